@@ -1030,6 +1030,7 @@ uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y)
 ***************************************************************************************/
 void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data, uint8_t sbpp)
 {
+  TFT_COUNT_PRIMITIVE(IMAGE);
   if (data == nullptr || !_created) return;
 
   PI_CLIP;
@@ -1169,6 +1170,7 @@ void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_
 ***************************************************************************************/
 void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data)
 {
+  TFT_COUNT_PRIMITIVE(IMAGE);
 #ifdef ESP32
   pushImage(x, y, w, h, (uint16_t*) data);
 #else
@@ -1515,6 +1517,7 @@ void TFT_eSprite::scroll(int16_t dx, int16_t dy)
 ***************************************************************************************/
 void TFT_eSprite::fillSprite(uint32_t color)
 {
+  TFT_COUNT_PRIMITIVE(RECT);
   if (!_created || _vpOoB) return;
 
   // Use memset if possible as it is super fast
@@ -1629,6 +1632,7 @@ uint8_t TFT_eSprite::getRotation(void)
 ***************************************************************************************/
 void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color)
 {
+  TFT_COUNT_PRIMITIVE(PIXEL);
   if (!_created || _vpOoB) return;
 
   x+= _xDatum;
@@ -1689,6 +1693,7 @@ void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color)
 ***************************************************************************************/
 void TFT_eSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color)
 {
+  TFT_COUNT_PRIMITIVE(LINE);
   if (!_created || _vpOoB) return;
 
   //_xDatum and _yDatum Not added here, it is added by drawPixel & drawFastxLine
@@ -1747,6 +1752,7 @@ void TFT_eSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint3
 ***************************************************************************************/
 void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
 {
+  TFT_COUNT_PRIMITIVE(VLINE);
   if (!_created || _vpOoB) return;
 
   x+= _xDatum;
@@ -1808,6 +1814,7 @@ void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
 ***************************************************************************************/
 void TFT_eSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
 {
+  TFT_COUNT_PRIMITIVE(HLINE);
   if (!_created || _vpOoB) return;
 
   x+= _xDatum;
@@ -1871,6 +1878,7 @@ void TFT_eSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
 ***************************************************************************************/
 void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
 {
+  TFT_COUNT_PRIMITIVE(RECT);
   if (!_created || _vpOoB) return;
 
   x+= _xDatum;
@@ -1977,12 +1985,193 @@ void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t
 }
 
 
+/***************************************************************************************
+** Function name:           roundCorner
+** Description:             corner span table of a rounded rectangle radius
+***************************************************************************************/
+// Per corner row (0 = top or bottom edge) the first column fillRoundRect fills and
+// the outline run drawRoundRect draws, as offsets from the left edge. The tables are
+// built by running the TFT_eSPI circle helper steps once, so the spans cover exactly
+// the same pixels. The last few radii are kept - GUI boxes use few (8, h/2)
+#define SPR_ROUND_MAX_R   48    // Larger radii go through the circle helpers
+#define SPR_ROUND_CACHE   4
+#define SPR_ROUND_NONE    0xFF  // Row without pixels
+
+typedef struct {
+  int16_t r;
+  uint8_t fill[SPR_ROUND_MAX_R];
+  uint8_t lineStart[SPR_ROUND_MAX_R];
+  uint8_t lineEnd[SPR_ROUND_MAX_R];
+} roundCorner_t;
+
+static roundCorner_t roundCorners[SPR_ROUND_CACHE];
+static uint8_t roundCornerNext = 0;
+
+static void roundCornerPixel(roundCorner_t *c, int32_t col, int32_t row)
+{
+  if (c->lineStart[row] == SPR_ROUND_NONE || col < c->lineStart[row]) c->lineStart[row] = col;
+  if (c->lineEnd[row] == SPR_ROUND_NONE || col > c->lineEnd[row]) c->lineEnd[row] = col;
+}
+
+static void buildRoundCorner(roundCorner_t *c, int32_t r)
+{
+  c->r = r;
+  memset(c->fill, SPR_ROUND_NONE, sizeof(c->fill));
+  memset(c->lineStart, SPR_ROUND_NONE, sizeof(c->lineStart));
+  memset(c->lineEnd, SPR_ROUND_NONE, sizeof(c->lineEnd));
+
+  // fillCircleHelper, top corners (centre r, r): rows r - rr and r - y
+  int32_t f = 1 - r, ddF_x = 1, ddF_y = -r - r, y = 0, rr = r;
+  while (y < rr) {
+    if (f >= 0) {
+      if (r - y < c->fill[r - rr]) c->fill[r - rr] = r - y;
+      rr--;
+      ddF_y += 2;
+      f     += ddF_y;
+    }
+    y++;
+    ddF_x += 2;
+    f     += ddF_x;
+    if (r - rr < c->fill[r - y]) c->fill[r - y] = r - rr;
+  }
+
+  // drawCircleHelper, left top corner (centre r, r)
+  f = 1 - r; ddF_x = 1; ddF_y = -2 * r; rr = r;
+  int32_t xe = 0, xs = 0;
+  do {
+    while (f < 0) {
+      ++xe;
+      f += (ddF_x += 2);
+    }
+    f += (ddF_y += 2);
+
+    if (xe - xs == 1) {
+      roundCornerPixel(c, r - xe, r - rr);
+      roundCornerPixel(c, r - rr, r - xe);
+    }
+    else {
+      int32_t len = xe - xs++;
+      for (int32_t i = 0; i < len; i++) {
+        roundCornerPixel(c, r - xe + i, r - rr);
+        roundCornerPixel(c, r - rr, r - xe + i);
+      }
+    }
+    xs = xe;
+  } while (xe < rr--);
+}
+
+// Table for radius r of a w x h rectangle, nullptr if the spans do not apply
+static const roundCorner_t *roundCorner(int32_t r, int32_t w, int32_t h)
+{
+  if (r <= 0 || r > SPR_ROUND_MAX_R || r + r > w || r + r > h) return nullptr;
+  for (uint8_t i = 0; i < SPR_ROUND_CACHE; i++) {
+    if (roundCorners[i].r == r) return &roundCorners[i];
+  }
+  roundCorner_t *c = &roundCorners[roundCornerNext];
+  roundCornerNext = (roundCornerNext + 1) % SPR_ROUND_CACHE;
+  buildRoundCorner(c, r);
+  return c;
+}
+
+
+/***************************************************************************************
+** Function name:           fillSpan
+** Description:             fill one row span, datum already applied
+***************************************************************************************/
+// 16-bit Sprites are written two pixels per 32-bit store, color is already byte
+// swapped. Other depths go through drawFastHLine with the unswapped color
+void TFT_eSprite::fillSpan(int32_t x, int32_t y, int32_t w, uint32_t color)
+{
+  TFT_COUNT_PRIMITIVE(RECT);
+  if (x < _vpX) { w += x - _vpX; x = _vpX; }
+  if ((x + w) > _vpW) w = _vpW - x;
+  if (w < 1) return;
+
+  if (_bpp == 16) {
+    uint16_t *p = _img + _iwidth * y + x;
+    if (((uintptr_t)p & 0x02) != 0) { *p++ = (uint16_t)color; w--; }
+    uint32_t  c2  = (color & 0xFFFF) | (color << 16);
+    uint32_t *p32 = (uint32_t *)p;
+    for (; w >= 2; w -= 2) *p32++ = c2;
+    if (w) *(uint16_t *)p32 = (uint16_t)color;
+  }
+  else {
+    drawFastHLine(x - _xDatum, y - _yDatum, w, color);
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           fillRoundRect
+** Description:             draw a filled rounded rectangle as row spans
+***************************************************************************************/
+void TFT_eSprite::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color)
+{
+  TFT_COUNT_PRIMITIVE(ROUNDRECT);
+  const roundCorner_t *c = roundCorner(r, w, h);
+  if (c == nullptr) { TFT_eSPI::fillRoundRect(x, y, w, h, r, color); return; }
+  if (!_created || _vpOoB) return;
+
+  x+= _xDatum;
+  y+= _yDatum;
+  if (_bpp == 16) color = ((color >> 8) | (color << 8)) & 0xFFFF;
+
+  // Only the rows inside the viewport
+  int32_t row = (y < _vpY) ? _vpY - y : 0;
+  int32_t end = (y + h > _vpH) ? _vpH - y : h;
+  for (; row < end; row++) {
+    int32_t k = (row < r) ? row : h - 1 - row;
+    int32_t inset = (k < r) ? c->fill[k] : 0;
+    if (inset == SPR_ROUND_NONE) continue;
+    fillSpan(x + inset, y + row, w - inset - inset, color);
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           drawRoundRect
+** Description:             draw a rounded rectangle outline as row spans
+***************************************************************************************/
+void TFT_eSprite::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color)
+{
+  TFT_COUNT_PRIMITIVE(ROUNDRECT);
+  const roundCorner_t *c = roundCorner(r, w, h);
+  if (c == nullptr) { TFT_eSPI::drawRoundRect(x, y, w, h, r, color); return; }
+  if (!_created || _vpOoB) return;
+
+  x+= _xDatum;
+  y+= _yDatum;
+  if (_bpp == 16) color = ((color >> 8) | (color << 8)) & 0xFFFF;
+
+  int32_t row = (y < _vpY) ? _vpY - y : 0;
+  int32_t end = (y + h > _vpH) ? _vpH - y : h;
+  for (; row < end; row++) {
+    int32_t k = (row < r) ? row : h - 1 - row;
+    if (k >= r) {
+      // Straight sides
+      fillSpan(x, y + row, 1, color);
+      fillSpan(x + w - 1, y + row, 1, color);
+      continue;
+    }
+    if (k == 0) {
+      // Top / bottom edge between the corners
+      fillSpan(x + r, y + row, w - r - r, color);
+    }
+    if (c->lineStart[k] == SPR_ROUND_NONE) continue;
+    int32_t len = c->lineEnd[k] - c->lineStart[k] + 1;
+    fillSpan(x + c->lineStart[k], y + row, len, color);
+    fillSpan(x + w - 1 - c->lineEnd[k], y + row, len, color);
+  }
+}
+
+
 /***************************************************************************************
 ** Function name:           drawChar
 ** Description:             draw a single character in the Adafruit GLCD or freefont
 ***************************************************************************************/
 void TFT_eSprite::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size)
 {
+  TFT_COUNT_PRIMITIVE(CHAR);
   if ( _vpOoB || !_created ) return;
 
   if (c < 32) return;
@@ -2150,6 +2339,7 @@ int16_t TFT_eSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y)
   // Any UTF-8 decoding must be done before calling drawChar()
 int16_t TFT_eSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font)
 {
+  TFT_COUNT_PRIMITIVE(CHAR);
   if (_vpOoB || !uniCode) return 0;
 
   if (font==1) {
@@ -2190,7 +2380,7 @@ int16_t TFT_eSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t fo
 
   int32_t width  = 0;
   int32_t height = 0;
-  uint32_t flash_address = 0;
+  uintptr_t flash_address = 0;
   uniCode -= 32;
 
 #ifdef LOAD_FONT2
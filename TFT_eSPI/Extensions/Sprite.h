@@ -87,6 +87,11 @@ class TFT_eSprite : public TFT_eSPI {
            // Fill a rectangular area with a color (aka draw a filled rectangle)
            fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
 
+           // Rounded rectangles as row spans from a cached corner table per radius
+           // (same pixels as the TFT_eSPI circle helpers), 32-bit stores in 16-bit Sprites
+  void     fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color),
+           drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+
            // Set the coordinate rotation of the Sprite (for 1bpp Sprites only)
            // Note: this uses coordinate rotation and is primarily for ePaper which does not support
            // CGRAM rotation (like TFT drivers do) within the displays internal hardware
@@ -159,6 +164,9 @@ class TFT_eSprite : public TFT_eSPI {
   void     begin_nin_write(void) { ; }
   void     end_nin_write(void) { ; }
 
+           // Fill one row span of a round rect, datum applied (16-bit: color swapped)
+  void     fillSpan(int32_t x, int32_t y, int32_t w, uint32_t color);
+
  protected:
 
   uint8_t  _bpp;     // bits per pixel (1, 4, 8 or 16)
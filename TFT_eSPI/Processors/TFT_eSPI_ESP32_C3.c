@@ -42,14 +42,12 @@
       spi_host_device_t spi_host = SPI2_HOST;
     #endif
   #else
-    #ifdef USE_HSPI_PORT
-      #define DMA_CHANNEL 2
-      spi_host_device_t spi_host = (spi_host_device_t) DMA_CHANNEL; // Draws once then freezes
-    #else // use FSPI port
-      #define DMA_CHANNEL 1
-      spi_host_device_t spi_host = (spi_host_device_t) DMA_CHANNEL; // Draws once then freezes
-    #endif
+    // GDMA targets have no fixed SPI DMA channels, only GPSPI2 is usable
+    #define DMA_CHANNEL SPI_DMA_CH_AUTO
+    spi_host_device_t spi_host = SPI2_HOST;
   #endif
+  // One descriptor set per queued transaction, reused after dmaWait()
+  static spi_transaction_t dmaTrans[TFT_DMA_QUEUE];
 #endif
 
 #if !defined (TFT_PARALLEL_8_BIT)
@@ -594,6 +592,38 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 #if defined (ESP32_DMA) && !defined (TFT_PARALLEL_8_BIT) //       DMA FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////
 
+/***************************************************************************************
+** Function name:           dmaQueue
+** Description:             Queue len pixels as transactions of TFT_DMA_MAX_BYTES
+**                          Returns the number queued (caller adds it to spiBusyCheck)
+***************************************************************************************/
+static uint8_t dmaQueue(const uint16_t* data, uint32_t len)
+{
+  const uint8_t* bytes = (const uint8_t*)data;
+  uint32_t remaining = len * 2;
+  uint8_t queued = 0;
+
+  while (remaining && queued < TFT_DMA_QUEUE) {
+    uint32_t n = remaining > TFT_DMA_MAX_BYTES ? TFT_DMA_MAX_BYTES : remaining;
+    spi_transaction_t* trans = &dmaTrans[queued];
+
+    memset(trans, 0, sizeof(spi_transaction_t));
+    trans->user = (void *)1;
+    trans->tx_buffer = bytes;  //Data pointer
+    trans->length = n * 8;     //Data length, in bits
+    trans->flags = 0;          //SPI_TRANS_USE_TXDATA flag
+
+    esp_err_t ret = spi_device_queue_trans(dmaHAL, trans, portMAX_DELAY);
+    assert(ret == ESP_OK);
+
+    bytes += n;
+    remaining -= n;
+    queued++;
+  }
+  return queued;
+}
+
+
 /***************************************************************************************
 ** Function name:           dmaBusy
 ** Description:             Check if DMA is busy
@@ -637,7 +667,7 @@ void TFT_eSPI::dmaWait(void)
 
 /***************************************************************************************
 ** Function name:           pushPixelsDMA
-** Description:             Push pixels to TFT (len must be less than 32767)
+** Description:             Push pixels to TFT (len up to TFT_DMA_QUEUE * TFT_DMA_MAX_BYTES / 2)
 ***************************************************************************************/
 // This will byte swap the original image if setSwapBytes(true) was called by sketch.
 void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
@@ -650,26 +680,13 @@ void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
     for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
   }
 
-  esp_err_t ret;
-  static spi_transaction_t trans;
-
-  memset(&trans, 0, sizeof(spi_transaction_t));
-
-  trans.user = (void *)1;
-  trans.tx_buffer = image;  //finally send the line data
-  trans.length = len * 16;        //Data length, in bits
-  trans.flags = 0;                //SPI_TRANS_USE_TXDATA flag
-
-  ret = spi_device_queue_trans(dmaHAL, &trans, portMAX_DELAY);
-  assert(ret == ESP_OK);
-
-  spiBusyCheck++;
+  spiBusyCheck += dmaQueue(image, len);
 }
 
 
 /***************************************************************************************
 ** Function name:           pushImageDMA
-** Description:             Push image to a window (w*h must be less than 65536)
+** Description:             Push image to a window (w*h up to TFT_DMA_QUEUE * TFT_DMA_MAX_BYTES / 2)
 ***************************************************************************************/
 // Fixed const data assumed, will NOT clip or swap bytes
 void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t const* image)
@@ -682,26 +699,13 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 
   setAddrWindow(x, y, w, h);
 
-  esp_err_t ret;
-  static spi_transaction_t trans;
-
-  memset(&trans, 0, sizeof(spi_transaction_t));
-
-  trans.user = (void *)1;
-  trans.tx_buffer = image;   //Data pointer
-  trans.length = len * 16;   //Data length, in bits
-  trans.flags = 0;           //SPI_TRANS_USE_TXDATA flag
-
-  ret = spi_device_queue_trans(dmaHAL, &trans, portMAX_DELAY);
-  assert(ret == ESP_OK);
-
-  spiBusyCheck++;
+  spiBusyCheck += dmaQueue(image, len);
 }
 
 
 /***************************************************************************************
 ** Function name:           pushImageDMA
-** Description:             Push image to a window (w*h must be less than 65536)
+** Description:             Push image to a window (w*h up to TFT_DMA_QUEUE * TFT_DMA_MAX_BYTES / 2)
 ***************************************************************************************/
 // This will clip and also swap bytes if setSwapBytes(true) was called by sketch
 void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer)
@@ -758,20 +762,7 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 
   setAddrWindow(x, y, dw, dh);
 
-  esp_err_t ret;
-  static spi_transaction_t trans;
-
-  memset(&trans, 0, sizeof(spi_transaction_t));
-
-  trans.user = (void *)1;
-  trans.tx_buffer = buffer;  //finally send the line data
-  trans.length = len * 16;   //Data length, in bits
-  trans.flags = 0;           //SPI_TRANS_USE_TXDATA flag
-
-  ret = spi_device_queue_trans(dmaHAL, &trans, portMAX_DELAY);
-  assert(ret == ESP_OK);
-
-  spiBusyCheck++;
+  spiBusyCheck += dmaQueue(buffer, len);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -810,7 +801,7 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
     .data5_io_num = -1,
     .data6_io_num = -1,
     .data7_io_num = -1,
-    .max_transfer_sz = TFT_WIDTH * TFT_HEIGHT * 2 + 8, // TFT screen size
+    .max_transfer_sz = TFT_DMA_MAX_BYTES, // Per transaction, frames are split by dmaQueue()
     .flags = 0,
     .intr_flags = 0
   };
@@ -830,14 +821,17 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
     .input_delay_ns = 0,
     .spics_io_num = pin,
     .flags = SPI_DEVICE_NO_DUMMY, //0,
-    .queue_size = 1,
+    .queue_size = TFT_DMA_QUEUE,
     .pre_cb = 0, //dc_callback, //Callback to handle D/C line
     .post_cb = 0
   };
   ret = spi_bus_initialize(spi_host, &buscfg, DMA_CHANNEL);
-  ESP_ERROR_CHECK(ret);
+  if (ret != ESP_OK) return false;  // Sketch keeps the CPU push functions
   ret = spi_bus_add_device(spi_host, &devcfg, &dmaHAL);
-  ESP_ERROR_CHECK(ret);
+  if (ret != ESP_OK) {
+    spi_bus_free(spi_host);
+    return false;
+  }
 
   DMA_Enabled = true;
   spiBusyCheck = 0;
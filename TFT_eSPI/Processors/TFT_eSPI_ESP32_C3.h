@@ -9,9 +9,9 @@
 #ifndef _TFT_eSPI_ESP32H_
 #define _TFT_eSPI_ESP32H_
 
-#if !defined(DISABLE_ALL_LIBRARY_WARNINGS)
- #warning >>>>------>> DMA is not supported on the ESP32 C3, C6(possible future update)
-#endif
+// DMA on the C3 / C6 goes through the GDMA controller: the channel is picked by
+// the IDF driver (SPI_DMA_CH_AUTO) and large images are queued as several
+// transactions of at most TFT_DMA_MAX_BYTES
 
 // Processor ID reported by getSetup()
 #define PROCESSOR_ID 0x32
@@ -22,7 +22,7 @@
 #include "hal/gpio_ll.h"
 
 
-#if !defined(CONFIG_IDF_TARGET_ESP32C3) && !defined(CONFIG_IDF_TARGET_ESP32S2) && !defined(CONFIG_IDF_TARGET_ESP32)  && !defined(CONFIG_IDF_TARGET_ESP32c6)
+#if !defined(CONFIG_IDF_TARGET_ESP32C3) && !defined(CONFIG_IDF_TARGET_ESP32S2) && !defined(CONFIG_IDF_TARGET_ESP32)  && !defined(CONFIG_IDF_TARGET_ESP32C6)
   #define CONFIG_IDF_TARGET_ESP32
 #endif
 
@@ -139,6 +139,10 @@ SPI3_HOST = 2
   #define ESP32_DMA
   // Code to check if DMA is busy, used by SPI DMA + transaction + endWrite functions
   #define DMA_BUSY_CHECK  dmaWait()
+  // GPSPI DMA moves at most 2^18 bits per transaction
+  #define TFT_DMA_MAX_BYTES 32000
+  // Transactions in flight - a 320x240 16-bit frame needs 5
+  #define TFT_DMA_QUEUE     8
 #else
   #define DMA_BUSY_CHECK
 #endif
@@ -0,0 +1,269 @@
+        ////////////////////////////////////////////////////
+        //      TFT_eSPI host (native build) driver       //
+        ////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Global variables
+////////////////////////////////////////////////////////////////////////////////////////
+
+// Only init() talks to it - the write macros go to the panel model
+SPIClass& spi = SPI;
+
+TFTHostPanel tftHostPanel;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Panel model
+////////////////////////////////////////////////////////////////////////////////////////
+
+void tftHostResetStats(void)
+{
+  memset(&tftHostPanel.stats, 0, sizeof(tftHostPanel.stats));
+}
+
+static inline void tftHostStore(uint16_t color)
+{
+  TFTHostPanel& p = tftHostPanel;
+  if (p.x < TFT_HOST_SIZE && p.y < TFT_HOST_SIZE) p.frame[p.y * TFT_HOST_SIZE + p.x] = color;
+  p.stats.pixels++;
+
+  // The controller wraps inside the window
+  if (++p.x > p.xe) {
+    p.x = p.xs;
+    if (++p.y > p.ye) p.y = p.ys;
+  }
+}
+
+void tftHostWrite8(uint8_t c)
+{
+  TFTHostPanel& p = tftHostPanel;
+  p.stats.bytes++;
+
+  if (!p.data) {
+    p.command = c;
+    p.params = 0;
+    p.pixelHalf = false;
+    p.stats.commands++;
+    if (c == TFT_RAMWR) {
+      p.x = p.xs;
+      p.y = p.ys;
+      p.stats.windows++;
+    }
+    return;
+  }
+
+  if (p.command == TFT_CASET || p.command == TFT_PASET) {
+    if (p.params < 4) p.param[p.params++] = c;
+    if (p.params == 4) {
+      uint16_t start = p.param[0] << 8 | p.param[1];
+      uint16_t end   = p.param[2] << 8 | p.param[3];
+      if (p.command == TFT_CASET) { p.xs = start; p.xe = end; }
+      else                        { p.ys = start; p.ye = end; }
+      p.params++;
+    }
+    return;
+  }
+
+  if (p.command == TFT_RAMWR) {
+    if (!p.pixelHalf) {
+      p.pixelHigh = c;
+      p.pixelHalf = true;
+      return;
+    }
+    p.pixelHalf = false;
+    tftHostStore(p.pixelHigh << 8 | c);
+  }
+  // Other commands (init sequence, MADCTL) only count their bytes
+}
+
+void tftHostWrite16(uint16_t c)
+{
+  tftHostWrite8(c >> 8);
+  tftHostWrite8(c);
+}
+
+void tftHostWrite32(uint32_t c)
+{
+  tftHostWrite16(c >> 16);
+  tftHostWrite16(c);
+}
+
+// Whole pixels of an open memory write skip the byte decoder
+static inline bool tftHostPixelMode(void)
+{
+  return tftHostPanel.data && tftHostPanel.command == TFT_RAMWR && !tftHostPanel.pixelHalf;
+}
+
+void tftHostFill(uint16_t color, uint32_t len)
+{
+  if (!tftHostPixelMode()) {
+    while (len--) tftHostWrite16(color);
+    return;
+  }
+  tftHostPanel.stats.bytes += len * 2;
+  while (len--) tftHostStore(color);
+}
+
+void tftHostPixels(const uint16_t* data, uint32_t len, bool swap)
+{
+  if (!tftHostPixelMode()) {
+    while (len--) { uint16_t c = *data++; tftHostWrite16(swap ? (uint16_t)(c << 8 | c >> 8) : c); }
+    return;
+  }
+  tftHostPanel.stats.bytes += len * 2;
+  while (len--) { uint16_t c = *data++; tftHostStore(swap ? (uint16_t)(c << 8 | c >> 8) : c); }
+}
+
+/***************************************************************************************
+** Function name:           pushBlock - for host panel model
+** Description:             Write a block of pixels of the same colour
+***************************************************************************************/
+void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
+{
+  tftHostFill(color, len);
+}
+
+/***************************************************************************************
+** Function name:           pushPixels - for host panel model
+** Description:             Write a sequence of pixels
+***************************************************************************************/
+void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
+{
+  // Swapped bytes: the data is in host order and goes out MSB first
+  tftHostPixels((const uint16_t*)data_in, len, !_swapBytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+//                                 DMA FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////
+// Same contract as the ESP32 ones, but the pixels are in panel memory when
+// the push returns
+
+/***************************************************************************************
+** Function name:           dmaBusy
+** Description:             Check if DMA is busy
+***************************************************************************************/
+bool TFT_eSPI::dmaBusy(void)
+{
+  return false;
+}
+
+/***************************************************************************************
+** Function name:           dmaWait
+** Description:             Wait until DMA is over
+***************************************************************************************/
+void TFT_eSPI::dmaWait(void)
+{
+}
+
+/***************************************************************************************
+** Function name:           pushPixelsDMA
+** Description:             Push pixels to TFT
+***************************************************************************************/
+// This will byte swap the original image if setSwapBytes(true) was called by sketch.
+void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
+{
+  if ((len == 0) || (!DMA_Enabled)) return;
+
+  if(_swapBytes) {
+    for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
+  }
+
+  tftHostPixels(image, len, true);
+  tftHostPanel.stats.dmaPushes++;
+}
+
+/***************************************************************************************
+** Function name:           pushImageDMA
+** Description:             Push image to a window
+***************************************************************************************/
+// Fixed const data assumed, will NOT clip or swap bytes
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t const* image)
+{
+  if ((w == 0) || (h == 0) || (!DMA_Enabled)) return;
+
+  setAddrWindow(x, y, w, h);
+
+  tftHostPixels(image, w * h, true);
+  tftHostPanel.stats.dmaPushes++;
+}
+
+/***************************************************************************************
+** Function name:           pushImageDMA
+** Description:             Push image to a window
+***************************************************************************************/
+// This will clip and also swap bytes if setSwapBytes(true) was called by sketch
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer)
+{
+  if ((x >= _vpW) || (y >= _vpH) || (!DMA_Enabled)) return;
+
+  int32_t dx = 0;
+  int32_t dy = 0;
+  int32_t dw = w;
+  int32_t dh = h;
+
+  if (x < _vpX) { dx = _vpX - x; dw -= dx; x = _vpX; }
+  if (y < _vpY) { dy = _vpY - y; dh -= dy; y = _vpY; }
+
+  if ((x + dw) > _vpW ) dw = _vpW - x;
+  if ((y + dh) > _vpH ) dh = _vpH - y;
+
+  if (dw < 1 || dh < 1) return;
+
+  uint32_t len = dw*dh;
+
+  if (buffer == nullptr) buffer = image;
+
+  // If image is clipped, copy pixels into a contiguous block
+  if ( (dw != w) || (dh != h) ) {
+    if(_swapBytes) {
+      for (int32_t yb = 0; yb < dh; yb++) {
+        for (int32_t xb = 0; xb < dw; xb++) {
+          uint32_t src = xb + dx + w * (yb + dy);
+          (buffer[xb + yb * dw] = image[src] << 8 | image[src] >> 8);
+        }
+      }
+    }
+    else {
+      for (int32_t yb = 0; yb < dh; yb++) {
+        memmove((uint8_t*) (buffer + yb * dw), (uint8_t*) (image + dx + w * (yb + dy)), dw << 1);
+      }
+    }
+  }
+  // else, if a buffer pointer has been provided copy whole image to the buffer
+  else if (buffer != image || _swapBytes) {
+    if(_swapBytes) {
+      for (uint32_t i = 0; i < len; i++) (buffer[i] = image[i] << 8 | image[i] >> 8);
+    }
+    else {
+      memcpy(buffer, image, len*2);
+    }
+  }
+
+  setAddrWindow(x, y, dw, dh);
+
+  tftHostPixels(buffer, len, true);
+  tftHostPanel.stats.dmaPushes++;
+}
+
+/***************************************************************************************
+** Function name:           initDMA
+** Description:             Initialise the DMA engine - returns true if init OK
+***************************************************************************************/
+bool TFT_eSPI::initDMA(bool ctrl_cs)
+{
+  if (DMA_Enabled) return false;
+  (void)ctrl_cs;
+
+  DMA_Enabled = true;
+  spiBusyCheck = 0;
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           deInitDMA
+** Description:             Disconnect the DMA engine from SPI
+***************************************************************************************/
+void TFT_eSPI::deInitDMA(void)
+{
+  DMA_Enabled = false;
+}
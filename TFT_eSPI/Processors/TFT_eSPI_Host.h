@@ -0,0 +1,130 @@
+        ////////////////////////////////////////////////////
+        //      TFT_eSPI host (native build) driver       //
+        ////////////////////////////////////////////////////
+
+// Selected with -D TFT_HOST_PANEL (BioPal [env:render]): the "bus" is a model
+// of the panel controller running on the build host. Command bytes are decoded
+// (column / page address set and memory write), pixels land in a framebuffer
+// and every byte is counted, so a frame's render cost and image can be checked
+// without a board. Sprites draw into their buffers as on the target; the
+// drawing calls they get are counted by TFT_COUNT_PRIMITIVE. DMA pushes are
+// synchronous
+
+#ifndef _TFT_eSPI_HOSTH_
+#define _TFT_eSPI_HOSTH_
+
+#include <stdint.h>
+
+// Processor ID reported by getSetup()
+#define PROCESSOR_ID 0x0F00
+
+// No bus to configure
+#define SET_BUS_WRITE_MODE
+#define SET_BUS_READ_MODE
+#define INIT_TFT_DATA_BUS
+
+// DMA completes inside the push call
+#define DMA_BUSY_CHECK
+
+// No file system for smooth fonts
+#undef SMOOTH_FONT
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Panel model
+////////////////////////////////////////////////////////////////////////////////////////
+
+// Square, so every rotation's address range fits. Pixels are stored as
+// addressed - MADCTL (rotation, colour order) is not modelled
+#define TFT_HOST_SIZE (TFT_WIDTH > TFT_HEIGHT ? TFT_WIDTH : TFT_HEIGHT)
+
+// Drawing calls counted into the panel statistics - nested calls included
+// (a round rect also counts the lines and rects it is made of)
+enum TFTHostPrimitive : uint8_t {
+  TFT_PRIM_PIXEL,
+  TFT_PRIM_LINE,
+  TFT_PRIM_HLINE,
+  TFT_PRIM_VLINE,
+  TFT_PRIM_RECT,       // fillRect, fillSpan, fillSprite
+  TFT_PRIM_ROUNDRECT,
+  TFT_PRIM_CIRCLE,
+  TFT_PRIM_CHAR,       // Library glyph renderer
+  TFT_PRIM_STRING,
+  TFT_PRIM_IMAGE,      // pushImage into a sprite
+  TFT_PRIM_COUNT
+};
+
+struct TFTHostStats {
+  uint32_t bytes;      // Every byte on the bus: commands, parameters and pixels
+  uint32_t commands;
+  uint32_t windows;    // Memory writes started (RAMWR)
+  uint32_t pixels;     // Pixels written to panel memory
+  uint32_t dmaPushes;
+  uint32_t primitives[TFT_PRIM_COUNT];
+};
+
+struct TFTHostPanel {
+  uint16_t frame[TFT_HOST_SIZE * TFT_HOST_SIZE];  // RGB565
+  TFTHostStats stats;
+
+  // Bus decoder
+  bool     data;       // DC high
+  uint8_t  command;    // Last command byte
+  uint8_t  params;     // Parameter bytes since the command
+  uint8_t  param[4];
+  uint8_t  pixelHigh;  // High byte while pixelHalf
+  bool     pixelHalf;  // One byte of a pixel received
+  uint16_t xs, xe, ys, ye;   // Address window
+  uint16_t x, y;             // Next pixel in it
+};
+
+extern TFTHostPanel tftHostPanel;
+
+// Zero the statistics, keep the image
+void tftHostResetStats(void);
+
+void tftHostWrite8(uint8_t c);
+void tftHostWrite16(uint16_t c);
+void tftHostWrite32(uint32_t c);
+
+// Pixels into the open memory write - len times color, or len pixels of
+// data (swap: the pixels are in memory byte order, not bus order)
+void tftHostFill(uint16_t color, uint32_t len);
+void tftHostPixels(const uint16_t* data, uint32_t len, bool swap);
+
+#define TFT_COUNT_PRIMITIVE(kind) (tftHostPanel.stats.primitives[TFT_PRIM_##kind]++)
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Pin drive code - DC selects command or data bytes in the model
+////////////////////////////////////////////////////////////////////////////////////////
+#define DC_C tftHostPanel.data = false
+#define DC_D tftHostPanel.data = true
+
+#define CS_L
+#define CS_H
+
+#define T_CS_L
+#define T_CS_H
+
+#ifndef TFT_RD
+  #define TFT_RD -1
+#endif
+
+#ifndef TFT_MISO
+  #define TFT_MISO -1
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Macros to write commands/pixel colour data
+////////////////////////////////////////////////////////////////////////////////////////
+#define tft_Write_8(C)     tftHostWrite8((uint8_t)(C))
+#define tft_Write_16(C)    tftHostWrite16((uint16_t)(C))
+#define tft_Write_16N(C)   tftHostWrite16((uint16_t)(C))
+#define tft_Write_16S(C)   tftHostWrite16((uint16_t)((uint16_t)(C) << 8 | (uint16_t)(C) >> 8))
+#define tft_Write_32(C)    tftHostWrite32((uint32_t)(C))
+#define tft_Write_32C(C,D) tftHostWrite32((uint32_t)(uint16_t)(C) << 16 | (uint16_t)(D))
+#define tft_Write_32D(C)   tftHostWrite32((uint32_t)(uint16_t)(C) << 16 | (uint16_t)(C))
+
+// Reads return nothing
+#define tft_Read_8() 0
+
+#endif // Header end
@@ -15,7 +15,9 @@
 
 #include "TFT_eSPI.h"
 
-#if defined (ESP32)
+#if defined (TFT_HOST_PANEL)
+  #include "Processors/TFT_eSPI_Host.c"
+#elif defined (ESP32)
   #if defined(CONFIG_IDF_TARGET_ESP32S3)
     #include "Processors/TFT_eSPI_ESP32_S3.c" // Tested with SPI and 8-bit parallel
   #elif defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32C6) 
@@ -2274,6 +2276,7 @@ void  TFT_eSPI::readRectRGB(int32_t x0, int32_t y0, int32_t w, int32_t h, uint8_
 // Optimised midpoint circle algorithm
 void TFT_eSPI::drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color)
 {
+  TFT_COUNT_PRIMITIVE(CIRCLE);
   if ( r <= 0 ) return;
 
   //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
@@ -2413,6 +2416,7 @@ void TFT_eSPI::drawCircleHelper( int32_t x0, int32_t y0, int32_t rr, uint8_t cor
 // Improved algorithm avoids repetition of lines
 void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color)
 {
+  TFT_COUNT_PRIMITIVE(CIRCLE);
   int32_t  x  = 0;
   int32_t  dx = 1;
   int32_t  dy = r+r;
@@ -3944,6 +3948,47 @@ void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t
 }
 
 
+/***************************************************************************************
+** Function name:           drawPixels
+** Description:             draw a list of pixels of one colour in one transaction
+***************************************************************************************/
+// Neighbouring pixels along a row or column (either direction) are merged into one
+// drawFastHLine / drawFastVLine, so a run costs one address window instead of one
+// per pixel. Lone pixels go to drawPixel, which only resends the address that changed
+void TFT_eSPI::drawPixels(const int16_t *xy, uint32_t count, uint32_t color)
+{
+  if (_vpOoB || count == 0) return;
+
+  //begin_tft_write();       // Sprite class can use this function, avoiding begin_tft_write()
+  inTransaction = true;
+
+  uint32_t i = 0;
+  while (i < count) {
+    int32_t x = xy[2 * i], y = xy[2 * i + 1];
+    int32_t sx = 0, sy = 0;
+    if (i + 1 < count) {
+      int32_t nx = xy[2 * i + 2] - x, ny = xy[2 * i + 3] - y;
+      if (ny == 0 && (nx == 1 || nx == -1)) sx = nx;
+      else if (nx == 0 && (ny == 1 || ny == -1)) sy = ny;
+    }
+
+    uint32_t run = 1;
+    if (sx != 0 || sy != 0) {
+      while (i + run < count && xy[2 * (i + run)] == x + sx * (int32_t)run
+                             && xy[2 * (i + run) + 1] == y + sy * (int32_t)run) run++;
+    }
+
+    if (sx != 0) drawFastHLine(sx > 0 ? x : x - (int32_t)run + 1, y, run, color);
+    else if (sy != 0) drawFastVLine(x, sy > 0 ? y : y - (int32_t)run + 1, run, color);
+    else drawPixel(x, y, color);
+    i += run;
+  }
+
+  inTransaction = lockTransaction;
+  end_tft_write();
+}
+
+
 /***************************************************************************************
 ** Description:  Constants for anti-aliased line drawing on TFT and in Sprites
 ***************************************************************************************/
@@ -5231,7 +5276,7 @@ int16_t TFT_eSPI::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font)
 
   int32_t width  = 0;
   int32_t height = 0;
-  uint32_t flash_address = 0;
+  uintptr_t flash_address = 0;
   uniCode -= 32;
 
 #ifdef LOAD_FONT2
@@ -5503,6 +5548,7 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY)
 // With font number. Note: font number is over-ridden if a smooth font is loaded
 int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8_t font)
 {
+  TFT_COUNT_PRIMITIVE(STRING);
   if (font > 8) return 0;
 
   int16_t sumX = 0;
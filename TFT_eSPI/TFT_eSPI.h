@@ -93,7 +93,10 @@
 #endif
 
 // Include the processor specific drivers
-#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#if defined (TFT_HOST_PANEL) // Native build, panel model in memory
+  #include "Processors/TFT_eSPI_Host.h"
+  #define GENERIC_PROCESSOR
+#elif defined(CONFIG_IDF_TARGET_ESP32S3)
   #include "Processors/TFT_eSPI_ESP32_S3.h"
 //#elif defined(CONFIG_IDF_TARGET_ESP32C3)
 #elif defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32C6) 
@@ -111,6 +114,11 @@
   #define GENERIC_PROCESSOR
 #endif
 
+// Drawing call statistics - only the host panel model counts them
+#ifndef TFT_COUNT_PRIMITIVE
+  #define TFT_COUNT_PRIMITIVE(kind)
+#endif
+
 /***************************************************************************************
 **                         Section 3: Interface setup
 ***************************************************************************************/
@@ -503,6 +511,10 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Write a set of pixels stored in memory, use setSwapBytes(true/false) function to correct endianess
   void     pushPixels(const void * data_in, uint32_t len);
 
+           // Draw count pixels of one colour, xy holds x,y pairs, in one transaction
+           // Runs along a row or column go out as one window + block write
+  void     drawPixels(const int16_t *xy, uint32_t count, uint32_t color);
+
            // Support for half duplex (bi-directional SDA) SPI bus where MOSI must be switched to input
            #ifdef TFT_SDA_READ
              #if defined (TFT_eSPI_ENABLE_8_BIT_READ)
@@ -785,7 +797,7 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // in progress, this simplifies the sketch and helps avoid "gotchas".
   void     pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr);
 
-#if defined (ESP32) // ESP32 only at the moment
+#if defined (ESP32) || defined (TFT_HOST_PANEL) // ESP32 only at the moment
            // For case where pointer is a const and the image data must not be modified (clipped or byte swapped)
   void     pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t const* data);
 #endif
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+BioPal Sweep-Throughput Benchmark
+Runs the on-target sweep workloads ([env:bench_sweep], include/sweep_bench.h:
+1, 4 and 16 DUTs of 38 frequencies against the virtual STM32) over USB
+serial and checks them against stored thresholds, so a firmware release that
+sweeps slower, delivers later, needs more heap or keeps the CPU busier is
+caught before it ships.
+
+Each workload reports sweeps/hour, p50/p95/p99 of the DUT_END -> delivered
+latency, the heap low-water mark and the CPU busy share (energy proxy). With
+--ble a client connects, asks for live points (STREAM:1) and the workloads
+run a second time with BLE streaming. The score - the geometric mean of the
+sweeps/hour of every workload run - is the one number to track.
+
+Thresholds are the reference run's numbers plus a margin (--update writes
+them from the current run). Tighten them when the firmware gets faster,
+never loosen them to merge a change. Exits 1 on a regression.
+
+Usage:
+  pio run -e bench_sweep -t upload
+  python bench_sweep.py --port /dev/ttyACM0                         # check
+  python bench_sweep.py --port /dev/ttyACM0 --ble AA:BB:CC:DD:EE:FF  # with streaming too
+  python bench_sweep.py --port /dev/ttyACM0 --ble --update          # new reference
+"""
+
+import argparse
+import asyncio
+import json
+import math
+import os
+import sys
+
+from biopal_host import BleDevice, DeviceError, SerialDevice
+
+DEFAULT_THRESHOLDS = "bench_sweep_thresholds.json"
+DEFAULT_SWEEPS = 5              # SWEEP_BENCH_SWEEPS
+EVENT_TIMEOUT_S = 180.0         # Longest gap between two results (16 DUTs, repeats of the warm-up)
+
+# Margins --update leaves between the reference run and its thresholds
+RATE_MARGIN = 0.90              # Sweeps/hour and score: at least this share of the reference
+LATENCY_MARGIN = 1.25           # Percentiles: at most this multiple
+HEAP_MARGIN = 0.90              # Heap low-water: at least this share
+CPU_MARGIN = 10.0               # CPU busy share: at most this many points more
+
+# (field, threshold kind) of a result - "min": measured >= threshold
+CHECKS = [
+    ("rate", "min"),
+    ("p50_us", "max"),
+    ("p95_us", "max"),
+    ("p99_us", "max"),
+    ("heap_min", "min"),
+    ("cpu", "max"),
+]
+
+
+def workload_key(result):
+    return f"{result['duts']}dut_{'ble' if result['ble'] else 'noble'}"
+
+
+def parse_result(fields):
+    """An "@EVT bench_result" line's fields after the event name"""
+    duts, ble, sweeps, rate, p50, p95, p99, heap, cpu = fields[:9]
+    cpu = float(cpu)
+    return {"duts": int(duts), "ble": ble == "1", "sweeps": int(sweeps), "rate": float(rate),
+            "p50_us": int(p50), "p95_us": int(p95), "p99_us": int(p99), "heap_min": int(heap),
+            "cpu": cpu if cpu >= 0 else None}
+
+
+async def run_workloads(device, sweeps):
+    """One "bench sweep" run: its results, in workload order"""
+    await device.command(f"bench sweep {sweeps}")
+    results = []
+    while True:
+        _, event = await device.next_event(("event",), EVENT_TIMEOUT_S,
+                                           lambda e: e[0] in ("bench_result", "bench_end"))
+        if event[0] == "bench_result":
+            result = parse_result(event[1:])
+            results.append(result)
+            print(f"  {workload_key(result)}: {result['rate']:.1f} sweeps/h", file=sys.stderr)
+        else:
+            if event[2] != "done":
+                raise DeviceError(f"bench ended: {event[2]}")
+            return results
+
+
+async def measure(args):
+    results = []
+    async with SerialDevice(args.port, args.baud) as device:
+        print("Workloads without BLE streaming", file=sys.stderr)
+        results += await run_workloads(device, args.sweeps)
+        if args.ble is not None:
+            async with BleDevice(args.ble or None) as client:
+                await client.request("STREAM:1", ("STATUS:Stream",))
+                print("Workloads with BLE streaming", file=sys.stderr)
+                results += await run_workloads(device, args.sweeps)
+    return results
+
+
+def score(results):
+    rates = [r["rate"] for r in results if r["rate"] > 0]
+    return math.exp(sum(math.log(r) for r in rates) / len(rates)) if rates else 0.0
+
+
+def make_thresholds(results):
+    workloads = {}
+    for r in results:
+        limits = {"rate": round(r["rate"] * RATE_MARGIN, 1),
+                  "p50_us": int(r["p50_us"] * LATENCY_MARGIN),
+                  "p95_us": int(r["p95_us"] * LATENCY_MARGIN),
+                  "p99_us": int(r["p99_us"] * LATENCY_MARGIN),
+                  "heap_min": int(r["heap_min"] * HEAP_MARGIN)}
+        if r["cpu"] is not None:
+            limits["cpu"] = round(min(r["cpu"] + CPU_MARGIN, 100.0), 1)
+        workloads[workload_key(r)] = limits
+    return {"sweeps": results[0]["sweeps"] if results else DEFAULT_SWEEPS,
+            "score": round(score(results) * RATE_MARGIN, 1),
+            "workloads": workloads}
+
+
+def check(results, thresholds):
+    """Print every result against its thresholds; True if none regressed"""
+    passed = True
+    limits_of = thresholds.get("workloads", {})
+    print(f"{'workload':<12} {'sweeps/h':>10} {'p50 ms':>8} {'p95 ms':>8} {'p99 ms':>8} "
+          f"{'heap min':>9} {'CPU %':>6}  result")
+    for r in results:
+        key = workload_key(r)
+        cpu = f"{r['cpu']:.1f}" if r["cpu"] is not None else "-"
+        line = (f"{key:<12} {r['rate']:>10.1f} {r['p50_us'] / 1000:>8.2f} {r['p95_us'] / 1000:>8.2f} "
+                f"{r['p99_us'] / 1000:>8.2f} {r['heap_min']:>9} {cpu:>6}")
+        limits = limits_of.get(key)
+        if limits is None:
+            print(f"{line}  no threshold")
+            continue
+        failed = []
+        for field, kind in CHECKS:
+            if field not in limits or r[field] is None:
+                continue
+            bad = r[field] < limits[field] if kind == "min" else r[field] > limits[field]
+            if bad:
+                failed.append(f"{field} {r[field]} {'<' if kind == 'min' else '>'} {limits[field]}")
+        passed &= not failed
+        print(f"{line}  {'ok' if not failed else 'FAIL: ' + ', '.join(failed)}")
+
+    total = score(results)
+    # The score compares only the same set of workloads
+    if sorted(workload_key(r) for r in results) == sorted(limits_of):
+        ok = total >= thresholds.get("score", 0.0)
+        passed &= ok
+        print(f"\nScore: {total:.1f} sweeps/h (threshold {thresholds.get('score', 0.0):.1f}) "
+              f"{'ok' if ok else 'FAIL'}")
+    else:
+        print(f"\nScore: {total:.1f} sweeps/h (other workloads than the thresholds - not compared)")
+    return passed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check on-target sweep throughput against stored thresholds")
+    parser.add_argument("--port", required=True, help="Serial port of a board running [env:bench_sweep]")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--ble", nargs="?", const="", help="Also run with BLE streaming (address, or scan by name)")
+    parser.add_argument("--sweeps", type=int, default=DEFAULT_SWEEPS, help="Measured final sweeps per workload")
+    parser.add_argument("--thresholds", default=DEFAULT_THRESHOLDS, help="Stored thresholds (JSON)")
+    parser.add_argument("--update", action="store_true", help="Write the thresholds from this run")
+    args = parser.parse_args()
+
+    thresholds = None
+    if not args.update:
+        if not os.path.exists(args.thresholds):
+            print(f"ERROR: {args.thresholds} not found - record a reference run with --update")
+            sys.exit(2)
+        with open(args.thresholds) as f:
+            thresholds = json.load(f)
+        if thresholds.get("sweeps", args.sweeps) != args.sweeps:
+            print(f"WARNING: thresholds were recorded with --sweeps {thresholds['sweeps']}")
+
+    try:
+        results = asyncio.run(measure(args))
+    except (DeviceError, OSError, asyncio.TimeoutError) as e:
+        print(f"ERROR: {type(e).__name__}: {e}")
+        sys.exit(2)
+    if not results:
+        print("ERROR: no workload results")
+        sys.exit(2)
+
+    if args.update:
+        with open(args.thresholds, "w") as f:
+            json.dump(make_thresholds(results), f, indent=2)
+            f.write("\n")
+        check(results, make_thresholds(results))
+        print(f"\nThresholds written to {args.thresholds}")
+        sys.exit(0)
+
+    passed = check(results, thresholds)
+    print(f"\n{'PASS' if passed else 'FAIL'}")
+    sys.exit(0 if passed else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,488 @@
+#!/usr/bin/env python3
+"""
+BioPal Host Library
+One asyncio API for driving BioPal boards over USB serial or BLE, so test
+rigs and tools do not scrape console text each in their own way:
+
+  SerialDevice  tagged serial commands ("#<tag> <command>", answered
+                @OK / @ERR), @EVT lines and the binary export frames
+  BleDevice     RX / TX characteristics with FRAMING:1 and FORMAT:BIN -
+                text replies reassembled from their chunks, DUT rows from
+                binary notifications
+
+Both give typed commands (start, measure, stop, preset, status, fetch_session)
+and deliver results on one event queue. Binary formats are decoded straight
+from the received buffers, no copies of the payload - by the firmware's own
+decoders in the host SDK (biopal_sdk.py, "pio run -e sdk") when it is built,
+else by memoryview + struct.unpack_from. Several devices run side by side in
+one event loop:
+
+  async with SerialDevice("/dev/ttyACM0") as a, SerialDevice("/dev/ttyACM1") as b:
+      await asyncio.gather(a.run(5), b.run(5))
+
+Usage:
+  python biopal_host.py --port /dev/ttyACM0 --port /dev/ttyACM1 run 5 --csv-dir out
+  python biopal_host.py --port COM5 status
+  python biopal_host.py --ble AA:BB:CC:DD:EE:FF preset screen4
+  python biopal_host.py --ble AA:BB:CC:DD:EE:FF session 1791990042 2
+  python biopal_host.py --wifi 192.168.4.1 history
+  python biopal_host.py --wifi 192.168.4.1 history --cache history.bin   # new sessions only
+"""
+
+import argparse
+import asyncio
+import json
+import os
+import struct
+import sys
+import threading
+
+import biopal_sdk
+from cal_compile import SWEEP_FREQUENCIES
+from history_decode import decode_image, image_id, merge_sync, sync_refs
+from usb_export_decode import ExportDecoder, export_to_csv_lines
+
+# Must match include/BLE_Functions.h
+DEVICE_NAME = "BioPal"
+RX_UUID = "12345678-1234-5678-1234-56789abcdef1"
+TX_UUID = "12345678-1234-5678-1234-56789abcdef2"
+BIN_MAGIC = 0xB1
+TEXT_CHUNK_MAGIC = 0xB2
+BIN_TYPE_DATA = 0x01
+BIN_TYPE_POINT = 0x02
+BIN_FLAG_SPREAD = 0x01
+BIN_FLAG_FINAL = 0x02
+BIN_FLAG_END = 0x04             # Last part of a delivered DUT - stands for DUT_END
+BIN_FREQ_OFFGRID = 0x8000
+BIN_OFFGRID_STEP_HZ = 10
+BIN_MAG_LOG_MIN = -1.0
+BIN_MAG_LOG_SCALE = 8192.0
+BIN_PHASE_SCALE = 100.0
+BIN_HEADER = struct.Struct("<BBBBBBBB")
+BIN_POINT = struct.Struct("<HHh")
+BIN_SPREAD_POINT = struct.Struct("<HHhBB")
+CHUNK_HEADER = struct.Struct("<BBHH")
+CHUNK_MESSAGES_KEPT = 16        # Framed messages the device can still resend
+
+COMMAND_TIMEOUT_S = 10.0
+
+# The firmware's decoders when the SDK is built, else the Python ones
+SDK = biopal_sdk.load()
+decode_history = SDK.decode_history if SDK is not None else decode_image
+
+
+class DeviceError(Exception):
+    """A command refused by the device (@ERR reason or ERROR: text)"""
+
+
+def bin_frequency(code):
+    if code & BIN_FREQ_OFFGRID:
+        return (code & ~BIN_FREQ_OFFGRID) * BIN_OFFGRID_STEP_HZ
+    return SWEEP_FREQUENCIES[code] if code < len(SWEEP_FREQUENCIES) else 0
+
+
+class ImpedancePacket:
+    """One binary DATA / live point notification, decoded in place"""
+
+    def __init__(self, data):
+        self.view = memoryview(data)
+        (self.magic, self.type, self.dut, self.flags,
+         self.part, self.parts, self.count, self.total) = BIN_HEADER.unpack_from(self.view)
+        self.point = BIN_SPREAD_POINT if self.flags & BIN_FLAG_SPREAD else BIN_POINT
+
+    @property
+    def final(self):
+        return bool(self.flags & BIN_FLAG_FINAL)
+
+    def valid(self):
+        return (self.magic == BIN_MAGIC and self.type in (BIN_TYPE_DATA, BIN_TYPE_POINT) and
+                len(self.view) >= BIN_HEADER.size + self.count * self.point.size)
+
+    def points(self):
+        """(freq_hz, |Z|, phase) per point"""
+        if SDK is not None:
+            decoded = SDK.decode_packet(self.view)
+            for freq, mag, phase, _, _ in decoded[1] if decoded is not None else []:
+                yield freq, mag, phase
+            return
+        for k in range(self.count):
+            fields = self.point.unpack_from(self.view, BIN_HEADER.size + k * self.point.size)
+            yield (bin_frequency(fields[0]), 10 ** (fields[1] / BIN_MAG_LOG_SCALE + BIN_MAG_LOG_MIN),
+                   fields[2] / BIN_PHASE_SCALE)
+
+
+class Device:
+    """Transport-independent part: the event queue and the typed commands"""
+
+    def __init__(self, name):
+        self.name = name
+        self.events = asyncio.Queue()   # (kind, payload): text, event, export, row, session
+        self.lock = asyncio.Lock()      # One command at a time per device
+
+    async def __aenter__(self):
+        await self.open()
+        return self
+
+    async def __aexit__(self, *exc):
+        await self.close()
+
+    def post(self, kind, payload):
+        self.events.put_nowait((kind, payload))
+
+    async def next_event(self, kinds, timeout=None, predicate=None):
+        """Next event of one of kinds (others are dropped); (kind, payload)"""
+        while True:
+            kind, payload = await asyncio.wait_for(self.events.get(), timeout)
+            if kind in kinds and (predicate is None or predicate(payload)):
+                return kind, payload
+
+
+class SerialDevice(Device):
+    """A board on USB serial - tagged commands, @EVT lines, export frames"""
+
+    def __init__(self, port, baud=115200):
+        super().__init__(port)
+        self.port = port
+        self.baud = baud
+        self.serial = None
+        self.loop = None
+        self.reader = None
+        self.decoder = ExportDecoder(on_text=self.on_text)
+        self.text = ""
+        self.tag = 0
+        self.pending = None             # [tag, future, output lines] of the command in flight
+
+    async def open(self):
+        import serial
+
+        self.loop = asyncio.get_running_loop()
+        self.serial = serial.Serial(self.port, self.baud, timeout=0.05)
+        self.serial.reset_input_buffer()
+        self.reader = threading.Thread(target=self.read_loop, daemon=True)
+        self.reader.start()
+
+    async def close(self):
+        if self.serial is not None:
+            self.serial.close()
+            self.serial = None
+
+    def read_loop(self):
+        while self.serial is not None:
+            try:
+                data = self.serial.read(4096)
+            except Exception:
+                break
+            if data:
+                self.loop.call_soon_threadsafe(self.feed, data)
+
+    def feed(self, data):
+        for export in self.decoder.feed(data):
+            self.post("export", export)
+
+    def on_text(self, text):
+        self.text += text
+        *lines, self.text = self.text.split("\n")
+        for line in lines:
+            self.on_line(line.rstrip("\r"))
+
+    def on_line(self, line):
+        pending = self.pending
+        tag = pending[0] if pending is not None else None
+        if line.startswith("@EVT "):
+            self.post("event", line[5:].split())
+        elif tag is not None and (line == f"@OK {tag}" or line.startswith(f"@ERR {tag} ")):
+            if not pending[1].done():
+                if line.startswith("@OK"):
+                    pending[1].set_result(pending[2])
+                else:
+                    pending[1].set_exception(DeviceError(line.split(" ", 2)[2]))
+        elif pending is not None:
+            pending[2].append(line)
+        else:
+            self.post("text", line)
+
+    async def command(self, text, timeout=COMMAND_TIMEOUT_S):
+        """Run one console command; its output lines, DeviceError on @ERR"""
+        async with self.lock:
+            self.tag += 1
+            future = self.loop.create_future()
+            self.pending = [str(self.tag), future, []]
+            self.serial.write(f"#{self.tag} {text}\n".encode())
+            try:
+                return await asyncio.wait_for(future, timeout)
+            finally:
+                self.pending = None
+
+    async def start(self, duts=None):
+        await self.command("start" if duts is None else f"start {duts}")
+
+    async def measure(self, duts=None):
+        # The console starts a final sweep once a baseline is stored
+        await self.start(duts)
+
+    async def stop(self):
+        await self.command("stop")
+
+    async def preset(self, name):
+        await self.command(f"preset {name}")
+
+    async def status(self):
+        """The @STATUS line as a dict"""
+        for line in await self.command("status"):
+            if line.startswith("@STATUS "):
+                return dict(field.split("=", 1) for field in line.split()[1:] if "=" in field)
+        raise DeviceError("no @STATUS line")
+
+    async def export(self, timeout=COMMAND_TIMEOUT_S):
+        """The stored rows, as usb_export_decode.ExportDecoder gives them"""
+        await self.command("export", timeout)
+        _, export = await self.next_event(("export",), timeout)
+        return export
+
+    async def fetch_session(self, timestamp, dut):
+        raise DeviceError("sessions are fetched over BLE or Wi-Fi (fetch_history)")
+
+    async def run(self, sweeps, duts=None, on_export=None, timeout=None):
+        """Run sweeps back to back ("run"); the export of each, in order"""
+        await self.command(f"run {sweeps}" if duts is None else f"run {sweeps} {duts}")
+        exports = []
+        while True:
+            kind, payload = await self.next_event(("export", "event"), timeout)
+            if kind == "export":
+                exports.append(payload)
+                if on_export is not None:
+                    on_export(payload)
+            elif payload[0] == "run_end":
+                if payload[3] != "done":
+                    raise DeviceError(f"run ended: {payload[3]}")
+                return exports
+
+
+class BleDevice(Device):
+    """A board over BLE - FRAMING:1 text, FORMAT:BIN rows"""
+
+    def __init__(self, address=None):
+        super().__init__(address or DEVICE_NAME)
+        self.address = address
+        self.client = None
+        self.chunks = {}                # Message ID -> {chunk: bytes}, newest CHUNK_MESSAGES_KEPT
+        self.rows = {}                  # (dut, final) -> [packets]
+        self.replies = asyncio.Queue()
+
+    async def open(self):
+        from bleak import BleakClient, BleakScanner
+
+        address = self.address
+        if address is None:
+            device = await BleakScanner.find_device_by_name(DEVICE_NAME, timeout=10.0)
+            if device is None:
+                raise DeviceError(f"'{DEVICE_NAME}' not found")
+            address = device.address
+        self.client = BleakClient(address)
+        await self.client.connect()
+        await self.client.start_notify(TX_UUID, self.on_notify)
+        await self.request("FRAMING:1", ("STATUS:Framing",))
+        await self.request("FORMAT:BIN", ("STATUS:Format",))
+
+    async def close(self):
+        if self.client is not None:
+            await self.client.disconnect()
+            self.client = None
+
+    def on_notify(self, _sender, data):
+        view = memoryview(data)
+        if len(view) >= CHUNK_HEADER.size and view[0] == TEXT_CHUNK_MAGIC:
+            self.on_chunk(view)
+        elif len(view) >= BIN_HEADER.size and view[0] == BIN_MAGIC:
+            self.on_binary(ImpedancePacket(data))
+
+    def on_chunk(self, view):
+        _, message, chunk, chunks = CHUNK_HEADER.unpack_from(view)
+        parts = self.chunks.setdefault(message, {})
+        parts[chunk] = view[CHUNK_HEADER.size:]
+        if len(parts) == chunks:
+            del self.chunks[message]
+            self.on_text(b"".join(parts[i] for i in range(chunks)).decode(errors="replace"))
+        while len(self.chunks) > CHUNK_MESSAGES_KEPT:
+            # Out of the device's resend window - never completes
+            del self.chunks[next(iter(self.chunks))]
+
+    def on_binary(self, packet):
+        if not packet.valid() or packet.type != BIN_TYPE_DATA:
+            return
+        key = (packet.dut, packet.final)
+        if packet.part == 0:
+            self.rows[key] = []
+        parts = self.rows.setdefault(key, [])
+        parts.append(packet)
+        if len(parts) == packet.parts:
+            del self.rows[key]
+            points = [point for p in parts for point in p.points()]
+            # delivered: sent at the DUT's DUT_END (else a GET_DATA reply)
+            self.post("row", {"dut": packet.dut, "sweep": "final" if packet.final else "baseline",
+                              "points": points, "delivered": bool(packet.flags & BIN_FLAG_END)})
+
+    def on_text(self, text):
+        if text.startswith("STATUS:") or text.startswith("ERROR:") or text.startswith("HISTORY:"):
+            self.replies.put_nowait(text)
+        if text.startswith("HISTORY:"):
+            self.post("session", json.loads(text[8:]))
+        else:
+            self.post("text", text)
+
+    async def request(self, text, accept, timeout=COMMAND_TIMEOUT_S):
+        """Write a command; the first reply starting with one of accept"""
+        async with self.lock:
+            while not self.replies.empty():
+                self.replies.get_nowait()
+            await self.client.write_gatt_char(RX_UUID, text.encode(), response=True)
+            while True:
+                reply = await asyncio.wait_for(self.replies.get(), timeout)
+                if reply.startswith("ERROR:"):
+                    raise DeviceError(reply[6:])
+                if reply.startswith(accept):
+                    return reply
+
+    async def start(self, duts=None):
+        await self.request("BASELINE_START" if duts is None else f"BASELINE_START,{duts}",
+                           ("STATUS:Measuring",))
+
+    async def measure(self):
+        await self.request("MEAS_START", ("STATUS:Measuring",))
+
+    async def stop(self):
+        await self.request("STOP", ("STATUS:Stopped",))
+
+    async def preset(self, name):
+        await self.request(f"PRESET:{name}", ("STATUS:Measuring",))
+
+    async def status(self):
+        raise DeviceError("the state is only reported over serial (status)")
+
+    async def fetch_session(self, timestamp, dut):
+        """One archived session: the HISTORY document (ts, dut, kind, freq, mag, phase, ...)"""
+        reply = await self.request(f"HISTORY:{timestamp},{dut}", ("HISTORY:",))
+        return json.loads(reply[8:])
+
+    async def next_row(self, timeout=None):
+        """Next DUT row of a sweep: dut, sweep, points as (freq_hz, |Z|, phase)"""
+        _, row = await self.next_event(("row",), timeout)
+        return row
+
+
+async def fetch_history(host, timeout=30.0):
+    """Sessions of the whole log over Wi-Fi (GET /history), oldest first"""
+    import urllib.request
+
+    def download():
+        with urllib.request.urlopen(f"http://{host}/history", timeout=timeout) as reply:
+            return reply.read()
+
+    image = await asyncio.get_running_loop().run_in_executor(None, download)
+    return decode_history(memoryview(image))
+
+
+async def sync_history(host, path, timeout=30.0):
+    """Bring the image kept in path up to date over Wi-Fi (GET /history?after=...): only what
+    the board added since the last sync is downloaded. Returns the sessions, oldest first, and
+    the bytes downloaded"""
+    import urllib.request
+
+    held = b""
+    if os.path.exists(path):
+        with open(path, "rb") as f:
+            held = f.read()
+    sessions = decode_history(memoryview(held))
+    refs = sync_refs(sessions)
+    after = ",".join(".".join(str(v) for v in ref) for ref in refs)
+    url = f"http://{host}/history?id={image_id(held)}&offset={len(held)}&after={after}"
+
+    def download():
+        with urllib.request.urlopen(url, timeout=timeout) as reply:
+            return reply.read(), int(reply.headers["X-History-Match"]), int(reply.headers["X-History-Start"])
+
+    body, match, start = await asyncio.get_running_loop().run_in_executor(None, download)
+    image = merge_sync(held, sessions, refs, match, start, body)
+    with open(path, "wb") as f:
+        f.write(image)
+    return decode_history(memoryview(image)), len(body)
+
+
+async def drive(device, args):
+    async with device:
+        if args.action == "status":
+            print(device.name, await device.status())
+        elif args.action == "stop":
+            await device.stop()
+        elif args.action == "preset":
+            await device.preset(args.name)
+            print(f"{device.name}: preset {args.name} started")
+        elif args.action == "session":
+            print(json.dumps(await device.fetch_session(args.timestamp, args.dut)))
+        elif args.action == "run":
+            count = [0]
+
+            def save(export):
+                count[0] += 1
+                if args.csv_dir:
+                    base = os.path.basename(device.name).replace(":", "")
+                    path = os.path.join(args.csv_dir, f"{base}_{count[0]:03d}.csv")
+                    with open(path, "w") as f:
+                        f.write("\n".join(export_to_csv_lines(export)) + "\n")
+                print(f"{device.name}: sweep {count[0]}/{args.sweeps}", file=sys.stderr)
+
+            await device.run(args.sweeps, args.duts, on_export=save)
+
+
+async def main_async(args):
+    if args.wifi:
+        if getattr(args, "cache", None):
+            sessions, downloaded = await sync_history(args.wifi, args.cache)
+            print(f"{downloaded} bytes downloaded", file=sys.stderr)
+        else:
+            sessions = await fetch_history(args.wifi)
+        for s in sessions:
+            print(f"{s['timestamp']:>10}  DUT {s['dut']:2}  {s['kind']:<8}  {len(s['points']):2} points")
+        return 0
+    devices = [SerialDevice(port, args.baud) for port in args.port or []]
+    devices += [BleDevice(address) for address in args.ble or []]
+    if not devices:
+        raise SystemExit("ERROR: give --port, --ble or --wifi")
+    if args.csv_dir:
+        os.makedirs(args.csv_dir, exist_ok=True)
+    results = await asyncio.gather(*(drive(d, args) for d in devices), return_exceptions=True)
+    failed = 0
+    for device, result in zip(devices, results):
+        if isinstance(result, Exception):
+            print(f"{device.name}: {type(result).__name__}: {result}", file=sys.stderr)
+            failed += 1
+    return 1 if failed else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Drive one or more BioPal boards")
+    parser.add_argument("--port", action="append", help="Serial port (repeat for more boards)")
+    parser.add_argument("--ble", action="append", help="BLE address (repeat for more boards)")
+    parser.add_argument("--wifi", help="Board address for the Wi-Fi history download")
+    parser.add_argument("--baud", type=int, default=115200)
+    actions = parser.add_subparsers(dest="action")
+    run = actions.add_parser("run", help="Sweeps back to back (serial)")
+    run.add_argument("sweeps", type=int)
+    run.add_argument("--duts", type=int)
+    run.add_argument("--csv-dir", help="Write each sweep's export as CSV here")
+    actions.add_parser("status", help="The @STATUS line (serial)")
+    actions.add_parser("stop")
+    preset = actions.add_parser("preset", help="Start a stored preset's baseline")
+    preset.add_argument("name")
+    session = actions.add_parser("session", help="Fetch one archived session (BLE)")
+    session.add_argument("timestamp", type=int)
+    session.add_argument("dut", type=int)
+    history = actions.add_parser("history", help="List the sessions of the log (--wifi)")
+    history.add_argument("--cache", help="Image kept from the last sync - only new sessions are downloaded")
+    args = parser.parse_args()
+    args.csv_dir = getattr(args, "csv_dir", None)
+    return asyncio.run(main_async(args))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""
+BioPal Host SDK Bindings
+ctypes bindings of the host SDK (include/biopal_sdk.h), the firmware's own
+decoders built for the host by [env:sdk]:
+
+  index_uart_frames  STM32 UART stream -> frames (uart_frame.cpp)
+  decode_history     session history image -> sessions (session_codec.cpp),
+                     same dicts as history_decode.decode_image()
+  decode_packet      BLE binary notification -> header and points
+
+Buffers are handed to the library in place (bytes, bytearray or writable
+memoryview) and frame payloads come back as memoryview slices of them, so
+nothing is copied on the way in or out.
+
+  pio run -e sdk
+  python biopal_sdk.py history.bin             # sessions of a history image
+  python biopal_sdk.py --uart stream.bin       # frames of a captured UART stream
+
+load() returns None when the library is not built; biopal_host.py then
+falls back to the Python decoders.
+"""
+
+import argparse
+import ctypes
+import os
+import sys
+
+SDK_VERSION = 1                 # BIOPAL_SDK_VERSION
+MAX_FREQUENCIES = 38
+SESSION_NO_REFERENCE = 0xFFFFFFFF
+KIND_NAMES = {0: "baseline", 1: "final"}
+
+SEARCH_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), ".pio", "build", "sdk")
+LIBRARY_NAMES = ("libbiopal_sdk.so", "libbiopal_sdk.dylib", "libbiopal_sdk.dll")
+
+
+class SessionPoint(ctypes.Structure):
+    _pack_ = 1
+    _fields_ = [("freq_hz", ctypes.c_uint32), ("mag", ctypes.c_float), ("phase", ctypes.c_float),
+                ("flags", ctypes.c_uint8)]
+
+
+class SessionHeader(ctypes.Structure):
+    _pack_ = 1
+    _fields_ = [("magic", ctypes.c_uint32), ("timestamp", ctypes.c_uint32), ("dut", ctypes.c_uint8),
+                ("kind", ctypes.c_uint8), ("count", ctypes.c_uint8), ("risk", ctypes.c_uint8),
+                ("riskPercent", ctypes.c_float), ("offset", ctypes.c_uint32), ("reference", ctypes.c_uint32),
+                ("bytes", ctypes.c_uint16), ("crc", ctypes.c_uint16)]
+
+
+class Session(ctypes.Structure):
+    _fields_ = [("header", SessionHeader), ("points", SessionPoint * MAX_FREQUENCIES)]
+
+
+class UARTFrameCounters(ctypes.Structure):
+    _fields_ = [("framesParsed", ctypes.c_uint32), ("bytesSkipped", ctypes.c_uint32),
+                ("v2Frames", ctypes.c_uint32), ("crcErrors", ctypes.c_uint32), ("resyncs", ctypes.c_uint32)]
+
+
+class BiopalFrame(ctypes.Structure):
+    _fields_ = [("offset", ctypes.c_uint32), ("len", ctypes.c_uint16), ("type", ctypes.c_uint8),
+                ("v2", ctypes.c_uint8)]
+
+
+class BiopalPoint(ctypes.Structure):
+    _fields_ = [("freq_hz", ctypes.c_uint32), ("mag", ctypes.c_float), ("phase", ctypes.c_float),
+                ("magSd", ctypes.c_uint8), ("phaseSd", ctypes.c_uint8)]
+
+
+class BLEBinaryHeader(ctypes.Structure):
+    _pack_ = 1
+    _fields_ = [(name, ctypes.c_uint8) for name in ("magic", "type", "dut", "flags", "part", "parts",
+                                                     "count", "total")]
+
+
+def _pointer(data):
+    """(pointer, length, view) of a buffer without copying it - the view keeps it alive"""
+    if isinstance(data, bytes):
+        return ctypes.cast(ctypes.c_char_p(data), ctypes.c_void_p), len(data), memoryview(data)
+    view = memoryview(data)
+    if view.readonly and isinstance(view.obj, bytes) and view.nbytes == len(view.obj):
+        return _pointer(view.obj)
+    if view.readonly:
+        # ctypes only maps writable buffers - a read-only slice is copied once
+        data = bytes(view)
+        return ctypes.cast(ctypes.c_char_p(data), ctypes.c_void_p), len(data), memoryview(data)
+    return ctypes.cast((ctypes.c_char * view.nbytes).from_buffer(view), ctypes.c_void_p), view.nbytes, view
+
+
+class SDK:
+    def __init__(self, lib):
+        self.lib = lib
+        lib.biopalSdkVersion.restype = ctypes.c_int
+        lib.biopalIndexUARTFrames.restype = ctypes.c_size_t
+        lib.biopalIndexUARTFrames.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.POINTER(BiopalFrame),
+                                              ctypes.c_size_t, ctypes.POINTER(ctypes.c_size_t),
+                                              ctypes.POINTER(UARTFrameCounters)]
+        lib.biopalHistoryOpen.restype = ctypes.c_void_p
+        lib.biopalHistoryOpen.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+        lib.biopalHistoryClose.argtypes = [ctypes.c_void_p]
+        lib.biopalHistoryNext.restype = ctypes.c_bool
+        lib.biopalHistoryNext.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.POINTER(SessionHeader)),
+                                          ctypes.POINTER(ctypes.c_size_t), ctypes.POINTER(Session)]
+        lib.biopalDecodeBinaryPacket.restype = ctypes.c_int
+        lib.biopalDecodeBinaryPacket.argtypes = [ctypes.c_void_p, ctypes.c_size_t,
+                                                 ctypes.POINTER(ctypes.POINTER(BLEBinaryHeader)),
+                                                 ctypes.POINTER(BiopalPoint)]
+        self.points = (BiopalPoint * MAX_FREQUENCIES)()
+
+    def index_uart_frames(self, data, counters=None):
+        """([(type, v2, payload memoryview)], bytes consumed) - a trailing partial frame is left"""
+        ptr, length, view = _pointer(data)
+        consumed = ctypes.c_size_t()
+        capacity = length // 8 + 16
+        while True:
+            frames = (BiopalFrame * capacity)()
+            scan = UARTFrameCounters()
+            found = self.lib.biopalIndexUARTFrames(ptr, length, frames, capacity, ctypes.byref(consumed),
+                                                   ctypes.byref(scan))
+            if found <= capacity:
+                break
+            capacity = found
+        if counters is not None:
+            # Only the scan that filled the index counts
+            for name, _ in UARTFrameCounters._fields_:
+                setattr(counters, name, getattr(counters, name) + getattr(scan, name))
+        return [(f.type, bool(f.v2), view[f.offset:f.offset + f.len]) for f in frames[:found]], consumed.value
+
+    def decode_history(self, image):
+        """Sessions of a history image as history_decode.decode_image() gives them, oldest first"""
+        ptr, length, keep = _pointer(image)     # Headers point into it until the end
+        history = self.lib.biopalHistoryOpen(ptr, length)
+        sessions = []
+        try:
+            header = ctypes.POINTER(SessionHeader)()
+            pos = ctypes.c_size_t()
+            out = Session()
+            while self.lib.biopalHistoryNext(history, ctypes.byref(header), ctypes.byref(pos), ctypes.byref(out)):
+                h = header.contents
+                points = [(p.freq_hz, p.mag, p.phase, p.flags) for p in out.points[:h.count]]
+                size = ctypes.sizeof(SessionHeader) + h.bytes
+                sessions.append({"timestamp": h.timestamp, "dut": h.dut, "kind": KIND_NAMES.get(h.kind, str(h.kind)),
+                                 "risk": h.risk, "risk_percent": h.riskPercent, "bytes": size,
+                                 "delta": h.reference != SESSION_NO_REFERENCE, "points": points, "crc": h.crc,
+                                 "end": pos.value + size})
+        finally:
+            self.lib.biopalHistoryClose(history)
+        return sessions
+
+    def decode_packet(self, data):
+        """(BLEBinaryHeader, [(freq_hz, |Z|, phase, mag_sd, phase_sd)]) of a DATA / POINT notification,
+        None if it is not one"""
+        ptr, length, keep = _pointer(data)
+        header = ctypes.POINTER(BLEBinaryHeader)()
+        count = self.lib.biopalDecodeBinaryPacket(ptr, length, ctypes.byref(header), self.points)
+        if count < 0:
+            return None
+        return (BLEBinaryHeader.from_buffer_copy(ctypes.string_at(header, ctypes.sizeof(BLEBinaryHeader))),
+                [(p.freq_hz, p.mag, p.phase, p.magSd, p.phaseSd) for p in self.points[:count]])
+
+
+def load(path=None):
+    """The SDK from path, $BIOPAL_SDK or the [env:sdk] build; None if there is none"""
+    candidates = [path] if path else []
+    if os.environ.get("BIOPAL_SDK"):
+        candidates.append(os.environ["BIOPAL_SDK"])
+    candidates += [os.path.join(SEARCH_DIR, name) for name in LIBRARY_NAMES]
+    for candidate in candidates:
+        if not os.path.exists(candidate):
+            continue
+        lib = ctypes.CDLL(candidate)
+        if lib.biopalSdkVersion() != SDK_VERSION:
+            print(f"WARNING: {candidate} is SDK version {lib.biopalSdkVersion()}, "
+                  f"expected {SDK_VERSION} - rebuild with: pio run -e sdk", file=sys.stderr)
+            continue
+        return SDK(lib)
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode BioPal captures with the host SDK")
+    parser.add_argument("file", help="History image, or a UART stream with --uart")
+    parser.add_argument("--uart", action="store_true", help="The file is a captured STM32 UART stream")
+    parser.add_argument("--lib", help="SDK library (default: .pio/build/sdk)")
+    args = parser.parse_args()
+
+    sdk = load(args.lib)
+    if sdk is None:
+        print("ERROR: host SDK not found - build it with: pio run -e sdk")
+        return 2
+    with open(args.file, "rb") as f:
+        data = f.read()
+
+    if args.uart:
+        counters = UARTFrameCounters()
+        frames, consumed = sdk.index_uart_frames(data, counters)
+        by_type = {}
+        for frame_type, _, _ in frames:
+            by_type[frame_type] = by_type.get(frame_type, 0) + 1
+        for frame_type, count in sorted(by_type.items()):
+            print(f"type 0x{frame_type:02X}: {count}")
+        print(f"{len(frames)} frames ({counters.v2Frames} v2), {counters.crcErrors} CRC errors, "
+              f"{counters.resyncs} resyncs, {len(data) - consumed} bytes left")
+        return 0
+
+    sessions = sdk.decode_history(data)
+    for s in sessions:
+        print(f"{s['timestamp']:>10}  DUT {s['dut']:2}  {s['kind']:<8}  {len(s['points']):2} points"
+              f"  {s['bytes']:3} B{' delta' if s['delta'] else ''}")
+    print(f"{len(sessions)} sessions in {len(data)} bytes", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
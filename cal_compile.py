@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+BioPal Calibration Compiler
+Reads the calibration CSVs in data/ (voltage, tia_high/low, pga_*, ps_trace),
+validates them against the firmware sweep table and writes the binary
+calibration image flashed to the "calib" partition (see include/cal_image.h).
+
+Every problem is reported with file and line, and the image is only written
+when the data is complete. Malformed CSVs are caught on the host, before they
+reach the device.
+
+Usage:
+  python cal_compile.py                          # data/ -> cal_image.bin
+  python cal_compile.py --data data --out build/cal_image.bin
+  python cal_compile.py --allow-missing          # missing stages -> invalid entries
+"""
+
+import argparse
+import binascii
+import os
+import struct
+import sys
+
+# Must match sweepFrequencies in src/sweep_table.cpp
+SWEEP_FREQUENCIES = [
+    100000, 80000, 62500, 50000, 25000, 15625, 12500, 10000,
+    6250, 5000, 4000, 3125, 2500, 2000, 1250, 1000,
+    800, 625, 500, 400, 250, 200, 160, 125,
+    100, 80, 50, 40, 32, 25, 20, 16,
+    10, 8, 5, 4, 2, 1,
+]
+
+# Must match include/cal_image.h
+IMAGE_MAGIC = 0x4C414342  # "BCAL"
+IMAGE_VERSION = 1
+HEADER_FORMAT = "<IHHHBBHHIHH"
+ENTRY_FORMAT = "<ff?3x"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+ENTRY_SIZE = struct.calcsize(ENTRY_FORMAT)
+
+PGA_GAINS = [1, 2, 5, 10, 20, 50, 100, 200]
+
+# Index 1 = tia_gain flag set, which the firmware calibrates with tia_low.csv
+TIA_FILES = ["tia_high.csv", "tia_low.csv"]
+
+
+def crc16_ccitt(data):
+    """CRC-16/CCITT-FALSE, as crc16_ccitt() in src/crc.cpp"""
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+class CalStage:
+    """One calibration CSV: {sweep index: (gain, phase_offset)}"""
+
+    def __init__(self, path, freq_scale):
+        self.path = path
+        self.name = os.path.basename(path)
+        self.freq_scale = freq_scale
+        self.points = {}
+        self.errors = []
+
+    def load(self):
+        if not os.path.exists(self.path):
+            self.errors.append(f"{self.name}: file not found")
+            return self
+
+        with open(self.path, newline="") as f:
+            for lineno, line in enumerate(f, 1):
+                line = line.strip()
+                # Same skip rules as the firmware loaders
+                if not line or line.startswith("#") or line.lower().startswith("freq"):
+                    continue
+                self._parse_line(line, lineno)
+        return self
+
+    def _parse_line(self, line, lineno):
+        where = f"{self.name}:{lineno}"
+        fields = line.split(",")
+        if len(fields) != 3:
+            self.errors.append(f"{where}: expected 3 fields (freq,gain,phase_offset), got {len(fields)}")
+            return
+        try:
+            freq, gain, phase = (float(x) for x in fields)
+        except ValueError:
+            self.errors.append(f"{where}: non-numeric value in '{line}'")
+            return
+
+        freq_hz = round(freq * self.freq_scale)
+        if freq_hz not in SWEEP_FREQUENCIES:
+            self.errors.append(f"{where}: {freq_hz} Hz is not a sweep frequency")
+            return
+        idx = SWEEP_FREQUENCIES.index(freq_hz)
+        if idx in self.points:
+            self.errors.append(f"{where}: duplicate entry for {freq_hz} Hz")
+            return
+        if gain == 0.0:
+            self.errors.append(f"{where}: zero gain at {freq_hz} Hz")
+            return
+        self.points[idx] = (gain, phase)
+
+    def missing(self):
+        return [SWEEP_FREQUENCIES[i] for i in range(len(SWEEP_FREQUENCIES)) if i not in self.points]
+
+
+def load_stages(data_dir):
+    """Load all stages - frequencies are kHz except ps_trace.csv (Hz)"""
+    voltage = CalStage(os.path.join(data_dir, "voltage.csv"), 1000).load()
+    tia = [CalStage(os.path.join(data_dir, name), 1000).load() for name in TIA_FILES]
+    pga = [CalStage(os.path.join(data_dir, f"pga_{g}.csv"), 1000).load() for g in PGA_GAINS]
+    ps_trace = CalStage(os.path.join(data_dir, "ps_trace.csv"), 1).load()
+    return voltage, tia, pga, ps_trace
+
+
+def build_entries(voltage, tia, pga, ps_trace):
+    """Fuse the stages exactly as buildCalibrationLUT() does"""
+    entries = []
+    for f in range(len(SWEEP_FREQUENCIES)):
+        v = voltage.points.get(f)
+        ps_gain, ps_phase = ps_trace.points.get(f, (1.0, 0.0))
+        for t in range(2):
+            tc = tia[t].points.get(f)
+            for p in range(8):
+                pc = pga[p].points.get(f)
+                if v and tc and pc:
+                    gain = tc[0] * pc[0] / v[0] * ps_gain
+                    phase = -v[1] + tc[1] + pc[1] + ps_phase
+                    entries.append(struct.pack(ENTRY_FORMAT, gain, phase, True))
+                else:
+                    entries.append(struct.pack(ENTRY_FORMAT, 1.0, 0.0, False))
+    return entries
+
+
+def build_image(entries):
+    payload = struct.pack(f"<{len(SWEEP_FREQUENCIES)}I", *SWEEP_FREQUENCIES) + b"".join(entries)
+    fields = [IMAGE_MAGIC, IMAGE_VERSION, HEADER_SIZE, len(SWEEP_FREQUENCIES), 2, 8,
+              ENTRY_SIZE, 0, len(payload), crc16_ccitt(payload)]
+    header_body = struct.pack(HEADER_FORMAT[:-1], *fields)
+    header = header_body + struct.pack("<H", crc16_ccitt(header_body))
+    return header + payload
+
+
+def compile_calibration(data_dir, out_path, allow_missing=False):
+    """Validate and compile - returns True if the image was written"""
+    voltage, tia, pga, ps_trace = load_stages(data_dir)
+    required = [voltage] + tia + pga
+
+    errors = []
+    warnings = []
+    for stage in required + [ps_trace]:
+        errors.extend(stage.errors)
+
+    for stage in required:
+        missing = stage.missing()
+        if missing and not stage.errors:
+            msg = f"{stage.name}: no data for {', '.join(str(m) for m in missing)} Hz"
+            (warnings if allow_missing else errors).append(msg)
+
+    # PS Trace is an optional refinement - missing frequencies keep gain 1, offset 0
+    if not ps_trace.errors and ps_trace.missing():
+        warnings.append(f"{ps_trace.name}: no data for {len(ps_trace.missing())} frequencies (not applied there)")
+
+    for w in warnings:
+        print(f"WARNING: {w}")
+    if errors:
+        for e in errors:
+            print(f"ERROR: {e}")
+        print(f"✗ Calibration image not written ({len(errors)} error(s))")
+        return False
+
+    entries = build_entries(voltage, tia, pga, ps_trace)
+    image = build_image(entries)
+
+    out_dir = os.path.dirname(out_path)
+    if out_dir:
+        os.makedirs(out_dir, exist_ok=True)
+    with open(out_path, "wb") as f:
+        f.write(image)
+
+    valid = sum(1 for e in entries if e[8])
+    print(f"✓ Calibration image written to {out_path} ({len(image)} bytes, {valid}/{len(entries)} entries valid)")
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile BioPal calibration CSVs into a flash image")
+    parser.add_argument("--data", default="data", help="Directory with the calibration CSVs")
+    parser.add_argument("--out", default="cal_image.bin", help="Output image path")
+    parser.add_argument("--allow-missing", action="store_true",
+                        help="Write invalid entries for missing frequencies instead of failing")
+    args = parser.parse_args()
+
+    if not compile_calibration(args.data, args.out, args.allow_missing):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+BioPal Calibration Upload over BLE
+Sends a compiled calibration image (cal_compile.py) to the device's
+calibration characteristic. The device streams it into the "calib" partition,
+validates it and switches to it before the next sweep - no USB, no reboot.
+
+Frame format and replies: include/cal_upload.h
+
+Usage:
+  python cal_upload_ble.py                       # compile data/ and upload to "BioPal"
+  python cal_upload_ble.py --image cal_image.bin
+  python cal_upload_ble.py --address AA:BB:CC:DD:EE:FF
+"""
+
+import argparse
+import asyncio
+import os
+import struct
+import sys
+import tempfile
+
+from bleak import BleakClient, BleakScanner
+
+from cal_compile import compile_calibration, crc16_ccitt
+
+# Must match include/BLE_Functions.h
+DEVICE_NAME = "BioPal"
+TX_UUID = "12345678-1234-5678-1234-56789abcdef2"
+CAL_UUID = "12345678-1234-5678-1234-56789abcdef3"
+
+# Must match include/cal_upload.h
+FRAME_BEGIN = 0x01
+FRAME_DATA = 0x02
+FRAME_END = 0x03
+FRAME_ABORT = 0x04
+FRAME_MAX = 512
+FRAME_OVERHEAD = 5
+CHUNK_SIZE = FRAME_MAX - FRAME_OVERHEAD
+
+REPLY_TIMEOUT_S = 5.0
+RETRIES = 3
+
+
+def build_frame(frame_type, seq, payload=b""):
+    body = struct.pack("<BH", frame_type, seq) + payload
+    return body + struct.pack("<H", crc16_ccitt(body))
+
+
+class Uploader:
+    def __init__(self, client):
+        self.client = client
+        self.replies = asyncio.Queue()
+
+    def on_notify(self, _sender, data):
+        text = bytes(data).decode(errors="replace")
+        if text.startswith("CAL_ACK:") or text.startswith("ERROR:"):
+            self.replies.put_nowait(text)
+
+    async def send(self, frame_type, seq, payload=b""):
+        """Send one frame and wait for its CAL_ACK - retried on timeout"""
+        frame = build_frame(frame_type, seq, payload)
+        for _ in range(RETRIES):
+            await self.client.write_gatt_char(CAL_UUID, frame, response=True)
+            try:
+                reply = await asyncio.wait_for(self.replies.get(), REPLY_TIMEOUT_S)
+            except asyncio.TimeoutError:
+                continue
+            if reply == f"CAL_ACK:{seq}":
+                return
+            raise RuntimeError(reply)
+        raise RuntimeError(f"no reply to frame {seq}")
+
+    async def upload(self, image):
+        await self.client.start_notify(TX_UUID, self.on_notify)
+        try:
+            await self.send(FRAME_BEGIN, 0, struct.pack("<I", len(image)))
+            chunks = [image[i:i + CHUNK_SIZE] for i in range(0, len(image), CHUNK_SIZE)]
+            for seq, chunk in enumerate(chunks):
+                await self.send(FRAME_DATA, seq, chunk)
+                print(f"\r  {min((seq + 1) * CHUNK_SIZE, len(image))}/{len(image)} bytes", end="")
+            print()
+            await self.send(FRAME_END, len(chunks))
+        except Exception:
+            await self.client.write_gatt_char(CAL_UUID, build_frame(FRAME_ABORT, 0), response=True)
+            raise
+        finally:
+            await self.client.stop_notify(TX_UUID)
+
+
+async def run(args, image):
+    address = args.address
+    if address is None:
+        print(f"Scanning for '{DEVICE_NAME}'...")
+        device = await BleakScanner.find_device_by_name(DEVICE_NAME, timeout=10.0)
+        if device is None:
+            sys.exit(f"ERROR: '{DEVICE_NAME}' not found")
+        address = device.address
+
+    async with BleakClient(address) as client:
+        print(f"Connected to {address}, uploading {len(image)} bytes")
+        await Uploader(client).upload(image)
+    print("✓ Calibration uploaded - active from the next sweep")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Upload a BioPal calibration image over BLE")
+    parser.add_argument("--image", help="Compiled image (default: compile --data first)")
+    parser.add_argument("--data", default="data", help="Directory with the calibration CSVs")
+    parser.add_argument("--address", help="BLE address (default: scan for BioPal)")
+    args = parser.parse_args()
+
+    if args.image:
+        with open(args.image, "rb") as f:
+            image = f.read()
+    else:
+        path = os.path.join(tempfile.gettempdir(), "biopal_cal_image.bin")
+        if not compile_calibration(args.data, path):
+            sys.exit(1)
+        with open(path, "rb") as f:
+            image = f.read()
+
+    try:
+        asyncio.run(run(args, image))
+    except RuntimeError as e:
+        sys.exit(f"✗ Upload failed: {e}")
+
+
+if __name__ == "__main__":
+    main()
@@ -3,6 +3,10 @@
 ESP32 BioPal Data Capture Tool
 Captures impedance data from ESP32 and exports to CSV and PS Trace .pssession format
 OR converts existing CSV file to .pssession format
+
+Firmware with "export pssession" writes the .pssession itself (over USB:
+usb_export_decode.py --pssession, over Wi-Fi: GET /session.pssession) - the
+conversion here is for CSV captures of older firmware
 """
 
 import serial
@@ -13,12 +17,15 @@ import os
 from datetime import datetime
 import math
 import argparse
+from usb_export_decode import ExportDecoder, export_to_csv_lines
 
 class ESP32DataCapture:
     def __init__(self):
         self.ser = None
         self.capturing_csv = False
         self.csv_lines = []
+        # Binary export frames (sent after each sweep); log text goes to process_line
+        self.decoder = ExportDecoder(on_text=self.process_text)
 
     def list_serial_ports(self):
         """List all available serial ports"""
@@ -50,8 +57,20 @@ class ESP32DataCapture:
         else:
             print("ERROR: Serial port not open")
 
+    def process_text(self, text):
+        """Log text between export frames, line by line"""
+        for line in text.splitlines(keepends=True):
+            self.process_line(line)
+
+    def process_export(self, export):
+        """Save the rows of the sweep that just completed"""
+        sweep = "final" if export["final_done"] else "baseline"
+        self.csv_lines = export_to_csv_lines(export, (sweep,))
+        print(f"\n=== Received {sweep} export: {len(self.csv_lines) - 1} points ===")
+        self.save_data()
+
     def process_line(self, line):
-        """Process incoming line from ESP32"""
+        """Process incoming line from ESP32 ('export csv' text is still recognised)"""
         # Check for CSV data markers
         if "========== IMPEDANCE DATA CSV ==========" in line:
             self.capturing_csv = True
@@ -76,9 +95,16 @@ class ESP32DataCapture:
     def parse_csv_data(self):
         """Parse CSV lines into structured data"""
         data = []
+        # 'export csv' lists both sweeps - the .pssession takes one of them
+        header = self.csv_lines[0].split(',') if self.csv_lines else []
+        sweep_col = header.index('Sweep') if 'Sweep' in header else -1
+        sweeps = [line.split(',')[sweep_col] for line in self.csv_lines[1:]] if sweep_col >= 0 else []
+        keep = 'final' if 'final' in sweeps else 'baseline'
 
         for line in self.csv_lines[1:]:  # Skip header line
             parts = line.split(',')
+            if 0 <= sweep_col < len(parts) and parts[sweep_col] != keep:
+                continue
             if len(parts) >= 4:
                 try:
                     dut = int(parts[0])
@@ -355,6 +381,7 @@ AMPLITUDE=1.000E-002
         print("\n=== Commands ===")
         print("start [num_duts]  - Start measurement (e.g., 'start 4')")
         print("stop              - Stop measurement")
+        print("export            - Resend the stored rows")
         print("help              - Show ESP32 help")
         print("quit              - Exit program")
         print("\nType commands below (output from ESP32 will be mirrored):\n")
@@ -395,11 +422,11 @@ AMPLITUDE=1.000E-002
                 except queue.Empty:
                     pass
 
-                # Read from serial port
+                # Read from serial port - binary frames and log text
                 if self.ser.in_waiting > 0:
                     try:
-                        line = self.ser.readline().decode('utf-8', errors='ignore')
-                        self.process_line(line)
+                        for export in self.decoder.feed(self.ser.read(self.ser.in_waiting)):
+                            self.process_export(export)
                     except Exception as e:
                         print(f"ERROR reading serial: {e}")
 
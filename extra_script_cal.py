@@ -0,0 +1,56 @@
+"""
+PlatformIO hook for the calibration compiler (cal_compile.py)
+
+- buildfs / uploadfs: compile data/*.csv into $BUILD_DIR/cal_image.bin first,
+  so a malformed CSV fails the build instead of showing up at runtime
+- uploadcal: compile and flash the image to the "calib" partition
+
+  pio run -t buildfs
+  pio run -t uploadcal
+"""
+
+import csv
+import os
+import sys
+
+Import("env")  # noqa: F821 - provided by PlatformIO
+
+sys.path.insert(0, env.subst("$PROJECT_DIR"))  # noqa: F821
+from cal_compile import compile_calibration  # noqa: E402
+
+DATA_DIR = os.path.join(env.subst("$PROJECT_DIR"), "data")  # noqa: F821
+IMAGE_PATH = os.path.join(env.subst("$BUILD_DIR"), "cal_image.bin")  # noqa: F821
+
+
+def calib_partition_offset():
+    """Offset of the "calib" partition from the board's partition table"""
+    name = env.GetProjectOption("board_build.partitions", "partitions.csv")  # noqa: F821
+    table = os.path.join(env.subst("$PROJECT_DIR"), name)  # noqa: F821
+    with open(table, newline="") as f:
+        for row in csv.reader(line for line in f if not line.lstrip().startswith("#")):
+            if row and row[0].strip() == "calib":
+                return row[3].strip()
+    sys.exit("ERROR: no 'calib' partition in " + table)
+
+
+def compile_image(*args, **kwargs):
+    if not compile_calibration(DATA_DIR, IMAGE_PATH):
+        env.Exit(1)  # noqa: F821
+
+
+env.AddPreAction("buildfs", compile_image)  # noqa: F821
+env.AddPreAction("uploadfs", compile_image)  # noqa: F821
+
+upload_port = env.subst("$UPLOAD_PORT")  # noqa: F821
+env.AddCustomTarget(  # noqa: F821
+    name="uploadcal",
+    dependencies=None,
+    actions=[
+        compile_image,
+        '"$PYTHONEXE" "$UPLOADER" --chip $BOARD_MCU'
+        + (f' --port "{upload_port}"' if upload_port else "")
+        + f' write_flash {calib_partition_offset()} "{IMAGE_PATH}"',
+    ],
+    title="Upload Calibration Image",
+    description="Compile data/*.csv and flash the calibration image partition",
+)
@@ -0,0 +1,23 @@
+"""
+PlatformIO pre-build hook for the splash logo compiler (logo_compile.py)
+
+Regenerates include/logo_image.h from assets/logo.h before the sources are
+compiled whenever the raw logo is newer, so the firmware always embeds the
+compressed image of the current logo.
+"""
+
+import os
+import sys
+
+Import("env")  # noqa: F821 - provided by PlatformIO
+
+PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+sys.path.insert(0, PROJECT_DIR)
+from logo_compile import compile_logo  # noqa: E402
+
+SOURCE_PATH = os.path.join(PROJECT_DIR, "assets", "logo.h")
+HEADER_PATH = os.path.join(PROJECT_DIR, "include", "logo_image.h")
+
+if not os.path.exists(HEADER_PATH) or os.path.getmtime(SOURCE_PATH) > os.path.getmtime(HEADER_PATH):
+    if not compile_logo(SOURCE_PATH, HEADER_PATH):
+        env.Exit(1)  # noqa: F821
@@ -0,0 +1,19 @@
+"""
+PlatformIO hook of [env:sdk]: link the host SDK (src/biopal_sdk.cpp) as a
+shared library instead of a program, named for the platform's loader, so
+biopal_sdk.py finds it at .pio/build/sdk/libbiopal_sdk.so (.dylib, .dll)
+"""
+
+import sys
+
+Import("env")  # noqa: F821 - provided by PlatformIO
+
+if sys.platform == "win32":
+    SUFFIX = ".dll"
+elif sys.platform == "darwin":
+    SUFFIX = ".dylib"
+else:
+    SUFFIX = ".so"
+
+env.Append(CCFLAGS=["-fPIC"], LINKFLAGS=["-shared"])  # noqa: F821
+env.Replace(PROGNAME="libbiopal_sdk", PROGSUFFIX=SUFFIX)  # noqa: F821
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+BioPal Golden-Accuracy Fixture
+Builds the fixture of the golden-accuracy suite (test/test_golden_accuracy,
+"pio test -e native"): the calibration table compiled from data/, the
+recorded STM32 sweeps decoded as the UART handler does, and the PalmSens
+reference measurement of the same DUT (.pssession) at each point.
+
+The suite runs the points through the firmware calibration pipeline (float
+path and fixed-point kernel) and holds the per-band tolerances and the list
+of known failures - this script only converts the recordings. Regenerate the
+fixture when data/ or a case changes and commit it with the change.
+
+Usage:
+  python golden_accuracy.py                   # write the fixture from data/ and the built-in cases
+  python golden_accuracy.py --check           # exit 1 if the committed fixture is out of date
+  python golden_accuracy.py --image cal_image.bin --out /tmp/golden_data.h
+  pio test -e native -f test_golden_accuracy
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+import tempfile
+
+from cal_compile import HEADER_SIZE, ENTRY_FORMAT, ENTRY_SIZE, SWEEP_FREQUENCIES, compile_calibration
+from stm_to_impedance import parse_stm_csv, normalize_phase
+
+DEFAULT_FIXTURE = os.path.join("test", "test_golden_accuracy", "golden_data.h")
+
+# (STM32 listing, PalmSens reference of the same DUT)
+CASES = [
+    ("STM_output.csv", "PBS 1x DUT 1_2.pssession"),
+]
+
+# PalmSens dataset array types
+ARRAY_FREQUENCY = 5
+ARRAY_PHASE = 6
+ARRAY_Z = 10
+
+
+def load_pssession(path):
+    """{freq_hz: (|Z|, phase_deg)} of the first measurement, phase in device convention"""
+    with open(path, "rb") as f:
+        raw = f.read()
+    text = raw.decode("utf-16") if raw[:2] in (b"\xff\xfe", b"\xfe\xff") else raw.decode("utf-8-sig")
+    # The JSON is followed by trailing bytes - decode the first object only
+    session, _ = json.JSONDecoder().raw_decode(text.lstrip("﻿"))
+
+    arrays = {}
+    for array in session["measurements"][0]["dataset"]["values"]:
+        arrays[array.get("arraytype")] = [v["v"] for v in array["datavalues"]]
+    if not all(t in arrays for t in (ARRAY_FREQUENCY, ARRAY_Z, ARRAY_PHASE)):
+        raise ValueError(f"{path}: no frequency/Z/phase arrays in the first measurement")
+
+    # PalmSens reports -phase
+    return {round(f): (z, -p) for f, z, p in zip(arrays[ARRAY_FREQUENCY], arrays[ARRAY_Z], arrays[ARRAY_PHASE])}
+
+
+def load_image_lut(path):
+    """[(gain, phase_offset, valid)] of a compiled calibration image, sweep-table order"""
+    with open(path, "rb") as f:
+        image = f.read()
+    offset = HEADER_SIZE + 4 * len(SWEEP_FREQUENCIES)
+    count = len(SWEEP_FREQUENCIES) * 2 * 8
+    if len(image) < offset + count * ENTRY_SIZE:
+        raise ValueError(f"{path}: not a calibration image for {len(SWEEP_FREQUENCIES)} frequencies")
+    return [struct.unpack_from(ENTRY_FORMAT, image, offset + i * ENTRY_SIZE) for i in range(count)]
+
+
+def case_points(stm_path, ref_path):
+    """Fixture rows of one case - points without a reference frequency are left out"""
+    reference = load_pssession(ref_path)
+    rows = []
+    for dut, freq, v_mag, v_phase, i_mag, i_phase, pga, tia, valid in parse_stm_csv(stm_path):
+        if freq not in reference:
+            continue
+        # Same scaling as stm_to_impedance.py: mV and centidegrees
+        phase = normalize_phase(v_phase / 100.0 - i_phase / 100.0)
+        ref_z, ref_phase = reference[freq]
+        rows.append((dut, freq, v_mag / 1000.0, phase, i_mag / 1000.0, pga, tia, valid, ref_z, ref_phase))
+    return rows
+
+
+def render_fixture(lut, cases, source):
+    lines = [
+        "// Golden-accuracy fixture - generated by golden_accuracy.py, do not edit",
+        f"// Calibration: {source}",
+    ]
+    lines += [f"// Case: {stm} vs {ref}" for stm, ref, _ in cases]
+    lines += [
+        "#ifndef GOLDEN_DATA_H",
+        "#define GOLDEN_DATA_H",
+        "",
+        '#include "cal_apply.h"',
+        "",
+        "// A recorded point as the UART handler decodes it, and the PalmSens |Z| and phase",
+        "struct GoldenPoint {",
+        "    const char* reference;",
+        "    uint8_t dut;",
+        "    uint32_t freq_hz;",
+        "    float v_mag;",
+        "    float phase_deg;        // V - I",
+        "    float i_mag;",
+        "    uint8_t pga;",
+        "    bool tia;               // High TIA",
+        "    bool valid;",
+        "    float ref_z;",
+        "    float ref_phase;",
+        "};",
+        "",
+        "static const CalLUTRow goldenCalibration[SWEEP_FREQ_COUNT] = {",
+    ]
+    for f, hz in enumerate(SWEEP_FREQUENCIES):
+        lines.append(f"    {{   // {hz} Hz")
+        for t in range(2):
+            entries = lut[(f * 2 + t) * 8:(f * 2 + t + 1) * 8]
+            body = ", ".join(f"{{{g:.9g}f, {p:.9g}f, {'true' if ok else 'false'}, {{0, 0, 0}}}}"
+                             for g, p, ok in entries)
+            lines.append(f"        {{{body}}},")
+        lines.append("    },")
+    lines += ["};", "", "static const GoldenPoint goldenPoints[] = {"]
+    for _, ref, rows in cases:
+        for dut, freq, v, phase, i, pga, tia, valid, ref_z, ref_phase in rows:
+            lines.append(f'    {{"{ref}", {dut}, {freq}, {v:.9g}f, {phase:.4f}f, {i:.9g}f, {pga}, '
+                         f"{'true' if tia else 'false'}, {'true' if valid else 'false'}, "
+                         f"{ref_z:.6g}f, {ref_phase:.4f}f}},")
+    lines += [
+        "};",
+        "",
+        "#define GOLDEN_POINT_COUNT  (sizeof(goldenPoints) / sizeof(goldenPoints[0]))",
+        "",
+        "#endif // GOLDEN_DATA_H",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the golden-accuracy fixture from PalmSens references")
+    parser.add_argument("--image", help="Calibration image (default: compile data/)")
+    parser.add_argument("--data", default="data", help="Calibration CSVs when no --image is given")
+    parser.add_argument("--out", default=DEFAULT_FIXTURE, help="Fixture header to write")
+    parser.add_argument("--check", action="store_true", help="Only compare with the existing fixture")
+    args = parser.parse_args()
+
+    try:
+        if args.image:
+            lut = load_image_lut(args.image)
+            source = os.path.basename(args.image)
+        else:
+            with tempfile.TemporaryDirectory() as tmp:
+                image = os.path.join(tmp, "cal_image.bin")
+                if not compile_calibration(args.data, image):
+                    sys.exit(2)
+                lut = load_image_lut(image)
+            source = f"{args.data}/ (cal_compile.py)"
+        cases = [(stm, ref, case_points(stm, ref)) for stm, ref in CASES]
+    except (OSError, ValueError) as e:
+        print(f"ERROR: {e}")
+        sys.exit(2)
+
+    for stm, ref, rows in cases:
+        print(f"{stm} vs {ref}: {len(rows)} points")
+    fixture = render_fixture(lut, cases, source)
+
+    if args.check:
+        try:
+            with open(args.out, newline="") as f:
+                current = f.read()
+        except OSError:
+            current = None
+        if current != fixture:
+            print(f"FAIL: {args.out} is out of date - run python golden_accuracy.py")
+            sys.exit(1)
+        print(f"{args.out} is up to date")
+        return
+
+    with open(args.out, "w", newline="\n") as f:
+        f.write(fixture)
+    print(f"Wrote {args.out}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+BioPal Session History Decoder
+Decodes the session image of the bulk history download (BLE history service,
+or "GET /history" over Wi-Fi) into sessions: the records of
+SESSION_LOG_OLD_FILE followed by those of SESSION_LOG_FILE, each a header
+and its coded points (include/session_log.h).
+
+Usage:
+  curl -o history.bin http://biopal.local/history
+  python history_decode.py history.bin                   # one line per session
+  python history_decode.py history.bin --csv points.csv  # every point
+"""
+
+import argparse
+import csv
+import math
+import struct
+import sys
+
+from usb_export_decode import crc16_ccitt
+
+# Must match include/session_log.h
+SESSION_MAGIC = 0x33534553
+HEADER_FORMAT = "<IIBBBBfIIHH"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+MAG_STEPS_PER_LN = 8192
+PHASE_STEP_DEG = 0.01
+NO_REFERENCE = 0xFFFFFFFF
+MAX_FREQUENCIES = 38
+KIND_NAMES = {0: "baseline", 1: "final"}
+KIND_CODES = {name: code for code, name in KIND_NAMES.items()}
+SYNC_REFS = 4               # HISTORY_SYNC_REFS (include/history_download.h)
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = shift = 0
+        while True:
+            if self.pos >= len(self.data) or shift > 28:
+                raise ValueError("coded points cut short")
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7F) << shift
+            if not byte & 0x80:
+                return value
+            shift += 7
+
+    def signed(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+
+def mag_code(mag):
+    return round(math.log(mag) * MAG_STEPS_PER_LN)
+
+
+def phase_code(phase):
+    return round(phase / PHASE_STEP_DEG)
+
+
+def decode_points(count, data, ref):
+    """Points (freq_hz, mag, phase, flags) of one record; ref as decoded, or None"""
+    r = Reader(data)
+    points = []
+    freq = mag = phase = 0
+    for i in range(count):
+        if ref is None:
+            freq += r.signed()
+        mag += r.signed()
+        phase += r.signed()
+        if ref is not None:
+            rf, rm, rp, _ = ref[i]
+            points.append([rf, math.exp((mag + mag_code(rm)) / MAG_STEPS_PER_LN),
+                           (phase + phase_code(rp)) * PHASE_STEP_DEG, 0])
+        else:
+            points.append([freq, math.exp(mag / MAG_STEPS_PER_LN), phase * PHASE_STEP_DEG, 0])
+    masks = [0] * count
+    for _ in range(r.varint()):
+        i = r.varint()
+        masks[i] = r.varint()
+    for i in range(count):
+        base = ref[i][3] if ref is not None else points[i - 1][3] if i > 0 else 0
+        points[i][3] = base ^ masks[i]
+    if r.pos != len(data):
+        raise ValueError("extra bytes after the points")
+    return [tuple(p) for p in points]
+
+
+def decode_image(image):
+    """Sessions of an image (bytes or memoryview) as dicts, oldest first; damaged records are skipped"""
+    sessions = []
+    decoded = {}        # Image offset -> points, for references
+    pos = 0
+    while pos + HEADER_SIZE <= len(image):
+        fields = struct.unpack_from(HEADER_FORMAT, image, pos)
+        magic, timestamp, dut, kind, count, risk, risk_percent, offset, reference, size, crc = fields
+        end = pos + HEADER_SIZE + size
+        if magic != SESSION_MAGIC or offset > pos or count > MAX_FREQUENCIES or end > len(image):
+            pos += 1
+            continue
+        # CRC over the header with crc 0, then the points - no copy of a memoryview image
+        data = image[pos + HEADER_SIZE:end]
+        if crc16_ccitt(data, crc16_ccitt(bytes(image[pos:pos + HEADER_SIZE - 2]) + b"\0\0")) != crc:
+            pos += 1
+            continue
+        # References are offsets in the record's own file
+        ref = None
+        if reference != NO_REFERENCE:
+            ref = decoded.get(pos - offset + reference)
+        try:
+            if reference == NO_REFERENCE or ref is not None:
+                points = decode_points(count, data, ref)
+                decoded[pos] = points
+                sessions.append({"timestamp": timestamp, "dut": dut, "kind": KIND_NAMES.get(kind, str(kind)),
+                                 "risk": risk, "risk_percent": risk_percent, "bytes": HEADER_SIZE + size,
+                                 "delta": ref is not None, "points": points, "crc": crc, "end": end})
+        except ValueError:
+            pass
+        pos = end
+    return sessions
+
+
+def image_id(image):
+    """Generation of an image as the board names it: the first record's timestamp, 0 if none"""
+    if len(image) < HEADER_SIZE:
+        return 0
+    magic, timestamp = struct.unpack_from("<II", image, 0)
+    return timestamp if magic == SESSION_MAGIC else 0
+
+
+def sync_refs(sessions):
+    """The newest sessions of a decoded image, newest first, as HistorySessionRef tuples
+    (timestamp, dut, kind code, crc) for a history sync"""
+    return [(s["timestamp"], s["dut"], KIND_CODES.get(s["kind"], 0), s["crc"])
+            for s in reversed(sessions[-SYNC_REFS:])]
+
+
+def merge_sync(held, sessions, refs, match, start, body):
+    """The board's image after a sync: what matched of the held image, then the new bytes"""
+    if match == 0:
+        return bytes(held[:start]) + body
+    if 1 <= match <= len(refs):
+        # The named record ends at start in the board's image - keep the held bytes before it
+        end = next(s["end"] for s in reversed(sessions) if (s["timestamp"], s["dut"], KIND_CODES.get(s["kind"], 0),
+                                                   s["crc"]) == refs[match - 1])
+        if end < start:
+            raise ValueError("held image is shorter than the synced prefix")
+        return bytes(held[end - start:end]) + body
+    return body
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a BioPal session history image")
+    parser.add_argument("image", help="Image file from the history download")
+    parser.add_argument("--csv", help="Write every point to this CSV file")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    sessions = decode_image(image)
+    for s in sessions:
+        risk = f"  risk {s['risk']} ({s['risk_percent']:.1f}%)" if s["kind"] == "final" else ""
+        print(f"{s['timestamp']:>10}  DUT {s['dut']:2}  {s['kind']:<8}  {len(s['points']):2} points"
+              f"{risk}  {s['bytes']:3} B{' delta' if s['delta'] else ''}")
+    if sessions:
+        print(f"{len(sessions)} sessions in {len(image)} bytes "
+              f"({len(sessions) * 512 / max(len(image), 1):.1f}x smaller than 512-byte records)", file=sys.stderr)
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["timestamp", "dut", "kind", "freq_hz", "mag", "phase", "flags"])
+            for s in sessions:
+                for freq, mag, phase, flags in s["points"]:
+                    writer.writerow([s["timestamp"], s["dut"], s["kind"], freq, f"{mag:.4f}", f"{phase:.2f}", flags])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
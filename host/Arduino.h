@@ -0,0 +1,121 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/*=========================HOST ARDUINO CORE=========================*/
+// Just enough of the Arduino core for the host render build ([env:render]
+// in platformio.ini): the GUI modules and the bundled TFT_eSPI compile
+// unchanged against it. Pins and delays are no-ops, time is the host clock
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "esp_timer.h"
+#include "Print.h"
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH            1
+#define LOW             0
+#define INPUT           0x01
+#define OUTPUT          0x03
+#define INPUT_PULLUP    0x05
+
+#define PROGMEM
+#define PSTR(s)                 (s)
+#define pgm_read_byte(addr)     (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t*)(addr))
+// The fonts keep pointers in their tables and read them as dwords -
+// pointer-sized here
+#define pgm_read_dword(addr)    (*(const uintptr_t*)(addr))
+#define pgm_read_ptr(addr)      (*(void* const*)(addr))
+
+#define IRAM_ATTR
+
+#define digitalPinToBitMask(pin)    (1UL << ((pin) & 31))
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline void delay(uint32_t) {}
+inline void delayMicroseconds(uint32_t) {}
+inline void yield() {}
+
+inline long random(long max) {
+    return max > 0 ? rand() % max : 0;
+}
+
+inline long random(long min, long max) {
+    return min < max ? min + random(max - min) : min;
+}
+
+inline char* ltoa(long value, char* text, int base) {
+    if (base == 10) {
+        sprintf(text, "%ld", value);
+    } else {
+        sprintf(text, base == 16 ? "%lx" : "%lo", (unsigned long)value);
+    }
+    return text;
+}
+
+inline unsigned long micros() {
+    return (unsigned long)esp_timer_get_time();
+}
+
+inline unsigned long millis() {
+    return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+class String {
+public:
+    String(const char* text = "") : text(text ? text : "") {}
+    String(const std::string& text) : text(text) {}
+
+    const char* c_str() const { return text.c_str(); }
+    unsigned int length() const { return text.length(); }
+
+    void toCharArray(char* buffer, unsigned int size, unsigned int index = 0) const {
+        if (size == 0) {
+            return;
+        }
+        size_t n = index < text.length() ? std::min((size_t)size - 1, text.length() - index) : 0;
+        memcpy(buffer, text.data() + index, n);
+        buffer[n] = '\0';
+    }
+
+    int indexOf(char c) const {
+        size_t at = text.find(c);
+        return at == std::string::npos ? -1 : (int)at;
+    }
+
+    String substring(unsigned int from, unsigned int to = UINT32_MAX) const {
+        return from < text.length() ? String(text.substr(from, to - from)) : String();
+    }
+
+    long toInt() const { return atol(text.c_str()); }
+
+    String& operator+=(const String& other) {
+        text += other.text;
+        return *this;
+    }
+
+    bool operator==(const char* other) const { return text == other; }
+
+private:
+    std::string text;
+};
+
+inline size_t Print::print(const String& text) {
+    return write(text.c_str());
+}
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,30 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+/*=========================HOST FS=========================*/
+// File of the host render build - never open (see LittleFS.h)
+#include "Arduino.h"
+
+namespace fs {
+
+class File : public Print {
+public:
+    explicit operator bool() const { return false; }
+
+    size_t write(uint8_t) override { return 0; }
+    size_t write(const uint8_t*, size_t) override { return 0; }
+    using Print::write;
+
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t read(uint8_t*, size_t) { return 0; }
+    size_t size() const { return 0; }
+    String readStringUntil(char) { return String(); }
+    void close() {}
+};
+
+}
+
+using fs::File;
+
+#endif // HOST_FS_H
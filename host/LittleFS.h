@@ -0,0 +1,20 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+/*=========================HOST LITTLEFS=========================*/
+// The host render build has no file system: every open fails, so modules
+// that load their settings at boot keep the defaults
+#include "FS.h"
+
+class HostLittleFS {
+public:
+    bool begin(bool = false) { return false; }
+    void end() {}
+    bool exists(const char*) { return false; }
+    bool remove(const char*) { return false; }
+    File open(const char*, const char* = "r") { return File(); }
+};
+
+inline HostLittleFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
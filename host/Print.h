@@ -0,0 +1,61 @@
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+/*=========================HOST PRINT=========================*/
+// Arduino Print for the host render build - everything formats into write()
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+class String;
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t* data, size_t len) {
+        size_t n = 0;
+        while (len-- > 0) {
+            n += write(*data++);
+        }
+        return n;
+    }
+
+    size_t write(const char* text) {
+        return text ? write((const uint8_t*)text, strlen(text)) : 0;
+    }
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char line[256];
+        va_list args;
+        va_start(args, fmt);
+        int len = vsnprintf(line, sizeof(line), fmt, args);
+        va_end(args);
+        if (len <= 0) {
+            return 0;
+        }
+        return write((const uint8_t*)line, len < (int)sizeof(line) ? len : sizeof(line) - 1);
+    }
+
+    size_t print(const char* text) { return write(text); }
+    size_t print(const String& text);
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned int value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+
+    size_t println() { return write('\n'); }
+
+    template <typename T>
+    size_t println(const T& value) {
+        size_t n = print(value);
+        return n + println();
+    }
+};
+
+#endif // HOST_PRINT_H
@@ -0,0 +1,29 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+/*=========================HOST SPI=========================*/
+// The host render build's TFT_eSPI writes straight into the panel model
+// (TFT_eSPI/Processors/TFT_eSPI_Host.h) - this bus only has to exist
+#include <stdint.h>
+
+#define MSBFIRST    1
+#define SPI_MODE0   0
+
+struct SPISettings {
+    SPISettings(uint32_t = 0, uint8_t = MSBFIRST, uint8_t = SPI_MODE0) {}
+};
+
+class SPIClass {
+public:
+    void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+    void end() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    void setFrequency(uint32_t) {}
+    uint8_t transfer(uint8_t) { return 0; }
+    uint16_t transfer16(uint16_t) { return 0; }
+};
+
+inline SPIClass SPI;
+
+#endif // HOST_SPI_H
@@ -0,0 +1,11 @@
+#ifndef HOST_DRIVER_UART_H
+#define HOST_DRIVER_UART_H
+
+/*=========================HOST UART DRIVER=========================*/
+// Port numbers of the UART driver, for the declarations in UART_Functions.h
+typedef int uart_port_t;
+
+#define UART_NUM_0  0
+#define UART_NUM_1  1
+
+#endif // HOST_DRIVER_UART_H
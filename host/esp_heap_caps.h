@@ -0,0 +1,34 @@
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+/*=========================HOST HEAP CAPS=========================*/
+// Capability allocations of the host render build - all from the C heap
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_DMA          (1 << 3)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+
+inline void* heap_caps_malloc(size_t size, unsigned int) {
+    return malloc(size);
+}
+
+inline void* heap_caps_calloc(size_t n, size_t size, unsigned int) {
+    return calloc(n, size);
+}
+
+inline void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+// A C6 after boot - the render takes its largest tier
+inline size_t heap_caps_get_free_size(unsigned int) {
+    return 256 * 1024;
+}
+
+inline size_t heap_caps_get_largest_free_block(unsigned int) {
+    return 128 * 1024;
+}
+
+#endif // HOST_ESP_HEAP_CAPS_H
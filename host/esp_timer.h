@@ -0,0 +1,14 @@
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+/*=========================HOST ESP TIMER=========================*/
+// esp_timer_get_time() of the host render build - the host's steady clock
+#include <stdint.h>
+#include <chrono>
+
+inline int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // HOST_ESP_TIMER_H
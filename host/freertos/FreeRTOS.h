@@ -0,0 +1,28 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+/*=========================HOST FREERTOS=========================*/
+// Types of the FreeRTOS API the GUI headers declare - the host render build
+// runs single-threaded and never creates a queue, task or semaphore
+#include <stdint.h>
+
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              pdTRUE
+#define portMAX_DELAY       (TickType_t)0xFFFFFFFF
+#define portTICK_PERIOD_MS  1
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+
+typedef struct HostQueue* QueueHandle_t;
+typedef struct HostQueue* SemaphoreHandle_t;
+typedef struct HostEventGroup* EventGroupHandle_t;
+typedef struct HostTask* TaskHandle_t;
+typedef uint32_t EventBits_t;
+typedef void (*TaskFunction_t)(void*);
+typedef uint8_t StackType_t;
+
+#endif // HOST_FREERTOS_H
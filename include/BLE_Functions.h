@@ -6,20 +6,77 @@
 #include <BLEUtils.h>
 #include <BLEServer.h>
 #include <BLE2902.h>
+#include <BLESecurity.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/message_buffer.h"
+#include "freertos/semphr.h"
 #include "defines.h"
+#include "sweep_table.h"
+#include "ble_binary.h"
 
 // BLE UUIDs for BioPal service
 #define BLE_SERVICE_UUID        "12345678-1234-5678-1234-56789abcdef0"
 #define BLE_CHARACTERISTIC_RX   "12345678-1234-5678-1234-56789abcdef1"  // WebUI -> ESP32
 #define BLE_CHARACTERISTIC_TX   "12345678-1234-5678-1234-56789abcdef2"  // ESP32 -> WebUI
+#define BLE_CHARACTERISTIC_CAL  "12345678-1234-5678-1234-56789abcdef3"  // Calibration image upload (cal_upload.h)
+#define BLE_CHARACTERISTIC_OTA  "12345678-1234-5678-1234-56789abcdef4"  // Firmware update (ota_update.h)
+
+// Bulk session history download (history_download.h)
+#define BLE_HISTORY_SERVICE_UUID        "12345678-1234-5678-1234-56789abcdf00"
+#define BLE_CHARACTERISTIC_HIST_CTRL    "12345678-1234-5678-1234-56789abcdf01"  // Requests
+#define BLE_CHARACTERISTIC_HIST_DATA    "12345678-1234-5678-1234-56789abcdf02"  // INFO / BLOCK / ERROR frames
 
 // BLE device name
 #define BLE_DEVICE_NAME "BioPal"
 
+// Pairing: LE Secure Connections with bonding and MITM protection - the
+// client enters this passkey once, the bond is kept across reboots. Only
+// the OTA characteristic requires it (ota_update.h), the others stay open
+// to unpaired clients. Set a device's own passkey in build_flags
+#ifndef BLE_PAIRING_PASSKEY
+#define BLE_PAIRING_PASSKEY     246810
+#endif
+
 // BLE command types
 #define BLE_CMD_BASELINE   "BASELINE_START"
 #define BLE_CMD_STOP    "STOP"
 #define BLE_CMD_MEAS    "MEAS_START"
+#define BLE_CMD_STATS   "STATS"
+#define BLE_CMD_GET_DATA    "GET_DATA"        // GET_DATA / GET_DATA:<dut 1-n> (current session, requester only)
+#define BLE_CMD_COUNTERS    "COUNTERS"        // COUNTERS / COUNTERS:RESET (counters.h)
+#define BLE_CMD_CAL_RELOAD  "CAL_RELOAD"
+#define BLE_CMD_FAST_SCREEN "FAST_SCREEN"     // FAST_SCREEN:1 / FAST_SCREEN:0
+#define BLE_CMD_METRICS     "METRICS"         // METRICS[:<mask>,<marker>,<split lo>,<split hi>,<thresholds..>] (spectral_metrics.h)
+#define BLE_CMD_SWEEP       "SWEEP"           // SWEEP:<0x mask | index list> / SWEEP:ALL
+#define BLE_CMD_INTERLEAVE  "INTERLEAVE"      // INTERLEAVE:1 / INTERLEAVE:0
+#define BLE_CMD_CHANNELS    "CHANNELS"        // CHANNELS:<duts>[,<points>]
+#define BLE_CMD_TIME        "TIME"            // TIME:<unix seconds>
+#define BLE_CMD_HISTORY     "HISTORY"         // HISTORY / HISTORY:<timestamp>,<dut>
+#define BLE_CMD_MONITOR     "MONITOR"         // MONITOR:<interval s> / MONITOR:0
+#define BLE_CMD_SLEEP       "SLEEP"           // SLEEP:<interval s>[,<half-life>] / SLEEP:0 / SLEEP (sleep_monitor.h)
+#define BLE_CMD_RECIPE      "RECIPE"          // RECIPE:<steps> / RECIPE:RUN / RECIPE:0 / RECIPE (recipe.h)
+#define BLE_CMD_REPEATS     "REPEATS"         // REPEATS:<1-16>
+#define BLE_CMD_ADAPTIVE    "ADAPTIVE"        // ADAPTIVE:1 / ADAPTIVE:0 (repeats per frequency from the noise)
+#define BLE_CMD_REFINE      "REFINE"          // REFINE:1 / REFINE:0 (coarse baseline, then where the spectrum bends)
+#define BLE_CMD_LOTREF      "LOTREF"          // LOTREF:1 / LOTREF:0 (baseline from the lot reference if in band, lot_reference.h)
+#define BLE_CMD_LOTREF_SAVE "LOTREF_SAVE"     // LOTREF_SAVE:<name>[,<|Z| %>,<phase deg>] - reference from the baseline
+#define BLE_CMD_RECALC      "RECALC"          // RECALC:<calc start>,<calc end>,<low>,<medium>,<high> - risk of the stored sweeps
+#define BLE_CMD_FORMAT      "FORMAT"          // FORMAT:BIN / FORMAT:JSON (DATA payload, per connection)
+#define BLE_CMD_STREAM      "STREAM"          // STREAM:1 / STREAM:0 (live binary points, per connection)
+#define BLE_CMD_FRAMING     "FRAMING"         // FRAMING:1 / FRAMING:0 (chunk headers on text, per connection)
+#define BLE_CMD_RESEND      "RESEND"          // RESEND:<message>,<chunk>[,<count>] (framed text chunks)
+#define BLE_CMD_MIRROR      "MIRROR"          // MIRROR:BLE / MIRROR:WIFI / MIRROR:0 / MIRROR (screen_mirror.h)
+#define BLE_CMD_RESUME      "RESUME"          // RESUME (token) / RESUME:<token>,<message>,<chunk> after a reconnect
+#define BLE_CMD_WIFI        "WIFI"            // WIFI:<ssid>,<passphrase> / WIFI:1 / WIFI:0 / WIFI (wifi_server.h)
+#define BLE_CMD_PRESET      "PRESET"          // PRESET:<name> / PRESET (list) (sweep_presets.h)
+#define BLE_CMD_PRESET_SAVE "PRESET_SAVE"     // PRESET_SAVE:<name>[,<BASELINE_START fields>]
+#define BLE_CMD_PRESET_DEL  "PRESET_DEL"      // PRESET_DEL:<name>
+#define BLE_CMD_FLEET       "FLEET"           // FLEET:1 / FLEET:0 / FLEET (fleet_aggregator.h)
+#define BLE_CMD_FLEET_SEND  "FLEET_SEND"      // FLEET_SEND:<peer, 0 = all>,<command>
+#define BLE_CMD_FLEET_LINK  "FLEET_LINK"      // Sent by a fleet central: it sets the connection interval
+#define BLE_CMD_THREAD      "THREAD"          // THREAD:<channel>,<PAN ID>,<ext PAN ID>,<key> / THREAD:1 / THREAD:0 / THREAD (thread_uplink.h)
+#define BLE_CMD_THREAD_DEST "THREAD_DEST"     // THREAD_DEST:<IPv6>[,<port>] - summary collector
+#define BLE_CMD_BENCH       "BLE_BENCH"       // BLE_BENCH:<bytes>[,<BIN|JSON>[,<chunk>[,<NOTIFY|INDICATE>]]] (ble_bench.h)
 
 // BLE response types
 #define BLE_RESP_STATUS     "STATUS"
@@ -28,20 +85,146 @@
 #define BLE_RESP_DUT_END    "DUT_END"
 #define BLE_RESP_COMPLETE   "COMPLETE"
 #define BLE_RESP_ERROR      "ERROR"
+#define BLE_RESP_STATS      "STATS"
+#define BLE_RESP_COUNTERS   "COUNTERS"
+#define BLE_RESP_CAL_ACK    "CAL_ACK"
+#define BLE_RESP_OTA_ACK    "OTA_ACK"
+#define BLE_RESP_RISK       "RISK"
+#define BLE_RESP_TRACK      "TRACK"
+#define BLE_RESP_FIT        "FIT"
+#define BLE_RESP_METRICS    "METRICS"
+#define BLE_RESP_KK         "KK"
+#define BLE_RESP_SESSION    "SESSION"
+#define BLE_RESP_HISTORY    "HISTORY"
+#define BLE_RESP_RESUME     "RESUME"
+
+/*=========================LINK PARAMETERS=========================*/
+// On connect the link is set up for throughput: data length extension to 251
+// bytes, LE 2M PHY (BLE 5 builds) and a short connection interval. After
+// BLE_LINK_IDLE_MS without notifications it falls back to a long interval
+// with peripheral latency; the next queued notification asks for the short
+// one again. The ATT MTU is whatever the client negotiates (onMtuChanged)
+// Intervals in 1.25 ms units, supervision timeout in 10 ms units
+#define BLE_CONN_FAST_MIN_INT   6       // 7.5 ms
+#define BLE_CONN_FAST_MAX_INT   12      // 15 ms
+#define BLE_CONN_IDLE_MIN_INT   80      // 100 ms
+#define BLE_CONN_IDLE_MAX_INT   160     // 200 ms
+#define BLE_CONN_IDLE_LATENCY   4       // Connection events the peripheral may skip when idle
+#define BLE_CONN_TIMEOUT        400     // 4 s
+#define BLE_LINK_IDLE_MS        10000
+#define BLE_DATA_LEN            251     // LL payload bytes (DLE)
+
+// Connection TX power follows the weakest client while links are fast (in
+// transfers): every BLE_RSSI_POLL_MS the TX task reads each fast client's
+// RSSI and steps one level up below BLE_RSSI_WEAK_DBM - fewer lost packets
+// and retransmissions on a far phone - or one level down above
+// BLE_RSSI_STRONG_DBM. Idle links keep their level; with no client it goes
+// back to the lowest. The controller sets one power for all connections
+// (Bluedroid gives no HCI handle per client), so the weakest link decides.
+// Advertising stays at the lowest level
+#define BLE_TX_POWER_LEVELS     { ESP_PWR_LVL_N12, ESP_PWR_LVL_N6, ESP_PWR_LVL_N0, \
+                                  ESP_PWR_LVL_P3, ESP_PWR_LVL_P6, ESP_PWR_LVL_P9 }
+#define BLE_TX_POWER_DBM        { -12, -6, 0, 3, 6, 9 }
+#define BLE_RSSI_POLL_MS        2000
+#define BLE_RSSI_WEAK_DBM       (-80)
+#define BLE_RSSI_STRONG_DBM     (-60)
+
+// Advertising intervals in 0.625 ms units. Fast for discovery; the power
+// manager switches to slow after a while without activity (power_manager.h)
+#define BLE_ADV_FAST_MIN_INT    0x20    // 20 ms
+#define BLE_ADV_FAST_MAX_INT    0x40    // 40 ms
+#define BLE_ADV_SLOW_MIN_INT    0x640   // 1 s
+#define BLE_ADV_SLOW_MAX_INT    0x6A0   // 1.06 s
+
+/*=========================TX PIPELINE=========================*/
+// sendBLEString() / sendBLEBytes() only copy the message into a TX buffer as
+// notification-sized chunks (ATT MTU - 3) and return. The BLE TX task sends
+// them (processBLETx), each once the stack has a credit free: a credit is
+// taken per notification and given back by its ESP_GATTS_CONF_EVT, and no
+// notification goes out while the link reports congestion. The pace thus
+// follows the connection interval, not a fixed delay; a confirm that never
+// comes only costs BLE_TX_CREDIT_TIMEOUT_MS
+#define BLE_TX_BUFFER_BYTES         8192    // Queued chunks (a 4 KB JSON fits twice)
+#define BLE_DATA_JSON_BYTES         (128 + MAX_FREQUENCIES * 48)    // DATA document of a full row with spread
+#define BLE_STATS_JSON_BYTES        1024    // STATS reply
+#define BLE_COUNTERS_JSON_BYTES     1536    // COUNTERS reply
+#define BLE_DATA_CACHE_SLOTS        4       // Delivered DATA messages kept for GET_DATA (~2 KB each)
+#define BLE_TX_CREDITS              4       // Notifications in flight in the stack
+#define BLE_TX_CREDIT_TIMEOUT_MS    50      // Send anyway if no confirm frees a credit
+#define BLE_TX_QUEUE_WAIT_MS        200     // Max wait for buffer space per chunk
+#define BLE_TX_CONGEST_POLL_MS      2
+
+/*=========================FRAMED TEXT=========================*/
+// After FRAMING:1 every text message to that connection goes out in chunks
+// that each start with a BLETextChunkHeader - a message ID (wraps at 256)
+// and the chunk index and count - so the client places each chunk as it
+// arrives and knows which ones are missing. The first byte is never
+// printable. Chunks are sized to the smallest MTU among the framed
+// receivers, so the TX task never splits them further
+//
+// The newest BLE_CHUNK_RETAIN_MESSAGES framed messages (at most
+// BLE_CHUNK_RETAIN_BYTES together) are kept: RESEND:<message>,<chunk>[,<count>]
+// queues those chunks again for the connection that asks, instead of the
+// whole DUT payload being sent again
+#define BLE_CHUNK_MAGIC             0xB2
+#define BLE_CHUNK_RETAIN_BYTES      8192    // Two full DATA documents and the messages around them
+#define BLE_CHUNK_RETAIN_MESSAGES   16
+
+struct __attribute__((packed)) BLETextChunkHeader {
+    uint8_t magic;          // BLE_CHUNK_MAGIC
+    uint8_t message;        // Message ID
+    uint16_t chunk;         // This chunk (0-based)
+    uint16_t chunks;        // Chunks of the message
+};
+
+/*=========================TRANSFER RESUME=========================*/
+// Each connection gets a random token (RESUME answers RESUME:<8 hex digits>).
+// When a framed connection drops, its format, streaming choice and the
+// newest message ID are kept for BLE_RESUME_KEEP_MS. After reconnecting,
+// RESUME:<token>,<message>,<chunk> - the first chunk the client is missing -
+// takes that state over and queues the rest of that message and every later
+// retained message the old connection was sent, so an interrupted DATA
+// document carries on where it stopped instead of the client asking for it
+// again. <message> one past the last one received means nothing was missed
+#define BLE_RESUME_SLOTS    BLE_MAX_CLIENTS
+#define BLE_RESUME_KEEP_MS  60000
+
+enum BLEResumeResult {
+    BLE_RESUME_OK,
+    BLE_RESUME_UNKNOWN,         // Token never issued, already used or expired
+    BLE_RESUME_NOT_RETAINED     // Settings restored, but the messages are no longer kept
+};
 
 /*=========================BLE INITIALIZATION=========================*/
 // Initialize BLE server and characteristics
 // Sets up callbacks for connection and command reception
 void initBLE();
 
+// Only the TX queue the BLE TX task waits on - for a boot that brings BLE up
+// later or not at all (sleep_monitor.h). initBLE() includes it
+void initBLETx();
+
 // Reset BLE stack completely (deinit + reinit)
 // Use this if BLE gets into stuck state
 void resetBLE();
 
 /*=========================BLE CONNECTION STATUS=========================*/
-// Check if a BLE client is currently connected
+// Up to BLE_MAX_CLIENTS clients (e.g. a bench tablet and a supervisor laptop)
+// can be connected at once. Each connection keeps its own MTU, notification
+// subscriptions, DATA format and streaming choice; advertising goes on while
+// a slot is free. Every message is encoded once and queued once, addressed
+// to the connections it is for - text is split per connection to its MTU,
+// binary notifications are sized to the smallest MTU among their receivers.
+// Command replies and status messages go to every client
+#define BLE_MAX_CLIENTS     3
+#define BLE_NO_CLIENT       (-1)    // Client slot of none
+
+// Check if at least one BLE client is connected
 bool isBLEConnected();
 
+// Connected clients
+uint8_t getBLEClientCount();
+
 // Get connection state change flag (for detecting new connections)
 bool getBLEConnectionChanged();
 
@@ -49,31 +232,110 @@ bool getBLEConnectionChanged();
 void clearBLEConnectionChanged();
 
 /*=========================BLE COMMAND PROCESSING=========================*/
-// Check if new command received and get it
-// Returns true if command available, false otherwise
-// Command string will be copied to cmdBuffer (null-terminated)
-bool getBLECommand(char* cmdBuffer, size_t maxLen);
+// Commands written by the client wait in a ring of BLE_CMD_RING_SLOTS slots
+// (filled in the BLE callback without heap use, drained by the GUI task), so
+// a burst of commands is processed in order instead of overwriting each other
+#define BLE_CMD_RING_SLOTS  8
+#define BLE_CMD_MAX_LEN     112     // Longer commands are dropped (fits WIFI:<ssid>,<passphrase>)
+
+// Binary commands start with BLE_BIN_MAGIC (never a printable character)
+#define BLE_BIN_CMD_BASELINE    0x10    // SweepConfigPacket (sweep_config.h)
+#define BLE_BIN_CMD_MEAS        0x11    // BLE_BIN_MAGIC, BLE_BIN_CMD_MEAS - no parameters
 
-// Parse START command to extract number of DUTs, start index, and stop index
-void parseStartCommand(const char* cmd, uint8_t& num_duts, uint8_t& start_idx, uint8_t& stop_idx, float &calcStartFreq, float &calcEndFreq);
+// Get the oldest pending command
+// Returns its length in bytes, 0 if none is available
+// Command will be copied to cmdBuffer (null-terminated, may be binary); its
+// sender becomes the current connection for the per-connection settings below
+size_t getBLECommand(char* cmdBuffer, size_t maxLen);
+
+// Commands dropped because the ring was full or they were too long
+uint32_t getBLECommandDrops();
 
 /*=========================BLE DATA TRANSMISSION=========================*/
 // Send status message to WebUI
 // Examples: "STATUS:Ready", "STATUS:Measuring"
 void sendBLEStatus(const char* status);
 
-// Send DUT start notification
-// dutNum: 1-4
+// Send DUT start notification - JSON clients that do not stream
+// dutNum: 1-based
 void sendBLEDUTStart(uint8_t dutNum);
 
-// Send DUT end notification
-// dutNum: 1-4
+// Send DUT end notification - every client but the binary ones, whose
+// data's last part carries it (BLE_BIN_FLAG_END)
+// dutNum: 1-based
 void sendBLEDUTEnd(uint8_t dutNum);
 
-// Send impedance data for a DUT as JSON
-// dutIndex: 0-3 (for DUT 1-4)
-// Returns true if sent successfully
-bool sendBLEImpedanceData(uint8_t dutIndex);
+// Send impedance data for a DUT - DATA:{json}, or binary after FORMAT:BIN
+// dutIndex: 0-based (DUT number - 1), final: the final rows, else the baseline
+// Returns true if sent successfully (false without points - binary clients
+// still get the empty end part)
+bool sendBLEImpedanceData(uint8_t dutIndex, bool final);
+
+// GET_DATA selection of stored rows
+enum DataRows : uint8_t {
+    DATA_ROWS_CURRENT,      // The current session's kind
+    DATA_ROWS_BASELINE,
+    DATA_ROWS_FINAL
+};
+
+struct BLEDataQuery {
+    uint16_t dutMask;       // Bit n = DUT n+1
+    DataRows rows;
+    uint32_t minHz;         // Points outside [minHz, maxHz] are left out
+    uint32_t maxHz;
+    int8_t format;          // -1 = the client's FORMAT, 0 = JSON, 1 = binary
+};
+
+// <duts>,<rows>,<min Hz>-<max Hz>,<format> - every field optional, empty or
+// ALL for the default (all DUTs, CUR, every point, the client's format):
+// duts a hex mask, rows CUR / BASE / FINAL, format JSON / BIN. nullptr = all
+bool parseBLEDataQuery(const char* text, BLEDataQuery& query);
+
+// DATA of the selected rows to the requesting client only (GET_DATA), one
+// message per DUT with points. Final rows are served from the DATA cache;
+// rows still being swept are encoded afresh. Returns the DUTs sent
+int sendBLEDataQuery(const BLEDataQuery& query);
+
+// The same DATA:{json} messages as lines on the console (serial "data")
+int printDataQuery(const BLEDataQuery& query);
+
+// The DATA JSON document of the first stored points of a DUT's row (without
+// the DATA: prefix) into json, the points outside query's range left out.
+// Returns the JSON length, 0 if it does not fit
+size_t encodeBLEImpedanceJSON(uint8_t dutIndex, const ImpedanceRow& row, int stored, char* json, size_t size,
+                              const BLEDataQuery& query);
+
+// Send a DUT's risk result (riskLevels/riskPercentages) after its final sweep
+// Format: RISK:<dut 1-n>:<RiskLevel>:<percent reduction>
+// dutIndex: 0-based (DUT number - 1)
+void sendBLERisk(uint8_t dutIndex);
+
+// Send a DUT's risk against the tracked baseline (monitor mode, impedance_calc.h)
+// Format: TRACK:<dut 1-n>:<RiskLevel>:<percent reduction>
+void sendBLETrackedRisk(uint8_t dutIndex);
+
+// Send a DUT's equivalent-circuit fit (impedance_calc.h), nothing if it has none
+// Format: FIT:<dut 1-n>:<kind 0=baseline 1=final>:<Rs>:<Rct>:<Q>:<n>:<rms %>:<Rct reduction %>
+// dutIndex: 0-based (DUT number - 1)
+void sendBLEFit(uint8_t dutIndex, bool final);
+
+// Send a DUT's Kramers-Kronig check (impedance_calc.h), nothing if it was not checked
+// Format: KK:<dut 1-n>:<kind 0=baseline 1=final>:<1 pass, 0 fail>:<rms %>:<max %>:<worst Hz>
+// dutIndex: 0-based (DUT number - 1)
+void sendBLEKKResult(uint8_t dutIndex, bool final);
+
+// Send a DUT's spectral metrics (spectral_metrics.h) after its final sweep
+// Format: METRICS:<dut 1-n>:<mask hex>:<alarms hex>:<value>,... (one value per mask bit, low bit first)
+// dutIndex: 0-based (DUT number - 1)
+void sendBLEMetrics(uint8_t dutIndex);
+
+// List the newest archived sessions (session_log.h), newest first, then STATUS
+// Format: SESSION:<timestamp>,<dut>,<kind 0=baseline 1=final>,<points>,<RiskLevel>,<percent>
+void sendBLESessionList();
+
+// Send one archived session as JSON, ERROR if there is none with this key
+// Format: HISTORY:{"ts":..,"dut":..,"kind":..,"risk":..,"pct":..,"freq":[..],"mag":[..],"phase":[..]}
+bool sendBLESession(uint32_t timestamp, uint8_t dut);
 
 // Send measurement complete notification
 void sendBLEComplete();
@@ -81,12 +343,122 @@ void sendBLEComplete();
 // Send error message
 void sendBLEError(const char* errorMsg);
 
+// Send sweep latency statistics as JSON (min/avg/max us per stage)
+// Format: STATS:{"start_ack":{"n":1,"min":..,"avg":..,"max":..},...}
+void sendBLEStats();
+
+// Send the field counters (counters.h) as JSON - counters by name, histograms
+// with their bounds and buckets (the last one unbounded)
+// Format: COUNTERS:{"ble.notify_ok":12,"gui.render_us":{"n":..,"sum":..,"max":..,"le":[..],"b":[..]},...}
+void sendBLECounters();
+
+// DATA payload format of the current connection (FORMAT command)
+void setBLEBinaryData(bool enable);
+bool isBLEBinaryData();
+
+// Live streaming for the current connection (STREAM command): every stored
+// point goes out as a BLE_BIN_TYPE_POINT notification and the connection gets
+// no DUT_START / DATA burst, only DUT_END. The reader's per-point batch
+// handover is on while any connection streams
+void setBLEStreaming(bool enable);
+bool isBLEStreaming();
+
+// Framed text for the current connection (FRAMING command, see FRAMED TEXT)
+void setBLEFramedText(bool enable);
+bool isBLEFramedText();
+
+// RESEND: queue chunks first..first + count - 1 of a retained framed message
+// again for the current connection (count is clipped to the message)
+// Returns false if the message is no longer kept, first is past its end or
+// the connection's MTU no longer fits the chunks
+bool resendBLEChunks(uint8_t message, uint16_t first, uint16_t count);
+
+// RESUME token of the current connection
+uint32_t getBLEResumeToken();
+
+// RESUME: take over the dropped connection of token and queue what it missed
+// from chunk of message on; messagesOut is the number of messages queued
+BLEResumeResult resumeBLETransfer(uint32_t token, uint8_t message, uint16_t chunk, int& messagesOut);
+
+// At least one connection streams (worth calling sendBLELivePoint)
+bool anyBLEClientStreaming();
+
+// Queue stored point i of DUT dutIndex (0-based) as a live point notification
+// Called by the data processor right after storing it, final: the session's kind
+bool sendBLELivePoint(uint8_t dutIndex, int i, bool final);
+
 /*=========================BLE UTILITY=========================*/
-// Send raw string over BLE TX characteristic
-// Returns true if sent successfully
+// Queue a raw string for the BLE TX characteristic of every client, chunked to each MTU
+// Returns true if queued (false: not connected or TX buffer full)
 bool sendBLEString(const char* data);
 
+// Queue one binary notification for every client (at most the smallest
+// client payload size)
+bool sendBLEBytes(const uint8_t* data, size_t len);
+
+// Queue one notification for the history data characteristic of the client
+// that wrote the last history request (at most getBLEHistoryPayloadSize() bytes)
+// Does not wait for TX buffer space - returns false if it is full
+bool sendBLEHistoryFrame(const uint8_t* data, size_t len);
+
+// Payload size of the history requester, 0 once it has disconnected
+size_t getBLEHistoryPayloadSize();
+
+// Free TX buffer bytes
+size_t getBLETxFree();
+
+// Send the next queued chunk, paced by credits and congestion
+// Waits up to timeout for one; call from a dedicated BLE TX task
+// Returns true if a chunk was handled, false on timeout
+bool processBLETx(TickType_t timeout);
+
+// Credits that timed out instead of being freed by a notify confirm
+uint32_t getBLETxConfirmTimeouts();
+
+// Message options for queueBLEClientMessage()
+#define BLE_TX_FLAG_INDICATE    0x01    // Indications (confirmed by the client) instead of notifications
+#define BLE_TX_FLAG_BENCH       0x02    // Benchmark traffic - counted in BLETxCounters
+
+// Cumulative TX task counters since boot
+struct BLETxCounters {
+    uint32_t benchBytes;            // BLE_TX_FLAG_BENCH bytes handed to the stack
+    uint32_t benchNotifications;
+    uint32_t benchDropBytes;        // BLE_TX_FLAG_BENCH bytes the stack refused
+    uint32_t sendErrors;            // Notifications the stack refused (dropped on this end)
+    uint32_t congestEvents;
+    uint32_t creditTimeouts;        // See getBLETxConfirmTimeouts()
+    int64_t lastBenchUs;            // esp_timer time of the last bench notification
+};
+void getBLETxCounters(BLETxCounters& out);
+
+// Queue a message for one client (slot from getBLECommandClient()) in chunks
+// of chunkSize (0 or more than its payload size: its payload size)
+bool queueBLEClientMessage(int8_t client, const uint8_t* data, size_t len, size_t chunkSize, uint8_t flags);
+
+// Slot of the client whose command is being processed, -1 if none
+int8_t getBLECommandClient();
+
+// Payload size of a client slot, 0 if it is not connected
+size_t getBLEClientPayloadSize(int8_t client);
+
+// Largest notification payload on the current connection (ATT MTU - 3)
+size_t getBLEPayloadSize();
+
+// Largest binary notification every client subscribed to TX takes, 0 if none
+size_t getBLEDataPayloadSize();
+
+// FLEET_LINK: the current connection's central (fleet_aggregator.h) schedules
+// its connection interval - no fast / idle requests of our own on it
+void setBLELinkManaged();
+
+// Clients' RSSI, link state and the connection TX power (serial "stats")
+void printBLELinkStatus();
+
 // Enable/disable BLE (for power saving)
 void enableBLE(bool enable);
 
+// Slow (idle) or fast advertising intervals, restarting advertising if it runs
+void setBLEAdvertisingSlow(bool slow);
+bool isBLEAdvertisingSlow();
+
 #endif // BLE_FUNCTIONS_H
@@ -2,124 +2,454 @@
 #define UART_FUNCTIONS_H
 
 #include <Arduino.h>
-#include <HardwareSerial.h>
+#include "driver/uart.h"
 #include "defines.h"
+#include "uart_protocol.h"
+#include "uart_frame.h"
+#include "sweep_table.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/semphr.h"
+#include "freertos/event_groups.h"
 
 // UART configuration
+#define UART_PORT_NUM       UART_NUM_1
 #define UART_RX_PIN         2
 #define UART_TX_PIN         3
-#define UART_BAUD_RATE      3600
-
-// Command protocol (matching STM32)
-#define UART_CMD_START_BYTE     0xAA
-#define UART_CMD_END_BYTE       0x55
-#define UART_CMD_PACKET_SIZE    15
-#define UART_ACK_PACKET_SIZE    4
-
-// Command types
-#define CMD_SET_PGA_GAIN        0x01
-#define CMD_SET_MUX_CHANNEL     0x02
-#define CMD_START_MEASUREMENT   0x03
-#define CMD_END_MEASUREMENT     0x04
-#define CMD_SET_TIA_GAIN        0x05
-
-// Data packet protocol (matching STM32)
-#define UART_DATA_START_BYTE    0xAA
-#define UART_DATA_END_BYTE      0x55
-
-// Packet types
-#define UART_DATA_DUT_START     0x10
-#define UART_DATA_FREQUENCY     0x11
-#define UART_DATA_DUT_END       0x12
-
-// Packet sizes
-#define UART_DATA_DUT_START_SIZE    7
-#define UART_DATA_FREQUENCY_SIZE    26
-#define UART_DATA_DUT_END_SIZE      4
-
-// Receive state machine states
-enum UARTRxState {
-    WAITING_START,
-    READING_PACKET_TYPE,
-    READING_DUT_START,
-    READING_FREQUENCY,
-    READING_DUT_END,
-    VALIDATING_END
-};
+#define UART_BAUD_RATE      3600    // Default/fallback rate - both sides boot at this rate
+
+// Front ends on separate UARTs. Link 0 is the STM32 above; every further
+// link is another front end board sweeping its own DUTs in parallel. Each
+// link has its own driver ring, parser, statistics and baud rate. A link's
+// STM32 numbers its DUTs from 1 - the reader adds the link's offset, so the
+// DUTs of all links land in one session store as 1..getDUTCount(). A START
+// is split at the link boundaries and goes to every link it covers; STOP
+// and settings go to all links, the device ID is link 0's
+#ifndef UART_LINK_COUNT
+#define UART_LINK_COUNT     1
+#endif
+#define UART_LINK_MAX       2       // ESP32-C6: UART1 and UART0 (the console is on USB)
+#ifndef UART_LINK_DUTS
+#define UART_LINK_DUTS      8       // DUTs per link - the last link takes the rest
+#endif
+#define UART_LINK1_PORT     UART_NUM_0
+#ifndef UART_LINK1_RX_PIN
+#define UART_LINK1_RX_PIN   4       // Free on this board (pinDefs.h, TFT_eSPI User_Setup.h)
+#endif
+#ifndef UART_LINK1_TX_PIN
+#define UART_LINK1_TX_PIN   1
+#endif
+
+// Request FREQUENCY_IDX frames at boot (changed at run time with setIndexedFrames)
+#ifndef UART_INDEXED_FRAMES
+#define UART_INDEXED_FRAMES 0
+#endif
+
+// Request FREQUENCY_BLOCK frames at boot (changed at run time with setBlockFrames)
+#ifndef UART_BLOCK_FRAMES
+#define UART_BLOCK_FRAMES 0
+#endif
+
+// Quantize block frames at boot (changed at run time with setCompactFrames)
+#ifndef UART_COMPACT_FRAMES
+#define UART_COMPACT_FRAMES 0
+#endif
+
+// Start final sweeps at the baseline's gains at boot (changed with setGainHints)
+#ifndef UART_GAIN_HINTS
+#define UART_GAIN_HINTS 0
+#endif
+#define UART_GAIN_PLAN_ACK_MS   200     // ACK timeout of one CMD_SET_GAIN_PLAN / CMD_SET_REPEAT_PLAN / CMD_SET_GAIN_LIMITS
+
+// Limit autoranging to the calibrated gains at boot (changed with setGainLimits)
+#ifndef UART_GAIN_LIMITS
+#define UART_GAIN_LIMITS 1
+#endif
+
+// Credit flow control of sweeps at boot (changed with setFlowCredits)
+#ifndef UART_FLOW_CREDITS
+#define UART_FLOW_CREDITS 0
+#endif
+
+// Baud rate negotiation (CMD_SET_BAUD_RATE)
+#define UART_FAST_BAUD_RATES            { 921600, 115200 }  // Tried in order, fastest first
+#define UART_BAUD_SWITCH_SETTLE_MS      5       // Time for both sides to reconfigure after the switch ACK
+#define UART_BAUD_VERIFY_TIMEOUT_MS     200     // Verify ACK timeout at the new rate
+#define UART_BAUD_REVERT_MS             500     // STM32 reverts to UART_BAUD_RATE if no verify arrives in this time
+#define UART_RX_RESET_TIMEOUT_MS        50      // Wait for the reader task to drop the old rate's bytes
 
-// UART receiver context
+// Link tuning at boot (changed with setLinkTuning): negotiation climbs
+// UART_TUNE_BAUD_RATES instead and keeps the fastest rate whose CMD_LINK_TEST
+// bursts lose at most UART_TUNE_MAX_ERROR_PCT of their frames
+#ifndef UART_LINK_TUNING
+#define UART_LINK_TUNING 0
+#endif
+#define UART_TUNE_BAUD_RATES            { 115200, 230400, 460800, 921600 }  // Tried in order, slowest first
+#define UART_TUNE_FRAMES                32      // LINK_TEST frames per burst
+#define UART_TUNE_ROUNDS                4       // Bursts per rate - a command lost on the way out costs its burst
+#define UART_TUNE_MAX_ERROR_PCT         1       // Frames of the bursts a rate may lose (1 of 128)
+#define UART_RETUNE_MIN_FRAMES          500     // Frames received since the tuning before errors are judged
+#define UART_RETUNE_ERROR_PCT           1       // Link errors per frame received that force a slower rate
+
+// ESP-IDF UART driver configuration
+// With CONFIG_UART_ISR_IN_IRAM the driver ISR and its ring buffer (DRAM) keep
+// receiving while the flash cache is off for a LittleFS write or erase; the
+// reader task is held off meanwhile, so the ring must hold the bytes of the
+// longest flash operation at the fastest rate
+#define UART_FLASH_STALL_MS     60      // 4 KB sector erase, typical worst case
+#define UART_RX_RING_SIZE       8192    // Driver RX ring buffer (filled from the HW FIFO by the driver ISR)
+#define UART_TX_RING_SIZE       0       // 0 = uart_write_bytes() blocks until bytes are in the HW FIFO
+#define UART_EVENT_QUEUE_DEPTH  20      // Driver event queue depth
+#define UART_RX_TIMEOUT_SYMBOLS 2       // Idle time (in symbols) before the driver posts a UART_DATA event
+
+// Asynchronous command requests
+#define UART_CMD_REQUEST_QUEUE_DEPTH    16  // Commands waiting for the command task (allows setting bursts)
+#define UART_CMD_RESULT_QUEUE_DEPTH     4   // Completed requests waiting for processUARTCommandResults()
+#define UART_ACK_BIT(cmd)               ((EventBits_t)1 << (cmd))   // ACK event bit per command type
+#define UART_CMD_REQUEST_BIT            ((EventBits_t)1 << 20)  // New request queued for the command task
+#define UART_CMD_SEQ_ACK_BIT            ((EventBits_t)1 << 21)  // Sequenced ACK(s) queued for the command task
+#define UART_RX_RESET_BIT               ((EventBits_t)1 << 22)  // Reader task dropped the RX stream a rate change asked for
+
+// Pipelined setting commands (PGA/MUX/TIA) - v2 links only
+#define UART_CMD_WINDOW                 4       // Max setting commands in flight
+#define UART_CMD_ACK_TIMEOUT_MS         200     // Retransmit an unacknowledged command after this long
+#define UART_CMD_MAX_RETRIES            3       // Give up on a command after this many retransmits
+#define UART_CMD_SEQ_ACK_QUEUE_DEPTH    8
+
+// Measurement batching
+#define MEASUREMENT_BATCH_IDLE_MS   200     // Flush a partial batch after this long without data
+#define MEASUREMENT_BATCH_WAIT_MS   100     // Max wait for a free batch before dropping points
+
+// UART receiver context, one per link (used by the reader task, not ISR)
+// DUTs are session DUTs - the link's offset is added as frames arrive
 struct UARTRxContext {
-    UARTRxState state;
-    uint8_t buffer[32];
-    uint8_t byteCount;
-    uint8_t expectedBytes;
-    uint8_t packetType;
-    uint8_t currentDUT;
-    uint8_t expectedFreqCount;
+    UARTFrameStage stage;               // Partial-frame tail + newest block, parsed in place
+    uint8_t currentDUT;                 // DUT of the last DUT_START / FREQUENCY_DUT frame
+    uint8_t expectedFreqCount[MAX_DUT_COUNT]; // From DUT_START, 0 = not announced
+    uint16_t framesSinceStart[MAX_DUT_COUNT]; // Frequency frames since the DUT's DUT_START
+    uint16_t nextSeq[MAX_DUT_COUNT];    // Expected FREQUENCY_IDX sequence number
+    uint8_t lastFreqIdx[MAX_DUT_COUNT]; // Sweep table index of each DUT's previous point
+};
+
+// Completion callback for asynchronous commands
+// Runs in the task that calls processUARTCommandResults() (the GUI task)
+typedef void (*UARTCommandCallback)(uint8_t cmd_type, bool success, void* context);
+
+// Asynchronous command request (queued to the command task)
+struct UARTCommandRequest {
+    uint8_t cmd_type;           // Any CMD_* - START/STOP block, settings are pipelined
+    uint32_t data1, data2, data3;
+    UARTCommandCallback callback;
+    void* context;
+};
+
+// Completed asynchronous command
+struct UARTCommandResult {
+    uint8_t cmd_type;
+    bool success;
+    UARTCommandCallback callback;
+    void* context;
+};
+
+// Link statistics, per link (updated by the UART reader task)
+struct UARTStats {
+    uint32_t bytesReceived;     // Total bytes handed to the parser
+    uint32_t blocksReceived;    // Number of UART_DATA blocks read from the driver
+    uint32_t fifoOverflows;     // UART_FIFO_OVF events (HW FIFO overran before the driver ISR ran)
+    uint32_t bufferFullEvents;  // UART_BUFFER_FULL events (driver ring buffer full)
+    uint32_t bytesDropped;      // Bytes flushed after an overflow
+    uint32_t frameErrors;       // UART_FRAME_ERR / UART_PARITY_ERR events
+    uint32_t framesParsed;      // Valid frames decoded by the parser
+    uint32_t bytesSkipped;      // Bytes discarded while resyncing to a frame start
+    uint32_t v2Frames;          // Frames received in the CRC-protected v2 format
+    uint32_t crcErrors;         // v2 frames rejected by the CRC check
+    uint32_t resyncs;           // Times the parser lost frame sync
+    uint32_t pointsLost;        // Frames lost: FREQUENCY_IDX sequence gaps, else DUTs ending short of DUT_START
+    uint32_t pointsDropped;     // Points received but dropped - no free batch within MEASUREMENT_BATCH_WAIT_MS
+    uint32_t cmdRetransmits;    // Setting commands resent after an ACK timeout
+    uint32_t cmdFailures;       // Setting commands dropped after UART_CMD_MAX_RETRIES
 };
 
 /*=========================INITIALIZATION=========================*/
-// Initialize UART communication with STM32 using Arduino HardwareSerial
-// Sets up interrupt-driven reception using onReceive() callback
-// measurementQueue: FreeRTOS queue for parsed MeasurementPoints
+// Initialize UART communication with STM32 using the ESP-IDF UART driver
+// The driver ISR moves bytes from the HW FIFO into its ring buffer and posts
+// events to an event queue; the reader task consumes them in blocks
+// measurementQueue: FreeRTOS queue of MeasurementBatch* (depth MEASUREMENT_BATCH_POOL)
 void initUART(QueueHandle_t measurementQueue);
 
-// Get semaphore handle for signaling when new data received
-// Task can wait on this semaphore instead of polling
-SemaphoreHandle_t getUARTSemaphore();
+// Get the UART driver event queue of a link (UART_DATA, UART_FIFO_OVF, ...)
+QueueHandle_t getUARTEventQueue(uint8_t link = 0);
+
+// UART port of a link (light sleep wake-up)
+uart_port_t getUARTLinkPort(uint8_t link);
+
+// Wait up to timeout for one driver event of any link and handle it
+// UART_DATA: reads the pending bytes in blocks and passes them to the parser
+// Overflow events: flush the ring buffer, reset the parser and count the loss
+// framesOut (optional): number of complete frames parsed for this event
+// Returns true if an event was handled, false on timeout
+bool processUARTEvents(TickType_t timeout, size_t* framesOut = nullptr);
+
+// Get a snapshot of the statistics, summed over all links
+UARTStats getUARTStats();
+
+// Get a snapshot of one link's statistics
+UARTStats getUARTLinkStats(uint8_t link);
 
-// Process buffered bytes from ISR circular buffer
-// Call this from a task (not ISR) after semaphore is signaled
-// Processes all available bytes through state machine
-void processBufferedBytes();
+// Reset all link statistics counters to zero
+void resetUARTStats();
+
+// Measurement batches waiting for the data processor, and commands waiting
+// for the command task (diagnostics screen)
+uint32_t getPendingBatchCount();
+uint32_t getPendingCommandCount();
 
 /*=========================COMMAND SENDING=========================*/
 // Send start measurement command to STM32 (default 4 DUTs)
 bool sendStartCommand();
 
-// Send start measurement command with specific number of DUTs (1-4)
-bool sendStartCommand(uint8_t num_duts, uint8_t startIDX = 0, uint8_t endIDX = 37);
+// Send start measurement command with specific number of DUTs (1-getDUTCount())
+// firstDut > 1 resumes a sweep: only DUTs firstDut..num_duts are swept
+// gainPlan: upload the gain plan (setGainPlanHint) first and start with START_FLAG_GAIN_PLAN
+bool sendStartCommand(uint8_t num_duts, uint8_t startIDX = 0, uint8_t endIDX = SWEEP_FREQ_LAST, uint8_t firstDut = 1,
+                      bool gainPlan = false);
+
+// Sweep order of the next START: false = DUT by DUT (DUT_START ... DUT_END
+// blocks), true = frequency-major across DUTs with FREQUENCY_DUT frames, so the
+// STM32 settles each frequency once for all channels. Needs STM32 support
+void setInterleavedSweep(bool enable);
+bool isInterleavedSweep();
+
+// Ask the next START for FREQUENCY_IDX frames: the STM32 sends each point's
+// sweep table index, used directly instead of searching by frequency, and a
+// per-DUT sequence number that reveals lost frames. Needs STM32 support
+void setIndexedFrames(bool enable);
+bool isIndexedFrames();
+
+// Ask the next START for FREQUENCY_BLOCK frames: DUT-by-DUT sweeps send up to
+// UART_BLOCK_MAX_POINTS consecutive points per frame (13 bytes each, sequenced
+// like FREQUENCY_IDX), about half the line time of one frame per point.
+// Needs v2 STM32 support - interleaved sweeps keep FREQUENCY_DUT frames
+void setBlockFrames(bool enable);
+bool isBlockFrames();
+
+// Ask block sweeps for COMPACT_BLOCK frames: 7 bytes per point, log-coded
+// 16-bit magnitudes and the phase in centidegrees (UARTCompactPoint).
+// Only with block frames on; needs STM32 support
+void setCompactFrames(bool enable);
+bool isCompactFrames();
+
+// Gain hints: a final sweep sends each DUT's baseline gains (CMD_SET_GAIN_PLAN)
+// before its START, so the STM32 starts every point at the range the baseline
+// settled on instead of searching for it. STM32 firmware that does not ACK
+// the plan gets a plain START and is not asked again. Needs STM32 support
+void setGainHints(bool enable);
+bool isGainHints();
+
+// Gain limits: before a START whose plan has indices the calibration does
+// not cover at every gain (getCalibrationCoverage()), the command task sends
+// their coverage (CMD_SET_GAIN_LIMITS) and sets START_FLAG_GAIN_LIMITS, so
+// the STM32 never settles on a combination the ESP32 cannot calibrate. A
+// fully covered plan sends nothing; STM32 firmware that does not ACK the
+// limits gets a plain START and is not asked again. Needs STM32 support
+void setGainLimits(bool enable);
+bool isGainLimits();
+
+// Credit flow control: the next START asks the STM32 (START_FLAG_CREDITS) to
+// send frequency frames only up to the limit granted with CMD_FLOW_CREDIT -
+// the frames it sent so far plus what the free batches hold. A processor held
+// up by a flash write or a BLE burst then pauses the sweep instead of the
+// reader dropping points after MEASUREMENT_BATCH_WAIT_MS. Needs STM32 support
+void setFlowCredits(bool enable);
+bool isFlowCredits();
 
-// Send stop measurement command to STM32
-bool sendStopCommand();
+// Gain plan of the next START with gainPlan - written by the GUI task
+// before it queues the START, read by the command task when it sends it
+// hint: GAIN_HINT_* (uart_protocol.h), 0 = autorange
+void clearGainPlan();
+void setGainPlanHint(uint8_t dut, uint8_t freqIdx, uint8_t hint);
 
-// Send set PGA gain command
+// Start a sparse sweep of the frequencies selected in mask (sweep_table.h)
+// Contiguous masks and STM32 firmware without CMD_START_MASKED get a plain
+// START over the mask's index range instead
+bool sendStartMaskedCommand(uint8_t num_duts, SweepMask mask, uint8_t firstDut = 1, bool gainPlan = false);
+
+// Send stop measurement command to every STM32
+// dut: STOP_SCOPE_ALL, or 1-n to end just that DUT's sweep early (its link only)
+bool sendStopCommand(uint8_t dut = STOP_SCOPE_ALL);
+
+// Queue set PGA gain command (pipelined, returns immediately)
 bool sendSetPGAGainCommand(uint8_t gain);
 
-// Send set MUX channel command
+// Queue set MUX channel command (pipelined, returns immediately)
 bool sendSetMuxChannelCommand(uint8_t channel);
 
-// Send set TIA gain command (0 = high gain, 1 = low gain)
+// Queue set TIA gain command (0 = high gain, 1 = low gain; pipelined, returns immediately)
 bool sendSetTIAGainCommand(uint8_t low_gain);
 
-// Generic command sender
+// Negotiate the fastest UART_FAST_BAUD_RATES rate each STM32 accepts
+// Each rate is requested at the current rate, then verified with an ACK at the new rate
+// Falls back to UART_BAUD_RATE if no rate verifies (e.g. older STM32 firmware)
+// Returns true if a faster rate is now active on every link
+bool negotiateBaudRate();
+
+// Return both sides of every link to UART_BAUD_RATE without a handshake (after link loss)
+void resetBaudRate();
+
+// Get the active UART baud rate of the slowest link
+uint32_t getCurrentBaudRate();
+
+// Link tuning (UART_LINK_TUNING): every negotiation tests the link at rising
+// rates with bursts of LINK_TEST frames and keeps the fastest clean one, so a
+// short cable runs fast and a long one as fast as it can. When the CRC,
+// framing and sequence errors since the tuning exceed UART_RETUNE_ERROR_PCT of
+// the frames received, the next START tunes again below the current rate.
+// STM32 firmware that does not answer CMD_LINK_TEST gets the plain
+// negotiation above
+void setLinkTuning(bool enable);
+bool isLinkTuning();
+
+// Queue a tuning of every link for the command task (returns immediately),
+// with no cap from earlier error rises - between sweeps only
+bool requestLinkTuning();
+
+// Rate and frame errors of the last tuning per link (serial "linktune")
+void printLinkTuning();
+
+/*=========================DEVICE ID=========================*/
+#define STM32_DEVICE_ID_LEN     24      // Hex characters of the 96-bit UID
+
+// Queue a CMD_GET_DEVICE_ID for the command task (returns immediately)
+// Older STM32 firmware ignores it and the ID stays unknown
+bool requestSTM32DeviceId();
+
+// Copy the STM32 UID as STM32_DEVICE_ID_LEN uppercase hex chars (word 2 first)
+// out must hold STM32_DEVICE_ID_LEN + 1 bytes
+// Returns false while no DEVICE_ID frame has been received
+bool getSTM32DeviceId(char* out);
+
+// Queue a START for the command task (returns immediately)
+// callback (optional) is invoked from processUARTCommandResults() once ACKed or failed
+// Returns false if the request could not be queued or a START is already pending
+bool sendStartCommandAsync(uint8_t num_duts, uint8_t startIDX, uint8_t endIDX,
+                           UARTCommandCallback callback = nullptr, void* context = nullptr);
+
+// Queue a masked START (sendStartMaskedCommand) - same rules as sendStartCommandAsync
+bool sendStartMaskedCommandAsync(uint8_t num_duts, SweepMask mask,
+                                 UARTCommandCallback callback = nullptr, void* context = nullptr);
+
+// Queue the START for a sweep plan: masked if mask != 0, else startIDX..endIDX
+// Sweeps are started through the measurement controller (meas_control.h),
+// which opens the session first. gainPlan: start at the gain plan (setGainPlanHint)
+bool sendSweepStartAsync(uint8_t num_duts, uint8_t startIDX, uint8_t endIDX, SweepMask mask,
+                         UARTCommandCallback callback = nullptr, void* context = nullptr, bool gainPlan = false);
+
+// Queue the START that resumes a stalled sweep plan at DUT firstDut (1-based)
+// Same rules as sendSweepStartAsync - the session stays open (sweep_watchdog.h)
+bool sendSweepResumeAsync(uint8_t num_duts, uint8_t firstDut, uint8_t startIDX, uint8_t endIDX, SweepMask mask,
+                          UARTCommandCallback callback = nullptr, void* context = nullptr);
+
+// Queue a STOP for the command task (returns immediately)
+bool sendStopCommandAsync(UARTCommandCallback callback = nullptr, void* context = nullptr);
+
+// Queue a STOP that also resets the link if the STM32 does not ACK it: back
+// to UART_BAUD_RATE and v2 detection, renegotiated by the next START
+bool sendLinkResetAsync(UARTCommandCallback callback = nullptr, void* context = nullptr);
+
+// Queue a STOP that ends only DUT dut (1-based) and lets the sweep move on
+bool sendSkipDUTCommandAsync(uint8_t dut);
+
+// Queue any command for the command task (returns immediately)
+// Setting commands are pipelined up to UART_CMD_WINDOW deep; START/STOP wait for them to drain
+bool queueUARTCommand(uint8_t cmd_type, uint32_t data1, uint32_t data2, uint32_t data3);
+
+// Service the command pipeline: send queued requests, match sequenced ACKs, retransmit
+// Waits up to timeout when idle (shorter while commands are in flight)
+// Call from a dedicated command task - never from the GUI task
+// Returns true if anything was handled, false on timeout
+bool processUARTCommandRequests(TickType_t timeout);
+
+// True once the link 0 STM32 has sent a v2 frame - commands then carry
+// sequence numbers. The pipelined window is link 0's; further links get
+// setting commands untracked
+bool isV2CommandLink();
+
+// True from queueing a START until its ACK (or failure) - before
+// measurementInProgress is set
+bool isSweepStartPending();
+
+// Invoke callbacks for completed asynchronous commands (non-blocking)
+// Call regularly from the GUI task
+void processUARTCommandResults();
+
+// Generic command sender - to every link
 bool sendCommand(uint8_t cmd_type, uint32_t data1, uint32_t data2, uint32_t data3);
 
-// Wait for ACK packet from STM32 for a specific command
-// Returns true if ACK received within timeout, false otherwise
+// Wait for ACK packets from every STM32 for a specific command
+// Blocks on the links' ACK event groups (no polling); the ACK bit is cleared by sendCommand()
+// Returns true if every ACK was received within timeout, false otherwise
 bool waitForAck(uint8_t cmd_type, uint32_t timeout_ms);
 
 /*=========================PACKET RECEIVING=========================*/
-// Process incoming UART data (call from UART ISR or task)
+// Parse all complete frames of link 0 in a contiguous span without copying them
+// Accepts both legacy (AA..55) and v2 (A5 5A .. crc16) frames
+// Bytes that are not a frame start are skipped (resync)
+// consumed: set to the number of bytes used - the rest is an incomplete frame
+// Returns the number of frames handled
+size_t parseFrames(const uint8_t* data, size_t len, size_t* consumed);
+
+// Process a contiguous block of link 0 bytes (partial frames are kept for the next call)
+// Returns the number of frames handled
+size_t processIncomingBytes(const uint8_t* data, size_t len);
+
+// Process a single received byte (wrapper around processIncomingBytes)
 void processIncomingByte(uint8_t byte);
 
-// Get current DUT being processed
+// Get current DUT being processed (session DUT, of the link that sent the last frame)
 uint8_t getCurrentDUT();
 
+/*=========================MEASUREMENT BATCHES=========================*/
+// Send the batch being filled to the processor now (call when the link goes idle)
+void flushMeasurementBatch();
+
+// Hand each point to the processor as soon as it arrives (live BLE streaming)
+// instead of in batches of up to MEASUREMENT_BATCH_SIZE
+void setLiveBatchHandover(bool enable);
+
+// Return a processed batch to the free pool (call from the data processor)
+void releaseMeasurementBatch(MeasurementBatch* batch);
+
+// Grant the STM32 more frames once its remaining credit is below half of the
+// free room - any task; called as batches return, frames arrive and the START
+// is ACKed. resend: send the current limit even if it did not grow (idle
+// link - a lost grant would hold the sweep)
+void grantFlowCredit(bool resend = false);
+
+// Credit grants and dropped points (serial "stats")
+void printUARTFlowStats();
+
 /*=========================EVENT SIGNALING=========================*/
-// Get semaphore signaled when a DUT completes (DUT_END packet received)
-// GUI task can wait on this to trigger Bode plot drawing
-SemaphoreHandle_t getDUTCompleteSemaphore();
+// Signal that all points of a DUT have been processed and stored
+// Called by the data processor for the batch with dutComplete set, with the
+// batch's session (meas_session.h) - a cancelled session's DUT_END is dropped
+void signalDUTComplete(uint8_t dutNum, uint32_t generation);
 
-// Get semaphore signaled when all measurements complete
-// GUI task can wait on this to trigger CSV export
-SemaphoreHandle_t getMeasurementCompleteSemaphore();
+// One completed DUT, data processor -> GUI task. Every DUT_END gets its own
+// event, so DUTs finishing close together (short plans, raw capture, a
+// repair sweep) are each seen once and in order
+#define DUT_COMPLETE_QUEUE_DEPTH  (MAX_DUT_COUNT * 2)   // A sweep plus its repair
+
+struct DUTCompleteEvent {
+    uint8_t dutIndex;       // 0-based
+    bool sweepDone;         // Last DUT expected since the START
+    uint16_t points;        // Points stored for the DUT
+    uint32_t timestampMs;   // millis() of the signal
+    uint32_t generation;    // Session of the DUT's batches
+};
 
-// Get the DUT index that just completed (0-3 for DUT 1-4)
-// Call after getDUTCompleteSemaphore() signals
-uint8_t getCompletedDUTIndex();
+// Queue of DUTCompleteEvent, drained by the GUI task (GUI_WAKE_DUT)
+// The sweepDone event comes after the event of every DUT before it. Events
+// queued before a STOP carry the cancelled session and are skipped
+QueueHandle_t getDUTCompleteQueue();
 
 #endif // UART_FUNCTIONS_H
@@ -0,0 +1,81 @@
+#ifndef BASELINE_STORE_H
+#define BASELINE_STORE_H
+
+#include <Arduino.h>
+#include "defines.h"
+#include "sweep_table.h"
+#include "cal_set.h"
+
+/*=========================BASELINE PERSISTENCE=========================*/
+// A finished baseline sweep is written to BASELINE_FILE, so a reboot between
+// BASELINE_START and MEAS_START does not cost the baseline sweep again. The
+// file holds a BaselineHeader (sweep plan, store layout, calibration set)
+// and one fixed-size BaselineDutRecord per DUT of the plan. It is written
+// through the storage queue into BASELINE_TMP_FILE and renamed over the old
+// one only when complete, so a reset mid-write keeps the previous file
+//
+// At boot the file is read back into the baseline rows before any task runs:
+// the same store layout is required, the baseline circuit fit and KK check
+// are run again from the rows, and the final sweep is offered at once. A new
+// baseline or a store relayout removes the file. A final sweep is refused
+// while the active calibration set is not the one the baseline was taken
+// with (an STM32 ID that selects another set after the restore)
+#define BASELINE_FILE           "/baseline.dat"
+#define BASELINE_TMP_FILE       "/baseline.tmp"
+#define BASELINE_MAGIC          0x4C534142  // "BASL"
+#define BASELINE_VERSION        1
+
+struct __attribute__((packed)) BaselineHeader {
+    uint32_t magic;         // BASELINE_MAGIC
+    uint16_t version;       // BASELINE_VERSION
+    uint8_t storeDuts;      // getDUTCount() of the writer
+    uint8_t storePoints;    // getPointsPerDUT() of the writer
+    uint8_t numDuts;        // Sweep plan - DUT records that follow
+    uint8_t startIdx;
+    uint8_t endIdx;
+    SweepMask mask;
+    char calSet[CAL_SET_NAME_MAX];  // getCalibrationSetName() of the sweep
+    uint16_t crc;           // CRC-16/CCITT (crc.h) of everything before it
+};
+
+// One stored point - frequency in Hz so off-grid points outlive the RAM axis
+struct __attribute__((packed)) BaselinePoint {
+    uint32_t freq_hz;
+    float mag;
+    float phase;
+    uint8_t flags;          // IMPEDANCE_FLAG_* | PGA gain
+    uint8_t magSd;          // PointNoise spread (repeat_filter.h)
+    uint8_t phaseSd;
+};
+
+struct __attribute__((packed)) BaselineDutRecord {
+    uint8_t dut;            // 0-based
+    uint8_t count;          // Stored points, zero past it
+    BaselinePoint points[MAX_FREQUENCIES];
+    uint16_t crc;           // CRC-16/CCITT of everything before it
+};
+
+// GUI task, once a baseline sweep completed: note its calibration set for
+// the final sweep check and, with persist, queue the file write
+bool saveBaseline(bool persist);
+
+// Remove the stored baseline (new baseline, store relayout)
+void forgetStoredBaseline();
+
+// Boot, after initMeasurementStore() and before the tasks start: load the
+// stored baseline into the rows. Returns true if one was restored
+bool restoreBaseline();
+
+// The baseline was taken with the active calibration set
+bool isBaselineCalibrationCurrent();
+
+// The baseline in the rows as the file holds it - header, then one record
+// per DUT of header.numDuts (GUI task, between sweeps)
+void packBaselineHeader(BaselineHeader& header);
+void packBaselineRecord(uint8_t dut, BaselineDutRecord& record);
+
+// Boot, like restoreBaseline() but from packed records kept elsewhere (deep
+// sleep, sleep_monitor.h). False if they do not fit the store layout
+bool restoreBaselineRecords(const BaselineHeader& header, const BaselineDutRecord* records);
+
+#endif // BASELINE_STORE_H
@@ -0,0 +1,42 @@
+#ifndef BG_JOBS_H
+#define BG_JOBS_H
+
+#include <Arduino.h>
+
+/*=========================BACKGROUND JOBS=========================*/
+// Cooperative low-priority work of the GUI task: steps that need not run
+// the moment they become possible - a finished DUT's BLE encoding, its
+// risk / fit / KK / metric reports and its session archive. Jobs run in the
+// order they were queued, from processBackgroundJobs():
+//   - no sweep running: at once
+//   - during a sweep: only while the sweep time model (sweep_eta.h)
+//     predicts a frame gap of at least BG_JOB_GAP_MS, or once the oldest
+//     job has waited BG_JOB_DEFER_MAX_MS
+// A pass runs jobs for at most BG_JOB_SLICE_MS, so the work of one DUT is
+// spread over the slow points of the next instead of one burst at DUT_END
+//
+// Whatever reads a job's results (the results screen) or overwrites its
+// inputs (a sweep of the same kind, a new channel layout) calls
+// flushBackgroundJobs() first. A baseline's jobs run on into the final sweep
+// (meas_control.h); the sweep complete messages are a job behind them
+#define BG_JOB_QUEUE_DEPTH      32      // 3 jobs per DUT for MAX_DUT_COUNT plus slack
+#define BG_JOB_GAP_MS           40      // Predicted frame gap a job may start in
+#define BG_JOB_SLICE_MS         20      // Job time per GUI loop pass
+#define BG_JOB_DEFER_MAX_MS     2000    // Longest a job waits for a gap
+#define BG_JOB_RETRY_MS         10      // Re-check period while jobs wait
+
+typedef void (*BackgroundJobFn)(uint8_t arg);
+
+// Queue fn(arg) - runs it at once when the queue is full (GUI task)
+void queueBackgroundJob(BackgroundJobFn fn, uint8_t arg);
+
+// Run every queued job now (GUI task)
+void flushBackgroundJobs();
+
+// GUI task loop: run the jobs that fit (see above)
+void processBackgroundJobs();
+
+// Milliseconds until processBackgroundJobs() has work, UINT32_MAX if none is queued
+uint32_t getBackgroundJobsWaitMs();
+
+#endif // BG_JOBS_H
@@ -0,0 +1,68 @@
+#ifndef BIOPAL_SDK_H
+#define BIOPAL_SDK_H
+
+#include "ble_binary.h"
+#include "session_codec.h"
+#include "uart_frame.h"
+
+/*=========================HOST SDK=========================*/
+// C ABI over the firmware's platform-free decoders, for host tools: the
+// STM32 UART stream (uart_frame.h), session history images (session_codec.h)
+// and BLE binary notifications (ble_binary.h). [env:sdk] builds it as a
+// shared library, biopal_sdk.py binds it with ctypes
+//
+// Decoders read the caller's buffer in place - frames and record headers
+// come back as offsets or pointers into it, only decoded points are written
+// to caller memory. The buffer must outlive what points into it
+#define BIOPAL_SDK_VERSION  1
+
+// A frame of a UART stream: payload at data + offset
+struct BiopalFrame {
+    uint32_t offset;
+    uint16_t len;
+    uint8_t type;           // UART_DATA_*
+    uint8_t v2;             // CRC-protected v2 framing
+};
+
+// A decoded BLE binary point
+struct BiopalPoint {
+    uint32_t freq_hz;
+    float mag;
+    float phase;
+    uint8_t magSd;          // BLE_BIN_FLAG_SPREAD only, else 0
+    uint8_t phaseSd;
+};
+
+// Open iteration over a history image (BiopalHistory, biopal_sdk.cpp)
+struct BiopalHistory;
+
+extern "C" {
+
+int biopalSdkVersion(void);
+
+// Index the complete frames of data (scanUARTFrames()) into frames, at most
+// maxFrames. *consumed is set to the bytes used or skipped - a trailing
+// partial frame is left for the next call. counters are added to, as the
+// reader does. Returns the frames found: more than maxFrames means frames
+// was too small and only its first maxFrames are set
+size_t biopalIndexUARTFrames(const uint8_t* data, size_t len, BiopalFrame* frames, size_t maxFrames,
+                             size_t* consumed, UARTFrameCounters* counters);
+
+// Iterate the sessions of a history image, oldest first. Damaged records,
+// and delta records whose reference is not in the image, are skipped
+BiopalHistory* biopalHistoryOpen(const uint8_t* image, size_t len);
+void biopalHistoryClose(BiopalHistory* history);
+
+// Next session: *header points into the image, *pos is its offset there and
+// out holds the decoded points. false once the image is done
+bool biopalHistoryNext(BiopalHistory* history, const SessionHeader** header, size_t* pos, Session* out);
+
+// Points of a BLE_BIN_TYPE_DATA / BLE_BIN_TYPE_POINT notification into
+// points (room for MAX_FREQUENCIES); *header points into data
+// Returns the points, -1 if data is not a complete notification of either type
+int biopalDecodeBinaryPacket(const uint8_t* data, size_t len, const BLEBinaryHeader** header,
+                             BiopalPoint* points);
+
+}
+
+#endif // BIOPAL_SDK_H
@@ -0,0 +1,45 @@
+#ifndef BLE_BENCH_H
+#define BLE_BENCH_H
+
+#include <Arduino.h>
+
+/*=========================BLE THROUGHPUT BENCHMARK=========================*/
+// BLE_BENCH streams synthetic impedance payloads to the client that sent it,
+// through the same TX task, credits and encoders as real DATA, and reports
+// what the link sustained:
+//   BLE_BENCH:<bytes>[,<BIN|JSON>[,<chunk>[,<NOTIFY|INDICATE>]]]
+//   BLE_BENCH:STOP                       - abort, report what was sent
+//   BLE_BENCH:RESULT,<notifications>,<bytes>
+//                                        - client-side counts of the last run,
+//                                          answered with BENCH_RESULT (drops)
+// chunk 0 = the connection's MTU payload. BIN payloads are a BLEBenchHeader
+// and synthetic BLEBinaryPoints filling each chunk; JSON payloads are one
+// DATA-like document of a full sweep per message, encoded per message
+#define BLE_BENCH_DEFAULT_BYTES     32768
+#define BLE_BENCH_MAX_BYTES         (1024UL * 1024UL)
+#define BLE_BENCH_TX_RESERVE        2048    // TX buffer bytes kept free for other messages
+#define BLE_BENCH_MSG_MAX           1536    // Largest JSON message queued at once
+#define BLE_BENCH_IDLE_MS           5000    // No TX progress for this long ends the run
+
+#define BLE_RESP_BENCH              "BENCH"
+#define BLE_RESP_BENCH_RESULT       "BENCH_RESULT"
+
+struct __attribute__((packed)) BLEBenchHeader {
+    uint8_t magic;          // BLE_BIN_MAGIC
+    uint8_t type;           // BLE_BIN_TYPE_BENCH
+    uint16_t reserved;
+    uint32_t seq;           // Message number from 0 - gaps are drops
+};
+
+// Parse and run a BLE_BENCH command (everything after "BLE_BENCH:")
+// Replies STATUS / ERROR itself
+void handleBLEBenchCommand(const char* args);
+
+// Queue the next bench messages and report a finished run - called from the
+// GUI task loop, returns at once while the TX buffer is full
+void processBLEBench();
+
+// A run is being streamed or waits for its TX task to drain
+bool isBLEBenchActive();
+
+#endif // BLE_BENCH_H
@@ -0,0 +1,69 @@
+#ifndef BLE_BINARY_H
+#define BLE_BINARY_H
+
+#include "hal.h"
+
+/*=========================BINARY DATA FORMAT=========================*/
+// Platform-free, so the host SDK (biopal_sdk.h) decodes the notifications
+// with the same layout
+//
+// After FORMAT:BIN a DUT's data goes out as binary notifications instead of
+// DATA:{json} - a BLEBinaryHeader plus count fixed-size points, split so every
+// notification fits the negotiated MTU (38 points fit one notification from
+// an MTU of 247). The first byte is never printable, so clients tell binary
+// notifications from text messages by it. JSON stays the default until the
+// client asks, and again after every reconnect
+//
+// A DUT delivered at DUT_END is one message for binary clients: the first
+// part stands for DUT_START and the last, flagged BLE_BIN_FLAG_END, for
+// DUT_END - neither text message is sent to them. A DUT without points
+// still sends one empty part
+#define BLE_BIN_MAGIC           0xB1
+#define BLE_BIN_TYPE_DATA       0x01
+#define BLE_BIN_TYPE_POINT      0x02    // One live point (STREAM:1) - part = its index in the sweep
+#define BLE_BIN_TYPE_BENCH      0x03    // BLE_BENCH payload - BLEBenchHeader (ble_bench.h)
+#define BLE_BIN_TYPE_FLEET      0x04    // Relayed peer notification - FleetFrameHeader (fleet_aggregator.h)
+#define BLE_BIN_TYPE_MIRROR     0x05    // Screen tiles - ScreenMirrorHeader (screen_mirror.h)
+#define BLE_BIN_TYPE_SUMMARY    0x06    // Thread uplink datagram - ThreadSummaryHeader (thread_uplink.h)
+
+#define BLE_BIN_FLAG_SPREAD     0x01    // Points are BLEBinarySpreadPoint (repeats > 1)
+#define BLE_BIN_FLAG_FINAL      0x02    // Final sweep (else baseline)
+#define BLE_BIN_FLAG_END        0x04    // Last part of a DUT_END delivery (not GET_DATA)
+
+// BLEBinaryPoint.freq: sweep table index (sweep_table.h), or with
+// BLE_BIN_FREQ_OFFGRID set an off-grid frequency in BLE_BIN_OFFGRID_STEP_HZ
+#define BLE_BIN_FREQ_OFFGRID    0x8000
+#define BLE_BIN_OFFGRID_STEP_HZ 10
+
+// BLEBinaryPoint.mag = (log10(|Z|) - BLE_BIN_MAG_LOG_MIN) * BLE_BIN_MAG_LOG_SCALE
+// 0.1 Ohm to 10 MOhm in 0.03 % steps
+#define BLE_BIN_MAG_LOG_MIN     (-1.0f)
+#define BLE_BIN_MAG_LOG_SCALE   8192.0f
+
+// BLEBinaryPoint.phase: centidegrees
+#define BLE_BIN_PHASE_SCALE     100.0f
+
+struct __attribute__((packed)) BLEBinaryHeader {
+    uint8_t magic;          // BLE_BIN_MAGIC
+    uint8_t type;           // BLE_BIN_TYPE_DATA
+    uint8_t dut;            // DUT number (1-based)
+    uint8_t flags;          // BLE_BIN_FLAG_*
+    uint8_t part;           // Notification index (0-based)
+    uint8_t parts;          // Notifications for this DUT
+    uint8_t count;          // Points in this notification
+    uint8_t total;          // Points for this DUT
+};
+
+struct __attribute__((packed)) BLEBinaryPoint {
+    uint16_t freq;
+    uint16_t mag;
+    int16_t phase;
+};
+
+struct __attribute__((packed)) BLEBinarySpreadPoint {
+    BLEBinaryPoint point;
+    uint8_t magSd;          // POINT_NOISE_MAG_STEP units (repeat_filter.h)
+    uint8_t phaseSd;        // POINT_NOISE_PHASE_STEP units
+};
+
+#endif // BLE_BINARY_H
@@ -6,8 +6,30 @@
 /*=========================BODE PLOT=========================*/
 
 // Draw Bode plot for a specific DUT
-// dutIndex: 0-3 (DUT 1-4)
+// dutIndex: 0-based (DUT number - 1)
 // Shows impedance magnitude (log-log, solid) and phase (semi-log, dashed)
 void drawBodePlot(uint8_t dutIndex);
 
+/*=========================LIVE PLOT=========================*/
+// GUI_LIVE_PLOT shows the DUT being swept, point by point as the data
+// processor stores them. New points only draw their line segments; a point
+// off the axes rescales them and redraws the whole plot
+
+// Lay out and draw the plot of the points stored so far (renderCurrentScreen)
+void drawLiveBodePlot();
+
+// Draw the points stored since the last call - called from the GUI task loop
+void processLiveBodePlot();
+
+/*=========================OVERLAY PLOT=========================*/
+// GUI_OVERLAY: baseline and final |Z| of one DUT with |dZ|/Z (right axis,
+// dashed). The axes fit every measured DUT and are laid out once, so
+// switching DUTs only maps and draws the new data
+
+// Fit the axes again at the next draw (new results)
+void resetOverlayPlot();
+
+// Draw the overlay of dutIndex (renderCurrentScreen)
+void drawOverlayPlot(uint8_t dutIndex);
+
 #endif // BODE_PLOT_H
@@ -0,0 +1,25 @@
+#ifndef BOOT_TIMING_H
+#define BOOT_TIMING_H
+
+#include <Arduino.h>
+#include "esp_timer.h"
+
+// Boot stage timeline - setup() and the boot tasks record when each stage
+// began and ended (esp_timer_get_time), so overlapping stages show up as
+// such. Printed once the system is ready and with the "boot" serial command
+
+#define BOOT_MAX_STAGES     12
+#define BOOT_NO_STAGE       0xFF
+
+// Start a stage; returns its id for bootStageEnd (BOOT_NO_STAGE if full)
+// Safe to call from any task
+uint8_t bootStageBegin(const char* name);
+void bootStageEnd(uint8_t stage);
+
+// Everything is up - records time-to-ready
+void bootReady();
+
+// Per-stage start, end and duration, relative to the app start
+void printBootTimes();
+
+#endif // BOOT_TIMING_H
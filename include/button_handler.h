@@ -7,11 +7,14 @@
 
 /*=========================BUTTON HANDLER CONFIGURATION=========================*/
 
-// Debounce time in milliseconds
-#define BUTTON_DEBOUNCE_MS 250
+// Timings in milliseconds
+#define BUTTON_DEBOUNCE_MS 20        // Level is read this long after an edge
+#define BUTTON_LONG_PRESS_MS 600     // Held this long: BTN_EVENT_LONG, then auto-repeat
+#define BUTTON_REPEAT_MS 120         // Auto-repeat period of UP/DOWN
 
-// Encoder configuration
+// Encoder configuration (decoded by the PCNT peripheral)
 #define ENCODER_PULSES_PER_DETENT 2  // Adjust based on encoder type
+#define ENCODER_GLITCH_NS 10000      // Pulses shorter than this are ignored (C6 limit ~12.7 us)
 
 /*=========================BUTTON HANDLER FUNCTIONS=========================*/
 
@@ -0,0 +1,51 @@
+#ifndef CAL_ACQUIRE_H
+#define CAL_ACQUIRE_H
+
+#include <Arduino.h>
+#include "defines.h"
+
+/*=========================CALIBRATION ACQUISITION=========================*/
+// On-device calibration against a known reference resistor on channel 1:
+// one baseline sweep per TIA/PGA combination (TIA and PGA set through the
+// UART command pipeline before each START), the raw points averaged per
+// (frequency, TIA, PGA), then the fused gains computed in place and written
+// to the "calib" partition as a calibration image (cal_image.h), followed by
+// reloadCalibration(). Replaces the calibration_tool.py round trip
+//
+// A resistor has 0 degrees phase, so per entry:
+//   gain         = R_ref / |Z_raw|
+//   phase_offset = -arg(Z_raw)
+// Points are filed under the gains the STM32 reports, so a combination the
+// STM32 ranged away from stays invalid - with CAL_MODEL_PRIOR it is filled
+// from the front-end model (cal_model.h) instead
+//
+// Started by "cal acquire [ohms]" or a held RIGHT on the settings screen.
+// Progress on Serial as @EVT cal_start / cal_step / cal_end lines
+#ifndef CAL_ACQUIRE_REF_OHMS
+#define CAL_ACQUIRE_REF_OHMS    1000.0f     // Reference resistor fitted for the GUI start
+#endif
+
+#define CAL_ACQUIRE_STEPS       (2 * 8)     // TIA x PGA combinations, one sweep each
+#define CAL_ACQUIRE_MIN_POINTS  1           // Raw points an entry needs to be valid
+
+// Start an acquisition (GUI task). Returns false if a sweep, monitor or
+// calibration upload is running, there is no calib partition or refOhms <= 0
+bool startCalAcquire(float refOhms);
+
+// Abandon a running acquisition - the partition is not touched
+void abortCalAcquire(const char* reason);
+
+// Next combination or the flash write - called from the GUI task loop
+void processCalAcquire();
+
+// A sweep finished (GUI task, after the export) - moves on to the next step
+void calAcquireSweepComplete();
+
+// Data processor: file one raw point of channel 1 (ignored unless an
+// acquisition is recording)
+void recordCalAcquirePoint(const MeasurementPoint& point);
+
+// An acquisition is running (recording points or writing the image)
+bool isCalAcquireActive();
+
+#endif // CAL_ACQUIRE_H
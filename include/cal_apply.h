@@ -0,0 +1,30 @@
+#ifndef CAL_APPLY_H
+#define CAL_APPLY_H
+
+#include "hal.h"
+#include "calibration.h"
+
+/*=========================CALIBRATION APPLY=========================*/
+// The per-point side of calibration: the tables the data processor reads and
+// the lookup, formula and fused-LUT corrections. No filesystem or RTOS
+// dependencies (loading stays in calibration.cpp), so it builds for the host
+// ([env:native]) - fill the tables directly and call the calibrateWith*()
+// functions declared in calibration.h
+
+// All entries invalid - calibrationLUT until the first table is applied
+extern const CalLUTEntry emptyCalibrationLUT[SWEEP_FREQ_COUNT][2][8];
+
+// Apply a polar correction factor gain*e^(j*phase_deg) to an impedance point
+void applyCalibrationFactor(ImpedancePoint& point, float gain, float phase_deg);
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+// Lookup mode: Z_gain and -phase_offset of the calibrationData entry
+// Returns false if the frequency/gain combination has no entry
+bool calibrateWithLookup(ImpedancePoint& point);
+#endif
+
+// Make lut the table calibrateWithSeparateFiles() reads and rebuild its
+// interpolation slopes - data processor only (setActiveCalibrationLUT)
+void setCalibrationApplyTable(const CalLUTRow* lut);
+
+#endif // CAL_APPLY_H
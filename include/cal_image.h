@@ -0,0 +1,58 @@
+#ifndef CAL_IMAGE_H
+#define CAL_IMAGE_H
+
+#include "hal.h"
+#include "calibration.h"
+#ifdef ARDUINO
+#include "esp_partition.h"
+#endif
+
+/*=========================CALIBRATION IMAGE=========================*/
+// Compiled calibration image in its own flash partition, read in place
+// through esp_partition_mmap - no file system access or parsing at boot
+// The CSVs in data/ are the source format, compiled on the host
+//
+// Layout (little-endian):
+//   CalImageHeader
+//   uint32_t    frequencies[freqCount]          - must match sweepFrequencies
+//   CalLUTEntry entries[freqCount][2][8]        - fused gain/phase (see calibration.h)
+#define CAL_IMAGE_PARTITION_LABEL   "calib"
+#define CAL_IMAGE_PARTITION_SUBTYPE 0x40        // Custom data subtype (partitions.csv)
+#define CAL_IMAGE_MAGIC             0x4C414342  // "BCAL"
+#define CAL_IMAGE_VERSION           1
+
+struct __attribute__((packed)) CalImageHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;    // sizeof(CalImageHeader)
+    uint16_t freqCount;     // SWEEP_FREQ_COUNT
+    uint8_t tiaCount;       // 2
+    uint8_t pgaCount;       // 8
+    uint16_t entrySize;     // sizeof(CalLUTEntry)
+    uint16_t reserved;
+    uint32_t payloadSize;   // Bytes after the header
+    uint16_t payloadCRC;    // CRC-16/CCITT-FALSE over the payload
+    uint16_t headerCRC;     // CRC-16/CCITT-FALSE over the header up to here
+};
+
+static_assert(sizeof(CalImageHeader) == 24, "CalImageHeader layout is part of the image format");
+static_assert(sizeof(CalLUTEntry) == 12, "CalLUTEntry layout is part of the image format");
+
+// The layout above is platform-free - cal_compile.py writes the same format
+#ifdef ARDUINO
+
+// Map the calibration partition and validate the image
+// Returns the fused entries ([freqCount][2][8]) on success, nullptr if the
+// partition is missing, empty or invalid. The mapping stays valid until reboot
+const CalLUTEntry* mapCalibrationImage();
+
+// The "calib" partition, nullptr if the partition table has none
+const esp_partition_t* findCalibrationPartition();
+
+// Drop the mapping - the next mapCalibrationImage() maps and validates again
+// Nothing may still point into the image (see releaseCalibrationImage)
+void unmapCalibrationImage();
+
+#endif
+
+#endif // CAL_IMAGE_H
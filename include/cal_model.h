@@ -0,0 +1,187 @@
+#ifndef CAL_MODEL_H
+#define CAL_MODEL_H
+
+#include "hal.h"
+#include "calibration.h"
+
+/*=========================ANALYTIC FRONT-END MODEL=========================*/
+// Single-pole model of the analog front end, evaluated by the compiler over
+// the sweep table into flash - no atan/sqrt and nothing to load at runtime:
+//   Voltage  INA331, gain V_gain, pole at V_GBW / V_gain, inverting (180 deg)
+//   TIA      TIA_Gains[tia_gain flag] ohms, flat, inverting (-180 deg)
+//   PGA      PGA113 gain, pole at PGA_Cutoff[gain]
+// Stage phases follow the voltage / tia / pga CSVs, so a model stage can
+// stand in for a missing CSV entry. The TIA is flat: its pole is set by the
+// feedback network, not the transimpedance - the GBW / R pole of the old
+// single-pole sketch put the 7.5k range at 5 kHz, where tia_high.csv is flat
+// The TLV9061 stage (TLV_gain) is on both paths and cancels in Z
+//
+// Used as the prior of the fused table (-D CAL_MODEL_PRIOR=0 leaves it out):
+// - a (frequency, TIA, PGA) entry whose voltage, TIA or PGA data is missing
+//   takes that stage from the model instead of staying invalid, and with no
+//   calibration files at all the fused model table is used in place
+// - off-grid points interpolate between two sweep frequencies along the
+//   model's curvature instead of a straight line in ln(f)
+// - an acquisition (cal_acquire.h) fills the combinations it did not reach
+//   from the model, anchored to the nearest frequency it did measure
+#ifndef CAL_MODEL_PRIOR
+#define CAL_MODEL_PRIOR 1
+#endif
+
+constexpr float V_GBW = 10.0f;      // Gain Bandwidth Product in MHz
+constexpr float V_gain = 15.4f;     // Voltage Gain of the INA331 Instrumentation Amplifier
+constexpr float PGA_Cutoff[8] = {   // Cutoff frequencies for each PGA gain setting (in MHz)
+    10.0f,  // Gain = 1
+    3.8f,   // Gain = 2
+    1.8f,   // Gain = 5
+    1.8f,   // Gain = 10
+    1.3f,   // Gain = 20
+    0.9f,   // Gain = 50
+    0.38f,  // Gain = 100
+    0.23f   // Gain = 200
+};
+constexpr float I_GBW = 40.0f;      // Gain Bandwidth Product in MHz (TIA op amp)
+constexpr float TIA_Gains[2] = {7500.0f, 37.5f};   // TIA Gains for High and Low modes respectively
+constexpr float TLV_gain = 20.0f;   // Gain of the TLV9061 OpAmp which is identical on both current and voltage stages
+
+// Measured entries further than this from the model are reported by an acquisition
+#define CAL_MODEL_MAX_RATIO     4.0f        // Gain factor either way
+
+// One stage at one sweep frequency, as in the stage CSVs
+struct CalModelStage {
+    float gain;
+    float phase_offset;     // Degrees
+};
+
+// Model curvature across segment i (sweep index i -> i + 1): model at the
+// geometric mid frequency against the straight line between both ends
+struct CalModelBow {
+    float gain;             // Relative: mid / line - 1
+    float phase;            // Degrees: mid - line
+};
+
+namespace cal_model_detail {
+constexpr double PI = 3.14159265358979323846;
+constexpr double RAD_TO_DEG = 180.0 / PI;
+
+constexpr double sqrt(double x) {
+    if (x <= 0.0) return 0.0;
+    double r = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 100; i++) {
+        double next = 0.5 * (r + x / r);
+        if (next == r) break;
+        r = next;
+    }
+    return r;
+}
+
+// atan for x >= 0: above 1 through pi/2 - atan(1/x), then two half-angle
+// steps bring x under 0.2, where the series converges in a few dozen terms
+constexpr double atan(double x) {
+    if (x > 1.0) return PI / 2 - atan(1.0 / x);
+    for (int i = 0; i < 2; i++) x = x / (1.0 + sqrt(1.0 + x * x));
+    double x2 = x * x;
+    double term = x;
+    double sum = 0.0;
+    for (int k = 1; k < 60; k += 2) {
+        sum += (k % 4 == 1 ? term : -term) / k;
+        term *= x2;
+    }
+    return 4.0 * sum;
+}
+
+// Single pole at poleHz: |H| and arg(H) in degrees
+constexpr double poleGain(double hz, double poleHz) {
+    double r = hz / poleHz;
+    return 1.0 / sqrt(1.0 + r * r);
+}
+constexpr double polePhase(double hz, double poleHz) {
+    return -atan(hz / poleHz) * RAD_TO_DEG;
+}
+
+constexpr double voltagePoleHz() {
+    return (double)V_GBW / V_gain * 1e6;
+}
+
+constexpr CalModelStage voltageAt(double hz) {
+    return {(float)(V_gain * poleGain(hz, voltagePoleHz())),
+            (float)(180.0 + polePhase(hz, voltagePoleHz()))};
+}
+
+constexpr CalModelStage tiaAt(int tia) {
+    return {TIA_Gains[tia], -180.0f};
+}
+
+constexpr CalModelStage pgaAt(double hz, int pga) {
+    constexpr int gains[8] = {1, 2, 5, 10, 20, 50, 100, 200};
+    return {(float)(gains[pga] * poleGain(hz, PGA_Cutoff[pga] * 1e6)),
+            (float)polePhase(hz, PGA_Cutoff[pga] * 1e6)};
+}
+
+// Fused as buildCalibrationLUT() does, the phase wrapped to (-180, 180]
+constexpr CalLUTEntry fusedAt(double hz, int tia, int pga) {
+    CalModelStage v = voltageAt(hz);
+    CalModelStage i = tiaAt(tia);
+    CalModelStage p = pgaAt(hz, pga);
+    double phase = -(double)v.phase_offset + i.phase_offset + p.phase_offset;
+    while (phase > 180.0) phase -= 360.0;
+    while (phase <= -180.0) phase += 360.0;
+    return {i.gain * p.gain / v.gain, (float)phase, true, {0, 0, 0}};
+}
+
+struct Tables {
+    CalModelStage voltage[SWEEP_FREQ_COUNT];
+    CalModelStage tia[2];
+    CalModelStage pga[SWEEP_FREQ_COUNT][8];
+    CalLUTEntry fused[SWEEP_FREQ_COUNT][2][8];
+    CalModelBow bow[SWEEP_FREQ_COUNT - 1][2][8];
+};
+
+constexpr Tables buildTables() {
+    Tables t{};
+    for (int tia = 0; tia < 2; tia++) {
+        t.tia[tia] = tiaAt(tia);
+    }
+    for (int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        double hz = sweepFrequencies[f];
+        t.voltage[f] = voltageAt(hz);
+        for (int pga = 0; pga < 8; pga++) {
+            t.pga[f][pga] = pgaAt(hz, pga);
+            for (int tia = 0; tia < 2; tia++) {
+                t.fused[f][tia][pga] = fusedAt(hz, tia, pga);
+            }
+        }
+    }
+    for (int s = 0; s < SWEEP_FREQ_COUNT - 1; s++) {
+        double mid = sqrt((double)sweepFrequencies[s] * sweepFrequencies[s + 1]);
+        for (int tia = 0; tia < 2; tia++) {
+            for (int pga = 0; pga < 8; pga++) {
+                const CalLUTEntry& a = t.fused[s][tia][pga];
+                const CalLUTEntry& b = t.fused[s + 1][tia][pga];
+                CalLUTEntry m = fusedAt(mid, tia, pga);
+                t.bow[s][tia][pga].gain = m.gain / (0.5f * (a.gain + b.gain)) - 1.0f;
+                t.bow[s][tia][pga].phase = m.phase_offset - 0.5f * (a.phase_offset + b.phase_offset);
+            }
+        }
+    }
+    return t;
+}
+} // namespace cal_model_detail
+
+inline constexpr cal_model_detail::Tables calModel = cal_model_detail::buildTables();
+
+// The generator against values worked out by hand (voltage pole 649 kHz,
+// PGA x200 pole 230 kHz)
+static_assert(calModel.voltage[0].gain > 15.21f && calModel.voltage[0].gain < 15.23f &&
+              calModel.voltage[0].phase_offset > 171.2f && calModel.voltage[0].phase_offset < 171.3f,
+              "constexpr model off at 100 kHz (voltage)");
+static_assert(calModel.pga[0][7].gain > 183.3f && calModel.pga[0][7].gain < 183.5f &&
+              calModel.pga[0][7].phase_offset > -23.6f && calModel.pga[0][7].phase_offset < -23.4f,
+              "constexpr model off at 100 kHz (PGA x200)");
+
+// The fused model as a calibration table (flash, never freed)
+constexpr const CalLUTRow* getCalModelLUT() {
+    return calModel.fused;
+}
+
+#endif // CAL_MODEL_H
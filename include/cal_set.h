@@ -0,0 +1,49 @@
+#ifndef CAL_SET_H
+#define CAL_SET_H
+
+#include <Arduino.h>
+
+/*=========================CALIBRATION SETS=========================*/
+// Boards with different analog front ends each get a named set of the
+// separate-files CSVs on LittleFS:
+//   /voltage.csv, /tia_high.csv, ...          - default set (no name)
+//   /cal/<set>/voltage.csv, ...               - named set
+//   /cal/devices.csv                          - "stm32_id,set" lines
+//
+// The active set is, in order: the stored ID (CAL_SET_ID_FILE), the set
+// mapped to the STM32's unique ID (or a set named after the ID), the default.
+// Only the active set is parsed and only its fused table is kept in RAM; each
+// set has its own fused table cache (<set dir>/cal_lut.bin)
+#define CAL_SET_DIR         "/cal"
+#define CAL_SET_DEVICE_MAP  "/cal/devices.csv"
+#define CAL_SET_ID_FILE     "/cal_set.txt"      // Stored set name - overrides the STM32 ID
+#define CAL_SET_NAME_MAX    32                  // Including the terminator
+
+// Resolve the active set (LittleFS must be mounted)
+// Returns true if the active set changed
+bool selectCalibrationSet();
+
+// Active set name, "" for the default set
+const char* getCalibrationSetName();
+
+// Boot without LittleFS (deep-sleep wake, sleep_monitor.h): take the name of
+// the set whose rows were kept
+void restoreCalibrationSetName(const char* name);
+
+// Path of a calibration file ("/voltage.csv") inside the active set
+String calibrationSetPath(const char* file);
+
+// Store (or with "" clear) the set name that overrides the STM32 ID
+// Returns false for an invalid name or a set that does not exist
+bool storeCalibrationSet(const char* name);
+
+// Print all sets, the stored ID and the STM32 ID to Serial
+void printCalibrationSets();
+
+// GUI task: once the STM32 ID arrives, reload if it selects another set
+void processCalibrationSetSelection();
+
+// The ID has arrived but the selection waits for a reload or upload
+bool isCalibrationSetSelectionWaiting();
+
+#endif // CAL_SET_H
@@ -0,0 +1,40 @@
+#ifndef CAL_UPLOAD_H
+#define CAL_UPLOAD_H
+
+#include <Arduino.h>
+
+/*=========================CALIBRATION IMAGE UPLOAD=========================*/
+// Receives a compiled calibration image (cal_image.h, from cal_compile.py)
+// over the BLE calibration characteristic and streams it into the "calib"
+// partition, then reloads calibration (reloadCalibration)
+//
+// Frame (little-endian), one per BLE write:
+//   uint8_t  type       - CAL_UPLOAD_BEGIN / DATA / END / ABORT
+//   uint16_t seq        - DATA chunk number from 0, 0 otherwise
+//   uint8_t  payload[]  - BEGIN: uint32_t image size, DATA: image bytes
+//   uint16_t crc        - CRC-16/CCITT-FALSE over type..payload
+//
+// Every frame is answered on the TX characteristic with "CAL_ACK:<seq>" or
+// "ERROR:<reason>", and the client must wait for the answer before sending
+// the next frame - there is a single frame buffer. END answers "CAL_ACK:<seq>"
+// only after the image was validated and the reload was staged
+#define CAL_UPLOAD_BEGIN            0x01
+#define CAL_UPLOAD_DATA             0x02
+#define CAL_UPLOAD_END              0x03
+#define CAL_UPLOAD_ABORT            0x04
+
+#define CAL_UPLOAD_FRAME_MAX        512     // Fits the 517-byte MTU (3 bytes ATT header)
+#define CAL_UPLOAD_FRAME_OVERHEAD   5       // type + seq + crc
+#define CAL_UPLOAD_RELEASE_MS       2000    // Max wait for calibration to leave the partition
+
+// BLE write callback: copy one frame into the upload buffer
+// Returns false (frame dropped) if the previous frame is still being processed
+bool calUploadReceive(const uint8_t* data, size_t len);
+
+// Process a received frame - called from the GUI task loop, does the flash I/O
+void processCalUpload();
+
+// An upload has started and not finished or been aborted
+bool isCalUploadInProgress();
+
+#endif // CAL_UPLOAD_H
@@ -1,8 +1,9 @@
 #ifndef CALIBRATION_H
 #define CALIBRATION_H
 
-#include <Arduino.h>
+#include "hal.h"
 #include "defines.h"
+#include "sweep_table.h"
 
 /*=========================CALIBRATION MODE ENUM=========================*/
 enum CalibrationMode {
@@ -11,6 +12,43 @@ enum CalibrationMode {
     CALIBRATION_MODE_SEPARATE_FILES // Use separate CSV files for voltage, TIA, and PGA
 };
 
+// Calibration modes compiled in - a mask of the bits below. With one mode the
+// mode is a constant: calibrate() calls it directly, and the other modes'
+// code and tables (calibrationData, calibrationCoefficients) are left out.
+// With several, setCalibrationMode() switches at runtime
+// (bit = 1 << CalibrationMode, literals so #if can test them)
+#define CAL_PIPELINE_LOOKUP     0x1
+#define CAL_PIPELINE_FORMULA    0x2
+#define CAL_PIPELINE_FUSED      0x4     // CALIBRATION_MODE_SEPARATE_FILES
+#define CAL_PIPELINE_ALL        (CAL_PIPELINE_LOOKUP | CAL_PIPELINE_FORMULA | CAL_PIPELINE_FUSED)
+
+#ifndef CAL_PIPELINE
+#define CAL_PIPELINE CAL_PIPELINE_FUSED
+#endif
+
+#define CAL_PIPELINE_HAS(bit)   ((CAL_PIPELINE & (bit)) != 0)
+#define CAL_PIPELINE_SINGLE     ((CAL_PIPELINE & (CAL_PIPELINE - 1)) == 0)
+
+static_assert(CAL_PIPELINE_FUSED == 1 << CALIBRATION_MODE_SEPARATE_FILES &&
+              CAL_PIPELINE_FORMULA == 1 << CALIBRATION_MODE_FORMULA, "CAL_PIPELINE bits follow CalibrationMode");
+
+// Mode at boot: separate files if compiled in, else formula, else lookup
+#if CAL_PIPELINE & CAL_PIPELINE_FUSED
+#define CAL_PIPELINE_DEFAULT_MODE   CALIBRATION_MODE_SEPARATE_FILES
+#elif CAL_PIPELINE & CAL_PIPELINE_FORMULA
+#define CAL_PIPELINE_DEFAULT_MODE   CALIBRATION_MODE_FORMULA
+#elif CAL_PIPELINE & CAL_PIPELINE_LOOKUP
+#define CAL_PIPELINE_DEFAULT_MODE   CALIBRATION_MODE_LOOKUP
+#else
+#error "CAL_PIPELINE must include at least one calibration mode"
+#endif
+
+// Calibration arithmetic for the separate-files (LUT) mode
+// 0 = float, 1 = integer kernel in fixed_cal.h (the C6 has no FPU)
+#ifndef CAL_FIXED_POINT
+#define CAL_FIXED_POINT 0
+#endif
+
 /*=========================CALIBRATION COEFFICIENTS STRUCT=========================*/
 struct CalibrationCoefficients {
     float m0, m1, m2;  // Magnitude coefficients
@@ -105,16 +143,22 @@ class FreqCalibrationData
 /*=========================GLOBAL CALIBRATION DATA=========================*/
 #define MAX_CAL_FREQUENCIES 38
 
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
 extern FreqCalibrationData calibrationData[MAX_CAL_FREQUENCIES];
 extern int numCalibrationFreqs;
+#endif
 
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
 // Calibration coefficients: [TIA_mode][PGA_gain]
 // TIA_mode: 0=high (7500Ω), 1=low (37.5Ω)
 // PGA_gain: 0-7 (1, 2, 5, 10, 20, 50, 100, 200)
 extern CalibrationCoefficients calibrationCoefficients[2][8];
+#endif
 
+#if !CAL_PIPELINE_SINGLE
 // Current calibration mode
 extern CalibrationMode calibrationMode;
+#endif
 
 /*=========================NEW CALIBRATION DATA ARRAYS=========================*/
 // Separate calibration data for voltage, TIA, and PGA
@@ -136,6 +180,49 @@ extern int numPGAFreqs[8];
 extern FreqCalPoint psTraceCalData[MAX_CAL_FREQUENCIES];
 extern int numPSTraceFreqs;
 
+/*=========================INDEXED CALIBRATION TABLES=========================*/
+// Voltage, TIA, PGA and PS Trace stages fused per sweep frequency index, built
+// once after loading so each point needs a single indexed read. The entry is
+// the complex gain gain*e^(j*phase_offset) applied to Z in polar form
+struct CalLUTEntry {
+    float gain;             // tia_gain * pga_gain / v_gain * ps_mag_ratio
+    float phase_offset;     // -v_phase + tia_phase + pga_phase + ps_phase_offset
+    bool valid;             // Voltage, TIA and PGA present for this combination
+    uint8_t reserved[3];    // Explicit padding - layout is stored in flash
+};
+
+// One frequency row of a fused table - a table is CalLUTRow[SWEEP_FREQ_COUNT]
+typedef CalLUTEntry CalLUTRow[2][8];
+
+// Fused table cache on LittleFS - loaded instead of the CSVs on the next boot
+// The cache is not in data/, so uploading a new filesystem image removes it
+#define CAL_LUT_FILE        "/cal_lut.bin"
+#define CAL_LUT_MAGIC       0x54554C43      // "CLUT"
+#define CAL_LUT_VERSION     1
+
+struct __attribute__((packed)) CalLUTFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entrySize;     // sizeof(CalLUTEntry)
+    uint16_t entryCount;    // SWEEP_FREQ_COUNT * 2 * 8
+    uint16_t crc;           // CRC-16/CCITT over sweepFrequencies + entries
+};
+
+// [freq index][tia_gain flag][PGA gain 0-7] - tia_gain flag as in ImpedancePoint
+// calibrationLUT points at the mapped calibration image (cal_image.h) when one
+// is flashed, otherwise at a heap table built from the CSVs or the cache.
+// Only the data processor switches it (applyPendingCalibrationLUT)
+extern const CalLUTEntry (*calibrationLUT)[2][8];
+
+#define CAL_LUT_TABLE_SIZE  (SWEEP_FREQ_COUNT * 2 * 8 * sizeof(CalLUTEntry))
+
+// Data processor queue timeout while idle, so a staged table is picked up
+// between sweeps even when no batches arrive
+#define CAL_SWAP_POLL_MS    200
+
+// PS Trace calibration by sweep frequency index (gain 1, offset 0 where missing)
+extern SimpleCalPoint psTraceByIndex[SWEEP_FREQ_COUNT];
+
 // Calibration arrays
 // extern float v_phase_shifts[MAX_CAL_FREQUENCIES];
 // extern float v_gain[MAX_CAL_FREQUENCIES];
@@ -146,14 +233,23 @@ extern int numPSTraceFreqs;
 
 /*=========================CALIBRATION FUNCTIONS=========================*/
 
-// Load calibration data from filesystem (/calibration.csv)
+// Load the active mode's calibration data (separate files: from flash or
+// LittleFS, lookup: /calibration.csv)
 // Returns true on success, false on failure
 bool loadCalibrationData();
 
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
 // Load calibration coefficients from filesystem (/calibration_coefficients.csv)
 // Returns true on success, false on failure
 bool loadCalibrationCoefficients();
 
+// Apply calibration using quadratic formula
+// Formula: |Z_x| = |Z_nc| / (m0 + m1*f + m2*f²)
+//          arg(Z_x) = arg(Z_nc) - (a1*f + a2*f²)
+bool calibrateWithFormula(ImpedancePoint& point);
+#endif
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
 // Get calibration point for specific frequency and gain settings
 // Returns pointer to CalibrationPoint or nullptr if not found
 CalibrationPoint* getCalibrationPoint(uint32_t freq, bool lowTIA, uint8_t pgaGain);
@@ -161,21 +257,24 @@ CalibrationPoint* getCalibrationPoint(uint32_t freq, bool lowTIA, uint8_t pgaGai
 // Find the index of a frequency in the calibration data
 // Returns -1 if not found
 int findFrequencyIndex(uint32_t freq);
-
-// Apply calibration using quadratic formula
-// Formula: |Z_x| = |Z_nc| / (m0 + m1*f + m2*f²)
-//          arg(Z_x) = arg(Z_nc) - (a1*f + a2*f²)
-bool calibrateWithFormula(ImpedancePoint& point);
+#endif
 
 // Apply calibration to measured voltage, current, and phase
-// Uses current calibrationMode to select method
+// Uses the calibration mode to select the method
 bool calibrate(ImpedancePoint& point);
 
+#if CAL_PIPELINE_SINGLE
+// Fixed at build time - mode checks fold away
+static inline CalibrationMode getCalibrationMode() {
+    return CAL_PIPELINE_DEFAULT_MODE;
+}
+#else
 // Set calibration mode
 void setCalibrationMode(CalibrationMode mode);
 
 // Get current calibration mode
 CalibrationMode getCalibrationMode();
+#endif
 
 /*=========================NEW CALIBRATION FUNCTIONS=========================*/
 
@@ -188,13 +287,61 @@ bool loadPGACalibration();      // Loads /pga_1.csv through /pga_200.csv
 // Load all new calibration files
 bool loadSeparateCalibrationFiles();
 
+// Build a fused table from the loaded voltage/TIA/PGA and PS Trace data and
+// stage it (made active by loadCalibrationData/reloadCalibration)
+// Returns number of valid entries
+int buildCalibrationLUT();
+
+// Save the staged (or active) table to CAL_LUT_FILE / load and stage it
+// LittleFS must be mounted. Load fails on a missing file, wrong version/size
+// or CRC mismatch
+bool saveCalibrationLUT();
+bool loadCalibrationLUT();
+
+/*=========================HOT RELOAD=========================*/
+// Rebuild the fused table (calibration image, else CSVs) into a second buffer
+// and publish it without touching the active one. Separate-files mode only
+// Returns false if a reload is still pending or loading failed
+bool reloadCalibration();
+
+// Data processor only, between sweeps: switch to a published table and free
+// the old one. Returns true if the table changed
+bool applyPendingCalibrationLUT();
+
+// A reloaded table is waiting for the data processor
+bool isCalibrationReloadPending();
+
+// Boot without the calibration files (deep-sleep wake, sleep_monitor.h):
+// make a table active that holds rows, in index order, at the indices of
+// mask - every other index calibrates as missing. Nothing may calibrate yet
+bool installCalibrationRows(const CalLUTRow* rows, SweepMask mask);
+
+// Coverage map of the active fused table, updated whenever it switches: per
+// sweep index, bit tia * 8 + pga is set where that gain combination has a
+// valid entry (the GAIN_LIMIT_BIT layout, uart_protocol.h). The command task
+// sends it before a START so the STM32 only settles on calibrated gains.
+// CAL_COVERAGE_ALL outside separate-files mode, where every combination
+// calibrates
+#define CAL_COVERAGE_ALL    0xFFFF
+uint16_t getCalibrationCoverage(uint8_t freqIdx);
+
+// Indices of the plan with gain combinations missing, to Serial
+void printCalibrationCoverage(SweepMask plan);
+
+// Before the calibration partition is rewritten: move calibration off the
+// mapped image onto a RAM copy and unmap it. Call until it returns true -
+// the switch itself happens in the data processor
+bool releaseCalibrationImage();
+
 // Get individual calibration values for a specific frequency and settings
 // Returns pointers to SimpleCalPoint or nullptr if not found
 SimpleCalPoint* getVoltageCalPoint(uint32_t freq);
 SimpleCalPoint* getTIACalPoint(uint32_t freq, bool lowTIA);
 SimpleCalPoint* getPGACalPoint(uint32_t freq, uint8_t pgaGain);
 
-// Apply new calibration formula
+// Apply new calibration formula (fused in calibrationLUT, includes PS Trace)
+// Frequencies between sweep points are interpolated linearly in log(f)
+// With IMPEDANCE_RECTANGULAR this is a complex multiply on Z_re/Z_im
 // Formula: mag = (uncalibrated / v_gain) * tia_gain * pga_gain
 //          phase = uncalibrated_phase - v_phase + tia_phase + pga_phase
 bool calibrateWithSeparateFiles(ImpedancePoint& point);
@@ -0,0 +1,55 @@
+#ifndef CIRCUIT_FIT_H
+#define CIRCUIT_FIT_H
+
+#include "hal.h"
+
+/*=========================EQUIVALENT-CIRCUIT FIT=========================*/
+// Randles cell with a constant-phase element in place of the double-layer
+// capacitor (R-CPE):
+//
+//     Z(w) = Rs + Rct / (1 + Rct * Q * (jw)^n)
+//
+// fitted to a DUT's spectrum by Levenberg-Marquardt with analytic Jacobians.
+// The residuals are relative to each point's |Z|, so every decade weighs the
+// same. Each cost evaluation counts against CIRCUIT_FIT_MAX_ITER - the
+// fit is bounded whatever the data. No storage or RTOS dependencies, so it
+// builds for the host ([env:native])
+//
+// The data processor fits every DUT right after its DUT_END; the final
+// sweep starts from the DUT's baseline fit (impedance_calc.h)
+#ifndef CIRCUIT_FIT
+#define CIRCUIT_FIT 1
+#endif
+
+#define CIRCUIT_FIT_MAX_ITER    24      // Cost evaluations per fit
+#define CIRCUIT_FIT_MIN_POINTS  6       // Valid points needed for 4 parameters
+#define CIRCUIT_FIT_TOLERANCE   1e-5f   // Relative cost decrease that ends the fit
+#define CIRCUIT_FIT_N_MIN       0.3f    // CPE exponent range (1 = ideal capacitor)
+#define CIRCUIT_FIT_N_MAX       1.0f
+
+struct CircuitParams {
+    float rs;           // Series (solution) resistance, Ohms
+    float rct;          // Charge-transfer resistance, Ohms
+    float q;            // CPE coefficient, F*s^(n-1)
+    float n;            // CPE exponent
+};
+
+struct CircuitFit {
+    CircuitParams params;
+    float rmsError;     // RMS residual as a fraction of |Z|
+    uint8_t iterations; // Cost evaluations used
+    uint8_t points;     // Valid points fitted
+    bool converged;     // Stopped on the tolerance, not the budget
+    bool valid;         // Enough points and finite parameters
+};
+
+// Fit count points (Hz, Ohms, degrees). Points with freqHz 0 or a
+// non-positive |Z| are skipped. start (nullable, or !valid for none) is tried
+// against the spectrum's own estimate and the better one seeds the fit
+bool fitCircuit(const uint32_t* freqHz, const float* mag, const float* phaseDeg, int count,
+                const CircuitFit* start, CircuitFit& out);
+
+// Model impedance at freqHz, as re/im in Ohms
+void circuitImpedance(const CircuitParams& params, uint32_t freqHz, float& re, float& im);
+
+#endif // CIRCUIT_FIT_H
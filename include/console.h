@@ -0,0 +1,51 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <Arduino.h>
+
+/*=========================CONSOLE OUTPUT=========================*/
+// Every log line, reply and dump goes to Console instead of Serial. A write
+// copies the bytes into CONSOLE_TX_RING_BYTES of RAM under a short critical
+// section and returns; the Console TX task (priority 1, task table) drains
+// the ring into the USB Serial/JTAG port. A slow, full or absent USB host
+// therefore never holds up the UART, processing or BLE tasks
+//
+// Each write is kept as one record (longer ones are split at
+// CONSOLE_RECORD_MAX), so lines of different tasks are not interleaved. When
+// the ring is full the oldest records are dropped and counted - the newest
+// output is what matters after a stall. Nothing is written while no host is
+// attached; the ring keeps the latest output for when one opens the port
+//
+// Host-requested dumps (trace, raw, CSV, binary export) use
+// consoleWriteWait(): their bytes are only useful complete, so the caller
+// waits for ring space while a host is attached and reading
+//
+// Until the Console TX task runs, writes go straight to Serial as before
+#define CONSOLE_TX_RING_BYTES   16384
+#define CONSOLE_RECORD_MAX      1024        // Longer writes are split
+#define CONSOLE_IDLE_WAIT_MS    1000        // Drain task wait for new output
+#define CONSOLE_HOST_POLL_MS    100         // Drain task check for a host without one
+#define CONSOLE_WAIT_MAX_MS     1000        // consoleWriteWait() per record before dropping
+
+class ConsoleOut : public Print {
+public:
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t len) override;
+    using Print::write;
+};
+
+extern ConsoleOut Console;
+
+// Write len bytes, waiting for ring space while a host is reading
+size_t consoleWriteWait(const uint8_t* data, size_t len);
+
+// Write everything queued out now, from the calling task - before a restart
+void flushConsole();
+
+// Ring use and drop counters (serial "stats")
+void printConsoleStats();
+
+// Console TX task - drains the ring into Serial
+void taskConsoleTx(void* parameter);
+
+#endif // CONSOLE_H
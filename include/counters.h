@@ -0,0 +1,99 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include <Arduino.h>
+#include <atomic>
+
+/*=========================FIELD COUNTERS=========================*/
+// Registry of named counters and fixed-bucket histograms, declared at file
+// scope in the module that counts:
+//   static FieldCounter notifyErrors("ble.notify_err");
+//   static FieldHistogram renderUs("gui.render_us", COUNTER_BOUNDS_US);
+// Each links itself into the registry during static initialization. An
+// update is one relaxed atomic add (a compare-and-swap loop for a new
+// maximum), so any task or ISR may count without locks. The numbers are
+// read without a snapshot: a dump taken mid-update can be off by that update
+//
+// Dump: serial "counters", BLE COUNTERS (JSON, see sendBLECounters())
+
+#define COUNTER_MAX_BOUNDS      10      // Histogram buckets: bounds + 1 for the overflow
+
+enum CounterKind : uint8_t {
+    COUNTER_KIND_COUNTER,
+    COUNTER_KIND_HISTOGRAM
+};
+
+struct FieldMetric {
+    const char* name;
+    CounterKind kind;
+    FieldMetric* next;          // Registry list, in declaration order per file
+};
+
+class FieldCounter : public FieldMetric {
+public:
+    explicit FieldCounter(const char* name);
+
+    void add(uint32_t n = 1) {
+        value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint32_t get() const {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    void reset() {
+        value.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> value{0};
+};
+
+// Values up to bounds[i] count in bucket i, larger ones in the last bucket
+class FieldHistogram : public FieldMetric {
+public:
+    template <size_t N>
+    FieldHistogram(const char* name, const uint32_t (&bounds)[N]) : FieldHistogram(name, bounds, N) {
+        static_assert(N > 0 && N <= COUNTER_MAX_BOUNDS, "1 to COUNTER_MAX_BOUNDS histogram bounds");
+    }
+
+    void record(uint32_t value);
+    void reset();
+
+    uint8_t boundCount() const { return boundsCount; }
+    uint32_t bound(uint8_t i) const { return bounds[i]; }
+    uint32_t bucket(uint8_t i) const { return buckets[i].load(std::memory_order_relaxed); }
+    uint32_t count() const { return samples.load(std::memory_order_relaxed); }
+    uint32_t sum() const { return total.load(std::memory_order_relaxed); }
+    uint32_t maximum() const { return peak.load(std::memory_order_relaxed); }
+    uint32_t last() const { return latest.load(std::memory_order_relaxed); }
+
+private:
+    FieldHistogram(const char* name, const uint32_t* bounds, uint8_t count);
+
+    const uint32_t* bounds;
+    uint8_t boundsCount;
+    std::atomic<uint32_t> buckets[COUNTER_MAX_BOUNDS + 1] = {};
+    std::atomic<uint32_t> samples{0};
+    std::atomic<uint32_t> total{0};     // Wraps after 2^32 - mean only over short runs
+    std::atomic<uint32_t> peak{0};
+    std::atomic<uint32_t> latest{0};    // Last value recorded
+};
+
+// Common bucket bounds
+extern const uint32_t COUNTER_BOUNDS_US[10];        // 100 us .. 100 ms
+extern const uint32_t COUNTER_BOUNDS_BYTES[8];      // 1 .. 2048 bytes
+
+// First registered metric - walk with ->next
+const FieldMetric* firstFieldMetric();
+
+// Metric registered under name, nullptr if there is none
+const FieldMetric* findFieldMetric(const char* name);
+
+// Zero every counter and histogram
+void resetFieldCounters();
+
+// One line per metric on the console
+void printFieldCounters();
+
+#endif // COUNTERS_H
@@ -0,0 +1,18 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include "hal.h"
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflection, no final XOR)
+// Used by the v2 UART frame format - must match the STM32 implementation
+// It also guards BLE upload frames, the calibration image and stored
+// records (integrity.h). On the ESP32 it runs the ROM's table-driven
+// routine, so neither the table nor the loop takes flash cache - host
+// builds use the table below
+#define CRC16_CCITT_INIT    0xFFFF
+#define CRC16_CCITT_CHECK   0x29B1  // crc16_ccitt("123456789")
+
+// Compute (or continue, by passing the previous result as crc) a CRC-16/CCITT
+uint16_t crc16_ccitt(const uint8_t* data, size_t len, uint16_t crc = CRC16_CCITT_INIT);
+
+#endif // CRC_H
@@ -4,8 +4,33 @@
 #include <Arduino.h>
 
 /*=========================CSV EXPORT=========================*/
-// Print all impedance data to Serial in CSV format for Excel/plotting
-// Format: DUT,Frequency_Hz,Magnitude_Ohms,Phase_Deg
-void printCSVToSerial();
+// Stored sweeps as CSV text for Excel/plotting (serial "export csv" - sweeps
+// are exported as binary frames after each sweep, usb_export.h)
+// One line per stored point, baseline rows then final rows per DUT, in one
+// pass through a fixed stack buffer written in CSV_EXPORT_CHUNK blocks
+#define CSV_EXPORT_CHUNK    512     // Bytes per console write
+
+// Columns after DUT (always first), in this order
+#define CSV_COL_FREQ        0x0001  // Frequency_Hz
+#define CSV_COL_MAG         0x0002  // Magnitude_Ohms
+#define CSV_COL_PHASE       0x0004  // Phase_Deg
+#define CSV_COL_GAIN        0x0008  // PGA Gain, TIA Gain
+#define CSV_COL_SWEEP       0x0010  // baseline / final
+#define CSV_COL_VALID       0x0020  // Valid (0/1)
+#define CSV_COL_SPREAD      0x0040  // Mag_SD_Pct, Phase_SD_Deg of the repeats
+#define CSV_COL_RISK        0x0080  // Risk, Risk_Pct of the DUT (final rows only)
+#define CSV_COL_ALL         0x00FF
+
+// Historic column set plus the sweep, so old parsers (DUT,freq,|Z|,phase) still work
+#define CSV_COLS_DEFAULT    (CSV_COL_FREQ | CSV_COL_MAG | CSV_COL_PHASE | CSV_COL_GAIN | CSV_COL_SWEEP)
+
+#define CSV_BANNER          "========== IMPEDANCE DATA CSV =========="
+
+// Print the baseline and (once measured) final rows of every channel
+// Invalid points are left out unless CSV_COL_VALID is selected
+void printCSVToSerial(uint16_t columns = CSV_COLS_DEFAULT);
+
+// Column mask of a list like "freq,mag,phase,risk" or "all"; 0 if a name is unknown
+uint16_t parseCSVColumns(const char* list);
 
 #endif // CSV_EXPORT_H
@@ -0,0 +1,46 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+/*=========================CSV READER=========================*/
+// Streaming tokenizer for the calibration CSVs on LittleFS: the file is read
+// in CSV_READER_BLOCK blocks, each line is copied into a fixed buffer and its
+// numbers are parsed in place - no String per line, no sscanf/strtod (which
+// allocate in newlib) and no heap at all
+//
+// csvNextLine() skips blank lines, '#' comments and header lines (starting
+// with a letter, e.g. "freq,gain,phase_offset"), and strips CR / trailing
+// spaces. The csv*() field readers then take the line's fields in order:
+// spaces around a field are ignored, a field ends at ',' or the line end,
+// and anything else after a number fails the field. Fields past the ones
+// read are ignored, like sscanf did
+#define CSV_READER_BLOCK    512     // Bytes per file read
+#define CSV_READER_LINE_MAX 160     // Longer data lines are skipped (counted)
+
+struct CsvReader {
+    fs::File* file;
+    char block[CSV_READER_BLOCK];
+    size_t blockLen;
+    size_t blockPos;
+    char line[CSV_READER_LINE_MAX];     // Current data line, NUL-terminated
+    const char* cursor;                 // Next field in line
+    uint16_t lineNumber;                // 1-based, of the current line
+    uint8_t fields;                     // Fields read from the current line
+    uint16_t longLines;                 // Data lines over CSV_READER_LINE_MAX
+};
+
+// Start reading an open file
+void csvBegin(CsvReader& reader, fs::File& file);
+
+// Next data line into reader.line; false at the end of the file
+bool csvNextLine(CsvReader& reader);
+
+// Next field of the current line as a number. False (and the field is not
+// consumed) if it is missing or not a number
+bool csvFloat(CsvReader& reader, float& out);
+bool csvInt(CsvReader& reader, int& out);
+bool csvUint(CsvReader& reader, uint32_t& out);
+
+#endif // CSV_READER_H
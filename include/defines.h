@@ -1,10 +1,11 @@
 #ifndef DEFINES_H
 #define DEFINES_H
 
-#include <Arduino.h>
+#include "hal.h"
+#include <atomic>
 
 // System configuration
-#define MAX_DUT_COUNT 4        // Number of DUTs (Device Under Test)
+#define MAX_DUT_COUNT 16       // Upper bound on DUTs (Device Under Test) - the active count is in meas_store.h
 #define MAX_FREQUENCIES 38     // Maximum number of frequency points per sweep
 
 // Measurement point from STM32
@@ -16,18 +17,50 @@ struct MeasurementPoint {
     uint8_t pga_gain;   // PGA gain setting (0-7)
     bool tia_gain;      // TIA gain setting (true=high, false=low)
     bool valid;         // Validity flag
+    uint8_t freq_idx;   // Index in the sweep table (sweep_table.h), 0xFF if unknown
 };
 
-// Calculated impedance point
+// Batch of measurement points passed from the UART reader to the data processor
+// Sized for one full DUT sweep; partial batches are flushed on DUT_END or idle
+#define MEASUREMENT_BATCH_SIZE  MAX_FREQUENCIES
+#define MEASUREMENT_BATCH_POOL  8   // Preallocated batches - interleaved DUTs share them (see acquireBatch)
+
+struct MeasurementBatch {
+    uint8_t dut;            // DUT number (1-based) the points belong to
+    uint8_t count;          // Number of valid entries in points[]
+    bool dutComplete;       // DUT_END received - last batch for this DUT
+    bool dutStart;          // First batch after DUT_START - partial repeats are dropped
+    uint32_t generation;    // Measurement session the points belong to (meas_session.h)
+    MeasurementPoint points[MEASUREMENT_BATCH_SIZE];
+};
+
+// Internal impedance representation between calcImpedance() and storage
+// 0 = polar only, 1 = also carry Z as re/im so calibration is a complex multiply
+// Stored points (BLE, CSV, screen) are always polar - see impedanceToPolar()
+#ifndef IMPEDANCE_RECTANGULAR
+#define IMPEDANCE_RECTANGULAR 0
+#endif
+
+// Calculated impedance point - working form between calcImpedance() and the
+// measurement store, which keeps it packed (ImpedanceRow below)
 struct ImpedancePoint {
     uint32_t freq_hz;       // Frequency in Hz
     float Z_magnitude;      // Impedance magnitude in Ohms
     float Z_phase;          // Impedance phase in degrees
+#if IMPEDANCE_RECTANGULAR
+    float Z_re;             // Working value while calibrating (Ohms)
+    float Z_im;             // Polar fields are filled by impedanceToPolar()
+#endif
     uint8_t pga_gain;       // PGA gain setting (0-7)
     bool tia_gain;          // TIA gain setting (true=high, false=low)
     bool valid;             // Validity flag
+    uint8_t freq_idx;       // Index in the sweep table (sweep_table.h), 0xFF if unknown
 
-    ImpedancePoint() : freq_hz(0), Z_magnitude(0.0), Z_phase(0.0),pga_gain(0),tia_gain(false), valid(false) {}
+#if IMPEDANCE_RECTANGULAR
+    ImpedancePoint() : freq_hz(0), Z_magnitude(0.0), Z_phase(0.0), Z_re(0.0), Z_im(0.0),pga_gain(0),tia_gain(false), valid(false), freq_idx(0xFF) {}
+#else
+    ImpedancePoint() : freq_hz(0), Z_magnitude(0.0), Z_phase(0.0),pga_gain(0),tia_gain(false), valid(false), freq_idx(0xFF) {}
+#endif
 };
 
 // Risk level for qualitative results
@@ -47,13 +80,34 @@ extern float highRiskCutoff;
 extern RiskLevel riskLevels[MAX_DUT_COUNT];
 extern float riskPercentages[MAX_DUT_COUNT];
 
-extern bool measurementInProgress;
-extern bool baselineMeasurementDone;
-extern bool finalMeasurementDone;
+// Sweep flags - written by the measurement controller only (meas_control.h, GUI task), read anywhere
+extern std::atomic<bool> measurementInProgress;
+extern std::atomic<bool> baselineMeasurementDone;
+extern std::atomic<bool> finalMeasurementDone;
+
+// Stored impedance row of one DUT and sweep, structure of arrays - point i is
+// mag[i], phase[i], freqCode[i], flags[i], magSd[i], phaseSd[i]. Loops over
+// |Z| or phase stream through contiguous floats; frequency, gains and the
+// repeat spread (PointNoise, repeat_filter.h) are one byte each
+// Write with storeImpedancePoint(), decode with storedFrequency() (meas_store.h)
+#define IMPEDANCE_FLAG_VALID     0x80
+#define IMPEDANCE_FLAG_TIA_HIGH  0x08
+#define IMPEDANCE_FLAG_PGA_MASK  0x07   // PGA gain 0-7
+
+struct ImpedanceRow {
+    float* mag;             // Impedance magnitude in Ohms
+    float* phase;           // Impedance phase in degrees
+    uint8_t* freqCode;      // Index on the shared frequency axis
+    uint8_t* flags;         // IMPEDANCE_FLAG_* | PGA gain
+    uint8_t* magSd;         // Relative |Z| spread of the repeats (POINT_NOISE_MAG_STEP)
+    uint8_t* phaseSd;       // Phase spread of the repeats (POINT_NOISE_PHASE_STEP)
+};
+
 // Global impedance data storage [DUT][frequency]
-extern ImpedancePoint baselineImpedanceData[MAX_DUT_COUNT][MAX_FREQUENCIES];
-extern ImpedancePoint measurementImpedanceData[MAX_DUT_COUNT][MAX_FREQUENCIES];
+// Rows of getPointsPerDUT() points, null arrays past getDUTCount() (meas_store.h)
+extern ImpedanceRow baselineImpedanceData[MAX_DUT_COUNT];
+extern ImpedanceRow measurementImpedanceData[MAX_DUT_COUNT];
 
-extern int frequencyCount[MAX_DUT_COUNT];  // Number of valid frequencies per DUT
+// Points stored per DUT: getStoredPointCount() (meas_session.h)
 
 #endif // DEFINES_H
\ No newline at end of file
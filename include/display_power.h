@@ -0,0 +1,72 @@
+#ifndef DISPLAY_POWER_H
+#define DISPLAY_POWER_H
+
+#include <Arduino.h>
+#include "power_manager.h"
+
+/*=========================DISPLAY POWER=========================*/
+// Backlight and panel power follow user activity (GUI task):
+//   Active  full backlight
+//   Dim     after DISPLAY_DIM_AFTER_MS without a button, GUI event, BLE
+//           command or sweep: backlight at DISPLAY_BL_DIM; on the static
+//           status screens (home, baseline complete, results) the ILI9341
+//           also runs in idle mode - 8 colors, lower panel drive
+//   Off     after DISPLAY_OFF_AFTER_MS: backlight off, display off, sleep in
+// The render goes on in every state - the controller takes GRAM writes
+// while asleep - so the panel shows the current screen the moment it wakes.
+// Waking (sleep out, display on, backlight) takes DISPLAY_SLEEP_OUT_MS,
+// well under one frame, and runs at the start of the GUI pass that handles
+// the event
+//
+// The backlight is dimmed by LEDC PWM, which stops in light sleep - POWER_SAVE
+// builds switch it on / off only and dim through idle mode alone
+#ifndef DISPLAY_POWER
+#define DISPLAY_POWER 1
+#endif
+
+#ifndef DISPLAY_BL_PWM
+#define DISPLAY_BL_PWM          (!POWER_SAVE)
+#endif
+
+#define DISPLAY_DIM_AFTER_MS    60000
+#define DISPLAY_OFF_AFTER_MS    300000
+#define DISPLAY_BL_PWM_HZ       5000
+#define DISPLAY_BL_PWM_BITS     8
+#define DISPLAY_BL_FULL         255
+#define DISPLAY_BL_DIM          40          // ~15 %
+#define DISPLAY_SLEEP_OUT_MS    5           // ILI9341: SLPOUT to the next command
+#define DISPLAY_SLEEP_IN_MS     120         // ILI9341: SLPIN to SLPOUT at least
+
+// Estimated display current per state (mA, hardware.md) for the power report
+#define DISPLAY_BL_FULL_MA      45.0f
+#define DISPLAY_BL_DIM_MA       8.0f
+
+enum DisplayPowerState : uint8_t {
+    DISPLAY_ACTIVE = 0,
+    DISPLAY_DIM,
+    DISPLAY_OFF,
+    DISPLAY_STATE_COUNT
+};
+
+// Take over the backlight pin - after tft.init()
+void initDisplayPower();
+
+// GUI task, every pass: dim / switch off once idle long enough
+void processDisplayPower();
+
+// Button, GUI event or BLE command - back to full brightness at once
+void noteDisplayActivity();
+
+// Panel off for good, activity ignored - before deep sleep and on a
+// scheduled wake from it (sleep_monitor.h), which ends in sleep or a restart
+void holdDisplayOff();
+
+// Milliseconds until processDisplayPower() has a step due, UINT32_MAX if none
+uint32_t getDisplayPowerWaitMs();
+
+DisplayPowerState getDisplayPowerState();
+
+// Time per display state (serial "power")
+void printDisplayPowerReport();
+
+#endif // DISPLAY_POWER_H
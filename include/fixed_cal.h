@@ -0,0 +1,48 @@
+#ifndef FIXED_CAL_H
+#define FIXED_CAL_H
+
+#include "hal.h"
+#include "defines.h"
+#include "calibration.h"
+
+/*=========================FIXED-POINT CALIBRATION KERNEL=========================*/
+// Integer-only impedance + calibration for the separate-files LUT
+// Magnitudes are carried as log2 in Q16.16, so gains become additions, and
+// phases as 32-bit binary angles (2^32 = 360 deg), which wrap by overflow.
+// Floats are only unpacked/packed at the edges (STM32 input, ImpedancePoint out)
+// Selected with -D CAL_FIXED_POINT=1; always built so the self-test can compare
+// Host-buildable apart from calcCalibratedImpedanceFixed() ([env:native])
+
+typedef int32_t fx_log2_t;      // log2(x) in Q16.16
+typedef int32_t fx_angle_t;     // Binary angle, 2^32 = 360 deg
+
+#define FX_LOG2_ONE     (1 << 16)
+
+// log2 of a positive float from its exponent/mantissa bits (table + interpolation)
+fx_log2_t fxLog2(float x);
+
+// 2^q as float, assembled from integer exponent/mantissa bits
+float fxExp2(fx_log2_t q);
+
+fx_angle_t fxDegToAngle(float deg);
+float fxAngleToDeg(fx_angle_t angle);   // Result in [-180, 180)
+
+// Convert the active float LUT (and interpolation slopes) to fixed point
+// Called whenever calibrationLUT changes
+void buildFixedCalibrationLUT(const CalLUTEntry (*lut)[2][8]);
+
+// The integer pass alone: no mode check, trace or stage timing
+// Needs buildFixedCalibrationLUT() first - false if the point stays uncalibrated
+bool calcFixedCalibratedPoint(const MeasurementPoint& measPoint, ImpedancePoint& out);
+
+#ifdef ARDUINO
+// calcImpedance() + calibrate() in one integer pass
+// Modes other than CALIBRATION_MODE_SEPARATE_FILES use the float path
+bool calcCalibratedImpedanceFixed(const MeasurementPoint& measPoint, ImpedancePoint& out);
+#endif
+
+// Compare the fixed kernel with the float path over every valid LUT entry
+// and print the worst magnitude/phase error and the time per point
+void runFixedCalibrationSelfTest();
+
+#endif // FIXED_CAL_H
@@ -0,0 +1,24 @@
+#ifndef FIXED_FORMAT_H
+#define FIXED_FORMAT_H
+
+#include "hal.h"
+
+/*=========================FIXED-DECIMAL FORMATTING=========================*/
+// "%.Nf" for the values the firmware prints per point - JSON, CSV and the
+// results screen - with integer digit loops instead of newlib's soft-float
+// printf. No locale, no heap, no varargs. The value is scaled by 10^decimals
+// exactly in double precision and rounded like printf (ties to even); a
+// result that rounds to zero has no sign ("-0.00" is written as "0.00")
+#define FIXED_FORMAT_MAX_DECIMALS   6
+#define FIXED_FORMAT_BUFFER         24      // Longest result plus NUL: sign, 20 digits, point
+
+// Write value with decimals (0-FIXED_FORMAT_MAX_DECIMALS) places and a NUL
+// into out. Returns the length, or 0 if value is not finite, too large for
+// the scaled 64-bit integer, or out is too small - callers fall back to printf
+size_t formatFixed(char* out, size_t size, float value, uint8_t decimals);
+
+// formatFixed() for text where any rendering will do: values it refuses come
+// out as printf's "%g" ("nan", "inf", "1e+30"). Returns out
+const char* fixedText(char (&out)[FIXED_FORMAT_BUFFER], float value, uint8_t decimals);
+
+#endif // FIXED_FORMAT_H
@@ -0,0 +1,83 @@
+#ifndef FLEET_AGGREGATOR_H
+#define FLEET_AGGREGATOR_H
+
+#include <Arduino.h>
+
+/*=========================FLEET AGGREGATOR=========================*/
+// Optional BLE central role (-D FLEET_AGGREGATOR=1, [env:fleet]): one board
+// of a bench connects to up to FLEET_MAX_PEERS other BioPals and relays what
+// they send to its own WebUI clients and live WebSockets, so one tab follows
+// the whole bench. The board keeps measuring its own DUTs as before
+//
+// Switched on with FLEET:1 / serial "fleet on" (remembered across reboots).
+// The fleet task then scans for FLEET_SCAN_S seconds every FLEET_SCAN_PERIOD_MS
+// while a peer slot is free, connects to boards advertising BLE_SERVICE_UUID,
+// subscribes to their TX characteristic and writes:
+//   FORMAT:BIN      DATA as compact binary notifications
+//   FLEET_LINK      the peer leaves its connection parameters to the central
+// Every peer gets the same connection interval, FLEET_SLOT_INT per connected
+// peer, so one round of connection events holds one FLEET_SLOT_INT slot per
+// peer and the controller places their anchors apart - the transfers of two
+// peers never compete for the same event. Rescheduled whenever a peer comes
+// or goes
+//
+// Peer notifications are copied into a message buffer in the BT callback and
+// forwarded by the fleet task as binary FleetFrameHeader frames (first byte
+// BLE_BIN_MAGIC, type BLE_BIN_TYPE_FLEET): the header, then the peer's
+// notification as it was - a text piece or a binary DATA / point packet.
+// A notification longer than the uplink payload is split into parts; the
+// client appends the parts of a peer until one without FLEET_PART_MORE.
+// FLEET_SEND:<peer>,<command> writes a command to one peer (0 = every peer)
+//
+// BLE_MAX_CLIENTS + FLEET_MAX_PEERS connections need a controller built for
+// them ([env:fleet] raises the connection limits)
+#ifndef FLEET_AGGREGATOR
+#define FLEET_AGGREGATOR 0
+#endif
+
+#define FLEET_CONFIG_FILE       "/fleet.txt"    // "1" / "0"
+#define FLEET_MAX_PEERS         6
+#define FLEET_SCAN_S            3           // Scan length
+#define FLEET_SCAN_PERIOD_MS    15000       // Scan again while a peer slot is free
+#define FLEET_CONNECT_TIMEOUT_MS 4000       // Below the task watchdog together with a scan
+#define FLEET_SLOT_INT          6           // 7.5 ms of every round per peer (1.25 ms units)
+#define FLEET_CONN_TIMEOUT      400         // Supervision timeout, 4 s (10 ms units)
+#define FLEET_RX_BUFFER_BYTES   8192        // Peer notifications waiting for the fleet task
+#define FLEET_SEND_QUEUE_DEPTH  4           // FLEET_SEND commands waiting for the fleet task
+#define FLEET_POLL_MS           100         // Fleet task wait for a peer notification
+
+#define FLEET_PART_MORE         0x80        // FleetFrameHeader.part: another part follows
+
+struct __attribute__((packed)) FleetFrameHeader {
+    uint8_t magic;          // BLE_BIN_MAGIC
+    uint8_t type;           // BLE_BIN_TYPE_FLEET
+    uint8_t peer;           // Peer number (1-based, stable while connected)
+    uint8_t part;           // Part index (0-based) | FLEET_PART_MORE
+};
+
+#if FLEET_AGGREGATOR
+// Load the stored switch - setup(), after storage
+void initFleetAggregator();
+
+// Scan for / drop peers, remembered across reboots
+bool setFleetEnabled(bool enable);
+bool isFleetEnabled();
+
+// Connected peers
+uint8_t getFleetPeerCount();
+
+// Queue a command for peer (1-based, 0 = every peer). False if the peer is
+// not connected or the queue is full
+bool sendFleetCommand(uint8_t peer, const char* command);
+
+// Peers, their link schedule and the relay counters (serial "fleet")
+void printFleetStatus();
+
+// Fleet task - scans, connects and relays
+void taskFleet(void* parameter);
+#else
+inline bool isFleetEnabled() { return false; }
+inline uint8_t getFleetPeerCount() { return 0; }
+#endif
+
+#endif // FLEET_AGGREGATOR_H
@@ -0,0 +1,25 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <Arduino.h>
+
+/*=========================GLYPH CACHE=========================*/
+// Fonts 2 (bitmap) and 4 (run-length encoded) are decoded from flash on every
+// drawChar, once per band the glyph spans. The cache rasterizes each glyph
+// once into a 1-bit mask on first use, so drawing it is a few row spans.
+// Glyphs that no longer fit into the arena keep the library path
+#define GLYPH_CACHE_BYTES   8192
+#define GLYPH_FIRST_CHAR    32
+#define GLYPH_CHAR_COUNT    96
+
+struct GlyphMask {
+    const uint8_t* bits;    // height rows of (width + 7) / 8 bytes, MSB = left
+    uint8_t width;          // Advance in pixels, blank columns included
+    uint8_t height;
+};
+
+// Mask of uniCode in font 2 or 4, rasterized on first use
+// False for other fonts and characters, or when the arena is full
+bool getGlyphMask(uint8_t font, uint16_t uniCode, GlyphMask& mask);
+
+#endif // GLYPH_CACHE_H
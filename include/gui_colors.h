@@ -29,28 +29,60 @@
 #define COLOR_BLACK             TFT_BLACK
 #define COLOR_GRID              TFT_DARKGREY
 
+// Palette of 4-bit GUI sprites (GUI_SPRITE_4BIT): the scheme above plus
+// a few blends the screens use. Entry 0 is black, so TFT_BLACK is its own index
+#define GUI_PALETTE_SIZE        16
+extern const uint16_t guiPalette[GUI_PALETTE_SIZE];
+
 // Helper macro for creating gradient effect
-// Linearly interpolate between two 16-bit colors
-inline uint16_t lerpColor(uint16_t color1, uint16_t color2, float t) {
-    if (t <= 0.0f) return color1;
-    if (t >= 1.0f) return color2;
+// Linearly interpolate between two 16-bit colors, t in 1/256 steps
+// Integer only - the C6 has no FPU - and constexpr, so constant blends
+// (lerpColor256(a, b, LERP_T(0.7))) are folded by the compiler
+#define LERP_T(t)   ((int32_t)((t) * 256.0f))
+
+constexpr uint16_t lerpColor256(uint16_t color1, uint16_t color2, int32_t t256) {
+    if (t256 <= 0) return color1;
+    if (t256 >= 256) return color2;
 
     // Extract RGB components from RGB565
-    uint8_t r1 = (color1 >> 11) & 0x1F;
-    uint8_t g1 = (color1 >> 5) & 0x3F;
-    uint8_t b1 = color1 & 0x1F;
+    int32_t r1 = (color1 >> 11) & 0x1F;
+    int32_t g1 = (color1 >> 5) & 0x3F;
+    int32_t b1 = color1 & 0x1F;
 
-    uint8_t r2 = (color2 >> 11) & 0x1F;
-    uint8_t g2 = (color2 >> 5) & 0x3F;
-    uint8_t b2 = color2 & 0x1F;
+    int32_t r2 = (color2 >> 11) & 0x1F;
+    int32_t g2 = (color2 >> 5) & 0x3F;
+    int32_t b2 = color2 & 0x1F;
 
-    // Interpolate
-    uint8_t r = r1 + (uint8_t)((r2 - r1) * t);
-    uint8_t g = g1 + (uint8_t)((g2 - g1) * t);
-    uint8_t b = b1 + (uint8_t)((b2 - b1) * t);
+    // Interpolate (truncates toward color1 like the float version did)
+    int32_t r = r1 + (r2 - r1) * t256 / 256;
+    int32_t g = g1 + (g2 - g1) * t256 / 256;
+    int32_t b = b1 + (b2 - b1) * t256 / 256;
 
     // Recombine to RGB565
     return (r << 11) | (g << 5) | b;
 }
 
+// Compile-time ramp of N colors from color1 (index 0) towards color2:
+// color[i] = lerpColor256(color1, color2, i * 256 / N)
+// swapped stores them in TFT_eSprite buffer byte order, for memcpy into a sprite
+template <int N>
+struct ColorRamp {
+    uint16_t color[N];
+
+    constexpr ColorRamp(uint16_t color1, uint16_t color2, bool swapped) : color() {
+        for (int i = 0; i < N; i++) {
+            uint16_t c = lerpColor256(color1, color2, (int32_t)i * 256 / N);
+            color[i] = swapped ? (uint16_t)(c >> 8 | c << 8) : c;
+        }
+    }
+};
+
+// COLOR_PRIMARY_START -> COLOR_PRIMARY_END indexed by t in 1/256 steps
+extern const ColorRamp<256> primaryRamp;
+
+// Same with t from 0.0 to 1.0
+inline uint16_t lerpColor(uint16_t color1, uint16_t color2, float t) {
+    return lerpColor256(color1, color2, (int32_t)(t * 256.0f));
+}
+
 #endif // GUI_COLORS_H
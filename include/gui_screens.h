@@ -10,30 +10,187 @@
 
 #define SCREEN_WIDTH  320
 #define SCREEN_HEIGHT 240
+#define HEADER_HEIGHT 50      // Gradient title bar of every screen
 
 /*=========================TFT INSTANCE=========================*/
 
 // Get reference to TFT instance (initialized in bode_plot.cpp or gui_screens.cpp)
 extern TFT_eSPI tft;
 
+/*=========================BANDED SPRITE=========================*/
+// Screens are drawn in bands of BAND_HEIGHT rows into two strip buffers
+// (2 x 25,600 bytes instead of a 153,600-byte frame): while one band is
+// clocked out by DMA the next one is drawn into the other buffer. Drawing
+// code keeps using screen coordinates - the sprite maps them into the
+// current band and clips everything else
+#define BAND_HEIGHT   40
+#define BAND_COUNT    (SCREEN_HEIGHT / BAND_HEIGHT)
+
+// Build with -D GUI_SPRITE_4BIT=1 to draw into one 4-bit strip indexed
+// into guiPalette (6,400 bytes) instead. RGB565 colors are mapped to the
+// nearest palette entry, so blends and gradients band into its few shades;
+// the push expands the strip through the palette in PALETTE_SLICE_ROWS
+// slices, one slice going out by DMA while the next is expanded
+#ifndef GUI_SPRITE_4BIT
+#define GUI_SPRITE_4BIT 0
+#endif
+#define PALETTE_SLICE_ROWS  8
+
+/*=========================RENDER MEMORY=========================*/
+// The strips are sized to the heap. initSpriteBuffer() takes the largest
+// tier that leaves RENDER_HEAP_RESERVE bytes of internal RAM free; the
+// render steps down a tier when free RAM falls below RENDER_HEAP_LOW and
+// back up once a larger tier fits the reserve again (checked every
+// RENDER_TIER_CHECK_MS, between frames):
+//   DOUBLE  two 16-bit strips (51,200 bytes) - a band is drawn while the
+//           one before is clocked out by DMA
+//   SINGLE  one 16-bit strip (25,600 bytes) - each band waits for the DMA
+//           of the one before
+//   8BIT    one RGB332 strip (12,800 bytes) pushed by the CPU - colors
+//           are quantized to 256
+//   NONE    no strip - frames wait, the panel keeps the last one
+// GUI_SPRITE_4BIT builds have the 4-bit strip and NONE only. A bulk
+// transfer (BLE history download, Wi-Fi history or session document) holds
+// the render at its smallest strip until it ends, leaving the rest of the
+// RAM to the transfer's buffers
+#ifndef RENDER_HEAP_RESERVE
+#define RENDER_HEAP_RESERVE     32768   // Free internal RAM a larger tier must leave
+#endif
+#define RENDER_HEAP_LOW         16384   // Free internal RAM below which the render steps down
+#define RENDER_TIER_CHECK_MS    500
+
+enum RenderTier : uint8_t {
+    RENDER_TIER_NONE,
+#if GUI_SPRITE_4BIT
+    RENDER_TIER_4BIT,
+#else
+    RENDER_TIER_8BIT,
+    RENDER_TIER_SINGLE,
+    RENDER_TIER_DOUBLE,
+#endif
+    RENDER_TIER_COUNT
+};
+#define RENDER_TIER_MIN  ((RenderTier)(RENDER_TIER_NONE + 1))     // Smallest tier that draws
+#define RENDER_TIER_MAX  ((RenderTier)(RENDER_TIER_COUNT - 1))
+
+class BandSprite : public TFT_eSprite {
+public:
+    explicit BandSprite(TFT_eSPI* tft) : TFT_eSprite(tft) {}
+
+    // Allocate the strip buffers of tier, width x BAND_HEIGHT each
+    bool createBands(int16_t width, RenderTier tier);
+
+    // Free them (no push may still read them)
+    void deleteBands();
+
+    // Draw screen rows top..top + BAND_HEIGHT - 1 into strip buffer 0 or 1
+    void selectBand(uint8_t buffer, int16_t top);
+
+    // Limit drawing in the current band to screen rect [left, right) x
+    // [top, bottom) (after selectBand)
+    void clipBand(int16_t left, int16_t top, int16_t right, int16_t bottom);
+
+    // Clip all drawing (layout pass without pixels)
+    void selectNone();
+
+    // Pixels of strip buffer 0 or 1, sprite byte order
+    const uint16_t* bandPixels(uint8_t buffer) const;
+
+    // Screen row y in the current band, nullptr if it is outside or the
+    // strips are not 16-bit
+    uint16_t* rowPixels(int16_t y);
+
+    // Expand rows row..row + rows - 1 of the current band to RGB565 in
+    // panel byte order (4- and 8-bit strips)
+    void expandRows(int16_t row, int16_t rows, uint16_t* out) const;
+
+    // Fonts 2 and 4 at text size 1 come from the glyph cache (glyph_cache.h)
+    // as row spans; everything else goes through the library renderer
+    int16_t drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) override;
+    using TFT_eSprite::drawChar;
+
+#if GUI_SPRITE_4BIT
+    // RGB565 colors become palette indices; values below GUI_PALETTE_SIZE
+    // already are indices and pass through
+    void drawPixel(int32_t x, int32_t y, uint32_t color) override;
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) override;
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) override;
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) override;
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+    void fillSprite(uint32_t color);
+
+    // The font renderer writes the text colors into 4-bit sprites unconverted
+    void setTextColor(uint16_t color);
+    void setTextColor(uint16_t fgcolor, uint16_t bgcolor, bool bgfill = false);
+#endif
+
+private:
+    uint8_t* second = nullptr;      // Strip buffer 1 (buffer 0 is the sprite's own), DOUBLE only
+    int16_t bandTop = 0;
+
+#if GUI_SPRITE_4BIT
+    uint32_t pairColors[256];       // Strip byte -> its two pixels, panel byte order
+    uint32_t lastColor = 0;         // Last mapped color and its index
+    uint8_t lastIndex = 0;
+
+    uint8_t paletteIndex(uint32_t color);
+#endif
+};
+
 // Sprite for double buffering (eliminates flicker)
-extern TFT_eSprite sprite;
+extern BandSprite sprite;
 
 // Forward declarations of external functions (to avoid header conflicts)
 extern bool isBLEConnected();
 
 /*=========================SCREEN RENDERING FUNCTIONS=========================*/
 
-// Initialize the sprite buffer (call once in setup)
+// Initialize the sprite buffer at the largest tier that fits (call once
+// in setup) - false if not even the smallest did
 bool initSpriteBuffer();
 
-// Print memory usage statistics (for debugging)
-void printHeapStats();
+RenderTier getRenderTier();
+
+// Bulk transfers in other tasks (wifi_server.cpp): while held, the render
+// keeps its smallest strip. Nestable, one release per hold
+void holdRenderMemory();
+void releaseRenderMemory();
+
+// Tier, strip bytes, DMA and the tier changes since boot (serial "stats")
+void printRenderStats();
 
-// Render the current screen based on GUI state
-// Should be called whenever screen needs updating
+// Wait for a DMA frame push to finish and release the SPI bus
+// Call before drawing to tft directly or redrawing the sprite
+void finishFramePush();
+
+// The panel was drawn without the sprite (e.g. splash logo) - the next frame
+// is pushed whole
+void invalidateFrame();
+
+// Render the current screen based on GUI state, now. GUI code asks for a
+// frame with requestRender() instead
 void renderCurrentScreen();
 
+// Render scheduling (GUI task): state changes, progress updates and input
+// only mark the screen dirty; processRender() at the end of each GUI loop
+// pass draws one frame for all of them, at most one per GUI_FRAME_MIN_MS
+#ifndef GUI_FRAME_MIN_MS
+#define GUI_FRAME_MIN_MS  33      // ~30 frames/s
+#endif
+
+void requestRender();
+bool isRenderPending();
+
+// ms until the pending frame is due (0 = now), UINT32_MAX if none
+uint32_t getRenderWaitMs();
+
+// Render the pending frame once it is due
+void processRender();
+
+// Render a full frame outside the GUI screens (e.g. Bode plot): draw() is
+// called once per band and draws the whole screen into the sprite
+void renderFrame(void (*draw)());
+
 // Individual screen rendering functions
 void drawSplashScreen();
 void drawHomeScreen();
@@ -42,12 +199,17 @@ void drawFreqOverrideScreen();
 void drawProgressScreen(bool isBaseline);  // Used for both baseline and final
 void drawBaselineCompleteScreen();
 void drawResultsScreen();
+void drawMonitorScreen();
+void drawDiagnosticsScreen();
 
 /*=========================HELPER DRAWING FUNCTIONS=========================*/
 
 // Draw a gradient-filled rectangle
 void drawGradientRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color1, uint16_t color2, bool horizontal);
 
+// Draw the gradient header bar (0, 0, SCREEN_WIDTH, HEADER_HEIGHT) from a cached row
+void drawHeader();
+
 // Draw centered text
 void drawCenteredText(const char* text, int16_t y, uint8_t font, uint16_t color);
 
@@ -64,7 +226,8 @@ void drawProgressBar(int16_t x, int16_t y, int16_t w, int16_t h, float percent);
 void drawConnectionIndicator(int16_t x, int16_t y, bool connected);
 void drawConnectionIndicatorDefault(bool connected);
 
-// Draw DUT status grid (for progress screen)
+// Draw DUT status grid (for progress screen) - boxes are retained widgets,
+// redrawn one by one as their DUTs change
 void drawDUTStatusGrid(int16_t x, int16_t y);
 
 // Draw a simple icon (using basic shapes)
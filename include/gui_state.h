@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "defines.h"
 
 /*=========================GUI STATE DEFINITIONS=========================*/
 
@@ -16,11 +17,15 @@ enum GUIState {
     GUI_BASELINE_PROGRESS,   // Baseline measurement in progress
     GUI_BASELINE_COMPLETE,   // Baseline measurement complete
     GUI_FINAL_PROGRESS,      // Final measurement in progress
-    GUI_RESULTS              // Measurement complete / results
+    GUI_RESULTS,             // Measurement complete / results
+    GUI_MONITOR,             // Repeated final sweeps (monitor.h)
+    GUI_LIVE_PLOT,           // Bode plot of the running sweep (bode_plot.h)
+    GUI_OVERLAY,             // Baseline vs. final plot per DUT (bode_plot.h)
+    GUI_DIAGNOSTICS          // Hidden performance dashboard (perf_dashboard.h)
 };
 
 // Button/encoder events
-enum ButtonEvent {
+enum ButtonEvent : uint8_t {
     BTN_EVENT_NONE = 0,
     BTN_EVENT_UP,
     BTN_EVENT_DOWN,
@@ -31,12 +36,71 @@ enum ButtonEvent {
     BTN_EVENT_ROTATE_CCW    // Rotary encoder counter-clockwise
 };
 
-// Settings structure
+// Flags on a button's event (button_handler.h): held down (repeats for UP
+// and DOWN), held past the long-press time, released
+#define BTN_EVENT_BUTTON_MASK   0x0F
+#define BTN_EVENT_REPEAT        0x10
+#define BTN_EVENT_LONG          0x20
+#define BTN_EVENT_RELEASE       0x40
+
+// One entry of the button queue: the event, when the input happened - the
+// first edge of a press or release, a detent, a hold timer - and when it was
+// queued (micros(), input_latency.h)
+struct ButtonInput {
+    ButtonEvent event;
+    uint32_t edgeUs;
+    uint32_t queuedUs;
+};
+
+// Events other contexts (BLE stack callbacks) hand to the GUI task, which
+// does all drawing - posting never blocks, so callbacks return at once
+enum GUIEventType : uint8_t {
+    GUI_EVENT_BLE_CONNECTED,
+    GUI_EVENT_BLE_DISCONNECTED
+};
+
+struct GUIEvent {
+    GUIEventType type;
+    uint8_t value;          // BLE events: clients still connected
+};
+
+#define GUI_EVENT_QUEUE_DEPTH   8
+#define BUTTON_EVENT_QUEUE_DEPTH 10
+
+// The GUI task sleeps until woken or until the next deadline of a timed
+// module (splash, monitor interval, active downloads). Whoever queues work
+// for it sets its reason in the task's notification bits
+#define GUI_WAKE_BUTTON         (1UL << 0)  // Button / encoder ISR
+#define GUI_WAKE_EVENT          (1UL << 1)  // postGUIEvent
+#define GUI_WAKE_DUT            (1UL << 2)  // DUT / measurement complete
+#define GUI_WAKE_SERIAL         (1UL << 3)  // USB serial RX
+#define GUI_WAKE_BLE            (1UL << 4)  // BLE command, calibration frame, history request
+#define GUI_WAKE_UART           (1UL << 5)  // STM32 command result, device ID
+#define GUI_WAKE_POINT          (1UL << 6)  // Point stored while the live plot or a progress screen is shown
+#define GUI_WAKE_RENDER         (1UL << 7)  // Bulk transfer holds the render memory (holdRenderMemory)
+#define GUI_POLL_MS             10          // Wake-up period while a download streams
+
+// Settings structure - new fields go at the end (see GUISettingsRecord)
 struct GUISettings {
     bool useCustomFreqRange;  // false = full range, true = custom
     uint8_t startFreqIndex;   // Index into frequency table
     uint8_t endFreqIndex;     // Index into frequency table
-    uint8_t defaultDUTCount;  // Default number of DUTs (1-4)
+    uint8_t defaultDUTCount;  // Default number of DUTs (1-getDUTCount())
+};
+
+// Settings file: GUISettingsRecord, then size bytes of GUISettings, then a
+// CRC-16/CCITT of both. Fields are only ever appended, so a record of an
+// older or newer firmware loads the fields both know and the rest keep
+// their defaults. Changes are written GUI_SETTINGS_SAVE_DELAY_MS after the
+// last one, and only if they differ from what is in flash
+#define GUI_SETTINGS_MAGIC          0x54455347  // "GSET"
+#define GUI_SETTINGS_VERSION        1
+#define GUI_SETTINGS_SAVE_DELAY_MS  2000
+
+struct __attribute__((packed)) GUISettingsRecord {
+    uint32_t magic;           // GUI_SETTINGS_MAGIC
+    uint16_t version;         // GUI_SETTINGS_VERSION of the writer
+    uint16_t size;            // sizeof(GUISettings) of the writer
 };
 
 /*=========================GUI STATE VARIABLES=========================*/
@@ -48,24 +112,36 @@ extern GUIState currentGUIState;
 extern GUISettings guiSettings;
 
 // User selections (current session)
-extern uint8_t selectedDUTCount;    // Current DUT count selection (1-4)
+extern uint8_t selectedDUTCount;    // Current DUT count selection (1-getDUTCount())
 extern uint8_t selectedStartFreq;   // Temporary freq selection
 extern uint8_t selectedEndFreq;     // Temporary freq selection
 
+// Custom range picker of GUI_FREQ_OVERRIDE - active while menuEditMode is set,
+// menuSelection is then the highlighted sweep index
+enum FreqPickStage : uint8_t {
+    FREQ_PICK_START,
+    FREQ_PICK_END
+};
+extern FreqPickStage freqPickStage;
+
 // UI state
 extern uint8_t menuSelection;       // Currently highlighted menu item
 extern bool menuEditMode;           // true when editing a value
 
 // Progress tracking for UI
-extern uint8_t currentDUT;          // Current DUT being measured (0-3)
+extern uint8_t currentDUT;          // Current DUT being measured (0-based)
 extern uint8_t totalDUTs;           // Total DUTs in this measurement
 extern float progressPercent;       // Overall progress (0.0 - 100.0)
-extern bool dutStatus[4];           // Status of each DUT (false=pending, true=complete)
+extern bool dutStatus[MAX_DUT_COUNT]; // Status of each DUT (false=pending, true=complete)
+extern bool resultReady[MAX_DUT_COUNT]; // Risk of each DUT computed in this sweep
+extern uint8_t overlayDUT;          // DUT shown on the overlay plot (0-based)
 
 /*=========================GUI STATE FUNCTIONS=========================*/
 
-// Initialize GUI state machine
-void initGUIState();
+// Initialize GUI state machine: event queues, TFT and splash screen
+// (settings are loaded separately with loadGUISettings). Without splash the
+// state starts at home and nothing is drawn (deep-sleep wake)
+void initGUIState(bool splash = true);
 
 // Set new GUI state and trigger screen redraw
 void setGUIState(GUIState newState);
@@ -79,16 +155,50 @@ void handleGUIInput(ButtonEvent event);
 // Update progress display (called when DUT completes)
 void updateProgressScreen(uint8_t dutIndex);
 
+// The risk of dutIndex is ready (final sweep) - its box on the results
+// screen fills in. The first one replaces the final progress screen with
+// the results, the others as they finish
+void showDUTResult(uint8_t dutIndex);
+
+// GUI task loop: advance progressPercent by the points stored since the
+// last pass while a progress screen is shown
+void processProgress();
+
 // Reset measurement tracking
 void resetMeasurementTracking();
 
-// Load settings from flash
+// Load settings from flash (also the unversioned file of older firmware)
 bool loadGUISettings();
 
-// Save settings to flash
-bool saveGUISettings();
+// Schedule a settings save if they differ from flash - repeated calls are
+// coalesced into one write by processGUISettingsSave()
+void saveGUISettings();
+
+// Queue the scheduled settings write once its delay has passed (GUI task)
+void processGUISettingsSave();
+
+// Milliseconds until processGUISettingsSave() writes, UINT32_MAX if nothing is scheduled
+uint32_t getGUISettingsWaitMs();
 
 // Get reference to button event queue
 QueueHandle_t getButtonEventQueue();
 
+// Queue an event for the GUI task (any task or callback, never blocks)
+// Returns false if the queue is full or not created yet
+bool postGUIEvent(GUIEventType type, uint8_t value);
+
+// Get reference to GUI event queue
+QueueHandle_t getGUIEventQueue();
+
+// Handle a posted event (GUI task)
+void handleGUIEvent(const GUIEvent& event);
+
+// The calling task is the GUI task - wake-ups before this are dropped,
+// its first pass handles whatever was queued by then
+void registerGUITask();
+
+// Wake the GUI task (any task / callback, or an ISR with the FromISR form)
+void wakeGUITask(uint32_t reason);
+void wakeGUITaskFromISR(uint32_t reason, BaseType_t* higherPriorityTaskWoken);
+
 #endif // GUI_STATE_H
@@ -0,0 +1,59 @@
+#ifndef HAL_H
+#define HAL_H
+
+/*=========================PLATFORM SHIM=========================*/
+// The processing pipeline (frame parser, impedance, calibration apply, risk)
+// includes this instead of <Arduino.h>, so it also builds for the host
+// ([env:native] in platformio.ini) for unit tests and benchmarks
+#ifdef ARDUINO
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include "esp_timer.h"
+#include "console.h"
+
+// Console.printf() mallocs any line over 64 bytes - this one formats on the
+// stack, so logging on the sweep path stays off the heap. Longer lines are cut
+#define HAL_PRINTF_MAX          160
+
+static inline void halPrintf(const char* fmt, ...) {
+    char line[HAL_PRINTF_MAX];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (len > 0) {
+        Console.write((const uint8_t*)line, min(len, (int)sizeof(line) - 1));
+    }
+}
+
+#define HAL_PRINTF(fmt, ...)    halPrintf(fmt, ##__VA_ARGS__)
+
+static inline int64_t halMicros() {
+    return esp_timer_get_time();
+}
+
+#else
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+
+using std::min;
+using std::max;
+
+#define HAL_PRINTF(fmt, ...)    printf(fmt, ##__VA_ARGS__)
+
+static inline int64_t halMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif
+
+#endif // HAL_H
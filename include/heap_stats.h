@@ -0,0 +1,70 @@
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#include <Arduino.h>
+
+/*=========================HEAP STATISTICS=========================*/
+// Free / minimum-ever free heap, the largest free block (fragmentation) and
+// failed allocations, always. With -D HEAP_STATS=1 ([env:heap], which turns
+// on CONFIG_HEAP_USE_HOOKS) every malloc/free is also counted per task -
+// each module runs in its own task, loaders in the boot tasks - so a sweep
+// after "stats reset" shows who still allocates in steady state
+// Reported with the "stats" serial command and the BLE STATS reply
+//
+// The sweep path (commands, UART frames, processing, DATA/STATS encoding,
+// logging) works in preallocated buffers. Each sweep - START sent to sweep
+// complete - is checked: the table tasks (task_monitor.h) must not allocate.
+// Allocations inside the BT stack and LittleFS are counted as "ext", apart
+// from the application's. The first sweep after boot may still warm up
+// newlib's per-task float formatting buffers
+#ifndef HEAP_STATS
+#define HEAP_STATS 0
+#endif
+
+#define HEAP_STATS_OWNERS       16      // Tasks counted separately, later ones share "other"
+
+struct HeapSummary {
+    uint32_t freeBytes;
+    uint32_t totalBytes;
+    uint32_t minFreeBytes;      // Since boot (heap_caps_get_minimum_free_size)
+    uint32_t largestBlock;      // Largest allocatable block now
+    uint32_t minLargestBlock;   // Lowest largest block seen by heapStatsSample() since reset
+    uint32_t failures;          // Failed allocations since reset
+};
+
+// Register the failed-allocation callback - first thing in setup()
+void initHeapStats();
+
+// Track the lowest largest free block and report new allocation failures
+// Called after every sweep
+void heapStatsSample();
+
+// Clear the per-task counts, failures and the largest-block watermark
+void heapStatsReset();
+
+void getHeapSummary(HeapSummary& out);
+
+#if HEAP_STATS
+// Scope around a framework call (BT stack, LittleFS) - its allocations do
+// not count against the calling task's zero-allocation sweep. Nestable
+void heapStatsEnterFramework();
+void heapStatsExitFramework();
+
+// Open the check window at START and close it at sweep complete: prints
+// PASS, or FAIL with the table tasks that allocated
+void heapStatsSweepBegin();
+void heapStatsSweepEnd();
+#else
+inline void heapStatsEnterFramework() {}
+inline void heapStatsExitFramework() {}
+inline void heapStatsSweepBegin() {}
+inline void heapStatsSweepEnd() {}
+#endif
+
+// One line: total, used and free bytes, largest block (boot / GUI init)
+void printHeapStats();
+
+// Summary, last failure and the per-task allocation counts (serial "stats")
+void printHeapReport();
+
+#endif // HEAP_STATS_H
@@ -0,0 +1,154 @@
+#ifndef HISTORY_DOWNLOAD_H
+#define HISTORY_DOWNLOAD_H
+
+#include <Arduino.h>
+
+/*=========================BULK HISTORY DOWNLOAD=========================*/
+// The session log (session_log.h) is served as one byte image - the records
+// of SESSION_LOG_OLD_FILE followed by those of SESSION_LOG_FILE - over the
+// history GATT service (BLE_HISTORY_SERVICE_UUID). Blocks fill whole
+// notifications and are sent back to back through the BLE TX pipeline, so a
+// day of monitoring sweeps does not go through HISTORY JSON on the TX
+// characteristic
+//
+// Request (HIST_CTRL write, little-endian): HistoryRequest
+//   HISTORY_REQ_INFO   - retry pending session appends, answer INFO
+//   HISTORY_REQ_READ   - stream BLOCKs from offset to the end of the image
+//   HISTORY_REQ_ABORT  - stop streaming
+//   HISTORY_REQ_SYNC   - HistorySyncRequest: answer SYNC, then stream BLOCKs
+//                        of just what the client does not hold yet
+//
+// Frame (HIST_DATA notification): HistoryFrameHeader, length bytes, then a
+// uint16_t CRC-16/CCITT-FALSE over header and bytes
+//   INFO   - HistoryInfo
+//   BLOCK  - image bytes at offset, HISTORY_FLAG_LAST on the final one
+//   ERROR  - one HistoryError byte
+//
+// New sessions are only appended, so offsets stay valid: an interrupted or
+// corrupted download resumes with READ from the first bad offset, also after
+// a reconnect. Log rotation changes imageId and a READ with a stale id (or a
+// rotation during the stream) is answered ERROR HISTORY_ERR_IMAGE_CHANGED
+//
+// Sync: a reconnecting client names what it holds - the image generation
+// (imageId) with its byte count, and its newest sessions, newest first.
+// Records are never rewritten and a rotation only renames the files, so the
+// device continues after the first thing the image still holds: heldBytes
+// of the same generation, else the end of the newest named record found in
+// the index (a rotated image keeps it in the old file). The SYNC frame says
+// which one matched and where the stream starts; the client keeps its bytes
+// up to that record and appends the BLOCKs. New finals are coded against
+// baselines the client already holds (session_log.h), so a reconnect moves
+// the new records only. Nothing matched: the whole image
+#define HISTORY_REQ_INFO            0x01
+#define HISTORY_REQ_READ            0x02
+#define HISTORY_REQ_ABORT           0x03
+#define HISTORY_REQ_SYNC            0x04
+
+#define HISTORY_FRAME_INFO          0x01
+#define HISTORY_FRAME_BLOCK         0x02
+#define HISTORY_FRAME_ERROR         0x03
+#define HISTORY_FRAME_SYNC          0x04
+
+#define HISTORY_FLAG_LAST           0x01
+
+#define HISTORY_VERSION             3       // 3: coded variable-size records
+#define HISTORY_FRAME_MAX           512     // Fits the 517-byte MTU
+#define HISTORY_FRAME_OVERHEAD      (sizeof(HistoryFrameHeader) + sizeof(uint16_t))
+#define HISTORY_CACHE_BYTES         4096    // Image bytes read per refill
+#define HISTORY_TX_RESERVE          4096    // TX buffer bytes kept free for other messages
+#define HISTORY_REFILL_GAP_MS       10      // Frame gap a refill needs during a sweep (sweep_eta.h)
+#define HISTORY_REFILL_WAIT_MS      500     // Longest a refill waits for that gap
+#define HISTORY_SYNC_REFS           4       // Sessions a SYNC may name
+#define HISTORY_SYNC_BATCH          8       // Index entries read at a time by the search
+
+#define HISTORY_SYNC_GENERATION     0x00    // HistorySyncInfo.match: imageId and heldBytes still valid
+#define HISTORY_SYNC_NONE           0xFF    // Nothing held is in the image - sent whole
+
+enum HistoryError : uint8_t {
+    HISTORY_ERR_IMAGE_CHANGED = 1,  // Log rotated - start again with INFO
+    HISTORY_ERR_OFFSET,             // READ past the end of the image
+    HISTORY_ERR_READ,               // LittleFS read failed
+    HISTORY_ERR_REQUEST             // Unknown or malformed request
+};
+
+struct __attribute__((packed)) HistoryRequest {
+    uint8_t op;             // HISTORY_REQ_*
+    uint8_t reserved[3];
+    uint32_t imageId;       // READ: from INFO
+    uint32_t offset;        // READ: first image byte to send
+};
+
+// A session the client holds - its header fields, crc telling apart two
+// sessions of one second after a clock reset
+struct __attribute__((packed)) HistorySessionRef {
+    uint32_t timestamp;
+    uint8_t dut;
+    uint8_t kind;           // SessionKind
+    uint16_t crc;           // SessionHeader.crc
+};
+
+// Same start as HistoryRequest - count 0 is a check of the generation alone.
+// Sent with just the counted refs: one write holds (MTU - 3 - 12) / 8 of
+// them, so 1 at the default 23-byte MTU, all of them from
+// sizeof(HistorySyncRequest) + 3 = 47
+struct __attribute__((packed)) HistorySyncRequest {
+    uint8_t op;             // HISTORY_REQ_SYNC
+    uint8_t count;          // refs that follow, at most HISTORY_SYNC_REFS
+    uint8_t reserved[2];
+    uint32_t imageId;       // Generation the client last synced, 0 = none
+    uint32_t heldBytes;     // Its image bytes of that generation
+    HistorySessionRef refs[HISTORY_SYNC_REFS];  // Newest first
+};
+
+struct __attribute__((packed)) HistoryFrameHeader {
+    uint8_t type;           // HISTORY_FRAME_*
+    uint8_t flags;          // HISTORY_FLAG_*
+    uint16_t length;        // Bytes after the header, without the CRC
+    uint32_t offset;        // BLOCK: image offset of the bytes
+};
+
+struct __attribute__((packed)) HistoryInfo {
+    uint8_t version;        // HISTORY_VERSION
+    uint8_t reserved;
+    uint16_t blockBytes;    // Image bytes per BLOCK on this connection
+    uint32_t imageId;       // Timestamp of the first record, 0 = empty image
+    uint32_t totalBytes;    // Image size
+};
+
+struct __attribute__((packed)) HistorySyncInfo {
+    uint8_t version;        // HISTORY_VERSION
+    uint8_t match;          // HISTORY_SYNC_GENERATION, 1-based ref or HISTORY_SYNC_NONE
+    uint16_t blockBytes;
+    uint32_t imageId;
+    uint32_t totalBytes;
+    uint32_t startOffset;   // First image byte sent - the end of what matched
+};
+
+// BLE write callback: keep the request for processHistoryDownload()
+// A newer request replaces one not yet processed
+bool historyRequestReceive(const uint8_t* data, size_t len);
+
+// Handle requests and queue the next blocks - called from the GUI task loop
+// (the task that owns LittleFS), returns at once while the TX buffer is full
+void processHistoryDownload();
+
+// A READ is being streamed
+bool isHistoryDownloadActive();
+
+// Image access for the other transports (wifi_server.h) - any task but the
+// storage task; a session append queued before the call is part of the image
+// Id and size of the image now; false if storage is not mounted
+bool getHistoryImageInfo(uint32_t& id, uint32_t& totalBytes);
+
+// Copy up to len image bytes at offset into dest (copied: 0 at the end),
+// checking the image is still imageId. False with error set if not
+bool readHistoryImage(uint32_t imageId, uint32_t offset, uint8_t* dest, size_t len,
+                      size_t& copied, HistoryError& error);
+
+// Sync of request (count refs) against the image: its id and size, the
+// offset to send from and what matched (HistorySyncInfo). False if storage
+// is not mounted
+bool syncHistoryImage(const HistorySyncRequest& request, uint32_t& id, uint32_t& totalBytes,
+                      uint32_t& startOffset, uint8_t& match);
+
+#endif // HISTORY_DOWNLOAD_H
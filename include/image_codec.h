@@ -0,0 +1,43 @@
+#ifndef IMAGE_CODEC_H
+#define IMAGE_CODEC_H
+
+#include <Arduino.h>
+
+/*=========================COMPRESSED RGB565 IMAGES=========================*/
+// QOI-style byte stream written by logo_compile.py. Pixels are row-major and
+// every op produces pixels from the previous one ("prev", 0x0000 at the start):
+//   00iiiiii          INDEX  color in slot i of the recent-color table
+//   01rrggbb          DIFF   prev + (r - 2, g - 2, b - 2) per 565 channel
+//   10nnnnnn          RUN    prev repeated n + 1 times (may cross rows)
+//   11000000 hi lo    RAW    RGB565 color, big-endian
+// INDEX, DIFF and RAW colors are stored in slot imageColorHash(color)
+#define IMAGE_INDEX_SIZE    64
+
+#define IMAGE_OP_MASK       0xC0
+#define IMAGE_OP_INDEX      0x00
+#define IMAGE_OP_DIFF       0x40
+#define IMAGE_OP_RUN        0x80
+#define IMAGE_OP_RAW        0xC0
+
+inline uint8_t imageColorHash(uint16_t color) {
+    return ((color >> 11) * 3 + ((color >> 5) & 0x3F) * 5 + (color & 0x1F) * 7) % IMAGE_INDEX_SIZE;
+}
+
+struct ImageDecoder {
+    const uint8_t* data;
+    const uint8_t* end;
+    uint16_t prev;
+    uint16_t run;               // Pixels of prev still to emit
+    uint16_t index[IMAGE_INDEX_SIZE];
+};
+
+// Start decoding size bytes at data (flash or RAM)
+void beginImageDecode(ImageDecoder& decoder, const uint8_t* data, size_t size);
+
+// Next count pixels into out, host-order RGB565 - called line by line.
+// panelOrder writes them byte-swapped, as sprite strips and the panel take
+// them, so they can be stored or pushed without a per-pixel pass
+// False if the stream ends early or holds an invalid op
+bool decodeImagePixels(ImageDecoder& decoder, uint16_t* out, size_t count, bool panelOrder = false);
+
+#endif // IMAGE_CODEC_H
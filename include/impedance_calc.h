@@ -1,12 +1,97 @@
 #ifndef IMPEDANCE_CALC_H
 #define IMPEDANCE_CALC_H
 
-#include <Arduino.h>
+#include "hal.h"
 #include "defines.h"
+#include "impedance_math.h"
+#include "circuit_fit.h"
+#include "kk_check.h"
 
-ImpedancePoint calcImpedance(MeasurementPoint measPoint);
+/*=========================RISK LEVEL=========================*/
+// Clear the DUT's risk sums - data processor, before its first final point
+// Only points whose baseline frequency is within freqStartHz..freqEndHz count
+void resetRiskAccumulator(uint8_t dutIdx, uint32_t freqStartHz, uint32_t freqEndHz);
 
-void calculateRiskLevel(uint8_t dutIdx, uint32_t freqStartHz, uint32_t freqEndHz);
+// Data processor: forget the baseline slots - first point of a baseline row
+void resetBaselineSlots(uint8_t dutIdx);
 
+// Data processor: note where a baseline point was stored (freqIdx = storage slot)
+void recordBaselinePoint(uint8_t dutIdx, int freqIdx, const ImpedancePoint& point);
+
+// Data processor: add a final point stored at freqIdx to the DUT's risk sums
+// Paired with the baseline point of the same sweep frequency
+void accumulateRiskPoint(uint8_t dutIdx, int freqIdx, const ImpedancePoint& finalPoint);
+
+// Fast screen: end a DUT's final sweep once its running risk is confident
+// - at least FAST_SCREEN_MIN_POINTS in-range points, and the running |Z|
+// reduction at least FAST_SCREEN_MARGIN away from every risk cutoff
+#define FAST_SCREEN_MIN_POINTS  6
+#define FAST_SCREEN_MARGIN      0.05f   // Fraction (5 percentage points)
+
+extern bool fastScreenMode;
+
+// The DUT's running estimate is far enough from all cutoffs to stop early
+bool isRiskConfident(uint8_t dutIdx);
+
+// Classify the DUT's risk from the sums into riskLevels/riskPercentages
+// Call once the DUT is complete (after its completion event)
+void calculateRiskLevel(uint8_t dutIdx);
+
+// GUI task, between sweeps: classify the DUT again from its stored final and
+// baseline rows - pairs in freqStartHz..freqEndHz, the current cutoffs - for
+// new thresholds without a new sweep. True if its level or reported percent
+// (one decimal, as in RISK:) changed
+bool recalculateRiskLevel(uint8_t dutIdx, uint32_t freqStartHz, uint32_t freqEndHz);
+
+/*=========================TRACKED BASELINE=========================*/
+// Optional in monitor mode (MONITOR:<s>,<half-life>): per DUT and baseline
+// point an exponentially weighted |Z| that follows the final sweeps, so slow
+// drift (electrolyte, temperature) does not pile up against the fixed
+// baseline. Kept as ln|Z| and seeded from the fixed baseline; after each
+// monitor sweep every valid final point moves it by
+//   alpha = 1 - 2^(-1 / half-life)   (half-life in sweeps)
+// O(points) per DUT and no stored history. The risk against it is
+// classified like the fixed one, before the sweep's own update
+#define TRACK_HALF_LIFE_MAX     255
+
+// Seed every DUT from the fixed baseline; halfLifeSweeps 0 = tracking off
+void resetTrackedBaseline(uint8_t halfLifeSweeps);
+
+uint8_t getTrackingHalfLife();     // 0 = off
+
+// GUI task, once per DUT and monitor sweep after calculateRiskLevel():
+// classify the final row against the tracked baseline, then update it
+void trackDUTBaseline(uint8_t dutIdx);
+
+// Risk of the DUT's newest final row against the tracked baseline
+RiskLevel getTrackedRiskLevel(uint8_t dutIdx);
+float getTrackedRiskPercent(uint8_t dutIdx);
+
+// The DUT's tracked ln|Z| per baseline slot (MAX_FREQUENCIES) and the mask of
+// seeded slots - kept over deep sleep (sleep_monitor.h)
+uint64_t getTrackedBaseline(uint8_t dutIdx, float* logMag);
+
+// After resetTrackedBaseline(): continue the DUT from a kept state
+void setTrackedBaseline(uint8_t dutIdx, const float* logMag, uint64_t seeded);
+
+/*=========================CIRCUIT FIT=========================*/
+// Data processor, once the DUT's last point is stored: fit its baseline or
+// final row (circuit_fit.h). The final fit starts from the baseline fit
+void fitDUTCircuit(uint8_t dutIdx, bool final);
+
+// Newest fit of the DUT's baseline or final row - valid is false if none
+const CircuitFit& getDUTCircuitFit(uint8_t dutIdx, bool final);
+
+/*=========================KRAMERS-KRONIG CHECK=========================*/
+// Data processor, once the DUT's last point is stored: Lin-KK check of its
+// baseline or final row (kk_check.h). Returns false only for a failed verdict
+bool checkDUTKramersKronig(uint8_t dutIdx, bool final);
+
+// Newest check of the DUT's baseline or final row - checked is false if none
+const KKResult& getDUTKKResult(uint8_t dutIdx, bool final);
+
+// Rct reduction from the baseline to the final fit (fraction), 0 without both
+// Unlike the |Z| average it does not move with Rs (electrolyte, contact)
+float getCircuitRctChange(uint8_t dutIdx);
 
 #endif // IMPEDANCE_CALC_H
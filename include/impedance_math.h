@@ -0,0 +1,23 @@
+#ifndef IMPEDANCE_MATH_H
+#define IMPEDANCE_MATH_H
+
+#include "hal.h"
+#include "defines.h"
+
+/*=========================IMPEDANCE MATH=========================*/
+// Per-point impedance and risk classification - no storage or RTOS
+// dependencies, so it builds for the host ([env:native])
+
+ImpedancePoint calcImpedance(MeasurementPoint measPoint);
+
+#if IMPEDANCE_RECTANGULAR
+// Fill Z_magnitude/Z_phase (degrees, [-180, 180]) from Z_re/Z_im
+// Call once per point before it is stored for BLE, CSV and the screen
+void impedanceToPolar(ImpedancePoint& point);
+#endif
+
+// Risk level of an average |Z| reduction (fraction) against the
+// lowRiskCutoff/mediumRiskCutoff/highRiskCutoff bands
+RiskLevel classifyRiskChange(float avgChange);
+
+#endif // IMPEDANCE_MATH_H
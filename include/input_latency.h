@@ -0,0 +1,33 @@
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <Arduino.h>
+#include "gui_state.h"
+
+/*=========================INPUT LATENCY=========================*/
+// Time from a button edge or encoder detent to the frame that answers it
+// being on the panel, split where it can go wrong. Field histograms
+// (counters.h, serial "counters"):
+//   input.debounce_us  first edge -> event queued (BUTTON_DEBOUNCE_MS by design)
+//   input.wait_us      queued -> taken by the GUI task (wake-up, a busy pass)
+//   input.handle_us    handleGUIInput()
+//   input.pace_us      handled -> render starts (GUI_FRAME_MIN_MS pacing)
+//   input.draw_us      render: drawing, bands overlapping their SPI transfer
+//   input.push_us      render returned -> last band out of the DMA
+//   input.<screen>_us  edge -> on the panel, per screen the input ended on
+// and counters of the answering frames redrawn in full (input.full_frames)
+// against partial ones (input.partial_frames). Inputs arriving before the
+// frame that answers them count once, by the oldest; an input that requests
+// no frame (a release) is not timed
+
+// GUI task, for each event taken from the button queue
+void inputLatencyReceived(const ButtonInput& input);
+
+// GUI task, after handleGUIInput() of that event
+void inputLatencyHandled();
+
+// GUI task, after a render that began at startUs - waits for the last band
+// if an input is waiting for this frame. full: every band was redrawn
+void inputLatencyFrame(uint32_t startUs, bool full);
+
+#endif // INPUT_LATENCY_H
@@ -0,0 +1,46 @@
+#ifndef INTEGRITY_H
+#define INTEGRITY_H
+
+#include <Arduino.h>
+#include "crc.h"
+#include "mbedtls/sha256.h"
+
+/*=========================INTEGRITY CHECKS=========================*/
+// The checksums of the firmware in one place. Frames and records (UART v2
+// frames, BLE upload frames, the calibration image, session log and stored
+// settings) carry CRC-16/CCITT (crc.h, the ROM routine). Images too large
+// to trust to 16 bits (OTA slots) are checked by SHA-256 on the SHA
+// accelerator: mbedtls hands the blocks to it with
+// CONFIG_MBEDTLS_HARDWARE_SHA (the default on the C6), so hashing runs
+// beside the flash reads instead of on the CPU. Firmware updates are
+// signed: ECDSA P-256 over the image's SHA-256, checked against a public key
+// built into the firmware (ota_signing_key.h) - the ECC accelerator does the
+// point arithmetic with CONFIG_MBEDTLS_HARDWARE_ECC
+#define SHA256_SIZE     32
+#define P256_PUBLIC_KEY_SIZE    65      // Uncompressed point: 0x04, X, Y
+#define P256_SIGNATURE_SIZE     64      // r, s - big-endian, 32 bytes each
+
+// Incremental SHA-256 - begin, any number of updates, finish. release()
+// drops a hash that is not finished (an aborted transfer)
+class Sha256 {
+public:
+    void begin();
+    void update(const void* data, size_t len);
+    void finish(uint8_t* digest);   // SHA256_SIZE bytes
+    void release();
+
+private:
+    mbedtls_sha256_context context = {};
+    bool active = false;
+};
+
+// ECDSA P-256 signature over a SHA-256 digest. Returns false if it does not
+// verify or the key is not a point of the curve
+bool verifyP256Signature(const uint8_t* publicKey, const uint8_t* digest, const uint8_t* signature);
+
+// Boot: known-answer tests of the CRC, SHA and ECDSA engines, so a ROM or
+// accelerator that disagrees with the STM32 and the host tools shows up as
+// one line instead of every frame failing. Returns false on a mismatch
+bool checkIntegrityEngines();
+
+#endif // INTEGRITY_H
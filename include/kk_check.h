@@ -0,0 +1,47 @@
+#ifndef KK_CHECK_H
+#define KK_CHECK_H
+
+#include "hal.h"
+#include "sweep_table.h"
+
+/*=========================KRAMERS-KRONIG CHECK=========================*/
+// Linear Kramers-Kronig test (Lin-KK, Schoenleber et al. 2014). A spectrum
+// that drifted during the sweep, or was disturbed by a bubble, cannot be
+// described by a causal, stable, linear system. The check fits
+//
+//     Z(w) = R0 + sum_k Rk / (1 + j*w*tau_k) + 1/(j*w*C) + j*w*L
+//
+// by linear least squares, with KK_ELEMENTS time constants spread
+// evenly over the sweep table, and measures what is left. The
+// per-frequency basis is computed once for the fixed sweep table, so a
+// check is one small weighted normal-equation solve. Residuals are relative
+// to |Z|. No storage or RTOS dependencies, so it builds for the host
+// ([env:native])
+//
+// The data processor checks every DUT right after its DUT_END. A failing DUT
+// of a sweep is re-measured once by the repair sweep (meas_control.h)
+#ifndef KK_CHECK
+#define KK_CHECK 1
+#endif
+
+#define KK_ELEMENTS         15      // Voigt elements, 3 per decade of the table
+#define KK_MIN_POINTS       12      // Valid points needed for a verdict
+#define KK_MAX_RMS          0.008f  // RMS residual (fraction of |Z|) of a valid sweep
+#define KK_MAX_RESIDUAL     0.04f   // Largest single residual of a valid sweep
+#define KK_RESWEEP_MAX      1       // Automatic re-sweeps of a failing DUT per session
+
+struct KKResult {
+    float rmsResidual;      // Over real and imaginary parts, fraction of |Z|
+    float maxResidual;
+    uint8_t worstIdx;       // Sweep index of the largest residual
+    uint8_t points;         // Valid points checked
+    bool checked;           // Enough points for a verdict
+    bool passed;
+};
+
+// Check count points (sweep index, Ohms, degrees). Points off the sweep
+// table or with a non-positive |Z| are skipped. Returns out.passed
+bool checkKramersKronig(const uint8_t* freqIdx, const float* mag, const float* phaseDeg, int count,
+                        KKResult& out);
+
+#endif // KK_CHECK_H
@@ -0,0 +1,42 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include "hal.h"
+
+// Compile-time log levels - messages above LOG_LEVEL compile to nothing
+#define LOG_LEVEL_NONE      0
+#define LOG_LEVEL_ERROR     1
+#define LOG_LEVEL_WARN      2
+#define LOG_LEVEL_INFO      3
+#define LOG_LEVEL_DEBUG     4   // Per-point measurement/calibration traces
+
+// Override from platformio.ini, e.g. build_flags = -D LOG_LEVEL=LOG_LEVEL_DEBUG
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_E(fmt, ...) HAL_PRINTF(fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_W(fmt, ...) HAL_PRINTF(fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_I(fmt, ...) HAL_PRINTF(fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_D(fmt, ...) HAL_PRINTF(fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(fmt, ...) do {} while (0)
+#endif
+
+#endif // LOG_H
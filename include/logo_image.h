@@ -0,0 +1,1163 @@
+// Generated by logo_compile.py from assets/logo.h - do not edit
+#ifndef LOGO_IMAGE_H
+#define LOGO_IMAGE_H
+
+#include <Arduino.h>
+
+// Splash logo, compressed RGB565 (see image_codec.h)
+#define LOGO_WIDTH      320
+#define LOGO_HEIGHT     240
+#define LOGO_DATA_SIZE  27539
+
+const uint8_t logoData[LOGO_DATA_SIZE] PROGMEM = {
+    0xC0,0x63,0xFD,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xBF,0xBF,0xBF,0x8F,0x7A,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,
+    0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0xAB,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,
+    0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x9D,0x0D,0x0A,0x88,0x0D,0x80,0x0A,0x84,0x0D,0x0A,0x83,
+    0x0D,0x0A,0x81,0x0D,0x0A,0x8B,0x0D,0x80,0x0A,0x84,0x0D,0x0A,0x83,0x0D,0x0A,0x81,0x0D,0x0A,0x8B,0x0D,0x80,0x0A,0x84,0x0D,
+    0x0A,0x83,0x0D,0x0A,0x81,0x0D,0x0A,0x8B,0x0D,0x80,0x0A,0x84,0x0D,0x0A,0x83,0x0D,0x0A,0x81,0x0D,0x0A,0x8B,0x0D,0x80,0x0A,
+    0x84,0x0D,0x0A,0x83,0x0D,0x0A,0x81,0x0D,0x0A,0x8B,0x0D,0x80,0x0A,0x84,0x0D,0x0A,0x83,0x0D,0x0A,0x81,0x0D,0x0A,0x8B,0x0D,
+    0x80,0x0A,0x84,0x0D,0x0A,0x83,0x0D,0x0A,0x81,0x0D,0x0A,0x8B,0x0D,0x80,0x0A,0x84,0x0D,0x0A,0x83,0x0D,0x0A,0x81,0x0D,0x0A,
+    0x8B,0x0D,0x80,0x0A,0x84,0x0D,0x0A,0x83,0x0D,0x0A,0x81,0x0D,0x0A,0x8B,0x0D,0x80,0x0A,0x84,0x0D,0x0A,0x83,0x0D,0x0A,0x81,
+    0x0D,0x0A,0x82,0x0D,0x0A,0x84,0x0D,0x0A,0x96,0x0D,0x0A,0x84,0x0D,0x0A,0x96,0x0D,0x0A,0x84,0x0D,0x0A,0x96,0x0D,0x0A,0x84,
+    0x0D,0x0A,0x96,0x0D,0x0A,0x84,0x0D,0x0A,0x96,0x0D,0x0A,0x84,0x0D,0x0A,0x96,0x0D,0x0A,0x84,0x0D,0x0A,0x96,0x0D,0x0A,0x84,
+    0x0D,0x0A,0x96,0x0D,0x0A,0x84,0x0D,0x0A,0x96,0x0D,0x0A,0x84,0x0D,0x0A,0x99,0x0D,0x80,0x0A,0x81,0x0D,0x80,0x0A,0x80,0x0D,
+    0x0A,0x0D,0x80,0x0A,0x83,0x66,0x0D,0x80,0x0A,0x0D,0x0A,0x0D,0x0A,0x80,0x05,0x0A,0x82,0x0D,0x80,0x0A,0x81,0x0D,0x80,0x0A,
+    0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,0x0D,0x80,0x0A,0x0D,0x0A,0x0D,0x0A,0x80,0x05,0x0A,0x82,0x0D,0x80,0x0A,0x81,0x0D,
+    0x80,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,0x0D,0x80,0x0A,0x0D,0x0A,0x0D,0x0A,0x80,0x05,0x0A,0x82,0x0D,0x80,0x0A,
+    0x81,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,0x0D,0x80,0x0A,0x0D,0x0A,0x0D,0x0A,0x80,0x05,0x0A,0x82,0x0D,
+    0x80,0x0A,0x81,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,0x0D,0x80,0x0A,0x0D,0x0A,0x0D,0x0A,0x80,0x05,0x0A,
+    0x82,0x0D,0x80,0x0A,0x81,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,0x0D,0x80,0x0A,0x0D,0x0A,0x0D,0x0A,0x80,
+    0x05,0x0A,0x82,0x0D,0x80,0x0A,0x81,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,0x0D,0x80,0x0A,0x0D,0x0A,0x0D,
+    0x0A,0x80,0x05,0x0A,0x82,0x0D,0x80,0x0A,0x81,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,0x0D,0x80,0x0A,0x0D,
+    0x0A,0x0D,0x0A,0x80,0x05,0x0A,0x82,0x0D,0x80,0x0A,0x81,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,0x0D,0x80,
+    0x0A,0x0D,0x0A,0x0D,0x0A,0x80,0x05,0x0A,0x82,0x0D,0x80,0x0A,0x81,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x83,0x05,
+    0x0D,0x80,0x0A,0x0D,0x0A,0x0D,0x0A,0x80,0x05,0x0D,0x0A,0x0D,0x66,0x0A,0x81,0x0D,0x0A,0x82,0x0D,0x08,0x0A,0x05,0x0A,0x80,
+    0x0D,0x0A,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x82,0x05,0x0A,0x0D,0x80,0x0A,0x0D,0x08,0x0A,0x81,0x0D,0x0A,0x82,0x0D,0x08,0x0A,
+    0x05,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x82,0x05,0x0A,0x0D,0x80,0x0A,0x0D,0x08,0x0A,0x81,0x0D,0x0A,0x82,
+    0x0D,0x08,0x0A,0x05,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x82,0x05,0x0A,0x0D,0x80,0x0A,0x0D,0x08,0x0A,0x81,
+    0x0D,0x0A,0x82,0x0D,0x08,0x0A,0x05,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x82,0x05,0x0A,0x0D,0x80,0x0A,0x0D,
+    0x08,0x0A,0x81,0x0D,0x0A,0x82,0x0D,0x08,0x0A,0x05,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x82,0x05,0x0A,0x0D,
+    0x80,0x0A,0x0D,0x08,0x0A,0x81,0x0D,0x0A,0x82,0x0D,0x08,0x0A,0x05,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x82,
+    0x05,0x0A,0x0D,0x80,0x0A,0x0D,0x08,0x0A,0x81,0x0D,0x0A,0x82,0x0D,0x08,0x0A,0x05,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x80,
+    0x0D,0x0A,0x82,0x05,0x0A,0x0D,0x80,0x0A,0x0D,0x08,0x0A,0x81,0x0D,0x0A,0x82,0x0D,0x08,0x0A,0x05,0x0A,0x80,0x0D,0x0A,0x0D,
+    0x80,0x0A,0x80,0x0D,0x0A,0x82,0x05,0x0A,0x0D,0x80,0x0A,0x0D,0x08,0x0A,0x81,0x0D,0x0A,0x82,0x0D,0x08,0x0A,0x05,0x0A,0x80,
+    0x0D,0x0A,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x82,0x05,0x0A,0x0D,0x80,0x0A,0x0D,0x08,0x0A,0x81,0x0D,0x0A,0x82,0x0D,0x08,0x0A,
+    0x05,0x0A,0x80,0x0D,0x0A,0x0D,0x80,0x0A,0x80,0x0D,0x0A,0x82,0x05,0x0A,0x0D,0x05,0x0D,0x05,0x0D,0x08,0x0D,0x05,0x0D,0x0A,
+    0x08,0x0D,0x0A,0x81,0x0D,0x80,0x08,0x0A,0x80,0x0D,0x05,0x80,0x0A,0x81,0x08,0x0D,0x80,0x08,0x0D,0x81,0x05,0x0D,0x05,0x0D,
+    0x08,0x0D,0x05,0x0D,0x0A,0x08,0x0D,0x0A,0x81,0x0D,0x80,0x08,0x0A,0x80,0x0D,0x05,0x80,0x0A,0x81,0x08,0x0D,0x80,0x08,0x0D,
+    0x81,0x05,0x0D,0x05,0x0D,0x08,0x0D,0x05,0x0D,0x0A,0x08,0x0D,0x0A,0x81,0x0D,0x80,0x08,0x0A,0x80,0x0D,0x05,0x80,0x0A,0x81,
+    0x08,0x0D,0x80,0x08,0x0D,0x81,0x05,0x0D,0x05,0x0D,0x08,0x0D,0x05,0x0D,0x0A,0x08,0x0D,0x0A,0x81,0x0D,0x80,0x08,0x0A,0x80,
+    0x0D,0x05,0x80,0x0A,0x81,0x08,0x0D,0x80,0x08,0x0D,0x81,0x05,0x0D,0x05,0x0D,0x08,0x0D,0x05,0x0D,0x0A,0x08,0x0D,0x0A,0x81,
+    0x0D,0x80,0x08,0x0A,0x80,0x0D,0x05,0x80,0x0A,0x81,0x08,0x0D,0x80,0x08,0x0D,0x81,0x05,0x0D,0x05,0x0D,0x08,0x0D,0x05,0x0D,
+    0x0A,0x08,0x0D,0x0A,0x81,0x0D,0x80,0x08,0x0A,0x80,0x0D,0x05,0x80,0x0A,0x81,0x08,0x0D,0x80,0x08,0x0D,0x81,0x05,0x0D,0x05,
+    0x0D,0x08,0x0D,0x05,0x0D,0x0A,0x08,0x0D,0x0A,0x81,0x0D,0x80,0x08,0x0A,0x80,0x0D,0x05,0x80,0x0A,0x81,0x08,0x0D,0x80,0x08,
+    0x0D,0x81,0x05,0x0D,0x05,0x0D,0x08,0x0D,0x05,0x0D,0x0A,0x08,0x0D,0x0A,0x81,0x0D,0x80,0x08,0x0A,0x80,0x0D,0x05,0x80,0x0A,
+    0x81,0x08,0x0D,0x80,0x08,0x0D,0x81,0x05,0x0D,0x05,0x0D,0x08,0x0D,0x05,0x0D,0x0A,0x08,0x0D,0x0A,0x81,0x0D,0x80,0x08,0x0A,
+    0x80,0x0D,0x05,0x80,0x0A,0x81,0x08,0x0D,0x80,0x08,0x0D,0x81,0x05,0x0D,0x05,0x0D,0x08,0x0D,0x05,0x0D,0x0A,0x08,0x0D,0x0A,
+    0x81,0x0D,0x80,0x08,0x0A,0x80,0x0D,0x05,0x80,0x0A,0x81,0x08,0x0D,0x80,0x08,0x0D,0x81,0x08,0x0D,0x05,0x08,0x0D,0x0A,0x08,
+    0x0D,0x05,0x0D,0x08,0x81,0x0D,0x80,0x05,0x08,0x0D,0x08,0x05,0x80,0x08,0x81,0x0D,0x05,0x0D,0x80,0x05,0x0D,0x05,0x08,0x80,
+    0x0D,0x05,0x08,0x0D,0x0A,0x08,0x0D,0x05,0x0D,0x08,0x81,0x0D,0x80,0x05,0x08,0x0D,0x08,0x05,0x80,0x08,0x81,0x0D,0x05,0x0D,
+    0x80,0x05,0x0D,0x05,0x08,0x80,0x0D,0x05,0x08,0x0D,0x0A,0x08,0x0D,0x05,0x0D,0x08,0x81,0x0D,0x80,0x05,0x08,0x0D,0x08,0x05,
+    0x80,0x08,0x81,0x0D,0x05,0x0D,0x80,0x05,0x0D,0x05,0x08,0x80,0x0D,0x05,0x08,0x0D,0x0A,0x08,0x0D,0x05,0x0D,0x08,0x81,0x0D,
+    0x80,0x05,0x08,0x0D,0x08,0x05,0x80,0x08,0x81,0x0D,0x05,0x0D,0x80,0x05,0x0D,0x05,0x08,0x80,0x0D,0x05,0x08,0x0D,0x0A,0x08,
+    0x0D,0x05,0x0D,0x08,0x81,0x0D,0x80,0x05,0x08,0x0D,0x08,0x05,0x80,0x08,0x81,0x0D,0x05,0x0D,0x80,0x05,0x0D,0x05,0x08,0x80,
+    0x0D,0x05,0x08,0x0D,0x0A,0x08,0x0D,0x05,0x0D,0x08,0x81,0x0D,0x80,0x05,0x08,0x0D,0x08,0x05,0x80,0x08,0x81,0x0D,0x05,0x0D,
+    0x80,0x05,0x0D,0x05,0x08,0x80,0x0D,0x05,0x08,0x0D,0x0A,0x08,0x0D,0x05,0x0D,0x08,0x81,0x0D,0x80,0x05,0x08,0x0D,0x08,0x05,
+    0x80,0x08,0x81,0x0D,0x05,0x0D,0x80,0x05,0x0D,0x05,0x08,0x80,0x0D,0x05,0x08,0x0D,0x0A,0x08,0x0D,0x05,0x0D,0x08,0x81,0x0D,
+    0x80,0x05,0x08,0x0D,0x08,0x05,0x80,0x08,0x81,0x0D,0x05,0x0D,0x80,0x05,0x0D,0x05,0x08,0x80,0x0D,0x05,0x08,0x0D,0x0A,0x08,
+    0x0D,0x05,0x0D,0x08,0x81,0x0D,0x80,0x05,0x08,0x0D,0x08,0x05,0x80,0x08,0x81,0x0D,0x05,0x0D,0x80,0x05,0x0D,0x05,0x08,0x80,
+    0x0D,0x05,0x08,0x0D,0x0A,0x08,0x0D,0x05,0x0D,0x08,0x81,0x0D,0x80,0x05,0x08,0x0D,0x08,0x05,0x80,0x08,0x81,0x0D,0x05,0x0D,
+    0x80,0x05,0x0D,0x05,0x08,0x80,0x0D,0x80,0x08,0x0D,0x05,0x08,0x82,0x05,0x0A,0x08,0x82,0x0D,0x08,0x80,0x0D,0x80,0x08,0x0A,
+    0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,0x0D,0x08,0x0D,0x80,0x08,0x0D,0x05,0x08,0x82,0x05,0x0A,0x08,0x82,0x0D,0x08,0x80,
+    0x0D,0x80,0x08,0x0A,0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,0x0D,0x08,0x0D,0x80,0x08,0x0D,0x05,0x08,0x82,0x05,0x0A,0x08,
+    0x82,0x0D,0x08,0x80,0x0D,0x80,0x08,0x0A,0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,0x0D,0x08,0x0D,0x80,0x08,0x0D,0x05,0x08,
+    0x82,0x05,0x0A,0x08,0x82,0x0D,0x08,0x80,0x0D,0x80,0x08,0x0A,0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,0x0D,0x08,0x0D,0x80,
+    0x08,0x0D,0x05,0x08,0x82,0x05,0x0A,0x08,0x82,0x0D,0x08,0x80,0x0D,0x80,0x08,0x0A,0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,
+    0x0D,0x08,0x0D,0x80,0x08,0x0D,0x05,0x08,0x82,0x05,0x0A,0x08,0x82,0x0D,0x08,0x80,0x0D,0x80,0x08,0x0A,0x05,0x08,0x80,0x0A,
+    0x0D,0x80,0x05,0x0A,0x0D,0x08,0x0D,0x80,0x08,0x0D,0x05,0x08,0x82,0x05,0x0A,0x08,0x82,0x0D,0x08,0x80,0x0D,0x80,0x08,0x0A,
+    0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,0x0D,0x08,0x0D,0x80,0x08,0x0D,0x05,0x08,0x82,0x05,0x0A,0x08,0x82,0x0D,0x08,0x80,
+    0x0D,0x80,0x08,0x0A,0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,0x0D,0x08,0x0D,0x80,0x08,0x0D,0x05,0x08,0x82,0x05,0x0A,0x08,
+    0x82,0x0D,0x08,0x80,0x0D,0x80,0x08,0x0A,0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,0x0D,0x08,0x0D,0x80,0x08,0x0D,0x05,0x08,
+    0x82,0x05,0x0A,0x08,0x82,0x0D,0x08,0x80,0x0D,0x80,0x08,0x0A,0x05,0x08,0x80,0x0A,0x0D,0x80,0x05,0x0A,0x0D,0x08,0x05,0x08,
+    0x87,0x0D,0x08,0x80,0x05,0x08,0x80,0x0A,0x08,0x05,0x81,0x08,0x89,0x05,0x08,0x87,0x0D,0x08,0x80,0x05,0x08,0x80,0x0A,0x08,
+    0x05,0x81,0x08,0x89,0x05,0x08,0x87,0x0D,0x08,0x80,0x05,0x08,0x80,0x0A,0x08,0x05,0x81,0x08,0x89,0x05,0x08,0x87,0x0D,0x08,
+    0x80,0x05,0x08,0x80,0x0A,0x08,0x05,0x81,0x08,0x89,0x05,0x08,0x87,0x0D,0x08,0x80,0x05,0x08,0x80,0x0A,0x08,0x05,0x81,0x08,
+    0x89,0x05,0x08,0x87,0x0D,0x08,0x80,0x05,0x08,0x80,0x0A,0x08,0x05,0x81,0x08,0x89,0x05,0x08,0x87,0x0D,0x08,0x80,0x05,0x08,
+    0x80,0x0A,0x08,0x05,0x81,0x08,0x89,0x05,0x08,0x87,0x0D,0x08,0x80,0x05,0x08,0x80,0x0A,0x08,0x05,0x81,0x08,0x89,0x05,0x08,
+    0x87,0x0D,0x08,0x80,0x05,0x08,0x80,0x0A,0x08,0x05,0x81,0x08,0x89,0x05,0x08,0x87,0x0D,0x08,0x80,0x05,0x08,0x80,0x0A,0x08,
+    0x05,0x81,0x08,0x8B,0x0D,0x05,0x08,0x81,0x0D,0x05,0x08,0x83,0x0D,0x08,0x80,0x0D,0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,
+    0x08,0x83,0x0D,0x05,0x08,0x81,0x0D,0x05,0x08,0x83,0x0D,0x08,0x80,0x0D,0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x83,
+    0x0D,0x05,0x08,0x81,0x0D,0x05,0x08,0x83,0x0D,0x08,0x80,0x0D,0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x83,0x0D,0x05,
+    0x08,0x81,0x0D,0x05,0x08,0x83,0x0D,0x08,0x80,0x0D,0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x83,0x0D,0x05,0x08,0x81,
+    0x0D,0x05,0x08,0x83,0x0D,0x08,0x80,0x0D,0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x83,0x0D,0x05,0x08,0x81,0x0D,0x05,
+    0x08,0x83,0x0D,0x08,0x80,0x0D,0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x83,0x0D,0x05,0x08,0x81,0x0D,0x05,0x08,0x83,
+    0x0D,0x08,0x80,0x0D,0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x83,0x0D,0x05,0x08,0x81,0x0D,0x05,0x08,0x83,0x0D,0x08,
+    0x80,0x0D,0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x83,0x0D,0x05,0x08,0x81,0x0D,0x05,0x08,0x83,0x0D,0x08,0x80,0x0D,
+    0x08,0x82,0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x83,0x0D,0x05,0x08,0x81,0x0D,0x05,0x08,0x83,0x0D,0x08,0x80,0x0D,0x08,0x82,
+    0x0D,0x08,0x81,0x05,0x08,0x05,0x08,0x8C,0x05,0x08,0x90,0x0D,0x08,0x8A,0x05,0x08,0x90,0x0D,0x08,0x8A,0x05,0x08,0x90,0x0D,
+    0x08,0x8A,0x05,0x08,0x90,0x0D,0x08,0x8A,0x05,0x08,0x90,0x0D,0x08,0x8A,0x05,0x08,0x90,0x0D,0x08,0x8A,0x05,0x08,0x90,0x0D,
+    0x08,0x8A,0x05,0x08,0x90,0x0D,0x08,0x8A,0x05,0x08,0x90,0x0D,0x08,0x8A,0x05,0x08,0x90,0x0D,0x08,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xBF,0x66,0x08,0x88,0x03,0x08,0x92,0x03,0x08,0x88,0x03,0x08,0x92,0x03,0x08,0x88,0x03,0x08,0x92,0x03,0x08,0x88,0x03,
+    0x08,0x92,0x03,0x08,0x88,0x03,0x08,0x92,0x03,0x08,0x88,0x03,0x08,0x92,0x03,0x08,0x88,0x03,0x08,0x92,0x03,0x08,0x88,0x03,
+    0x08,0x92,0x03,0x08,0x88,0x03,0x08,0x92,0x03,0x08,0x88,0x03,0x08,0x9B,0x03,0x08,0x83,0x03,0x08,0x81,0x03,0x08,0x93,0x03,
+    0x08,0x83,0x03,0x08,0x81,0x03,0x08,0x93,0x03,0x08,0x83,0x03,0x08,0x81,0x03,0x08,0x93,0x03,0x08,0x83,0x03,0x08,0x81,0x03,
+    0x08,0x93,0x03,0x08,0x83,0x03,0x08,0x81,0x03,0x08,0x93,0x03,0x08,0x83,0x03,0x08,0x81,0x03,0x08,0x93,0x03,0x08,0x83,0x03,
+    0x08,0x81,0x03,0x08,0x93,0x03,0x08,0x83,0x03,0x08,0x81,0x03,0x08,0x93,0x03,0x08,0x83,0x03,0x08,0x81,0x03,0x08,0x93,0x03,
+    0x08,0x83,0x03,0x08,0x81,0x03,0x08,0x8A,0x03,0x08,0x89,0x03,0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,
+    0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,
+    0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,
+    0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,
+    0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x82,0x03,0x08,0x89,0x03,
+    0x08,0x86,0x03,0x08,0x83,0x03,0x08,0x84,0x03,0x81,0x08,0x82,0x03,0x82,0x08,0x80,0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,
+    0x08,0x03,0x08,0x03,0x08,0x82,0x03,0x81,0x08,0x82,0x03,0x82,0x08,0x80,0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,
+    0x08,0x03,0x08,0x82,0x03,0x81,0x08,0x82,0x03,0x82,0x08,0x80,0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,0x08,0x03,
+    0x08,0x82,0x03,0x81,0x08,0x82,0x03,0x82,0x08,0x80,0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x82,
+    0x03,0x81,0x08,0x82,0x03,0x82,0x08,0x80,0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x82,0x03,0x81,
+    0x08,0x82,0x03,0x82,0x08,0x80,0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x82,0x03,0x81,0x08,0x82,
+    0x03,0x82,0x08,0x80,0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x82,0x03,0x81,0x08,0x82,0x03,0x82,
+    0x08,0x80,0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x82,0x03,0x81,0x08,0x82,0x03,0x82,0x08,0x80,
+    0x03,0x08,0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x82,0x03,0x81,0x08,0x82,0x03,0x82,0x08,0x80,0x03,0x08,
+    0x03,0x08,0x83,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,
+    0x03,0x08,0x03,0x08,0x03,0x81,0x08,0x82,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,
+    0x08,0x03,0x08,0x03,0x81,0x08,0x82,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x08,
+    0x03,0x08,0x03,0x81,0x08,0x82,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x08,0x03,
+    0x08,0x03,0x81,0x08,0x82,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x08,0x03,0x08,
+    0x03,0x81,0x08,0x82,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x03,
+    0x81,0x08,0x82,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x81,
+    0x08,0x82,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x81,0x08,
+    0x82,0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x81,0x08,0x82,
+    0x03,0x08,0x03,0x82,0x08,0x80,0x03,0x83,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x03,0x81,0x08,0x82,0x03,
+    0x08,0x03,0x82,0x08,0x80,0x03,0x80,0x08,0x03,0x84,0x08,0x03,0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,0x08,0x03,0x85,0x08,
+    0x80,0x03,0x80,0x08,0x03,0x84,0x08,0x03,0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,0x08,0x03,0x85,0x08,0x80,0x03,0x80,0x08,
+    0x03,0x84,0x08,0x03,0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,0x08,0x03,0x85,0x08,0x80,0x03,0x80,0x08,0x03,0x84,0x08,0x03,
+    0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,0x08,0x03,0x85,0x08,0x80,0x03,0x80,0x08,0x03,0x84,0x08,0x03,0x82,0x08,0x03,0x81,
+    0x08,0x80,0x03,0x80,0x08,0x03,0x85,0x08,0x80,0x03,0x80,0x08,0x03,0x84,0x08,0x03,0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,
+    0x08,0x03,0x85,0x08,0x80,0x03,0x80,0x08,0x03,0x84,0x08,0x03,0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,0x08,0x03,0x85,0x08,
+    0x80,0x03,0x80,0x08,0x03,0x84,0x08,0x03,0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,0x08,0x03,0x85,0x08,0x80,0x03,0x80,0x08,
+    0x03,0x84,0x08,0x03,0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,0x08,0x03,0x85,0x08,0x80,0x03,0x80,0x08,0x03,0x84,0x08,0x03,
+    0x82,0x08,0x03,0x81,0x08,0x80,0x03,0x80,0x08,0x03,0x88,0x08,0x03,0x80,0x08,0x03,0x82,0x08,0x03,0x83,0x08,0x03,0x08,0x03,
+    0x8D,0x08,0x03,0x80,0x08,0x03,0x82,0x08,0x03,0x83,0x08,0x03,0x08,0x03,0x8D,0x08,0x03,0x80,0x08,0x03,0x82,0x08,0x03,0x83,
+    0x08,0x03,0x08,0x03,0x8D,0x08,0x03,0x80,0x08,0x03,0x82,0x08,0x03,0x83,0x08,0x03,0x08,0x03,0x8D,0x08,0x03,0x80,0x08,0x03,
+    0x82,0x08,0x03,0x83,0x08,0x03,0x08,0x03,0x8D,0x08,0x03,0x80,0x08,0x03,0x82,0x08,0x03,0x83,0x08,0x03,0x08,0x03,0x8D,0x08,
+    0x03,0x80,0x08,0x03,0x82,0x08,0x03,0x83,0x08,0x03,0x08,0x03,0x8D,0x08,0x03,0x80,0x08,0x03,0x82,0x08,0x03,0x83,0x08,0x03,
+    0x08,0x03,0x8D,0x08,0x03,0x80,0x08,0x03,0x82,0x08,0x03,0x83,0x08,0x03,0x08,0x03,0x8D,0x08,0x03,0x80,0x08,0x03,0x82,0x08,
+    0x03,0x83,0x08,0x03,0x08,0x03,0xBF,0xBF,0xBF,0xBF,0xBF,0x8C,0x08,0x03,0x9D,0x08,0x03,0x9D,0x08,0x03,0x9D,0x08,0x03,0x9D,
+    0x08,0x03,0x9D,0x08,0x03,0x9D,0x08,0x03,0x9D,0x08,0x03,0x9D,0x08,0x03,0x9D,0x08,0x03,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0x8B,0x08,0x59,0xC0,0x64,0x18,0xC0,0x5C,0x75,0xC0,0x5C,0xB1,0xC0,0x4C,0xEE,0x7E,0x80,0x6E,0x65,0x6E,0x01,0x06,0x87,0x69,
+    0x06,0x3F,0x8B,0x6E,0x3F,0x91,0x06,0x8E,0x01,0x80,0x0D,0x08,0x82,0x67,0x67,0xC0,0x5C,0xB2,0xC0,0x5C,0x74,0xC0,0x64,0x19,
+    0xC0,0x6B,0xDC,0x03,0xBF,0xBF,0xBF,0xA8,0x33,0x0C,0xC0,0x55,0x6B,0x6C,0x81,0x6E,0x80,0x39,0x3E,0x39,0x3E,0x84,0x39,0x3E,
+    0x84,0x39,0x80,0x3E,0x39,0x81,0x3E,0x88,0x39,0x3E,0x82,0x39,0x3E,0x87,0x39,0x3E,0x39,0x86,0x3E,0x80,0x39,0x80,0x3E,0x39,
+    0x84,0x3E,0x39,0x82,0x3E,0x80,0x39,0x80,0xC0,0x55,0x4B,0xC0,0x54,0xB2,0xC0,0x63,0xFA,0x03,0xBF,0xBF,0xBF,0xA4,0x33,0x06,
+    0x3E,0x86,0x39,0x3E,0x92,0x39,0x80,0x3E,0xA2,0x39,0x3E,0x83,0x39,0x80,0x3E,0x8A,0x39,0x08,0xC0,0x63,0xF9,0x03,0xBF,0xBF,
+    0xBF,0xA0,0x01,0x11,0xC0,0x55,0x8A,0x39,0x3E,0x8E,0x39,0x3E,0x84,0x39,0x3E,0x8C,0x39,0x3E,0x87,0x39,0x3E,0x83,0x39,0x3E,
+    0x8F,0x39,0x80,0x3E,0x84,0x39,0x3E,0x86,0x00,0x18,0x01,0x03,0xBF,0xBF,0xBF,0x9D,0x35,0x06,0x39,0x80,0x3E,0x90,0x39,0x3E,
+    0x82,0x39,0x3E,0x39,0x82,0x3E,0x84,0x39,0x3E,0x87,0x39,0x3E,0x81,0x39,0x80,0x3E,0x39,0x3E,0x80,0x39,0x81,0x3E,0x81,0x39,
+    0x3E,0x39,0x85,0x3E,0x80,0x39,0x82,0x3E,0x39,0x3E,0x39,0x80,0x3E,0x88,0x39,0x06,0x35,0x03,0xBF,0xBF,0xBF,0x9B,0x5C,0x04,
+    0x39,0x3E,0x83,0x39,0x3E,0x81,0x55,0x55,0x2F,0x8C,0x66,0x2F,0x81,0x2A,0x2F,0x99,0x2A,0x2F,0x96,0x2A,0x20,0x2F,0x3E,0x88,
+    0x3F,0x37,0x03,0xBF,0xBF,0xBF,0x99,0x6C,0x3D,0x39,0x3E,0x81,0x39,0x80,0x3E,0x56,0x0A,0x23,0x37,0xC0,0x6B,0xDD,0x7A,0xBF,
+    0x88,0x08,0x37,0x23,0x0A,0x39,0x3E,0x83,0x39,0x3E,0x3D,0xC0,0x63,0xFB,0x03,0xBF,0xBF,0xBF,0x97,0x01,0xC0,0x55,0x0E,0x3E,
+    0x39,0x3E,0x82,0x39,0xC0,0x55,0x0F,0xC0,0x64,0x38,0xC0,0x6B,0xDD,0x03,0xBF,0x8F,0x31,0x0F,0x39,0x3E,0x82,0x39,0x3E,0xC0,
+    0x55,0x0E,0x01,0x03,0xBF,0xBF,0xBF,0x96,0xC0,0x5C,0x93,0x39,0x3E,0x39,0x3E,0x39,0x80,0x67,0x23,0x03,0xBF,0x94,0xC0,0x5C,
+    0x94,0x3B,0x3E,0x83,0x39,0x1A,0x03,0xBF,0xBF,0xBF,0x95,0x2E,0x39,0x82,0x3E,0x39,0x02,0x33,0x03,0xBF,0x96,0x2E,0x02,0x39,
+    0x3E,0x82,0x39,0x2E,0x03,0xBF,0xBF,0xBF,0x94,0x0C,0x39,0x81,0x3E,0x39,0x3B,0x2C,0x03,0xBF,0x98,0x2C,0x3B,0x3E,0x80,0x39,
+    0x3E,0x39,0xC0,0x5C,0xF0,0x03,0xBF,0xAD,0x66,0x03,0x8E,0x3E,0x03,0x88,0x3E,0x03,0x81,0x3E,0x03,0x8E,0x3E,0x03,0x88,0x3E,
+    0x03,0x81,0x3E,0x03,0x8E,0x3E,0x03,0x88,0x3E,0x03,0x81,0x3E,0x03,0x83,0x2C,0x39,0x6E,0x80,0x39,0x81,0xC0,0x5C,0x56,0x03,
+    0x81,0x66,0x03,0x88,0x3E,0x03,0x81,0x3E,0x03,0x8E,0x3E,0x03,0x88,0x3E,0x03,0x81,0x3E,0x03,0x8E,0x3E,0x03,0x88,0x3E,0x03,
+    0x81,0x3E,0x03,0x87,0x25,0x39,0x6E,0x81,0x39,0x80,0x2C,0x03,0x88,0x66,0x03,0x81,0x3E,0x03,0x8E,0x3E,0x03,0x88,0x3E,0x03,
+    0x81,0x3E,0x03,0x8E,0x3E,0x03,0x88,0x3E,0x03,0x81,0x3E,0x03,0x8E,0x3E,0x03,0x88,0x3E,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,
+    0x83,0x3E,0x03,0x3E,0x03,0x82,0x3E,0x03,0x8D,0x3E,0x03,0x80,0x3E,0x03,0x83,0x3E,0x03,0x3E,0x03,0x82,0x3E,0x03,0x8D,0x3E,
+    0x03,0x80,0x3E,0x03,0x83,0x3E,0x03,0x3E,0x03,0x82,0x3E,0x03,0x8D,0x3E,0x03,0x80,0x3E,0x03,0x81,0x18,0xC0,0x55,0xA9,0x81,
+    0x39,0x80,0x0C,0x03,0x80,0x66,0x03,0x8D,0x3E,0x03,0x80,0x3E,0x03,0x84,0xC0,0x53,0xBC,0xC0,0x33,0xFB,0xC0,0x43,0xDB,0x03,
+    0x81,0x3E,0x03,0x8D,0x3E,0x03,0x80,0x3E,0x03,0x83,0x3E,0x03,0x3E,0x03,0x82,0x3E,0x03,0x8D,0x3E,0x03,0x80,0x3E,0x03,0x83,
+    0x3E,0x03,0x80,0x0C,0x39,0x6E,0x39,0x80,0x3E,0x11,0x03,0x8B,0x66,0x03,0x80,0x3E,0x03,0x83,0x3E,0x03,0x3E,0x03,0x82,0x3E,
+    0x03,0x8D,0x3E,0x03,0x80,0x3E,0x03,0x83,0x3E,0x03,0x3E,0x03,0x82,0x3E,0x03,0x8D,0x3E,0x03,0x80,0x3E,0x03,0x83,0x3E,0x03,
+    0x3E,0x03,0x82,0x3E,0x03,0x8C,0x3E,0x03,0x80,0x3E,0x80,0x03,0x3E,0x03,0x80,0x3E,0x03,0x87,0x3E,0x03,0x3E,0x03,0x81,0x3E,
+    0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,0x03,0x3E,0x03,0x80,0x3E,0x03,0x87,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,
+    0x3E,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,0x03,0x3E,0x03,0x80,0x3E,0x03,0x87,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,
+    0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,0x03,0x3E,0x6D,0x3F,0x39,0x6E,0x39,0x3E,0x39,0x2E,0x03,0x82,0x66,0x03,0x3E,0x03,
+    0x81,0x3E,0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,0x03,0x3E,0x03,0x80,0x3E,0x2B,0xC0,0x04,0x79,0x6E,0x80,0xC0,
+    0x2C,0x1A,0x03,0x82,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,0x03,0x3E,0x03,0x80,
+    0x3E,0x03,0x87,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,0x03,0x3E,0x03,0x80,0x3E,
+    0x03,0x81,0x2E,0x39,0x6E,0x39,0x80,0x3E,0x3F,0x3C,0x67,0x03,0x81,0x3E,0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,
+    0x03,0x3E,0x03,0x80,0x3E,0x03,0x87,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,0x03,
+    0x3E,0x03,0x80,0x3E,0x03,0x87,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x80,0x03,0x3E,
+    0x03,0x80,0x3E,0x03,0x87,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x81,0x03,0x3E,0x03,0x3E,0x03,0x82,0x3E,0x80,0x03,0x3E,
+    0x80,0x03,0x3E,0x83,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,0x03,0x3E,0x03,0x82,0x3E,0x80,0x03,
+    0x3E,0x80,0x03,0x3E,0x83,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,0x03,0x3E,0x03,0x82,0x3E,0x80,
+    0x03,0x3E,0x80,0x03,0x3E,0x83,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,0x03,0x3E,0x03,0x82,0x3E,
+    0x2C,0x00,0x6D,0x82,0xC0,0x55,0x0D,0xC0,0x6B,0x9D,0x81,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,
+    0x03,0x3E,0x03,0x82,0x3E,0x80,0x03,0x3E,0xC0,0x0C,0x39,0x1E,0x23,0x1E,0x80,0xC0,0x5B,0xBD,0x3E,0x03,0x80,0x3E,0x03,0x80,
+    0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,0x03,0x3E,0x03,0x82,0x3E,0x80,0x03,0x3E,0x80,0x03,0x3E,0x83,0x03,0x80,0x3E,0x03,
+    0x80,0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,0x03,0x3E,0x03,0x82,0x3E,0x80,0x03,0x3E,0x80,0x03,0x3E,0x80,0x01,0x39,0x6E,
+    0x39,0x3E,0x3B,0x2C,0x03,0x66,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,0x03,0x3E,0x03,0x82,0x3E,0x80,0x03,0x3E,0x80,0x03,0x3E,
+    0x83,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,0x03,0x3E,0x03,0x82,0x3E,0x80,0x03,0x3E,0x80,0x03,
+    0x3E,0x83,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x80,0x03,0x3E,0x03,0x82,0x3E,0x80,0x03,0x3E,0x80,
+    0x03,0x3E,0x83,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x81,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,
+    0x80,0x3E,0x03,0x3E,0x03,0x80,0x3E,0x84,0x03,0x80,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x80,
+    0x3E,0x03,0x3E,0x03,0x80,0x3E,0x84,0x03,0x80,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x80,0x3E,
+    0x03,0x3E,0x03,0x80,0x3E,0x84,0x03,0x80,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x80,0x1C,0x39,0x6E,0x39,
+    0x81,0x1C,0x03,0x66,0x84,0x03,0x80,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x33,0x23,0x82,0x1E,
+    0xC0,0x4B,0xDC,0x3E,0x83,0x03,0x80,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x3E,
+    0x03,0x80,0x3E,0x84,0x03,0x80,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x80,0x3E,0x03,0x3E,0x03,
+    0x1C,0xC0,0x55,0xA9,0x82,0x39,0xC0,0x5C,0x56,0x03,0x80,0x66,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,
+    0x80,0x3E,0x03,0x3E,0x03,0x80,0x3E,0x84,0x03,0x80,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x80,
+    0x3E,0x03,0x3E,0x03,0x80,0x3E,0x84,0x03,0x80,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x80,0x3E,
+    0x03,0x3E,0x03,0x80,0x3E,0x84,0x03,0x80,0x3E,0x03,0x3E,0x86,0x03,0x3E,0x8B,0x03,0x81,0x3E,0x86,0x03,0x3E,0x84,0x03,0x3E,
+    0x8B,0x03,0x81,0x3E,0x86,0x03,0x3E,0x84,0x03,0x3E,0x8B,0x03,0x81,0x3E,0x86,0x03,0x3E,0x84,0x03,0x3E,0x83,0xC0,0x5C,0xB3,
+    0x39,0x83,0x31,0x3E,0x03,0x81,0x3E,0x86,0x03,0x3E,0x84,0x03,0x3E,0x85,0xC0,0x3B,0xFB,0x1E,0x23,0x80,0x1E,0x23,0xC0,0x2C,
+    0x1A,0x03,0x80,0x3E,0x86,0x03,0x3E,0x84,0x03,0x3E,0x8B,0x03,0x81,0x3E,0x86,0x03,0x3E,0x84,0x03,0x3E,0x8A,0xC0,0x64,0x37,
+    0x39,0x6E,0x81,0x39,0x21,0xC0,0x6B,0x9D,0x83,0x03,0x3E,0x84,0x03,0x3E,0x8B,0x03,0x81,0x3E,0x86,0x03,0x3E,0x84,0x03,0x3E,
+    0x8B,0x03,0x81,0x3E,0x86,0x03,0x3E,0x84,0x03,0x3E,0x8B,0x03,0x81,0x3E,0x86,0x03,0x3E,0x85,0x03,0x3E,0x82,0x6B,0x3E,0x80,
+    0x03,0x3E,0x95,0x03,0x3E,0x82,0x05,0x3E,0x80,0x03,0x3E,0x95,0x03,0x3E,0x82,0x05,0x3E,0x80,0x03,0x3E,0x95,0x03,0x3E,0x82,
+    0x1F,0x39,0x6E,0x39,0x80,0x36,0xC0,0x6C,0x1A,0xC0,0x6B,0x9D,0x92,0x03,0x3E,0x82,0x05,0x3E,0xC0,0x24,0x3A,0x1E,0x80,0x23,
+    0x1E,0x23,0x61,0x3E,0x90,0x03,0x3E,0x82,0x05,0x3E,0x80,0x03,0x3E,0x95,0x03,0x3E,0x82,0x05,0x3E,0x80,0x03,0x3E,0x81,0xC0,
+    0x6C,0x3A,0x2F,0x7F,0x81,0x39,0x1F,0xC0,0x6B,0x9D,0x8B,0x03,0x3E,0x82,0x05,0x3E,0x80,0x03,0x3E,0x95,0x03,0x3E,0x82,0x05,
+    0x3E,0x80,0x03,0x3E,0x95,0x03,0x3E,0x82,0x05,0x3E,0x80,0x03,0x3E,0x92,0x03,0x3E,0x9D,0x03,0x3E,0x9D,0x03,0x3E,0x9D,0x03,
+    0x3E,0x85,0x1F,0x39,0x80,0x6E,0x80,0x39,0xC0,0x6B,0xFA,0xC0,0x6B,0x9D,0x8F,0x03,0x3E,0x86,0x4D,0xC0,0x04,0x59,0x1E,0x23,
+    0x1E,0x23,0x81,0x36,0x3E,0x8C,0x03,0x3E,0x9D,0x03,0x3E,0x8C,0x3D,0x39,0x6E,0x81,0x39,0x1F,0xC0,0x6B,0x9D,0x88,0x03,0x3E,
+    0x9D,0x03,0x3E,0x9D,0x03,0x3E,0xBF,0xBF,0x85,0x1F,0x39,0x80,0x6E,0x80,0x39,0xC0,0x63,0xFA,0xC0,0x6B,0x9D,0x98,0xC0,0x4B,
+    0xDB,0x1E,0x23,0x1E,0x23,0x1E,0x81,0xC0,0x43,0xFB,0x3E,0xBB,0x38,0x39,0x6E,0x81,0x39,0x1F,0xC0,0x6B,0x9D,0xBF,0xAC,0x05,
+    0x3E,0x87,0x05,0x3E,0x8E,0x05,0x3E,0x82,0x05,0x3E,0x87,0x05,0x3E,0x8E,0x05,0x3E,0x82,0x05,0x3E,0x87,0x05,0x3E,0x8E,0x05,
+    0x3E,0x82,0x05,0x3E,0x81,0x1F,0x39,0x80,0x6E,0x80,0x39,0x38,0xC0,0x6B,0x9D,0x8E,0x05,0x3E,0x82,0x05,0x3E,0x82,0x25,0x23,
+    0x83,0x1E,0x23,0xC0,0x24,0x1A,0x3E,0x8B,0x05,0x3E,0x82,0x05,0x3E,0x87,0x05,0x3E,0x8E,0x05,0x3E,0x82,0x05,0x3E,0x87,0x05,
+    0x38,0x39,0x6E,0x39,0x3E,0x39,0x18,0xC0,0x6B,0x9D,0x87,0x05,0x3E,0x82,0x05,0x3E,0x87,0x05,0x3E,0x8E,0x05,0x3E,0x82,0x05,
+    0x3E,0x87,0x05,0x3E,0x8E,0x05,0x3E,0x82,0x05,0x3E,0x87,0x05,0x3E,0x8E,0x05,0x3E,0x80,0x05,0x3E,0x83,0x05,0x3E,0x97,0x05,
+    0x3E,0x83,0x05,0x3E,0x97,0x05,0x3E,0x83,0x05,0x3E,0x97,0x05,0x3E,0x83,0x1F,0x39,0x6E,0x80,0x39,0x80,0x38,0xC0,0x6B,0x9D,
+    0x91,0x05,0x3E,0x83,0x03,0xC0,0x14,0x59,0x23,0x82,0x1E,0x23,0x80,0x72,0xC0,0x63,0xBD,0x3E,0x8D,0x05,0x3E,0x83,0x05,0x3E,
+    0x97,0x05,0x3E,0x83,0x05,0x3E,0x84,0xC0,0x63,0xDA,0x39,0x6E,0x81,0x39,0x11,0xC0,0x6B,0x9D,0x8A,0x05,0x3E,0x83,0x05,0x3E,
+    0x97,0x05,0x3E,0x83,0x05,0x3E,0x97,0x05,0x3E,0x83,0x05,0x3E,0x96,0x05,0x3E,0x97,0x05,0x3E,0x83,0x05,0x3E,0x97,0x05,0x3E,
+    0x83,0x05,0x3E,0x97,0x05,0x3E,0x83,0x05,0x3E,0x84,0xC0,0x64,0xB3,0x39,0x6E,0x39,0x81,0x38,0xC0,0x6B,0x9D,0x8A,0x05,0x3E,
+    0x83,0x05,0x3E,0x84,0x33,0x1E,0x23,0x85,0x1E,0xC0,0x53,0xDC,0x3E,0x86,0x05,0x3E,0x83,0x05,0x3E,0x97,0x05,0x3E,0x83,0x05,
+    0x3E,0x8B,0xC0,0x6B,0xDA,0x39,0x6E,0x81,0x39,0x11,0xC0,0x6B,0x9D,0x83,0x05,0x3E,0x83,0x05,0x3E,0x97,0x05,0x3E,0x83,0x05,
+    0x3E,0x97,0x05,0x3E,0x83,0x05,0x3E,0x97,0x05,0x3E,0x8D,0x05,0x3E,0x82,0x05,0x3E,0x82,0x05,0x3E,0x93,0x05,0x3E,0x82,0x05,
+    0x3E,0x82,0x05,0x3E,0x93,0x05,0x3E,0x82,0x05,0x3E,0x82,0x05,0x3E,0x90,0xC0,0x5C,0xB3,0x39,0x6E,0x39,0x81,0xC0,0x6B,0xFA,
+    0xC0,0x6B,0x9D,0x05,0x3E,0x82,0x05,0x3E,0x90,0xC0,0x33,0xFB,0x1E,0x23,0x86,0x2D,0x3E,0x80,0x05,0x3E,0x93,0x05,0x3E,0x82,
+    0x05,0x3E,0x82,0x05,0x3E,0x93,0x05,0x3E,0x81,0x3A,0xC0,0x55,0x8A,0x39,0x6E,0x80,0x39,0xC0,0x5C,0xD1,0xC0,0x6B,0x9D,0x93,
+    0x05,0x3E,0x82,0x05,0x3E,0x82,0x05,0x3E,0x93,0x05,0x3E,0x82,0x05,0x3E,0x82,0x05,0x3E,0x93,0x05,0x3E,0x82,0x05,0x3E,0x82,
+    0x05,0x3E,0x8C,0x05,0x3E,0x81,0x05,0x80,0x3E,0x84,0x05,0x80,0x3E,0x83,0x05,0x3E,0x8A,0x05,0x3E,0x81,0x05,0x80,0x3E,0x84,
+    0x05,0x80,0x3E,0x83,0x05,0x3E,0x8A,0x05,0x3E,0x81,0x05,0x80,0x3E,0x84,0x05,0x80,0x3E,0x83,0x05,0x3E,0x8A,0x05,0x3E,0x81,
+    0x22,0x39,0x6E,0x39,0x81,0x35,0xC0,0x6B,0x9D,0x05,0x80,0x3E,0x83,0x05,0x3E,0x8A,0x05,0x3E,0x81,0xC0,0x1C,0x3A,0x1E,0x80,
+    0x23,0x80,0x1E,0x80,0x23,0x81,0x24,0xC0,0x73,0x9D,0x3E,0x81,0x05,0x3E,0x8A,0x05,0x3E,0x81,0x05,0x80,0x3E,0x84,0x05,0x80,
+    0x3E,0x83,0x05,0x3E,0x8A,0x05,0x3E,0x81,0x05,0x80,0x3E,0x83,0x3A,0x00,0x6D,0x81,0x39,0x11,0xC0,0x6B,0x9D,0x05,0x3E,0x8A,
+    0x05,0x3E,0x81,0x05,0x80,0x3E,0x84,0x05,0x80,0x3E,0x83,0x05,0x3E,0x8A,0x05,0x3E,0x81,0x05,0x80,0x3E,0x84,0x05,0x80,0x3E,
+    0x83,0x05,0x3E,0x8A,0x05,0x3E,0x81,0x05,0x80,0x3E,0x84,0x05,0x80,0x3E,0x83,0x05,0x3E,0x86,0x05,0x01,0x3E,0x87,0x05,0x3E,
+    0x05,0x3E,0x82,0x05,0x3E,0x05,0x3E,0x83,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x87,0x05,0x3E,0x05,0x3E,0x82,0x05,
+    0x3E,0x05,0x3E,0x83,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x87,0x05,0x3E,0x05,0x3E,0x82,0x05,0x3E,0x05,0x3E,0x83,
+    0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x84,0x22,0x39,0x6E,0x80,0x39,0x80,0x38,0xC0,0x6B,0x9D,0x81,0x05,0x3E,0x05,
+    0x3E,0x83,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x83,0x03,0x12,0x23,0x1E,0x23,0x1E,0xC0,0x1C,0x59,0x1E,0x23,0x81,
+    0x1C,0xC0,0x63,0x9D,0x05,0x3E,0x83,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x87,0x05,0x3E,0x05,0x3E,0x82,0x05,0x3E,
+    0x05,0x3E,0x83,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x87,0x05,0x3E,0x05,0x3E,0x3C,0xC0,0x55,0x6B,0xC0,0x55,0xA9,
+    0x81,0x39,0x1F,0xC0,0x6B,0x9D,0x82,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x87,0x05,0x3E,0x05,0x3E,0x82,0x05,0x3E,
+    0x05,0x3E,0x83,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x87,0x05,0x3E,0x05,0x3E,0x82,0x05,0x3E,0x05,0x3E,0x83,0x05,
+    0x3E,0x80,0x05,0x3E,0x80,0x05,0x01,0x3E,0x87,0x05,0x3E,0x05,0x3E,0x82,0x05,0x3E,0x05,0x3E,0x83,0x05,0x3E,0x80,0x05,0x3E,
+    0x80,0x05,0x81,0x3E,0x80,0x05,0x82,0x3E,0x80,0x05,0x80,0x3E,0x05,0x80,0x3E,0x05,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,
+    0x3E,0x84,0x05,0x81,0x3E,0x80,0x05,0x82,0x3E,0x80,0x05,0x80,0x3E,0x05,0x80,0x3E,0x05,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x80,
+    0x05,0x3E,0x84,0x05,0x81,0x3E,0x80,0x05,0x82,0x3E,0x80,0x05,0x80,0x3E,0x05,0x80,0x3E,0x05,0x3E,0x05,0x3E,0x80,0x05,0x3E,
+    0x80,0x05,0x3E,0x84,0x05,0x81,0x3E,0x80,0x05,0x81,0x1F,0x39,0x6E,0x81,0x39,0x33,0x05,0x69,0x05,0x3E,0x05,0x3E,0x80,0x05,
+    0x3E,0x80,0x05,0x3E,0x84,0x05,0x81,0x3E,0x80,0x05,0x80,0xC0,0x43,0xBB,0x23,0x81,0x1E,0x80,0xC0,0x53,0xDC,0x1E,0x23,0x81,
+    0x1E,0xC0,0x4B,0xDC,0x3E,0x80,0x05,0x3E,0x80,0x05,0x3E,0x84,0x05,0x81,0x3E,0x80,0x05,0x82,0x3E,0x80,0x05,0x80,0x3E,0x05,
+    0x80,0x3E,0x05,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x3E,0x84,0x05,0x81,0x3E,0x80,0x05,0x82,0x3E,0x80,0x05,0x80,0x3E,
+    0x05,0x3E,0xC0,0x55,0x0D,0xC0,0x55,0xA9,0x81,0x39,0xC0,0x5C,0x36,0x05,0x69,0x80,0x05,0x3E,0x84,0x05,0x81,0x3E,0x80,0x05,
+    0x82,0x3E,0x80,0x05,0x80,0x3E,0x05,0x80,0x3E,0x05,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x3E,0x84,0x05,0x81,0x3E,0x80,
+    0x05,0x82,0x3E,0x80,0x05,0x80,0x3E,0x05,0x80,0x3E,0x05,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x3E,0x84,0x05,0x81,0x3E,
+    0x80,0x05,0x82,0x3E,0x80,0x05,0x80,0x3E,0x05,0x80,0x3E,0x05,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x80,0x05,0x3E,0x87,0x05,0x3E,
+    0x81,0x7B,0x05,0x3E,0x82,0x05,0x3E,0x7A,0x05,0x3E,0x05,0x3E,0x81,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,0x82,0x05,
+    0x3E,0x81,0x08,0x05,0x3E,0x82,0x05,0x3E,0x01,0x05,0x3E,0x05,0x3E,0x81,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,0x82,
+    0x05,0x3E,0x81,0x08,0x05,0x3E,0x82,0x05,0x3E,0x01,0x05,0x3E,0x05,0x3E,0x81,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,
+    0x82,0x05,0x3E,0x81,0x08,0xC0,0x64,0xB3,0x39,0x6E,0x81,0x39,0xC0,0x63,0xFA,0x01,0x05,0x69,0x05,0x3E,0x81,0x05,0x3E,0x05,
+    0x3E,0x01,0x80,0x05,0x81,0x3E,0x82,0x05,0x3E,0x81,0xC0,0x24,0x1A,0x1E,0x23,0x1E,0x80,0xC0,0x14,0x39,0x3E,0x1A,0x23,0x82,
+    0xC0,0x34,0x1A,0x3E,0x80,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,0x82,0x05,0x3E,0x81,0x08,0x05,0x3E,0x82,0x05,0x3E,
+    0x01,0x05,0x3E,0x05,0x3E,0x81,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,0x82,0x05,0x3E,0x81,0x08,0x05,0x3E,0x82,0x05,
+    0x3E,0x01,0x5C,0xC0,0x55,0x0E,0x00,0x02,0xC0,0x5C,0x74,0x3E,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,0x82,0x05,0x3E,
+    0x81,0x7B,0x05,0x3E,0x82,0x05,0x3E,0x01,0x05,0x3E,0x05,0x3E,0x81,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,0x82,0x05,
+    0x3E,0x81,0x08,0x05,0x3E,0x82,0x05,0x3E,0x01,0x05,0x3E,0x05,0x3E,0x81,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,0x82,
+    0x05,0x3E,0x81,0x08,0x05,0x3E,0x82,0x05,0x3E,0x01,0x05,0x3E,0x05,0x3E,0x81,0x05,0x3E,0x05,0x3E,0x01,0x80,0x05,0x81,0x3E,
+    0x05,0x80,0x08,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x05,0x80,0x3E,0x08,0x05,0x08,0x3E,0x80,0x05,0x08,0x05,0x3E,0x05,0x08,
+    0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,0x3E,0x05,0x80,0x08,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x05,0x80,0x3E,0x08,0x05,0x08,
+    0x3E,0x80,0x05,0x08,0x05,0x3E,0x05,0x08,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,0x3E,0x05,0x80,0x08,0x05,0x3E,0x05,0x80,0x3E,
+    0x80,0x08,0x05,0x80,0x3E,0x08,0x05,0x08,0x3E,0x80,0x05,0x08,0x05,0x3E,0x05,0x08,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,0x3E,
+    0x05,0x80,0x08,0x05,0x3E,0x05,0x80,0x3E,0xC0,0x64,0xB3,0x39,0x6E,0x81,0x39,0xC0,0x6B,0xFA,0x08,0x59,0x80,0x05,0x08,0x05,
+    0x3E,0x05,0x08,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,0x3E,0x05,0x80,0x08,0x05,0x3E,0x05,0x3E,0xC0,0x0C,0x59,0x23,0x1E,0x80,
+    0x23,0xC0,0x3B,0xFA,0x08,0x2D,0x23,0x80,0x1E,0x23,0xC0,0x1C,0x39,0x05,0x3E,0x05,0x08,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,
+    0x3E,0x05,0x80,0x08,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x05,0x80,0x3E,0x08,0x05,0x08,0x3E,0x80,0x05,0x08,0x05,0x3E,0x05,
+    0x08,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,0x3E,0x05,0x80,0x08,0x3E,0xC0,0x53,0xBC,0x2D,0x25,0x80,0x2A,0xC0,0x4B,0xBC,0x3E,
+    0x05,0x3E,0x08,0x05,0x08,0x3E,0x80,0x3A,0x3C,0x05,0x3E,0x05,0x08,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,0x3E,0x05,0x80,0x08,
+    0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x05,0x80,0x3E,0x08,0x05,0x08,0x3E,0x80,0x05,0x08,0x05,0x3E,0x05,0x08,0x3E,0x05,0x3E,
+    0x80,0x05,0x3E,0x05,0x3E,0x05,0x80,0x08,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x05,0x80,0x3E,0x08,0x05,0x08,0x3E,0x80,0x05,
+    0x08,0x05,0x3E,0x05,0x08,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,0x3E,0x05,0x80,0x08,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x05,
+    0x80,0x3E,0x08,0x05,0x08,0x3E,0x80,0x05,0x08,0x05,0x3E,0x05,0x08,0x3E,0x05,0x3E,0x80,0x05,0x3E,0x05,0x3E,0x01,0x05,0x80,
+    0x3E,0x08,0x80,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x80,0x3E,0x05,0x3E,0x81,0x08,0x3E,0x05,0x80,0x3E,0x80,0x01,0x05,0x80,
+    0x01,0x3E,0x01,0x05,0x01,0x05,0x80,0x3E,0x08,0x80,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x80,0x3E,0x05,0x3E,0x81,0x08,0x3E,
+    0x05,0x80,0x3E,0x80,0x01,0x05,0x80,0x01,0x3E,0x01,0x05,0x01,0x05,0x80,0x3E,0x08,0x80,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,
+    0x80,0x3E,0x05,0x3E,0x81,0x08,0x3E,0x05,0x80,0x3E,0x80,0x01,0x05,0x80,0x01,0x3E,0x01,0x05,0x01,0x05,0x80,0x3E,0x08,0x80,
+    0x05,0x3E,0x22,0x39,0x6E,0x81,0x39,0x38,0x05,0x69,0x81,0x08,0x3E,0x05,0x80,0x3E,0x80,0x01,0x05,0x80,0x01,0x3E,0x01,0x05,
+    0x01,0x05,0x80,0x3E,0x08,0x80,0x36,0x1E,0x23,0x1E,0x23,0x1E,0x36,0x08,0xC0,0x5B,0x9C,0x1E,0x23,0x1E,0x23,0x1E,0x3B,0x05,
+    0x80,0x3E,0x80,0x01,0x05,0x80,0x01,0x3E,0x01,0x05,0x01,0x05,0x80,0x3E,0x08,0x80,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x80,
+    0x3E,0x05,0x3E,0x81,0x08,0x3E,0x05,0x80,0x3E,0x80,0x01,0x05,0x80,0x01,0x3E,0x01,0x05,0x01,0x3E,0x2D,0x1C,0x1E,0x23,0x1E,
+    0x23,0x81,0x1E,0xC0,0x24,0x1A,0x36,0x08,0x3E,0x05,0x3E,0x81,0x08,0x3E,0x05,0x80,0x3E,0x80,0x01,0x05,0x80,0x01,0x3E,0x01,
+    0x05,0x01,0x05,0x80,0x3E,0x08,0x80,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x80,0x3E,0x05,0x3E,0x81,0x08,0x3E,0x05,0x80,0x3E,
+    0x80,0x01,0x05,0x80,0x01,0x3E,0x01,0x05,0x01,0x05,0x80,0x3E,0x08,0x80,0x05,0x3E,0x05,0x80,0x3E,0x80,0x08,0x80,0x3E,0x05,
+    0x3E,0x81,0x08,0x3E,0x05,0x80,0x3E,0x80,0x01,0x05,0x80,0x01,0x3E,0x01,0x05,0x01,0x05,0x80,0x3E,0x08,0x80,0x05,0x3E,0x05,
+    0x80,0x3E,0x80,0x08,0x80,0x3E,0x05,0x3E,0x81,0x08,0x3E,0x05,0x80,0x3E,0x80,0x01,0x05,0x80,0x01,0x3E,0x01,0x05,0x3E,0x80,
+    0x01,0x05,0x01,0x3E,0x80,0x05,0x76,0x01,0x08,0x3E,0x05,0x3E,0x05,0x80,0x01,0x80,0x05,0x01,0x08,0x01,0x05,0x08,0x05,0x3E,
+    0x01,0x3E,0x08,0x81,0x3E,0x81,0x01,0x05,0x01,0x3E,0x80,0x05,0x03,0x01,0x08,0x3E,0x05,0x3E,0x05,0x80,0x01,0x80,0x05,0x01,
+    0x08,0x01,0x05,0x08,0x05,0x3E,0x01,0x3E,0x08,0x81,0x3E,0x81,0x01,0x05,0x01,0x3E,0x80,0x05,0x03,0x01,0x08,0x3E,0x05,0x3E,
+    0x05,0x80,0x01,0x80,0x05,0x01,0x08,0x01,0x05,0x08,0x05,0x3E,0x01,0x3E,0x08,0x81,0x3E,0x81,0x01,0x05,0x01,0x3E,0x80,0x05,
+    0xC0,0x64,0xB3,0x39,0x6E,0x81,0x39,0x38,0x05,0x01,0x80,0x05,0x01,0x08,0x01,0x05,0x08,0x05,0x69,0x01,0x3E,0x08,0x81,0x3E,
+    0x81,0x01,0x05,0x01,0x3E,0xC0,0x3B,0xDA,0x23,0x80,0x1E,0x80,0x1C,0x3E,0x81,0x19,0x23,0x1E,0x23,0x80,0xC0,0x4B,0xBB,0x01,
+    0x05,0x08,0x05,0x3E,0x01,0x3E,0x08,0x81,0x3E,0x81,0x01,0x05,0x01,0x3E,0x80,0x05,0x03,0x01,0x08,0x3E,0x05,0x3E,0x05,0x80,
+    0x01,0x80,0x05,0x01,0x08,0x01,0x05,0x08,0x05,0x3E,0x01,0x3E,0x08,0x81,0x3E,0x80,0x24,0x23,0x81,0x1E,0x80,0x23,0x83,0x1E,
+    0x2E,0x05,0x80,0x01,0x80,0x05,0x01,0x08,0x01,0x05,0x08,0x05,0x3E,0x01,0x3E,0x08,0x81,0x3E,0x81,0x01,0x05,0x01,0x3E,0x80,
+    0x05,0x03,0x01,0x08,0x3E,0x05,0x3E,0x05,0x80,0x01,0x80,0x05,0x01,0x08,0x01,0x05,0x08,0x05,0x3E,0x01,0x3E,0x08,0x81,0x3E,
+    0x81,0x01,0x05,0x01,0x3E,0x80,0x05,0x03,0x01,0x08,0x3E,0x05,0x3E,0x05,0x80,0x01,0x80,0x05,0x01,0x08,0x01,0x05,0x08,0x05,
+    0x3E,0x01,0x3E,0x08,0x81,0x3E,0x81,0x01,0x05,0x01,0x3E,0x80,0x05,0x03,0x01,0x08,0x3E,0x05,0x3E,0x05,0x80,0x01,0x80,0x05,
+    0x01,0x08,0x01,0x05,0x08,0x05,0x3E,0x01,0x3E,0x08,0x81,0x3E,0x08,0x03,0x01,0x05,0x80,0x66,0x08,0x80,0x05,0x80,0x08,0x80,
+    0x3E,0x01,0x08,0x3E,0x08,0x80,0x05,0x80,0x3E,0x05,0x65,0x3E,0x08,0x80,0x05,0x08,0x05,0x80,0x3E,0x08,0x80,0x03,0x01,0x05,
+    0x80,0x00,0x08,0x80,0x05,0x80,0x08,0x80,0x3E,0x01,0x08,0x3E,0x08,0x80,0x05,0x80,0x3E,0x05,0x39,0x3E,0x08,0x80,0x05,0x08,
+    0x05,0x80,0x3E,0x08,0x80,0x03,0x01,0x05,0x80,0x00,0x08,0x80,0x05,0x80,0x08,0x80,0x3E,0x01,0x08,0x3E,0x08,0x80,0x05,0x80,
+    0x3E,0x05,0x39,0x3E,0x08,0x80,0x05,0x08,0x05,0x80,0x3E,0x08,0x80,0x03,0x01,0x05,0x80,0x00,0x08,0x80,0x22,0xC0,0x55,0xA9,
+    0x81,0x66,0x80,0xC0,0x6B,0xDA,0xC0,0x6B,0x9D,0x08,0x80,0x05,0x80,0x3E,0x05,0x65,0x3E,0x08,0x80,0x05,0x08,0x05,0x80,0x3E,
+    0x08,0x80,0x03,0x01,0x05,0x80,0x00,0x1A,0x23,0x82,0x25,0x3E,0x01,0x08,0x24,0x23,0x1E,0x23,0x80,0x25,0x05,0x39,0x3E,0x08,
+    0x80,0x05,0x08,0x05,0x80,0x3E,0x08,0x80,0x03,0x01,0x05,0x80,0x00,0x08,0x80,0x05,0x80,0x08,0x80,0x3E,0x01,0x08,0x3E,0x08,
+    0x80,0x05,0x80,0x3E,0x05,0x39,0x3E,0x08,0x80,0x05,0x08,0x05,0x80,0x3E,0x3B,0xC0,0x14,0x3A,0x23,0x80,0x1E,0x23,0x86,0x1E,
+    0x80,0xC0,0x43,0xFB,0x3E,0x08,0x80,0x05,0x80,0x3E,0x05,0x39,0x3E,0x08,0x80,0x05,0x08,0x05,0x80,0x3E,0x08,0x80,0x03,0x01,
+    0x05,0x80,0x00,0x08,0x80,0x05,0x80,0x08,0x80,0x3E,0x01,0x08,0x3E,0x08,0x80,0x05,0x80,0x3E,0x05,0x39,0x3E,0x08,0x80,0x05,
+    0x08,0x05,0x80,0x3E,0x08,0x80,0x03,0x01,0x05,0x80,0x00,0x08,0x80,0x05,0x80,0x08,0x80,0x3E,0x01,0x08,0x3E,0x08,0x80,0x05,
+    0x80,0x3E,0x05,0x39,0x3E,0x08,0x80,0x05,0x08,0x05,0x80,0x3E,0x08,0x80,0x03,0x01,0x05,0x80,0x00,0x08,0x80,0x05,0x80,0x08,
+    0x80,0x3E,0x01,0x08,0x3E,0x08,0x80,0x05,0x80,0x3E,0x05,0x39,0x3E,0x08,0x80,0x05,0x08,0x05,0x80,0x3E,0x08,0x00,0x08,0x81,
+    0x01,0x08,0x3E,0x80,0x01,0x08,0x00,0x05,0x80,0x08,0x81,0x39,0x01,0x05,0x03,0x08,0x05,0x08,0x05,0x08,0x03,0x3E,0x08,0x80,
+    0x01,0x05,0x01,0x00,0x08,0x81,0x01,0x08,0x3E,0x80,0x01,0x08,0x00,0x05,0x80,0x08,0x81,0x39,0x01,0x05,0x03,0x08,0x05,0x08,
+    0x05,0x08,0x03,0x3E,0x08,0x80,0x01,0x05,0x01,0x00,0x08,0x81,0x01,0x08,0x3E,0x80,0x01,0x08,0x00,0x05,0x80,0x08,0x81,0x39,
+    0x01,0x05,0x03,0x08,0x05,0x08,0x05,0x08,0x03,0x3E,0x08,0x80,0x01,0x05,0x01,0x00,0x08,0x81,0x01,0x08,0x3E,0x80,0x22,0xC0,
+    0x55,0x89,0x6E,0x80,0x39,0x80,0x38,0x08,0x55,0x01,0x05,0x03,0x08,0x05,0x08,0x05,0x08,0x03,0x5D,0x08,0x80,0x01,0x05,0x01,
+    0x00,0x08,0x81,0x01,0x3B,0x1E,0x23,0x80,0x1E,0x23,0x29,0x05,0x08,0x80,0xC0,0x3B,0xDB,0x23,0x82,0xC0,0x14,0x59,0x3E,0x08,
+    0x05,0x08,0x03,0x3E,0x08,0x80,0x01,0x05,0x01,0x00,0x08,0x81,0x01,0x08,0x3E,0x80,0x01,0x08,0x00,0x05,0x80,0x08,0x81,0x39,
+    0x01,0x05,0x03,0x08,0x05,0x08,0x05,0x08,0x03,0x3E,0x08,0x80,0x01,0x3E,0xC0,0x24,0x1A,0x23,0x8C,0x1E,0xC0,0x53,0xBC,0x39,
+    0x01,0x05,0x03,0x08,0x05,0x08,0x05,0x08,0x03,0x3E,0x08,0x80,0x01,0x05,0x01,0x00,0x08,0x81,0x01,0x08,0x3E,0x80,0x01,0x08,
+    0x00,0x05,0x80,0x08,0x81,0x39,0x01,0x05,0x03,0x08,0x05,0x08,0x05,0x08,0x03,0x3E,0x08,0x80,0x01,0x05,0x01,0x00,0x08,0x81,
+    0x01,0x08,0x3E,0x80,0x01,0x08,0x00,0x05,0x80,0x08,0x81,0x39,0x01,0x05,0x03,0x08,0x05,0x08,0x05,0x08,0x03,0x3E,0x08,0x80,
+    0x01,0x05,0x01,0x00,0x08,0x81,0x01,0x08,0x3E,0x80,0x01,0x08,0x00,0x05,0x80,0x08,0x81,0x39,0x01,0x05,0x03,0x08,0x05,0x08,
+    0x05,0x08,0x03,0x3E,0x08,0x80,0x01,0x05,0x01,0x3E,0x08,0x00,0x03,0x08,0x83,0x05,0x01,0x08,0x03,0x08,0x80,0x01,0x08,0x81,
+    0x03,0x01,0x03,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,0x01,0x08,0x3E,0x08,0x00,0x03,0x08,0x83,0x05,0x01,0x08,0x03,0x08,
+    0x80,0x01,0x08,0x81,0x03,0x01,0x03,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,0x01,0x08,0x3E,0x08,0x00,0x03,0x08,0x83,0x05,
+    0x01,0x08,0x03,0x08,0x80,0x01,0x08,0x81,0x03,0x01,0x03,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,0x01,0x08,0x3E,0x08,0x00,
+    0x03,0x08,0x82,0xC0,0x64,0xB3,0xC0,0x55,0x89,0x6E,0x80,0x39,0x80,0x38,0x01,0x08,0x81,0x03,0x01,0x03,0x08,0x80,0x03,0x05,
+    0x08,0x80,0x03,0x00,0x01,0x08,0x59,0x08,0x00,0x03,0x08,0xC0,0x4B,0xBC,0x23,0x82,0x1E,0x3E,0x03,0x08,0x80,0x36,0x1E,0x81,
+    0x23,0x1E,0x3B,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,0x01,0x08,0x3E,0x08,0x00,0x03,0x08,0x83,0x05,0x01,0x08,0x03,0x08,
+    0x80,0x01,0x08,0x81,0x03,0x01,0x03,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,0x2B,0x23,0x8B,0x1E,0x23,0x80,0x1A,0x3E,0x08,
+    0x80,0x03,0x01,0x03,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,0x01,0x08,0x3E,0x08,0x00,0x03,0x08,0x83,0x05,0x01,0x08,0x03,
+    0x08,0x80,0x01,0x08,0x81,0x03,0x01,0x03,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,0x01,0x08,0x3E,0x08,0x00,0x03,0x08,0x83,
+    0x05,0x01,0x08,0x03,0x08,0x80,0x01,0x08,0x81,0x03,0x01,0x03,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,0x01,0x08,0x3E,0x08,
+    0x00,0x03,0x08,0x83,0x05,0x01,0x08,0x03,0x08,0x80,0x01,0x08,0x81,0x03,0x01,0x03,0x08,0x80,0x03,0x05,0x08,0x80,0x03,0x00,
+    0x01,0x08,0x03,0x08,0x03,0x08,0x03,0x00,0x08,0x81,0x65,0x03,0x80,0x00,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x80,0x05,0x08,
+    0x80,0x3E,0x03,0x3C,0x05,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x00,0x08,0x81,0x3C,0x03,0x80,0x00,0x08,0x03,0x08,0x03,
+    0x08,0x03,0x08,0x80,0x05,0x08,0x80,0x3E,0x03,0x3C,0x05,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x00,0x08,0x81,0x3C,0x03,
+    0x80,0x00,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x80,0x05,0x08,0x80,0x3E,0x03,0x3C,0x05,0x08,0x80,0x03,0x81,0x08,0x03,0x08,
+    0x03,0x00,0x08,0x80,0x22,0x39,0x6E,0x39,0x81,0xC0,0x6B,0xDA,0x08,0x03,0x08,0x03,0x08,0x80,0x05,0x08,0x80,0x59,0x03,0x3C,
+    0x05,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x80,0xC0,0x24,0x1A,0x23,0x1E,0x23,0x80,0x24,0x03,0x00,0x08,0x03,0x3E,0x1F,0x1E,
+    0x80,0x23,0x80,0x2B,0x08,0x80,0x3E,0x03,0x3C,0x05,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x00,0x08,0x81,0x3C,0x03,0x80,
+    0x00,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x80,0x05,0x08,0x80,0x3E,0x03,0x3C,0x05,0x08,0x3B,0x19,0x23,0x85,0x1E,0x23,0x86,
+    0x1E,0x30,0x08,0x03,0x08,0x80,0x05,0x08,0x80,0x3E,0x03,0x3C,0x05,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x00,0x08,0x81,
+    0x3C,0x03,0x80,0x00,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x80,0x05,0x08,0x80,0x3E,0x03,0x3C,0x05,0x08,0x80,0x03,0x81,0x08,
+    0x03,0x08,0x03,0x00,0x08,0x81,0x3C,0x03,0x80,0x00,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x80,0x05,0x08,0x80,0x3E,0x03,0x3C,
+    0x05,0x08,0x80,0x03,0x81,0x08,0x03,0x08,0x03,0x00,0x08,0x81,0x3C,0x03,0x80,0x00,0x08,0x03,0x08,0x03,0x08,0x03,0x08,0x80,
+    0x05,0x08,0x80,0x3E,0x03,0x3C,0x05,0x08,0x80,0x03,0x80,0x00,0x08,0x81,0x03,0x80,0x3C,0x80,0x03,0x08,0x03,0x81,0x08,0x00,
+    0x08,0x03,0x87,0x08,0x03,0x80,0x08,0x01,0x08,0x03,0x00,0x08,0x81,0x03,0x80,0x3C,0x80,0x03,0x08,0x03,0x81,0x08,0x00,0x08,
+    0x03,0x87,0x08,0x03,0x80,0x08,0x01,0x08,0x03,0x00,0x08,0x81,0x03,0x80,0x3C,0x80,0x03,0x08,0x03,0x81,0x08,0x00,0x08,0x03,
+    0x87,0x08,0x03,0x80,0x08,0x01,0x08,0x03,0x00,0x08,0x81,0x03,0x80,0x3C,0x80,0xC0,0x64,0xB3,0x39,0x6E,0x80,0x39,0x80,0x33,
+    0x08,0x03,0x87,0x08,0x03,0x80,0x08,0x01,0x08,0x03,0x00,0x08,0x81,0x59,0x1C,0x1E,0x23,0x81,0x2D,0x03,0x80,0x08,0x00,0x08,
+    0x25,0x1E,0x81,0x23,0xC0,0x24,0x1A,0x03,0x81,0x08,0x03,0x80,0x08,0x01,0x08,0x03,0x00,0x08,0x81,0x03,0x80,0x3C,0x80,0x03,
+    0x08,0x03,0x81,0x08,0x00,0x08,0x03,0x87,0x08,0x03,0x80,0x08,0x30,0x23,0x90,0x24,0x03,0x86,0x08,0x03,0x80,0x08,0x01,0x08,
+    0x03,0x00,0x08,0x81,0x03,0x80,0x3C,0x80,0x03,0x08,0x03,0x81,0x08,0x00,0x08,0x03,0x87,0x08,0x03,0x80,0x08,0x01,0x08,0x03,
+    0x00,0x08,0x81,0x03,0x80,0x3C,0x80,0x03,0x08,0x03,0x81,0x08,0x00,0x08,0x03,0x87,0x08,0x03,0x80,0x08,0x01,0x08,0x03,0x00,
+    0x08,0x81,0x03,0x80,0x3C,0x80,0x03,0x08,0x03,0x81,0x08,0x00,0x08,0x03,0x87,0x08,0x03,0x80,0x08,0x01,0x08,0x03,0x01,0x03,
+    0x84,0x08,0x03,0x81,0x01,0x03,0x87,0x01,0x03,0x86,0x08,0x03,0x01,0x03,0x84,0x08,0x03,0x81,0x01,0x03,0x87,0x01,0x03,0x86,
+    0x08,0x03,0x01,0x03,0x84,0x08,0x03,0x81,0x01,0x03,0x87,0x01,0x03,0x86,0x08,0x03,0x01,0x03,0x84,0x08,0xC0,0x64,0xB3,0x39,
+    0x6E,0x81,0x39,0x33,0x03,0x84,0x01,0x03,0x86,0x08,0x03,0x01,0x03,0x81,0x36,0x1E,0x23,0x81,0x1E,0xC0,0x53,0x9C,0x01,0x03,
+    0x82,0xC0,0x43,0xBB,0x23,0x82,0x19,0x03,0x86,0x08,0x03,0x01,0x03,0x84,0x08,0x03,0x81,0x01,0x03,0x87,0x01,0x03,0x85,0xC0,
+    0x34,0x1A,0x23,0x88,0x1E,0x80,0x23,0x1E,0x23,0x82,0x19,0x08,0x03,0x81,0x01,0x03,0x86,0x08,0x03,0x01,0x03,0x84,0x08,0x03,
+    0x81,0x01,0x03,0x87,0x01,0x03,0x86,0x08,0x03,0x01,0x03,0x84,0x08,0x03,0x81,0x01,0x03,0x87,0x01,0x03,0x86,0x08,0x03,0x01,
+    0x03,0x84,0x08,0x03,0x81,0x01,0x03,0x87,0x01,0x03,0x86,0x08,0x03,0x8D,0x3C,0x08,0x03,0x84,0x08,0x03,0x84,0x3C,0x03,0x8E,
+    0x3C,0x08,0x03,0x84,0x08,0x03,0x84,0x3C,0x03,0x8E,0x3C,0x08,0x03,0x84,0x08,0x03,0x84,0x3C,0x03,0x88,0x22,0x39,0x80,0x3E,
+    0x80,0x39,0xC0,0x55,0x4B,0x3F,0x84,0x06,0x80,0xC0,0x5D,0x0F,0x63,0xC0,0x5C,0x55,0x01,0x03,0x80,0x3C,0x03,0x84,0xC0,0x3B,
+    0xDB,0x23,0x82,0x1A,0xC0,0x6B,0x9D,0x03,0x81,0x3C,0x08,0x3E,0xC0,0x04,0x78,0x23,0x82,0x3B,0x03,0x84,0x3C,0x03,0x83,0x59,
+    0x2D,0x27,0x24,0x27,0x24,0x80,0x27,0x24,0x86,0x21,0x80,0x1A,0x83,0x5A,0x81,0xC0,0x04,0x79,0x23,0x89,0x1E,0x23,0x84,0x1E,
+    0xC0,0x63,0x7D,0x03,0x82,0x08,0x03,0x84,0x3C,0x03,0x8E,0x3C,0x08,0x03,0x84,0x08,0x03,0x84,0x3C,0x03,0x8E,0x3C,0x08,0x03,
+    0x84,0x08,0x03,0x84,0x3C,0x03,0x8E,0x3C,0x08,0x03,0x84,0x08,0x03,0x84,0x3C,0x03,0x89,0x3C,0x03,0x88,0x3C,0x03,0x92,0x3C,
+    0x03,0x88,0x3C,0x03,0x92,0x3C,0x03,0x88,0x3C,0x03,0x91,0x22,0xC0,0x55,0x89,0x80,0x6E,0x39,0x80,0x3E,0x39,0x3E,0x83,0x39,
+    0x83,0xC0,0x5C,0x92,0x03,0x87,0x1A,0x23,0x81,0x1E,0xC0,0x33,0xFA,0x03,0x85,0x1D,0xC0,0x04,0x99,0x82,0x2B,0x03,0x89,0x5D,
+    0x25,0x23,0xAB,0xC0,0x5B,0x7C,0x03,0x80,0x3C,0x03,0x92,0x3C,0x03,0x88,0x3C,0x03,0x92,0x3C,0x03,0x88,0x3C,0x03,0x92,0x3C,
+    0x03,0x88,0x3C,0x03,0xBF,0xB1,0x22,0x39,0x6E,0x80,0x39,0x3E,0x80,0x39,0x80,0x3E,0x87,0x63,0x35,0x03,0x85,0x4D,0x1E,0x23,
+    0x82,0x30,0x03,0x85,0xC0,0x33,0xFA,0xC0,0x04,0x99,0x82,0xC0,0x24,0x1A,0x00,0x03,0x88,0xC0,0x43,0xDC,0x1E,0x23,0xAA,0x1E,
+    0xC0,0x6B,0x9D,0x03,0xBF,0xBF,0xBF,0x94,0xC0,0x64,0xB3,0xC0,0x55,0xA9,0x80,0x39,0x80,0x3E,0x84,0x39,0x3E,0x81,0x39,0x3E,
+    0x81,0x13,0x03,0x85,0x29,0x1E,0x23,0x81,0x19,0x3B,0x03,0x85,0xC0,0x4B,0xDB,0x1E,0x23,0x81,0x1C,0xC0,0x6B,0x9D,0x03,0x87,
+    0x59,0x1A,0x23,0xAB,0x19,0x08,0x03,0xBF,0xBF,0xBF,0x94,0x22,0xC0,0x55,0x89,0x80,0x6E,0x80,0x39,0x3E,0x82,0x39,0x82,0x3E,
+    0x39,0x3E,0x81,0x63,0x35,0x03,0x84,0x25,0x1E,0x23,0x81,0x25,0x00,0x03,0x85,0x4D,0x1C,0x23,0x81,0x1E,0xC0,0x5B,0xBC,0x03,
+    0x87,0x28,0x1E,0x23,0xAB,0xC0,0x24,0x1A,0x03,0xBF,0xBF,0xBF,0x95,0xC0,0x64,0xB3,0x39,0x80,0x3E,0x39,0x80,0x04,0x3F,0x85,
+    0x04,0x39,0x80,0x3E,0x81,0x13,0x03,0x83,0x3B,0x1C,0x23,0x82,0x2B,0x03,0x87,0x27,0x23,0x82,0x2B,0x03,0x86,0x59,0x19,0x23,
+    0x81,0x1E,0x80,0x1A,0x80,0x17,0x81,0x1A,0x81,0x17,0x1A,0x88,0x17,0x82,0x19,0x23,0x8E,0x1E,0xC0,0x53,0x9C,0x03,0xBF,0xBF,
+    0xBF,0x95,0x22,0xC0,0x55,0x89,0x80,0x3E,0x39,0x80,0x33,0x03,0x85,0x5C,0x04,0x3E,0x82,0x63,0xC0,0x6B,0x9D,0x03,0x82,0xC0,
+    0x53,0xBC,0x1E,0x23,0x81,0x1E,0xC0,0x5B,0x9D,0x03,0x87,0x2D,0x23,0x82,0xC0,0x1C,0x19,0x03,0x86,0xC0,0x33,0xDB,0x23,0x83,
+    0xC0,0x2C,0x1A,0x03,0x95,0x2E,0x1E,0x23,0x8D,0xC0,0x1C,0x1A,0x00,0x03,0xBF,0xBF,0xBF,0x95,0x22,0x39,0x6E,0x80,0x39,0x80,
+    0xC0,0x6B,0xDA,0x03,0x86,0xC0,0x5C,0x73,0x3E,0x83,0xC0,0x5C,0x54,0x03,0x82,0x2D,0x23,0x82,0xC0,0x0C,0x39,0x03,0x88,0xC0,
+    0x53,0xBC,0x1E,0x23,0x81,0x19,0xC0,0x6B,0x7D,0x03,0x84,0x5D,0x1C,0x23,0x82,0x1E,0xC0,0x63,0x9D,0x03,0x96,0xC0,0x33,0xDB,
+    0x23,0x8B,0x1E,0x80,0x3B,0x03,0xBF,0xBF,0xBF,0x96,0xC0,0x64,0x93,0xC0,0x55,0x89,0x6E,0x39,0x81,0xC0,0x6B,0xDA,0x03,0x86,
+    0x01,0x3D,0x39,0x3E,0x81,0x02,0x37,0x03,0x80,0x00,0xC0,0x1C,0x39,0x23,0x82,0x2D,0x03,0x88,0x3B,0x1C,0x1E,0x23,0x81,0xC0,
+    0x53,0xBC,0x03,0x84,0xC0,0x2B,0xFA,0x23,0x82,0x1E,0x28,0x03,0x97,0x59,0x20,0x23,0x8A,0x1C,0x2E,0x03,0xBF,0xBF,0xBF,0x97,
+    0xC0,0x64,0x93,0xC0,0x55,0x89,0x3E,0x81,0x39,0xC0,0x6B,0xDA,0x03,0x87,0x15,0x39,0x3E,0x82,0xC0,0x64,0x36,0x03,0x80,0x31,
+    0x1E,0x6E,0x81,0x1E,0x2E,0x03,0x88,0x3C,0xC0,0x24,0x1A,0x23,0x82,0x2D,0x03,0x83,0x49,0x1E,0x23,0x82,0x1C,0xC0,0x6B,0x7D,
+    0x03,0x98,0x39,0x28,0x1E,0x23,0x87,0x1A,0x31,0x03,0xBF,0xBF,0xBF,0x98,0x1D,0xC0,0x55,0x89,0x3E,0x81,0x39,0x33,0x03,0x87,
+    0xC0,0x6B,0x9B,0x04,0x3E,0x82,0x3D,0xC0,0x6B,0x9D,0x03,0x2B,0x1E,0x23,0x81,0x1C,0xC0,0x6B,0x7D,0x03,0x89,0x2B,0x23,0x82,
+    0x24,0x00,0x03,0x81,0x00,0x20,0x23,0x83,0x28,0x03,0x9B,0x31,0xC0,0x2C,0x1A,0x1C,0x1E,0x23,0x81,0x65,0x24,0x2B,0x39,0x03,
+    0xBF,0xBF,0xBF,0x99,0x1D,0xC0,0x55,0x89,0x6E,0x81,0x39,0x33,0x03,0x88,0x15,0x3E,0x82,0x39,0xC0,0x64,0x36,0x03,0x27,0xC0,
+    0x04,0x99,0x82,0xC0,0x23,0xFA,0x03,0x8A,0x2E,0x23,0x82,0x19,0x3B,0x03,0x81,0x31,0x1E,0x23,0x82,0x1C,0xC0,0x6B,0x7D,0x03,
+    0x9D,0x3B,0x2E,0x5E,0x6E,0x76,0x38,0x39,0x03,0xBF,0xBF,0xBF,0x9B,0xC0,0x64,0x93,0xC0,0x55,0x89,0x3E,0x81,0x39,0xC0,0x6B,
+    0xDA,0x03,0x88,0xC0,0x6B,0xBA,0x3D,0x3E,0x81,0x39,0xC0,0x5D,0x0E,0xC0,0x6B,0x9D,0x19,0x23,0x82,0x30,0x03,0x8A,0x59,0xC0,
+    0x04,0x58,0x23,0x81,0x1E,0x30,0x03,0x81,0xC0,0x23,0xFA,0x23,0x80,0x1E,0x81,0x2B,0x03,0xBF,0xBF,0xB0,0x66,0x03,0x9D,0x3E,
+    0x03,0x9D,0x3E,0x03,0x8F,0xC0,0x64,0x93,0xC0,0x55,0x89,0x6E,0x81,0x39,0x33,0x03,0x85,0x66,0x03,0x81,0x15,0xC0,0x55,0xA9,
+    0x83,0xC0,0x44,0x56,0x1E,0x23,0x81,0x1E,0xC0,0x6B,0x7D,0x03,0x8B,0x22,0x23,0x82,0x20,0x03,0x80,0x31,0x1E,0x23,0x1E,0x23,
+    0x1E,0xC0,0x1C,0x39,0x39,0x03,0x90,0x66,0x03,0x9D,0x3E,0x03,0x9D,0x3E,0x03,0x9D,0x3E,0x03,0x9D,0x3E,0x03,0x89,0x3E,0x03,
+    0x96,0x3E,0x03,0x84,0x3E,0x03,0x96,0x3E,0x03,0x84,0x3E,0x03,0x96,0x3E,0x03,0x84,0x3E,0x03,0x83,0xC0,0x64,0x93,0xC0,0x55,
+    0x89,0x6E,0x81,0x39,0x33,0x03,0x89,0xC0,0x6B,0x9B,0xC0,0x4D,0x89,0x3E,0x82,0xC0,0x1C,0xD4,0x1E,0x23,0x81,0x1A,0x03,0x8C,
+    0x2B,0x23,0x1E,0x23,0x80,0xC0,0x04,0x39,0x03,0x80,0x22,0x23,0x82,0x1E,0x29,0x03,0x96,0x66,0x03,0x84,0x3E,0x03,0x96,0x3E,
+    0x03,0x84,0x3E,0x03,0x96,0x3E,0x03,0x84,0x3E,0x03,0x96,0x3E,0x03,0x84,0x3E,0x03,0x96,0x3E,0x03,0x87,0x3E,0x03,0x81,0x3E,
+    0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x8B,0x3E,0x03,0x85,0x3E,0x03,0x81,0x3E,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x8B,0x3E,
+    0x03,0x85,0x3E,0x03,0x81,0x3E,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x8B,0x3E,0x03,0x85,0x3E,0x03,0x80,0x1D,0x39,0x6E,0x80,
+    0x39,0x80,0x33,0xC0,0x73,0x5E,0x03,0x89,0x15,0x39,0x6E,0x80,0xC0,0x4D,0x8B,0xC0,0x0C,0x97,0x23,0x81,0x1E,0x28,0x03,0x81,
+    0x66,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x82,0x31,0x1E,0x23,0x82,0x31,0x5E,0x1E,0x23,0x1E,0x23,0x80,0x24,0xC0,0x6B,0x7D,
+    0x03,0x80,0x3E,0x03,0x81,0x3E,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x8B,0x3E,0x03,0x85,0x3E,0x03,0x81,0x3E,0x03,0x80,0x3E,
+    0x03,0x80,0x3E,0x03,0x8B,0x3E,0x03,0x85,0x3E,0x03,0x81,0x3E,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x8B,0x3E,0x03,0x85,0x3E,
+    0x03,0x81,0x3E,0x03,0x80,0x3E,0x03,0x80,0x3E,0x03,0x8B,0x3E,0x03,0x85,0x3E,0x03,0x81,0x3E,0x03,0x80,0x3E,0x03,0x80,0x3E,
+    0x03,0x8B,0x3E,0x03,0x83,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x80,0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x81,0x3E,
+    0x03,0x3E,0x03,0x81,0x3E,0x80,0x03,0x82,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x80,0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,
+    0x03,0x81,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x80,0x03,0x82,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x80,0x3E,0x80,0x03,0x81,0x3E,0x03,
+    0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x80,0x03,0x82,0x3E,0x03,0x3E,0x03,0x3E,0x1D,0xC0,0x55,0x89,0x6E,
+    0x81,0x39,0xC0,0x6B,0xDA,0xC0,0x73,0x5E,0x03,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x03,0xC0,0x6B,0xBB,0xC0,0x55,0x6A,
+    0xC0,0x55,0xA9,0x80,0xC0,0x35,0x2F,0x1E,0x23,0x81,0x1E,0xC0,0x63,0x9D,0x03,0x66,0x03,0x80,0x3E,0x80,0x03,0x81,0x3E,0x03,
+    0x3E,0x03,0x3E,0x5D,0xC0,0x0C,0x59,0x23,0x82,0x2B,0x27,0x23,0x83,0xC0,0x4B,0xBC,0x03,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x80,
+    0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x80,0x03,0x82,0x3E,0x03,0x3E,0x03,
+    0x3E,0x03,0x80,0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x80,0x03,0x82,0x3E,
+    0x03,0x3E,0x03,0x3E,0x03,0x80,0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x80,
+    0x03,0x82,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x80,0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x81,0x3E,0x03,0x3E,0x03,
+    0x81,0x3E,0x80,0x03,0x82,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x80,0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x03,0x81,0x3E,
+    0x03,0x3E,0x03,0x81,0x3E,0x80,0x03,0x80,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x81,0x3E,0x80,0x03,0x85,0x3E,0x80,0x03,
+    0x81,0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x81,0x3E,0x80,0x03,0x85,0x3E,0x80,0x03,0x81,
+    0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x81,0x3E,0x80,0x03,0x85,0x3E,0x80,0x03,0x81,0x3E,
+    0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x80,0x1D,0xC0,0x55,0x89,0x6E,0x81,0x39,0x33,0x03,0x84,0x66,0x80,
+    0x03,0x81,0x3E,0x80,0xC0,0x5C,0x92,0xC0,0x55,0xA9,0x39,0xC0,0x24,0xD3,0x23,0x82,0xC0,0x14,0x59,0x03,0x66,0x81,0x03,0x81,
+    0x3E,0x80,0x03,0x85,0xC0,0x23,0xFA,0x23,0x82,0x76,0x23,0x82,0x1E,0xC0,0x1C,0x19,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,
+    0x81,0x3E,0x80,0x03,0x85,0x3E,0x80,0x03,0x81,0x3E,0x80,0x03,0x81,0x3E,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x80,0x33,0xC0,
+    0x64,0x74,0xC0,0x5C,0xEF,0x3F,0x6E,0x3F,0xC0,0x5C,0xD0,0xC0,0x64,0x35,0x37,0x03,0x82,0x3E,0x80,0x03,0x81,0x3E,0x80,0x03,
+    0x81,0x3E,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x81,0x3E,0x80,0x03,0x85,0x3E,0x80,0x03,0x81,0x3E,0x80,0x03,0x81,
+    0x3E,0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x81,0x3E,0x80,0x03,0x85,0x3E,0x80,0x03,0x81,0x3E,0x80,0x03,0x81,0x3E,
+    0x03,0x3E,0x03,0x3E,0x80,0x03,0x3E,0x81,0x03,0x81,0x3E,0x80,0x03,0x85,0x3E,0x80,0x03,0x81,0x3E,0x80,0x03,0x81,0x3E,0x80,
+    0x03,0x80,0x3E,0x82,0x03,0x3E,0x83,0x03,0x3E,0x81,0x03,0x3E,0x03,0x3E,0x88,0x03,0x3E,0x80,0x03,0x80,0x3E,0x82,0x03,0x3E,
+    0x83,0x03,0x3E,0x81,0x03,0x3E,0x03,0x3E,0x88,0x03,0x3E,0x80,0x03,0x80,0x3E,0x82,0x03,0x3E,0x83,0x03,0x3E,0x81,0x03,0x3E,
+    0x03,0x3E,0x88,0x03,0x3E,0x80,0x03,0x80,0x3E,0x82,0x03,0xC0,0x64,0x93,0x39,0x6E,0x81,0x39,0x2E,0xC0,0x73,0x5E,0x80,0x03,
+    0x3E,0x03,0x3E,0x86,0xC0,0x6B,0x9B,0x39,0x6E,0xC0,0x0C,0x97,0x23,0x82,0x20,0xC0,0x73,0x5E,0x80,0x03,0x3E,0x83,0x03,0x3E,
+    0x81,0x03,0x3E,0x03,0x3E,0x26,0x23,0x87,0x1E,0xC0,0x53,0xBC,0x03,0x80,0x3E,0x82,0x03,0x3E,0x83,0x03,0x3E,0x81,0x03,0x3E,
+    0x03,0x3E,0x88,0x03,0x3E,0x80,0x03,0x80,0x3E,0x81,0x3C,0x13,0x02,0xC0,0x55,0xA9,0x84,0x39,0x06,0xC0,0x63,0xD8,0xC0,0x73,
+    0x5E,0x03,0x3E,0x88,0x03,0x3E,0x80,0x03,0x80,0x3E,0x82,0x03,0x3E,0x83,0x03,0x3E,0x81,0x03,0x3E,0x03,0x3E,0x88,0x03,0x3E,
+    0x80,0x03,0x80,0x3E,0x82,0x03,0x3E,0x83,0x03,0x3E,0x81,0x03,0x3E,0x03,0x3E,0x88,0x03,0x3E,0x80,0x03,0x80,0x3E,0x82,0x03,
+    0x3E,0x83,0x03,0x3E,0x81,0x03,0x3E,0x03,0x3E,0x88,0x03,0x3E,0x83,0x03,0x3E,0x83,0x03,0x3E,0x84,0x03,0x3E,0x87,0x03,0x3E,
+    0x86,0x03,0x3E,0x83,0x03,0x3E,0x84,0x03,0x3E,0x87,0x03,0x3E,0x86,0x03,0x3E,0x83,0x03,0x3E,0x84,0x03,0x3E,0x87,0x03,0x3E,
+    0x86,0x03,0x3E,0x81,0x1D,0x39,0x6E,0x81,0x39,0x2E,0xC0,0x73,0x5E,0x80,0x03,0x3E,0x87,0x03,0x3E,0xC0,0x5C,0xB0,0xC0,0x45,
+    0x6C,0x1E,0x23,0x82,0xC0,0x53,0x9C,0x3E,0x83,0x6E,0x3E,0x84,0x03,0x3E,0x81,0x4D,0x23,0x85,0x1E,0x23,0xC0,0x1C,0x19,0x03,
+    0x3E,0x81,0x03,0x3E,0x83,0x03,0x3E,0x84,0x03,0x3E,0x87,0x03,0x3E,0x86,0x03,0x35,0x06,0x39,0x80,0x6E,0x86,0x39,0xC0,0x5C,
+    0x74,0x03,0x66,0x85,0x03,0x3E,0x86,0x03,0x3E,0x83,0x03,0x3E,0x84,0x03,0x3E,0x87,0x03,0x3E,0x86,0x03,0x3E,0x83,0x03,0x3E,
+    0x84,0x03,0x3E,0x87,0x03,0x3E,0x86,0x03,0x3E,0x83,0x03,0x3E,0x84,0x03,0x3E,0x87,0x03,0x3E,0x82,0x03,0x3E,0x84,0x03,0x3E,
+    0x03,0x3E,0x82,0x03,0x3E,0x86,0x03,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x82,0x03,0x3E,0x86,0x03,0x3E,
+    0x03,0x3E,0x84,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x82,0x03,0x3E,0x86,0x03,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x84,0x03,0x1D,
+    0x39,0x6E,0x81,0x39,0xC0,0x6B,0xDA,0xC0,0x73,0x5E,0x86,0x03,0x3E,0x03,0x3E,0x81,0x35,0xC0,0x2C,0xD2,0x1E,0x23,0x81,0x19,
+    0x3E,0x81,0x03,0x3E,0x03,0x3E,0x82,0x03,0x3E,0x84,0x03,0x19,0x23,0x82,0x1E,0x23,0x1E,0x80,0x31,0x03,0x3E,0x84,0x03,0x3E,
+    0x03,0x3E,0x82,0x03,0x3E,0x86,0x03,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x81,0x30,0xC0,0x55,0x0E,0xC0,0x55,0xA9,0x85,0x39,0x3E,
+    0x82,0x39,0xC0,0x64,0x36,0xC0,0x73,0x5E,0x81,0x03,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x82,0x03,0x3E,
+    0x86,0x03,0x3E,0x03,0x3E,0x84,0x03,0x3E,0x84,0x03,0x3E,0x03,0x3E,0x82,0x03,0x3E,0x86,0x03,0x3E,0x03,0x3E,0x84,0x03,0x3E,
+    0x84,0x03,0x3E,0x03,0x3E,0x82,0x03,0x3E,0x86,0x03,0x3E,0x03,0x3E,0x96,0x03,0x3E,0x9D,0x03,0x3E,0x9D,0x03,0x3E,0x93,0x1D,
+    0xC0,0x55,0xA9,0x83,0xC0,0x6B,0xBA,0xC0,0x73,0x5E,0x81,0x03,0x3E,0x89,0xC0,0x34,0x19,0x1E,0x6E,0x81,0xC0,0x24,0x1A,0x3E,
+    0x8C,0x03,0x3E,0x81,0xC0,0x23,0xFA,0x23,0x1E,0x84,0x18,0x03,0x3E,0x90,0x03,0x3E,0x8F,0x13,0x39,0x6E,0x82,0x39,0x3E,0x39,
+    0x3E,0x84,0x02,0x2E,0xC0,0x73,0x5E,0x9B,0x03,0x3E,0x9D,0x03,0x3E,0x9D,0x03,0x3E,0xBF,0xB3,0xC0,0x64,0x93,0x39,0x80,0x6E,
+    0x39,0x80,0x2E,0xC0,0x73,0x5E,0x8D,0x5A,0xC0,0x0C,0x59,0x23,0x1E,0x19,0x31,0x3E,0x90,0xC0,0x53,0x9C,0x1E,0x23,0x1E,0x81,
+    0x23,0x1E,0x2C,0x3E,0x8F,0x3C,0xC0,0x64,0x17,0x6D,0x69,0x6D,0x5A,0x69,0x80,0x15,0x80,0x10,0x80,0x15,0x10,0x80,0x15,0x80,
+    0x10,0x80,0x6D,0xC0,0x55,0x6A,0xC0,0x55,0xA9,0x85,0x39,0x3E,0x84,0x39,0x11,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x91,0x1D,0xC0,
+    0x55,0xA9,0x82,0x39,0xC0,0x6B,0xBA,0xC0,0x73,0x5E,0x8E,0x36,0xC0,0x33,0xDA,0x80,0xC0,0x5B,0x7D,0x3E,0x91,0x5D,0xC0,0x04,
+    0x79,0x81,0x6E,0x81,0x22,0x3E,0x8F,0xC0,0x73,0x9C,0xC0,0x5D,0x0E,0xC0,0x55,0x89,0x8C,0x6E,0x80,0x39,0x82,0x3E,0x8D,0x3D,
+    0xC0,0x6B,0x9A,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x90,0x1D,0x39,0x6E,0x80,0x39,0x80,0x2E,0xC0,0x73,0x5E,0xA6,0x24,0x23,0x1E,
+    0x82,0xC0,0x6B,0x5D,0x3E,0x8E,0x30,0x3D,0xC0,0x55,0xA9,0x83,0x39,0x3E,0x92,0x39,0x3E,0x87,0x39,0x1C,0xC0,0x73,0x5E,0xBF,
+    0xBF,0xBF,0x90,0x1D,0x39,0x80,0x6E,0x80,0x39,0x2E,0xC0,0x73,0x5E,0xA6,0xC0,0x4B,0xBC,0x1E,0x82,0x2B,0x3E,0x8E,0xC0,0x6B,
+    0xD9,0x3D,0x39,0x6E,0x94,0x39,0x3E,0x87,0x39,0x3E,0x82,0x13,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x90,0x1D,0x39,0x6E,0x39,0x81,
+    0x2E,0xC0,0x73,0x5E,0xA7,0xC0,0x4B,0x9B,0x22,0x7A,0x30,0x3E,0x8E,0xC0,0x63,0xF8,0x3B,0x39,0x6E,0x9C,0x39,0x3E,0x84,0x39,
+    0x0A,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x90,0x1D,0x39,0x6E,0x80,0x39,0x80,0x2E,0xC0,0x73,0x5E,0xBA,0xC0,0x64,0x17,0x3D,0xC0,
+    0x55,0xA9,0x39,0x3E,0x80,0x39,0x80,0x3F,0x66,0x3F,0x85,0x3A,0x3F,0x81,0x3A,0x3F,0x80,0x39,0x3E,0x39,0x3E,0x82,0x39,0x3E,
+    0x39,0x82,0x3E,0x39,0x3E,0x80,0x39,0x13,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x90,0x1D,0x39,0x6E,0x81,0x39,0x2E,0xC0,0x73,0x5E,
+    0xB9,0xC0,0x64,0x16,0x3B,0x39,0x6E,0x81,0x39,0x80,0xC0,0x5C,0x91,0xC0,0x73,0x5D,0x6B,0x8D,0x08,0xC0,0x55,0xA9,0x84,0x39,
+    0x3E,0x80,0x39,0x81,0x3E,0x39,0x80,0x3E,0x39,0x1A,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x90,0x1D,0x39,0x6E,0x80,0x39,0x80,0x2E,
+    0xC0,0x73,0x5E,0xB8,0x1E,0x39,0x80,0x6E,0x82,0x39,0x17,0xC0,0x73,0x5E,0x8F,0x13,0x39,0x6E,0x39,0x3E,0x83,0x39,0x3E,0x39,
+    0x82,0x3E,0x80,0x3B,0xC0,0x63,0xD9,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x90,0x1D,0x39,0x6E,0x81,0x39,0x2E,0xC0,0x73,0x5E,0xB7,
+    0x1C,0x39,0x82,0x6E,0x39,0x80,0x17,0xC0,0x73,0x5E,0x90,0x29,0x3B,0xC0,0x55,0xA9,0x83,0x39,0x3E,0x39,0x81,0x3E,0x80,0x39,
+    0x3E,0x80,0xC0,0x54,0xEE,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x91,0x1D,0xC0,0x55,0xA9,0x82,0x39,0xC0,0x6B,0xDA,0xC0,0x73,0x5E,
+    0xB6,0x1E,0x39,0x80,0x6E,0x82,0x39,0x17,0xC0,0x73,0x5E,0x92,0x11,0x39,0x6E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x81,0x3E,
+    0x39,0x80,0x25,0xC0,0x73,0x5E,0xBF,0xBF,0xBF,0x91,0x1D,0x39,0x6E,0x81,0x39,0x33,0xC0,0x73,0x5E,0xB5,0x1C,0x39,0x6E,0x83,
+    0x39,0x10,0xC0,0x73,0x5E,0x93,0xC0,0x6B,0x9B,0x3F,0xC0,0x55,0xA9,0x39,0x3E,0x80,0x39,0x81,0x3E,0x80,0x39,0x80,0x3E,0x39,
+    0x11,0x37,0x6B,0xBF,0xBF,0xBF,0x91,0x1D,0x39,0x6E,0x81,0x39,0x2E,0xC0,0x73,0x5E,0x88,0x30,0x33,0x68,0x5D,0x6E,0x1E,0x80,
+    0x59,0x81,0x6E,0x80,0x14,0x19,0x69,0x8C,0x19,0x12,0x8D,0xC0,0x54,0x91,0x39,0x80,0x6E,0x82,0x39,0x12,0xC0,0x73,0x5E,0x95,
+    0x30,0x3D,0x39,0x80,0x6E,0x39,0x82,0x3E,0x81,0x39,0xC0,0x5C,0xCF,0x37,0x6B,0xBF,0xAA,0x66,0x3E,0x9A,0x39,0x3E,0x80,0x39,
+    0x3E,0x9A,0x39,0x3E,0x80,0x39,0x3E,0x9A,0x39,0x3E,0x80,0x39,0x3E,0x85,0x1D,0xC0,0x55,0x89,0x6E,0x80,0x39,0x80,0xC0,0x73,
+    0xDB,0xC0,0x73,0x5E,0x87,0x0A,0xC0,0x55,0x8A,0x6D,0x80,0x39,0x3E,0x8E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x84,0x39,0x3E,0x83,
+    0x39,0x85,0x3E,0x82,0x39,0x17,0xC0,0x73,0x5E,0x8E,0x66,0x3E,0x80,0x39,0x3E,0x83,0xC0,0x6B,0x9C,0x0A,0xC0,0x55,0xA9,0x82,
+    0x66,0x3E,0x81,0x39,0x1A,0xC0,0x73,0x5D,0x6B,0x88,0x66,0x3E,0x80,0x39,0x3E,0x9A,0x39,0x3E,0x80,0x39,0x3E,0x9A,0x39,0x3E,
+    0x80,0x39,0x3E,0x9A,0x39,0x3E,0x83,0x39,0x80,0x3E,0x87,0x39,0x3E,0x82,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x85,
+    0x39,0x80,0x3E,0x87,0x39,0x3E,0x82,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x85,0x39,0x80,0x3E,0x87,0x39,0x3E,0x82,
+    0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x85,0x39,0x80,0x3E,0x81,0x1D,0xC0,0x55,0x89,0x6E,0x81,0x39,0xC0,0x73,0xBA,
+    0xC0,0x73,0x5E,0x82,0x66,0x3E,0x39,0x3E,0xC0,0x63,0xD8,0xC0,0x55,0xA9,0x85,0x66,0x3E,0x82,0x39,0x3E,0x9A,0x39,0x3E,0x39,
+    0x3E,0x81,0x39,0x3E,0x80,0x39,0xC0,0x64,0x55,0xC0,0x73,0x5E,0x80,0x66,0x3E,0x82,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x39,
+    0x3E,0x85,0x39,0x80,0x3E,0x81,0x2C,0x13,0xC0,0x55,0x0D,0x02,0x58,0xC0,0x55,0x4B,0x03,0x1A,0x30,0x3E,0x80,0x39,0x3E,0x39,
+    0x3E,0x81,0x39,0x3E,0x39,0x3E,0x85,0x39,0x80,0x3E,0x87,0x39,0x3E,0x82,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x85,
+    0x39,0x80,0x3E,0x87,0x39,0x3E,0x82,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x85,0x39,0x80,0x3E,0x87,0x39,0x3E,0x82,
+    0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x82,0x39,0x3E,0x81,0x39,0x3E,0x84,0x39,0x81,0x3E,0x81,0x39,0x3E,0x39,0x3E,
+    0x82,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x84,0x39,0x81,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x82,0x39,
+    0x3E,0x81,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x84,0x39,0x81,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x82,0x39,0x3E,0x81,
+    0x39,0x3E,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x81,0x1D,0xC0,0x55,0x89,0x6E,0x81,0x39,0xC0,0x73,0xDA,0xC0,0x73,0x5E,0x80,
+    0x66,0x3E,0x39,0x3E,0x81,0x12,0xC0,0x55,0xA9,0x84,0x66,0x3E,0x8C,0x39,0x80,0x3E,0x8B,0x39,0x3E,0x86,0x39,0x3E,0x82,0x39,
+    0x25,0xC0,0x73,0x3E,0x80,0x6E,0x81,0x39,0x3E,0x39,0x3E,0x82,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,
+    0x83,0x6C,0x6D,0x30,0x67,0x37,0x3E,0x80,0x39,0x3E,0x39,0x3E,0x82,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x81,0x39,
+    0x3E,0x84,0x39,0x81,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x82,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x84,
+    0x39,0x81,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x82,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x84,0x39,0x81,
+    0x3E,0x81,0x39,0x3E,0x39,0x3E,0x82,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,0x39,0x80,0x3E,0x39,0x3E,0x39,0x84,0x3E,0x80,0x39,
+    0x3E,0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x39,0x3E,0x80,0x39,0x3E,0x80,0x39,0x80,0x3E,0x39,0x3E,0x39,0x84,0x3E,
+    0x80,0x39,0x3E,0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x39,0x3E,0x80,0x39,0x3E,0x80,0x39,0x80,0x3E,0x39,0x3E,0x39,
+    0x84,0x3E,0x80,0x39,0x3E,0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x39,0x3E,0x80,0x39,0x3E,0x80,0x39,0x80,0x3E,0x39,
+    0x3E,0x39,0x81,0x1D,0xC0,0x55,0x89,0x6E,0x81,0x39,0x36,0xC0,0x73,0x3E,0x80,0x6E,0x39,0x3E,0x81,0x39,0x30,0x00,0x6D,0x82,
+    0x66,0x3E,0x83,0x39,0x3E,0x82,0x39,0x3E,0x39,0x3E,0x88,0x39,0x3E,0x81,0x39,0x80,0x3E,0x84,0x39,0x82,0x3E,0x39,0x3E,0x82,
+    0x3B,0x1E,0xC0,0x73,0x3E,0x6E,0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x39,0x3E,0x80,0x39,0x3E,0x80,0x39,0x80,0x3E,
+    0x39,0x3E,0x39,0x84,0x3E,0x80,0x39,0x3E,0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x39,0x3E,0x80,0x39,0x3E,0x80,0x39,
+    0x80,0x3E,0x39,0x3E,0x39,0x84,0x3E,0x80,0x39,0x3E,0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x39,0x3E,0x80,0x39,0x3E,
+    0x80,0x39,0x80,0x3E,0x39,0x3E,0x39,0x84,0x3E,0x80,0x39,0x3E,0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x39,0x3E,0x80,
+    0x39,0x3E,0x80,0x39,0x80,0x3E,0x39,0x3E,0x39,0x84,0x3E,0x80,0x39,0x3E,0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x81,0x3E,0x39,
+    0x3E,0x80,0x39,0x3E,0x80,0x39,0x3E,0x39,0x80,0x3E,0x80,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x39,0x81,0x3E,0x39,0x80,0x3E,0x39,
+    0x81,0x3E,0x39,0x88,0x3E,0x39,0x80,0x3E,0x80,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x39,0x81,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,
+    0x39,0x88,0x3E,0x39,0x80,0x3E,0x80,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x39,0x81,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x88,
+    0x3E,0x39,0x80,0x3E,0x80,0x39,0x3E,0x1D,0xC0,0x55,0x89,0x6E,0x81,0x39,0xC0,0x73,0xBA,0xC0,0x73,0x5E,0x66,0x80,0x3E,0x39,
+    0x81,0x3E,0x39,0x20,0x0D,0x06,0x3F,0x04,0x3D,0x82,0x02,0x3D,0x02,0x80,0x3B,0x89,0x66,0x3B,0x80,0x36,0x3B,0x8A,0x36,0x3B,
+    0x81,0x36,0x80,0xC0,0x55,0x89,0x6E,0x83,0x39,0x17,0x37,0x6B,0x66,0x80,0x3E,0x39,0x81,0x3E,0x39,0x88,0x3E,0x39,0x80,0x3E,
+    0x80,0x39,0x3E,0x39,0x3E,0x39,0x3E,0x39,0x81,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x88,0x3E,0x39,0x80,0x3E,0x80,0x39,
+    0x3E,0x39,0x3E,0x39,0x3E,0x39,0x81,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x88,0x3E,0x39,0x80,0x3E,0x80,0x39,0x3E,0x39,
+    0x3E,0x39,0x3E,0x39,0x81,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x88,0x3E,0x39,0x80,0x3E,0x80,0x39,0x3E,0x39,0x3E,0x39,
+    0x3E,0x39,0x81,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x8A,0x3E,0x39,0x86,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x80,
+    0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x86,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x83,
+    0x3E,0x39,0x86,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x82,0x1D,0xC0,0x55,
+    0x89,0x6E,0x80,0x39,0x80,0xC0,0x73,0xDB,0xC0,0x73,0x3E,0x6E,0x39,0x83,0x3E,0x39,0x80,0x3E,0x81,0x37,0x82,0x35,0x66,0x32,
+    0x80,0x35,0x80,0x32,0x35,0x32,0x80,0x35,0x32,0x80,0x35,0x80,0x32,0x35,0x85,0x32,0x80,0x35,0x32,0x35,0x32,0x35,0x80,0x32,
+    0x80,0x35,0x32,0x80,0x35,0x80,0x0E,0xC0,0x55,0x89,0x6E,0x80,0x39,0x3E,0x80,0x39,0x0A,0x37,0x6B,0x66,0x83,0x3E,0x39,0x80,
+    0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x86,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x83,
+    0x3E,0x39,0x86,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x86,0x3E,0x39,0x81,
+    0x3E,0x39,0x83,0x3E,0x39,0x80,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x86,0x3E,0x39,0x81,0x3E,0x39,0x83,0x3E,0x39,0x80,
+    0x3E,0x39,0x81,0x3E,0x39,0x9B,0x3E,0x39,0x9D,0x3E,0x39,0x9D,0x3E,0x39,0x8A,0x1D,0xC0,0x55,0x89,0x6E,0x80,0x39,0x80,0xC0,
+    0x73,0xDA,0xC0,0x73,0x3E,0x8A,0x6E,0x39,0x9D,0x3E,0x39,0x88,0x3E,0x1E,0xC0,0x55,0x89,0x6E,0x39,0x3E,0x39,0x3E,0x80,0xC0,
+    0x54,0xED,0x35,0xC0,0x73,0x3E,0x88,0x6E,0x39,0x92,0x37,0x0A,0x04,0xC0,0x55,0x0E,0xC0,0x6B,0xD8,0x39,0x84,0x3E,0x39,0x9D,
+    0x3E,0x39,0x9D,0x3E,0x39,0x9D,0x3E,0x39,0xBF,0xAA,0x1D,0xC0,0x55,0x89,0x6E,0x80,0x39,0x80,0x36,0xC0,0x73,0x3E,0xB7,0x27,
+    0x3B,0x3E,0x84,0x3F,0xC0,0x6B,0x9B,0x39,0x9C,0xC0,0x54,0xCF,0xC0,0x55,0x89,0x3E,0x80,0xC0,0x55,0x4B,0xC0,0x6B,0xB9,0xC0,
+    0x73,0x3E,0xBF,0xBF,0xBF,0x90,0x1D,0x3E,0x82,0x66,0x31,0xC0,0x73,0x3E,0xB8,0x2E,0x3F,0x3E,0x66,0x3E,0x82,0x3D,0x20,0xC0,
+    0x73,0x3E,0x9A,0x35,0x3B,0x3E,0x81,0x66,0x15,0xC0,0x73,0x3E,0xBF,0xBF,0xBF,0x90,0x1D,0xC0,0x55,0x89,0x3E,0x81,0x39,0x31,
+    0xC0,0x73,0x3E,0xB9,0xC0,0x6B,0x9A,0x3F,0x3E,0x83,0x66,0x3B,0x12,0xC0,0x63,0xB8,0x99,0xC0,0x63,0xF6,0x39,0x80,0x3E,0x81,
+    0x0A,0xC0,0x73,0x3E,0xBF,0xBF,0xBF,0x90,0xC0,0x64,0x93,0xC0,0x55,0x89,0x81,0x3E,0x56,0x31,0xC0,0x73,0x3E,0xBA,0xC0,0x6B,
+    0x7B,0x05,0x3E,0xA1,0x66,0x3E,0x39,0x3E,0x80,0x13,0xC0,0x73,0x3E,0xBF,0xBF,0xBF,0x90,0xC0,0x64,0x73,0xC0,0x55,0x89,0x80,
+    0x3E,0x39,0x80,0x2E,0xC0,0x73,0x3E,0xBB,0x6C,0x0A,0xC0,0x55,0x89,0x3E,0x82,0x39,0x80,0x3E,0x87,0x39,0x3E,0x8B,0x39,0x3E,
+    0x85,0x39,0x10,0xC0,0x73,0x3E,0xBF,0xBF,0xBF,0x90,0x1C,0xC0,0x55,0x89,0x3E,0x80,0x39,0x3E,0x1E,0xC0,0x73,0x3E,0xBC,0x37,
+    0x15,0xC0,0x55,0x89,0x3E,0x82,0x39,0x3E,0x39,0x80,0x3E,0x83,0x39,0x3E,0x80,0x39,0x83,0x3E,0x83,0x39,0x80,0x3E,0x39,0x80,
+    0x3E,0x39,0x80,0x3E,0x39,0x80,0x19,0xC0,0x73,0x3E,0xBF,0xB2,0x7A,0x39,0x9D,0x3C,0x39,0x9D,0x3C,0x39,0x9B,0x29,0x3B,0x3E,
+    0x66,0x3E,0x39,0x3A,0xC0,0x73,0x3E,0x99,0x3C,0x39,0x9D,0x3C,0x39,0x82,0x1E,0x3B,0x3E,0x81,0x66,0x83,0x3E,0x39,0x3E,0x80,
+    0x39,0x80,0x3E,0x39,0x3E,0x81,0x39,0x3E,0x82,0x39,0x3E,0x83,0x39,0x80,0x3E,0x80,0x39,0x02,0x29,0xC0,0x73,0x3E,0x92,0x3C,
+    0x39,0x9D,0x3C,0x39,0x9D,0x3C,0x39,0x95,0x3C,0x39,0x89,0x3C,0x39,0x91,0x3C,0x39,0x89,0x3C,0x39,0x91,0x3C,0x39,0x89,0x3C,
+    0x39,0x91,0x3C,0x39,0x84,0xC0,0x54,0xED,0x3E,0x82,0x66,0xC0,0x6B,0xB8,0xC0,0x73,0x3E,0x90,0x7A,0x39,0x89,0x3C,0x39,0x91,
+    0x3C,0x39,0x89,0x3C,0x39,0x2E,0xC0,0x55,0x2B,0x2F,0x7B,0x8C,0x36,0x39,0x82,0x36,0x80,0x39,0x36,0x39,0x36,0x80,0x2F,0x39,
+    0x3E,0x80,0x39,0x3E,0x39,0x08,0xC0,0x73,0x3E,0x8B,0x3C,0x39,0x89,0x3C,0x39,0x91,0x3C,0x39,0x89,0x3C,0x39,0x91,0x3C,0x39,
+    0x89,0x3C,0x39,0xA2,0x3C,0x39,0x82,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x92,0x3C,0x39,0x82,0x3C,0x39,0x3C,0x39,0x81,0x3C,
+    0x39,0x92,0x3C,0x39,0x82,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x88,0x1A,0xC0,0x55,0x89,0x3E,0x81,0x39,0x03,0x37,0x67,0x80,
+    0x3C,0x39,0x82,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x92,0x3C,0x39,0x82,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x90,0x3C,0x37,
+    0x83,0x6B,0x37,0x81,0x3E,0x37,0x81,0x66,0x37,0x39,0x37,0x89,0x35,0xC0,0x5C,0xCF,0xC0,0x55,0x89,0x81,0x6E,0x80,0x1A,0xC0,
+    0x73,0x3E,0x81,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x92,0x3C,0x39,0x82,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x92,0x3C,0x39,
+    0x82,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x92,0x3C,0x39,0x82,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x3C,
+    0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,0x82,0x3C,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,
+    0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,0x82,0x3C,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,
+    0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,0x82,0x3C,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,
+    0x39,0x3C,0x39,0x80,0xC0,0x6B,0x9B,0xC0,0x55,0x4A,0x3E,0x81,0x66,0x80,0xC0,0x64,0x34,0x3C,0x5A,0x82,0x3C,0x39,0x81,0x3C,
+    0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,0x82,0x3C,0x39,0x81,0x3C,
+    0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,0x82,0x3C,0x39,0x81,0x3C,
+    0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x1E,0xC0,0x55,0x89,0x82,0x3E,0x3B,0x29,0xC0,0x73,
+    0x3E,0x3C,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,
+    0x82,0x3C,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,
+    0x82,0x3C,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x3C,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,
+    0x82,0x3C,0x39,0x81,0x3C,0x39,0x85,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x89,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,
+    0x3C,0x80,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x89,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,0x3C,0x80,0x39,
+    0x81,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x89,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,0x3C,0x80,0x39,0x81,0x3C,0x39,
+    0x80,0x3C,0x39,0x3C,0x80,0x39,0xC0,0x5C,0x73,0xC0,0x55,0x89,0x3E,0x82,0x3B,0xC0,0x6B,0xF7,0xC0,0x73,0x3E,0x80,0x3C,0x39,
+    0x80,0x3C,0x39,0x81,0x3C,0x39,0x3C,0x80,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x89,0x3C,0x39,0x80,0x3C,0x39,
+    0x81,0x3C,0x39,0x3C,0x80,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x89,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,
+    0x3C,0x80,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x81,0x25,0x36,0xC0,0x55,0x89,0x3E,0x81,0x39,0x13,0xC0,0x73,
+    0x3E,0x81,0x3C,0x39,0x81,0x3C,0x39,0x3C,0x80,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x89,0x3C,0x39,0x80,0x3C,
+    0x39,0x81,0x3C,0x39,0x3C,0x80,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x89,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,
+    0x39,0x3C,0x80,0x39,0x81,0x3C,0x39,0x80,0x3C,0x39,0x3C,0x80,0x39,0x89,0x3C,0x39,0x80,0x3C,0x39,0x81,0x3C,0x39,0x3C,0x80,
+    0x39,0x3C,0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x80,0x39,0x3C,0x83,0x39,0x80,0x3C,0x81,0x39,0x3C,0x82,0x39,0x3C,0x39,0x80,
+    0x3C,0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x80,0x39,0x3C,0x83,0x39,0x80,0x3C,0x81,0x39,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,
+    0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x80,0x39,0x3C,0x83,0x39,0x80,0x3C,0x81,0x39,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x80,
+    0x39,0x81,0x3C,0x39,0x82,0xC0,0x73,0x7B,0x3B,0x3E,0x80,0x66,0x3E,0x80,0x36,0xC0,0x6B,0xF8,0xC0,0x73,0x3E,0x3C,0x81,0x39,
+    0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x80,0x39,0x3C,0x83,0x39,0x80,0x3C,0x81,0x39,0x3C,
+    0x82,0x39,0x3C,0x39,0x80,0x3C,0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x80,0x39,0x3C,0x83,0x39,0x80,0x3C,0x81,0x39,0x3C,0x82,
+    0x39,0x3C,0x39,0x80,0x3C,0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x25,0x3D,0xC0,0x55,0x89,0x3E,0x81,0x39,0x3B,0x2B,0x3C,0x81,
+    0x5A,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x80,0x39,0x3C,0x83,0x39,0x80,0x3C,0x81,0x39,
+    0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x80,0x39,0x3C,0x83,0x39,0x80,0x3C,0x81,0x39,0x3C,
+    0x82,0x39,0x3C,0x39,0x80,0x3C,0x80,0x39,0x81,0x3C,0x39,0x82,0x3C,0x80,0x39,0x3C,0x83,0x39,0x80,0x3C,0x81,0x39,0x3C,0x82,
+    0x39,0x3C,0x39,0x82,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x39,0x80,0x3C,0x39,0x82,0x3C,0x81,0x39,0x81,0x3C,0x39,0x83,0x3C,
+    0x39,0x81,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x39,0x80,0x3C,0x39,0x82,0x3C,0x81,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x81,
+    0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x39,0x80,0x3C,0x39,0x82,0x3C,0x81,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x81,0x3C,0x82,
+    0x39,0x3C,0x39,0x80,0x3C,0x1E,0xC0,0x55,0x89,0x3E,0x80,0x39,0x3E,0x80,0x3B,0xC0,0x64,0x34,0xC0,0x73,0x3E,0x82,0x3C,0x39,
+    0x83,0x3C,0x39,0x81,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x39,0x80,0x3C,0x39,0x82,0x3C,0x81,0x39,0x81,0x3C,0x39,0x83,0x3C,
+    0x39,0x81,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x39,0x80,0x3C,0x39,0x82,0x3C,0x81,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x81,
+    0x3C,0x82,0x39,0x3C,0x39,0x80,0xC0,0x64,0x53,0x3B,0x6D,0x3E,0x80,0x39,0x3E,0x39,0x1C,0x3C,0x80,0x5A,0x81,0x3C,0x39,0x83,
+    0x3C,0x39,0x81,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x39,0x80,0x3C,0x39,0x82,0x3C,0x81,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,
+    0x81,0x3C,0x82,0x39,0x3C,0x39,0x80,0x3C,0x39,0x80,0x3C,0x39,0x82,0x3C,0x81,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x81,0x3C,
+    0x82,0x39,0x3C,0x39,0x80,0x3C,0x39,0x80,0x3C,0x39,0x82,0x3C,0x81,0x39,0x81,0x3C,0x39,0x83,0x3C,0x39,0x3C,0x80,0x39,0x80,
+    0x3C,0x80,0x56,0x3C,0x80,0x39,0x3C,0x82,0x39,0x3C,0x80,0x39,0x3C,0x81,0x39,0x3C,0x83,0x66,0x39,0x34,0x3C,0x82,0x39,0x80,
+    0x3C,0x80,0x34,0x3C,0x80,0x39,0x3C,0x82,0x39,0x3C,0x80,0x39,0x3C,0x81,0x39,0x3C,0x83,0x37,0x39,0x34,0x3C,0x82,0x39,0x80,
+    0x3C,0x80,0x34,0x3C,0x80,0x39,0x3C,0x82,0x39,0x3C,0x80,0x39,0x3C,0x81,0x39,0x3C,0x83,0x37,0x39,0x34,0x3C,0x82,0x39,0x80,
+    0x3C,0x80,0x34,0x3C,0x80,0x39,0x3C,0x39,0x0A,0xC0,0x55,0x89,0x3E,0x39,0x3E,0x82,0x3A,0x25,0x32,0x3C,0x82,0x37,0x5E,0x34,
+    0x3C,0x82,0x39,0x80,0x3C,0x80,0x34,0x3C,0x80,0x39,0x3C,0x82,0x39,0x3C,0x80,0x39,0x3C,0x81,0x39,0x3C,0x83,0x37,0x39,0x34,
+    0x3C,0x82,0x39,0x80,0x3C,0x80,0x34,0x3C,0x80,0x39,0x3C,0x82,0x39,0x3C,0x80,0x39,0x3C,0x81,0x39,0x3C,0x83,0x37,0x39,0x34,
+    0x3C,0x82,0x39,0x80,0x3C,0x80,0x34,0x32,0x2A,0xC0,0x55,0x0B,0xC0,0x55,0x89,0x3E,0x84,0x08,0xC0,0x73,0x3E,0x3C,0x80,0x39,
+    0x3C,0x83,0x37,0x39,0x34,0x3C,0x82,0x39,0x80,0x3C,0x80,0x34,0x3C,0x80,0x39,0x3C,0x82,0x39,0x3C,0x80,0x39,0x3C,0x81,0x39,
+    0x3C,0x83,0x37,0x39,0x34,0x3C,0x82,0x39,0x80,0x3C,0x80,0x34,0x3C,0x80,0x39,0x3C,0x82,0x39,0x3C,0x80,0x39,0x3C,0x81,0x39,
+    0x3C,0x83,0x37,0x39,0x34,0x3C,0x82,0x39,0x80,0x3C,0x80,0x34,0x3C,0x80,0x39,0x3C,0x82,0x39,0x3C,0x80,0x39,0x3C,0x81,0x39,
+    0x3C,0x83,0x37,0x39,0x34,0x3C,0x80,0x37,0x3C,0x80,0x37,0x3C,0x34,0x3C,0x80,0x34,0x37,0x3C,0x34,0x3C,0x37,0x3C,0x80,0x37,
+    0x3C,0x39,0x3C,0x37,0x3C,0x37,0x3C,0x39,0x81,0x3C,0x82,0x39,0x37,0x3C,0x80,0x37,0x3C,0x34,0x3C,0x80,0x34,0x37,0x3C,0x34,
+    0x3C,0x37,0x3C,0x80,0x37,0x3C,0x39,0x3C,0x37,0x3C,0x37,0x3C,0x39,0x81,0x3C,0x82,0x39,0x37,0x3C,0x80,0x37,0x3C,0x34,0x3C,
+    0x80,0x34,0x37,0x3C,0x34,0x3C,0x37,0x3C,0x80,0x37,0x3C,0x39,0x3C,0x37,0x3C,0x37,0x3C,0x39,0x81,0x3C,0x82,0x39,0x37,0x3C,
+    0x80,0x37,0x3C,0x34,0x3C,0x80,0x34,0x37,0x3C,0x34,0x32,0x01,0xC0,0x55,0x89,0x80,0x3E,0x81,0x39,0x81,0x3D,0xC0,0x5C,0x92,
+    0x25,0x29,0xC0,0x73,0x5C,0x6B,0x7B,0x3C,0x80,0x5A,0x3C,0x83,0x39,0x3C,0x83,0x39,0x3C,0x8A,0x39,0x3C,0x84,0x39,0x3C,0x81,
+    0x66,0x3C,0x39,0x3C,0x80,0x39,0x3C,0x80,0x39,0x3C,0x84,0x39,0x3C,0x82,0x01,0x5A,0x80,0x69,0x7A,0x80,0x37,0x3A,0x5E,0x7A,
+    0x6D,0x80,0x59,0x29,0x27,0x10,0x38,0xC0,0x55,0x89,0x6E,0x84,0x39,0xC0,0x55,0x2C,0x32,0x6B,0x7A,0x66,0x3C,0x37,0x3C,0x39,
+    0x81,0x3C,0x82,0x39,0x37,0x3C,0x80,0x37,0x3C,0x34,0x3C,0x80,0x34,0x37,0x3C,0x34,0x3C,0x37,0x3C,0x80,0x37,0x3C,0x39,0x3C,
+    0x37,0x3C,0x37,0x3C,0x39,0x81,0x3C,0x82,0x39,0x37,0x3C,0x80,0x37,0x3C,0x34,0x3C,0x80,0x34,0x37,0x3C,0x34,0x3C,0x37,0x3C,
+    0x80,0x37,0x3C,0x39,0x3C,0x37,0x3C,0x37,0x3C,0x39,0x81,0x3C,0x82,0x39,0x37,0x3C,0x80,0x37,0x3C,0x34,0x3C,0x80,0x34,0x37,
+    0x3C,0x34,0x3C,0x37,0x3C,0x80,0x37,0x3C,0x39,0x3C,0x37,0x3C,0x37,0x3C,0x39,0x81,0x3C,0x82,0x39,0x3C,0x82,0x37,0x80,0x3C,
+    0x82,0x37,0x3C,0x80,0x37,0x82,0x3C,0x37,0x81,0x3C,0x39,0x3C,0x37,0x3C,0x82,0x37,0x3C,0x84,0x37,0x80,0x3C,0x82,0x37,0x3C,
+    0x80,0x37,0x82,0x3C,0x37,0x81,0x3C,0x39,0x3C,0x37,0x3C,0x82,0x37,0x3C,0x84,0x37,0x80,0x3C,0x82,0x37,0x3C,0x80,0x37,0x82,
+    0x3C,0x37,0x81,0x3C,0x39,0x3C,0x37,0x3C,0x82,0x37,0x3C,0x84,0x37,0x80,0x3C,0x82,0x37,0x3C,0x80,0x30,0xC0,0x55,0x0D,0xC0,
+    0x55,0x89,0x3E,0x80,0x39,0x3E,0x39,0x82,0x3E,0x39,0x2F,0xBF,0x88,0x39,0x3E,0x39,0x80,0x3E,0x83,0x39,0x3E,0x01,0x30,0x3C,
+    0x37,0x81,0x3C,0x5A,0x3C,0x37,0x3C,0x82,0x37,0x3C,0x84,0x37,0x80,0x3C,0x82,0x37,0x3C,0x80,0x37,0x82,0x3C,0x37,0x81,0x3C,
+    0x39,0x3C,0x37,0x3C,0x82,0x37,0x3C,0x84,0x37,0x80,0x3C,0x82,0x37,0x3C,0x80,0x37,0x82,0x3C,0x37,0x81,0x3C,0x39,0x3C,0x37,
+    0x3C,0x82,0x37,0x3C,0x84,0x37,0x80,0x3C,0x82,0x37,0x3C,0x80,0x37,0x82,0x3C,0x37,0x81,0x3C,0x39,0x3C,0x37,0x3C,0x82,0x37,
+    0x3C,0x81,0x34,0x37,0x80,0x3C,0x82,0x37,0x3C,0x37,0x3C,0x34,0x3C,0x82,0x37,0x80,0x3C,0x81,0x37,0x84,0x3C,0x37,0x3C,0x37,
+    0x3C,0x34,0x37,0x80,0x3C,0x82,0x37,0x3C,0x37,0x3C,0x34,0x3C,0x82,0x37,0x80,0x3C,0x81,0x37,0x84,0x3C,0x37,0x3C,0x37,0x3C,
+    0x34,0x37,0x80,0x3C,0x82,0x37,0x3C,0x37,0x3C,0x34,0x3C,0x82,0x37,0x80,0x3C,0x81,0x37,0x84,0x3C,0x37,0x3C,0x37,0x3C,0x34,
+    0x37,0x80,0x3C,0x82,0x37,0x3C,0x37,0x3C,0x34,0x3C,0x5D,0x03,0xC0,0x55,0x89,0x3E,0x99,0x39,0x3E,0x90,0x39,0x3E,0x8E,0x39,
+    0x3E,0x81,0x39,0x80,0x3E,0x84,0x39,0x3E,0x82,0x39,0x3E,0x88,0x39,0x80,0x03,0x37,0x3C,0x66,0x80,0x3C,0x81,0x37,0x84,0x3C,
+    0x37,0x3C,0x37,0x3C,0x34,0x37,0x80,0x3C,0x82,0x37,0x3C,0x37,0x3C,0x34,0x3C,0x82,0x37,0x80,0x3C,0x81,0x37,0x84,0x3C,0x37,
+    0x3C,0x37,0x3C,0x34,0x37,0x80,0x3C,0x82,0x37,0x3C,0x37,0x3C,0x34,0x3C,0x82,0x37,0x80,0x3C,0x81,0x37,0x84,0x3C,0x37,0x3C,
+    0x37,0x3C,0x34,0x37,0x80,0x3C,0x82,0x37,0x3C,0x37,0x3C,0x34,0x3C,0x82,0x37,0x80,0x3C,0x81,0x37,0x84,0x3C,0x37,0x3C,0x37,
+    0x81,0x3C,0x37,0x34,0x37,0x82,0x3C,0x37,0x83,0x3C,0x37,0x82,0x3C,0x37,0x80,0x3C,0x37,0x3C,0x37,0x86,0x3C,0x37,0x34,0x37,
+    0x82,0x3C,0x37,0x83,0x3C,0x37,0x82,0x3C,0x37,0x80,0x3C,0x37,0x3C,0x37,0x86,0x3C,0x37,0x34,0x37,0x82,0x3C,0x37,0x83,0x3C,
+    0x37,0x82,0x3C,0x37,0x80,0x3C,0x37,0x3C,0x37,0x86,0x3C,0x37,0x34,0x37,0x82,0x3C,0x37,0x83,0x5E,0x1A,0x3B,0x6D,0x3E,0x81,
+    0x39,0x3E,0x85,0x39,0x3E,0x8A,0x39,0x80,0x3E,0x39,0x80,0x3E,0x82,0x39,0x3E,0x39,0x3E,0x8C,0x39,0x80,0x3E,0x82,0x39,0x3E,
+    0x82,0x39,0x84,0x3E,0x82,0x39,0x3E,0x82,0x39,0x80,0x3E,0x89,0x3B,0xC0,0x64,0x53,0xC0,0x73,0x3E,0x3C,0x37,0x82,0x3C,0x37,
+    0x80,0x3C,0x37,0x3C,0x37,0x86,0x3C,0x37,0x34,0x37,0x82,0x3C,0x37,0x83,0x3C,0x37,0x82,0x3C,0x37,0x80,0x3C,0x37,0x3C,0x37,
+    0x86,0x3C,0x37,0x34,0x37,0x82,0x3C,0x37,0x83,0x3C,0x37,0x82,0x3C,0x37,0x80,0x3C,0x37,0x3C,0x37,0x86,0x3C,0x37,0x34,0x37,
+    0x82,0x3C,0x37,0x83,0x3C,0x37,0x82,0x3C,0x37,0x80,0x3C,0x37,0x3C,0x37,0x86,0x3C,0x37,0x3C,0x37,0x85,0x3C,0x37,0x88,0x3C,
+    0x37,0x80,0x3C,0x37,0x80,0x3C,0x80,0x37,0x81,0x3C,0x37,0x3C,0x37,0x85,0x3C,0x37,0x88,0x3C,0x37,0x80,0x3C,0x37,0x80,0x3C,
+    0x80,0x37,0x81,0x3C,0x37,0x3C,0x37,0x85,0x3C,0x37,0x88,0x3C,0x37,0x80,0x3C,0x37,0x80,0x3C,0x80,0x37,0x81,0x3C,0x37,0x3C,
+    0x37,0x85,0x3C,0x37,0x81,0x34,0x2B,0x0A,0xC0,0x55,0x89,0x3E,0x83,0x39,0x80,0x3E,0x81,0x39,0x3E,0x81,0x39,0x3E,0x39,0x3E,
+    0x39,0x3E,0x80,0x39,0x3E,0x88,0x39,0x3E,0x89,0x39,0x86,0x3E,0x80,0x39,0x80,0x3E,0x81,0x39,0x3E,0x82,0x39,0x81,0x3E,0x39,
+    0x87,0x3E,0x87,0x39,0x05,0x29,0x37,0x88,0x3C,0x37,0x80,0x3C,0x37,0x80,0x3C,0x80,0x37,0x81,0x3C,0x37,0x3C,0x37,0x85,0x3C,
+    0x37,0x88,0x3C,0x37,0x80,0x3C,0x37,0x80,0x3C,0x80,0x37,0x81,0x3C,0x37,0x3C,0x37,0x85,0x3C,0x37,0x88,0x3C,0x37,0x80,0x3C,
+    0x37,0x80,0x3C,0x80,0x37,0x81,0x3C,0x37,0x3C,0x37,0x85,0x3C,0x37,0x88,0x3C,0x37,0x80,0x3C,0x37,0x80,0x3C,0x80,0x37,0x87,
+    0x3C,0x37,0x80,0x3C,0x37,0x9A,0x3C,0x37,0x80,0x3C,0x37,0x9A,0x3C,0x37,0x80,0x3C,0x37,0x9A,0x3C,0x37,0x80,0x3C,0x37,0x85,
+    0xC0,0x6B,0x7A,0x1A,0x01,0xC0,0x4D,0x89,0x3E,0x39,0x3E,0x88,0x39,0x3E,0x81,0x39,0x80,0x3E,0x81,0x39,0x3E,0x81,0x39,0x80,
+    0x3E,0x39,0x3E,0x86,0x39,0x3E,0x80,0x39,0x3E,0x80,0x39,0x81,0x3E,0x39,0x3E,0x82,0x39,0x80,0x3E,0x84,0x39,0x82,0x3E,0x39,
+    0x3E,0x84,0x39,0x3E,0x84,0x39,0x80,0xC0,0x55,0x0C,0xC0,0x5C,0x73,0x29,0x3C,0x37,0x9A,0x3C,0x37,0x80,0x3C,0x37,0x9A,0x3C,
+    0x37,0x80,0x3C,0x37,0x9A,0x3C,0x37,0x80,0x3C,0x37,0xAD,0x3C,0x37,0x9D,0x3C,0x37,0x9D,0x3C,0x37,0x97,0xC0,0x73,0x5D,0x27,
+    0x1A,0x18,0x82,0x1D,0x18,0x81,0x1D,0x80,0x18,0x9F,0x1D,0x18,0x80,0x1D,0x80,0x18,0x9C,0x1A,0x25,0x30,0xC0,0x7B,0x1E,0x90,
+    0x3C,0x37,0x9D,0x3C,0x37,0x9D,0x3C,0x37,0x9D,0x3C,0x37,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0x83,
+    0x66,0x37,0x82,0x32,0x37,0x84,0x32,0x37,0x81,0x32,0x37,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x82,0x32,0x37,0x84,0x32,
+    0x37,0x81,0x32,0x37,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x82,0x32,0x37,0x84,0x32,0x37,0x81,0x32,0x37,0x32,0x37,0x82,
+    0x32,0x37,0x86,0x32,0x37,0x82,0x32,0x37,0x84,0x32,0x37,0x81,0x32,0x37,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x82,0x32,
+    0x37,0x84,0x32,0x37,0x81,0x32,0x37,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x82,0x32,0x37,0x84,0x32,0x37,0x81,0x32,0x37,
+    0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x82,0x32,0x37,0x84,0x32,0x37,0x81,0x32,0x37,0x32,0x37,0x82,0x32,0x37,0x86,0x32,
+    0x37,0x82,0x32,0x37,0x84,0x32,0x37,0x81,0x32,0x37,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x82,0x32,0x37,0x84,0x32,0x37,
+    0x81,0x32,0x37,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x82,0x32,0x37,0x84,0x32,0x37,0x81,0x32,0x37,0x32,0x37,0x82,0x32,
+    0x37,0x86,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x85,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x82,0x32,0x37,0x82,0x32,0x37,
+    0x86,0x32,0x37,0x85,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x82,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x85,0x32,0x37,0x32,
+    0x37,0x80,0x32,0x37,0x82,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x85,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x82,0x32,0x37,
+    0x82,0x32,0x37,0x86,0x32,0x37,0x85,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x82,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x85,
+    0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x82,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x85,0x32,0x37,0x32,0x37,0x80,0x32,0x37,
+    0x82,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x85,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x82,0x32,0x37,0x82,0x32,0x37,0x86,
+    0x32,0x37,0x85,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x82,0x32,0x37,0x82,0x32,0x37,0x86,0x32,0x37,0x85,0x32,0x37,0x32,0x37,
+    0x80,0x32,0x37,0x81,0x32,0x80,0x37,0x81,0x32,0x37,0x80,0x6B,0x32,0x37,0x81,0x32,0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,
+    0x32,0x37,0x32,0x80,0x37,0x81,0x32,0x37,0x80,0x3E,0x32,0x37,0x81,0x32,0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,
+    0x32,0x80,0x37,0x81,0x32,0x37,0x80,0x3E,0x32,0x37,0x81,0x32,0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,0x32,0x80,
+    0x37,0x81,0x32,0x37,0x80,0x3E,0x32,0x37,0x81,0x32,0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,0x32,0x80,0x37,0x81,
+    0x32,0x37,0x80,0x3E,0x32,0x37,0x81,0x32,0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,0x32,0x80,0x37,0x81,0x32,0x37,
+    0x80,0x3E,0x32,0x37,0x81,0x32,0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,0x32,0x80,0x37,0x81,0x32,0x37,0x80,0x3E,
+    0x32,0x37,0x81,0x32,0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,0x32,0x80,0x37,0x81,0x32,0x37,0x80,0x3E,0x32,0x37,
+    0x81,0x32,0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,0x32,0x80,0x37,0x81,0x32,0x37,0x80,0x3E,0x32,0x37,0x81,0x32,
+    0x37,0x80,0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,0x32,0x80,0x37,0x81,0x32,0x37,0x80,0x3E,0x32,0x37,0x81,0x32,0x37,0x80,
+    0x32,0x37,0x80,0x32,0x37,0x88,0x32,0x37,0x80,0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x32,
+    0x80,0x3E,0x32,0x37,0x32,0x82,0x6B,0x37,0x81,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x37,0x32,0x37,0x80,
+    0x32,0x37,0x32,0x80,0x3E,0x32,0x37,0x32,0x82,0x39,0x37,0x81,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x37,
+    0x32,0x37,0x80,0x32,0x37,0x32,0x80,0x3E,0x32,0x37,0x32,0x82,0x39,0x37,0x81,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x32,0x82,
+    0x37,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x32,0x80,0x3E,0x32,0x37,0x32,0x82,0x39,0x37,0x81,0x32,0x80,0x37,0x32,0x37,0x32,
+    0x37,0x32,0x82,0x37,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x32,0x80,0x3E,0x32,0x37,0x32,0x82,0x39,0x37,0x81,0x32,0x80,0x37,
+    0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x32,0x80,0x3E,0x32,0x37,0x32,0x82,0x39,0x37,0x81,
+    0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x32,0x80,0x3E,0x32,0x37,0x32,0x82,
+    0x39,0x37,0x81,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x32,0x80,0x3E,0x32,
+    0x37,0x32,0x82,0x39,0x37,0x81,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x37,0x32,0x37,0x80,0x32,0x37,0x32,
+    0x80,0x3E,0x32,0x37,0x32,0x82,0x39,0x37,0x81,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x37,0x32,0x37,0x80,
+    0x32,0x37,0x32,0x80,0x3E,0x32,0x37,0x32,0x82,0x39,0x37,0x81,0x32,0x81,0x37,0x32,0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,
+    0x83,0x37,0x80,0x32,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,
+    0x80,0x32,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,0x80,0x32,
+    0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,0x80,0x32,0x37,0x32,
+    0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,0x80,0x32,0x37,0x32,0x82,0x37,
+    0x32,0x83,0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,0x80,0x32,0x37,0x32,0x82,0x37,0x32,0x83,
+    0x37,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,0x80,0x32,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,
+    0x37,0x32,0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,0x80,0x32,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,
+    0x82,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,0x80,0x32,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0x82,0x37,
+    0x32,0x80,0x37,0x32,0x37,0x32,0x83,0x37,0x80,0x32,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x80,0x37,0x32,0x3E,0x32,0x37,
+    0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,0x32,0x84,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x39,0x32,0x80,0x37,0x32,0x3E,
+    0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,0x32,0x84,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x39,0x32,0x80,0x37,
+    0x32,0x3E,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,0x32,0x84,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x39,0x32,
+    0x80,0x37,0x32,0x3E,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,0x32,0x84,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x37,
+    0x39,0x32,0x80,0x37,0x32,0x3E,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,0x32,0x84,0x37,0x32,0x80,0x37,0x32,0x37,
+    0x32,0x37,0x39,0x32,0x80,0x37,0x32,0x3E,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,0x32,0x84,0x37,0x32,0x80,0x37,
+    0x32,0x37,0x32,0x37,0x39,0x32,0x80,0x37,0x32,0x3E,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,0x32,0x84,0x37,0x32,
+    0x80,0x37,0x32,0x37,0x32,0x37,0x39,0x32,0x80,0x37,0x32,0x3E,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,0x32,0x84,
+    0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x39,0x32,0x80,0x37,0x32,0x3E,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,0x32,0x37,
+    0x32,0x84,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x39,0x32,0x80,0x37,0x32,0x3E,0x32,0x37,0x32,0x82,0x37,0x32,0x80,0x39,
+    0x32,0x37,0x32,0x84,0x37,0x32,0x80,0x37,0x32,0x37,0x32,0x37,0x39,0x32,0x80,0x39,0x32,0x83,0x39,0x32,0x8A,0x37,0x32,0x83,
+    0x37,0x32,0x84,0x39,0x32,0x83,0x39,0x32,0x8A,0x37,0x32,0x83,0x37,0x32,0x84,0x39,0x32,0x83,0x39,0x32,0x8A,0x37,0x32,0x83,
+    0x37,0x32,0x84,0x39,0x32,0x83,0x39,0x32,0x87,0x37,0xC0,0x8B,0x9E,0x80,0x6B,0x32,0x83,0x37,0x32,0x84,0x39,0x32,0x83,0x39,
+    0x32,0x8A,0x37,0x32,0x83,0x37,0x32,0x84,0x39,0x32,0x83,0x39,0x32,0x8A,0x37,0x32,0x83,0x37,0x32,0x84,0x39,0x32,0x83,0x39,
+    0x32,0x8A,0x37,0x32,0x83,0x37,0x32,0x84,0x39,0x32,0x83,0x39,0x32,0x8A,0x37,0x32,0x83,0x37,0x32,0x84,0x39,0x32,0x83,0x39,
+    0x32,0x8A,0x37,0x32,0x83,0x37,0x32,0x84,0x39,0x32,0x83,0x39,0x32,0x8A,0x37,0x32,0x83,0x37,0x32,0x83,0x39,0x32,0x85,0x37,
+    0x32,0x8F,0x39,0x32,0x83,0x39,0x32,0x85,0x37,0x32,0x8F,0x39,0x32,0x83,0x39,0x32,0x85,0x37,0x32,0x8F,0x39,0x32,0x83,0x39,
+    0x32,0x85,0x37,0x32,0x84,0x37,0xC0,0xAC,0xDF,0xC0,0xE7,0x3F,0xC0,0xFF,0xFF,0x81,0xC0,0xCE,0x3F,0xC0,0x8B,0x7E,0x32,0x81,
+    0x39,0x32,0x83,0x39,0x32,0x85,0x37,0x32,0x8F,0x39,0x32,0x83,0x39,0x32,0x85,0x37,0x32,0x8F,0x39,0x32,0x83,0x39,0x32,0x85,
+    0x37,0x32,0x8F,0x39,0x32,0x83,0x39,0x32,0x85,0x37,0x32,0x8F,0x39,0x32,0x83,0x39,0x32,0x85,0x37,0x32,0x8F,0x39,0x32,0x83,
+    0x39,0x32,0x85,0x37,0x32,0x8F,0x39,0x32,0x8D,0x39,0x32,0x82,0x39,0x32,0x82,0x39,0x32,0x86,0x37,0x32,0x8A,0x39,0x32,0x82,
+    0x39,0x32,0x82,0x39,0x32,0x86,0x37,0x32,0x8A,0x39,0x32,0x82,0x39,0x32,0x82,0x39,0x32,0x86,0x37,0x32,0x8A,0x39,0x32,0x82,
+    0xC0,0xBD,0x7F,0x31,0x84,0xC0,0xE7,0x1F,0xC0,0x83,0x5F,0x32,0x83,0x37,0x32,0x8A,0x39,0x32,0x82,0x39,0x32,0x82,0x39,0x32,
+    0x86,0x37,0x32,0x8A,0x39,0x32,0x82,0x39,0x32,0x82,0x39,0x32,0x86,0x37,0x32,0x8A,0x39,0x32,0x82,0x39,0x32,0x82,0x39,0x32,
+    0x86,0x37,0x32,0x8A,0x39,0x32,0x82,0x39,0x32,0xC0,0x9C,0x7E,0x16,0x66,0x16,0x82,0x11,0x51,0x3C,0x32,0x80,0x37,0x32,0x8A,
+    0x39,0x32,0x82,0x39,0x32,0x82,0x39,0x32,0x86,0x37,0x32,0x8A,0x39,0x32,0x82,0x39,0x32,0x82,0x39,0x32,0x86,0x37,0x32,0x81,
+    0x39,0x32,0x39,0x32,0x81,0x39,0x80,0x32,0x84,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x32,0x85,0x39,0x32,0x80,0x39,0x32,
+    0x39,0x32,0x81,0x39,0x80,0x32,0x84,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x32,0x85,0x39,0x32,0x80,0x39,0x32,0x39,0x32,
+    0xC0,0xD6,0x5F,0xC0,0xE6,0xFF,0x80,0x69,0x5A,0x66,0x05,0x31,0x84,0x6F,0x00,0x05,0x00,0xC0,0xEF,0x3F,0x80,0x05,0xC0,0xDE,
+    0xBF,0xC0,0xC5,0xFF,0xC0,0xA4,0xBF,0xC0,0x8B,0xBE,0xC0,0x83,0x1E,0x57,0x32,0x80,0x39,0x32,0x39,0x32,0x81,0x39,0x80,0x32,
+    0x83,0xC0,0x9C,0x3F,0xC0,0xF7,0xBF,0xC0,0xFF,0xFF,0x85,0xC0,0xC5,0xDF,0xC0,0x7B,0x1E,0x32,0x83,0x39,0x32,0x80,0x39,0x32,
+    0x39,0x32,0x81,0x39,0x80,0x32,0x84,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x32,0x85,0x39,0x32,0x80,0x39,0x32,0x39,0x32,
+    0x81,0xC0,0xD6,0xBE,0x00,0x55,0x86,0x36,0x31,0x80,0x36,0x00,0x81,0x0D,0xC0,0xDE,0xDF,0x19,0xC0,0xBD,0x7E,0xC0,0xA4,0x7F,
+    0xC0,0x8B,0x9E,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x81,0x39,0x80,0x32,0x84,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x32,
+    0x85,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x81,0x39,0x80,0x32,0x84,0x39,0x80,0x0D,0xC0,0xFF,0xFF,0x85,0xC0,0xF7,0x9F,0xC0,
+    0x8B,0x7F,0x32,0x81,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x81,0x39,0x80,0x32,0x84,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,
+    0x32,0x85,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x81,0x39,0x80,0x32,0x84,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x32,0x85,
+    0x39,0x80,0x32,0x88,0x39,0x32,0x39,0x32,0x82,0x39,0x32,0x39,0x32,0x83,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x88,0x39,
+    0x32,0x39,0x32,0x82,0x39,0x32,0x39,0x32,0x83,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x83,0x0D,0x31,0x94,0x66,0xC0,0xEF,
+    0x5F,0xC0,0xCE,0x1F,0xC0,0x93,0xFF,0x32,0x88,0x39,0x32,0x39,0x32,0x07,0x31,0x86,0x05,0xC0,0x83,0x7E,0x39,0x32,0x80,0x39,
+    0x32,0x80,0x39,0x32,0x88,0x39,0x32,0x39,0x32,0x82,0x39,0x32,0x39,0x32,0x83,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x85,
+    0x31,0x94,0x24,0x38,0x2E,0xC0,0x83,0x5E,0x32,0x87,0x39,0x32,0x39,0x32,0x82,0x39,0x32,0x39,0x32,0x83,0x39,0x32,0x80,0x39,
+    0x32,0x80,0x39,0x32,0x88,0x39,0x32,0x39,0x32,0x82,0x0D,0x31,0x85,0x1F,0x13,0x32,0x39,0x32,0x80,0x39,0x32,0x88,0x39,0x32,
+    0x39,0x32,0x82,0x39,0x32,0x39,0x32,0x83,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x88,0x39,0x32,0x39,0x32,0x82,0x39,0x32,
+    0x39,0x32,0x83,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x81,0x32,0x80,0x39,0x82,0x32,0x80,0x39,0x80,0x32,0x39,0x80,0x32,0x39,
+    0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x84,0x39,0x81,0x32,0x80,0x39,0x82,0x32,0x80,0x39,0x80,0x32,0x39,0x80,0x32,
+    0x39,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x84,0x39,0x81,0x32,0x80,0x39,0x0D,0x31,0x98,0x0D,0xC0,0x9C,0x3F,0xC0,
+    0x7B,0x1E,0x32,0x39,0x82,0x32,0x80,0x39,0x80,0x32,0x39,0x19,0x31,0x87,0xC0,0x93,0xDF,0x32,0x84,0x39,0x81,0x32,0x80,0x39,
+    0x82,0x32,0x80,0x39,0x80,0x32,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x84,0x39,0x81,0x32,0x80,
+    0x39,0x81,0x2C,0x31,0x96,0x2C,0x07,0xC0,0x8B,0x7E,0x32,0x39,0x82,0x32,0x80,0x39,0x80,0x32,0x39,0x80,0x32,0x39,0x32,0x39,
+    0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x84,0x39,0x81,0x32,0x80,0x39,0x82,0x32,0x80,0x39,0x80,0x32,0x39,0x80,0x32,0x39,0x0D,
+    0x31,0x85,0x1F,0x13,0x32,0x82,0x39,0x81,0x32,0x80,0x39,0x82,0x32,0x80,0x39,0x80,0x32,0x39,0x80,0x32,0x39,0x32,0x39,0x32,
+    0x80,0x39,0x32,0x80,0x39,0x32,0x84,0x39,0x81,0x32,0x80,0x39,0x82,0x32,0x80,0x39,0x80,0x32,0x39,0x80,0x32,0x39,0x32,0x39,
+    0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x87,0x39,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x39,0x32,
+    0x81,0x39,0x32,0x39,0x32,0x81,0x39,0x81,0x32,0x82,0x39,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,
+    0x39,0x32,0x81,0x39,0x32,0x39,0x32,0x81,0x39,0x81,0x32,0x82,0x39,0x32,0x80,0x0D,0x31,0x99,0x24,0xC0,0xC5,0xBF,0x3C,0x32,
+    0x80,0x39,0x80,0x32,0x39,0x32,0x80,0x39,0x32,0x19,0x31,0x86,0x1F,0x16,0x32,0x80,0x39,0x81,0x32,0x82,0x39,0x32,0x81,0x39,
+    0x80,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x81,0x39,0x32,0x39,0x32,0x81,0x39,0x81,0x32,0x82,0x39,0x32,
+    0x81,0x39,0x2C,0x31,0x98,0x05,0xC0,0xA4,0x9E,0x37,0x32,0x39,0x80,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x39,0x32,
+    0x81,0x39,0x32,0x39,0x32,0x81,0x39,0x81,0x32,0x82,0x39,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,
+    0x0D,0x31,0x85,0x1F,0x13,0x39,0x81,0x32,0x82,0x39,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,0x32,0x39,
+    0x32,0x81,0x39,0x32,0x39,0x32,0x81,0x39,0x81,0x32,0x82,0x39,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x80,0x39,0x32,0x80,0x39,
+    0x32,0x39,0x32,0x81,0x39,0x32,0x39,0x32,0x81,0x39,0x81,0x32,0x39,0x82,0x32,0x39,0x80,0x32,0x80,0x39,0x81,0x32,0x39,0x89,
+    0x32,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x80,0x32,0x80,0x39,0x81,0x32,0x39,0x89,0x32,0x39,0x32,0x80,
+    0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x0D,0x31,0x9B,0x07,0x32,0x39,0x32,0x80,0x39,0x81,0x32,0x39,0x80,0xC0,0xB5,0x3F,
+    0x31,0x86,0xC0,0xD6,0x7F,0xC0,0x83,0x1F,0x32,0x80,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x80,0x32,0x80,0x39,0x81,0x32,
+    0x39,0x89,0x32,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x80,0x32,0xC0,0xF7,0xDF,0x31,0x99,0x2C,0xC0,0xB5,
+    0x1F,0x39,0x32,0x80,0x39,0x81,0x32,0x39,0x89,0x32,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x80,0x32,0x80,
+    0x39,0x81,0x32,0x39,0x83,0x0D,0x31,0x85,0x1F,0x13,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x80,0x32,0x80,0x39,0x81,0x32,
+    0x39,0x89,0x32,0x39,0x32,0x80,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x80,0x32,0x80,0x39,0x81,0x32,0x39,0x89,0x32,0x39,
+    0x32,0x80,0x39,0x32,0x39,0x32,0x80,0x39,0x80,0x32,0x39,0x81,0x32,0x39,0x80,0x32,0x80,0x39,0x80,0x32,0x39,0x32,0x81,0x39,
+    0x32,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x39,0x81,0x32,0x39,0x80,0x32,0x80,0x39,0x80,0x32,
+    0x39,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x39,0x80,0x0D,0x31,0x9C,0xC0,
+    0xC5,0x9F,0x39,0x32,0x39,0x80,0x32,0x80,0x39,0x80,0x32,0xC0,0x83,0x3F,0x38,0x31,0x85,0xC0,0x9C,0x5E,0x32,0x39,0x80,0x32,
+    0x81,0x39,0x32,0x39,0x80,0x32,0x39,0x81,0x32,0x39,0x80,0x32,0x80,0x39,0x80,0x32,0x39,0x32,0x81,0x39,0x32,0x39,0x80,0x32,
+    0x81,0x39,0x80,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x39,0x81,0x32,0x31,0x9C,0x23,0x32,0x39,0x80,0x32,0x80,0x39,0x80,0x32,
+    0x39,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x39,0x81,0x32,0x39,0x80,0x32,
+    0x80,0x39,0x80,0x32,0x39,0x32,0x80,0x0D,0x31,0x85,0x1F,0x13,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x39,0x81,0x32,0x39,0x80,
+    0x32,0x80,0x39,0x80,0x32,0x39,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x39,
+    0x81,0x32,0x39,0x80,0x32,0x80,0x39,0x80,0x32,0x39,0x32,0x81,0x39,0x32,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x32,
+    0x80,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x80,0x32,0x80,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x80,
+    0x39,0x81,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x80,0x32,0x80,0x39,0x32,0x39,0x32,0x39,
+    0x82,0x32,0x80,0x39,0x81,0x32,0x81,0x39,0x80,0x32,0x80,0x0D,0x31,0x9D,0xC0,0x93,0xFE,0x39,0x80,0x32,0x39,0x32,0x39,0x32,
+    0x39,0x80,0x11,0x05,0x31,0x82,0x2C,0xC0,0xAC,0xFF,0x39,0x80,0x32,0x80,0x39,0x81,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x80,
+    0x32,0x39,0x32,0x39,0x32,0x39,0x80,0x32,0x80,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x80,0x39,0x81,0x32,0x81,0x39,0x80,0x32,
+    0x81,0x39,0x31,0x9C,0x62,0x2A,0x39,0x32,0x39,0x32,0x39,0x32,0x39,0x80,0x32,0x80,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x80,
+    0x39,0x81,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x80,0x32,0x80,0x0D,0x31,0x85,0x1F,0x13,
+    0x39,0x81,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x80,0x32,0x80,0x39,0x32,0x39,0x32,0x39,
+    0x82,0x32,0x80,0x39,0x81,0x32,0x81,0x39,0x80,0x32,0x81,0x39,0x80,0x32,0x39,0x32,0x39,0x32,0x39,0x80,0x32,0x80,0x39,0x32,
+    0x39,0x32,0x39,0x82,0x32,0x80,0x39,0x81,0x32,0x39,0x80,0x32,0x39,0x87,0x32,0x80,0x39,0x84,0x32,0x39,0x32,0x80,0x39,0x84,
+    0x32,0x39,0x81,0x32,0x39,0x87,0x32,0x80,0x39,0x84,0x32,0x39,0x32,0x80,0x39,0x84,0x32,0x39,0x81,0x32,0x39,0x81,0x0D,0x31,
+    0x86,0xC0,0x93,0xDE,0x16,0x2A,0x23,0x80,0x6E,0x5A,0xC0,0x94,0x5D,0x07,0x7E,0xC0,0xBD,0x7F,0x38,0x27,0x31,0x88,0x14,0x39,
+    0x83,0x32,0x80,0x39,0x81,0x01,0xC0,0xAC,0xBF,0xC0,0xBD,0xBE,0x7E,0x35,0xC0,0x8B,0x9E,0x32,0x39,0x84,0x32,0x39,0x81,0x32,
+    0x39,0x87,0x32,0x80,0x39,0x84,0x32,0x39,0x32,0x80,0x39,0x84,0x32,0x39,0x81,0x32,0x39,0x83,0x2C,0x31,0x85,0x33,0x35,0x07,
+    0x80,0x65,0x07,0x14,0x33,0x0D,0x05,0xC0,0xEF,0x7F,0x2C,0x31,0x89,0x12,0x3E,0x39,0x81,0x32,0x80,0x39,0x84,0x32,0x39,0x32,
+    0x80,0x39,0x84,0x32,0x39,0x81,0x32,0x39,0x87,0x32,0x80,0x39,0x82,0x0D,0x31,0x85,0x1F,0x13,0x39,0x80,0x32,0x39,0x81,0x32,
+    0x39,0x87,0x32,0x80,0x39,0x84,0x32,0x39,0x32,0x80,0x39,0x84,0x32,0x39,0x81,0x32,0x39,0x87,0x32,0x80,0x39,0x84,0x32,0x39,
+    0x32,0x80,0x39,0x84,0x32,0x39,0x83,0x32,0x39,0x32,0x81,0x39,0x85,0x32,0x80,0x39,0x86,0x32,0x39,0x80,0x32,0x39,0x32,0x39,
+    0x82,0x32,0x39,0x32,0x81,0x39,0x85,0x32,0x80,0x39,0x86,0x32,0x39,0x80,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x0D,0x31,0x86,
+    0x39,0x32,0x80,0x39,0x86,0x32,0xC0,0x8B,0xBF,0xC0,0xD6,0x3F,0x31,0x87,0x05,0x04,0x32,0x39,0x85,0x32,0x80,0x39,0x86,0x32,
+    0x39,0x80,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x32,0x81,0x39,0x85,0x32,0x80,0x39,0x86,0x32,0x39,0x80,0x32,0x39,0x32,0x39,
+    0x82,0x32,0x39,0x32,0x80,0x2C,0x31,0x85,0x3D,0x32,0x39,0x86,0xC0,0x83,0x3E,0x18,0xC0,0xAC,0xBF,0xC0,0xE6,0xDF,0x31,0x88,
+    0x02,0x39,0x85,0x32,0x80,0x39,0x86,0x32,0x39,0x80,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x32,0x81,0x39,0x85,0x32,0x80,0x0D,
+    0x31,0x85,0x1F,0x13,0x39,0x32,0x39,0x32,0x39,0x82,0x32,0x39,0x32,0x81,0x39,0x85,0x32,0x80,0x39,0x86,0x32,0x39,0x80,0x32,
+    0x39,0x32,0x39,0x82,0x32,0x39,0x32,0x81,0x39,0x85,0x32,0x80,0x39,0x86,0x32,0x39,0x80,0x32,0x39,0x32,0x80,0x39,0x87,0x32,
+    0x39,0x82,0x32,0x39,0x8E,0x32,0x39,0x87,0x32,0x39,0x82,0x32,0x39,0x8E,0x32,0x39,0x83,0x0D,0x31,0x86,0x32,0x39,0x8A,0x01,
+    0x26,0x31,0x87,0xC0,0x9C,0x3F,0x39,0x80,0x32,0x39,0x82,0x32,0x39,0x8E,0x32,0x39,0x87,0x32,0x39,0x82,0x32,0x39,0x8E,0x32,
+    0x39,0x85,0x29,0x31,0x85,0x3D,0x39,0x8B,0xC0,0xAC,0xDF,0x2C,0x31,0x86,0x05,0x3F,0x32,0x39,0x82,0x32,0x39,0x8E,0x32,0x39,
+    0x87,0x32,0x39,0x82,0x32,0x39,0x80,0x0D,0x31,0x85,0x1F,0x13,0x39,0x82,0x32,0x39,0x87,0x32,0x39,0x82,0x32,0x39,0x8E,0x32,
+    0x39,0x87,0x32,0x39,0x82,0x32,0x39,0x97,0x32,0x39,0x8E,0x32,0x39,0x8C,0x32,0x39,0x8E,0x32,0x39,0x89,0x0D,0x31,0x86,0x39,
+    0x89,0x32,0x39,0x80,0x18,0x1F,0x31,0x86,0xC0,0xAC,0x9F,0x39,0x32,0x39,0x8E,0x32,0x39,0x8C,0x32,0x39,0x8E,0x32,0x39,0x8B,
+    0x31,0x86,0x3D,0x39,0x87,0x32,0x39,0x82,0x16,0x31,0x87,0x23,0x39,0x8E,0x32,0x39,0x8C,0x32,0x39,0x86,0x0D,0x31,0x85,0x1F,
+    0x13,0x39,0x8B,0x32,0x39,0x8E,0x32,0x39,0x8C,0x32,0x39,0x8E,0x32,0x39,0x89,0x32,0x80,0x39,0x8C,0x66,0x39,0x84,0x32,0x39,
+    0x34,0x39,0x84,0x32,0x80,0x39,0x8C,0x34,0x39,0x84,0x32,0x39,0x34,0x39,0x84,0x0D,0x31,0x86,0x39,0x85,0x34,0x39,0x84,0x32,
+    0x26,0x31,0x86,0x02,0x39,0x8C,0x34,0x39,0x84,0x32,0x39,0x34,0x39,0x84,0x32,0x80,0x39,0x83,0xC0,0x93,0xBE,0xC0,0x9C,0x1E,
+    0x11,0x56,0x11,0x37,0xC0,0x8B,0x9E,0x39,0x80,0x34,0x39,0x84,0x32,0x39,0x34,0x39,0x84,0x32,0x80,0x31,0x86,0x3D,0x39,0x83,
+    0x34,0x39,0x84,0x32,0x39,0x80,0x21,0x31,0x86,0xC0,0xB5,0x3F,0x39,0x8A,0x34,0x39,0x06,0xC0,0x93,0xBF,0xC0,0x9C,0x5F,0xC0,
+    0xAC,0xBF,0x80,0x09,0xC0,0x8B,0xBE,0x18,0x39,0x84,0x32,0x80,0x39,0x88,0x0D,0x31,0x85,0x1F,0xC0,0x8B,0x5F,0x39,0x32,0x39,
+    0x34,0x39,0x84,0x32,0x80,0x39,0x8C,0x34,0x39,0x84,0x32,0x39,0x34,0x39,0x84,0x32,0x80,0x39,0x8C,0x34,0x39,0x84,0x32,0x39,
+    0x34,0x39,0x81,0x34,0x39,0x85,0x32,0x39,0x34,0x39,0x34,0x39,0x8B,0x34,0x39,0x83,0x34,0x39,0x85,0x32,0x39,0x34,0x39,0x34,
+    0x39,0x8B,0x34,0x39,0x83,0x34,0x39,0x80,0x0D,0x31,0x86,0x34,0x39,0x8B,0x34,0x0F,0x31,0x86,0xC0,0xA4,0x7E,0x39,0x81,0x32,
+    0x39,0x34,0x39,0x18,0xC0,0xDE,0xDF,0x0D,0x85,0xC0,0xB5,0x1F,0x39,0x82,0x34,0x39,0x83,0x34,0x39,0x83,0x18,0x11,0xC0,0xCE,
+    0x1E,0x05,0x1F,0x24,0x31,0x81,0x2C,0x1F,0xC0,0xE6,0xFF,0x21,0x1B,0xC0,0x8B,0x9E,0x39,0x83,0x34,0x39,0x83,0x34,0x39,0x82,
+    0x2C,0x31,0x85,0xC0,0xC5,0x9F,0x39,0x8A,0x34,0x39,0x80,0xC0,0x9C,0x1F,0x31,0x86,0xC0,0xCE,0x5F,0x39,0x69,0x39,0x34,0x39,
+    0x34,0x39,0x82,0x0B,0xC0,0xA4,0x7F,0xC0,0xC5,0xBF,0x33,0x0A,0x1F,0x2C,0x31,0x81,0x1F,0x66,0x05,0xC0,0xCE,0x3F,0xC0,0xB5,
+    0x3E,0xC0,0x93,0xDE,0x3A,0x39,0x84,0x32,0x39,0x34,0x39,0x34,0x39,0x80,0xC0,0xEF,0x3F,0x31,0x85,0x1F,0x0E,0x39,0x34,0x39,
+    0x83,0x34,0x39,0x85,0x32,0x39,0x34,0x39,0x34,0x39,0x8B,0x34,0x39,0x83,0x34,0x39,0x85,0x32,0x39,0x34,0x39,0x34,0x39,0x8B,
+    0x34,0x39,0x80,0x34,0x39,0x34,0x39,0x34,0x39,0x34,0x39,0x80,0x34,0x39,0x84,0x34,0x39,0x81,0x34,0x80,0x39,0x81,0x34,0x39,
+    0x80,0x34,0x32,0x39,0x80,0x34,0x39,0x34,0x39,0x34,0x39,0x34,0x39,0x80,0x34,0x39,0x84,0x34,0x39,0x81,0x34,0x80,0x39,0x81,
+    0x34,0x39,0x80,0x34,0x32,0x39,0x80,0x34,0x39,0x34,0x39,0x34,0x39,0x0D,0x31,0x86,0x39,0x34,0x39,0x81,0x34,0x80,0x39,0x81,
+    0x34,0x39,0x80,0x34,0x32,0x02,0x31,0x86,0xC0,0xAC,0xBF,0x39,0x34,0x39,0x83,0xC0,0x93,0xBE,0x1F,0x31,0x85,0x3D,0x34,0x39,
+    0x80,0x34,0x32,0x39,0x80,0x34,0x39,0x34,0x39,0x34,0x39,0x34,0x18,0x07,0x12,0x31,0x8B,0x17,0x35,0x13,0x39,0x80,0x34,0x32,
+    0x39,0x80,0x34,0x39,0x34,0x39,0x34,0x39,0x34,0x39,0x2C,0x31,0x85,0x3D,0x39,0x81,0x34,0x80,0x39,0x81,0x34,0x39,0x80,0x34,
+    0x32,0x39,0x80,0x34,0x24,0x31,0x85,0x05,0x39,0x84,0x34,0x39,0x06,0x28,0x00,0x31,0x8C,0x1F,0xC0,0xD6,0x5F,0xC0,0x93,0xFE,
+    0x34,0x39,0x80,0x34,0x39,0x84,0x34,0x39,0x0D,0x31,0x85,0x1F,0x0E,0x34,0x32,0x39,0x80,0x34,0x39,0x34,0x39,0x34,0x39,0x34,
+    0x39,0x80,0x34,0x39,0x84,0x34,0x39,0x81,0x34,0x80,0x39,0x81,0x34,0x39,0x80,0x34,0x32,0x39,0x80,0x34,0x39,0x34,0x39,0x34,
+    0x39,0x34,0x39,0x80,0x34,0x39,0x84,0x34,0x39,0x81,0x34,0x80,0x39,0x81,0x34,0x39,0x80,0x34,0x32,0x39,0x80,0x34,0x39,0x34,
+    0x80,0x39,0x80,0x34,0x39,0x34,0x32,0x34,0x81,0x39,0x80,0x34,0x80,0x39,0x34,0x80,0x69,0x34,0x81,0x39,0x34,0x39,0x80,0x34,
+    0x39,0x34,0x81,0x39,0x34,0x80,0x39,0x80,0x34,0x39,0x34,0x32,0x34,0x81,0x39,0x80,0x34,0x80,0x39,0x34,0x80,0x2D,0x34,0x81,
+    0x39,0x34,0x39,0x80,0x34,0x39,0x34,0x81,0x39,0x34,0x80,0x39,0x80,0x0D,0x31,0x86,0x34,0x80,0x39,0x34,0x80,0x2D,0x34,0x81,
+    0x39,0x34,0x39,0x80,0x34,0x39,0x1C,0x31,0x85,0x2C,0xC0,0x9B,0xFF,0x34,0x32,0x34,0x81,0x39,0x80,0x19,0x1F,0x31,0x85,0x3D,
+    0x34,0x39,0x80,0x34,0x39,0x34,0x81,0x39,0x34,0x80,0x39,0x80,0xC0,0xB4,0xFF,0x24,0x31,0x90,0xC0,0xB5,0x1F,0x06,0x34,0x39,
+    0x34,0x81,0x39,0x34,0x80,0x39,0x80,0x34,0x39,0x31,0x86,0x3D,0x39,0x34,0x80,0x69,0x34,0x81,0x39,0x34,0x39,0x80,0x34,0x39,
+    0x34,0x81,0x00,0x31,0x86,0x34,0x81,0x39,0x80,0x34,0x80,0x37,0x12,0x31,0x90,0x2C,0xC0,0xBD,0x5E,0x06,0x34,0x32,0x34,0x81,
+    0x39,0x80,0x34,0x80,0x39,0x0D,0x31,0x85,0x1F,0x0E,0x34,0x39,0x34,0x81,0x39,0x34,0x80,0x39,0x80,0x34,0x39,0x34,0x32,0x34,
+    0x81,0x39,0x80,0x34,0x80,0x39,0x34,0x80,0x2D,0x34,0x81,0x39,0x34,0x39,0x80,0x34,0x39,0x34,0x81,0x39,0x34,0x80,0x39,0x80,
+    0x34,0x39,0x34,0x32,0x34,0x81,0x39,0x80,0x34,0x80,0x39,0x34,0x80,0x2D,0x34,0x81,0x39,0x34,0x39,0x80,0x34,0x39,0x34,0x81,
+    0x39,0x80,0x34,0x39,0x34,0x84,0x39,0x34,0x82,0x39,0x34,0x80,0x39,0x80,0x34,0x39,0x34,0x81,0x39,0x81,0x34,0x39,0x80,0x34,
+    0x39,0x80,0x34,0x39,0x34,0x84,0x39,0x34,0x82,0x39,0x34,0x80,0x39,0x80,0x34,0x39,0x34,0x81,0x39,0x81,0x34,0x39,0x80,0x34,
+    0x39,0x80,0x34,0x39,0x34,0x0D,0x31,0x86,0x34,0x39,0x34,0x80,0x39,0x80,0x34,0x39,0x34,0x81,0x39,0x82,0x00,0x31,0x85,0x0D,
+    0x0E,0x34,0x81,0x39,0x34,0x81,0x20,0x1F,0x31,0x85,0x3D,0x34,0x39,0x81,0x34,0x39,0x80,0x34,0x39,0x80,0x34,0x3A,0x26,0x31,
+    0x93,0x21,0x0E,0x34,0x39,0x80,0x34,0x39,0x80,0x34,0x39,0x34,0x81,0xC0,0xF7,0xDF,0x31,0x85,0x23,0x34,0x80,0x39,0x80,0x34,
+    0x39,0x34,0x81,0x39,0x81,0x34,0x39,0x80,0x34,0x0D,0x31,0x85,0x2C,0x34,0x39,0x34,0x82,0x11,0x31,0x94,0x0F,0x34,0x81,0x39,
+    0x34,0x82,0x39,0x34,0x0D,0x31,0x85,0x1F,0x0E,0x39,0x34,0x39,0x80,0x34,0x39,0x80,0x34,0x39,0x34,0x84,0x39,0x34,0x82,0x39,
+    0x34,0x80,0x39,0x80,0x34,0x39,0x34,0x81,0x39,0x81,0x34,0x39,0x80,0x34,0x39,0x80,0x34,0x39,0x34,0x84,0x39,0x34,0x82,0x39,
+    0x34,0x80,0x39,0x80,0x34,0x39,0x34,0x81,0x39,0x81,0x34,0x39,0x80,0x34,0x89,0x39,0x34,0x83,0x39,0x34,0x97,0x39,0x34,0x83,
+    0x39,0x34,0x92,0x0D,0x31,0x86,0x34,0x80,0x39,0x34,0x89,0xC0,0xAC,0xDF,0x31,0x86,0x02,0x34,0x82,0x39,0x34,0x81,0xC0,0x93,
+    0xDF,0x1F,0x31,0x85,0x3D,0x34,0x88,0x0E,0x0D,0x31,0x95,0x00,0x06,0x34,0x88,0x31,0x86,0x11,0x39,0x34,0x8D,0x0D,0x31,0x86,
+    0x34,0x39,0x34,0x81,0x09,0x31,0x96,0xC0,0xA4,0x7E,0x34,0x80,0x39,0x34,0x83,0x39,0x0D,0x31,0x85,0x1F,0x0E,0x34,0x8D,0x39,
+    0x34,0x83,0x39,0x34,0x97,0x39,0x34,0x83,0x39,0x34,0x8F,0x39,0x34,0x82,0x39,0x34,0x84,0x39,0x34,0x80,0x39,0x34,0x82,0x39,
+    0x34,0x89,0x39,0x34,0x82,0x39,0x34,0x84,0x39,0x34,0x80,0x39,0x34,0x82,0x39,0x34,0x89,0x39,0x34,0x80,0x0D,0x31,0x86,0x39,
+    0x34,0x80,0x39,0x34,0x82,0x39,0x34,0x82,0xC0,0xA4,0x5F,0x24,0x31,0x86,0x18,0x34,0x39,0x34,0x84,0x25,0x1F,0x31,0x85,0xC0,
+    0xC5,0x9F,0x34,0x87,0x3A,0xC0,0xCE,0x3E,0x31,0x97,0x3B,0x3A,0x34,0x82,0x39,0x34,0x82,0x31,0x86,0x11,0x34,0x39,0x34,0x82,
+    0x39,0x34,0x86,0x01,0x31,0x86,0x3B,0x34,0x82,0x18,0x1F,0x31,0x96,0x0D,0x01,0x34,0x83,0x39,0x34,0x80,0x0D,0x31,0x85,0x1F,
+    0x0E,0x34,0x85,0x39,0x34,0x82,0x39,0x34,0x84,0x39,0x34,0x80,0x39,0x34,0x82,0x39,0x34,0x89,0x39,0x34,0x82,0x39,0x34,0x84,
+    0x39,0x34,0x80,0x39,0x34,0x82,0x39,0x34,0xA5,0x39,0x34,0x9D,0x39,0x34,0x84,0x0D,0x31,0x86,0x34,0x89,0x3A,0x23,0x24,0x31,
+    0x86,0x35,0x34,0x87,0x20,0x1F,0x31,0x85,0x3D,0x34,0x84,0x39,0x34,0x80,0x07,0x31,0x88,0x05,0x1C,0x35,0x3D,0x35,0x1C,0x0D,
+    0x31,0x88,0x14,0x39,0x34,0x86,0x31,0x86,0x11,0x34,0x8C,0x39,0x16,0x31,0x86,0x14,0x34,0x81,0x7E,0x07,0x31,0x86,0x2C,0xC0,
+    0xCE,0x3F,0xC0,0xAC,0xFE,0xC0,0x94,0x3E,0xC0,0x8B,0x9E,0x6E,0xC0,0x9C,0x5E,0x23,0x33,0x31,0x87,0xC0,0xAC,0xBF,0x34,0x86,
+    0x0D,0x31,0x85,0x1F,0x0E,0x34,0x81,0x39,0x34,0x9D,0x39,0x34,0x9D,0x39,0x34,0xBF,0x84,0x0D,0x31,0x86,0x1E,0xC0,0xBD,0x7F,
+    0x3D,0x80,0x5A,0x35,0xC0,0xCE,0x1F,0x07,0x80,0xC0,0xC6,0x1E,0x00,0x0D,0x31,0x87,0x1C,0x06,0x34,0x87,0x20,0x1F,0x31,0x85,
+    0x3D,0x34,0x86,0x09,0x27,0x31,0x86,0x0D,0xC0,0xAC,0xDF,0x0E,0x34,0x82,0x3C,0x0E,0x11,0x00,0x31,0x87,0xC0,0x9C,0x1F,0x34,
+    0x86,0x31,0x86,0x11,0x34,0x8C,0x0E,0xC0,0xEF,0x5F,0x31,0x86,0xC0,0xAC,0xBE,0x34,0x81,0xC0,0x93,0x9F,0x17,0x31,0x85,0x05,
+    0x37,0x3C,0x34,0x84,0x01,0x16,0x2C,0x31,0x85,0xC0,0xDE,0x9F,0x34,0x86,0x0D,0x31,0x85,0x1F,0x0E,0x34,0xBF,0xBF,0x88,0x0D,
+    0x31,0x9A,0x07,0x01,0x34,0x88,0xC0,0x8B,0xBE,0x1F,0x31,0x85,0x3D,0x34,0x86,0x33,0x31,0x86,0x33,0x18,0x34,0x87,0x0E,0x21,
+    0x31,0x86,0x00,0x3C,0x34,0x85,0x2C,0x31,0x85,0x11,0x34,0x8B,0x7D,0x14,0x31,0x86,0x2C,0x1B,0x34,0x81,0xC0,0xAC,0xFF,0x31,
+    0x85,0x17,0x20,0x34,0x88,0xC0,0xBD,0x5F,0x31,0x85,0x24,0x34,0x86,0x0D,0x31,0x85,0x1F,0x0E,0x34,0xBF,0xBF,0x88,0x0D,0x31,
+    0x98,0x17,0xC0,0xAC,0xDF,0x34,0x8A,0xC0,0x8B,0x9E,0x1A,0x31,0x85,0x3D,0x34,0x85,0x37,0x31,0x86,0x00,0x0E,0x34,0x89,0x01,
+    0x00,0x31,0x86,0x04,0x34,0x85,0x31,0x86,0xC0,0xAC,0xBF,0x34,0x89,0x3C,0xC0,0x9B,0xFF,0x0D,0x31,0x87,0x21,0x34,0x82,0x0F,
+    0x31,0x85,0xC0,0xBD,0x7E,0x34,0x89,0x06,0x17,0x31,0x85,0x13,0x34,0x85,0x0D,0x31,0x85,0x1F,0x0E,0x34,0xBF,0x9C,0x7A,0x34,
+    0x37,0x34,0x9B,0x37,0x34,0x37,0x34,0x87,0x0D,0x31,0x97,0x29,0x02,0x01,0x34,0x8A,0xC0,0x8B,0x9E,0x1F,0x31,0x85,0x3D,0x34,
+    0x37,0x34,0x37,0x34,0x81,0x21,0x31,0x86,0x04,0x34,0x8B,0x2D,0x2C,0x31,0x85,0x19,0x34,0x85,0x2C,0x31,0x85,0xC0,0xAC,0xBF,
+    0x34,0x86,0x0E,0x25,0x1B,0x26,0x2C,0x31,0x88,0xC0,0x8B,0x9E,0x34,0x82,0x18,0x16,0x6D,0x52,0xC0,0xBD,0xBF,0x21,0x19,0x69,
+    0xC0,0x93,0xFE,0x34,0x82,0x37,0x34,0x37,0x34,0x82,0x3C,0x0D,0x31,0x85,0x20,0x34,0x85,0x0D,0x31,0x85,0x1F,0x0E,0x37,0x34,
+    0x9B,0x37,0x34,0x37,0x34,0x9B,0x37,0x34,0x37,0x34,0x88,0x37,0x34,0x80,0x37,0x34,0x9A,0x37,0x34,0x80,0x37,0x34,0x99,0x0D,
+    0x31,0x99,0x24,0x1E,0x3C,0x34,0x80,0x37,0x34,0x80,0x37,0x34,0x82,0xC0,0x83,0x7E,0x17,0x31,0x85,0x3D,0x34,0x84,0x0E,0xC0,
+    0xEF,0x5F,0x31,0x85,0xC0,0xDE,0x9F,0x01,0x37,0x34,0x8B,0x26,0x31,0x86,0x01,0x34,0x83,0x37,0x2C,0x31,0x86,0x2C,0x24,0x65,
+    0x24,0x2C,0x24,0x69,0x80,0x31,0x8C,0x0F,0x34,0x80,0x37,0x34,0x95,0x0D,0x31,0x85,0xC0,0xAC,0xBF,0x34,0x85,0x0D,0x31,0x85,
+    0x1F,0x0E,0x34,0x89,0x37,0x34,0x80,0x37,0x34,0x9A,0x37,0x34,0x80,0x37,0x34,0x96,0x37,0x34,0x80,0x37,0x34,0x86,0x37,0x34,
+    0x82,0x37,0x34,0x37,0x34,0x84,0x37,0x34,0x83,0x37,0x34,0x80,0x37,0x34,0x86,0x37,0x34,0x82,0x37,0x34,0x37,0x34,0x84,0x37,
+    0x34,0x83,0x37,0x34,0x80,0x0D,0x31,0x9B,0xC0,0xEF,0x1F,0xC0,0x8B,0x9F,0x37,0x34,0x86,0x20,0x1F,0x31,0x85,0x3D,0x34,0x82,
+    0x37,0x34,0xC0,0xA4,0x5E,0x2C,0x31,0x85,0x1E,0x34,0x84,0x37,0x34,0x82,0x37,0x34,0x37,0x34,0x1E,0x31,0x86,0x32,0x34,0x37,
+    0x34,0x80,0x37,0x34,0x2C,0x31,0x9B,0x3B,0x01,0x34,0x85,0x37,0x34,0x82,0x37,0x34,0x37,0x34,0x84,0x37,0x34,0x82,0x0D,0x31,
+    0x85,0x04,0x34,0x82,0x37,0x34,0x80,0x0D,0x31,0x85,0x1F,0x0E,0x34,0x37,0x34,0x83,0x37,0x34,0x80,0x37,0x34,0x86,0x37,0x34,
+    0x82,0x37,0x34,0x37,0x34,0x84,0x37,0x34,0x83,0x37,0x34,0x80,0x37,0x34,0x86,0x37,0x34,0x82,0x37,0x34,0x37,0x34,0x84,0x37,
+    0x34,0x81,0x37,0x80,0x34,0x80,0x37,0x34,0x80,0x37,0x81,0x34,0x37,0x34,0x80,0x37,0x34,0x80,0x37,0x34,0x82,0x37,0x34,0x37,
+    0x34,0x81,0x37,0x34,0x81,0x37,0x80,0x34,0x80,0x37,0x34,0x80,0x37,0x81,0x34,0x37,0x34,0x80,0x37,0x34,0x80,0x37,0x34,0x82,
+    0x37,0x34,0x37,0x34,0x81,0x37,0x34,0x81,0x37,0x80,0x34,0x80,0x37,0x0D,0x31,0x8A,0x2C,0x31,0x8F,0x1F,0x2D,0x34,0x37,0x81,
+    0x34,0x37,0x34,0x80,0xC0,0x93,0xBE,0x1F,0x31,0x85,0x3D,0x37,0x34,0x81,0x37,0x34,0xC0,0xBD,0x7F,0x31,0x86,0x20,0x37,0x80,
+    0x34,0x37,0x34,0x80,0x37,0x34,0x80,0x37,0x34,0x82,0x37,0x0E,0x12,0x31,0x85,0xC0,0xB5,0x1F,0x37,0x34,0x80,0x37,0x34,0x80,
+    0x2C,0x31,0x9A,0x05,0xC0,0x93,0x9F,0x34,0x37,0x81,0x34,0x37,0x34,0x80,0x37,0x34,0x80,0x37,0x34,0x82,0x37,0x34,0x37,0x34,
+    0x01,0x0E,0x80,0x20,0x19,0xC0,0x9C,0x3E,0xC0,0xBD,0x3F,0x1F,0x31,0x85,0xC0,0xA4,0x5F,0x34,0x37,0x34,0x80,0x37,0x34,0x80,
+    0x0D,0x31,0x85,0x1F,0x0E,0x34,0x37,0x34,0x81,0x37,0x80,0x34,0x80,0x37,0x34,0x80,0x37,0x81,0x34,0x37,0x34,0x80,0x37,0x34,
+    0x80,0x37,0x34,0x82,0x37,0x34,0x37,0x34,0x81,0x37,0x34,0x81,0x37,0x80,0x34,0x80,0x37,0x34,0x80,0x37,0x81,0x34,0x37,0x34,
+    0x80,0x37,0x34,0x80,0x37,0x34,0x82,0x37,0x34,0x37,0x34,0x81,0x37,0x34,0x80,0x37,0x34,0x81,0x37,0x80,0x34,0x80,0x37,0x34,
+    0x81,0x37,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0x34,0x82,0x37,0x80,0x34,0x80,0x37,0x34,0x80,0x37,0x34,0x81,0x37,0x80,0x34,
+    0x80,0x37,0x34,0x81,0x37,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0x34,0x82,0x37,0x80,0x34,0x80,0x37,0x34,0x80,0x37,0x34,0x81,
+    0x37,0x80,0x0D,0x31,0x86,0x20,0x81,0x1B,0x69,0x25,0x80,0x69,0x6E,0xC0,0x94,0x3E,0x3D,0x28,0x33,0x1F,0x31,0x87,0x0D,0x20,
+    0x37,0x34,0x81,0x37,0x34,0x80,0xC0,0x8B,0x9E,0x1A,0x31,0x85,0x3D,0x37,0x80,0x34,0x80,0x37,0x34,0xC0,0xCE,0x1F,0x31,0x86,
+    0x37,0x34,0x81,0x37,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0x34,0x82,0x08,0x31,0x85,0x02,0x34,0x80,0x37,0x80,0x34,0x80,0x2C,
+    0x31,0x99,0x33,0xC0,0x8B,0x5E,0x34,0x80,0x37,0x34,0x81,0x37,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0x34,0x30,0xC0,0xB5,0x3E,
+    0x14,0x2E,0x05,0x12,0x1F,0x80,0x31,0x2C,0x31,0x88,0x3F,0x34,0x37,0x34,0x81,0x37,0x34,0x0D,0x31,0x85,0x1F,0x0E,0x34,0x37,
+    0x34,0x80,0x37,0x34,0x81,0x37,0x80,0x34,0x80,0x37,0x34,0x81,0x37,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0x34,0x82,0x37,0x80,
+    0x34,0x80,0x37,0x34,0x80,0x37,0x34,0x81,0x37,0x80,0x34,0x80,0x37,0x34,0x81,0x37,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0x34,
+    0x82,0x37,0x80,0x34,0x80,0x37,0x34,0x81,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x34,0x37,0x34,0x37,0x80,0x34,0x80,0x37,0x80,
+    0x34,0x81,0x37,0x34,0x37,0x80,0x34,0x37,0x34,0x37,0x34,0x37,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x34,0x37,
+    0x34,0x37,0x80,0x34,0x80,0x37,0x80,0x34,0x81,0x37,0x34,0x37,0x80,0x34,0x37,0x34,0x37,0x34,0x37,0x34,0x37,0x34,0x37,0x80,
+    0x34,0x37,0x80,0x0D,0x31,0x86,0x37,0x80,0x34,0x81,0x37,0x34,0x37,0x80,0x34,0x37,0x34,0x37,0x3C,0xC0,0xB4,0xFF,0x17,0x31,
+    0x86,0x26,0x34,0x37,0x34,0x37,0x80,0x34,0x80,0x18,0x1F,0x31,0x85,0x3D,0x37,0x34,0x37,0x34,0x37,0x34,0x14,0x31,0x85,0xC0,
+    0xCE,0x5E,0x34,0x37,0x34,0x37,0x80,0x34,0x80,0x37,0x80,0x34,0x81,0x37,0x34,0x37,0x80,0x34,0x26,0x31,0x85,0xC0,0xD6,0x5F,
+    0x37,0x34,0x37,0x80,0x34,0x37,0x2C,0x31,0x97,0x1F,0xC0,0xB5,0x1F,0x3C,0x37,0x34,0x37,0x34,0x37,0x34,0x37,0x80,0x34,0x80,
+    0x37,0x80,0x34,0x1B,0xC0,0xBD,0x5F,0x33,0x1F,0x31,0x92,0x3F,0x37,0x80,0x34,0x80,0x37,0x80,0x34,0x0D,0x31,0x85,0x1F,0xC0,
+    0x8B,0x3F,0x34,0x37,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x34,0x37,0x34,0x37,0x80,0x34,0x80,0x37,0x80,0x34,
+    0x81,0x37,0x34,0x37,0x80,0x34,0x37,0x34,0x37,0x34,0x37,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x34,0x37,0x34,
+    0x37,0x80,0x34,0x80,0x37,0x80,0x34,0x81,0x37,0x34,0x37,0x80,0x34,0x37,0x34,0x37,0x34,0x37,0x34,0x37,0x80,0x34,0x81,0x37,
+    0x80,0x34,0x37,0x34,0x80,0x37,0x34,0x80,0x37,0x80,0x34,0x80,0x37,0x81,0x34,0x37,0x34,0x81,0x37,0x80,0x34,0x37,0x80,0x34,
+    0x37,0x80,0x34,0x81,0x37,0x80,0x34,0x37,0x34,0x80,0x37,0x34,0x80,0x37,0x80,0x34,0x80,0x37,0x81,0x34,0x37,0x34,0x81,0x37,
+    0x80,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x81,0x37,0x80,0x0D,0x31,0x86,0x34,0x80,0x37,0x81,0x34,0x37,0x34,0x81,0x37,0x80,
+    0x34,0x37,0x80,0x20,0x1F,0x31,0x86,0xC0,0x9B,0xFF,0x34,0x37,0x34,0x80,0x37,0x80,0x11,0x1A,0x31,0x85,0x3D,0x37,0x80,0x34,
+    0x37,0x80,0x34,0xC0,0xCE,0x3F,0x31,0x85,0x2E,0x34,0x80,0x37,0x34,0x80,0x37,0x80,0x34,0x80,0x37,0x81,0x34,0x37,0x34,0x81,
+    0x26,0x31,0x85,0x19,0x34,0x80,0x37,0x80,0x34,0x37,0x29,0x31,0x95,0x12,0x3D,0x20,0x34,0x37,0x80,0x34,0x37,0x34,0x80,0x37,
+    0x34,0x80,0x37,0x80,0x34,0x1B,0x02,0x1A,0x31,0x95,0x3F,0x34,0x80,0x37,0x80,0x34,0x80,0x37,0x0D,0x31,0x85,0x1F,0x09,0x37,
+    0x80,0x34,0x37,0x80,0x34,0x81,0x37,0x80,0x34,0x37,0x34,0x80,0x37,0x34,0x80,0x37,0x80,0x34,0x80,0x37,0x81,0x34,0x37,0x34,
+    0x81,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x81,0x37,0x80,0x34,0x37,0x34,0x80,0x37,0x34,0x80,0x37,0x80,0x34,0x80,
+    0x37,0x81,0x34,0x37,0x34,0x81,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x83,0x34,0x37,0x86,0x34,0x37,0x81,0x34,0x81,0x37,0x34,
+    0x80,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x82,0x34,0x37,0x86,0x34,0x37,0x81,0x34,0x81,0x37,0x34,0x80,0x37,
+    0x80,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x82,0x34,0x37,0x0D,0x31,0x86,0x37,0x80,0x34,0x81,0x37,0x34,0x80,0x37,0x80,
+    0x34,0x37,0x80,0x34,0x37,0x80,0x30,0x31,0x86,0x02,0x37,0x82,0x34,0x37,0xC0,0x8B,0x7E,0xC0,0xEF,0x7F,0x31,0x85,0x3D,0x34,
+    0x37,0x80,0x34,0x37,0x80,0x1C,0x31,0x85,0x3B,0x37,0x83,0x34,0x37,0x81,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0xC0,0xDE,0x7F,
+    0x31,0x85,0x1C,0x37,0x80,0x34,0x37,0x81,0xC0,0xF7,0xDF,0x31,0x8F,0x2C,0x24,0x1A,0x3B,0x0F,0xC0,0xAC,0xBF,0x09,0x37,0x81,
+    0x34,0x37,0x86,0x34,0x37,0xC0,0xA4,0x3F,0x12,0x31,0x97,0x3F,0x37,0x80,0x34,0x37,0x81,0x34,0x0D,0x31,0x85,0x1F,0x0E,0x34,
+    0x37,0x80,0x34,0x37,0x82,0x34,0x37,0x86,0x34,0x37,0x81,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x80,
+    0x34,0x37,0x82,0x34,0x37,0x86,0x34,0x37,0x81,0x34,0x81,0x37,0x34,0x80,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,
+    0x66,0x37,0x82,0x34,0x37,0x80,0x34,0x37,0x34,0x32,0x37,0x8A,0x34,0x37,0x85,0x32,0x37,0x82,0x34,0x37,0x80,0x34,0x37,0x34,
+    0x32,0x37,0x8A,0x34,0x37,0x85,0x32,0x37,0x82,0x0D,0x31,0x86,0x37,0x88,0x34,0x37,0x83,0xC0,0x93,0x7F,0x1A,0x31,0x85,0x3B,
+    0x01,0x37,0x34,0x32,0x37,0x80,0x0C,0x17,0x31,0x85,0x3D,0x34,0x37,0x83,0x14,0x31,0x85,0x33,0x37,0x34,0x37,0x34,0x32,0x37,
+    0x8A,0x21,0x31,0x85,0x14,0x37,0x82,0x34,0x37,0x29,0x31,0x85,0xC0,0xC5,0xDE,0xC0,0x9C,0x1F,0x3A,0x84,0x32,0x0E,0x37,0x85,
+    0x66,0x37,0x82,0x34,0x37,0x80,0x34,0x37,0x34,0x32,0x37,0x3F,0x2C,0x31,0x8A,0x1F,0x80,0xC0,0xE7,0x3F,0x08,0x2E,0x1C,0x24,
+    0x31,0x85,0x3F,0x34,0x32,0x37,0x83,0x0D,0x31,0x85,0x1F,0x09,0x37,0x83,0x32,0x37,0x82,0x34,0x37,0x80,0x34,0x37,0x34,0x32,
+    0x37,0x8A,0x34,0x37,0x85,0x32,0x37,0x82,0x34,0x37,0x80,0x34,0x37,0x34,0x32,0x37,0x8A,0x34,0x37,0x85,0x34,0x37,0x86,0x32,
+    0x37,0x83,0x32,0x37,0x81,0x32,0x37,0x82,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x86,0x32,0x37,0x83,0x32,0x37,
+    0x81,0x32,0x37,0x82,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x82,0x0D,0x31,0x86,0x37,0x32,0x37,0x81,0x32,0x37,
+    0x82,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0xC0,0xDE,0xDF,0x31,0x85,0x0D,0x09,0x32,0x37,0x82,0xC0,0x83,0x7E,0x17,0x31,0x85,
+    0x3D,0x34,0x37,0x34,0x37,0x80,0x34,0x14,0x31,0x85,0x05,0x37,0x80,0x32,0x37,0x83,0x32,0x37,0x81,0x32,0x37,0x82,0x26,0x31,
+    0x85,0x21,0x37,0x84,0x29,0x31,0x85,0xC0,0xC5,0x7F,0x37,0x81,0x32,0x37,0x82,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0x80,0x34,
+    0x37,0x86,0x32,0x37,0x80,0x3A,0x2C,0x31,0x86,0x2C,0xC0,0xE6,0xFF,0xC0,0xBD,0x9E,0xC0,0xAC,0x9F,0x20,0x0E,0x66,0x3C,0x37,
+    0x80,0x34,0x0D,0x31,0x85,0x3A,0x37,0x83,0x32,0x37,0x0D,0x31,0x85,0x1F,0x09,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x86,0x32,
+    0x37,0x83,0x32,0x37,0x81,0x32,0x37,0x82,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0x80,0x34,0x37,0x86,0x32,0x37,0x83,0x32,0x37,
+    0x81,0x32,0x37,0x82,0x34,0x37,0x34,0x37,0x80,0x34,0x37,0x80,0x32,0x37,0x80,0x34,0x37,0x84,0x34,0x37,0x32,0x34,0x37,0x34,
+    0x37,0x83,0x32,0x37,0x83,0x32,0x37,0x82,0x32,0x37,0x80,0x34,0x37,0x84,0x34,0x37,0x32,0x34,0x37,0x34,0x37,0x83,0x32,0x37,
+    0x83,0x32,0x37,0x82,0x32,0x37,0x80,0x34,0x37,0x0D,0x31,0x86,0x37,0x34,0x37,0x83,0x32,0x37,0x83,0x32,0x37,0x81,0x0D,0x31,
+    0x85,0x27,0x1B,0x37,0x34,0x37,0x32,0x34,0xC0,0x8B,0x7E,0x17,0x31,0x85,0x3D,0x37,0x81,0x32,0x37,0x80,0x14,0x31,0x86,0x3C,
+    0x37,0x80,0x34,0x37,0x32,0x34,0x37,0x34,0x37,0x83,0x32,0x37,0x80,0x05,0x31,0x85,0x3D,0x37,0x80,0x34,0x37,0x81,0x29,0x31,
+    0x85,0x3D,0x37,0x83,0x32,0x37,0x83,0x32,0x37,0x82,0x32,0x37,0x80,0x34,0x37,0x84,0x34,0x3C,0x26,0x31,0x85,0x2C,0x35,0x01,
+    0x37,0x82,0x32,0x37,0x82,0x32,0x0D,0x31,0x85,0xC0,0x9C,0x3E,0x34,0x37,0x32,0x34,0x37,0x34,0x37,0x0D,0x31,0x85,0x1F,0x09,
+    0x32,0x37,0x82,0x32,0x37,0x80,0x34,0x37,0x84,0x34,0x37,0x32,0x34,0x37,0x34,0x37,0x83,0x32,0x37,0x83,0x32,0x37,0x82,0x32,
+    0x37,0x80,0x34,0x37,0x84,0x34,0x37,0x32,0x34,0x37,0x34,0x37,0x83,0x32,0x37,0x83,0x32,0x37,0x84,0x32,0x81,0x37,0x82,0x32,
+    0x82,0x37,0x80,0x32,0x37,0x32,0x37,0x83,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x82,0x32,0x81,0x37,0x82,0x32,0x82,0x37,
+    0x80,0x32,0x37,0x32,0x37,0x83,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x82,0x32,0x81,0x0D,0x31,0x86,0x37,0x32,0x37,0x32,
+    0x37,0x83,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x0D,0x31,0x86,0x20,0x32,0x82,0x37,0x0C,0x17,0x31,0x85,0x38,0x37,0x32,
+    0x37,0x32,0x37,0x32,0x35,0x31,0x86,0xC0,0x93,0xDE,0x37,0x32,0x82,0x37,0x80,0x32,0x37,0x32,0x37,0x83,0x20,0x1F,0x31,0x85,
+    0x23,0x37,0x32,0x81,0x37,0x80,0x29,0x31,0x85,0x38,0x37,0x32,0x37,0x83,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x82,0x32,
+    0x81,0x37,0x82,0x32,0x80,0xC0,0xA4,0x5E,0x2C,0x31,0x84,0x27,0x11,0x37,0x80,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x81,
+    0x08,0x31,0x85,0xC0,0xA4,0x3E,0x32,0x81,0x37,0x80,0x32,0x37,0x0D,0x31,0x85,0x1F,0x09,0x32,0x37,0x32,0x37,0x82,0x32,0x81,
+    0x37,0x82,0x32,0x82,0x37,0x80,0x32,0x37,0x32,0x37,0x83,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x82,0x32,0x81,0x37,0x82,
+    0x32,0x82,0x37,0x80,0x32,0x37,0x32,0x37,0x83,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x82,0x37,0x80,0x32,0x83,0x37,
+    0x80,0x32,0x81,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x81,0x37,0x82,0x32,0x37,0x32,0x82,0x37,0x80,0x32,0x83,0x37,0x80,
+    0x32,0x81,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x81,0x37,0x82,0x32,0x37,0x32,0x82,0x37,0x80,0x0D,0x31,0x86,0x32,0x37,
+    0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x81,0x37,0x82,0x32,0x3C,0x00,0x31,0x85,0x24,0x1B,0x32,0x37,0x80,0x32,0x80,0xC0,0x83,
+    0x7E,0x17,0x31,0x85,0xC0,0xC5,0x7F,0x32,0x37,0x82,0x32,0xC0,0x9C,0x1E,0x2C,0x31,0x85,0xC0,0xBD,0x5F,0x32,0x80,0x37,0x80,
+    0x32,0x81,0x37,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x30,0x31,0x86,0xC0,0x9C,0x1F,0xC0,0x82,0xBF,0x80,0x37,0x80,0x32,0x80,
+    0x29,0x31,0x85,0x3D,0x32,0x37,0x32,0x37,0x32,0x37,0x32,0x81,0x37,0x82,0x32,0x37,0x32,0x82,0x37,0x80,0x32,0x83,0x37,0xC0,
+    0xCD,0xDF,0x31,0x85,0x14,0x32,0x37,0x32,0x81,0x37,0x82,0x32,0x37,0x32,0x01,0x12,0x31,0x85,0x33,0x37,0x80,0x32,0x81,0x37,
+    0x32,0x0D,0x31,0x85,0x1F,0xC0,0x8B,0x3F,0x37,0x80,0x32,0x37,0x32,0x82,0x37,0x80,0x32,0x83,0x37,0x80,0x32,0x81,0x37,0x32,
+    0x37,0x32,0x37,0x32,0x37,0x32,0x81,0x37,0x82,0x32,0x37,0x32,0x82,0x37,0x80,0x32,0x83,0x37,0x80,0x32,0x81,0x37,0x32,0x37,
+    0x32,0x37,0x32,0x37,0x32,0x81,0x37,0x82,0x32,0x37,0x32,0x82,0x37,0x80,0x32,0x80,0x37,0x32,0x84,0x37,0x32,0x82,0x37,0x32,
+    0x81,0x37,0x80,0x32,0x80,0x37,0x32,0x85,0x37,0x80,0x32,0x80,0x37,0x32,0x84,0x37,0x32,0x82,0x37,0x32,0x81,0x37,0x80,0x32,
+    0x80,0x37,0x32,0x85,0x37,0x80,0x0D,0x31,0x86,0x37,0x32,0x82,0x37,0x32,0x81,0x37,0x80,0x32,0x80,0x37,0x32,0x80,0x0E,0x12,
+    0x31,0x85,0x17,0x0E,0x32,0x83,0xC0,0x83,0x5E,0x17,0x31,0x85,0x3D,0x37,0x32,0x80,0x37,0x32,0x80,0x09,0x12,0x31,0x85,0x3B,
+    0xC0,0x8B,0x1F,0x32,0x83,0x37,0x32,0x82,0x37,0x32,0x81,0x2E,0x31,0x85,0x2C,0x04,0x32,0x80,0x37,0x80,0x32,0x80,0x29,0x31,
+    0x85,0x38,0x32,0x81,0x37,0x32,0x81,0x37,0x80,0x32,0x80,0x37,0x32,0x85,0x37,0x80,0x32,0x80,0x37,0x32,0x81,0xC0,0xDE,0xBF,
+    0x31,0x85,0xC0,0xAC,0xDF,0x32,0x81,0x37,0x80,0x32,0x80,0x37,0x32,0x82,0x1B,0x2C,0x31,0x85,0xC0,0xA4,0x3E,0x32,0x82,0x37,
+    0x32,0x80,0x0D,0x31,0x85,0x1F,0x09,0x37,0x32,0x85,0x37,0x80,0x32,0x80,0x37,0x32,0x84,0x37,0x32,0x82,0x37,0x32,0x81,0x37,
+    0x80,0x32,0x80,0x37,0x32,0x85,0x37,0x80,0x32,0x80,0x37,0x32,0x84,0x37,0x32,0x82,0x37,0x32,0x81,0x37,0x80,0x32,0x80,0x37,
+    0x32,0x88,0x37,0x32,0x80,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0x8D,0x37,0x32,0x80,0x37,0x32,0x82,0x37,0x32,
+    0x83,0x37,0x32,0x37,0x32,0x8C,0x0D,0x31,0x86,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0x85,0x3D,0x31,0x86,0x00,0x04,0x37,0x32,
+    0x82,0xC0,0x83,0x7E,0x17,0x31,0x85,0x38,0x32,0x85,0xC0,0xD6,0x1F,0x31,0x86,0xC0,0xB4,0xFF,0x37,0x32,0x82,0x37,0x32,0x83,
+    0x37,0x32,0xC0,0xA4,0x7F,0x31,0x86,0x14,0x32,0x84,0x37,0x29,0x31,0x85,0x38,0x32,0x82,0x37,0x32,0x37,0x32,0x8D,0x37,0x32,
+    0x80,0x37,0x32,0x00,0x31,0x85,0x04,0x37,0x32,0x37,0x32,0x87,0x30,0x31,0x86,0xC0,0x9C,0x3E,0x32,0x82,0x37,0x32,0x80,0x0D,
+    0x31,0x85,0x1F,0xC0,0x8B,0x3F,0x32,0x89,0x37,0x32,0x80,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0x8D,0x37,0x32,
+    0x80,0x37,0x32,0x82,0x37,0x32,0x83,0x37,0x32,0x37,0x32,0xBF,0x8C,0x0D,0x31,0x86,0x32,0x8D,0xC0,0xAC,0x9F,0x1F,0x31,0x86,
+    0x0A,0x37,0x32,0x83,0xC0,0x83,0x5E,0xC0,0xEF,0x7F,0x31,0x85,0x38,0x32,0x85,0xC0,0xA4,0x1F,0x2C,0x31,0x85,0x12,0x2D,0x32,
+    0x89,0xC0,0x93,0x7F,0x0D,0x31,0x86,0x3A,0x32,0x85,0x29,0x31,0x85,0x38,0x32,0x99,0xC0,0xDE,0xDE,0xC0,0xFF,0xFF,0x85,0xC0,
+    0xBD,0x3F,0x32,0x89,0x3C,0x12,0x31,0x86,0x30,0x32,0x85,0x0D,0x31,0x85,0x1F,0x09,0x32,0xBF,0x88,0x37,0x32,0x9D,0x37,0x32,
+    0x9D,0x0D,0x31,0x86,0x32,0x8B,0x3C,0x2B,0x1F,0x31,0x87,0x3F,0x32,0x84,0x04,0x17,0x31,0x85,0x38,0x32,0x86,0xC0,0xDE,0xBF,
+    0x31,0x86,0x08,0xC0,0x9B,0xDF,0x32,0x87,0x09,0x08,0x31,0x86,0x08,0xC0,0x8B,0x1F,0x32,0x83,0x37,0x32,0x29,0x31,0x85,0x38,
+    0x32,0x93,0x37,0x32,0x83,0x05,0x31,0x85,0x2E,0x3C,0x32,0x87,0x37,0xC0,0xB5,0x5E,0x31,0x87,0xC0,0xA4,0x3E,0x32,0x85,0x0D,
+    0x31,0x85,0x1F,0x09,0x32,0x88,0x37,0x32,0x9D,0x37,0x32,0xBF,0x9D,0x0D,0x31,0x86,0xC0,0xAC,0x7F,0x0C,0x07,0x0C,0x82,0x56,
+    0x0C,0x23,0x38,0x42,0x0F,0x31,0x89,0x0D,0x32,0x85,0xC0,0x83,0x5E,0x17,0x31,0x85,0x38,0x32,0x86,0x3A,0x27,0x31,0x86,0x27,
+    0xC0,0xBD,0x5F,0x0E,0x32,0x83,0x09,0x11,0x1F,0x31,0x87,0x2D,0x32,0x86,0x29,0x31,0x85,0x38,0x32,0x99,0x0F,0x31,0x86,0x30,
+    0x32,0x86,0x3C,0x38,0x31,0x88,0xC0,0x9C,0x3E,0x32,0x85,0x0D,0x31,0x85,0x1F,0x09,0x32,0xBF,0xBF,0x88,0x0D,0x31,0x9D,0x2C,
+    0x3A,0x32,0x85,0xC0,0x83,0x3E,0x17,0x31,0x85,0x38,0x32,0x87,0x02,0x31,0x88,0x24,0x3B,0x0A,0x0F,0x56,0xC0,0xDE,0x7F,0x1A,
+    0x31,0x88,0x0F,0x32,0x87,0xC0,0xF7,0xDF,0x31,0x85,0x38,0x32,0x99,0x2B,0x31,0x87,0x02,0x0E,0x32,0x82,0x3C,0x3A,0x3B,0x31,
+    0x89,0x30,0x32,0x85,0x0D,0x31,0x85,0x1F,0x09,0x32,0xBF,0xBF,0x88,0x0D,0x31,0x9D,0x3D,0x37,0x32,0x85,0x04,0x17,0x31,0x85,
+    0x38,0x32,0x87,0xC0,0x8B,0x1F,0xC0,0xE6,0xBF,0x31,0x97,0xC0,0xDE,0xBF,0x3C,0x32,0x87,0x2C,0x31,0x85,0x38,0x32,0x99,0xC0,
+    0x93,0x5F,0x12,0x31,0x88,0x12,0xC0,0xDE,0xDF,0x51,0x08,0x2C,0x31,0x8B,0x30,0x32,0x85,0x0D,0x31,0x85,0x1F,0x09,0x32,0xBF,
+    0xBF,0x88,0x0D,0x31,0x9C,0xC0,0xBD,0x5F,0x37,0x32,0x86,0xC0,0x83,0x5E,0x17,0x31,0x85,0xC0,0xC5,0x7F,0x32,0x88,0x0E,0x00,
+    0x31,0x95,0x00,0x0E,0x32,0x88,0x29,0x31,0x85,0x38,0x32,0x9A,0x38,0x31,0x91,0x2C,0x80,0x31,0x85,0xC0,0x9C,0x3E,0x32,0x85,
+    0x0D,0x31,0x85,0x1F,0x09,0x32,0xBF,0xBF,0x88,0x0D,0x31,0x9A,0x2C,0x2B,0x37,0x32,0x87,0x3F,0x17,0x31,0x85,0x38,0x32,0x89,
+    0x09,0x14,0x31,0x93,0x21,0x09,0x32,0x89,0x29,0x31,0x85,0x38,0x32,0x9A,0xC0,0x8B,0x1F,0xC0,0xDE,0x7F,0x31,0x8F,0x1A,0xC0,
+    0xA4,0x5F,0x0D,0x31,0x85,0xC0,0xA4,0x3E,0x32,0x85,0x0D,0x31,0x85,0x1F,0x09,0x32,0xBF,0xBF,0x88,0x0D,0x31,0x98,0x2C,0x2E,
+    0xC0,0x9C,0x1F,0xC0,0x82,0xBF,0x89,0xC0,0x83,0x3E,0x17,0x31,0x85,0x38,0x32,0x8A,0x3C,0x3D,0x1F,0x31,0x8F,0x1F,0xC0,0xBD,
+    0x5F,0x04,0x32,0x8A,0xC0,0xF7,0xDF,0x31,0x85,0x38,0x32,0x9B,0x09,0xC0,0xDE,0xBF,0x31,0x8D,0x33,0x2D,0x32,0x0D,0x31,0x85,
+    0xC0,0xA4,0x3E,0x32,0x85,0x0D,0x31,0x85,0x1F,0x09,0x32,0xBF,0xBF,0x88,0x0D,0x31,0x96,0x12,0x0A,0x35,0x32,0x8B,0xC0,0x83,
+    0x5E,0x17,0x31,0x85,0x38,0x32,0x8C,0xC0,0x9B,0xDF,0x21,0xC0,0xF7,0xBF,0x31,0x8B,0x1F,0x0A,0xC0,0x9B,0xBF,0x32,0x8C,0x2C,
+    0x31,0x85,0x38,0x32,0x9C,0xC0,0x8B,0x1F,0x0A,0x2C,0x31,0x89,0x12,0x30,0x37,0x32,0x80,0x0D,0x31,0x85,0xC0,0xA4,0x5E,0x32,
+    0x85,0x0D,0x31,0x85,0x1F,0x09,0x32,0xBF,0xBF,0x88,0x3D,0x21,0x92,0x0F,0xC0,0xC5,0x7F,0xC0,0xB4,0xBF,0x09,0x32,0x8E,0xC0,
+    0x7A,0xFE,0x02,0x21,0x85,0xC0,0xAC,0x7F,0xC0,0x82,0xBF,0x8E,0x09,0x2B,0x2E,0x12,0x1F,0x31,0x2C,0x81,0x31,0x24,0x12,0xC0,
+    0xDE,0x7F,0xC0,0xAC,0xDF,0x3C,0x32,0x8E,0xC0,0xC5,0xDE,0x21,0x85,0x0C,0x32,0x9E,0xC0,0x93,0x7F,0x3D,0x08,0x1F,0x31,0x2C,
+    0x81,0x27,0x12,0x2E,0xC0,0xB4,0xDF,0x3C,0x32,0x82,0x02,0x21,0x85,0xC0,0x93,0x9E,0x32,0x85,0x02,0x21,0x85,0x0A,0xC0,0x8A,
+    0xFF,0x32,0xBF,0xBF,0xBF,0x8E,0x3F,0x04,0x1B,0x16,0x81,0x1B,0x09,0x37,0x32,0xBC,0x37,0x09,0x1B,0x16,0x69,0x16,0x11,0x04,
+    0x32,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xA6,0x66,0x32,0x8E,0x2D,0x32,0x88,
+    0x2D,0x32,0x81,0x2D,0x32,0x8E,0x2D,0x32,0x88,0x2D,0x32,0x81,0x2D,0x32,0x8E,0x2D,0x32,0x88,0x2D,0x32,0x81,0x2D,0x32,0x8E,
+    0x2D,0x32,0x88,0x2D,0x32,0x81,0x2D,0x32,0x8E,0x2D,0x32,0x88,0x2D,0x32,0x81,0x2D,0x32,0x8E,0x2D,0x32,0x88,0x2D,0x32,0x81,
+    0x2D,0x32,0x8E,0x2D,0x32,0x88,0x2D,0x32,0x81,0x2D,0x32,0x8E,0x2D,0x32,0x88,0x2D,0x32,0x81,0x2D,0x32,0x8E,0x2D,0x32,0x88,
+    0x2D,0x32,0x81,0x2D,0x32,0x8E,0x2D,0x32,0x88,0x2D,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,0x83,0x2D,0x32,0x2D,0x32,0x82,0x2D,
+    0x32,0x8D,0x2D,0x32,0x80,0x2D,0x32,0x83,0x2D,0x32,0x2D,0x32,0x82,0x2D,0x32,0x8D,0x2D,0x32,0x80,0x2D,0x32,0x83,0x2D,0x32,
+    0x2D,0x32,0x82,0x2D,0x32,0x8D,0x2D,0x32,0x80,0x2D,0x32,0x83,0x2D,0x32,0x2D,0x32,0x82,0x2D,0x32,0x8D,0x2D,0x32,0x80,0x2D,
+    0x32,0x83,0x2D,0x32,0x2D,0x32,0x82,0x2D,0x32,0x8D,0x2D,0x32,0x80,0x2D,0x32,0x83,0x2D,0x32,0x2D,0x32,0x82,0x2D,0x32,0x8D,
+    0x2D,0x32,0x80,0x2D,0x32,0x83,0x2D,0x32,0x2D,0x32,0x82,0x2D,0x32,0x8D,0x2D,0x32,0x80,0x2D,0x32,0x83,0x2D,0x32,0x2D,0x32,
+    0x82,0x2D,0x32,0x8D,0x2D,0x32,0x80,0x2D,0x32,0x83,0x2D,0x32,0x2D,0x32,0x82,0x2D,0x32,0x8D,0x2D,0x32,0x80,0x2D,0x32,0x83,
+    0x2D,0x32,0x2D,0x32,0x82,0x2D,0x32,0x8C,0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,
+    0x81,0x2D,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,
+    0x2D,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,0x2D,
+    0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,0x2D,0x32,
+    0x2D,0x81,0x32,0x80,0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,0x2D,0x32,0x2D,
+    0x81,0x32,0x80,0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,0x2D,0x32,0x2D,0x81,
+    0x32,0x80,0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,0x2D,0x32,0x2D,0x81,0x32,
+    0x80,0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,0x2D,0x32,0x2D,0x81,0x32,0x80,
+    0x2D,0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,0x2D,0x32,0x2D,0x81,0x32,0x80,0x2D,
+    0x32,0x80,0x2D,0x80,0x32,0x2D,0x32,0x80,0x2D,0x32,0x87,0x2D,0x32,0x2D,0x32,0x81,0x2D,0x32,0x2D,0x81,0x32,0x2D,0x32,0x2D,
+    0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,0x81,0x2D,0x32,0x81,0x2D,0x80,0x32,
+    0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,0x81,0x2D,0x32,0x81,0x2D,0x80,
+    0x32,0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,0x81,0x2D,0x32,0x81,0x2D,
+    0x80,0x32,0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,0x81,0x2D,0x32,0x81,
+    0x2D,0x80,0x32,0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,0x81,0x2D,0x32,
+    0x81,0x2D,0x80,0x32,0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,0x81,0x2D,
+    0x32,0x81,0x2D,0x80,0x32,0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,0x81,
+    0x2D,0x32,0x81,0x2D,0x80,0x32,0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,0x32,
+    0x81,0x2D,0x32,0x81,0x2D,0x80,0x32,0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,0x2D,
+    0x32,0x81,0x2D,0x32,0x81,0x2D,0x80,0x32,0x2D,0x32,0x82,0x2D,0x80,0x32,0x2D,0x80,0x32,0x2D,0x83,0x32,0x80,0x2D,0x32,0x80,
+    0x2D,0x32,0x81,0x2D,0x32,0x81,0x2D,0x32,0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,
+    0x32,0x80,0x2D,0x32,0x2D,0x84,0x32,0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,
+    0x80,0x2D,0x32,0x2D,0x84,0x32,0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,0x80,
+    0x2D,0x32,0x2D,0x84,0x32,0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,0x80,0x2D,
+    0x32,0x2D,0x84,0x32,0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,0x80,0x2D,0x32,
+    0x2D,0x84,0x32,0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,0x80,0x2D,0x32,0x2D,
+    0x84,0x32,0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,0x80,0x2D,0x32,0x2D,0x84,
+    0x32,0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,0x80,0x2D,0x32,0x2D,0x84,0x32,
+    0x2D,0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,0x80,0x2D,0x32,0x2D,0x84,0x32,0x2D,
+    0x32,0x2D,0x80,0x32,0x2D,0x81,0x32,0x80,0x2D,0x32,0x2D,0x32,0x80,0x2D,0x84,0x32,0x80,0x2D,0x32,0x2D,0x86,0x32,0x2D,0x8B,
+    0x32,0x81,0x2D,0x86,0x32,0x2D,0x84,0x32,0x2D,0x8B,0x32,0x81,0x2D,0x86,0x32,0x2D,0x84,0x32,0x2D,0x8B,0x32,0x81,0x2D,0x86,
+    0x32,0x2D,0x84,0x32,0x2D,0x8B,0x32,0x81,0x2D,0x86,0x32,0x2D,0x84,0x32,0x2D,0x8B,0x32,0x81,0x2D,0x86,0x32,0x2D,0x84,0x32,
+    0x2D,0x8B,0x32,0x81,0x2D,0x86,0x32,0x2D,0x84,0x32,0x2D,0x8B,0x32,0x81,0x2D,0x86,0x32,0x2D,0x84,0x32,0x2D,0x8B,0x32,0x81,
+    0x2D,0x86,0x32,0x2D,0x84,0x32,0x2D,0x8B,0x32,0x81,0x2D,0x86,0x32,0x2D,0x84,0x32,0x2D,0x8B,0x32,0x81,0x2D,0x86,0x32,0x2D,
+    0x85,0x32,0x2D,0x85,0x32,0x2D,0x95,0x32,0x2D,0x85,0x32,0x2D,0x95,0x32,0x2D,0x85,0x32,0x2D,0x95,0x32,0x2D,0x85,0x32,0x2D,
+    0x95,0x32,0x2D,0x85,0x32,0x2D,0x95,0x32,0x2D,0x85,0x32,0x2D,0x95,0x32,0x2D,0x85,0x32,0x2D,0x95,0x32,0x2D,0x85,0x32,0x2D,
+    0x95,0x32,0x2D,0x85,0x32,0x2D,0x95,0x32,0x2D,0x85,0x32,0x2D,0x92,0x32,0x2D,0x9D,0x32,0x2D,0x9D,0x32,0x2D,0x9D,0x32,0x2D,
+    0x9D,0x32,0x2D,0x9D,0x32,0x2D,0x9D,0x32,0x2D,0x9D,0x32,0x2D,0x9D,0x32,0x2D,0x9D,0x32,0x2D,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,
+    0xBF,0xA5,0x66,0x2D,0x9D,0x28,0x2D,0x9D,0x28,0x2D,0x9D,0x28,0x2D,0x9D,0x28,0x2D,0x9D,0x28,0x2D,0x9D,0x28,0x2D,0x9D,0x28,
+    0x2D,0x9D,0x28,0x2D,0x9D,0x28,0x2D,0x96,0x28,0x2D,0x81,0x28,0x2D,0x8E,0x28,0x2D,0x88,0x28,0x2D,0x81,0x28,0x2D,0x8E,0x28,
+    0x2D,0x88,0x28,0x2D,0x81,0x28,0x2D,0x8E,0x28,0x2D,0x88,0x28,0x2D,0x81,0x28,0x2D,0x8E,0x28,0x2D,0x88,0x28,0x2D,0x81,0x28,
+    0x2D,0x8E,0x28,0x2D,0x88,0x28,0x2D,0x81,0x28,0x2D,0x8E,0x28,0x2D,0x88,0x28,0x2D,0x81,0x28,0x2D,0x8E,0x28,0x2D,0x88,0x28,
+    0x2D,0x81,0x28,0x2D,0x8E,0x28,0x2D,0x88,0x28,0x2D,0x81,0x28,0x2D,0x8E,0x28,0x2D,0x88,0x28,0x2D,0x81,0x28,0x2D,0x8E,0x28,
+    0x2D,0x87,0x28,0x2D,0x87,0x28,0x2D,0x83,0x28,0x2D,0x80,0x28,0x2D,0x83,0x28,0x2D,0x84,0x28,0x2D,0x87,0x28,0x2D,0x83,0x28,
+    0x2D,0x80,0x28,0x2D,0x83,0x28,0x2D,0x84,0x28,0x2D,0x87,0x28,0x2D,0x83,0x28,0x2D,0x80,0x28,0x2D,0x83,0x28,0x2D,0x84,0x28,
+    0x2D,0x87,0x28,0x2D,0x83,0x28,0x2D,0x80,0x28,0x2D,0x83,0x28,0x2D,0x84,0x28,0x2D,0x87,0x28,0x2D,0x83,0x28,0x2D,0x80,0x28,
+    0x2D,0x83,0x28,0x2D,0x84,0x28,0x2D,0x87,0x28,0x2D,0x83,0x28,0x2D,0x80,0x28,0x2D,0x83,0x28,0x2D,0x84,0x28,0x2D,0x87,0x28,
+    0x2D,0x83,0x28,0x2D,0x80,0x28,0x2D,0x83,0x28,0x2D,0x84,0x28,0x2D,0x87,0x28,0x2D,0x83,0x28,0x2D,0x80,0x28,0x2D,0x83,0x28,
+    0x2D,0x84,0x28,0x2D,0x87,0x28,0x2D,0x83,0x28,0x2D,0x80,0x28,0x2D,0x83,0x28,0x2D,0x84,0x28,0x2D,0x87,0x28,0x2D,0x83,0x28,
+    0x2D,0x80,0x28,0x2D,0x83,0x28,0x2D,0x86,0x28,0x80,0x2D,0x86,0x28,0x2D,0x84,0x28,0x2D,0x28,0x2D,0x80,0x28,0x2D,0x81,0x28,
+    0x80,0x2D,0x82,0x28,0x80,0x2D,0x86,0x28,0x2D,0x84,0x28,0x2D,0x28,0x2D,0x80,0x28,0x2D,0x81,0x28,0x80,0x2D,0x82,0x28,0x80,
+    0x2D,0x86,0x28,0x2D,0x84,0x28,0x2D,0x28,0x2D,0x80,0x28,0x2D,0x81,0x28,0x80,0x2D,0x82,0x28,0x80,0x2D,0x86,0x28,0x2D,0x84,
+    0x28,0x2D,0x28,0x2D,0x80,0x28,0x2D,0x81,0x28,0x80,0x2D,0x82,0x28,0x80,0x2D,0x86,0x28,0x2D,0x84,0x28,0x2D,0x28,0x2D,0x80,
+    0x28,0x2D,0x81,0x28,0x80,0x2D,0x82,0x28,0x80,0x2D,0x86,0x28,0x2D,0x84,0x28,0x2D,0x28,0x2D,0x80,0x28,0x2D,0x81,0x28,0x80,
+    0x2D,0x82,0x28,0x80,0x2D,0x86,0x28,0x2D,0x84,0x28,0x2D,0x28,0x2D,0x80,0x28,0x2D,0x81,0x28,0x80,0x2D,0x82,0x28,0x80,0x2D,
+    0x86,0x28,0x2D,0x84,0x28,0x2D,0x28,0x2D,0x80,0x28,0x2D,0x81,0x28,0x80,0x2D,0x82,0x28,0x80,0x2D,0x86,0x28,0x2D,0x84,0x28,
+    0x2D,0x28,0x2D,0x80,0x28,0x2D,0x81,0x28,0x80,0x2D,0x82,0x28,0x80,0x2D,0x86,0x28,0x2D,0x84,0x28,0x2D,0x28,0x2D,0x80,0x28,
+    0x2D,0x81,0x28,0x80,0x2D,0x80,0x28,0x2D,0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,
+    0x28,0x80,0x2D,0x81,0x28,0x81,0x2D,0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,
+    0x80,0x2D,0x81,0x28,0x81,0x2D,0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,0x80,
+    0x2D,0x81,0x28,0x81,0x2D,0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,0x80,0x2D,
+    0x81,0x28,0x81,0x2D,0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,0x80,0x2D,0x81,
+    0x28,0x81,0x2D,0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,0x80,0x2D,0x81,0x28,
+    0x81,0x2D,0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,0x80,0x2D,0x81,0x28,0x81,
+    0x2D,0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,0x80,0x2D,0x81,0x28,0x81,0x2D,
+    0x28,0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,0x80,0x2D,0x81,0x28,0x81,0x2D,0x28,
+    0x2D,0x28,0x80,0x2D,0x81,0x28,0x82,0x2D,0x28,0x2D,0x28,0x2D,0x28,0x2D,0x84,0x28,0x80,0x2D,0x81,0x28,0x81,0x2D,0x81,0x28,
+    0x83,0x2D,0x28,0x81,0x2D,0x28,0x2D,0x28,0x87,0x2D,0x28,0x80,0x2D,0x81,0x28,0x80,0x2D,0x81,0x28,0x83,0x2D,0x28,0x81,0x2D,
+    0x28,0x2D,0x28,0x87,0x2D,0x28,0x80,0x2D,0x81,0x28,0x80,0x2D,0x81,0x28,0x83,0x2D,0x28,0x81,0x2D,0x28,0x2D,0x28,0x87,0x2D,
+    0x28,0x80,0x2D,0x81,0x28,0x80,0x2D,0x81,0x28,0x83,0x2D,0x28,0x81,0x2D,0x28,0x2D,0x28,0x87,0x2D,0x28,0x80,0x2D,0x81,0x28,
+    0x80,0x2D,0x81,0x28,0x83,0x2D,0x28,0x81,0x2D,0x28,0x2D,0x28,0x87,0x2D,0x28,0x80,0x2D,0x81,0x28,0x80,0x2D,0x81,0x28,0x83,
+    0x2D,0x28,0x81,0x2D,0x28,0x2D,0x28,0x87,0x2D,0x28,0x80,0x2D,0x81,0x28,0x80,0x2D,0x81,0x28,0x83,0x2D,0x28,0x81,0x2D,0x28,
+    0x2D,0x28,0x87,0x2D,0x28,0x80,0x2D,0x81,0x28,0x80,0x2D,0x81,0x28,0x83,0x2D,0x28,0x81,0x2D,0x28,0x2D,0x28,0x87,0x2D,0x28,
+    0x80,0x2D,0x81,0x28,0x80,0x2D,0x81,0x28,0x83,0x2D,0x28,0x81,0x2D,0x28,0x2D,0x28,0x87,0x2D,0x28,0x80,0x2D,0x81,0x28,0x80,
+    0x2D,0x81,0x28,0x83,0x2D,0x28,0x81,0x2D,0x28,0x2D,0x28,0x87,0x2D,0x28,0x80,0x2D,0x81,0x28,0x2D,0x28,0x84,0x2D,0x28,0x81,
+    0x2D,0x28,0x87,0x2D,0x28,0x86,0x2D,0x28,0x2D,0x28,0x84,0x2D,0x28,0x81,0x2D,0x28,0x87,0x2D,0x28,0x86,0x2D,0x28,0x2D,0x28,
+    0x84,0x2D,0x28,0x81,0x2D,0x28,0x87,0x2D,0x28,0x86,0x2D,0x28,0x2D,0x28,0x84,0x2D,0x28,0x81,0x2D,0x28,0x87,0x2D,0x28,0x86,
+    0x2D,0x28,0x2D,0x28,0x84,0x2D,0x28,0x81,0x2D,0x28,0x87,0x2D,0x28,0x86,0x2D,0x28,0x2D,0x28,0x84,0x2D,0x28,0x81,0x2D,0x28,
+    0x87,0x2D,0x28,0x86,0x2D,0x28,0x2D,0x28,0x84,0x2D,0x28,0x81,0x2D,0x28,0x87,0x2D,0x28,0x86,0x2D,0x28,0x2D,0x28,0x84,0x2D,
+    0x28,0x81,0x2D,0x28,0x87,0x2D,0x28,0x86,0x2D,0x28,0x2D,0x28,0x84,0x2D,0x28,0x81,0x2D,0x28,0x87,0x2D,0x28,0x86,0x2D,0x28,
+    0x2D,0x28,0x84,0x2D,0x28,0x81,0x2D,0x28,0x87,0x2D,0x28,0x86,0x2D,0x28,0x8E,0x2D,0x28,0x84,0x2D,0x28,0x96,0x2D,0x28,0x84,
+    0x2D,0x28,0x96,0x2D,0x28,0x84,0x2D,0x28,0x96,0x2D,0x28,0x84,0x2D,0x28,0x96,0x2D,0x28,0x84,0x2D,0x28,0x96,0x2D,0x28,0x84,
+    0x2D,0x28,0x96,0x2D,0x28,0x84,0x2D,0x28,0x96,0x2D,0x28,0x84,0x2D,0x28,0x96,0x2D,0x28,0x84,0x2D,0x28,0x96,0x2D,0x28,0x84,
+    0x2D,0x28,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0xBF,0x8C,0x7A,0x28,0x81,0x2B,0x28,0x83,0x2B,0x28,0x93,0x2B,0x28,
+    0x81,0x2B,0x28,0x83,0x2B,0x28,0x93,0x2B,0x28,0x81,0x2B,0x28,0x83,0x2B,0x28,0x93,0x2B,0x28,0x81,0x2B,0x28,0x83,0x2B,0x28,
+    0x93,0x2B,0x28,0x81,0x2B,0x28,0x83,0x2B,0x28,0x93,0x2B,0x28,0x81,0x2B,0x28,0x83,0x2B,0x28,0x93,0x2B,0x28,0x81,0x2B,0x28,
+    0x83,0x2B,0x28,0x93,0x2B,0x28,0x81,0x2B,0x28,0x83,0x2B,0x28,0x93,0x2B,0x28,0x81,0x2B,0x28,0x83,0x2B,0x28,0x93,0x2B,0x28,
+    0x81,0x2B,0x28,0x83,0x2B,0x28,0xAD,0x2B,0x28,0x9D,0x2B,0x28,0x9D,0x2B,0x28,0x9D,0x2B,0x28,0x9D,0x2B,0x28,0x9D,0x2B,0x28,
+    0x9D,0x2B,0x28,0x9D,0x2B,0x28,0x9D,0x2B,0x28,0x9D,0x2B,
+};
+
+#endif // LOGO_IMAGE_H
@@ -0,0 +1,87 @@
+#ifndef LOT_REFERENCE_H
+#define LOT_REFERENCE_H
+
+#include <Arduino.h>
+#include "sweep_table.h"
+#include "cal_set.h"
+
+/*=========================LOT REFERENCE=========================*/
+// A sensor lot with tight tolerances shares one baseline: the lot reference,
+// the mean spectrum of a baseline of sample sensors with a tolerance band per
+// index. With the reference on, a baseline START sweeps only
+// LOT_VERIFY_POINTS planned indices spread over the plan. If every DUT is in
+// band there, its baseline row is filled with the reference and the final
+// sweep may follow at once; if any DUT is outside (or a point is missing),
+// the rest of the plan is swept in the same session - a full baseline
+//
+// The band of an index is the larger of the tolerance given when the
+// reference was saved and LOT_REF_SD_BAND spreads of the sample sensors. A
+// reference is used only for plans it covers index by index and with the
+// calibration set it was taken with; other baselines are swept in full.
+// Kept in LOT_REF_FILE (one record with a CRC), loaded at boot
+//
+// Set -D LOT_REFERENCE_DEFAULT=1 to use a stored reference from boot
+#ifndef LOT_REFERENCE_DEFAULT
+#define LOT_REFERENCE_DEFAULT 0
+#endif
+#define LOT_REF_FILE            "/lotref.dat"
+#define LOT_REF_MAGIC           0x4652544C  // "LTRF"
+#define LOT_REF_VERSION         1
+#define LOT_REF_NAME_MAX        16
+#define LOT_VERIFY_POINTS       4       // Indices of the verification sweep (3-5 keep it short)
+#define LOT_REF_SD_BAND         3.0f    // Band at least this many sample spreads wide
+#define LOT_REF_MAG_TOL_PCT     5.0f    // Default band: |Z| off the mean, percent
+#define LOT_REF_PHASE_TOL_DEG   2.0f    // Default band: phase off the mean, degrees
+
+struct __attribute__((packed)) LotRefPoint {
+    float mag;              // Mean |Z|, Ohms
+    float phase;            // Mean phase, degrees
+    float magTol;           // Band: relative |Z| deviation (0.05 = 5 %)
+    float phaseTol;         // Band: degrees
+    uint8_t flags;          // IMPEDANCE_FLAG_VALID | gains of the first sample sensor
+    uint8_t magSd;          // Mean PointNoise spread of the samples (repeat_filter.h)
+    uint8_t phaseSd;
+};
+
+struct __attribute__((packed)) LotReference {
+    uint32_t magic;         // LOT_REF_MAGIC
+    uint16_t version;       // LOT_REF_VERSION
+    char name[LOT_REF_NAME_MAX];
+    char calSet[CAL_SET_NAME_MAX];  // getCalibrationSetName() of the sample baseline
+    uint8_t samples;        // Sensors averaged
+    SweepMask mask;         // Indices with a reference point
+    LotRefPoint points[SWEEP_FREQ_COUNT];   // By sweep table index
+    uint16_t crc;           // CRC-16/CCITT (crc.h) of everything before it
+};
+
+// Boot, after storage: load LOT_REF_FILE
+void initLotReference();
+
+// GUI task, between sweeps (the next baseline)
+void setLotReferenceEnabled(bool enable);
+bool isLotReferenceEnabled();
+
+// GUI task, after a baseline of sample sensors: the mean of the valid points
+// of DUTs 0..numDuts-1 (open channels left out) with bands of at least the
+// given tolerances. Stored to flash; false if no index has a valid point
+bool saveLotReference(const char* name, uint8_t numDuts, float magTolPct = LOT_REF_MAG_TOL_PCT,
+                      float phaseTolDeg = LOT_REF_PHASE_TOL_DEG);
+
+// Remove the stored reference
+void clearLotReference();
+
+// GUI task, planning a baseline of plan: the indices to verify, or 0 to
+// sweep in full (reference off, missing, of another calibration set, or not
+// covering the plan)
+SweepMask getLotVerifyMask(SweepMask plan);
+
+// GUI task, once the verification sweep of DUTs 0..numDuts-1 ended (no
+// batch of its session is left): if every DUT is in band at the verified
+// indices, fill their baseline rows with the reference over plan and return
+// true. false if any DUT needs a full baseline - the rows are left alone
+bool applyLotReference(uint8_t numDuts, SweepMask plan, SweepMask verified);
+
+// Reference, mode and the last verification to Serial
+void printLotReference();
+
+#endif // LOT_REFERENCE_H
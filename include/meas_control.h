@@ -0,0 +1,135 @@
+#ifndef MEAS_CONTROL_H
+#define MEAS_CONTROL_H
+
+#include <Arduino.h>
+#include "sweep_table.h"
+#include "UART_Functions.h"
+
+/*=========================MEASUREMENT CONTROL=========================*/
+// The one place sweeps are started and stopped. The GUI buttons, serial
+// commands, BLE commands and the monitor all post here (GUI task), and the
+// controller owns the sweep flags (defines.h) and the plan (num_duts,
+// startIDX, endIDX, sweepMask):
+//   IDLE --request--> STARTING --ACK--> SWEEPING --last DUT--> IDLE
+//           STARTING/SWEEPING --stop--> IDLE
+//           SWEEPING --stall--> STARTING (resume) or IDLE (given up)
+//           SWEEPING --coarse pass ended--> STARTING (refinement)
+//           SWEEPING --points missing--> STARTING (repair)
+// START and STOP go to the STM32 through the async UART queue. The stored rows
+// are never cleared here - the data processor resets the used points of a row
+// when the new session's first batch arrives (meas_session.h)
+//
+// Baseline and final rows are the two session buffers: a final sweep may start
+// as soon as the baseline's last DUT ended, while that DUT's data, fit and
+// archive still go out as background jobs (bg_jobs.h) reading the baseline
+// rows. A sweep of the kind that ran last (a new baseline, the next final
+// sweep) overwrites what those jobs read, so it runs them all first
+enum MeasSource : uint8_t {
+    MEAS_SOURCE_GUI,
+    MEAS_SOURCE_SERIAL,
+    MEAS_SOURCE_BLE,
+    MEAS_SOURCE_MONITOR,    // Final sweeps of the monitor - no screen change or BLE status
+    MEAS_SOURCE_CAL,        // Calibration acquisition sweeps (cal_acquire.h)
+    MEAS_SOURCE_RECIPE      // Sweep steps of a running recipe (recipe.h)
+};
+
+enum MeasControlState : uint8_t {
+    MEAS_IDLE,
+    MEAS_STARTING,          // START queued, STM32 ACK not yet in
+    MEAS_SWEEPING
+};
+
+enum MeasRequestError : uint8_t {
+    MEAS_REQUEST_OK,
+    MEAS_REQUEST_BUSY,          // A sweep is starting or running
+    MEAS_REQUEST_MONITOR,       // The monitor owns the sweeps
+    MEAS_REQUEST_NO_BASELINE,   // Final sweep before a baseline
+    MEAS_REQUEST_INVALID,       // Channel count out of range
+    MEAS_REQUEST_QUEUE,         // UART command queue full
+    MEAS_REQUEST_UPDATE,        // Firmware update in progress (ota_update.h)
+    MEAS_REQUEST_CALIBRATION,   // Final sweep with another calibration set than the baseline
+    MEAS_REQUEST_RECIPE         // A recipe owns the sweeps
+};
+
+// Channels and frequencies of a baseline sweep - the final sweep reuses them
+// so stored points pair up by index
+struct SweepPlan {
+    uint8_t numDuts;
+    uint8_t startIdx;
+    uint8_t endIdx;
+    SweepMask mask;             // 0 = startIdx..endIdx
+};
+
+// Start a baseline sweep, discarding the previous baseline and final results
+// callback (optional) runs in the GUI task after the STM32 answered START
+MeasRequestError requestBaselineSweep(MeasSource source, const SweepPlan& plan,
+                                      UARTCommandCallback callback = nullptr, void* context = nullptr);
+
+// Start a final sweep with the baseline's plan
+MeasRequestError requestFinalSweep(MeasSource source, UARTCommandCallback callback = nullptr,
+                                   void* context = nullptr);
+
+// Stop the sweep (and the monitor, unless the monitor itself asks, and a
+// running recipe). The
+// session is closed and acknowledged (home screen, BLE "Stopped") at once;
+// the STOP goes out asynchronously
+void requestMeasurementStop(MeasSource source);
+
+// Any task (the BLE write callback, ahead of the GUI task): queue the STOP of
+// a starting or running sweep now. The requestMeasurementStop() that follows
+// for the same command does not send it again. false if no sweep runs, a
+// STOP is already queued this way or the UART queue is full
+bool preemptMeasurementStop();
+
+// The last DUT of the running sweep is stored - marks its kind done
+// Returns true if it was a final sweep
+bool completeMeasurement();
+
+// GUI task: the sweep watchdog expired with dut (1-based) the first DUT not
+// finished. A sequential sweep resets the link (STOP) and resumes at dut in
+// the same session, up to SWEEP_WD_RESYNC_MAX times; otherwise, or for
+// calibration acquisition, the sweep is stopped as "link_lost"
+void handleSweepStall(uint8_t dut);
+
+// Repair sweeps per sweep: re-measure only the points that never arrived
+#define SWEEP_REPAIR_MAX        2
+
+// GUI task, at a DUT's DUT_END: true if its points go out (BLE, risk,
+// history) now. false if they went out already in this session, or - unless
+// sweepDone - points are missing and a repair sweep may still fill them
+bool claimDUTDelivery(uint8_t dutIndex, bool sweepDone);
+
+// GUI task: dut's (0-based) points went out in this session - its row is final
+bool isDUTDelivered(uint8_t dutIndex);
+
+// GUI task, when the last DUT ended: queue a sweep of only the missing
+// points of the session (planned indices that did not arrive), in the same
+// session. true if queued - the sweep is not complete yet
+bool requestSweepRepair();
+
+// GUI task, when the last DUT of a baseline's verification sweep ended:
+// check it against the lot reference (lot_reference.h). In band, the rows
+// are filled from the reference and the sweep completes; otherwise the rest
+// of the plan is queued in the same session - true if queued
+bool requestLotVerification();
+
+// GUI task, when the last DUT of a refined baseline's coarse pass ended:
+// queue a sweep of the indices where the spectrum bends (sweep_refine.h), in
+// the same session. true if queued - deliveries wait for it
+bool requestSweepRefinement();
+
+// A repair sweep is still allowed in this session (any task - a stale read
+// only delays the decision to the next DUT)
+bool isSweepRepairAvailable();
+
+// Forget the baseline and final results (new measurement, store relayout)
+void resetMeasurementResults();
+
+MeasControlState getMeasurementState();
+
+// Source of the last requested sweep
+MeasSource getMeasurementSource();
+
+const char* measRequestErrorText(MeasRequestError error);
+
+#endif // MEAS_CONTROL_H
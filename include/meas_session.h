@@ -0,0 +1,106 @@
+#ifndef MEAS_SESSION_H
+#define MEAS_SESSION_H
+
+#include <Arduino.h>
+#include "sweep_table.h"
+
+/*=========================MEASUREMENT SESSION=========================*/
+// Who owns the stored sweep, so the tasks share it without locks:
+// - The measurement controller (meas_control.h, GUI task) owns the sweep flags
+//   and opens a session for each START. A session is a generation number whose
+//   low bit tells baseline (0) from final (1)
+// - The UART reader stamps every batch with the generation it was filled in
+// - The data processor is the only writer of rows and point counts. Each
+//   row's count is tagged with the session that wrote it, so the first batch
+//   of a new session "clears" its kind's rows in O(1): the old tags no longer
+//   match and read as 0 points. Batches of an older session are dropped
+// - Points past a row's count are stale and never read. A point is published
+//   by raising its row's count after it is stored (release), so a reader
+//   loading the count (acquire) only sees complete points. Counts read 0
+//   until the processor has caught up with a new session
+// - Point k of the session's plan goes to slot k of the row, whatever
+//   arrives before it: a dropped frame leaves an invalid gap slot instead of
+//   shifting the later points. The gaps are re-measured by a repair sweep in
+//   the same session (meas_control.h); a reader may see a gap filled late
+// - A cancelled sweep's session is closed at once (abortMeasurementSession):
+//   its batches still in the queue or in the reader, and those of frames the
+//   STM32 sends until it takes the STOP, are dropped unprocessed
+// A reader on another task that copies a row compares getMeasurementGeneration()
+// before and after - a change means a new session may have cleared it
+enum SessionSync : uint8_t {
+    SESSION_CURRENT,        // Batch of the session being stored
+    SESSION_NEW,            // First batch of a newer session - its rows and counts are clear
+    SESSION_STALE           // Batch of an older session - drop it
+};
+
+// GUI task, before START is queued - plan: the sweep table indices asked for
+void beginMeasurementSession(bool final, SweepMask plan);
+
+// GUI task, when a running sweep is cancelled: moves to a closed generation
+// of the same kind that no session stores into. The rows keep what the
+// cancelled session stored; the next session starts as usual
+void abortMeasurementSession();
+
+uint32_t getMeasurementGeneration();
+
+inline bool isFinalGeneration(uint32_t generation) {
+    return generation & 1;
+}
+
+// Data processor, for each batch
+SessionSync syncMeasurementSession(uint32_t generation);
+
+// Data processor: slot of dut's (0-based) point at sweep index freqIdx, and
+// marks it arrived. -1 if it arrived already in this session (a resumed or
+// repaired DUT) or is not in the plan. Off-grid points go to the row's end
+int claimPointSlot(uint8_t dut, uint8_t freqIdx);
+
+// Sweep index of slot of the plan, SWEEP_FREQ_INVALID past its end
+uint8_t getSlotFreqIndex(int slot);
+
+// Data processor: slots of dut's (0-based) row up to end are stored
+void publishMeasurementPoints(uint8_t dut, int end);
+
+// GUI task, once every DUT of the session ended (no batch of it is left):
+// dut's row holds end points the caller stored in its slots - a baseline
+// taken from the lot reference (lot_reference.h). The whole plan counts as arrived
+void publishFilledRow(uint8_t dut, int end);
+
+// GUI task, no sweep running (the data processor is idle): dut's baseline (or
+// final) row of the newest session of that kind holds end points the caller
+// stored again - a recalibrated raw capture (raw_capture.h)
+void publishRecalibratedRow(bool baseline, uint8_t dut, int end);
+
+// Data processor: the rest of dut's plan is not wanted (fast screen ended it)
+void closeMeasurementRow(uint8_t dut);
+
+// Data processor: all of dut's plan is wanted again - the repair sweep
+// re-measures the whole row (KK check failed). The stored points stay
+// readable until they are overwritten
+void reopenMeasurementRow(uint8_t dut);
+
+// Data processor: end of dut's row (0-based) - the next free slot
+int getNextPointIndex(uint8_t dut);
+
+// Planned points of dut (0-based) that have not arrived in the current
+// session. Exact once the data processor signalled dut's DUT_END
+SweepMask getMissingPoints(uint8_t dut);
+
+// Points of dut (0-based) stored in the current session
+int getStoredPointCount(uint8_t dut);
+
+// Points of dut's baseline (or final) row from the newest session of that kind
+int getRowPointCount(bool baseline, uint8_t dut);
+
+// Generation of the newest session whose batches reached the baseline (or
+// final) rows - a reader of those rows compares it before and after
+uint32_t getRowGeneration(bool baseline);
+
+// Boot, before the data processor runs: a baseline session with plan whose
+// rows hold counts[dut] points (baseline_store.h) - the final sweep follows it
+void restoreBaselineSession(const uint8_t* counts, SweepMask plan);
+
+// Empty every row directly - only while no sweep runs (store layout change)
+void resetMeasurementCounts();
+
+#endif // MEAS_SESSION_H
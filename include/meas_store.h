@@ -0,0 +1,83 @@
+#ifndef MEAS_STORE_H
+#define MEAS_STORE_H
+
+#include <Arduino.h>
+#include "defines.h"
+#include "sweep_table.h"
+#include "repeat_filter.h"
+
+/*=========================MEASUREMENT STORE=========================*/
+// baselineImpedanceData / measurementImpedanceData rows are carved out of one
+// static arena per field (ImpedanceRow), so the channel count and sweep length
+// of a session are configuration instead of array dimensions (MAX_DUT_COUNT
+// only bounds the small per-DUT bookkeeping arrays)
+//
+// Configuration is stored as "dutCount,pointsPerDut" in MEAS_STORE_CONFIG_FILE
+// and applied at boot - changing it needs no recompile, just a free arena
+
+// Arena size in points - both rows of every DUT: 2 * dutCount * pointsPerDut
+#ifndef MEAS_STORE_ARENA_POINTS
+#define MEAS_STORE_ARENA_POINTS (2 * 8 * MAX_FREQUENCIES)
+#endif
+
+#define MEAS_STORE_DEFAULT_DUTS 4
+#define MEAS_STORE_CONFIG_FILE  "/channels.txt"
+
+// Shared frequency axis: codes 0..SWEEP_FREQ_COUNT-1 are sweep table indices,
+// the next MEAS_STORE_OFFGRID_MAX codes are off-grid frequencies in the order
+// they were first stored (kept until reboot)
+#define MEAS_STORE_OFFGRID_MAX  16
+#define MEAS_STORE_FREQ_UNKNOWN 0xFF    // Off-grid table full - stored invalid
+
+// Load the stored configuration (or the defaults) and lay out the rows
+void initMeasurementStore();
+
+// Lay out the rows for dutCount channels of pointsPerDut points each
+// Returns false (old layout kept) if it is out of range or exceeds the arena
+// Not while a measurement is in progress - the data processor writes the rows
+bool configureMeasurementStore(uint8_t dutCount, uint8_t pointsPerDut);
+
+// Store the active configuration so it is applied at the next boot
+bool saveMeasurementStoreConfig();
+
+uint8_t getDUTCount();          // Channels of the active layout
+uint8_t getPointsPerDUT();      // Points stored per channel and sweep
+
+// Reset the baseline (or final) rows of all channels - only while no sweep
+// runs. A new session needs no clear: points past a row's count are never
+// read (meas_session.h)
+void clearImpedanceData(bool baseline);
+
+/*=========================POINT ACCESS=========================*/
+// Pack point into slot i of row, with the spread of its repeats
+void storeImpedancePoint(const ImpedanceRow& row, int i, const ImpedancePoint& point,
+                         const PointNoise& noise = PointNoise());
+
+// Unpack slot i of row (polar fields only)
+ImpedancePoint loadImpedancePoint(const ImpedanceRow& row, int i);
+
+// Relative |Z| spread of slot i in percent, phase spread in degrees
+inline float storedMagSdPercent(const ImpedanceRow& row, int i) {
+    return row.magSd[i] * POINT_NOISE_MAG_STEP;
+}
+
+inline float storedPhaseSdDegrees(const ImpedanceRow& row, int i) {
+    return row.phaseSd[i] * POINT_NOISE_PHASE_STEP;
+}
+
+// Frequency in Hz of an axis code, 0 for MEAS_STORE_FREQ_UNKNOWN
+uint32_t storedFrequency(uint8_t freqCode);
+
+// Sweep table index of an axis code, SWEEP_FREQ_INVALID for off-grid codes
+inline uint8_t storedFreqIndex(uint8_t freqCode) {
+    return freqCode < SWEEP_FREQ_COUNT ? freqCode : SWEEP_FREQ_INVALID;
+}
+
+inline bool isStoredPointValid(const ImpedanceRow& row, int i) {
+    return (row.flags[i] & IMPEDANCE_FLAG_VALID) != 0;
+}
+
+// Print the layout and arena usage to Serial
+void printMeasurementStore();
+
+#endif // MEAS_STORE_H
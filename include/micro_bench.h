@@ -0,0 +1,26 @@
+#ifndef MICRO_BENCH_H
+#define MICRO_BENCH_H
+
+#include <Arduino.h>
+
+/*=========================ON-TARGET MICRO-BENCHMARKS=========================*/
+// Times the per-point and per-frame kernels on the C6 itself in CPU cycles
+// (esp_cpu_get_cycle_count): calcImpedance, every compiled calibration mode,
+// the fixed-point kernel, the fixed-decimal formatter against printf,
+// calculateRiskLevel, the BLE DATA JSON encoder and each screen drawn and
+// pushed. Built with -D MICRO_BENCH=1 ([env:bench],
+// which also compiles every calibration mode in), run with "bench"
+#ifndef MICRO_BENCH
+#define MICRO_BENCH 0
+#endif
+
+#define MICRO_BENCH_ROUNDS      7       // Table shows min and median round
+#define MICRO_BENCH_POINT_CALLS 256     // Per round, per-point kernels
+#define MICRO_BENCH_SWEEP_CALLS 8       // Per round, per-DUT kernels
+#define MICRO_BENCH_FRAME_CALLS 2       // Per round, screens
+
+// Run every benchmark and print the table - GUI task, no sweep running
+// The screen is redrawn afterwards; sweep latency statistics are cleared
+void runMicroBenchmarks();
+
+#endif // MICRO_BENCH_H
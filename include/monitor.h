@@ -0,0 +1,56 @@
+#ifndef MONITOR_H
+#define MONITOR_H
+
+#include <Arduino.h>
+#include "defines.h"
+
+/*=========================MONITOR MODE=========================*/
+// Repeats the final sweep every interval against the stored baseline, for
+// overnight / longitudinal runs without the WebUI driving MEAS_START.
+// Risk is accumulated per point as usual; per DUT only a changed result is
+// reported (RISK) and archived - no DUT_START/DATA/DUT_END traffic
+#define MONITOR_MIN_INTERVAL_S  10
+#define MONITOR_PCT_DEADBAND    1.0f    // Percentage points a result must move to be reported
+
+// Start monitoring every intervalS seconds (first sweep right away)
+// Needs a baseline and no measurement in progress. trackHalfLife > 0 also
+// tracks the baseline with that half-life in sweeps (impedance_calc.h)
+bool startMonitor(uint32_t intervalS, uint32_t trackHalfLife = 0);
+
+// Stop monitoring, ending a running sweep - the caller picks the next GUI state
+void stopMonitor();
+
+bool isMonitorActive();
+uint32_t getMonitorInterval();      // Seconds
+uint32_t getMonitorSweepCount();    // Sweeps started since startMonitor()
+
+// GUI task: start the next sweep once the interval has passed
+void processMonitor();
+
+// Milliseconds until processMonitor() starts the next sweep, UINT32_MAX
+// while none is due (not monitoring, or a sweep is running)
+uint32_t getMonitorWaitMs();
+
+// GUI task, after a DUT's risk was calculated in a monitor sweep
+// Returns true if the result - or the tracked one - moved enough to report
+// (and remembers it)
+bool monitorRiskChanged(uint8_t dutIndex);
+
+// GUI task, when all DUTs of a monitor sweep are done
+void onMonitorSweepComplete();
+
+// Last result reported for a DUT - kept over deep sleep (sleep_monitor.h)
+struct MonitorReport {
+    RiskLevel level;
+    float percent;
+    RiskLevel trackedLevel;
+    float trackedPercent;
+};
+MonitorReport getMonitorReport(uint8_t dutIndex);
+
+// Boot after a deep-sleep wake, baseline and tracked baseline restored:
+// monitor on as before the sleep, the next sweep right away and a DUT
+// reported only if it moved from reports[dut]
+void resumeMonitor(uint32_t intervalS, uint32_t sweeps, const MonitorReport* reports, uint8_t count);
+
+#endif // MONITOR_H
@@ -0,0 +1,38 @@
+#ifndef OPEN_CHANNEL_H
+#define OPEN_CHANNEL_H
+
+#include <Arduino.h>
+#include "defines.h"
+
+/*=========================OPEN CHANNELS=========================*/
+// An empty sensor slot still gets a full sweep from the STM32: every point
+// invalid or with next to no current. The data processor checks the first
+// points each DUT sends in a session: OPEN_CHANNEL_POINTS open points in a
+// row, before any that is not, mark the DUT open. Its row is closed (no
+// repair asks for the rest) and the rest of its sweep is skipped with a
+// STOP of that DUT. A DUT that starts with a good point is taken as
+// populated for the session
+//
+// A baseline session starts with no DUT open. The final sweep keeps the
+// baseline's open DUTs: each is skipped right after the START and its row
+// closed, so it costs no sweep time at all. Its risk reads as RISK_ERROR;
+// the results screen shows it as empty
+#define OPEN_CHANNEL_POINTS     3       // Leading open points that mark a DUT open
+#define OPEN_CHANNEL_OHMS       1e8f    // Raw |V / I| above this reads as open
+
+// Data processor, new session: forget which DUTs were checked; a baseline
+// session also forgets which are open
+void resetOpenChannelScan(bool final);
+
+// Data processor, every raw point of dut (0-based) before it is calibrated
+// Returns true once, for the point that marks dut open
+bool noteOpenChannelPoint(uint8_t dut, const MeasurementPoint& point);
+
+// Mark dut (0-based) open - a restored baseline row without valid points
+void markChannelOpen(uint8_t dut);
+
+// Any task
+bool isChannelOpen(uint8_t dut);
+uint32_t getOpenChannelMask();
+
+#endif // OPEN_CHANNEL_H
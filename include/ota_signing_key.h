@@ -0,0 +1,15 @@
+#ifndef OTA_SIGNING_KEY_H
+#define OTA_SIGNING_KEY_H
+
+#include <stdint.h>
+
+/*=========================FIRMWARE UPDATE KEY=========================*/
+// Public half of the key firmware updates are signed with (ota_update.h):
+// an uncompressed P-256 point. Written by
+//   python ota_upload_ble.py --keygen ota_signing_key.pem
+// which keeps the private half in the .pem - it signs every update and
+// never goes into the tree. Until a key is set here (first byte 0x04) the
+// firmware refuses all updates
+static const uint8_t otaSigningKey[65] = {0};
+
+#endif // OTA_SIGNING_KEY_H
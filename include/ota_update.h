@@ -0,0 +1,87 @@
+#ifndef OTA_UPDATE_H
+#define OTA_UPDATE_H
+
+#include <Arduino.h>
+
+/*=========================FIRMWARE UPDATE=========================*/
+// Receives a firmware image over the BLE OTA characteristic and streams it
+// into the inactive app slot (partitions.csv: app0 / app1), then reboots
+// into it. Frames and replies are those of the calibration upload
+// (cal_upload.h): type, seq, payload, CRC-16 - one frame in flight, each
+// answered with "OTA_ACK:<seq>" or "ERROR:<reason>"
+//
+// BEGIN payload (little-endian):
+//   uint32_t imageSize       - decoded image, as written to the slot
+//   uint8_t  encoding        - OTA_ENCODING_RAW / OTA_ENCODING_DELTA
+//   uint8_t  imageSha[32]    - SHA-256 of the decoded image
+//   uint32_t baseSize        - DELTA: bytes of the running image it was made
+//   uint8_t  baseSha[32]       against (0 = none), and their SHA-256
+//   uint8_t  signature[64]   - ECDSA P-256 (r, s) of imageSha by the update
+//                              key (ota_signing_key.h)
+//
+// DATA payloads of a DELTA image are one op stream (ops may span frames):
+//   0x00 len:u16 bytes[len]    LITERAL   bytes as they are
+//   0x01 offset:u32 len:u32    COPY_BASE from the running image (< baseSize)
+//   0x02 offset:u32 len:u32    COPY_OUT  from the image already written - the
+//                              source must end at or before the last
+//                              OTA_WRITE_BUFFER boundary of the output
+//   0x03 len:u32 value:u8      FILL      one byte repeated (padding, 0xFF)
+// So a delta against the running firmware sends only what changed, and
+// COPY_OUT / FILL compress a full image. ota_upload_ble.py builds both
+//
+// BEGIN is answered once the signature verified, the slot is open (and a
+// delta base hashed). END is answered after the SHA-256 of the decoded
+// image - a delta's reconstruction as written, not the op stream - matched
+// and its signature verified again over that digest, and esp_ota_end()
+// validated the image; the device reboots OTA_REBOOT_DELAY_MS later. A
+// firmware built without a key (ota_signing_key.h) refuses every update
+//
+// Frames are only taken from a bonded, encrypted link (BLE_Functions.h,
+// BLE_PAIRING_PASSKEY): the characteristic needs MITM-protected encryption
+//
+// Rollback: an updated image boots pending verification and confirms itself
+// after OTA_SELFTEST_MS of normal operation. A failed boot self-test, or a
+// crash / watchdog reset before then, makes the bootloader return to the
+// previous slot
+#define OTA_UPDATE_BEGIN        0x01
+#define OTA_UPDATE_DATA         0x02
+#define OTA_UPDATE_END          0x03
+#define OTA_UPDATE_ABORT        0x04
+
+#define OTA_ENCODING_RAW        0
+#define OTA_ENCODING_DELTA      1
+
+#define OTA_OP_LITERAL          0x00
+#define OTA_OP_COPY_BASE        0x01
+#define OTA_OP_COPY_OUT         0x02
+#define OTA_OP_FILL             0x03
+
+#define OTA_FRAME_MAX           512     // Fits the 517-byte MTU (3 bytes ATT header)
+#define OTA_FRAME_OVERHEAD      5       // type + seq + crc
+#define OTA_SHA_SIZE            32
+#define OTA_SIGNATURE_SIZE      64      // P256_SIGNATURE_SIZE
+#define OTA_BEGIN_SIZE          (4 + 1 + OTA_SHA_SIZE + 4 + OTA_SHA_SIZE + OTA_SIGNATURE_SIZE)
+#define OTA_WRITE_BUFFER        4096    // esp_ota_write() block - one flash sector
+#define OTA_STEP_BYTES          16384   // Copy / hash work per GUI loop pass
+#define OTA_REBOOT_DELAY_MS     1000    // Lets the last OTA_ACK go out
+#define OTA_SELFTEST_MS         30000   // Normal operation before an update is confirmed
+
+// setup(), after the tasks are created: roll back an update pending
+// verification if the boot went wrong, otherwise start its confirmation timer
+void initOTAUpdate(bool tasksStarted);
+
+// BLE write callback: copy one frame into the update buffer
+// Returns false (frame dropped) if the previous frame is still being processed
+bool otaUpdateReceive(const uint8_t* data, size_t len);
+
+// GUI task loop: process a received frame in OTA_STEP_BYTES steps, reboot
+// after END, confirm a new image once OTA_SELFTEST_MS have passed
+void processOTAUpdate();
+
+// An update has started and not finished or been aborted
+bool isOTAUpdateActive();
+
+// Running slot, its state and any update in progress to Serial
+void printOTAStatus();
+
+#endif // OTA_UPDATE_H
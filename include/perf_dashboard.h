@@ -0,0 +1,47 @@
+#ifndef PERF_DASHBOARD_H
+#define PERF_DASHBOARD_H
+
+#include <Arduino.h>
+#include "task_monitor.h"
+
+/*=========================PERFORMANCE DASHBOARD=========================*/
+// Numbers of the hidden diagnostics screen (GUI_DIAGNOSTICS - hold UP on
+// the settings screen), so link and memory trouble shows at the bench
+// without a laptop. While it is shown the GUI task samples every
+// DIAG_REFRESH_MS: UART frames and errors, queue depths, heap, CPU per
+// table task, BLE notification throughput (field counters, counters.h) and
+// the last render. Rates are over the last interval; the screen pushes only
+// the rows whose text changed
+#define DIAG_REFRESH_MS     1000
+
+struct PerfSnapshot {
+    uint32_t uartFramesPerS;
+    uint32_t uartErrors;        // CRC, framing, FIFO / buffer overflows and resyncs since reset
+    uint32_t uartLost;          // Points lost on the link or dropped for want of a batch
+    uint32_t batchesQueued;     // Of MEASUREMENT_BATCH_POOL, waiting for the data processor
+    uint32_t commandsQueued;    // Of UART_CMD_REQUEST_QUEUE_DEPTH, waiting for the command task
+    uint32_t bleTxQueued;       // Bytes waiting in the BLE TX buffer
+    uint32_t bleBytesPerS;      // Notification payload sent
+    uint32_t bleErrors;         // Notifications the stack refused
+    uint32_t heapFree;
+    uint32_t heapMin;           // Lowest free heap since boot
+    uint32_t heapLargest;       // Largest free block
+    uint32_t renderUs;          // Last GUI frame
+    uint32_t renderMaxUs;
+    uint8_t taskCount;          // 0 without FreeRTOS run-time stats
+    TaskCpuLoad tasks[TASK_MONITOR_MAX];
+};
+
+// GUI task, entering the screen: take the first sample (rates start from it)
+void resetPerfDashboard();
+
+// GUI task loop: sample and redraw once per DIAG_REFRESH_MS while the
+// screen is shown
+void processPerfDashboard();
+
+// ms until the next sample, UINT32_MAX while the screen is not shown
+uint32_t getPerfDashboardWaitMs();
+
+const PerfSnapshot& getPerfSnapshot();
+
+#endif // PERF_DASHBOARD_H
@@ -0,0 +1,71 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+
+/*=========================POWER MANAGEMENT=========================*/
+// Tracks what the firmware is doing as a power state and accounts the time
+// spent in each. With POWER_SAVE the CPU scales between POWER_MIN_FREQ_MHZ
+// and POWER_MAX_FREQ_MHZ and idles in light sleep (tickless idle), woken by
+// the STM32 UART and the buttons; a sweep holds no sleep from START to the
+// end - the UART has to receive every byte - and full clock unless the link
+// runs at POWER_SLOW_LINK_BAUD or below: a few kB/s leave the CPU idle (WFI)
+// at POWER_MIN_FREQ_MHZ between RX events, and the batches are calibrated
+// and sent at DUT_END, when full or after an idle gap. Needs a framework built with CONFIG_PM_ENABLE and
+// CONFIG_FREERTOS_USE_TICKLESS_IDLE (see platformio.ini). Light sleep
+// suspends the USB serial console between wake-ups
+#ifndef POWER_SAVE
+#define POWER_SAVE 0
+#endif
+
+#define POWER_MAX_FREQ_MHZ      160
+#define POWER_MIN_FREQ_MHZ      40      // XTAL
+#define POWER_UART_WAKE_EDGES   3       // RX edges that wake from light sleep - the waking byte is lost
+#define POWER_ADV_SLOW_AFTER_MS 30000   // No activity for this long -> slow advertising
+#define POWER_SLOW_LINK_BAUD    115200  // Sweeps at or below this baud rate skip the full-clock lock
+
+// Estimated module current per state (mA, display excluded) - measure the
+// board and adjust; the report weights them by time spent in each state
+#if POWER_SAVE
+#define POWER_SWEEP_MA          38.0f
+#define POWER_SWEEP_SLOW_MA     16.0f
+#define POWER_CONNECTED_MA      6.0f
+#define POWER_ADV_FAST_MA       4.5f
+#define POWER_ADV_SLOW_MA       0.8f
+#else
+#define POWER_SWEEP_MA          38.0f
+#define POWER_SWEEP_SLOW_MA     38.0f
+#define POWER_CONNECTED_MA      26.0f
+#define POWER_ADV_FAST_MA       25.0f
+#define POWER_ADV_SLOW_MA       23.0f
+#endif
+
+enum PowerState : uint8_t {
+    POWER_STATE_SWEEP = 0,      // START queued or sweep running
+    POWER_STATE_SWEEP_SLOW,     // The same on a link at POWER_SLOW_LINK_BAUD or below
+    POWER_STATE_CONNECTED,      // Idle, BLE client connected
+    POWER_STATE_ADV_FAST,       // Idle, advertising for discovery
+    POWER_STATE_ADV_SLOW,       // Idle without activity, slow advertising
+    POWER_STATE_COUNT
+};
+
+// Configure DFS / light sleep and the wake sources - after initUART()
+// and initBLE()
+void initPowerManagement();
+
+// GUI task, every pass: follow the sweep / BLE state
+void processPowerManagement();
+
+// Button, serial or BLE activity - back to fast advertising
+void notePowerActivity();
+
+// Milliseconds until processPowerManagement() slows advertising down,
+// UINT32_MAX while nothing is due
+uint32_t getPowerWaitMs();
+
+PowerState getPowerState();
+
+// Time per state and the time-weighted average current (serial "power")
+void printPowerReport();
+
+#endif // POWER_MANAGER_H
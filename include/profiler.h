@@ -0,0 +1,51 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+
+/*=========================SAMPLING PROFILER=========================*/
+// Statistical profiler for units without JTAG: a GPTimer alarm interrupt
+// records the interrupted PC (mepc) and the running task at a fixed rate into
+// a RAM ring ("prof start [hz]", "prof stop"). The ring is dumped over USB
+// serial ("prof dump") and profile_report.py resolves the PCs against the
+// firmware ELF - per function and per task, on real workloads
+//
+// The ISR is not in IRAM: no samples are taken while the flash cache is off.
+// An enabled GPTimer holds a PM lock, so POWER_SAVE builds stay awake while
+// it runs
+//
+// Dump: "PROF_BEGIN <ver> <count> <record_size> <hz>\n" + count records,
+// oldest first + "\n", one "PROF_TASK <handle hex> <name>\n" per live task,
+// then "PROF_END\n"
+// Set -D PROFILER=0 to compile it out
+#ifndef PROFILER
+#define PROFILER 1
+#endif
+
+#define PROFILER_RING_SIZE      2048    // Samples (power of two) - 8 bytes each, allocated on first start
+#define PROFILER_DEFAULT_HZ     997     // Prime - does not alias with the 1 kHz tick
+#define PROFILER_MAX_HZ         10000
+#define PROFILER_FORMAT_VER     1
+
+// One sample (little-endian, as dumped)
+struct __attribute__((packed)) ProfileSample {
+    uint32_t pc;            // Interrupted instruction
+    uint32_t task;          // TaskHandle_t running at the time
+};
+
+static_assert(sizeof(ProfileSample) == 8, "ProfileSample layout is part of the dump format");
+static_assert((PROFILER_RING_SIZE & (PROFILER_RING_SIZE - 1)) == 0, "PROFILER_RING_SIZE must be a power of two");
+
+// Clear the ring and sample at hz (1..PROFILER_MAX_HZ)
+// Returns false if the ring or the timer could not be set up
+bool startProfiler(uint32_t hz);
+
+void stopProfiler();
+
+// Running / rate, samples in the ring and taken since the last start
+void printProfilerStatus();
+
+// Stream the ring out over USB serial, oldest sample first (see above)
+void dumpProfiler();
+
+#endif // PROFILER_H
@@ -0,0 +1,34 @@
+#ifndef PSSESSION_EXPORT_H
+#define PSSESSION_EXPORT_H
+
+#include <Arduino.h>
+
+/*=========================PSSESSION EXPORT=========================*/
+// Stored sweeps as a PalmSens .pssession document, opened directly by
+// PSTrace / PStouch - the file esp32_data_capture.py used to build from
+// scraped CSV text. JSON in UTF-16LE between two byte order marks: one
+// measurement per DUT with valid points, each an EIS data set of Idc,
+// potential, time, Frequency, ZRe, ZIm, Z, Phase and Iac arrays (the current
+// arrays from |Z| at the PSSESSION_AMPLITUDE_V excitation)
+//
+// The document is generated while it is sent: text is widened into a
+// PSSESSION_CHUNK stack buffer that goes to the sink whenever it is full,
+// straight from the session store - no document buffer. Served over USB
+// (serial "export pssession", usb_export.h) and Wi-Fi (GET /session.pssession)
+#define PSSESSION_CHUNK         512     // UTF-16 bytes per sink call
+#define PSSESSION_AMPLITUDE_V   0.01f   // AC amplitude in the method and Iac
+#define PSSESSION_CORE_VERSION  "5.8.1704.29098"
+
+// Takes len document bytes; false stops the export (connection gone)
+typedef bool (*PsSessionSink)(const uint8_t* data, size_t len, void* context);
+
+// Whether a document of the final (else baseline) rows would hold a point
+bool hasPsSessionData(bool final);
+
+// Write the document of the final (else baseline) rows to sink - any task.
+// False if no row holds a valid point (nothing is written), the sink
+// refused a chunk, or a new session cleared the rows while they were read
+// (the document is cut short)
+bool writePsSession(bool final, PsSessionSink sink, void* context);
+
+#endif // PSSESSION_EXPORT_H
@@ -0,0 +1,80 @@
+#ifndef RAW_CAPTURE_H
+#define RAW_CAPTURE_H
+
+#include <Arduino.h>
+#include "defines.h"
+
+/*=========================RAW CAPTURE=========================*/
+// Debug / re-calibration mode: the data processor keeps the STM32 points as
+// received (V, I, phase, PGA, TIA) in a RAM ring instead of calculating,
+// calibrating and storing impedance. Sweeps still run and complete as usual,
+// but their rows stay empty. The ring is dumped over USB serial ("raw dump")
+// and decoded by raw_capture_decode.py, so calibration can be re-run offline
+// on the same data without re-sweeping
+//
+// Dump: "RAW_BEGIN <ver> <count> <record_size>\n" + count records, oldest
+// first + "\nRAW_END <crc>\n" (CRC-16/CCITT-FALSE over the records, hex)
+#define RAW_CAPTURE_RING_SIZE   1024    // Records (power of two) - 20 bytes each, allocated on first use
+#define RAW_CAPTURE_FORMAT_VER  1
+
+// One captured point (little-endian, as dumped)
+struct __attribute__((packed)) RawCaptureRecord {
+    uint32_t freqHz;
+    float vMagnitude;
+    float iMagnitude;
+    float phaseDeg;         // V-I phase difference
+    uint8_t dut;            // 1-based, as sent by the STM32
+    uint8_t flags;          // IMPEDANCE_FLAG_* | PGA gain
+    uint8_t freqIdx;        // Sweep table index, 0xFF if unknown
+    uint8_t sweep;          // 0 baseline, 1 final
+};
+
+static_assert(sizeof(RawCaptureRecord) == 20, "RawCaptureRecord layout is part of the dump format");
+static_assert((RAW_CAPTURE_RING_SIZE & (RAW_CAPTURE_RING_SIZE - 1)) == 0,
+              "RAW_CAPTURE_RING_SIZE must be a power of two");
+
+// Turn capture on (allocates the ring the first time) or off
+// Returns false if the ring could not be allocated
+bool setRawCapture(bool on);
+
+bool isRawCaptureActive();
+
+// Data processor: keep one point of a batch in the ring (oldest overwritten)
+void captureRawPoint(uint8_t dut, bool final, const MeasurementPoint& point);
+
+// Records in the ring / total captured since the last clear
+uint32_t getRawCaptureCount();
+uint32_t getRawCaptureTotal();
+
+// Discard the captured points
+void clearRawCapture();
+
+// Stream the ring out over USB serial, oldest record first (see above)
+void dumpRawCapture();
+
+/*=========================RECALIBRATION=========================*/
+// "raw recal": the captured sweeps through the calibration pipeline again
+// with the calibration now active (after "cal reload" / "cal set") and stored
+// in their rows as if they had been measured calibrated. Only the newest
+// session of each kind in the ring is used, and only while it still owns its
+// rows - the baseline first, so the final points pair with it. Repeats are
+// averaged as in a sweep (repeat_filter.h), a re-measured index keeps its
+// newest point. Final rows get new risk sums and spectral metrics; KK check
+// and fit run again on both kinds
+struct RawRecalResult {
+    uint16_t baselineDuts;  // Bit per DUT (0-based) whose baseline row was rewritten
+    uint16_t finalDuts;     // Same for the final rows
+    uint16_t points;        // Points stored
+    uint16_t uncalibrated;  // Points calibrate() failed on (stored as calculated)
+    bool truncated;         // The ring had lost the first records of a session
+};
+
+static_assert(MAX_DUT_COUNT <= 16, "RawRecalResult holds one bit per DUT");
+
+// GUI task, no sweep running and no calibration swap pending - this task
+// then stands in for the data processor. Final risk sums count the
+// baseline frequencies within freqStartHz..freqEndHz; the caller classifies
+// the rewritten final DUTs (calculateRiskLevel, finishSpectralMetrics)
+RawRecalResult recalibrateRawCapture(uint32_t freqStartHz, uint32_t freqEndHz);
+
+#endif // RAW_CAPTURE_H
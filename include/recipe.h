@@ -0,0 +1,103 @@
+#ifndef RECIPE_H
+#define RECIPE_H
+
+#include <Arduino.h>
+#include "sweep_presets.h"
+
+/*=========================SWEEP RECIPES=========================*/
+// A multi-step protocol (baseline, wait, measure, repeat, export) uploaded
+// once and run by the firmware, so the host does not send each step. The
+// text form is a comma-separated list of steps, parsed and validated when
+// it is uploaded (RECIPE:<steps>, serial "recipe <steps>"):
+//   B[n]         baseline of n DUTs (default all configured) with the
+//                current plan, band and cutoffs (as serial "start")
+//   P<name>      baseline from sweep preset name (sweep_presets.h)
+//   M            final sweep against the baseline
+//   W<s>         wait s seconds from the end of the step before
+//   L<step>x<n>  run steps <step> (1-based) up to this one n times in all
+//   E            the .pssession document of the last sweep over USB
+//                (serial "export pssession", usb_export.h)
+// e.g. "B,W300,M,L2x6,E": a baseline, then six final sweeps five minutes
+// apart, then the export. Sweeps are delivered as usual (DATA, RISK,
+// archive); a recipe step starts from the sweep-complete delivery of the
+// one before. Each step logs "@EVT recipe_step", the end "@EVT recipe_end"
+//
+// While a recipe runs it owns the sweeps (MEAS_REQUEST_RECIPE for the other
+// sources); STOP (button, BLE, serial) ends it with the sweep. The steps
+// live in RECIPE_FILE (one RecipeFile with a CRC), loaded at boot. GUI task
+// only
+#define RECIPE_FILE             "/recipe.dat"
+#define RECIPE_MAGIC            0x50434552  // "RECP"
+#define RECIPE_VERSION          1
+#define RECIPE_MAX_STEPS        16
+#define RECIPE_WAIT_MAX_S       86400       // Longest W step
+#define RECIPE_LOOP_MAX         1000        // Largest L count
+
+enum RecipeOp : uint8_t {
+    RECIPE_OP_BASELINE,
+    RECIPE_OP_PRESET,
+    RECIPE_OP_MEASURE,
+    RECIPE_OP_WAIT,
+    RECIPE_OP_LOOP,
+    RECIPE_OP_EXPORT
+};
+
+struct RecipeStep {
+    RecipeOp op;
+    uint16_t count;                     // L: runs in all
+    uint32_t value;                     // B: DUTs (0 = all), W: seconds, L: first step (0-based)
+    char preset[SWEEP_PRESET_NAME_MAX]; // P
+};
+
+struct RecipeFile {
+    uint32_t magic;                     // RECIPE_MAGIC
+    uint16_t version;                   // RECIPE_VERSION
+    uint8_t count;
+    RecipeStep steps[RECIPE_MAX_STEPS];
+    uint16_t crc;                       // CRC-16/CCITT (crc.h) of everything before it
+};
+
+enum RecipeError : uint8_t {
+    RECIPE_OK = 0,
+    RECIPE_SYNTAX,              // A step does not parse or is out of range
+    RECIPE_EMPTY,               // No steps, or none stored
+    RECIPE_TOO_LONG,            // More than RECIPE_MAX_STEPS steps
+    RECIPE_BUSY,                // A recipe, the monitor or a sweep is running
+    RECIPE_STORAGE              // Kept in RAM, but not queued for flash
+};
+
+// Boot, after initStorage(): read the stored recipe
+void loadRecipe();
+
+// Parse and store the steps of text. errorStep (1-based) is the step a
+// RECIPE_SYNTAX refers to
+RecipeError saveRecipe(const char* text, uint8_t* errorStep = nullptr);
+
+// Run the stored recipe from its first step
+RecipeError runRecipe();
+
+// A stop ended the recipe's sweep or wait (meas_control.cpp) - reason is the
+// @EVT token. No-op if none runs
+void abortRecipe(const char* reason);
+
+bool isRecipeRunning();
+
+// GUI task loop: start the steps that are due
+void processRecipe();
+
+// Milliseconds until processRecipe() has a step due, UINT32_MAX while none
+// is (no recipe, or its sweep runs)
+uint32_t getRecipeWaitMs();
+
+// main.cpp, after the sweep-complete delivery (export, BLE status)
+void recipeSweepComplete(bool final);
+
+// The stored steps in their text form, into out; "" if none
+void formatRecipe(char* out, size_t size);
+
+// Steps, and the running step, to Serial
+void printRecipe();
+
+const char* recipeErrorText(RecipeError error);
+
+#endif // RECIPE_H
@@ -0,0 +1,58 @@
+#ifndef REPEAT_FILTER_H
+#define REPEAT_FILTER_H
+
+#include <Arduino.h>
+#include "defines.h"
+
+/*=========================REPEAT AVERAGING=========================*/
+// With a repeat count N > 1 the STM32 measures every frequency N times in a
+// row (START data1 bits 16-23, see setSweepRepeats()). The data processor
+// feeds each calibrated repeat in here; a per-DUT streaming estimator keeps
+// the running mean and variance of |Z| and phase (Welford) and rejects a
+// repeat whose |Z| lies more than REPEAT_REJECT_SIGMA standard deviations
+// from the mean of the repeats accepted so far - no raw repeats are buffered
+//
+// An adaptive repeat plan sets N per sweep index instead (repeat_plan.h)
+//
+// A point is finished after N repeats, or early when the next frequency or
+// the DUT_END arrives (STM32 firmware that ignores the repeat count simply
+// gives one repeat per point)
+#define REPEAT_COUNT_MAX            16
+#define REPEAT_REJECT_SIGMA         3.0f
+#define REPEAT_REJECT_MIN_SAMPLES   3       // Accepted repeats before rejection starts
+
+// Spread stored per point - one byte each, saturating at 255
+#define POINT_NOISE_MAG_STEP        0.1f    // Relative |Z| standard deviation, % per LSB
+#define POINT_NOISE_PHASE_STEP      0.1f    // Phase standard deviation, degrees per LSB
+
+struct PointNoise {
+    uint8_t magSd;          // POINT_NOISE_MAG_STEP units, 0 = single repeat
+    uint8_t phaseSd;        // POINT_NOISE_PHASE_STEP units
+    uint8_t repeats;        // Repeats averaged
+    uint8_t rejected;       // Repeats dropped as outliers
+
+    PointNoise() : magSd(0), phaseSd(0), repeats(1), rejected(0) {}
+};
+
+// Repeats per frequency the next sweeps ask for (1 to REPEAT_COUNT_MAX)
+// Call between sweeps - the data processor reads it while a sweep runs
+bool setSweepRepeats(uint8_t repeats);
+uint8_t getSweepRepeats();
+
+// Drop any partially averaged points (start of a sweep)
+void resetRepeatFilter();
+
+// Add one repeat of DUT dutIndex (0-based)
+// Returns true with the finished point in out/noise if this completes one -
+// the previous frequency when sample starts a new one, otherwise sample's own
+// frequency on its last repeat
+bool addRepeatSample(uint8_t dutIndex, const ImpedancePoint& sample, ImpedancePoint& out, PointNoise& noise);
+
+// Finish the point still being averaged for dutIndex (at DUT_END)
+// Returns false if there is none
+bool flushRepeatSample(uint8_t dutIndex, ImpedancePoint& out, PointNoise& noise);
+
+// Total repeats rejected since the last resetRepeatFilter()
+uint32_t getRejectedRepeatCount();
+
+#endif // REPEAT_FILTER_H
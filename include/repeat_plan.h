@@ -0,0 +1,73 @@
+#ifndef REPEAT_PLAN_H
+#define REPEAT_PLAN_H
+
+#include <Arduino.h>
+#include "sweep_table.h"
+
+/*=========================ADAPTIVE REPEATS=========================*/
+// Repeats per sweep table index instead of one count for the whole sweep:
+// after each sweep the spread the repeat filter measured at an index (the
+// worst DUT) sets how many repeats it needs for the mean to reach
+// REPEAT_PLAN_TARGET_MAG_SE / REPEAT_PLAN_TARGET_PHASE_SE - n = (sd / se)^2.
+// Quiet mid-band points drop to REPEAT_PLAN_MIN, the noisy low and high ends
+// get more, up to REPEAT_COUNT_MAX. A count at most doubles or halves per
+// sweep, so one disturbed sweep does not swing the plan
+//
+// The STM32's only per-point averaging control is the repeat count, so the
+// plan goes out as CMD_SET_REPEAT_PLAN before a START with
+// START_FLAG_REPEAT_PLAN. Firmware that does not ACK it gets the uniform
+// count (getSweepRepeats()) and the plan is not applied to that sweep.
+// Presets keep the plan they learned (sweep_presets.h)
+//
+// Set -D REPEAT_PLAN_ADAPTIVE=1 to start adaptive at boot
+#ifndef REPEAT_PLAN_ADAPTIVE
+#define REPEAT_PLAN_ADAPTIVE 0
+#endif
+#define REPEAT_PLAN_TARGET_MAG_SE   0.2f    // Standard error of the mean |Z|, % of |Z|
+#define REPEAT_PLAN_TARGET_PHASE_SE 0.1f    // Standard error of the mean phase, degrees
+#define REPEAT_PLAN_MIN             2       // A single repeat leaves the spread unmeasured
+
+// Repeats per index, 4 bits each (count - 1) - the preset layout
+struct RepeatPlan {
+    uint8_t nibbles[(SWEEP_FREQ_COUNT + 1) / 2];
+};
+
+inline uint8_t getRepeatPlanCount(const RepeatPlan& plan, uint8_t freqIdx) {
+    return ((plan.nibbles[freqIdx / 2] >> (4 * (freqIdx & 1))) & 0x0F) + 1;
+}
+
+inline void setRepeatPlanCount(RepeatPlan& plan, uint8_t freqIdx, uint8_t repeats) {
+    uint8_t shift = 4 * (freqIdx & 1);
+    plan.nibbles[freqIdx / 2] = (plan.nibbles[freqIdx / 2] & ~(0x0F << shift)) | ((repeats - 1) & 0x0F) << shift;
+}
+
+// Between sweeps (GUI task)
+void setAdaptiveRepeats(bool enable);
+bool isAdaptiveRepeats();
+
+// Every index back to the uniform count (at least REPEAT_PLAN_MIN)
+void resetRepeatPlan();
+
+const RepeatPlan& getRepeatPlan();
+void setRepeatPlan(const RepeatPlan& plan);
+
+// UART start: whether the sweep being started over mask runs the plan
+// (every link ACKed it)
+void setRepeatPlanApplied(bool applied, SweepMask mask);
+bool isRepeatPlanApplied();
+
+// Frames per DUT the applied plan asks for (DUT_END loss count)
+uint32_t getRepeatPlanFrames();
+
+// Repeats the running sweep makes at freqIdx - the plan when applied, else
+// getSweepRepeats() (also for SWEEP_FREQ_INVALID). Any task
+uint8_t getPointRepeats(uint8_t freqIdx);
+
+// GUI task, after a sweep: learn from the spread of its rows (final or
+// baseline). Returns true if the plan changed
+bool learnRepeatPlan(bool final);
+
+// Repeats and point time per index to Serial
+void printRepeatPlan();
+
+#endif // REPEAT_PLAN_H
@@ -0,0 +1,84 @@
+#ifndef SCREEN_MIRROR_H
+#define SCREEN_MIRROR_H
+
+#include <Arduino.h>
+
+/*=========================SCREEN MIRROR=========================*/
+// The panel as pushed, mirrored to a host for remote support. There is no
+// frame buffer to diff against: the render already draws only the dirty
+// rect of a frame, so the mirror encodes what each band pushes, as it is
+// pushed. The screen is split into MIRROR_TILE_W x MIRROR_TILE_H tiles and
+// the hash of every tile sent is kept (300 x 4 bytes) - a tile redrawn with
+// the same pixels (a full redraw, a widget hashed as changed) is skipped.
+// A changed screen costs a few hundred bytes instead of 150 KB
+//
+// Sinks, any combination (GUI task - all of this runs in the render):
+//   USB   USB_EXPORT_MIRROR frames on the export channel (usb_export.h)
+//   BLE   binary notifications to the connection that sent MIRROR:BLE
+//   Wi-Fi binary frames on the live WebSockets (wifi_server.h)
+//
+// Packet (at most the smallest sink's size, MIRROR_PACKET_MAX):
+//   ScreenMirrorHeader | tiles x (ScreenMirrorTile | RLE rows)
+// RLE, per row of the tile: a count byte n - bit 7 clear: (n & 0x7F) + 1
+// literal pixels follow, bit 7 set: the next pixel repeats (n & 0x7F) + 1
+// times. Pixels are RGB565 in panel byte order (big-endian), as the strips
+// hold them. A packet a sink refuses (BLE or Wi-Fi buffer full) forgets the
+// hashes of its tiles and redraws the whole screen on the next frame, so
+// the host catches up instead of keeping a stale tile
+//
+// The host keeps a 320x240 image and pastes every tile as it arrives;
+// MIRROR_FLAG_END marks the last packet of a frame (screen_mirror_view.py)
+#define MIRROR_TILE_W       32
+#define MIRROR_TILE_H       8           // Bands are a whole number of tile rows
+#define MIRROR_PACKET_MAX   512
+#define MIRROR_BLE_MIN_PAYLOAD 128      // Smaller MTUs cannot take one tile row
+
+#define MIRROR_SINK_USB     0x01
+#define MIRROR_SINK_BLE     0x02
+#define MIRROR_SINK_WIFI    0x04
+
+#define MIRROR_FLAG_END     0x01        // Last packet of the frame
+
+struct __attribute__((packed)) ScreenMirrorHeader {
+    uint8_t magic;          // BLE_BIN_MAGIC
+    uint8_t type;           // BLE_BIN_TYPE_MIRROR
+    uint8_t frame;          // Frame number (wraps)
+    uint8_t flags;          // MIRROR_FLAG_*
+    uint8_t part;           // Packet of the frame (0-based)
+    uint8_t tiles;          // Tiles in this packet
+};
+
+struct __attribute__((packed)) ScreenMirrorTile {
+    uint16_t x;             // Screen rect of the pixels
+    uint16_t y;
+    uint8_t w;
+    uint8_t h;
+    uint16_t bytes;         // RLE bytes after this header
+};
+
+// Switch sinks on or off. Turning one on sends the whole screen again;
+// BLE goes to the connection whose command is being processed. Returns
+// false if that sink is not available (no Wi-Fi build, MTU too small)
+bool setScreenMirror(uint8_t sink, bool enable);
+uint8_t getScreenMirrorSinks();
+
+// "off" or the sinks on, e.g. "usb+ble" - for STATUS and the serial console
+void formatMirrorSinks(char* out, size_t size);
+
+// Render hooks (gui_screens.cpp). Rows [top, top + rows) of the screen, as
+// pushed, in columns [left, right); pixels is row top, column 0, rows
+// SCREEN_WIDTH pixels apart
+bool isScreenMirrorActive();
+void mirrorRows(const uint16_t* pixels, int16_t top, int16_t rows, int16_t left, int16_t right);
+
+// SCREEN_WIDTH x MIRROR_TILE_H pixels for strips that are expanded first
+// (GUI_SPRITE_4BIT, RENDER_TIER_8BIT), nullptr if it could not be allocated
+uint16_t* getMirrorRowBuffer();
+
+// Send what the frame left queued, marked MIRROR_FLAG_END
+void endMirrorFrame();
+
+// Sinks, bytes and packets sent, refused packets (serial "stats")
+void printScreenMirrorStats();
+
+#endif // SCREEN_MIRROR_H
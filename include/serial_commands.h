@@ -5,10 +5,22 @@
 
 /*=========================SERIAL COMMANDS=========================*/
 // Process serial commands from computer (USB Serial)
-// Call this regularly from a task to check for commands
-// Commands:
-//   start [num_duts]  - Start measurement (default 4 DUTs, or specify 1-4)
-//   stop              - Stop measurement
+// Reads only the bytes already received into a fixed line buffer and runs
+// each completed line through the command table (serial_commands.cpp, also
+// the "help" text) - never waits for the rest of a line. Called by the GUI
+// task on GUI_WAKE_SERIAL
 void processSerialCommands();
 
+// A sweep finished and its export was sent: report it (@EVT sweep) and
+// start the next sweep of a "run" (GUI task)
+void serialSweepComplete(bool final);
+
+// The running sweep was stopped by the firmware: end a "run" with reason
+// (@EVT run_end ... <reason>) if the sweep was the run's (GUI task)
+void serialSweepAborted(const char* reason);
+
+// Wake the GUI task when serial bytes arrive (call from the GUI task
+// after registerGUITask)
+void initSerialCommands();
+
 #endif // SERIAL_COMMANDS_H
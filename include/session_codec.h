@@ -0,0 +1,94 @@
+#ifndef SESSION_CODEC_H
+#define SESSION_CODEC_H
+
+#include "hal.h"
+#include "defines.h"
+
+/*=========================SESSION RECORDS=========================*/
+// A session record is a SessionHeader and header.bytes of coded points. The
+// session log (session_log.h) stores records back to back, and the history
+// download serves the log files as one image. Platform-free: the firmware
+// archives and reads records with it, the host SDK (biopal_sdk.h) decodes
+// downloaded images
+//
+// Points are quantized to SESSION_MAG_STEPS_PER_LN steps of ln|Z| (0.006 %)
+// and SESSION_PHASE_STEP_DEG, and coded as zig-zag varints:
+//   self-contained  per point the frequency, ln|Z| and phase change from the
+//                   point before; every baseline is coded this way
+//   delta           a final against header.reference, a self-contained
+//                   record of the same DUT in the same log file: per point
+//                   the change of (ln|Z| ratio, phase difference) from the
+//                   point before - both follow the spectrum slowly, so most
+//                   points take two bytes
+// then the flag changes (count, then point index and XOR of each). A final
+// whose frequencies differ from its reference's is self-contained and the
+// reference of the next ones. Monitoring finals take ~100 bytes instead of
+// the 512 of a fixed record
+#define SESSION_MAGIC           0x33534553  // "SES3" - coded records
+
+#define SESSION_MAG_STEPS_PER_LN    8192    // |Z| stored as round(ln|Z| * 8192)
+#define SESSION_PHASE_STEP_DEG      0.01f
+#define SESSION_MAG_MIN             1e-6f   // Smaller (or not finite) |Z| is stored as this
+#define SESSION_NO_REFERENCE        0xFFFFFFFF
+// Worst case: three 5-byte varints per point, the flag count and a change per point
+#define SESSION_DATA_MAX            (MAX_FREQUENCIES * 15 + 5 + MAX_FREQUENCIES * 6)
+
+enum SessionKind : uint8_t {
+    SESSION_BASELINE = 0,
+    SESSION_FINAL = 1
+};
+
+// One stored point - frequency in Hz so log records outlive the RAM axis
+struct __attribute__((packed)) SessionPoint {
+    uint32_t freq_hz;
+    float mag;
+    float phase;
+    uint8_t flags;          // IMPEDANCE_FLAG_* | PGA gain
+};
+
+// Session header - the start of its record and its index entry
+struct __attribute__((packed)) SessionHeader {
+    uint32_t magic;         // SESSION_MAGIC
+    uint32_t timestamp;     // Seconds (session_log.h)
+    uint8_t dut;            // DUT number (1-based)
+    uint8_t kind;           // SessionKind
+    uint8_t count;          // Valid points
+    uint8_t risk;           // RiskLevel of a final session, RISK_NONE for a baseline
+    float riskPercent;
+    uint32_t offset;        // Of this record in its log file
+    uint32_t reference;     // Offset of the record the points are coded against, SESSION_NO_REFERENCE
+    uint16_t bytes;         // Coded point bytes after the header
+    uint16_t crc;           // CRC-16/CCITT (crc.h) of the header (crc 0) and the coded points
+};
+
+// A session with its points decoded - offset, reference and bytes are set
+// once the record is written
+struct Session {
+    SessionHeader header;
+    SessionPoint points[MAX_FREQUENCIES];   // Zero past count
+};
+
+// Quantize the points in place, as a record gives them back
+void quantizeSessionPoints(Session& session);
+
+// Same frequencies as ref, so session can be coded against it
+bool sessionMatchesReference(const Session& session, const Session& ref);
+
+// Code the points against ref, self-contained if ref is nullptr, into out
+// (SESSION_DATA_MAX bytes); returns the bytes
+size_t encodeSessionPoints(const Session& session, const Session* ref, uint8_t* out);
+
+// Decode header.bytes of coded points into out (header copied), ref as for
+// encodeSessionPoints; false if the data does not decode to exactly count points
+bool decodeSessionPoints(const SessionHeader& header, const uint8_t* data, const Session* ref, Session& out);
+
+// CRC-16/CCITT of the header (crc 0) and the coded points - header.crc
+uint16_t sessionRecordCrc(const SessionHeader& header, const uint8_t* data);
+
+// The header fields a record must have at offset of its log file
+inline bool isSessionHeader(const SessionHeader& header, uint32_t offset) {
+    return header.magic == SESSION_MAGIC && header.offset == offset &&
+           header.count <= MAX_FREQUENCIES && header.bytes <= SESSION_DATA_MAX;
+}
+
+#endif // SESSION_CODEC_H
@@ -0,0 +1,61 @@
+#ifndef SESSION_LOG_H
+#define SESSION_LOG_H
+
+#include <Arduino.h>
+#include "session_codec.h"
+
+/*=========================SESSION HISTORY=========================*/
+// Every finished DUT sweep (baseline or final) is archived as a session keyed
+// by timestamp and DUT and written to flash at once - one record per DUT, so
+// a reset loses nothing already archived. The newest SESSION_RAM_DEPTH stay
+// in a RAM ring as a cache for HISTORY requests
+//
+// Flash layout (LittleFS): SESSION_LOG_FILE holds records - a SessionHeader
+// and header.bytes of coded points - back to back, and SESSION_INDEX_FILE
+// the header of record i at i * sizeof(SessionHeader). Listing and lookups
+// read only the index and seek straight to header.offset. Once the log
+// reaches SESSION_SEGMENT_BYTES both files are renamed to the _OLD names
+// (the segment before is dropped whole), so no record is ever rewritten and
+// flash use stays bounded
+//
+// Points are coded as in session_codec.h - a final delta-coded against the
+// DUT's newest self-contained record in the same log file
+//
+// Timestamps are Unix seconds once the WebUI has set the clock (TIME:<s>),
+// seconds since boot before that
+#define SESSION_RAM_DEPTH       8
+#define SESSION_LOG_FILE        "/sessions.log"
+#define SESSION_LOG_OLD_FILE    "/sessions.old"
+#define SESSION_INDEX_FILE      "/sessions.idx"
+#define SESSION_INDEX_OLD_FILE  "/sessions.old.idx"
+#define SESSION_SEGMENT_BYTES   65536   // 64 KB log per segment
+#define SESSION_LIST_MAX        32      // Newest sessions listed by HISTORY
+
+// Set the wall clock (Unix seconds) used for new session timestamps
+void setSessionClock(uint32_t unixSeconds);
+
+// Current session timestamp
+uint32_t getSessionTime();
+
+// Archive the stored row of DUT dutIndex (0-based) as a new session
+// final: the final row with its risk result, else the baseline row
+// Appends its record and index entry to flash (GUI task, between DUTs). The
+// points are quantized as stored, also the copy in the RAM ring
+void archiveSession(uint8_t dutIndex, bool final);
+
+// Find a session by timestamp and DUT number - RAM ring first, then the index
+bool findSession(uint32_t timestamp, uint8_t dut, Session& out);
+
+// Visit the headers of the newest sessions (at most maxCount), newest first
+// Returns the number visited
+typedef void (*SessionVisitor)(const SessionHeader& header, void* context);
+int listSessions(int maxCount, SessionVisitor visitor, void* context);
+
+// Retry the sessions whose append was not queued and wait for the storage
+// queue; true once every session is in flash
+bool flushSessions();
+
+// Print the newest sessions to Serial, with the log size and coding ratio
+void printSessions();
+
+#endif // SESSION_LOG_H
@@ -0,0 +1,87 @@
+#ifndef SLEEP_MONITOR_H
+#define SLEEP_MONITOR_H
+
+#include <Arduino.h>
+
+/*=========================SLEEP MONITOR=========================*/
+// Monitor mode (monitor.h) on a battery: between two scheduled sweeps the
+// ESP32 goes to deep sleep (-D SLEEP_MONITOR=1, [env:sleep]). SLEEP:<s>[,<h>]
+// or serial "sleep <s> [h]" starts the monitor as MONITOR does and arms it;
+// after every sweep the session is packed into RTC memory and the timer
+// wakes the chip for the next one
+//
+// Kept in RTC memory (SleepMonitorState, CRC-checked): the baseline records
+// as the baseline file holds them (baseline_store.h), the fused calibration
+// rows of the planned indices only (calibration.h), the store layout, repeats,
+// calculation band and risk cutoffs, and the monitor's accumulated state -
+// the last reported result per DUT and the tracked baseline
+//
+// A scheduled wake skips the splash, the LittleFS mount, the calibration
+// files and BLE: setup() restores the session from RTC memory and the sweep
+// starts at once, with the panel off. A DUT whose result moved as monitor
+// mode judges it brings BLE up for SLEEP_REPORT_WINDOW_MS - the moved RISK
+// (and TRACK) lines go to the first client that subscribes; otherwise the
+// chip sleeps again right after the sweep. Each sweep ends with an
+// "@EVT sleep_summary" line on the console
+//
+// Any other boot (reset, power-on) disarms - the buttons are not on LP GPIO
+// and cannot wake the chip, so the reset button ends a run. Stopping the
+// monitor on a wake (button, STOP, SLEEP:0) disarms and restarts into a
+// normal boot. Fast wakes archive nothing (no LittleFS): the session log
+// holds the arming sweep only
+#ifndef SLEEP_MONITOR
+#define SLEEP_MONITOR 0
+#endif
+
+#define SLEEP_MONITOR_MAGIC         0x504C5353  // "SSLP"
+#define SLEEP_MONITOR_VERSION       1
+#define SLEEP_MONITOR_MAX_DUTS      4           // Baseline records kept
+#define SLEEP_MONITOR_MAX_POINTS    24          // Planned indices whose calibration rows are kept
+#define SLEEP_MONITOR_MIN_INTERVAL_S 60         // Shorter runs stay awake (MONITOR)
+#define SLEEP_MONITOR_MIN_SLEEP_MS  1000        // Shortest timer sleep
+#define SLEEP_REPORT_WINDOW_MS      30000       // BLE up this long for a client after a change
+#define SLEEP_DRAIN_MS              2000        // Longest wait for BLE TX and storage before sleeping
+#define SLEEP_POLL_MS               100         // GUI wake-up period during the window and the drain
+
+#if SLEEP_MONITOR
+// Start the monitor every intervalS seconds (trackHalfLife as startMonitor)
+// and sleep between its sweeps. Needs a baseline of at most
+// SLEEP_MONITOR_MAX_DUTS DUTs and SLEEP_MONITOR_MAX_POINTS planned indices,
+// separate-files calibration and an idle sweep
+bool startSleepMonitor(uint32_t intervalS, uint32_t trackHalfLife = 0);
+
+// Disarm - the monitor runs on awake. On a scheduled wake: restart into a
+// normal boot
+void stopSleepMonitor();
+
+bool isSleepMonitorArmed();
+
+// setup(), first thing: whether this boot is a scheduled wake with a valid
+// kept session. Any other boot disarms
+bool checkSleepMonitorWake();
+
+// setup() on such a wake, after initGUIState(false) and before the tasks
+// start: the layout, calibration rows, baseline and monitor from RTC memory.
+// Restarts into a normal boot if they do not fit
+void restoreSleepMonitor();
+
+// monitor.cpp, when all DUTs of a monitor sweep are done
+void sleepMonitorSweepComplete();
+
+// GUI task loop: report window, then deep sleep
+void processSleepMonitor();
+
+// Milliseconds until processSleepMonitor() has a step due, UINT32_MAX if none
+uint32_t getSleepMonitorWaitMs();
+
+// Armed state, wakes and the last summary (serial "sleep")
+void printSleepMonitor();
+#else
+inline bool checkSleepMonitorWake() { return false; }
+inline void restoreSleepMonitor() {}
+inline void sleepMonitorSweepComplete() {}
+inline void processSleepMonitor() {}
+inline uint32_t getSleepMonitorWaitMs() { return UINT32_MAX; }
+#endif
+
+#endif // SLEEP_MONITOR_H
@@ -0,0 +1,76 @@
+#ifndef SPECTRAL_METRICS_H
+#define SPECTRAL_METRICS_H
+
+#include "hal.h"
+#include "defines.h"
+
+/*=========================SPECTRAL METRICS=========================*/
+// Baseline-relative metrics of a DUT's final sweep, next to the averaged
+// |Z| ratio behind RISK. Every metric is a row of the table in
+// spectral_metrics.cpp with a reset, a constant-time per-point update and a
+// finish hook: the data processor feeds each final point paired with its
+// baseline point (accumulateRiskPoint(), impedance_calc.h) as it is stored,
+// so the results are ready at DUT_END without another pass over the rows
+//
+// Configured with METRICS:<mask>,<marker>,<split lo>,<split hi>,<band>,<phase>,<area>,<fit>
+// (any leading subset, like BASELINE_START) between sweeps. A metric whose
+// magnitude reaches its threshold sets its bit in the result's alarm mask
+enum SpectralMetric : uint8_t {
+    METRIC_BAND_LOW = 0,        // Mean |Z| reduction below split lo (fraction)
+    METRIC_BAND_MID,            // ... between split lo and split hi
+    METRIC_BAND_HIGH,           // ... above split hi
+    METRIC_PHASE_SHIFT,         // Final - baseline phase at the point nearest the marker (degrees)
+    METRIC_AREA,                // Area between the log10|Z| curves over log10 f (decades^2)
+    METRIC_RS_CHANGE,           // Rs reduction of the circuit fits (fraction, circuit_fit.h)
+    METRIC_RCT_CHANGE,          // Rct reduction of the circuit fits (fraction)
+    METRIC_N_CHANGE,            // CPE exponent, final - baseline
+    METRIC_COUNT
+};
+
+#define METRICS_MASK_ALL        ((1u << METRIC_COUNT) - 1)
+#define METRICS_TEXT_FIELDS     8
+
+struct MetricsConfig {
+    uint16_t mask;              // Bit per SpectralMetric
+    float markerHz;             // METRIC_PHASE_SHIFT frequency
+    float splitLowHz;           // Band edges of METRIC_BAND_*
+    float splitHighHz;
+    float bandThreshold;        // |Z| reduction (fraction), like the risk cutoffs
+    float phaseThreshold;       // Degrees
+    float areaThreshold;        // Decades^2
+    float fitThreshold;         // Fit parameter change (fraction, n absolute)
+};
+
+struct MetricsResult {
+    uint16_t mask;              // Metrics computed - enabled and with data
+    uint16_t alarms;            // Of those, at or past their threshold
+    float value[METRIC_COUNT];
+};
+
+// The active configuration - change it only between sweeps
+extern MetricsConfig metricsConfig;
+
+// Parse METRICS[:fields] into config (starting from its current values)
+// Returns false with the 1-based bad field in errorField; config is then unchanged
+bool parseMetricsConfig(const char* cmd, MetricsConfig& config, uint8_t& errorField);
+
+// Data processor: clear the DUT's accumulators - with resetRiskAccumulator()
+void resetSpectralMetrics(uint8_t dutIdx);
+
+// Data processor: one final point and its baseline point (same frequency)
+void addSpectralMetricsPoint(uint8_t dutIdx, uint32_t freqHz, uint8_t freqIdx,
+                             float baselineMag, float baselinePhase, float finalMag, float finalPhase);
+
+// Compute the DUT's results - once it is complete, after its circuit fit
+void finishSpectralMetrics(uint8_t dutIdx);
+
+// Last results of the DUT (mask 0 before the first final sweep)
+const MetricsResult& getSpectralMetrics(uint8_t dutIdx);
+
+// Short name for reports ("band_lo", "phase", ...)
+const char* getSpectralMetricName(SpectralMetric metric);
+
+// Configuration and every DUT's last results to Serial
+void printSpectralMetrics();
+
+#endif // SPECTRAL_METRICS_H
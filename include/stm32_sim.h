@@ -0,0 +1,84 @@
+#ifndef STM32_SIM_H
+#define STM32_SIM_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+
+/*=========================VIRTUAL STM32=========================*/
+// Stands in for the STM32 analog front end: answers commands with ACKs and
+// streams DUT_START / FREQUENCY / DUT_END frames of synthetic RC DUTs, so
+// BLE, GUI and storage can be soak-tested without hardware and at sweep
+// rates the real front end cannot reach. Built with -D STM32_SIM=1 ([env:sim])
+//
+//   SIM_LOOPBACK  UART1 TX is looped back to RX inside the chip - the
+//                 board's own commands go to the simulator instead of the
+//                 pin, its frames take the real driver -> parser path
+//   SIM_TX        The board is the STM32 of a second board wired to
+//                 UART1: received commands go to the simulator, frames
+//                 go out of the TX pin (baud negotiation included)
+#ifndef STM32_SIM
+#define STM32_SIM 0
+#endif
+
+// Mode at boot (0 off, 1 loopback, 2 tx) - the "sim" command changes it
+#ifndef STM32_SIM_BOOT_MODE
+#define STM32_SIM_BOOT_MODE 0
+#endif
+
+// Frames in the CRC-protected v2 format, as current STM32 firmware sends
+// them (0 = a legacy STM32: legacy frames until a v2 command arrives)
+#ifndef STM32_SIM_V2
+#define STM32_SIM_V2 1
+#endif
+
+#define STM32_SIM_POINT_MS      5       // Default gap after each point, 0 = UART line rate
+#define STM32_SIM_QUEUE_DEPTH   8       // Commands waiting for the simulator task
+#define STM32_SIM_IDLE_MS       1000    // Simulator task wake-up while idle
+
+enum STM32SimMode : uint8_t {
+    SIM_OFF = 0,
+    SIM_LOOPBACK = 1,
+    SIM_TX = 2
+};
+
+// Create the command queue and enter STM32_SIM_BOOT_MODE - after initUART()
+void initSTM32Sim();
+
+// Switch mode - only between sweeps. Aborts a simulated sweep and resets
+// the link (baud rate, v2 detection) for the new peer
+void setSTM32SimMode(STM32SimMode mode);
+STM32SimMode getSTM32SimMode();
+
+// Gap after each point (0 = as fast as the UART sends), noise in percent
+// of |Z| (phase: the same number in tenths of a degree) and the number of
+// DUTs reported per sweep (0 = as many as START asks for)
+void setSTM32SimParams(uint32_t pointMs, float noisePct, uint8_t duts);
+
+// Fault injection: the next sweep stops sending frames after points points,
+// as a stuck front end would, until a STOP or START (sweep_watchdog.h)
+// Commands are still answered. 0 cancels
+void setSTM32SimHang(uint32_t points);
+
+// Fault injection: the next sweep leaves out every n-th point, as frames
+// lost on the line (meas_control.h repair sweeps). 0 cancels
+void setSTM32SimDrop(uint32_t every);
+
+// Empty sensor slots: DUTs of mask (bit 0 = DUT 1) send invalid points with
+// no current, as an unpopulated channel does (open_channel.h). 0 = none
+void setSTM32SimEmpty(uint32_t mask);
+
+// Print mode, parameters and frame counts (serial "sim")
+void printSTM32SimStatus();
+
+// SIM_LOOPBACK: a command the board would have sent to the STM32
+// seq is the v2 sequence number, v2 false for legacy packets
+void stm32SimCommand(uint8_t cmd, uint8_t seq, bool v2, uint32_t data1, uint32_t data2, uint32_t data3);
+
+// SIM_TX: bytes received on UART1 (the second board's commands)
+// UART reader task
+void stm32SimReceive(const uint8_t* data, size_t len);
+
+// Simulator task body: wait up to timeout for a command, emit due frames
+void processSTM32Sim(TickType_t timeout);
+
+#endif // STM32_SIM_H
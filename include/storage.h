@@ -0,0 +1,59 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <Arduino.h>
+
+/*=========================STORAGE SERVICE=========================*/
+// LittleFS is mounted once at boot (initStorage(), formatted if it cannot
+// be mounted) and stays mounted; modules open their files directly and
+// check isStorageMounted() instead of calling LittleFS.begin()/end()
+//
+// Settings and log writes go through a write queue drained by the storage
+// task, so the GUI task never waits for a flash erase. Operations run in the
+// order they were queued. A reader of a file with queued writes calls
+// waitStorageIdle() first. Calibration saves stay synchronous - their
+// callers report the result
+//
+// During a sweep each operation waits for a predicted gap between frames of
+// STORAGE_SWEEP_GAP_MS (sweep_eta.h), at most STORAGE_GAP_WAIT_MS, so flash
+// erases do not land while a frame is coming in
+#define STORAGE_QUEUE_BYTES     4096    // Pending operations, data included
+#define STORAGE_PATH_MAX        32      // Path length incl. the terminator
+#define STORAGE_ITEM_MAX        1024    // Largest data per operation
+#define STORAGE_QUEUE_WAIT_MS   20      // Max wait for queue space
+#define STORAGE_IDLE_WAIT_MS    500     // Default waitStorageIdle() timeout
+#define STORAGE_SWEEP_GAP_MS    30      // Frame gap an operation needs during a sweep
+#define STORAGE_GAP_WAIT_MS     200     // Longest wait for that gap
+
+enum StorageOp : uint8_t {
+    STORAGE_OP_WRITE = 0,   // Replace the file with data
+    STORAGE_OP_APPEND,      // Append data
+    STORAGE_OP_REMOVE,      // Remove the file if it exists
+    STORAGE_OP_RENAME       // Rename to the path in data
+};
+
+// Mount LittleFS and create the write queue - boot, before any file access
+bool initStorage();
+
+// LittleFS is mounted
+bool isStorageMounted();
+
+// Queue a write, append, remove or rename of path
+// Returns false if the queue stays full for STORAGE_QUEUE_WAIT_MS or the
+// arguments do not fit - nothing is queued then
+bool queueStorageWrite(const char* path, const void* data, size_t len);
+bool queueStorageAppend(const char* path, const void* data, size_t len);
+bool queueStorageRemove(const char* path);
+bool queueStorageRename(const char* path, const char* newPath);
+
+// Wait until every queued operation has run; false on timeout
+// Not from the storage task
+bool waitStorageIdle(uint32_t timeoutMs = STORAGE_IDLE_WAIT_MS);
+
+// Queued operations that failed since boot
+uint32_t getStorageErrors();
+
+// Storage task - runs the queued operations
+void taskStorage(void* parameter);
+
+#endif // STORAGE_H
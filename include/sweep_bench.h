@@ -0,0 +1,72 @@
+#ifndef SWEEP_BENCH_H
+#define SWEEP_BENCH_H
+
+#include <Arduino.h>
+
+/*=========================SWEEP THROUGHPUT BENCHMARK=========================*/
+// Whole sweeps on the target against the virtual STM32 in loopback
+// (stm32_sim.h), under fixed workloads - 1, 4 and 16 DUTs of the full
+// SWEEP_FREQ_COUNT frequencies, SWEEP_BENCH_REPEATS repeat, the simulator's
+// default point gap. Built with -D SWEEP_BENCH=1 ([env:bench_sweep]), run
+// with serial "bench sweep [sweeps]"
+//
+// Each workload is a warm-up baseline and then sweeps final sweeps back to
+// back; over the final sweeps it measures:
+//   rate     sweeps per hour, first START to the last sweep complete
+//   latency  p50 / p95 / p99 of DUT_END frame -> DUT delivered (sweep_stats.h
+//            dut_end_to_ble), per DUT
+//   heap     lowest free heap (local minimum, heap_caps monitor)
+//   cpu      share of the CPU the idle task did not get - the energy proxy
+// BLE streaming is whatever the connected clients asked for: a client with
+// STREAM:1 makes every workload a streaming one (ble=1). Each workload ends
+// with "@EVT bench_result <duts> <ble> <sweeps> <sweeps/h> <p50 us> <p95 us>
+// <p99 us> <heap min> <cpu %>", the run with "@EVT bench_end <workloads>
+// <reason>" and a table. bench_sweep.py runs it with and without streaming
+// and fails on a regression against bench_sweep_thresholds.json
+//
+// The store is laid out for the largest workload (not saved - the next
+// boot restores the configured layout); the baseline is replaced. GUI task
+// only
+#ifndef SWEEP_BENCH
+#define SWEEP_BENCH 0
+#endif
+
+#if SWEEP_BENCH && !STM32_SIM
+#error "SWEEP_BENCH sweeps against the virtual STM32 - build with STM32_SIM=1"
+#endif
+
+#define SWEEP_BENCH_SWEEPS      5       // Measured final sweeps per workload, default
+#define SWEEP_BENCH_MAX_SWEEPS  50
+#define SWEEP_BENCH_REPEATS     1       // Readings per point
+#define SWEEP_BENCH_NOISE_PCT   1.0f    // Simulator noise - the risk and fit paths see real spreads
+#define SWEEP_BENCH_SAMPLES     256     // Latency samples kept per workload, later ones are not
+
+#if SWEEP_BENCH
+// Start the workloads - false (and why on the console) unless the
+// simulator is in loopback and no sweep runs
+bool startSweepBench(uint16_t sweeps);
+
+// A stop ended the bench's sweep (meas_control.cpp) - reason is the @EVT
+// token. No-op if none runs
+void abortSweepBench(const char* reason);
+
+bool isSweepBenchRunning();
+
+// main.cpp, after the sweep-complete delivery: next sweep or workload
+void sweepBenchSweepComplete(bool final);
+
+// sweep_stats.cpp, as a DUT is delivered: its DUT_END -> delivered time.
+// Any task, inside the statistics' critical section
+void sweepBenchLatency(uint32_t us);
+
+// Progress of the run, or the results of the last one, to Serial (serial
+// "bench sweep" while one runs)
+void printSweepBench();
+#else
+inline void abortSweepBench(const char* reason) {}
+inline bool isSweepBenchRunning() { return false; }
+inline void sweepBenchSweepComplete(bool final) {}
+inline void sweepBenchLatency(uint32_t us) {}
+#endif
+
+#endif // SWEEP_BENCH_H
@@ -0,0 +1,68 @@
+#ifndef SWEEP_CONFIG_H
+#define SWEEP_CONFIG_H
+
+#include <Arduino.h>
+#include "sweep_table.h"
+
+/*=========================SWEEP CONFIGURATION=========================*/
+// Parameters of a BASELINE_START, parsed without heap use from either
+//   text:   BASELINE_START[:n,SS,EE,CCCCCC,CCCCCC,LLL,MMM,HHH[,PPPPPPPPPP]]
+//           (any leading subset of the fields; missing ones keep the defaults)
+//   binary: SweepConfigPacket (BLE_BIN_MAGIC, BLE_BIN_CMD_BASELINE)
+// and validated against the measurement store and sweep table
+enum SweepConfigError : uint8_t {
+    SWEEP_CONFIG_OK = 0,
+    SWEEP_CONFIG_SYNTAX,        // Not a BASELINE_START, or a field is not a number
+    SWEEP_CONFIG_VERSION,       // Binary packet of an unknown version / size
+    SWEEP_CONFIG_DUTS,          // DUT count outside 1-getDUTCount()
+    SWEEP_CONFIG_RANGE,         // Index range outside the sweep table or reversed
+    SWEEP_CONFIG_BAND,          // Calculation band empty or reversed
+    SWEEP_CONFIG_CUTOFFS,       // Risk cutoffs negative or not ascending
+    SWEEP_CONFIG_PLAN           // Sweep plan selects no frequency
+};
+
+struct SweepConfig {
+    uint8_t numDuts;
+    uint8_t startIdx;           // Contiguous sweep (when sweepMask == 0)
+    uint8_t endIdx;
+    float calcStartFreq;        // Risk calculation band (Hz)
+    float calcEndFreq;
+    float lowCutoff;            // Risk cutoffs
+    float mediumCutoff;
+    float highCutoff;
+    SweepMask sweepMask;        // Planned sparse sweep, 0 = startIdx..endIdx
+    SweepConfigError error;
+    uint8_t errorField;         // 1-based text field / binary offset of the error, 0 = none
+};
+
+// Binary BASELINE_START - little-endian, no padding
+#define SWEEP_CONFIG_PACKET_VERSION 1
+#define SWEEP_CONFIG_FLAG_PLAN      0x01    // Plan the sweep from the band plus pinnedMask
+
+struct __attribute__((packed)) SweepConfigPacket {
+    uint8_t magic;              // BLE_BIN_MAGIC
+    uint8_t type;               // BLE_BIN_CMD_BASELINE
+    uint8_t version;            // SWEEP_CONFIG_PACKET_VERSION
+    uint8_t flags;              // SWEEP_CONFIG_FLAG_*
+    uint8_t numDuts;
+    uint8_t startIdx;
+    uint8_t endIdx;
+    uint8_t reserved;
+    uint32_t calcStartFreq;     // Hz
+    uint32_t calcEndFreq;
+    float lowCutoff;
+    float mediumCutoff;
+    float highCutoff;
+    uint64_t pinnedMask;        // Sweep index mask added to the band (SWEEP_CONFIG_FLAG_PLAN)
+};
+
+// Parse a text BASELINE_START (the whole command)
+SweepConfig parseSweepConfigText(const char* cmd, const SweepConfig& defaults);
+
+// Parse a binary BASELINE_START of len bytes
+SweepConfig parseSweepConfigBinary(const uint8_t* data, size_t len, const SweepConfig& defaults);
+
+// Short description of an error for ERROR replies
+const char* sweepConfigErrorText(SweepConfigError error);
+
+#endif // SWEEP_CONFIG_H
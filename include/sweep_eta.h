@@ -0,0 +1,73 @@
+#ifndef SWEEP_ETA_H
+#define SWEEP_ETA_H
+
+#include <Arduino.h>
+#include "sweep_table.h"
+
+/*=========================SWEEP TIME MODEL=========================*/
+// Learns the time the STM32 takes for one point at each sweep table
+// frequency from the frames the UART reader sees: the interval from the
+// previous frame of the DUT (or its DUT_START) goes into an exponential
+// average per table index. The low frequencies dominate a sweep, so a flat
+// per-point time is far off. Indices never measured use a prior of
+// SWEEP_ETA_PRIOR_MS plus SWEEP_ETA_PRIOR_PERIODS signal periods
+//
+// The model is kept in SWEEP_ETA_FILE (LittleFS, written through the
+// storage queue after a sweep changed it), so the first sweep after boot
+// already has a good estimate
+//
+// Users: the remaining time of the sweep (progress screen, BLE
+// "STATUS:ETA:<s>") and background work that touches flash - storage task
+// operations and history download refills - which waits for a predicted
+// gap between frames long enough to run in (waitForSweepGap())
+#define SWEEP_ETA_FILE          "/sweep_time.dat"
+#define SWEEP_ETA_MAGIC         0x41544553  // "SETA"
+#define SWEEP_ETA_VERSION       1
+#define SWEEP_ETA_WEIGHT_SHIFT  2           // A new interval weighs 1/4
+#define SWEEP_ETA_SAMPLE_MAX_MS 10000       // Longer intervals are stalls, not points
+#define SWEEP_ETA_SAVE_DELTA    8           // Percent change of a point time worth a save
+#define SWEEP_ETA_PRIOR_MS      40          // Settling, ADC and frame time of one point
+#define SWEEP_ETA_PRIOR_PERIODS 4           // Signal periods measured per point
+#define SWEEP_GAP_POLL_MS       5           // waitForSweepGap() re-check period
+
+struct __attribute__((packed)) SweepTimeRecord {
+    uint32_t magic;         // SWEEP_ETA_MAGIC
+    uint16_t version;       // SWEEP_ETA_VERSION
+    uint16_t count;         // SWEEP_FREQ_COUNT of the writer
+    uint32_t pointUs[SWEEP_FREQ_COUNT];     // 0 = not measured yet
+    uint16_t crc;           // CRC-16/CCITT (crc.h) of everything before it
+};
+
+// Boot, after initStorage(): load the saved model
+void loadSweepTimeModel();
+
+// Queue a write of the model if it moved by SWEEP_ETA_SAVE_DELTA since the
+// last one (GUI task, after a sweep)
+void saveSweepTimeModel();
+
+// UART reader task: sweep progress - freqIdx is the resolved table index
+void sweepTimeDutStart(uint8_t dut);
+void sweepTimePoint(uint8_t dut, uint8_t freqIdx);
+void sweepTimeDutEnd(uint8_t dut);
+
+// Expected time of one point at table index freqIdx (model or prior)
+uint32_t getPointTimeUs(uint8_t freqIdx);
+
+// Milliseconds the current sweep still needs for DUTs 0..dutCount-1: the
+// plan slots each DUT has not stored yet, times the sweep repeats
+// 0 while no sweep runs
+uint32_t estimateSweepRemainingMs(uint8_t dutCount);
+
+// Milliseconds until the next frame is expected - UINT32_MAX while no sweep
+// runs, 0 when one is due (also between DUTs)
+uint32_t getSweepGapMs();
+
+// Wait until the predicted gap is at least needMs, for at most maxWaitMs
+// Returns false on timeout - the caller goes ahead anyway. Not from the
+// UART reader task
+bool waitForSweepGap(uint32_t needMs, uint32_t maxWaitMs);
+
+// Point time per frequency (model and prior) to Serial
+void printSweepTimeModel();
+
+#endif // SWEEP_ETA_H
@@ -0,0 +1,92 @@
+#ifndef SWEEP_PRESETS_H
+#define SWEEP_PRESETS_H
+
+#include <Arduino.h>
+#include "sweep_config.h"
+#include "spectral_metrics.h"
+#include "meas_control.h"
+#include "repeat_plan.h"
+
+/*=========================SWEEP PRESETS=========================*/
+// Named baseline setups an operator would otherwise re-enter every run:
+// the BASELINE_START fields plus the repeat count, the adaptive repeat plan
+// and the spectral metric configuration in effect when the preset is saved.
+// An adaptive preset keeps learning: the plan its baseline sweep refines
+// goes back into the preset (updateSweepPresetRepeatPlan())
+//
+// A preset is parsed and validated once, when it is saved, and kept as the
+// finished sweep plan (the customSweepMask / planned mask already resolved),
+// risk band and cutoffs - starting one copies them into place without any
+// parsing. Only the DUT count is checked again at start, since CHANNELS may
+// have shrunk the store since
+//
+// All presets live in SWEEP_PRESET_FILE, one fixed-size SweepPresetFile
+// written through the storage queue. GUI task only
+#define SWEEP_PRESET_FILE       "/presets.dat"
+#define SWEEP_PRESET_MAGIC      0x54455250  // "PRET"
+#define SWEEP_PRESET_VERSION    2           // 2: adaptive repeat plan
+#define SWEEP_PRESET_MAX        8
+#define SWEEP_PRESET_NAME_MAX   16          // Name length incl. the terminator
+
+struct SweepPreset {
+    char name[SWEEP_PRESET_NAME_MAX];   // Letters, digits, '_' and '-'
+    SweepPlan plan;
+    float calcStartFreq;                // Risk calculation band (Hz)
+    float calcEndFreq;
+    float lowCutoff;                    // Risk cutoffs
+    float mediumCutoff;
+    float highCutoff;
+    uint8_t repeats;                    // setSweepRepeats()
+    bool adaptive;                      // setAdaptiveRepeats()
+    RepeatPlan repeatPlan;
+    MetricsConfig metrics;
+};
+
+struct SweepPresetFile {
+    uint32_t magic;                     // SWEEP_PRESET_MAGIC
+    uint16_t version;                   // SWEEP_PRESET_VERSION
+    uint8_t count;
+    SweepPreset presets[SWEEP_PRESET_MAX];
+    uint16_t crc;                       // CRC-16/CCITT (crc.h) of everything before it
+};
+
+enum SweepPresetError : uint8_t {
+    SWEEP_PRESET_OK = 0,
+    SWEEP_PRESET_NAME,          // Empty, too long or an invalid character
+    SWEEP_PRESET_CONFIG,        // BASELINE_START fields rejected (see the config's error)
+    SWEEP_PRESET_FULL,          // SWEEP_PRESET_MAX presets stored
+    SWEEP_PRESET_NOT_FOUND,
+    SWEEP_PRESET_STORAGE        // Kept in RAM, but not queued for flash
+};
+
+// Boot, after initStorage(): read the stored presets
+void loadSweepPresets();
+
+// Save (or replace) preset name from a validated config, with the current
+// repeat count and metrics configuration. customMask is the operator's
+// sparse sweep the BASELINE_START would have used
+SweepPresetError saveSweepPreset(const char* name, const SweepConfig& config, SweepMask customMask);
+
+// Remove preset name
+SweepPresetError deleteSweepPreset(const char* name);
+
+// Stored preset of that name, nullptr if none
+const SweepPreset* findSweepPreset(const char* name);
+
+// Number of stored presets and the index-th of them
+uint8_t getSweepPresetCount();
+const SweepPreset& getSweepPreset(uint8_t index);
+
+// Apply the preset's repeats, repeat plan, metrics, band and cutoffs and start its
+// baseline sweep (requestBaselineSweep(), callback as there)
+MeasRequestError startSweepPreset(MeasSource source, const SweepPreset& preset,
+                                  UARTCommandCallback callback = nullptr);
+
+// After learnRepeatPlan() changed the plan: store it in the adaptive preset
+// whose baseline sweep it was learned from. Returns false if there is none
+bool updateSweepPresetRepeatPlan();
+
+// Short description of an error for ERROR replies
+const char* sweepPresetErrorText(SweepPresetError error);
+
+#endif // SWEEP_PRESETS_H
@@ -0,0 +1,51 @@
+#ifndef SWEEP_REFINE_H
+#define SWEEP_REFINE_H
+
+#include <Arduino.h>
+#include "sweep_table.h"
+
+/*=========================SWEEP REFINEMENT=========================*/
+// A baseline in two passes instead of every planned index: the coarse pass
+// sweeps every SWEEP_REFINE_STRIDE-th index of the plan (and its last), then
+// the points between them go where the spectrum bends. At each interior
+// coarse point log10 |Z| and phase are compared with the straight line (in
+// log f) through its neighbours - the error in units of the tolerances
+// scores the planned indices between those neighbours, worst DUT. Indices
+// scoring 1 or more are added best first until both passes take
+// SWEEP_REFINE_BUDGET_PCT of the full plan's time (sweep_eta.h)
+//
+// Both passes are one session (meas_control.h): the refinement is a masked
+// START of the added indices like a repair sweep, storage is by plan slot,
+// and the indices left out read as invalid gaps that no repair asks for. A
+// final sweep measures only where its baseline has valid points, so the
+// pairs still line up by index
+//
+// Set -D SWEEP_REFINE_DEFAULT=1 to refine from boot
+#ifndef SWEEP_REFINE_DEFAULT
+#define SWEEP_REFINE_DEFAULT 0
+#endif
+#define SWEEP_REFINE_STRIDE         3       // Coarse pass: every third planned index
+#define SWEEP_REFINE_MIN_POINTS     8       // Smaller plans are swept in full
+#define SWEEP_REFINE_MAG_TOL        0.01f   // log10 |Z| off the neighbours' line (2.3 %)
+#define SWEEP_REFINE_PHASE_TOL      1.0f    // Phase off that line, degrees
+#define SWEEP_REFINE_BUDGET_PCT     50      // Time of both passes, % of the full plan
+
+// Between sweeps (GUI task)
+void setSweepRefinement(bool enable);
+bool isSweepRefinement();
+
+// Coarse pass of plan - plan itself if it is too small to refine
+SweepMask getCoarseSweepMask(SweepMask plan);
+
+// GUI task, after the coarse pass of a baseline: the planned indices to add
+// for DUTs 0..numDuts-1 (open channels left out). 0 if nothing bends enough
+SweepMask planSweepRefinement(uint8_t numDuts, SweepMask plan, SweepMask coarse);
+
+// Indices where the baseline rows of DUTs 0..numDuts-1 hold a valid point -
+// what a final sweep measures
+SweepMask getBaselinePointMask(uint8_t numDuts);
+
+// Mode, tolerances and the last refinement to Serial
+void printSweepRefinement();
+
+#endif // SWEEP_REFINE_H
@@ -0,0 +1,68 @@
+#ifndef SWEEP_STATS_H
+#define SWEEP_STATS_H
+
+#include <Arduino.h>
+#include "esp_timer.h"
+
+// End-to-end sweep latency statistics - each stage keeps count/min/avg/max
+// and a log2 histogram of its durations (microseconds, esp_timer_get_time)
+// Reported with the "stats" serial command and the BLE STATS command
+
+#define SWEEP_STATS_HIST_BINS   24      // Bin i holds [2^i, 2^(i+1)) us - last bin catches the rest
+
+// Measured stages
+enum SweepStage : uint8_t {
+    STAGE_START_ACK = 0,        // START sent -> START ACK received
+    STAGE_START_TO_FIRST_DUT,   // START sent -> first DUT_START frame
+    STAGE_FREQ_INTERVAL,        // DUT_START/previous FREQUENCY -> next FREQUENCY frame
+    STAGE_CALIBRATE,            // One calibrate() call
+    STAGE_DUT_END_TO_BLE,       // DUT_END frame -> DUT data delivered over BLE
+    STAGE_BLE_DELIVERY,         // One sendBLEImpedanceData() call
+    STAGE_SWEEP_TOTAL,          // START sent -> "Measurement/Baseline Complete" sent
+    STAGE_CIRCUIT_FIT,          // One fitDUTCircuit() call (circuit_fit.h)
+    STAGE_COUNT
+};
+
+// Timeline events that close the stages above
+enum SweepMark : uint8_t {
+    MARK_START_SENT = 0,
+    MARK_START_ACKED,
+    MARK_START_FAILED,          // START never acknowledged - sweep discarded
+    MARK_DUT_START,
+    MARK_FREQUENCY,
+    MARK_DUT_END,               // dutNum required
+    MARK_DUT_DELIVERED,         // dutNum required
+    MARK_SWEEP_COMPLETE,
+    MARK_SWEEP_STOPPED          // Stopped or abandoned - the next START starts a new timeline
+};
+
+struct StageStats {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint16_t hist[SWEEP_STATS_HIST_BINS];
+};
+
+/*=========================RECORDING=========================*/
+// Record a timeline event - stages ending at this event are updated
+// dutNum (1-based) is needed by the per-DUT marks. Safe to call from any task
+void sweepStatsMark(SweepMark mark, uint8_t dutNum = 0);
+
+// Record a directly measured duration for a stage
+void sweepStatsRecord(SweepStage stage, uint32_t duration_us);
+
+// Clear all stage statistics
+void sweepStatsReset();
+
+/*=========================REPORTING=========================*/
+// Copy one stage's statistics (consistent snapshot)
+void getSweepStageStats(SweepStage stage, StageStats& out);
+
+// Short stage name for reports ("start_ack", "freq_interval", ...)
+const char* getSweepStageName(SweepStage stage);
+
+// Print all stages with min/avg/max and non-empty histogram bins to Serial
+void printSweepStats();
+
+#endif // SWEEP_STATS_H
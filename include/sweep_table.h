@@ -0,0 +1,158 @@
+#ifndef SWEEP_TABLE_H
+#define SWEEP_TABLE_H
+
+#include "hal.h"
+#include "defines.h"
+
+/*=========================SWEEP FREQUENCY TABLE=========================*/
+// Fixed STM32 sweep table - the index is the STM32 frequency index used by
+// START (startIDX..endIDX). Same order as the calibration CSVs (high -> low)
+#define SWEEP_FREQ_COUNT    MAX_FREQUENCIES
+#define SWEEP_FREQ_LAST     (SWEEP_FREQ_COUNT - 1)     // Lowest frequency - end of the full range
+#define SWEEP_FREQ_INVALID  0xFF
+
+inline constexpr uint32_t sweepFrequencies[SWEEP_FREQ_COUNT] = {
+    100000, 80000, 62500, 50000, 25000, 15625, 12500, 10000,
+    6250, 5000, 4000, 3125, 2500, 2000, 1250, 1000,
+    800, 625, 500, 400, 250, 200, 160, 125,
+    100, 80, 50, 40, 32, 25, 20, 16,
+    10, 8, 5, 4, 2, 1
+};
+
+/*=========================SWEEP TABLE METADATA=========================*/
+// What the modules derive from a sweep frequency, computed by the compiler
+// once for the whole table - the plot axis, the calibration interpolation,
+// the fits and the screens read it instead of calling log10f()/logf() (soft
+// float on the C6) per point or keeping their own caches
+#define SWEEP_LABEL_SIZE    6       // "62.5k" + NUL
+
+struct SweepFreqInfo {
+    uint32_t hz;
+    float log10Hz;                  // Plot axis, area metric
+    float lnHz;                     // Calibration interpolation
+    float lnOmega;                  // ln(2*pi*f) - circuit fit
+    char label[SWEEP_LABEL_SIZE];   // "100k", "62.5k", "125" (Hz)
+};
+
+namespace sweep_detail {
+constexpr double LN2 = 0.69314718055994530942;
+constexpr double LN10 = 2.30258509299404568402;
+constexpr double TWO_PI = 6.28318530717958647692;
+
+// Natural log for the compiler: x = m * 2^e with m in [0.5, 1], then
+// ln(m) = 2 * atanh((m - 1) / (m + 1)) - the series converges in a few dozen terms
+constexpr double ln(double x) {
+    int e = 0;
+    while (x > 1.0) { x *= 0.5; e++; }
+    while (x < 0.5) { x *= 2.0; e--; }
+    double s = (x - 1.0) / (x + 1.0);
+    double s2 = s * s;
+    double term = s;
+    double sum = 0.0;
+    for (int k = 1; k < 80; k += 2) {
+        sum += term / k;
+        term *= s2;
+    }
+    return 2.0 * sum + e * LN2;
+}
+
+// Up to 3 significant digits, "k" from 1 kHz
+constexpr void formatLabel(uint32_t hz, char* out) {
+    uint32_t value = hz;
+    int decimals = 0;
+    bool kilo = hz >= 1000;
+    if (kilo) {
+        uint32_t unit = hz >= 100000 ? 1000 : hz >= 10000 ? 100 : 10;
+        value = (hz + unit / 2) / unit;
+        decimals = unit == 1000 ? 0 : unit == 100 ? 1 : 2;
+        while (decimals > 0 && value % 10 == 0) { value /= 10; decimals--; }
+    }
+    char digits[10] = {};
+    int n = 0;
+    do { digits[n++] = (char)('0' + value % 10); value /= 10; } while (value > 0 || n <= decimals);
+    int pos = 0;
+    while (n > 0) {
+        if (n == decimals) out[pos++] = '.';
+        out[pos++] = digits[--n];
+    }
+    if (kilo) out[pos++] = 'k';
+    out[pos] = '\0';
+}
+
+struct SweepTable {
+    SweepFreqInfo entry[SWEEP_FREQ_COUNT];
+};
+
+constexpr SweepTable buildSweepTable() {
+    SweepTable table{};
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        SweepFreqInfo& info = table.entry[i];
+        double lnHz = ln((double)sweepFrequencies[i]);
+        info.hz = sweepFrequencies[i];
+        info.log10Hz = (float)(lnHz / LN10);
+        info.lnHz = (float)lnHz;
+        info.lnOmega = (float)(lnHz + ln(TWO_PI));
+        formatLabel(sweepFrequencies[i], info.label);
+    }
+    return table;
+}
+
+constexpr bool isDescending() {
+    for (int i = 1; i < SWEEP_FREQ_COUNT; i++) {
+        if (sweepFrequencies[i] >= sweepFrequencies[i - 1]) return false;
+    }
+    return true;
+}
+} // namespace sweep_detail
+
+inline constexpr sweep_detail::SweepTable sweepTable = sweep_detail::buildSweepTable();
+
+// The searches below and the STM32 protocol rely on the order
+static_assert(sweep_detail::isDescending(), "sweep table must be strictly descending");
+static_assert(SWEEP_FREQ_COUNT <= 64, "sweep masks are 64 bit");
+static_assert(sweepTable.entry[15].hz == 1000 && sweepTable.entry[15].log10Hz == 3.0f &&
+              sweepTable.entry[SWEEP_FREQ_LAST].log10Hz == 0.0f, "constexpr log10 off the decades");
+
+// Metadata of sweep index idx (idx < SWEEP_FREQ_COUNT)
+constexpr const SweepFreqInfo& getSweepFreqInfo(uint8_t idx) {
+    return sweepTable.entry[idx];
+}
+
+// Display label of idx, "?" off the table
+constexpr const char* getSweepFreqLabel(uint8_t idx) {
+    return idx < SWEEP_FREQ_COUNT ? sweepTable.entry[idx].label : "?";
+}
+
+// Index of freq_hz in the sweep table
+// Checks hint first (e.g. previous index + 1), then falls back to a binary search
+// Returns SWEEP_FREQ_INVALID if freq_hz is not a sweep frequency
+uint8_t getSweepFrequencyIndex(uint32_t freq_hz, uint8_t hint = SWEEP_FREQ_INVALID);
+
+// Segment i of an off-grid frequency: sweepFrequencies[i] > freq_hz > sweepFrequencies[i + 1]
+// Returns SWEEP_FREQ_INVALID if freq_hz is a sweep frequency or outside the table
+uint8_t getSweepSegment(uint32_t freq_hz);
+
+/*=========================SWEEP PLANNING=========================*/
+// Sparse sweep: bit i selects sweepFrequencies[i] (CMD_START_MASKED)
+typedef uint64_t SweepMask;
+#define SWEEP_MASK_ALL      ((1ULL << SWEEP_FREQ_COUNT) - 1)
+
+// Sweep frequencies inside the risk calculation band (either order), plus pinned
+// Returns 0 if nothing is selected - sweep the plain startIDX..endIDX range then
+SweepMask planSweepMask(uint32_t calcStartHz, uint32_t calcEndHz, SweepMask pinned);
+
+// First and last selected index - the minimal plain START range for mask
+// Returns false for an empty mask
+bool getSweepMaskRange(SweepMask mask, uint8_t& firstIdx, uint8_t& lastIdx);
+
+// Mask of the plain START range between two indices (either order, clamped)
+SweepMask getSweepRangeMask(uint8_t firstIdx, uint8_t lastIdx);
+
+// The mask selects one run of adjacent indices (a plain START covers it exactly)
+bool isSweepMaskContiguous(SweepMask mask);
+
+// Parse a sweep selection: "0x..." hex mask or a comma-separated index list
+// ("0,3,6,9"). Returns false for bad syntax, an index >= SWEEP_FREQ_COUNT or an empty set
+bool parseSweepMask(const char* text, SweepMask& mask);
+
+#endif // SWEEP_TABLE_H
@@ -0,0 +1,36 @@
+#ifndef SWEEP_WATCHDOG_H
+#define SWEEP_WATCHDOG_H
+
+#include <Arduino.h>
+#include "sweep_table.h"
+
+/*=========================SWEEP WATCHDOG=========================*/
+// Supervises a running sweep from the frames the UART reader sees. Armed at
+// the START ACK with the plan, it expects a frame at least every stall
+// timeout and every DUT within its budget: per frequency SWEEP_WD_POINT_MS
+// plus SWEEP_WD_PERIODS signal periods, per repeat. On expiry the GUI task
+// hands the first DUT without DUT_END to meas_control, which resets the link
+// and resumes the sweep there (or stops it - meas_control.h)
+#define SWEEP_WD_POINT_MS       1000    // Settling, ADC and frame time of one point
+#define SWEEP_WD_PERIODS        10      // Signal periods measured per point, at most
+#define SWEEP_WD_STALL_MS       5000    // Longest gap between frames, plus the slowest point
+#define SWEEP_WD_RESYNC_MAX     2       // Resumes per sweep before it is stopped
+
+// GUI task, at the START ACK: supervise numDuts DUTs of the plan from DUT
+// firstDut (1-based). firstDut 1 forgets the DUTs a resumed sweep finished
+void sweepWatchdogArm(uint8_t numDuts, uint8_t startIdx, uint8_t endIdx, SweepMask mask, uint8_t firstDut);
+void sweepWatchdogDisarm();
+
+// UART reader task: sweep progress
+void sweepWatchdogDutStart(uint8_t dut);
+void sweepWatchdogPoint();
+void sweepWatchdogDutEnd(uint8_t dut);
+
+// GUI task: report an expired sweep to meas_control (once per arm)
+void processSweepWatchdog();
+
+// Milliseconds until processSweepWatchdog() must look again, UINT32_MAX
+// while disarmed
+uint32_t getSweepWatchdogWaitMs();
+
+#endif // SWEEP_WATCHDOG_H
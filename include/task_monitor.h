@@ -0,0 +1,87 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/*=========================TASK TABLE=========================*/
+// setup() creates the application tasks from one table (main.cpp) so their
+// priorities and stacks are reviewed in one place. The C6 has one core - no
+// affinity, the tasks are ordered by priority only
+struct TaskSpec {
+    TaskFunction_t function;
+    const char* name;
+    uint32_t stackBytes;
+    UBaseType_t priority;
+};
+
+#define TASK_MONITOR_MAX        12
+#define TASK_BOOT_MAX           2
+#define TASK_STACK_MIN_FREE     512     // Bytes - less left is reported
+
+// Tasks run on static stacks: the table's stacks lie back to back in one
+// arena (main.cpp, taskStackBytes() of the table), so all of them are in
+// .bss and the heap is left to the renderer and BLE. The boot tasks borrow
+// the front of the arena - they are gone before startTasks() lays the table
+// out over it. ESP-IDF counts stacks in bytes
+constexpr uint32_t taskStackBytes(const TaskSpec* specs, size_t count) {
+    return count == 0 ? 0 : specs[0].stackBytes + taskStackBytes(specs + 1, count - 1);
+}
+
+// Task watchdog: every table task is subscribed and calls taskWatchdogFeed()
+// once per loop pass, never blocking longer than TASK_WDT_FEED_MS. A task
+// stuck for TASK_WDT_TIMEOUT_MS panics and reboots the board; the next boot
+// reports it. -D TASK_WATCHDOG=0 to sit on a breakpoint
+#ifndef TASK_WATCHDOG
+#define TASK_WATCHDOG 1
+#endif
+
+#define TASK_WDT_TIMEOUT_MS     10000
+#define TASK_WDT_FEED_MS        (TASK_WDT_TIMEOUT_MS / 2)   // Longest wait in a task loop
+
+// Configure the task watchdog and report a watchdog reset - setup(), before startTasks()
+void initTaskWatchdog();
+
+// Start a boot task on stack (within the arena) - it ends with vTaskDelete(nullptr)
+void startBootTask(TaskFunction_t function, const char* name, StackType_t* stack, uint32_t stackBytes,
+                   UBaseType_t priority);
+
+// Wait for the boot tasks to be gone, then create every task of the table
+// on its stack in arena; false if one could not be created
+bool startTasks(const TaskSpec* specs, size_t count, StackType_t* arena, size_t arenaBytes);
+
+// Calling task is alive
+#if TASK_WATCHDOG
+void taskWatchdogFeed();
+#else
+inline void taskWatchdogFeed() {}
+#endif
+
+// True for a task created from the table (heap_stats.h sweep check)
+bool isTableTask(TaskHandle_t task);
+
+// Stack high-water mark and priority per table task, plus CPU time per task
+// when FreeRTOS keeps run-time stats (serial "tasks")
+void printTaskStats();
+
+// Report tasks whose free stack dropped under TASK_STACK_MIN_FREE, once each
+void checkTaskStacks();
+
+struct TaskCpuLoad {
+    const char* name;       // TaskSpec name
+    uint8_t percent;        // Of the CPU time since the previous sample
+};
+
+// CPU share of each table task since the previous call (the first call:
+// since boot) into out - the number written. 0 when FreeRTOS keeps no
+// run-time stats. One caller (the GUI task)
+size_t sampleTaskCpu(TaskCpuLoad* out, size_t max);
+
+// Run time of the idle task and of the run-time clock, in the same unit -
+// between two calls the CPU was busy 1 - idle / total of the time (the
+// counters wrap, the differences stay right). false, and zeros, when
+// FreeRTOS keeps no run-time stats. Any task
+bool getIdleRunTime(uint32_t& idle, uint32_t& total);
+
+#endif // TASK_MONITOR_H
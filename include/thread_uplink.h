@@ -0,0 +1,90 @@
+#ifndef THREAD_UPLINK_H
+#define THREAD_UPLINK_H
+
+#include <Arduino.h>
+
+/*=========================THREAD UPLINK=========================*/
+// Optional low-power telemetry over the C6's 802.15.4 radio (-D THREAD_UPLINK=1,
+// [env:thread]) for wards and labs with many units: the board joins a Thread
+// network as a sleepy end device and sends one UDP datagram per DUT result
+// to a collector behind the border router (thread_collector.py). BLE stays
+// free for the operator's local session; the two radios share the antenna
+// through the framework's software coexistence
+//
+// Provisioned with THREAD:<channel>,<PAN ID>,<extended PAN ID>,<network key>
+// (hex, as "ot-ctl dataset" shows them) or serial "thread ..."; OpenThread
+// keeps the dataset in NVS and learns the rest of it from the leader when it
+// attaches. THREAD_DEST:<IPv6>[,<port>] sets the collector
+//
+// A summary is queued by the GUI task after a final (or reporting monitor)
+// sweep's risk and metrics (main.cpp deliverDUTResults); the uplink task
+// sends them while the device is attached and keeps the newest
+// THREAD_SUMMARY_QUEUE_DEPTH while it is not. Summaries are not
+// acknowledged - the sequence number shows the gaps
+//
+// OpenThread runs its main loop in a framework task of its own (like the BT
+// host); the other tasks call into it under the OpenThread lock
+#ifndef THREAD_UPLINK
+#define THREAD_UPLINK 0
+#endif
+
+#define THREAD_CONFIG_FILE          "/thread.txt"   // enabled, collector address, port - one per line
+#define THREAD_DEFAULT_DEST         "ff03::1"       // Realm-local all nodes - set a collector to leave the mesh
+#define THREAD_DEFAULT_PORT         61631
+#define THREAD_ADDR_MAX             46              // IPv6 text with the terminator
+#define THREAD_POLL_PERIOD_MS       30000           // Sleepy child's data poll - nothing to receive but the parent's
+#define THREAD_SUMMARY_QUEUE_DEPTH  16
+#define THREAD_RETRY_MS             1000            // Role check while detached
+#define THREAD_LOCK_WAIT_MS         100
+#define THREAD_MAIN_STACK           6144
+#define THREAD_MAIN_PRIORITY        3               // Below the UART reader
+
+#define THREAD_SUMMARY_VERSION      1
+#define THREAD_SUMMARY_MONITOR      0x01            // ThreadSummaryHeader.flags: monitor sweep
+
+// One UDP datagram: the header, then one float per metricMask bit, low bit
+// first (spectral_metrics.h) - at most 46 bytes, one 802.15.4 frame
+struct __attribute__((packed)) ThreadSummaryHeader {
+    uint8_t magic;          // BLE_BIN_MAGIC
+    uint8_t type;           // BLE_BIN_TYPE_SUMMARY
+    uint8_t version;        // THREAD_SUMMARY_VERSION
+    uint8_t dut;            // DUT number (1-based)
+    uint16_t sequence;      // +1 per summary since boot
+    uint8_t risk;           // RiskLevel
+    uint8_t flags;          // THREAD_SUMMARY_*
+    int16_t percent;        // Risk reduction in 0.1 %
+    uint16_t metricMask;    // MetricsResult.mask
+    uint16_t alarms;        // MetricsResult.alarms
+};
+
+#if THREAD_UPLINK
+// Load the stored switch and start OpenThread if it is on - setup(), after storage
+void initThreadUplink();
+
+// Join / leave the network, remembered across reboots
+bool setThreadEnabled(bool enable);
+bool isThreadEnabled();
+
+// "<channel>,<PAN ID>,<extended PAN ID>,<network key>" - replaces the
+// dataset and rejoins. False if a field does not parse
+bool setThreadNetwork(const char* args);
+
+// Collector of the summaries
+bool setThreadDestination(const char* address, uint16_t port);
+
+// "off", "detached", "child <RLOC16>" ... - for STATUS and the serial console
+void getThreadStatus(char* out, size_t size);
+
+// GUI task: queue the summary of dut (0-based) - risk and metrics are final
+void queueThreadSummary(uint8_t dutIndex);
+
+// Role, network, collector and the summary counters (serial "thread")
+void printThreadStatus();
+
+// Uplink task - sends the queued summaries
+void taskThreadUplink(void* parameter);
+#else
+inline void queueThreadSummary(uint8_t dutIndex) {}
+#endif
+
+#endif // THREAD_UPLINK_H
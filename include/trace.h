@@ -0,0 +1,99 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include "esp_timer.h"
+
+// Deferred binary tracing - fixed-size records in a RAM ring, dumped on request
+// ("trace dump" serial command) and decoded on the host with trace_decode.py
+// Set -D TRACE_ENABLED=0 to compile all trace points out
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+// SystemView over JTAG apptrace (-D TRACE_SYSVIEW=1, [env:sysview]): the
+// framework's SystemView hooks record task switches, ISRs and queue
+// operations, and every trace point is also sent as a "BioPal" module event
+// with its three args - the pipeline stages on the same timeline
+#ifndef TRACE_SYSVIEW
+#define TRACE_SYSVIEW 0
+#endif
+
+#define TRACE_RING_SIZE     512     // Records (power of two) - 16 bytes each
+#define TRACE_FORMAT_VER    1
+
+// Event IDs - keep in sync with EVENT_NAMES in trace_decode.py
+enum TraceEvent : uint16_t {
+    TRACE_NONE = 0,
+
+    // UART (arg0, arg1)
+    TRACE_UART_BLOCK = 0x0100,      // bytes read, frames parsed
+    TRACE_UART_FRAME,               // packet type, freq_hz (FREQUENCY) / dut
+    TRACE_UART_ACK,                 // cmd, seq (0xFFFF for legacy)
+    TRACE_UART_CMD_TX,              // cmd, seq
+    TRACE_UART_OVERFLOW,            // event type, bytes dropped
+    TRACE_BATCH_FLUSH,              // dut, point count
+
+    // Calibration / processing
+    TRACE_CAL_BEGIN = 0x0200,       // -, freq_hz
+    TRACE_CAL_END,                  // success, freq_hz
+    TRACE_BATCH_PROCESSED,          // dut, point count
+
+    // BLE
+    TRACE_BLE_TX_BEGIN = 0x0300,    // -, bytes
+    TRACE_BLE_TX_END,               // chunks, bytes
+
+    // GUI
+    TRACE_GUI_RENDER_BEGIN = 0x0400,    // GUI state
+    TRACE_GUI_RENDER_END,               // GUI state
+    TRACE_GUI_STATE,                    // new GUI state, old GUI state
+    TRACE_GUI_WAKE,                     // -, GUI_WAKE_* reasons (0 = deadline)
+};
+
+// One trace record (little-endian, as dumped)
+struct __attribute__((packed)) TraceRecord {
+    uint32_t timestamp_us;  // esp_timer_get_time() low 32 bits
+    uint16_t event;         // TraceEvent
+    uint16_t arg0;
+    uint32_t arg1;
+    uint32_t arg2;
+};
+
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord must stay 16 bytes (decoder format)");
+static_assert((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) == 0, "TRACE_RING_SIZE must be a power of two");
+
+extern TraceRecord traceRing[TRACE_RING_SIZE];
+extern uint32_t traceHead;   // Total records written (ring index = traceHead % size)
+
+#if TRACE_SYSVIEW
+// Module events: 16 per event group (0x01xx..0x04xx)
+#define TRACE_SV_GROUP_EVENTS   16
+#define TRACE_SV_EVENTS         (4 * TRACE_SV_GROUP_EVENTS)
+
+void traceSysView(uint16_t event, uint16_t arg0, uint32_t arg1, uint32_t arg2);
+#endif
+
+#if TRACE_ENABLED
+// Record an event - one atomic index bump plus a record store, safe from any task
+static inline void trace(uint16_t event, uint16_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0) {
+    uint32_t idx = __atomic_fetch_add(&traceHead, 1, __ATOMIC_RELAXED) & (TRACE_RING_SIZE - 1);
+    traceRing[idx] = TraceRecord{(uint32_t)esp_timer_get_time(), event, arg0, arg1, arg2};
+#if TRACE_SYSVIEW
+    traceSysView(event, arg0, arg1, arg2);
+#endif
+}
+#else
+static inline void trace(uint16_t, uint16_t = 0, uint32_t = 0, uint32_t = 0) {}
+#endif
+
+// Register the SystemView module (TRACE_SYSVIEW builds) - early in setup()
+void initTrace();
+
+// Discard all recorded events
+void traceClear();
+
+// Stream the ring out over USB serial, oldest record first
+// Format: "TRACE_BEGIN <ver> <count> <record_size>\n" + count raw records + "\nTRACE_END\n"
+void traceDump();
+
+#endif // TRACE_H
@@ -0,0 +1,127 @@
+#ifndef UART_FRAME_H
+#define UART_FRAME_H
+
+#include "hal.h"
+#include "uart_protocol.h"
+
+/*=========================FRAME PARSER=========================*/
+// Finds legacy (AA type payload 55) and v2 (A5 5A ver type len payload crc16)
+// frames in a byte buffer and hands each payload to a handler. Platform-free:
+// the UART reader (UART_Functions.cpp) owns the buffers, handlers and stats
+
+// Counters of a scan - added to, never cleared, by scanUARTFrames()
+struct UARTFrameCounters {
+    uint32_t framesParsed;      // Valid frames handed to the handler
+    uint32_t bytesSkipped;      // Bytes discarded while resyncing to a frame start
+    uint32_t v2Frames;          // Frames in the CRC-protected v2 format
+    uint32_t crcErrors;         // v2 frames rejected by the CRC check
+    uint32_t resyncs;           // Times the scan lost sync (garbage or a rejected frame start)
+};
+
+// One valid frame: payload is the legacy frame without start/type/end, or the
+// v2 payload (len may exceed the type's size on newer peers)
+typedef void (*UARTFrameHandler)(uint8_t type, const uint8_t* payload, size_t len, bool v2, void* context);
+
+// Receive staging: a partial frame left from the previous block + the newest block
+#define UART_RX_BLOCK_SIZE  128     // Max bytes handed to the parser per read
+#define UART_RX_STAGE_SIZE  (UART_RX_BLOCK_SIZE + UART_MAX_FRAME_SIZE)
+
+struct UARTFrameStage {
+    uint8_t data[UART_RX_STAGE_SIZE];   // Parsed in place
+    size_t len;
+    bool outOfSync;                     // Skipping bytes - the next skip is not a new resync
+};
+
+// Result of checking for a frame at the current position
+enum FrameCheck {
+    FRAME_OK,           // Complete valid frame, size set
+    FRAME_INCOMPLETE,   // Might be a frame - wait for more bytes
+    FRAME_INVALID       // Not a frame - skip one byte and rescan
+};
+
+// Payload size for a packet type (the minimum for the block types), 0 if the type is unknown
+inline size_t uartPayloadSize(uint8_t type) {
+    return type < UART_FRAME_TYPE_LIMIT ? uartFrameSchema.spec[type].payloadSize : 0;
+}
+
+/*=========================FRAME CODEC=========================*/
+// Encoders and decoders for both ends of the link, driven by
+// UART_FRAME_SCHEMA (uart_protocol.h). The STM32 firmware builds this file
+// and uart_frame.cpp as they are; the simulator (stm32_sim.cpp) uses the same
+// calls. Encoders write into out (UART_MAX_FRAME_SIZE bytes) and return the
+// frame size, 0 if the schema does not allow the frame
+
+// Data or ACK frame of type with len payload bytes - at least the schema
+// size, and for blocks the header's count of points
+size_t encodeUARTFrame(uint8_t* out, uint8_t type, const void* payload, size_t len, bool v2);
+
+template <uint8_t Type>
+inline size_t encodeUARTFrame(uint8_t* out, const typename UARTFrameLayout<Type>::Payload& payload, bool v2) {
+    static_assert((UARTFrameLayout<Type>::frameFlags & UART_FRAME_BLOCK) == 0, "Blocks carry points - use the sized call");
+    return encodeUARTFrame(out, Type, &payload, sizeof(payload), v2);
+}
+
+// ACK of command cmd (the sequence number on v2 only)
+size_t encodeUARTAck(uint8_t* out, uint8_t cmd, uint8_t seq, bool v2);
+
+// A command as either side handles it
+struct UARTCommand {
+    uint8_t type;           // CMD_*
+    uint8_t seq;            // v2 only, echoed in the ACK
+    uint32_t data1;
+    uint32_t data2;
+    uint32_t data3;
+};
+
+// Command packet: v2 A5 5A ver cmd len UARTCommandPayload crc16, or legacy
+// AA cmd UARTLegacyCommandPayload 55
+size_t encodeUARTCommand(uint8_t* out, const UARTCommand& command, bool v2);
+
+// Command packet at the start of data (STM32 side): FRAME_OK with command,
+// its framing and the bytes used in size
+FrameCheck decodeUARTCommand(const uint8_t* data, size_t len, UARTCommand& command, bool& v2, size_t& size);
+
+// Typed view of a received payload, nullptr if it is too short for Type
+template <uint8_t Type>
+inline const typename UARTFrameLayout<Type>::Payload* decodeUARTPayload(const uint8_t* payload, size_t len) {
+    using Payload = typename UARTFrameLayout<Type>::Payload;
+    return len >= sizeof(Payload) ? reinterpret_cast<const Payload*>(payload) : nullptr;
+}
+
+// Header and points of a block frame (UART_FRAME_BLOCK); nullptr if the
+// count is out of range or the points do not fit len
+template <uint8_t Type>
+inline const UARTFrequencyBlockHeader* decodeUARTBlock(const uint8_t* payload, size_t len,
+                                                       const typename UARTFrameLayout<Type>::Point*& points) {
+    using Point = typename UARTFrameLayout<Type>::Point;
+    static_assert((UARTFrameLayout<Type>::frameFlags & UART_FRAME_BLOCK) != 0, "Not a block frame");
+    const UARTFrequencyBlockHeader* header = decodeUARTPayload<Type>(payload, len);
+    if (header == nullptr || header->count == 0 || header->count > UART_BLOCK_MAX_POINTS ||
+        len < sizeof(*header) + header->count * sizeof(Point)) {
+        return nullptr;
+    }
+    points = reinterpret_cast<const Point*>(payload + sizeof(*header));
+    return header;
+}
+
+// UARTCompactPoint magnitude coding
+uint16_t uartCompactMagCode(float magnitude);
+float uartCompactMagnitude(uint16_t code);
+
+// Parse all complete frames in data. *consumed is set to the bytes used or
+// skipped - a trailing partial frame is left for the next call
+// Returns the number of frames handed to handler
+size_t scanUARTFrames(const uint8_t* data, size_t len, size_t* consumed,
+                      UARTFrameHandler handler, void* context, UARTFrameCounters& counters);
+
+// Parse stage.data[0..len) in place and keep only the incomplete tail
+// Callers may fill the free space (UART_RX_STAGE_SIZE - len) directly first
+size_t parseUARTStage(UARTFrameStage& stage, UARTFrameHandler handler, void* context,
+                      UARTFrameCounters& counters);
+
+// Parse a block of received bytes of any length: straight from data while
+// no partial frame is pending, the remainder through the stage
+size_t feedUARTFrames(UARTFrameStage& stage, const uint8_t* data, size_t len,
+                      UARTFrameHandler handler, void* context, UARTFrameCounters& counters);
+
+#endif // UART_FRAME_H
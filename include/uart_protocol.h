@@ -0,0 +1,388 @@
+#ifndef UART_PROTOCOL_H
+#define UART_PROTOCOL_H
+
+#include "hal.h"
+
+/*=========================STM32 WIRE PROTOCOL=========================*/
+// Frame and command definitions shared with the STM32 firmware - no driver
+// or RTOS dependencies, so the frame parser (uart_frame.h) builds on the host
+
+// Command protocol (matching STM32)
+#define UART_CMD_START_BYTE     0xAA
+#define UART_CMD_END_BYTE       0x55
+#define UART_CMD_PACKET_SIZE    15
+#define UART_ACK_PACKET_SIZE    4
+
+// Command types
+#define CMD_SET_PGA_GAIN        0x01
+#define CMD_SET_MUX_CHANNEL     0x02
+#define CMD_START_MEASUREMENT   0x03
+#define CMD_END_MEASUREMENT     0x04
+#define CMD_SET_TIA_GAIN        0x05
+#define CMD_SET_BAUD_RATE       0x06
+#define CMD_GET_DEVICE_ID       0x07    // Answered with a UART_DATA_DEVICE_ID frame
+#define CMD_START_MASKED        0x08    // START over a SweepMask: data2/data3 = mask bits 0-31/32-63
+#define CMD_SET_GAIN_PLAN       0x09    // Starting gains of up to 8 sweep indices of one DUT (see below)
+#define CMD_FLOW_CREDIT         0x0A    // Frame limit of a START_FLAG_CREDITS sweep - never ACKed
+#define CMD_SET_REPEAT_PLAN     0x0B    // Repeats of up to 8 sweep indices, all DUTs (see below)
+#define CMD_LINK_TEST           0x0C    // Answered with LINK_TEST frames of a known pattern (see below)
+#define CMD_SET_GAIN_LIMITS     0x0D    // Gain combinations allowed at up to 4 sweep indices, all DUTs (see below)
+// Which commands are ACKed: UART_FRAME_SCHEMA below
+
+// START / START_MASKED data1 flags above the DUT count (bits 0-7)
+#define START_FLAG_INTERLEAVED  0x100   // Frequency-major: all DUTs at f0, then all at f1, ...
+#define START_FLAG_INDEXED      0x200   // Send FREQUENCY_IDX frames (sweep index + sequence number)
+#define START_FLAG_GAIN_PLAN    0x400   // Start each point at its CMD_SET_GAIN_PLAN gains, autorange from there
+#define START_FLAG_CREDITS      0x800   // Send frequency frames only up to the CMD_FLOW_CREDIT limit
+#define START_FLAG_BLOCKS       0x1000  // Send FREQUENCY_BLOCK frames (v2 peers, DUT-by-DUT sweeps)
+#define START_FLAG_COMPACT      0x2000  // Blocks as COMPACT_BLOCK frames (with START_FLAG_BLOCKS only)
+#define START_FLAG_REPEAT_PLAN  0x4000  // Measure each index its CMD_SET_REPEAT_PLAN count of times
+#define START_FLAG_GAIN_LIMITS  0x8000  // Autorange only over the CMD_SET_GAIN_LIMITS combinations
+#define START_REPEATS_SHIFT     16      // Bits 16-23: measure each frequency N times (0/1 = once)
+#define START_FIRST_DUT_SHIFT   24      // Bits 24-31: first DUT to sweep (0/1 = DUT 1) - resume after a stall
+
+// CMD_END_MEASUREMENT data1: 0 = stop the sweep, 1-n = end only this DUT
+// (the STM32 sends its DUT_END and continues with the next DUT)
+#define STOP_SCOPE_ALL          0
+
+// CMD_SET_GAIN_PLAN: data1 = DUT (1-n, bits 0-7), first sweep index (bits
+// 8-15) and hint count (bits 16-23, 1-GAIN_PLAN_CHUNK); data2/data3 = one hint
+// byte per index, data2 bits 0-7 first. A hint has the IMPEDANCE_FLAG_* layout
+// of a stored point - indices without GAIN_HINT_VALID autorange as before.
+// The plan holds for the next START with START_FLAG_GAIN_PLAN only; a START
+// without the flag drops it
+#define GAIN_PLAN_CHUNK         8
+#define GAIN_PLAN_FIRST_SHIFT   8
+#define GAIN_PLAN_COUNT_SHIFT   16
+#define GAIN_HINT_VALID         0x80
+#define GAIN_HINT_TIA_HIGH      0x08
+#define GAIN_HINT_PGA_MASK      0x07
+
+// CMD_SET_REPEAT_PLAN: data1 = first sweep index (bits 0-7) and count (bits
+// 8-15, 1-REPEAT_PLAN_CHUNK); data2/data3 = one repeat count (1-255) per
+// index, data2 bits 0-7 first. With START_FLAG_REPEAT_PLAN the counts replace
+// the START repeats for those indices; a START without the flag drops the
+// plan. A FREQUENCY_BLOCK holds indices of one repeat count only
+#define REPEAT_PLAN_CHUNK       8
+#define REPEAT_PLAN_COUNT_SHIFT 8
+
+// CMD_SET_GAIN_LIMITS: data1 = first sweep index (bits 0-7) and count (bits
+// 8-15, 1-GAIN_LIMIT_CHUNK); data2/data3 = one 16-bit mask per index, data2
+// bits 0-15 first. Bit GAIN_LIMIT_BIT(tia high, pga) allows that combination;
+// with START_FLAG_GAIN_LIMITS the autoranging of those indices settles only
+// on allowed combinations (the nearest PGA, then the other TIA). Indices
+// not sent are not limited; a START without the flag drops the limits
+#define GAIN_LIMIT_CHUNK        4
+#define GAIN_LIMIT_COUNT_SHIFT  8
+#define GAIN_LIMIT_ALL          0xFFFF
+#define GAIN_LIMIT_BIT(tiaHigh, pga)    ((uint16_t)1 << ((tiaHigh) ? 8 + (pga) : (pga)))
+
+// CMD_FLOW_CREDIT: data1 = frequency frames (every kind, repeats included)
+// the STM32 may have sent since the START ACK. The limit is absolute, so a
+// lost or repeated grant does no harm - the STM32 keeps the highest one. A
+// sweep with START_FLAG_CREDITS sends no frequency frame before the first
+// grant and holds at the limit; DUT_START / DUT_END frames are not counted
+
+// CMD_SET_BAUD_RATE data2 phase
+#define BAUD_PHASE_SWITCH       0   // Request switch to data1 (ACKed at the old rate)
+#define BAUD_PHASE_VERIFY       1   // Confirm data1 is working (ACKed at the new rate)
+
+// CMD_LINK_TEST: data1 = frames (1-LINK_TEST_MAX_FRAMES), data2 = seed. After
+// the ACK the STM32 sends that many LINK_TEST frames back to back, frame n
+// carrying sequence number n and fillUARTLinkTestPattern(seed, n) - the
+// receiver counts the frames that arrive intact
+#define LINK_TEST_MAX_FRAMES    64
+#define LINK_TEST_PATTERN_SIZE  24
+
+// Data packet protocol (matching STM32)
+#define UART_DATA_START_BYTE    0xAA
+#define UART_DATA_END_BYTE      0x55
+
+// Packet types
+#define UART_DATA_DUT_START     0x10
+#define UART_DATA_FREQUENCY     0x11
+#define UART_DATA_DUT_END       0x12
+#define UART_DATA_DEVICE_ID     0x13    // STM32 96-bit unique ID (reply to CMD_GET_DEVICE_ID)
+#define UART_DATA_FREQUENCY_DUT 0x14    // FREQUENCY with its DUT number (interleaved sweeps)
+#define UART_DATA_FREQUENCY_IDX 0x15    // FREQUENCY with DUT, sweep index and sequence (START_FLAG_INDEXED)
+#define UART_DATA_FREQUENCY_BLOCK 0x16  // Consecutive points of one DUT (START_FLAG_BLOCKS, v2 only)
+#define UART_DATA_COMPACT_BLOCK 0x17    // FREQUENCY_BLOCK with quantized points (START_FLAG_COMPACT, v2 only)
+#define UART_DATA_LINK_TEST     0x18    // Test pattern (reply to CMD_LINK_TEST)
+
+// Packet sizes
+#define UART_DATA_DUT_START_SIZE    7
+#define UART_DATA_FREQUENCY_SIZE    26
+#define UART_DATA_DUT_END_SIZE      4
+#define UART_DATA_DEVICE_ID_SIZE    15
+#define UART_DATA_FREQUENCY_DUT_SIZE 27
+#define UART_DATA_FREQUENCY_IDX_SIZE 30
+#define UART_DATA_LINK_TEST_SIZE    29
+
+// Versioned frame format (v2): A5 5A ver type len payload[len] crc16
+// CRC-16/CCITT (crc16_ccitt) over ver..payload, little-endian on the wire
+// The payload is the legacy frame without its start/type/end bytes
+#define UART_V2_SYNC0               0xA5
+#define UART_V2_SYNC1               0x5A
+#define UART_V2_VERSION             0x01
+#define UART_V2_HEADER_SIZE         5       // sync0, sync1, ver, type, len
+#define UART_V2_CRC_SIZE            2
+#define UART_V2_MAX_PAYLOAD         (UART_BLOCK_HEADER_SIZE + UART_BLOCK_MAX_POINTS * UART_BLOCK_POINT_SIZE)
+#define UART_V2_MAX_FRAME_SIZE      (UART_V2_HEADER_SIZE + UART_V2_MAX_PAYLOAD + UART_V2_CRC_SIZE)
+
+#define UART_MAX_FRAME_SIZE         UART_V2_MAX_FRAME_SIZE
+
+// FREQUENCY_BLOCK frames (see UARTFrequencyBlockHeader)
+#define UART_BLOCK_MAX_POINTS       16
+#define UART_BLOCK_HEADER_SIZE      8
+#define UART_BLOCK_POINT_SIZE       13
+#define UART_COMPACT_POINT_SIZE     7
+
+// Wire layout of the frame payloads (little-endian, same as the ESP32)
+// The parser reads frames through these views directly in the receive buffer
+struct __attribute__((packed)) UARTDutStartPayload {
+    uint8_t dut;            // DUT number (1-based)
+    uint8_t freqCount;      // Number of frequency frames that follow
+    uint8_t reserved[2];
+};
+
+struct __attribute__((packed)) UARTFrequencyPayload {
+    uint32_t freq_hz;
+    float V_magnitude;
+    float V_phase;
+    float I_magnitude;
+    float I_phase;
+    uint8_t pga_gain;
+    uint8_t tia_gain;       // 1=high, 0=low
+    uint8_t valid;
+};
+
+// Interleaved sweeps tag every point with its DUT instead of DUT_START blocks
+struct __attribute__((packed)) UARTFrequencyDutPayload {
+    uint8_t dut;            // DUT number (1-based)
+    UARTFrequencyPayload point;
+};
+
+// Indexed sweeps (either order): the point's sweep table index and a per-DUT
+// sequence number - 0 at the DUT's first frame after START, +1 per frame
+// including repeats - so a lost frame shows as a gap without matching frequencies
+struct __attribute__((packed)) UARTFrequencyIdxPayload {
+    uint8_t dut;            // DUT number (1-based)
+    uint8_t freqIdx;        // sweepFrequencies[] index of point.freq_hz
+    uint16_t seq;
+    UARTFrequencyPayload point;
+};
+
+// Block sweeps (START_FLAG_BLOCKS): up to UART_BLOCK_MAX_POINTS points of one
+// DUT in one v2 frame, followed by count UARTBlockPoint. The points walk the
+// sweep table from firstIdx in steps of step (+1, or -1 for rising
+// frequency), each index measured repeats times, and the first point is
+// repeat firstRepeat of firstIdx. Point i is therefore at index
+// firstIdx + step * ((firstRepeat + i) / repeats). The frequency comes from the
+// index and the phase is sent as V - I, so a point costs 13 bytes instead of
+// a 26-byte frame. A mask gap ends the block. seq numbers the first point as
+// FREQUENCY_IDX would, +1 per point, and every point counts as one frame
+// against CMD_FLOW_CREDIT. Interleaved sweeps and legacy framing ignore the flag
+struct __attribute__((packed)) UARTFrequencyBlockHeader {
+    uint8_t dut;            // DUT number (1-based)
+    uint8_t firstIdx;       // sweepFrequencies[] index of the first point
+    int8_t step;            // +1 / -1 per index
+    uint8_t firstRepeat;    // Repeats of firstIdx sent before this block
+    uint8_t repeats;        // Points per index (0/1 = once)
+    uint8_t count;          // Points that follow, 1-UART_BLOCK_MAX_POINTS
+    uint16_t seq;
+};
+
+// Block point gains: the IMPEDANCE_FLAG_* layout of a stored point
+#define BLOCK_POINT_VALID       0x80
+#define BLOCK_POINT_TIA_HIGH    0x08
+#define BLOCK_POINT_PGA_MASK    0x07
+
+struct __attribute__((packed)) UARTBlockPoint {
+    float V_magnitude;
+    float I_magnitude;
+    float phase_deg;        // V_phase - I_phase
+    uint8_t gains;          // BLOCK_POINT_*
+};
+
+// Compact blocks (START_FLAG_COMPACT): the same header, then count
+// UARTCompactPoint - magnitudes as round(ln(mag) * 2048) + 32768 (0.05 %
+// steps over e^-16..e^16, clamped; code 0 = 0), phase in centidegrees.
+// About half the bytes of a UARTBlockPoint, finer than the ADC resolves
+#define UART_COMPACT_MAG_STEPS_PER_LN   2048
+#define UART_COMPACT_MAG_ZERO           32768   // Code of magnitude 1.0
+
+struct __attribute__((packed)) UARTCompactPoint {
+    uint16_t V_code;
+    uint16_t I_code;
+    int16_t phase_cdeg;     // V_phase - I_phase, 0.01 degree
+    uint8_t gains;          // BLOCK_POINT_*
+};
+
+struct __attribute__((packed)) UARTDutEndPayload {
+    uint8_t dut;
+};
+
+struct __attribute__((packed)) UARTDeviceIdPayload {
+    uint32_t uid[3];        // UID_BASE words 0-2 as read on the STM32
+};
+
+struct __attribute__((packed)) UARTLinkTestPayload {
+    uint16_t seq;           // 0..frames-1 of the CMD_LINK_TEST
+    uint8_t pattern[LINK_TEST_PATTERN_SIZE];
+};
+
+// Pattern of LINK_TEST frame seq: runs and alternating bits first (the
+// worst cases for a slow edge or a baud mismatch), then xorshift32 bytes
+inline void fillUARTLinkTestPattern(uint8_t* out, uint32_t seed, uint16_t seq) {
+    static const uint8_t fixed[] = {0x55, 0xAA, 0x00, 0xFF, 0x0F, 0xF0};
+    uint32_t x = (seed ^ (seq * 0x9E3779B1u)) | 1;
+    for (int i = 0; i < LINK_TEST_PATTERN_SIZE; i++) {
+        if (i < (int)sizeof(fixed)) {
+            out[i] = fixed[i];
+            continue;
+        }
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        out[i] = (uint8_t)x;
+    }
+}
+
+struct __attribute__((packed)) UARTAckPayload {
+    uint8_t status;         // 0x01 = OK
+};
+
+// v2 ACKs append the sequence number of the acknowledged command
+struct __attribute__((packed)) UARTAckSeqPayload {
+    uint8_t status;         // 0x01 = OK
+    uint8_t seq;
+};
+
+// v2 command payload (type = command, sent as A5 5A ver cmd len payload crc16)
+struct __attribute__((packed)) UARTCommandPayload {
+    uint8_t seq;            // Echoed in the ACK
+    uint32_t data1;
+    uint32_t data2;
+    uint32_t data3;
+};
+
+// Legacy command payload (AA cmd payload 55) - no sequence number
+struct __attribute__((packed)) UARTLegacyCommandPayload {
+    uint32_t data1;
+    uint32_t data2;
+    uint32_t data3;
+};
+
+// Legacy framing: start, type, payload, end
+#define UART_LEGACY_OVERHEAD        3
+
+static_assert(sizeof(UARTDutStartPayload) + UART_LEGACY_OVERHEAD == UART_DATA_DUT_START_SIZE, "DUT_START frame size");
+static_assert(sizeof(UARTFrequencyPayload) + UART_LEGACY_OVERHEAD == UART_DATA_FREQUENCY_SIZE, "FREQUENCY frame size");
+static_assert(sizeof(UARTDutEndPayload) + UART_LEGACY_OVERHEAD == UART_DATA_DUT_END_SIZE, "DUT_END frame size");
+static_assert(sizeof(UARTFrequencyDutPayload) + UART_LEGACY_OVERHEAD == UART_DATA_FREQUENCY_DUT_SIZE, "FREQUENCY_DUT frame size");
+static_assert(sizeof(UARTFrequencyDutPayload) <= UART_V2_MAX_PAYLOAD, "v2 payload limit");
+static_assert(sizeof(UARTFrequencyIdxPayload) + UART_LEGACY_OVERHEAD == UART_DATA_FREQUENCY_IDX_SIZE, "FREQUENCY_IDX frame size");
+static_assert(sizeof(UARTFrequencyIdxPayload) <= UART_V2_MAX_PAYLOAD, "v2 payload limit");
+static_assert(sizeof(UARTDeviceIdPayload) + UART_LEGACY_OVERHEAD == UART_DATA_DEVICE_ID_SIZE, "DEVICE_ID frame size");
+static_assert(sizeof(UARTLinkTestPayload) + UART_LEGACY_OVERHEAD == UART_DATA_LINK_TEST_SIZE, "LINK_TEST frame size");
+static_assert(sizeof(UARTAckPayload) + UART_LEGACY_OVERHEAD == UART_ACK_PACKET_SIZE, "ACK frame size");
+static_assert(sizeof(UARTFrequencyPayload) <= UART_V2_MAX_PAYLOAD, "v2 payload limit");
+static_assert(sizeof(UARTFrequencyBlockHeader) == UART_BLOCK_HEADER_SIZE, "FREQUENCY_BLOCK header size");
+static_assert(sizeof(UARTBlockPoint) == UART_BLOCK_POINT_SIZE, "FREQUENCY_BLOCK point size");
+static_assert(sizeof(UARTCompactPoint) == UART_COMPACT_POINT_SIZE, "COMPACT_BLOCK point size");
+static_assert(UART_V2_MAX_PAYLOAD <= 255, "v2 len is one byte");
+static_assert(sizeof(UARTLegacyCommandPayload) + UART_LEGACY_OVERHEAD == UART_CMD_PACKET_SIZE, "Command packet size");
+
+/*=========================FRAME SCHEMA=========================*/
+// Every STM32 -> ESP32 frame type once: its payload view, the point that
+// follows a block header (void for fixed frames) and UART_FRAME_* flags. The
+// parser's size lookup (uartPayloadSize()), the typed decoders and encoders
+// (uart_frame.h) and the layout checks below are generated from it, so a new
+// frame type is one row and a packed struct - no byte offsets anywhere
+//
+// X(type, payload, point, flags)
+#define UART_FRAME_LEGACY       0x01    // Also sent with legacy framing (AA type payload 55)
+#define UART_FRAME_BLOCK        0x02    // Header + count points, v2 only - len gives the size
+#define UART_FRAME_ACK          0x04    // ACK of the command of that type (UARTAckSeqPayload on v2)
+
+#define UART_FRAME_SCHEMA(X) \
+    X(CMD_SET_PGA_GAIN,          UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_SET_MUX_CHANNEL,       UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_START_MEASUREMENT,     UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_END_MEASUREMENT,       UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_SET_TIA_GAIN,          UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_SET_BAUD_RATE,         UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_GET_DEVICE_ID,         UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_START_MASKED,          UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_SET_GAIN_PLAN,         UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_SET_REPEAT_PLAN,       UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_LINK_TEST,             UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(CMD_SET_GAIN_LIMITS,       UARTAckPayload,           void,             UART_FRAME_LEGACY | UART_FRAME_ACK) \
+    X(UART_DATA_DUT_START,       UARTDutStartPayload,      void,             UART_FRAME_LEGACY) \
+    X(UART_DATA_FREQUENCY,       UARTFrequencyPayload,     void,             UART_FRAME_LEGACY) \
+    X(UART_DATA_DUT_END,         UARTDutEndPayload,        void,             UART_FRAME_LEGACY) \
+    X(UART_DATA_DEVICE_ID,       UARTDeviceIdPayload,      void,             UART_FRAME_LEGACY) \
+    X(UART_DATA_LINK_TEST,       UARTLinkTestPayload,      void,             UART_FRAME_LEGACY) \
+    X(UART_DATA_FREQUENCY_DUT,   UARTFrequencyDutPayload,  void,             UART_FRAME_LEGACY) \
+    X(UART_DATA_FREQUENCY_IDX,   UARTFrequencyIdxPayload,  void,             UART_FRAME_LEGACY) \
+    X(UART_DATA_FREQUENCY_BLOCK, UARTFrequencyBlockHeader, UARTBlockPoint,   UART_FRAME_BLOCK) \
+    X(UART_DATA_COMPACT_BLOCK,   UARTFrequencyBlockHeader, UARTCompactPoint, UART_FRAME_BLOCK)
+
+#define UART_FRAME_TYPE_LIMIT   0x20    // Frame types are below this
+
+// Layout of one frame type - payloadSize 0 = unknown type
+struct UARTFrameSpec {
+    uint8_t payloadSize;    // Fixed payload, or the block header
+    uint8_t pointSize;      // Block point, 0 for fixed frames
+    uint8_t flags;          // UART_FRAME_*
+};
+
+struct UARTFrameSchema {
+    UARTFrameSpec spec[UART_FRAME_TYPE_LIMIT];
+};
+
+template <typename T> constexpr size_t uartSizeOf() { return sizeof(T); }
+template <> constexpr size_t uartSizeOf<void>() { return 0; }
+
+constexpr UARTFrameSchema buildUARTFrameSchema() {
+    UARTFrameSchema schema = {};
+#define UART_SCHEMA_SPEC(type, payload, point, flags) \
+    schema.spec[type] = {(uint8_t)sizeof(payload), (uint8_t)uartSizeOf<point>(), (uint8_t)(flags)};
+    UART_FRAME_SCHEMA(UART_SCHEMA_SPEC)
+#undef UART_SCHEMA_SPEC
+    return schema;
+}
+
+inline constexpr UARTFrameSchema uartFrameSchema = buildUARTFrameSchema();
+
+// Typed view of a frame type: UARTFrameLayout<UART_DATA_FREQUENCY>::Payload
+template <uint8_t Type> struct UARTFrameLayout;
+
+#define UART_SCHEMA_LAYOUT(type, payload, point, flags) \
+    template <> struct UARTFrameLayout<type> { \
+        using Payload = payload; \
+        using Point = point; \
+        static constexpr uint8_t frameFlags = (flags); \
+    };
+UART_FRAME_SCHEMA(UART_SCHEMA_LAYOUT)
+#undef UART_SCHEMA_LAYOUT
+
+// Every row fits both framings it is sent in, and a full block fits v2
+#define UART_SCHEMA_CHECK(type, payload, point, flags) \
+    static_assert((type) < UART_FRAME_TYPE_LIMIT, #type ": type outside the schema table"); \
+    static_assert(sizeof(payload) + ((flags) & UART_FRAME_BLOCK ? UART_BLOCK_MAX_POINTS * uartSizeOf<point>() : 0) \
+                  <= UART_V2_MAX_PAYLOAD, #type ": payload exceeds a v2 frame"); \
+    static_assert(((flags) & UART_FRAME_BLOCK) == 0 || uartSizeOf<point>() > 0, #type ": block without a point"); \
+    static_assert(((flags) & (UART_FRAME_BLOCK | UART_FRAME_LEGACY)) != (UART_FRAME_BLOCK | UART_FRAME_LEGACY), \
+                  #type ": blocks are v2 only");
+UART_FRAME_SCHEMA(UART_SCHEMA_CHECK)
+#undef UART_SCHEMA_CHECK
+
+// The fixed legacy sizes the STM32 firmware was written against
+static_assert(uartFrameSchema.spec[UART_DATA_FREQUENCY].payloadSize + UART_LEGACY_OVERHEAD == UART_DATA_FREQUENCY_SIZE,
+              "FREQUENCY schema size");
+static_assert(uartFrameSchema.spec[CMD_START_MEASUREMENT].payloadSize + UART_LEGACY_OVERHEAD == UART_ACK_PACKET_SIZE,
+              "ACK schema size");
+static_assert(uartFrameSchema.spec[CMD_FLOW_CREDIT].payloadSize == 0, "CMD_FLOW_CREDIT is never ACKed");
+
+#endif // UART_PROTOCOL_H
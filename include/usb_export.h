@@ -0,0 +1,50 @@
+#ifndef USB_EXPORT_H
+#define USB_EXPORT_H
+
+#include <Arduino.h>
+
+/*=========================BINARY EXPORT=========================*/
+// Stored sweeps as framed binary on Serial (USB CDC), decoded on the host by
+// usb_export_decode.py. Every frame is COBS-encoded between two 0x00 bytes
+// and goes out as one console record, so log lines from other tasks can only
+// land between frames - the host drops whatever fails the CRC as text
+//
+// Decoded frame: type (1) | body | CRC-16/CCITT of type + body (2, LE)
+#define USB_EXPORT_VERSION      1
+
+#define USB_EXPORT_BEGIN        0x01    // version, dutCount, pointsPerDut, state, generation (u32)
+#define USB_EXPORT_ROW          0x02    // dut, sweep (0 baseline, 1 final), count, count x point
+#define USB_EXPORT_END          0x03    // rows (u8), points (u16)
+#define USB_EXPORT_MIRROR       0x04    // Screen mirror packet (screen_mirror.h), not part of an export
+#define USB_EXPORT_FILE         0x05    // offset (u32), up to PSSESSION_CHUNK bytes of a .pssession document
+#define USB_EXPORT_FILE_END     0x06    // bytes (u32), complete (u8: 0 if the document was cut short)
+
+#define USB_EXPORT_STATE_BASELINE   0x01    // baselineMeasurementDone
+#define USB_EXPORT_STATE_FINAL      0x02    // finalMeasurementDone
+
+// One point in a ROW body (little-endian, 15 bytes)
+struct __attribute__((packed)) UsbExportPoint {
+    uint32_t freqHz;
+    float magnitude;        // Ohms
+    float phase;            // Degrees
+    uint8_t flags;          // IMPEDANCE_FLAG_* | PGA gain
+    uint8_t magSd;          // POINT_NOISE_MAG_STEP units (repeat_filter.h)
+    uint8_t phaseSd;        // POINT_NOISE_PHASE_STEP units
+};
+
+// Send the stored baseline and final rows of every channel
+// finishedOnly: leave out the rows of a sweep still running - the export of a
+// baseline, queued behind its deliveries, may go out once the final sweep started
+// Returns false if no row holds a point (nothing is sent)
+bool sendBinaryExport(bool finishedOnly = false);
+
+// Send the .pssession document (pssession_export.h) of the final (else
+// baseline) rows as FILE frames and a FILE_END - serial "export pssession".
+// Returns false if no row holds a valid point (nothing is sent)
+bool sendPsSessionExport(bool final);
+
+// One frame of type with len bytes of body, for other senders on the same
+// channel (GUI task, like the export)
+void sendUsbExportFrame(uint8_t type, const uint8_t* body, size_t len);
+
+#endif // USB_EXPORT_H
@@ -0,0 +1,73 @@
+#ifndef WIFI_SERVER_H
+#define WIFI_SERVER_H
+
+#include <Arduino.h>
+
+/*=========================WI-FI SERVER=========================*/
+// Optional Wi-Fi station mode for bulk transfers (-D WIFI_SERVER=1,
+// [env:wifi]). BLE stays the control path: the WebUI provisions the network
+// with WIFI:<ssid>,<passphrase> and keeps sending its commands over BLE
+//
+// HTTP server (esp_http_server, port 80, also http://biopal.local):
+//   GET /history/info  {"version":..,"id":..,"size":..} of the session image
+//   GET /history       The session image (history_download.h) as one
+//                      application/octet-stream body, from ?offset=N, and
+//                      only while it is still ?id=I (409 once it rotated)
+//   GET /session.pssession  The stored final (?sweep=baseline: baseline)
+//                      rows as a PalmSens document (pssession_export.h),
+//                      generated while it is sent
+//   GET /live          WebSocket: every message the BLE clients get from
+//                      sendBLEString() as a text frame, and every live point
+//                      (sendBLELivePoint) as a binary frame - the same bytes,
+//                      encoded once. A socket counts as a streaming client
+//
+// Live frames go through a message buffer to the Wi-Fi TX task, so the data
+// processor never waits on TCP; a full buffer drops the frame (counted).
+// Credentials are kept in WIFI_CONFIG_FILE, in the clear like the other
+// settings files
+#ifndef WIFI_SERVER
+#define WIFI_SERVER 0
+#endif
+
+#define WIFI_CONFIG_FILE        "/wifi.txt"     // enabled, ssid, passphrase - one per line
+#define WIFI_HOSTNAME           "biopal"
+#define WIFI_SSID_MAX           32
+#define WIFI_PASS_MAX           63
+#define WIFI_WS_CLIENTS         3       // Live WebSocket connections
+#define WIFI_WS_BUFFER_BYTES    8192    // Live frames waiting for the TX task
+#define WIFI_WS_FRAME_MAX       512     // Largest live frame
+#define WIFI_HTTP_CHUNK_BYTES   4096    // Image bytes per HTTP body chunk
+#define WIFI_SEND_TIMEOUT_S     2       // Socket send timeout - below the task watchdog
+
+#if WIFI_SERVER
+// Load the stored network and connect if it is enabled - setup(), after storage
+void initWiFiServer();
+
+// Store a network and connect to it (pass may be empty for an open network)
+bool setWiFiNetwork(const char* ssid, const char* pass);
+
+// Connect to / drop the stored network, remembered across reboots
+bool setWiFiEnabled(bool enable);
+bool isWiFiEnabled();
+
+// "off", "connecting <ssid>" or "<ip>" - for STATUS and the serial console
+void getWiFiStatus(char* out, size_t size);
+
+// Live WebSocket connections
+uint8_t getWiFiLiveClients();
+
+// Queue a live message for every WebSocket - text, or binary if data starts
+// with BLE_BIN_MAGIC. Never blocks; false if it was dropped
+bool sendWiFiLive(const uint8_t* data, size_t len);
+
+// Live frames dropped because the buffer was full
+uint32_t getWiFiLiveDrops();
+
+// Wi-Fi TX task - drains the live buffer to the WebSockets
+void taskWiFiTx(void* parameter);
+#else
+inline uint8_t getWiFiLiveClients() { return 0; }
+inline bool sendWiFiLive(const uint8_t* data, size_t len) { return false; }
+#endif
+
+#endif // WIFI_SERVER_H
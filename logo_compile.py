@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+BioPal Splash Logo Compiler
+Reads the raw RGB565 splash logo (assets/logo.h, a C array as exported by
+image converters) and writes include/logo_image.h: the same image in the
+compressed stream decoded by src/image_codec.cpp (format in
+include/image_codec.h). The stream is decoded again before writing, so a
+codec mismatch fails here instead of drawing garbage on the device.
+
+Usage:
+  python logo_compile.py                         # assets/logo.h -> include/logo_image.h
+  python logo_compile.py --src assets/logo.h --out include/logo_image.h
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Must match include/image_codec.h
+INDEX_SIZE = 64
+OP_INDEX = 0x00
+OP_DIFF = 0x40
+OP_RUN = 0x80
+OP_RAW = 0xC0
+MAX_RUN = 64
+
+WIDTH = 320
+HEIGHT = 240
+
+
+def color_hash(color):
+    """imageColorHash() in include/image_codec.h"""
+    return ((color >> 11) * 3 + ((color >> 5) & 0x3F) * 5 + (color & 0x1F) * 7) % INDEX_SIZE
+
+
+def channels(color):
+    return color >> 11, (color >> 5) & 0x3F, color & 0x1F
+
+
+def encode(pixels):
+    out = bytearray()
+    index = [0] * INDEX_SIZE
+    prev = 0
+    run = 0
+    for color in pixels:
+        if color == prev:
+            run += 1
+            if run == MAX_RUN:
+                out.append(OP_RUN | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(OP_RUN | (run - 1))
+            run = 0
+
+        slot = color_hash(color)
+        deltas = [c - p for c, p in zip(channels(color), channels(prev))]
+        if index[slot] == color:
+            out.append(OP_INDEX | slot)
+        elif all(-2 <= d <= 1 for d in deltas):
+            dr, dg, db = (d + 2 for d in deltas)
+            out.append(OP_DIFF | dr << 4 | dg << 2 | db)
+        else:
+            out += bytes([OP_RAW, color >> 8, color & 0xFF])
+        index[slot] = color
+        prev = color
+    if run:
+        out.append(OP_RUN | (run - 1))
+    return bytes(out)
+
+
+def decode(data, count):
+    """Reference decoder, as decodeImagePixels()"""
+    pixels = []
+    index = [0] * INDEX_SIZE
+    prev = 0
+    pos = 0
+    while len(pixels) < count:
+        op = data[pos]
+        pos += 1
+        kind = op & 0xC0
+        if kind == OP_RUN:
+            pixels += [prev] * ((op & 0x3F) + 1)
+            continue
+        if kind == OP_INDEX:
+            color = index[op]
+        elif kind == OP_DIFF:
+            r, g, b = channels(prev)
+            color = ((r + (op >> 4 & 3) - 2) & 0x1F) << 11 | ((g + (op >> 2 & 3) - 2) & 0x3F) << 5 | ((b + (op & 3) - 2) & 0x1F)
+        else:
+            color = data[pos] << 8 | data[pos + 1]
+            pos += 2
+        index[color_hash(color)] = color
+        prev = color
+        pixels.append(color)
+    return pixels[:count]
+
+
+def read_pixels(path):
+    with open(path) as f:
+        text = f.read()
+    body = text[text.index("{"):]
+    return [int(value, 16) for value in re.findall(r"0x([0-9A-Fa-f]{1,4})\b", body)]
+
+
+def write_header(path, data, source):
+    lines = [
+        f"// Generated by logo_compile.py from {source} - do not edit",
+        "#ifndef LOGO_IMAGE_H",
+        "#define LOGO_IMAGE_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "// Splash logo, compressed RGB565 (see image_codec.h)",
+        f"#define LOGO_WIDTH      {WIDTH}",
+        f"#define LOGO_HEIGHT     {HEIGHT}",
+        f"#define LOGO_DATA_SIZE  {len(data)}",
+        "",
+        "const uint8_t logoData[LOGO_DATA_SIZE] PROGMEM = {",
+    ]
+    for i in range(0, len(data), 24):
+        lines.append("    " + ",".join(f"0x{b:02X}" for b in data[i:i + 24]) + ",")
+    lines += ["};", "", "#endif // LOGO_IMAGE_H", ""]
+    with open(path, "w", newline="\n") as f:
+        f.write("\n".join(lines))
+
+
+def compile_logo(src, out):
+    pixels = read_pixels(src)
+    if len(pixels) != WIDTH * HEIGHT:
+        print(f"ERROR: {src}: {len(pixels)} pixels, expected {WIDTH} x {HEIGHT}")
+        return False
+
+    data = encode(pixels)
+    if decode(data, len(pixels)) != pixels:
+        print("ERROR: compressed logo does not decode to the source image")
+        return False
+
+    source = os.path.basename(os.path.dirname(os.path.abspath(src))) + "/" + os.path.basename(src)
+    write_header(out, data, source)
+    print(f"Logo: {len(pixels) * 2} -> {len(data)} bytes ({len(data) * 100 / (len(pixels) * 2):.1f}%) -> {out}")
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compress the BioPal splash logo")
+    parser.add_argument("--src", default=os.path.join("assets", "logo.h"), help="Raw RGB565 logo header")
+    parser.add_argument("--out", default=os.path.join("include", "logo_image.h"), help="Generated header path")
+    args = parser.parse_args()
+
+    if not compile_logo(args.src, args.out):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
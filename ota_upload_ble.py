@@ -0,0 +1,357 @@
+#!/usr/bin/env python3
+"""
+BioPal Firmware Update over BLE
+Sends a firmware image (.pio/build/<env>/firmware.bin) to the device's OTA
+characteristic. The device streams it into the inactive app slot, checks its
+SHA-256 and signature, switches the boot slot and reboots. An update that
+fails its boot self-test, or crashes before it is confirmed, rolls back to
+the previous slot.
+
+Updates are signed with ECDSA P-256 over the image's SHA-256 (--key, default
+ota_signing_key.pem); the device checks them against the public key built
+into it (include/ota_signing_key.h). --keygen makes a key pair once: the .pem
+stays with whoever releases firmware, the header is built into the next
+firmware, flashed over USB. The OTA characteristic needs a bonded link, so
+the first upload pairs with the device's passkey (BLE_PAIRING_PASSKEY).
+
+With --base (the firmware.bin the device runs now) only a delta is sent:
+copies of unchanged runs from the running image plus the changed bytes.
+Without it the image is still compressed (repeated runs and fills).
+
+Frame format, delta ops and replies: include/ota_update.h
+
+Usage:
+  python ota_upload_ble.py --keygen ota_signing_key.pem
+  python ota_upload_ble.py --image .pio/build/esp32-c6-devkitc-1/firmware.bin
+  python ota_upload_ble.py --image new.bin --base old.bin
+  python ota_upload_ble.py --image new.bin --raw --address AA:BB:CC:DD:EE:FF
+  python ota_upload_ble.py --image new.bin --base old.bin --dry-run
+"""
+
+import argparse
+import asyncio
+import hashlib
+import os
+import struct
+import sys
+
+from cal_compile import crc16_ccitt
+
+# Must match include/BLE_Functions.h
+DEVICE_NAME = "BioPal"
+TX_UUID = "12345678-1234-5678-1234-56789abcdef2"
+OTA_UUID = "12345678-1234-5678-1234-56789abcdef4"
+
+# Must match include/ota_update.h
+FRAME_BEGIN = 0x01
+FRAME_DATA = 0x02
+FRAME_END = 0x03
+FRAME_ABORT = 0x04
+FRAME_MAX = 512
+FRAME_OVERHEAD = 5
+CHUNK_SIZE = FRAME_MAX - FRAME_OVERHEAD
+
+ENCODING_RAW = 0
+ENCODING_DELTA = 1
+
+OP_LITERAL = 0x00
+OP_COPY_BASE = 0x01
+OP_COPY_OUT = 0x02
+OP_FILL = 0x03
+WRITE_BUFFER = 4096
+SIGNATURE_SIZE = 64          # P-256 r, s
+
+DEFAULT_KEY = "ota_signing_key.pem"
+KEY_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "include", "ota_signing_key.h")
+
+# Encoder tuning - a copy or fill shorter than this costs more than the bytes
+BLOCK = 16
+MIN_COPY = 24
+MIN_FILL = 12
+LITERAL_MAX = 0xFFFF
+
+REPLY_TIMEOUT_S = 10.0       # BEGIN of a delta hashes the running image first
+RETRIES = 3
+
+
+def build_frame(frame_type, seq, payload=b""):
+    body = struct.pack("<BH", frame_type, seq) + payload
+    return body + struct.pack("<H", crc16_ccitt(body))
+
+
+class _Matcher:
+    """First offset of every BLOCK-byte window of a buffer"""
+
+    def __init__(self, data, limit=None):
+        self.data = data
+        self.index = {}
+        self.added = 0
+        self.extend(len(data) if limit is None else limit)
+
+    def extend(self, limit):
+        # Windows ending at or before limit
+        for pos in range(self.added, max(self.added, limit - BLOCK + 1)):
+            self.index.setdefault(self.data[pos:pos + BLOCK], pos)
+        self.added = max(self.added, limit - BLOCK + 1)
+
+    def match(self, image, pos, limit):
+        """Longest match of image[pos:] at a stored window, source below limit"""
+        src = self.index.get(image[pos:pos + BLOCK])
+        if src is None:
+            return None, 0
+        length = 0
+        end = min(len(image) - pos, limit - src)
+        while length < end and self.data[src + length] == image[pos + length]:
+            length += 1
+        return src, length
+
+
+def encode_delta(image, base=b""):
+    """Op stream producing image - COPY_BASE from base, COPY_OUT from the
+    image's own prefix (only what the device has already flushed), FILL runs"""
+    ops = []
+    literal = bytearray()
+    base_matcher = _Matcher(base) if base else None
+    out_matcher = _Matcher(image, 0)
+
+    def flush_literal():
+        while literal:
+            part = literal[:LITERAL_MAX]
+            ops.append(struct.pack("<BH", OP_LITERAL, len(part)) + bytes(part))
+            del literal[:LITERAL_MAX]
+
+    pos = 0
+    while pos < len(image):
+        # The device flushes its write buffer in WRITE_BUFFER blocks
+        flushed = pos // WRITE_BUFFER * WRITE_BUFFER
+        out_matcher.extend(flushed)
+
+        run = 1
+        while pos + run < len(image) and image[pos + run] == image[pos]:
+            run += 1
+        best_op, best_src, best_len = None, 0, 0
+        if base_matcher is not None:
+            src, length = base_matcher.match(image, pos, len(base))
+            if length > best_len:
+                best_op, best_src, best_len = OP_COPY_BASE, src, length
+        src, length = out_matcher.match(image, pos, flushed)
+        if length > best_len:
+            best_op, best_src, best_len = OP_COPY_OUT, src, length
+
+        if run >= MIN_FILL and run >= best_len:
+            flush_literal()
+            ops.append(struct.pack("<BIB", OP_FILL, run, image[pos]))
+            pos += run
+        elif best_len >= MIN_COPY:
+            flush_literal()
+            ops.append(struct.pack("<BII", best_op, best_src, best_len))
+            pos += best_len
+        else:
+            literal.append(image[pos])
+            pos += 1
+    flush_literal()
+    return b"".join(ops)
+
+
+def decode_delta(stream, base=b""):
+    """Reference decoder - the firmware's, without the flash"""
+    out = bytearray()
+    i = 0
+    while i < len(stream):
+        op = stream[i]
+        if op == OP_LITERAL:
+            (length,) = struct.unpack_from("<H", stream, i + 1)
+            out += stream[i + 3:i + 3 + length]
+            i += 3 + length
+        elif op == OP_FILL:
+            length, value = struct.unpack_from("<IB", stream, i + 1)
+            out += bytes([value]) * length
+            i += 6
+        elif op in (OP_COPY_BASE, OP_COPY_OUT):
+            src, length = struct.unpack_from("<II", stream, i + 1)
+            if op == OP_COPY_BASE:
+                assert src + length <= len(base)
+                out += base[src:src + length]
+            else:
+                assert src + length <= len(out) // WRITE_BUFFER * WRITE_BUFFER
+                out += out[src:src + length]
+            i += 9
+        else:
+            raise ValueError(f"bad op {op:#x} at {i}")
+    return bytes(out)
+
+
+def load_key(path):
+    from cryptography.hazmat.primitives import serialization
+    with open(path, "rb") as f:
+        return serialization.load_pem_private_key(f.read(), password=None)
+
+
+def sign_image(key, image):
+    """r, s of ECDSA P-256 / SHA-256 over image - what the device checks against the image's digest"""
+    from cryptography.hazmat.primitives import hashes
+    from cryptography.hazmat.primitives.asymmetric import ec
+    from cryptography.hazmat.primitives.asymmetric.utils import decode_dss_signature
+    r, s = decode_dss_signature(key.sign(image, ec.ECDSA(hashes.SHA256())))
+    return r.to_bytes(32, "big") + s.to_bytes(32, "big")
+
+
+def keygen(path, header=KEY_HEADER):
+    """New update key: the private key to path, its public point to the firmware header"""
+    from cryptography.hazmat.primitives import serialization
+    from cryptography.hazmat.primitives.asymmetric import ec
+    if os.path.exists(path):
+        raise RuntimeError(f"{path} exists - updates signed with it would no longer install")
+    key = ec.generate_private_key(ec.SECP256R1())
+    pem = key.private_bytes(serialization.Encoding.PEM, serialization.PrivateFormat.PKCS8,
+                            serialization.NoEncryption())
+    with open(os.open(path, os.O_WRONLY | os.O_CREAT | os.O_EXCL, 0o600), "wb") as f:
+        f.write(pem)
+    point = key.public_key().public_bytes(serialization.Encoding.X962,
+                                          serialization.PublicFormat.UncompressedPoint)
+    rows = ",\n".join("    " + ", ".join(f"0x{b:02X}" for b in point[i:i + 16]) for i in range(0, len(point), 16))
+    with open(header) as f:
+        text = f.read()
+    start = text.index("static const uint8_t otaSigningKey[65] = ")
+    end = text.index(";", start) + 1
+    text = text[:start] + "static const uint8_t otaSigningKey[65] = {\n" + rows + ",\n};" + text[end:]
+    with open(header, "w") as f:
+        f.write(text)
+
+
+def build_update(image, base=None, raw=False, key=None):
+    """BEGIN payload and DATA bytes for image - unsigned (zero signature) without key"""
+    image_sha = hashlib.sha256(image).digest()
+    signature = sign_image(key, image) if key is not None else bytes(SIGNATURE_SIZE)
+    if raw:
+        begin = (struct.pack("<IB", len(image), ENCODING_RAW) + image_sha + struct.pack("<I", 0) + bytes(32)
+                 + signature)
+        return begin, image
+    base = base or b""
+    stream = encode_delta(image, base)
+    if decode_delta(stream, base) != image:
+        raise RuntimeError("delta encoder self-check failed")
+    base_sha = hashlib.sha256(base).digest() if base else bytes(32)
+    # The signature is of the image, so the same one holds for any delta of it
+    begin = (struct.pack("<IB", len(image), ENCODING_DELTA) + image_sha + struct.pack("<I", len(base)) + base_sha
+             + signature)
+    return begin, stream
+
+
+class Uploader:
+    def __init__(self, client):
+        self.client = client
+        self.replies = asyncio.Queue()
+
+    def on_notify(self, _sender, data):
+        text = bytes(data).decode(errors="replace")
+        if text.startswith("OTA_ACK:") or text.startswith("ERROR:"):
+            self.replies.put_nowait(text)
+
+    async def send(self, frame_type, seq, payload=b""):
+        """Send one frame and wait for its OTA_ACK - retried on timeout"""
+        frame = build_frame(frame_type, seq, payload)
+        for _ in range(RETRIES):
+            await self.client.write_gatt_char(OTA_UUID, frame, response=True)
+            try:
+                reply = await asyncio.wait_for(self.replies.get(), REPLY_TIMEOUT_S)
+            except asyncio.TimeoutError:
+                continue
+            if reply == f"OTA_ACK:{seq}":
+                return
+            raise RuntimeError(reply)
+        raise RuntimeError(f"no reply to frame {seq}")
+
+    async def upload(self, begin, data):
+        await self.client.start_notify(TX_UUID, self.on_notify)
+        try:
+            await self.send(FRAME_BEGIN, 0, begin)
+            chunks = [data[i:i + CHUNK_SIZE] for i in range(0, len(data), CHUNK_SIZE)]
+            for seq, chunk in enumerate(chunks):
+                await self.send(FRAME_DATA, seq, chunk)
+                print(f"\r  {min((seq + 1) * CHUNK_SIZE, len(data))}/{len(data)} bytes", end="")
+            print()
+            await self.send(FRAME_END, len(chunks))
+        except Exception:
+            await self.client.write_gatt_char(OTA_UUID, build_frame(FRAME_ABORT, 0), response=True)
+            raise
+        finally:
+            await self.client.stop_notify(TX_UUID)
+
+
+async def run(args, begin, data):
+    from bleak import BleakClient, BleakScanner
+
+    address = args.address
+    if address is None:
+        print(f"Scanning for '{DEVICE_NAME}'...")
+        device = await BleakScanner.find_device_by_name(DEVICE_NAME, timeout=10.0)
+        if device is None:
+            sys.exit(f"ERROR: '{DEVICE_NAME}' not found")
+        address = device.address
+
+    async with BleakClient(address) as client:
+        print(f"Connected to {address}, sending {len(data)} bytes")
+        # The OTA characteristic needs a bonded link - pairs with the device's passkey the first time
+        try:
+            await client.pair()
+        except NotImplementedError:
+            pass        # CoreBluetooth pairs by itself on the first refused write
+        await Uploader(client).upload(begin, data)
+    print("✓ Firmware written - the device reboots into it and confirms it after its self-test")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Update BioPal firmware over BLE")
+    parser.add_argument("--image", help="New firmware.bin")
+    parser.add_argument("--base", help="firmware.bin the device runs now - send a delta against it")
+    parser.add_argument("--raw", action="store_true", help="Send the image as it is (no delta / compression)")
+    parser.add_argument("--address", help="BLE address (default: scan for BioPal)")
+    parser.add_argument("--key", default=DEFAULT_KEY, help=f"Update signing key (default: {DEFAULT_KEY})")
+    parser.add_argument("--keygen", metavar="PEM", help="Make a new signing key and write its public half "
+                                                        "to include/ota_signing_key.h")
+    parser.add_argument("--dry-run", action="store_true", help="Only build and check the update, print its size")
+    args = parser.parse_args()
+
+    if args.keygen:
+        try:
+            keygen(args.keygen)
+        except RuntimeError as e:
+            sys.exit(f"✗ {e}")
+        print(f"✓ Private key in {args.keygen} - keep it out of the repository")
+        print(f"✓ Public key in {KEY_HEADER} - flash a build with it over USB before the first update")
+        return
+    if not args.image:
+        parser.error("--image is required")
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    base = None
+    if args.base:
+        with open(args.base, "rb") as f:
+            base = f.read()
+
+    key = None
+    if os.path.exists(args.key):
+        key = load_key(args.key)
+    elif not args.dry_run:
+        sys.exit(f"✗ No signing key {args.key} - the device refuses unsigned updates (--keygen makes one)")
+
+    try:
+        begin, data = build_update(image, base, args.raw, key)
+    except RuntimeError as e:
+        sys.exit(f"✗ {e}")
+    kind = "raw" if args.raw else ("delta" if base else "compressed")
+    print(f"Image {len(image)} bytes, {kind} update {len(data)} bytes ({100.0 * len(data) / len(image):.1f}%)"
+          f"{'' if key else ', unsigned'}")
+    if args.dry_run:
+        return
+
+    try:
+        asyncio.run(run(args, begin, data))
+    except RuntimeError as e:
+        sys.exit(f"✗ Update failed: {e}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""
+BioPal Sampling Profile Report
+Fetches the ESP32 profiler ring ("prof dump" serial command, filled while
+"prof start" runs) and resolves the sampled PCs against the firmware ELF with
+addr2line: a flat profile per function, and per task with its top functions.
+
+Usage:
+  python profile_report.py --port /dev/ttyACM0 --elf .pio/build/esp32-c6-devkitc-1/firmware.elf
+  python profile_report.py --port COM5 --save prof.bin --elf firmware.elf   # also keep the raw dump
+  python profile_report.py --file prof.bin --elf firmware.elf --top 40      # report a saved dump
+
+The ELF must be the build that is running on the board.
+"""
+
+import argparse
+import os
+import shutil
+import struct
+import subprocess
+import sys
+from collections import Counter
+
+# Must match ProfileSample in include/profiler.h
+FORMAT_VERSION = 1
+RECORD_FORMAT = "<II"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+ADDR2LINE = "riscv32-esp-elf-addr2line"
+BUNDLED_ADDR2LINE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                 "toolchain-riscv32-esp", "bin", ADDR2LINE)
+
+
+def extract_dump(data):
+    """Find PROF_BEGIN in a byte stream and return (samples, rate_hz, task names by handle)"""
+    start = data.find(b"PROF_BEGIN ")
+    if start < 0:
+        raise ValueError("No PROF_BEGIN marker found")
+
+    header_end = data.index(b"\n", start)
+    fields = data[start:header_end].split()
+    version, count, record_size, rate_hz = (int(f) for f in fields[1:5])
+    if version != FORMAT_VERSION or record_size != RECORD_SIZE:
+        raise ValueError(f"Unsupported profile format (version {version}, record size {record_size})")
+
+    payload_end = header_end + 1 + count * RECORD_SIZE
+    if payload_end > len(data):
+        raise ValueError(f"Truncated dump: expected {count} samples")
+    samples = [struct.unpack_from(RECORD_FORMAT, data, header_end + 1 + i * RECORD_SIZE) for i in range(count)]
+
+    tasks = {}
+    end = data.find(b"PROF_END", payload_end)
+    for line in data[payload_end:end if end >= 0 else len(data)].split(b"\n"):
+        if line.startswith(b"PROF_TASK "):
+            parts = line.rstrip(b"\r").split(b" ", 2)
+            tasks[int(parts[1], 16)] = parts[2].decode(errors="replace") if len(parts) > 2 else "?"
+    return samples, rate_hz, tasks
+
+
+def read_from_device(port, baud_rate=115200, timeout=5.0):
+    """Send 'prof dump' and capture everything up to PROF_END"""
+    import serial
+
+    with serial.Serial(port, baud_rate, timeout=timeout) as ser:
+        ser.reset_input_buffer()
+        ser.write(b"prof dump\n")
+
+        data = b""
+        while b"PROF_END" not in data:
+            chunk = ser.read(4096)
+            if not chunk:
+                raise TimeoutError("Timed out waiting for PROF_END")
+            data += chunk
+    return data
+
+
+def resolve(elf, addr2line, pcs):
+    """Map each PC to (function, file:line) with one addr2line run"""
+    pcs = sorted(pcs)
+    if not pcs:
+        return {}
+    out = subprocess.run([addr2line, "-e", elf, "-f", "-C", "-s"] + [f"0x{pc:08x}" for pc in pcs],
+                         capture_output=True, text=True, check=True).stdout.splitlines()
+    names = {}
+    for i, pc in enumerate(pcs):
+        function, location = out[2 * i], out[2 * i + 1]
+        names[pc] = (f"0x{pc:08x}" if function == "??" else function, location)
+    return names
+
+
+def print_report(samples, rate_hz, tasks, names, top):
+    total = len(samples)
+    if total == 0:
+        print("No samples - run 'prof start' first")
+        return
+    print(f"{total} samples at {rate_hz} Hz ({total / max(rate_hz, 1):.1f} s)")
+
+    by_function = Counter(names[pc][0] for pc, _ in samples)
+    print(f"\n=== Functions (top {top}) ===")
+    print(f"{'%':>6} {'samples':>8}  function")
+    for function, n in by_function.most_common(top):
+        print(f"{100.0 * n / total:6.1f} {n:8d}  {function}")
+
+    by_task = Counter(task for _, task in samples)
+    print("\n=== Tasks ===")
+    for task, n in by_task.most_common():
+        name = tasks.get(task, f"task 0x{task:08X} (ended)")
+        print(f"{100.0 * n / total:6.1f} {n:8d}  {name}")
+        functions = Counter(names[pc][0] for pc, t in samples if t == task)
+        for function, fn in functions.most_common(3):
+            print(f"{'':17}{100.0 * fn / n:5.1f}%  {function}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the BioPal ESP32 sampling profile")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="Serial port of the ESP32")
+    source.add_argument("--file", help="Saved raw dump (output of --save)")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("--save", help="Write the raw dump to this file")
+    parser.add_argument("--elf", required=True, help="Firmware ELF of the running build")
+    parser.add_argument("--addr2line", help=f"addr2line to use (default: bundled toolchain or {ADDR2LINE})")
+    parser.add_argument("--top", type=int, default=25, help="Functions to list")
+    args = parser.parse_args()
+
+    addr2line = args.addr2line or (BUNDLED_ADDR2LINE if os.path.exists(BUNDLED_ADDR2LINE)
+                                   else shutil.which(ADDR2LINE))
+    if addr2line is None:
+        print(f"ERROR: {ADDR2LINE} not found - pass --addr2line")
+        sys.exit(1)
+
+    try:
+        if args.port:
+            data = read_from_device(args.port, args.baud)
+        else:
+            with open(args.file, "rb") as f:
+                data = f.read()
+
+        if args.save:
+            with open(args.save, "wb") as f:
+                f.write(data)
+
+        samples, rate_hz, tasks = extract_dump(data)
+        names = resolve(args.elf, addr2line, {pc for pc, _ in samples})
+    except (ValueError, TimeoutError, OSError, subprocess.CalledProcessError) as e:
+        print(f"ERROR: {e}")
+        sys.exit(1)
+
+    print_report(samples, rate_hz, tasks, names, args.top)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+BioPal Raw Capture Decoder
+Fetches the ESP32 raw capture ring ("raw dump" serial command, filled while
+"raw on" is set) and writes the uncalibrated STM32 points as CSV, so
+calibration can be re-run offline on the same sweep data.
+
+Usage:
+  python raw_capture_decode.py --port /dev/ttyACM0 --csv raw.csv   # request dump from device
+  python raw_capture_decode.py --port COM5 --save dump.bin          # also keep the raw dump
+  python raw_capture_decode.py --file dump.bin --csv raw.csv        # decode saved dump
+"""
+
+import argparse
+import struct
+import sys
+
+from usb_export_decode import crc16_ccitt
+
+# Must match RawCaptureRecord in include/raw_capture.h
+FORMAT_VERSION = 1
+RECORD_FORMAT = "<IfffBBBB"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+# Must match include/defines.h
+FLAG_VALID = 0x80
+FLAG_TIA_HIGH = 0x08
+FLAG_PGA_MASK = 0x07
+
+SWEEP_NAMES = ("baseline", "final")
+CSV_HEADER = "DUT,Sweep,Frequency_Hz,Freq_Index,V_Magnitude,I_Magnitude,Phase_Deg,PGA Gain, TIA Gain,Valid,Z_Uncalibrated_Ohms"
+
+
+def extract_dump(data):
+    """Find the RAW_BEGIN header in a byte stream and return (records bytes, count)"""
+    start = data.find(b"RAW_BEGIN ")
+    if start < 0:
+        raise ValueError("No RAW_BEGIN marker found")
+
+    header_end = data.index(b"\n", start)
+    fields = data[start:header_end].split()
+    version, count, record_size = int(fields[1]), int(fields[2]), int(fields[3])
+    if version != FORMAT_VERSION or record_size != RECORD_SIZE:
+        raise ValueError(f"Unsupported raw capture format (version {version}, record size {record_size})")
+
+    payload = data[header_end + 1:header_end + 1 + count * RECORD_SIZE]
+    if len(payload) < count * RECORD_SIZE:
+        raise ValueError(f"Truncated dump: expected {count} records")
+
+    end = data.find(b"RAW_END ", header_end + 1 + len(payload))
+    if end >= 0:
+        crc = int(data[end + 8:data.index(b"\n", end)], 16)
+        if crc != crc16_ccitt(payload):
+            raise ValueError("Dump CRC mismatch - log output mixed into the records?")
+    return payload, count
+
+
+def read_from_device(port, baud_rate=115200, timeout=5.0):
+    """Send 'raw dump' and capture everything up to the RAW_END line"""
+    import serial
+
+    with serial.Serial(port, baud_rate, timeout=timeout) as ser:
+        ser.reset_input_buffer()
+        ser.write(b"raw dump\n")
+
+        data = b""
+        while True:
+            end = data.find(b"RAW_END ")
+            if end >= 0 and b"\n" in data[end:]:
+                break
+            chunk = ser.read(4096)
+            if not chunk:
+                raise TimeoutError("Timed out waiting for RAW_END")
+            data += chunk
+    return data
+
+
+def decode(payload, count):
+    """Yield one dict per captured point, oldest first"""
+    for i in range(count):
+        freq, v_mag, i_mag, phase, dut, flags, freq_idx, sweep = struct.unpack_from(
+            RECORD_FORMAT, payload, i * RECORD_SIZE)
+        yield {"dut": dut, "sweep": SWEEP_NAMES[sweep & 1], "frequency": freq, "freq_idx": freq_idx,
+               "v_mag": v_mag, "i_mag": i_mag, "phase": phase, "pga_gain": flags & FLAG_PGA_MASK,
+               "tia_gain": int(bool(flags & FLAG_TIA_HIGH)), "valid": bool(flags & FLAG_VALID)}
+
+
+def to_csv_lines(points):
+    """CSV lines (header first) - the last column is V/I as calcImpedance() computes it"""
+    lines = [CSV_HEADER]
+    for p in points:
+        z = p["v_mag"] / p["i_mag"] if p["i_mag"] > 0 else 0.0
+        lines.append(f"{p['dut']},{p['sweep']},{p['frequency']},{p['freq_idx']},{p['v_mag']:.6g},"
+                     f"{p['i_mag']:.6g},{p['phase']:.2f},{p['pga_gain']},{p['tia_gain']},"
+                     f"{int(p['valid'])},{z:.6f}")
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the BioPal raw capture ring")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="Serial port of the ESP32")
+    source.add_argument("--file", help="Saved raw dump (output of --save)")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("--save", help="Write the raw dump to this file")
+    parser.add_argument("--csv", help="Write the points to this CSV file (default: stdout)")
+    args = parser.parse_args()
+
+    try:
+        if args.port:
+            data = read_from_device(args.port, args.baud)
+        else:
+            with open(args.file, "rb") as f:
+                data = f.read()
+
+        if args.save:
+            with open(args.save, "wb") as f:
+                f.write(data)
+
+        payload, count = extract_dump(data)
+    except (ValueError, TimeoutError, OSError) as e:
+        print(f"ERROR: {e}")
+        sys.exit(1)
+
+    lines = to_csv_lines(decode(payload, count))
+    if args.csv:
+        with open(args.csv, "w") as f:
+            f.write("\n".join(lines) + "\n")
+        print(f"Wrote {count} points to {args.csv}", file=sys.stderr)
+    else:
+        print("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""
+BioPal Screen Mirror Viewer
+Switches on the ESP32's screen mirror ("mirror usb" serial command) and
+rebuilds the 320x240 panel from the changed tiles it sends. Log text between
+frames is passed through. BLE and Wi-Fi clients get the same packets
+(binary notifications / WebSocket frames of type 0x05) and can use
+MirrorImage below as it is.
+
+Usage:
+  python screen_mirror_view.py --port /dev/ttyACM0                  # live window
+  python screen_mirror_view.py --port COM5 --snapshot screen.ppm    # rewrite a PPM per frame
+"""
+
+import argparse
+import struct
+import sys
+
+from usb_export_decode import cobs_decode, crc16_ccitt
+
+# Must match include/screen_mirror.h, include/usb_export.h and include/BLE_Functions.h
+SCREEN_WIDTH = 320
+SCREEN_HEIGHT = 240
+FRAME_MIRROR = 0x04
+BIN_MAGIC = 0xB1
+BIN_TYPE_MIRROR = 0x05
+FLAG_END = 0x01
+HEADER_FORMAT = "<BBBBBB"
+TILE_FORMAT = "<HHBBH"
+
+
+class MirrorImage:
+    """The panel as RGB888, updated by mirror packets"""
+
+    def __init__(self):
+        self.pixels = bytearray(SCREEN_WIDTH * SCREEN_HEIGHT * 3)
+        self.frames = 0
+
+    def apply(self, packet):
+        """Paste the tiles of one packet; True if it ended a frame"""
+        magic, ptype, _frame, flags, _part, tiles = struct.unpack_from(HEADER_FORMAT, packet)
+        if magic != BIN_MAGIC or ptype != BIN_TYPE_MIRROR:
+            return False
+        offset = struct.calcsize(HEADER_FORMAT)
+        for _ in range(tiles):
+            x, y, w, h, size = struct.unpack_from(TILE_FORMAT, packet, offset)
+            offset += struct.calcsize(TILE_FORMAT)
+            self.paste(x, y, w, h, packet[offset:offset + size])
+            offset += size
+        if flags & FLAG_END:
+            self.frames += 1
+            return True
+        return False
+
+    def paste(self, x, y, w, h, rle):
+        i = 0
+        for row in range(h):
+            col = 0
+            while col < w and i < len(rle):
+                count = rle[i]
+                n = (count & 0x7F) + 1
+                i += 1
+                if count & 0x80:
+                    values = [rle[i:i + 2]] * n
+                    i += 2
+                else:
+                    values = [rle[i + 2 * k:i + 2 * k + 2] for k in range(n)]
+                    i += 2 * n
+                for value in values:
+                    self.put(x + col, y + row, (value[0] << 8) | value[1])
+                    col += 1
+
+    def put(self, x, y, rgb565):
+        if x >= SCREEN_WIDTH or y >= SCREEN_HEIGHT:
+            return
+        o = (y * SCREEN_WIDTH + x) * 3
+        r = (rgb565 >> 11) & 0x1F
+        g = (rgb565 >> 5) & 0x3F
+        b = rgb565 & 0x1F
+        self.pixels[o:o + 3] = bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)))
+
+    def save_ppm(self, path):
+        with open(path, "wb") as f:
+            f.write(b"P6\n%d %d\n255\n" % (SCREEN_WIDTH, SCREEN_HEIGHT))
+            f.write(self.pixels)
+
+
+class MirrorStream:
+    """Splits a serial byte stream into mirror packets and log text"""
+
+    def __init__(self, image, on_text=None):
+        self.image = image
+        self.on_text = on_text or (lambda text: sys.stdout.write(text))
+        self.pending = bytearray()
+
+    def feed(self, data):
+        """Process received bytes; returns the frames completed by them"""
+        self.pending += data
+        frames = 0
+        while True:
+            i = self.pending.find(0)
+            if i < 0:
+                break
+            block = bytes(self.pending[:i])
+            del self.pending[:i + 1]
+            frame = cobs_decode(block) if block else None
+            if (frame is not None and len(frame) >= 3 and frame[0] == FRAME_MIRROR and
+                    crc16_ccitt(frame[:-2]) == struct.unpack("<H", frame[-2:])[0]):
+                frames += self.image.apply(frame[1:-2])
+            elif block:
+                self.on_text(block.decode("utf-8", errors="replace"))
+        return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Show the BioPal screen mirror")
+    parser.add_argument("--port", required=True, help="Serial port of the board")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--snapshot", help="Write the screen to this PPM after every frame (no window)")
+    args = parser.parse_args()
+
+    import serial
+
+    image = MirrorImage()
+    stream = MirrorStream(image)
+    window = None
+    if not args.snapshot:
+        import matplotlib.pyplot as plt
+        import numpy as np
+        plt.ion()
+        figure, axes = plt.subplots()
+        axes.set_axis_off()
+        window = axes.imshow(np.zeros((SCREEN_HEIGHT, SCREEN_WIDTH, 3), dtype=np.uint8))
+
+    with serial.Serial(args.port, args.baud, timeout=0.05) as ser:
+        ser.write(b"mirror usb\n")
+        try:
+            while True:
+                if stream.feed(ser.read(8192)) == 0:
+                    if window is not None:
+                        plt.pause(0.01)
+                    continue
+                if args.snapshot:
+                    image.save_ppm(args.snapshot)
+                else:
+                    window.set_data(np.frombuffer(bytes(image.pixels), dtype=np.uint8)
+                                    .reshape(SCREEN_HEIGHT, SCREEN_WIDTH, 3))
+                    figure.canvas.draw_idle()
+                    plt.pause(0.001)
+        except KeyboardInterrupt:
+            pass
+        finally:
+            ser.write(b"mirror off\n")
+    print(f"\n{image.frames} frames", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,82 +1,962 @@
 #include "BLE_Functions.h"
+#include "console.h"
 #include "defines.h"           // << add to access global calc/risk vars
-#include <ArduinoJson.h>
+#include "trace.h"
+#include "sweep_stats.h"
+#include "heap_stats.h"
+#include "cal_upload.h"
+#include "ota_update.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "meas_control.h"
+#include "repeat_filter.h"
+#include "session_log.h"
+#include "history_download.h"
+#include "UART_Functions.h"
+#include "counters.h"
+#include "gui_state.h"
+#include "wifi_server.h"
+#include "impedance_calc.h"
+#include "spectral_metrics.h"
+#include "fixed_format.h"
+#include "esp_system.h"
 
 /*=========================GLOBAL BLE OBJECTS=========================*/
 static BLEServer* pServer = nullptr;
+static bool advertisingSlow = false;
 static BLECharacteristic* pTxCharacteristic = nullptr;
 static BLECharacteristic* pRxCharacteristic = nullptr;
+static BLECharacteristic* pCalCharacteristic = nullptr;
+static BLECharacteristic* pOTACharacteristic = nullptr;
+static BLECharacteristic* pHistCtrlCharacteristic = nullptr;
+static BLECharacteristic* pHistDataCharacteristic = nullptr;
 
 // Connection state tracking
-static bool deviceConnected = false;
-static bool oldDeviceConnected = false;
 static bool connectionChanged = false;
 
-// Command buffer
-static String receivedCommand = "";
-static bool commandReady = false;
+// Negotiated per connection
+#define BLE_DEFAULT_MTU     23
+#define BLE_MAX_PAYLOAD     512         // Attribute value limit
+
+// TX queue targets - subscription bits of a client
+#define BLE_TX_CHANNEL_DATA     0   // TX characteristic
+#define BLE_TX_CHANNEL_HISTORY  1   // History data characteristic
+
+// One connected client - written by the BTC task callbacks
+struct BLEClientSlot {
+    volatile bool active;
+    uint16_t connId;
+    esp_bd_addr_t address;
+    volatile uint16_t mtu;
+    volatile uint8_t subscribed;    // 1 << BLE_TX_CHANNEL_* with notifications enabled
+    bool binaryData;                // FORMAT:BIN - DATA as binary notifications
+    bool streaming;                 // STREAM:1 - live point notifications
+    bool framedText;                // FRAMING:1 - text chunks carry a BLETextChunkHeader
+    volatile bool congested;
+    volatile uint8_t inFlight;      // Credits held by unconfirmed notifications
+    bool linkFast;
+    bool linkManaged;               // FLEET_LINK - the central sets the interval
+    uint32_t lastTxMs;
+    volatile int8_t rssi;           // Last read (dBm), 0 = none yet
+    uint32_t resumeToken;           // RESUME token of this connection
+    volatile bool bonded;           // Encrypted with a bonded, MITM-protected key
+};
+static BLEClientSlot clients[BLE_MAX_CLIENTS];
+static int8_t commandClient = BLE_NO_CLIENT;            // Sender of the command being processed
+static volatile int8_t historyClient = BLE_NO_CLIENT;   // Sender of the last history request
+
+// CCCDs - their writes are tracked per connection
+static BLE2902* pTxCccd = nullptr;
+static BLE2902* pHistCccd = nullptr;
+
+// Received commands - single-producer (BLE callback) / single-consumer (GUI
+// task) ring: the producer only writes head, the consumer only tail, and a
+// slot is published by advancing head after it is filled
+struct BLECommandSlot {
+    uint8_t length;
+    uint16_t connId;
+    char text[BLE_CMD_MAX_LEN];
+};
+static BLECommandSlot commandRing[BLE_CMD_RING_SLOTS];
+static volatile uint8_t commandHead = 0;
+static volatile uint8_t commandTail = 0;
+static volatile uint32_t commandDrops = 0;
+
+
+/*=========================CLIENTS=========================*/
+static int findClient(uint16_t connId) {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (clients[i].active && clients[i].connId == connId) {
+            return i;
+        }
+    }
+    return BLE_NO_CLIENT;
+}
+
+static size_t clientPayloadSize(const BLEClientSlot& client) {
+    return min((size_t)client.mtu - 3, (size_t)BLE_MAX_PAYLOAD);
+}
+
+// Clients subscribed to channel; binary / streaming: -1 = either, else must match
+static uint8_t selectClients(uint8_t channel, int binary = -1, int streaming = -1) {
+    uint8_t mask = 0;
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        const BLEClientSlot& client = clients[i];
+        if (!client.active || !(client.subscribed & (1 << channel))) {
+            continue;
+        }
+        if ((binary >= 0 && client.binaryData != (bool)binary) ||
+            (streaming >= 0 && client.streaming != (bool)streaming)) {
+            continue;
+        }
+        mask |= 1 << i;
+    }
+    return mask;
+}
+
+// Smallest / largest payload among the clients of mask, 0 if none
+static size_t maskPayloadSize(uint8_t mask, bool largest) {
+    size_t size = 0;
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if ((mask & (1 << i)) && clients[i].active) {
+            size_t clientSize = clientPayloadSize(clients[i]);
+            if (size == 0 || (largest ? clientSize > size : clientSize < size)) {
+                size = clientSize;
+            }
+        }
+    }
+    return size;
+}
+
+static void updateLiveBatchHandover() {
+    setLiveBatchHandover(anyBLEClientStreaming() || getWiFiLiveClients() > 0);
+}
+
+/*=========================LINK PARAMETERS=========================*/
+static void requestLinkParams(BLEClientSlot& client, bool fast) {
+    client.linkFast = fast;
+    if (client.linkManaged) {
+        return;
+    }
+    heapStatsEnterFramework();
+    if (fast) {
+        pServer->updateConnParams(client.address, BLE_CONN_FAST_MIN_INT, BLE_CONN_FAST_MAX_INT, 0, BLE_CONN_TIMEOUT);
+    } else {
+        pServer->updateConnParams(client.address, BLE_CONN_IDLE_MIN_INT, BLE_CONN_IDLE_MAX_INT,
+                                  BLE_CONN_IDLE_LATENCY, BLE_CONN_TIMEOUT);
+    }
+    heapStatsExitFramework();
+    HAL_PRINTF("[BLE] Requested %s connection parameters for client %d\n", fast ? "fast" : "idle", client.connId);
+}
+
+// New connection: longest packets, 2M PHY where supported, short interval
+static void setupLink(BLEClientSlot& client) {
+    if (esp_ble_gap_set_pkt_data_len(client.address, BLE_DATA_LEN) != ESP_OK) {
+        Console.println("[BLE] WARNING: Data length extension request failed");
+    }
+#if CONFIG_BT_BLE_50_FEATURES_SUPPORTED
+    if (esp_ble_gap_set_preferred_phy(client.address, 0, ESP_BLE_GAP_PHY_2M_PREF_MASK, ESP_BLE_GAP_PHY_2M_PREF_MASK,
+                                      ESP_BLE_GAP_PHY_OPTIONS_NO_PREF) != ESP_OK) {
+        Console.println("[BLE] WARNING: 2M PHY request failed");
+    }
+#endif
+    requestLinkParams(client, true);
+    client.lastTxMs = millis();
+}
 
-extern void drawConnectionIndicatorDefault(bool connected);
+/*=========================TX POWER=========================*/
+static const esp_power_level_t txPowerLevels[] = BLE_TX_POWER_LEVELS;
+static const int8_t txPowerDbm[] = BLE_TX_POWER_DBM;
+#define TX_POWER_LEVEL_COUNT    (int)(sizeof(txPowerLevels) / sizeof(txPowerLevels[0]))
+static_assert(sizeof(txPowerDbm) == TX_POWER_LEVEL_COUNT, "one dBm value per TX power level");
 
+static uint8_t txPowerStep = 0;         // txPowerLevels[] index - BLE TX task
+static uint32_t txPowerChanges = 0;
+static uint32_t lastRssiPollMs = 0;
+
+static void setTxPowerStep(uint8_t step) {
+    if (step == txPowerStep) {
+        return;
+    }
+    txPowerStep = step;
+    txPowerChanges++;
+    esp_ble_tx_power_set(ESP_BLE_PWR_TYPE_DEFAULT, txPowerLevels[step]);
+    HAL_PRINTF("[BLE] Connection TX power %d dBm\n", txPowerDbm[step]);
+}
+
+// RSSI replies of esp_ble_gap_read_rssi() (BTC task)
+static void onGapEvent(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t* param) {
+    if (event != ESP_GAP_BLE_READ_RSSI_COMPLETE_EVT || param->read_rssi_cmpl.status != ESP_BT_STATUS_SUCCESS) {
+        return;
+    }
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (clients[i].active && memcmp(clients[i].address, param->read_rssi_cmpl.remote_addr,
+                                        sizeof(esp_bd_addr_t)) == 0) {
+            clients[i].rssi = param->read_rssi_cmpl.rssi;
+        }
+    }
+}
+
+// One step per poll on the replies to the previous poll's reads
+static void adaptTxPower() {
+    uint32_t now = millis();
+    if (now - lastRssiPollMs < BLE_RSSI_POLL_MS) {
+        return;
+    }
+    lastRssiPollMs = now;
+
+    bool anyClient = false;
+    int weakest = 0;
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        BLEClientSlot& client = clients[i];
+        if (!client.active) {
+            continue;
+        }
+        anyClient = true;
+        if (!client.linkFast) {
+            continue;
+        }
+        if (client.rssi != 0 && (weakest == 0 || client.rssi < weakest)) {
+            weakest = client.rssi;
+        }
+        esp_ble_gap_read_rssi(client.address);
+    }
+
+    if (!anyClient) {
+        setTxPowerStep(0);
+    } else if (weakest != 0 && weakest < BLE_RSSI_WEAK_DBM && txPowerStep + 1 < TX_POWER_LEVEL_COUNT) {
+        setTxPowerStep(txPowerStep + 1);
+    } else if (weakest != 0 && weakest > BLE_RSSI_STRONG_DBM && txPowerStep > 0) {
+        setTxPowerStep(txPowerStep - 1);
+    }
+}
+
+void printBLELinkStatus() {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        const BLEClientSlot& client = clients[i];
+        if (client.active) {
+            Console.printf("BLE client %d: RSSI %d dBm, %s link, MTU %u\n", client.connId, client.rssi,
+                          client.linkManaged ? "managed" : client.linkFast ? "fast" : "idle", client.mtu);
+        }
+    }
+    Console.printf("BLE TX power: %d dBm (%lu changes), %s advertising\n", txPowerDbm[txPowerStep],
+                  (unsigned long)txPowerChanges, advertisingSlow ? "slow" : "fast");
+}
+
+/*=========================TX PIPELINE=========================*/
+// Queued chunk: header + up to one notification payload
+struct __attribute__((packed)) BLETxChunkHeader {
+    uint16_t messageBytes;  // Whole message (trace)
+    uint16_t chunks;        // Chunks of the message
+    uint16_t chunk;         // This chunk (0-based)
+    uint8_t channel;        // BLE_TX_CHANNEL_*
+    uint8_t clients;        // Receivers, 1 << client slot
+    uint8_t flags;          // BLE_TX_FLAG_*
+};
+
+static MessageBufferHandle_t txBuffer = nullptr;
+static SemaphoreHandle_t txMutex = nullptr;     // Keeps a message's chunks back to back
+static SemaphoreHandle_t txCredits = nullptr;   // Notifications handed to the stack, not yet confirmed
+static uint8_t txBufferStorage[BLE_TX_BUFFER_BYTES + 1];   // A message buffer keeps one byte free
+static StaticMessageBuffer_t txBufferControl;
+static StaticSemaphore_t txMutexControl;
+static StaticSemaphore_t txCreditsControl;
+static uint32_t txConfirmTimeouts = 0;
+static BLETxCounters txCounters = {};
+
+static void giveBLETxCredits(BLEClientSlot& client) {
+    while (client.inFlight > 0) {
+        client.inFlight = client.inFlight - 1;
+        xSemaphoreGive(txCredits);
+    }
+}
+
+// Stack events the Arduino callbacks do not surface (BTC task)
+static void onGattsEvent(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t* param) {
+    int slot;
+    switch (event) {
+        case ESP_GATTS_CONF_EVT:
+            // Notification sent - its credit is free again
+            slot = findClient(param->conf.conn_id);
+            if (slot != BLE_NO_CLIENT && clients[slot].inFlight > 0) {
+                clients[slot].inFlight = clients[slot].inFlight - 1;
+            }
+            xSemaphoreGive(txCredits);
+            break;
+        case ESP_GATTS_CONGEST_EVT:
+            if (param->congest.congested) {
+                txCounters.congestEvents++;
+            }
+            slot = findClient(param->congest.conn_id);
+            if (slot != BLE_NO_CLIENT) {
+                clients[slot].congested = param->congest.congested;
+            }
+            break;
+        case ESP_GATTS_WRITE_EVT:
+            // Subscriptions - the Arduino descriptor keeps only one value for all connections
+            slot = findClient(param->write.conn_id);
+            if (slot != BLE_NO_CLIENT && param->write.len >= 1) {
+                uint8_t channel;
+                if (pTxCccd != nullptr && param->write.handle == pTxCccd->getHandle()) {
+                    channel = BLE_TX_CHANNEL_DATA;
+                } else if (pHistCccd != nullptr && param->write.handle == pHistCccd->getHandle()) {
+                    channel = BLE_TX_CHANNEL_HISTORY;
+                } else {
+                    break;
+                }
+                if (param->write.value[0] & 0x01) {
+                    clients[slot].subscribed = clients[slot].subscribed | (1 << channel);
+                } else {
+                    clients[slot].subscribed = clients[slot].subscribed & ~(1 << channel);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void initBLETx() {
+    if (txBuffer == nullptr) {
+        txBuffer = xMessageBufferCreateStatic(BLE_TX_BUFFER_BYTES, txBufferStorage, &txBufferControl);
+        txMutex = xSemaphoreCreateMutexStatic(&txMutexControl);
+        txCredits = xSemaphoreCreateCountingStatic(BLE_TX_CREDITS, BLE_TX_CREDITS, &txCreditsControl);
+    }
+    BLEDevice::setCustomGattsHandler(onGattsEvent);
+    BLEDevice::setCustomGapHandler(onGapEvent);
+}
+
+// Copy a message for the clients of mask into the TX buffer as chunks of at
+// most chunkSize (the TX task splits them further for smaller MTUs)
+// wait: max wait for buffer space per chunk
+static bool queueBLEMessage(const uint8_t* data, size_t len, uint8_t channel, uint8_t mask, size_t chunkSize,
+                            TickType_t wait = pdMS_TO_TICKS(BLE_TX_QUEUE_WAIT_MS), uint8_t flags = 0) {
+    if (txBuffer == nullptr) {
+        return false;
+    }
+    if (mask == 0 || chunkSize == 0) {
+        return true;  // Nobody subscribed to this message
+    }
+    static uint8_t item[sizeof(BLETxChunkHeader) + BLE_MAX_PAYLOAD];
+    BLETxChunkHeader* header = (BLETxChunkHeader*)item;
+
+    xSemaphoreTake(txMutex, portMAX_DELAY);
+    header->messageBytes = len;
+    header->chunks = (len + chunkSize - 1) / chunkSize;
+    header->channel = channel;
+    header->clients = mask;
+    header->flags = flags;
+    bool ok = true;
+    for (size_t offset = 0; offset < len && ok; offset += chunkSize) {
+        size_t n = min(chunkSize, len - offset);
+        header->chunk = offset / chunkSize;
+        memcpy(item + sizeof(BLETxChunkHeader), data + offset, n);
+        ok = xMessageBufferSend(txBuffer, item, sizeof(BLETxChunkHeader) + n, wait) > 0;
+    }
+    xSemaphoreGive(txMutex);
+
+    if (!ok) {
+        HAL_PRINTF("[BLE] ERROR: TX buffer full - %d byte message truncated\n", len);
+    }
+    return ok;
+}
+
+/*=========================FRAMED TEXT=========================*/
+// A framed message kept for RESEND - its bytes in retainArena
+struct RetainedMessage {
+    bool valid;
+    uint8_t id;
+    uint16_t start;
+    uint16_t length;
+    uint16_t chunkSize;     // Text bytes per chunk, without the chunk header
+    uint8_t clients;        // Client slots it was queued for
+};
+
+// All under txMutex
+static uint8_t retainArena[BLE_CHUNK_RETAIN_BYTES];
+static RetainedMessage retained[BLE_CHUNK_RETAIN_MESSAGES];
+static uint16_t retainHead = 0;     // Next free arena byte
+static uint8_t retainSlot = 0;      // Next slot to reuse
+static uint8_t nextMessageId = 0;
+
+// Copy a message into the arena, dropping the old ones it overwrites
+static void retainMessage(uint8_t id, const uint8_t* data, size_t len, size_t chunkSize, uint8_t mask) {
+    if (len > BLE_CHUNK_RETAIN_BYTES) {
+        return;
+    }
+    if (retainHead + len > BLE_CHUNK_RETAIN_BYTES) {
+        retainHead = 0;
+    }
+    size_t end = retainHead + len;
+    for (int i = 0; i < BLE_CHUNK_RETAIN_MESSAGES; i++) {
+        RetainedMessage& old = retained[i];
+        if (old.valid && old.start < end && retainHead < old.start + old.length) {
+            old.valid = false;
+        }
+    }
+    RetainedMessage& slot = retained[retainSlot];
+    retainSlot = (retainSlot + 1) % BLE_CHUNK_RETAIN_MESSAGES;
+    memcpy(retainArena + retainHead, data, len);
+    slot.valid = true;
+    slot.id = id;
+    slot.start = retainHead;
+    slot.length = len;
+    slot.chunkSize = chunkSize;
+    slot.clients = mask;
+    retainHead = end;
+}
+
+// Queue chunks first..first + count - 1 of message id for the clients of mask
+// Called with txMutex held
+static bool queueFramedChunks(uint8_t id, const uint8_t* data, size_t len, size_t chunkSize,
+                              uint16_t first, uint16_t count, uint8_t mask, TickType_t wait) {
+    static uint8_t item[sizeof(BLETxChunkHeader) + BLE_MAX_PAYLOAD];
+    BLETxChunkHeader* header = (BLETxChunkHeader*)item;
+    BLETextChunkHeader* frame = (BLETextChunkHeader*)(item + sizeof(BLETxChunkHeader));
+    uint8_t* text = item + sizeof(BLETxChunkHeader) + sizeof(BLETextChunkHeader);
+
+    uint16_t chunks = (len + chunkSize - 1) / chunkSize;
+    header->messageBytes = len;
+    header->chunks = chunks;
+    header->channel = BLE_TX_CHANNEL_DATA;
+    header->clients = mask;
+    header->flags = 0;
+    frame->magic = BLE_CHUNK_MAGIC;
+    frame->message = id;
+    frame->chunks = chunks;
+    bool ok = true;
+    for (uint16_t chunk = first; chunk < first + count && chunk < chunks && ok; chunk++) {
+        size_t offset = (size_t)chunk * chunkSize;
+        size_t n = min(chunkSize, len - offset);
+        header->chunk = chunk;
+        frame->chunk = chunk;
+        memcpy(text, data + offset, n);
+        ok = xMessageBufferSend(txBuffer, item, sizeof(BLETxChunkHeader) + sizeof(BLETextChunkHeader) + n,
+                                wait) > 0;
+    }
+    return ok;
+}
+
+// Text for the framed clients of mask: a new message ID, kept for RESEND
+static bool queueFramedText(const uint8_t* data, size_t len, uint8_t mask) {
+    size_t payload = maskPayloadSize(mask, false);
+    if (txBuffer == nullptr || payload <= sizeof(BLETextChunkHeader)) {
+        return txBuffer != nullptr;
+    }
+    size_t chunkSize = payload - sizeof(BLETextChunkHeader);
+
+    xSemaphoreTake(txMutex, portMAX_DELAY);
+    uint8_t id = nextMessageId++;
+    retainMessage(id, data, len, chunkSize, mask);
+    bool ok = queueFramedChunks(id, data, len, chunkSize, 0, UINT16_MAX, mask,
+                                pdMS_TO_TICKS(BLE_TX_QUEUE_WAIT_MS));
+    xSemaphoreGive(txMutex);
+
+    if (!ok) {
+        HAL_PRINTF("[BLE] ERROR: TX buffer full - framed message %u truncated\n", id);
+    }
+    return ok;
+}
+
+// Connections of mask that asked for framed text
+static uint8_t framedClients(uint8_t mask) {
+    uint8_t framed = 0;
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if ((mask & (1 << i)) && clients[i].active && clients[i].framedText) {
+            framed |= 1 << i;
+        }
+    }
+    return framed;
+}
+
+bool resendBLEChunks(uint8_t message, uint16_t first, uint16_t count) {
+    if (commandClient == BLE_NO_CLIENT || !clients[commandClient].active || txBuffer == nullptr) {
+        return false;
+    }
+    size_t payload = clientPayloadSize(clients[commandClient]);
+    bool found = false;
+    bool ok = false;
+
+    xSemaphoreTake(txMutex, portMAX_DELAY);
+    for (int i = 0; i < BLE_CHUNK_RETAIN_MESSAGES && !found; i++) {
+        const RetainedMessage& slot = retained[i];
+        if (!slot.valid || slot.id != message) {
+            continue;
+        }
+        found = true;
+        uint16_t chunks = (slot.length + slot.chunkSize - 1) / slot.chunkSize;
+        if (first < chunks && slot.chunkSize + sizeof(BLETextChunkHeader) <= payload) {
+            ok = queueFramedChunks(slot.id, retainArena + slot.start, slot.length, slot.chunkSize, first,
+                                   min(count, (uint16_t)(chunks - first)), 1 << commandClient,
+                                   pdMS_TO_TICKS(BLE_TX_QUEUE_WAIT_MS));
+        }
+    }
+    xSemaphoreGive(txMutex);
+    return ok;
+}
+
+/*=========================TRANSFER RESUME=========================*/
+// A dropped framed connection - kept for BLE_RESUME_KEEP_MS
+struct BLEParkedSession {
+    bool valid;
+    uint32_t token;
+    uint32_t parkedAt;
+    uint8_t slot;           // Its client slot - the receiver bit of its retained messages
+    uint8_t lastMessage;    // Newest framed message ID at the disconnect
+    bool binaryData;
+    bool streaming;
+};
+static BLEParkedSession parked[BLE_RESUME_SLOTS];
+static portMUX_TYPE parkedMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Disconnect of a framed client (BTC task)
+static void parkSession(const BLEClientSlot& client, int slot) {
+    if (!client.framedText) {
+        return;
+    }
+    portENTER_CRITICAL(&parkedMux);
+    // Reuse a free entry, else the oldest
+    int entry = 0;
+    for (int i = 0; i < BLE_RESUME_SLOTS; i++) {
+        if (!parked[i].valid) {
+            entry = i;
+            break;
+        }
+        if (parked[i].parkedAt - parked[entry].parkedAt > UINT32_MAX / 2) {
+            entry = i;
+        }
+    }
+    BLEParkedSession& session = parked[entry];
+    session.valid = true;
+    session.token = client.resumeToken;
+    session.parkedAt = millis();
+    session.slot = slot;
+    session.lastMessage = nextMessageId - 1;
+    session.binaryData = client.binaryData;
+    session.streaming = client.streaming;
+    portEXIT_CRITICAL(&parkedMux);
+}
+
+uint32_t getBLEResumeToken() {
+    return commandClient != BLE_NO_CLIENT ? clients[commandClient].resumeToken : 0;
+}
+
+BLEResumeResult resumeBLETransfer(uint32_t token, uint8_t message, uint16_t chunk, int& messagesOut) {
+    messagesOut = 0;
+    if (commandClient == BLE_NO_CLIENT || !clients[commandClient].active || txBuffer == nullptr) {
+        return BLE_RESUME_UNKNOWN;
+    }
+    BLEParkedSession session;
+    bool found = false;
+    portENTER_CRITICAL(&parkedMux);
+    for (int i = 0; i < BLE_RESUME_SLOTS && !found; i++) {
+        if (parked[i].valid && parked[i].token == token) {
+            found = millis() - parked[i].parkedAt < BLE_RESUME_KEEP_MS;
+            session = parked[i];
+            parked[i].valid = false;
+        }
+    }
+    portEXIT_CRITICAL(&parkedMux);
+    if (!found) {
+        return BLE_RESUME_UNKNOWN;
+    }
+
+    // The new connection carries on as the old one
+    BLEClientSlot& client = clients[commandClient];
+    client.resumeToken = session.token;
+    client.binaryData = session.binaryData;
+    client.streaming = session.streaming;
+    client.framedText = true;
+    updateLiveBatchHandover();
+
+    // message..lastMessage, wrapping at 256; lastMessage + 1 = nothing missed
+    uint8_t span = session.lastMessage - message;
+    if (message == (uint8_t)(session.lastMessage + 1)) {
+        return BLE_RESUME_OK;
+    }
+    if (span >= BLE_CHUNK_RETAIN_MESSAGES) {
+        return BLE_RESUME_NOT_RETAINED;
+    }
+    size_t payload = clientPayloadSize(client);
+    BLEResumeResult result = BLE_RESUME_OK;
+
+    xSemaphoreTake(txMutex, portMAX_DELAY);
+    for (int n = 0; n <= span && result == BLE_RESUME_OK; n++) {
+        uint8_t id = message + n;
+        const RetainedMessage* slot = nullptr;
+        for (int i = 0; i < BLE_CHUNK_RETAIN_MESSAGES && slot == nullptr; i++) {
+            if (retained[i].valid && retained[i].id == id) {
+                slot = &retained[i];
+            }
+        }
+        if (slot == nullptr) {
+            result = BLE_RESUME_NOT_RETAINED;
+            break;
+        }
+        // IDs are shared by all connections - skip the other clients' messages
+        if (!(slot->clients & (1 << session.slot))) {
+            continue;
+        }
+        uint16_t first = n == 0 ? chunk : 0;
+        uint16_t chunks = (slot->length + slot->chunkSize - 1) / slot->chunkSize;
+        if (first >= chunks || slot->chunkSize + sizeof(BLETextChunkHeader) > payload) {
+            result = BLE_RESUME_NOT_RETAINED;
+            break;
+        }
+        if (!queueFramedChunks(slot->id, retainArena + slot->start, slot->length, slot->chunkSize, first,
+                               chunks - first, 1 << commandClient, pdMS_TO_TICKS(BLE_TX_QUEUE_WAIT_MS))) {
+            result = BLE_RESUME_NOT_RETAINED;
+            break;
+        }
+        messagesOut++;
+    }
+    xSemaphoreGive(txMutex);
+    return result;
+}
+
+static FieldCounter notifySent("ble.notify_ok");
+static FieldCounter notifyErrors("ble.notify_err");
+static FieldHistogram notifyBytes("ble.notify_bytes", COUNTER_BOUNDS_BYTES);
+
+// Notify one client, in pieces of its own payload size
+static void sendToClient(BLEClientSlot& client, BLECharacteristic* characteristic, uint8_t channel, uint8_t flags,
+                         const uint8_t* data, size_t len) {
+    if (!client.active || !(client.subscribed & (1 << channel))) {
+        return;  // Gone or unsubscribed since the message was queued
+    }
+    client.lastTxMs = millis();
+    if (!client.linkFast) {
+        requestLinkParams(client, true);
+    }
+
+    size_t pieceSize = clientPayloadSize(client);
+    for (size_t offset = 0; offset < len && client.active; offset += pieceSize) {
+        // Send once the stack has room: not congested and a notification credit free
+        while (client.congested && client.active) {
+            vTaskDelay(pdMS_TO_TICKS(BLE_TX_CONGEST_POLL_MS));
+        }
+        if (xSemaphoreTake(txCredits, pdMS_TO_TICKS(BLE_TX_CREDIT_TIMEOUT_MS)) == pdTRUE) {
+            client.inFlight = client.inFlight + 1;
+        } else {
+            txConfirmTimeouts++;  // Confirm lost (or none from this stack) - the timeout paces instead
+        }
+        size_t n = min(pieceSize, len - offset);
+        if (esp_ble_gatts_send_indicate(pServer->getGattsIf(), client.connId, characteristic->getHandle(),
+                                        n, (uint8_t*)data + offset, (flags & BLE_TX_FLAG_INDICATE) != 0) != ESP_OK) {
+            txCounters.sendErrors++;
+            notifyErrors.add();
+            if (flags & BLE_TX_FLAG_BENCH) {
+                txCounters.benchDropBytes += n;
+            }
+            continue;
+        }
+        notifySent.add();
+        notifyBytes.record(n);
+        if (flags & BLE_TX_FLAG_BENCH) {
+            txCounters.benchBytes += n;
+            txCounters.benchNotifications++;
+            txCounters.lastBenchUs = esp_timer_get_time();
+        }
+    }
+}
+
+bool processBLETx(TickType_t timeout) {
+    static uint8_t item[sizeof(BLETxChunkHeader) + BLE_MAX_PAYLOAD];
+    size_t size = xMessageBufferReceive(txBuffer, item, sizeof(item), timeout);
+    adaptTxPower();
+    if (size < sizeof(BLETxChunkHeader)) {
+        // Nothing to send for a while - let idle links save power
+        for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+            BLEClientSlot& client = clients[i];
+            if (client.active && client.linkFast && millis() - client.lastTxMs > BLE_LINK_IDLE_MS) {
+                requestLinkParams(client, false);
+            }
+        }
+        return false;
+    }
+    const BLETxChunkHeader* header = (const BLETxChunkHeader*)item;
+    const uint8_t* payload = item + sizeof(BLETxChunkHeader);
+    size_t len = size - sizeof(BLETxChunkHeader);
+
+    // One encoded chunk, fanned out to every receiver - the stack copies it
+    // into allocations of its own, counted apart from the application's
+    BLECharacteristic* characteristic = header->channel == BLE_TX_CHANNEL_HISTORY ? pHistDataCharacteristic
+                                                                                  : pTxCharacteristic;
+    heapStatsEnterFramework();
+    characteristic->setValue(payload, len);
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (header->clients & (1 << i)) {
+            sendToClient(clients[i], characteristic, header->channel, header->flags, payload, len);
+        }
+    }
+    heapStatsExitFramework();
+
+    if (header->chunk + 1 == header->chunks) {
+        trace(TRACE_BLE_TX_END, header->chunks, header->messageBytes);
+    }
+    return true;
+}
+
+uint32_t getBLETxConfirmTimeouts() {
+    return txConfirmTimeouts;
+}
+
+void getBLETxCounters(BLETxCounters& out) {
+    out = txCounters;
+    out.creditTimeouts = txConfirmTimeouts;
+}
+
+bool queueBLEClientMessage(int8_t client, const uint8_t* data, size_t len, size_t chunkSize, uint8_t flags) {
+    if (client == BLE_NO_CLIENT || !clients[client].active || len == 0) {
+        return false;
+    }
+    size_t payload = clientPayloadSize(clients[client]);
+    if (chunkSize == 0 || chunkSize > payload) {
+        chunkSize = payload;
+    }
+    return queueBLEMessage(data, len, BLE_TX_CHANNEL_DATA, 1 << client, chunkSize,
+                           pdMS_TO_TICKS(BLE_TX_QUEUE_WAIT_MS), flags);
+}
+
+int8_t getBLECommandClient() {
+    return commandClient != BLE_NO_CLIENT && clients[commandClient].active ? commandClient : BLE_NO_CLIENT;
+}
+
+size_t getBLEClientPayloadSize(int8_t client) {
+    return client != BLE_NO_CLIENT && clients[client].active ? clientPayloadSize(clients[client]) : 0;
+}
 
 /*=========================BLE SERVER CALLBACKS=========================*/
 class BioPalServerCallbacks: public BLEServerCallbacks {
-    void onConnect(BLEServer* pServer) {
-        deviceConnected = true;
+    void onConnect(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+        // Our own central links to fleet peers (fleet_aggregator.h) are no clients
+        if (param->connect.link_role == 0) {
+            return;
+        }
         connectionChanged = true;
-        Serial.println("[BLE] Client connected");
-        Serial.printf("[BLE] Connection count: %d\n", pServer->getConnectedCount());
-        // drawConnectionIndicatorDefault(true);
+        int slot = BLE_NO_CLIENT;
+        for (int i = 0; i < BLE_MAX_CLIENTS && slot == BLE_NO_CLIENT; i++) {
+            slot = clients[i].active ? BLE_NO_CLIENT : i;
+        }
+        if (slot == BLE_NO_CLIENT) {
+            Console.println("[BLE] WARNING: No free client slot - disconnecting");
+            pServer->disconnect(param->connect.conn_id);
+            return;
+        }
+
+        // A new client negotiates its own MTU, subscriptions and format
+        BLEClientSlot& client = clients[slot];
+        client.connId = param->connect.conn_id;
+        memcpy(client.address, param->connect.remote_bda, sizeof(esp_bd_addr_t));
+        client.mtu = BLE_DEFAULT_MTU;
+        client.subscribed = 0;
+        client.binaryData = false;
+        client.streaming = false;
+        client.framedText = false;
+        client.linkManaged = false;
+        client.congested = false;
+        client.inFlight = 0;
+        client.rssi = 0;
+        client.resumeToken = esp_random();
+        client.bonded = false;      // Set by onAuthenticationComplete
+        client.active = true;
+        Console.printf("[BLE] Client %d connected (%d of %d)\n", client.connId, getBLEClientCount(), BLE_MAX_CLIENTS);
+        setupLink(client);
+        postGUIEvent(GUI_EVENT_BLE_CONNECTED, getBLEClientCount());
+
+        // Keep advertising so another client can join
+        if (getBLEClientCount() < BLE_MAX_CLIENTS) {
+            pServer->startAdvertising();
+        }
     }
 
-    void onDisconnect(BLEServer* pServer) {
-        deviceConnected = false;
+    void onDisconnect(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
         connectionChanged = true;
-        Serial.println("[BLE] Client disconnected");
-        Serial.println("[BLE] Restarting advertising...");
-        drawConnectionIndicatorDefault(false);
+        int slot = findClient(param->disconnect.conn_id);
+        if (slot != BLE_NO_CLIENT) {
+            BLEClientSlot& client = clients[slot];
+            client.active = false;
+            giveBLETxCredits(client);
+            parkSession(client, slot);
+            if (historyClient == slot) {
+                historyClient = BLE_NO_CLIENT;
+            }
+            updateLiveBatchHandover();
+        }
+        Console.printf("[BLE] Client %d disconnected (%d left)\n", param->disconnect.conn_id, getBLEClientCount());
+        // Drawing stays on the GUI task
+        postGUIEvent(GUI_EVENT_BLE_DISCONNECTED, getBLEClientCount());
         pServer->startAdvertising();
-        Serial.println("[BLE] Advertising restarted");
+        Console.println("[BLE] Advertising restarted");
+    }
+
+    void onMtuChanged(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+        int slot = findClient(param->mtu.conn_id);
+        if (slot != BLE_NO_CLIENT) {
+            clients[slot].mtu = param->mtu.mtu;
+        }
+        Console.printf("[BLE] MTU negotiated with client %d: %d\n", param->mtu.conn_id, param->mtu.mtu);
+    }
+};
+
+/*=========================BLE SECURITY CALLBACKS=========================*/
+// Static passkey (BLE_PAIRING_PASSKEY): the device has no keypad, the client
+// types it in. Encryption with a stored bond completes here as well
+class BioPalSecurityCallbacks: public BLESecurityCallbacks {
+    uint32_t onPassKeyRequest() {
+        return BLE_PAIRING_PASSKEY;
+    }
+
+    void onPassKeyNotify(uint32_t passKey) {}
+
+    bool onSecurityRequest() {
+        return true;
+    }
+
+    bool onConfirmPIN(uint32_t pin) {
+        return pin == BLE_PAIRING_PASSKEY;
+    }
+
+    void onAuthenticationComplete(esp_ble_auth_cmpl_t result) {
+        bool bonded = result.success && (result.auth_mode & ESP_LE_AUTH_BOND) &&
+                      (result.auth_mode & ESP_LE_AUTH_REQ_MITM);
+        for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+            if (clients[i].active && memcmp(clients[i].address, result.bd_addr, sizeof(esp_bd_addr_t)) == 0) {
+                clients[i].bonded = bonded;
+            }
+        }
+        if (result.success) {
+            Console.printf("[BLE] Link encrypted (%s)\n", bonded ? "bonded" : "not bonded");
+        } else {
+            Console.printf("[BLE] Pairing failed (reason 0x%02X)\n", result.fail_reason);
+        }
     }
 };
 
 /*=========================BLE CHARACTERISTIC CALLBACKS=========================*/
 class BioPalCharacteristicCallbacks: public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic* pCharacteristic, esp_ble_gatts_cb_param_t* param) {
+        size_t len = pCharacteristic->getLength();
+        if (len == 0) {
+            return;
+        }
+
+        // Full ring or oversized command - count it, never overwrite a pending one
+        uint8_t head = commandHead;
+        uint8_t next = (head + 1) % BLE_CMD_RING_SLOTS;
+        if (next == commandTail || len >= BLE_CMD_MAX_LEN) {
+            commandDrops = commandDrops + 1;
+            wakeGUITask(GUI_WAKE_BLE);      // Reports the drop
+            return;
+        }
+        BLECommandSlot& slot = commandRing[head];
+        memcpy(slot.text, pCharacteristic->getData(), len);
+        slot.text[len] = '\0';
+        slot.length = len;
+        slot.connId = param->write.conn_id;
+
+        // The controller queues a running sweep's STOP from here instead of
+        // behind a frame or a DATA burst of the GUI task - before the command
+        // is visible, so the GUI task's requestMeasurementStop() skips it
+        if (len == strlen(BLE_CMD_STOP) && memcmp(slot.text, BLE_CMD_STOP, len) == 0) {
+            preemptMeasurementStop();
+        }
+
+        __sync_synchronize();   // Slot contents before the new head
+        commandHead = next;
+        wakeGUITask(GUI_WAKE_BLE);
+
+        if ((uint8_t)slot.text[0] == BLE_BIN_MAGIC) {
+            Console.printf("[BLE] Received binary command (%u bytes)\n", (unsigned)len);
+        } else {
+            Console.printf("[BLE] Received command: '%s'\n", slot.text);
+        }
+    }
+};
+
+// Binary calibration image frames - buffered here, written to flash by the GUI task
+class BioPalCalUploadCallbacks: public BLECharacteristicCallbacks {
     void onWrite(BLECharacteristic* pCharacteristic) {
-        String value = pCharacteristic->getValue().c_str();
+        if (!calUploadReceive(pCharacteristic->getData(), pCharacteristic->getLength())) {
+            Console.println("[BLE] Calibration frame dropped");
+        }
+        wakeGUITask(GUI_WAKE_BLE);
+    }
+};
 
-        if (value.length() > 0) {
-            receivedCommand = value;
-            commandReady = true;
+// Firmware update frames - buffered here, written to the update slot by the GUI task
+class BioPalOTACallbacks: public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic* pCharacteristic, esp_ble_gatts_cb_param_t* param) {
+        // The attribute already needs MITM encryption - the bond is checked too
+        int slot = findClient(param->write.conn_id);
+        if (slot == BLE_NO_CLIENT || !clients[slot].bonded) {
+            Console.println("[BLE] Firmware update frame from an unbonded link dropped");
+            return;
+        }
+        if (!otaUpdateReceive(pCharacteristic->getData(), pCharacteristic->getLength())) {
+            Console.println("[BLE] Firmware update frame dropped");
+        }
+        wakeGUITask(GUI_WAKE_BLE);
+    }
+};
 
-            Serial.print("[BLE] Received command: '");
-            Serial.print(receivedCommand);
-            Serial.println("'");
+// History download requests - handled by the GUI task
+class BioPalHistoryCallbacks: public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic* pCharacteristic, esp_ble_gatts_cb_param_t* param) {
+        // Frames go back to whoever asked last
+        historyClient = findClient(param->write.conn_id);
+        if (!historyRequestReceive(pCharacteristic->getData(), pCharacteristic->getLength())) {
+            Console.println("[BLE] History request dropped");
         }
+        wakeGUITask(GUI_WAKE_BLE);
     }
 };
 
 /*=========================INITIALIZATION=========================*/
 void initBLE() {
-    Serial.println("[BLE] Initializing BLE...");
+    Console.println("[BLE] Initializing BLE...");
 
     // Create BLE device
     // Set mtu size before init to allow larger packe
     BLEDevice::init(BLE_DEVICE_NAME);
-    esp_ble_tx_power_set(ESP_BLE_PWR_TYPE_DEFAULT, ESP_PWR_LVL_N12);
-    Serial.printf("[BLE] Device name: %s\n", BLE_DEVICE_NAME);
+    // Connections start at the lowest level and adapt (adaptTxPower)
+    txPowerStep = 0;
+    esp_ble_tx_power_set(ESP_BLE_PWR_TYPE_DEFAULT, txPowerLevels[0]);
+    esp_ble_tx_power_set(ESP_BLE_PWR_TYPE_ADV, txPowerLevels[0]);
+    Console.printf("[BLE] Device name: %s\n", BLE_DEVICE_NAME);
+
+    // Queued notifications, sent by the BLE TX task
+    initBLETx();
+
+    // No connection survives a (re)init
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        clients[i].active = false;
+    }
+    historyClient = BLE_NO_CLIENT;
 
     // Create BLE server
     BLEDevice::setMTU(517);
     pServer = BLEDevice::createServer();
     pServer->setCallbacks(new BioPalServerCallbacks());
 
+    // Bonding for the OTA characteristic - pairing starts when a client first
+    // writes it and gets "insufficient authentication"
+    BLEDevice::setSecurityCallbacks(new BioPalSecurityCallbacks());
+    BLESecurity* pSecurity = new BLESecurity();
+    pSecurity->setAuthenticationMode(ESP_LE_AUTH_REQ_SC_MITM_BOND);
+    pSecurity->setCapability(ESP_IO_CAP_OUT);
+    pSecurity->setKeySize(16);
+    pSecurity->setInitEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
+    pSecurity->setRespEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
+    uint32_t passKey = BLE_PAIRING_PASSKEY;
+    esp_ble_gap_set_security_param(ESP_BLE_SM_SET_STATIC_PASSKEY, &passKey, sizeof(passKey));
+
     // Set MTU size for larger packets
-    Serial.println("[BLE] Server created with MTU=517");
+    Console.println("[BLE] Server created with MTU=517");
 
     // Create BLE service
     BLEService* pService = pServer->createService(BLE_SERVICE_UUID);
-    Serial.printf("[BLE] Service UUID: %s\n", BLE_SERVICE_UUID);
+    Console.printf("[BLE] Service UUID: %s\n", BLE_SERVICE_UUID);
 
     // Create TX characteristic (ESP32 -> WebUI)
     pTxCharacteristic = pService->createCharacteristic(
@@ -85,8 +965,9 @@ void initBLE() {
         BLECharacteristic::PROPERTY_NOTIFY
     );
     // Add descriptor for notifications
-    pTxCharacteristic->addDescriptor(new BLE2902());
-    Serial.println("[BLE] TX characteristic created (for sending data to WebUI)");
+    pTxCccd = new BLE2902();
+    pTxCharacteristic->addDescriptor(pTxCccd);
+    Console.println("[BLE] TX characteristic created (for sending data to WebUI)");
 
     // Create RX characteristic (WebUI -> ESP32)
     pRxCharacteristic = pService->createCharacteristic(
@@ -95,178 +976,250 @@ void initBLE() {
         BLECharacteristic::PROPERTY_WRITE_NR
     );
     pRxCharacteristic->setCallbacks(new BioPalCharacteristicCallbacks());
-    Serial.println("[BLE] RX characteristic created (for receiving commands from WebUI)");
+    Console.println("[BLE] RX characteristic created (for receiving commands from WebUI)");
+
+    // Create calibration upload characteristic (host -> ESP32, binary frames)
+    pCalCharacteristic = pService->createCharacteristic(
+        BLE_CHARACTERISTIC_CAL,
+        BLECharacteristic::PROPERTY_WRITE
+    );
+    pCalCharacteristic->setCallbacks(new BioPalCalUploadCallbacks());
+    Console.println("[BLE] Calibration upload characteristic created");
+
+    // Create firmware update characteristic (host -> ESP32, binary frames)
+    pOTACharacteristic = pService->createCharacteristic(
+        BLE_CHARACTERISTIC_OTA,
+        BLECharacteristic::PROPERTY_WRITE
+    );
+    pOTACharacteristic->setAccessPermissions(ESP_GATT_PERM_WRITE_ENC_MITM);
+    pOTACharacteristic->setCallbacks(new BioPalOTACallbacks());
+    Console.println("[BLE] Firmware update characteristic created (bonded clients only)");
 
     // Start the service
     pService->start();
-    Serial.println("[BLE] Service started");
+    Console.println("[BLE] Service started");
+
+    // Bulk history download service - not advertised, found by service discovery
+    BLEService* pHistoryService = pServer->createService(BLE_HISTORY_SERVICE_UUID);
+    pHistCtrlCharacteristic = pHistoryService->createCharacteristic(
+        BLE_CHARACTERISTIC_HIST_CTRL,
+        BLECharacteristic::PROPERTY_WRITE
+    );
+    pHistCtrlCharacteristic->setCallbacks(new BioPalHistoryCallbacks());
+    pHistDataCharacteristic = pHistoryService->createCharacteristic(
+        BLE_CHARACTERISTIC_HIST_DATA,
+        BLECharacteristic::PROPERTY_NOTIFY
+    );
+    pHistCccd = new BLE2902();
+    pHistDataCharacteristic->addDescriptor(pHistCccd);
+    pHistoryService->start();
+    Console.printf("[BLE] History service started: %s\n", BLE_HISTORY_SERVICE_UUID);
 
     // Allow BLE stack to stabilize before advertising
-    Serial.println("[BLE] BLE stack stabilized");
+    Console.println("[BLE] BLE stack stabilized");
 
     // Start advertising - PROPERLY SPLIT DATA TO AVOID 31-BYTE OVERFLOW
     BLEAdvertising* pAdvertising = BLEDevice::getAdvertising();
 
     pAdvertising->addServiceUUID(BLE_SERVICE_UUID);
     // Set advertising interval for fast discovery (20-40ms)
-    pAdvertising->setMinInterval(0x20);  // 20ms (0x20 * 0.625ms)
-    pAdvertising->setMaxInterval(0x40);  // 40ms (0x40 * 0.625ms)
+    pAdvertising->setMinInterval(BLE_ADV_FAST_MIN_INT);
+    pAdvertising->setMaxInterval(BLE_ADV_FAST_MAX_INT);
 
     BLEDevice::startAdvertising();
 
-    Serial.println("[BLE] ========================================");
-    Serial.println("[BLE] BLE Server started successfully!");
-    Serial.printf("[BLE] Device Name: %s\n", BLE_DEVICE_NAME);
-    Serial.println("[BLE] Waiting for client connection...");
-    Serial.println("[BLE] ========================================");
+    Console.println("[BLE] ========================================");
+    Console.println("[BLE] BLE Server started successfully!");
+    Console.printf("[BLE] Device Name: %s\n", BLE_DEVICE_NAME);
+    Console.println("[BLE] Waiting for client connection...");
+    Console.println("[BLE] ========================================");
 }
 
 /*=========================BLE RESET=========================*/
 void resetBLE() {
-    Serial.println("[BLE] Manual BLE reset requested");
-    Serial.println("[BLE] Deinitializing BLE stack...");
+    Console.println("[BLE] Manual BLE reset requested");
+    Console.println("[BLE] Deinitializing BLE stack...");
 
     BLEDevice::deinit(true);  // Complete teardown
     delay(1000);  // Allow full shutdown
 
-    Serial.println("[BLE] Reinitializing BLE...");
+    Console.println("[BLE] Reinitializing BLE...");
     initBLE();
 
-    Serial.println("[BLE] BLE reset complete");
+    Console.println("[BLE] BLE reset complete");
 }
 
 /*=========================CONNECTION STATUS=========================*/
 bool isBLEConnected() {
-    return deviceConnected;
+    return getBLEClientCount() > 0;
+}
+
+uint8_t getBLEClientCount() {
+    uint8_t count = 0;
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        count += clients[i].active ? 1 : 0;
+    }
+    return count;
 }
 
 
 /*=========================COMMAND PROCESSING=========================*/
-bool getBLECommand(char* cmdBuffer, size_t maxLen) {
-    if (!commandReady) {
-        return false;
+size_t getBLECommand(char* cmdBuffer, size_t maxLen) {
+    uint8_t tail = commandTail;
+    if (tail == commandHead) {
+        return 0;
     }
+    __sync_synchronize();   // Head before the slot contents
 
-    // Copy command to buffer
-    strncpy(cmdBuffer, receivedCommand.c_str(), maxLen - 1);
-    cmdBuffer[maxLen - 1] = '\0';  // Ensure null termination
+    const BLECommandSlot& slot = commandRing[tail];
+    commandClient = findClient(slot.connId);
+    size_t len = min((size_t)slot.length, maxLen - 1);
+    memcpy(cmdBuffer, slot.text, len);
+    cmdBuffer[len] = '\0';
 
-    // Clear command flag
-    commandReady = false;
-    receivedCommand = "";
+    // Slot free for the producer again
+    commandTail = (tail + 1) % BLE_CMD_RING_SLOTS;
+    return len;
+}
 
-    return true;
+uint32_t getBLECommandDrops() {
+    return commandDrops;
 }
 
-void parseStartCommand(const char* cmd, uint8_t& num_duts, uint8_t& start_idx, uint8_t& stop_idx, float &calcStartFreq, float &calcEndFreq) {
-    // Expect strict format (commas present):
-    // BASELINE_START:n,SS,EE,CCCCCC,CCCCCC,LLL,MMM,HHH
-    // n = 1 char (1-4)
-    // SS = start index (2 chars)
-    // EE = end index (2 chars)
-    // CCCCC C = calc start/end freq in Hz (6 chars each)
-    // LLL,MMM,HHH = risk limits as integer percentages (3 chars each, e.g. "005" -> 5%)
-    String cmdStr(cmd);
-
-    // defaults
-    num_duts = 4;
-    start_idx = 0;
-    stop_idx = 0;
-
-    if (!cmdStr.startsWith(BLE_CMD_BASELINE)) {
-        Serial.println("[BLE] ERROR: Not a BASELINE_START command");
-        num_duts = 0;
-        return;
+/*=========================DATA TRANSMISSION=========================*/
+// Text to every subscribed client of mask, chunks split per client by the TX task
+static bool queueBLEText(const char* data, uint8_t mask) {
+    if (!isBLEConnected() || !pTxCharacteristic) {
+        Console.println("[BLE] WARNING: Cannot send - no client connected");
+        return false;
     }
-
-    int colonIndex = cmdStr.indexOf(':');
-    if (colonIndex < 0) {
-        Serial.println("[BLE] WARNING: START command without parameters, using defaults (4,0,0)");
-        return;
+    if (mask == 0) {
+        return true;  // Nobody this message is for
     }
 
-    String params = cmdStr.substring(colonIndex + 1);
-    params.trim();
+    size_t len = strlen(data);
+    if (len == 0) {
+        Console.println("[BLE] WARNING: Attempted to send empty string");
+        return false;
+    }
 
-    // Split into 8 comma-separated fields (assume format is exact)
-    String parts[8];
-    int from = 0;
-    for (int i = 0; i < 7; ++i) {
-        int idx = params.indexOf(',', from);
-        parts[i] = params.substring(from, idx);
-        from = idx + 1;
+    // Framed clients get their own copy with chunk headers (FRAMING:1)
+    uint8_t framed = framedClients(mask);
+    mask &= ~framed;
+    size_t chunkSize = maskPayloadSize(mask | framed, true);
+    trace(TRACE_BLE_TX_BEGIN, 0, len);
+    if (len <= chunkSize) {
+        HAL_PRINTF("[BLE] Queued (%d bytes): %s\n", len, data);
+    } else {
+        HAL_PRINTF("[BLE] Queued %d bytes in %d byte chunks\n", len, chunkSize);
     }
-    parts[7] = params.substring(from);
+    bool ok = true;
+    if (framed != 0) {
+        ok = queueFramedText((const uint8_t*)data, len, framed);
+    }
+    return queueBLEMessage((const uint8_t*)data, len, BLE_TX_CHANNEL_DATA, mask, maskPayloadSize(mask, true)) && ok;
+}
 
-    // Assign directly (no legacy handling, minimal parsing as requested)
-    num_duts   = (uint8_t)parts[0].toInt();
-    start_idx  = (uint8_t)parts[1].toInt();
-    stop_idx   = (uint8_t)parts[2].toInt();
+// One binary notification to the clients of mask - must fit the smallest MTU among them
+static bool queueBLENotification(const uint8_t* data, size_t len, uint8_t mask) {
+    if (!isBLEConnected() || !pTxCharacteristic) {
+        Console.println("[BLE] WARNING: Cannot send - no client connected");
+        return false;
+    }
+    size_t maxLen = maskPayloadSize(mask, false);
+    if (mask != 0 && (len == 0 || len > maxLen)) {
+        Console.printf("[BLE] ERROR: Binary notification of %d bytes (max %d)\n", len, maxLen);
+        return false;
+    }
 
-    // calculation frequency bounds (Hz)
-    calcStartFreq = (float)parts[3].toInt();
-    calcEndFreq   = (float)parts[4].toInt();
+    trace(TRACE_BLE_TX_BEGIN, 0, len);
+    return queueBLEMessage(data, len, BLE_TX_CHANNEL_DATA, mask, len);
+}
 
-    // risk cutoffs provided as integer percent strings -> convert to fraction
-    lowRiskCutoff    = (float)parts[5].toFloat();
-    mediumRiskCutoff = (float)parts[6].toFloat();
-    highRiskCutoff   = (float)parts[7].toFloat();
+bool sendBLEString(const char* data) {
+    // Live WebSockets get the same text (wifi_server.h)
+    sendWiFiLive((const uint8_t*)data, strlen(data));
+    return queueBLEText(data, selectClients(BLE_TX_CHANNEL_DATA));
+}
 
-    Serial.printf("[BLE] Parsed BASELINE_START -> %d DUT(s), start=%u, stop=%u\n",
-                  num_duts, start_idx, stop_idx);
-    Serial.printf("[BLE] CalcFreqs: %.0f - %.0f Hz, Limits: L=%.3f M=%.3f H=%.3f\n",
-                  calcStartFreq, calcEndFreq,
-                  lowRiskCutoff, mediumRiskCutoff, highRiskCutoff);
+bool sendBLEBytes(const uint8_t* data, size_t len) {
+    return queueBLENotification(data, len, selectClients(BLE_TX_CHANNEL_DATA));
 }
 
-/*=========================DATA TRANSMISSION=========================*/
-bool sendBLEString(const char* data) {
-    if (!deviceConnected || !pTxCharacteristic) {
-        Serial.println("[BLE] WARNING: Cannot send - no client connected");
+bool sendBLEHistoryFrame(const uint8_t* data, size_t len) {
+    int slot = historyClient;
+    if (slot == BLE_NO_CLIENT || !pHistDataCharacteristic || len == 0 || len > getBLEHistoryPayloadSize()) {
         return false;
     }
+    // Only the requester - an unsubscribed one simply gets nothing
+    return queueBLEMessage(data, len, BLE_TX_CHANNEL_HISTORY, 1 << slot, len, 0);
+}
 
-    size_t len = strlen(data);
-    if (len == 0) {
-        Serial.println("[BLE] WARNING: Attempted to send empty string");
-        return false;
-    }
+size_t getBLEHistoryPayloadSize() {
+    int slot = historyClient;
+    return slot != BLE_NO_CLIENT && clients[slot].active ? clientPayloadSize(clients[slot]) : 0;
+}
 
-    // BLE MTU limit - use conservative chunk size
-    const size_t MAX_CHUNK_SIZE = 400;
+size_t getBLETxFree() {
+    return txBuffer != nullptr ? xMessageBufferSpacesAvailable(txBuffer) : 0;
+}
 
-    if (len <= MAX_CHUNK_SIZE) {
-        // Small enough to send in one packet
-        pTxCharacteristic->setValue((uint8_t*)data, len);
-        pTxCharacteristic->notify();
-        Serial.printf("[BLE] Sent (%d bytes): %s\n", len, data);
-        return true;
+size_t getBLEPayloadSize() {
+    if (commandClient == BLE_NO_CLIENT || !clients[commandClient].active) {
+        return BLE_DEFAULT_MTU - 3;
     }
+    return clientPayloadSize(clients[commandClient]);
+}
 
-    // Need to chunk the data
-    Serial.printf("[BLE] Data too large (%d bytes), chunking...\n", len);
+size_t getBLEDataPayloadSize() {
+    return maskPayloadSize(selectClients(BLE_TX_CHANNEL_DATA), false);
+}
 
-    size_t offset = 0;
-    int chunkNum = 0;
+void setBLELinkManaged() {
+    if (commandClient != BLE_NO_CLIENT && clients[commandClient].active) {
+        clients[commandClient].linkManaged = true;
+        HAL_PRINTF("[BLE] Client %d: connection interval set by its central\n", clients[commandClient].connId);
+    }
+}
 
-    while (offset < len) {
-        size_t chunkSize = min(MAX_CHUNK_SIZE, len - offset);
+void setBLEBinaryData(bool enable) {
+    if (commandClient != BLE_NO_CLIENT) {
+        clients[commandClient].binaryData = enable;
+    }
+}
 
-        // Send chunk
-        pTxCharacteristic->setValue((uint8_t*)(data + offset), chunkSize);
-        pTxCharacteristic->notify();
+bool isBLEBinaryData() {
+    return commandClient != BLE_NO_CLIENT && clients[commandClient].binaryData;
+}
 
-        Serial.printf("[BLE] Sent chunk %d (%d bytes)\n", chunkNum, chunkSize);
+void setBLEStreaming(bool enable) {
+    if (commandClient != BLE_NO_CLIENT) {
+        clients[commandClient].streaming = enable;
+    }
+    updateLiveBatchHandover();
+}
 
-        offset += chunkSize;
-        chunkNum++;
+bool isBLEStreaming() {
+    return commandClient != BLE_NO_CLIENT && clients[commandClient].streaming;
+}
 
-        // Small delay between chunks to avoid overwhelming receiver
-        delay(20);
+void setBLEFramedText(bool enable) {
+    if (commandClient != BLE_NO_CLIENT) {
+        clients[commandClient].framedText = enable;
     }
+}
 
-    Serial.printf("[BLE] Sent %d chunks (total %d bytes)\n", chunkNum, len);
-    return true;
+bool isBLEFramedText() {
+    return commandClient != BLE_NO_CLIENT && clients[commandClient].framedText;
+}
+
+bool anyBLEClientStreaming() {
+    for (int i = 0; i < BLE_MAX_CLIENTS; i++) {
+        if (clients[i].active && clients[i].streaming) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void sendBLEStatus(const char* status) {
@@ -276,97 +1229,568 @@ void sendBLEStatus(const char* status) {
 }
 
 void sendBLEDUTStart(uint8_t dutNum) {
+    // Streaming clients already saw the points arrive, binary ones get the first part
     char buffer[32];
     snprintf(buffer, sizeof(buffer), "%s:%d", BLE_RESP_DUT_START, dutNum);
-    sendBLEString(buffer);
+    queueBLEText(buffer, selectClients(BLE_TX_CHANNEL_DATA, 0, 0));
 }
 
 void sendBLEDUTEnd(uint8_t dutNum) {
     char buffer[32];
     snprintf(buffer, sizeof(buffer), "%s:%d", BLE_RESP_DUT_END, dutNum);
-    sendBLEString(buffer);
+    sendWiFiLive((const uint8_t*)buffer, strlen(buffer));
+    queueBLEText(buffer, selectClients(BLE_TX_CHANNEL_DATA) & ~selectClients(BLE_TX_CHANNEL_DATA, 1, 0));
 }
 
-bool sendBLEImpedanceData(uint8_t dutIndex) {
-    if (dutIndex >= MAX_DUT_COUNT) {
-        Serial.printf("[BLE] ERROR: Invalid DUT index %d\n", dutIndex);
+/*=========================BINARY DATA=========================*/
+
+static uint16_t encodeBinaryFreq(uint8_t freqCode) {
+    uint8_t idx = storedFreqIndex(freqCode);
+    if (idx != SWEEP_FREQ_INVALID) {
+        return idx;
+    }
+    uint32_t steps = (storedFrequency(freqCode) + BLE_BIN_OFFGRID_STEP_HZ / 2) / BLE_BIN_OFFGRID_STEP_HZ;
+    return BLE_BIN_FREQ_OFFGRID | min(steps, (uint32_t)(BLE_BIN_FREQ_OFFGRID - 1));
+}
+
+static uint16_t encodeBinaryMag(float mag) {
+    if (!(mag > 0.0f)) {
+        return 0;
+    }
+    float code = (log10f(mag) - BLE_BIN_MAG_LOG_MIN) * BLE_BIN_MAG_LOG_SCALE + 0.5f;
+    return code <= 0.0f ? 0 : code >= 65535.0f ? 65535 : (uint16_t)code;
+}
+
+static int16_t encodeBinaryPhase(float phase) {
+    float code = phase * BLE_BIN_PHASE_SCALE;
+    code += code < 0.0f ? -0.5f : 0.5f;
+    return code <= -32768.0f ? -32768 : code >= 32767.0f ? 32767 : (int16_t)code;
+}
+
+static BLEBinarySpreadPoint encodeBinaryPoint(const ImpedanceRow& row, int i) {
+    BLEBinarySpreadPoint point;
+    point.point.freq = encodeBinaryFreq(row.freqCode[i]);
+    point.point.mag = encodeBinaryMag(row.mag[i]);
+    point.point.phase = encodeBinaryPhase(row.phase[i]);
+    point.magSd = row.magSd[i];
+    point.phaseSd = row.phaseSd[i];
+    return point;
+}
+
+// Valid point i of a row within the query's frequency range
+static bool isPointSelected(const ImpedanceRow& row, int i, const BLEDataQuery& query) {
+    if (!isStoredPointValid(row, i)) {
         return false;
     }
+    uint32_t freq = storedFrequency(row.freqCode[i]);
+    return freq >= query.minHz && freq <= query.maxHz;
+}
 
-    if (frequencyCount[dutIndex] == 0) {
-        Serial.printf("[BLE] WARNING: No data for DUT %d\n", dutIndex + 1);
+// Selected points of the first stored of a row as BLEBinaryHeader + points
+// notifications to the clients of mask, lastFlags added to the last one
+static bool sendBLEImpedanceBinary(uint8_t dutIndex, const ImpedanceRow& row, int stored, bool final,
+                                   const BLEDataQuery& query, uint8_t mask, uint8_t lastFlags = 0) {
+    static uint8_t packet[BLE_MAX_PAYLOAD];
+    BLEBinaryHeader* header = (BLEBinaryHeader*)packet;
+
+    bool withSpread = getSweepRepeats() > 1;
+    size_t pointSize = withSpread ? sizeof(BLEBinarySpreadPoint) : sizeof(BLEBinaryPoint);
+    // Encoded once - every part fits the smallest MTU among the receivers
+    int perPart = (maskPayloadSize(mask, false) - sizeof(BLEBinaryHeader)) / pointSize;
+
+    int total = 0;
+    for (int i = 0; i < stored; i++) {
+        total += isPointSelected(row, i, query) ? 1 : 0;
+    }
+    int parts = max(1, (total + perPart - 1) / perPart);
+
+    header->magic = BLE_BIN_MAGIC;
+    header->type = BLE_BIN_TYPE_DATA;
+    header->dut = dutIndex + 1;
+    uint8_t flags = (withSpread ? BLE_BIN_FLAG_SPREAD : 0) | (final ? BLE_BIN_FLAG_FINAL : 0);
+    header->parts = parts;
+    header->total = total;
+
+    int i = 0;
+    for (int part = 0; part < parts; part++) {
+        uint8_t* out = packet + sizeof(BLEBinaryHeader);
+        int count = 0;
+        for (; i < stored && count < perPart; i++) {
+            if (!isPointSelected(row, i, query)) {
+                continue;
+            }
+            BLEBinarySpreadPoint point = encodeBinaryPoint(row, i);
+            memcpy(out, &point, pointSize);
+            out += pointSize;
+            count++;
+        }
+        header->part = part;
+        header->count = count;
+        header->flags = part == parts - 1 ? flags | lastFlags : flags;
+        if (!queueBLENotification(packet, out - packet, mask)) {
+            return false;
+        }
+    }
+
+    HAL_PRINTF("[BLE] Sent binary data for DUT %d (%d points, %d notification%s)\n",
+               dutIndex + 1, total, parts, parts > 1 ? "s" : "");
+    return true;
+}
+
+bool sendBLELivePoint(uint8_t dutIndex, int i, bool final) {
+    uint8_t mask = selectClients(BLE_TX_CHANNEL_DATA, -1, 1);
+    if (mask == 0 && getWiFiLiveClients() == 0) {
         return false;
     }
+    const ImpedanceRow& row = final ? measurementImpedanceData[dutIndex] : baselineImpedanceData[dutIndex];
+    if (!isStoredPointValid(row, i)) {
+        return false;
+    }
+    uint8_t packet[sizeof(BLEBinaryHeader) + sizeof(BLEBinarySpreadPoint)];
+    BLEBinaryHeader* header = (BLEBinaryHeader*)packet;
+    bool withSpread = getSweepRepeats() > 1;
+
+    header->magic = BLE_BIN_MAGIC;
+    header->type = BLE_BIN_TYPE_POINT;
+    header->dut = dutIndex + 1;
+    header->flags = (withSpread ? BLE_BIN_FLAG_SPREAD : 0) | (final ? BLE_BIN_FLAG_FINAL : 0);
+    header->part = i;
+    header->parts = 1;
+    header->count = 1;
+    header->total = i + 1;
+
+    BLEBinarySpreadPoint point = encodeBinaryPoint(row, i);
+    size_t pointSize = withSpread ? sizeof(BLEBinarySpreadPoint) : sizeof(BLEBinaryPoint);
+    memcpy(packet + sizeof(BLEBinaryHeader), &point, pointSize);
+    // Encoded once for both transports
+    sendWiFiLive(packet, sizeof(BLEBinaryHeader) + pointSize);
+    return queueBLENotification(packet, sizeof(BLEBinaryHeader) + pointSize, mask);
+}
 
-    Serial.printf("[BLE] Preparing to send data for DUT %d (%d points)...\n",
-                  dutIndex + 1, frequencyCount[dutIndex]);
+/*=========================JSON DATA=========================*/
+// Written with snprintf into the caller's buffer instead of a JsonDocument -
+// sent every DUT of every sweep, it must not allocate
+struct JsonWriter {
+    char* out;
+    size_t size;
+    size_t len;
+    bool full;      // Something did not fit - the output is unusable
+};
 
-    // Create JSON document
-    // Size calculation: ~50 bytes overhead + ~60 bytes per point
-    size_t jsonSize = 200 + (frequencyCount[dutIndex] * 80);
-    JsonDocument doc;
+static void jsonAppend(JsonWriter& w, const char* fmt, ...) {
+    if (w.full) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(w.out + w.len, w.size - w.len, fmt, args);
+    va_end(args);
+    if (n < 0 || (size_t)n >= w.size - w.len) {
+        w.full = true;
+        return;
+    }
+    w.len += n;
+}
 
-    // Add DUT number
-    doc["dut"] = dutIndex + 1;
-    doc["count"] = frequencyCount[dutIndex];
+// value with fixed decimals (fixed_format.h): newlib's float printf is slow
+// and mallocs its conversion buffers the first time each task uses it
+static void jsonAppendFixed(JsonWriter& w, float value, int decimals) {
+    char text[FIXED_FORMAT_BUFFER];
+    size_t n = formatFixed(text, sizeof(text), value, decimals);
+    if (n == 0) {
+        jsonAppend(w, "null");  // Not finite or out of range
+        return;
+    }
+    if (w.full || n >= w.size - w.len) {
+        w.full = true;
+        return;
+    }
+    memcpy(w.out + w.len, text, n + 1);
+    w.len += n;
+}
 
-    // Create arrays for frequency, magnitude, and phase
-    JsonArray freqArray = doc["freq"].to<JsonArray>();
-    JsonArray magArray = doc["mag"].to<JsonArray>();
-    JsonArray phaseArray = doc["phase"].to<JsonArray>();
+enum JsonField { JSON_FREQ, JSON_MAG, JSON_PHASE, JSON_MAG_SD, JSON_PHASE_SD };
 
-    // Fill arrays with impedance data
-    for (int i = 0; i < frequencyCount[dutIndex]; i++) {
-        if (!baselineMeasurementDone) {
-            ImpedancePoint& point = baselineImpedanceData[dutIndex][i];
+// "key":[...] of one field over the valid stored points
+static void jsonAppendArray(JsonWriter& w, const char* key, JsonField field, const ImpedanceRow& row, int stored,
+                            const BLEDataQuery& query) {
+    jsonAppend(w, ",\"%s\":[", key);
+    bool first = true;
+    for (int i = 0; i < stored; i++) {
+        if (!isPointSelected(row, i, query)) {
+            continue;
+        }
+        if (!first) {
+            jsonAppend(w, ",");
+        }
+        first = false;
+        switch (field) {
+            case JSON_FREQ:     jsonAppend(w, "%lu", (unsigned long)storedFrequency(row.freqCode[i])); break;
+            case JSON_MAG:      jsonAppendFixed(w, row.mag[i], 3); break;   // 3 decimal places (reduced for smaller JSON)
+            case JSON_PHASE:    jsonAppendFixed(w, row.phase[i], 2); break; // 2 decimal places
+            case JSON_MAG_SD:   jsonAppendFixed(w, storedMagSdPercent(row, i), 1); break;
+            case JSON_PHASE_SD: jsonAppendFixed(w, storedPhaseSdDegrees(row, i), 1); break;
+        }
+    }
+    jsonAppend(w, "]");
+}
 
-            if (point.valid) {
-                freqArray.add(point.freq_hz);
-                magArray.add(serialized(String(point.Z_magnitude, 3)));  // 3 decimal places (reduced for smaller JSON)
-                phaseArray.add(serialized(String(point.Z_phase, 2)));     // 2 decimal places
-            }
-        } else {
-            ImpedancePoint& point = measurementImpedanceData[dutIndex][i];
+size_t encodeBLEImpedanceJSON(uint8_t dutIndex, const ImpedanceRow& row, int stored, char* json, size_t size,
+                              const BLEDataQuery& query) {
+    JsonWriter w = {json, size, 0, size == 0};
 
-            if (point.valid) {
-                freqArray.add(point.freq_hz);
-                magArray.add(serialized(String(point.Z_magnitude, 3)));  // 3 decimal places (reduced for smaller JSON)
-                phaseArray.add(serialized(String(point.Z_phase, 2)));     // 2 decimal places
-            }
+    jsonAppend(w, "{\"dut\":%d,\"count\":%d", dutIndex + 1, stored);
+    jsonAppendArray(w, "freq", JSON_FREQ, row, stored, query);
+    jsonAppendArray(w, "mag", JSON_MAG, row, stored, query);
+    jsonAppendArray(w, "phase", JSON_PHASE, row, stored, query);
+
+    // Spread of averaged repeats (% of |Z|, degrees) - only sent when repeating
+    if (getSweepRepeats() > 1) {
+        jsonAppend(w, ",\"repeats\":%d", getSweepRepeats());
+        jsonAppendArray(w, "mag_sd", JSON_MAG_SD, row, stored, query);
+        jsonAppendArray(w, "phase_sd", JSON_PHASE_SD, row, stored, query);
+    }
+    jsonAppend(w, "}");
+    return w.full ? 0 : w.len;
+}
+
+/*=========================DATA CACHE=========================*/
+// DATA messages per session, DUT and frequency range. A row is final once
+// it is delivered (repairs and KK resweeps come before) or its session is
+// no longer the current one, and stays so until the next session of its kind
+// changes the row generation - GET_DATA re-queues the text instead of
+// formatting ~40 floats again. Rows still being swept are encoded afresh.
+// Binary is not cached, it is integer packing
+struct BLEDataCacheSlot {
+    uint32_t generation;        // Of the rows - 0 = empty, sessions start at 1
+    uint32_t minHz;
+    uint32_t maxHz;
+    bool final;
+    uint8_t dut;
+    uint8_t repeats;            // The JSON has spread arrays when > 1
+    uint8_t stored;
+    char text[sizeof(BLE_RESP_DATA) + BLE_DATA_JSON_BYTES];
+};
+
+static BLEDataCacheSlot dataCache[BLE_DATA_CACHE_SLOTS];
+static uint8_t dataCacheNext = 0;      // Round-robin replacement
+static char dataScratch[sizeof(BLE_RESP_DATA) + BLE_DATA_JSON_BYTES];   // Rows not final yet
+static FieldCounter dataCacheHits("ble.data_cache_hit");
+static FieldCounter dataCacheMisses("ble.data_cache_miss");
+
+static const BLEDataQuery fullRangeQuery = {0xFFFF, DATA_ROWS_CURRENT, 0, UINT32_MAX, -1};
+
+// One DUT's row picked by a query
+struct DataRowRef {
+    const ImpedanceRow* row;
+    int stored;
+    uint32_t generation;
+    bool final;
+};
+
+static DataRowRef selectDataRow(const BLEDataQuery& query, uint8_t dut) {
+    DataRowRef ref;
+    ref.final = query.rows == DATA_ROWS_CURRENT ? isFinalGeneration(getMeasurementGeneration())
+                                                : query.rows == DATA_ROWS_FINAL;
+    ref.generation = getRowGeneration(!ref.final);
+    ref.stored = getRowPointCount(!ref.final, dut);
+    ref.row = ref.final ? &measurementImpedanceData[dut] : &baselineImpedanceData[dut];
+    return ref;
+}
+
+static BLEDataCacheSlot* findDataCache(const DataRowRef& ref, uint8_t dut, const BLEDataQuery& query) {
+    for (int i = 0; i < BLE_DATA_CACHE_SLOTS; i++) {
+        BLEDataCacheSlot& slot = dataCache[i];
+        if (slot.generation == ref.generation && slot.final == ref.final && slot.dut == dut &&
+            slot.stored == ref.stored && slot.minHz == query.minHz && slot.maxHz == query.maxHz &&
+            slot.repeats == getSweepRepeats()) {
+            return &slot;
         }
     }
+    return nullptr;
+}
+
+// DATA:{json} of a row into text, false if it does not fit
+static bool encodeDataMessage(uint8_t dutIndex, const DataRowRef& ref, const BLEDataQuery& query,
+                              char* text, size_t size) {
+    size_t prefix = snprintf(text, size, "%s:", BLE_RESP_DATA);
+    size_t jsonLen = encodeBLEImpedanceJSON(dutIndex, *ref.row, ref.stored, text + prefix, size - prefix, query);
+    if (jsonLen == 0) {
+        HAL_PRINTF("[BLE] ERROR: DATA JSON for DUT %d exceeds %d bytes\n", dutIndex + 1, BLE_DATA_JSON_BYTES);
+        return false;
+    }
+    HAL_PRINTF("[BLE] JSON size: %d bytes\n", (int)jsonLen);
+    return true;
+}
+
+// DATA:{json} of a row - the cached message, or encoded into a new cache
+// slot if the row is final, else into scratch. nullptr if it does not fit or
+// the row was replaced while encoding
+static const char* dataMessage(uint8_t dutIndex, const DataRowRef& ref, const BLEDataQuery& query, bool final) {
+    if (const BLEDataCacheSlot* slot = findDataCache(ref, dutIndex, query)) {
+        dataCacheHits.add();
+        return slot->text;
+    }
+    dataCacheMisses.add();
+    if (!final) {
+        return encodeDataMessage(dutIndex, ref, query, dataScratch, sizeof(dataScratch)) ? dataScratch : nullptr;
+    }
 
-    // Serialize to string
-    String jsonStr;
-    serializeJson(doc, jsonStr);
+    BLEDataCacheSlot* slot = &dataCache[dataCacheNext];
+    dataCacheNext = (dataCacheNext + 1) % BLE_DATA_CACHE_SLOTS;
+    slot->generation = 0;
+    if (!encodeDataMessage(dutIndex, ref, query, slot->text, sizeof(slot->text)) ||
+        getRowGeneration(!ref.final) != ref.generation) {
+        return nullptr;
+    }
+    slot->generation = ref.generation;
+    slot->minHz = query.minHz;
+    slot->maxHz = query.maxHz;
+    slot->final = ref.final;
+    slot->dut = dutIndex;
+    slot->repeats = getSweepRepeats();
+    slot->stored = ref.stored;
+    return slot->text;
+}
 
-    Serial.printf("[BLE] JSON size: %d bytes\n", jsonStr.length());
-    Serial.println("[BLE] JSON preview (first 200 chars):");
-    Serial.println(jsonStr.substring(0, min(200, (int)jsonStr.length())));
+bool sendBLEImpedanceData(uint8_t dutIndex, bool final) {
+    if (dutIndex >= getDUTCount()) {
+        Console.printf("[BLE] ERROR: Invalid DUT index %d\n", dutIndex);
+        return false;
+    }
 
-    // Send with DATA prefix
-    String dataMsg = String(BLE_RESP_DATA) + ":" + jsonStr;
+    // The newest session of that kind, not the current one - a baseline
+    // delivered while the final sweep runs. One snapshot of the count, the
+    // processor may still be publishing
+    BLEDataQuery query = fullRangeQuery;
+    query.rows = final ? DATA_ROWS_FINAL : DATA_ROWS_BASELINE;
+    DataRowRef ref = selectDataRow(query, dutIndex);
+
+    // Streaming clients got the points live; the others by their format. The
+    // binary ones' DUT_START and DUT_END are in this message
+    uint8_t binaryMask = selectClients(BLE_TX_CHANNEL_DATA, 1, 0);
+    uint8_t jsonMask = selectClients(BLE_TX_CHANNEL_DATA, 0, 0);
+    bool success = true;
+    if (binaryMask != 0) {
+        success = sendBLEImpedanceBinary(dutIndex, *ref.row, ref.stored, ref.final, fullRangeQuery, binaryMask,
+                                         BLE_BIN_FLAG_END);
+    }
+    if (ref.stored == 0) {
+        Console.printf("[BLE] WARNING: No data for DUT %d\n", dutIndex + 1);
+        return false;
+    }
+    if (jsonMask == 0) {
+        return success;
+    }
 
-    // Check if data fits in single BLE packet (conservative limit)
-    if (dataMsg.length() > 512) {
-        Serial.println("[BLE] WARNING: Data might exceed BLE MTU - consider chunking");
-        // For now, try to send anyway - BLE stack may handle it
+    HAL_PRINTF("[BLE] Preparing to send data for DUT %d (%d points)...\n", dutIndex + 1, ref.stored);
+
+    // DATA:{json} - one DUT at a time from the GUI task, kept for GET_DATA
+    const char* dataMsg = dataMessage(dutIndex, ref, fullRangeQuery, true);
+    if (dataMsg == nullptr) {
+        return false;
     }
 
-    bool success = sendBLEString(dataMsg.c_str());
+    Console.println("[BLE] JSON preview (first 200 chars):");
+    size_t prefix = sizeof(BLE_RESP_DATA);
+    Console.write((const uint8_t*)dataMsg + prefix, min(strlen(dataMsg) - prefix, (size_t)200));
+    Console.println();
+
+    success = queueBLEText(dataMsg, jsonMask) && success;
 
     if (success) {
-        Serial.printf("[BLE] Successfully sent impedance data for DUT %d\n", dutIndex + 1);
+        HAL_PRINTF("[BLE] Successfully sent impedance data for DUT %d\n", dutIndex + 1);
     } else {
-        Serial.printf("[BLE] FAILED to send impedance data for DUT %d\n", dutIndex + 1);
+        HAL_PRINTF("[BLE] FAILED to send impedance data for DUT %d\n", dutIndex + 1);
     }
-
     return success;
 }
 
+bool parseBLEDataQuery(const char* text, BLEDataQuery& query) {
+    query = fullRangeQuery;
+    if (text == nullptr) {
+        return true;
+    }
+    char field[24];
+    for (int index = 0; ; index++) {
+        const char* comma = strchr(text, ',');
+        size_t len = comma ? (size_t)(comma - text) : strlen(text);
+        if (len >= sizeof(field)) {
+            return false;
+        }
+        memcpy(field, text, len);
+        field[len] = '\0';
+
+        // Empty fields keep their default
+        if (len > 0 && strcmp(field, "ALL") != 0) {
+            char* end = nullptr;
+            if (index == 0) {
+                unsigned long mask = strtoul(field, &end, 16);
+                if (*end != '\0' || mask == 0 || mask > 0xFFFF) {
+                    return false;
+                }
+                query.dutMask = mask;
+            } else if (index == 1) {
+                if (strcmp(field, "CUR") == 0) {
+                    query.rows = DATA_ROWS_CURRENT;
+                } else if (strcmp(field, "BASE") == 0) {
+                    query.rows = DATA_ROWS_BASELINE;
+                } else if (strcmp(field, "FINAL") == 0) {
+                    query.rows = DATA_ROWS_FINAL;
+                } else {
+                    return false;
+                }
+            } else if (index == 2) {
+                query.minHz = strtoul(field, &end, 10);
+                if (*end != '-' || end == field) {
+                    return false;
+                }
+                const char* hi = end + 1;
+                query.maxHz = strtoul(hi, &end, 10);
+                if (*end != '\0' || end == hi || query.maxHz < query.minHz) {
+                    return false;
+                }
+            } else if (index == 3) {
+                if (strcmp(field, "BIN") == 0) {
+                    query.format = 1;
+                } else if (strcmp(field, "JSON") == 0) {
+                    query.format = 0;
+                } else {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+        }
+        if (comma == nullptr) {
+            return true;
+        }
+        text = comma + 1;
+    }
+}
+
+// Only the rows of the current session that have not been delivered can still change
+static bool isDataRowFinal(const DataRowRef& ref, uint8_t dut) {
+    return ref.generation != getMeasurementGeneration() || isDUTDelivered(dut);
+}
+
+int sendBLEDataQuery(const BLEDataQuery& query) {
+    int client = getBLECommandClient();
+    if (client == BLE_NO_CLIENT) {
+        return 0;
+    }
+    uint8_t mask = 1 << client;
+    bool binary = query.format < 0 ? clients[client].binaryData : query.format == 1;
+
+    int sent = 0;
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        DataRowRef ref = selectDataRow(query, dut);
+        if (!(query.dutMask & (1 << dut)) || ref.stored == 0) {
+            continue;
+        }
+        bool ok;
+        if (binary) {
+            ok = sendBLEImpedanceBinary(dut, *ref.row, ref.stored, ref.final, query, mask);
+        } else {
+            const char* dataMsg = dataMessage(dut, ref, query, isDataRowFinal(ref, dut));
+            ok = dataMsg != nullptr && queueBLEText(dataMsg, mask);
+        }
+        sent += ok ? 1 : 0;
+    }
+    return sent;
+}
+
+int printDataQuery(const BLEDataQuery& query) {
+    int sent = 0;
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        DataRowRef ref = selectDataRow(query, dut);
+        if (!(query.dutMask & (1 << dut)) || ref.stored == 0) {
+            continue;
+        }
+        if (const char* dataMsg = dataMessage(dut, ref, query, isDataRowFinal(ref, dut))) {
+            Console.println(dataMsg);
+            sent++;
+        }
+    }
+    return sent;
+}
+
+void sendBLERisk(uint8_t dutIndex) {
+    if (dutIndex >= MAX_DUT_COUNT) {
+        return;
+    }
+    char buffer[48];
+    char pct[FIXED_FORMAT_BUFFER];
+    snprintf(buffer, sizeof(buffer), "%s:%d:%d:%s", BLE_RESP_RISK, dutIndex + 1,
+             (int)riskLevels[dutIndex], fixedText(pct, riskPercentages[dutIndex], 1));
+    sendBLEString(buffer);
+}
+
+void sendBLETrackedRisk(uint8_t dutIndex) {
+    if (dutIndex >= MAX_DUT_COUNT) {
+        return;
+    }
+    char buffer[48];
+    char pct[FIXED_FORMAT_BUFFER];
+    snprintf(buffer, sizeof(buffer), "%s:%d:%d:%s", BLE_RESP_TRACK, dutIndex + 1,
+             (int)getTrackedRiskLevel(dutIndex), fixedText(pct, getTrackedRiskPercent(dutIndex), 1));
+    sendBLEString(buffer);
+}
+
+void sendBLEFit(uint8_t dutIndex, bool final) {
+    if (dutIndex >= MAX_DUT_COUNT) {
+        return;
+    }
+    const CircuitFit& fit = getDUTCircuitFit(dutIndex, final);
+    if (!fit.valid) {
+        return;
+    }
+    char buffer[112];
+    snprintf(buffer, sizeof(buffer), "%s:%d:%d:%.2f:%.2f:%.4e:%.4f:%.2f:%.1f", BLE_RESP_FIT, dutIndex + 1,
+             final ? 1 : 0, fit.params.rs, fit.params.rct, fit.params.q, fit.params.n,
+             fit.rmsError * 100.0f, final ? getCircuitRctChange(dutIndex) * 100.0f : 0.0f);
+    sendBLEString(buffer);
+}
+
+void sendBLEKKResult(uint8_t dutIndex, bool final) {
+    if (dutIndex >= MAX_DUT_COUNT) {
+        return;
+    }
+    const KKResult& kk = getDUTKKResult(dutIndex, final);
+    if (!kk.checked) {
+        return;
+    }
+    char buffer[64];
+    char rms[FIXED_FORMAT_BUFFER], worst[FIXED_FORMAT_BUFFER];
+    snprintf(buffer, sizeof(buffer), "%s:%d:%d:%d:%s:%s:%lu", BLE_RESP_KK, dutIndex + 1, final ? 1 : 0,
+             kk.passed ? 1 : 0, fixedText(rms, kk.rmsResidual * 100.0f, 2),
+             fixedText(worst, kk.maxResidual * 100.0f, 2), (unsigned long)sweepFrequencies[kk.worstIdx]);
+    sendBLEString(buffer);
+}
+
+void sendBLEMetrics(uint8_t dutIndex) {
+    if (dutIndex >= MAX_DUT_COUNT) {
+        return;
+    }
+    const MetricsResult& result = getSpectralMetrics(dutIndex);
+    char buffer[160];
+    JsonWriter w = {buffer, sizeof(buffer), 0, false};
+    jsonAppend(w, "%s:%d:%02x:%02x:", BLE_RESP_METRICS, dutIndex + 1, result.mask, result.alarms);
+    bool first = true;
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if (result.mask & (1u << i)) {
+            jsonAppend(w, first ? "%.4g" : ",%.4g", result.value[i]);
+            first = false;
+        }
+    }
+    if (!w.full) {
+        sendBLEString(buffer);
+    }
+}
+
 void sendBLEComplete() {
     sendBLEString(BLE_RESP_COMPLETE);
-    Serial.println("[BLE] Sent measurement complete notification");
+    Console.println("[BLE] Sent measurement complete notification");
 }
 
 void sendBLEError(const char* errorMsg) {
@@ -375,13 +1799,151 @@ void sendBLEError(const char* errorMsg) {
     sendBLEString(buffer);
 }
 
+void sendBLEStats() {
+    static char statsMsg[BLE_STATS_JSON_BYTES];
+    JsonWriter w = {statsMsg, sizeof(statsMsg), 0, false};
+
+    jsonAppend(w, "%s:{", BLE_RESP_STATS);
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        StageStats s;
+        getSweepStageStats((SweepStage)i, s);
+        jsonAppend(w, "\"%s\":{\"n\":%lu,\"min\":%lu,\"avg\":%lu,\"max\":%lu},",
+                   getSweepStageName((SweepStage)i), (unsigned long)s.count, (unsigned long)s.min_us,
+                   (unsigned long)(s.count ? s.sum_us / s.count : 0), (unsigned long)s.max_us);
+    }
+
+    HeapSummary heap;
+    getHeapSummary(heap);
+    jsonAppend(w, "\"heap\":{\"free\":%lu,\"min\":%lu,\"largest\":%lu,\"fails\":%lu}}",
+               (unsigned long)heap.freeBytes, (unsigned long)heap.minFreeBytes,
+               (unsigned long)heap.largestBlock, (unsigned long)heap.failures);
+    if (w.full) {
+        sendBLEError("Stats do not fit");
+        return;
+    }
+    sendBLEString(statsMsg);
+}
+
+void sendBLECounters() {
+    static char countersMsg[BLE_COUNTERS_JSON_BYTES];
+    JsonWriter w = {countersMsg, sizeof(countersMsg), 0, false};
+
+    jsonAppend(w, "%s:{", BLE_RESP_COUNTERS);
+    for (const FieldMetric* m = firstFieldMetric(); m != nullptr; m = m->next) {
+        if (m->kind == COUNTER_KIND_COUNTER) {
+            jsonAppend(w, "\"%s\":%lu", m->name, (unsigned long)static_cast<const FieldCounter*>(m)->get());
+        } else {
+            const FieldHistogram& h = *static_cast<const FieldHistogram*>(m);
+            jsonAppend(w, "\"%s\":{\"n\":%lu,\"sum\":%lu,\"max\":%lu,\"le\":[", m->name, (unsigned long)h.count(),
+                       (unsigned long)h.sum(), (unsigned long)h.maximum());
+            for (uint8_t i = 0; i < h.boundCount(); i++) {
+                jsonAppend(w, i ? ",%lu" : "%lu", (unsigned long)h.bound(i));
+            }
+            jsonAppend(w, "],\"b\":[");
+            for (uint8_t i = 0; i <= h.boundCount(); i++) {
+                jsonAppend(w, i ? ",%lu" : "%lu", (unsigned long)h.bucket(i));
+            }
+            jsonAppend(w, "]}");
+        }
+        if (m->next != nullptr) {
+            jsonAppend(w, ",");
+        }
+    }
+    jsonAppend(w, "}");
+    if (w.full) {
+        sendBLEError("Counters do not fit");
+        return;
+    }
+    sendBLEString(countersMsg);
+}
+
+static void sendSessionHeader(const SessionHeader& header, void* context) {
+    char buffer[64];
+    char pct[FIXED_FORMAT_BUFFER];
+    snprintf(buffer, sizeof(buffer), "%s:%lu,%d,%d,%d,%d,%s", BLE_RESP_SESSION,
+             (unsigned long)header.timestamp, header.dut, header.kind, header.count,
+             header.risk, fixedText(pct, header.riskPercent, 1));
+    sendBLEString(buffer);
+}
+
+void sendBLESessionList() {
+    int count = listSessions(SESSION_LIST_MAX, sendSessionHeader, nullptr);
+    char statusMsg[32];
+    snprintf(statusMsg, sizeof(statusMsg), "History:%d", count);
+    sendBLEStatus(statusMsg);
+}
+
+bool sendBLESession(uint32_t timestamp, uint8_t dut) {
+    static Session session;     // ~0.5 KB - keep it off the GUI task stack
+    if (!findSession(timestamp, dut, session)) {
+        sendBLEError("No such session");
+        return false;
+    }
+
+    // Same writer and number format as the DATA JSON
+    static char historyMsg[BLE_DATA_JSON_BYTES];
+    JsonWriter w = {historyMsg, sizeof(historyMsg), 0, false};
+    const SessionHeader& header = session.header;
+    jsonAppend(w, "%s:{\"ts\":%lu,\"dut\":%d,\"kind\":%d,\"risk\":%d,\"pct\":", BLE_RESP_HISTORY,
+               (unsigned long)header.timestamp, header.dut, header.kind, header.risk);
+    jsonAppendFixed(w, header.riskPercent, 1);
+
+    static const char* const keys[] = {"freq", "mag", "phase"};
+    for (int field = 0; field < 3; field++) {
+        jsonAppend(w, ",\"%s\":[", keys[field]);
+        bool first = true;
+        for (int i = 0; i < header.count; i++) {
+            const SessionPoint& point = session.points[i];
+            if (!(point.flags & IMPEDANCE_FLAG_VALID)) {
+                continue;
+            }
+            if (!first) {
+                jsonAppend(w, ",");
+            }
+            first = false;
+            if (field == 0) {
+                jsonAppend(w, "%lu", (unsigned long)point.freq_hz);
+            } else {
+                jsonAppendFixed(w, field == 1 ? point.mag : point.phase, field == 1 ? 3 : 2);
+            }
+        }
+        jsonAppend(w, "]");
+    }
+    jsonAppend(w, "}");
+    if (w.full) {
+        sendBLEError("Session does not fit");
+        return false;
+    }
+    return sendBLEString(historyMsg);
+}
+
 /*=========================UTILITY=========================*/
 void enableBLE(bool enable) {
     if (enable) {
-        Serial.println("[BLE] Enabling BLE advertising...");
+        Console.println("[BLE] Enabling BLE advertising...");
         pServer->startAdvertising();
     } else {
-        Serial.println("[BLE] Disabling BLE advertising...");
+        Console.println("[BLE] Disabling BLE advertising...");
         pServer->getAdvertising()->stop();
     }
 }
+
+void setBLEAdvertisingSlow(bool slow) {
+    if (pServer == nullptr || slow == advertisingSlow) {
+        return;
+    }
+    advertisingSlow = slow;
+    // New intervals take effect on the next start
+    BLEAdvertising* pAdvertising = pServer->getAdvertising();
+    pAdvertising->stop();
+    pAdvertising->setMinInterval(slow ? BLE_ADV_SLOW_MIN_INT : BLE_ADV_FAST_MIN_INT);
+    pAdvertising->setMaxInterval(slow ? BLE_ADV_SLOW_MAX_INT : BLE_ADV_FAST_MAX_INT);
+    if (getBLEClientCount() < BLE_MAX_CLIENTS) {
+        pAdvertising->start();
+    }
+    Console.printf("[BLE] %s advertising\n", slow ? "Slow" : "Fast");
+}
+
+bool isBLEAdvertisingSlow() {
+    return advertisingSlow;
+}
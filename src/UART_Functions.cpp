@@ -1,441 +1,2071 @@
 #include "UART_Functions.h"
-
-// UART serial instance
-HardwareSerial UARTSerial(1);  // Use Serial1 for ESP32-C6
-
-// Queue handle for sending measurement points to processing task
+#include "console.h"
+#include "crc.h"
+#include "log.h"
+#include "trace.h"
+#include "sweep_stats.h"
+#include "sweep_table.h"
+#include "repeat_filter.h"
+#include "repeat_plan.h"
+#include "meas_session.h"
+#include "gui_state.h"
+#include "stm32_sim.h"
+#include "heap_stats.h"
+#include "sweep_watchdog.h"
+#include "sweep_eta.h"
+#include "counters.h"
+#include "calibration.h"
+
+// Queue handle for sending filled measurement batches to processing task
 static QueueHandle_t measurementQueueHandle = nullptr;
 
-// Semaphore for signaling when data is received
-static SemaphoreHandle_t uartDataSemaphore = nullptr;
+// Batch pool - free batches cycle through freeBatchQueue, filled ones through measurementQueueHandle
+static MeasurementBatch batchPool[MEASUREMENT_BATCH_POOL];
+static QueueHandle_t freeBatchQueue = nullptr;
+static uint8_t freeBatchStorage[MEASUREMENT_BATCH_POOL * sizeof(MeasurementBatch*)];
+static StaticQueue_t freeBatchControl;
+static MeasurementBatch* currentBatch[MAX_DUT_COUNT] = {};     // Batch being filled per DUT
 
-// Semaphores for event signaling to GUI task
-static SemaphoreHandle_t dutCompleteSemaphore = nullptr;
-static SemaphoreHandle_t measurementCompleteSemaphore = nullptr;
+// DUT completion events to the GUI task
+static QueueHandle_t dutCompleteQueue = nullptr;
+static uint8_t dutCompleteStorage[DUT_COMPLETE_QUEUE_DEPTH * sizeof(DUTCompleteEvent)];
+static StaticQueue_t dutCompleteControl;
 
 // DUT completion tracking
-static uint8_t completedDUTIndex = 0;
 static uint8_t totalExpectedDUTs = 4;  // Default to 4, updated on START command
 static uint8_t completedDUTCount = 0;
 
-// Circular buffer for ISR byte collection
-#define CIRC_BUFFER_SIZE 512
-static uint8_t circBuffer[CIRC_BUFFER_SIZE];
-static volatile uint16_t circBufferHead = 0;
-static volatile uint16_t circBufferTail = 0;
-
-// Receiver context (used by processing task, not ISR)
-static UARTRxContext rxContext;
+// CMD_START_MASKED support, learned from the first masked START
+enum MaskedStartSupport : uint8_t { MASKED_START_UNKNOWN, MASKED_START_SUPPORTED, MASKED_START_UNSUPPORTED };
+
+static constexpr uint32_t tuneRates[] = UART_TUNE_BAUD_RATES;
+static constexpr int TUNE_RATE_COUNT = sizeof(tuneRates) / sizeof(tuneRates[0]);
+
+// One STM32 front end on its own UART (UART_LINK_COUNT)
+struct UARTLink {
+    uint8_t index;
+    uart_port_t port;
+    int rxPin, txPin;
+    uint8_t dutOffset;                  // Session DUTs before the link's DUT 1
+    uint8_t dutCount;                   // Session DUTs the link sweeps
+
+    QueueHandle_t eventQueue;           // UART driver events (created by uart_driver_install)
+    UARTRxContext rx;                   // Reader task only
+    volatile bool rxResetRequested;     // A rate change wants the RX stream dropped - set by requestRxReset()
+    UARTStats stats;
+
+    // ACK reception - one event bit per command type (UART_ACK_BIT). Link 0's
+    // group also carries the command task's request bits
+    EventGroupHandle_t ackGroup;
+    StaticEventGroup_t ackGroupControl; // Links other than 0
+    volatile bool peerSupportsV2;       // Set once the STM32 sends a v2 frame - commands are then sequenced
+    uint8_t nextSeq;
+
+    // Active link rate and whether negotiation has been attempted since the last reset
+    uint32_t baudRate;
+    bool baudNegotiated;
+    MaskedStartSupport maskedStart;
+    bool gainPlanUnsupported;           // The STM32 did not ACK a plan
+    bool repeatPlanUnsupported;         // ... nor a repeat plan
+    bool gainLimitsUnsupported;         // ... nor gain limits
+
+    // Credit flow control (START_FLAG_CREDITS) - the counters are relative to
+    // the START ACK, as on the STM32
+    volatile bool creditSweep;          // The running sweep was started with the flag
+    volatile uint32_t creditFrames;     // Frequency frames the STM32 sent (received + lost) - reader task
+    uint32_t creditBase;                // creditFrames at the START ACK
+    uint32_t creditGranted;             // Highest limit sent
+
+    // Link tuning (UART_LINK_TUNING) - command task, but the LINK_TEST counts
+    bool linkTestUnsupported;           // The STM32 never answered a CMD_LINK_TEST
+    uint32_t tuneCap;                   // Fastest rate the next tuning may keep, 0 = any
+    int16_t tuneErrors[TUNE_RATE_COUNT];// Frames lost per rate at the last tuning, -1 = not tested
+    uint32_t tuneFrameMark;             // Frames parsed / link errors when last judged
+    uint32_t tuneErrorMark;
+    volatile uint32_t testSeed;         // Of the burst being received
+    volatile uint16_t testGood;         // Intact LINK_TEST frames of that burst - reader task
+    volatile uint16_t testBad;
+};
+
+static_assert(UART_LINK_COUNT >= 1 && UART_LINK_COUNT <= UART_LINK_MAX, "UART_LINK_COUNT: 1 or 2 links");
+
+// The flash-safe ISR path needs the driver's ring and queue ISR calls in IRAM too
+#if CONFIG_RINGBUF_PLACE_ISR_FUNCTIONS_INTO_FLASH || CONFIG_FREERTOS_PLACE_FUNCTIONS_INTO_FLASH
+#error "UART ingest needs the ring buffer and FreeRTOS ISR functions in IRAM"
+#endif
+
+static constexpr uint32_t maxBaudRate() {
+    constexpr uint32_t rates[] = UART_FAST_BAUD_RATES;
+    uint32_t fastest = UART_BAUD_RATE;
+    for (uint32_t rate : rates) {
+        fastest = rate > fastest ? rate : fastest;
+    }
+    for (uint32_t rate : tuneRates) {
+        fastest = rate > fastest ? rate : fastest;
+    }
+    return fastest;
+}
+// 10 bits per byte (8N1)
+static_assert(UART_RX_RING_SIZE >= maxBaudRate() / 10 * UART_FLASH_STALL_MS / 1000,
+              "UART_RX_RING_SIZE must hold a flash stall at the fastest rate");
+static_assert(UART_LINK_COUNT == 1 || UART_LINK_DUTS * (UART_LINK_COUNT - 1) < MAX_DUT_COUNT,
+              "Every link needs DUTs");
+
+static UARTLink links[UART_LINK_COUNT];
+static volatile uint8_t lastRxLink = 0;     // Link of the last frame (getCurrentDUT)
+
+#if UART_LINK_COUNT > 1
+// The reader task waits on all links' driver queues at once. Heap-allocated
+// at boot - the IDF's FreeRTOS has no static queue set
+static QueueSetHandle_t linkEventSet = nullptr;
+#endif
+
+// Link 0's ACK group: request / sequenced ACK bits of the command task
+static EventGroupHandle_t ackEventGroup = nullptr;
+static StaticEventGroup_t ackEventControl;
+
+// Asynchronous command requests/results
+static QueueHandle_t cmdRequestQueue = nullptr;
+static QueueHandle_t cmdResultQueue = nullptr;
+static uint8_t cmdRequestStorage[UART_CMD_REQUEST_QUEUE_DEPTH * sizeof(UARTCommandRequest)];
+static uint8_t cmdResultStorage[UART_CMD_RESULT_QUEUE_DEPTH * sizeof(UARTCommandResult)];
+static StaticQueue_t cmdRequestControl;
+static StaticQueue_t cmdResultControl;
+static volatile bool startPending = false;
+
+// Pipelined setting commands awaiting a sequenced ACK
+struct InFlightCommand {
+    bool active;
+    uint8_t seq;
+    uint8_t retries;
+    uint32_t sentAt;
+    UARTCommandRequest req;
+};
+
+// Sequenced ACK handed from the parser to the command task
+struct SeqAck {
+    uint8_t cmd;
+    uint8_t seq;
+};
+
+// Link 0's window only
+static InFlightCommand inFlight[UART_CMD_WINDOW];
+static int inFlightCount = 0;
+static QueueHandle_t seqAckQueue = nullptr;
+static uint8_t seqAckStorage[UART_CMD_SEQ_ACK_QUEUE_DEPTH * sizeof(SeqAck)];
+static StaticQueue_t seqAckControl;
+static UARTCommandRequest heldRequest;      // Dequeued but waiting for window space / drain
+static bool heldRequestValid = false;
+
+// Frequency-major sweeps across DUTs (START_FLAG_INTERLEAVED)
+static bool interleavedSweep = false;
+
+// FREQUENCY_IDX frames (START_FLAG_INDEXED)
+static bool indexedFrames = UART_INDEXED_FRAMES;
+
+// FREQUENCY_BLOCK frames (START_FLAG_BLOCKS), quantized (START_FLAG_COMPACT)
+static bool blockFrames = UART_BLOCK_FRAMES;
+static bool compactFrames = UART_COMPACT_FRAMES;
+
+// Hand every point to the processor at once instead of filling batches
+static volatile bool liveHandover = false;
+
+// DUTs whose DUT_START came and whose next batch is not yet taken - reader task only
+static uint32_t dutStartPending = 0;
+
+// Baseline gains for the final sweep (CMD_SET_GAIN_PLAN), by session DUT
+static bool gainHints = UART_GAIN_HINTS;
+static uint8_t gainPlan[MAX_DUT_COUNT][SWEEP_FREQ_COUNT];
+
+// Calibration coverage before a START (CMD_SET_GAIN_LIMITS)
+static bool gainLimits = UART_GAIN_LIMITS;
+
+// Credit flow control (START_FLAG_CREDITS) - per link counters in UARTLink
+static bool flowCredits = UART_FLOW_CREDITS;
+static uint32_t creditGrants = 0;
+static volatile uint32_t creditHolds = 0;       // Times an STM32 reached its limit
+static portMUX_TYPE creditMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Link tuning - per link results in UARTLink
+static bool linkTuning = UART_LINK_TUNING;
+
+// Link 0's STM32 unique ID - written by the reader task, read by the GUI task
+static portMUX_TYPE deviceIdMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t deviceId[3];
+static bool deviceIdValid = false;
+
+
+// Frame handler for the parser (uart_frame.h) - routes payloads to the handlers below
+static void dispatchFrame(uint8_t type, const uint8_t* payload, size_t len, bool v2, void* context);
 
-// ACK reception tracking
-static volatile bool ackReceived = false;
-static volatile uint8_t ackCmdType = 0;
+/*=========================INITIALIZATION=========================*/
 
-extern int frequencyCount[MAX_DUT_COUNT];
+// Drop any partial frame - the next byte is treated as a fresh stream
+static void resetRxContext(UARTLink& link) {
+    link.rx.stage.len = 0;
+    link.rx.stage.outOfSync = false;
+}
 
-/*=========================CIRCULAR BUFFER HELPERS=========================*/
+// Reader task: drop the RX stream if a rate change asked for it, and say so
+static void serviceRxReset(UARTLink& link) {
+    if (link.rxResetRequested) {
+        link.rxResetRequested = false;
+        uart_flush_input(link.port);
+        resetRxContext(link);
+        xEventGroupSetBits(link.ackGroup, UART_RX_RESET_BIT);
+    }
+}
 
-// Check if buffer has data available
-static inline bool circBufferAvailable() {
-    return circBufferHead != circBufferTail;
+// " (link n)" after link messages when there is more than one link
+static const char* linkName(const UARTLink& link) {
+    static const char* const names[UART_LINK_MAX] = {" (link 0)", " (link 1)"};
+    return UART_LINK_COUNT > 1 ? names[link.index] : "";
 }
 
-// Read one byte from circular buffer (call from task, not ISR)
-static uint8_t circBufferRead() {
-    uint8_t byte = circBuffer[circBufferTail];
-    circBufferTail = (circBufferTail + 1) % CIRC_BUFFER_SIZE;
-    return byte;
+// Session DUT of a link's DUT, 0 for a DUT the link does not have
+static uint8_t sessionDUT(const UARTLink& link, uint8_t dut) {
+    if (dut < 1 || dut > link.dutCount) {
+        LOG_W("WARNING: DUT %d out of range%s\n", dut, linkName(link));
+        return 0;
+    }
+    return link.dutOffset + dut;
 }
 
-// Write one byte to circular buffer (call from ISR)
-static inline void circBufferWrite(uint8_t byte) {
-    uint16_t nextHead = (circBufferHead + 1) % CIRC_BUFFER_SIZE;
-    if (nextHead != circBufferTail) {  // Check for overflow
-        circBuffer[circBufferHead] = byte;
-        circBufferHead = nextHead;
+// Link sweeping session DUT dut (1-based)
+static UARTLink& linkOfDUT(uint8_t dut) {
+    for (int i = UART_LINK_COUNT - 1; i > 0; i--) {
+        if (dut > links[i].dutOffset) {
+            return links[i];
+        }
     }
-    // If buffer full, oldest data is dropped (could add error counter here)
+    return links[0];
 }
 
-/*=========================INTERRUPT CALLBACK=========================*/
+// Install the driver of one link at UART_BAUD_RATE 8N1
+static void initLink(UARTLink& link, uint8_t index, uart_port_t port, int rxPin, int txPin) {
+    link.index = index;
+    link.port = port;
+    link.rxPin = rxPin;
+    link.txPin = txPin;
+    link.dutOffset = index * UART_LINK_DUTS;
+    link.dutCount = index == UART_LINK_COUNT - 1 ? MAX_DUT_COUNT - link.dutOffset : UART_LINK_DUTS;
+    link.ackGroup = index == 0 ? ackEventGroup : xEventGroupCreateStatic(&link.ackGroupControl);
+    link.baudRate = UART_BAUD_RATE;
+    for (int i = 0; i < TUNE_RATE_COUNT; i++) {
+        link.tuneErrors[i] = -1;
+    }
 
-// UART receive interrupt callback - called when data arrives
-// MINIMAL ISR - only buffers bytes and signals task
-void IRAM_ATTR onUARTReceive() {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uart_config_t config = {};
+    config.baud_rate = UART_BAUD_RATE;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    config.source_clk = UART_SCLK_DEFAULT;
+
+    // Install driver with an event queue - the driver ISR drains the HW FIFO
+    // into its ring buffer and posts one event per block, not per byte. The ISR
+    // is placed in IRAM by CONFIG_UART_ISR_IN_IRAM (the driver ignores
+    // ESP_INTR_FLAG_IRAM); events lost while the reader is held off by a
+    // flash write are harmless, as UART_DATA reads everything buffered
+    uart_driver_install(port, UART_RX_RING_SIZE, UART_TX_RING_SIZE,
+                        UART_EVENT_QUEUE_DEPTH, &link.eventQueue, 0);
+    uart_param_config(port, &config);
+    uart_set_pin(port, txPin, rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    uart_set_rx_timeout(port, UART_RX_TIMEOUT_SYMBOLS);
+
+    // Initialize receiver
+    resetRxContext(link);
+    link.rx.currentDUT = 0;
+    memset(link.rx.expectedFreqCount, 0, sizeof(link.rx.expectedFreqCount));
+    memset(link.rx.framesSinceStart, 0, sizeof(link.rx.framesSinceStart));
+    memset(link.rx.nextSeq, 0, sizeof(link.rx.nextSeq));
+    memset(link.rx.lastFreqIdx, SWEEP_FREQ_INVALID, sizeof(link.rx.lastFreqIdx));
+
+    Console.printf("UART initialized%s: RX=GPIO%d, TX=GPIO%d, Baud=%d\n",
+                  linkName(link), rxPin, txPin, UART_BAUD_RATE);
+    if (UART_LINK_COUNT > 1) {
+        Console.printf("  DUTs %d-%d\n", link.dutOffset + 1, link.dutOffset + link.dutCount);
+    }
+}
 
-    // Copy all available bytes to circular buffer (fast operation)
-    while (UARTSerial.available()) {
-        uint8_t byte = UARTSerial.read();
-        circBufferWrite(byte);
+void initUART(QueueHandle_t measurementQueue) {
+    measurementQueueHandle = measurementQueue;
+
+    // ACK signaling and async command queues
+    ackEventGroup = xEventGroupCreateStatic(&ackEventControl);
+    cmdRequestQueue = xQueueCreateStatic(UART_CMD_REQUEST_QUEUE_DEPTH, sizeof(UARTCommandRequest),
+                                         cmdRequestStorage, &cmdRequestControl);
+    cmdResultQueue = xQueueCreateStatic(UART_CMD_RESULT_QUEUE_DEPTH, sizeof(UARTCommandResult),
+                                        cmdResultStorage, &cmdResultControl);
+    seqAckQueue = xQueueCreateStatic(UART_CMD_SEQ_ACK_QUEUE_DEPTH, sizeof(SeqAck), seqAckStorage, &seqAckControl);
+
+    // Fill the free pool with all preallocated batches
+    freeBatchQueue = xQueueCreateStatic(MEASUREMENT_BATCH_POOL, sizeof(MeasurementBatch*),
+                                        freeBatchStorage, &freeBatchControl);
+    for (int i = 0; i < MEASUREMENT_BATCH_POOL; i++) {
+        MeasurementBatch* batch = &batchPool[i];
+        xQueueSend(freeBatchQueue, &batch, 0);
     }
 
-    // Signal semaphore to wake up processing task
-    if (uartDataSemaphore != nullptr) {
-        xSemaphoreGiveFromISR(uartDataSemaphore, &xHigherPriorityTaskWoken);
+    // DUT completion events for the GUI task
+    dutCompleteQueue = xQueueCreateStatic(DUT_COMPLETE_QUEUE_DEPTH, sizeof(DUTCompleteEvent),
+                                          dutCompleteStorage, &dutCompleteControl);
+
+    // Configure UART1 for 3600 baud 8N1 on pins 2 (RX) and 3 (TX), UART0 for a second front end
+    initLink(links[0], 0, UART_PORT_NUM, UART_RX_PIN, UART_TX_PIN);
+#if UART_LINK_COUNT > 1
+    initLink(links[1], 1, UART_LINK1_PORT, UART_LINK1_RX_PIN, UART_LINK1_TX_PIN);
+    linkEventSet = xQueueCreateSet(UART_EVENT_QUEUE_DEPTH * UART_LINK_COUNT);
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        xQueueAddToSet(links[i].eventQueue, linkEventSet);
     }
+#endif
+    Console.println("Block reception enabled (ESP-IDF UART driver event queue)");
+#if !CONFIG_UART_ISR_IN_IRAM
+    Console.println("WARNING: UART ISR in flash - STM32 bytes may be lost during flash writes");
+#endif
+}
+
+QueueHandle_t getUARTEventQueue(uint8_t link) {
+    return link < UART_LINK_COUNT ? links[link].eventQueue : nullptr;
+}
+
+uart_port_t getUARTLinkPort(uint8_t link) {
+    return links[link < UART_LINK_COUNT ? link : 0].port;
+}
+
+// Add one parse's frame counters to the link statistics
+static void addFrameCounters(UARTLink& link, const UARTFrameCounters& counters) {
+    link.stats.framesParsed += counters.framesParsed;
+    link.stats.bytesSkipped += counters.bytesSkipped;
+    link.stats.v2Frames += counters.v2Frames;
+    link.stats.crcErrors += counters.crcErrors;
+    link.stats.resyncs += counters.resyncs;
+}
 
-    // Yield if higher priority task was woken
-    if (xHigherPriorityTaskWoken == pdTRUE) {
-        portYIELD_FROM_ISR();
+// Parse the staging buffer in place and keep only the incomplete tail
+static size_t parseStage(UARTLink& link) {
+    UARTFrameCounters counters = {};
+    size_t frames = parseUARTStage(link.rx.stage, dispatchFrame, &link, counters);
+    addFrameCounters(link, counters);
+    return frames;
+}
+
+// Read everything the driver has buffered straight into the staging buffer
+// (after any partial frame left from the previous block) and parse it there
+// This runs in task context with full stack - safe for heavy processing
+static FieldHistogram rxReadBytes("uart.rx_read_bytes", COUNTER_BOUNDS_BYTES);
+static FieldCounter batchesDropped("uart.batch_drops");     // Batches the processing queue had no room for
+
+static size_t readPendingBytes(UARTLink& link, size_t pending) {
+    UARTFrameStage& stage = link.rx.stage;
+    size_t frames = 0;
+    while (pending > 0) {
+        size_t space = UART_RX_STAGE_SIZE - stage.len;
+        size_t toRead = min(pending, space);
+        int len = uart_read_bytes(link.port, stage.data + stage.len, toRead, 0);
+        if (len <= 0) {
+            break;
+        }
+        link.stats.bytesReceived += len;
+        link.stats.blocksReceived++;
+        rxReadBytes.record(len);
+#if STM32_SIM
+        // Another board's commands for the virtual STM32, not frames
+        if (link.index == 0 && getSTM32SimMode() == SIM_TX) {
+            stm32SimReceive(stage.data + stage.len, len);
+            pending -= len;
+            continue;
+        }
+#endif
+        stage.len += len;
+        size_t parsed = parseStage(link);
+        trace(TRACE_UART_BLOCK, len, parsed);
+        frames += parsed;
+        pending -= len;
     }
+    return frames;
 }
 
-/*=========================INITIALIZATION=========================*/
+// Discard buffered data after an overflow - the stream is no longer contiguous
+static void recoverFromOverflow(UARTLink& link) {
+    size_t buffered = 0;
+    uart_get_buffered_data_len(link.port, &buffered);
+    link.stats.bytesDropped += buffered;
+    trace(TRACE_UART_OVERFLOW, link.index, buffered);
+    uart_flush_input(link.port);
+    xQueueReset(link.eventQueue);
+    resetRxContext(link);
+    // The reset may have dropped a requestRxReset() wake-up
+    serviceRxReset(link);
+}
 
-void initUART(QueueHandle_t measurementQueue) {
-    measurementQueueHandle = measurementQueue;
+bool processUARTEvents(TickType_t timeout, size_t* framesOut) {
+    uart_event_t event;
+    size_t frames = 0;
 
-    // Create semaphores for signaling
-    uartDataSemaphore = xSemaphoreCreateBinary();
-    dutCompleteSemaphore = xSemaphoreCreateBinary();
-    measurementCompleteSemaphore = xSemaphoreCreateBinary();
+    if (framesOut != nullptr) {
+        *framesOut = 0;
+    }
+    UARTLink* link = &links[0];
+#if UART_LINK_COUNT > 1
+    QueueSetMemberHandle_t member = xQueueSelectFromSet(linkEventSet, timeout);
+    if (member == nullptr) {
+        return false;
+    }
+    for (int i = 1; i < UART_LINK_COUNT; i++) {
+        if (member == links[i].eventQueue) {
+            link = &links[i];
+        }
+    }
+    // Before any more bytes are parsed
+    serviceRxReset(*link);
+    // An overflow reset the queue behind the set's entry - nothing to read
+    if (xQueueReceive(link->eventQueue, &event, 0) != pdTRUE) {
+        return true;
+    }
+#else
+    if (xQueueReceive(link->eventQueue, &event, timeout) != pdTRUE) {
+        return false;
+    }
+    serviceRxReset(*link);
+#endif
+
+    switch (event.type) {
+        case UART_DATA: {
+            // event.size is what triggered the event; read all that is buffered
+            size_t buffered = 0;
+            uart_get_buffered_data_len(link->port, &buffered);
+            frames = readPendingBytes(*link, max(buffered, event.size));
+            if (frames > 0) {
+                grantFlowCredit();
+            }
+            break;
+        }
 
-    // Initialize UART with 3600 baud on pins 2 (RX) and 3 (TX)
-    UARTSerial.begin(UART_BAUD_RATE, SERIAL_8N1, UART_RX_PIN, UART_TX_PIN);
+        case UART_FIFO_OVF:
+            link->stats.fifoOverflows++;
+            Console.printf("WARNING: UART HW FIFO overflow%s - flushing input\n", linkName(*link));
+            recoverFromOverflow(*link);
+            break;
+
+        case UART_BUFFER_FULL:
+            link->stats.bufferFullEvents++;
+            Console.printf("WARNING: UART ring buffer full%s - flushing input\n", linkName(*link));
+            recoverFromOverflow(*link);
+            break;
 
-    // Attach interrupt callback for received data
-    UARTSerial.onReceive(onUARTReceive);
+        case UART_FRAME_ERR:
+        case UART_PARITY_ERR:
+            link->stats.frameErrors++;
+            break;
+
+        default:
+            break;
+    }
 
-    // Initialize receiver state machine
-    rxContext.state = WAITING_START;
-    rxContext.byteCount = 0;
-    rxContext.expectedBytes = 0;
-    rxContext.packetType = 0;
-    rxContext.currentDUT = 0;
-    rxContext.expectedFreqCount = 0;
+    if (framesOut != nullptr) {
+        *framesOut = frames;
+    }
+    return true;
+}
 
-    Serial.printf("UART initialized: RX=GPIO%d, TX=GPIO%d, Baud=%d\n",
-                  UART_RX_PIN, UART_TX_PIN, UART_BAUD_RATE);
-    Serial.println("Interrupt-driven reception enabled (Arduino onReceive)");
+UARTStats getUARTStats() {
+    static_assert(sizeof(UARTStats) % sizeof(uint32_t) == 0, "UARTStats holds only counters");
+    UARTStats sum = {};
+    uint32_t* total = reinterpret_cast<uint32_t*>(&sum);
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        const uint32_t* counters = reinterpret_cast<const uint32_t*>(&links[i].stats);
+        for (size_t k = 0; k < sizeof(UARTStats) / sizeof(uint32_t); k++) {
+            total[k] += counters[k];
+        }
+    }
+    return sum;
 }
 
-SemaphoreHandle_t getUARTSemaphore() {
-    return uartDataSemaphore;
+UARTStats getUARTLinkStats(uint8_t link) {
+    return link < UART_LINK_COUNT ? links[link].stats : UARTStats{};
 }
 
-// Process all buffered bytes from circular buffer
-// This runs in task context with full stack - safe for heavy processing
-void processBufferedBytes() {
-    while (circBufferAvailable()) {
-        uint8_t byte = circBufferRead();
-        processIncomingByte(byte);
+void resetUARTStats() {
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        links[i].stats = {};
     }
 }
 
 /*=========================COMMAND SENDING=========================*/
 
-bool sendCommand(uint8_t cmd_type, uint32_t data1, uint32_t data2, uint32_t data3) {
+#if STM32_SIM
+// The virtual STM32 owns the link - loopback commands go to it, and a board
+// acting as the STM32 of another one sends none of its own
+static bool divertToSimulator(uint8_t cmd_type, uint8_t seq, bool v2, uint32_t data1, uint32_t data2, uint32_t data3) {
+    STM32SimMode simMode = getSTM32SimMode();
+    if (simMode == SIM_LOOPBACK) {
+        trace(TRACE_UART_CMD_TX, cmd_type, v2 ? seq : 0xFFFF);
+        stm32SimCommand(cmd_type, seq, v2, data1, data2, data3);
+    } else if (simMode == SIM_TX) {
+        LOG_W("Command 0x%02X not sent - the board is a virtual STM32\n", cmd_type);
+    }
+    return simMode != SIM_OFF;
+}
+#endif
+
+// Build and send a v2 command frame carrying a sequence number
+static void transmitCommandV2(UARTLink& link, uint8_t cmd_type, uint8_t seq,
+                              uint32_t data1, uint32_t data2, uint32_t data3) {
+    uint8_t packet[UART_V2_HEADER_SIZE + sizeof(UARTCommandPayload) + UART_V2_CRC_SIZE];
+    size_t size = encodeUARTCommand(packet, {cmd_type, seq, data1, data2, data3}, true);
+
+    xEventGroupClearBits(link.ackGroup, UART_ACK_BIT(cmd_type));
+#if STM32_SIM
+    if (link.index == 0 && divertToSimulator(cmd_type, seq, true, data1, data2, data3)) {
+        return;
+    }
+#endif
+    trace(TRACE_UART_CMD_TX, cmd_type, seq);
+    uart_write_bytes(link.port, packet, size);
+}
+
+// Build and send a legacy command packet
+static void transmitCommandLegacy(UARTLink& link, uint8_t cmd_type, uint32_t data1, uint32_t data2, uint32_t data3) {
     uint8_t packet[UART_CMD_PACKET_SIZE];
+    encodeUARTCommand(packet, {cmd_type, 0, data1, data2, data3}, false);
+
+    // Clear a stale ACK before sending so a fast reply can't be missed
+    xEventGroupClearBits(link.ackGroup, UART_ACK_BIT(cmd_type));
+#if STM32_SIM
+    if (link.index == 0 && divertToSimulator(cmd_type, 0, false, data1, data2, data3)) {
+        return;
+    }
+#endif
 
-    // Build command packet (little-endian)
-    packet[0] = UART_CMD_START_BYTE;
-    packet[1] = cmd_type;
-
-    // data1 (4 bytes)
-    packet[2] = (data1 >> 0) & 0xFF;
-    packet[3] = (data1 >> 8) & 0xFF;
-    packet[4] = (data1 >> 16) & 0xFF;
-    packet[5] = (data1 >> 24) & 0xFF;
-
-    // data2 (4 bytes)
-    packet[6] = (data2 >> 0) & 0xFF;
-    packet[7] = (data2 >> 8) & 0xFF;
-    packet[8] = (data2 >> 16) & 0xFF;
-    packet[9] = (data2 >> 24) & 0xFF;
-
-    // data3 (4 bytes)
-    packet[10] = (data3 >> 0) & 0xFF;
-    packet[11] = (data3 >> 8) & 0xFF;
-    packet[12] = (data3 >> 16) & 0xFF;
-    packet[13] = (data3 >> 24) & 0xFF;
-
-    packet[14] = UART_CMD_END_BYTE;
-
-    // Send packet
-    UARTSerial.write(packet, UART_CMD_PACKET_SIZE);
-    UARTSerial.flush();
+    trace(TRACE_UART_CMD_TX, cmd_type, 0xFFFF);
+    uart_write_bytes(link.port, packet, UART_CMD_PACKET_SIZE);
+}
+
+static bool sendLinkCommand(UARTLink& link, uint8_t cmd_type, uint32_t data1, uint32_t data2, uint32_t data3) {
+    // v2 peers get sequenced, CRC-protected commands
+    if (link.peerSupportsV2) {
+        transmitCommandV2(link, cmd_type, link.nextSeq++, data1, data2, data3);
+    } else {
+        transmitCommandLegacy(link, cmd_type, data1, data2, data3);
+    }
+
+    // Wait until the packet has left the TX FIFO
+    uart_wait_tx_done(link.port, pdMS_TO_TICKS(100));
+    return true;
+}
+
+// Sleep until the parser sets the link's ACK bit (cleared on return)
+static bool waitForLinkAck(UARTLink& link, uint8_t cmd_type, uint32_t timeout_ms) {
+    EventBits_t bits = xEventGroupWaitBits(link.ackGroup, UART_ACK_BIT(cmd_type),
+                                           pdTRUE, pdTRUE, pdMS_TO_TICKS(timeout_ms));
+    if (bits & UART_ACK_BIT(cmd_type)) {
+        return true;
+    }
+
+    // Timeout - no ACK received
+    Console.printf("WARNING: No ACK received for command 0x%02X%s\n", cmd_type, linkName(link));
+    return false;
+}
+
+bool sendCommand(uint8_t cmd_type, uint32_t data1, uint32_t data2, uint32_t data3) {
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        sendLinkCommand(links[i], cmd_type, data1, data2, data3);
+    }
     return true;
 }
 
 bool sendStartCommand() {
-    Serial.println("Sending START command to STM32 (4 DUTs)");
+    Console.println("Sending START command to STM32 (4 DUTs)");
     return sendStartCommand(4);
 }
 
-bool sendStartCommand(uint8_t num_duts, uint8_t startIDX, uint8_t endIDX) {
-    // Clear frequency counts
-    for (int i = 0; i < MAX_DUT_COUNT; i++) {
-        frequencyCount[i] = 0;
+// START data1: DUT count, sweep order flags, repeats per frequency and first DUT
+static uint32_t startFlags(uint8_t num_duts, uint8_t firstDut, bool gainPlanSent, bool gainLimitsSent) {
+    uint32_t flags = num_duts | (interleavedSweep ? START_FLAG_INTERLEAVED : 0) |
+                     (indexedFrames ? START_FLAG_INDEXED : 0) | (gainPlanSent ? START_FLAG_GAIN_PLAN : 0) |
+                     (gainLimitsSent ? START_FLAG_GAIN_LIMITS : 0) |
+                     (flowCredits ? START_FLAG_CREDITS : 0) |
+                     (blockFrames && !interleavedSweep ? START_FLAG_BLOCKS : 0) |
+                     (blockFrames && compactFrames && !interleavedSweep ? START_FLAG_COMPACT : 0);
+    uint8_t repeats = getSweepRepeats();
+    if (repeats > 1) {
+        flags |= (uint32_t)repeats << START_REPEATS_SHIFT;
     }
-    Serial.printf("Sending START command to STM32 (%d DUT%s)\n", num_duts, num_duts > 1 ? "s" : "");
-    totalExpectedDUTs = num_duts;
-    completedDUTCount = 0;  // Reset counter
+    if (isRepeatPlanApplied()) {
+        flags |= START_FLAG_REPEAT_PLAN;
+    }
+    if (firstDut > 1) {
+        flags |= (uint32_t)firstDut << START_FIRST_DUT_SHIFT;
+    }
+    return flags;
+}
 
-    // Retry up to 3 times if no ACK
-    for (int attempt = 0; attempt < 3; attempt++) {
-        sendCommand(CMD_START_MEASUREMENT, num_duts, startIDX, endIDX);
+void setInterleavedSweep(bool enable) {
+    interleavedSweep = enable;
+}
+
+bool isInterleavedSweep() {
+    return interleavedSweep;
+}
+
+void setIndexedFrames(bool enable) {
+    indexedFrames = enable;
+}
+
+bool isIndexedFrames() {
+    return indexedFrames;
+}
+
+void setBlockFrames(bool enable) {
+    blockFrames = enable;
+}
+
+bool isBlockFrames() {
+    return blockFrames;
+}
+
+void setCompactFrames(bool enable) {
+    compactFrames = enable;
+}
+
+bool isCompactFrames() {
+    return compactFrames;
+}
+
+void setGainHints(bool enable) {
+    gainHints = enable;
+}
+
+bool isGainHints() {
+    return gainHints;
+}
+
+void setGainLimits(bool enable) {
+    gainLimits = enable;
+}
+
+bool isGainLimits() {
+    return gainLimits;
+}
+
+void setFlowCredits(bool enable) {
+    flowCredits = enable;
+}
+
+bool isFlowCredits() {
+    return flowCredits;
+}
+
+void clearGainPlan() {
+    memset(gainPlan, 0, sizeof(gainPlan));
+}
+
+void setGainPlanHint(uint8_t dut, uint8_t freqIdx, uint8_t hint) {
+    if (dut < MAX_DUT_COUNT && freqIdx < SWEEP_FREQ_COUNT) {
+        gainPlan[dut][freqIdx] = hint;
+    }
+}
+
+// Send the link DUTs' gain plan in GAIN_PLAN_CHUNK pieces, leaving out pieces
+// without a hint. Returns true if the STM32 ACKed all of it
+static bool sendGainPlan(UARTLink& link, uint8_t num_duts, uint8_t firstDut) {
+    if (link.gainPlanUnsupported) {
+        return false;
+    }
+    int sent = 0;
+    for (uint8_t dut = max((int)firstDut, 1); dut <= min((int)num_duts, (int)link.dutCount); dut++) {
+        const uint8_t* hints = gainPlan[link.dutOffset + dut - 1];
+        for (int first = 0; first < SWEEP_FREQ_COUNT; first += GAIN_PLAN_CHUNK) {
+            int count = min(GAIN_PLAN_CHUNK, SWEEP_FREQ_COUNT - first);
+            uint32_t words[2] = {0, 0};
+            bool any = false;
+            for (int k = 0; k < count; k++) {
+                words[k / 4] |= (uint32_t)hints[first + k] << (8 * (k % 4));
+                any = any || (hints[first + k] & GAIN_HINT_VALID);
+            }
+            if (!any) {
+                continue;
+            }
+            uint32_t data1 = dut | (uint32_t)first << GAIN_PLAN_FIRST_SHIFT | (uint32_t)count << GAIN_PLAN_COUNT_SHIFT;
+            sendLinkCommand(link, CMD_SET_GAIN_PLAN, data1, words[0], words[1]);
+            if (!waitForLinkAck(link, CMD_SET_GAIN_PLAN, UART_GAIN_PLAN_ACK_MS)) {
+                // Older firmware never ACKs it - a half-sent plan is dropped by the plain START
+                Console.printf("Gain plan not supported%s - autoranging every point\n", linkName(link));
+                link.gainPlanUnsupported = true;
+                return false;
+            }
+            sent++;
+        }
+    }
+    HAL_PRINTF("Gain plan sent%s (%d command%s)\n", linkName(link), sent, sent != 1 ? "s" : "");
+    return sent > 0;
+}
+
+// Send the repeat plan of the indices in mask in REPEAT_PLAN_CHUNK pieces
+// Returns true if the STM32 ACKed all of it
+static bool sendRepeatPlan(UARTLink& link, SweepMask mask) {
+    if (link.repeatPlanUnsupported) {
+        return false;
+    }
+    const RepeatPlan& plan = getRepeatPlan();
+    for (int first = 0; first < SWEEP_FREQ_COUNT; first += REPEAT_PLAN_CHUNK) {
+        int count = min(REPEAT_PLAN_CHUNK, SWEEP_FREQ_COUNT - first);
+        if (!(mask & ((((SweepMask)1 << count) - 1) << first))) {
+            continue;
+        }
+        uint32_t words[2] = {0, 0};
+        for (int k = 0; k < count; k++) {
+            words[k / 4] |= (uint32_t)getRepeatPlanCount(plan, first + k) << (8 * (k % 4));
+        }
+        sendLinkCommand(link, CMD_SET_REPEAT_PLAN, first | (uint32_t)count << REPEAT_PLAN_COUNT_SHIFT,
+                        words[0], words[1]);
+        if (!waitForLinkAck(link, CMD_SET_REPEAT_PLAN, UART_GAIN_PLAN_ACK_MS)) {
+            Console.printf("Repeat plan not supported%s - %d repeats everywhere\n", linkName(link),
+                           getSweepRepeats());
+            link.repeatPlanUnsupported = true;
+            return false;
+        }
+    }
+    HAL_PRINTF("Repeat plan sent%s\n", linkName(link));
+    return true;
+}
+
+// Send the calibration coverage of the indices in mask that lack a gain
+// combination, in GAIN_LIMIT_CHUNK pieces. Fully covered pieces are left out,
+// and so is an index without any calibration - limiting it would save
+// nothing. Returns true if something was sent and the STM32 ACKed all of it
+static bool sendGainLimits(UARTLink& link, SweepMask mask) {
+    if (!gainLimits || link.gainLimitsUnsupported) {
+        return false;
+    }
+    int sent = 0;
+    for (int first = 0; first < SWEEP_FREQ_COUNT; first += GAIN_LIMIT_CHUNK) {
+        int count = min(GAIN_LIMIT_CHUNK, SWEEP_FREQ_COUNT - first);
+        uint32_t words[2] = {0, 0};
+        bool any = false;
+        for (int k = 0; k < count; k++) {
+            uint16_t allowed = GAIN_LIMIT_ALL;
+            if (mask & ((SweepMask)1 << (first + k))) {
+                uint16_t covered = getCalibrationCoverage(first + k);
+                allowed = covered != 0 ? covered : GAIN_LIMIT_ALL;
+            }
+            words[k / 2] |= (uint32_t)allowed << (16 * (k % 2));
+            any = any || allowed != GAIN_LIMIT_ALL;
+        }
+        if (!any) {
+            continue;
+        }
+        sendLinkCommand(link, CMD_SET_GAIN_LIMITS, first | (uint32_t)count << GAIN_LIMIT_COUNT_SHIFT,
+                        words[0], words[1]);
+        if (!waitForLinkAck(link, CMD_SET_GAIN_LIMITS, UART_GAIN_PLAN_ACK_MS)) {
+            Console.printf("Gain limits not supported%s - uncalibrated gains may be measured\n", linkName(link));
+            link.gainLimitsUnsupported = true;
+            return false;
+        }
+        sent++;
+    }
+    if (sent > 0) {
+        HAL_PRINTF("Gain limits sent%s (%d command%s)\n", linkName(link), sent, sent != 1 ? "s" : "");
+    }
+    return sent > 0;
+}
+
+// START ACKed: the STM32 counts frames from here and waits for the first grant
+static void beginCreditSweep(UARTLink& link) {
+    if (!flowCredits) {
+        return;
+    }
+    portENTER_CRITICAL(&creditMux);
+    link.creditBase = link.creditFrames;
+    link.creditGranted = 0;
+    portEXIT_CRITICAL(&creditMux);
+    link.creditSweep = true;
+    grantFlowCredit(true);
+}
+
+static bool negotiateLinkBaudRate(UARTLink& link);
+static bool tuneLinkBaudRate(UARTLink& link);
+static void resetLinkBaudRate(UARTLink& link);
+static bool linkErrorsRose(UARTLink& link);
+static bool stopLink(UARTLink& link, uint8_t dut);
+
+// The link's part of session DUTs firstDut..num_duts in its own numbers;
+// false if it has none of them
+static bool getLinkShare(const UARTLink& link, uint8_t num_duts, uint8_t firstDut,
+                         uint8_t& linkDuts, uint8_t& linkFirst) {
+    int first = max((int)firstDut, link.dutOffset + 1);
+    int last = min((int)num_duts, link.dutOffset + link.dutCount);
+    if (first > last) {
+        return false;
+    }
+    linkDuts = last - link.dutOffset;
+    linkFirst = first - link.dutOffset;
+    return true;
+}
 
-        if (waitForAck(CMD_START_MEASUREMENT, 1000)) {
-            Serial.println("START command acknowledged");
+// START one link's DUTs - masked if mask != 0 and the STM32 takes it, else
+// over startIDX..endIDX. Retries up to 3 times
+static bool startLinkSweep(UARTLink& link, uint8_t num_duts, uint8_t firstDut, bool gainPlan,
+                           uint8_t startIDX, uint8_t endIDX, SweepMask mask) {
+    // Bring the link up to speed before the sweep starts streaming data
+    if (link.baudNegotiated && linkErrorsRose(link)) {
+        link.baudNegotiated = false;
+    }
+    if (!link.baudNegotiated) {
+        negotiateLinkBaudRate(link);
+    }
+    bool gainPlanSent = gainPlan && sendGainPlan(link, num_duts, firstDut);
+    bool gainLimitsSent = sendGainLimits(link, mask != 0 ? mask : getSweepRangeMask(startIDX, endIDX));
+
+    // Until the STM32 has ACKed one, a missing ACK most likely means it does not know the command
+    bool masked = mask != 0 && link.maskedStart != MASKED_START_UNSUPPORTED;
+    int attempts = masked && link.maskedStart == MASKED_START_UNKNOWN ? 1 : 3;
+    uint8_t cmd = masked ? CMD_START_MASKED : CMD_START_MEASUREMENT;
+    uint32_t flags = startFlags(num_duts, firstDut, gainPlanSent, gainLimitsSent);
+    for (int attempt = 0; attempt < attempts; attempt++) {
+        if (masked) {
+            sendLinkCommand(link, cmd, flags, (uint32_t)mask, (uint32_t)(mask >> 32));
+        } else {
+            sendLinkCommand(link, cmd, flags, startIDX, endIDX);
+        }
+
+        if (waitForLinkAck(link, cmd, 1000)) {
+            Console.printf("%s command acknowledged%s\n", masked ? "Masked START" : "START", linkName(link));
+            if (masked) {
+                link.maskedStart = MASKED_START_SUPPORTED;
+            }
+            beginCreditSweep(link);
             return true;  // Success
         }
 
-        Serial.printf("Retry %d/3...\n", attempt + 1);
+        if (attempts > 1) {
+            Console.printf("Retry %d/3...\n", attempt + 1);
+        }
         delay(100);  // Wait before retry
     }
 
-    Serial.println("ERROR: START command failed after 3 attempts");
+    // A plain START covers the mask's index range - and is all older firmware understands
+    if (masked && link.maskedStart == MASKED_START_UNKNOWN) {
+        Console.printf("Masked START not supported%s - sweeping index %d-%d\n", linkName(link), startIDX, endIDX);
+        link.maskedStart = MASKED_START_UNSUPPORTED;
+        return startLinkSweep(link, num_duts, firstDut, gainPlan, startIDX, endIDX, 0);
+    }
+
+    Console.printf("ERROR: %s command failed after 3 attempts%s\n", masked ? "Masked START" : "START",
+                   linkName(link));
+
+    // STM32 may have reset to the default rate - renegotiate on the next START
+    if (link.baudRate != UART_BAUD_RATE) {
+        resetLinkBaudRate(link);
+    }
     return false;
 }
 
-bool sendStopCommand() {
-    Serial.println("Sending STOP command to STM32");
+// START session DUTs firstDut..num_duts on every link that has some of them
+static bool startSweep(uint8_t num_duts, uint8_t firstDut, bool gainPlan,
+                       uint8_t startIDX, uint8_t endIDX, SweepMask mask) {
+    // Stored points and the repeat filter are reset by the data processor
+    // with the first batch of the new session (meas_session.h)
+    totalExpectedDUTs = firstDut > 1 ? num_duts - min(firstDut, num_duts) + 1 : num_duts;
+    completedDUTCount = 0;  // Reset counter
+    sweepStatsMark(MARK_START_SENT);
+    heapStatsSweepBegin();
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        links[i].creditSweep = false;
+    }
+
+    // Every link runs the plan or none does - the DUT budgets are per index
+    SweepMask planned = mask != 0 ? mask : getSweepRangeMask(startIDX, endIDX);
+    bool repeatPlan = isAdaptiveRepeats();
+    for (int i = 0; i < UART_LINK_COUNT && repeatPlan; i++) {
+        uint8_t linkDuts, linkFirst;
+        if (getLinkShare(links[i], num_duts, firstDut, linkDuts, linkFirst)) {
+            repeatPlan = sendRepeatPlan(links[i], planned);
+        }
+    }
+    setRepeatPlanApplied(repeatPlan, planned);
+
+    bool started[UART_LINK_COUNT] = {};
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        uint8_t linkDuts, linkFirst;
+        if (!getLinkShare(links[i], num_duts, firstDut, linkDuts, linkFirst)) {
+            continue;
+        }
+        if (!startLinkSweep(links[i], linkDuts, linkFirst, gainPlan, startIDX, endIDX, mask)) {
+            sweepStatsMark(MARK_START_FAILED);
+            // A sweep missing a link never completes - stop the links already running
+            for (int k = 0; k < i; k++) {
+                if (started[k]) {
+                    stopLink(links[k], STOP_SCOPE_ALL);
+                }
+            }
+            return false;
+        }
+        started[i] = true;
+    }
+    sweepStatsMark(MARK_START_ACKED);
+    return true;
+}
+
+bool sendStartCommand(uint8_t num_duts, uint8_t startIDX, uint8_t endIDX, uint8_t firstDut, bool gainPlan) {
+    HAL_PRINTF("Sending START command to STM32 (%d DUT%s)\n", num_duts, num_duts > 1 ? "s" : "");
+    if (firstDut > 1) {
+        HAL_PRINTF("Resuming at DUT %d\n", firstDut);
+    }
+    return startSweep(num_duts, firstDut, gainPlan, startIDX, endIDX, 0);
+}
+
+bool sendStartMaskedCommand(uint8_t num_duts, SweepMask mask, uint8_t firstDut, bool gainPlan) {
+    uint8_t firstIdx, lastIdx;
+    if (!getSweepMaskRange(mask, firstIdx, lastIdx)) {
+        Console.println("ERROR: Empty sweep mask");
+        return false;
+    }
+    // A plain START covers a single run
+    if (isSweepMaskContiguous(mask)) {
+        return sendStartCommand(num_duts, firstIdx, lastIdx, firstDut, gainPlan);
+    }
+
+    HAL_PRINTF("Sending masked START command to STM32 (%d DUT%s, %d frequencies)\n",
+               num_duts, num_duts > 1 ? "s" : "", __builtin_popcountll(mask));
+    return startSweep(num_duts, firstDut, gainPlan, firstIdx, lastIdx, mask);
+}
+
+// STOP one link - dut in the link's numbers or STOP_SCOPE_ALL
+static bool stopLink(UARTLink& link, uint8_t dut) {
+    if (dut == STOP_SCOPE_ALL) {
+        link.creditSweep = false;
+    }
 
     // Retry up to 3 times if no ACK
     for (int attempt = 0; attempt < 3; attempt++) {
-        sendCommand(CMD_END_MEASUREMENT, 0, 0, 0);
+        sendLinkCommand(link, CMD_END_MEASUREMENT, dut, 0, 0);
 
-        if (waitForAck(CMD_END_MEASUREMENT, 1000)) {
-            Serial.println("STOP command acknowledged");
+        if (waitForLinkAck(link, CMD_END_MEASUREMENT, 1000)) {
+            Console.printf("STOP command acknowledged%s\n", linkName(link));
             return true;  // Success
         }
 
-        Serial.printf("Retry %d/3...\n", attempt + 1);
+        Console.printf("Retry %d/3...\n", attempt + 1);
         delay(100);  // Wait before retry
     }
 
-    Serial.println("ERROR: STOP command failed after 3 attempts");
+    Console.printf("ERROR: STOP command failed after 3 attempts%s\n", linkName(link));
     return false;
 }
 
+bool sendStopCommand(uint8_t dut) {
+    if (dut == STOP_SCOPE_ALL) {
+        Console.println("Sending STOP command to STM32");
+        bool success = true;
+        for (int i = 0; i < UART_LINK_COUNT; i++) {
+            success = stopLink(links[i], STOP_SCOPE_ALL) && success;
+        }
+        return success;
+    }
+
+    Console.printf("Sending STOP command to STM32 (DUT %d only)\n", dut);
+    UARTLink& link = linkOfDUT(dut);
+    return stopLink(link, dut - link.dutOffset);
+}
+
 bool sendSetPGAGainCommand(uint8_t gain) {
-    Serial.printf("Sending SET_PGA_GAIN command: %d\n", gain);
-    sendCommand(CMD_SET_PGA_GAIN, gain, 0, 0);
-    return true;
+    Console.printf("Sending SET_PGA_GAIN command: %d\n", gain);
+    return queueUARTCommand(CMD_SET_PGA_GAIN, gain, 0, 0);
 }
 
 bool sendSetMuxChannelCommand(uint8_t channel) {
-    Serial.printf("Sending SET_MUX_CHANNEL command: %d\n", channel);
-    sendCommand(CMD_SET_MUX_CHANNEL, channel, 0, 0);
-    return true;
+    Console.printf("Sending SET_MUX_CHANNEL command: %d\n", channel);
+    return queueUARTCommand(CMD_SET_MUX_CHANNEL, channel, 0, 0);
 }
 
 bool sendSetTIAGainCommand(uint8_t low_gain) {
-    Serial.printf("Sending SET_TIA_GAIN command: %s\n", low_gain ? "LOW" : "HIGH");
-    sendCommand(CMD_SET_TIA_GAIN, low_gain, 0, 0);
+    Console.printf("Sending SET_TIA_GAIN command: %s\n", low_gain ? "LOW" : "HIGH");
+    return queueUARTCommand(CMD_SET_TIA_GAIN, low_gain, 0, 0);
+}
+
+/*=========================ASYNC COMMANDS=========================*/
+
+// Queue a request and wake the command task
+static bool enqueueRequest(const UARTCommandRequest& req) {
+    if (xQueueSend(cmdRequestQueue, &req, 0) != pdTRUE) {
+        Console.printf("ERROR: Command queue full - 0x%02X not sent\n", req.cmd_type);
+        return false;
+    }
+    xEventGroupSetBits(ackEventGroup, UART_CMD_REQUEST_BIT);
     return true;
 }
 
-/*=========================HELPER FUNCTIONS=========================*/
+bool queueUARTCommand(uint8_t cmd_type, uint32_t data1, uint32_t data2, uint32_t data3) {
+    UARTCommandRequest req = {cmd_type, data1, data2, data3, nullptr, nullptr};
+    return enqueueRequest(req);
+}
+
+// START requests carry the DUT count in data1 bits 0-7, the first DUT in bits
+// 8-15 and START_REQ_GAIN_PLAN
+#define START_REQ_DUTS(duts, firstDut)  ((uint32_t)(duts) | (uint32_t)(firstDut) << 8)
+#define START_REQ_COUNT(data1)          ((uint8_t)(data1))
+#define START_REQ_FIRST(data1)          ((uint8_t)((data1) >> 8))
+#define START_REQ_GAIN_PLAN             0x10000
+#define START_REQ_HAS_PLAN(data1)       (((data1) & START_REQ_GAIN_PLAN) != 0)
+
+// Stop request data2: reset the link if the STOP goes unanswered
+#define STOP_REQ_LINK_RESET     1
+
+static bool queueStartRequest(const UARTCommandRequest& req) {
+    if (startPending) {
+        Console.println("WARNING: START already pending");
+        return false;
+    }
+    // Set first - the command task may run the START and clear it before
+    // enqueueRequest() returns
+    startPending = true;
+    if (!enqueueRequest(req)) {
+        startPending = false;
+        return false;
+    }
+    return true;
+}
 
-// Convert 4 bytes to uint32 (little-endian)
-static uint32_t bytesToUint32(uint8_t* bytes) {
-    return (uint32_t)bytes[0] |
-           ((uint32_t)bytes[1] << 8) |
-           ((uint32_t)bytes[2] << 16) |
-           ((uint32_t)bytes[3] << 24);
+bool sendStartCommandAsync(uint8_t num_duts, uint8_t startIDX, uint8_t endIDX,
+                           UARTCommandCallback callback, void* context) {
+    UARTCommandRequest req = {CMD_START_MEASUREMENT, START_REQ_DUTS(num_duts, 1), startIDX, endIDX, callback, context};
+    return queueStartRequest(req);
 }
 
-// Convert 4 bytes to int32 (little-endian)
-static int32_t bytesToInt32(uint8_t* bytes) {
-    return (int32_t)bytesToUint32(bytes);
+bool sendStartMaskedCommandAsync(uint8_t num_duts, SweepMask mask,
+                                 UARTCommandCallback callback, void* context) {
+    UARTCommandRequest req = {CMD_START_MASKED, START_REQ_DUTS(num_duts, 1), (uint32_t)mask, (uint32_t)(mask >> 32),
+                              callback, context};
+    return queueStartRequest(req);
 }
 
-// Convert 4 bytes to float (IEEE 754)
-static float bytesToFloat(uint8_t* bytes) {
-    float result;
-    memcpy(&result, bytes, sizeof(float));
-    return result;
+bool sendSweepStartAsync(uint8_t num_duts, uint8_t startIDX, uint8_t endIDX, SweepMask mask,
+                         UARTCommandCallback callback, void* context, bool gainPlan) {
+    uint32_t duts = START_REQ_DUTS(num_duts, 1) | (gainPlan ? START_REQ_GAIN_PLAN : 0);
+    UARTCommandRequest req = mask != 0
+        ? UARTCommandRequest{CMD_START_MASKED, duts, (uint32_t)mask, (uint32_t)(mask >> 32), callback, context}
+        : UARTCommandRequest{CMD_START_MEASUREMENT, duts, startIDX, endIDX, callback, context};
+    return queueStartRequest(req);
 }
 
-// Parse and queue a frequency packet
-static void parseFrequencyPacket() {
-    MeasurementPoint point;
+bool sendSweepResumeAsync(uint8_t num_duts, uint8_t firstDut, uint8_t startIDX, uint8_t endIDX, SweepMask mask,
+                          UARTCommandCallback callback, void* context) {
+    UARTCommandRequest req = mask != 0
+        ? UARTCommandRequest{CMD_START_MASKED, START_REQ_DUTS(num_duts, firstDut), (uint32_t)mask,
+                             (uint32_t)(mask >> 32), callback, context}
+        : UARTCommandRequest{CMD_START_MEASUREMENT, START_REQ_DUTS(num_duts, firstDut), startIDX, endIDX,
+                             callback, context};
+    return queueStartRequest(req);
+}
 
-    // Parse frequency (4 bytes at index 2)
-    point.freq_hz = bytesToUint32(&rxContext.buffer[2]);
+bool sendStopCommandAsync(UARTCommandCallback callback, void* context) {
+    UARTCommandRequest req = {CMD_END_MEASUREMENT, 0, 0, 0, callback, context};
+    return enqueueRequest(req);
+}
 
-    // Parse voltage magnitude (4 bytes at index 6) - float
-    point.V_magnitude = bytesToFloat(&rxContext.buffer[6]);
+bool sendLinkResetAsync(UARTCommandCallback callback, void* context) {
+    UARTCommandRequest req = {CMD_END_MEASUREMENT, STOP_SCOPE_ALL, STOP_REQ_LINK_RESET, 0, callback, context};
+    return enqueueRequest(req);
+}
 
-    // Parse voltage phase (4 bytes at index 10) - float
-    float v_phase = bytesToFloat(&rxContext.buffer[10]);
+bool sendSkipDUTCommandAsync(uint8_t dut) {
+    UARTCommandRequest req = {CMD_END_MEASUREMENT, dut, 0, 0, nullptr, nullptr};
+    return enqueueRequest(req);
+}
 
-    // Parse current magnitude (4 bytes at index 14) - float
-    point.I_magnitude = bytesToFloat(&rxContext.buffer[14]);
+bool isV2CommandLink() {
+    return links[0].peerSupportsV2;
+}
 
-    // Parse current phase (4 bytes at index 18) - float
-    float i_phase = bytesToFloat(&rxContext.buffer[18]);
+bool isSweepStartPending() {
+    return startPending;
+}
 
-    // Calculate phase difference (V - I) and normalize to [-180, 180]
-    float phase_diff = v_phase - i_phase;
-    while (phase_diff > 180.0f) phase_diff -= 360.0f;
-    while (phase_diff < -180.0f) phase_diff += 360.0f;
-    point.phase_deg = phase_diff;
+// PGA/MUX/TIA can be pipelined; everything else is stop-and-wait
+static bool isSettingCommand(uint8_t cmd_type) {
+    return cmd_type == CMD_SET_PGA_GAIN ||
+           cmd_type == CMD_SET_MUX_CHANNEL ||
+           cmd_type == CMD_SET_TIA_GAIN;
+}
 
-    // Parse PGA gain (1 byte at index 22)
-    point.pga_gain = rxContext.buffer[22];
+// Run a START/STOP request with the blocking send/ACK/retry logic
+static void runBlockingRequest(const UARTCommandRequest& req) {
+    bool success = false;
+    if (req.cmd_type == CMD_START_MEASUREMENT) {
+        success = sendStartCommand(START_REQ_COUNT(req.data1), req.data2, req.data3, START_REQ_FIRST(req.data1),
+                                   START_REQ_HAS_PLAN(req.data1));
+        startPending = false;
+    } else if (req.cmd_type == CMD_START_MASKED) {
+        success = sendStartMaskedCommand(START_REQ_COUNT(req.data1), ((SweepMask)req.data3 << 32) | req.data2,
+                                         START_REQ_FIRST(req.data1), START_REQ_HAS_PLAN(req.data1));
+        startPending = false;
+    } else if (req.cmd_type == CMD_LINK_TEST) {
+        success = true;
+        for (int i = 0; i < UART_LINK_COUNT; i++) {
+            links[i].tuneCap = 0;
+            links[i].linkTestUnsupported = false;
+            success = tuneLinkBaudRate(links[i]) && success;
+        }
+    } else if (req.cmd_type == CMD_END_MEASUREMENT) {
+        success = sendStopCommand(req.data1);
+        // No answer: the STM32 rebooted to the boot rate or lost the link
+        if (!success && req.data2 == STOP_REQ_LINK_RESET) {
+            Console.println("Resetting the STM32 link");
+            resetBaudRate();
+        }
+    } else {
+        success = sendCommand(req.cmd_type, req.data1, req.data2, req.data3);
+    }
 
-    // Parse TIA gain (1 byte at index 23)
-    point.tia_gain = (rxContext.buffer[23] == 1);  // 1=high, 0=low
+    // Hand the outcome back to the requesting task
+    if (req.callback != nullptr) {
+        UARTCommandResult result = {req.cmd_type, success, req.callback, req.context};
+        if (xQueueSend(cmdResultQueue, &result, pdMS_TO_TICKS(100)) != pdTRUE) {
+            Console.printf("ERROR: Result queue full - callback for 0x%02X dropped\n", req.cmd_type);
+        }
+        wakeGUITask(GUI_WAKE_UART);
+    }
+}
 
-    // Parse valid flag (1 byte at index 24)
-    point.valid = (rxContext.buffer[24] == 1);
+// Send a setting command into the first free window slot
+// Legacy peers don't ACK settings, so they are sent untracked as before -
+// as are the further links, the window is link 0's
+static void sendSettingRequest(const UARTCommandRequest& req) {
+    for (int i = 1; i < UART_LINK_COUNT; i++) {
+        sendLinkCommand(links[i], req.cmd_type, req.data1, req.data2, req.data3);
+    }
+    UARTLink& link = links[0];
+    if (!link.peerSupportsV2) {
+        sendLinkCommand(link, req.cmd_type, req.data1, req.data2, req.data3);
+        return;
+    }
 
-    // Send to queue
-    if (measurementQueueHandle != nullptr) {
-        if (xQueueSend(measurementQueueHandle, &point, pdMS_TO_TICKS(100)) != pdTRUE) {
-            Serial.println("ERROR: Failed to queue measurement point!");
-        } else {
-            Serial.printf("Queued: DUT%d Freq=%lu Hz, V=%.3f, I=%.3f, Phase=%.2f°, Valid=%d\n",
-                         rxContext.currentDUT, point.freq_hz, point.V_magnitude,
-                         point.I_magnitude, point.phase_deg, point.valid);
+    for (int i = 0; i < UART_CMD_WINDOW; i++) {
+        if (!inFlight[i].active) {
+            inFlight[i].active = true;
+            inFlight[i].seq = link.nextSeq++;
+            inFlight[i].retries = 0;
+            inFlight[i].sentAt = millis();
+            inFlight[i].req = req;
+            inFlightCount++;
+            transmitCommandV2(link, req.cmd_type, inFlight[i].seq, req.data1, req.data2, req.data3);
+            return;
         }
     }
 }
 
-/*=========================PACKET RECEIVING=========================*/
+// Retire the in-flight command matching a sequenced ACK (any order)
+static void completeSeqAck(const SeqAck& ack) {
+    for (int i = 0; i < UART_CMD_WINDOW; i++) {
+        if (inFlight[i].active && inFlight[i].seq == ack.seq && inFlight[i].req.cmd_type == ack.cmd) {
+            inFlight[i].active = false;
+            inFlightCount--;
+            return;
+        }
+    }
+}
 
-void processIncomingByte(uint8_t byte) {
-    switch (rxContext.state) {
-        case WAITING_START:
-            if (byte == UART_DATA_START_BYTE) {
-                rxContext.buffer[0] = byte;
-                rxContext.byteCount = 1;
-                rxContext.state = READING_PACKET_TYPE;
-            }
-            break;
+// Resend commands whose ACK is overdue, dropping them after UART_CMD_MAX_RETRIES
+static void checkInFlightTimeouts() {
+    uint32_t now = millis();
+    for (int i = 0; i < UART_CMD_WINDOW; i++) {
+        InFlightCommand& cmd = inFlight[i];
+        if (!cmd.active || now - cmd.sentAt < UART_CMD_ACK_TIMEOUT_MS) {
+            continue;
+        }
 
-        case READING_PACKET_TYPE:
-            rxContext.buffer[1] = byte;
-            rxContext.packetType = byte;
-            rxContext.byteCount = 2;
+        if (cmd.retries >= UART_CMD_MAX_RETRIES) {
+            Console.printf("ERROR: Command 0x%02X (seq %d) failed after %d retries\n",
+                          cmd.req.cmd_type, cmd.seq, UART_CMD_MAX_RETRIES);
+            links[0].stats.cmdFailures++;
+            cmd.active = false;
+            inFlightCount--;
+            continue;
+        }
+
+        cmd.retries++;
+        cmd.sentAt = now;
+        links[0].stats.cmdRetransmits++;
+        transmitCommandV2(links[0], cmd.req.cmd_type, cmd.seq, cmd.req.data1, cmd.req.data2, cmd.req.data3);
+    }
+}
 
-            // Check if this might be an ACK packet (cmd_type 0x01-0x05)
-            if (byte >= CMD_SET_PGA_GAIN && byte <= CMD_SET_TIA_GAIN) {
-                // Could be ACK packet - need to read next 2 bytes to confirm
-                rxContext.expectedBytes = UART_ACK_PACKET_SIZE;
-                rxContext.state = READING_DUT_START;  // Reuse state for ACK reading
+// Time until the oldest in-flight command is due for a retransmit
+static TickType_t nextWakeTicks(TickType_t idleTimeout) {
+    if (inFlightCount == 0) {
+        return idleTimeout;
+    }
+
+    uint32_t now = millis();
+    uint32_t wait = UART_CMD_ACK_TIMEOUT_MS;
+    for (int i = 0; i < UART_CMD_WINDOW; i++) {
+        if (inFlight[i].active) {
+            uint32_t elapsed = now - inFlight[i].sentAt;
+            uint32_t remaining = elapsed >= UART_CMD_ACK_TIMEOUT_MS ? 0 : UART_CMD_ACK_TIMEOUT_MS - elapsed;
+            wait = min(wait, remaining);
+        }
+    }
+    return pdMS_TO_TICKS(wait) + 1;
+}
+
+bool processUARTCommandRequests(TickType_t timeout) {
+    EventBits_t bits = xEventGroupWaitBits(ackEventGroup, UART_CMD_REQUEST_BIT | UART_CMD_SEQ_ACK_BIT,
+                                           pdTRUE, pdFALSE, nextWakeTicks(timeout));
+    bool handled = (bits & (UART_CMD_REQUEST_BIT | UART_CMD_SEQ_ACK_BIT)) != 0;
+
+    // Retire acknowledged commands, then resend overdue ones
+    SeqAck ack;
+    while (xQueueReceive(seqAckQueue, &ack, 0) == pdTRUE) {
+        completeSeqAck(ack);
+    }
+    checkInFlightTimeouts();
+
+    // Fill the pipeline in request order
+    while (true) {
+        if (!heldRequestValid) {
+            if (xQueueReceive(cmdRequestQueue, &heldRequest, 0) != pdTRUE) {
+                break;
             }
-            // Determine data packet type and expected size
-            else if (byte == UART_DATA_DUT_START) {
-                rxContext.expectedBytes = UART_DATA_DUT_START_SIZE;
-                rxContext.state = READING_DUT_START;
-            } else if (byte == UART_DATA_FREQUENCY) {
-                rxContext.expectedBytes = UART_DATA_FREQUENCY_SIZE;
-                rxContext.state = READING_FREQUENCY;
-            } else if (byte == UART_DATA_DUT_END) {
-                rxContext.expectedBytes = UART_DATA_DUT_END_SIZE;
-                rxContext.state = READING_DUT_END;
-            } else {
-                // Unknown packet type, reset
-                Serial.printf("Unknown packet type: 0x%02X\n", byte);
-                rxContext.state = WAITING_START;
+            heldRequestValid = true;
+            handled = true;
+        }
+
+        if (isSettingCommand(heldRequest.cmd_type)) {
+            if (links[0].peerSupportsV2 && inFlightCount >= UART_CMD_WINDOW) {
+                break;  // Window full - wait for ACKs
             }
+            sendSettingRequest(heldRequest);
+        } else {
+            if (inFlightCount > 0) {
+                break;  // START/STOP only after all settings are confirmed
+            }
+            runBlockingRequest(heldRequest);
+        }
+        heldRequestValid = false;
+    }
+    return handled;
+}
+
+void processUARTCommandResults() {
+    UARTCommandResult result;
+    while (xQueueReceive(cmdResultQueue, &result, 0) == pdTRUE) {
+        result.callback(result.cmd_type, result.success, result.context);
+    }
+}
+
+/*=========================BAUD RATE NEGOTIATION=========================*/
+
+// Have the reader task, which owns the RX stream, drop what it holds - the
+// wake-up event gets it out of its queue wait. If it does not answer in
+// time the request stays set and is served before its next event
+static void requestRxReset(UARTLink& link) {
+    xEventGroupClearBits(link.ackGroup, UART_RX_RESET_BIT);
+    link.rxResetRequested = true;
+    uart_event_t wake = {};
+    wake.type = UART_EVENT_MAX;
+    xQueueSend(link.eventQueue, &wake, 0);
+    xEventGroupWaitBits(link.ackGroup, UART_RX_RESET_BIT, pdTRUE, pdFALSE, pdMS_TO_TICKS(UART_RX_RESET_TIMEOUT_MS));
+}
+
+// Reconfigure the local UART and drop anything received at the old rate
+static void applyLocalBaudRate(UARTLink& link, uint32_t baud) {
+    uart_wait_tx_done(link.port, pdMS_TO_TICKS(100));
+    uart_set_baudrate(link.port, baud);
+    requestRxReset(link);
+    link.baudRate = baud;
+}
+
+// Try a single rate: switch request at the current rate, verify at the new one
+static bool tryBaudRate(UARTLink& link, uint32_t baud) {
+    sendLinkCommand(link, CMD_SET_BAUD_RATE, baud, BAUD_PHASE_SWITCH, 0);
+    if (!waitForLinkAck(link, CMD_SET_BAUD_RATE, 1000)) {
+        return false;  // STM32 rejected the rate or doesn't know the command
+    }
+
+    delay(UART_BAUD_SWITCH_SETTLE_MS);
+    applyLocalBaudRate(link, baud);
+
+    sendLinkCommand(link, CMD_SET_BAUD_RATE, baud, BAUD_PHASE_VERIFY, 0);
+    if (waitForLinkAck(link, CMD_SET_BAUD_RATE, UART_BAUD_VERIFY_TIMEOUT_MS)) {
+        return true;
+    }
+
+    // Verify failed - STM32 reverts on its own after UART_BAUD_REVERT_MS
+    applyLocalBaudRate(link, UART_BAUD_RATE);
+    delay(UART_BAUD_REVERT_MS);
+    return false;
+}
+
+static bool negotiateLinkBaudRate(UARTLink& link) {
+    static const uint32_t rates[] = UART_FAST_BAUD_RATES;
+    if (linkTuning && !link.linkTestUnsupported) {
+        return tuneLinkBaudRate(link);
+    }
+
+    // Always negotiate from the default rate both sides boot at
+    if (link.baudRate != UART_BAUD_RATE) {
+        resetLinkBaudRate(link);
+    }
+    link.baudNegotiated = true;
+
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        Console.printf("Negotiating UART baud rate%s: %lu\n", linkName(link), rates[i]);
+        if (tryBaudRate(link, rates[i])) {
+            Console.printf("UART link%s running at %lu baud\n", linkName(link), rates[i]);
+            return true;
+        }
+    }
+
+    Console.printf("Baud negotiation failed%s - staying at %d baud\n", linkName(link), UART_BAUD_RATE);
+    return false;
+}
+
+static void resetLinkBaudRate(UARTLink& link) {
+    applyLocalBaudRate(link, UART_BAUD_RATE);
+    link.peerSupportsV2 = false;  // Re-detect after link loss
+    delay(UART_BAUD_REVERT_MS);  // Give the STM32 time to fall back as well
+    link.baudNegotiated = false;
+}
+
+bool negotiateBaudRate() {
+    bool fast = true;
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        fast = negotiateLinkBaudRate(links[i]) && fast;
+    }
+    return fast;
+}
+
+void resetBaudRate() {
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        resetLinkBaudRate(links[i]);
+    }
+}
+
+uint32_t getCurrentBaudRate() {
+    uint32_t baud = links[0].baudRate;
+    for (int i = 1; i < UART_LINK_COUNT; i++) {
+        baud = min(baud, links[i].baudRate);
+    }
+    return baud;
+}
+
+/*=========================LINK TUNING=========================*/
+
+// Frames lost of UART_TUNE_ROUNDS bursts at the current rate, -1 if the
+// STM32 answered none of them (no CMD_LINK_TEST in its firmware)
+static int measureLinkErrors(UARTLink& link) {
+    // A burst at line rate (v2 frames, the longer kind), plus the ACK turnaround
+    constexpr uint32_t frameBytes = UART_V2_HEADER_SIZE + sizeof(UARTLinkTestPayload) + UART_V2_CRC_SIZE;
+    uint32_t burstMs = UART_TUNE_FRAMES * frameBytes * 10 * 1000 / link.baudRate + UART_BAUD_VERIFY_TIMEOUT_MS;
+    bool answered = false;
+    int lost = 0;
+    for (int round = 0; round < UART_TUNE_ROUNDS; round++) {
+        link.testSeed = millis() * 2654435761u + round;
+        link.testGood = 0;
+        link.testBad = 0;
+        sendLinkCommand(link, CMD_LINK_TEST, UART_TUNE_FRAMES, link.testSeed, 0);
+        answered = waitForLinkAck(link, CMD_LINK_TEST, UART_BAUD_VERIFY_TIMEOUT_MS) || answered;
+        uint32_t start = millis();
+        while (link.testGood + link.testBad < UART_TUNE_FRAMES && millis() - start < burstMs) {
+            delay(2);
+        }
+        answered = answered || link.testGood > 0;
+        lost += UART_TUNE_FRAMES - min((int)link.testGood, UART_TUNE_FRAMES);
+    }
+    return answered ? lost : -1;
+}
+
+// Switch to baud from the current rate; after a failed attempt both sides
+// are back at UART_BAUD_RATE (or still at the old rate) and it is tried again
+static bool switchLinkBaudRate(UARTLink& link, uint32_t baud) {
+    for (int attempt = 0; attempt < 3; attempt++) {
+        if (link.baudRate == baud || tryBaudRate(link, baud)) {
+            return true;
+        }
+    }
+    resetLinkBaudRate(link);
+    return false;
+}
+
+// Mark the link statistics the next error judgement counts from
+static void markLinkErrors(UARTLink& link) {
+    link.tuneFrameMark = link.stats.framesParsed;
+    link.tuneErrorMark = link.stats.crcErrors + link.stats.frameErrors + link.stats.resyncs + link.stats.pointsLost;
+}
+
+// Climb tuneRates from UART_BAUD_RATE while the bursts stay clean, then
+// settle at the last clean rate. Returns true if that is faster than the boot rate
+static bool tuneLinkBaudRate(UARTLink& link) {
+    if (link.baudRate != UART_BAUD_RATE) {
+        resetLinkBaudRate(link);
+    }
+    link.baudNegotiated = true;
+    for (int i = 0; i < TUNE_RATE_COUNT; i++) {
+        link.tuneErrors[i] = -1;
+    }
+
+    constexpr int total = UART_TUNE_ROUNDS * UART_TUNE_FRAMES;
+    uint32_t best = UART_BAUD_RATE;
+    for (int i = 0; i < TUNE_RATE_COUNT; i++) {
+        if (link.tuneCap != 0 && tuneRates[i] > link.tuneCap) {
             break;
+        }
+        Console.printf("Testing UART link%s at %lu baud\n", linkName(link), (unsigned long)tuneRates[i]);
+        if (!tryBaudRate(link, tuneRates[i])) {
+            break;  // Rejected or not verified - both sides are at the boot rate
+        }
+        int lost = measureLinkErrors(link);
+        if (lost < 0) {
+            Console.printf("No link test%s - negotiating instead\n", linkName(link));
+            link.linkTestUnsupported = true;
+            return negotiateLinkBaudRate(link);
+        }
+        link.tuneErrors[i] = lost;
+        Console.printf("  %d of %d frames lost\n", lost, total);
+        if (lost * 100 > UART_TUNE_MAX_ERROR_PCT * total) {
+            break;
+        }
+        best = tuneRates[i];
+    }
+
+    if (link.baudRate != best && !switchLinkBaudRate(link, best)) {
+        Console.printf("ERROR: UART link%s lost while tuning - back at %d baud\n", linkName(link), UART_BAUD_RATE);
+        return false;
+    }
+    markLinkErrors(link);
+    Console.printf("UART link%s tuned to %lu baud\n", linkName(link), (unsigned long)best);
+    return best != UART_BAUD_RATE;
+}
+
+// Command task, before a START: true if the link errors since the last
+// judgement exceed UART_RETUNE_ERROR_PCT of the frames received - the
+// tuning is then capped below the current rate
+static bool linkErrorsRose(UARTLink& link) {
+    if (!linkTuning || link.linkTestUnsupported) {
+        return false;
+    }
+    uint32_t errors = link.stats.crcErrors + link.stats.frameErrors + link.stats.resyncs + link.stats.pointsLost;
+    if (link.stats.framesParsed < link.tuneFrameMark || errors < link.tuneErrorMark) {
+        markLinkErrors(link);   // Statistics were reset
+        return false;
+    }
+    uint32_t frames = link.stats.framesParsed - link.tuneFrameMark;
+    if (frames < UART_RETUNE_MIN_FRAMES) {
+        return false;
+    }
+    errors -= link.tuneErrorMark;
+    markLinkErrors(link);
+    if (errors * 100 <= (uint32_t)UART_RETUNE_ERROR_PCT * frames) {
+        return false;
+    }
+
+    uint32_t cap = UART_BAUD_RATE;
+    for (int i = 0; i < TUNE_RATE_COUNT; i++) {
+        if (tuneRates[i] < link.baudRate) {
+            cap = max(cap, tuneRates[i]);
+        }
+    }
+    link.tuneCap = cap;
+    Console.printf("UART link%s: %lu errors in %lu frames at %lu baud - tuning again at %lu or below\n",
+                   linkName(link), (unsigned long)errors, (unsigned long)frames, (unsigned long)link.baudRate,
+                   (unsigned long)cap);
+    return true;
+}
+
+void setLinkTuning(bool enable) {
+    linkTuning = enable;
+}
+
+bool isLinkTuning() {
+    return linkTuning;
+}
+
+bool requestLinkTuning() {
+    if (measurementInProgress || isSweepStartPending()) {
+        return false;
+    }
+    return queueUARTCommand(CMD_LINK_TEST, 0, 0, 0);
+}
+
+void printLinkTuning() {
+    Console.printf("Link tuning: %s (up to %d%% of %d test frames lost)\n", linkTuning ? "on" : "off",
+                   UART_TUNE_MAX_ERROR_PCT, UART_TUNE_ROUNDS * UART_TUNE_FRAMES);
+    for (int l = 0; l < UART_LINK_COUNT; l++) {
+        const UARTLink& link = links[l];
+        Console.printf("UART link %d: %lu baud%s", l, (unsigned long)link.baudRate,
+                       link.linkTestUnsupported ? ", no link test" : "");
+        if (link.tuneCap != 0) {
+            Console.printf(", capped at %lu", (unsigned long)link.tuneCap);
+        }
+        for (int i = 0; i < TUNE_RATE_COUNT; i++) {
+            if (link.tuneErrors[i] >= 0) {
+                Console.printf(", %lu: %d lost", (unsigned long)tuneRates[i], link.tuneErrors[i]);
+            }
+        }
+        Console.println();
+    }
+}
 
-        case READING_DUT_START:
-        case READING_FREQUENCY:
-        case READING_DUT_END:
-            // Collect bytes for current packet type
-            // All three packet types use the same collection logic
-            rxContext.buffer[rxContext.byteCount++] = byte;
-
-            // Check if we've received all expected bytes for this packet
-            if (rxContext.byteCount >= rxContext.expectedBytes) {
-                // Validate end byte
-                if (rxContext.buffer[rxContext.byteCount - 1] == UART_DATA_END_BYTE) {
-                    // Check if this is an ACK packet (4 bytes, third byte is 0x01, packet type is a command)
-                    if (rxContext.expectedBytes == UART_ACK_PACKET_SIZE &&
-                        rxContext.buffer[2] == 0x01 &&
-                        rxContext.packetType >= CMD_SET_PGA_GAIN &&
-                        rxContext.packetType <= CMD_SET_TIA_GAIN) {
-                        // ACK packet received
-                        ackCmdType = rxContext.packetType;
-                        ackReceived = true;
-                        Serial.printf("ACK received for command 0x%02X\n", ackCmdType);
-                    }
-                    // Process data packets
-                    else if (rxContext.packetType == UART_DATA_DUT_START) {
-                        rxContext.currentDUT = rxContext.buffer[2];
-                        rxContext.expectedFreqCount = rxContext.buffer[3];
-                        Serial.printf("\n=== DUT %d START (expecting %d frequencies) ===\n",
-                                     rxContext.currentDUT, rxContext.expectedFreqCount);
-                    }
-                    else if (rxContext.packetType == UART_DATA_FREQUENCY) {
-                        parseFrequencyPacket();
-                    }
-                    else if (rxContext.packetType == UART_DATA_DUT_END) {
-                        uint8_t dutNum = rxContext.buffer[2];
-                        Serial.printf("=== DUT %d END ===\n\n", dutNum);
-
-                        // Signal GUI task that DUT is complete
-                        completedDUTIndex = dutNum - 1;  // Convert 1-4 to 0-3
-                        completedDUTCount++;
-
-                        if (dutCompleteSemaphore != nullptr) {
-                            xSemaphoreGive(dutCompleteSemaphore);
-                        }
-
-                        // Check if all DUTs complete
-                        if (completedDUTCount >= totalExpectedDUTs) {
-                            Serial.println("=== ALL MEASUREMENTS COMPLETE ===");
-                            if (measurementCompleteSemaphore != nullptr) {
-                                xSemaphoreGive(measurementCompleteSemaphore);
-                            }
-                        }
-                    }
-                } else {
-                    Serial.printf("Invalid end byte: 0x%02X\n",
-                                 rxContext.buffer[rxContext.byteCount - 1]);
+/*=========================DEVICE ID=========================*/
+
+bool requestSTM32DeviceId() {
+    return queueUARTCommand(CMD_GET_DEVICE_ID, 0, 0, 0);
+}
+
+bool getSTM32DeviceId(char* out) {
+    uint32_t uid[3];
+    portENTER_CRITICAL(&deviceIdMux);
+    bool valid = deviceIdValid;
+    memcpy(uid, deviceId, sizeof(uid));
+    portEXIT_CRITICAL(&deviceIdMux);
+
+    if (!valid) {
+        return false;
+    }
+    snprintf(out, STM32_DEVICE_ID_LEN + 1, "%08lX%08lX%08lX",
+             (unsigned long)uid[2], (unsigned long)uid[1], (unsigned long)uid[0]);
+    return true;
+}
+
+/*=========================MEASUREMENT BATCHES=========================*/
+
+// Queue the batch dut is filling, if any
+static void flushDUTBatch(uint8_t dut, TickType_t wait = pdMS_TO_TICKS(MEASUREMENT_BATCH_WAIT_MS)) {
+    MeasurementBatch*& batch = currentBatch[dut - 1];
+    if (batch == nullptr) {
+        return;
+    }
+    trace(TRACE_BATCH_FLUSH, batch->dut, batch->count);
+    if (measurementQueueHandle == nullptr ||
+        xQueueSend(measurementQueueHandle, &batch, wait) != pdTRUE) {
+        Console.printf("ERROR: Failed to queue batch (%d points dropped)\n", batch->count);
+        linkOfDUT(dut).stats.pointsDropped += batch->count;
+        batchesDropped.add();
+        releaseMeasurementBatch(batch);
+    }
+    batch = nullptr;
+}
+
+// Get the batch being filled for dut (1-based), taking a fresh one from the pool if needed
+// Each DUT fills its own batch so interleaved sweeps still hand over whole runs
+static MeasurementBatch* acquireBatch(uint8_t dut, TickType_t wait = pdMS_TO_TICKS(MEASUREMENT_BATCH_WAIT_MS)) {
+    if (dut < 1 || dut > MAX_DUT_COUNT) {
+        return nullptr;
+    }
+    MeasurementBatch*& batch = currentBatch[dut - 1];
+    if (batch == nullptr) {
+        if (freeBatchQueue == nullptr) {
+            return nullptr;
+        }
+        // Interleaved over more DUTs than the pool holds - hand over the other
+        // DUTs' partial batches so the processor can return some
+        if (xQueueReceive(freeBatchQueue, &batch, 0) != pdTRUE) {
+            for (uint8_t other = 1; other <= MAX_DUT_COUNT; other++) {
+                if (other != dut) {
+                    flushDUTBatch(other);
                 }
+            }
+        }
+        if (batch == nullptr &&
+            xQueueReceive(freeBatchQueue, &batch, wait) != pdTRUE) {
+            batch = nullptr;
+            return nullptr;
+        }
+        batch->dut = dut;
+        batch->count = 0;
+        batch->dutComplete = false;
+        batch->dutStart = (dutStartPending & (1UL << (dut - 1))) != 0;
+        batch->generation = getMeasurementGeneration();
+        dutStartPending &= ~(1UL << (dut - 1));
+    }
+    return batch;
+}
+
+void setLiveBatchHandover(bool enable) {
+    liveHandover = enable;
+}
+
+void flushMeasurementBatch() {
+    for (uint8_t dut = 1; dut <= MAX_DUT_COUNT; dut++) {
+        flushDUTBatch(dut);
+    }
+}
+
+void releaseMeasurementBatch(MeasurementBatch* batch) {
+    xQueueSend(freeBatchQueue, &batch, 0);
+    grantFlowCredit();
+}
+
+/*=========================FLOW CREDITS=========================*/
+
+// Not ACKed and not sequenced - sent from whichever task grows the limit
+static void transmitFlowCredit(UARTLink& link, uint32_t limit) {
+    if (link.peerSupportsV2) {
+        transmitCommandV2(link, CMD_FLOW_CREDIT, 0, limit, 0, 0);
+    } else {
+        transmitCommandLegacy(link, CMD_FLOW_CREDIT, limit, 0, 0);
+    }
+}
+
+void grantFlowCredit(bool resend) {
+    if (freeBatchQueue == nullptr) {
+        return;
+    }
+    int sweeping = 0;
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        sweeping += links[i].creditSweep ? 1 : 0;
+    }
+    if (sweeping == 0) {
+        return;
+    }
+    // Only free batches count: a point may need a fresh one per DUT when
+    // interleaved or handed over live, a whole batch's worth otherwise.
+    // The links running a sweep share them
+    uint32_t perBatch = (liveHandover || interleavedSweep) ? 1 : MEASUREMENT_BATCH_SIZE;
+    uint32_t room = uxQueueMessagesWaiting(freeBatchQueue) * perBatch / sweeping;
+
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        UARTLink& link = links[i];
+        if (!link.creditSweep) {
+            continue;
+        }
+        portENTER_CRITICAL(&creditMux);
+        uint32_t sent = link.creditFrames - link.creditBase;
+        uint32_t limit = max(sent + room, link.creditGranted);
+        uint32_t remaining = link.creditGranted > sent ? link.creditGranted - sent : 0;
+        bool send = resend || (limit > link.creditGranted && 2 * remaining < room);
+        if (send) {
+            link.creditGranted = limit;
+            creditGrants++;
+        }
+        portEXIT_CRITICAL(&creditMux);
+
+        if (send) {
+            transmitFlowCredit(link, limit);
+        }
+    }
+}
+
+void printUARTFlowStats() {
+    uint32_t limit = 0;
+    uint32_t sent = 0;
+    bool running = false;
+    portENTER_CRITICAL(&creditMux);
+    uint32_t grants = creditGrants;
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        limit += links[i].creditGranted;
+        sent += links[i].creditFrames - links[i].creditBase;
+        running = running || links[i].creditSweep;
+    }
+    portEXIT_CRITICAL(&creditMux);
+    UARTStats stats = getUARTStats();
+    Console.printf("Flow credits: %s, %lu grants, %lu of %lu frames used, %lu holds%s\n",
+                  flowCredits ? "on" : "off", (unsigned long)grants, (unsigned long)sent,
+                  (unsigned long)limit, (unsigned long)creditHolds, running ? " (sweep running)" : "");
+    Console.printf("UART points: %lu lost on the line, %lu dropped (no free batch)\n",
+                  (unsigned long)stats.pointsLost, (unsigned long)stats.pointsDropped);
+    for (int i = 0; UART_LINK_COUNT > 1 && i < UART_LINK_COUNT; i++) {
+        const UARTLink& link = links[i];
+        Console.printf("UART link %d: DUTs %d-%d, %lu baud, %lu bytes / %lu frames, %lu lost%s\n", i,
+                      link.dutOffset + 1, link.dutOffset + link.dutCount, (unsigned long)link.baudRate,
+                      (unsigned long)link.stats.bytesReceived, (unsigned long)link.stats.framesParsed,
+                      (unsigned long)link.stats.pointsLost, link.peerSupportsV2 ? ", v2" : "");
+    }
+}
+
+/*=========================FRAME HANDLERS=========================*/
+
+// Normalize a V - I phase difference to [-180, 180]
+static float normalizePhase(float phase_diff) {
+    while (phase_diff > 180.0f) phase_diff -= 360.0f;
+    while (phase_diff < -180.0f) phase_diff += 360.0f;
+    return phase_diff;
+}
 
-                // Reset state machine
-                rxContext.state = WAITING_START;
-                rxContext.byteCount = 0;
+// Queue one decoded point (freq_idx still to be set) for the processing task
+// dut: session DUT from the preceding DUT_START, or from the frame itself when interleaved
+// freqIdx: sweep table index sent with the point (FREQUENCY_IDX, blocks), else SWEEP_FREQ_INVALID
+static void queuePoint(UARTLink& link, MeasurementPoint& point, uint8_t dut, uint8_t freqIdx) {
+    UARTRxContext& rxContext = link.rx;
+
+    sweepStatsMark(MARK_FREQUENCY);
+    sweepWatchdogPoint();
+    link.creditFrames++;
+    if (link.creditSweep && link.creditFrames - link.creditBase == link.creditGranted) {
+        creditHolds++;
+    }
+
+    // A sent index is checked against the table and used directly; otherwise the
+    // STM32 steps through its table in order - the DUT's next index is the likely match
+    if (dut < 1 || dut > MAX_DUT_COUNT) {
+        Console.printf("ERROR: Frequency frame for invalid DUT %d\n", dut);
+        return;
+    }
+    rxContext.framesSinceStart[dut - 1]++;
+    uint8_t& lastFreqIdx = rxContext.lastFreqIdx[dut - 1];
+    uint8_t hint = freqIdx;
+    if (hint == SWEEP_FREQ_INVALID && lastFreqIdx < SWEEP_FREQ_COUNT) {
+        hint = lastFreqIdx + 1;
+    }
+    point.freq_idx = getSweepFrequencyIndex(point.freq_hz, hint);
+    lastFreqIdx = point.freq_idx;
+    sweepTimePoint(dut, point.freq_idx);
+
+    // Append to the DUT's batch, sending it on when full
+    MeasurementBatch* batch = acquireBatch(dut);
+    if (batch == nullptr) {
+        Console.println("ERROR: Failed to queue measurement point!");
+        link.stats.pointsDropped++;
+        return;
+    }
+
+    batch->points[batch->count++] = point;
+    LOG_D("Queued: DUT%d Freq=%lu Hz, V=%.3f, I=%.3f, Phase=%.2f°, Valid=%d\n",
+          batch->dut, point.freq_hz, point.V_magnitude,
+          point.I_magnitude, point.phase_deg, point.valid);
+
+    if (batch->count >= MEASUREMENT_BATCH_SIZE || liveHandover) {
+        flushDUTBatch(dut);
+    }
+}
+
+// Decode a frequency frame in place and queue it
+static void handleFrequencyFrame(UARTLink& link, const UARTFrequencyPayload* frame, uint8_t dut,
+                                 uint8_t freqIdx = SWEEP_FREQ_INVALID) {
+    MeasurementPoint point;
+    trace(TRACE_UART_FRAME, UART_DATA_FREQUENCY, frame->freq_hz);
+
+    point.freq_hz = frame->freq_hz;
+    point.V_magnitude = frame->V_magnitude;
+    point.I_magnitude = frame->I_magnitude;
+    point.phase_deg = normalizePhase(frame->V_phase - frame->I_phase);
+    point.pga_gain = frame->pga_gain;
+    point.tia_gain = (frame->tia_gain == 1);  // 1=high, 0=low
+    point.valid = (frame->valid == 1);
+    queuePoint(link, point, dut, freqIdx);
+}
+
+static void handleFrequencyDutFrame(UARTLink& link, const UARTFrequencyDutPayload* frame) {
+    link.rx.currentDUT = sessionDUT(link, frame->dut);
+    handleFrequencyFrame(link, &frame->point, link.rx.currentDUT);
+}
+
+// Sequence 0 starts the DUT's count over (new START); a jump ahead is lost
+// frames, a step back (duplicate, or a lost first frame) just resynchronizes
+// points: frames the sequence number covers (a block's point count)
+static void checkPointSequence(UARTLink& link, uint8_t dut, uint16_t seq, uint16_t points) {
+    if (dut < 1 || dut > MAX_DUT_COUNT) {
+        return;
+    }
+    uint16_t& expected = link.rx.nextSeq[dut - 1];
+    uint16_t gap = seq - expected;
+    if (seq != 0 && gap != 0 && gap < 0x8000) {
+        link.stats.pointsLost += gap;
+        link.creditFrames += gap;    // Sent, so counted against the credit
+        LOG_W("WARNING: DUT %d lost %u frame(s) before sequence %u\n", dut, gap, seq);
+    }
+    expected = seq + points;
+}
+
+static void handleFrequencyIdxFrame(UARTLink& link, const UARTFrequencyIdxPayload* frame) {
+    uint8_t dut = sessionDUT(link, frame->dut);
+    link.rx.currentDUT = dut;
+    checkPointSequence(link, dut, frame->seq, 1);
+    handleFrequencyFrame(link, &frame->point, dut, frame->freqIdx);
+}
+
+// Consecutive points of one DUT - each queued as if it came in its own
+// FREQUENCY_IDX frame. compact: UARTCompactPoint points (COMPACT_BLOCK)
+static void handleFrequencyBlockFrame(UARTLink& link, const uint8_t* payload, size_t len, bool compact) {
+    const UARTCompactPoint* compactPoints = nullptr;
+    const UARTBlockPoint* blockPoints = nullptr;
+    const UARTFrequencyBlockHeader* header =
+        compact ? decodeUARTBlock<UART_DATA_COMPACT_BLOCK>(payload, len, compactPoints)
+                : decodeUARTBlock<UART_DATA_FREQUENCY_BLOCK>(payload, len, blockPoints);
+    if (header == nullptr) {
+        const UARTFrequencyBlockHeader* raw = reinterpret_cast<const UARTFrequencyBlockHeader*>(payload);
+        LOG_W("WARNING: Malformed %s (%u points, %u bytes)%s\n", compact ? "COMPACT_BLOCK" : "FREQUENCY_BLOCK",
+              raw->count, (unsigned)len, linkName(link));
+        return;
+    }
+    uint8_t dut = sessionDUT(link, header->dut);
+    link.rx.currentDUT = dut;
+    trace(TRACE_UART_FRAME, compact ? UART_DATA_COMPACT_BLOCK : UART_DATA_FREQUENCY_BLOCK,
+          ((uint32_t)header->count << 16) | header->firstIdx);
+    checkPointSequence(link, dut, header->seq, header->count);
+
+    int repeats = max((int)header->repeats, 1);
+    int step = header->step < 0 ? -1 : 1;
+    for (uint8_t i = 0; i < header->count; i++) {
+        int idx = header->firstIdx + step * ((header->firstRepeat + i) / repeats);
+        if (idx < 0 || idx >= SWEEP_FREQ_COUNT) {
+            LOG_W("WARNING: FREQUENCY_BLOCK past the sweep table%s\n", linkName(link));
+            return;
+        }
+        MeasurementPoint point;
+        uint8_t gains;
+        point.freq_hz = sweepFrequencies[idx];
+        if (compact) {
+            const UARTCompactPoint& sent = compactPoints[i];
+            point.V_magnitude = uartCompactMagnitude(sent.V_code);
+            point.I_magnitude = uartCompactMagnitude(sent.I_code);
+            point.phase_deg = normalizePhase(sent.phase_cdeg * 0.01f);
+            gains = sent.gains;
+        } else {
+            const UARTBlockPoint& sent = blockPoints[i];
+            point.V_magnitude = sent.V_magnitude;
+            point.I_magnitude = sent.I_magnitude;
+            point.phase_deg = normalizePhase(sent.phase_deg);
+            gains = sent.gains;
+        }
+        point.pga_gain = gains & BLOCK_POINT_PGA_MASK;
+        point.tia_gain = (gains & BLOCK_POINT_TIA_HIGH) != 0;
+        point.valid = (gains & BLOCK_POINT_VALID) != 0;
+        queuePoint(link, point, dut, idx);
+    }
+}
+
+static void handleDutStartFrame(UARTLink& link, const UARTDutStartPayload* frame) {
+    UARTRxContext& rxContext = link.rx;
+    uint8_t dut = sessionDUT(link, frame->dut);
+    trace(TRACE_UART_FRAME, UART_DATA_DUT_START, dut);
+    sweepStatsMark(MARK_DUT_START);
+
+    // Points of the previous DUT must not end up in the new DUT's batch
+    flushMeasurementBatch();
+
+    rxContext.currentDUT = dut;
+    if (dut >= 1 && dut <= MAX_DUT_COUNT) {
+        uint8_t i = dut - 1;
+        rxContext.expectedFreqCount[i] = frame->freqCount;
+        rxContext.framesSinceStart[i] = 0;
+        rxContext.nextSeq[i] = 0;
+        rxContext.lastFreqIdx[i] = SWEEP_FREQ_INVALID;
+        // First batch after DUT_START drops half-averaged repeats
+        dutStartPending |= 1UL << i;
+    }
+    sweepWatchdogDutStart(dut);
+    sweepTimeDutStart(dut);
+    HAL_PRINTF("\n=== DUT %d START (expecting %d frequencies) ===\n",
+               dut, frame->freqCount);
+}
+
+static void handleDutEndFrame(UARTLink& link, const UARTDutEndPayload* frame) {
+    UARTRxContext& rxContext = link.rx;
+    uint8_t dutNum = sessionDUT(link, frame->dut);
+    trace(TRACE_UART_FRAME, UART_DATA_DUT_END, dutNum);
+    sweepStatsMark(MARK_DUT_END, dutNum);
+    sweepWatchdogDutEnd(dutNum);
+    sweepTimeDutEnd(dutNum);
+    Console.printf("=== DUT %d END ===\n\n", dutNum);
+
+    // Frames short of DUT_START's count were lost on the line (a STOP of
+    // this DUT also ends it short) - the repair sweep asks for them again
+    if (dutNum >= 1 && dutNum <= MAX_DUT_COUNT && rxContext.expectedFreqCount[dutNum - 1] > 0) {
+        uint8_t i = dutNum - 1;
+        uint32_t expected = isRepeatPlanApplied() ? getRepeatPlanFrames()
+                                                  : (uint32_t)rxContext.expectedFreqCount[i] * getSweepRepeats();
+        if (rxContext.framesSinceStart[i] < expected) {
+            uint32_t missing = expected - rxContext.framesSinceStart[i];
+            // Sequenced frames counted their gaps already
+            if (!indexedFrames && !blockFrames) {
+                link.stats.pointsLost += missing;
+                link.creditFrames += missing;
             }
+            LOG_W("WARNING: DUT %d ended with %u of %lu frames\n", dutNum,
+                  rxContext.framesSinceStart[i], expected);
+        }
+        rxContext.expectedFreqCount[i] = 0;
+    }
+
+    // DUT_END is in-band: the last batch (empty when the points went out
+    // already) is marked complete and queued behind the DUT's points, so the
+    // processor signals the GUI only after storing all of them (see
+    // signalDUTComplete). The marker is never dropped - the processor keeps
+    // returning batches, so waiting for a free one or for queue room ends
+    MeasurementBatch* batch = acquireBatch(dutNum, portMAX_DELAY);
+    if (batch == nullptr) {
+        // Out-of-range DUT: no points of it were queued to overtake
+        Console.println("ERROR: No batch for DUT_END - signaling directly");
+        signalDUTComplete(dutNum, getMeasurementGeneration());
+        return;
+    }
+    batch->dutComplete = true;
+    flushDUTBatch(dutNum, portMAX_DELAY);
+}
+
+static void handleDeviceIdFrame(UARTLink& link, const UARTDeviceIdPayload* frame) {
+    trace(TRACE_UART_FRAME, UART_DATA_DEVICE_ID, frame->uid[0]);
+
+    // Calibration follows link 0's STM32
+    if (link.index != 0) {
+        Console.printf("STM32 device ID%s: %08lX%08lX%08lX\n", linkName(link),
+                      (unsigned long)frame->uid[2], (unsigned long)frame->uid[1], (unsigned long)frame->uid[0]);
+        return;
+    }
+    portENTER_CRITICAL(&deviceIdMux);
+    memcpy(deviceId, frame->uid, sizeof(deviceId));
+    deviceIdValid = true;
+    portEXIT_CRITICAL(&deviceIdMux);
+    // Calibration set selection runs in the GUI task
+    wakeGUITask(GUI_WAKE_UART);
+
+    Console.printf("STM32 device ID: %08lX%08lX%08lX\n",
+                  (unsigned long)frame->uid[2], (unsigned long)frame->uid[1], (unsigned long)frame->uid[0]);
+}
+
+// Count an intact burst frame - anything else the burst brings is an error
+static void handleLinkTestFrame(UARTLink& link, const UARTLinkTestPayload* frame) {
+    uint8_t expected[LINK_TEST_PATTERN_SIZE];
+    fillUARTLinkTestPattern(expected, link.testSeed, frame->seq);
+    if (frame->seq < UART_TUNE_FRAMES && memcmp(expected, frame->pattern, sizeof(expected)) == 0) {
+        link.testGood++;
+    } else {
+        link.testBad++;
+    }
+}
+
+static void handleAckFrame(UARTLink& link, uint8_t cmd, const uint8_t* payload, size_t len) {
+    const UARTAckPayload* frame = reinterpret_cast<const UARTAckPayload*>(payload);
+    if (cmd >= UART_FRAME_TYPE_LIMIT || !(uartFrameSchema.spec[cmd].flags & UART_FRAME_ACK) || frame->status != 0x01) {
+        return;
+    }
+
+    // v2 ACKs carry the sequence number for the pipelined command window (link 0's)
+    if (len >= sizeof(UARTAckSeqPayload) && link.index == 0) {
+        SeqAck ack = {cmd, reinterpret_cast<const UARTAckSeqPayload*>(payload)->seq};
+        trace(TRACE_UART_ACK, cmd, ack.seq);
+        if (xQueueSend(seqAckQueue, &ack, 0) == pdTRUE) {
+            xEventGroupSetBits(ackEventGroup, UART_CMD_SEQ_ACK_BIT);
+        }
+    } else {
+        trace(TRACE_UART_ACK, cmd, 0xFFFF);
+    }
+
+    xEventGroupSetBits(link.ackGroup, UART_ACK_BIT(cmd));
+    Console.printf("ACK received for command 0x%02X%s\n", cmd, linkName(link));
+}
+
+// Route a payload to its handler - shared by legacy and v2 frames. The
+// parser checked len against the schema, so the typed views are never null
+// context: the UARTLink the frame arrived on
+static void dispatchFrame(uint8_t type, const uint8_t* payload, size_t len, bool v2, void* context) {
+    UARTLink& link = *static_cast<UARTLink*>(context);
+    if (v2) {
+        link.peerSupportsV2 = true;
+    }
+    lastRxLink = link.index;
+    switch (type) {
+        case UART_DATA_DUT_START:
+            handleDutStartFrame(link, decodeUARTPayload<UART_DATA_DUT_START>(payload, len));
+            break;
+        case UART_DATA_FREQUENCY:
+            handleFrequencyFrame(link, decodeUARTPayload<UART_DATA_FREQUENCY>(payload, len), link.rx.currentDUT);
+            break;
+        case UART_DATA_FREQUENCY_DUT:
+            handleFrequencyDutFrame(link, decodeUARTPayload<UART_DATA_FREQUENCY_DUT>(payload, len));
+            break;
+        case UART_DATA_FREQUENCY_IDX:
+            handleFrequencyIdxFrame(link, decodeUARTPayload<UART_DATA_FREQUENCY_IDX>(payload, len));
+            break;
+        case UART_DATA_FREQUENCY_BLOCK:
+        case UART_DATA_COMPACT_BLOCK:
+            handleFrequencyBlockFrame(link, payload, len, type == UART_DATA_COMPACT_BLOCK);
+            break;
+        case UART_DATA_DUT_END:
+            handleDutEndFrame(link, decodeUARTPayload<UART_DATA_DUT_END>(payload, len));
+            break;
+        case UART_DATA_DEVICE_ID:
+            handleDeviceIdFrame(link, decodeUARTPayload<UART_DATA_DEVICE_ID>(payload, len));
+            break;
+        case UART_DATA_LINK_TEST:
+            handleLinkTestFrame(link, decodeUARTPayload<UART_DATA_LINK_TEST>(payload, len));
+            break;
+        default:
+            handleAckFrame(link, type, payload, len);
             break;
     }
 }
 
+/*=========================PACKET RECEIVING=========================*/
+
+size_t parseFrames(const uint8_t* data, size_t len, size_t* consumed) {
+    UARTFrameCounters counters = {};
+    size_t frames = scanUARTFrames(data, len, consumed, dispatchFrame, &links[0], counters);
+    addFrameCounters(links[0], counters);
+    return frames;
+}
+
+size_t processIncomingBytes(const uint8_t* data, size_t len) {
+    UARTFrameCounters counters = {};
+    size_t frames = feedUARTFrames(links[0].rx.stage, data, len, dispatchFrame, &links[0], counters);
+    addFrameCounters(links[0], counters);
+    return frames;
+}
+
+void processIncomingByte(uint8_t byte) {
+    processIncomingBytes(&byte, 1);
+}
+
 uint8_t getCurrentDUT() {
-    return rxContext.currentDUT;
+    return links[lastRxLink].rx.currentDUT;
 }
 
 /*=========================ACK HANDLING=========================*/
 
 bool waitForAck(uint8_t cmd_type, uint32_t timeout_ms) {
-    // Reset ACK flags
-    ackReceived = false;
-    ackCmdType = 0;
+    uint32_t start = millis();
+    bool acked = true;
+    for (int i = 0; i < UART_LINK_COUNT; i++) {
+        uint32_t elapsed = millis() - start;
+        acked = waitForLinkAck(links[i], cmd_type, elapsed < timeout_ms ? timeout_ms - elapsed : 0) && acked;
+    }
+    return acked;
+}
 
-    uint32_t startTime = millis();
+/*=========================EVENT SIGNALING=========================*/
 
-    // Wait for ACK or timeout
-    while (millis() - startTime < timeout_ms) {
-        if (ackReceived && ackCmdType == cmd_type) {
-            ackReceived = false;  // Reset flag
-            return true;
+void signalDUTComplete(uint8_t dutNum, uint32_t generation) {
+    // Cancelled meanwhile - must not count towards the next START's DUTs
+    if (generation != getMeasurementGeneration()) {
+        return;
+    }
+    DUTCompleteEvent event;
+    event.dutIndex = dutNum - 1;  // Convert 1-based to 0-based
+    event.points = event.dutIndex < MAX_DUT_COUNT ? getStoredPointCount(event.dutIndex) : 0;
+    event.timestampMs = millis();
+    event.generation = generation;
+    completedDUTCount++;
+
+    // Check if all DUTs complete
+    event.sweepDone = completedDUTCount >= totalExpectedDUTs;
+    if (event.sweepDone) {
+        Console.println("=== ALL MEASUREMENTS COMPLETE ===");
+        for (int i = 0; i < UART_LINK_COUNT; i++) {
+            links[i].creditSweep = false;
         }
-        delay(1);  // Small delay to prevent tight loop
     }
 
-    // Timeout - no ACK received
-    Serial.printf("WARNING: No ACK received for command 0x%02X\n", cmd_type);
-    return false;
+    // Room for a sweep and its repair - only a stalled GUI task fills it,
+    // and a dropped sweepDone would hang the session
+    if (dutCompleteQueue != nullptr) {
+        xQueueSend(dutCompleteQueue, &event, portMAX_DELAY);
+    }
+    wakeGUITask(GUI_WAKE_DUT);
 }
 
-/*=========================EVENT SIGNALING=========================*/
-
-SemaphoreHandle_t getDUTCompleteSemaphore() {
-    return dutCompleteSemaphore;
+QueueHandle_t getDUTCompleteQueue() {
+    return dutCompleteQueue;
 }
 
-SemaphoreHandle_t getMeasurementCompleteSemaphore() {
-    return measurementCompleteSemaphore;
+uint32_t getPendingBatchCount() {
+    return measurementQueueHandle != nullptr ? uxQueueMessagesWaiting(measurementQueueHandle) : 0;
 }
 
-uint8_t getCompletedDUTIndex() {
-    return completedDUTIndex;
+uint32_t getPendingCommandCount() {
+    return cmdRequestQueue != nullptr ? uxQueueMessagesWaiting(cmdRequestQueue) : 0;
 }
@@ -0,0 +1,215 @@
+#include "baseline_store.h"
+#include "console.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "impedance_calc.h"
+#include "storage.h"
+#include "crc.h"
+#include "open_channel.h"
+#include <LittleFS.h>
+
+static_assert(sizeof(BaselineDutRecord) <= STORAGE_ITEM_MAX, "BaselineDutRecord must fit one storage operation");
+
+// Sweep plan (main.cpp)
+extern uint8_t num_duts;
+extern uint8_t startIDX;
+extern uint8_t endIDX;
+extern SweepMask sweepMask;
+
+// Calibration set of the baseline in the rows
+static char baselineCalSet[CAL_SET_NAME_MAX] = "";
+
+/*=========================SAVE=========================*/
+
+void packBaselineHeader(BaselineHeader& header) {
+    memset(&header, 0, sizeof(header));
+    header.magic = BASELINE_MAGIC;
+    header.version = BASELINE_VERSION;
+    header.storeDuts = getDUTCount();
+    header.storePoints = getPointsPerDUT();
+    header.numDuts = min(num_duts, getDUTCount());
+    header.startIdx = startIDX;
+    header.endIdx = endIDX;
+    header.mask = sweepMask;
+    snprintf(header.calSet, sizeof(header.calSet), "%s", baselineCalSet);
+    header.crc = crc16_ccitt((const uint8_t*)&header, offsetof(BaselineHeader, crc));
+}
+
+void packBaselineRecord(uint8_t dut, BaselineDutRecord& record) {
+    const ImpedanceRow& row = baselineImpedanceData[dut];
+    int count = min(getRowPointCount(true, dut), (int)getPointsPerDUT());
+    memset(&record, 0, sizeof(record));
+    record.dut = dut;
+    record.count = count;
+    for (int i = 0; i < count; i++) {
+        BaselinePoint& point = record.points[i];
+        point.freq_hz = storedFrequency(row.freqCode[i]);
+        point.mag = row.mag[i];
+        point.phase = row.phase[i];
+        point.flags = row.flags[i];
+        point.magSd = row.magSd[i];
+        point.phaseSd = row.phaseSd[i];
+    }
+    record.crc = crc16_ccitt((const uint8_t*)&record, offsetof(BaselineDutRecord, crc));
+}
+
+bool saveBaseline(bool persist) {
+    snprintf(baselineCalSet, sizeof(baselineCalSet), "%s", getCalibrationSetName());
+    if (!persist || !isStorageMounted()) {
+        return false;
+    }
+
+    BaselineHeader header;
+    packBaselineHeader(header);
+    bool ok = queueStorageWrite(BASELINE_TMP_FILE, &header, sizeof(header));
+
+    // GUI task only - too large for its stack
+    static BaselineDutRecord record;
+    for (uint8_t dut = 0; dut < header.numDuts && ok; dut++) {
+        packBaselineRecord(dut, record);
+        ok = queueStorageAppend(BASELINE_TMP_FILE, &record, sizeof(record));
+    }
+
+    // Complete - replaces the old baseline in one step
+    ok = ok && queueStorageRename(BASELINE_TMP_FILE, BASELINE_FILE);
+    if (!ok) {
+        Console.println("WARNING: Baseline not saved - storage queue full");
+        queueStorageRemove(BASELINE_TMP_FILE);
+        return false;
+    }
+    Console.printf("Baseline of %d DUT%s queued for flash\n", header.numDuts, header.numDuts > 1 ? "s" : "");
+    return true;
+}
+
+void forgetStoredBaseline() {
+    baselineCalSet[0] = '\0';
+    if (isStorageMounted()) {
+        queueStorageRemove(BASELINE_TMP_FILE);
+        queueStorageRemove(BASELINE_FILE);
+    }
+}
+
+/*=========================RESTORE=========================*/
+
+static bool headerValid(const BaselineHeader& header) {
+    return header.magic == BASELINE_MAGIC && header.version == BASELINE_VERSION &&
+           header.crc == crc16_ccitt((const uint8_t*)&header, offsetof(BaselineHeader, crc)) &&
+           header.calSet[CAL_SET_NAME_MAX - 1] == '\0';
+}
+
+// Unpack a record into the DUT's baseline row - not visible until the
+// session publishes the counts
+static void loadRecord(const BaselineDutRecord& record) {
+    const ImpedanceRow& row = baselineImpedanceData[record.dut];
+    resetBaselineSlots(record.dut);
+    for (int i = 0; i < record.count; i++) {
+        const BaselinePoint& stored = record.points[i];
+        ImpedancePoint point;
+        point.freq_hz = stored.freq_hz;
+        point.freq_idx = getSweepFrequencyIndex(stored.freq_hz);
+        point.Z_magnitude = stored.mag;
+        point.Z_phase = stored.phase;
+        point.pga_gain = stored.flags & IMPEDANCE_FLAG_PGA_MASK;
+        point.tia_gain = (stored.flags & IMPEDANCE_FLAG_TIA_HIGH) != 0;
+        point.valid = (stored.flags & IMPEDANCE_FLAG_VALID) != 0;
+        PointNoise noise;
+        noise.magSd = stored.magSd;
+        noise.phaseSd = stored.phaseSd;
+        storeImpedancePoint(row, i, point, noise);
+        recordBaselinePoint(record.dut, i, point);
+    }
+}
+
+// Rows of another layout would not line up
+static bool headerFits(const BaselineHeader& header) {
+    return headerValid(header) && header.storeDuts == getDUTCount() && header.storePoints == getPointsPerDUT() &&
+           header.numDuts >= 1 && header.numDuts <= header.storeDuts;
+}
+
+// Load a checked record of header into its row, false if it is not DUT dut's
+static bool restoreRecord(const BaselineHeader& header, const BaselineDutRecord& record, uint8_t dut,
+                          uint8_t* counts) {
+    if (record.dut != dut || record.count > header.storePoints ||
+        record.crc != crc16_ccitt((const uint8_t*)&record, offsetof(BaselineDutRecord, crc))) {
+        return false;
+    }
+    loadRecord(record);
+    counts[dut] = record.count;
+    // An empty slot's row holds only its open leading points
+    bool anyValid = false;
+    for (int i = 0; i < record.count; i++) {
+        anyValid = anyValid || (record.points[i].flags & IMPEDANCE_FLAG_VALID);
+    }
+    if (!anyValid) {
+        markChannelOpen(dut);
+    }
+    return true;
+}
+
+// Every record loaded - publish the session and the plan
+static void finishRestore(const BaselineHeader& header, const uint8_t* counts) {
+    num_duts = header.numDuts;
+    startIDX = header.startIdx;
+    endIDX = header.endIdx;
+    sweepMask = header.mask;
+    restoreBaselineSession(counts, header.mask != 0 ? header.mask : getSweepRangeMask(startIDX, endIDX));
+    snprintf(baselineCalSet, sizeof(baselineCalSet), "%s", header.calSet);
+
+    // Derived from the rows, not stored
+    for (uint8_t dut = 0; dut < header.numDuts; dut++) {
+#if KK_CHECK
+        checkDUTKramersKronig(dut, false);
+#endif
+#if CIRCUIT_FIT
+        fitDUTCircuit(dut, false);
+#endif
+    }
+    finalMeasurementDone = false;
+    baselineMeasurementDone = true;
+    Console.printf("Baseline of %d DUT%s restored (calibration set \"%s\")\n", header.numDuts,
+                  header.numDuts > 1 ? "s" : "", baselineCalSet);
+}
+
+bool restoreBaseline() {
+    if (!isStorageMounted() || !LittleFS.exists(BASELINE_FILE)) {
+        return false;
+    }
+    fs::File file = LittleFS.open(BASELINE_FILE, "r");
+    if (!file) {
+        return false;
+    }
+
+    BaselineHeader header;
+    bool ok = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && headerFits(header);
+
+    uint8_t counts[MAX_DUT_COUNT] = {};
+    static BaselineDutRecord record;    // Boot task only
+    for (uint8_t dut = 0; ok && dut < header.numDuts; dut++) {
+        ok = file.read((uint8_t*)&record, sizeof(record)) == sizeof(record) &&
+             restoreRecord(header, record, dut, counts);
+    }
+    file.close();
+    if (!ok) {
+        Console.println("WARNING: Stored baseline invalid or of another layout - discarded");
+        LittleFS.remove(BASELINE_FILE);
+        return false;
+    }
+    finishRestore(header, counts);
+    return true;
+}
+
+bool restoreBaselineRecords(const BaselineHeader& header, const BaselineDutRecord* records) {
+    bool ok = headerFits(header);
+    uint8_t counts[MAX_DUT_COUNT] = {};
+    for (uint8_t dut = 0; ok && dut < header.numDuts; dut++) {
+        ok = restoreRecord(header, records[dut], dut, counts);
+    }
+    if (ok) {
+        finishRestore(header, counts);
+    }
+    return ok;
+}
+
+bool isBaselineCalibrationCurrent() {
+    return strcmp(baselineCalSet, getCalibrationSetName()) == 0;
+}
@@ -0,0 +1,61 @@
+#include "bg_jobs.h"
+#include "sweep_eta.h"
+
+struct BackgroundJob {
+    BackgroundJobFn fn;
+    uint8_t arg;
+    uint32_t queuedMs;
+};
+
+// GUI task only
+static BackgroundJob jobs[BG_JOB_QUEUE_DEPTH];
+static uint8_t head = 0;
+static uint8_t count = 0;
+
+void queueBackgroundJob(BackgroundJobFn fn, uint8_t arg) {
+    if (count == BG_JOB_QUEUE_DEPTH) {
+        // Keeps the order: everything queued before it runs first
+        flushBackgroundJobs();
+        fn(arg);
+        return;
+    }
+    BackgroundJob& job = jobs[(head + count) % BG_JOB_QUEUE_DEPTH];
+    job.fn = fn;
+    job.arg = arg;
+    job.queuedMs = millis();
+    count++;
+}
+
+// Remove and run the oldest job
+static void runNextJob() {
+    BackgroundJob job = jobs[head];
+    head = (head + 1) % BG_JOB_QUEUE_DEPTH;
+    count--;
+    // A job may queue follow-up jobs
+    job.fn(job.arg);
+}
+
+void flushBackgroundJobs() {
+    while (count > 0) {
+        runNextJob();
+    }
+}
+
+// The oldest job may start now
+static bool jobFits() {
+    return getSweepGapMs() >= BG_JOB_GAP_MS || millis() - jobs[head].queuedMs >= BG_JOB_DEFER_MAX_MS;
+}
+
+void processBackgroundJobs() {
+    uint32_t start = millis();
+    while (count > 0 && millis() - start < BG_JOB_SLICE_MS && jobFits()) {
+        runNextJob();
+    }
+}
+
+uint32_t getBackgroundJobsWaitMs() {
+    if (count == 0) {
+        return UINT32_MAX;
+    }
+    return jobFits() ? 0 : BG_JOB_RETRY_MS;
+}
@@ -0,0 +1,138 @@
+// Host SDK - [env:sdk] only, the firmware build (ARDUINO) compiles this file
+// to nothing. The decoding is the firmware's own (uart_frame.cpp,
+// session_codec.cpp); this file only walks the host-side containers
+//
+// Usage: pio run -e sdk
+//        python biopal_sdk.py history.bin
+#ifndef ARDUINO
+
+#include "biopal_sdk.h"
+#include "sweep_table.h"
+#include <unordered_map>
+
+int biopalSdkVersion(void) {
+    return BIOPAL_SDK_VERSION;
+}
+
+/*=========================UART STREAM=========================*/
+
+struct FrameIndex {
+    const uint8_t* data;
+    BiopalFrame* frames;
+    size_t maxFrames;
+    size_t found;
+};
+
+static void indexFrame(uint8_t type, const uint8_t* payload, size_t len, bool v2, void* context) {
+    FrameIndex& index = *static_cast<FrameIndex*>(context);
+    if (index.found < index.maxFrames) {
+        BiopalFrame& frame = index.frames[index.found];
+        frame.offset = payload - index.data;
+        frame.len = len;
+        frame.type = type;
+        frame.v2 = v2;
+    }
+    index.found++;
+}
+
+size_t biopalIndexUARTFrames(const uint8_t* data, size_t len, BiopalFrame* frames, size_t maxFrames,
+                             size_t* consumed, UARTFrameCounters* counters) {
+    FrameIndex index = {data, frames, maxFrames, 0};
+    UARTFrameCounters unused = {};
+    scanUARTFrames(data, len, consumed, indexFrame, &index, counters != nullptr ? *counters : unused);
+    return index.found;
+}
+
+/*=========================SESSION HISTORY=========================*/
+// The image is SESSION_LOG_OLD_FILE then SESSION_LOG_FILE: header.offset is
+// the record's place in its own file, so a reference is found at
+// pos - header.offset + header.reference of the image
+
+struct BiopalHistory {
+    const uint8_t* image;
+    size_t len;
+    size_t pos;
+    std::unordered_map<size_t, Session> references;     // Self-contained records by image offset
+};
+
+BiopalHistory* biopalHistoryOpen(const uint8_t* image, size_t len) {
+    return new BiopalHistory{image, len, 0, {}};
+}
+
+void biopalHistoryClose(BiopalHistory* history) {
+    delete history;
+}
+
+bool biopalHistoryNext(BiopalHistory* history, const SessionHeader** header, size_t* pos, Session* out) {
+    while (history->pos + sizeof(SessionHeader) <= history->len) {
+        size_t at = history->pos;
+        const SessionHeader* record = reinterpret_cast<const SessionHeader*>(history->image + at);
+        const uint8_t* data = history->image + at + sizeof(SessionHeader);
+        size_t end = at + sizeof(SessionHeader) + record->bytes;
+        // Resync byte by byte after damage, as the firmware's index rebuild does
+        if (record->magic != SESSION_MAGIC || record->offset > at || record->count > MAX_FREQUENCIES ||
+            record->bytes > SESSION_DATA_MAX || end > history->len ||
+            sessionRecordCrc(*record, data) != record->crc) {
+            history->pos++;
+            continue;
+        }
+        history->pos = end;
+
+        const Session* ref = nullptr;
+        if (record->reference != SESSION_NO_REFERENCE) {
+            auto found = history->references.find(at - record->offset + record->reference);
+            if (found == history->references.end()) {
+                continue;
+            }
+            ref = &found->second;
+        }
+        if (!decodeSessionPoints(*record, data, ref, *out)) {
+            continue;
+        }
+        if (ref == nullptr) {
+            history->references[at] = *out;
+        }
+        *header = record;
+        *pos = at;
+        return true;
+    }
+    return false;
+}
+
+/*=========================BLE BINARY=========================*/
+
+static uint32_t binaryFrequency(uint16_t code) {
+    if (code & BLE_BIN_FREQ_OFFGRID) {
+        return (uint32_t)(code & ~BLE_BIN_FREQ_OFFGRID) * BLE_BIN_OFFGRID_STEP_HZ;
+    }
+    return code < SWEEP_FREQ_COUNT ? sweepFrequencies[code] : 0;
+}
+
+int biopalDecodeBinaryPacket(const uint8_t* data, size_t len, const BLEBinaryHeader** header,
+                             BiopalPoint* points) {
+    if (len < sizeof(BLEBinaryHeader)) {
+        return -1;
+    }
+    const BLEBinaryHeader* packet = reinterpret_cast<const BLEBinaryHeader*>(data);
+    bool spread = packet->flags & BLE_BIN_FLAG_SPREAD;
+    size_t pointSize = spread ? sizeof(BLEBinarySpreadPoint) : sizeof(BLEBinaryPoint);
+    if (packet->magic != BLE_BIN_MAGIC ||
+        (packet->type != BLE_BIN_TYPE_DATA && packet->type != BLE_BIN_TYPE_POINT) ||
+        packet->count > MAX_FREQUENCIES || len < sizeof(BLEBinaryHeader) + packet->count * pointSize) {
+        return -1;
+    }
+    const uint8_t* body = data + sizeof(BLEBinaryHeader);
+    for (int i = 0; i < packet->count; i++) {
+        BLEBinarySpreadPoint point = {};
+        memcpy(&point, body + i * pointSize, pointSize);
+        points[i].freq_hz = binaryFrequency(point.point.freq);
+        points[i].mag = powf(10.0f, point.point.mag / BLE_BIN_MAG_LOG_SCALE + BLE_BIN_MAG_LOG_MIN);
+        points[i].phase = point.point.phase / BLE_BIN_PHASE_SCALE;
+        points[i].magSd = point.magSd;
+        points[i].phaseSd = point.phaseSd;
+    }
+    *header = packet;
+    return packet->count;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,264 @@
+#include "ble_bench.h"
+#include "console.h"
+#include "BLE_Functions.h"
+#include "defines.h"
+#include "sweep_table.h"
+#include "monitor.h"
+#include <ArduinoJson.h>
+#include <esp_timer.h>
+
+// Run settings and progress - only touched by the GUI task
+static bool active = false;
+static bool queuing = false;        // Still queuing (else waiting for the TX task)
+static bool binary = true;
+static uint8_t txFlags = BLE_TX_FLAG_BENCH;
+static int8_t client = BLE_NO_CLIENT;
+static size_t chunk = 0;
+static uint32_t targetBytes = 0;
+static uint32_t queuedBytes = 0;
+static uint32_t messages = 0;
+static uint32_t queueFailures = 0;
+static int64_t startUs = 0;
+static uint32_t lastProgressMs = 0;
+static uint32_t lastSentBytes = 0;
+
+// TX counters when the run started - the report shows the difference
+static BLETxCounters base;
+
+// Last report, for BLE_BENCH:RESULT
+static uint32_t reportNotifications = 0;
+static uint32_t reportBytes = 0;
+
+bool isBLEBenchActive() {
+    return active;
+}
+
+/*=========================PAYLOADS=========================*/
+// Deterministic RC-like sweep point i
+static void syntheticPoint(int i, float& mag, float& phase) {
+    mag = 1000.0f / (1.0f + i * 0.25f);
+    phase = -2.0f * i;
+}
+
+static bool queueBinaryMessage(size_t payload) {
+    static uint8_t packet[512];
+    payload = min(payload, sizeof(packet));
+    BLEBenchHeader* header = (BLEBenchHeader*)packet;
+    header->magic = BLE_BIN_MAGIC;
+    header->type = BLE_BIN_TYPE_BENCH;
+    header->reserved = 0;
+    header->seq = messages;
+
+    size_t points = (payload - sizeof(BLEBenchHeader)) / sizeof(BLEBinaryPoint);
+    BLEBinaryPoint* point = (BLEBinaryPoint*)(packet + sizeof(BLEBenchHeader));
+    for (size_t i = 0; i < points; i++) {
+        float mag, phase;
+        syntheticPoint(i % SWEEP_FREQ_COUNT, mag, phase);
+        point[i].freq = i % SWEEP_FREQ_COUNT;
+        point[i].mag = (log10f(mag) - BLE_BIN_MAG_LOG_MIN) * BLE_BIN_MAG_LOG_SCALE;
+        point[i].phase = phase * BLE_BIN_PHASE_SCALE;
+    }
+    size_t len = sizeof(BLEBenchHeader) + points * sizeof(BLEBinaryPoint);
+    if (!queueBLEClientMessage(client, packet, len, len, txFlags)) {
+        return false;
+    }
+    queuedBytes += len;
+    return true;
+}
+
+static bool queueJSONMessage() {
+    JsonDocument doc;
+    doc["seq"] = messages;
+    doc["count"] = SWEEP_FREQ_COUNT;
+    JsonArray freqArray = doc["freq"].to<JsonArray>();
+    JsonArray magArray = doc["mag"].to<JsonArray>();
+    JsonArray phaseArray = doc["phase"].to<JsonArray>();
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        float mag, phase;
+        syntheticPoint(i, mag, phase);
+        freqArray.add(sweepFrequencies[i]);
+        magArray.add(serialized(String(mag, 3)));
+        phaseArray.add(serialized(String(phase, 2)));
+    }
+
+    String benchMsg = String(BLE_RESP_BENCH) + ":";
+    serializeJson(doc, benchMsg);
+    size_t len = benchMsg.length();
+    if (!queueBLEClientMessage(client, (const uint8_t*)benchMsg.c_str(), len, chunk, txFlags)) {
+        return false;
+    }
+    queuedBytes += len;
+    return true;
+}
+
+/*=========================REPORT=========================*/
+static void report(const char* reason) {
+    BLETxCounters now;
+    getBLETxCounters(now);
+    uint32_t sentBytes = now.benchBytes - base.benchBytes;
+    int64_t endUs = now.lastBenchUs > startUs ? now.lastBenchUs : startUs;
+    uint32_t ms = (endUs - startUs) / 1000;
+
+    reportNotifications = now.benchNotifications - base.benchNotifications;
+    reportBytes = sentBytes;
+    active = false;
+
+    JsonDocument doc;
+    doc["end"] = reason;
+    doc["format"] = binary ? "BIN" : "JSON";
+    doc["mode"] = (txFlags & BLE_TX_FLAG_INDICATE) ? "INDICATE" : "NOTIFY";
+    doc["chunk"] = chunk;
+    doc["payload"] = getBLEClientPayloadSize(client);
+    doc["bytes"] = sentBytes;
+    doc["messages"] = messages;
+    doc["notifications"] = reportNotifications;
+    doc["ms"] = ms;
+    doc["bps"] = ms ? (uint32_t)((uint64_t)sentBytes * 1000 / ms) : 0;
+    doc["send_errors"] = now.sendErrors - base.sendErrors;
+    doc["dropped_bytes"] = now.benchDropBytes - base.benchDropBytes;
+    doc["queue_failures"] = queueFailures;
+    doc["credit_timeouts"] = now.creditTimeouts - base.creditTimeouts;
+    doc["congested"] = now.congestEvents - base.congestEvents;
+
+    String reportMsg = String(BLE_RESP_BENCH) + ":";
+    serializeJson(doc, reportMsg);
+    Console.printf("[BENCH] %s\n", reportMsg.c_str());
+    sendBLEString(reportMsg.c_str());
+}
+
+// Client-side counts against the last report
+static void reportDrops(const char* args) {
+    char* end;
+    uint32_t notifications = strtoul(args, &end, 10);
+    if (*end != ',') {
+        sendBLEError("Invalid bench result");
+        return;
+    }
+    uint32_t bytes = strtoul(end + 1, nullptr, 10);
+
+    char buffer[96];
+    snprintf(buffer, sizeof(buffer), "%s:%lu,%lu,%lu,%lu", BLE_RESP_BENCH_RESULT,
+             (unsigned long)reportNotifications, (unsigned long)notifications,
+             (unsigned long)(reportNotifications > notifications ? reportNotifications - notifications : 0),
+             (unsigned long)(reportBytes > bytes ? reportBytes - bytes : 0));
+    sendBLEString(buffer);
+}
+
+/*=========================COMMAND=========================*/
+void handleBLEBenchCommand(const char* args) {
+    if (strcmp(args, "STOP") == 0) {
+        if (active) {
+            report("stopped");
+        } else {
+            sendBLEStatus("Bench idle");
+        }
+        return;
+    }
+    if (strncmp(args, "RESULT,", 7) == 0) {
+        reportDrops(args + 7);
+        return;
+    }
+    if (active) {
+        sendBLEError("Bench already running");
+        return;
+    }
+    if (measurementInProgress || isMonitorActive()) {
+        sendBLEError("Measurement in progress");
+        return;
+    }
+    if (getBLECommandClient() == BLE_NO_CLIENT) {
+        return;  // Serial or a client that left - nowhere to stream to
+    }
+
+    // <bytes>[,<BIN|JSON>[,<chunk>[,<NOTIFY|INDICATE>]]]
+    bool ok = true;
+    char* cursor = (char*)args;
+    uint32_t bytes = *cursor ? strtoul(cursor, &cursor, 10) : BLE_BENCH_DEFAULT_BYTES;
+    bool useBinary = true;
+    uint32_t chunkSize = 0;
+    bool indicate = false;
+    if (*cursor == ',') {
+        cursor++;
+        useBinary = strncmp(cursor, "BIN", 3) == 0;
+        ok = useBinary || strncmp(cursor, "JSON", 4) == 0;
+        cursor += useBinary ? 3 : 4;
+    }
+    if (ok && *cursor == ',') {
+        chunkSize = strtoul(cursor + 1, &cursor, 10);
+    }
+    if (ok && *cursor == ',') {
+        cursor++;
+        indicate = strncmp(cursor, "INDICATE", 8) == 0;
+        ok = indicate || strncmp(cursor, "NOTIFY", 6) == 0;
+        cursor += indicate ? 8 : 6;
+    }
+    if (!ok || *cursor != '\0' || bytes == 0 || bytes > BLE_BENCH_MAX_BYTES) {
+        sendBLEError("Invalid bench parameters");
+        return;
+    }
+
+    client = getBLECommandClient();
+    size_t payload = getBLEClientPayloadSize(client);
+    if (chunkSize == 0 || chunkSize > payload) {
+        chunkSize = payload;
+    }
+    if (useBinary && chunkSize < sizeof(BLEBenchHeader) + sizeof(BLEBinaryPoint)) {
+        sendBLEError("Bench chunk too small");
+        return;
+    }
+
+    binary = useBinary;
+    chunk = chunkSize;
+    txFlags = BLE_TX_FLAG_BENCH | (indicate ? BLE_TX_FLAG_INDICATE : 0);
+    targetBytes = bytes;
+    queuedBytes = 0;
+    messages = 0;
+    queueFailures = 0;
+    getBLETxCounters(base);
+    lastSentBytes = base.benchBytes;
+    lastProgressMs = millis();
+    startUs = esp_timer_get_time();
+    active = true;
+    queuing = true;
+
+    char statusMsg[48];
+    snprintf(statusMsg, sizeof(statusMsg), "Bench:%lu,%s,%d,%s", (unsigned long)targetBytes,
+             binary ? "BIN" : "JSON", (int)chunk, indicate ? "INDICATE" : "NOTIFY");
+    sendBLEStatus(statusMsg);
+    Console.printf("[BENCH] Started: %s\n", statusMsg);
+}
+
+/*=========================STREAMING=========================*/
+void processBLEBench() {
+    if (!active) {
+        return;
+    }
+    if (getBLEClientPayloadSize(client) == 0) {
+        active = false;
+        Console.println("[BENCH] Client disconnected - run dropped");
+        return;
+    }
+
+    // Fill the TX buffer, leaving room for status and data messages
+    while (queuing && getBLETxFree() > BLE_BENCH_TX_RESERVE + BLE_BENCH_MSG_MAX) {
+        if (!(binary ? queueBinaryMessage(chunk) : queueJSONMessage())) {
+            queueFailures++;
+            break;  // Retried next loop
+        }
+        messages++;
+        queuing = queuedBytes < targetBytes;
+    }
+
+    BLETxCounters now;
+    getBLETxCounters(now);
+    if (now.benchBytes != lastSentBytes) {
+        lastSentBytes = now.benchBytes;
+        lastProgressMs = millis();
+    }
+    uint32_t handled = (now.benchBytes - base.benchBytes) + (now.benchDropBytes - base.benchDropBytes);
+    if (!queuing && handled >= queuedBytes) {
+        report("done");
+    } else if (millis() - lastProgressMs >= BLE_BENCH_IDLE_MS) {
+        report("stalled");
+    }
+}
@@ -1,5 +1,13 @@
 #include "bode_plot.h"
+#include "console.h"
 #include "defines.h"
+#include "calibration.h"
+#include "fixed_cal.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "gui_screens.h"
+#include "sweep_table.h"
+#include "UART_Functions.h"
 #include <TFT_eSPI.h>
 #include <math.h>
 
@@ -24,6 +32,8 @@ TFT_eSPI tft = TFT_eSPI();
 #define PLOT_X0 MARGIN_LEFT
 #define PLOT_Y0 (SCREEN_HEIGHT - MARGIN_BOTTOM)
 
+#define DASH_BATCH  64    // Dash pixels per drawPixels() call
+
 // Colors
 #define COLOR_BG        TFT_BLACK
 #define COLOR_GRID      TFT_DARKGREY
@@ -31,43 +41,113 @@ TFT_eSPI tft = TFT_eSPI();
 #define COLOR_MAG       TFT_CYAN      // Magnitude line
 #define COLOR_PHASE     TFT_YELLOW    // Phase line
 #define COLOR_TEXT      TFT_WHITE
+#define COLOR_BASELINE  TFT_LIGHTGREY // Overlay: baseline magnitude
+#define COLOR_DELTA     TFT_YELLOW    // Overlay: |dZ|/Z line
+
+// Live plot: phase axis in steps of this many degrees, so a new point only
+// rescales when it crosses one; magnitude decades before the first point
+#define LIVE_PHASE_STEP     30
+#define LIVE_MAG_MIN_EXP    1
+#define LIVE_MAG_MAX_EXP    4
+
+// Overlay: |dZ|/Z axis from 0 up to the first of these percentages that
+// holds the largest change of all DUTs
+static const uint16_t deltaAxisSteps[] = {5, 10, 25, 50, 100, 250, 500, 1000};
+
+// External state variables (from main.cpp)
+extern uint8_t startIDX;
+extern uint8_t endIDX;
+extern uint8_t num_duts;
+
+// Plot of the last drawBodePlot() in screen coordinates - computed once,
+// then drawn into every band
+struct PlotPoint {
+    int16_t x;
+    int16_t y;
+};
+
+enum PlotMode : uint8_t {
+    PLOT_BODE,                      // |Z| and phase of the baseline
+    PLOT_LIVE,                      // Same, of the running sweep
+    PLOT_OVERLAY                    // Baseline and final |Z|, |dZ|/Z
+};
+
+struct BodeLayout {
+    uint8_t dut;
+    PlotMode mode;
+    int freqMinExp, freqMaxExp;     // Decades of the axes
+    int magMinExp, magMaxExp;
+    float rightMin, rightMax;       // Right axis: phase (degrees) or |dZ|/Z (%)
+    int rightStep;
+    uint8_t magCount, rightCount, baseCount;
+    PlotPoint mag[MAX_FREQUENCIES];     // Solid |Z| line (final |Z| on the overlay)
+    PlotPoint right[MAX_FREQUENCIES];   // Dashed right axis line
+    PlotPoint base[MAX_FREQUENCIES];    // Overlay: baseline |Z|
+};
+
+static BodeLayout plot;
+
+// The overlay axes fit all DUTs and are kept while browsing them
+static bool overlayAxesValid = false;
+
+// X of each sweep table frequency on the current axis
+static int16_t sweepX[SWEEP_FREQ_COUNT];
+
+// Points of the live plot DUT already on the panel
+static int livePoints = 0;
+
+// Data ranges of a set of points
+struct PlotRange {
+    float freqMin, freqMax;
+    float magMin, magMax;
+    float phaseMin, phaseMax;
+};
 
 /*=========================HELPER FUNCTIONS=========================*/
 
-// Map frequency to X pixel coordinate (log scale)
-static int16_t freqToX(float freq_hz, float freq_min, float freq_max) {
-    if (freq_hz <= 0 || freq_min <= 0 || freq_max <= 0) return PLOT_X0;
-
-    float log_freq = log10f(freq_hz);
-    float log_min = log10f(freq_min);
-    float log_max = log10f(freq_max);
-
-    float normalized = (log_freq - log_min) / (log_max - log_min);
+// X pixel of decade position log_freq (log scale)
+static int16_t logFreqToX(float log_freq) {
+    float normalized = (log_freq - plot.freqMinExp) / (plot.freqMaxExp - plot.freqMinExp);
     return PLOT_X0 + (int16_t)(normalized * PLOT_WIDTH);
 }
 
 // Map magnitude to Y pixel coordinate (log scale, inverted for screen)
-static int16_t magToY(float mag, float mag_min, float mag_max) {
-    if (mag <= 0 || mag_min <= 0 || mag_max <= 0) return PLOT_Y0;
-
-    float log_mag = log10f(mag);
-    float log_min = log10f(mag_min);
-    float log_max = log10f(mag_max);
-
-    float normalized = (log_mag - log_min) / (log_max - log_min);
+static int16_t magToY(float mag) {
+    if (mag <= 0) return PLOT_Y0;
+
+#if CAL_FIXED_POINT
+    // Base cancels out in the ratio - integer log2 is enough
+    // log2(10^exp) = exp * log2(10), log2(10) = 217706 in Q16.16
+    fx_log2_t log_mag = fxLog2(mag);
+    fx_log2_t log_min = (fx_log2_t)plot.magMinExp * 217706;
+    fx_log2_t log_max = (fx_log2_t)plot.magMaxExp * 217706;
+    return PLOT_Y0 - (int16_t)((int64_t)(log_mag - log_min) * PLOT_HEIGHT / (log_max - log_min));
+#else
+    float normalized = (log10f(mag) - plot.magMinExp) / (plot.magMaxExp - plot.magMinExp);
     // Invert Y because screen coordinates go top-to-bottom
     return PLOT_Y0 - (int16_t)(normalized * PLOT_HEIGHT);
+#endif
 }
 
-// Map phase to Y pixel coordinate (linear scale, inverted for screen)
-static int16_t phaseToY(float phase_deg, float phase_min, float phase_max) {
-    float normalized = (phase_deg - phase_min) / (phase_max - phase_min);
+// Map phase (or |dZ|/Z) to Y pixel coordinate (linear scale, inverted for screen)
+static int16_t rightToY(float value) {
+    float normalized = (value - plot.rightMin) / (plot.rightMax - plot.rightMin);
     // Invert Y because screen coordinates go top-to-bottom
     return PLOT_Y0 - (int16_t)(normalized * PLOT_HEIGHT);
 }
 
-// Draw dashed line
-static void drawDashedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+// Grid positions of decade exp - no powf, the axes end on decades
+static int16_t decadeX(int exp) {
+    return PLOT_X0 + (exp - plot.freqMinExp) * PLOT_WIDTH / (plot.freqMaxExp - plot.freqMinExp);
+}
+
+static int16_t decadeY(int exp) {
+    return PLOT_Y0 - (exp - plot.magMinExp) * PLOT_HEIGHT / (plot.magMaxExp - plot.magMinExp);
+}
+
+// Draw dashed line - the dash pixels go out in batches of one drawPixels()
+// call (sprite or tft), which turns each dash into a span or two
+static void drawDashedLine(TFT_eSPI& gfx, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
     int16_t dx = abs(x1 - x0);
     int16_t dy = abs(y1 - y0);
     int16_t sx = (x0 < x1) ? 1 : -1;
@@ -78,14 +158,19 @@ static void drawDashedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint1
     const int16_t dashLength = 5;
     const int16_t gapLength = 3;
     bool drawing = true;
+    int16_t xy[2 * DASH_BATCH];
+    uint32_t pending = 0;
 
     while (true) {
         if (drawing) {
-            tft.drawPixel(x0, y0, color);
+            xy[2 * pending] = x0;
+            xy[2 * pending + 1] = y0;
+            if (++pending == DASH_BATCH) {
+                gfx.drawPixels(xy, pending, color);
+                pending = 0;
+            }
         }
-
-        dashCount++;
-        if (dashCount >= (drawing ? dashLength : gapLength)) {
+        if (++dashCount >= (drawing ? dashLength : gapLength)) {
             dashCount = 0;
             drawing = !drawing;
         }
@@ -102,189 +187,438 @@ static void drawDashedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint1
             y0 += sy;
         }
     }
+    if (pending > 0) {
+        gfx.drawPixels(xy, pending, color);
+    }
 }
 
-/*=========================PUBLIC FUNCTIONS=========================*/
+// Draw the plot into the current band
+static void drawBodeFrame() {
+    sprite.fillSprite(COLOR_BG);
+    sprite.setTextDatum(TL_DATUM);
+    char buf[24];
 
+    // Draw title
+    sprite.setTextColor(COLOR_TEXT);
+    sprite.setTextSize(2);
+    const char* title = plot.mode == PLOT_LIVE ? "DUT %d Live Sweep" :
+                        plot.mode == PLOT_OVERLAY ? "DUT %d Base/Final" : "DUT %d Bode Plot";
+    snprintf(buf, sizeof(buf), title, plot.dut + 1);
+    sprite.drawString(buf, 10, 5, 1);
+    sprite.setTextSize(1);
+    bool overlay = plot.mode == PLOT_OVERLAY;
+    uint16_t rightColor = overlay ? COLOR_DELTA : COLOR_PHASE;
+
+    // Overlay legend
+    if (overlay) {
+        sprite.setTextColor(COLOR_BASELINE);
+        sprite.drawString("base", SCREEN_WIDTH - 90, 4, 1);
+        sprite.setTextColor(COLOR_MAG);
+        sprite.drawString("final", SCREEN_WIDTH - 90, 16, 1);
+        sprite.setTextColor(COLOR_DELTA);
+        sprite.drawString("dZ/Z", SCREEN_WIDTH - 45, 4, 1);
+    }
 
-void drawBodePlot(uint8_t dutIndex) {
-    if (dutIndex >= MAX_DUT_COUNT) {
-        Serial.printf("ERROR: Invalid DUT index %d\n", dutIndex);
-        return;
+    // Draw grid lines at powers of 10 for frequency (X-axis)
+    for (int exp = plot.freqMinExp; exp <= plot.freqMaxExp; exp++) {
+        int16_t x = decadeX(exp);
+        if (x > PLOT_X0 && x < PLOT_X0 + PLOT_WIDTH) {
+            sprite.drawFastVLine(x, PLOT_Y0 - PLOT_HEIGHT, PLOT_HEIGHT + 1, COLOR_GRID);
+        }
     }
 
-    int numPoints = frequencyCount[dutIndex];
-    if (numPoints == 0) {
-        Serial.printf("WARNING: No data for DUT %d\n", dutIndex + 1);
-        return;
+    // Draw grid lines at powers of 10 for magnitude (Y-axis)
+    for (int exp = plot.magMinExp; exp <= plot.magMaxExp; exp++) {
+        int16_t y = decadeY(exp);
+        if (y > PLOT_Y0 - PLOT_HEIGHT && y < PLOT_Y0) {
+            sprite.drawFastHLine(PLOT_X0, y, PLOT_WIDTH + 1, COLOR_GRID);
+        }
     }
 
-    Serial.printf("Drawing Bode plot for DUT %d (%d points)\n", dutIndex + 1, numPoints);
+    // Draw axes
+    sprite.drawFastHLine(PLOT_X0, PLOT_Y0, PLOT_WIDTH + 1, COLOR_AXIS);                   // X-axis
+    sprite.drawFastVLine(PLOT_X0, PLOT_Y0 - PLOT_HEIGHT, PLOT_HEIGHT + 1, COLOR_AXIS);    // Y-axis
 
-    // Find data ranges
-    float freq_min = 1e9, freq_max = 0;
-    float mag_min = 1e9, mag_max = 0;
-    float phase_min = 1e9, phase_max = -1e9;
+    // X-axis label (frequency)
+    sprite.drawString("Frequency (Hz)", SCREEN_WIDTH / 2 - 30, SCREEN_HEIGHT - 10, 1);
+
+    // Y-axis labels (magnitude left, phase or |dZ|/Z right)
+    sprite.setTextColor(COLOR_MAG);
+    sprite.drawString("|Z|", 5, SCREEN_HEIGHT / 2, 1);
 
-    for (int i = 0; i < numPoints; i++) {
-        ImpedancePoint* point = &baselineImpedanceData[dutIndex][i];
-        if (!point->valid) continue;
+    sprite.setTextColor(rightColor);
+    sprite.drawString(overlay ? "dZ %" : "Phase", SCREEN_WIDTH - 40, SCREEN_HEIGHT / 2, 1);
 
-        if (point->freq_hz > 0) {
-            if (point->freq_hz < freq_min) freq_min = point->freq_hz;
-            if (point->freq_hz > freq_max) freq_max = point->freq_hz;
+    // Frequency ticks (X-axis) - scientific notation
+    sprite.setTextColor(COLOR_TEXT);
+    for (int exp = plot.freqMinExp; exp <= plot.freqMaxExp; exp++) {
+        int16_t x = decadeX(exp);
+        if (x >= PLOT_X0 && x <= PLOT_X0 + PLOT_WIDTH) {
+            snprintf(buf, sizeof(buf), "10^%d", exp);
+            sprite.drawString(buf, x - 15, PLOT_Y0 + 5, 1);
         }
+    }
 
-        if (point->Z_magnitude > 0) {
-            if (point->Z_magnitude < mag_min) mag_min = point->Z_magnitude;
-            if (point->Z_magnitude > mag_max) mag_max = point->Z_magnitude;
+    // Magnitude ticks (Y-axis left) - scientific notation
+    sprite.setTextColor(COLOR_MAG);
+    for (int exp = plot.magMinExp; exp <= plot.magMaxExp; exp++) {
+        int16_t y = decadeY(exp);
+        if (y >= PLOT_Y0 - PLOT_HEIGHT && y <= PLOT_Y0) {
+            snprintf(buf, sizeof(buf), "10^%d", exp);
+            sprite.drawString(buf, 2, y - 4, 1);
         }
+    }
 
-        if (point->Z_phase < phase_min) phase_min = point->Z_phase;
-        if (point->Z_phase > phase_max) phase_max = point->Z_phase;
+    // Phase ticks (Y-axis right) - degrees, or |dZ|/Z in percent
+    sprite.setTextColor(rightColor);
+    for (int value = (int)plot.rightMin; value <= (int)plot.rightMax; value += plot.rightStep) {
+        int16_t y = rightToY(value);
+        if (y >= PLOT_Y0 - PLOT_HEIGHT && y <= PLOT_Y0) {
+            snprintf(buf, sizeof(buf), "%d", value);
+            sprite.drawString(buf, SCREEN_WIDTH - 25, y - 4, 1);
+        }
     }
 
-    // Round to nice power-of-10 boundaries for log scales
-    int freq_min_exp = (int)floorf(log10f(freq_min));
-    int freq_max_exp = (int)ceilf(log10f(freq_max));
-    freq_min = powf(10.0f, freq_min_exp);
-    freq_max = powf(10.0f, freq_max_exp);
+    // Overlay: baseline magnitude under the final one
+    for (int i = 1; i < plot.baseCount; i++) {
+        sprite.drawLine(plot.base[i - 1].x, plot.base[i - 1].y, plot.base[i].x, plot.base[i].y, COLOR_BASELINE);
+    }
 
-    int mag_min_exp = (int)floorf(log10f(mag_min));
-    int mag_max_exp = (int)ceilf(log10f(mag_max));
-    mag_min = powf(10.0f, mag_min_exp);
-    mag_max = powf(10.0f, mag_max_exp);
+    // Plot magnitude data (solid line)
+    for (int i = 1; i < plot.magCount; i++) {
+        sprite.drawLine(plot.mag[i - 1].x, plot.mag[i - 1].y, plot.mag[i].x, plot.mag[i].y, COLOR_MAG);
+    }
 
-    // Add padding to phase range
-    float phase_range = phase_max - phase_min;
-    phase_min -= phase_range * 0.05f;
-    phase_max += phase_range * 0.05f;
+    // Plot phase (or |dZ|/Z) data (dashed line)
+    for (int i = 1; i < plot.rightCount; i++) {
+        drawDashedLine(sprite, plot.right[i - 1].x, plot.right[i - 1].y, plot.right[i].x, plot.right[i].y, rightColor);
+    }
+}
 
-    // Clear screen
-    tft.fillScreen(COLOR_BG);
+/*=========================LAYOUT=========================*/
 
-    // Draw title
-    tft.setTextColor(COLOR_TEXT);
-    tft.setTextSize(2);
-    tft.setCursor(10, 5);
-    tft.printf("DUT %d Bode Plot", dutIndex + 1);
+static void clearRange(PlotRange& range) {
+    range.freqMin = 1e9;
+    range.freqMax = 0;
+    range.magMin = 1e9;
+    range.magMax = 0;
+    range.phaseMin = 1e9;
+    range.phaseMax = -1e9;
+}
 
-    // Draw axes
-    tft.drawLine(PLOT_X0, PLOT_Y0, PLOT_X0 + PLOT_WIDTH, PLOT_Y0, COLOR_AXIS);  // X-axis
-    tft.drawLine(PLOT_X0, PLOT_Y0, PLOT_X0, PLOT_Y0 - PLOT_HEIGHT, COLOR_AXIS); // Y-axis
+// Extend range by the valid points [0, count) of row
+static void addRange(PlotRange& range, const ImpedanceRow& row, int count) {
+    for (int i = 0; i < count; i++) {
+        if (!isStoredPointValid(row, i)) continue;
 
-    // Draw grid lines at powers of 10 for frequency (X-axis)
-    for (int exp = freq_min_exp; exp <= freq_max_exp; exp++) {
-        float freq = powf(10.0f, exp);
-        int16_t x = freqToX(freq, freq_min, freq_max);
-        if (x > PLOT_X0 && x < PLOT_X0 + PLOT_WIDTH) {
-            tft.drawLine(x, PLOT_Y0, x, PLOT_Y0 - PLOT_HEIGHT, COLOR_GRID);
+        uint32_t freq = storedFrequency(row.freqCode[i]);
+        if (freq > 0) {
+            if (freq < range.freqMin) range.freqMin = freq;
+            if (freq > range.freqMax) range.freqMax = freq;
         }
-    }
 
-    // Draw grid lines at powers of 10 for magnitude (Y-axis)
-    for (int exp = mag_min_exp; exp <= mag_max_exp; exp++) {
-        float mag = powf(10.0f, exp);
-        int16_t y = magToY(mag, mag_min, mag_max);
-        if (y > PLOT_Y0 - PLOT_HEIGHT && y < PLOT_Y0) {
-            tft.drawLine(PLOT_X0, y, PLOT_X0 + PLOT_WIDTH, y, COLOR_GRID);
+        if (row.mag[i] > 0) {
+            if (row.mag[i] < range.magMin) range.magMin = row.mag[i];
+            if (row.mag[i] > range.magMax) range.magMax = row.mag[i];
         }
+
+        if (row.phase[i] < range.phaseMin) range.phaseMin = row.phase[i];
+        if (row.phase[i] > range.phaseMax) range.phaseMax = row.phase[i];
     }
+}
 
-    // Axis labels
-    tft.setTextSize(1);
+// Axes for range: decades for the log scales (at least one), the phase range
+// padded by 5% - or, live, rounded out to LIVE_PHASE_STEP
+static void fitAxes(const PlotRange& range) {
+    plot.freqMinExp = (int)floorf(log10f(range.freqMin));
+    plot.freqMaxExp = max((int)ceilf(log10f(range.freqMax)), plot.freqMinExp + 1);
+    if (range.magMax > 0) {
+        plot.magMinExp = (int)floorf(log10f(range.magMin));
+        plot.magMaxExp = max((int)ceilf(log10f(range.magMax)), plot.magMinExp + 1);
+    } else {
+        plot.magMinExp = LIVE_MAG_MIN_EXP;
+        plot.magMaxExp = LIVE_MAG_MAX_EXP;
+    }
 
-    // X-axis label (frequency)
-    tft.setCursor(SCREEN_WIDTH / 2 - 30, SCREEN_HEIGHT - 10);
-    tft.print("Frequency (Hz)");
+    if (range.phaseMax < range.phaseMin) {
+        plot.rightMin = -90;
+        plot.rightMax = 0;
+    } else if (plot.mode == PLOT_LIVE) {
+        plot.rightMin = floorf(range.phaseMin / LIVE_PHASE_STEP) * LIVE_PHASE_STEP;
+        plot.rightMax = max(ceilf(range.phaseMax / LIVE_PHASE_STEP) * LIVE_PHASE_STEP,
+                            plot.rightMin + LIVE_PHASE_STEP);
+    } else {
+        float phase_range = max(range.phaseMax - range.phaseMin, 1.0f);
+        plot.rightMin = range.phaseMin - phase_range * 0.05f;
+        plot.rightMax = range.phaseMax + phase_range * 0.05f;
+    }
+    plot.rightStep = max((int)((plot.rightMax - plot.rightMin) / 4), 10);
 
-    // Y-axis labels (magnitude left, phase right)
-    tft.setTextColor(COLOR_MAG);
-    tft.setCursor(5, SCREEN_HEIGHT / 2);
-    tft.print("|Z|");
+    // Frequency -> X for the fixed sweep table; off-grid codes are mapped one by one
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        sweepX[i] = logFreqToX(getSweepFreqInfo(i).log10Hz);
+    }
+}
 
-    tft.setTextColor(COLOR_PHASE);
-    tft.setCursor(SCREEN_WIDTH - 40, SCREEN_HEIGHT / 2);
-    tft.print("Phase");
+// Point i of row lies on the current axes
+static bool pointFits(const ImpedanceRow& row, int i) {
+    uint8_t code = row.freqCode[i];
+    uint32_t freq = storedFrequency(code);
+    if (!isStoredPointValid(row, i) || freq == 0) return true;     // Not plotted
+
+    float mag = row.mag[i];
+    float logFreq = code < SWEEP_FREQ_COUNT ? getSweepFreqInfo(code).log10Hz : log10f(freq);
+    return logFreq >= plot.freqMinExp && logFreq <= plot.freqMaxExp &&
+           (mag <= 0 || (log10f(mag) >= plot.magMinExp && log10f(mag) <= plot.magMaxExp)) &&
+           row.phase[i] >= plot.rightMin && row.phase[i] <= plot.rightMax;
+}
 
-    // Tick labels in scientific notation
-    tft.setTextSize(1);
-    char buf[16];
+// Append the screen coordinates of point i of row
+static void mapPoint(const ImpedanceRow& row, int i) {
+    uint8_t code = row.freqCode[i];
+    uint32_t freq = storedFrequency(code);
+    if (!isStoredPointValid(row, i) || freq == 0) return;
 
-    // Frequency ticks (X-axis) - scientific notation
-    tft.setTextColor(COLOR_TEXT);
-    for (int exp = freq_min_exp; exp <= freq_max_exp; exp++) {
-        float freq = powf(10.0f, exp);
-        int16_t x = freqToX(freq, freq_min, freq_max);
+    int16_t x = code < SWEEP_FREQ_COUNT ? sweepX[code] : logFreqToX(log10f(freq));
+    if (row.mag[i] > 0 && plot.magCount < MAX_FREQUENCIES) {
+        plot.mag[plot.magCount++] = {x, magToY(row.mag[i])};
+    }
+    if (plot.rightCount < MAX_FREQUENCIES) {
+        plot.right[plot.rightCount++] = {x, rightToY(row.phase[i])};
+    }
+}
 
-        if (x >= PLOT_X0 && x <= PLOT_X0 + PLOT_WIDTH) {
-            snprintf(buf, sizeof(buf), "10^%d", exp);
-            tft.setCursor(x - 15, PLOT_Y0 + 5);
-            tft.print(buf);
-        }
+static void mapPoints(const ImpedanceRow& row, int count) {
+    plot.magCount = 0;
+    plot.rightCount = 0;
+    plot.baseCount = 0;
+    for (int i = 0; i < count; i++) {
+        mapPoint(row, i);
     }
+}
 
-    // Magnitude ticks (Y-axis left) - scientific notation
-    tft.setTextColor(COLOR_MAG);
-    for (int exp = mag_min_exp; exp <= mag_max_exp; exp++) {
-        float mag = powf(10.0f, exp);
-        int16_t y = magToY(mag, mag_min, mag_max);
+/*=========================LIVE PLOT=========================*/
 
-        if (y >= PLOT_Y0 - PLOT_HEIGHT && y <= PLOT_Y0) {
-            snprintf(buf, sizeof(buf), "10^%d", exp);
-            tft.setCursor(2, y - 4);
-            tft.print(buf);
+// DUT the STM32 is sweeping, 0-based
+static uint8_t liveDUT() {
+    uint8_t dut = getCurrentDUT();
+    return (dut >= 1 && dut <= getDUTCount()) ? dut - 1 : 0;
+}
+
+// Row the data processor stores the current sweep in
+static const ImpedanceRow& liveRow(uint8_t dut) {
+    return baselineMeasurementDone ? measurementImpedanceData[dut] : baselineImpedanceData[dut];
+}
+
+static int livePointCount(uint8_t dut) {
+    return min(getStoredPointCount(dut), (int)getPointsPerDUT());
+}
+
+void drawLiveBodePlot() {
+    plot.dut = liveDUT();
+    plot.mode = PLOT_LIVE;
+    const ImpedanceRow& row = liveRow(plot.dut);
+    livePoints = livePointCount(plot.dut);
+
+    // The frequency axis spans the whole sweep from the start
+    PlotRange range;
+    clearRange(range);
+    range.freqMin = min(sweepFrequencies[startIDX], sweepFrequencies[endIDX]);
+    range.freqMax = max(sweepFrequencies[startIDX], sweepFrequencies[endIDX]);
+    addRange(range, row, livePoints);
+    fitAxes(range);
+    mapPoints(row, livePoints);
+
+    renderFrame(drawBodeFrame);
+}
+
+void processLiveBodePlot() {
+    // A pending frame lays the plot out again anyway
+    if (getGUIState() != GUI_LIVE_PLOT || isRenderPending()) {
+        return;
+    }
+    uint8_t dut = liveDUT();
+    int count = livePointCount(dut);
+    if (dut != plot.dut || count < livePoints) {
+        drawLiveBodePlot();     // Next DUT or a new sweep
+        return;
+    }
+    if (count == livePoints) {
+        return;
+    }
+
+    // A point off the axes rescales them - everything moves
+    const ImpedanceRow& row = liveRow(dut);
+    for (int i = livePoints; i < count; i++) {
+        if (!pointFits(row, i)) {
+            drawLiveBodePlot();
+            return;
         }
     }
 
-    // Phase ticks (Y-axis right) - degrees
-    tft.setTextColor(COLOR_PHASE);
-    int phase_step = (int)((phase_max - phase_min) / 4);
-    if (phase_step < 10) phase_step = 10;
+    // Otherwise only the new segments are drawn, straight to the panel
+    finishFramePush();
+    tft.startWrite();
+    for (; livePoints < count; livePoints++) {
+        uint8_t magCount = plot.magCount;
+        uint8_t phaseCount = plot.rightCount;
+        mapPoint(row, livePoints);
+        if (magCount > 0 && plot.magCount > magCount) {
+            tft.drawLine(plot.mag[magCount - 1].x, plot.mag[magCount - 1].y,
+                         plot.mag[magCount].x, plot.mag[magCount].y, COLOR_MAG);
+        }
+        if (phaseCount > 0 && plot.rightCount > phaseCount) {
+            drawDashedLine(tft, plot.right[phaseCount - 1].x, plot.right[phaseCount - 1].y,
+                           plot.right[phaseCount].x, plot.right[phaseCount].y, COLOR_PHASE);
+        }
+    }
+    tft.endWrite();
+}
 
-    for (int phase_val = (int)phase_min; phase_val <= (int)phase_max; phase_val += phase_step) {
-        int16_t y = phaseToY(phase_val, phase_min, phase_max);
+/*=========================OVERLAY PLOT=========================*/
 
-        if (y >= PLOT_Y0 - PLOT_HEIGHT && y <= PLOT_Y0) {
-            snprintf(buf, sizeof(buf), "%d", phase_val);
-            tft.setCursor(SCREEN_WIDTH - 25, y - 4);
-            tft.print(buf);
+// |Zf - Zb| / |Zb| in percent from the polar points
+static float deltaPercent(float magBase, float phaseBase, float magFinal, float phaseFinal) {
+    float cosDelta = cosf((phaseFinal - phaseBase) * (float)M_PI / 180.0f);
+    float delta2 = magFinal * magFinal + magBase * magBase - 2.0f * magFinal * magBase * cosDelta;
+    return sqrtf(max(delta2, 0.0f)) / magBase * 100.0f;
+}
+
+// Slot of each axis code in row, 0xFF where the sweep has no valid point
+static void indexByCode(const ImpedanceRow& row, int count, uint8_t* slot) {
+    memset(slot, 0xFF, SWEEP_FREQ_COUNT + MEAS_STORE_OFFGRID_MAX);
+    for (int i = 0; i < count; i++) {
+        uint8_t code = row.freqCode[i];
+        if (isStoredPointValid(row, i) && code < SWEEP_FREQ_COUNT + MEAS_STORE_OFFGRID_MAX) {
+            slot[code] = i;
         }
     }
+}
 
-    // Plot magnitude data (solid line)
-    int16_t prevX_mag = -1, prevY_mag = -1;
-    for (int i = 0; i < numPoints; i++) {
-        ImpedancePoint* point = &baselineImpedanceData[dutIndex][i];
-        if (!point->valid || point->freq_hz <= 0 || point->Z_magnitude <= 0) continue;
+// Visit the baseline/final pairs of dut: fn(baseline slot, final slot)
+template <typename Fn>
+static void forEachPair(uint8_t dut, Fn fn) {
+    uint8_t slot[SWEEP_FREQ_COUNT + MEAS_STORE_OFFGRID_MAX];
+    int count = min(getStoredPointCount(dut), (int)getPointsPerDUT());
+    indexByCode(baselineImpedanceData[dut], min(getRowPointCount(true, dut), (int)getPointsPerDUT()), slot);
+    const ImpedanceRow& measured = measurementImpedanceData[dut];
+    for (int i = 0; i < count; i++) {
+        uint8_t code = measured.freqCode[i];
+        if (isStoredPointValid(measured, i) && code < sizeof(slot) && slot[code] != 0xFF) {
+            fn(slot[code], i);
+        }
+    }
+}
 
-        int16_t x = freqToX(point->freq_hz, freq_min, freq_max);
-        int16_t y = magToY(point->Z_magnitude, mag_min, mag_max);
+// Shared axes: both sweeps of every measured DUT, |dZ|/Z from 0
+static void fitOverlayAxes() {
+    PlotRange range;
+    clearRange(range);
+    float deltaMax = 0;
+    for (uint8_t dut = 0; dut < num_duts && dut < getDUTCount(); dut++) {
+        int count = min(getStoredPointCount(dut), (int)getPointsPerDUT());
+        addRange(range, baselineImpedanceData[dut], count);
+        addRange(range, measurementImpedanceData[dut], count);
+        const ImpedanceRow& base = baselineImpedanceData[dut];
+        const ImpedanceRow& measured = measurementImpedanceData[dut];
+        forEachPair(dut, [&](int b, int f) {
+            if (base.mag[b] > 0) {
+                deltaMax = max(deltaMax, deltaPercent(base.mag[b], base.phase[b], measured.mag[f], measured.phase[f]));
+            }
+        });
+    }
+    if (range.freqMax == 0) {
+        range.freqMin = min(sweepFrequencies[startIDX], sweepFrequencies[endIDX]);
+        range.freqMax = max(sweepFrequencies[startIDX], sweepFrequencies[endIDX]);
+    }
+    fitAxes(range);
 
-        if (prevX_mag >= 0 && prevY_mag >= 0) {
-            tft.drawLine(prevX_mag, prevY_mag, x, y, COLOR_MAG);
+    int steps = sizeof(deltaAxisSteps) / sizeof(deltaAxisSteps[0]);
+    int top = 0;
+    while (top < steps - 1 && deltaAxisSteps[top] < deltaMax) {
+        top++;
+    }
+    plot.rightMin = 0;
+    plot.rightMax = deltaAxisSteps[top];
+    plot.rightStep = max((int)deltaAxisSteps[top] / 5, 1);
+    overlayAxesValid = true;
+}
+
+// Data layer of dut on the cached axes
+static void mapOverlayPoints(uint8_t dut) {
+    plot.magCount = 0;
+    plot.rightCount = 0;
+    plot.baseCount = 0;
+    const ImpedanceRow& base = baselineImpedanceData[dut];
+    const ImpedanceRow& measured = measurementImpedanceData[dut];
+    forEachPair(dut, [&](int b, int f) {
+        uint8_t code = measured.freqCode[f];
+        uint32_t freq = storedFrequency(code);
+        if (freq == 0) return;
+
+        int16_t x = code < SWEEP_FREQ_COUNT ? sweepX[code] : logFreqToX(log10f(freq));
+        if (base.mag[b] > 0) {
+            plot.base[plot.baseCount++] = {x, magToY(base.mag[b])};
+            float delta = min(deltaPercent(base.mag[b], base.phase[b], measured.mag[f], measured.phase[f]), plot.rightMax);
+            plot.right[plot.rightCount++] = {x, rightToY(delta)};
         }
+        if (measured.mag[f] > 0) {
+            plot.mag[plot.magCount++] = {x, magToY(measured.mag[f])};
+        }
+    });
+}
 
-        prevX_mag = x;
-        prevY_mag = y;
+void resetOverlayPlot() {
+    overlayAxesValid = false;
+}
+
+void drawOverlayPlot(uint8_t dutIndex) {
+    if (plot.mode != PLOT_OVERLAY) {
+        overlayAxesValid = false;   // The other plots changed sweepX
+    }
+    plot.mode = PLOT_OVERLAY;
+    plot.dut = dutIndex < getDUTCount() ? dutIndex : 0;
+    if (!overlayAxesValid) {
+        fitOverlayAxes();
     }
+    mapOverlayPoints(plot.dut);
+    renderFrame(drawBodeFrame);
+}
 
-    // Plot phase data (dashed line)
-    int16_t prevX_phase = -1, prevY_phase = -1;
-    for (int i = 0; i < numPoints; i++) {
-        ImpedancePoint* point = &baselineImpedanceData[dutIndex][i];
-        if (!point->valid || point->freq_hz <= 0) continue;
+/*=========================PUBLIC FUNCTIONS=========================*/
 
-        int16_t x = freqToX(point->freq_hz, freq_min, freq_max);
-        int16_t y = phaseToY(point->Z_phase, phase_min, phase_max);
 
-        if (prevX_phase >= 0 && prevY_phase >= 0) {
-            drawDashedLine(prevX_phase, prevY_phase, x, y, COLOR_PHASE);
-        }
+void drawBodePlot(uint8_t dutIndex) {
+    if (dutIndex >= getDUTCount()) {
+        Console.printf("ERROR: Invalid DUT index %d\n", dutIndex);
+        return;
+    }
 
-        prevX_phase = x;
-        prevY_phase = y;
+    int numPoints = getStoredPointCount(dutIndex);
+    if (numPoints == 0) {
+        Console.printf("WARNING: No data for DUT %d\n", dutIndex + 1);
+        return;
     }
 
-    Serial.printf("Bode plot drawn for DUT %d\n", dutIndex + 1);
+    Console.printf("Drawing Bode plot for DUT %d (%d points)\n", dutIndex + 1, numPoints);
+
+    // Find data ranges
+    const ImpedanceRow& row = baselineImpedanceData[dutIndex];
+    PlotRange range;
+    clearRange(range);
+    addRange(range, row, numPoints);
+    if (range.freqMax == 0 || range.magMax == 0) {
+        Console.printf("WARNING: No valid points for DUT %d\n", dutIndex + 1);
+        return;
+    }
+
+    plot.dut = dutIndex;
+    plot.mode = PLOT_BODE;
+    fitAxes(range);
+    mapPoints(row, numPoints);
+
+    // One flicker-free push through the band sprite
+    renderFrame(drawBodeFrame);
+
+    Console.printf("Bode plot drawn for DUT %d\n", dutIndex + 1);
 }
@@ -0,0 +1,54 @@
+#include "boot_timing.h"
+#include "console.h"
+
+struct BootStage {
+    const char* name;
+    int64_t beginUs;
+    int64_t endUs;          // 0 while running
+};
+
+static BootStage stages[BOOT_MAX_STAGES];
+static uint8_t stageCount = 0;
+static int64_t readyUs = 0;
+static portMUX_TYPE bootMux = portMUX_INITIALIZER_UNLOCKED;
+
+uint8_t bootStageBegin(const char* name) {
+    int64_t now = esp_timer_get_time();
+    uint8_t stage = BOOT_NO_STAGE;
+    portENTER_CRITICAL(&bootMux);
+    if (stageCount < BOOT_MAX_STAGES) {
+        stage = stageCount++;
+        stages[stage].name = name;
+        stages[stage].beginUs = now;
+        stages[stage].endUs = 0;
+    }
+    portEXIT_CRITICAL(&bootMux);
+    return stage;
+}
+
+void bootStageEnd(uint8_t stage) {
+    if (stage < BOOT_MAX_STAGES) {
+        stages[stage].endUs = esp_timer_get_time();
+    }
+}
+
+void bootReady() {
+    readyUs = esp_timer_get_time();
+}
+
+void printBootTimes() {
+    Console.println("\n=== Boot Timeline (ms since app start) ===");
+    for (uint8_t i = 0; i < stageCount; i++) {
+        const BootStage& stage = stages[i];
+        if (stage.endUs == 0) {
+            Console.printf("  %-18s %8.1f -   running\n", stage.name, stage.beginUs / 1000.0f);
+        } else {
+            Console.printf("  %-18s %8.1f - %8.1f  (%7.1f ms)\n", stage.name, stage.beginUs / 1000.0f,
+                          stage.endUs / 1000.0f, (stage.endUs - stage.beginUs) / 1000.0f);
+        }
+    }
+    if (readyUs > 0) {
+        Console.printf("  Time to ready:     %8.1f ms\n", readyUs / 1000.0f);
+    }
+    Console.println("==========================================\n");
+}
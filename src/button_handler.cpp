@@ -1,119 +1,228 @@
 #include "button_handler.h"
+#include "console.h"
+#include "power_manager.h"
+#include "driver/pulse_cnt.h"
+#include "esp_timer.h"
+#if POWER_SAVE
+#include "driver/gpio.h"
+#endif
 
 /*=========================BUTTON STATE TRACKING=========================*/
-
-// Last interrupt time for debouncing
-static volatile unsigned long lastInterruptTime[5] = {0};
-
-// Encoder state tracking
-static volatile int8_t encoderPos = 0;
-static volatile uint8_t encoderState = 0;
-static volatile int8_t lastEncoderPos = 0;
+#define BUTTON_COUNT 5
+
+struct ButtonChannel {
+    uint8_t pin;
+    ButtonEvent event;
+    bool repeats;           // Auto-repeat while held
+};
+
+static const ButtonChannel buttons[BUTTON_COUNT] = {
+    {BTN_UP, BTN_EVENT_UP, true},
+    {BTN_DOWN, BTN_EVENT_DOWN, true},
+    {BTN_LEFT, BTN_EVENT_LEFT, false},     // LEFT / RIGHT navigate between screens
+    {BTN_RIGHT, BTN_EVENT_RIGHT, false},
+    {BTN_SELECT, BTN_EVENT_SELECT, false},
+};
+
+// Debounced state per button - written by the esp_timer task only
+struct ButtonState {
+    esp_timer_handle_t debounceTimer;   // Settle time after an edge
+    esp_timer_handle_t holdTimer;       // Long press, then auto-repeat
+    bool pressed;
+    bool longSent;
+    volatile uint32_t edgeUs;           // First edge since the timer was armed (buttonEdgeISR)
+};
+
+static ButtonState buttonStates[BUTTON_COUNT];
+static bool buttonTimersReady = false;
+
+// Encoder quadrature counter
+static pcnt_unit_handle_t encoderUnit = nullptr;
 
 // Button event queue (defined in gui_state.cpp)
 extern QueueHandle_t buttonEventQueue;
 
-/*=========================INTERRUPT SERVICE ROUTINES=========================*/
+// edgeUs: when the input happened (input_latency.h)
+static void postButtonEvent(uint8_t event, uint32_t edgeUs) {
+    ButtonInput input = {(ButtonEvent)event, edgeUs, (uint32_t)esp_timer_get_time()};
+    if (xQueueSend(buttonEventQueue, &input, 0) == pdTRUE) {
+        wakeGUITask(GUI_WAKE_BUTTON);
+    }
+}
 
-// Generic button ISR with debouncing
-void IRAM_ATTR buttonISR(uint8_t buttonIndex, ButtonEvent event) {
-    unsigned long now = millis();
+/*=========================DEBOUNCE STATE MACHINE=========================*/
+// An edge interrupt arms the debounce timer unless it is running, and the
+// level is read BUTTON_DEBOUNCE_MS later - edges after that arm it again, so
+// the last reading is the settled level. A press emits the button's
+// event, a hold BTN_EVENT_LONG after BUTTON_LONG_PRESS_MS and then, for
+// UP and DOWN, a repeat every BUTTON_REPEAT_MS; letting go emits
+// BTN_EVENT_RELEASE
+static void debounceExpired(void* arg) {
+    uint8_t index = (uint8_t)(uintptr_t)arg;
+    ButtonState& state = buttonStates[index];
+    bool pressed = digitalRead(buttons[index].pin) == LOW;
+    if (pressed == state.pressed) {
+        return;     // Bounced back
+    }
+    state.pressed = pressed;
+    if (pressed) {
+        state.longSent = false;
+        postButtonEvent(buttons[index].event, state.edgeUs);
+        esp_timer_start_once(state.holdTimer, BUTTON_LONG_PRESS_MS * 1000ULL);
+    } else {
+        esp_timer_stop(state.holdTimer);
+        postButtonEvent(buttons[index].event | BTN_EVENT_RELEASE, state.edgeUs);
+    }
+}
 
-    // Debounce check
-    if (now - lastInterruptTime[buttonIndex] < BUTTON_DEBOUNCE_MS) {
+static void holdExpired(void* arg) {
+    uint8_t index = (uint8_t)(uintptr_t)arg;
+    ButtonState& state = buttonStates[index];
+    if (!state.pressed) {
         return;
     }
-    lastInterruptTime[buttonIndex] = now;
-
-    // Send event to queue (ISR-safe)
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    xQueueSendFromISR(buttonEventQueue, &event, &xHigherPriorityTaskWoken);
-
-    if (xHigherPriorityTaskWoken) {
-        portYIELD_FROM_ISR();
+    // The timer firing is the input
+    uint32_t now = esp_timer_get_time();
+    if (!state.longSent) {
+        state.longSent = true;
+        postButtonEvent(buttons[index].event | BTN_EVENT_LONG, now);
+    }
+    if (buttons[index].repeats) {
+        postButtonEvent(buttons[index].event | BTN_EVENT_REPEAT, now);
+        esp_timer_start_once(state.holdTimer, BUTTON_REPEAT_MS * 1000ULL);
     }
 }
 
-// Individual button ISRs
-void IRAM_ATTR btnUpISR() {
-    buttonISR(0, BTN_EVENT_UP);
+static bool initButtonTimers() {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        esp_timer_create_args_t args = {};
+        args.arg = (void*)(uintptr_t)i;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.callback = debounceExpired;
+        args.name = "btn_debounce";
+        if (esp_timer_create(&args, &buttonStates[i].debounceTimer) != ESP_OK) {
+            return false;
+        }
+        args.callback = holdExpired;
+        args.name = "btn_hold";
+        if (esp_timer_create(&args, &buttonStates[i].holdTimer) != ESP_OK) {
+            return false;
+        }
+        buttonStates[i].pressed = digitalRead(buttons[i].pin) == LOW;
+    }
+    buttonTimersReady = true;
+    return true;
 }
 
-void IRAM_ATTR btnDownISR() {
-    buttonISR(1, BTN_EVENT_DOWN);
+/*=========================INTERRUPT SERVICE ROUTINES=========================*/
+// Every edge, bounces included - only starts the settle timer
+static void IRAM_ATTR buttonEdgeISR(void* arg) {
+    uint8_t index = (uint8_t)(uintptr_t)arg;
+#if POWER_SAVE
+    // Light sleep only wakes on GPIO levels, so the buttons interrupt on the
+    // level opposite to the current one - once per edge, and the pin wakes
+    // the CPU pressed or released
+    uint8_t pin = buttons[index].pin;
+    gpio_set_intr_type((gpio_num_t)pin, digitalRead(pin) == LOW ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+#endif
+    esp_timer_handle_t timer = buttonStates[index].debounceTimer;
+    if (!esp_timer_is_active(timer)) {
+        buttonStates[index].edgeUs = esp_timer_get_time();
+        esp_timer_start_once(timer, BUTTON_DEBOUNCE_MS * 1000ULL);
+    }
 }
 
-void IRAM_ATTR btnLeftISR() {
-    buttonISR(2, BTN_EVENT_LEFT);
+#if POWER_SAVE
+#define BUTTON_MODE     ONLOW
+#else
+#define BUTTON_MODE     CHANGE
+#endif
+
+static void attachButtonInterrupts() {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        attachInterruptArg(digitalPinToInterrupt(buttons[i].pin), buttonEdgeISR, (void*)(uintptr_t)i, BUTTON_MODE);
+    }
 }
 
-void IRAM_ATTR btnRightISR() {
-    buttonISR(3, BTN_EVENT_RIGHT);
+// Encoder count reached +/- one detent - the unit clears itself at the limit,
+// so this runs once per detent instead of once per edge
+static bool IRAM_ATTR encoderDetentISR(pcnt_unit_handle_t unit, const pcnt_watch_event_data_t* edata, void* ctx) {
+    ButtonEvent event = (edata->watch_point_value > 0) ? BTN_EVENT_ROTATE_CW : BTN_EVENT_ROTATE_CCW;
+    uint32_t now = esp_timer_get_time();
+    ButtonInput input = {event, now, now};
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    if (xQueueSendFromISR(buttonEventQueue, &input, &xHigherPriorityTaskWoken) == pdTRUE) {
+        wakeGUITaskFromISR(GUI_WAKE_BUTTON, &xHigherPriorityTaskWoken);
+    }
+    return xHigherPriorityTaskWoken == pdTRUE;
 }
 
-void IRAM_ATTR btnSelectISR() {
-    buttonISR(4, BTN_EVENT_SELECT);
+/*=========================ENCODER COUNTER=========================*/
+// Full quadrature (x4) on one PCNT unit: each channel counts the edges of one
+// line, with the other line's level giving the direction. Clockwise is
+// A/B = 00 -> 01 -> 11 -> 10
+static bool initEncoderCounter() {
+    pcnt_unit_config_t unitConfig = {};
+    unitConfig.low_limit = -ENCODER_PULSES_PER_DETENT;
+    unitConfig.high_limit = ENCODER_PULSES_PER_DETENT;
+    if (pcnt_new_unit(&unitConfig, &encoderUnit) != ESP_OK) {
+        return false;
+    }
+
+#if !POWER_SAVE
+    // The filter holds the APB clock at maximum, which would keep the CPU
+    // out of light sleep
+    pcnt_glitch_filter_config_t filterConfig = {};
+    filterConfig.max_glitch_ns = ENCODER_GLITCH_NS;
+    pcnt_unit_set_glitch_filter(encoderUnit, &filterConfig);
+#endif
+
+    pcnt_chan_config_t chanAConfig = {};
+    chanAConfig.edge_gpio_num = ENCODER_A;
+    chanAConfig.level_gpio_num = ENCODER_B;
+    pcnt_chan_config_t chanBConfig = {};
+    chanBConfig.edge_gpio_num = ENCODER_B;
+    chanBConfig.level_gpio_num = ENCODER_A;
+    pcnt_channel_handle_t chanA = nullptr;
+    pcnt_channel_handle_t chanB = nullptr;
+    if (pcnt_new_channel(encoderUnit, &chanAConfig, &chanA) != ESP_OK ||
+        pcnt_new_channel(encoderUnit, &chanBConfig, &chanB) != ESP_OK) {
+        return false;
+    }
+
+    // A edges count up while B is high, B edges count up while A is low;
+    // the falling edges and the opposite levels count down
+    pcnt_channel_set_edge_action(chanA, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_DECREASE);
+    pcnt_channel_set_level_action(chanA, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE);
+    pcnt_channel_set_edge_action(chanB, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_DECREASE);
+    pcnt_channel_set_level_action(chanB, PCNT_CHANNEL_LEVEL_ACTION_INVERSE, PCNT_CHANNEL_LEVEL_ACTION_KEEP);
+
+    pcnt_unit_add_watch_point(encoderUnit, ENCODER_PULSES_PER_DETENT);
+    pcnt_unit_add_watch_point(encoderUnit, -ENCODER_PULSES_PER_DETENT);
+    pcnt_event_callbacks_t callbacks = {};
+    callbacks.on_reach = encoderDetentISR;
+    if (pcnt_unit_register_event_callbacks(encoderUnit, &callbacks, nullptr) != ESP_OK ||
+        pcnt_unit_enable(encoderUnit) != ESP_OK) {
+        return false;
+    }
+    pcnt_unit_clear_count(encoderUnit);
+    return pcnt_unit_start(encoderUnit) == ESP_OK;
 }
 
-// Rotary encoder ISR (quadrature decoding)
-// Based on Gray code state machine
-void IRAM_ATTR encoderISR() {
-    // Read current encoder pins
-    uint8_t A = digitalRead(ENCODER_A);
-    uint8_t B = digitalRead(ENCODER_B);
-
-    // Combine into 2-bit value
-    uint8_t currentState = (A << 1) | B;
-
-    // Create 4-bit value: old_state | new_state
-    uint8_t combinedState = (encoderState << 2) | currentState;
-
-    // Update encoder state
-    encoderState = currentState;
-
-    // Quadrature decoding using lookup table
-    // CW: 0b0001, 0b0111, 0b1110, 0b1000
-    // CCW: 0b0010, 0b1011, 0b1101, 0b0100
-    switch (combinedState) {
-        case 0b0001: // CW step 1
-        case 0b0111: // CW step 2
-        case 0b1110: // CW step 3
-        case 0b1000: // CW step 4
-            encoderPos = encoderPos + 1;
-            break;
-
-        case 0b0010: // CCW step 1
-        case 0b1011: // CCW step 2
-        case 0b1101: // CCW step 3
-        case 0b0100: // CCW step 4
-            encoderPos = encoderPos - 1;
-            break;
-
-        default:
-            // Invalid state or no movement
-            break;
-    }
-
-    // Check if we've moved enough to trigger an event
-    int8_t delta = encoderPos - lastEncoderPos;
-    if (abs(delta) >= ENCODER_PULSES_PER_DETENT) {
-        ButtonEvent event = (delta > 0) ? BTN_EVENT_ROTATE_CW : BTN_EVENT_ROTATE_CCW;
-        lastEncoderPos = encoderPos;
-
-        // Send event to queue (ISR-safe)
-        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        xQueueSendFromISR(buttonEventQueue, &event, &xHigherPriorityTaskWoken);
-
-        if (xHigherPriorityTaskWoken) {
-            portYIELD_FROM_ISR();
-        }
+#if POWER_SAVE
+// Buttons wake from light sleep, the encoder does not (it may rest low)
+static void enableButtonWakeup() {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        gpio_wakeup_enable((gpio_num_t)buttons[i].pin, GPIO_INTR_LOW_LEVEL);
     }
 }
+#endif
 
 /*=========================PUBLIC FUNCTIONS=========================*/
 
 void initButtons() {
-    Serial.println("[BTN] Initializing button interrupts...");
+    Console.println("[BTN] Initializing button interrupts...");
 
     // Configure button pins as inputs with pull-ups
     pinMode(BTN_UP, INPUT_PULLUP);
@@ -126,43 +235,52 @@ void initButtons() {
     pinMode(ENCODER_A, INPUT_PULLUP);
     pinMode(ENCODER_B, INPUT_PULLUP);
 
-    // Read initial encoder state
-    uint8_t A = digitalRead(ENCODER_A);
-    uint8_t B = digitalRead(ENCODER_B);
-    encoderState = (A << 1) | B;
-
-    // Attach interrupts (active LOW - triggers on press)
-    attachInterrupt(digitalPinToInterrupt(BTN_UP), btnUpISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BTN_DOWN), btnDownISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BTN_LEFT), btnLeftISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BTN_RIGHT), btnRightISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BTN_SELECT), btnSelectISR, FALLING);
+    // Edge interrupts feed the debounce timers (active LOW)
+    if (initButtonTimers()) {
+        attachButtonInterrupts();
+    } else {
+        Console.println("[BTN] ERROR: Failed to create debounce timers");
+    }
 
-    // Attach encoder interrupts (trigger on any change)
-    attachInterrupt(digitalPinToInterrupt(ENCODER_A), encoderISR, CHANGE);
-    attachInterrupt(digitalPinToInterrupt(ENCODER_B), encoderISR, CHANGE);
+    // Encoder is decoded by the pulse counter
+    if (!initEncoderCounter()) {
+        Console.println("[BTN] ERROR: Failed to set up encoder pulse counter");
+    }
+#if POWER_SAVE
+    enableButtonWakeup();
+#endif
 
-    Serial.println("[BTN] Button interrupts initialized");
+    Console.println("[BTN] Button interrupts initialized");
 }
 
 void disableButtons() {
-    detachInterrupt(digitalPinToInterrupt(BTN_UP));
-    detachInterrupt(digitalPinToInterrupt(BTN_DOWN));
-    detachInterrupt(digitalPinToInterrupt(BTN_LEFT));
-    detachInterrupt(digitalPinToInterrupt(BTN_RIGHT));
-    detachInterrupt(digitalPinToInterrupt(BTN_SELECT));
-    detachInterrupt(digitalPinToInterrupt(ENCODER_A));
-    detachInterrupt(digitalPinToInterrupt(ENCODER_B));
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        detachInterrupt(digitalPinToInterrupt(buttons[i].pin));
+        if (buttonTimersReady) {
+            esp_timer_stop(buttonStates[i].debounceTimer);
+            esp_timer_stop(buttonStates[i].holdTimer);
+        }
+    }
+    if (encoderUnit != nullptr) {
+        pcnt_unit_stop(encoderUnit);
+    }
 }
 
 void enableButtons() {
-    attachInterrupt(digitalPinToInterrupt(BTN_UP), btnUpISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BTN_DOWN), btnDownISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BTN_LEFT), btnLeftISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BTN_RIGHT), btnRightISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BTN_SELECT), btnSelectISR, FALLING);
-    attachInterrupt(digitalPinToInterrupt(ENCODER_A), encoderISR, CHANGE);
-    attachInterrupt(digitalPinToInterrupt(ENCODER_B), encoderISR, CHANGE);
+    if (buttonTimersReady) {
+        // A button held while disabled counts from the next press
+        for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+            buttonStates[i].pressed = digitalRead(buttons[i].pin) == LOW;
+        }
+        attachButtonInterrupts();
+    }
+    if (encoderUnit != nullptr) {
+        pcnt_unit_clear_count(encoderUnit);
+        pcnt_unit_start(encoderUnit);
+    }
+#if POWER_SAVE
+    enableButtonWakeup();
+#endif
 }
 
 bool isButtonPressed(uint8_t buttonPin) {
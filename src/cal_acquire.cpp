@@ -0,0 +1,333 @@
+#include "cal_acquire.h"
+#include "console.h"
+#include "cal_image.h"
+#include "cal_model.h"
+#include "cal_upload.h"
+#include "calibration.h"
+#include "crc.h"
+#include "meas_control.h"
+#include "monitor.h"
+#include "raw_capture.h"
+#include "sweep_table.h"
+#include "UART_Functions.h"
+#include "esp_partition.h"
+#include <atomic>
+#include <math.h>
+
+enum CalAcquireState : uint8_t {
+    ACQUIRE_IDLE,
+    ACQUIRE_NEXT_STEP,      // Settings and START of the next combination to queue
+    ACQUIRE_SWEEPING,
+    ACQUIRE_RELEASING       // All sweeps done, waiting for releaseCalibrationImage()
+};
+
+// Raw impedance summed as a complex number, so phases around +-180 average correctly
+struct RawSum {
+    float re;
+    float im;
+    uint16_t count;
+};
+
+// GUI task only
+static CalAcquireState state = ACQUIRE_IDLE;
+static uint8_t step = 0;                // TIA flag = step / 8, PGA = step % 8
+static float referenceOhms = 0.0f;
+static unsigned long releaseStart = 0;
+
+// Allocated by the first acquisition and kept - a stopped sweep's last batch
+// may still be filed after the GUI task gave up. Written by the data processor
+// while recording, read by the GUI task once the sweeps are done
+static RawSum (*sums)[2][8] = nullptr;
+static std::atomic<bool> recording{false};
+
+/*=========================DATA PROCESSOR SIDE=========================*/
+void recordCalAcquirePoint(const MeasurementPoint& point) {
+    if (!recording.load(std::memory_order_acquire) || !point.valid ||
+        point.I_magnitude <= 0.0f || point.pga_gain > 7) {
+        return;
+    }
+    uint8_t idx = getSweepFrequencyIndex(point.freq_hz, point.freq_idx);
+    if (idx == SWEEP_FREQ_INVALID) {
+        return;
+    }
+
+    RawSum& sum = sums[idx][point.tia_gain][point.pga_gain];
+    float mag = point.V_magnitude / point.I_magnitude;
+    float phaseRad = point.phase_deg * (float)(M_PI / 180.0);
+    sum.re += mag * cosf(phaseRad);
+    sum.im += mag * sinf(phaseRad);
+    sum.count++;
+}
+
+/*=========================HELPERS=========================*/
+static void finish() {
+    recording.store(false, std::memory_order_release);
+    state = ACQUIRE_IDLE;
+}
+
+bool isCalAcquireActive() {
+    return state != ACQUIRE_IDLE;
+}
+
+void abortCalAcquire(const char* reason) {
+    if (state == ACQUIRE_IDLE) {
+        return;
+    }
+    Console.printf("[CAL] Acquisition failed: %s\n", reason);
+    Console.printf("@EVT cal_end 0 %s\n", reason);
+    finish();
+}
+
+// Fused entry of one (frequency, TIA, PGA) slot
+static CalLUTEntry entryFor(const RawSum& sum) {
+    CalLUTEntry entry = {1.0f, 0.0f, false, {0, 0, 0}};
+    if (sum.count < CAL_ACQUIRE_MIN_POINTS) {
+        return entry;
+    }
+    float re = sum.re / sum.count;
+    float im = sum.im / sum.count;
+    float mag = sqrtf(re * re + im * im);
+    if (mag <= 0.0f) {
+        return entry;
+    }
+    entry.gain = referenceOhms / mag;
+    entry.phase_offset = -atan2f(im, re) * (float)(180.0 / M_PI);
+    entry.valid = true;
+    return entry;
+}
+
+#if CAL_MODEL_PRIOR
+static float wrapDegrees(float deg) {
+    while (deg > 180.0f) deg -= 360.0f;
+    while (deg <= -180.0f) deg += 360.0f;
+    return deg;
+}
+
+// Slot the acquisition did not reach: the model, moved onto the nearest
+// frequency the same combination was measured at (the plain model if none)
+static CalLUTEntry modelEntry(int f, int tia, int pga) {
+    CalLUTEntry entry = calModel.fused[f][tia][pga];
+    for (int d = 1; d < SWEEP_FREQ_COUNT; d++) {
+        for (int n : {f - d, f + d}) {
+            if (n < 0 || n >= SWEEP_FREQ_COUNT) {
+                continue;
+            }
+            CalLUTEntry measured = entryFor(sums[n][tia][pga]);
+            if (!measured.valid) {
+                continue;
+            }
+            const CalLUTEntry& model = calModel.fused[n][tia][pga];
+            entry.gain *= measured.gain / model.gain;
+            entry.phase_offset = wrapDegrees(entry.phase_offset + measured.phase_offset - model.phase_offset);
+            return entry;
+        }
+    }
+    return entry;
+}
+
+// A measured entry this far from the model points at the wrong R_ref or a loose lead
+static bool farFromModel(const CalLUTEntry& entry, int f, int tia, int pga) {
+    float ratio = entry.gain / calModel.fused[f][tia][pga].gain;
+    return ratio > CAL_MODEL_MAX_RATIO || ratio < 1.0f / CAL_MODEL_MAX_RATIO;
+}
+#endif
+
+/*=========================IMAGE WRITE=========================*/
+// Payload (frequencies, then entries one frequency at a time) first, the
+// header last - an interrupted write leaves no valid magic behind
+static bool writeImage(const esp_partition_t* partition, int& validCount, int& modelCount) {
+    const size_t entryBytes = SWEEP_FREQ_COUNT * 2 * 8 * sizeof(CalLUTEntry);
+    const size_t payloadSize = sizeof(sweepFrequencies) + entryBytes;
+    const size_t imageSize = sizeof(CalImageHeader) + payloadSize;
+    if (imageSize > partition->size) {
+        return false;
+    }
+
+    size_t eraseSize = (imageSize + partition->erase_size - 1) / partition->erase_size * partition->erase_size;
+    if (esp_partition_erase_range(partition, 0, eraseSize) != ESP_OK) {
+        return false;
+    }
+
+    size_t offset = sizeof(CalImageHeader);
+    if (esp_partition_write(partition, offset, sweepFrequencies, sizeof(sweepFrequencies)) != ESP_OK) {
+        return false;
+    }
+    uint16_t payloadCRC = crc16_ccitt((const uint8_t*)sweepFrequencies, sizeof(sweepFrequencies));
+    offset += sizeof(sweepFrequencies);
+
+    validCount = 0;
+    modelCount = 0;
+    int farCount = 0;
+    CalLUTEntry row[2][8];
+    for (int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        for (int tia = 0; tia < 2; tia++) {
+            for (int pga = 0; pga < 8; pga++) {
+                row[tia][pga] = entryFor(sums[f][tia][pga]);
+                validCount += row[tia][pga].valid ? 1 : 0;
+#if CAL_MODEL_PRIOR
+                if (!row[tia][pga].valid) {
+                    row[tia][pga] = modelEntry(f, tia, pga);
+                    modelCount++;
+                } else if (farFromModel(row[tia][pga], f, tia, pga)) {
+                    farCount++;
+                }
+#endif
+            }
+        }
+        if (esp_partition_write(partition, offset, row, sizeof(row)) != ESP_OK) {
+            return false;
+        }
+        payloadCRC = crc16_ccitt((const uint8_t*)row, sizeof(row), payloadCRC);
+        offset += sizeof(row);
+    }
+
+    CalImageHeader header = {};
+    header.magic = CAL_IMAGE_MAGIC;
+    header.version = CAL_IMAGE_VERSION;
+    header.headerSize = sizeof(CalImageHeader);
+    header.freqCount = SWEEP_FREQ_COUNT;
+    header.tiaCount = 2;
+    header.pgaCount = 8;
+    header.entrySize = sizeof(CalLUTEntry);
+    header.payloadSize = payloadSize;
+    header.payloadCRC = payloadCRC;
+    header.headerCRC = crc16_ccitt((const uint8_t*)&header, offsetof(CalImageHeader, headerCRC));
+    if (farCount > 0) {
+        Console.printf("[CAL] WARNING: %d entries more than %.0fx off the front-end model - check R_ref\n",
+                       farCount, CAL_MODEL_MAX_RATIO);
+    }
+    return esp_partition_write(partition, 0, &header, sizeof(header)) == ESP_OK;
+}
+
+static void writeCalibration() {
+    const esp_partition_t* partition = findCalibrationPartition();
+    int validCount = 0;
+    int modelCount = 0;
+    if (partition == nullptr || !writeImage(partition, validCount, modelCount)) {
+        abortCalAcquire("flash_write");
+        return;
+    }
+    // Validates the written image and stages it for the data processor
+    if (mapCalibrationImage() == nullptr || !reloadCalibration()) {
+        abortCalAcquire("image_invalid");
+        return;
+    }
+
+    Console.printf("[CAL] Acquisition complete: %d of %d entries valid, %d from the front-end model (R_ref %.1f Ohm)\n",
+                  validCount, SWEEP_FREQ_COUNT * 2 * 8, modelCount, referenceOhms);
+    Console.printf("@EVT cal_end %d ok\n", validCount);
+    finish();
+}
+
+/*=========================SEQUENCING=========================*/
+static void onStepStartAnswered(uint8_t cmd_type, bool success, void* context) {
+    if (!success) {
+        abortCalAcquire("start_failed");
+    }
+}
+
+// TIA and PGA of this step, then a channel 1 sweep over the full table
+// Settings are pipelined - START waits for them to drain (UART_Functions.h)
+static void startStep() {
+    bool tiaHigh = step / 8;
+    uint8_t pga = step % 8;
+    Console.printf("@EVT cal_step %u %u %s %u\n", step + 1, CAL_ACQUIRE_STEPS, tiaHigh ? "high" : "low", pga);
+
+    // CMD_SET_TIA_GAIN: 0 = high gain, 1 = low gain
+    if (!queueUARTCommand(CMD_SET_TIA_GAIN, tiaHigh ? 0 : 1, 0, 0) ||
+        !queueUARTCommand(CMD_SET_PGA_GAIN, pga, 0, 0)) {
+        abortCalAcquire("queue");
+        return;
+    }
+    SweepPlan plan = {1, 0, SWEEP_FREQ_COUNT - 1, 0};
+    MeasRequestError error = requestBaselineSweep(MEAS_SOURCE_CAL, plan, onStepStartAnswered);
+    if (error != MEAS_REQUEST_OK) {
+        Console.printf("[CAL] START refused: %s\n", measRequestErrorText(error));
+        abortCalAcquire("start_refused");
+        return;
+    }
+    state = ACQUIRE_SWEEPING;
+}
+
+bool startCalAcquire(float refOhms) {
+    if (state != ACQUIRE_IDLE) {
+        Console.println("[CAL] Acquisition already running");
+        return false;
+    }
+    if (!(refOhms > 0.0f)) {
+        Console.println("[CAL] Reference resistance must be > 0");
+        return false;
+    }
+    if (getMeasurementState() != MEAS_IDLE || isMonitorActive() || isCalUploadInProgress()) {
+        Console.println("[CAL] Measurement or calibration upload in progress");
+        return false;
+    }
+    if (isRawCaptureActive()) {
+        Console.println("[CAL] Raw capture is on - no points reach calibration");
+        return false;
+    }
+    if (findCalibrationPartition() == nullptr) {
+        Console.println("[CAL] No '" CAL_IMAGE_PARTITION_LABEL "' partition");
+        return false;
+    }
+
+    if (sums == nullptr) {
+        sums = (RawSum(*)[2][8])malloc(SWEEP_FREQ_COUNT * sizeof(*sums));
+        if (sums == nullptr) {
+            Console.println("[CAL] Out of memory");
+            return false;
+        }
+    }
+    memset(sums, 0, SWEEP_FREQ_COUNT * sizeof(*sums));
+
+    referenceOhms = refOhms;
+    step = 0;
+    state = ACQUIRE_NEXT_STEP;
+    recording.store(true, std::memory_order_release);
+    Console.printf("[CAL] Acquisition started: %d sweeps against %.1f Ohm on channel 1\n",
+                  CAL_ACQUIRE_STEPS, refOhms);
+    Console.printf("@EVT cal_start %u %.1f\n", CAL_ACQUIRE_STEPS, refOhms);
+    return true;
+}
+
+void calAcquireSweepComplete() {
+    if (state != ACQUIRE_SWEEPING || getMeasurementSource() != MEAS_SOURCE_CAL) {
+        return;
+    }
+    step++;
+    if (step < CAL_ACQUIRE_STEPS) {
+        state = ACQUIRE_NEXT_STEP;
+        return;
+    }
+    // The data processor stored every point before the last DUT completed
+    recording.store(false, std::memory_order_release);
+    releaseStart = millis();
+    state = ACQUIRE_RELEASING;
+}
+
+void processCalAcquire() {
+    switch (state) {
+        case ACQUIRE_NEXT_STEP:
+            startStep();
+            break;
+
+        case ACQUIRE_SWEEPING:
+            // Stopped from the GUI, serial or BLE
+            if (getMeasurementState() == MEAS_IDLE || getMeasurementSource() != MEAS_SOURCE_CAL) {
+                abortCalAcquire("stopped");
+            }
+            break;
+
+        case ACQUIRE_RELEASING:
+            // Calibration must stop reading the partition before it is erased
+            if (releaseCalibrationImage()) {
+                writeCalibration();
+            } else if (millis() - releaseStart > CAL_UPLOAD_RELEASE_MS) {
+                abortCalAcquire("calibration_busy");
+            }
+            break;
+
+        default:
+            break;
+    }
+}
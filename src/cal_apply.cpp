@@ -0,0 +1,268 @@
+#include "cal_apply.h"
+#include "cal_model.h"
+#include "log.h"
+#include <math.h>
+
+/*=========================APPLY TABLES=========================*/
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+FreqCalibrationData calibrationData[MAX_CAL_FREQUENCIES];
+int numCalibrationFreqs = 0;
+#endif
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
+// Calibration coefficients: [TIA_mode][PGA_gain]
+CalibrationCoefficients calibrationCoefficients[2][8];
+#endif
+
+// Indexed tables - RAM tables are heap allocated, so only the active one (plus
+// the staged one during a reload) is resident. Everything reads as invalid
+// from the empty table in flash until the first table is applied
+const CalLUTEntry emptyCalibrationLUT[SWEEP_FREQ_COUNT][2][8] = {};
+const CalLUTEntry (*calibrationLUT)[2][8] = emptyCalibrationLUT;
+
+// Interpolation slopes between neighbouring sweep frequencies (per ln Hz)
+// Segment i spans sweep index i -> i + 1, rebuilt whenever calibrationLUT changes
+struct CalSegment {
+    float gain_slope;
+    float phase_slope;
+};
+static CalSegment calibrationSegments[SWEEP_FREQ_COUNT - 1][2][8];
+
+#if IMPEDANCE_RECTANGULAR
+// calibrationLUT entries as gain*e^(j*phase_offset), rebuilt with the slopes
+struct CalComplex {
+    float re;
+    float im;
+};
+static CalComplex calibrationComplex[SWEEP_FREQ_COUNT][2][8];
+#endif
+
+/*=========================HELPER FUNCTIONS=========================*/
+
+// Apply a polar correction factor gain*e^(j*phase_deg) to an impedance point
+void applyCalibrationFactor(ImpedancePoint& point, float gain, float phase_deg) {
+#if IMPEDANCE_RECTANGULAR
+    float phaseRad = phase_deg * (float)(M_PI / 180.0);
+    float cre = gain * cosf(phaseRad);
+    float cim = gain * sinf(phaseRad);
+    float re = point.Z_re * cre - point.Z_im * cim;
+    point.Z_im = point.Z_re * cim + point.Z_im * cre;
+    point.Z_re = re;
+#else
+    point.Z_magnitude *= gain;
+    point.Z_phase += phase_deg;
+#endif
+}
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+// Find the index of a frequency in the calibration data
+int findFrequencyIndex(uint32_t freq) {
+    for(int i = 0; i < numCalibrationFreqs; i++) {
+        if(calibrationData[i].frequency_hz == freq) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Get calibration point for specific frequency and gain settings
+CalibrationPoint* getCalibrationPoint(uint32_t freq, bool lowTIA, uint8_t pgaGain) {
+    if(pgaGain > 7) return nullptr;
+
+    // The analytic front-end model is compiled into cal_model.h
+    int idx = findFrequencyIndex(freq);
+    if(idx < 0) return nullptr;
+
+    if(lowTIA) {
+        return &calibrationData[idx].low_TIA_gains[pgaGain];
+    } else {
+        return &calibrationData[idx].high_TIA_gains[pgaGain];
+    }
+}
+// Lookup table: Z_gain and -phase from calibrationData
+bool calibrateWithLookup(ImpedancePoint& point) {
+    CalibrationPoint* calPoint = getCalibrationPoint(point.freq_hz, point.tia_gain, point.pga_gain);
+    LOG_D("Lookup cal: Freq=%lu, TIA=%d, PGA=%d -> Z_gain=%.3f, Phase=%.2f\n",
+          point.freq_hz, point.tia_gain, point.pga_gain,
+          calPoint ? calPoint->impedance_gain : 0.0f,
+          calPoint ? calPoint->phase_offset : 0.0f);
+    if(!calPoint) {
+        return false;
+    }
+    applyCalibrationFactor(point, calPoint->impedance_gain, -calPoint->phase_offset);
+    return true;
+}
+#endif
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
+// Apply calibration using quadratic formula
+// Formula: |Z_x| = |Z_nc| / (m0 + m1*f + m2*f²)
+//          arg(Z_x) = arg(Z_nc) - (a1*f + a2*f²)
+bool calibrateWithFormula(ImpedancePoint& point) {
+    // Validate PGA gain
+    if(point.pga_gain > 7) {
+        LOG_D("Invalid PGA gain: %d\n", point.pga_gain);
+        return false;
+    }
+
+    // Determine TIA mode index (0=high, 1=low)
+    int tia_mode = point.tia_gain ? 1 : 0;
+
+    // Get coefficients
+    CalibrationCoefficients& coeff = calibrationCoefficients[tia_mode][point.pga_gain];
+
+    // Check if coefficients are valid
+    if(!coeff.valid) {
+        LOG_D("No coefficients for TIA=%d, PGA=%d\n", tia_mode, point.pga_gain);
+        return false;
+    }
+
+    // Convert frequency to Hz (already in Hz from ImpedancePoint)
+    float f = (float)point.freq_hz;
+
+    // Calculate magnitude correction factor: (m0 + m1*f + m2*f²)
+    float mag_factor = coeff.m0 + coeff.m1 * f + coeff.m2 * f * f;
+
+    // Calculate phase correction: (a1*f + a2*f²)
+    float phase_correction = coeff.a1 * f + coeff.a2 * f * f;
+
+    // Apply calibration
+    // |Z_x| = |Z_nc| / (m0 + m1*f + m2*f²)
+    // arg(Z_x) = arg(Z_nc) - (a1*f + a2*f²)
+    applyCalibrationFactor(point, 1.0f / mag_factor, -phase_correction);
+
+    LOG_D("Formula cal: Freq=%lu, TIA=%d, PGA=%d -> mag_factor=%.6f, phase_corr=%.6f\n",
+          point.freq_hz, tia_mode, point.pga_gain, mag_factor, phase_correction);
+
+    return true;
+}
+#endif
+
+/*=========================FUSED LUT=========================*/
+void setCalibrationApplyTable(const CalLUTRow* lut) {
+    calibrationLUT = lut;
+
+    for(int s = 0; s < SWEEP_FREQ_COUNT - 1; s++) {
+        float dx = getSweepFreqInfo(s + 1).lnHz - getSweepFreqInfo(s).lnHz;
+        for(int tia = 0; tia < 2; tia++) {
+            for(int pga = 0; pga < 8; pga++) {
+                const CalLUTEntry& a = lut[s][tia][pga];
+                const CalLUTEntry& b = lut[s + 1][tia][pga];
+                CalSegment& seg = calibrationSegments[s][tia][pga];
+
+                // Only used when both ends are valid
+                seg.gain_slope = (b.gain - a.gain) / dx;
+                seg.phase_slope = (b.phase_offset - a.phase_offset) / dx;
+            }
+        }
+    }
+
+#if IMPEDANCE_RECTANGULAR
+    for(int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        for(int tia = 0; tia < 2; tia++) {
+            for(int pga = 0; pga < 8; pga++) {
+                const CalLUTEntry& cal = lut[f][tia][pga];
+                float phaseRad = cal.phase_offset * (float)(M_PI / 180.0);
+                calibrationComplex[f][tia][pga].re = cal.gain * cosf(phaseRad);
+                calibrationComplex[f][tia][pga].im = cal.gain * sinf(phaseRad);
+            }
+        }
+    }
+#endif
+}
+
+// Gain/phase for a point - exact sweep frequency or interpolated between two
+static bool lookupCalibration(const ImpedancePoint& point, float& gain, float& phase_offset) {
+    if(point.pga_gain > 7) {
+        return false;
+    }
+
+    uint8_t idx = getSweepFrequencyIndex(point.freq_hz, point.freq_idx);
+    if(idx != SWEEP_FREQ_INVALID) {
+        const CalLUTEntry& cal = calibrationLUT[idx][point.tia_gain][point.pga_gain];
+        gain = cal.gain;
+        phase_offset = cal.phase_offset;
+        return cal.valid;
+    }
+
+    // Off-grid: interpolate in log(f), no extrapolation outside the table
+    uint8_t s = getSweepSegment(point.freq_hz);
+    if(s == SWEEP_FREQ_INVALID ||
+       !calibrationLUT[s][point.tia_gain][point.pga_gain].valid ||
+       !calibrationLUT[s + 1][point.tia_gain][point.pga_gain].valid) {
+        return false;
+    }
+
+    const CalLUTEntry& a = calibrationLUT[s][point.tia_gain][point.pga_gain];
+    const CalSegment& seg = calibrationSegments[s][point.tia_gain][point.pga_gain];
+    float dx = logf((float)point.freq_hz) - getSweepFreqInfo(s).lnHz;
+    gain = a.gain + seg.gain_slope * dx;
+    phase_offset = a.phase_offset + seg.phase_slope * dx;
+#if CAL_MODEL_PRIOR
+    // Bend the line by the model's curvature - a parabola through both ends,
+    // off the line by the model's bow at the middle of the segment
+    float t = dx / (getSweepFreqInfo(s + 1).lnHz - getSweepFreqInfo(s).lnHz);
+    float w = 4.0f * t * (1.0f - t);
+    const CalModelBow& bow = calModel.bow[s][point.tia_gain][point.pga_gain];
+    gain *= 1.0f + w * bow.gain;
+    phase_offset += w * bow.phase;
+#endif
+    return true;
+}
+
+// Apply calibration using separate files
+// Formula: mag = (uncalibrated / v_gain) * tia_gain * pga_gain
+//          phase = uncalibrated_phase - v_phase + tia_phase + pga_phase
+bool calibrateWithSeparateFiles(ImpedancePoint& point) {
+#if IMPEDANCE_RECTANGULAR
+    uint8_t idx = getSweepFrequencyIndex(point.freq_hz, point.freq_idx);
+    if(idx == SWEEP_FREQ_INVALID || point.pga_gain > 7) {
+        // Off-grid: interpolate gain/phase as in polar mode (re/im interpolation
+        // collapses the magnitude where the phase offset jumps between points)
+        float gain, phase_offset;
+        if(!lookupCalibration(point, gain, phase_offset)) {
+            LOG_W("Missing calibration data for freq=%lu, TIA=%d, PGA=%d\n",
+                  point.freq_hz, point.tia_gain, point.pga_gain);
+            return false;
+        }
+        applyCalibrationFactor(point, gain, phase_offset);
+        return true;
+    }
+
+    if(!calibrationLUT[idx][point.tia_gain][point.pga_gain].valid) {
+        LOG_W("Missing calibration data for freq=%lu, TIA=%d, PGA=%d\n",
+              point.freq_hz, point.tia_gain, point.pga_gain);
+        return false;
+    }
+
+    // Z * (re + j*im) - no trig, phase is wrapped when converted to polar
+    const CalComplex& cal = calibrationComplex[idx][point.tia_gain][point.pga_gain];
+    float re = point.Z_re * cal.re - point.Z_im * cal.im;
+    point.Z_im = point.Z_re * cal.im + point.Z_im * cal.re;
+    point.Z_re = re;
+    LOG_D("Separate file cal: Freq=%lu, TIA=%d, PGA=%d -> cal=%.3f%+.3fj\n",
+          point.freq_hz, point.tia_gain, point.pga_gain, cal.re, cal.im);
+
+    return true;
+#else
+    float gain, phase_offset;
+
+    // Check if calibration is available for this combination
+    if(!lookupCalibration(point, gain, phase_offset)) {
+        LOG_W("Missing calibration data for freq=%lu, TIA=%d, PGA=%d\n",
+              point.freq_hz, point.tia_gain, point.pga_gain);
+        return false;
+    }
+
+    point.Z_magnitude *= gain;
+    point.Z_phase += phase_offset;
+
+    // Wrap phase to [-180, 180]
+    while(point.Z_phase > 180.0f) point.Z_phase -= 360.0f;
+    while(point.Z_phase < -180.0f) point.Z_phase += 360.0f;
+    LOG_D("Separate file cal: Freq=%lu, TIA=%d, PGA=%d -> gain=%.3f, phase=%.3f\n",
+          point.freq_hz, point.tia_gain, point.pga_gain, gain, phase_offset);
+
+    return true;
+#endif
+}
@@ -0,0 +1,92 @@
+#include "cal_image.h"
+#include "console.h"
+#include "crc.h"
+#include "esp_partition.h"
+
+static esp_partition_mmap_handle_t imageHandle;
+static const CalLUTEntry* imageEntries = nullptr;
+
+static bool validateImage(const uint8_t* image, size_t partitionSize) {
+    const CalImageHeader* header = reinterpret_cast<const CalImageHeader*>(image);
+
+    if (header->magic != CAL_IMAGE_MAGIC) {
+        Console.println("Calibration image: no image in partition");
+        return false;
+    }
+    if (header->headerCRC != crc16_ccitt(image, offsetof(CalImageHeader, headerCRC))) {
+        Console.println("Calibration image: header CRC mismatch");
+        return false;
+    }
+    if (header->version != CAL_IMAGE_VERSION ||
+        header->headerSize != sizeof(CalImageHeader) ||
+        header->freqCount != SWEEP_FREQ_COUNT ||
+        header->tiaCount != 2 || header->pgaCount != 8 ||
+        header->entrySize != sizeof(CalLUTEntry)) {
+        Console.printf("Calibration image: unsupported format (version %d, %d freqs, entry %d bytes)\n",
+                      header->version, header->freqCount, header->entrySize);
+        return false;
+    }
+
+    size_t expected = sizeof(sweepFrequencies) + SWEEP_FREQ_COUNT * 2 * 8 * sizeof(CalLUTEntry);
+    if (header->payloadSize != expected || sizeof(CalImageHeader) + expected > partitionSize) {
+        Console.printf("Calibration image: bad payload size %lu\n", header->payloadSize);
+        return false;
+    }
+
+    const uint8_t* payload = image + sizeof(CalImageHeader);
+    if (header->payloadCRC != crc16_ccitt(payload, header->payloadSize)) {
+        Console.println("Calibration image: payload CRC mismatch");
+        return false;
+    }
+
+    // Calibrated against a different sweep table - indices would not line up
+    if (memcmp(payload, sweepFrequencies, sizeof(sweepFrequencies)) != 0) {
+        Console.println("Calibration image: frequency table does not match firmware");
+        return false;
+    }
+    return true;
+}
+
+const esp_partition_t* findCalibrationPartition() {
+    return esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)CAL_IMAGE_PARTITION_SUBTYPE,
+        CAL_IMAGE_PARTITION_LABEL);
+}
+
+const CalLUTEntry* mapCalibrationImage() {
+    if (imageEntries != nullptr) {
+        return imageEntries;
+    }
+
+    const esp_partition_t* partition = findCalibrationPartition();
+    if (partition == nullptr) {
+        Console.println("Calibration image: no '" CAL_IMAGE_PARTITION_LABEL "' partition");
+        return nullptr;
+    }
+
+    const void* mapped = nullptr;
+    esp_err_t err = esp_partition_mmap(partition, 0, partition->size,
+                                       ESP_PARTITION_MMAP_DATA, &mapped, &imageHandle);
+    if (err != ESP_OK) {
+        Console.printf("Calibration image: mmap failed (%d)\n", err);
+        return nullptr;
+    }
+
+    const uint8_t* image = static_cast<const uint8_t*>(mapped);
+    if (!validateImage(image, partition->size)) {
+        esp_partition_munmap(imageHandle);
+        return nullptr;
+    }
+
+    imageEntries = reinterpret_cast<const CalLUTEntry*>(
+        image + sizeof(CalImageHeader) + sizeof(sweepFrequencies));
+    Console.printf("✓ Calibration image mapped from flash (0x%lx)\n", partition->address);
+    return imageEntries;
+}
+
+void unmapCalibrationImage() {
+    if (imageEntries != nullptr) {
+        esp_partition_munmap(imageHandle);
+        imageEntries = nullptr;
+    }
+}
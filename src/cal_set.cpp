@@ -0,0 +1,220 @@
+#include "cal_set.h"
+#include "console.h"
+#include "calibration.h"
+#include "cal_upload.h"
+#include "UART_Functions.h"
+#include "storage.h"
+#include <LittleFS.h>
+
+static char activeSet[CAL_SET_NAME_MAX] = "";     // "" = default set in the root
+static bool deviceIdHandled = false;
+
+/*=========================HELPERS=========================*/
+
+// Set names become directory names - keep them to [A-Za-z0-9_-]
+static bool isValidSetName(const char* name) {
+    size_t len = strlen(name);
+    if (len == 0 || len >= CAL_SET_NAME_MAX) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (!isalnum((unsigned char)name[i]) && name[i] != '_' && name[i] != '-') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static String setDir(const char* name) {
+    return String(CAL_SET_DIR "/") + name;
+}
+
+static bool setExists(const char* name) {
+    return isValidSetName(name) && LittleFS.exists(setDir(name));
+}
+
+// First line of CAL_SET_ID_FILE
+static bool readStoredSet(char* out) {
+    File file = LittleFS.open(CAL_SET_ID_FILE, "r");
+    if (!file) {
+        return false;
+    }
+    String line = file.readStringUntil('\n');
+    file.close();
+    line.trim();
+
+    if (line.length() == 0 || line.length() >= CAL_SET_NAME_MAX) {
+        return false;
+    }
+    strcpy(out, line.c_str());
+    return true;
+}
+
+// Set for an STM32 ID: CAL_SET_DEVICE_MAP entry, else a set named after the ID
+static bool lookupDeviceSet(const char* deviceId, char* out) {
+    File file = LittleFS.open(CAL_SET_DEVICE_MAP, "r");
+    if (file) {
+        while (file.available()) {
+            String line = file.readStringUntil('\n');
+            line.trim();
+            if (line.length() == 0 || line.startsWith("#")) {
+                continue;
+            }
+
+            int comma = line.indexOf(',');
+            if (comma <= 0) {
+                continue;
+            }
+            String id = line.substring(0, comma);
+            String name = line.substring(comma + 1);
+            id.trim();
+            name.trim();
+            if (id.equalsIgnoreCase(deviceId) && name.length() < CAL_SET_NAME_MAX) {
+                file.close();
+                strcpy(out, name.c_str());
+                return true;
+            }
+        }
+        file.close();
+    }
+
+    if (setExists(deviceId)) {
+        strcpy(out, deviceId);
+        return true;
+    }
+    return false;
+}
+
+/*=========================SELECTION=========================*/
+
+bool selectCalibrationSet() {
+    char name[CAL_SET_NAME_MAX] = "";
+    char candidate[CAL_SET_NAME_MAX];
+    char deviceId[STM32_DEVICE_ID_LEN + 1];
+    const char* source = "default";
+
+    if (readStoredSet(candidate)) {
+        if (setExists(candidate)) {
+            strcpy(name, candidate);
+            source = "stored ID";
+        } else {
+            Console.printf("Warning: stored calibration set '%s' not found\n", candidate);
+        }
+    }
+
+    if (name[0] == '\0' && getSTM32DeviceId(deviceId) && lookupDeviceSet(deviceId, candidate)) {
+        if (setExists(candidate)) {
+            strcpy(name, candidate);
+            source = "STM32 ID";
+        } else {
+            Console.printf("Warning: calibration set '%s' for STM32 %s not found\n", candidate, deviceId);
+        }
+    }
+
+    bool changed = strcmp(name, activeSet) != 0;
+    strcpy(activeSet, name);
+    Console.printf("Calibration set: %s (%s)\n", name[0] ? name : "<default>", source);
+    return changed;
+}
+
+const char* getCalibrationSetName() {
+    return activeSet;
+}
+
+void restoreCalibrationSetName(const char* name) {
+    snprintf(activeSet, sizeof(activeSet), "%s", name);
+}
+
+String calibrationSetPath(const char* file) {
+    if (activeSet[0] == '\0') {
+        return String(file);
+    }
+    return setDir(activeSet) + file;
+}
+
+bool storeCalibrationSet(const char* name) {
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted");
+        return false;
+    }
+
+    bool ok;
+    if (name[0] == '\0') {
+        ok = !LittleFS.exists(CAL_SET_ID_FILE) || LittleFS.remove(CAL_SET_ID_FILE);
+    } else if (!setExists(name)) {
+        Console.printf("ERROR: No calibration set '%s' in " CAL_SET_DIR "\n", name);
+        ok = false;
+    } else {
+        File file = LittleFS.open(CAL_SET_ID_FILE, "w");
+        ok = file && file.print(name) == strlen(name);
+        if (file) {
+            file.close();
+        }
+    }
+
+    return ok;
+}
+
+void printCalibrationSets() {
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted");
+        return;
+    }
+
+    char stored[CAL_SET_NAME_MAX];
+    char deviceId[STM32_DEVICE_ID_LEN + 1];
+    Console.println("\n=== Calibration Sets ===");
+    Console.printf("  %s <default>\n", activeSet[0] == '\0' ? "*" : " ");
+
+    File dir = LittleFS.open(CAL_SET_DIR);
+    if (dir && dir.isDirectory()) {
+        File entry = dir.openNextFile();
+        while (entry) {
+            if (entry.isDirectory()) {
+                Console.printf("  %s %s\n", strcmp(entry.name(), activeSet) == 0 ? "*" : " ", entry.name());
+            }
+            entry = dir.openNextFile();
+        }
+    }
+
+    Console.printf("Stored ID: %s\n", readStoredSet(stored) ? stored : "-");
+    Console.printf("STM32 ID:  %s\n", getSTM32DeviceId(deviceId) ? deviceId : "unknown");
+    Console.println("========================\n");
+}
+
+bool isCalibrationSetSelectionWaiting() {
+    char deviceId[STM32_DEVICE_ID_LEN + 1];
+    return !deviceIdHandled && getSTM32DeviceId(deviceId);
+}
+
+void processCalibrationSetSelection() {
+    if (deviceIdHandled) {
+        return;
+    }
+
+    char deviceId[STM32_DEVICE_ID_LEN + 1];
+    if (!getSTM32DeviceId(deviceId)) {
+        return;
+    }
+    // Try again once the previous reload was applied / the upload finished
+    if (isCalibrationReloadPending() || isCalUploadInProgress()) {
+        return;
+    }
+    deviceIdHandled = true;
+
+    if (getCalibrationMode() != CALIBRATION_MODE_SEPARATE_FILES) {
+        return;
+    }
+
+    char before[CAL_SET_NAME_MAX];
+    strcpy(before, activeSet);
+    if (!isStorageMounted()) {
+        return;
+    }
+    bool changed = selectCalibrationSet();
+
+    if (changed) {
+        Console.printf("Calibration set changed from '%s' - reloading\n", before);
+        reloadCalibration();
+    }
+}
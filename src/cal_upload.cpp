@@ -0,0 +1,219 @@
+#include "cal_upload.h"
+#include "console.h"
+#include "cal_image.h"
+#include "cal_acquire.h"
+#include "ota_update.h"
+#include "calibration.h"
+#include "crc.h"
+#include "BLE_Functions.h"
+#include "esp_partition.h"
+#include "defines.h"
+
+enum CalUploadState : uint8_t {
+    UPLOAD_IDLE,
+    UPLOAD_RELEASING,       // BEGIN received, waiting for releaseCalibrationImage()
+    UPLOAD_RECEIVING
+};
+
+// Single frame slot - filled by the BLE callback, drained by processCalUpload()
+static uint8_t frameBuffer[CAL_UPLOAD_FRAME_MAX];
+static volatile size_t frameLength = 0;         // 0 = slot free
+static volatile bool frameDropped = false;
+
+static CalUploadState state = UPLOAD_IDLE;
+static const esp_partition_t* partition = nullptr;
+static uint32_t imageSize = 0;
+static uint32_t writeOffset = 0;
+static uint32_t erasedUpTo = 0;
+static uint16_t nextSeq = 0;
+static unsigned long releaseStart = 0;
+
+/*=========================BLE SIDE=========================*/
+bool calUploadReceive(const uint8_t* data, size_t len) {
+    if (frameLength != 0) {
+        frameDropped = true;
+        return false;
+    }
+    if (len < CAL_UPLOAD_FRAME_OVERHEAD || len > CAL_UPLOAD_FRAME_MAX) {
+        return false;
+    }
+
+    memcpy(frameBuffer, data, len);
+    frameLength = len;      // Publish after the copy
+    return true;
+}
+
+bool isCalUploadInProgress() {
+    return state != UPLOAD_IDLE;
+}
+
+/*=========================REPLIES=========================*/
+static void sendAck(uint16_t seq) {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%s:%u", BLE_RESP_CAL_ACK, seq);
+    sendBLEString(buffer);
+}
+
+static void fail(const char* reason) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "Cal upload: %s", reason);
+    Console.printf("[CAL] %s\n", buffer);
+    sendBLEError(buffer);
+    state = UPLOAD_IDLE;
+}
+
+/*=========================FRAME HANDLERS=========================*/
+static void handleBegin(const uint8_t* payload, size_t len) {
+    if (len != sizeof(uint32_t)) {
+        fail("bad BEGIN");
+        return;
+    }
+    if (measurementInProgress) {
+        fail("measurement in progress");
+        return;
+    }
+    if (isCalAcquireActive()) {
+        fail("calibration acquisition running");
+        return;
+    }
+    if (isOTAUpdateActive()) {
+        fail("firmware update running");
+        return;
+    }
+
+    partition = findCalibrationPartition();
+    if (partition == nullptr) {
+        fail("no calib partition");
+        return;
+    }
+
+    memcpy(&imageSize, payload, sizeof(imageSize));
+    if (imageSize < sizeof(CalImageHeader) || imageSize > partition->size) {
+        fail("bad image size");
+        return;
+    }
+
+    writeOffset = 0;
+    erasedUpTo = 0;
+    nextSeq = 0;
+    releaseStart = millis();
+    state = UPLOAD_RELEASING;
+    Console.printf("[CAL] Upload started (%lu bytes)\n", imageSize);
+}
+
+static void handleData(uint16_t seq, const uint8_t* payload, size_t len) {
+    if (state != UPLOAD_RECEIVING) {
+        fail("DATA before BEGIN");
+        return;
+    }
+    if (seq + 1 == nextSeq) {
+        sendAck(seq);       // Retransmission after a lost ACK - already written
+        return;
+    }
+    if (seq != nextSeq) {
+        fail("chunk out of sequence");
+        return;
+    }
+    if (writeOffset + len > imageSize) {
+        fail("image larger than announced");
+        return;
+    }
+
+    // Erase sectors just ahead of the data instead of the whole partition at BEGIN
+    while (erasedUpTo < writeOffset + len) {
+        if (esp_partition_erase_range(partition, erasedUpTo, partition->erase_size) != ESP_OK) {
+            fail("flash erase failed");
+            return;
+        }
+        erasedUpTo += partition->erase_size;
+    }
+    if (esp_partition_write(partition, writeOffset, payload, len) != ESP_OK) {
+        fail("flash write failed");
+        return;
+    }
+
+    writeOffset += len;
+    nextSeq++;
+    sendAck(seq);
+}
+
+static void handleEnd(uint16_t seq) {
+    if (state != UPLOAD_RECEIVING || writeOffset != imageSize) {
+        fail("image incomplete");
+        return;
+    }
+    state = UPLOAD_IDLE;
+
+    // Validates header, sweep table and payload CRC straight from flash
+    if (mapCalibrationImage() == nullptr) {
+        fail("image invalid");
+        return;
+    }
+    if (!reloadCalibration()) {
+        fail("reload failed");
+        return;
+    }
+
+    Console.printf("[CAL] Upload complete (%lu bytes)\n", imageSize);
+    sendAck(seq);
+}
+
+/*=========================PROCESSING=========================*/
+void processCalUpload() {
+    if (frameDropped) {
+        frameDropped = false;
+        fail("frame dropped - wait for CAL_ACK");
+    }
+
+    // Calibration must stop reading the partition before it is erased
+    if (state == UPLOAD_RELEASING) {
+        if (releaseCalibrationImage()) {
+            state = UPLOAD_RECEIVING;
+            sendAck(0);
+        } else if (millis() - releaseStart > CAL_UPLOAD_RELEASE_MS) {
+            fail("calibration table busy");
+        }
+    }
+
+    size_t len = frameLength;
+    if (len == 0) {
+        return;
+    }
+
+    uint16_t crc;
+    memcpy(&crc, frameBuffer + len - sizeof(crc), sizeof(crc));
+    if (crc != crc16_ccitt(frameBuffer, len - sizeof(crc))) {
+        fail("frame CRC mismatch");
+        frameLength = 0;
+        return;
+    }
+
+    uint8_t type = frameBuffer[0];
+    uint16_t seq;
+    memcpy(&seq, frameBuffer + 1, sizeof(seq));
+    const uint8_t* payload = frameBuffer + 3;
+    size_t payloadLen = len - CAL_UPLOAD_FRAME_OVERHEAD;
+
+    switch (type) {
+        case CAL_UPLOAD_BEGIN:
+            handleBegin(payload, payloadLen);
+            break;
+        case CAL_UPLOAD_DATA:
+            handleData(seq, payload, payloadLen);
+            break;
+        case CAL_UPLOAD_END:
+            handleEnd(seq);
+            break;
+        case CAL_UPLOAD_ABORT:
+            // The partition may hold a partial image - it fails validation at boot
+            state = UPLOAD_IDLE;
+            Console.println("[CAL] Upload aborted");
+            sendAck(seq);
+            break;
+        default:
+            fail("unknown frame type");
+            break;
+    }
+
+    frameLength = 0;        // Free the slot for the next frame
+}
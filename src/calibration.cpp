@@ -1,4 +1,17 @@
 #include "calibration.h"
+#include "console.h"
+#include "cal_apply.h"
+#include "cal_model.h"
+#include "log.h"
+#include "trace.h"
+#include "sweep_stats.h"
+#include "crc.h"
+#include "cal_image.h"
+#include "fixed_cal.h"
+#include "cal_set.h"
+#include "storage.h"
+#include "csv_reader.h"
+#include "counters.h"
 #include <LittleFS.h>
 
 // float v_phase_shifts[MAX_CAL_FREQUENCIES] = {
@@ -249,21 +262,8 @@
 //     319.0f   // 156250 Hz
 // };
 
-const float V_GBW = 10.0f;  // Gain Bandwidth Product in MHz
-const float V_gain = 15.4f; // Voltage Gain of the INA331 Instrumentation Amplifier
-const float PGA_Cutoff[8] = { // Cutoff frequencies for each PGA gain setting (in MHz)
-    10.0f,  // Gain = 1
-    3.8f,   // Gain = 2
-    1.8f,   // Gain = 5
-    1.8f,   // Gain = 10
-    1.3f,   // Gain = 20
-    0.9f,   // Gain = 50
-    0.38f,  // Gain = 100
-    0.23f   // Gain = 200
-};
-const float I_GBW = 40.0f;  // Gain Bandwidth Product in MHz
-const float TIA_Gains[2] = {7500.0f, 37.5f}; // TIA Gains for High and Low modes respectively
-const float TLV_gain = 20.0f; // Gain of the TLV9061 OpAmp which is identical on both current and voltage stages
+// Front-end constants (V_GBW, V_gain, PGA_Cutoff, I_GBW, TIA_Gains, TLV_gain)
+// and the model built from them: cal_model.h
 
 // const float non_ideal_phase_shift[38] = {
 
@@ -293,16 +293,19 @@ typedef enum {
     (gain_enum) == PGA113_GAIN_200 ? 200 : 1)  // Default to 1 if invalid
 /* Exported functions prototypes ---------------------------------------------*/
 
-/*=========================GLOBAL VARIABLES=========================*/
-FreqCalibrationData calibrationData[MAX_CAL_FREQUENCIES];
-int numCalibrationFreqs = 0;
+// Switch the active table and precompute its interpolation slopes
+static void setActiveCalibrationLUT(const CalLUTRow* lut);
 
-// Calibration coefficients: [TIA_mode][PGA_gain]
-CalibrationCoefficients calibrationCoefficients[2][8];
+// Keep a freshly built/loaded table until publishCalibrationLUT() hands it to
+// applyPendingCalibrationLUT() - replaces (and frees) an unpublished one
+static void stageCalibrationLUT(const CalLUTRow* lut);
+static void publishCalibrationLUT();
 
-// Current calibration mode (default to lookup table)
-CalibrationMode calibrationMode = CALIBRATION_MODE_SEPARATE_FILES;
-// CalibrationMode calibrationMode = CALIBRATION_MODE_FORMULA;
+/*=========================GLOBAL VARIABLES=========================*/
+#if !CAL_PIPELINE_SINGLE
+// Current calibration mode (CAL_PIPELINE selects the modes that can be set)
+CalibrationMode calibrationMode = CAL_PIPELINE_DEFAULT_MODE;
+#endif
 
 /*=========================NEW CALIBRATION GLOBALS=========================*/
 // Separate calibration data arrays
@@ -322,68 +325,136 @@ int numPGAFreqs[8] = {0};
 FreqCalPoint psTraceCalData[MAX_CAL_FREQUENCIES];
 int numPSTraceFreqs = 0;
 
-/*=========================HELPER FUNCTIONS=========================*/
-
-// Find the index of a frequency in the calibration data
-int findFrequencyIndex(uint32_t freq) {
-    for(int i = 0; i < numCalibrationFreqs; i++) {
-        if(calibrationData[i].frequency_hz == freq) {
-            return i;
-        }
-    }
-    return -1;
-}
+// Staged: private to the loading task. Pending: published, taken by the data
+// processor between sweeps - a single pointer store, so no lock is needed
+static const CalLUTRow* stagedCalibrationLUT = nullptr;
+static const CalLUTRow* volatile pendingCalibrationLUT = nullptr;
+static const CalLUTEntry* mappedImageLUT = nullptr;     // Flash - never freed
 
-// Get calibration point for specific frequency and gain settings
-CalibrationPoint* getCalibrationPoint(uint32_t freq, bool lowTIA, uint8_t pgaGain) {
-    if(pgaGain > 7) return nullptr;
+// Valid gain combinations per index of the active table - written when the
+// table switches (between sweeps), read by the command task at START
+static uint16_t calCoverage[SWEEP_FREQ_COUNT];
 
-    // // Calculate our voltage gain and phase shift
-    // float v_gain = 20 * V_gain * (1/sqrt(1+(pow((freq/(V_GBW/V_gain*1e6)), 2))));
-    // float v_phase = -atan(freq/(V_GBW/V_gain*1e6)) * 180.0f / M_PI;
+SimpleCalPoint psTraceByIndex[SWEEP_FREQ_COUNT];
 
-    // // Calculate our current gain and phase shift
-    // float tia_gain = TIA_Gains[lowTIA];
-    // float i_gain = 20 * tia_gain * (1/sqrt(1+(pow((freq/(I_GBW/tia_gain*1e6)), 2)))) 
-    //                * PGA113_ENUM_TO_GAIN(pgaGain) * (1/sqrt(1+(pow((freq/(PGA_Cutoff[pgaGain]*1e6)), 2))));
-    // float i_phase = -atan(freq/(I_GBW/tia_gain*1e6)) * 180.0f / M_PI - atan(freq/(PGA_Cutoff[pgaGain]*1e6)) * 180.0f / M_PI;
+/*=========================FILE LOADING FUNCTIONS=========================*/
 
-    // return new CalibrationPoint(v_gain, i_gain, v_phase - i_phase);
-    int idx = findFrequencyIndex(freq);
-    if(idx < 0) return nullptr;
+// Every loader reads through this one - boot calibration task, or the GUI
+// task for a reload, never two at once
+static CsvReader csv;
 
-    if(lowTIA) {
-        return &calibrationData[idx].low_TIA_gains[pgaGain];
-    } else {
-        return &calibrationData[idx].high_TIA_gains[pgaGain];
+static void reportLongLines(const char* name) {
+    if(csv.longLines > 0) {
+        Console.printf("Warning: %u lines over %d characters skipped in %s\n",
+                       csv.longLines, CSV_READER_LINE_MAX, name);
     }
 }
 
-/*=========================FILE LOADING FUNCTIONS=========================*/
+// Read a freq,gain,phase_offset file into out (at most MAX_CAL_FREQUENCIES
+// rows), scaling freq by freqScale to Hz (the stage CSVs are in kHz)
+// Returns the row count, -1 if the file does not open
+static int loadFreqCalFile(const String& path, FreqCalPoint* out, float freqScale, const char* name) {
+    File file = LittleFS.open(path, "r");
+    if(!file) {
+        return -1;
+    }
+
+    int count = 0;
+    csvBegin(csv, file);
+    while(count < MAX_CAL_FREQUENCIES && csvNextLine(csv)) {
+        float freq = 0.0;
+        float gain = 1.0;
+        float phase = 0.0;
+        if(!csvFloat(csv, freq) || !csvFloat(csv, gain) || !csvFloat(csv, phase)) {
+            Console.printf("Invalid line %u in %s: %s\n", csv.lineNumber, name, csv.line);
+            continue;
+        }
+        out[count++] = FreqCalPoint(round(freq * freqScale), gain, phase);
+    }
+    file.close();
+    reportLongLines(name);
+    return count;
+}
 
 // Load calibration data from filesystem
 // CSV Format: freq,tia_mode,pga_gain,v_gain,i_gain,phase
 // tia_mode: 0=low, 1=high
 // pga_gain: 0-7
+// Stage the fused table for separate-files mode: calibration image, cache, CSVs
+static bool stageSeparateFilesLUT(bool useCache) {
+    // Pick the set for this board first - cache and CSV paths depend on it
+    if (isStorageMounted()) {
+        selectCalibrationSet();
+    }
+
+    // Compiled image in the calibration partition - used in place from flash
+    const CalLUTEntry* image = mapCalibrationImage();
+    if (image != nullptr) {
+        mappedImageLUT = image;
+        stageCalibrationLUT(reinterpret_cast<const CalLUTRow*>(image));
+        return true;
+    }
+
+    // Fused table from a previous boot - skips parsing all CSV files
+    if (useCache && isStorageMounted()) {
+        bool cached = loadCalibrationLUT();
+        if (cached) {
+            return true;
+        }
+    }
+
+#if CAL_MODEL_PRIOR
+    // Every stage file is read - the model only stands in for what is missing
+    bool voltageOk = loadVoltageCalibration();
+    bool tiaOk = loadTIACalibration();
+    bool pgaOk = loadPGACalibration();
+    bool success = voltageOk && tiaOk && pgaOk;
+    bool psTraceOk = loadPSTraceCalibration();
+    if (!voltageOk && !tiaOk && !pgaOk && !psTraceOk) {
+        // No calibration files at all - the model table, used in place from flash
+        Console.println("No calibration files - calibrating from the front-end model");
+        stageCalibrationLUT(getCalModelLUT());
+        return false;
+    }
+#else
+    bool success = (loadVoltageCalibration() && loadTIACalibration() && loadPGACalibration());
+    // Load PS Trace calibration (final calibration step, fused into the LUT)
+    loadPSTraceCalibration();
+#endif
+    buildCalibrationLUT();
+
+    if (success && isStorageMounted()) {
+        saveCalibrationLUT();
+    }
+    return success;
+}
+
 bool loadCalibrationData() {
 
-    if (calibrationMode == CALIBRATION_MODE_SEPARATE_FILES) {
-        bool success = (loadVoltageCalibration() && loadTIACalibration() && loadPGACalibration());
-        // Load PS Trace calibration (final calibration step)
+    if (getCalibrationMode() == CALIBRATION_MODE_SEPARATE_FILES) {
+        // Boot: nothing is calibrating yet, switch right away
+        bool success = stageSeparateFilesLUT(true);
+        publishCalibrationLUT();
+        applyPendingCalibrationLUT();
+        return success;
+    }
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
+    if (getCalibrationMode() == CALIBRATION_MODE_FORMULA) {
+        bool success = loadCalibrationCoefficients();
         loadPSTraceCalibration();
         return success;
     }
-    // Initialize LittleFS
-    if(!LittleFS.begin(true)) {
-        Serial.println("Failed to mount LittleFS");
+#endif
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted");
         return false;
     }
 
     // Open calibration file
     File file = LittleFS.open("/calibration.csv", "r");
     if(!file) {
-        Serial.println("Failed to open calibration.csv");
-        LittleFS.end();
+        Console.println("Failed to open calibration.csv");
         return false;
     }
 
@@ -391,34 +462,24 @@ bool loadCalibrationData() {
     int currentFreqIdx = -1;
     uint32_t lastFreq = 0;
 
-    // Read file line by line
-    while(file.available() && numCalibrationFreqs <= MAX_CAL_FREQUENCIES) {
-        String line = file.readStringUntil('\n');
-        line.trim();
-
-        // Skip empty lines and comments
-        if(line.length() == 0 || line.startsWith("#")) {
-            continue;
-        }
-
-        // Parse CSV line: freq,tia_mode,pga_gain,v_gain,i_gain,phase
+    csvBegin(csv, file);
+    while(numCalibrationFreqs <= MAX_CAL_FREQUENCIES && csvNextLine(csv)) {
+        // CSV line: freq,tia_mode,pga_gain,Z_gain,phase
         uint32_t freq = 0;
         int tia_mode = 0;
         int pga_gain = 0;
         float Z_gain = 1.0;
         float phase = 0.0;
 
-        int fieldCount = sscanf(line.c_str(), "%lu,%d,%d,%f,%f",
-                                &freq, &tia_mode, &pga_gain, &Z_gain, &phase);
-
-        if(fieldCount != 5) {
-            Serial.printf("Invalid line: %s\n", line.c_str());
+        if(!csvUint(csv, freq) || !csvInt(csv, tia_mode) || !csvInt(csv, pga_gain) ||
+           !csvFloat(csv, Z_gain) || !csvFloat(csv, phase)) {
+            Console.printf("Invalid line %u: %s\n", csv.lineNumber, csv.line);
             continue;
         }
 
         // Validate ranges
         if(tia_mode < 0 || tia_mode > 1 || pga_gain < 0 || pga_gain > 7) {
-            Serial.printf("Invalid TIA mode or PGA gain: %s\n", line.c_str());
+            Console.printf("Invalid TIA mode or PGA gain: %s\n", csv.line);
             continue;
         }
 
@@ -442,71 +503,66 @@ bool loadCalibrationData() {
             calibrationData[currentFreqIdx].high_TIA_gains[pga_gain] = point;
         }
 
-        // Serial.printf("Loaded: Freq=%lu, TIA=%d, PGA=%d, Z_gain=%.3f, Phase=%.2f\n",
+        // Console.printf("Loaded: Freq=%lu, TIA=%d, PGA=%d, Z_gain=%.3f, Phase=%.2f\n",
         //               freq, tia_mode, pga_gain, Z_gain, phase);
     }
 
     file.close();
-    LittleFS.end();
+    reportLongLines("calibration.csv");
 
-    Serial.printf("Loaded calibration data for %d frequencies\n", numCalibrationFreqs);
+    Console.printf("Loaded calibration data for %d frequencies\n", numCalibrationFreqs);
 
     // Load PS Trace calibration (final calibration step)
     loadPSTraceCalibration();
 
     return true;
+#else
+    return false;
+#endif
 }
 
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
 // Load calibration coefficients from filesystem
 // CSV Format: tia_mode,pga_gain_index,m0,m1,m2,a1,a2,r_squared_mag,r_squared_phase
 // tia_mode: 0=high (7500Ω), 1=low (37.5Ω)
 // pga_gain_index: 0-7 (1, 2, 5, 10, 20, 50, 100, 200)
 bool loadCalibrationCoefficients() {
-    // Initialize LittleFS
-    if(!LittleFS.begin(true)) {
-        Serial.println("Failed to mount LittleFS");
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted");
         return false;
     }
 
     // Open coefficients file
     File file = LittleFS.open("/calibration_coefficients.csv", "r");
     if(!file) {
-        Serial.println("Failed to open calibration_coefficients.csv");
-        LittleFS.end();
+        Console.println("Failed to open calibration_coefficients.csv");
         return false;
     }
 
     int coeffCount = 0;
 
-    // Read file line by line
-    while(file.available()) {
-        String line = file.readStringUntil('\n');
-        line.trim();
-
-        // Skip empty lines and comments
-        if(line.length() == 0 || line.startsWith("#")) {
-            continue;
-        }
-
-        // Parse CSV line: tia_mode,pga_gain_index,m0,m1,m2,a1,a2,r_squared_mag,r_squared_phase
+    csvBegin(csv, file);
+    while(csvNextLine(csv)) {
+        // CSV line: tia_mode,pga_gain_index,m0,m1,m2,a1,a2,r_squared_mag,r_squared_phase
         int tia_mode = 0;
         int pga_gain = 0;
         float m0 = 1.0, m1 = 0.0, m2 = 0.0;
         float a1 = 0.0, a2 = 0.0;
         float r_sq_mag = 0.0, r_sq_phase = 0.0;
 
-        int fieldCount = sscanf(line.c_str(), "%d,%d,%f,%f,%f,%f,%f,%f,%f",
-                                &tia_mode, &pga_gain, &m0, &m1, &m2, &a1, &a2,
-                                &r_sq_mag, &r_sq_phase);
+        bool ok = csvInt(csv, tia_mode) && csvInt(csv, pga_gain) &&
+                  csvFloat(csv, m0) && csvFloat(csv, m1) && csvFloat(csv, m2) &&
+                  csvFloat(csv, a1) && csvFloat(csv, a2) &&
+                  csvFloat(csv, r_sq_mag) && csvFloat(csv, r_sq_phase);
 
-        if(fieldCount != 9) {
-            Serial.printf("Invalid coefficient line (expected 9 fields, got %d): %s\n", fieldCount, line.c_str());
+        if(!ok) {
+            Console.printf("Invalid coefficient line (expected 9 fields, got %d): %s\n", csv.fields, csv.line);
             continue;
         }
 
         // Validate ranges
         if(tia_mode < 0 || tia_mode > 1 || pga_gain < 0 || pga_gain > 7) {
-            Serial.printf("Invalid TIA mode or PGA gain: %s\n", line.c_str());
+            Console.printf("Invalid TIA mode or PGA gain: %s\n", csv.line);
             continue;
         }
 
@@ -522,100 +578,70 @@ bool loadCalibrationCoefficients() {
 
         coeffCount++;
 
-        // Serial.printf("Loaded: TIA=%d, PGA=%d, m0=%.6f, m1=%.6e, m2=%.6e, a1=%.6e, a2=%.6e\n",
+        // Console.printf("Loaded: TIA=%d, PGA=%d, m0=%.6f, m1=%.6e, m2=%.6e, a1=%.6e, a2=%.6e\n",
         //               tia_mode, pga_gain, m0, m1, m2, a1, a2);
     }
 
     file.close();
-    LittleFS.end();
+    reportLongLines("calibration_coefficients.csv");
 
-    Serial.printf("Loaded %d calibration coefficient sets\n", coeffCount);
+    Console.printf("Loaded %d calibration coefficient sets\n", coeffCount);
     return coeffCount > 0;
 }
 
-// Apply calibration using quadratic formula
-// Formula: |Z_x| = |Z_nc| / (m0 + m1*f + m2*f²)
-//          arg(Z_x) = arg(Z_nc) - (a1*f + a2*f²)
-bool calibrateWithFormula(ImpedancePoint& point) {
-    // Validate PGA gain
-    if(point.pga_gain > 7) {
-        Serial.printf("Invalid PGA gain: %d\n", point.pga_gain);
-        return false;
-    }
-
-    // Determine TIA mode index (0=high, 1=low)
-    int tia_mode = point.tia_gain ? 1 : 0;
-
-    // Get coefficients
-    CalibrationCoefficients& coeff = calibrationCoefficients[tia_mode][point.pga_gain];
-
-    // Check if coefficients are valid
-    if(!coeff.valid) {
-        Serial.printf("No coefficients for TIA=%d, PGA=%d\n", tia_mode, point.pga_gain);
-        return false;
-    }
-
-    // Convert frequency to Hz (already in Hz from ImpedancePoint)
-    float f = (float)point.freq_hz;
-
-    // Calculate magnitude correction factor: (m0 + m1*f + m2*f²)
-    float mag_factor = coeff.m0 + coeff.m1 * f + coeff.m2 * f * f;
-
-    // Calculate phase correction: (a1*f + a2*f²)
-    float phase_correction = coeff.a1 * f + coeff.a2 * f * f;
+#endif
 
-    // Apply calibration
-    // |Z_x| = |Z_nc| / (m0 + m1*f + m2*f²)
-    point.Z_magnitude = point.Z_magnitude / mag_factor;
-
-    // arg(Z_x) = arg(Z_nc) - (a1*f + a2*f²)
-    point.Z_phase = point.Z_phase - phase_correction;
-
-    Serial.printf("Formula cal: Freq=%lu, TIA=%d, PGA=%d -> mag_factor=%.6f, phase_corr=%.6f\n",
-                  point.freq_hz, tia_mode, point.pga_gain, mag_factor, phase_correction);
-
-    return true;
-}
+static FieldCounter calMisses("cal.misses");      // Points without calibration data
 
 bool calibrate(ImpedancePoint& point) {
     bool success = false;
-
-    // Check calibration mode and route to appropriate method
-    if(calibrationMode == CALIBRATION_MODE_FORMULA) {
-        // Use formula-based calibration
-        success = calibrateWithFormula(point);
-    } else if(calibrationMode == CALIBRATION_MODE_SEPARATE_FILES) {
+    int64_t startUs = esp_timer_get_time();
+    trace(TRACE_CAL_BEGIN, 0, point.freq_hz);
+
+    // Route to the mode's method - with one mode compiled in (CAL_PIPELINE)
+    // the checks are constant and only its call remains
+    CalibrationMode mode = getCalibrationMode();
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FUSED)
+    if(mode == CALIBRATION_MODE_SEPARATE_FILES) {
         // Use separate files calibration
         success = calibrateWithSeparateFiles(point);
-    } else {
+    }
+#endif
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
+    if(mode == CALIBRATION_MODE_FORMULA) {
+        // Use formula-based calibration
+        success = calibrateWithFormula(point);
+    }
+#endif
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+    if(mode == CALIBRATION_MODE_LOOKUP) {
         // Use lookup table calibration
-        CalibrationPoint* calPoint = getCalibrationPoint(point.freq_hz, point.tia_gain, point.pga_gain);
-        Serial.printf("Lookup cal: Freq=%lu, TIA=%d, PGA=%d -> Z_gain=%.3f, Phase=%.2f\n",
-                      point.freq_hz, point.tia_gain, point.pga_gain,
-                      calPoint ? calPoint->impedance_gain : 0.0f,
-                      calPoint ? calPoint->phase_offset : 0.0f);
-        if(calPoint) {
-            // Apply calibration
-            point.Z_magnitude = point.Z_magnitude * calPoint->impedance_gain;
-            point.Z_phase -= calPoint->phase_offset;
-            success = true;
-        } else {
-            success = false; // Calibration point not found
-        }
+        success = calibrateWithLookup(point);
     }
+#endif
 
     // Apply PS Trace calibration as final step (always applied if data loaded)
-    if(success) {
+    // The separate-files LUT already has it fused in
+    if(success && mode != CALIBRATION_MODE_SEPARATE_FILES) {
         applyPSTraceCalibration(point);
     }
 
+    if(!success) {
+        calMisses.add();
+    }
+    trace(TRACE_CAL_END, success, point.freq_hz);
+    sweepStatsRecord(STAGE_CALIBRATE, (uint32_t)(esp_timer_get_time() - startUs));
     return success;
 }
 
 /*=========================MODE CONTROL FUNCTIONS=========================*/
-
-// Set calibration mode
+#if !CAL_PIPELINE_SINGLE
+// Set calibration mode - only modes compiled in (CAL_PIPELINE)
 void setCalibrationMode(CalibrationMode mode) {
+    if(!CAL_PIPELINE_HAS(1 << mode)) {
+        Console.printf("Calibration mode %d not built in (CAL_PIPELINE 0x%X)\n", mode, CAL_PIPELINE);
+        return;
+    }
     calibrationMode = mode;
     const char* modeName;
     switch(mode) {
@@ -629,13 +655,14 @@ void setCalibrationMode(CalibrationMode mode) {
             modeName = "LOOKUP_TABLE";
             break;
     }
-    Serial.printf("Calibration mode set to: %s\n", modeName);
+    Console.printf("Calibration mode set to: %s\n", modeName);
 }
 
 // Get current calibration mode
 CalibrationMode getCalibrationMode() {
     return calibrationMode;
 }
+#endif
 
 /*=========================NEW CALIBRATION FUNCTIONS=========================*/
 
@@ -682,154 +709,58 @@ int findPGAFreqIndex(uint32_t freq, uint8_t pgaGain) {
 // Load voltage calibration from /voltage.csv
 // CSV Format: freq,gain,phase_offset
 bool loadVoltageCalibration() {
-    // Initialize LittleFS
-    if(!LittleFS.begin(true)) {
-        Serial.println("Failed to mount LittleFS for voltage calibration");
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted for voltage calibration");
         return false;
     }
 
-    // Open voltage calibration file
-    File file = LittleFS.open("/voltage.csv", "r");
-    if(!file) {
-        Serial.println("Failed to open voltage.csv");
-        LittleFS.end();
+    int count = loadFreqCalFile(calibrationSetPath("/voltage.csv"), voltageCalData, 1000.0f, "voltage.csv");
+    if(count < 0) {
+        Console.println("Failed to open voltage.csv");
         return false;
     }
+    numVoltageFreqs = count;
 
-    numVoltageFreqs = 0;
-
-    // Read file line by line
-    while(file.available() && numVoltageFreqs < MAX_CAL_FREQUENCIES) {
-        String line = file.readStringUntil('\n');
-        line.trim();
-
-        // Skip empty lines, comments, and header
-        if(line.length() == 0 || line.startsWith("#") || line.startsWith("freq")) {
-            continue;
-        }
-
-        // Parse CSV line: freq,gain,phase_offset
-        float freq_khz = 0;
-        float gain = 1.0;
-        float phase = 0.0;
-
-        int fieldCount = sscanf(line.c_str(), "%f,%f,%f", &freq_khz, &gain, &phase);
-
-        if(fieldCount != 3) {
-            Serial.printf("Invalid voltage cal line: %s\n", line.c_str());
-            continue;
-        }
-
-        // Store calibration point
-        voltageCalData[numVoltageFreqs] = FreqCalPoint(round(freq_khz*1000), gain, phase);
-        numVoltageFreqs++;
-    }
-
-    file.close();
-    LittleFS.end();
-
-    Serial.printf("Loaded voltage calibration for %d frequencies\n", numVoltageFreqs);
+    Console.printf("Loaded voltage calibration for %d frequencies\n", numVoltageFreqs);
     return numVoltageFreqs > 0;
 }
 
 // Load TIA calibration from /tia_high.csv and /tia_low.csv
 // CSV Format: freq,gain,phase_offset
 bool loadTIACalibration() {
-    // Initialize LittleFS
-    if(!LittleFS.begin(true)) {
-        Serial.println("Failed to mount LittleFS for TIA calibration");
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted for TIA calibration");
         return false;
     }
 
     bool success = true;
 
-    // Load TIA High calibration
-    File fileHigh = LittleFS.open("/tia_high.csv", "r");
-    if(!fileHigh) {
-        Serial.println("Failed to open tia_high.csv");
+    int count = loadFreqCalFile(calibrationSetPath("/tia_high.csv"), tiaHighCalData, 1000.0f, "tia_high.csv");
+    if(count < 0) {
+        Console.println("Failed to open tia_high.csv");
         success = false;
     } else {
-        numTIAHighFreqs = 0;
-
-        while(fileHigh.available() && numTIAHighFreqs < MAX_CAL_FREQUENCIES) {
-            String line = fileHigh.readStringUntil('\n');
-            line.trim();
-
-            // Skip empty lines, comments, and header
-            if(line.length() == 0 || line.startsWith("#") || line.startsWith("freq")) {
-                continue;
-            }
-
-            // Parse CSV line: freq,gain,phase_offset
-            float freq_khz = 0;
-            float gain = 1.0;
-            float phase = 0.0;
-
-            int fieldCount = sscanf(line.c_str(), "%f,%f,%f", &freq_khz, &gain, &phase);
-
-            if(fieldCount != 3) {
-                Serial.printf("Invalid TIA high cal line: %s\n", line.c_str());
-                continue;
-            }
-
-            // Store calibration point
-            tiaHighCalData[numTIAHighFreqs] = FreqCalPoint(round(freq_khz*1000), gain, phase);
-            numTIAHighFreqs++;
-        }
-
-        fileHigh.close();
-        Serial.printf("Loaded TIA high calibration for %d frequencies\n", numTIAHighFreqs);
+        numTIAHighFreqs = count;
+        Console.printf("Loaded TIA high calibration for %d frequencies\n", numTIAHighFreqs);
     }
 
-    // Load TIA Low calibration
-    File fileLow = LittleFS.open("/tia_low.csv", "r");
-    if(!fileLow) {
-        Serial.println("Failed to open tia_low.csv");
+    count = loadFreqCalFile(calibrationSetPath("/tia_low.csv"), tiaLowCalData, 1000.0f, "tia_low.csv");
+    if(count < 0) {
+        Console.println("Failed to open tia_low.csv");
         success = false;
     } else {
-        numTIALowFreqs = 0;
-
-        while(fileLow.available() && numTIALowFreqs < MAX_CAL_FREQUENCIES) {
-            String line = fileLow.readStringUntil('\n');
-            line.trim();
-
-            // Skip empty lines, comments, and header
-            if(line.length() == 0 || line.startsWith("#") || line.startsWith("freq")) {
-                continue;
-            }
-
-            // Parse CSV line: freq,gain,phase_offset
-            float freq_khz = 0;
-            float gain = 1.0;
-            float phase = 0.0;
-
-            int fieldCount = sscanf(line.c_str(), "%f,%f,%f", &freq_khz, &gain, &phase);
-
-            if(fieldCount != 3) {
-                Serial.printf("Invalid TIA low cal line: %s\n", line.c_str());
-                continue;
-            }
-
-            // Store calibration point
-            tiaLowCalData[numTIALowFreqs] = FreqCalPoint(round(freq_khz*1000), gain, phase);
-            numTIALowFreqs++;
-        }
-
-        fileLow.close();
-        Serial.printf("Loaded TIA low calibration for %d frequencies\n", numTIALowFreqs);
+        numTIALowFreqs = count;
+        Console.printf("Loaded TIA low calibration for %d frequencies\n", numTIALowFreqs);
     }
 
-    LittleFS.end();
-
     return success && (numTIAHighFreqs > 0 || numTIALowFreqs > 0);
 }
 
 // Load PGA calibration from /pga_*.csv files
 // CSV Format: freq,gain,phase_offset
 bool loadPGACalibration() {
-    // Initialize LittleFS
-    if(!LittleFS.begin(true)) {
-        Serial.println("Failed to mount LittleFS for PGA calibration");
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted for PGA calibration");
         return false;
     }
 
@@ -849,68 +780,40 @@ bool loadPGACalibration() {
 
     // Load each PGA calibration file
     for(int pgaIdx = 0; pgaIdx < 8; pgaIdx++) {
-        File file = LittleFS.open(pgaFiles[pgaIdx], "r");
-        if(!file) {
-            Serial.printf("Warning: Failed to open %s\n", pgaFiles[pgaIdx]);
+        int count = loadFreqCalFile(calibrationSetPath(pgaFiles[pgaIdx]), pgaCalData[pgaIdx], 1000.0f,
+                                    pgaFiles[pgaIdx] + 1);
+        if(count < 0) {
+            Console.printf("Warning: Failed to open %s\n", pgaFiles[pgaIdx]);
             numPGAFreqs[pgaIdx] = 0;
             continue;
         }
-
-        numPGAFreqs[pgaIdx] = 0;
-
-        while(file.available() && numPGAFreqs[pgaIdx] < MAX_CAL_FREQUENCIES) {
-            String line = file.readStringUntil('\n');
-            line.trim();
-
-            // Skip empty lines, comments, and header
-            if(line.length() == 0 || line.startsWith("#") || line.startsWith("freq")) {
-                continue;
-            }
-
-            // Parse CSV line: freq,gain,phase_offset
-            float freq_khz = 0;
-            float gain = 1.0;
-            float phase = 0.0;
-
-            int fieldCount = sscanf(line.c_str(), "%f,%f,%f", &freq_khz, &gain, &phase);
-
-            if(fieldCount != 3) {
-                Serial.printf("Invalid PGA cal line in %s: %s\n", pgaFiles[pgaIdx], line.c_str());
-                continue;
-            }
-
-            // Store calibration point
-            pgaCalData[pgaIdx][numPGAFreqs[pgaIdx]] = FreqCalPoint(round(freq_khz*1000), gain, phase);
-            numPGAFreqs[pgaIdx]++;
-        }
-
-        file.close();
-        Serial.printf("Loaded PGA %d calibration for %d frequencies\n", pgaIdx, numPGAFreqs[pgaIdx]);
+        numPGAFreqs[pgaIdx] = count;
+        Console.printf("Loaded PGA %d calibration for %d frequencies\n", pgaIdx, numPGAFreqs[pgaIdx]);
 
         if(numPGAFreqs[pgaIdx] > 0) {
             anyLoaded = true;
         }
     }
 
-    LittleFS.end();
 
     return anyLoaded;
 }
 
 // Load all separate calibration files
 bool loadSeparateCalibrationFiles() {
-    Serial.println("\n=== Loading Separate Calibration Files ===");
+    Console.println("\n=== Loading Separate Calibration Files ===");
 
     bool voltageOK = loadVoltageCalibration();
     bool tiaOK = loadTIACalibration();
     bool pgaOK = loadPGACalibration();
 
     bool success = voltageOK && tiaOK && pgaOK;
+    buildCalibrationLUT();
 
     if(success) {
-        Serial.println("✓ All calibration files loaded successfully");
+        Console.println("✓ All calibration files loaded successfully");
     } else {
-        Serial.println("✗ Some calibration files failed to load");
+        Console.println("✗ Some calibration files failed to load");
     }
 
     return success;
@@ -921,53 +824,31 @@ bool loadSeparateCalibrationFiles() {
 // Load PS Trace calibration from /data/ps_trace.csv
 // CSV Format: freq_hz,mag_ratio,phase_offset
 bool loadPSTraceCalibration() {
-    // Initialize LittleFS
-    if(!LittleFS.begin(true)) {
-        Serial.println("Failed to mount LittleFS for PS Trace calibration");
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted for PS Trace calibration");
         return false;
     }
 
-    // Open PS Trace calibration file
-    File file = LittleFS.open("/ps_trace.csv", "r");
-    if(!file) {
-        Serial.println("Warning: Failed to open ps_trace.csv - PS Trace calibration not applied");
-        LittleFS.end();
+    // CSV line: freq_hz,mag_ratio,phase_offset (Hz, unlike the stage files)
+    int count = loadFreqCalFile(calibrationSetPath("/ps_trace.csv"), psTraceCalData, 1.0f, "ps_trace.csv");
+    if(count < 0) {
+        Console.println("Warning: Failed to open ps_trace.csv - PS Trace calibration not applied");
         return false;
     }
+    numPSTraceFreqs = count;
 
-    numPSTraceFreqs = 0;
-
-    // Read file line by line
-    while(file.available() && numPSTraceFreqs < MAX_CAL_FREQUENCIES) {
-        String line = file.readStringUntil('\n');
-        line.trim();
-
-        // Skip empty lines, comments, and header
-        if(line.length() == 0 || line.startsWith("#") || line.startsWith("freq")) {
-            continue;
-        }
-
-        // Parse CSV line: freq_hz,mag_ratio,phase_offset
-        float freq_hz = 0;
-        float mag_ratio = 1.0;
-        float phase_offset = 0.0;
-
-        int fieldCount = sscanf(line.c_str(), "%f,%f,%f", &freq_hz, &mag_ratio, &phase_offset);
-
-        if(fieldCount != 3) {
-            Serial.printf("Invalid PS Trace cal line: %s\n", line.c_str());
-            continue;
+    // Index by sweep frequency - unmatched frequencies stay at gain 1, offset 0
+    for(int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        psTraceByIndex[i] = SimpleCalPoint();
+    }
+    for(int i = 0; i < numPSTraceFreqs; i++) {
+        uint8_t idx = getSweepFrequencyIndex(psTraceCalData[i].frequency_hz);
+        if(idx != SWEEP_FREQ_INVALID) {
+            psTraceByIndex[idx] = psTraceCalData[i].calPoint;
         }
-
-        // Store calibration point (freq in Hz, mag_ratio as gain, phase_offset)
-        psTraceCalData[numPSTraceFreqs] = FreqCalPoint(round(freq_hz), mag_ratio, phase_offset);
-        numPSTraceFreqs++;
     }
 
-    file.close();
-    LittleFS.end();
-
-    Serial.printf("✓ Loaded PS Trace calibration for %d frequencies\n", numPSTraceFreqs);
+    Console.printf("✓ Loaded PS Trace calibration for %d frequencies\n", numPSTraceFreqs);
     return numPSTraceFreqs > 0;
 }
 
@@ -980,24 +861,12 @@ void applyPSTraceCalibration(ImpedancePoint& point) {
         return;
     }
 
-    // Find exact frequency match in PS Trace data
-    uint32_t target_freq = round(point.freq_hz);
-
-    for(int i = 0; i < numPSTraceFreqs; i++) {
-        if(psTraceCalData[i].frequency_hz == target_freq) {
-            // Found matching frequency - apply calibration
-            float mag_ratio = psTraceCalData[i].calPoint.gain;
-            float phase_offset = psTraceCalData[i].calPoint.phase_offset;
-
-            point.Z_magnitude *= mag_ratio;
-            point.Z_phase += phase_offset;
-
-            return; // Done
-        }
+    uint8_t idx = getSweepFrequencyIndex(point.freq_hz, point.freq_idx);
+    if(idx == SWEEP_FREQ_INVALID) {
+        return; // Not a sweep frequency - no PS Trace data
     }
 
-    // If we get here, no exact frequency match found
-    // Serial.printf("Warning: No PS Trace calibration found for %.1f Hz\n", point.freq_hz);
+    applyCalibrationFactor(point, psTraceByIndex[idx].gain, psTraceByIndex[idx].phase_offset);
 }
 
 // Get voltage calibration point for specific frequency
@@ -1029,40 +898,311 @@ SimpleCalPoint* getPGACalPoint(uint32_t freq, uint8_t pgaGain) {
     return &pgaCalData[pgaGain][idx].calPoint;
 }
 
-// Apply calibration using separate files
-// Formula: mag = (uncalibrated / v_gain) * tia_gain * pga_gain
-//          phase = uncalibrated_phase - v_phase + tia_phase + pga_phase
-bool calibrateWithSeparateFiles(ImpedancePoint& point) {
-    // Get calibration points
-    SimpleCalPoint* vCal = getVoltageCalPoint(point.freq_hz);
-    SimpleCalPoint* tiaCal = getTIACalPoint(point.freq_hz, point.tia_gain);
-    SimpleCalPoint* pgaCal = getPGACalPoint(point.freq_hz, point.pga_gain);
-
-    // Check if all calibration points are available
-    if(!vCal || !tiaCal || !pgaCal) {
-        Serial.printf("Missing calibration data for freq=%lu, TIA=%d, PGA=%d\n",
-                      point.freq_hz, point.tia_gain, point.pga_gain);
-        if(!vCal) Serial.println("  - Missing voltage calibration");
-        if(!tiaCal) Serial.println("  - Missing TIA calibration");
-        if(!pgaCal) Serial.println("  - Missing PGA calibration");
+/*=========================TABLE SWAP=========================*/
+
+static CalLUTRow* newCalibrationLUT() {
+    CalLUTRow* lut = (CalLUTRow*)malloc(CAL_LUT_TABLE_SIZE);
+    if(lut == nullptr) {
+        Console.printf("ERROR: No memory for calibration LUT (%d bytes)\n", (int)CAL_LUT_TABLE_SIZE);
+    }
+    return lut;
+}
+
+static void freeCalibrationLUT(const CalLUTRow* lut) {
+    if(lut != emptyCalibrationLUT && lut != getCalModelLUT() && (const CalLUTEntry*)lut != mappedImageLUT) {
+        free((void*)lut);
+    }
+}
+
+static void stageCalibrationLUT(const CalLUTRow* lut) {
+    const CalLUTRow* previous = stagedCalibrationLUT;
+    stagedCalibrationLUT = lut;
+    if(previous != nullptr && previous != lut) {
+        freeCalibrationLUT(previous);
+    }
+}
+
+// Only called with nothing pending (reloadCalibration() checks first)
+static void publishCalibrationLUT() {
+    pendingCalibrationLUT = stagedCalibrationLUT;
+    stagedCalibrationLUT = nullptr;
+}
+
+bool applyPendingCalibrationLUT() {
+    const CalLUTRow* lut = pendingCalibrationLUT;
+    if(lut == nullptr) {
         return false;
     }
 
-    // Apply calibration formulas
-    // Magnitude: mag = (uncalibrated / v_gain) * tia_gain * pga_gain
-    point.Z_magnitude = (point.Z_magnitude / vCal->gain) * tiaCal->gain * pgaCal->gain;
+    const CalLUTRow* previous = calibrationLUT;
+    setActiveCalibrationLUT(lut);
+    pendingCalibrationLUT = nullptr;
+    if(previous != lut) {
+        freeCalibrationLUT(previous);
+    }
+    Console.println("Calibration LUT switched");
+    return true;
+}
+
+bool isCalibrationReloadPending() {
+    return pendingCalibrationLUT != nullptr;
+}
 
-    // Phase: phase = uncalibrated_phase - v_phase + tia_phase + pga_phase
-    point.Z_phase = point.Z_phase - vCal->phase_offset + tiaCal->phase_offset + pgaCal->phase_offset;
+bool installCalibrationRows(const CalLUTRow* rows, SweepMask mask) {
+    CalLUTRow* lut = newCalibrationLUT();
+    if(lut == nullptr) {
+        return false;
+    }
+    memset(lut, 0, CAL_LUT_TABLE_SIZE);
+    int n = 0;
+    for(uint8_t idx = 0; idx < SWEEP_FREQ_COUNT; idx++) {
+        if(mask & ((SweepMask)1 << idx)) {
+            memcpy(lut[idx], rows[n++], sizeof(CalLUTRow));
+        }
+    }
+    stageCalibrationLUT(lut);
+    publishCalibrationLUT();
+    applyPendingCalibrationLUT();
+    return true;
+}
 
-    // Wrap phase to [-180, 180]
-    while(point.Z_phase > 180.0f) point.Z_phase -= 360.0f;
-    while(point.Z_phase < -180.0f) point.Z_phase += 360.0f;
-    Serial.printf("Separate file cal: Freq=%lu, TIA=%d, PGA=%d\n",
-                  point.freq_hz, point.tia_gain, point.pga_gain);
-    Serial.printf("  V: gain=%.3f, phase=%.3f\n", vCal->gain, vCal->phase_offset);
-    Serial.printf("  TIA: gain=%.3f, phase=%.3f\n", tiaCal->gain, tiaCal->phase_offset);
-    Serial.printf("  PGA: gain=%.3f, phase=%.3f\n", pgaCal->gain, pgaCal->phase_offset);
+bool reloadCalibration() {
+    if(getCalibrationMode() != CALIBRATION_MODE_SEPARATE_FILES) {
+        Console.println("Calibration reload needs separate-files mode");
+        return false;
+    }
+    if(pendingCalibrationLUT != nullptr) {
+        Console.println("Calibration reload already pending");
+        return false;
+    }
 
+    // Rebuild from the image or CSVs - the cache would just return the old table
+    if(!stageSeparateFilesLUT(false) || stagedCalibrationLUT == nullptr) {
+        Console.println("✗ Calibration reload failed - keeping current table");
+        stageCalibrationLUT(nullptr);
+        return false;
+    }
+    publishCalibrationLUT();
+    Console.println("✓ Calibration staged - active from the next sweep");
     return true;
-}
\ No newline at end of file
+}
+
+bool releaseCalibrationImage() {
+    const CalLUTEntry* image = mappedImageLUT;
+    if(image == nullptr) {
+        return true;
+    }
+
+    const CalLUTRow* pending = pendingCalibrationLUT;
+    bool active = (const CalLUTEntry*)calibrationLUT == image;
+    if(!active && (const CalLUTEntry*)pending != image) {
+        mappedImageLUT = nullptr;
+        unmapCalibrationImage();
+        return true;
+    }
+    if(pending != nullptr) {
+        return false;       // Wait for the data processor to take it
+    }
+
+    // Keep calibrating from a RAM copy while the partition is rewritten
+    CalLUTRow* copy = newCalibrationLUT();
+    if(copy == nullptr) {
+        return false;
+    }
+    memcpy(copy, image, CAL_LUT_TABLE_SIZE);
+    stageCalibrationLUT(copy);
+    publishCalibrationLUT();
+    return false;
+}
+
+static void setActiveCalibrationLUT(const CalLUTRow* lut) {
+    setCalibrationApplyTable(lut);
+    buildFixedCalibrationLUT(lut);
+
+    int partial = 0;
+    for(int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        uint16_t covered = 0;
+        for(int tia = 0; tia < 2; tia++) {
+            for(int pga = 0; pga < 8; pga++) {
+                covered |= lut[f][tia][pga].valid ? (uint16_t)1 << (tia * 8 + pga) : 0;
+            }
+        }
+        calCoverage[f] = covered;
+        partial += covered != CAL_COVERAGE_ALL ? 1 : 0;
+    }
+    if(partial > 0) {
+        Console.printf("Calibration covers every gain at %d of %d indices - the rest are limited at START\n",
+                       SWEEP_FREQ_COUNT - partial, SWEEP_FREQ_COUNT);
+    }
+}
+
+uint16_t getCalibrationCoverage(uint8_t freqIdx) {
+    if(getCalibrationMode() != CALIBRATION_MODE_SEPARATE_FILES || freqIdx >= SWEEP_FREQ_COUNT) {
+        return CAL_COVERAGE_ALL;
+    }
+    return calCoverage[freqIdx];
+}
+
+void printCalibrationCoverage(SweepMask plan) {
+    int shown = 0;
+    for(uint8_t f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        uint16_t covered = getCalibrationCoverage(f);
+        if(!(plan & ((SweepMask)1 << f)) || covered == CAL_COVERAGE_ALL) {
+            continue;
+        }
+        // One character per PGA 0-7: '#' calibrated, '.' missing
+        char low[9];
+        char high[9];
+        for(int pga = 0; pga < 8; pga++) {
+            low[pga] = covered & ((uint16_t)1 << pga) ? '#' : '.';
+            high[pga] = covered & ((uint16_t)1 << (8 + pga)) ? '#' : '.';
+        }
+        low[8] = high[8] = '\0';
+        Console.printf("  [%2d] %7lu Hz  TIA low %s  high %s%s\n", f, sweepFrequencies[f], low, high,
+                       covered == 0 ? "  (none - measured unlimited)" : "");
+        shown++;
+    }
+    if(shown == 0) {
+        Console.println("Calibration covers every gain combination of the plan");
+    }
+}
+
+
+// Fuse voltage, TIA, PGA and PS Trace calibration per (freq index, TIA, PGA)
+// With CAL_MODEL_PRIOR a missing stage entry is taken from the front-end model
+int buildCalibrationLUT() {
+    int validCount = 0;
+    int modelCount = 0;
+
+    CalLUTRow* lut = newCalibrationLUT();
+    if(lut == nullptr) {
+        return 0;
+    }
+
+    for(int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        uint32_t freq = sweepFrequencies[f];
+        SimpleCalPoint* vCal = getVoltageCalPoint(freq);
+        const SimpleCalPoint& psCal = psTraceByIndex[f];
+#if CAL_MODEL_PRIOR
+        SimpleCalPoint vModel(calModel.voltage[f].gain, calModel.voltage[f].phase_offset);
+        bool vFromModel = vCal == nullptr;
+        if(vFromModel) vCal = &vModel;
+#endif
+
+        for(int tia = 0; tia < 2; tia++) {
+            SimpleCalPoint* tiaCal = getTIACalPoint(freq, tia);
+#if CAL_MODEL_PRIOR
+            SimpleCalPoint tiaModel(calModel.tia[tia].gain, calModel.tia[tia].phase_offset);
+            bool tiaFromModel = tiaCal == nullptr;
+            if(tiaFromModel) tiaCal = &tiaModel;
+#endif
+
+            for(int pga = 0; pga < 8; pga++) {
+                SimpleCalPoint* pgaCal = getPGACalPoint(freq, pga);
+#if CAL_MODEL_PRIOR
+                SimpleCalPoint pgaModel(calModel.pga[f][pga].gain, calModel.pga[f][pga].phase_offset);
+                bool pgaFromModel = pgaCal == nullptr;
+                if(pgaFromModel) pgaCal = &pgaModel;
+                modelCount += (vFromModel || tiaFromModel || pgaFromModel) ? 1 : 0;
+#endif
+                CalLUTEntry& entry = lut[f][tia][pga];
+
+                entry.valid = (vCal && tiaCal && pgaCal && vCal->gain != 0.0f);
+                if(!entry.valid) {
+                    entry.gain = 1.0f;
+                    entry.phase_offset = 0.0f;
+                    continue;
+                }
+
+                entry.gain = tiaCal->gain * pgaCal->gain / vCal->gain * psCal.gain;
+                entry.phase_offset = -vCal->phase_offset + tiaCal->phase_offset + pgaCal->phase_offset
+                                     + psCal.phase_offset;
+                validCount++;
+            }
+        }
+    }
+
+    stageCalibrationLUT(lut);
+    Console.printf("Calibration LUT built: %d/%d entries valid (%d from the front-end model)\n",
+                   validCount, SWEEP_FREQ_COUNT * 2 * 8, modelCount);
+    return validCount;
+}
+
+// CRC covers the sweep table too - a firmware with a different table rejects the cache
+static uint16_t calibrationLUTCRC(const CalLUTRow* lut) {
+    uint16_t crc = crc16_ccitt((const uint8_t*)sweepFrequencies, sizeof(sweepFrequencies));
+    return crc16_ccitt((const uint8_t*)lut, CAL_LUT_TABLE_SIZE, crc);
+}
+
+bool saveCalibrationLUT() {
+    const CalLUTRow* lut = stagedCalibrationLUT ? stagedCalibrationLUT : calibrationLUT;
+    if(lut == emptyCalibrationLUT) {
+        return false;
+    }
+
+    File file = LittleFS.open(calibrationSetPath(CAL_LUT_FILE), "w");
+    if(!file) {
+        Console.println("Failed to create " CAL_LUT_FILE);
+        return false;
+    }
+
+    CalLUTFileHeader header;
+    header.magic = CAL_LUT_MAGIC;
+    header.version = CAL_LUT_VERSION;
+    header.entrySize = sizeof(CalLUTEntry);
+    header.entryCount = SWEEP_FREQ_COUNT * 2 * 8;
+    header.crc = calibrationLUTCRC(lut);
+
+    bool ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t*)lut, CAL_LUT_TABLE_SIZE) == CAL_LUT_TABLE_SIZE;
+    file.close();
+
+    if(!ok) {
+        Console.println("Failed to write " CAL_LUT_FILE);
+        LittleFS.remove(calibrationSetPath(CAL_LUT_FILE));
+        return false;
+    }
+    Console.printf("Saved fused calibration LUT (%d bytes)\n", (int)(sizeof(header) + CAL_LUT_TABLE_SIZE));
+    return true;
+}
+
+bool loadCalibrationLUT() {
+    if(!LittleFS.exists(calibrationSetPath(CAL_LUT_FILE))) {
+        return false;
+    }
+
+    File file = LittleFS.open(calibrationSetPath(CAL_LUT_FILE), "r");
+    if(!file) {
+        return false;
+    }
+
+    CalLUTRow* lut = newCalibrationLUT();
+    if(lut == nullptr) {
+        file.close();
+        return false;
+    }
+
+    CalLUTFileHeader header;
+    bool ok = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == CAL_LUT_MAGIC &&
+              header.version == CAL_LUT_VERSION &&
+              header.entrySize == sizeof(CalLUTEntry) &&
+              header.entryCount == SWEEP_FREQ_COUNT * 2 * 8 &&
+              file.read((uint8_t*)lut, CAL_LUT_TABLE_SIZE) == CAL_LUT_TABLE_SIZE;
+    file.close();
+
+    if(ok && header.crc != calibrationLUTCRC(lut)) {
+        Console.println("Warning: " CAL_LUT_FILE " CRC mismatch - rebuilding from CSV");
+        ok = false;
+    }
+    if(!ok) {
+        // Leave no half-loaded table behind
+        free(lut);
+        return false;
+    }
+
+    stageCalibrationLUT(lut);
+
+    Console.println("✓ Loaded fused calibration LUT from " CAL_LUT_FILE);
+    return true;
+}
@@ -0,0 +1,281 @@
+#include "circuit_fit.h"
+#include "defines.h"
+#include "sweep_table.h"
+#include <math.h>
+
+// Parameter vector of the solver - Q is fitted as ln(Q), which spans decades
+#define FIT_PARAMS      4
+#define P_RS            0
+#define P_RCT           1
+#define P_LNQ           2
+#define P_N             3
+
+#define LM_LAMBDA_START 1e-3f
+#define LM_LAMBDA_UP    10.0f
+#define LM_LAMBDA_DOWN  0.3f
+#define LM_LAMBDA_MAX   1e7f
+
+// Spectrum in the solver's form - measured Z as re/im, weighted by 1/|Z|
+struct FitData {
+    float lnOmega[MAX_FREQUENCIES];
+    float re[MAX_FREQUENCIES];
+    float im[MAX_FREQUENCIES];
+    float weight[MAX_FREQUENCIES];
+    int count;
+};
+
+/*=========================MODEL=========================*/
+// Z and its derivatives d/d(rs, rct, lnQ, n) at one point
+// A = Rct*Q*w^n * e^(j*n*pi/2), Z = Rs + Rct/(1+A)
+//   dZ/dRs = 1, dZ/dRct = 1/(1+A)^2, dZ/dlnQ = -Rct*A/(1+A)^2,
+//   dZ/dn = dZ/dlnQ * (ln w + j*pi/2)
+static void evalModel(const float* x, float lnOmega, float& zRe, float& zIm,
+                      float* dRe, float* dIm) {
+    float aMag = x[P_RCT] * expf(x[P_LNQ] + x[P_N] * lnOmega);
+    float angle = x[P_N] * (float)(M_PI / 2.0);
+    float aRe = aMag * cosf(angle);
+    float aIm = aMag * sinf(angle);
+
+    // 1/(1+A)
+    float dRe0 = 1.0f + aRe;
+    float den = dRe0 * dRe0 + aIm * aIm;
+    float invRe = dRe0 / den;
+    float invIm = -aIm / den;
+
+    zRe = x[P_RS] + x[P_RCT] * invRe;
+    zIm = x[P_RCT] * invIm;
+    if (dRe == nullptr) {
+        return;
+    }
+
+    // 1/(1+A)^2
+    float inv2Re = invRe * invRe - invIm * invIm;
+    float inv2Im = 2.0f * invRe * invIm;
+    // -Rct*A/(1+A)^2
+    float qRe = -x[P_RCT] * (aRe * inv2Re - aIm * inv2Im);
+    float qIm = -x[P_RCT] * (aRe * inv2Im + aIm * inv2Re);
+    const float halfPi = (float)(M_PI / 2.0);
+
+    dRe[P_RS] = 1.0f;
+    dIm[P_RS] = 0.0f;
+    dRe[P_RCT] = inv2Re;
+    dIm[P_RCT] = inv2Im;
+    dRe[P_LNQ] = qRe;
+    dIm[P_LNQ] = qIm;
+    dRe[P_N] = qRe * lnOmega - qIm * halfPi;
+    dIm[P_N] = qRe * halfPi + qIm * lnOmega;
+}
+
+// Sum of squared relative residuals
+static float fitCost(const FitData& data, const float* x) {
+    float cost = 0.0f;
+    for (int i = 0; i < data.count; i++) {
+        float zRe, zIm;
+        evalModel(x, data.lnOmega[i], zRe, zIm, nullptr, nullptr);
+        float rRe = (zRe - data.re[i]) * data.weight[i];
+        float rIm = (zIm - data.im[i]) * data.weight[i];
+        cost += rRe * rRe + rIm * rIm;
+    }
+    return cost;
+}
+
+// Keep the parameters physical
+static void clampParams(float* x) {
+    if (x[P_RS] < 0.0f) x[P_RS] = 0.0f;
+    if (x[P_RCT] < 1e-3f) x[P_RCT] = 1e-3f;
+    if (x[P_N] < CIRCUIT_FIT_N_MIN) x[P_N] = CIRCUIT_FIT_N_MIN;
+    if (x[P_N] > CIRCUIT_FIT_N_MAX) x[P_N] = CIRCUIT_FIT_N_MAX;
+}
+
+/*=========================START VALUES=========================*/
+// Rs from the highest frequency, Rct from the lowest, Q from the frequency
+// of the largest -Im(Z) (the arc's top, where |A| = 1)
+static void estimateParams(const FitData& data, float* x) {
+    int lo = 0, hi = 0, peak = 0;
+    for (int i = 1; i < data.count; i++) {
+        if (data.lnOmega[i] < data.lnOmega[lo]) lo = i;
+        if (data.lnOmega[i] > data.lnOmega[hi]) hi = i;
+        if (data.im[i] < data.im[peak]) peak = i;
+    }
+    float rs = data.re[hi] > 0.0f ? data.re[hi] : 0.0f;
+    float rct = data.re[lo] - rs;
+    if (rct < 0.1f * data.re[lo]) rct = 0.1f * data.re[lo];
+    x[P_RS] = rs;
+    x[P_RCT] = rct;
+    x[P_N] = 0.9f;
+    clampParams(x);
+    x[P_LNQ] = -logf(x[P_RCT]) - x[P_N] * data.lnOmega[peak];
+}
+
+static void toParams(const float* x, CircuitParams& params) {
+    params.rs = x[P_RS];
+    params.rct = x[P_RCT];
+    params.q = expf(x[P_LNQ]);
+    params.n = x[P_N];
+}
+
+/*=========================SOLVER=========================*/
+// Solve a * delta = b (FIT_PARAMS square) by elimination with partial pivoting
+static bool solveNormal(float a[FIT_PARAMS][FIT_PARAMS], float* b, float* delta) {
+    for (int col = 0; col < FIT_PARAMS; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < FIT_PARAMS; row++) {
+            if (fabsf(a[row][col]) > fabsf(a[pivot][col])) pivot = row;
+        }
+        if (fabsf(a[pivot][col]) < 1e-30f) {
+            return false;
+        }
+        if (pivot != col) {
+            for (int k = 0; k < FIT_PARAMS; k++) {
+                float t = a[col][k]; a[col][k] = a[pivot][k]; a[pivot][k] = t;
+            }
+            float t = b[col]; b[col] = b[pivot]; b[pivot] = t;
+        }
+        for (int row = col + 1; row < FIT_PARAMS; row++) {
+            float f = a[row][col] / a[col][col];
+            for (int k = col; k < FIT_PARAMS; k++) {
+                a[row][k] -= f * a[col][k];
+            }
+            b[row] -= f * b[col];
+        }
+    }
+    for (int row = FIT_PARAMS - 1; row >= 0; row--) {
+        float sum = b[row];
+        for (int k = row + 1; k < FIT_PARAMS; k++) {
+            sum -= a[row][k] * delta[k];
+        }
+        delta[row] = sum / a[row][row];
+    }
+    return true;
+}
+
+bool fitCircuit(const uint32_t* freqHz, const float* mag, const float* phaseDeg, int count,
+                const CircuitFit* start, CircuitFit& out) {
+    out = CircuitFit();
+    FitData data;
+    data.count = 0;
+    for (int i = 0; i < count && data.count < MAX_FREQUENCIES; i++) {
+        if (freqHz[i] == 0 || !(mag[i] > 0.0f)) {
+            continue;
+        }
+        float phaseRad = phaseDeg[i] * (float)(M_PI / 180.0);
+        uint8_t idx = getSweepFrequencyIndex(freqHz[i], i);
+        data.lnOmega[data.count] = idx != SWEEP_FREQ_INVALID ? getSweepFreqInfo(idx).lnOmega
+                                                             : logf(2.0f * (float)M_PI * freqHz[i]);
+        data.re[data.count] = mag[i] * cosf(phaseRad);
+        data.im[data.count] = mag[i] * sinf(phaseRad);
+        data.weight[data.count] = 1.0f / mag[i];
+        data.count++;
+    }
+    out.points = data.count;
+    if (data.count < CIRCUIT_FIT_MIN_POINTS) {
+        return false;
+    }
+
+    // Seed with the better of the spectrum's estimate and the given fit
+    float x[FIT_PARAMS];
+    estimateParams(data, x);
+    float cost = fitCost(data, x);
+    int evaluations = 1;
+    if (start != nullptr && start->valid) {
+        float warm[FIT_PARAMS] = {start->params.rs, start->params.rct,
+                                  logf(start->params.q), start->params.n};
+        clampParams(warm);
+        float warmCost = fitCost(data, warm);
+        evaluations++;
+        if (warmCost < cost) {
+            memcpy(x, warm, sizeof(x));
+            cost = warmCost;
+        }
+    }
+
+    float lambda = LM_LAMBDA_START;
+    bool rebuild = true;
+    float jtj[FIT_PARAMS][FIT_PARAMS];
+    float jtr[FIT_PARAMS];
+    while (evaluations < CIRCUIT_FIT_MAX_ITER && lambda < LM_LAMBDA_MAX) {
+        // Normal equations at x - only after an accepted step
+        if (rebuild) {
+            memset(jtj, 0, sizeof(jtj));
+            memset(jtr, 0, sizeof(jtr));
+            for (int i = 0; i < data.count; i++) {
+                float zRe, zIm, dRe[FIT_PARAMS], dIm[FIT_PARAMS];
+                evalModel(x, data.lnOmega[i], zRe, zIm, dRe, dIm);
+                float w = data.weight[i];
+                float rRe = (zRe - data.re[i]) * w;
+                float rIm = (zIm - data.im[i]) * w;
+                for (int j = 0; j < FIT_PARAMS; j++) {
+                    float jRe = dRe[j] * w;
+                    float jIm = dIm[j] * w;
+                    jtr[j] += jRe * rRe + jIm * rIm;
+                    for (int k = 0; k <= j; k++) {
+                        jtj[j][k] += jRe * dRe[k] * w + jIm * dIm[k] * w;
+                    }
+                }
+            }
+            for (int j = 0; j < FIT_PARAMS; j++) {
+                for (int k = j + 1; k < FIT_PARAMS; k++) {
+                    jtj[j][k] = jtj[k][j];
+                }
+            }
+            rebuild = false;
+        }
+
+        // Damped step: (JtJ + lambda*diag(JtJ)) delta = -Jt r
+        float a[FIT_PARAMS][FIT_PARAMS];
+        float b[FIT_PARAMS];
+        float delta[FIT_PARAMS];
+        memcpy(a, jtj, sizeof(a));
+        for (int j = 0; j < FIT_PARAMS; j++) {
+            a[j][j] += lambda * (jtj[j][j] > 0.0f ? jtj[j][j] : 1.0f);
+            b[j] = -jtr[j];
+        }
+        if (!solveNormal(a, b, delta)) {
+            lambda *= LM_LAMBDA_UP;
+            continue;
+        }
+
+        float trial[FIT_PARAMS];
+        for (int j = 0; j < FIT_PARAMS; j++) {
+            trial[j] = x[j] + delta[j];
+        }
+        clampParams(trial);
+        float trialCost = fitCost(data, trial);
+        evaluations++;
+        if (!(trialCost < cost)) {
+            // At float precision every step is rejected - no worse than the tolerance is a minimum
+            if (fabsf(trialCost - cost) <= CIRCUIT_FIT_TOLERANCE * cost) {
+                out.converged = true;
+                break;
+            }
+            lambda *= LM_LAMBDA_UP;
+            continue;
+        }
+
+        float gain = cost - trialCost;
+        memcpy(x, trial, sizeof(x));
+        cost = trialCost;
+        lambda *= LM_LAMBDA_DOWN;
+        rebuild = true;
+        if (gain <= CIRCUIT_FIT_TOLERANCE * cost || cost < 1e-12f) {
+            out.converged = true;
+            break;
+        }
+    }
+    // Damped to nothing without a lower cost: no step improves on x
+    if (lambda >= LM_LAMBDA_MAX) {
+        out.converged = true;
+    }
+
+    toParams(x, out.params);
+    out.rmsError = sqrtf(cost / data.count);
+    out.iterations = evaluations;
+    out.valid = isfinite(out.params.rs) && isfinite(out.params.rct) && isfinite(out.params.q) &&
+                out.params.q > 0.0f && isfinite(out.rmsError);
+    return out.valid;
+}
+
+void circuitImpedance(const CircuitParams& params, uint32_t freqHz, float& re, float& im) {
+    float x[FIT_PARAMS] = {params.rs, params.rct, logf(params.q), params.n};
+    evalModel(x, logf(2.0f * (float)M_PI * freqHz), re, im, nullptr, nullptr);
+}
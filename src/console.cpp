@@ -0,0 +1,175 @@
+#include "console.h"
+#include "task_monitor.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+ConsoleOut Console;
+
+// Records back to back: [uint16_t length][bytes], wrapping at the end
+static uint8_t ring[CONSOLE_TX_RING_BYTES];
+static size_t ringHead = 0;         // Next byte written
+static size_t ringTail = 0;         // Oldest record
+static size_t ringUsed = 0;
+static size_t ringPeak = 0;
+static uint32_t droppedRecords = 0;
+static uint32_t droppedBytes = 0;
+static portMUX_TYPE ringLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Set once the Console TX task runs - writes go straight to Serial before
+static TaskHandle_t drainTask = nullptr;
+
+// consoleWriteWait() timed out - drop instead of waiting until the host reads again
+static bool waitStalled = false;
+
+/*=========================RING=========================*/
+// All under ringLock
+
+static void ringPut(const uint8_t* data, size_t len) {
+    size_t first = min(len, (size_t)CONSOLE_TX_RING_BYTES - ringHead);
+    memcpy(&ring[ringHead], data, first);
+    memcpy(ring, data + first, len - first);
+    ringHead = (ringHead + len) % CONSOLE_TX_RING_BYTES;
+    ringUsed += len;
+}
+
+static void ringGet(uint8_t* data, size_t len) {
+    size_t first = min(len, (size_t)CONSOLE_TX_RING_BYTES - ringTail);
+    memcpy(data, &ring[ringTail], first);
+    memcpy(data + first, ring, len - first);
+    ringTail = (ringTail + len) % CONSOLE_TX_RING_BYTES;
+    ringUsed -= len;
+}
+
+static void dropOldest() {
+    uint16_t len;
+    ringGet((uint8_t*)&len, sizeof(len));
+    ringTail = (ringTail + len) % CONSOLE_TX_RING_BYTES;
+    ringUsed -= len;
+    droppedRecords++;
+    droppedBytes += len;
+}
+
+// Queue one record of at most CONSOLE_RECORD_MAX bytes. Without room it
+// drops the oldest records if dropOld, otherwise returns false
+static bool queueRecord(const uint8_t* data, uint16_t len, bool dropOld) {
+    size_t need = sizeof(len) + len;
+    portENTER_CRITICAL(&ringLock);
+    bool room = CONSOLE_TX_RING_BYTES - ringUsed >= need;
+    if (!room && dropOld) {
+        while (CONSOLE_TX_RING_BYTES - ringUsed < need) {
+            dropOldest();
+        }
+        room = true;
+    }
+    if (room) {
+        ringPut((const uint8_t*)&len, sizeof(len));
+        ringPut(data, len);
+        ringPeak = max(ringPeak, ringUsed);
+    }
+    portEXIT_CRITICAL(&ringLock);
+    if (room) {
+        xTaskNotifyGive(drainTask);
+    }
+    return room;
+}
+
+// Oldest record into out (CONSOLE_RECORD_MAX bytes); 0 if the ring is empty
+static size_t popRecord(uint8_t* out) {
+    uint16_t len = 0;
+    portENTER_CRITICAL(&ringLock);
+    if (ringUsed > 0) {
+        ringGet((uint8_t*)&len, sizeof(len));
+        ringGet(out, len);
+    }
+    portEXIT_CRITICAL(&ringLock);
+    return len;
+}
+
+static bool draining() {
+    return __atomic_load_n(&drainTask, __ATOMIC_ACQUIRE) != nullptr;
+}
+
+/*=========================WRITERS=========================*/
+
+size_t ConsoleOut::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t ConsoleOut::write(const uint8_t* data, size_t len) {
+    if (!draining()) {
+        return Serial.write(data, len);
+    }
+    for (size_t done = 0; done < len; ) {
+        uint16_t n = min(len - done, (size_t)CONSOLE_RECORD_MAX);
+        queueRecord(data + done, n, true);
+        done += n;
+    }
+    return len;
+}
+
+size_t consoleWriteWait(const uint8_t* data, size_t len) {
+    if (!draining()) {
+        return Serial.write(data, len);
+    }
+    for (size_t done = 0; done < len; ) {
+        uint16_t n = min(len - done, (size_t)CONSOLE_RECORD_MAX);
+        uint32_t start = millis();
+        while (!queueRecord(data + done, n, false)) {
+            // No host, or one that stopped reading - keep the caller going
+            if (waitStalled || !Serial || millis() - start >= CONSOLE_WAIT_MAX_MS) {
+                waitStalled = true;
+                queueRecord(data + done, n, true);
+                break;
+            }
+            vTaskDelay(1);
+        }
+        if (millis() - start < CONSOLE_WAIT_MAX_MS) {
+            waitStalled = false;
+        }
+        done += n;
+    }
+    return len;
+}
+
+void flushConsole() {
+    // Restarts only - the drain task may be writing its own record meanwhile
+    static uint8_t record[CONSOLE_RECORD_MAX];
+    size_t len;
+    while (Serial && (len = popRecord(record)) > 0) {
+        Serial.write(record, len);
+    }
+    Serial.flush();
+}
+
+void printConsoleStats() {
+    portENTER_CRITICAL(&ringLock);
+    size_t used = ringUsed;
+    size_t peak = ringPeak;
+    uint32_t records = droppedRecords;
+    uint32_t bytes = droppedBytes;
+    portEXIT_CRITICAL(&ringLock);
+    Console.printf("Console TX: %u of %u bytes queued (peak %u), %lu writes / %lu bytes dropped\n",
+                   (unsigned)used, (unsigned)CONSOLE_TX_RING_BYTES, (unsigned)peak, records, bytes);
+}
+
+/*=========================TASK=========================*/
+
+void taskConsoleTx(void* parameter) {
+    static uint8_t record[CONSOLE_RECORD_MAX];
+    __atomic_store_n(&drainTask, xTaskGetCurrentTaskHandle(), __ATOMIC_RELEASE);
+    while (true) {
+        taskWatchdogFeed();
+        // Keep the latest output until a host opens the port
+        if (!Serial) {
+            vTaskDelay(pdMS_TO_TICKS(CONSOLE_HOST_POLL_MS));
+            continue;
+        }
+        size_t len = popRecord(record);
+        if (len == 0) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONSOLE_IDLE_WAIT_MS));
+            continue;
+        }
+        Serial.write(record, len);
+    }
+}
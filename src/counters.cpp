@@ -0,0 +1,99 @@
+#include "counters.h"
+#include "console.h"
+
+const uint32_t COUNTER_BOUNDS_US[10] = {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000};
+const uint32_t COUNTER_BOUNDS_BYTES[8] = {1, 8, 32, 64, 128, 256, 1024, 2048};
+
+// Constant-initialized, so constructors in any translation unit may append
+static FieldMetric* head = nullptr;
+static FieldMetric* tail = nullptr;
+
+static void registerMetric(FieldMetric* metric) {
+    metric->next = nullptr;
+    if (tail == nullptr) {
+        head = metric;
+    } else {
+        tail->next = metric;
+    }
+    tail = metric;
+}
+
+FieldCounter::FieldCounter(const char* name) {
+    this->name = name;
+    kind = COUNTER_KIND_COUNTER;
+    registerMetric(this);
+}
+
+FieldHistogram::FieldHistogram(const char* name, const uint32_t* bounds, uint8_t count)
+    : bounds(bounds), boundsCount(count) {
+    this->name = name;
+    kind = COUNTER_KIND_HISTOGRAM;
+    registerMetric(this);
+}
+
+void FieldHistogram::record(uint32_t value) {
+    uint8_t i = 0;
+    while (i < boundsCount && value > bounds[i]) {
+        i++;
+    }
+    buckets[i].fetch_add(1, std::memory_order_relaxed);
+    samples.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(value, std::memory_order_relaxed);
+    latest.store(value, std::memory_order_relaxed);
+    uint32_t seen = peak.load(std::memory_order_relaxed);
+    while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+void FieldHistogram::reset() {
+    for (uint8_t i = 0; i <= boundsCount; i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    samples.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    peak.store(0, std::memory_order_relaxed);
+    latest.store(0, std::memory_order_relaxed);
+}
+
+const FieldMetric* firstFieldMetric() {
+    return head;
+}
+
+const FieldMetric* findFieldMetric(const char* name) {
+    for (const FieldMetric* m = head; m != nullptr; m = m->next) {
+        if (strcmp(m->name, name) == 0) {
+            return m;
+        }
+    }
+    return nullptr;
+}
+
+void resetFieldCounters() {
+    for (FieldMetric* m = head; m != nullptr; m = m->next) {
+        if (m->kind == COUNTER_KIND_COUNTER) {
+            static_cast<FieldCounter*>(m)->reset();
+        } else {
+            static_cast<FieldHistogram*>(m)->reset();
+        }
+    }
+}
+
+void printFieldCounters() {
+    Console.printf("=== Counters (uptime %lu s) ===\n", millis() / 1000);
+    for (const FieldMetric* m = head; m != nullptr; m = m->next) {
+        if (m->kind == COUNTER_KIND_COUNTER) {
+            Console.printf("  %-24s %lu\n", m->name, (unsigned long)static_cast<const FieldCounter*>(m)->get());
+            continue;
+        }
+        const FieldHistogram& h = *static_cast<const FieldHistogram*>(m);
+        uint32_t n = h.count();
+        Console.printf("  %-24s n=%lu mean=%lu max=%lu\n", m->name, (unsigned long)n,
+                       (unsigned long)(n ? h.sum() / n : 0), (unsigned long)h.maximum());
+        Console.print("   ");
+        for (uint8_t i = 0; i < h.boundCount(); i++) {
+            Console.printf(" <=%lu:%lu", (unsigned long)h.bound(i), (unsigned long)h.bucket(i));
+        }
+        Console.printf(" >%lu:%lu\n", (unsigned long)h.bound(h.boundCount() - 1),
+                       (unsigned long)h.bucket(h.boundCount()));
+    }
+}
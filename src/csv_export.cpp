@@ -1,25 +1,182 @@
 #include "csv_export.h"
+#include "console.h"
 #include "defines.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "fixed_format.h"
+#include <stdarg.h>
+#include <string.h>
 
-void printCSVToSerial() {
-    Serial.println("\n\n========== IMPEDANCE DATA CSV ==========");
-    Serial.println("DUT,Frequency_Hz,Magnitude_Ohms,Phase_Deg,PGA Gain, TIA Gain");
-
-    for (uint8_t dut = 0; dut < MAX_DUT_COUNT; dut++) {
-        for (int freqIdx = 0; freqIdx < frequencyCount[dut]; freqIdx++) {
-            ImpedancePoint* point = &baselineImpedanceData[dut][freqIdx];
-
-            if (point->valid) {
-                Serial.printf("%d,%lu,%.6f,%.2f,%d,%d\n",
-                             dut + 1,  // DUT numbering 1-4
-                             point->freq_hz,
-                             point->Z_magnitude,
-                             point->Z_phase,
-                             point->pga_gain,
-                             point->tia_gain);
+// Longest line with every column - flushed before a line could overflow
+#define CSV_LINE_MAX    144
+
+struct CsvColumnName {
+    const char* name;       // parseCSVColumns() name
+    uint16_t bit;
+    const char* header;
+};
+
+static const CsvColumnName csvColumns[] = {
+    {"freq",   CSV_COL_FREQ,   ",Frequency_Hz"},
+    {"mag",    CSV_COL_MAG,    ",Magnitude_Ohms"},
+    {"phase",  CSV_COL_PHASE,  ",Phase_Deg"},
+    {"gain",   CSV_COL_GAIN,   ",PGA Gain, TIA Gain"},
+    {"sweep",  CSV_COL_SWEEP,  ",Sweep"},
+    {"valid",  CSV_COL_VALID,  ",Valid"},
+    {"spread", CSV_COL_SPREAD, ",Mag_SD_Pct,Phase_SD_Deg"},
+    {"risk",   CSV_COL_RISK,   ",Risk,Risk_Pct"},
+};
+
+static const char* const riskNames[] = {"None", "Low", "Medium", "High", "Error"};
+
+/*=========================OUTPUT BUFFER=========================*/
+// Lines are collected on the caller's stack and written in large blocks
+struct CsvBuffer {
+    char data[CSV_EXPORT_CHUNK];
+    size_t len;
+};
+
+static void flush(CsvBuffer& out) {
+    if (out.len > 0) {
+        consoleWriteWait((const uint8_t*)out.data, out.len);
+        out.len = 0;
+    }
+}
+
+static void append(CsvBuffer& out, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(out.data + out.len, sizeof(out.data) - out.len, format, args);
+    va_end(args);
+    if (n > 0) {
+        out.len = min(out.len + n, sizeof(out.data) - 1);
+    }
+}
+
+// ",<value>" with fixed decimals (fixed_format.h) - printf only for "nan" / huge values
+static void appendFixed(CsvBuffer& out, float value, uint8_t decimals) {
+    char text[FIXED_FORMAT_BUFFER];
+    size_t n = formatFixed(text, sizeof(text), value, decimals);
+    if (n == 0) {
+        append(out, ",%.*f", decimals, value);
+        return;
+    }
+    if (out.len + n + 1 < sizeof(out.data)) {
+        out.data[out.len++] = ',';
+        memcpy(out.data + out.len, text, n);
+        out.len += n;
+    }
+}
+
+/*=========================EXPORT=========================*/
+
+// One line per stored point of a row
+static void appendRow(CsvBuffer& out, uint8_t dut, bool final, uint16_t columns) {
+    const ImpedanceRow& row = final ? measurementImpedanceData[dut] : baselineImpedanceData[dut];
+    int count = min(getRowPointCount(!final, dut), (int)getPointsPerDUT());
+    if (row.mag == nullptr) {
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        uint8_t flags = row.flags[i];
+        bool valid = (flags & IMPEDANCE_FLAG_VALID) != 0;
+        if (!valid && !(columns & CSV_COL_VALID)) {
+            continue;
+        }
+        if (out.len + CSV_LINE_MAX > sizeof(out.data)) {
+            flush(out);
+        }
+
+        append(out, "%d", dut + 1);  // DUT numbering starts at 1
+        if (columns & CSV_COL_FREQ) {
+            append(out, ",%lu", (unsigned long)storedFrequency(row.freqCode[i]));
+        }
+        if (columns & CSV_COL_MAG) {
+            appendFixed(out, row.mag[i], 6);
+        }
+        if (columns & CSV_COL_PHASE) {
+            appendFixed(out, row.phase[i], 2);
+        }
+        if (columns & CSV_COL_GAIN) {
+            append(out, ",%d,%d", flags & IMPEDANCE_FLAG_PGA_MASK, (flags & IMPEDANCE_FLAG_TIA_HIGH) ? 1 : 0);
+        }
+        if (columns & CSV_COL_SWEEP) {
+            append(out, final ? ",final" : ",baseline");
+        }
+        if (columns & CSV_COL_VALID) {
+            append(out, valid ? ",1" : ",0");
+        }
+        if (columns & CSV_COL_SPREAD) {
+            appendFixed(out, storedMagSdPercent(row, i), 1);
+            appendFixed(out, storedPhaseSdDegrees(row, i), 1);
+        }
+        if (columns & CSV_COL_RISK) {
+            // The risk belongs to the final sweep - empty on baseline lines
+            if (final && finalMeasurementDone && riskLevels[dut] <= RISK_ERROR) {
+                append(out, ",%s", riskNames[riskLevels[dut]]);
+                appendFixed(out, riskPercentages[dut], 2);
+            } else {
+                append(out, ",,");
             }
         }
+        append(out, "\n");
+    }
+}
+
+void printCSVToSerial(uint16_t columns) {
+    CsvBuffer out;
+    out.len = 0;
+
+    append(out, "\n\n" CSV_BANNER "\nDUT");
+    for (const CsvColumnName& column : csvColumns) {
+        if (columns & column.bit) {
+            append(out, "%s", column.header);
+        }
     }
+    append(out, "\n");
 
-    Serial.println("========================================\n");
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        appendRow(out, dut, false, columns);
+        appendRow(out, dut, true, columns);
+    }
+
+    if (out.len + CSV_LINE_MAX > sizeof(out.data)) {
+        flush(out);
+    }
+    append(out, "========================================\n\n");
+    flush(out);
+}
+
+uint16_t parseCSVColumns(const char* list) {
+    if (strcmp(list, "all") == 0) {
+        return CSV_COL_ALL;
+    }
+
+    uint16_t columns = 0;
+    char name[16];
+    while (*list != '\0') {
+        size_t len = strcspn(list, ",");
+        if (len == 0 || len >= sizeof(name)) {
+            return 0;
+        }
+        memcpy(name, list, len);
+        name[len] = '\0';
+
+        uint16_t bit = 0;
+        for (const CsvColumnName& column : csvColumns) {
+            if (strcmp(name, column.name) == 0) {
+                bit = column.bit;
+            }
+        }
+        if (bit == 0) {
+            return 0;
+        }
+        columns |= bit;
+        list += len;
+        if (*list == ',') {
+            list++;
+        }
+    }
+    return columns;
 }
@@ -0,0 +1,206 @@
+#include "csv_reader.h"
+
+// Exact powers of ten in double - the scale steps of a parsed number
+static const double pow10Table[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#define POW10_TABLE_MAX     22
+#define MANTISSA_DIGITS     19      // Significant digits kept in 64 bits
+
+/*=========================LINES=========================*/
+
+void csvBegin(CsvReader& reader, fs::File& file) {
+    reader.file = &file;
+    reader.blockLen = 0;
+    reader.blockPos = 0;
+    reader.line[0] = '\0';
+    reader.cursor = reader.line;
+    reader.lineNumber = 0;
+    reader.fields = 0;
+    reader.longLines = 0;
+}
+
+// Next byte of the file, -1 at the end
+static int nextByte(CsvReader& reader) {
+    if (reader.blockPos == reader.blockLen) {
+        reader.blockLen = reader.file->read((uint8_t*)reader.block, sizeof(reader.block));
+        reader.blockPos = 0;
+        if (reader.blockLen == 0) {
+            return -1;
+        }
+    }
+    return (uint8_t)reader.block[reader.blockPos++];
+}
+
+// One raw line into reader.line (cut at the buffer, the rest dropped)
+// Returns false at the end of the file; cut is set for a cut line
+static bool readLine(CsvReader& reader, bool& cut) {
+    size_t len = 0;
+    cut = false;
+    int c = nextByte(reader);
+    if (c < 0) {
+        return false;
+    }
+    while (c >= 0 && c != '\n') {
+        if (len < sizeof(reader.line) - 1) {
+            reader.line[len++] = (char)c;
+        } else {
+            cut = true;
+        }
+        c = nextByte(reader);
+    }
+    while (len > 0 && (reader.line[len - 1] == '\r' || reader.line[len - 1] == ' ' ||
+                       reader.line[len - 1] == '\t')) {
+        len--;
+    }
+    reader.line[len] = '\0';
+    reader.lineNumber++;
+    return true;
+}
+
+bool csvNextLine(CsvReader& reader) {
+    bool cut;
+    while (readLine(reader, cut)) {
+        const char* p = reader.line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0' || *p == '#' || isalpha((unsigned char)*p)) {
+            continue;
+        }
+        if (cut) {
+            reader.longLines++;
+            continue;
+        }
+        reader.cursor = p;
+        reader.fields = 0;
+        return true;
+    }
+    return false;
+}
+
+/*=========================FIELDS=========================*/
+
+static const char* skipSpaces(const char* p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+// After a number: spaces, then ',' (consumed) or the line end
+static bool endField(CsvReader& reader, const char* p) {
+    p = skipSpaces(p);
+    if (*p == ',') {
+        p++;
+    } else if (*p != '\0') {
+        return false;
+    }
+    reader.cursor = p;
+    reader.fields++;
+    return true;
+}
+
+// [+-]digits[.digits][e[+-]digits] - up to MANTISSA_DIGITS significant
+// digits are kept, enough for a float; more only move the exponent
+static bool parseDecimal(const char*& p, double& out) {
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = *p++ == '-';
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any = false;
+    for (; *p >= '0' && *p <= '9'; p++, any = true) {
+        if (digits < MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += mantissa != 0 ? 1 : 0;
+        } else {
+            exponent++;
+        }
+    }
+    if (*p == '.') {
+        for (p++; *p >= '0' && *p <= '9'; p++, any = true) {
+            if (digits < MANTISSA_DIGITS) {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += mantissa != 0 ? 1 : 0;
+                exponent--;
+            }
+        }
+    }
+    if (!any) {
+        return false;
+    }
+    if (*p == 'e' || *p == 'E') {
+        const char* e = p + 1;
+        bool negativeExp = false;
+        if (*e == '+' || *e == '-') {
+            negativeExp = *e++ == '-';
+        }
+        if (*e >= '0' && *e <= '9') {
+            int value = 0;
+            for (; *e >= '0' && *e <= '9'; e++) {
+                if (value < 1000) value = value * 10 + (*e - '0');
+            }
+            exponent += negativeExp ? -value : value;
+            p = e;
+        }
+    }
+
+    double value = (double)mantissa;
+    if (mantissa != 0) {
+        for (; exponent > POW10_TABLE_MAX; exponent -= POW10_TABLE_MAX) value *= pow10Table[POW10_TABLE_MAX];
+        for (; exponent < -POW10_TABLE_MAX; exponent += POW10_TABLE_MAX) value /= pow10Table[POW10_TABLE_MAX];
+        value = exponent >= 0 ? value * pow10Table[exponent] : value / pow10Table[-exponent];
+    }
+    out = negative ? -value : value;
+    return true;
+}
+
+bool csvFloat(CsvReader& reader, float& out) {
+    const char* p = skipSpaces(reader.cursor);
+    double value;
+    if (!parseDecimal(p, value) || !endField(reader, p)) {
+        return false;
+    }
+    out = (float)value;
+    return true;
+}
+
+// [+-]digits, no fraction
+static bool parseInteger(const char*& p, bool allowSign, int64_t& out) {
+    bool negative = false;
+    if (*p == '+' || (allowSign && *p == '-')) {
+        negative = *p++ == '-';
+    }
+    if (*p < '0' || *p > '9') {
+        return false;
+    }
+    int64_t value = 0;
+    for (; *p >= '0' && *p <= '9'; p++) {
+        value = value * 10 + (*p - '0');
+        if (value > UINT32_MAX) {
+            return false;
+        }
+    }
+    out = negative ? -value : value;
+    return true;
+}
+
+bool csvInt(CsvReader& reader, int& out) {
+    const char* p = skipSpaces(reader.cursor);
+    int64_t value;
+    if (!parseInteger(p, true, value) || value > INT32_MAX || value < INT32_MIN || !endField(reader, p)) {
+        return false;
+    }
+    out = (int)value;
+    return true;
+}
+
+bool csvUint(CsvReader& reader, uint32_t& out) {
+    const char* p = skipSpaces(reader.cursor);
+    int64_t value;
+    if (!parseInteger(p, false, value) || !endField(reader, p)) {
+        return false;
+    }
+    out = (uint32_t)value;
+    return true;
+}
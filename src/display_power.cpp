@@ -0,0 +1,162 @@
+#include "display_power.h"
+#include "console.h"
+#include "defines.h"
+#include "gui_screens.h"
+#include "UART_Functions.h"
+
+// ILI9341 power commands
+#define PANEL_SLPIN     0x10
+#define PANEL_SLPOUT    0x11
+#define PANEL_DISPOFF   0x28
+#define PANEL_DISPON    0x29
+#define PANEL_IDMOFF    0x38
+#define PANEL_IDMON     0x39
+
+static const char* const stateNames[DISPLAY_STATE_COUNT] = {"Active", "Dim", "Off"};
+
+// GUI task only
+static DisplayPowerState displayState = DISPLAY_ACTIVE;
+static bool panelIdle = false;          // Idle (8-color) mode on
+static uint32_t lastActivityMs = 0;
+static uint32_t sleepInMs = 0;          // Last SLPIN
+static uint32_t stateSinceMs = 0;
+static uint32_t stateTimeMs[DISPLAY_STATE_COUNT] = {0};
+static uint32_t wakeCount = 0;
+static bool heldOff = false;
+
+/*=========================PANEL=========================*/
+
+static void setBacklight(DisplayPowerState state) {
+#ifdef TFT_BL
+#if DISPLAY_BL_PWM
+    ledcWrite(TFT_BL, state == DISPLAY_ACTIVE ? DISPLAY_BL_FULL : state == DISPLAY_DIM ? DISPLAY_BL_DIM : 0);
+#else
+    digitalWrite(TFT_BL, state != DISPLAY_OFF ? TFT_BACKLIGHT_ON : !TFT_BACKLIGHT_ON);
+#endif
+#endif
+}
+
+// Status screens that only change on an event - worth the 8-color mode
+static bool isStaticScreen(GUIState state) {
+    return state == GUI_HOME || state == GUI_BASELINE_COMPLETE || state == GUI_RESULTS;
+}
+
+static void applyState(DisplayPowerState next, bool idle) {
+    // Commands share the SPI bus with the frame push
+    finishFramePush();
+    if (next == DISPLAY_OFF && displayState != DISPLAY_OFF) {
+        setBacklight(DISPLAY_OFF);
+        tft.writecommand(PANEL_DISPOFF);
+        tft.writecommand(PANEL_SLPIN);
+        sleepInMs = millis();
+    } else if (next != DISPLAY_OFF && displayState == DISPLAY_OFF) {
+        uint32_t asleep = millis() - sleepInMs;
+        if (asleep < DISPLAY_SLEEP_IN_MS) {
+            delay(DISPLAY_SLEEP_IN_MS - asleep);
+        }
+        tft.writecommand(PANEL_SLPOUT);
+        delay(DISPLAY_SLEEP_OUT_MS);
+        tft.writecommand(PANEL_DISPON);
+        wakeCount++;
+    }
+    if (idle != panelIdle) {
+        tft.writecommand(idle ? PANEL_IDMON : PANEL_IDMOFF);
+        panelIdle = idle;
+    }
+    if (next != DISPLAY_OFF) {
+        setBacklight(next);
+    }
+
+    if (next != displayState) {
+        uint32_t now = millis();
+        stateTimeMs[displayState] += now - stateSinceMs;
+        stateSinceMs = now;
+        displayState = next;
+    }
+}
+
+/*=========================STATE=========================*/
+
+void initDisplayPower() {
+    lastActivityMs = millis();
+    stateSinceMs = lastActivityMs;
+#if DISPLAY_POWER && defined(TFT_BL) && DISPLAY_BL_PWM
+    // tft.init() drove the pin high - PWM from here on
+    if (!ledcAttach(TFT_BL, DISPLAY_BL_PWM_HZ, DISPLAY_BL_PWM_BITS)) {
+        Console.println("[DISP] WARNING: Backlight PWM not available");
+        return;
+    }
+    setBacklight(DISPLAY_ACTIVE);
+#endif
+}
+
+static bool isSweepActive() {
+    return measurementInProgress || isSweepStartPending();
+}
+
+void processDisplayPower() {
+#if DISPLAY_POWER
+    if (heldOff) {
+        return;
+    }
+    if (isSweepActive()) {
+        lastActivityMs = millis();
+    }
+    uint32_t idleMs = millis() - lastActivityMs;
+    DisplayPowerState next = idleMs >= DISPLAY_OFF_AFTER_MS ? DISPLAY_OFF
+                           : idleMs >= DISPLAY_DIM_AFTER_MS ? DISPLAY_DIM : DISPLAY_ACTIVE;
+    bool idle = next == DISPLAY_DIM && isStaticScreen(getGUIState());
+    if (next != displayState || idle != panelIdle) {
+        applyState(next, idle);
+    }
+#endif
+}
+
+void noteDisplayActivity() {
+    lastActivityMs = millis();
+#if DISPLAY_POWER
+    if (!heldOff && (displayState != DISPLAY_ACTIVE || panelIdle)) {
+        applyState(DISPLAY_ACTIVE, false);
+    }
+#endif
+}
+
+void holdDisplayOff() {
+    heldOff = true;
+    applyState(DISPLAY_OFF, false);
+}
+
+uint32_t getDisplayPowerWaitMs() {
+    if (!DISPLAY_POWER || heldOff || displayState == DISPLAY_OFF || isSweepActive()) {
+        return UINT32_MAX;
+    }
+    uint32_t due = displayState == DISPLAY_ACTIVE ? DISPLAY_DIM_AFTER_MS : DISPLAY_OFF_AFTER_MS;
+    uint32_t elapsed = millis() - lastActivityMs;
+    return elapsed >= due ? 0 : due - elapsed;
+}
+
+DisplayPowerState getDisplayPowerState() {
+    return displayState;
+}
+
+/*=========================REPORT=========================*/
+
+void printDisplayPowerReport() {
+    uint32_t times[DISPLAY_STATE_COUNT];
+    uint32_t total = 0;
+    for (int i = 0; i < DISPLAY_STATE_COUNT; i++) {
+        times[i] = stateTimeMs[i] + (i == displayState ? millis() - stateSinceMs : 0);
+        total += times[i];
+    }
+    Console.printf("Display: %s%s, %lu wake-ups, backlight %s\n", stateNames[displayState],
+                   panelIdle ? " (idle mode)" : "", wakeCount, DISPLAY_BL_PWM ? "PWM" : "on/off");
+    float chargeMAs = times[DISPLAY_ACTIVE] / 1000.0f * DISPLAY_BL_FULL_MA +
+                      times[DISPLAY_DIM] / 1000.0f * (DISPLAY_BL_PWM ? DISPLAY_BL_DIM_MA : DISPLAY_BL_FULL_MA);
+    for (int i = 0; i < DISPLAY_STATE_COUNT; i++) {
+        Console.printf("  %-8s %9.1f s  %5.1f%%\n", stateNames[i], times[i] / 1000.0f,
+                       total > 0 ? times[i] * 100.0f / total : 0.0f);
+    }
+    if (total > 0) {
+        Console.printf("  Backlight ~%.2f mA average (estimated)\n", chargeMAs / (total / 1000.0f));
+    }
+}
@@ -0,0 +1,309 @@
+#include "fixed_cal.h"
+#include "impedance_calc.h"
+#include "log.h"
+#ifdef ARDUINO
+#include "trace.h"
+#include "sweep_stats.h"
+#endif
+
+#define FX_LOG2_INVALID     INT32_MIN
+#define FX_TABLE_BITS       8
+#define FX_TABLE_SIZE       (1 << FX_TABLE_BITS)
+
+/*=========================LOOKUP TABLES=========================*/
+// log2(1 + i/256) in Q16.16 and (2^(i/256) - 1) as 23-bit float mantissa
+// Filled once with float math at init - never touched on the hot path
+static int32_t log2Table[FX_TABLE_SIZE + 1];
+static int32_t exp2Table[FX_TABLE_SIZE + 1];
+static bool tablesReady = false;
+
+struct FixedCalEntry {
+    fx_log2_t log2_gain;
+    fx_angle_t phase;
+    bool valid;
+};
+
+// Slopes per log2(Hz), Q16.16 - segment i spans sweep index i -> i + 1
+struct FixedCalSegment {
+    int32_t gain_slope;
+    int32_t phase_slope;
+};
+
+static FixedCalEntry fixedLUT[SWEEP_FREQ_COUNT][2][8];
+static FixedCalSegment fixedSegments[SWEEP_FREQ_COUNT - 1][2][8];
+static fx_log2_t sweepLog2[SWEEP_FREQ_COUNT];
+
+static void initTables() {
+    for (int i = 0; i <= FX_TABLE_SIZE; i++) {
+        float x = (float)i / FX_TABLE_SIZE;
+        log2Table[i] = (int32_t)lroundf(log2f(1.0f + x) * FX_LOG2_ONE);
+        exp2Table[i] = (int32_t)lroundf((exp2f(x) - 1.0f) * (1 << 23));
+    }
+    tablesReady = true;
+}
+
+/*=========================CONVERSIONS=========================*/
+
+// log2 of (1.mantissa) * 2^exponent, mantissa as 23 bits
+static inline fx_log2_t log2FromParts(int32_t exponent, uint32_t mantissa) {
+    uint32_t i = mantissa >> (23 - FX_TABLE_BITS);
+    uint32_t r = mantissa & ((1 << (23 - FX_TABLE_BITS)) - 1);
+    int32_t frac = log2Table[i] +
+                   (int32_t)(((int64_t)(log2Table[i + 1] - log2Table[i]) * r) >> (23 - FX_TABLE_BITS));
+    return exponent * FX_LOG2_ONE + frac;
+}
+
+fx_log2_t fxLog2(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    int32_t exponent = (int32_t)((bits >> 23) & 0xFF);
+    if ((bits & 0x80000000) || exponent == 0 || exponent == 0xFF) {
+        return FX_LOG2_INVALID;     // Negative, zero/denormal, inf/NaN
+    }
+    return log2FromParts(exponent - 127, bits & 0x7FFFFF);
+}
+
+// Integer input - frequencies never go through a float
+static fx_log2_t fxLog2U32(uint32_t v) {
+    if (v == 0) {
+        return FX_LOG2_INVALID;
+    }
+    int32_t exponent = 31 - __builtin_clz(v);
+    uint32_t normalized = v << (31 - exponent);          // Leading 1 at bit 31
+    return log2FromParts(exponent, (normalized >> 8) & 0x7FFFFF);
+}
+
+float fxExp2(fx_log2_t q) {
+    int32_t exponent = (q >> 16) + 127;     // Arithmetic shift = floor
+    uint32_t frac = (uint32_t)q & 0xFFFF;
+
+    if (exponent <= 0) return 0.0f;
+    if (exponent >= 0xFF) return INFINITY;
+
+    uint32_t i = frac >> (16 - FX_TABLE_BITS);
+    uint32_t r = frac & ((1 << (16 - FX_TABLE_BITS)) - 1);
+    uint32_t mantissa = exp2Table[i] +
+                        (uint32_t)(((int64_t)(exp2Table[i + 1] - exp2Table[i]) * r) >> (16 - FX_TABLE_BITS));
+
+    uint32_t bits = ((uint32_t)exponent << 23) | (mantissa & 0x7FFFFF);
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+fx_angle_t fxDegToAngle(float deg) {
+    // Through int64 so any |deg| < 2^31 / 11.9M wraps correctly
+    return (fx_angle_t)(uint32_t)(int64_t)(deg * (4294967296.0f / 360.0f));
+}
+
+float fxAngleToDeg(fx_angle_t angle) {
+    return (float)angle * (360.0f / 4294967296.0f);
+}
+
+/*=========================LUT CONVERSION=========================*/
+
+void buildFixedCalibrationLUT(const CalLUTEntry (*lut)[2][8]) {
+    if (!tablesReady) {
+        initTables();
+    }
+
+    for (int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        sweepLog2[f] = fxLog2U32(sweepFrequencies[f]);
+        for (int tia = 0; tia < 2; tia++) {
+            for (int pga = 0; pga < 8; pga++) {
+                const CalLUTEntry& src = lut[f][tia][pga];
+                FixedCalEntry& dst = fixedLUT[f][tia][pga];
+
+                dst.valid = src.valid && src.gain > 0.0f;
+                dst.log2_gain = dst.valid ? fxLog2(src.gain) : 0;
+                dst.phase = dst.valid ? fxDegToAngle(src.phase_offset) : 0;
+            }
+        }
+    }
+
+    for (int s = 0; s < SWEEP_FREQ_COUNT - 1; s++) {
+        int32_t dx = sweepLog2[s + 1] - sweepLog2[s];
+        for (int tia = 0; tia < 2; tia++) {
+            for (int pga = 0; pga < 8; pga++) {
+                const FixedCalEntry& a = fixedLUT[s][tia][pga];
+                const FixedCalEntry& b = fixedLUT[s + 1][tia][pga];
+                FixedCalSegment& seg = fixedSegments[s][tia][pga];
+
+                // Phase difference taken the short way round
+                int32_t dPhase = (int32_t)((uint32_t)b.phase - (uint32_t)a.phase);
+                seg.gain_slope = (int32_t)(((int64_t)(b.log2_gain - a.log2_gain) << 16) / dx);
+                seg.phase_slope = (int32_t)(((int64_t)dPhase << 16) / dx);
+            }
+        }
+    }
+}
+
+/*=========================KERNEL=========================*/
+
+// Exact sweep frequency or log-log interpolation between neighbours
+// (the float path interpolates the linear gain - results differ slightly off-grid)
+static bool lookupFixed(const MeasurementPoint& m, fx_log2_t& log2Gain, fx_angle_t& phase) {
+    if (m.pga_gain > 7) {
+        return false;
+    }
+
+    uint8_t idx = getSweepFrequencyIndex(m.freq_hz, m.freq_idx);
+    if (idx != SWEEP_FREQ_INVALID) {
+        const FixedCalEntry& cal = fixedLUT[idx][m.tia_gain][m.pga_gain];
+        log2Gain = cal.log2_gain;
+        phase = cal.phase;
+        return cal.valid;
+    }
+
+    uint8_t s = getSweepSegment(m.freq_hz);
+    if (s == SWEEP_FREQ_INVALID ||
+        !fixedLUT[s][m.tia_gain][m.pga_gain].valid ||
+        !fixedLUT[s + 1][m.tia_gain][m.pga_gain].valid) {
+        return false;
+    }
+
+    const FixedCalEntry& a = fixedLUT[s][m.tia_gain][m.pga_gain];
+    const FixedCalSegment& seg = fixedSegments[s][m.tia_gain][m.pga_gain];
+    int64_t dx = fxLog2U32(m.freq_hz) - sweepLog2[s];
+    log2Gain = a.log2_gain + (int32_t)((seg.gain_slope * dx) >> 16);
+    phase = (fx_angle_t)((uint32_t)a.phase + (uint32_t)((seg.phase_slope * dx) >> 16));
+    return true;
+}
+
+bool calcFixedCalibratedPoint(const MeasurementPoint& measPoint, ImpedancePoint& out) {
+    out = ImpedancePoint();
+    fx_log2_t log2I = fxLog2(measPoint.I_magnitude);
+
+    // Same rejection as calcImpedance(): invalid flag or I <= 0
+    if (!measPoint.valid || log2I == FX_LOG2_INVALID) {
+        return false;
+    }
+
+    out.freq_hz = measPoint.freq_hz;
+    out.valid = true;
+    out.pga_gain = measPoint.pga_gain;
+    out.tia_gain = measPoint.tia_gain;
+    out.freq_idx = measPoint.freq_idx;
+
+    fx_log2_t log2Gain = 0;
+    fx_angle_t calPhase = 0;
+    bool success = lookupFixed(measPoint, log2Gain, calPhase);
+    if (!success) {
+        // Keep the uncalibrated value, as the float path does
+        log2Gain = 0;
+        calPhase = 0;
+        LOG_W("Missing calibration data for freq=%lu, TIA=%d, PGA=%d\n",
+              measPoint.freq_hz, measPoint.tia_gain, measPoint.pga_gain);
+    }
+
+    // |Z| = V / I * gain, phase + offset (wraps to [-180, 180) by itself)
+    fx_log2_t log2V = fxLog2(measPoint.V_magnitude);
+    out.Z_magnitude = (log2V == FX_LOG2_INVALID) ? 0.0f : fxExp2(log2V - log2I + log2Gain);
+    out.Z_phase = fxAngleToDeg((fx_angle_t)((uint32_t)fxDegToAngle(measPoint.phase_deg) + (uint32_t)calPhase));
+    return success;
+}
+
+#ifdef ARDUINO
+bool calcCalibratedImpedanceFixed(const MeasurementPoint& measPoint, ImpedancePoint& out) {
+    if (getCalibrationMode() != CALIBRATION_MODE_SEPARATE_FILES || !tablesReady) {
+        out = calcImpedance(measPoint);
+        bool success = calibrate(out);
+#if IMPEDANCE_RECTANGULAR
+        impedanceToPolar(out);
+#endif
+        return success;
+    }
+
+    int64_t startUs = esp_timer_get_time();
+    trace(TRACE_CAL_BEGIN, 1, measPoint.freq_hz);
+
+    bool success = calcFixedCalibratedPoint(measPoint, out);
+
+    trace(TRACE_CAL_END, success, measPoint.freq_hz);
+    sweepStatsRecord(STAGE_CALIBRATE, (uint32_t)(esp_timer_get_time() - startUs));
+    return success;
+}
+#endif
+
+/*=========================SELF-TEST=========================*/
+
+static float wrapPhaseError(float d) {
+    while (d > 180.0f) d -= 360.0f;
+    while (d < -180.0f) d += 360.0f;
+    return fabsf(d);
+}
+
+void runFixedCalibrationSelfTest() {
+    if (getCalibrationMode() != CALIBRATION_MODE_SEPARATE_FILES || !tablesReady) {
+        HAL_PRINTF("Fixed-point self-test needs the separate-files calibration LUT\n");
+        return;
+    }
+
+    // Spread over the front-end range: V in volts, I in amps, phase in degrees
+    static const float testV[] = {0.005f, 0.35f, 2.9f};
+    static const float testI[] = {2.0e-9f, 4.0e-6f, 1.5e-3f};
+    static const float testPhase[] = {-179.5f, -45.0f, 0.0f, 89.9f};
+
+    uint32_t points = 0;
+    float maxMagErr = 0.0f;         // Relative
+    float maxPhaseErr = 0.0f;       // Degrees
+    int64_t floatUs = 0;
+    int64_t fixedUs = 0;
+
+    for (int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        for (int tia = 0; tia < 2; tia++) {
+            for (int pga = 0; pga < 8; pga++) {
+                if (!fixedLUT[f][tia][pga].valid) continue;
+
+                for (float v : testV) {
+                    for (float i : testI) {
+                        for (float ph : testPhase) {
+                            MeasurementPoint m;
+                            m.freq_hz = sweepFrequencies[f];
+                            m.V_magnitude = v;
+                            m.I_magnitude = i;
+                            m.phase_deg = ph;
+                            m.pga_gain = pga;
+                            m.tia_gain = tia;
+                            m.valid = true;
+                            m.freq_idx = f;
+
+                            int64_t t0 = halMicros();
+                            ImpedancePoint ref = calcImpedance(m);
+                            calibrateWithSeparateFiles(ref);
+#if IMPEDANCE_RECTANGULAR
+                            impedanceToPolar(ref);
+#endif
+                            int64_t t1 = halMicros();
+                            ImpedancePoint fx;
+                            calcFixedCalibratedPoint(m, fx);
+                            int64_t t2 = halMicros();
+
+                            floatUs += t1 - t0;
+                            fixedUs += t2 - t1;
+                            points++;
+
+                            float magErr = fabsf(fx.Z_magnitude - ref.Z_magnitude) / ref.Z_magnitude;
+                            if (magErr > maxMagErr) maxMagErr = magErr;
+                            float phaseErr = wrapPhaseError(fx.Z_phase - ref.Z_phase);
+                            if (phaseErr > maxPhaseErr) maxPhaseErr = phaseErr;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (points == 0) {
+        HAL_PRINTF("Fixed-point self-test: no valid calibration entries\n");
+        return;
+    }
+
+    HAL_PRINTF("\n=== Fixed-point Calibration Self-test ===\n");
+    HAL_PRINTF("Points:          %lu\n", points);
+    HAL_PRINTF("Max |Z| error:   %.1f ppm\n", maxMagErr * 1e6f);
+    HAL_PRINTF("Max phase error: %.5f deg\n", maxPhaseErr);
+    HAL_PRINTF("Float path:      %.2f us/point\n", (float)floatUs / points);
+    HAL_PRINTF("Fixed path:      %.2f us/point\n", (float)fixedUs / points);
+}
@@ -0,0 +1,68 @@
+#include "fixed_format.h"
+
+static const uint32_t decimalScale[FIXED_FORMAT_MAX_DECIMALS + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+// Digits of n, least significant first - returns their count
+static int reverseDigits(uint64_t n, char* digits) {
+    int count = 0;
+    // 64-bit division is a library call on the C6 - only for the upper part
+    while (n > UINT32_MAX) {
+        digits[count++] = '0' + (char)(n % 10);
+        n /= 10;
+    }
+    uint32_t low = (uint32_t)n;
+    do {
+        digits[count++] = '0' + (char)(low % 10);
+        low /= 10;
+    } while (low != 0);
+    return count;
+}
+
+size_t formatFixed(char* out, size_t size, float value, uint8_t decimals) {
+    if (decimals > FIXED_FORMAT_MAX_DECIMALS) {
+        return 0;
+    }
+    // Exact: 24 mantissa bits times at most 20 bits of scale
+    double scaled = fabs((double)value) * decimalScale[decimals];
+    if (!(scaled < 18446744073709551615.0)) {
+        return 0;   // NaN, infinity or out of range
+    }
+    uint64_t units = (uint64_t)scaled;
+    // Ties to even, as printf rounds the exact value
+    double rest = scaled - (double)units;
+    if (rest > 0.5 || (rest == 0.5 && (units & 1))) {
+        units++;
+    }
+
+    char digits[20];
+    int count = reverseDigits(units, digits);
+    // Leading zeros up to "0." and the decimals
+    while (count <= decimals) {
+        digits[count++] = '0';
+    }
+
+    bool negative = value < 0.0f && units != 0;
+    size_t len = (negative ? 1 : 0) + count + (decimals > 0 ? 1 : 0);
+    if (len + 1 > size) {
+        return 0;
+    }
+    char* p = out;
+    if (negative) {
+        *p++ = '-';
+    }
+    for (int i = count - 1; i >= 0; i--) {
+        *p++ = digits[i];
+        if (i == decimals && decimals > 0) {
+            *p++ = '.';
+        }
+    }
+    *p = '\0';
+    return len;
+}
+
+const char* fixedText(char (&out)[FIXED_FORMAT_BUFFER], float value, uint8_t decimals) {
+    if (formatFixed(out, sizeof(out), value, decimals) == 0) {
+        snprintf(out, sizeof(out), "%g", value);    // Rare - not finite or huge
+    }
+    return out;
+}
@@ -0,0 +1,401 @@
+#include "fleet_aggregator.h"
+#include "console.h"
+
+#if FLEET_AGGREGATOR
+
+#include "BLE_Functions.h"
+#include "wifi_server.h"
+#include "storage.h"
+#include "task_monitor.h"
+#include "heap_stats.h"
+#include "log.h"
+#include <LittleFS.h>
+#include "freertos/message_buffer.h"
+#include "freertos/queue.h"
+
+#define FLEET_NOTIFY_MAX    512     // Attribute value limit - largest peer notification
+
+/*=========================STATE=========================*/
+// One connected peer - connected / tx are read by the BT callbacks
+struct FleetPeer {
+    BLEClient* client;              // Created once per slot, reused
+    BLERemoteCharacteristic* volatile tx;
+    BLERemoteCharacteristic* rx;
+    volatile bool connected;
+    esp_bd_addr_t address;
+    uint32_t frames;                // Notifications relayed
+    uint32_t bytes;
+};
+static FleetPeer peers[FLEET_MAX_PEERS];
+
+// A board seen by the last scan
+struct FleetCandidate {
+    esp_bd_addr_t address;
+    esp_ble_addr_type_t type;
+};
+static FleetCandidate candidates[FLEET_MAX_PEERS];
+static volatile uint8_t candidateCount = 0;
+
+// Written by the GUI / serial commands, read by the fleet task
+static volatile bool enabled = false;
+
+// Peer notifications: [peer slot][notification] - the BT task writes, the fleet task reads
+static MessageBufferHandle_t rxBuffer = nullptr;
+static QueueHandle_t sendQueue = nullptr;
+static uint8_t rxBufferStorage[FLEET_RX_BUFFER_BYTES + 1];
+static StaticMessageBuffer_t rxBufferControl;
+static StaticQueue_t sendQueueControl;
+static volatile bool linksChanged = false;
+static volatile uint32_t rxDrops = 0;
+static uint32_t relayDrops = 0;
+static uint16_t linkInterval = 0;
+
+struct FleetCommand {
+    uint8_t peer;                   // 1-based, 0 = every peer
+    char text[BLE_CMD_MAX_LEN];
+};
+static uint8_t sendQueueStorage[FLEET_SEND_QUEUE_DEPTH * sizeof(FleetCommand)];
+
+/*=========================SETTINGS=========================*/
+void initFleetAggregator() {
+    rxBuffer = xMessageBufferCreateStatic(FLEET_RX_BUFFER_BYTES, rxBufferStorage, &rxBufferControl);
+    sendQueue = xQueueCreateStatic(FLEET_SEND_QUEUE_DEPTH, sizeof(FleetCommand), sendQueueStorage, &sendQueueControl);
+    if (!isStorageMounted()) {
+        return;
+    }
+    File file = LittleFS.open(FLEET_CONFIG_FILE, "r");
+    if (file) {
+        enabled = file.read() == '1';
+        file.close();
+    }
+    Console.printf("[FLEET] Aggregator %s\n", enabled ? "on" : "off");
+}
+
+bool setFleetEnabled(bool enable) {
+    enabled = enable;
+    return queueStorageWrite(FLEET_CONFIG_FILE, enable ? "1" : "0", 1);
+}
+
+bool isFleetEnabled() {
+    return enabled;
+}
+
+uint8_t getFleetPeerCount() {
+    uint8_t count = 0;
+    for (const FleetPeer& peer : peers) {
+        count += peer.connected ? 1 : 0;
+    }
+    return count;
+}
+
+static void formatAddress(const esp_bd_addr_t address, char* out, size_t size) {
+    snprintf(out, size, "%02x:%02x:%02x:%02x:%02x:%02x", address[0], address[1], address[2], address[3],
+             address[4], address[5]);
+}
+
+/*=========================BT CALLBACKS=========================*/
+// BT task: copy the notification for the fleet task, never wait
+static void onPeerNotify(BLERemoteCharacteristic* characteristic, uint8_t* data, size_t len, bool isNotify) {
+    static uint8_t item[1 + FLEET_NOTIFY_MAX];     // BT task only
+    if (len == 0 || len > FLEET_NOTIFY_MAX) {
+        return;
+    }
+    for (uint8_t slot = 0; slot < FLEET_MAX_PEERS; slot++) {
+        if (peers[slot].connected && peers[slot].tx == characteristic) {
+            item[0] = slot;
+            memcpy(item + 1, data, len);
+            if (xMessageBufferSend(rxBuffer, item, 1 + len, 0) == 0) {
+                rxDrops = rxDrops + 1;
+            }
+            return;
+        }
+    }
+}
+
+class FleetClientCallbacks : public BLEClientCallbacks {
+    void onConnect(BLEClient* client) {}
+
+    void onDisconnect(BLEClient* client) {
+        for (FleetPeer& peer : peers) {
+            if (peer.client == client && peer.connected) {
+                peer.connected = false;
+                linksChanged = true;
+            }
+        }
+    }
+};
+static FleetClientCallbacks clientCallbacks;
+
+// Boards advertising the BioPal service, not yet connected
+class FleetScanCallbacks : public BLEAdvertisedDeviceCallbacks {
+    void onResult(BLEAdvertisedDevice device) {
+        static BLEUUID service(BLE_SERVICE_UUID);
+        if (!device.isAdvertisingService(service) || candidateCount == FLEET_MAX_PEERS) {
+            return;
+        }
+        BLEAddress bleAddress = device.getAddress();
+        const uint8_t* address = *bleAddress.getNative();
+        for (uint8_t i = 0; i < candidateCount; i++) {
+            if (memcmp(candidates[i].address, address, sizeof(esp_bd_addr_t)) == 0) {
+                return;
+            }
+        }
+        for (const FleetPeer& peer : peers) {
+            if (peer.connected && memcmp(peer.address, address, sizeof(esp_bd_addr_t)) == 0) {
+                return;
+            }
+        }
+        FleetCandidate& candidate = candidates[candidateCount];
+        memcpy(candidate.address, address, sizeof(esp_bd_addr_t));
+        candidate.type = device.getAddressType();
+        candidateCount = candidateCount + 1;
+    }
+};
+static FleetScanCallbacks scanCallbacks;
+
+/*=========================LINK SCHEDULE=========================*/
+// The same interval for every peer, one FLEET_SLOT_INT slot each per round
+static void scheduleLinks() {
+    uint8_t count = getFleetPeerCount();
+    linkInterval = FLEET_SLOT_INT * count;
+    for (FleetPeer& peer : peers) {
+        if (!peer.connected) {
+            continue;
+        }
+        esp_ble_conn_update_params_t params = {};
+        memcpy(params.bda, peer.address, sizeof(esp_bd_addr_t));
+        params.min_int = linkInterval;
+        params.max_int = linkInterval;
+        params.latency = 0;
+        params.timeout = FLEET_CONN_TIMEOUT;
+        if (esp_ble_gap_update_conn_params(&params) != ESP_OK) {
+            LOG_W("[FLEET] Connection parameter update failed\n");
+        }
+    }
+    if (count > 0) {
+        HAL_PRINTF("[FLEET] %d peer%s at %.2f ms intervals\n", count, count > 1 ? "s" : "", linkInterval * 1.25f);
+    }
+}
+
+/*=========================PEERS=========================*/
+static void writePeer(FleetPeer& peer, const char* text) {
+    heapStatsEnterFramework();
+    peer.rx->writeValue((uint8_t*)text, strlen(text), true);
+    heapStatsExitFramework();
+}
+
+static void announcePeer(uint8_t slot, bool connected) {
+    char address[18];
+    char statusMsg[40];
+    formatAddress(peers[slot].address, address, sizeof(address));
+    if (connected) {
+        snprintf(statusMsg, sizeof(statusMsg), "Fleet peer:%d,%s", slot + 1, address);
+    } else {
+        snprintf(statusMsg, sizeof(statusMsg), "Fleet lost:%d", slot + 1);
+    }
+    Console.printf("[FLEET] Peer %d (%s) %s\n", slot + 1, address, connected ? "connected" : "lost");
+    sendBLEStatus(statusMsg);
+}
+
+static bool connectPeer(uint8_t slot, const FleetCandidate& candidate) {
+    FleetPeer& peer = peers[slot];
+    if (peer.client == nullptr) {
+        peer.client = BLEDevice::createClient();
+        peer.client->setClientCallbacks(&clientCallbacks);
+    }
+    memcpy(peer.address, candidate.address, sizeof(esp_bd_addr_t));
+
+    heapStatsEnterFramework();
+    bool ok = peer.client->connect(BLEAddress(peer.address), candidate.type, FLEET_CONNECT_TIMEOUT_MS);
+    BLERemoteService* service = ok ? peer.client->getService(BLEUUID(BLE_SERVICE_UUID)) : nullptr;
+    BLERemoteCharacteristic* tx = service != nullptr ? service->getCharacteristic(BLEUUID(BLE_CHARACTERISTIC_TX)) : nullptr;
+    BLERemoteCharacteristic* rx = service != nullptr ? service->getCharacteristic(BLEUUID(BLE_CHARACTERISTIC_RX)) : nullptr;
+    ok = tx != nullptr && rx != nullptr && tx->canNotify();
+    if (ok) {
+        // Notifications may come as soon as the CCCD is written
+        peer.tx = tx;
+        peer.rx = rx;
+        peer.frames = 0;
+        peer.bytes = 0;
+        peer.connected = true;
+        tx->registerForNotify(onPeerNotify);
+    } else if (peer.client->isConnected()) {
+        peer.client->disconnect();
+    }
+    heapStatsExitFramework();
+    if (!ok) {
+        return false;
+    }
+
+    writePeer(peer, BLE_CMD_FORMAT ":BIN");
+    writePeer(peer, BLE_CMD_FLEET_LINK);
+    announcePeer(slot, true);
+    return true;
+}
+
+// Scan, then connect to what it found while slots are free
+static void findPeers() {
+    candidateCount = 0;
+    BLEScan* scan = BLEDevice::getScan();
+    heapStatsEnterFramework();
+    scan->setAdvertisedDeviceCallbacks(&scanCallbacks);
+    scan->setActiveScan(false);     // The service UUID is in the advertisement
+    scan->setInterval(100);
+    scan->setWindow(50);
+    scan->start(FLEET_SCAN_S, false);
+    scan->clearResults();
+    heapStatsExitFramework();
+
+    bool added = false;
+    for (uint8_t i = 0; i < candidateCount; i++) {
+        taskWatchdogFeed();
+        for (uint8_t slot = 0; slot < FLEET_MAX_PEERS; slot++) {
+            if (!peers[slot].connected) {
+                added = connectPeer(slot, candidates[i]) || added;
+                break;
+            }
+        }
+    }
+    if (added) {
+        scheduleLinks();
+    }
+}
+
+static void dropPeers() {
+    for (FleetPeer& peer : peers) {
+        if (peer.connected) {
+            heapStatsEnterFramework();
+            peer.client->disconnect();
+            heapStatsExitFramework();
+        }
+    }
+}
+
+/*=========================RELAY=========================*/
+// One peer notification as FleetFrameHeader frames of at most frameMax bytes
+static bool relayFrames(bool ble, uint8_t slot, const uint8_t* data, size_t len, size_t frameMax) {
+    static uint8_t frame[sizeof(FleetFrameHeader) + FLEET_NOTIFY_MAX];    // Fleet task only
+    if (frameMax <= sizeof(FleetFrameHeader)) {
+        return true;    // Nobody listening
+    }
+    size_t partSize = min(frameMax, sizeof(frame)) - sizeof(FleetFrameHeader);
+    FleetFrameHeader* header = (FleetFrameHeader*)frame;
+    header->magic = BLE_BIN_MAGIC;
+    header->type = BLE_BIN_TYPE_FLEET;
+    header->peer = slot + 1;
+    bool ok = true;
+    for (size_t offset = 0; offset < len && ok; offset += partSize) {
+        size_t n = min(partSize, len - offset);
+        header->part = offset / partSize;
+        if (offset + n < len) {
+            header->part |= FLEET_PART_MORE;
+        }
+        memcpy(frame + sizeof(FleetFrameHeader), data + offset, n);
+        ok = ble ? sendBLEBytes(frame, sizeof(FleetFrameHeader) + n)
+                 : sendWiFiLive(frame, sizeof(FleetFrameHeader) + n);
+    }
+    return ok;
+}
+
+static void relay(const uint8_t* item, size_t size) {
+    uint8_t slot = item[0];
+    const uint8_t* data = item + 1;
+    size_t len = size - 1;
+    if (slot >= FLEET_MAX_PEERS) {
+        return;
+    }
+    peers[slot].frames++;
+    peers[slot].bytes += len;
+    bool ok = relayFrames(true, slot, data, len, getBLEDataPayloadSize());
+#if WIFI_SERVER
+    if (getWiFiLiveClients() > 0) {
+        ok = relayFrames(false, slot, data, len, WIFI_WS_FRAME_MAX) && ok;
+    }
+#endif
+    if (!ok) {
+        relayDrops++;
+    }
+}
+
+static void sendCommands() {
+    FleetCommand command;
+    while (xQueueReceive(sendQueue, &command, 0) == pdTRUE) {
+        for (uint8_t slot = 0; slot < FLEET_MAX_PEERS; slot++) {
+            if (peers[slot].connected && (command.peer == 0 || command.peer == slot + 1)) {
+                writePeer(peers[slot], command.text);
+            }
+        }
+    }
+}
+
+bool sendFleetCommand(uint8_t peer, const char* command) {
+    if (sendQueue == nullptr || getFleetPeerCount() == 0 ||
+        peer > FLEET_MAX_PEERS || (peer > 0 && !peers[peer - 1].connected)) {
+        return false;
+    }
+    FleetCommand item;
+    item.peer = peer;
+    snprintf(item.text, sizeof(item.text), "%s", command);
+    return xQueueSend(sendQueue, &item, 0) == pdTRUE;
+}
+
+/*=========================STATUS=========================*/
+void printFleetStatus() {
+    Console.printf("Fleet aggregator: %s, %d of %d peers", enabled ? "on" : "off", getFleetPeerCount(),
+                  FLEET_MAX_PEERS);
+    if (getFleetPeerCount() > 0) {
+        Console.printf(", %.2f ms intervals", linkInterval * 1.25f);
+    }
+    Console.printf("\n  dropped: %lu in the receive buffer, %lu on the uplink\n", (unsigned long)rxDrops,
+                  (unsigned long)relayDrops);
+    for (uint8_t slot = 0; slot < FLEET_MAX_PEERS; slot++) {
+        const FleetPeer& peer = peers[slot];
+        if (peer.connected) {
+            char address[18];
+            formatAddress(peer.address, address, sizeof(address));
+            Console.printf("  peer %d  %s  %lu notifications, %lu bytes\n", slot + 1, address,
+                          (unsigned long)peer.frames, (unsigned long)peer.bytes);
+        }
+    }
+}
+
+/*=========================TASK=========================*/
+void taskFleet(void* parameter) {
+    static uint8_t item[1 + FLEET_NOTIFY_MAX];
+    uint32_t lastScanMs = millis() - FLEET_SCAN_PERIOD_MS;
+    bool connectedPeers[FLEET_MAX_PEERS] = {};
+    Console.println("Fleet task started");
+
+    while (true) {
+        taskWatchdogFeed();
+        size_t size = xMessageBufferReceive(rxBuffer, item, sizeof(item), pdMS_TO_TICKS(FLEET_POLL_MS));
+        while (size > 0) {
+            relay(item, size);
+            size = xMessageBufferReceive(rxBuffer, item, sizeof(item), 0);
+        }
+        sendCommands();
+
+        // A peer went away - the others get its share of the round
+        if (linksChanged) {
+            linksChanged = false;
+            for (uint8_t slot = 0; slot < FLEET_MAX_PEERS; slot++) {
+                if (connectedPeers[slot] && !peers[slot].connected) {
+                    announcePeer(slot, false);
+                }
+            }
+            scheduleLinks();
+        }
+
+        if (!enabled) {
+            dropPeers();
+        } else if (getFleetPeerCount() < FLEET_MAX_PEERS && millis() - lastScanMs >= FLEET_SCAN_PERIOD_MS) {
+            findPeers();
+            lastScanMs = millis();
+        }
+        for (uint8_t slot = 0; slot < FLEET_MAX_PEERS; slot++) {
+            connectedPeers[slot] = peers[slot].connected;
+        }
+    }
+}
+
+#endif // FLEET_AGGREGATOR
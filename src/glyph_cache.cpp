@@ -0,0 +1,99 @@
+#include "glyph_cache.h"
+#include "console.h"
+#include <TFT_eSPI.h>
+
+#define GLYPH_UNCACHED  0xFFFF
+#define GLYPH_FAILED    0xFFFE      // Did not fit - not retried
+
+// Masks packed into the arena, located by font slot and character
+static uint8_t arena[GLYPH_CACHE_BYTES];
+static uint16_t arenaUsed = 0;
+static uint16_t glyphOffset[2][GLYPH_CHAR_COUNT];
+static bool tableReady = false;
+static bool fullReported = false;
+
+static int fontSlot(uint8_t font) {
+    switch (font) {
+        case 2:  return 0;
+        case 4:  return 1;
+        default: return -1;
+    }
+}
+
+/*=========================RASTERIZING=========================*/
+// Font 2 rows are (width + 6) / 8 bytes - the last column is spacing
+static void rasterizeBitmap(const uint8_t* glyph, uint8_t width, uint8_t height, uint8_t* out) {
+    uint8_t inStride = (width + 6) / 8;
+    uint8_t outStride = (width + 7) / 8;
+    for (uint8_t row = 0; row < height; row++) {
+        for (uint8_t i = 0; i < inStride; i++) {
+            out[row * outStride + i] = *glyph++;
+        }
+    }
+}
+
+// RLE bytes: bit 7 set = (b & 0x7F) + 1 set pixels, else b + 1 clear pixels,
+// row-major over the whole cell
+static void rasterizeRLE(const uint8_t* glyph, uint8_t width, uint8_t height, uint8_t* out) {
+    uint8_t outStride = (width + 7) / 8;
+    uint32_t pixels = (uint32_t)width * height;
+    uint32_t pixel = 0;
+    while (pixel < pixels) {
+        uint8_t code = *glyph++;
+        uint32_t run = (code & 0x7F) + 1;
+        if (code & 0x80) {
+            for (uint32_t end = min(pixel + run, pixels); pixel < end; pixel++) {
+                uint8_t x = pixel % width;
+                out[(pixel / width) * outStride + (x >> 3)] |= 0x80 >> (x & 7);
+            }
+        } else {
+            pixel += run;
+        }
+    }
+}
+
+/*=========================LOOKUP=========================*/
+bool getGlyphMask(uint8_t font, uint16_t uniCode, GlyphMask& mask) {
+    int slot = fontSlot(font);
+    if (slot < 0 || uniCode < GLYPH_FIRST_CHAR || uniCode >= GLYPH_FIRST_CHAR + GLYPH_CHAR_COUNT) {
+        return false;
+    }
+    if (!tableReady) {
+        memset(glyphOffset, 0xFF, sizeof(glyphOffset));
+        tableReady = true;
+    }
+
+    uint8_t index = uniCode - GLYPH_FIRST_CHAR;
+    // Flash is memory mapped - the font tables are read in place
+    const uint8_t* glyph = ((const uint8_t* const*)fontdata[font].chartbl)[index];
+    mask.width = fontdata[font].widthtbl[index];
+    mask.height = fontdata[font].height;
+
+    uint16_t& offset = glyphOffset[slot][index];
+    if (offset == GLYPH_FAILED) {
+        return false;
+    }
+    if (offset == GLYPH_UNCACHED) {
+        size_t bytes = ((mask.width + 7) / 8) * mask.height;
+        if (arenaUsed + bytes > GLYPH_CACHE_BYTES) {
+            offset = GLYPH_FAILED;
+            if (!fullReported) {
+                fullReported = true;
+                Console.printf("[GUI] Glyph cache full (%u bytes) - font %d '%c' drawn uncached\n",
+                              (unsigned)arenaUsed, font, (char)uniCode);
+            }
+            return false;
+        }
+        uint8_t* out = arena + arenaUsed;
+        memset(out, 0, bytes);
+        if (font == 2) {
+            rasterizeBitmap(glyph, mask.width, mask.height, out);
+        } else {
+            rasterizeRLE(glyph, mask.width, mask.height, out);
+        }
+        offset = arenaUsed;
+        arenaUsed += bytes;
+    }
+    mask.bits = arena + offset;
+    return true;
+}
@@ -1,13 +1,87 @@
 #include "gui_screens.h"
+#include "console.h"
 #include "defines.h"
+#include "sweep_table.h"
 #include <LittleFS.h>
-#include "logo.h"
+#include "logo_image.h"
+#include "image_codec.h"
+#include "trace.h"
+#include "monitor.h"
+#include "bode_plot.h"
+#include "meas_control.h"
+#include "sweep_eta.h"
+#include "glyph_cache.h"
+#include "heap_stats.h"
+#include "fixed_format.h"
+#include "open_channel.h"
+#include "screen_mirror.h"
+#include "counters.h"
+#include "perf_dashboard.h"
+#include "input_latency.h"
+#include "history_download.h"
+#include <esp_heap_caps.h>
+#include <atomic>
 
 // TFT instance (shared with bode_plot.cpp)
 extern TFT_eSPI tft;
 
-// Sprite for double buffering (full screen)
-TFT_eSprite sprite = TFT_eSprite(&tft);
+// Sprite for double buffering (two strip buffers, see BandSprite)
+BandSprite sprite = BandSprite(&tft);
+
+// Bands go to the panel by SPI DMA when initDMA() succeeds (not 8-bit strips)
+static bool frameDMA = false;
+static bool framePending = false;  // DMA still reads a band, SPI bus held
+
+// Strip tier (GUI task), see RENDER MEMORY
+static RenderTier renderTier = RENDER_TIER_NONE;
+static uint32_t lastTierCheckMs = 0;
+static uint32_t tierDowns = 0;
+static uint32_t tierUps = 0;
+static std::atomic<uint8_t> renderHolds{0};  // holdRenderMemory(), any task
+
+#if GUI_SPRITE_4BIT
+// Expanded band slices for DMA, used alternately across bands
+static uint16_t* sliceBuffer[2] = {nullptr, nullptr};
+static uint8_t nextSlice = 0;
+#endif
+
+// Screen rects [left, right) x [top, bottom) changed since the last frame.
+// Only the bands they touch are drawn and pushed - with 16-bit strips just
+// the rects when narrower than the screen. Kept apart so a title and one
+// tile far below it cost their own areas, not the span between them;
+// overlapping rects, or one more than DIRTY_RECT_MAX, are merged
+#define DIRTY_RECT_MAX  4
+struct DirtyRect {
+    int16_t left, top, right, bottom;
+};
+static DirtyRect dirtyRects[DIRTY_RECT_MAX];
+static uint8_t dirtyCount = 0;
+static uint8_t bandBuffer = 0;      // Strip to draw next - the other one may still be in DMA
+static bool framePartial = false;   // The screen has retained widgets
+static bool frameInvalid = true;    // Panel no longer shows the last frame
+static GUIState pushedState = GUI_SPLASH;
+
+// A frame runs the screen function once to find changed widgets (probe,
+// nothing drawn), then once per band that has to be pushed
+enum FramePhase : uint8_t {
+    FRAME_PROBE,
+    FRAME_DRAW
+};
+static FramePhase framePhase = FRAME_DRAW;
+
+// Last content pushed for one widget
+struct RetainedWidget {
+    bool valid;
+    uint32_t key;                   // Hash of everything the widget shows
+};
+
+// Last progress bar pushed - its fill edge, so an advance marks only the
+// columns it crossed
+struct RetainedBar {
+    bool valid;
+    int16_t fill;                   // Filled columns
+    uint8_t percent;                // Percentage text
+};
 
 // PNG rendering position
 int16_t png_xpos = 0;
@@ -22,63 +96,630 @@ extern bool menuEditMode;
 extern uint8_t currentDUT;
 extern uint8_t totalDUTs;
 extern float progressPercent;
-extern bool dutStatus[4];
+extern bool dutStatus[MAX_DUT_COUNT];
+extern bool resultReady[MAX_DUT_COUNT];
+extern uint8_t overlayDUT;
 
 /*=========================SPRITE INITIALIZATION=========================*/
 
+bool BandSprite::createBands(int16_t width, RenderTier tier) {
+#if GUI_SPRITE_4BIT
+    // One strip: the push has expanded it before the next band is drawn
+    setColorDepth(4);
+    if (createSprite(width, BAND_HEIGHT) == nullptr) {
+        return false;
+    }
+    createPalette(guiPalette, GUI_PALETTE_SIZE);
+    for (int i = 0; i < 256; i++) {
+        // High nibble is the left pixel
+        uint16_t left = guiPalette[i >> 4];
+        uint16_t right = guiPalette[i & 0x0F];
+        pairColors[i] = (uint16_t)(left >> 8 | left << 8) | (uint32_t)(uint16_t)(right >> 8 | right << 8) << 16;
+    }
+    return true;
+#else
+    // The library maps RGB565 colors to RGB332 in 8-bit sprites
+    setColorDepth(tier == RENDER_TIER_8BIT ? 8 : 16);
+    if (createSprite(width, BAND_HEIGHT) == nullptr) {
+        return false;
+    }
+    if (tier != RENDER_TIER_DOUBLE) {
+        return true;
+    }
+    // DMA reads the strips - keep both in internal RAM
+    second = (uint8_t*)heap_caps_calloc(width * BAND_HEIGHT, sizeof(uint16_t), MALLOC_CAP_DMA);
+    if (second == nullptr) {
+        deleteSprite();
+        return false;
+    }
+    return true;
+#endif
+}
+
+void BandSprite::deleteBands() {
+    if (second != nullptr) {
+        heap_caps_free(second);
+        second = nullptr;
+    }
+    deleteSprite();
+}
+
+void BandSprite::selectBand(uint8_t buffer, int16_t top) {
+    _img8 = (buffer && second) ? second : _img8_1;
+    _img = (uint16_t*)_img8;
+    _img4 = _img8;
+    bandTop = top;
+
+    // Screen coordinates: the datum moves row top to sprite row 0
+    _xDatum = 0;
+    _yDatum = -top;
+    _xWidth = _iwidth;
+    _yHeight = BAND_HEIGHT;
+    _vpX = 0;
+    _vpY = 0;
+    _vpW = _iwidth;
+    _vpH = BAND_HEIGHT;
+    _vpDatum = false;
+    _vpOoB = false;
+}
+
+void BandSprite::clipBand(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    _vpX = max(left, (int16_t)0);
+    _vpW = min(right, (int16_t)_iwidth);
+    _vpY = max((int16_t)(top - bandTop), (int16_t)0);
+    _vpH = min((int16_t)(bottom - bandTop), (int16_t)BAND_HEIGHT);
+    _xWidth = _vpW - _vpX;
+    _yHeight = _vpH - _vpY;
+    _vpOoB = _xWidth <= 0 || _yHeight <= 0;
+}
+
+void BandSprite::selectNone() {
+    _vpOoB = true;
+}
+
+const uint16_t* BandSprite::bandPixels(uint8_t buffer) const {
+    return (const uint16_t*)((buffer && second) ? second : _img8_1);
+}
+
+uint16_t* BandSprite::rowPixels(int16_t y) {
+    if (!_created || _bpp != 16 || _vpOoB || y < bandTop || y >= bandTop + BAND_HEIGHT) {
+        return nullptr;
+    }
+    return _img + (y - bandTop) * _iwidth;
+}
+
+int16_t BandSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) {
+    GlyphMask mask;
+    if (textsize != 1 || !getGlyphMask(font, uniCode, mask)) {
+        return TFT_eSprite::drawChar(uniCode, x, y, font);
+    }
+    if (_vpOoB || y >= bandTop + BAND_HEIGHT || y + mask.height <= bandTop) {
+        return mask.width;
+    }
+
+    // Same cell as the library: opaque text fills its background first
+    if (textcolor != textbgcolor) {
+        fillRect(x, y, mask.width, mask.height, textbgcolor);
+    }
+    uint8_t stride = (mask.width + 7) / 8;
+    int32_t firstRow = max((int32_t)0, bandTop - y);
+    int32_t lastRow = min((int32_t)mask.height, bandTop + BAND_HEIGHT - y);
+    for (int32_t row = firstRow; row < lastRow; row++) {
+        const uint8_t* bits = mask.bits + row * stride;
+        int32_t start = -1;
+        for (int32_t col = 0; col <= mask.width; col++) {
+            bool set = col < mask.width && (bits[col >> 3] & (0x80 >> (col & 7)));
+            if (set && start < 0) {
+                start = col;
+            } else if (!set && start >= 0) {
+                drawFastHLine(x + start, y + row, col - start, textcolor);
+                start = -1;
+            }
+        }
+    }
+    return mask.width;
+}
+
+#if GUI_SPRITE_4BIT
+void BandSprite::expandRows(int16_t row, int16_t rows, uint16_t* out) const {
+    const uint8_t* in = _img4 + row * (_iwidth >> 1);
+    uint32_t* pairs = (uint32_t*)out;
+    for (int32_t i = rows * (_iwidth >> 1); i > 0; i--) {
+        *pairs++ = pairColors[*in++];
+    }
+}
+#else
+void BandSprite::expandRows(int16_t row, int16_t rows, uint16_t* out) const {
+    // RGB332, bits repeated into the wider RGB565 fields
+    const uint8_t* in = _img8 + row * _iwidth;
+    for (int32_t i = rows * _iwidth; i > 0; i--) {
+        uint8_t c = *in++;
+        uint16_t r = c >> 5, g = (c >> 2) & 0x07, b = c & 0x03;
+        uint16_t r5 = r << 2 | r >> 1, g6 = g << 3 | g, b5 = b << 3 | b << 1 | b >> 1;
+        uint16_t color = r5 << 11 | g6 << 5 | b5;
+        *out++ = color >> 8 | color << 8;
+    }
+}
+#endif
+
+#if GUI_SPRITE_4BIT
+
+uint8_t BandSprite::paletteIndex(uint32_t color) {
+    if (color < GUI_PALETTE_SIZE) {
+        return color;
+    }
+    if (color == lastColor) {
+        return lastIndex;
+    }
+
+    // Nearest entry, channels scaled to 6 bits
+    int32_t r = (color >> 10) & 0x3E;
+    int32_t g = (color >> 5) & 0x3F;
+    int32_t b = (color << 1) & 0x3E;
+    uint32_t best = UINT32_MAX;
+    for (uint8_t i = 0; i < GUI_PALETTE_SIZE; i++) {
+        int32_t dr = r - ((guiPalette[i] >> 10) & 0x3E);
+        int32_t dg = g - ((guiPalette[i] >> 5) & 0x3F);
+        int32_t db = b - ((guiPalette[i] << 1) & 0x3E);
+        uint32_t distance = dr * dr + dg * dg + db * db;
+        if (distance < best) {
+            best = distance;
+            lastIndex = i;
+        }
+    }
+    lastColor = color;
+    return lastIndex;
+}
+
+void BandSprite::drawPixel(int32_t x, int32_t y, uint32_t color) {
+    TFT_eSprite::drawPixel(x, y, paletteIndex(color));
+}
+
+void BandSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+    TFT_eSprite::drawLine(x0, y0, x1, y1, paletteIndex(color));
+}
+
+void BandSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+    TFT_eSprite::drawFastVLine(x, y, h, paletteIndex(color));
+}
+
+void BandSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+    TFT_eSprite::drawFastHLine(x, y, w, paletteIndex(color));
+}
+
+void BandSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    TFT_eSprite::fillRect(x, y, w, h, paletteIndex(color));
+}
+
+void BandSprite::fillSprite(uint32_t color) {
+    TFT_eSprite::fillSprite(paletteIndex(color));
+}
+
+void BandSprite::setTextColor(uint16_t color) {
+    TFT_eSprite::setTextColor(paletteIndex(color));
+}
+
+void BandSprite::setTextColor(uint16_t fgcolor, uint16_t bgcolor, bool bgfill) {
+    TFT_eSprite::setTextColor(paletteIndex(fgcolor), paletteIndex(bgcolor), bgfill);
+}
+#endif
+
+/*=========================RENDER MEMORY=========================*/
+
+// Bytes a tier allocates, and its largest single block
+static size_t tierBytes(RenderTier tier) {
+    switch (tier) {
+#if GUI_SPRITE_4BIT
+        case RENDER_TIER_4BIT:   return SCREEN_WIDTH * BAND_HEIGHT / 2 + 2 * SCREEN_WIDTH * PALETTE_SLICE_ROWS * 2;
+#else
+        case RENDER_TIER_8BIT:   return SCREEN_WIDTH * BAND_HEIGHT;
+        case RENDER_TIER_SINGLE: return SCREEN_WIDTH * BAND_HEIGHT * 2;
+        case RENDER_TIER_DOUBLE: return 2 * SCREEN_WIDTH * BAND_HEIGHT * 2;
+#endif
+        default:                 return 0;
+    }
+}
+
+static size_t tierBlock(RenderTier tier) {
+#if GUI_SPRITE_4BIT
+    return tier == RENDER_TIER_NONE ? 0 : SCREEN_WIDTH * BAND_HEIGHT / 2;
+#else
+    return tier == RENDER_TIER_DOUBLE ? tierBytes(tier) / 2 : tierBytes(tier);
+#endif
+}
+
+static const char* tierName(RenderTier tier) {
+    switch (tier) {
+#if GUI_SPRITE_4BIT
+        case RENDER_TIER_4BIT:   return "4-bit strip";
+#else
+        case RENDER_TIER_8BIT:   return "8-bit strip";
+        case RENDER_TIER_SINGLE: return "single strip";
+        case RENDER_TIER_DOUBLE: return "double strips";
+#endif
+        default:                 return "none";
+    }
+}
+
+// Whether bands of the current tier go out by DMA
+static bool bandDMA() {
+#if GUI_SPRITE_4BIT
+    // Without slice buffers a 4-bit band is pushed by the CPU
+    return frameDMA && sliceBuffer[0] != nullptr && sliceBuffer[1] != nullptr;
+#else
+    return frameDMA && renderTier != RENDER_TIER_8BIT;
+#endif
+}
+
+// tier fits with RENDER_HEAP_RESERVE bytes to spare once heldBytes (the
+// current tier's) are freed
+static bool tierFits(RenderTier tier, size_t heldBytes) {
+    size_t freeBytes = heap_caps_get_free_size(MALLOC_CAP_DMA) + heldBytes;
+    return freeBytes >= tierBytes(tier) + RENDER_HEAP_RESERVE &&
+           heap_caps_get_largest_free_block(MALLOC_CAP_DMA) + heldBytes >= tierBlock(tier);
+}
+
+// Largest tier up to top that fits, RENDER_TIER_NONE if none does
+static RenderTier fittingTier(RenderTier top, size_t heldBytes) {
+    RenderTier tier = top;
+    while (tier > RENDER_TIER_NONE && !tierFits(tier, heldBytes)) {
+        tier = (RenderTier)(tier - 1);
+    }
+    return tier;
+}
+
+static void freeTier() {
+    finishFramePush();
+    sprite.deleteBands();
+#if GUI_SPRITE_4BIT
+    for (int i = 0; i < 2; i++) {
+        heap_caps_free(sliceBuffer[i]);
+        sliceBuffer[i] = nullptr;
+    }
+#endif
+    renderTier = RENDER_TIER_NONE;
+}
+
+// Allocate tier, or the largest smaller one that can be
+static void allocTier(RenderTier tier) {
+    while (tier > RENDER_TIER_NONE && !sprite.createBands(SCREEN_WIDTH, tier)) {
+        tier = (RenderTier)(tier - 1);
+    }
+#if GUI_SPRITE_4BIT
+    // DMA slices (2 x 320x8x2 = 10,240 bytes)
+    for (int i = 0; tier != RENDER_TIER_NONE && i < 2; i++) {
+        sliceBuffer[i] = (uint16_t*)heap_caps_malloc(SCREEN_WIDTH * PALETTE_SLICE_ROWS * sizeof(uint16_t), MALLOC_CAP_DMA);
+    }
+#endif
+    renderTier = tier;
+}
+
+static void changeTier(RenderTier tier) {
+    RenderTier from = renderTier;
+    freeTier();
+    allocTier(tier);
+    if (renderTier == from) {
+        return;
+    }
+    if (renderTier < from) {
+        tierDowns++;
+    } else {
+        tierUps++;
+    }
+    Console.printf("[GUI] Render memory: %s -> %s, %u bytes free\n", tierName(from), tierName(renderTier),
+                   (unsigned)heap_caps_get_free_size(MALLOC_CAP_DMA));
+    if (from == RENDER_TIER_NONE) {
+        // Frames were skipped - the screen is pushed whole
+        invalidateFrame();
+        requestRender();
+    }
+}
+
+// Between frames: follow the heap and the bulk-transfer holds
+static void updateRenderTier() {
+    bool held = renderHolds > 0 || isHistoryDownloadActive();
+    RenderTier top = held ? RENDER_TIER_MIN : RENDER_TIER_MAX;
+    uint32_t now = millis();
+    // A new hold is served at once, the rest every check period
+    if (renderTier <= top && now - lastTierCheckMs < RENDER_TIER_CHECK_MS) {
+        return;
+    }
+    lastTierCheckMs = now;
+    if (renderTier > top) {
+        changeTier(top);
+    } else if (renderTier > RENDER_TIER_MIN && heap_caps_get_free_size(MALLOC_CAP_DMA) < RENDER_HEAP_LOW) {
+        changeTier((RenderTier)(renderTier - 1));
+    } else if (renderTier < top) {
+        RenderTier tier = fittingTier(top, tierBytes(renderTier));
+        if (tier > renderTier) {
+            changeTier(tier);
+        }
+    }
+}
+
 bool initSpriteBuffer() {
-    Serial.println("[GUI] Initializing sprite buffer...");
+    Console.println("[GUI] Initializing sprite buffer...");
 
     // Print initial heap stats
     printHeapStats();
 
-    // Create sprite buffer (320x240x2 = 153,600 bytes)
-    bool success = sprite.createSprite(SCREEN_WIDTH, SCREEN_HEIGHT);
+    // The largest tier that leaves the reserve, else the smallest that allocates
+    RenderTier tier = fittingTier(RENDER_TIER_MAX, 0);
+    allocTier(tier > RENDER_TIER_NONE ? tier : RENDER_TIER_MIN);
+    bool success = renderTier != RENDER_TIER_NONE;
+    lastTierCheckMs = millis();
+    frameDMA = tft.initDMA();
 
     if (success) {
-        Serial.println("[GUI] Sprite buffer created successfully!");
-        Serial.printf("[GUI] Sprite size: %d x %d = %d bytes\n",
-            SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_WIDTH * SCREEN_HEIGHT * 2);
+        Console.println("[GUI] Sprite buffer created successfully!");
+        Console.printf("[GUI] Sprite bands: %s, %d x %d, %u bytes\n", tierName(renderTier),
+                       SCREEN_WIDTH, BAND_HEIGHT, (unsigned)tierBytes(renderTier));
+        Console.printf("[GUI] Frame push: %s\n", bandDMA() ? "DMA" : "CPU");
         printHeapStats();
     } else {
-        Serial.println("[GUI] ERROR: Failed to create sprite buffer!");
-        Serial.println("[GUI] Falling back to direct rendering (will have flicker)");
+        Console.println("[GUI] ERROR: Failed to create sprite buffer!");
+        Console.println("[GUI] Frames wait until the heap has room for a strip");
     }
 
     return success;
 }
 
-void printHeapStats() {
-    uint32_t freeHeap = ESP.getFreeHeap();
-    uint32_t heapSize = ESP.getHeapSize();
-    uint32_t usedHeap = heapSize - freeHeap;
-    float usedPercent = (float)usedHeap / (float)heapSize * 100.0f;
+RenderTier getRenderTier() {
+    return renderTier;
+}
+
+void holdRenderMemory() {
+    renderHolds++;
+    wakeGUITask(GUI_WAKE_RENDER);
+}
+
+void releaseRenderMemory() {
+    uint8_t holds = renderHolds.load();
+    while (holds > 0 && !renderHolds.compare_exchange_weak(holds, holds - 1)) {
+    }
+}
+
+void printRenderStats() {
+    Console.printf("Render: %s (%u bytes, max %s), push %s, %lu steps down, %lu up%s\n", tierName(renderTier),
+                   (unsigned)tierBytes(renderTier), tierName(RENDER_TIER_MAX), bandDMA() ? "DMA" : "CPU",
+                   (unsigned long)tierDowns, (unsigned long)tierUps,
+                   renderHolds > 0 || isHistoryDownloadActive() ? ", held by a transfer" : "");
+}
+
+/*=========================FRAME PUSH=========================*/
+
+void finishFramePush() {
+    if (framePending) {
+        tft.dmaWait();
+        tft.endWrite();
+        framePending = false;
+    }
+}
+
+void invalidateFrame() {
+    frameInvalid = true;
+}
 
-    Serial.printf("[HEAP] Total: %d bytes, Used: %d bytes (%.1f%%), Free: %d bytes\n",
-        heapSize, usedHeap, usedPercent, freeHeap);
+static DirtyRect unionRect(const DirtyRect& a, const DirtyRect& b) {
+    return {min(a.left, b.left), min(a.top, b.top), max(a.right, b.right), max(a.bottom, b.bottom)};
 }
 
+static int32_t rectArea(const DirtyRect& r) {
+    return (int32_t)(r.right - r.left) * (r.bottom - r.top);
+}
+
+static void markDirtyRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    DirtyRect rect = {max((int16_t)0, x), max((int16_t)0, y),
+                      min((int16_t)SCREEN_WIDTH, (int16_t)(x + w)), min((int16_t)SCREEN_HEIGHT, (int16_t)(y + h))};
+    if (rect.left >= rect.right || rect.top >= rect.bottom) {
+        return;
+    }
+#if GUI_SPRITE_4BIT
+    // Whole bands are pushed - rects sharing a band merge
+    rect = {0, (int16_t)(rect.top / BAND_HEIGHT * BAND_HEIGHT), SCREEN_WIDTH,
+            (int16_t)((rect.bottom + BAND_HEIGHT - 1) / BAND_HEIGHT * BAND_HEIGHT)};
+#endif
+    // Merge with overlapping rects - the union may overlap further ones
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (uint8_t i = 0; i < dirtyCount; i++) {
+            const DirtyRect& r = dirtyRects[i];
+            if (rect.left < r.right && r.left < rect.right && rect.top < r.bottom && r.top < rect.bottom) {
+                rect = unionRect(rect, r);
+                dirtyRects[i] = dirtyRects[--dirtyCount];
+                merged = true;
+                break;
+            }
+        }
+    }
+    if (dirtyCount < DIRTY_RECT_MAX) {
+        dirtyRects[dirtyCount++] = rect;
+        return;
+    }
+    // Full: into the rect that grows least
+    uint8_t best = 0;
+    int32_t bestGrowth = INT32_MAX;
+    for (uint8_t i = 0; i < dirtyCount; i++) {
+        int32_t growth = rectArea(unionRect(dirtyRects[i], rect)) - rectArea(dirtyRects[i]);
+        if (growth < bestGrowth) {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+    dirtyRects[best] = unionRect(dirtyRects[best], rect);
+}
+
+// Called by screens whose changes are all widgetChanged() widgets
+// Returns true while probing - the static chrome can be skipped
+static bool beginPartialFrame() {
+    framePartial = true;
+    return framePhase == FRAME_PROBE;
+}
+
+// Probe: note whether the widget changed (its rect is then pushed), draw nothing
+// Draw: always true - everything inside the pushed rect is drawn
+static bool widgetRectChanged(RetainedWidget& widget, uint32_t key, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (framePhase == FRAME_DRAW) {
+        widget.valid = true;
+        widget.key = key;
+        return true;
+    }
+    if (!widget.valid || widget.key != key) {
+        widget.valid = true;
+        widget.key = key;
+        markDirtyRect(x, y, w, h);
+    }
+    return false;
+}
+
+// Full-width widget rows
+static bool widgetChanged(RetainedWidget& widget, uint32_t key, int16_t y, int16_t h) {
+    return widgetRectChanged(widget, key, 0, y, SCREEN_WIDTH, h);
+}
+
+static int16_t progressFill(int16_t w, float percent) {
+    return (int16_t)((float)w * percent / 100.0f);
+}
+
+// Probe: an advanced fill marks the columns between the old and new edge,
+// a new percentage the text box - a bar not pushed yet is marked whole
+// Draw: always true - everything inside the pushed rect is drawn
+static bool barChanged(RetainedBar& bar, int16_t x, int16_t y, int16_t w, int16_t h, float percent) {
+    int16_t fill = progressFill(w, percent);
+    uint8_t shown = (uint8_t)(percent + 0.5f);
+    if (framePhase == FRAME_PROBE) {
+        if (!bar.valid) {
+            markDirtyRect(x, y, w, h);
+        } else {
+            if (fill != bar.fill) {
+                markDirtyRect(x + min(fill, bar.fill), y, abs(fill - bar.fill), h);
+            }
+            if (shown != bar.percent || (fill > 0) != (bar.fill > 0)) {
+                int16_t textW = sprite.textWidth("100%", 2) + 4;
+                markDirtyRect(x + (w - textW) / 2, y, textW, h);
+            }
+        }
+    }
+    bar.valid = true;
+    bar.fill = fill;
+    bar.percent = shown;
+    return framePhase == FRAME_DRAW;
+}
+
+static uint32_t hashText(const char* text) {
+    uint32_t hash = 2166136261u;    // FNV-1a
+    while (*text) {
+        hash = (hash ^ (uint8_t)*text++) * 16777619u;
+    }
+    return hash;
+}
+
+// Hand the band to the SPI peripheral and return at once - the next band
+// is drawn into the other strip while this one is clocked out
+static void pushBand(uint8_t buffer, int16_t top) {
+    if (!bandDMA()) {
+        sprite.pushSprite(0, top);
+        return;
+    }
+    if (!framePending) {
+        tft.startWrite();
+        framePending = true;
+    }
+#if GUI_SPRITE_4BIT
+    // Each slice is expanded while the previous one is clocked out -
+    // pushImageDMA waits for it before queueing the next
+    for (int16_t row = 0; row < BAND_HEIGHT; row += PALETTE_SLICE_ROWS) {
+        uint16_t* slice = sliceBuffer[nextSlice];
+        nextSlice ^= 1;
+        sprite.expandRows(row, PALETTE_SLICE_ROWS, slice);
+        tft.pushImageDMA(0, top + row, SCREEN_WIDTH, PALETTE_SLICE_ROWS, (const uint16_t*)slice);
+    }
+#else
+    // Waits for the previous band - sprite pixels are stored panel byte
+    // order, the const overload does not swap
+    tft.pushImageDMA(0, top, SCREEN_WIDTH, BAND_HEIGHT, sprite.bandPixels(buffer));
+#endif
+}
+
+#if !GUI_SPRITE_4BIT
+// Push screen rect [left, right) x [top, bottom) of the band at bandTop,
+// one row at a time - the strip rows are SCREEN_WIDTH apart
+static void pushBandRect(uint8_t buffer, int16_t bandTop, int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    int16_t w = right - left;
+    if (!bandDMA()) {
+        sprite.pushSprite(left, top, left, top - bandTop, w, bottom - top);
+        return;
+    }
+    if (!framePending) {
+        tft.startWrite();
+        framePending = true;
+    }
+    const uint16_t* pixels = sprite.bandPixels(buffer) + (top - bandTop) * SCREEN_WIDTH + left;
+    for (int16_t y = top; y < bottom; y++, pixels += SCREEN_WIDTH) {
+        tft.pushImageDMA(left, y, w, 1, pixels);
+    }
+}
+#endif
+
 
 /*=========================HELPER DRAWING FUNCTIONS=========================*/
 
+// Gradient tables, generated at compile time into flash
+constexpr ColorRamp<256> primaryRamp(COLOR_PRIMARY_START, COLOR_PRIMARY_END, false);
+
+constexpr uint16_t guiPalette[GUI_PALETTE_SIZE] = {
+    COLOR_BLACK,
+    COLOR_WHITE,
+    COLOR_BG_LIGHT,
+    COLOR_BG_MEDIUM,
+    COLOR_TEXT_DARK,
+    COLOR_TEXT_GRAY,
+    COLOR_PRIMARY_START,
+    lerpColor256(COLOR_PRIMARY_START, COLOR_PRIMARY_END, LERP_T(0.5)),   // Header and progress gradients
+    COLOR_PRIMARY_END,
+    lerpColor256(COLOR_PRIMARY_START, COLOR_WHITE, LERP_T(0.8)),         // DUT being measured
+    COLOR_SUCCESS,
+    COLOR_DANGER,
+    COLOR_GREEN,
+    COLOR_YELLOW,
+    COLOR_ORANGE,
+    COLOR_RED
+};
+
+// Header gradient row in sprite byte order (swapped RGB565) - copied into
+// every header row instead of 320 column fills per frame
+static constexpr ColorRamp<SCREEN_WIDTH> headerRow(COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
+
 void drawGradientRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color1, uint16_t color2, bool horizontal) {
-    if (horizontal) {
-        // Horizontal gradient
-        for (int16_t i = 0; i < w; i++) {
-            float t = (float)i / (float)w;
-            uint16_t color = lerpColor(color1, color2, t);
+    // The primary ramp is a table lookup
+    bool primary = color1 == COLOR_PRIMARY_START && color2 == COLOR_PRIMARY_END;
+    int16_t steps = horizontal ? w : h;
+    for (int16_t i = 0; i < steps; i++) {
+        int32_t t256 = (int32_t)i * 256 / steps;
+        uint16_t color = primary ? primaryRamp.color[t256] : lerpColor256(color1, color2, t256);
+        if (horizontal) {
             sprite.drawFastVLine(x + i, y, h, color);
-        }
-    } else {
-        // Vertical gradient
-        for (int16_t i = 0; i < h; i++) {
-            float t = (float)i / (float)h;
-            uint16_t color = lerpColor(color1, color2, t);
+        } else {
             sprite.drawFastHLine(x, y + i, w, color);
         }
     }
 }
 
+void drawHeader() {
+    if (sprite.getColorDepth() != 16) {
+        // No RGB565 rows to copy into - the gradient is quantized to the strip's colors
+        drawGradientRect(0, 0, SCREEN_WIDTH, HEADER_HEIGHT, COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
+        return;
+    }
+    for (int16_t row = 0; row < HEADER_HEIGHT; row++) {
+        uint16_t* pixels = sprite.rowPixels(row);
+        if (pixels != nullptr) {
+            memcpy(pixels, headerRow.color, sizeof(headerRow.color));
+        }
+    }
+}
+
 void drawCenteredText(const char* text, int16_t y, uint8_t font, uint16_t color) {
     sprite.setTextColor(color);
     sprite.setTextDatum(TC_DATUM);  // Top center
@@ -116,14 +757,17 @@ void drawProgressBar(int16_t x, int16_t y, int16_t w, int16_t h, float percent)
     sprite.fillRoundRect(x, y, w, h, h/2, COLOR_BG_MEDIUM);
 
     // Calculate fill width
-    int16_t fillWidth = (int16_t)((float)w * percent / 100.0f);
+    int16_t fillWidth = progressFill(w, percent);
     if (fillWidth > 0) {
-        // Draw gradient fill
-        drawGradientRect(x, y, fillWidth, h, COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
+        // Gradient spans the whole bar - the filled columns keep their color
+        // as the fill advances, only the new ones are drawn
+        for (int16_t i = 0; i < fillWidth; i++) {
+            sprite.drawFastVLine(x + i, y, h, primaryRamp.color[(int32_t)i * 256 / w]);
+        }
 
-        // Draw percentage text in center
+        // Draw percentage text in center - rounded as barChanged() keys it
         char percentText[8];
-        snprintf(percentText, sizeof(percentText), "%.0f%%", percent);
+        snprintf(percentText, sizeof(percentText), "%d%%", (int)(percent + 0.5f));
         sprite.setTextColor(COLOR_WHITE);
         sprite.setTextDatum(MC_DATUM);
         sprite.drawString(percentText, x + w/2, y + h/2, 2);
@@ -136,7 +780,7 @@ void drawConnectionIndicator(int16_t x, int16_t y, bool connected) {
 
     // Add subtle glow effect for connected state
     if (connected) {
-        sprite.drawCircle(x, y, 7, lerpColor(COLOR_SUCCESS, COLOR_BG_LIGHT, 0.5));
+        sprite.drawCircle(x, y, 7, lerpColor256(COLOR_SUCCESS, COLOR_BG_LIGHT, LERP_T(0.5)));
     }
 }
 
@@ -144,24 +788,45 @@ void drawConnectionIndicatorDefault(bool connected) {
     drawConnectionIndicator(SCREEN_WIDTH - 20, 25, connected);
 }
 
-void drawDUTStatusGrid(int16_t x, int16_t y) {
-    const int16_t boxSize = 60;
-    const int16_t gap = 10;
-    const int16_t cols = 4;
+// Up to 4 labelled boxes in a row, more channels wrap into rows of 8 numbered ones
+#define DUT_GRID_BOX(compact)   ((compact) ? 28 : 60)
+#define DUT_GRID_GAP(compact)   ((compact) ? 6 : 10)
+#define DUT_GRID_COLS(compact)  ((compact) ? 8 : 4)
 
-    for (uint8_t i = 0; i < totalDUTs; i++) {
-        int16_t boxX = x - (cols * boxSize + (cols - 1) * gap) / 2 + (i) * (boxSize + gap);
-        int16_t boxY = y;
+static int16_t dutStatusGridHeight() {
+    const bool compact = totalDUTs > 4;
+    int16_t rows = (totalDUTs + DUT_GRID_COLS(compact) - 1) / DUT_GRID_COLS(compact);
+    return rows * (DUT_GRID_BOX(compact) + DUT_GRID_GAP(compact));
+}
+
+void drawDUTStatusGrid(int16_t x, int16_t y) {
+    // Each box is its own widget - a DUT finishing pushes two boxes, however
+    // many channels there are
+    static RetainedWidget boxes[MAX_DUT_COUNT];
+    const bool compact = totalDUTs > 4;
+    const int16_t boxSize = DUT_GRID_BOX(compact);
+    const int16_t gap = DUT_GRID_GAP(compact);
+    const int16_t cols = DUT_GRID_COLS(compact);
+
+    for (uint8_t i = 0; i < totalDUTs && i < MAX_DUT_COUNT; i++) {
+        int16_t boxX = x - (cols * boxSize + (cols - 1) * gap) / 2 + (i % cols) * (boxSize + gap);
+        int16_t boxY = y + (i / cols) * (boxSize + gap);
+
+        bool measuring = !dutStatus[i] && i == currentDUT && progressPercent > 0;
+        uint32_t boxKey = dutStatus[i] | measuring << 1 | totalDUTs << 8;
+        if (!widgetRectChanged(boxes[i], boxKey, boxX, boxY, boxSize, boxSize)) {
+            continue;
+        }
 
         // Determine status color
         uint16_t fillColor, borderColor;
         if (dutStatus[i]) {
             // Complete
-            fillColor = lerpColor(COLOR_SUCCESS, COLOR_WHITE, 0.7);
+            fillColor = lerpColor256(COLOR_SUCCESS, COLOR_WHITE, LERP_T(0.7));
             borderColor = COLOR_SUCCESS;
-        } else if (i == currentDUT && progressPercent > 0) {
+        } else if (measuring) {
             // Currently measuring
-            fillColor = lerpColor(COLOR_PRIMARY_START, COLOR_WHITE, 0.8);
+            fillColor = lerpColor256(COLOR_PRIMARY_START, COLOR_WHITE, LERP_T(0.8));
             borderColor = COLOR_PRIMARY_START;
         } else {
             // Pending
@@ -175,11 +840,14 @@ void drawDUTStatusGrid(int16_t x, int16_t y) {
         // Draw DUT label
         sprite.setTextColor(COLOR_TEXT_DARK);
         sprite.setTextDatum(MC_DATUM);
-        sprite.drawString("Sensor", boxX + boxSize/2, boxY + boxSize/2 - 10, 2);
-        
         char numLabel[4];
         snprintf(numLabel, sizeof(numLabel), "%d", i + 1);
-        sprite.drawString(numLabel, boxX + boxSize/2, boxY + boxSize/2 + 10, 2);
+        if (compact) {
+            sprite.drawString(numLabel, boxX + boxSize/2, boxY + boxSize/2, 2);
+        } else {
+            sprite.drawString("Sensor", boxX + boxSize/2, boxY + boxSize/2 - 10, 2);
+            sprite.drawString(numLabel, boxX + boxSize/2, boxY + boxSize/2 + 10, 2);
+        }
     }
 }
 
@@ -227,10 +895,10 @@ static uint16_t riskLevelToColor(RiskLevel r) {
 
 /*=========================SCREEN RENDERING FUNCTIONS=========================*/
 
-void renderCurrentScreen() {
+// Draw the current screen into the selected band
+static void drawScreen() {
     switch (currentGUIState) {
         case GUI_SPLASH:
-            drawSplashScreen();
             break;
         case GUI_HOME:
             drawHomeScreen();
@@ -253,26 +921,253 @@ void renderCurrentScreen() {
         case GUI_RESULTS:
             drawResultsScreen();
             break;
+        case GUI_MONITOR:
+            drawMonitorScreen();
+            break;
+        case GUI_DIAGNOSTICS:
+            drawDiagnosticsScreen();
+            break;
+        case GUI_LIVE_PLOT:
+        case GUI_OVERLAY:
+            break;
+    }
+}
+
+// Hand rows [top, bottom) x [left, right) of the drawn band to the screen
+// mirror, before the push - the strip is redrawn after it
+static void mirrorBand(uint8_t buffer, int16_t bandTop, int16_t top, int16_t bottom, int16_t left, int16_t right) {
+    if (!sprite.created()) {
+        return;
+    }
+#if !GUI_SPRITE_4BIT
+    if (renderTier != RENDER_TIER_8BIT) {
+        mirrorRows(sprite.bandPixels(buffer) + (top - bandTop) * SCREEN_WIDTH, top, bottom - top, left, right);
+        return;
+    }
+#endif
+    uint16_t* rows = getMirrorRowBuffer();
+    for (int16_t y = top; rows != nullptr && y < bottom; y += MIRROR_TILE_H) {
+        sprite.expandRows(y - bandTop, MIRROR_TILE_H, rows);
+        mirrorRows(rows, y, MIRROR_TILE_H, left, right);
+    }
+}
+
+// Draw and push the bands covering screen rows [top, bottom). A rect
+// narrower than the screen is drawn clipped and pushed as just that rect
+// (not with 4-bit strips - the whole band is expanded and pushed)
+static void drawBands(void (*draw)(), int16_t top, int16_t bottom, int16_t left = 0, int16_t right = SCREEN_WIDTH) {
+#if GUI_SPRITE_4BIT
+    bool clip = false;
+#else
+    bool clip = left > 0 || right < SCREEN_WIDTH;
+    // Word-aligned rows for the DMA
+    left &= ~1;
+    right = min((int16_t)((right + 1) & ~1), (int16_t)SCREEN_WIDTH);
+#endif
+    uint8_t& buffer = bandBuffer;
+    for (int16_t bandTop = 0; bandTop < SCREEN_HEIGHT; bandTop += BAND_HEIGHT) {
+        if (bandTop + BAND_HEIGHT <= top || bandTop >= bottom) {
+            continue;
+        }
+#if !GUI_SPRITE_4BIT
+        // One 16-bit strip: the band before must be out before it is redrawn
+        if (renderTier == RENDER_TIER_SINGLE) {
+            finishFramePush();
+        }
+#endif
+        sprite.selectBand(buffer, bandTop);
+#if !GUI_SPRITE_4BIT
+        if (clip) {
+            int16_t rectTop = max(top, bandTop);
+            int16_t rectBottom = min(bottom, (int16_t)(bandTop + BAND_HEIGHT));
+            sprite.clipBand(left, rectTop, right, rectBottom);
+            draw();
+            if (isScreenMirrorActive()) {
+                mirrorBand(buffer, bandTop, rectTop, rectBottom, left, right);
+            }
+            pushBandRect(buffer, bandTop, left, rectTop, right, rectBottom);
+            buffer ^= 1;
+            continue;
+        }
+#endif
+        draw();
+        if (isScreenMirrorActive()) {
+            mirrorBand(buffer, bandTop, bandTop, bandTop + BAND_HEIGHT, 0, SCREEN_WIDTH);
+        }
+        pushBand(buffer, bandTop);
+        buffer ^= 1;
+    }
+}
+
+/*=========================RENDER SCHEDULING=========================*/
+static bool renderPending = false;
+static uint32_t lastRenderMs = 0;
+static bool lastFrameFull = false;     // Every band of the last render was redrawn
+
+void requestRender() {
+    renderPending = true;
+}
+
+bool isRenderPending() {
+    return renderPending;
+}
+
+uint32_t getRenderWaitMs() {
+    uint32_t waitMs = UINT32_MAX;
+    if (renderPending) {
+        uint32_t elapsed = millis() - lastRenderMs;
+        waitMs = elapsed >= GUI_FRAME_MIN_MS ? 0 : GUI_FRAME_MIN_MS - elapsed;
+    }
+    // Below the largest tier the heap is checked for a step up
+    if (renderTier < RENDER_TIER_MAX) {
+        uint32_t elapsed = millis() - lastTierCheckMs;
+        waitMs = min(waitMs, elapsed >= RENDER_TIER_CHECK_MS ? 0 : RENDER_TIER_CHECK_MS - elapsed);
+    }
+    return waitMs;
+}
+
+static FieldHistogram renderUs("gui.render_us", COUNTER_BOUNDS_US);
+
+void processRender() {
+    updateRenderTier();
+    if (renderPending && getRenderWaitMs() == 0) {
+        uint32_t startUs = micros();
+        renderCurrentScreen();
+        renderUs.record(micros() - startUs);
+        inputLatencyFrame(startUs, lastFrameFull);
+    }
+}
+
+void renderCurrentScreen() {
+    trace(TRACE_GUI_RENDER_BEGIN, currentGUIState);
+    // Whatever was requested so far is in this frame
+    renderPending = false;
+    lastRenderMs = millis();
+    // The last band must be out before the strips are redrawn
+    finishFramePush();
+    lastFrameFull = true;
+    if (currentGUIState == GUI_SPLASH) {
+        drawSplashScreen();
+        trace(TRACE_GUI_RENDER_END, currentGUIState);
+        return;
+    }
+    if (currentGUIState == GUI_LIVE_PLOT || currentGUIState == GUI_OVERLAY) {
+        // Laid out by the plot module, pushed through renderFrame()
+        if (currentGUIState == GUI_LIVE_PLOT) {
+            drawLiveBodePlot();
+        } else {
+            drawOverlayPlot(overlayDUT);
+        }
+        trace(TRACE_GUI_RENDER_END, currentGUIState);
+        return;
+    }
+    if (!sprite.created()) {
+        // No strip (RENDER_TIER_NONE) - drawn whole once there is one
+        frameInvalid = true;
+        trace(TRACE_GUI_RENDER_END, currentGUIState);
+        return;
+    }
+
+    // Same screen as on the panel: probe its retained widgets for changes
+    bool full = frameInvalid || pushedState != currentGUIState;
+    dirtyCount = 0;
+    framePartial = false;
+    if (!full) {
+        framePhase = FRAME_PROBE;
+        sprite.selectNone();
+        drawScreen();
+        full = !framePartial;   // No retained widgets - redraw everything
+    }
+    framePhase = FRAME_DRAW;
+    lastFrameFull = full;
+    if (full) {
+        drawBands(drawScreen, 0, SCREEN_HEIGHT);
+    } else {
+        for (uint8_t i = 0; i < dirtyCount; i++) {
+            const DirtyRect& r = dirtyRects[i];
+            drawBands(drawScreen, r.top, r.bottom, r.left, r.right);
+        }
+    }
+    endMirrorFrame();
+    frameInvalid = false;
+    pushedState = currentGUIState;
+    trace(TRACE_GUI_RENDER_END, currentGUIState);
+}
+
+void renderFrame(void (*draw)()) {
+    finishFramePush();
+    if (!sprite.created()) {
+        invalidateFrame();
+        return;
+    }
+    framePhase = FRAME_DRAW;
+    drawBands(draw, 0, SCREEN_HEIGHT);
+    endMirrorFrame();
+    // The GUI screen is not on the panel any more
+    invalidateFrame();
+}
+
+// The logo stream is decoded row by row as the bands are drawn top to
+// bottom, continuing where the previous band stopped
+static ImageDecoder splashDecoder;
+static int16_t splashRow = 0;
+static bool splashValid = false;
+
+// Next logo row into line (panelOrder: byte-swapped, as strips and the
+// panel store pixels); a corrupt stream leaves the primary color
+static void decodeSplashRow(uint16_t* line, bool panelOrder) {
+    splashValid = splashValid && decodeImagePixels(splashDecoder, line, LOGO_WIDTH, panelOrder);
+    if (!splashValid) {
+        uint16_t color = panelOrder ? (uint16_t)(COLOR_PRIMARY_START >> 8 | COLOR_PRIMARY_START << 8)
+                                    : COLOR_PRIMARY_START;
+        for (int16_t x = 0; x < LOGO_WIDTH; x++) {
+            line[x] = color;
+        }
+    }
+}
+
+static void drawSplashBand() {
+    uint16_t line[LOGO_WIDTH];
+    int16_t x0 = (SCREEN_WIDTH - LOGO_WIDTH) / 2;
+    for (int16_t i = 0; i < BAND_HEIGHT && splashRow < LOGO_HEIGHT; i++, splashRow++) {
+        uint16_t* row = sprite.rowPixels(splashRow);
+        if (row != nullptr) {
+            // Straight into the strip - no copy or swap pass
+            decodeSplashRow(row + x0, true);
+            continue;
+        }
+        decodeSplashRow(line, false);
+        // 4- and 8-bit strips: one span per run of equal color (values below
+        // the palette size would pass as indices - they are near black anyway)
+        int16_t start = 0;
+        for (int16_t x = 1; x <= LOGO_WIDTH; x++) {
+            if (x == LOGO_WIDTH || line[x] != line[start]) {
+                uint16_t color = line[start] < 16 ? TFT_BLACK : line[start];
+                sprite.drawFastHLine(x0 + start, splashRow, x - start, color);
+                start = x;
+            }
+        }
     }
 }
 
 void drawSplashScreen() {
-    // Clear screen with gradient background
-    // drawGradientRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, COLOR_PRIMARY_START, COLOR_PRIMARY_END, false);
-
-    // sprite.pushSprite(0, 0);  
-    // Display logo centered                       │
-    int16_t x = (SCREEN_WIDTH - LOGO_WIDTH) / 2;   
-    int16_t y = 0;  // Position from top          
-    tft.setSwapBytes(true);
-    tft.pushImage(x, y, LOGO_WIDTH, LOGO_HEIGHT,logo);    
-    tft.setSwapBytes(false);                                        
-                                                    
-    // Subtitle                                    
-    // sprite.setTextColor(COLOR_WHITE);              
-    // sprite.setTextDatum(TC_DATUM);                 
-    // sprite.drawString("Impedance Analyzer",SCREEN_WIDTH/2, SCREEN_HEIGHT - 40, 2);            
-             
+    beginImageDecode(splashDecoder, logoData, LOGO_DATA_SIZE);
+    splashRow = 0;
+    splashValid = true;
+    if (sprite.created()) {
+        renderFrame(drawSplashBand);
+    } else {
+        // No strips - push the logo line by line, already in panel order
+        uint16_t line[LOGO_WIDTH];
+        for (int16_t y = 0; y < LOGO_HEIGHT; y++) {
+            decodeSplashRow(line, true);
+            tft.pushImage((SCREEN_WIDTH - LOGO_WIDTH) / 2, y, LOGO_WIDTH, 1, line);
+        }
+        invalidateFrame();
+    }
+    if (!splashValid) {
+        Console.println("[GUI] Splash logo stream is corrupt");
+    }
 }
 
 void drawHomeScreen() {
@@ -280,7 +1175,7 @@ void drawHomeScreen() {
     sprite.fillSprite(COLOR_WHITE);
 
     // Draw header with gradient
-    drawGradientRect(0, 0, SCREEN_WIDTH, 50, COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
+    drawHeader();
 
     // Draw title
     sprite.setTextColor(COLOR_WHITE);
@@ -321,9 +1216,6 @@ void drawHomeScreen() {
 
     drawButton(btn1X, btnY, btnW, btnH, "START", startHighlighted, false);
     drawButton(btn2X, btnY, btnW, btnH, "SETTINGS", settingsHighlighted, false);
-
-    // Push sprite to screen
-    sprite.pushSprite(0, 0);
 }
 
 void drawSettingsScreen() {
@@ -331,7 +1223,7 @@ void drawSettingsScreen() {
     sprite.fillSprite(COLOR_WHITE);
 
     // Draw header
-    drawGradientRect(0, 0, SCREEN_WIDTH, 50, COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
+    drawHeader();
     sprite.setTextColor(COLOR_WHITE);
     sprite.setTextDatum(MC_DATUM);
     sprite.drawString("Settings", SCREEN_WIDTH/2, 25, 4);
@@ -366,17 +1258,85 @@ void drawSettingsScreen() {
     sprite.setTextColor(COLOR_TEXT_GRAY);
     sprite.setTextDatum(TC_DATUM);
     sprite.drawString("Rotate: Navigate | Select: Toggle", SCREEN_WIDTH/2, SCREEN_HEIGHT - 20, 1);
+}
 
-    // Push sprite to screen
-    sprite.pushSprite(0, 0);
+// Custom range picker: one retained widget per visible row, so an encoder
+// step pushes only the bands of the row left and the row entered. The labels
+// come pre-rendered from the sweep table (sweep_table.h)
+#define FREQ_LIST_X         10
+#define FREQ_LIST_Y         (HEADER_HEIGHT + 10)
+#define FREQ_LIST_ROW_H     20
+#define FREQ_LIST_ROWS      8
+
+static uint8_t freqListTop = 0;     // Sweep index of the first visible row
+
+// Scroll the window just far enough to show the highlighted index
+static void scrollFreqList(uint8_t cursor) {
+    if (cursor < freqListTop) {
+        freqListTop = cursor;
+    } else if (cursor >= freqListTop + FREQ_LIST_ROWS) {
+        freqListTop = cursor - FREQ_LIST_ROWS + 1;
+    }
+    freqListTop = min(freqListTop, (uint8_t)(SWEEP_FREQ_COUNT - FREQ_LIST_ROWS));
+}
+
+static void drawFreqListRow(uint8_t idx, int16_t y, bool highlighted, bool inRange, bool isStart) {
+    uint16_t bg = highlighted ? COLOR_BG_MEDIUM : inRange ? COLOR_BG_LIGHT : COLOR_WHITE;
+    sprite.fillRect(FREQ_LIST_X, y, SCREEN_WIDTH - 2 * FREQ_LIST_X, FREQ_LIST_ROW_H, bg);
+    sprite.setTextColor(COLOR_TEXT_DARK);
+    sprite.setTextDatum(MR_DATUM);
+    sprite.drawString(getSweepFreqLabel(idx), SCREEN_WIDTH/2, y + FREQ_LIST_ROW_H/2, 2);
+    sprite.setTextDatum(ML_DATUM);
+    sprite.drawString("Hz", SCREEN_WIDTH/2 + 6, y + FREQ_LIST_ROW_H/2, 2);
+    if (isStart) {
+        sprite.setTextColor(COLOR_TEXT_GRAY);
+        sprite.setTextDatum(MR_DATUM);
+        sprite.drawString("start", SCREEN_WIDTH - FREQ_LIST_X - 8, y + FREQ_LIST_ROW_H/2, 2);
+    }
+}
+
+static void drawFreqPicker() {
+    static RetainedWidget rows[FREQ_LIST_ROWS];
+    bool pickEnd = freqPickStage == FREQ_PICK_END;
+    uint8_t cursor = min(menuSelection, (uint8_t)SWEEP_FREQ_LAST);
+    scrollFreqList(cursor);
+
+    // Header and hint - the stage only changes with a full frame
+    if (!beginPartialFrame()) {
+        sprite.fillSprite(COLOR_WHITE);
+        drawHeader();
+        sprite.setTextColor(COLOR_WHITE);
+        sprite.setTextDatum(MC_DATUM);
+        sprite.drawString(pickEnd ? "End Frequency" : "Start Frequency", SCREEN_WIDTH/2, 25, 4);
+        sprite.setTextColor(COLOR_TEXT_GRAY);
+        sprite.setTextDatum(TC_DATUM);
+        sprite.drawString("Rotate: Scroll | Select: Set | Left: Back", SCREEN_WIDTH/2, SCREEN_HEIGHT - 14, 1);
+    }
+
+    for (uint8_t r = 0; r < FREQ_LIST_ROWS; r++) {
+        uint8_t idx = freqListTop + r;
+        int16_t y = FREQ_LIST_Y + r * FREQ_LIST_ROW_H;
+        bool highlighted = idx == cursor;
+        bool inRange = pickEnd && idx >= selectedStartFreq && idx <= cursor;
+        bool isStart = pickEnd && idx == selectedStartFreq;
+        uint32_t key = idx | highlighted << 8 | inRange << 9 | isStart << 10;
+        if (widgetChanged(rows[r], key, y, FREQ_LIST_ROW_H)) {
+            drawFreqListRow(idx, y, highlighted, inRange, isStart);
+        }
+    }
 }
 
 void drawFreqOverrideScreen() {
+    if (menuEditMode) {
+        drawFreqPicker();
+        return;
+    }
+
     // Clear screen
     sprite.fillSprite(COLOR_WHITE);
 
     // Draw header
-    drawGradientRect(0, 0, SCREEN_WIDTH, 50, COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
+    drawHeader();
     sprite.setTextColor(COLOR_WHITE);
     sprite.setTextDatum(MC_DATUM);
     sprite.drawString("Frequency Range", SCREEN_WIDTH/2, 25, 4);
@@ -386,6 +1346,18 @@ void drawFreqOverrideScreen() {
     sprite.setTextDatum(TC_DATUM);
     sprite.drawString("Use default range?", SCREEN_WIDTH/2, 80, 2);
 
+    // Last custom range - built when it changes, not per band
+    static char range[32];
+    static uint16_t rangeKey = 0xFFFF;
+    uint16_t key = guiSettings.startFreqIndex | guiSettings.endFreqIndex << 8;
+    if (key != rangeKey) {
+        snprintf(range, sizeof(range), "Custom: %s - %s Hz", getSweepFreqLabel(guiSettings.startFreqIndex),
+                 getSweepFreqLabel(guiSettings.endFreqIndex));
+        rangeKey = key;
+    }
+    sprite.setTextColor(COLOR_TEXT_GRAY);
+    sprite.drawString(range, SCREEN_WIDTH/2, 102, 2);
+
     // Buttons
     int16_t btnY = 130;
     int16_t btnW = 130;
@@ -396,42 +1368,52 @@ void drawFreqOverrideScreen() {
 
     drawButton(btn1X, btnY, btnW, btnH, "DEFAULT", menuSelection == 0, false);
     drawButton(btn2X, btnY, btnW, btnH, "CUSTOM", menuSelection == 1, false);
-
-    // Push sprite to screen
-    sprite.pushSprite(0, 0);
 }
 
 void drawProgressScreen(bool isBaseline) {
-    // Clear screen
-    sprite.fillSprite(COLOR_WHITE);
-
-    // Draw header
-    drawGradientRect(0, 0, SCREEN_WIDTH, 50, COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
-    sprite.setTextColor(COLOR_WHITE);
-    sprite.setTextDatum(MC_DATUM);
-    sprite.drawString(isBaseline ? "Baseline Measurement" : "Final Measurement", SCREEN_WIDTH/2, 25, 4);
+    // Progress updates redraw and push only the bands of widgets that changed
+    static RetainedWidget grid, status;
+    static RetainedBar bar;
+    if (!beginPartialFrame()) {
+        // Clear screen
+        sprite.fillSprite(COLOR_WHITE);
+
+        // Draw header
+        drawHeader();
+        sprite.setTextColor(COLOR_WHITE);
+        sprite.setTextDatum(MC_DATUM);
+        sprite.drawString(isBaseline ? "Baseline Measurement" : "Final Measurement", SCREEN_WIDTH/2, 25, 4);
+    }
 
-    // Progress bar
-    drawProgressBar(20, 70, SCREEN_WIDTH - 40, 30, progressPercent);
+    // Progress bar - advances per stored point, pushing only the new columns
+    const int16_t barW = SCREEN_WIDTH - 40;
+    if (barChanged(bar, 20, 70, barW, 30, progressPercent)) {
+        drawProgressBar(20, 70, barW, 30, progressPercent);
+    }
 
-    // DUT status grid
+    // DUT status grid - the whole area only when its layout changes
+    widgetChanged(grid, totalDUTs, 120, dutStatusGridHeight());
     drawDUTStatusGrid(160, 120);
 
-    // Current status text
-    char statusText[32];
+    // Current status text - with the time left once the sweep runs
+    char statusText[40];
+    uint32_t etaS = (estimateSweepRemainingMs(totalDUTs) + 999) / 1000;
     if (progressPercent >= 100.0f) {
         snprintf(statusText, sizeof(statusText), "Complete!");
+    } else if (currentDUT < totalDUTs && etaS > 0) {
+        snprintf(statusText, sizeof(statusText), "Sensor %d/%d - about %lu:%02lu left",
+                 currentDUT + 1, totalDUTs, (unsigned long)(etaS / 60), (unsigned long)(etaS % 60));
     } else if (currentDUT < totalDUTs) {
         snprintf(statusText, sizeof(statusText), "Sensor %d/%d - Measuring...", currentDUT + 1, totalDUTs);
     } else {
         snprintf(statusText, sizeof(statusText), "Initializing...");
     }
-    sprite.setTextColor(COLOR_TEXT_DARK);
-    sprite.setTextDatum(TC_DATUM);
-    sprite.drawString(statusText, SCREEN_WIDTH/2, SCREEN_HEIGHT - 25, 2);
-
-    // Push sprite to screen
-    sprite.pushSprite(0, 0);
+    if (widgetChanged(status, hashText(statusText), SCREEN_HEIGHT - 25, 16)) {
+        sprite.fillRect(0, SCREEN_HEIGHT - 25, SCREEN_WIDTH, 16, COLOR_WHITE);
+        sprite.setTextColor(COLOR_TEXT_DARK);
+        sprite.setTextDatum(TC_DATUM);
+        sprite.drawString(statusText, SCREEN_WIDTH/2, SCREEN_HEIGHT - 25, 2);
+    }
 }
 
 void drawBaselineCompleteScreen() {
@@ -439,7 +1421,7 @@ void drawBaselineCompleteScreen() {
     sprite.fillSprite(COLOR_WHITE);
 
     // Draw header
-    drawGradientRect(0, 0, SCREEN_WIDTH, 50, COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
+    drawHeader();
     sprite.setTextColor(COLOR_WHITE);
     sprite.setTextDatum(MC_DATUM);
     sprite.drawString("Baseline Complete", SCREEN_WIDTH/2, 25, 4);
@@ -454,25 +1436,35 @@ void drawBaselineCompleteScreen() {
 
     // Button
     drawButton(60, 185, SCREEN_WIDTH - 120, 45, "START FINAL", true, true);
-
-    // Push sprite to screen
-    sprite.pushSprite(0, 0);
 }
 
-void drawResultsScreen() {
-    // Clear screen
-    sprite.fillSprite(COLOR_WHITE);
-
-    // Draw header
-    drawGradientRect(0, 0, SCREEN_WIDTH, 50, COLOR_PRIMARY_START, COLOR_PRIMARY_END, true);
-    sprite.setTextColor(COLOR_WHITE);
-    sprite.setTextDatum(MC_DATUM);
-    sprite.drawString("Measurement Complete", SCREEN_WIDTH/2, 25, 4);
+// Risk grid shared by the results and monitor screens
+// partial: boxes of DUTs without resultReady show them still being measured
+static void drawRiskScreen(const char* title, const char* buttonText, bool partial) {
+    // A result arriving redraws and pushes only its own box
+    static RetainedWidget titleBar, button, boxes[MAX_DUT_COUNT];
+    if (!beginPartialFrame()) {
+        // Clear screen
+        sprite.fillSprite(COLOR_WHITE);
+
+        // Draw header
+        drawHeader();
+    }
+    if (widgetChanged(titleBar, hashText(title), 0, HEADER_HEIGHT)) {
+        sprite.setTextColor(COLOR_WHITE);
+        sprite.setTextDatum(MC_DATUM);
+        sprite.drawString(title, SCREEN_WIDTH/2, 25, 4);
+    }
 
     // 2x2 grid of DUT blocks replacing the checkmark/Done area
-    const int maxCols = 2;
-    const int maxRows = 2;
-    const int16_t padding = 12;
+    // More channels get a 4-wide grid of single-line blocks, past 8 packed
+    // into heatmap tiles - shade deepening with the percentage
+    const bool compact = totalDUTs > 4;
+    const bool tiles = totalDUTs > 8;
+    const int maxCols = compact ? 4 : 2;
+    const int maxRows = compact ? (totalDUTs + maxCols - 1) / maxCols : 2;
+    const int16_t padding = tiles ? 4 : 12;
+    const int16_t radius = tiles ? 4 : 8;
     // Compute available area beneath header and above button
     const int16_t areaTop = 60;
     const int16_t areaBottom = SCREEN_HEIGHT - 60; // leave room for button
@@ -491,11 +1483,55 @@ void drawResultsScreen() {
         int16_t boxX = startX + col * (boxW + padding);
         int16_t boxY = startY + row * (boxH + padding);
 
+        // Keyed on what the box shows
+        bool pending = partial && !resultReady[i];
+        bool empty = !pending && isChannelOpen(i);
+        float p = riskPercentages[i];
+        if (isnan(p)) p = 0.0f;
+        if (p < 0.0f) p = 0.0f;
+        if (p > 100.0f) p = 100.0f;
+        uint32_t boxKey = pending ? UINT32_MAX : empty ? UINT32_MAX - 1
+                        : (uint32_t)riskLevels[i] | (uint32_t)(p + 0.5f) << 8 | totalDUTs << 16;
+        if (!widgetRectChanged(boxes[i], boxKey, boxX, boxY, boxW, boxH)) {
+            continue;
+        }
+
+        if (pending) {
+            // Still being measured - filled in once its DUT_END is processed
+            drawRoundRect(boxX, boxY, boxW, boxH, radius, COLOR_BG_LIGHT, COLOR_BG_MEDIUM);
+            char pendingText[24];
+            snprintf(pendingText, sizeof(pendingText), compact ? "%d ..." : "Sensor %d ...", i + 1);
+            sprite.setTextDatum(MC_DATUM);
+            sprite.setTextColor(COLOR_TEXT_GRAY);
+            sprite.drawString(pendingText, boxX + boxW / 2, boxY + boxH / 2, 2);
+            continue;
+        }
+        if (empty) {
+            // Empty slot (open_channel.h) - no risk to show
+            drawRoundRect(boxX, boxY, boxW, boxH, radius, COLOR_BG_LIGHT, COLOR_BG_MEDIUM);
+            char emptyText[24];
+            snprintf(emptyText, sizeof(emptyText), compact ? "%d empty" : "Sensor %d empty", i + 1);
+            sprite.setTextDatum(MC_DATUM);
+            sprite.setTextColor(COLOR_TEXT_GRAY);
+            sprite.drawString(emptyText, boxX + boxW / 2, boxY + boxH / 2, 2);
+            continue;
+        }
+
         // Fill block with risk color (slightly desaturated background)
         uint16_t baseColor = riskLevelToColor(riskLevels[i]);
         // create a softer background by blending with white
-        uint16_t bgColor = lerpColor(baseColor, COLOR_WHITE, 0.55);
-        drawRoundRect(boxX, boxY, boxW, boxH, 8, bgColor, baseColor);
+        uint16_t bgColor = lerpColor256(baseColor, COLOR_WHITE,
+                                        tiles ? LERP_T(0.75) - (int32_t)(p * 1.5f) : LERP_T(0.55));
+        drawRoundRect(boxX, boxY, boxW, boxH, radius, bgColor, baseColor);
+
+        if (compact) {
+            char compactText[24];
+            snprintf(compactText, sizeof(compactText), "%d %s", i + 1, riskLevelToString(riskLevels[i]));
+            sprite.setTextDatum(MC_DATUM);
+            sprite.setTextColor(COLOR_TEXT_DARK);
+            sprite.drawString(compactText, boxX + boxW / 2, boxY + boxH / 2, 2);
+            continue;
+        }
 
         // Inner padding for text
         const int16_t tx = boxX + 10;
@@ -509,19 +1545,113 @@ void drawResultsScreen() {
         sprite.drawString(dutLabel, tx, ty, 2);
 
         // Risk level text with percentage in brackets
-        float p = riskPercentages[i];
-        if (isnan(p)) p = 0.0f;
-        if (p < 0.0f) p = 0.0f;
-        if (p > 100.0f) p = 100.0f;
         char riskText[24];
-        snprintf(riskText, sizeof(riskText), "%s (%.0f%%)", riskLevelToString(riskLevels[i]), p);
+        char pct[FIXED_FORMAT_BUFFER];
+        snprintf(riskText, sizeof(riskText), "%s (%s%%)", riskLevelToString(riskLevels[i]), fixedText(pct, p, 0));
         sprite.setTextDatum(ML_DATUM);
         sprite.drawString(riskText, tx, ty + 20, 2);
     }
 
-    // Bottom button: New Test
-    drawButton(60, SCREEN_HEIGHT - 40, SCREEN_WIDTH - 120, 36, "NEW TEST", true, false);
+    // Bottom button
+    if (widgetChanged(button, hashText(buttonText), SCREEN_HEIGHT - 40, 36)) {
+        drawButton(60, SCREEN_HEIGHT - 40, SCREEN_WIDTH - 120, 36, buttonText, true, false);
+    }
+}
 
-    // Push sprite to screen
-    sprite.pushSprite(0, 0);
+void drawResultsScreen() {
+    // Opened with the first result of a final sweep - the others fill in
+    // as their DUTs finish
+    if (getMeasurementState() == MEAS_IDLE) {
+        drawRiskScreen("Measurement Complete", "NEW TEST", false);
+        return;
+    }
+    uint8_t ready = 0;
+    for (uint8_t i = 0; i < totalDUTs && i < MAX_DUT_COUNT; i++) {
+        ready += resultReady[i];
+    }
+    char title[32];
+    snprintf(title, sizeof(title), "Results %u/%u", ready, totalDUTs);
+    drawRiskScreen(title, "STOP", true);
+}
+
+void drawMonitorScreen() {
+    char title[32];
+    snprintf(title, sizeof(title), "Monitoring #%lu", (unsigned long)getMonitorSweepCount());
+    drawRiskScreen(title, "STOP", false);
+}
+
+// Diagnostics: one retained widget per text row, so a refresh pushes only
+// the rows whose numbers changed - inset from the edges, so as clipped
+// rects of their own height instead of whole bands
+#define DIAG_ROW_Y          (HEADER_HEIGHT + 4)
+#define DIAG_ROW_H          16
+#define DIAG_ROW_X          4
+#define DIAG_VALUE_X        70
+#define DIAG_CPU_X          164     // Second task column
+#define DIAG_STAT_ROWS      5
+#define DIAG_ROWS           (DIAG_STAT_ROWS + (TASK_MONITOR_MAX + 1) / 2)
+
+static void drawDiagRow(RetainedWidget& widget, int16_t y, const char* left, uint16_t leftColor,
+                        const char* right, int16_t rightX) {
+    const int16_t w = SCREEN_WIDTH - 2 * DIAG_ROW_X;
+    if (!widgetRectChanged(widget, hashText(left) * 31 + hashText(right), DIAG_ROW_X, y, w, DIAG_ROW_H)) {
+        return;
+    }
+    sprite.fillRect(DIAG_ROW_X, y, w, DIAG_ROW_H, COLOR_WHITE);
+    sprite.setTextDatum(TL_DATUM);
+    sprite.setTextColor(leftColor);
+    sprite.drawString(left, 8, y, 2);
+    sprite.setTextColor(COLOR_TEXT_DARK);
+    sprite.drawString(right, rightX, y, 2);
+}
+
+void drawDiagnosticsScreen() {
+    static RetainedWidget rows[DIAG_ROWS];
+    if (!beginPartialFrame()) {
+        sprite.fillSprite(COLOR_WHITE);
+        drawHeader();
+        sprite.setTextColor(COLOR_WHITE);
+        sprite.setTextDatum(MC_DATUM);
+        sprite.drawString("Diagnostics", SCREEN_WIDTH/2, 25, 4);
+    }
+
+    const PerfSnapshot& s = getPerfSnapshot();
+    char text[48];
+    int16_t y = DIAG_ROW_Y;
+    snprintf(text, sizeof(text), "%lu frames/s  err %lu  lost %lu", (unsigned long)s.uartFramesPerS,
+             (unsigned long)s.uartErrors, (unsigned long)s.uartLost);
+    drawDiagRow(rows[0], y, "UART", COLOR_TEXT_GRAY, text, DIAG_VALUE_X);
+    y += DIAG_ROW_H;
+    snprintf(text, sizeof(text), "batch %lu/%d  cmd %lu/%d  BLE %lu B", (unsigned long)s.batchesQueued,
+             MEASUREMENT_BATCH_POOL, (unsigned long)s.commandsQueued, UART_CMD_REQUEST_QUEUE_DEPTH,
+             (unsigned long)s.bleTxQueued);
+    drawDiagRow(rows[1], y, "Queues", COLOR_TEXT_GRAY, text, DIAG_VALUE_X);
+    y += DIAG_ROW_H;
+    snprintf(text, sizeof(text), "%lu KB free  min %lu  block %lu", (unsigned long)(s.heapFree / 1024),
+             (unsigned long)(s.heapMin / 1024), (unsigned long)(s.heapLargest / 1024));
+    drawDiagRow(rows[2], y, "Heap", COLOR_TEXT_GRAY, text, DIAG_VALUE_X);
+    y += DIAG_ROW_H;
+    snprintf(text, sizeof(text), "%lu B/s  err %lu", (unsigned long)s.bleBytesPerS, (unsigned long)s.bleErrors);
+    drawDiagRow(rows[3], y, "BLE", COLOR_TEXT_GRAY, text, DIAG_VALUE_X);
+    y += DIAG_ROW_H;
+    snprintf(text, sizeof(text), "%lu.%lu ms  max %lu.%lu ms", (unsigned long)(s.renderUs / 1000),
+             (unsigned long)(s.renderUs / 100 % 10), (unsigned long)(s.renderMaxUs / 1000),
+             (unsigned long)(s.renderMaxUs / 100 % 10));
+    drawDiagRow(rows[4], y, "Render", COLOR_TEXT_GRAY, text, DIAG_VALUE_X);
+    y += DIAG_ROW_H;
+
+    // CPU per table task, two to a row
+    if (s.taskCount == 0) {
+        drawDiagRow(rows[DIAG_STAT_ROWS], y, "CPU", COLOR_TEXT_GRAY, "n/a - no run-time stats", DIAG_VALUE_X);
+        return;
+    }
+    for (uint8_t i = 0; i < s.taskCount; i += 2) {
+        char right[24] = "";
+        snprintf(text, sizeof(text), "%s %u%%", s.tasks[i].name, s.tasks[i].percent);
+        if (i + 1 < s.taskCount) {
+            snprintf(right, sizeof(right), "%s %u%%", s.tasks[i + 1].name, s.tasks[i + 1].percent);
+        }
+        drawDiagRow(rows[DIAG_STAT_ROWS + i / 2], y, text, COLOR_TEXT_DARK, right, DIAG_CPU_X);
+        y += DIAG_ROW_H;
+    }
 }
@@ -1,7 +1,20 @@
 #include "gui_state.h"
+#include "console.h"
 #include "gui_screens.h"
 #include "UART_Functions.h"
 #include "defines.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "sweep_eta.h"
+#include "monitor.h"
+#include "meas_control.h"
+#include "cal_acquire.h"
+#include "bode_plot.h"
+#include "trace.h"
+#include "storage.h"
+#include "crc.h"
+#include "display_power.h"
+#include "perf_dashboard.h"
 #include <LittleFS.h>
 #include <FS.h>
 
@@ -17,14 +30,15 @@ GUIState currentGUIState = GUI_SPLASH;
 GUISettings guiSettings = {
     .useCustomFreqRange = false,  // Default: full range
     .startFreqIndex = 0,
-    .endFreqIndex = 37,           // Full range by default
+    .endFreqIndex = SWEEP_FREQ_LAST,  // Full range by default
     .defaultDUTCount = 4
 };
 
 // User selections (current session)
 uint8_t selectedDUTCount = 4;
 uint8_t selectedStartFreq = 0;
-uint8_t selectedEndFreq = 37;
+uint8_t selectedEndFreq = SWEEP_FREQ_LAST;
+FreqPickStage freqPickStage = FREQ_PICK_START;
 
 // UI state
 uint8_t menuSelection = 0;
@@ -34,101 +48,189 @@ bool menuEditMode = false;
 uint8_t currentDUT = 0;
 uint8_t totalDUTs = 0;
 float progressPercent = 0.0f;
-bool dutStatus[4] = {false, false, false, false};
+bool dutStatus[MAX_DUT_COUNT] = {};
+bool resultReady[MAX_DUT_COUNT] = {};
+uint8_t overlayDUT = 0;
 
 // Button event queue
 QueueHandle_t buttonEventQueue = nullptr;
+static uint8_t buttonEventStorage[BUTTON_EVENT_QUEUE_DEPTH * sizeof(ButtonInput)];
+static StaticQueue_t buttonEventControl;
+
+// Events posted by other contexts (postGUIEvent)
+static QueueHandle_t guiEventQueue = nullptr;
+static uint8_t guiEventStorage[GUI_EVENT_QUEUE_DEPTH * sizeof(GUIEvent)];
+static StaticQueue_t guiEventControl;
+
+// Notified by wakeGUITask (registerGUITask)
+static TaskHandle_t guiTask = nullptr;
+
+// Progress screen the live plot was opened from
+static GUIState liveReturnState = GUI_BASELINE_PROGRESS;
+
+// The results screen opened early in this sweep / is left for the progress screen
+static bool resultsShownEarly = false;
+static bool resultsReturn = false;
 
 // External measurement state variables (from main.cpp)
-extern bool measurementInProgress;
-extern bool baselineMeasurementDone;
-extern bool finalMeasurementDone;
 extern uint8_t num_duts;
-extern uint8_t startIDX;
-extern uint8_t endIDX;
 
 /*=========================SETTINGS PERSISTENCE=========================*/
 
 #define SETTINGS_FILE "/gui_settings.dat"
 
+static GUISettings flashSettings;       // What the settings file holds
+static bool saveScheduled = false;
+static uint32_t saveChangedMs = 0;      // Last saveGUISettings() that found a change
+
+static uint16_t settingsCrc(const GUISettingsRecord& record, const uint8_t* settings, size_t size) {
+    uint16_t crc = crc16_ccitt((const uint8_t*)&record, sizeof(record));
+    return crc16_ccitt(settings, size, crc);
+}
+
+static bool settingsValid(const GUISettings& settings) {
+    return settings.startFreqIndex <= settings.endFreqIndex && settings.endFreqIndex < SWEEP_FREQ_COUNT &&
+           settings.defaultDUTCount >= 1 && settings.defaultDUTCount <= MAX_DUT_COUNT;
+}
+
+// Settings of a record into out (the fields the record has); false if damaged
+static bool readSettingsRecord(fs::File& file, GUISettings& out) {
+    static uint8_t stored[255];     // Settings of a newer firmware may be larger
+    GUISettingsRecord record;
+    uint16_t crc;
+    if (file.read((uint8_t*)&record, sizeof(record)) != sizeof(record) || record.magic != GUI_SETTINGS_MAGIC ||
+        record.size == 0 || record.size > sizeof(stored) ||
+        file.read(stored, record.size) != record.size ||
+        file.read((uint8_t*)&crc, sizeof(crc)) != sizeof(crc) || crc != settingsCrc(record, stored, record.size)) {
+        return false;
+    }
+    memcpy(&out, stored, min((size_t)record.size, sizeof(GUISettings)));
+    if (record.version != GUI_SETTINGS_VERSION) {
+        Console.printf("[GUI] Settings record v%d read by v%d\n", record.version, GUI_SETTINGS_VERSION);
+    }
+    return true;
+}
+
 bool loadGUISettings() {
-    if (!LittleFS.begin()) {
-        Serial.println("[GUI] Failed to mount LittleFS");
+    flashSettings = guiSettings;
+    if (!isStorageMounted()) {
+        Console.println("[GUI] LittleFS not mounted");
         return false;
     }
 
     if (!LittleFS.exists(SETTINGS_FILE)) {
-        Serial.println("[GUI] No saved settings found, using defaults");
+        Console.println("[GUI] No saved settings found, using defaults");
         return false;
     }
 
     fs::File file = LittleFS.open(SETTINGS_FILE, "r");
     if (!file) {
-        Serial.println("[GUI] Failed to open settings file");
+        Console.println("[GUI] Failed to open settings file");
         return false;
     }
 
-    size_t bytesRead = file.read((uint8_t*)&guiSettings, sizeof(GUISettings));
+    GUISettings loaded = guiSettings;
+    bool ok;
+    bool legacy = file.size() == sizeof(GUISettings);
+    if (legacy) {
+        // Raw struct of firmware before the versioned record - rewritten below
+        ok = file.read((uint8_t*)&loaded, sizeof(GUISettings)) == sizeof(GUISettings);
+    } else {
+        ok = readSettingsRecord(file, loaded);
+    }
     file.close();
 
-    if (bytesRead != sizeof(GUISettings)) {
-        Serial.println("[GUI] Settings file corrupted, using defaults");
+    if (!ok || !settingsValid(loaded)) {
+        Console.println("[GUI] Settings file corrupted, using defaults");
         return false;
     }
 
-    Serial.println("[GUI] Settings loaded from flash");
+    guiSettings = loaded;
     selectedDUTCount = guiSettings.defaultDUTCount;
+    if (legacy) {
+        Console.println("[GUI] Settings loaded from flash (old format - converting)");
+        memset(&flashSettings, 0xFF, sizeof(flashSettings));
+        saveGUISettings();
+    } else {
+        Console.println("[GUI] Settings loaded from flash");
+        flashSettings = guiSettings;
+    }
     return true;
 }
 
-bool saveGUISettings() {
-    if (!LittleFS.begin()) {
-        Serial.println("[GUI] Failed to mount LittleFS");
-        return false;
+void saveGUISettings() {
+    if (memcmp(&guiSettings, &flashSettings, sizeof(GUISettings)) == 0) {
+        saveScheduled = false;
+        return;
     }
+    // Restart the delay - a burst of changes becomes one write
+    saveScheduled = true;
+    saveChangedMs = millis();
+}
 
-    fs::File file = LittleFS.open(SETTINGS_FILE, "w");
-    if (!file) {
-        Serial.println("[GUI] Failed to create settings file");
-        return false;
+uint32_t getGUISettingsWaitMs() {
+    if (!saveScheduled) {
+        return UINT32_MAX;
     }
+    uint32_t elapsed = millis() - saveChangedMs;
+    return elapsed >= GUI_SETTINGS_SAVE_DELAY_MS ? 0 : GUI_SETTINGS_SAVE_DELAY_MS - elapsed;
+}
 
-    size_t bytesWritten = file.write((uint8_t*)&guiSettings, sizeof(GUISettings));
-    file.close();
-
-    if (bytesWritten != sizeof(GUISettings)) {
-        Serial.println("[GUI] Failed to write settings");
-        return false;
+void processGUISettingsSave() {
+    if (getGUISettingsWaitMs() != 0) {
+        return;
     }
-
-    Serial.println("[GUI] Settings saved to flash");
-    return true;
+    saveScheduled = false;
+
+    uint8_t buffer[sizeof(GUISettingsRecord) + sizeof(GUISettings) + sizeof(uint16_t)];
+    GUISettingsRecord record = {GUI_SETTINGS_MAGIC, GUI_SETTINGS_VERSION, sizeof(GUISettings)};
+    uint16_t crc = settingsCrc(record, (const uint8_t*)&guiSettings, sizeof(GUISettings));
+    memcpy(buffer, &record, sizeof(record));
+    memcpy(buffer + sizeof(record), &guiSettings, sizeof(GUISettings));
+    memcpy(buffer + sizeof(record) + sizeof(GUISettings), &crc, sizeof(crc));
+
+    // Written by the storage task - the GUI never waits for flash
+    if (!queueStorageWrite(SETTINGS_FILE, buffer, sizeof(buffer))) {
+        Console.println("[GUI] Failed to queue settings save");
+        return;
+    }
+    flashSettings = guiSettings;
+    Console.println("[GUI] Settings save queued");
 }
 
 /*=========================STATE MANAGEMENT=========================*/
 
-void initGUIState() {
+void initGUIState(bool splash) {
+    // Queues first - BLE may come up while the splash is drawn
+    buttonEventQueue = xQueueCreateStatic(BUTTON_EVENT_QUEUE_DEPTH, sizeof(ButtonInput),
+                                          buttonEventStorage, &buttonEventControl);
+    guiEventQueue = xQueueCreateStatic(GUI_EVENT_QUEUE_DEPTH, sizeof(GUIEvent), guiEventStorage, &guiEventControl);
+
     tft.init();
     tft.setRotation(3);  // Landscape orientation (0=portrait, 1=landscape)
-    
-    drawSplashScreen();
+    initDisplayPower();
 
-    Serial.println("TFT initialized");
-    // Create button event queue
-    buttonEventQueue = xQueueCreate(10, sizeof(ButtonEvent));
-    if (buttonEventQueue == nullptr) {
-        Serial.println("[GUI] ERROR: Failed to create button event queue");
+    if (splash) {
+        drawSplashScreen();
     }
+    Console.println("TFT initialized");
 
-    // Load settings from flash
-    loadGUISettings();
+    // Settings are loaded by setup() once the calibration task is done
+    // with LittleFS (loadGUISettings)
 
     // Initialize state
-    currentGUIState = GUI_SPLASH;
+    currentGUIState = splash ? GUI_SPLASH : GUI_HOME;
     menuSelection = 0;
     menuEditMode = false;
 
-    Serial.println("[GUI] State machine initialized");
+    Console.println("[GUI] State machine initialized");
+}
+
+// WebUI: remaining sweep time from the point time model (sweep_eta.h)
+static void sendProgressETA() {
+    char status[24];
+    snprintf(status, sizeof(status), "ETA:%lu", (unsigned long)((estimateSweepRemainingMs(totalDUTs) + 999) / 1000));
+    sendBLEStatus(status);
 }
 
 void setGUIState(GUIState newState) {
@@ -136,7 +238,8 @@ void setGUIState(GUIState newState) {
         return;  // No change
     }
 
-    Serial.printf("[GUI] State change: %d -> %d\n", currentGUIState, newState);
+    Console.printf("[GUI] State change: %d -> %d\n", currentGUIState, newState);
+    trace(TRACE_GUI_STATE, newState, currentGUIState);
 
     // Save old state for entry actions
     GUIState oldState = currentGUIState;
@@ -159,7 +262,8 @@ void setGUIState(GUIState newState) {
         case GUI_HOME:
             menuSelection = 0;  // Reset to START button
             // Notify WebUI if we're stopping a measurement
-            if (oldState == GUI_BASELINE_PROGRESS || oldState == GUI_FINAL_PROGRESS) {
+            if (oldState == GUI_BASELINE_PROGRESS || oldState == GUI_FINAL_PROGRESS || oldState == GUI_LIVE_PLOT ||
+                (oldState == GUI_RESULTS && getMeasurementState() != MEAS_IDLE)) {
                 sendBLEStatus("Stopped");
             }
             break;
@@ -171,23 +275,34 @@ void setGUIState(GUIState newState) {
 
         case GUI_FREQ_OVERRIDE:
             menuSelection = 0;  // Default to "Use Default"
+            menuEditMode = false;
+            break;
+
+        case GUI_DIAGNOSTICS:
+            resetPerfDashboard();
             break;
 
         case GUI_BASELINE_PROGRESS:
         case GUI_FINAL_PROGRESS:
+            // Back from the live plot or partial results - the measurement is still running
+            if (oldState == GUI_LIVE_PLOT || resultsReturn) {
+                resultsReturn = false;
+                break;
+            }
             resetMeasurementTracking();
             // Notify WebUI that measurement started
             char statusMsg[32];
             snprintf(statusMsg, sizeof(statusMsg), "Measuring:%d", num_duts);
             sendBLEStatus(statusMsg);
+            sendProgressETA();
             break;
 
         default:
             break;
     }
 
-    // Trigger screen redraw
-    renderCurrentScreen();
+    // Redrawn at the end of the GUI loop pass
+    requestRender();
 }
 
 GUIState getGUIState() {
@@ -198,24 +313,119 @@ QueueHandle_t getButtonEventQueue() {
     return buttonEventQueue;
 }
 
+bool postGUIEvent(GUIEventType type, uint8_t value) {
+    if (guiEventQueue == nullptr) {
+        return false;
+    }
+    GUIEvent event = {type, value};
+    if (xQueueSend(guiEventQueue, &event, 0) != pdTRUE) {
+        return false;
+    }
+    wakeGUITask(GUI_WAKE_EVENT);
+    return true;
+}
+
+void registerGUITask() {
+    guiTask = xTaskGetCurrentTaskHandle();
+}
+
+void wakeGUITask(uint32_t reason) {
+    if (guiTask != nullptr) {
+        xTaskNotify(guiTask, reason, eSetBits);
+    }
+}
+
+void IRAM_ATTR wakeGUITaskFromISR(uint32_t reason, BaseType_t* higherPriorityTaskWoken) {
+    if (guiTask != nullptr) {
+        xTaskNotifyFromISR(guiTask, reason, eSetBits, higherPriorityTaskWoken);
+    }
+}
+
+QueueHandle_t getGUIEventQueue() {
+    return guiEventQueue;
+}
+
+void handleGUIEvent(const GUIEvent& event) {
+    switch (event.type) {
+        case GUI_EVENT_BLE_CONNECTED:
+        case GUI_EVENT_BLE_DISCONNECTED:
+            Console.printf("[GUI] BLE %s (%d connected)\n",
+                          event.type == GUI_EVENT_BLE_CONNECTED ? "connected" : "disconnected", event.value);
+            // Only the home screen shows the connection indicator
+            if (currentGUIState == GUI_HOME) {
+                requestRender();
+            }
+            break;
+    }
+}
+
 /*=========================PROGRESS TRACKING=========================*/
 
+// Share of the sweep done: a completed DUT counts in full, the others by
+// their points stored so far out of the plan's points per DUT (the count
+// DUT_START announces) - at most one short, only completion reaches 100%
+static float measuredProgress() {
+    int perDUT = getPointsPerDUT();
+    if (totalDUTs == 0 || perDUT == 0) {
+        return 0.0f;
+    }
+    float done = 0.0f;
+    for (uint8_t i = 0; i < totalDUTs; i++) {
+        done += dutStatus[i] ? 1.0f : (float)min(getStoredPointCount(i), perDUT - 1) / perDUT;
+    }
+    return done / totalDUTs * 100.0f;
+}
+
+// Never moves back within a sweep - a DUT's points may be stored after its
+// share was already counted from an earlier DUT_END
+static bool advanceProgress() {
+    float percent = measuredProgress();
+    if (percent <= progressPercent) {
+        return false;
+    }
+    progressPercent = min(percent, 100.0f);
+    return true;
+}
+
+void processProgress() {
+    if (currentGUIState != GUI_BASELINE_PROGRESS && currentGUIState != GUI_FINAL_PROGRESS) {
+        return;
+    }
+    // The bar only pushes the columns it advanced by (drawProgressScreen)
+    if (advanceProgress()) {
+        requestRender();
+    }
+}
+
+void showDUTResult(uint8_t dutIndex) {
+    if (dutIndex >= MAX_DUT_COUNT) {
+        return;
+    }
+    resultReady[dutIndex] = true;
+    if (currentGUIState == GUI_FINAL_PROGRESS && !resultsShownEarly) {
+        // Once per sweep - going back to the progress screen stays there
+        resultsShownEarly = true;
+        setGUIState(GUI_RESULTS);
+    } else if (currentGUIState == GUI_RESULTS) {
+        requestRender();
+    }
+}
+
 void updateProgressScreen(uint8_t dutIndex) {
     if (dutIndex < MAX_DUT_COUNT) {
         dutStatus[dutIndex] = true;  // Mark DUT as complete
 
         // Update progress percentage
-        uint8_t completedDUTs = 0;
-        for (uint8_t i = 0; i < totalDUTs; i++) {
-            if (dutStatus[i]) completedDUTs++;
-        }
-        progressPercent = ((float)completedDUTs / (float)totalDUTs) * 100.0f;
+        advanceProgress();
 
-        Serial.printf("[GUI] Progress: Sensor %d complete, %.0f%% done\n", dutIndex + 1, progressPercent);
+        HAL_PRINTF("[GUI] Progress: Sensor %d complete, %.0f%% done\n", dutIndex + 1, progressPercent);
 
         // Redraw progress screen
         if (currentGUIState == GUI_BASELINE_PROGRESS || currentGUIState == GUI_FINAL_PROGRESS) {
-            renderCurrentScreen();
+            if (progressPercent < 100.0f) {
+                sendProgressETA();
+            }
+            requestRender();
         }
     }
 }
@@ -224,15 +434,85 @@ void resetMeasurementTracking() {
     currentDUT = 0;
     totalDUTs = num_duts;  // Use global num_duts which can be set from BLE or display
     progressPercent = 0.0f;
-    for (uint8_t i = 0; i < 4; i++) {
+    resultsShownEarly = false;
+    for (uint8_t i = 0; i < MAX_DUT_COUNT; i++) {
         dutStatus[i] = false;
+        resultReady[i] = false;
     }
 }
 
 /*=========================INPUT HANDLING=========================*/
 
+// Request a baseline over startIdx..endIdx without blocking on the STM32 ACK -
+// the controller enters the progress screen once it is acknowledged
+static void startBaseline(uint8_t startIdx = 0, uint8_t endIdx = SWEEP_FREQ_LAST) {
+    // The channel count may have been lowered since the selection was made
+    uint8_t duts = min(selectedDUTCount, getDUTCount());
+    SweepPlan plan = {duts, startIdx, endIdx, 0};
+    MeasRequestError error = requestBaselineSweep(MEAS_SOURCE_GUI, plan);
+    if (error != MEAS_REQUEST_OK) {
+        Console.printf("[GUI] START refused: %s\n", measRequestErrorText(error));
+    }
+}
+
+// Custom range picker: rotate to scroll, SELECT sets the start and then the
+// end (never above the start), LEFT steps back. The range is kept as the
+// next custom default
+static void handleFreqPickInput(ButtonEvent event) {
+    uint8_t lowest = freqPickStage == FREQ_PICK_END ? selectedStartFreq : 0;
+    if (event == BTN_EVENT_ROTATE_CW || event == BTN_EVENT_DOWN) {
+        if (menuSelection < SWEEP_FREQ_LAST) {
+            menuSelection++;
+            requestRender();
+        }
+    } else if (event == BTN_EVENT_ROTATE_CCW || event == BTN_EVENT_UP) {
+        if (menuSelection > lowest) {
+            menuSelection--;
+            requestRender();
+        }
+    } else if (event == BTN_EVENT_SELECT && freqPickStage == FREQ_PICK_START) {
+        selectedStartFreq = menuSelection;
+        freqPickStage = FREQ_PICK_END;
+        menuSelection = max(selectedEndFreq, selectedStartFreq);
+        invalidateFrame();
+        requestRender();
+    } else if (event == BTN_EVENT_SELECT) {
+        selectedEndFreq = menuSelection;
+        guiSettings.startFreqIndex = selectedStartFreq;
+        guiSettings.endFreqIndex = selectedEndFreq;
+        saveGUISettings();
+        startBaseline(selectedStartFreq, selectedEndFreq);
+    } else if (event == BTN_EVENT_LEFT && freqPickStage == FREQ_PICK_END) {
+        freqPickStage = FREQ_PICK_START;
+        menuSelection = selectedStartFreq;
+        invalidateFrame();
+        requestRender();
+    } else if (event == BTN_EVENT_LEFT) {
+        menuEditMode = false;
+        menuSelection = 1;
+        invalidateFrame();
+        requestRender();
+    }
+}
+
 void handleGUIInput(ButtonEvent event) {
-    Serial.printf("[GUI] Input event: %d in state %d\n", event, currentGUIState);
+    // Screens act on presses - a repeat is another press. Holding RIGHT (no
+    // press action there) on the settings screen starts a calibration
+    // acquisition, holding UP (none on the first item, where the screen
+    // opens) the diagnostics. Release is not bound
+    if (event == (BTN_EVENT_RIGHT | BTN_EVENT_LONG) && currentGUIState == GUI_SETTINGS) {
+        startCalAcquire(CAL_ACQUIRE_REF_OHMS);
+        return;
+    }
+    if (event == (BTN_EVENT_UP | BTN_EVENT_LONG) && currentGUIState == GUI_SETTINGS) {
+        setGUIState(GUI_DIAGNOSTICS);
+        return;
+    }
+    if (event & (BTN_EVENT_LONG | BTN_EVENT_RELEASE)) {
+        return;
+    }
+    event = (ButtonEvent)(event & BTN_EVENT_BUTTON_MASK);
+    Console.printf("[GUI] Input event: %d in state %d\n", event, currentGUIState);
 
     switch (currentGUIState) {
         case GUI_SPLASH:
@@ -245,20 +525,20 @@ void handleGUIInput(ButtonEvent event) {
         case GUI_HOME:
             if (event == BTN_EVENT_ROTATE_CW) {
                 // Increase DUT count
-                if (selectedDUTCount < 4) {
+                if (selectedDUTCount < getDUTCount()) {
                     selectedDUTCount++;
-                    renderCurrentScreen();
+                    requestRender();
                 }
             } else if (event == BTN_EVENT_ROTATE_CCW) {
                 // Decrease DUT count
                 if (selectedDUTCount > 1) {
                     selectedDUTCount--;
-                    renderCurrentScreen();
+                    requestRender();
                 }
             } else if (event == BTN_EVENT_LEFT || event == BTN_EVENT_RIGHT) {
                 // Toggle between START and SETTINGS buttons
                 menuSelection = (menuSelection == 0) ? 1 : 0;
-                renderCurrentScreen();
+                requestRender();
             } else if (event == BTN_EVENT_SELECT) {
                 // Confirm selection
                 if (menuSelection == 0) {
@@ -267,12 +547,7 @@ void handleGUIInput(ButtonEvent event) {
                         setGUIState(GUI_FREQ_OVERRIDE);
                     } else {
                         // Start baseline measurement with default settings
-                        num_duts = selectedDUTCount;
-                        startIDX = guiSettings.startFreqIndex;
-                        endIDX = guiSettings.endFreqIndex;
-                        if (sendStartCommand(num_duts, startIDX, endIDX)) {
-                            setGUIState(GUI_BASELINE_PROGRESS);
-                        }
+                        startBaseline();
                     }
                 } else {
                     // SETTINGS button
@@ -289,19 +564,19 @@ void handleGUIInput(ButtonEvent event) {
                 // Navigate down
                 if (menuSelection < 1) {
                     menuSelection++;
-                    renderCurrentScreen();
+                    requestRender();
                 }
             } else if (event == BTN_EVENT_ROTATE_CCW || event == BTN_EVENT_UP) {
                 // Navigate up
                 if (menuSelection > 0) {
                     menuSelection--;
-                    renderCurrentScreen();
+                    requestRender();
                 }
             } else if (event == BTN_EVENT_SELECT) {
                 if (menuSelection == 0) {
                     // Toggle frequency range setting
                     guiSettings.useCustomFreqRange = !guiSettings.useCustomFreqRange;
-                    renderCurrentScreen();
+                    requestRender();
                 } else if (menuSelection == 1) {
                     // Back to home
                     setGUIState(GUI_HOME);
@@ -313,26 +588,24 @@ void handleGUIInput(ButtonEvent event) {
             break;
 
         case GUI_FREQ_OVERRIDE:
-            if (event == BTN_EVENT_UP || event == BTN_EVENT_DOWN || event == BTN_EVENT_ROTATE_CW || event == BTN_EVENT_ROTATE_CCW) {
+            if (menuEditMode) {
+                handleFreqPickInput(event);
+            } else if (event == BTN_EVENT_UP || event == BTN_EVENT_DOWN || event == BTN_EVENT_ROTATE_CW || event == BTN_EVENT_ROTATE_CCW) {
                 // Toggle between default and custom
                 menuSelection = (menuSelection == 0) ? 1 : 0;
-                renderCurrentScreen();
+                requestRender();
+            } else if (event == BTN_EVENT_SELECT && menuSelection == 0) {
+                // Full table
+                startBaseline();
             } else if (event == BTN_EVENT_SELECT) {
-                if (menuSelection == 0) {
-                    // Use default range
-                    num_duts = selectedDUTCount;
-                    startIDX = guiSettings.startFreqIndex;
-                    endIDX = guiSettings.endFreqIndex;
-                } else {
-                    // Use custom range (for now, same as default - full implementation later)
-                    num_duts = selectedDUTCount;
-                    startIDX = guiSettings.startFreqIndex;
-                    endIDX = guiSettings.endFreqIndex;
-                }
-                // Start baseline measurement
-                if (sendStartCommand(num_duts, startIDX, endIDX)) {
-                    setGUIState(GUI_BASELINE_PROGRESS);
-                }
+                // Pick a range, starting from the last custom one
+                selectedStartFreq = guiSettings.startFreqIndex;
+                selectedEndFreq = guiSettings.endFreqIndex;
+                freqPickStage = FREQ_PICK_START;
+                menuSelection = selectedStartFreq;
+                menuEditMode = true;
+                invalidateFrame();
+                requestRender();
             } else if (event == BTN_EVENT_LEFT) {
                 // Back to home
                 setGUIState(GUI_HOME);
@@ -343,16 +616,30 @@ void handleGUIInput(ButtonEvent event) {
         case GUI_FINAL_PROGRESS:
             if (event == BTN_EVENT_SELECT) {
                 // Stop measurement (with confirmation in future)
-                sendStopCommand();
-                setGUIState(GUI_HOME);
+                requestMeasurementStop(MEAS_SOURCE_GUI);
+            } else if (event == BTN_EVENT_RIGHT) {
+                // Watch the sweep
+                liveReturnState = currentGUIState;
+                setGUIState(GUI_LIVE_PLOT);
+            }
+            break;
+
+        case GUI_LIVE_PLOT:
+            if (event == BTN_EVENT_SELECT) {
+                // Stop measurement, as on the progress screen
+                requestMeasurementStop(MEAS_SOURCE_GUI);
+            } else if (event == BTN_EVENT_LEFT) {
+                // Back to the progress screen
+                setGUIState(liveReturnState);
             }
             break;
 
         case GUI_BASELINE_COMPLETE:
             if (event == BTN_EVENT_SELECT) {
                 // Start final measurement
-                if (sendStartCommand(num_duts, startIDX, endIDX)) {
-                    setGUIState(GUI_FINAL_PROGRESS);
+                MeasRequestError error = requestFinalSweep(MEAS_SOURCE_GUI);
+                if (error != MEAS_REQUEST_OK) {
+                    Console.printf("[GUI] START refused: %s\n", measRequestErrorText(error));
                 }
             } else if (event == BTN_EVENT_LEFT) {
                 // Back to home
@@ -361,12 +648,53 @@ void handleGUIInput(ButtonEvent event) {
             break;
 
         case GUI_RESULTS:
+            if (getMeasurementState() != MEAS_IDLE) {
+                // Partial results - the final sweep still runs
+                if (event == BTN_EVENT_SELECT) {
+                    requestMeasurementStop(MEAS_SOURCE_GUI);
+                } else if (event == BTN_EVENT_LEFT) {
+                    resultsReturn = true;
+                    setGUIState(GUI_FINAL_PROGRESS);
+                }
+                break;
+            }
             if (event == BTN_EVENT_SELECT) {
                 // New measurement - reset and return to home
-                baselineMeasurementDone = false;
-                finalMeasurementDone = false;
-                measurementInProgress = false;
+                resetMeasurementResults();
                 setGUIState(GUI_HOME);
+            } else if (event == BTN_EVENT_RIGHT && totalDUTs > 0) {
+                // Baseline vs. final plots, from the first DUT
+                overlayDUT = 0;
+                resetOverlayPlot();
+                setGUIState(GUI_OVERLAY);
+            }
+            break;
+
+        case GUI_OVERLAY:
+            if (event == BTN_EVENT_ROTATE_CW || event == BTN_EVENT_DOWN) {
+                // Next DUT - the axes stay
+                overlayDUT = (overlayDUT + 1) % totalDUTs;
+                requestRender();
+            } else if (event == BTN_EVENT_ROTATE_CCW || event == BTN_EVENT_UP) {
+                overlayDUT = (overlayDUT + totalDUTs - 1) % totalDUTs;
+                requestRender();
+            } else if (event == BTN_EVENT_SELECT || event == BTN_EVENT_LEFT) {
+                setGUIState(GUI_RESULTS);
+            }
+            break;
+
+        case GUI_MONITOR:
+            if (event == BTN_EVENT_SELECT) {
+                // Stop monitoring - the baseline stays for another run
+                stopMonitor();
+                setGUIState(GUI_BASELINE_COMPLETE);
+            }
+            break;
+
+        case GUI_DIAGNOSTICS:
+            // UP still repeating from the hold that opened it does nothing
+            if (event == BTN_EVENT_SELECT || event == BTN_EVENT_LEFT) {
+                setGUIState(GUI_SETTINGS);
             }
             break;
     }
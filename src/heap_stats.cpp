@@ -0,0 +1,292 @@
+#include "heap_stats.h"
+#include "console.h"
+#include "log.h"
+#include "task_monitor.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <esp_heap_caps.h>
+
+#define HEAP_CAPS           MALLOC_CAP_8BIT
+#define HEAP_NAME_LEN       16      // configMAX_TASK_NAME_LEN
+
+/*=========================STATE=========================*/
+static portMUX_TYPE heapMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t failures = 0;
+static uint32_t failuresReported = 0;
+static uint32_t lastFailSize = 0;
+static uint32_t lastFailCaps = 0;
+static char lastFailTask[HEAP_NAME_LEN] = "-";
+static uint32_t minLargestBlock = UINT32_MAX;
+
+// Name of the running task, "isr" or "boot" (before the scheduler)
+static void currentOwnerName(char (&name)[HEAP_NAME_LEN]) {
+    const char* task = "boot";
+    if (xPortInIsrContext()) {
+        task = "isr";
+    } else if (xTaskGetCurrentTaskHandle() != nullptr) {
+        task = pcTaskGetName(nullptr);
+    }
+    strncpy(name, task, HEAP_NAME_LEN - 1);
+    name[HEAP_NAME_LEN - 1] = '\0';
+}
+
+// Called by the heap with the allocator unlocked, possibly from an ISR
+static void IRAM_ATTR onAllocFailed(size_t size, uint32_t caps, const char* function) {
+    portENTER_CRITICAL_SAFE(&heapMux);
+    failures++;
+    lastFailSize = size;
+    lastFailCaps = caps;
+    currentOwnerName(lastFailTask);
+    portEXIT_CRITICAL_SAFE(&heapMux);
+}
+
+#if HEAP_STATS
+/*=========================ALLOCATION HOOKS=========================*/
+// Slots are matched by task handle - a task created after another was
+// deleted can get the same handle, and its counts then add to that slot
+struct HeapOwner {
+    TaskHandle_t task;
+    char name[HEAP_NAME_LEN];
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t bytes;         // Allocated since reset (frees carry no size)
+    uint32_t largest;       // Largest single allocation
+    uint32_t extAllocs;     // Of allocs, inside heapStatsEnterFramework()
+    uint32_t sweepAllocs;   // Own allocations in the open sweep window
+    uint32_t sweepBytes;
+    uint8_t frameworkDepth;
+};
+
+// Task slots, then "isr" and "other" (table full)
+static HeapOwner owners[HEAP_STATS_OWNERS + 2];
+static size_t ownerCount = 0;
+static bool sweepOpen = false;
+static uint32_t sweepsChecked = 0;
+static uint32_t sweepsFailed = 0;
+
+#define OWNER_ISR       HEAP_STATS_OWNERS
+#define OWNER_OTHER     (HEAP_STATS_OWNERS + 1)
+
+// Caller holds heapMux
+static HeapOwner& currentOwner() {
+    if (xPortInIsrContext()) {
+        return owners[OWNER_ISR];
+    }
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    for (size_t i = 0; i < ownerCount; i++) {
+        if (owners[i].task == task) {
+            return owners[i];
+        }
+    }
+    if (ownerCount == HEAP_STATS_OWNERS) {
+        return owners[OWNER_OTHER];
+    }
+    // First allocation of this task - the name is copied once, here
+    HeapOwner& owner = owners[ownerCount++];
+    owner.task = task;
+    currentOwnerName(owner.name);
+    return owner;
+}
+
+// Heap hooks (CONFIG_HEAP_USE_HOOKS): every successful allocation and free,
+// after the allocator has released its lock. Must not allocate
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+    portENTER_CRITICAL_SAFE(&heapMux);
+    HeapOwner& owner = currentOwner();
+    owner.allocs++;
+    owner.bytes += size;
+    if (size > owner.largest) owner.largest = size;
+    if (owner.frameworkDepth > 0) {
+        owner.extAllocs++;
+    } else if (sweepOpen) {
+        owner.sweepAllocs++;
+        owner.sweepBytes += size;
+    }
+    portEXIT_CRITICAL_SAFE(&heapMux);
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void* ptr) {
+    portENTER_CRITICAL_SAFE(&heapMux);
+    currentOwner().frees++;
+    portEXIT_CRITICAL_SAFE(&heapMux);
+}
+
+/*=========================SWEEP CHECK=========================*/
+void heapStatsEnterFramework() {
+    portENTER_CRITICAL(&heapMux);
+    currentOwner().frameworkDepth++;
+    portEXIT_CRITICAL(&heapMux);
+}
+
+void heapStatsExitFramework() {
+    portENTER_CRITICAL(&heapMux);
+    HeapOwner& owner = currentOwner();
+    if (owner.frameworkDepth > 0) owner.frameworkDepth--;
+    portEXIT_CRITICAL(&heapMux);
+}
+
+void heapStatsSweepBegin() {
+    portENTER_CRITICAL(&heapMux);
+    for (HeapOwner& owner : owners) {
+        owner.sweepAllocs = 0;
+        owner.sweepBytes = 0;
+    }
+    sweepOpen = true;
+    portEXIT_CRITICAL(&heapMux);
+}
+
+void heapStatsSweepEnd() {
+    static HeapOwner snapshot[HEAP_STATS_OWNERS + 2];
+    portENTER_CRITICAL(&heapMux);
+    if (!sweepOpen) {
+        portEXIT_CRITICAL(&heapMux);
+        return;
+    }
+    sweepOpen = false;
+    memcpy(snapshot, owners, sizeof(snapshot));
+    size_t count = ownerCount;
+    portEXIT_CRITICAL(&heapMux);
+
+    // Table tasks and ISRs only - the BT host and timer tasks are the framework's
+    uint32_t allocs = 0;
+    for (size_t i = 0; i < HEAP_STATS_OWNERS + 1; i++) {
+        if ((i < count && isTableTask(snapshot[i].task)) || i == OWNER_ISR) {
+            allocs += snapshot[i].sweepAllocs;
+        }
+    }
+    sweepsChecked++;
+    if (allocs == 0) {
+        LOG_I("[HEAP] Sweep check PASS: no allocations in the application tasks\n");
+        return;
+    }
+    sweepsFailed++;
+    LOG_E("[HEAP] Sweep check FAIL: %lu allocation(s) in the application tasks\n", allocs);
+    for (size_t i = 0; i < HEAP_STATS_OWNERS + 1; i++) {
+        const HeapOwner& owner = snapshot[i];
+        if (owner.sweepAllocs > 0 && ((i < count && isTableTask(owner.task)) || i == OWNER_ISR)) {
+            LOG_E("  %-16s %lu allocs, %lu bytes\n", owner.name, owner.sweepAllocs, owner.sweepBytes);
+        }
+    }
+}
+#endif // HEAP_STATS
+
+/*=========================CONTROL=========================*/
+void initHeapStats() {
+#if HEAP_STATS
+    strcpy(owners[OWNER_ISR].name, "isr");
+    strcpy(owners[OWNER_OTHER].name, "other");
+#endif
+    if (heap_caps_register_failed_alloc_callback(onAllocFailed) != ESP_OK) {
+        Console.println("WARNING: Cannot register the failed-allocation callback");
+    }
+}
+
+void heapStatsSample() {
+    uint32_t largest = heap_caps_get_largest_free_block(HEAP_CAPS);
+
+    portENTER_CRITICAL(&heapMux);
+    if (largest < minLargestBlock) minLargestBlock = largest;
+    uint32_t newFailures = failures - failuresReported;
+    failuresReported = failures;
+    uint32_t size = lastFailSize;
+    uint32_t caps = lastFailCaps;
+    char task[HEAP_NAME_LEN];
+    memcpy(task, lastFailTask, sizeof(task));
+    portEXIT_CRITICAL(&heapMux);
+
+    // Printed here, outside the failing allocation
+    if (newFailures > 0) {
+        LOG_W("WARNING: %lu allocation failure(s), last %lu bytes (caps 0x%lx) in %s\n",
+              newFailures, size, caps, task);
+    }
+}
+
+void heapStatsReset() {
+    portENTER_CRITICAL(&heapMux);
+    failures = 0;
+    failuresReported = 0;
+    minLargestBlock = UINT32_MAX;
+#if HEAP_STATS
+    for (HeapOwner& owner : owners) {
+        owner.allocs = 0;
+        owner.frees = 0;
+        owner.bytes = 0;
+        owner.largest = 0;
+        owner.extAllocs = 0;
+    }
+    sweepsChecked = 0;
+    sweepsFailed = 0;
+#endif
+    portEXIT_CRITICAL(&heapMux);
+}
+
+/*=========================REPORTING=========================*/
+void getHeapSummary(HeapSummary& out) {
+    out.freeBytes = heap_caps_get_free_size(HEAP_CAPS);
+    out.totalBytes = heap_caps_get_total_size(HEAP_CAPS);
+    out.minFreeBytes = heap_caps_get_minimum_free_size(HEAP_CAPS);
+    out.largestBlock = heap_caps_get_largest_free_block(HEAP_CAPS);
+
+    portENTER_CRITICAL(&heapMux);
+    out.minLargestBlock = min(minLargestBlock, out.largestBlock);
+    out.failures = failures;
+    portEXIT_CRITICAL(&heapMux);
+}
+
+void printHeapStats() {
+    HeapSummary heap;
+    getHeapSummary(heap);
+    uint32_t used = heap.totalBytes - heap.freeBytes;
+
+    Console.printf("[HEAP] Total: %lu bytes, Used: %lu bytes (%.1f%%), Free: %lu bytes, Largest block: %lu bytes\n",
+        heap.totalBytes, used, 100.0f * used / heap.totalBytes, heap.freeBytes, heap.largestBlock);
+}
+
+void printHeapReport() {
+    HeapSummary heap;
+    getHeapSummary(heap);
+
+    portENTER_CRITICAL(&heapMux);
+    uint32_t size = lastFailSize;
+    uint32_t caps = lastFailCaps;
+    char task[HEAP_NAME_LEN];
+    memcpy(task, lastFailTask, sizeof(task));
+    portEXIT_CRITICAL(&heapMux);
+
+    // Fragmentation: the share of free memory not in the largest block
+    float fragmentation = heap.freeBytes ? 100.0f * (heap.freeBytes - heap.largestBlock) / heap.freeBytes : 0.0f;
+
+    Console.println("\n=== Heap ===");
+    Console.printf("Free:         %lu of %lu bytes (min ever %lu)\n", heap.freeBytes, heap.totalBytes, heap.minFreeBytes);
+    Console.printf("Largest:      %lu bytes (lowest after a sweep %lu), fragmentation %.0f%%\n",
+                  heap.largestBlock, heap.minLargestBlock, fragmentation);
+    if (heap.failures > 0) {
+        Console.printf("Failures:     %lu (last %lu bytes, caps 0x%lx, in %s)\n", heap.failures, size, caps, task);
+    } else {
+        Console.println("Failures:     0");
+    }
+
+#if HEAP_STATS
+    // Copy out - printing allocates, which would change the counts mid-table
+    static HeapOwner snapshot[HEAP_STATS_OWNERS + 2];
+    portENTER_CRITICAL(&heapMux);
+    memcpy(snapshot, owners, sizeof(snapshot));
+    size_t count = ownerCount;
+    portEXIT_CRITICAL(&heapMux);
+
+    Console.printf("%-16s %9s %9s %10s %8s %9s\n", "task", "allocs", "frees", "bytes", "largest", "ext");
+    for (size_t i = 0; i < HEAP_STATS_OWNERS + 2; i++) {
+        const HeapOwner& owner = snapshot[i];
+        if ((i < count || i >= HEAP_STATS_OWNERS) && owner.allocs + owner.frees > 0) {
+            Console.printf("%-16s %9lu %9lu %10lu %8lu %9lu\n", owner.name, owner.allocs, owner.frees,
+                          owner.bytes, owner.largest, owner.extAllocs);
+        }
+    }
+    Console.printf("Sweep check:  %lu of %lu sweep(s) allocated in the application tasks\n",
+                  sweepsFailed, sweepsChecked);
+#else
+    Console.println("Per-task counts: not built in (pio run -e heap)");
+#endif
+    Console.println("============\n");
+}
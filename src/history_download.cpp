@@ -0,0 +1,395 @@
+#include "history_download.h"
+#include "console.h"
+#include "session_log.h"
+#include "BLE_Functions.h"
+#include "crc.h"
+#include "storage.h"
+#include "sweep_eta.h"
+#include <LittleFS.h>
+
+// Single request slot - filled by the BLE callback, drained by processHistoryDownload()
+union HistoryRequestSlot {
+    HistoryRequest request;
+    HistorySyncRequest sync;
+};
+static HistoryRequestSlot pendingRequest;
+static volatile bool requestPending = false;
+static portMUX_TYPE requestMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Transfer being streamed
+static bool active = false;
+static uint32_t imageId = 0;
+static uint32_t nextOffset = 0;
+static uint32_t blocksSent = 0;
+
+// Image bytes [cacheOffset, cacheOffset + cacheLength) of the last refill
+static uint8_t cache[HISTORY_CACHE_BYTES];
+static uint32_t cacheOffset = 0;
+static size_t cacheLength = 0;
+static uint32_t cacheImageSize = 0;     // Image size at the last refill
+static uint32_t refillWaitMs = 0;       // When the next refill started waiting, 0 = not
+
+/*=========================BLE SIDE=========================*/
+bool historyRequestReceive(const uint8_t* data, size_t len) {
+    bool sync = data != nullptr && len > 0 && data[0] == HISTORY_REQ_SYNC;
+    size_t max = sync ? sizeof(HistorySyncRequest) : sizeof(HistoryRequest);
+    if (len < 1 || len > max) {
+        return false;
+    }
+    // A SYNC carries just the refs it counts - as many as the client's MTU fits
+    if (sync && (len < offsetof(HistorySyncRequest, refs) ||
+                 len < offsetof(HistorySyncRequest, refs) + data[1] * sizeof(HistorySessionRef))) {
+        return false;
+    }
+    portENTER_CRITICAL(&requestMux);
+    memset(&pendingRequest, 0, sizeof(pendingRequest));
+    memcpy(&pendingRequest, data, len);
+    requestPending = true;
+    portEXIT_CRITICAL(&requestMux);
+    return true;
+}
+
+bool isHistoryDownloadActive() {
+    return active;
+}
+
+/*=========================IMAGE=========================*/
+struct ImageLayout {
+    uint32_t oldSize;       // SESSION_LOG_OLD_FILE bytes, first in the image
+    uint32_t logSize;
+    uint32_t id;
+};
+
+static uint32_t fileSize(const char* path) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return 0;
+    }
+    uint32_t size = file.size();
+    file.close();
+    return size;
+}
+
+// Sizes and id of the image
+static ImageLayout readLayout() {
+    ImageLayout layout;
+    layout.oldSize = fileSize(SESSION_LOG_OLD_FILE);
+    layout.logSize = fileSize(SESSION_LOG_FILE);
+    layout.id = 0;
+
+    // The first record changes exactly when the log rotates
+    File file = LittleFS.open(layout.oldSize > 0 ? SESSION_LOG_OLD_FILE : SESSION_LOG_FILE, "r");
+    if (file) {
+        SessionHeader header;
+        if (file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && header.magic == SESSION_MAGIC) {
+            layout.id = header.timestamp;
+        }
+        file.close();
+    }
+    return layout;
+}
+
+// Copy len bytes at offset of one log file into dest
+static bool readFileRange(const char* path, uint32_t offset, uint8_t* dest, size_t len) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+    bool ok = file.seek(offset) && file.read(dest, len) == len;
+    file.close();
+    return ok;
+}
+
+// Copy image bytes [offset, offset + len) of layout into dest
+static bool readImageRange(const ImageLayout& layout, uint32_t offset, uint8_t* dest, size_t len) {
+    // The range may span the end of the old log
+    size_t fromOld = offset < layout.oldSize ? min(len, (size_t)(layout.oldSize - offset)) : 0;
+    if (fromOld > 0 && !readFileRange(SESSION_LOG_OLD_FILE, offset, dest, fromOld)) {
+        return false;
+    }
+    return len == fromOld ||
+           readFileRange(SESSION_LOG_FILE, offset + fromOld - layout.oldSize, dest + fromOld, len - fromOld);
+}
+
+bool getHistoryImageInfo(uint32_t& id, uint32_t& totalBytes) {
+    if (!isStorageMounted() || !waitStorageIdle()) {
+        return false;
+    }
+    ImageLayout layout = readLayout();
+    id = layout.id;
+    totalBytes = layout.oldSize + layout.logSize;
+    return true;
+}
+
+// Image size at the read in imageSize (0 on a storage failure)
+static bool readImage(uint32_t id, uint32_t offset, uint8_t* dest, size_t len, size_t& copied,
+                      uint32_t& imageSize, HistoryError& error) {
+    copied = 0;
+    imageSize = 0;
+    if (!isStorageMounted()) {
+        error = HISTORY_ERR_READ;
+        return false;
+    }
+    // Queued session appends belong to the image
+    waitStorageIdle();
+    ImageLayout layout = readLayout();
+    imageSize = layout.oldSize + layout.logSize;
+    if (layout.id != id) {
+        error = HISTORY_ERR_IMAGE_CHANGED;
+        return false;
+    }
+    if (offset > imageSize) {
+        error = HISTORY_ERR_OFFSET;
+        return false;
+    }
+    copied = min((size_t)(imageSize - offset), len);
+    if (!readImageRange(layout, offset, dest, copied)) {
+        copied = 0;
+        error = HISTORY_ERR_READ;
+        return false;
+    }
+    return true;
+}
+
+bool readHistoryImage(uint32_t imageId, uint32_t offset, uint8_t* dest, size_t len,
+                      size_t& copied, HistoryError& error) {
+    uint32_t imageSize;
+    return readImage(imageId, offset, dest, len, copied, imageSize, error);
+}
+
+// End in its log file of the newest index entry in path that is ref
+static bool findIndexRecord(const char* path, const HistorySessionRef& ref, uint32_t& end) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+    SessionHeader headers[HISTORY_SYNC_BATCH];
+    int32_t left = file.size() / sizeof(SessionHeader);
+    bool found = false;
+    while (left > 0 && !found) {
+        int32_t batch = min(left, (int32_t)HISTORY_SYNC_BATCH);
+        left -= batch;
+        size_t bytes = batch * sizeof(SessionHeader);
+        if (!file.seek(left * sizeof(SessionHeader)) || file.read((uint8_t*)headers, bytes) != bytes) {
+            break;
+        }
+        for (int32_t i = batch - 1; i >= 0 && !found; i--) {
+            const SessionHeader& header = headers[i];
+            found = header.magic == SESSION_MAGIC && header.timestamp == ref.timestamp &&
+                    header.dut == ref.dut && header.kind == ref.kind && header.crc == ref.crc;
+            end = header.offset + sizeof(SessionHeader) + header.bytes;
+        }
+    }
+    file.close();
+    return found;
+}
+
+bool syncHistoryImage(const HistorySyncRequest& request, uint32_t& id, uint32_t& totalBytes,
+                      uint32_t& startOffset, uint8_t& match) {
+    if (!isStorageMounted() || !waitStorageIdle()) {
+        return false;
+    }
+    ImageLayout layout = readLayout();
+    id = layout.id;
+    totalBytes = layout.oldSize + layout.logSize;
+    startOffset = 0;
+    match = HISTORY_SYNC_NONE;
+    if (request.imageId != 0 && request.imageId == layout.id && request.heldBytes <= totalBytes) {
+        startOffset = request.heldBytes;
+        match = HISTORY_SYNC_GENERATION;
+        return true;
+    }
+    // Newest named session first, the current log before the old one
+    for (uint8_t i = 0; i < request.count && i < HISTORY_SYNC_REFS; i++) {
+        uint32_t end;
+        if (findIndexRecord(SESSION_INDEX_FILE, request.refs[i], end)) {
+            end += layout.oldSize;
+        } else if (!findIndexRecord(SESSION_INDEX_OLD_FILE, request.refs[i], end)) {
+            continue;
+        }
+        if (end <= totalBytes) {
+            startOffset = end;
+            match = i + 1;
+            return true;
+        }
+    }
+    return true;
+}
+
+// Reload the cache from offset; false with error set if the image is unusable
+static bool refillCache(uint32_t offset, HistoryError& error) {
+    cacheOffset = offset;
+    return readImage(imageId, offset, cache, HISTORY_CACHE_BYTES, cacheLength, cacheImageSize, error);
+}
+
+/*=========================FRAMES=========================*/
+static size_t blockBytes() {
+    size_t payload = getBLEHistoryPayloadSize();
+    return payload > HISTORY_FRAME_OVERHEAD ? min(payload, (size_t)HISTORY_FRAME_MAX) - HISTORY_FRAME_OVERHEAD : 0;
+}
+
+static bool sendFrame(uint8_t type, uint8_t flags, uint32_t offset, const uint8_t* data, size_t len) {
+    static uint8_t frame[HISTORY_FRAME_MAX];
+    HistoryFrameHeader header;
+    header.type = type;
+    header.flags = flags;
+    header.length = len;
+    header.offset = offset;
+    memcpy(frame, &header, sizeof(header));
+    memcpy(frame + sizeof(header), data, len);
+    uint16_t crc = crc16_ccitt(frame, sizeof(header) + len);
+    memcpy(frame + sizeof(header) + len, &crc, sizeof(crc));
+    return sendBLEHistoryFrame(frame, sizeof(header) + len + sizeof(crc));
+}
+
+static void sendError(HistoryError error) {
+    uint8_t code = error;
+    active = false;
+    Console.printf("[HIST] Download error %d at offset %lu\n", error, (unsigned long)nextOffset);
+    sendFrame(HISTORY_FRAME_ERROR, 0, nextOffset, &code, sizeof(code));
+}
+
+/*=========================REQUESTS=========================*/
+static void handleInfo() {
+    // Sessions whose flash append failed get another try
+    flushSessions();
+
+    HistoryInfo info = {};
+    info.version = HISTORY_VERSION;
+    info.blockBytes = blockBytes();
+    uint32_t id, totalBytes;
+    if (getHistoryImageInfo(id, totalBytes)) {
+        info.imageId = id;
+        info.totalBytes = totalBytes;
+    }
+    active = false;
+    cacheLength = 0;
+    Console.printf("[HIST] Image %lu: %lu bytes\n", (unsigned long)info.imageId, (unsigned long)info.totalBytes);
+    sendFrame(HISTORY_FRAME_INFO, 0, 0, (const uint8_t*)&info, sizeof(info));
+}
+
+static void handleRead(const HistoryRequest& request) {
+    imageId = request.imageId;
+    nextOffset = request.offset;
+    blocksSent = 0;
+    cacheLength = 0;
+
+    HistoryError error;
+    if (!refillCache(nextOffset, error)) {
+        sendError(error);
+        return;
+    }
+    active = true;
+    Console.printf("[HIST] Streaming from offset %lu of %lu\n", (unsigned long)nextOffset, (unsigned long)cacheImageSize);
+}
+
+static void handleSync(const HistorySyncRequest& request) {
+    // Sessions whose flash append failed are part of what is missing
+    flushSessions();
+
+    HistorySyncInfo info = {};
+    info.version = HISTORY_VERSION;
+    info.blockBytes = blockBytes();
+    active = false;
+    cacheLength = 0;
+    if (request.count > HISTORY_SYNC_REFS) {
+        sendError(HISTORY_ERR_REQUEST);
+        return;
+    }
+    uint32_t id, totalBytes, startOffset;
+    uint8_t match;
+    if (!syncHistoryImage(request, id, totalBytes, startOffset, match)) {
+        sendError(HISTORY_ERR_READ);
+        return;
+    }
+    info.imageId = id;
+    info.totalBytes = totalBytes;
+    info.startOffset = startOffset;
+    info.match = match;
+    Console.printf("[HIST] Sync: match %d, %lu of %lu bytes to send\n", info.match,
+                   (unsigned long)(info.totalBytes - info.startOffset), (unsigned long)info.totalBytes);
+    // Up to date: the SYNC frame is the last one
+    bool upToDate = info.startOffset >= info.totalBytes;
+    if (!sendFrame(HISTORY_FRAME_SYNC, upToDate ? HISTORY_FLAG_LAST : 0, info.startOffset,
+                   (const uint8_t*)&info, sizeof(info)) || upToDate) {
+        return;
+    }
+    HistoryRequest read = {HISTORY_REQ_READ, {}, info.imageId, info.startOffset};
+    handleRead(read);
+}
+
+/*=========================STREAMING=========================*/
+// During a sweep a refill reads flash only in a gap between frames - or
+// once it has waited HISTORY_REFILL_WAIT_MS for one
+static bool refillFits() {
+    uint32_t now = millis();
+    if (getSweepGapMs() >= HISTORY_REFILL_GAP_MS ||
+        (refillWaitMs != 0 && now - refillWaitMs >= HISTORY_REFILL_WAIT_MS)) {
+        refillWaitMs = 0;
+        return true;
+    }
+    if (refillWaitMs == 0) {
+        refillWaitMs = now | 1;
+    }
+    return false;
+}
+
+// Queue the block at nextOffset; false when the stream has ended (or waits)
+static bool sendNextBlock() {
+    if (nextOffset < cacheOffset || nextOffset >= cacheOffset + cacheLength) {
+        if (!refillFits()) {
+            return false;  // Retried next loop
+        }
+        HistoryError error;
+        if (!refillCache(nextOffset, error)) {
+            sendError(error);
+            return false;
+        }
+    }
+
+    size_t inCache = cacheOffset + cacheLength - nextOffset;
+    size_t len = min(blockBytes(), inCache);
+    bool last = nextOffset + len >= cacheImageSize;
+    if (!sendFrame(HISTORY_FRAME_BLOCK, last ? HISTORY_FLAG_LAST : 0, nextOffset,
+                   cache + (nextOffset - cacheOffset), len)) {
+        return false;  // TX buffer full after all - retried next loop
+    }
+    nextOffset += len;
+    blocksSent++;
+    if (last) {
+        active = false;
+        Console.printf("[HIST] Download complete: %lu blocks\n", (unsigned long)blocksSent);
+    }
+    return !last;
+}
+
+void processHistoryDownload() {
+    if (requestPending) {
+        HistoryRequestSlot slot;
+        portENTER_CRITICAL(&requestMux);
+        slot = pendingRequest;
+        requestPending = false;
+        portEXIT_CRITICAL(&requestMux);
+
+        switch (slot.request.op) {
+            case HISTORY_REQ_INFO:  handleInfo(); break;
+            case HISTORY_REQ_READ:  handleRead(slot.request); break;
+            case HISTORY_REQ_SYNC:  handleSync(slot.sync); break;
+            case HISTORY_REQ_ABORT: active = false; break;
+            default:                sendError(HISTORY_ERR_REQUEST); break;
+        }
+    }
+    if (!active) {
+        return;
+    }
+    if (getBLEHistoryPayloadSize() == 0) {
+        // The client resumes with READ from its last good offset
+        active = false;
+        Console.printf("[HIST] Download interrupted at offset %lu\n", (unsigned long)nextOffset);
+        return;
+    }
+
+    // Fill the TX buffer, leaving room for status and data messages
+    while (getBLETxFree() > HISTORY_TX_RESERVE + HISTORY_FRAME_MAX && sendNextBlock()) {
+    }
+}
@@ -0,0 +1,65 @@
+#include "image_codec.h"
+
+void beginImageDecode(ImageDecoder& decoder, const uint8_t* data, size_t size) {
+    decoder.data = data;
+    decoder.end = data + size;
+    decoder.prev = 0;
+    decoder.run = 0;
+    memset(decoder.index, 0, sizeof(decoder.index));
+}
+
+// Apply a signed 2-bit delta (stored with bias 2) to one channel
+static uint16_t addChannel(uint16_t color, uint8_t shift, uint16_t mask, uint8_t bits) {
+    uint16_t channel = ((color >> shift) + bits - 2) & mask;
+    return (color & ~(mask << shift)) | channel << shift;
+}
+
+static inline uint16_t panelColor(uint16_t color, bool panelOrder) {
+    return panelOrder ? (uint16_t)(color >> 8 | color << 8) : color;
+}
+
+bool decodeImagePixels(ImageDecoder& decoder, uint16_t* out, size_t count, bool panelOrder) {
+    while (count > 0) {
+        if (decoder.run > 0) {
+            size_t n = min((size_t)decoder.run, count);
+            uint16_t value = panelColor(decoder.prev, panelOrder);
+            for (size_t i = 0; i < n; i++) {
+                *out++ = value;
+            }
+            decoder.run -= n;
+            count -= n;
+            continue;
+        }
+        if (decoder.data >= decoder.end) {
+            return false;
+        }
+
+        uint8_t op = *decoder.data++;
+        uint16_t color;
+        switch (op & IMAGE_OP_MASK) {
+            case IMAGE_OP_INDEX:
+                color = decoder.index[op];
+                break;
+            case IMAGE_OP_DIFF:
+                color = addChannel(decoder.prev, 11, 0x1F, (op >> 4) & 0x03);
+                color = addChannel(color, 5, 0x3F, (op >> 2) & 0x03);
+                color = addChannel(color, 0, 0x1F, op & 0x03);
+                break;
+            case IMAGE_OP_RUN:
+                decoder.run = (op & 0x3F) + 1;
+                continue;
+            default:
+                if (op != IMAGE_OP_RAW || decoder.end - decoder.data < 2) {
+                    return false;
+                }
+                color = decoder.data[0] << 8 | decoder.data[1];
+                decoder.data += 2;
+                break;
+        }
+        decoder.index[imageColorHash(color)] = color;
+        decoder.prev = color;
+        *out++ = panelColor(color, panelOrder);
+        count--;
+    }
+    return true;
+}
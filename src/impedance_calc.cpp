@@ -1,95 +1,340 @@
 #include "impedance_calc.h"
+#include "log.h"
+#include "sweep_table.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "sweep_stats.h"
+#include "spectral_metrics.h"
 #include <math.h>
 
 RiskLevel riskLevels[MAX_DUT_COUNT];
 float riskPercentages[MAX_DUT_COUNT];
-float lowRiskCutoff = 0.05f;  
-float mediumRiskCutoff = 0.15f;
-float highRiskCutoff = 0.25f;
+bool fastScreenMode = false;
 
 
-/*=========================IMPEDANCE CALCULATION=========================*/
-// Calculate impedance from voltage and current samples
+/*=========================RISK LEVEL=========================*/
+// Running sums of final/baseline |Z| ratios, updated as each final point is
+// stored - the risk is ready as soon as the DUT's last point arrives
+static float riskRatioSum[MAX_DUT_COUNT];
+static int riskRatioCount[MAX_DUT_COUNT];
+// Storage slot of each sweep index in the DUT's baseline row
+static uint8_t baselineSlot[MAX_DUT_COUNT][SWEEP_FREQ_COUNT];
+static uint32_t riskFreqStartHz = 0;
+static uint32_t riskFreqEndHz = 0;
 
+void resetRiskAccumulator(uint8_t dutIdx, uint32_t freqStartHz, uint32_t freqEndHz) {
+    riskRatioSum[dutIdx] = 0.0f;
+    riskRatioCount[dutIdx] = 0;
+    riskFreqStartHz = freqStartHz;
+    riskFreqEndHz = freqEndHz;
+    resetSpectralMetrics(dutIdx);
+}
 
-ImpedancePoint calcImpedance(MeasurementPoint measPoint) {
-    ImpedancePoint result;
+void resetBaselineSlots(uint8_t dutIdx) {
+    memset(baselineSlot[dutIdx], SWEEP_FREQ_INVALID, sizeof(baselineSlot[dutIdx]));
+}
 
-    if (measPoint.I_magnitude <= 0.0f || !measPoint.valid) {
-        // Invalid current or measurement
-        result.valid = false;
-        return result;
+void recordBaselinePoint(uint8_t dutIdx, int freqIdx, const ImpedancePoint& point) {
+    if (point.freq_idx < SWEEP_FREQ_COUNT) {
+        baselineSlot[dutIdx][point.freq_idx] = freqIdx;
     }
+}
 
-    result.freq_hz = measPoint.freq_hz;
-    result.valid = measPoint.valid;
-    result.Z_magnitude = measPoint.V_magnitude / measPoint.I_magnitude; // |Z| = V/I
-    result.Z_phase = measPoint.phase_deg; // Phase angle already in degrees
-    result.pga_gain = measPoint.pga_gain;
-    result.tia_gain = measPoint.tia_gain;
+void accumulateRiskPoint(uint8_t dutIdx, int freqIdx, const ImpedancePoint& finalPoint) {
+    // Pair by sweep frequency - the two sweeps may cover different (sparse) index sets
+    int slot = freqIdx;
+    if (finalPoint.freq_idx < SWEEP_FREQ_COUNT) {
+        slot = baselineSlot[dutIdx][finalPoint.freq_idx];
+        if (slot == SWEEP_FREQ_INVALID) {
+            return; // Not in the baseline sweep
+        }
+    }
+    if (slot >= getRowPointCount(true, dutIdx)) {
+        return; // Past the baseline's points - left over from an older sweep
+    }
+    const ImpedanceRow& baseline = baselineImpedanceData[dutIdx];
+    uint32_t baselineFreq = storedFrequency(baseline.freqCode[slot]);
+    if (baselineFreq != finalPoint.freq_hz) {
+        return; // Off-grid point without a baseline at the same position
+    }
+
+    float baselineMag = baseline.mag[slot];
+    if (!isStoredPointValid(baseline, slot) || !finalPoint.valid || baselineMag <= 0.0f) {
+        return; // Skip invalid points
+    }
+    addSpectralMetricsPoint(dutIdx, baselineFreq, finalPoint.freq_idx, baselineMag, baseline.phase[slot],
+                            finalPoint.Z_magnitude, finalPoint.Z_phase);
+
+    if (baselineFreq >= riskFreqStartHz && baselineFreq <= riskFreqEndHz) {
+        riskRatioSum[dutIdx] += fabs(finalPoint.Z_magnitude / baselineMag);
+        riskRatioCount[dutIdx]++;
+    }
+}
 
-    // Print raw measurement m=point data
-    Serial.printf("Measurement: freq= %d, V=%.2f, I=%.2f, phase=%.2f, PGA=%d, TIA=%d, valid=%d\n",
-                  measPoint.freq_hz, measPoint.V_magnitude, measPoint.I_magnitude,
-                  measPoint.phase_deg, measPoint.pga_gain, measPoint.tia_gain, measPoint.valid);
+bool isRiskConfident(uint8_t dutIdx) {
+    int count = riskRatioCount[dutIdx];
+    if (count < FAST_SCREEN_MIN_POINTS) {
+        return false;
+    }
 
-    Serial.printf("Uncalibrated Impedance: freq= %d, |Z|=%.2f, phase=%.2f\n",
-                  result.freq_hz, result.Z_magnitude, result.Z_phase);
-    return result;
+    float avgChange = 1.0f - (riskRatioSum[dutIdx] / count);
+    const float cutoffs[] = {lowRiskCutoff, mediumRiskCutoff, highRiskCutoff};
+    for (float cutoff : cutoffs) {
+        if (fabs(avgChange - cutoff) < FAST_SCREEN_MARGIN) {
+            return false;
+        }
+    }
+    return true;
 }
 
 // Calculate risk level across range of interest for specified DUT
-void calculateRiskLevel(uint8_t dutIdx, uint32_t freqStartHz, uint32_t freqEndHz) {
-    // For the DUT, calculate average impedance magnitude change between baseline and final in the specified frequency range
+void calculateRiskLevel(uint8_t dutIdx) {
+    // For the DUT, average impedance magnitude change between baseline and final in the range of interest
     if (dutIdx >= MAX_DUT_COUNT) {
-        riskLevels[dutIdx] = RISK_ERROR; // Invalid DUT index
+        LOG_E("ERROR: Invalid DUT index %d for risk calculation\n", dutIdx + 1);
+        return;
+    }
+
+    // No point stored this sweep - the sums were never reset
+    int count = getStoredPointCount(dutIdx) > 0 ? riskRatioCount[dutIdx] : 0;
+    if (count == 0) {
+        riskLevels[dutIdx] = RISK_ERROR; // No valid data points in the range of interest
         riskPercentages[dutIdx] = 0.0f;
-        Serial.printf("ERROR: Invalid DUT index %d for risk calculation\n", dutIdx + 1);
+        LOG_E("ERROR: No valid data points for DUT %d in frequency range %lu-%lu Hz\n",
+              dutIdx + 1, riskFreqStartHz, riskFreqEndHz);
         return;
     }
-    // Get total change in range of interest
-    float totalChange = 0.0f;
-    int count = 0;
-    for (int i = 0; i < frequencyCount[dutIdx]; i++) {
-        ImpedancePoint baselinePoint = baselineImpedanceData[dutIdx][i];
-        ImpedancePoint finalPoint = measurementImpedanceData[dutIdx][i];
+    float avgChange = 1.0f - (riskRatioSum[dutIdx] / count); //Invert to make % reduction instead of % increase
+    riskLevels[dutIdx] = classifyRiskChange(avgChange);
+    riskPercentages[dutIdx] = avgChange*100.0f; // Store as percentage
+
+    // Print risk level
+    LOG_I("DUT %d Risk Calculation: Avg Change=%.3f, Risk Level=%d\n",
+          dutIdx + 1, riskPercentages[dutIdx], riskLevels[dutIdx]);
+}
+
+static int baselineSlotOf(uint8_t dutIdx, const ImpedanceRow& row, int i);
 
-        if (!baselinePoint.valid || !finalPoint.valid || baselinePoint.Z_magnitude <= 0.0f) {
-            continue; // Skip invalid points
+bool recalculateRiskLevel(uint8_t dutIdx, uint32_t freqStartHz, uint32_t freqEndHz) {
+    if (dutIdx >= MAX_DUT_COUNT) {
+        return false;
+    }
+    const ImpedanceRow& row = measurementImpedanceData[dutIdx];
+    const ImpedanceRow& baseline = baselineImpedanceData[dutIdx];
+    int count = min(getRowPointCount(false, dutIdx), MAX_FREQUENCIES);
+    float ratioSum = 0.0f;
+    int ratioCount = 0;
+    for (int i = 0; i < count; i++) {
+        int slot = baselineSlotOf(dutIdx, row, i);
+        if (slot < 0 || !isStoredPointValid(row, i) || !isStoredPointValid(baseline, slot) ||
+            baseline.mag[slot] <= 0.0f) {
+            continue;
+        }
+        uint32_t freq = storedFrequency(baseline.freqCode[slot]);
+        if (freq >= freqStartHz && freq <= freqEndHz) {
+            ratioSum += fabs(row.mag[i] / baseline.mag[slot]);
+            ratioCount++;
         }
+    }
+
+    RiskLevel level = RISK_ERROR;
+    float percent = 0.0f;
+    if (ratioCount > 0) {
+        float avgChange = 1.0f - ratioSum / ratioCount;
+        level = classifyRiskChange(avgChange);
+        percent = avgChange * 100.0f;
+    }
+    bool changed = level != riskLevels[dutIdx] ||
+                   lroundf(percent * 10.0f) != lroundf(riskPercentages[dutIdx] * 10.0f);
+    riskLevels[dutIdx] = level;
+    riskPercentages[dutIdx] = percent;
+    return changed;
+}
+
+/*=========================TRACKED BASELINE=========================*/
+// [DUT][baseline slot] - a slot without a valid baseline point is seeded by
+// its first valid final point
+static float trackedLogMag[MAX_DUT_COUNT][MAX_FREQUENCIES];
+static uint64_t trackedSeeded[MAX_DUT_COUNT];
+static RiskLevel trackedLevels[MAX_DUT_COUNT];
+static float trackedPercentages[MAX_DUT_COUNT];
+static uint8_t trackHalfLife = 0;
+static float trackAlpha = 0.0f;
 
-        if (baselinePoint.freq_hz >= freqStartHz && baselinePoint.freq_hz <= freqEndHz) {
-            float change = fabs(finalPoint.Z_magnitude / baselinePoint.Z_magnitude);
-            totalChange += change;
-            count++;
+static_assert(MAX_FREQUENCIES <= 64, "trackedSeeded holds one bit per slot");
+
+void resetTrackedBaseline(uint8_t halfLifeSweeps) {
+    trackHalfLife = halfLifeSweeps;
+    trackAlpha = halfLifeSweeps > 0 ? 1.0f - exp2f(-1.0f / halfLifeSweeps) : 0.0f;
+    for (int dut = 0; dut < MAX_DUT_COUNT; dut++) {
+        const ImpedanceRow& baseline = baselineImpedanceData[dut];
+        int count = dut < getDUTCount() ? min(getRowPointCount(true, dut), MAX_FREQUENCIES) : 0;
+        trackedSeeded[dut] = 0;
+        for (int slot = 0; slot < count; slot++) {
+            if (isStoredPointValid(baseline, slot) && baseline.mag[slot] > 0.0f) {
+                trackedLogMag[dut][slot] = logf(baseline.mag[slot]);
+                trackedSeeded[dut] |= 1ULL << slot;
+            }
         }
+        trackedLevels[dut] = RISK_NONE;
+        trackedPercentages[dut] = 0.0f;
     }
-    if (count == 0) {
-        riskLevels[dutIdx] = RISK_ERROR; // No valid data points in the range of interest
-        riskPercentages[dutIdx] = 0.0f;
-        Serial.printf("ERROR: No valid data points for DUT %d in frequency range %lu-%lu Hz\n",
-                      dutIdx + 1, freqStartHz, freqEndHz);
+}
+
+uint8_t getTrackingHalfLife() {
+    return trackHalfLife;
+}
+
+// Baseline slot of final row point i, -1 if it has no baseline point
+static int baselineSlotOf(uint8_t dutIdx, const ImpedanceRow& row, int i) {
+    uint8_t freqIdx = storedFreqIndex(row.freqCode[i]);
+    int slot = freqIdx < SWEEP_FREQ_COUNT ? baselineSlot[dutIdx][freqIdx] : i;
+    if (slot == SWEEP_FREQ_INVALID || slot >= min(getRowPointCount(true, dutIdx), MAX_FREQUENCIES) ||
+        storedFrequency(baselineImpedanceData[dutIdx].freqCode[slot]) != storedFrequency(row.freqCode[i])) {
+        return -1;
+    }
+    return slot;
+}
+
+void trackDUTBaseline(uint8_t dutIdx) {
+    if (trackHalfLife == 0 || dutIdx >= MAX_DUT_COUNT) {
         return;
     }
-    float avgChange = 1.0f - (totalChange / count); //Invert to make % reduction instead of % increase
-    
-    // Determine risk level based on average change
-    if (avgChange < lowRiskCutoff) {
-        riskLevels[dutIdx] = RISK_NONE;
-    } else if (avgChange < mediumRiskCutoff) {
-        riskLevels[dutIdx] = RISK_LOW;
-    } else if (avgChange < highRiskCutoff) {
-        riskLevels[dutIdx] = RISK_MEDIUM;
-    } else if (avgChange >= highRiskCutoff) {
-        riskLevels[dutIdx] = RISK_HIGH;
-    } else {
-        riskLevels[dutIdx] = RISK_ERROR; // Unable to calculate risk
-        riskPercentages[dutIdx] = 0.0f;
+    const ImpedanceRow& row = measurementImpedanceData[dutIdx];
+    const ImpedanceRow& baseline = baselineImpedanceData[dutIdx];
+    int count = min(getRowPointCount(false, dutIdx), MAX_FREQUENCIES);
+    float ratioSum = 0.0f;
+    int ratioCount = 0;
+    for (int i = 0; i < count; i++) {
+        int slot = baselineSlotOf(dutIdx, row, i);
+        if (slot < 0 || !isStoredPointValid(row, i) || row.mag[i] <= 0.0f) {
+            continue;
+        }
+        float logMag = logf(row.mag[i]);
+        uint64_t bit = 1ULL << slot;
+        if (trackedSeeded[dutIdx] & bit) {
+            uint32_t freq = storedFrequency(baseline.freqCode[slot]);
+            if (freq >= riskFreqStartHz && freq <= riskFreqEndHz) {
+                ratioSum += expf(logMag - trackedLogMag[dutIdx][slot]);
+                ratioCount++;
+            }
+            trackedLogMag[dutIdx][slot] += trackAlpha * (logMag - trackedLogMag[dutIdx][slot]);
+        } else {
+            trackedLogMag[dutIdx][slot] = logMag;
+            trackedSeeded[dutIdx] |= bit;
+        }
     }
 
-    riskPercentages[dutIdx] = avgChange*100.0f; // Store as percentage
+    if (ratioCount == 0) {
+        trackedLevels[dutIdx] = RISK_ERROR;
+        trackedPercentages[dutIdx] = 0.0f;
+        return;
+    }
+    float avgChange = 1.0f - ratioSum / ratioCount;
+    trackedLevels[dutIdx] = classifyRiskChange(avgChange);
+    trackedPercentages[dutIdx] = avgChange * 100.0f;
+    LOG_I("DUT %d tracked baseline: Avg Change=%.3f, Risk Level=%d\n",
+          dutIdx + 1, trackedPercentages[dutIdx], trackedLevels[dutIdx]);
+}
 
-    // Print risk level
-    Serial.printf("DUT %d Risk Calculation: Avg Change=%.3f, Risk Level=%d\n",
-                  dutIdx + 1, riskPercentages[dutIdx], riskLevels[dutIdx]);
+RiskLevel getTrackedRiskLevel(uint8_t dutIdx) {
+    return trackedLevels[dutIdx < MAX_DUT_COUNT ? dutIdx : 0];
+}
+
+float getTrackedRiskPercent(uint8_t dutIdx) {
+    return trackedPercentages[dutIdx < MAX_DUT_COUNT ? dutIdx : 0];
+}
+
+uint64_t getTrackedBaseline(uint8_t dutIdx, float* logMag) {
+    memcpy(logMag, trackedLogMag[dutIdx], sizeof(trackedLogMag[dutIdx]));
+    return trackedSeeded[dutIdx];
+}
+
+void setTrackedBaseline(uint8_t dutIdx, const float* logMag, uint64_t seeded) {
+    memcpy(trackedLogMag[dutIdx], logMag, sizeof(trackedLogMag[dutIdx]));
+    trackedSeeded[dutIdx] = seeded;
+}
+
+/*=========================CIRCUIT FIT=========================*/
+static CircuitFit circuitFits[2][MAX_DUT_COUNT];   // [final][DUT]
+
+void fitDUTCircuit(uint8_t dutIdx, bool final) {
+    if (dutIdx >= MAX_DUT_COUNT) {
+        return;
+    }
+    int64_t startUs = esp_timer_get_time();
+    const ImpedanceRow& row = final ? measurementImpedanceData[dutIdx] : baselineImpedanceData[dutIdx];
+    int count = min(getRowPointCount(!final, dutIdx), MAX_FREQUENCIES);
+
+    // Valid points only - skipped slots leave freqHz 0
+    uint32_t freqHz[MAX_FREQUENCIES];
+    for (int i = 0; i < count; i++) {
+        freqHz[i] = isStoredPointValid(row, i) ? storedFrequency(row.freqCode[i]) : 0;
+    }
+
+    // A final row starts from this sweep's baseline fit, a baseline from the
+    // previous one - the result goes through a copy, as start may be the slot
+    const CircuitFit& start = circuitFits[0][dutIdx];
+    CircuitFit& fit = circuitFits[final ? 1 : 0][dutIdx];
+    CircuitFit result;
+    fitCircuit(freqHz, row.mag, row.phase, count, &start, result);
+    fit = result;
+    sweepStatsRecord(STAGE_CIRCUIT_FIT, (uint32_t)(esp_timer_get_time() - startUs));
+
+    if (!fit.valid) {
+        LOG_W("WARNING: No circuit fit for DUT %d (%d valid points)\n", dutIdx + 1, fit.points);
+        return;
+    }
+    LOG_I("DUT %d fit: Rs=%.1f Rct=%.1f Q=%.3e n=%.3f, rms %.2f%%, %d evaluations%s\n",
+          dutIdx + 1, fit.params.rs, fit.params.rct, fit.params.q, fit.params.n,
+          fit.rmsError * 100.0f, fit.iterations, fit.converged ? "" : " (budget)");
+}
+
+const CircuitFit& getDUTCircuitFit(uint8_t dutIdx, bool final) {
+    return circuitFits[final ? 1 : 0][dutIdx < MAX_DUT_COUNT ? dutIdx : 0];
+}
+
+float getCircuitRctChange(uint8_t dutIdx) {
+    const CircuitFit& baseline = getDUTCircuitFit(dutIdx, false);
+    const CircuitFit& final = getDUTCircuitFit(dutIdx, true);
+    if (!baseline.valid || !final.valid || baseline.params.rct <= 0.0f) {
+        return 0.0f;
+    }
+    return 1.0f - final.params.rct / baseline.params.rct;
+}
+
+/*=========================KRAMERS-KRONIG CHECK=========================*/
+static KKResult kkResults[2][MAX_DUT_COUNT];    // [final][DUT]
+
+bool checkDUTKramersKronig(uint8_t dutIdx, bool final) {
+    if (dutIdx >= MAX_DUT_COUNT) {
+        return true;
+    }
+    const ImpedanceRow& row = final ? measurementImpedanceData[dutIdx] : baselineImpedanceData[dutIdx];
+    int count = min(getRowPointCount(!final, dutIdx), MAX_FREQUENCIES);
+
+    // Valid on-grid points only
+    uint8_t freqIdx[MAX_FREQUENCIES];
+    for (int i = 0; i < count; i++) {
+        freqIdx[i] = isStoredPointValid(row, i) ? storedFreqIndex(row.freqCode[i]) : SWEEP_FREQ_INVALID;
+    }
+
+    KKResult& result = kkResults[final ? 1 : 0][dutIdx];
+    checkKramersKronig(freqIdx, row.mag, row.phase, count, result);
+    if (!result.checked) {
+        LOG_I("DUT %d: KK check skipped (%d valid points)\n", dutIdx + 1, result.points);
+        return true;
+    }
+    if (result.passed) {
+        LOG_I("DUT %d: KK check passed, rms %.2f%%, max %.2f%%\n", dutIdx + 1,
+              result.rmsResidual * 100.0f, result.maxResidual * 100.0f);
+        return true;
+    }
+    LOG_W("WARNING: DUT %d fails the KK check - rms %.2f%%, max %.2f%% at %lu Hz\n", dutIdx + 1,
+          result.rmsResidual * 100.0f, result.maxResidual * 100.0f, sweepFrequencies[result.worstIdx]);
+    return false;
+}
+
+const KKResult& getDUTKKResult(uint8_t dutIdx, bool final) {
+    return kkResults[final ? 1 : 0][dutIdx < MAX_DUT_COUNT ? dutIdx : 0];
 }
@@ -0,0 +1,66 @@
+#include "impedance_math.h"
+#include "log.h"
+#include <math.h>
+
+float lowRiskCutoff = 0.05f;  
+float mediumRiskCutoff = 0.15f;
+float highRiskCutoff = 0.25f;
+
+/*=========================IMPEDANCE CALCULATION=========================*/
+// Calculate impedance from voltage and current samples
+
+
+ImpedancePoint calcImpedance(MeasurementPoint measPoint) {
+    ImpedancePoint result;
+
+    if (measPoint.I_magnitude <= 0.0f || !measPoint.valid) {
+        // Invalid current or measurement
+        result.valid = false;
+        return result;
+    }
+
+    result.freq_hz = measPoint.freq_hz;
+    result.valid = measPoint.valid;
+    result.Z_magnitude = measPoint.V_magnitude / measPoint.I_magnitude; // |Z| = V/I
+    result.Z_phase = measPoint.phase_deg; // Phase angle already in degrees
+    result.pga_gain = measPoint.pga_gain;
+    result.tia_gain = measPoint.tia_gain;
+    result.freq_idx = measPoint.freq_idx;
+#if IMPEDANCE_RECTANGULAR
+    // The STM32 reports polar - one sin/cos here, none while calibrating
+    float phaseRad = measPoint.phase_deg * (float)(M_PI / 180.0);
+    result.Z_re = result.Z_magnitude * cosf(phaseRad);
+    result.Z_im = result.Z_magnitude * sinf(phaseRad);
+#endif
+
+    // Print raw measurement m=point data
+    LOG_D("Measurement: freq= %d, V=%.2f, I=%.2f, phase=%.2f, PGA=%d, TIA=%d, valid=%d\n",
+                  measPoint.freq_hz, measPoint.V_magnitude, measPoint.I_magnitude,
+                  measPoint.phase_deg, measPoint.pga_gain, measPoint.tia_gain, measPoint.valid);
+
+    LOG_D("Uncalibrated Impedance: freq= %d, |Z|=%.2f, phase=%.2f\n",
+                  result.freq_hz, result.Z_magnitude, result.Z_phase);
+    return result;
+}
+
+#if IMPEDANCE_RECTANGULAR
+void impedanceToPolar(ImpedancePoint& point) {
+    point.Z_magnitude = sqrtf(point.Z_re * point.Z_re + point.Z_im * point.Z_im);
+    point.Z_phase = atan2f(point.Z_im, point.Z_re) * (float)(180.0 / M_PI);
+}
+#endif
+
+/*=========================RISK CLASSIFICATION=========================*/
+RiskLevel classifyRiskChange(float avgChange) {
+    // Determine risk level based on average change
+    if (avgChange < lowRiskCutoff) {
+        return RISK_NONE;
+    } else if (avgChange < mediumRiskCutoff) {
+        return RISK_LOW;
+    } else if (avgChange < highRiskCutoff) {
+        return RISK_MEDIUM;
+    } else if (avgChange >= highRiskCutoff) {
+        return RISK_HIGH;
+    }
+    return RISK_ERROR; // Unable to calculate risk (NaN)
+}
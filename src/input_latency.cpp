@@ -0,0 +1,77 @@
+#include "input_latency.h"
+#include "counters.h"
+#include "gui_screens.h"
+
+static FieldHistogram debounceUs("input.debounce_us", COUNTER_BOUNDS_US);
+static FieldHistogram waitUs("input.wait_us", COUNTER_BOUNDS_US);
+static FieldHistogram handleUs("input.handle_us", COUNTER_BOUNDS_US);
+static FieldHistogram paceUs("input.pace_us", COUNTER_BOUNDS_US);
+static FieldHistogram drawUs("input.draw_us", COUNTER_BOUNDS_US);
+static FieldHistogram pushUs("input.push_us", COUNTER_BOUNDS_US);
+static FieldCounter fullFrames("input.full_frames");
+static FieldCounter partialFrames("input.partial_frames");
+
+// By GUIState
+static FieldHistogram screenUs[] = {
+    {"input.splash_us", COUNTER_BOUNDS_US},
+    {"input.home_us", COUNTER_BOUNDS_US},
+    {"input.settings_us", COUNTER_BOUNDS_US},
+    {"input.freq_us", COUNTER_BOUNDS_US},
+    {"input.base_prog_us", COUNTER_BOUNDS_US},
+    {"input.base_done_us", COUNTER_BOUNDS_US},
+    {"input.final_prog_us", COUNTER_BOUNDS_US},
+    {"input.results_us", COUNTER_BOUNDS_US},
+    {"input.monitor_us", COUNTER_BOUNDS_US},
+    {"input.live_plot_us", COUNTER_BOUNDS_US},
+    {"input.overlay_us", COUNTER_BOUNDS_US},
+    {"input.diag_us", COUNTER_BOUNDS_US},
+};
+static_assert(sizeof(screenUs) / sizeof(screenUs[0]) == GUI_DIAGNOSTICS + 1, "One histogram per GUIState");
+
+// GUI task only: the oldest input still waiting for its frame
+static bool waiting = false;
+static bool received = false;       // Taken from the queue, not yet handled
+static uint32_t edgeUs = 0;
+static uint32_t receivedUs = 0;
+static uint32_t handledUs = 0;
+
+void inputLatencyReceived(const ButtonInput& input) {
+    receivedUs = micros();
+    received = !waiting;
+    if (!received) {
+        return;     // Answered by the frame an older input is waiting for
+    }
+    edgeUs = input.edgeUs;
+    if (input.queuedUs != input.edgeUs) {
+        debounceUs.record(input.queuedUs - input.edgeUs);
+    }
+    waitUs.record(receivedUs - input.queuedUs);
+}
+
+void inputLatencyHandled() {
+    if (!received) {
+        return;
+    }
+    received = false;
+    handledUs = micros();
+    handleUs.record(handledUs - receivedUs);
+    waiting = isRenderPending();
+}
+
+void inputLatencyFrame(uint32_t startUs, bool full) {
+    if (!waiting) {
+        return;
+    }
+    waiting = false;
+    uint32_t drawnUs = micros();
+    finishFramePush();
+    uint32_t doneUs = micros();
+
+    paceUs.record(startUs - handledUs);
+    drawUs.record(drawnUs - startUs);
+    pushUs.record(doneUs - drawnUs);
+    (full ? fullFrames : partialFrames).add();
+    if (currentGUIState <= GUI_DIAGNOSTICS) {
+        screenUs[currentGUIState].record(doneUs - edgeUs);
+    }
+}
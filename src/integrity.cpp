@@ -0,0 +1,108 @@
+#include "integrity.h"
+#include "console.h"
+#include "mbedtls/ecdsa.h"
+
+/*=========================SHA-256=========================*/
+
+void Sha256::begin() {
+    release();
+    mbedtls_sha256_init(&context);
+    mbedtls_sha256_starts(&context, 0);
+    active = true;
+}
+
+void Sha256::update(const void* data, size_t len) {
+    mbedtls_sha256_update(&context, static_cast<const unsigned char*>(data), len);
+}
+
+void Sha256::finish(uint8_t* digest) {
+    mbedtls_sha256_finish(&context, digest);
+    release();
+}
+
+void Sha256::release() {
+    if (active) {
+        mbedtls_sha256_free(&context);
+        active = false;
+    }
+}
+
+/*=========================ECDSA P-256=========================*/
+
+bool verifyP256Signature(const uint8_t* publicKey, const uint8_t* digest, const uint8_t* signature) {
+    mbedtls_ecp_group group;
+    mbedtls_ecp_point key;
+    mbedtls_mpi r;
+    mbedtls_mpi s;
+    mbedtls_ecp_group_init(&group);
+    mbedtls_ecp_point_init(&key);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    bool ok = mbedtls_ecp_group_load(&group, MBEDTLS_ECP_DP_SECP256R1) == 0 &&
+              mbedtls_ecp_point_read_binary(&group, &key, publicKey, P256_PUBLIC_KEY_SIZE) == 0 &&
+              mbedtls_ecp_check_pubkey(&group, &key) == 0 &&
+              mbedtls_mpi_read_binary(&r, signature, P256_SIGNATURE_SIZE / 2) == 0 &&
+              mbedtls_mpi_read_binary(&s, signature + P256_SIGNATURE_SIZE / 2, P256_SIGNATURE_SIZE / 2) == 0 &&
+              mbedtls_ecdsa_verify(&group, digest, SHA256_SIZE, &key, &r, &s) == 0;
+
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_point_free(&key);
+    mbedtls_ecp_group_free(&group);
+    return ok;
+}
+
+/*=========================SELF TEST=========================*/
+
+bool checkIntegrityEngines() {
+    static const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    // SHA-256("abc"), FIPS 180-2 appendix B.1
+    static const uint8_t abcDigest[SHA256_SIZE] = {
+        0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+        0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD,
+    };
+    // A test key's signature of "abc" (openssl dgst -sha256 -sign) - not the update key
+    static const uint8_t testKey[P256_PUBLIC_KEY_SIZE] = {
+        0x04, 0xBA, 0x6D, 0x90, 0x67, 0xA4, 0xCB, 0x62, 0xEA, 0x6E, 0xDA, 0x5E, 0xC7, 0x98, 0xA6, 0xB3,
+        0x93, 0x21, 0x8F, 0x9E, 0xF7, 0x7A, 0x52, 0x7B, 0xCE, 0x7C, 0xD8, 0xF2, 0x7B, 0x08, 0x1A, 0x5F,
+        0x31, 0x8A, 0x28, 0xCD, 0x4C, 0x04, 0x20, 0x25, 0xCA, 0xAF, 0x95, 0x5F, 0x9E, 0xC1, 0x74, 0xA4,
+        0xF7, 0xFE, 0x17, 0xCF, 0xDC, 0xBC, 0x41, 0xE2, 0x9E, 0x3F, 0x8E, 0x81, 0xBA, 0x04, 0x37, 0xB3,
+        0x07,
+    };
+    static const uint8_t abcSignature[P256_SIGNATURE_SIZE] = {
+        0x39, 0x53, 0x10, 0xB3, 0x57, 0xBD, 0xDA, 0x3F, 0xB3, 0xF7, 0xE0, 0x49, 0x98, 0xAE, 0x65, 0x85,
+        0xFC, 0x87, 0x8A, 0x15, 0xB7, 0x10, 0x0C, 0xF5, 0x8D, 0xCE, 0x9C, 0x7B, 0x6D, 0x24, 0x48, 0xF7,
+        0x6B, 0xFF, 0x06, 0x05, 0x7E, 0xDD, 0x00, 0x4B, 0xC1, 0x77, 0x76, 0x53, 0x81, 0xAE, 0xE5, 0x43,
+        0x79, 0x14, 0x51, 0x47, 0xFA, 0x5B, 0x87, 0x92, 0x32, 0xD9, 0x22, 0xA9, 0x55, 0xEF, 0x2F, 0x6E,
+    };
+
+    bool ok = true;
+    uint16_t crc = crc16_ccitt(check, sizeof(check));
+    if (crc != CRC16_CCITT_CHECK) {
+        Console.printf("ERROR: CRC-16 engine gives %04X, expected %04X\n", crc, CRC16_CCITT_CHECK);
+        ok = false;
+    }
+
+    Sha256 sha;
+    uint8_t digest[SHA256_SIZE];
+    sha.begin();
+    sha.update("a", 1);
+    sha.update("bc", 2);
+    sha.finish(digest);
+    if (memcmp(digest, abcDigest, sizeof(digest)) != 0) {
+        Console.println("ERROR: SHA-256 engine failed its known-answer test");
+        ok = false;
+    }
+
+    // The signature must hold, and must not once the digest changes
+    uint8_t tampered[SHA256_SIZE];
+    memcpy(tampered, abcDigest, sizeof(tampered));
+    tampered[0] ^= 0x01;
+    if (!verifyP256Signature(testKey, abcDigest, abcSignature) ||
+        verifyP256Signature(testKey, tampered, abcSignature)) {
+        Console.println("ERROR: ECDSA engine failed its known-answer test");
+        ok = false;
+    }
+    return ok;
+}
@@ -0,0 +1,171 @@
+#include "kk_check.h"
+#include <math.h>
+
+// Unknowns: R0, Rk, the series capacitance and inductance terms
+#define KK_UNKNOWNS     (KK_ELEMENTS + 3)
+#define KK_COL_R0       0
+#define KK_COL_RK       1
+#define KK_COL_C        (KK_ELEMENTS + 1)
+#define KK_COL_L        (KK_ELEMENTS + 2)
+#define KK_RIDGE        1e-9    // Relative to the mean diagonal - keeps sparse plans solvable
+
+/*=========================BASIS=========================*/
+// Per sweep index: real / imaginary part of each Voigt element with R = 1,
+// and the C and L columns scaled to at most 1 over the table
+static float basisRe[SWEEP_FREQ_COUNT][KK_ELEMENTS];
+static float basisIm[SWEEP_FREQ_COUNT][KK_ELEMENTS];
+static float basisC[SWEEP_FREQ_COUNT];
+static float basisL[SWEEP_FREQ_COUNT];
+static bool basisReady = false;
+
+static void initBasis() {
+    // Table is descending
+    double wMin = 2.0 * M_PI * sweepFrequencies[SWEEP_FREQ_LAST];
+    double wMax = 2.0 * M_PI * sweepFrequencies[0];
+    double tauMin = 1.0 / wMax;
+    double tauRatio = wMax / wMin;
+
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        double w = 2.0 * M_PI * sweepFrequencies[i];
+        for (int k = 0; k < KK_ELEMENTS; k++) {
+            // R / (1 + j*w*tau) = R * (1 - j*w*tau) / (1 + (w*tau)^2)
+            double x = w * tauMin * pow(tauRatio, (double)k / (KK_ELEMENTS - 1));
+            basisRe[i][k] = (float)(1.0 / (1.0 + x * x));
+            basisIm[i][k] = (float)(-x / (1.0 + x * x));
+        }
+        basisC[i] = (float)(-wMin / w);     // 1/(j*w*C) = -j/(w*C)
+        basisL[i] = (float)(w / wMax);
+    }
+    basisReady = true;
+}
+
+/*=========================SOLVER=========================*/
+// Solve the symmetric positive definite a * x = b in place (Cholesky)
+static bool solveCholesky(double a[KK_UNKNOWNS][KK_UNKNOWNS], double* b) {
+    for (int j = 0; j < KK_UNKNOWNS; j++) {
+        double d = a[j][j];
+        for (int k = 0; k < j; k++) {
+            d -= a[j][k] * a[j][k];
+        }
+        if (!(d > 0.0)) {
+            return false;
+        }
+        a[j][j] = sqrt(d);
+        for (int i = j + 1; i < KK_UNKNOWNS; i++) {
+            double s = a[i][j];
+            for (int k = 0; k < j; k++) {
+                s -= a[i][k] * a[j][k];
+            }
+            a[i][j] = s / a[j][j];
+        }
+    }
+    // L y = b, then L^T x = y
+    for (int i = 0; i < KK_UNKNOWNS; i++) {
+        for (int k = 0; k < i; k++) {
+            b[i] -= a[i][k] * b[k];
+        }
+        b[i] /= a[i][i];
+    }
+    for (int i = KK_UNKNOWNS - 1; i >= 0; i--) {
+        for (int k = i + 1; k < KK_UNKNOWNS; k++) {
+            b[i] -= a[k][i] * b[k];
+        }
+        b[i] /= a[i][i];
+    }
+    return true;
+}
+
+// One row of the real or imaginary design matrix at sweep index idx
+static void designRow(uint8_t idx, bool imaginary, double* row) {
+    row[KK_COL_R0] = imaginary ? 0.0 : 1.0;
+    for (int k = 0; k < KK_ELEMENTS; k++) {
+        row[KK_COL_RK + k] = imaginary ? basisIm[idx][k] : basisRe[idx][k];
+    }
+    row[KK_COL_C] = imaginary ? basisC[idx] : 0.0;
+    row[KK_COL_L] = imaginary ? basisL[idx] : 0.0;
+}
+
+bool checkKramersKronig(const uint8_t* freqIdx, const float* mag, const float* phaseDeg, int count,
+                        KKResult& out) {
+    out = KKResult();
+    if (!basisReady) {
+        initBasis();
+    }
+
+    // Weighted normal equations - each point counts relative to its |Z|
+    static double ata[KK_UNKNOWNS][KK_UNKNOWNS];
+    static double atb[KK_UNKNOWNS];
+    memset(ata, 0, sizeof(ata));
+    memset(atb, 0, sizeof(atb));
+    int points = 0;
+    for (int i = 0; i < count; i++) {
+        if (freqIdx[i] >= SWEEP_FREQ_COUNT || !(mag[i] > 0.0f)) {
+            continue;
+        }
+        double phaseRad = phaseDeg[i] * (M_PI / 180.0);
+        double part[2] = {cos(phaseRad), sin(phaseRad)};    // Z / |Z|
+        double w2 = 1.0 / ((double)mag[i] * mag[i]);
+        for (int p = 0; p < 2; p++) {
+            double row[KK_UNKNOWNS];
+            designRow(freqIdx[i], p == 1, row);
+            double z = mag[i] * part[p];
+            for (int j = 0; j < KK_UNKNOWNS; j++) {
+                if (row[j] == 0.0) {
+                    continue;
+                }
+                atb[j] += w2 * row[j] * z;
+                for (int k = 0; k <= j; k++) {
+                    ata[j][k] += w2 * row[j] * row[k];
+                }
+            }
+        }
+        points++;
+    }
+    out.points = points;
+    if (points < KK_MIN_POINTS) {
+        return false;
+    }
+
+    double trace = 0.0;
+    for (int j = 0; j < KK_UNKNOWNS; j++) {
+        trace += ata[j][j];
+        for (int k = j + 1; k < KK_UNKNOWNS; k++) {
+            ata[j][k] = ata[k][j];
+        }
+    }
+    double ridge = KK_RIDGE * trace / KK_UNKNOWNS;
+    for (int j = 0; j < KK_UNKNOWNS; j++) {
+        ata[j][j] += ridge;
+    }
+    if (!solveCholesky(ata, atb)) {
+        return false;
+    }
+
+    // Residuals of the fitted model
+    double sumSq = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (freqIdx[i] >= SWEEP_FREQ_COUNT || !(mag[i] > 0.0f)) {
+            continue;
+        }
+        double phaseRad = phaseDeg[i] * (M_PI / 180.0);
+        double part[2] = {cos(phaseRad), sin(phaseRad)};
+        for (int p = 0; p < 2; p++) {
+            double row[KK_UNKNOWNS];
+            designRow(freqIdx[i], p == 1, row);
+            double model = 0.0;
+            for (int j = 0; j < KK_UNKNOWNS; j++) {
+                model += row[j] * atb[j];
+            }
+            double residual = fabs(part[p] - model / mag[i]);
+            sumSq += residual * residual;
+            if (residual > out.maxResidual) {
+                out.maxResidual = (float)residual;
+                out.worstIdx = freqIdx[i];
+            }
+        }
+    }
+    out.rmsResidual = (float)sqrt(sumSq / (2 * points));
+    out.checked = true;
+    out.passed = out.rmsResidual <= KK_MAX_RMS && out.maxResidual <= KK_MAX_RESIDUAL;
+    return out.passed;
+}
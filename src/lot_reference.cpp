@@ -0,0 +1,273 @@
+#include "lot_reference.h"
+#include "console.h"
+#include "defines.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "impedance_calc.h"
+#include "repeat_filter.h"
+#include "open_channel.h"
+#include "storage.h"
+#include "crc.h"
+#include <LittleFS.h>
+#include <math.h>
+
+static_assert(sizeof(LotReference) <= STORAGE_ITEM_MAX, "LotReference must fit one storage operation");
+
+// GUI task only - the stored reference, valid while loaded
+static LotReference reference;
+static bool loaded = false;
+static bool enabled = LOT_REFERENCE_DEFAULT;
+
+// Last verification, for printLotReference()
+static uint8_t lastChecked = 0;
+static uint8_t lastInBand = 0;
+static bool lastUsed = false;
+
+static uint16_t referenceCrc(const LotReference& ref) {
+    return crc16_ccitt((const uint8_t*)&ref, offsetof(LotReference, crc));
+}
+
+/*=========================STORAGE=========================*/
+
+void initLotReference() {
+    loaded = false;
+    if (!isStorageMounted() || !LittleFS.exists(LOT_REF_FILE)) {
+        return;
+    }
+    fs::File file = LittleFS.open(LOT_REF_FILE, "r");
+    if (!file) {
+        return;
+    }
+    bool ok = file.read((uint8_t*)&reference, sizeof(reference)) == sizeof(reference) &&
+              reference.magic == LOT_REF_MAGIC && reference.version == LOT_REF_VERSION &&
+              reference.crc == referenceCrc(reference) && reference.name[LOT_REF_NAME_MAX - 1] == '\0' &&
+              reference.calSet[CAL_SET_NAME_MAX - 1] == '\0';
+    file.close();
+    if (!ok) {
+        Console.println("WARNING: Stored lot reference invalid - discarded");
+        LittleFS.remove(LOT_REF_FILE);
+        return;
+    }
+    loaded = true;
+    Console.printf("Lot reference \"%s\" loaded (%d points, %u sensors)\n", reference.name,
+                   __builtin_popcountll(reference.mask), reference.samples);
+}
+
+bool saveLotReference(const char* name, uint8_t numDuts, float magTolPct, float phaseTolDeg) {
+    // Sums per sweep index over the sample sensors
+    float magSum[SWEEP_FREQ_COUNT] = {};
+    float magSq[SWEEP_FREQ_COUNT] = {};
+    float phaseSum[SWEEP_FREQ_COUNT] = {};
+    float phaseSq[SWEEP_FREQ_COUNT] = {};
+    uint16_t magSdSum[SWEEP_FREQ_COUNT] = {};
+    uint16_t phaseSdSum[SWEEP_FREQ_COUNT] = {};
+    uint8_t count[SWEEP_FREQ_COUNT] = {};
+
+    memset(&reference, 0, sizeof(reference));
+    loaded = false;
+    for (uint8_t dut = 0; dut < numDuts && dut < getDUTCount(); dut++) {
+        if (isChannelOpen(dut)) {
+            continue;
+        }
+        const ImpedanceRow& row = baselineImpedanceData[dut];
+        int points = getRowPointCount(true, dut);
+        bool sample = false;
+        for (int i = 0; i < points; i++) {
+            uint8_t idx = storedFreqIndex(row.freqCode[i]);
+            if (idx >= SWEEP_FREQ_COUNT || !isStoredPointValid(row, i)) {
+                continue;
+            }
+            ImpedancePoint point = loadImpedancePoint(row, i);
+            if (count[idx] == 0) {
+                reference.points[idx].flags = IMPEDANCE_FLAG_VALID |
+                                              (row.flags[i] & (IMPEDANCE_FLAG_TIA_HIGH | IMPEDANCE_FLAG_PGA_MASK));
+            }
+            magSum[idx] += point.Z_magnitude;
+            magSq[idx] += point.Z_magnitude * point.Z_magnitude;
+            phaseSum[idx] += point.Z_phase;
+            phaseSq[idx] += point.Z_phase * point.Z_phase;
+            magSdSum[idx] += row.magSd[i];
+            phaseSdSum[idx] += row.phaseSd[i];
+            count[idx]++;
+            sample = true;
+        }
+        reference.samples += sample ? 1 : 0;
+    }
+
+    for (uint8_t idx = 0; idx < SWEEP_FREQ_COUNT; idx++) {
+        if (count[idx] == 0) {
+            continue;
+        }
+        LotRefPoint& point = reference.points[idx];
+        float n = count[idx];
+        point.mag = magSum[idx] / n;
+        point.phase = phaseSum[idx] / n;
+        float magSd = sqrtf(fmaxf(magSq[idx] / n - point.mag * point.mag, 0.0f));
+        float phaseSd = sqrtf(fmaxf(phaseSq[idx] / n - point.phase * point.phase, 0.0f));
+        point.magTol = fmaxf(magTolPct / 100.0f, point.mag > 0.0f ? LOT_REF_SD_BAND * magSd / point.mag : 0.0f);
+        point.phaseTol = fmaxf(phaseTolDeg, LOT_REF_SD_BAND * phaseSd);
+        point.magSd = magSdSum[idx] / count[idx];
+        point.phaseSd = phaseSdSum[idx] / count[idx];
+        reference.mask |= (SweepMask)1 << idx;
+    }
+    if (reference.mask == 0) {
+        Console.println("ERROR: No valid baseline point to build a lot reference from");
+        return false;
+    }
+
+    reference.magic = LOT_REF_MAGIC;
+    reference.version = LOT_REF_VERSION;
+    snprintf(reference.name, sizeof(reference.name), "%s", name);
+    snprintf(reference.calSet, sizeof(reference.calSet), "%s", getCalibrationSetName());
+    reference.crc = referenceCrc(reference);
+    loaded = true;
+    if (!isStorageMounted() || !queueStorageWrite(LOT_REF_FILE, &reference, sizeof(reference))) {
+        Console.println("WARNING: Lot reference not saved - kept until reboot");
+    }
+    Console.printf("Lot reference \"%s\": %d points from %u sensors\n", reference.name,
+                   __builtin_popcountll(reference.mask), reference.samples);
+    return true;
+}
+
+void clearLotReference() {
+    loaded = false;
+    if (isStorageMounted()) {
+        queueStorageRemove(LOT_REF_FILE);
+    }
+}
+
+void setLotReferenceEnabled(bool enable) {
+    enabled = enable;
+}
+
+bool isLotReferenceEnabled() {
+    return enabled;
+}
+
+/*=========================VERIFICATION=========================*/
+
+SweepMask getLotVerifyMask(SweepMask plan) {
+    int planned = __builtin_popcountll(plan);
+    if (!enabled || !loaded || (plan & ~reference.mask) != 0 || planned <= LOT_VERIFY_POINTS ||
+        strcmp(reference.calSet, getCalibrationSetName()) != 0) {
+        return 0;
+    }
+    // Both ends and evenly between, in plan order
+    SweepMask verify = 0;
+    int n = 0;
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        if (!(plan & ((SweepMask)1 << i))) {
+            continue;
+        }
+        for (int k = 0; k < LOT_VERIFY_POINTS; k++) {
+            if (n == k * (planned - 1) / (LOT_VERIFY_POINTS - 1)) {
+                verify |= (SweepMask)1 << i;
+            }
+        }
+        n++;
+    }
+    return verify;
+}
+
+// dut's points at the verified indices all arrived, valid and in band
+static bool isDUTInBand(uint8_t dut, SweepMask plan, SweepMask verified) {
+    const ImpedanceRow& row = baselineImpedanceData[dut];
+    int count = getStoredPointCount(dut);
+    for (uint8_t idx = 0; idx < SWEEP_FREQ_COUNT; idx++) {
+        SweepMask bit = (SweepMask)1 << idx;
+        if (!(verified & bit)) {
+            continue;
+        }
+        // Stored by plan slot (meas_session.h)
+        int slot = __builtin_popcountll(plan & (bit - 1));
+        if (slot >= count || storedFreqIndex(row.freqCode[slot]) != idx || !isStoredPointValid(row, slot)) {
+            Console.printf("Lot reference: DUT %d has no point at %lu Hz\n", dut + 1, sweepFrequencies[idx]);
+            return false;
+        }
+        ImpedancePoint point = loadImpedancePoint(row, slot);
+        const LotRefPoint& ref = reference.points[idx];
+        float magDev = fabsf(point.Z_magnitude / ref.mag - 1.0f);
+        float phaseDev = fabsf(point.Z_phase - ref.phase);
+        if (magDev > ref.magTol || phaseDev > ref.phaseTol) {
+            Console.printf("Lot reference: DUT %d out of band at %lu Hz (|Z| %+.1f%%, phase %+.1f deg)\n",
+                           dut + 1, sweepFrequencies[idx], (point.Z_magnitude / ref.mag - 1.0f) * 100.0f,
+                           point.Z_phase - ref.phase);
+            return false;
+        }
+    }
+    return true;
+}
+
+// The reference over plan as dut's baseline row
+static void fillDUTRow(uint8_t dut, SweepMask plan) {
+    const ImpedanceRow& row = baselineImpedanceData[dut];
+    resetBaselineSlots(dut);
+    int slot = 0;
+    for (uint8_t idx = 0; idx < SWEEP_FREQ_COUNT; idx++) {
+        if (!(plan & ((SweepMask)1 << idx))) {
+            continue;
+        }
+        const LotRefPoint& ref = reference.points[idx];
+        ImpedancePoint point;
+        point.freq_hz = sweepFrequencies[idx];
+        point.freq_idx = idx;
+        point.Z_magnitude = ref.mag;
+        point.Z_phase = ref.phase;
+        point.pga_gain = ref.flags & IMPEDANCE_FLAG_PGA_MASK;
+        point.tia_gain = (ref.flags & IMPEDANCE_FLAG_TIA_HIGH) != 0;
+        point.valid = true;
+        PointNoise noise;
+        noise.magSd = ref.magSd;
+        noise.phaseSd = ref.phaseSd;
+        storeImpedancePoint(row, slot, point, noise);
+        recordBaselinePoint(dut, slot, point);
+        slot++;
+    }
+    publishFilledRow(dut, slot);
+#if KK_CHECK
+    checkDUTKramersKronig(dut, false);
+#endif
+#if CIRCUIT_FIT
+    fitDUTCircuit(dut, false);
+#endif
+}
+
+bool applyLotReference(uint8_t numDuts, SweepMask plan, SweepMask verified) {
+    lastChecked = 0;
+    lastInBand = 0;
+    lastUsed = false;
+    for (uint8_t dut = 0; dut < numDuts; dut++) {
+        if (isChannelOpen(dut)) {
+            continue;
+        }
+        lastChecked++;
+        lastInBand += isDUTInBand(dut, plan, verified) ? 1 : 0;
+    }
+    if (lastChecked == 0 || lastInBand < lastChecked) {
+        return false;
+    }
+    for (uint8_t dut = 0; dut < numDuts; dut++) {
+        if (!isChannelOpen(dut)) {
+            fillDUTRow(dut, plan);
+        }
+    }
+    lastUsed = true;
+    return true;
+}
+
+void printLotReference() {
+    Console.printf("Lot reference: %s", enabled ? "on" : "off");
+    if (!loaded) {
+        Console.println(", none stored");
+        return;
+    }
+    Console.printf(", \"%s\" - %d points from %u sensors, calibration set \"%s\"%s\n", reference.name,
+                   __builtin_popcountll(reference.mask), reference.samples, reference.calSet,
+                   strcmp(reference.calSet, getCalibrationSetName()) == 0 ? "" : " (not active)");
+    Console.printf("Verification sweep: %d points; default band %.1f%% / %.1f deg or %.0f sample spreads\n",
+                   LOT_VERIFY_POINTS, LOT_REF_MAG_TOL_PCT, LOT_REF_PHASE_TOL_DEG, LOT_REF_SD_BAND);
+    if (lastChecked > 0) {
+        Console.printf("Last verification: %u of %u DUTs in band - %s\n", lastInBand, lastChecked,
+                       lastUsed ? "reference used" : "full baseline");
+    }
+}
@@ -3,239 +3,1334 @@
 #include "freertos/task.h"
 #include "freertos/queue.h"
 #include "defines.h"
+#include "log.h"
+#include "console.h"
+#include "trace.h"
+#include "sweep_stats.h"
 #include "UART_Functions.h"
 #include "calibration.h"
+#include "fixed_cal.h"
+#include "cal_upload.h"
+#include "ota_update.h"
+#include "cal_acquire.h"
+#include "raw_capture.h"
+#include "cal_set.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "meas_control.h"
+#include "repeat_filter.h"
+#include "repeat_plan.h"
+#include "sweep_refine.h"
+#include "lot_reference.h"
+#include "perf_dashboard.h"
+#include "sweep_config.h"
+#include "session_log.h"
+#include "history_download.h"
+#include "storage.h"
+#include "ble_bench.h"
+#include "monitor.h"
+#include "sweep_watchdog.h"
+#include "sweep_eta.h"
+#include "bg_jobs.h"
 #include "impedance_calc.h"
 #include "bode_plot.h"
-#include "csv_export.h"
+#include "usb_export.h"
 #include "serial_commands.h"
 #include "BLE_Functions.h"
 #include "gui_state.h"
 #include "gui_screens.h"
 #include "button_handler.h"
+#include "boot_timing.h"
+#include "power_manager.h"
+#include "task_monitor.h"
+#include "heap_stats.h"
+#include "stm32_sim.h"
+#include "wifi_server.h"
+#include "spectral_metrics.h"
+#include "baseline_store.h"
+#include "open_channel.h"
+#include "sweep_presets.h"
+#include "recipe.h"
+#include "fleet_aggregator.h"
+#include "thread_uplink.h"
+#include "screen_mirror.h"
+#include "counters.h"
+#include "display_power.h"
+#include "integrity.h"
+#include "input_latency.h"
+#include "sleep_monitor.h"
+#include "sweep_bench.h"
+#include "freertos/event_groups.h"
 
 /*=========================GLOBAL VARIABLES=========================*/
-// Initialize global impedance data arrays
-ImpedancePoint baselineImpedanceData[MAX_DUT_COUNT][MAX_FREQUENCIES];
-ImpedancePoint measurementImpedanceData[MAX_DUT_COUNT][MAX_FREQUENCIES];
-int frequencyCount[MAX_DUT_COUNT] = {0};
-bool measurementInProgress = false;
-bool baselineMeasurementDone = false;
-bool finalMeasurementDone = false;
+// Impedance data rows live in the measurement store (meas_store.cpp)
+std::atomic<bool> measurementInProgress{false};
+std::atomic<bool> baselineMeasurementDone{false};
+std::atomic<bool> finalMeasurementDone{false};
 uint8_t startIDX = 0;
-uint8_t endIDX = 37;
+uint8_t endIDX = SWEEP_FREQ_LAST;
+SweepMask sweepMask = 0;        // Planned sparse sweep, 0 = startIDX..endIDX
+SweepMask customSweepMask = 0;  // Operator-selected sparse sweep (SWEEP / sweep), 0 = none
 uint8_t num_duts = 1;
 float calcStartFreq = 125;
 float calcEndFreq = 100000;
 // Splash screen timer (2 seconds)
+#define SPLASH_DURATION_MS  2000
 unsigned long splashStartTime;
 
-// FreeRTOS queue for measurement data
+// FreeRTOS queue for measurement data (MeasurementBatch pointers)
 QueueHandle_t measurementQueue;
+static uint8_t measurementQueueStorage[MEASUREMENT_BATCH_POOL * sizeof(MeasurementBatch*)];
+static StaticQueue_t measurementQueueControl;
 
 /*=========================TASK: UART READER=========================*/
-// Task to process bytes from circular buffer
-// ISR just collects bytes - this task does the heavy state machine work
+// Task to process UART driver events
+// The driver ISR collects bytes - this task does the heavy state machine work
 void taskUARTReader(void* parameter) {
-    Serial.println("UART Reader task started");
-
-    SemaphoreHandle_t uartSem = getUARTSemaphore();
+    Console.println("UART Reader task started");
 
     while (true) {
-        // Wait for semaphore from ISR (signals data was received)
-        // This task sleeps until interrupt occurs - no polling!
-        if (xSemaphoreTake(uartSem, pdMS_TO_TICKS(10000)) == pdTRUE) {
-            // Process all buffered bytes from ISR circular buffer
-            // This runs in task context with full stack - safe!
-            processBufferedBytes();
-        } else {
-            // Timeout - no data for 10 seconds (normal during idle)
+        taskWatchdogFeed();
+        // Block on the driver event queue - wakes once per received block
+        // This task sleeps until data arrives - no polling!
+        if (!processUARTEvents(pdMS_TO_TICKS(MEASUREMENT_BATCH_IDLE_MS))) {
+            // Link idle - hand over any partially filled batch, and repeat
+            // the credit grant in case the STM32 is holding for a lost one
+            flushMeasurementBatch();
+            grantFlowCredit(true);
         }
     }
 }
 
+/*=========================TASK: UART COMMANDS=========================*/
+// Task that owns STM32 command TX: pipelined PGA/MUX/TIA settings and
+// blocking START/STOP (send, wait for ACK, retry) - keeps ACK waits off the GUI task
+void taskUARTCommand(void* parameter) {
+    Console.println("UART Command task started");
+
+    while (true) {
+        taskWatchdogFeed();
+        processUARTCommandRequests(pdMS_TO_TICKS(TASK_WDT_FEED_MS));
+    }
+}
+
+#if STM32_SIM
+/*=========================TASK: VIRTUAL STM32=========================*/
+// Answers the commands and streams the frames of the simulated front end
+void taskSTM32Sim(void* parameter) {
+    Console.println("Virtual STM32 task started");
+
+    while (true) {
+        taskWatchdogFeed();
+        processSTM32Sim(pdMS_TO_TICKS(STM32_SIM_IDLE_MS));
+    }
+}
+#endif
+
+/*=========================TASK: BLE TX=========================*/
+// Task that owns BLE notifications: sends the chunks other tasks queued with
+// sendBLEString() as fast as the stack confirms them - keeps BLE pacing off the GUI task
+void taskBLETx(void* parameter) {
+    Console.println("BLE TX task started");
+
+    while (true) {
+        taskWatchdogFeed();
+        // Wakes up now and then so an idle link can drop to power-saving parameters
+        processBLETx(pdMS_TO_TICKS(1000));
+    }
+}
+
 /*=========================TASK: DATA PROCESSOR=========================*/
-// Task to receive measurements, calibrate, calculate impedance, and store
+// DUTs already ended early by fast screen in the current final sweep
+static bool fastScreenStopped[MAX_DUT_COUNT];
+// Re-sweeps of a DUT that failed the KK check, in the current session
+static uint8_t kkResweeps[MAX_DUT_COUNT];
+
+// Store a finished point at its plan slot and keep the risk sums current so
+// the result is ready at DUT_END
+static void storeProcessedPoint(uint8_t dutIndex, bool final, const ImpedanceRow& target,
+                                const ImpedancePoint& impedance, const PointNoise& noise) {
+    int end = getNextPointIndex(dutIndex);
+    int freqIndex = claimPointSlot(dutIndex, impedance.freq_idx);
+    if (freqIndex < 0) {
+        LOG_D("DUT %d: %lu Hz already stored or not planned - dropped\n", dutIndex + 1, impedance.freq_hz);
+        return;
+    }
+    LOG_D("Storing data for DUT %d at freq index %d (freq=%lu Hz)\n",
+          dutIndex + 1, freqIndex, impedance.freq_hz);
+    if (freqIndex >= getPointsPerDUT()) {
+        Console.printf("ERROR: Frequency buffer full for DUT %d\n", dutIndex + 1);
+        return;
+    }
+    // Points that did not arrive read as invalid until a repair sweep fills them
+    for (int gap = end; gap < freqIndex; gap++) {
+        ImpedancePoint missing;
+        missing.freq_idx = getSlotFreqIndex(gap);
+        missing.freq_hz = missing.freq_idx < SWEEP_FREQ_COUNT ? sweepFrequencies[missing.freq_idx] : 0;
+        storeImpedancePoint(target, gap, missing);
+    }
+    storeImpedancePoint(target, freqIndex, impedance, noise);
+    publishMeasurementPoints(dutIndex, max(end, freqIndex + 1));
+    GUIState shown = getGUIState();
+    if (shown == GUI_LIVE_PLOT || shown == GUI_BASELINE_PROGRESS || shown == GUI_FINAL_PROGRESS) {
+        wakeGUITask(GUI_WAKE_POINT);
+    }
+
+    // Live view - the WebUI draws the point while the sweep goes on
+    if (anyBLEClientStreaming() || getWiFiLiveClients() > 0) {
+        sendBLELivePoint(dutIndex, freqIndex, final);
+    }
+
+    // First point of the row in this session
+    bool first = end == 0;
+    if (!final) {
+        if (first) {
+            resetBaselineSlots(dutIndex);
+        }
+        recordBaselinePoint(dutIndex, freqIndex, impedance);
+        return;
+    }
+    if (first) {
+        resetRiskAccumulator(dutIndex, calcStartFreq, calcEndFreq);
+        fastScreenStopped[dutIndex] = false;
+    }
+    accumulateRiskPoint(dutIndex, freqIndex, impedance);
+
+    // Fast screen: the rest of this DUT cannot change its class
+    if (fastScreenMode && !fastScreenStopped[dutIndex] && isRiskConfident(dutIndex)) {
+        fastScreenStopped[dutIndex] = true;
+        Console.printf("Fast screen: DUT %d classified after %d points\n", dutIndex + 1, freqIndex + 1);
+        // Its other points are left out on purpose - no repair asks for them
+        closeMeasurementRow(dutIndex);
+        sendSkipDUTCommandAsync(dutIndex + 1);
+    }
+}
+
+#if KK_CHECK
+// A DUT failed the KK check: once per session its whole row goes back to
+// missing, so the sweep's repair pass (meas_control.h) measures it again
+// and its delivery waits for that. Fast-screened rows and calibration
+// sweeps keep what they have
+static void resweepFailedDUT(uint8_t dutIndex, bool final) {
+    if (kkResweeps[dutIndex] >= KK_RESWEEP_MAX || fastScreenStopped[dutIndex] || isChannelOpen(dutIndex) ||
+        getMeasurementSource() == MEAS_SOURCE_CAL || !isSweepRepairAvailable()) {
+        return;
+    }
+    kkResweeps[dutIndex]++;
+    reopenMeasurementRow(dutIndex);
+    // The repaired points are summed again from the start
+    if (final) {
+        resetRiskAccumulator(dutIndex, calcStartFreq, calcEndFreq);
+    }
+    Console.printf("DUT %d: KK check failed - re-measuring it\n", dutIndex + 1);
+    Console.printf("@EVT kk_resweep %d\n", dutIndex + 1);
+}
+#endif
+
+// Task to receive measurements, calibrate, calculate impedance, average repeats and store
 void taskDataProcessor(void* parameter) {
-    MeasurementPoint point;
-    Serial.println("Data Processor task started");
+    MeasurementBatch* batch;
+    Console.println("Data Processor task started");
 
     while (true) {
-        // Wait for measurement point from queue
-        if (xQueueReceive(measurementQueue, &point, portMAX_DELAY) == pdTRUE) {
-            // Get current DUT number (1-4 from STM, convert to 0-3 for array)
-            uint8_t dutIndex = getCurrentDUT() - 1;
+        taskWatchdogFeed();
+        // Switch to a reloaded calibration table between sweeps - this task is
+        // the only calibration reader, so the swap needs no lock
+        if (!measurementInProgress) {
+            applyPendingCalibrationLUT();
+        }
 
-            if (dutIndex >= MAX_DUT_COUNT) {
-                Serial.printf("ERROR: Invalid DUT index %d\n", dutIndex + 1);
-                continue;
+        // Wait for a batch of measurement points from the UART reader
+        // (wake up periodically while a reload waits to be applied)
+        TickType_t wait = pdMS_TO_TICKS(isCalibrationReloadPending() ? CAL_SWAP_POLL_MS : TASK_WDT_FEED_MS);
+        if (xQueueReceive(measurementQueue, &batch, wait) != pdTRUE) {
+            continue;
+        }
+
+        // Points of a stopped sweep are dropped, uncalibrated - also those the
+        // STM32 sends before it takes the STOP; a new sweep starts on cleared rows
+        SessionSync sync = syncMeasurementSession(batch->generation);
+        if (sync == SESSION_STALE) {
+            releaseMeasurementBatch(batch);
+            continue;
+        }
+        bool final = isFinalGeneration(batch->generation);
+        if (sync == SESSION_NEW) {
+            // Any point left half-averaged by a STOP
+            resetRepeatFilter();
+            memset(kkResweeps, 0, sizeof(kkResweeps));
+            // The final sweep skips the baseline's empty slots - nothing to repair
+            resetOpenChannelScan(final);
+            for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+                if (isChannelOpen(dut)) {
+                    closeMeasurementRow(dut);
+                }
+            }
+        }
+        // The reference resistor of a calibration step is never an empty slot
+        bool scanOpen = getMeasurementSource() != MEAS_SOURCE_CAL;
+
+        // DUT number is 1-based from STM, convert to 0-based for array
+        uint8_t dutIndex = batch->dut - 1;
+
+        if (dutIndex >= getDUTCount()) {
+            Console.printf("ERROR: Invalid DUT index %d\n", dutIndex + 1);
+            if (batch->dutComplete) {
+                signalDUTComplete(batch->dut, batch->generation);
             }
+            releaseMeasurementBatch(batch);
+            continue;
+        }
 
+        // Raw capture: the points as received, nothing calculated or stored
+        if (isRawCaptureActive()) {
+            for (int i = 0; i < batch->count; i++) {
+                captureRawPoint(batch->dut, final, batch->points[i]);
+            }
+            trace(TRACE_BATCH_PROCESSED, batch->dut, batch->count);
+            bool dutComplete = batch->dutComplete;
+            uint32_t generation = batch->generation;
+            releaseMeasurementBatch(batch);
+            if (dutComplete) {
+                signalDUTComplete(dutIndex + 1, generation);
+            }
+            continue;
+        }
 
+        // New DUT_START: repeats left half-averaged by a stall are dropped; a
+        // resumed or repaired DUT keeps the points it has
+        if (batch->dutStart) {
+            resetRepeatFilter();
+        }
+
+        const ImpedanceRow& target = final ? measurementImpedanceData[dutIndex]
+                                           : baselineImpedanceData[dutIndex];
+
+        for (int i = 0; i < batch->count; i++) {
+            const MeasurementPoint& point = batch->points[i];
+
+            // Raw point for an on-device calibration (reference resistor on channel 1)
+            if (dutIndex == 0) {
+                recordCalAcquirePoint(point);
+            }
+
+            // Empty slot: the rest of its sweep is not wanted (open_channel.h)
+            if (scanOpen && noteOpenChannelPoint(dutIndex, point)) {
+                Console.printf("DUT %d: no signal in its first %d points - empty slot, skipped\n",
+                              dutIndex + 1, OPEN_CHANNEL_POINTS);
+                Console.printf("@EVT dut_open %d\n", dutIndex + 1);
+                closeMeasurementRow(dutIndex);
+                sendSkipDUTCommandAsync(dutIndex + 1);
+            }
+
+#if CAL_FIXED_POINT
+            // Impedance + calibration in one integer pass
+            ImpedancePoint impedance;
+            bool calibrated = calcCalibratedImpedanceFixed(point, impedance);
+#else
             // Calculate impedance: Z = V / I
             ImpedancePoint impedance = calcImpedance(point);
 
             // Calibrate the measurement point
-            if (calibrate(impedance)) {
-                Serial.printf("Calibrated: Z=%.6e Phase=%.2f\n",
-                             impedance.Z_magnitude, impedance.Z_phase);
+            bool calibrated = calibrate(impedance);
+#if IMPEDANCE_RECTANGULAR
+            // Stored points are polar for BLE, CSV and the screen
+            impedanceToPolar(impedance);
+#endif
+#endif
+            if (calibrated) {
+                LOG_D("Calibrated: Z=%.6e Phase=%.2f\n",
+                      impedance.Z_magnitude, impedance.Z_phase);
             } else {
-                Serial.printf("WARNING: Calibration failed for freq=%lu Hz\n", point.freq_hz);
+                LOG_W("WARNING: Calibration failed for freq=%lu Hz\n", point.freq_hz);
             }
 
-            // Store in global impedance array
-            int freqIndex = frequencyCount[dutIndex];
-            // Print frequency index
-            Serial.printf("Storing data for DUT %d at freq index %d (freq=%lu Hz)\n",
-                          dutIndex + 1, freqIndex, impedance.freq_hz);
-            if (freqIndex < MAX_FREQUENCIES) {
-                if (baselineMeasurementDone) {
-                    measurementImpedanceData[dutIndex][freqIndex] = impedance;
-                } else {
-                    baselineImpedanceData[dutIndex][freqIndex] = impedance;
-                }
-                frequencyCount[dutIndex]++;
-            } else {
-                Serial.printf("ERROR: Frequency buffer full for DUT %d\n", dutIndex + 1);
+            // Average the repeats of this frequency - stored once complete
+            ImpedancePoint averaged;
+            PointNoise noise;
+            if (addRepeatSample(dutIndex, impedance, averaged, noise)) {
+                storeProcessedPoint(dutIndex, final, target, averaged, noise);
+            }
+        }
+
+        // The last point may still be short of repeats
+        ImpedancePoint averaged;
+        PointNoise noise;
+        if (batch->dutComplete && flushRepeatSample(dutIndex, averaged, noise)) {
+            storeProcessedPoint(dutIndex, final, target, averaged, noise);
+        }
+
+        trace(TRACE_BATCH_PROCESSED, batch->dut, batch->count);
+        bool dutComplete = batch->dutComplete;
+        uint32_t generation = batch->generation;
+        releaseMeasurementBatch(batch);
+
+        // All points of this DUT are stored - now the GUI may draw it
+        if (dutComplete) {
+#if KK_CHECK
+            if (!checkDUTKramersKronig(dutIndex, final)) {
+                resweepFailedDUT(dutIndex, final);
             }
+#endif
+#if CIRCUIT_FIT
+            fitDUTCircuit(dutIndex, final);
+#endif
+            signalDUTComplete(dutIndex + 1, generation);
         }
     }
 }
 
 /*=========================BLE COMMAND PROCESSING=========================*/
-void processBLECommands() {
-    char cmdBuffer[64];
+// BASELINE_START fields the command leaves out (all channels, first frequency,
+// current calculation band and risk cutoffs) - also the serial preset command's
+SweepConfig sweepConfigDefaults() {
+    SweepConfig config = {};
+    config.numDuts = getDUTCount();
+    config.startIdx = 0;
+    config.endIdx = 0;
+    config.calcStartFreq = calcStartFreq;
+    config.calcEndFreq = calcEndFreq;
+    config.lowCutoff = lowRiskCutoff;
+    config.mediumCutoff = mediumRiskCutoff;
+    config.highCutoff = highRiskCutoff;
+    return config;
+}
 
-    // Check for BLE command
-    if (!getBLECommand(cmdBuffer, sizeof(cmdBuffer))) {
-        return;  // No command available
+// A baseline waits for its final sweep - a new one would discard it
+static bool baselineAwaitsFinal() {
+    if (baselineMeasurementDone && !finalMeasurementDone && getMeasurementState() == MEAS_IDLE) {
+        sendBLEError("Baseline measurement already done, proceed to MEAS");
+        return true;
     }
+    return false;
+}
 
-    Serial.printf("[BLE] Processing command: '%s'\n", cmdBuffer);
+// Text or binary BASELINE_START
+static void startBaseline(const SweepConfig& config) {
+    if (baselineAwaitsFinal()) {
+        return;
+    }
 
-    String cmdStr(cmdBuffer);
+    if (config.error != SWEEP_CONFIG_OK) {
+        char errorMsg[48];
+        if (config.error == SWEEP_CONFIG_DUTS) {
+            snprintf(errorMsg, sizeof(errorMsg), "Invalid Sensor count (must be 1-%d)", getDUTCount());
+        } else {
+            snprintf(errorMsg, sizeof(errorMsg), "%s (field %d)", sweepConfigErrorText(config.error), config.errorField);
+        }
+        Console.printf("[BLE] ERROR: BASELINE_START rejected - %s\n", errorMsg);
+        sendBLEError(errorMsg);
+        return;
+    }
+
+    // Start measurement via UART (the controller reports the STM32's answer)
+    SweepPlan plan = {config.numDuts, config.startIdx, config.endIdx,
+                      config.sweepMask != 0 ? config.sweepMask : customSweepMask};
+    MeasRequestError error = requestBaselineSweep(MEAS_SOURCE_BLE, plan);
+    if (error != MEAS_REQUEST_OK) {
+        sendBLEError(measRequestErrorText(error));
+        return;
+    }
+
+    calcStartFreq = config.calcStartFreq;
+    calcEndFreq = config.calcEndFreq;
+    lowRiskCutoff = config.lowCutoff;
+    mediumRiskCutoff = config.mediumCutoff;
+    highRiskCutoff = config.highCutoff;
+
+    HAL_PRINTF("[BLE] BASELINE_START -> %d DUT(s), start=%u, stop=%u\n", num_duts, startIDX, endIDX);
+    if (config.sweepMask != 0) {
+        HAL_PRINTF("[BLE] Planned sweep: %d frequencies, mask 0x%010llX\n",
+                   __builtin_popcountll(config.sweepMask), (unsigned long long)config.sweepMask);
+    }
+    HAL_PRINTF("[BLE] CalcFreqs: %.0f - %.0f Hz, Limits: L=%.3f M=%.3f H=%.3f\n",
+               calcStartFreq, calcEndFreq, lowRiskCutoff, mediumRiskCutoff, highRiskCutoff);
+    HAL_PRINTF("[BLE] Starting Baseline measurement with %d Sensor%s...\n", num_duts, num_duts > 1 ? "s" : "");
+}
+
+// PRESET:<name> - the stored plan goes out as it is
+static void startPreset(const char* name) {
+    const SweepPreset* preset = findSweepPreset(name);
+    if (preset == nullptr) {
+        sendBLEError(sweepPresetErrorText(SWEEP_PRESET_NOT_FOUND));
+        return;
+    }
+    if (baselineAwaitsFinal()) {
+        return;
+    }
+    MeasRequestError error = startSweepPreset(MEAS_SOURCE_BLE, *preset);
+    if (error != MEAS_REQUEST_OK) {
+        sendBLEError(measRequestErrorText(error));
+        return;
+    }
+    HAL_PRINTF("[BLE] PRESET %s -> %d DUT(s), start=%u, stop=%u, repeats=%d\n", preset->name, num_duts,
+               startIDX, endIDX, preset->repeats);
+}
+
+// PRESET_SAVE:<name>[,<fields>] - the fields are those of BASELINE_START
+static void savePreset(const char* args) {
+    char name[SWEEP_PRESET_NAME_MAX];
+    const char* comma = strchr(args, ',');
+    size_t len = comma != nullptr ? comma - args : strlen(args);
+    if (len >= sizeof(name)) {
+        sendBLEError(sweepPresetErrorText(SWEEP_PRESET_NAME));
+        return;
+    }
+    memcpy(name, args, len);
+    name[len] = '\0';
+
+    char cmd[BLE_CMD_MAX_LEN + 16];
+    snprintf(cmd, sizeof(cmd), "%s%s%s", BLE_CMD_BASELINE, comma != nullptr ? ":" : "",
+             comma != nullptr ? comma + 1 : "");
+    SweepConfig config = parseSweepConfigText(cmd, sweepConfigDefaults());
+    if (config.error != SWEEP_CONFIG_OK) {
+        char errorMsg[48];
+        snprintf(errorMsg, sizeof(errorMsg), "%s (field %d)", sweepConfigErrorText(config.error), config.errorField);
+        sendBLEError(errorMsg);
+        return;
+    }
+    SweepPresetError error = saveSweepPreset(name, config, customSweepMask);
+    if (error != SWEEP_PRESET_OK) {
+        sendBLEError(sweepPresetErrorText(error));
+        return;
+    }
+    char statusMsg[40];
+    snprintf(statusMsg, sizeof(statusMsg), "Preset saved:%s", name);
+    sendBLEStatus(statusMsg);
+}
+
+// Text or binary MEAS_START
+static void startFinal() {
+    // The final sweep reuses the baseline's plan so stored points pair up by index
+    MeasRequestError error = requestFinalSweep(MEAS_SOURCE_BLE);
+    if (error != MEAS_REQUEST_OK) {
+        sendBLEError(measRequestErrorText(error));
+    }
+}
+
+// Argument of NAME:arg, or nullptr if cmd is not that command
+static const char* commandArg(const char* cmd, const char* name) {
+    size_t n = strlen(name);
+    return strncmp(cmd, name, n) == 0 && cmd[n] == ':' ? cmd + n + 1 : nullptr;
+}
+
+// NAME:...:1 switches a setting on
+static bool commandSwitchOn(const char* cmd, size_t len) {
+    return len >= 2 && strcmp(cmd + len - 2, ":1") == 0;
+}
+
+// Parsed in place - no String, so a sweep's commands do not touch the heap
+static void handleBLECommand(const char* cmdBuffer, size_t cmdLen) {
+    // Binary commands
+    if ((uint8_t)cmdBuffer[0] == BLE_BIN_MAGIC) {
+        uint8_t type = cmdLen > 1 ? (uint8_t)cmdBuffer[1] : 0;
+        if (type == BLE_BIN_CMD_BASELINE) {
+            startBaseline(parseSweepConfigBinary((const uint8_t*)cmdBuffer, cmdLen, sweepConfigDefaults()));
+        } else if (type == BLE_BIN_CMD_MEAS && cmdLen == 2) {
+            startFinal();
+        } else {
+            sendBLEError("Unknown binary command");
+        }
+        return;
+    }
+
+    HAL_PRINTF("[BLE] Processing command: '%s'\n", cmdBuffer);
 
     // Parse START command
-    if (cmdStr.startsWith(BLE_CMD_BASELINE)) {
-        if (measurementInProgress) {
-            sendBLEError("Measurement already in progress");
+    if (strncmp(cmdBuffer, BLE_CMD_BASELINE, strlen(BLE_CMD_BASELINE)) == 0) {
+        startBaseline(parseSweepConfigText(cmdBuffer, sweepConfigDefaults()));
+    }
+    else if (strcmp(cmdBuffer, BLE_CMD_MEAS) == 0) {
+        startFinal();
+    }
+    // Report sweep latency statistics
+    else if (strcmp(cmdBuffer, BLE_CMD_STATS) == 0) {
+        sendBLEStats();
+    }
+    // Field counters and histograms of every module
+    else if (strcmp(cmdBuffer, BLE_CMD_COUNTERS) == 0) {
+        sendBLECounters();
+    }
+    else if (const char* arg = commandArg(cmdBuffer, BLE_CMD_COUNTERS)) {
+        if (strcmp(arg, "RESET") != 0) {
+            sendBLEError("Unknown counters command");
             return;
-        } else if (baselineMeasurementDone && !finalMeasurementDone) {
-            sendBLEError("Baseline measurement already done, proceed to MEAS");
+        }
+        resetFieldCounters();
+        sendBLEStatus("Counters reset");
+    }
+    // Rebuild calibration from flash - switched in before the next sweep
+    else if (strcmp(cmdBuffer, BLE_CMD_CAL_RELOAD) == 0) {
+        if (isCalUploadInProgress()) {
+            sendBLEError("Calibration upload in progress");
+        } else if (reloadCalibration()) {
+            sendBLEStatus("Calibration reloaded");
+        } else {
+            sendBLEError("Calibration reload failed");
+        }
+    }
+    // Named baselines - saved once, started by name
+    else if (const char* name = commandArg(cmdBuffer, BLE_CMD_PRESET)) {
+        startPreset(name);
+    }
+    else if (const char* args = commandArg(cmdBuffer, BLE_CMD_PRESET_SAVE)) {
+        if (measurementInProgress || isMonitorActive()) {
+            sendBLEError("Measurement in progress");
             return;
         }
-        baselineMeasurementDone = false;
-        finalMeasurementDone = false;
-        
-        parseStartCommand(cmdBuffer, num_duts, startIDX, endIDX, calcStartFreq, calcEndFreq);
-
-        if (num_duts == 0) {
-            sendBLEError("Invalid Sensor count (must be 1-4)");
+        savePreset(args);
+    }
+    else if (const char* name = commandArg(cmdBuffer, BLE_CMD_PRESET_DEL)) {
+        SweepPresetError error = deleteSweepPreset(name);
+        if (error != SWEEP_PRESET_OK) {
+            sendBLEError(sweepPresetErrorText(error));
             return;
         }
-
-        Serial.printf("[BLE] Starting Baseline measurement with %d Sensor%s...\n", num_duts, num_duts > 1 ? "s" : "");
-
-        // Clear previous measurement data
-        for (int i = 0; i < MAX_DUT_COUNT; i++) {
-            frequencyCount[i] = 0;
-            for (int j = 0; j < MAX_FREQUENCIES; j++) {
-                baselineImpedanceData[i][j] = ImpedancePoint();
+        sendBLEStatus("Preset deleted");
+    }
+    else if (strcmp(cmdBuffer, BLE_CMD_PRESET) == 0) {
+        char statusMsg[16 + SWEEP_PRESET_MAX * SWEEP_PRESET_NAME_MAX];
+        int len = snprintf(statusMsg, sizeof(statusMsg), "Presets:");
+        for (uint8_t i = 0; i < getSweepPresetCount(); i++) {
+            len += snprintf(statusMsg + len, sizeof(statusMsg) - len, "%s%s", i > 0 ? "," : "",
+                            getSweepPreset(i).name);
+        }
+        sendBLEStatus(statusMsg);
+    }
+    // Spectral metric selection and thresholds - between sweeps
+    else if (strcmp(cmdBuffer, BLE_CMD_METRICS) == 0 || commandArg(cmdBuffer, BLE_CMD_METRICS)) {
+        if (commandArg(cmdBuffer, BLE_CMD_METRICS) != nullptr) {
+            if (measurementInProgress || isMonitorActive()) {
+                sendBLEError("Measurement in progress");
+                return;
+            }
+            uint8_t field;
+            if (!parseMetricsConfig(cmdBuffer, metricsConfig, field)) {
+                char errorMsg[48];
+                snprintf(errorMsg, sizeof(errorMsg), "Invalid metrics (field %d)", field);
+                sendBLEError(errorMsg);
+                return;
             }
         }
-        Serial.println("[BLE] Buffers cleared - ready for new measurement");
+        char statusMsg[96];
+        const MetricsConfig& c = metricsConfig;
+        snprintf(statusMsg, sizeof(statusMsg), "Metrics:%02x,%.0f,%.0f,%.0f,%.3f,%.1f,%.3f,%.3f", c.mask,
+                 c.markerHz, c.splitLowHz, c.splitHighHz, c.bandThreshold, c.phaseThreshold,
+                 c.areaThreshold, c.fitThreshold);
+        sendBLEStatus(statusMsg);
+    }
+    // End each DUT's final sweep as soon as its risk class is certain
+    else if (commandArg(cmdBuffer, BLE_CMD_FAST_SCREEN)) {
+        fastScreenMode = commandSwitchOn(cmdBuffer, cmdLen);
+        sendBLEStatus(fastScreenMode ? "Fast screen on" : "Fast screen off");
+    }
+    // Sweep all DUTs per frequency instead of DUT by DUT
+    else if (commandArg(cmdBuffer, BLE_CMD_INTERLEAVE)) {
+        if (measurementInProgress) {
+            sendBLEError("Measurement in progress");
+            return;
+        }
+        setInterleavedSweep(commandSwitchOn(cmdBuffer, cmdLen));
+        sendBLEStatus(isInterleavedSweep() ? "Interleaved sweep on" : "Interleaved sweep off");
+    }
+    // A fleet central takes over our connection interval
+    else if (strcmp(cmdBuffer, BLE_CMD_FLEET_LINK) == 0) {
+        setBLELinkManaged();
+        sendBLEStatus("Fleet link");
+    }
+#if FLEET_AGGREGATOR
+    // Relay nearby boards' results to this board's clients
+    else if (strcmp(cmdBuffer, BLE_CMD_FLEET) == 0 || commandArg(cmdBuffer, BLE_CMD_FLEET)) {
+        if (commandArg(cmdBuffer, BLE_CMD_FLEET) != nullptr) {
+            setFleetEnabled(commandSwitchOn(cmdBuffer, cmdLen));
+        }
+        char statusMsg[32];
+        snprintf(statusMsg, sizeof(statusMsg), "Fleet:%s,%d", isFleetEnabled() ? "on" : "off", getFleetPeerCount());
+        sendBLEStatus(statusMsg);
+    }
+    else if (const char* args = commandArg(cmdBuffer, BLE_CMD_FLEET_SEND)) {
+        char* rest;
+        long peer = strtol(args, &rest, 10);
+        if (rest == args || *rest != ',' || peer < 0 || peer > FLEET_MAX_PEERS ||
+            !sendFleetCommand(peer, rest + 1)) {
+            sendBLEError("Invalid fleet command");
+            return;
+        }
+        sendBLEStatus("Fleet sent");
+    }
+#endif
+#if WIFI_SERVER
+    // Wi-Fi bulk transfers: provision, switch, or report the address
+    else if (strcmp(cmdBuffer, BLE_CMD_WIFI) == 0 || commandArg(cmdBuffer, BLE_CMD_WIFI)) {
+        const char* arg = commandArg(cmdBuffer, BLE_CMD_WIFI);
+        bool ok = true;
+        if (arg != nullptr && (strcmp(arg, "1") == 0 || strcmp(arg, "0") == 0)) {
+            ok = setWiFiEnabled(arg[0] == '1');
+        } else if (arg != nullptr) {
+            // The SSID ends at the first comma, the passphrase may hold more
+            char network[WIFI_SSID_MAX + 1];
+            const char* comma = strchr(arg, ',');
+            size_t len = comma != nullptr ? comma - arg : strlen(arg);
+            ok = len <= WIFI_SSID_MAX;
+            if (ok) {
+                memcpy(network, arg, len);
+                network[len] = '\0';
+                ok = setWiFiNetwork(network, comma != nullptr ? comma + 1 : "");
+            }
+        }
+        if (!ok) {
+            sendBLEError("Invalid Wi-Fi setting");
+            return;
+        }
+        char status[40];
+        char statusMsg[48];
+        getWiFiStatus(status, sizeof(status));
+        snprintf(statusMsg, sizeof(statusMsg), "WiFi:%s", status);
+        sendBLEStatus(statusMsg);
+    }
+#endif
+#if THREAD_UPLINK
+    // Thread telemetry: provision, switch, or report the role
+    else if (strcmp(cmdBuffer, BLE_CMD_THREAD) == 0 || commandArg(cmdBuffer, BLE_CMD_THREAD)) {
+        const char* arg = commandArg(cmdBuffer, BLE_CMD_THREAD);
+        bool ok = true;
+        if (arg != nullptr && (strcmp(arg, "1") == 0 || strcmp(arg, "0") == 0)) {
+            ok = setThreadEnabled(arg[0] == '1');
+        } else if (arg != nullptr) {
+            ok = setThreadNetwork(arg);
+        }
+        if (!ok) {
+            sendBLEError("Invalid Thread setting");
+            return;
+        }
+        char status[32];
+        char statusMsg[48];
+        getThreadStatus(status, sizeof(status));
+        snprintf(statusMsg, sizeof(statusMsg), "Thread:%s", status);
+        sendBLEStatus(statusMsg);
+    }
+    else if (const char* arg = commandArg(cmdBuffer, BLE_CMD_THREAD_DEST)) {
+        char address[THREAD_ADDR_MAX];
+        const char* comma = strchr(arg, ',');
+        size_t len = comma != nullptr ? comma - arg : strlen(arg);
+        unsigned long port = comma != nullptr ? strtoul(comma + 1, nullptr, 10) : THREAD_DEFAULT_PORT;
+        bool ok = len < sizeof(address) && port <= 65535;
+        if (ok) {
+            memcpy(address, arg, len);
+            address[len] = '\0';
+            ok = setThreadDestination(address, port);
+        }
+        if (!ok) {
+            sendBLEError("Invalid Thread collector");
+            return;
+        }
+        sendBLEStatus("Thread collector set");
+    }
+#endif
+    // Resize the measurement store for another front end (stored across reboots)
+    else if (const char* args = commandArg(cmdBuffer, BLE_CMD_CHANNELS)) {
+        if (measurementInProgress || isMonitorActive()) {
+            sendBLEError("Measurement in progress");
+            return;
+        }
+        const char* comma = strchr(args, ',');
+        int duts = atoi(args);
+        int points = comma != nullptr && comma > args ? atoi(comma + 1) : getPointsPerDUT();
+        if (!configureMeasurementStore(duts, points)) {
+            sendBLEError("Invalid channel configuration");
+            return;
+        }
+        // The old rows are gone - a new baseline is needed
+        resetMeasurementResults();
+        if (selectedDUTCount > duts) {
+            selectedDUTCount = duts;
+        }
+        saveMeasurementStoreConfig();
 
-        // Start measurement via UART
-        if (sendStartCommand(num_duts, startIDX, endIDX)) {
-            // Send status update with DUT count
-            char statusMsg[32];
-            snprintf(statusMsg, sizeof(statusMsg), "Measuring:%d", num_duts);
+        char statusMsg[32];
+        snprintf(statusMsg, sizeof(statusMsg), "Channels:%d,%d", getDUTCount(), getPointsPerDUT());
+        sendBLEStatus(statusMsg);
+    }
+    // Repeat the final sweep every interval, reporting only changed risk results
+    else if (const char* arg = commandArg(cmdBuffer, BLE_CMD_MONITOR)) {
+        char* end;
+        uint32_t intervalS = strtoul(arg, &end, 10);
+        uint32_t halfLife = *end == ',' ? strtoul(end + 1, nullptr, 10) : 0;
+        char statusMsg[32];
+        if (intervalS == 0) {
+            if (isMonitorActive()) {
+                stopMonitor();
+                setGUIState(GUI_BASELINE_COMPLETE);
+            }
+            sendBLEStatus("Monitor off");
+        } else if (isMonitorActive()) {
+            sendBLEError("Monitor already running");
+        } else if (startMonitor(intervalS, halfLife)) {
+            snprintf(statusMsg, sizeof(statusMsg), "Monitor:%lu", (unsigned long)intervalS);
+            if (halfLife > 0) {
+                snprintf(statusMsg + strlen(statusMsg), sizeof(statusMsg) - strlen(statusMsg), ",%lu",
+                         (unsigned long)halfLife);
+            }
             sendBLEStatus(statusMsg);
-            measurementInProgress = true;
-
-            // Update display GUI to show progress screen
-            setGUIState(GUI_BASELINE_PROGRESS);
         } else {
-            sendBLEError("Failed to start measurement");
+            sendBLEError("Monitor needs a baseline, idle sweep, interval >= 10 s and half-life <= 255");
         }
-
     }
-    else if (cmdStr.equals(BLE_CMD_MEAS)) {
-        if (measurementInProgress) {
-            sendBLEError("Measurement already in progress");
+#if SLEEP_MONITOR
+    // Monitor with deep sleep between the sweeps (sleep_monitor.h)
+    else if (strcmp(cmdBuffer, BLE_CMD_SLEEP) == 0 || commandArg(cmdBuffer, BLE_CMD_SLEEP)) {
+        const char* arg = commandArg(cmdBuffer, BLE_CMD_SLEEP);
+        if (arg != nullptr) {
+            char* end;
+            uint32_t intervalS = strtoul(arg, &end, 10);
+            uint32_t halfLife = *end == ',' ? strtoul(end + 1, nullptr, 10) : 0;
+            if (intervalS == 0) {
+                stopSleepMonitor();
+            } else if (isMonitorActive()) {
+                sendBLEError("Monitor already running");
+                return;
+            } else if (!startSleepMonitor(intervalS, halfLife)) {
+                sendBLEError("Sleep monitor needs a baseline of <= 4 DUTs and 24 points, interval >= 60 s");
+                return;
+            }
+        }
+        char statusMsg[32];
+        if (isSleepMonitorArmed()) {
+            snprintf(statusMsg, sizeof(statusMsg), "Sleep:%lu", (unsigned long)getMonitorInterval());
+        } else {
+            snprintf(statusMsg, sizeof(statusMsg), "Sleep off");
+        }
+        sendBLEStatus(statusMsg);
+    }
+#endif
+    // Multi-step protocol run by the firmware (recipe.h)
+    else if (strcmp(cmdBuffer, BLE_CMD_RECIPE) == 0 || commandArg(cmdBuffer, BLE_CMD_RECIPE)) {
+        const char* arg = commandArg(cmdBuffer, BLE_CMD_RECIPE);
+        if (arg != nullptr && strcmp(arg, "0") == 0) {
+            if (isRecipeRunning()) {
+                requestMeasurementStop(MEAS_SOURCE_BLE);  // Ends the recipe, "Stopped" sent
+            } else {
+                sendBLEStatus("Recipe off");
+            }
+            return;
+        }
+        if (arg != nullptr && strcmp(arg, "RUN") == 0) {
+            RecipeError error = runRecipe();
+            if (error != RECIPE_OK) {
+                sendBLEError(recipeErrorText(error));
+            } else {
+                sendBLEStatus("Recipe started");
+            }
+            return;
+        }
+        if (arg != nullptr) {
+            uint8_t errorStep = 0;
+            RecipeError error = saveRecipe(arg, &errorStep);
+            if (error == RECIPE_SYNTAX) {
+                char errorMsg[40];
+                snprintf(errorMsg, sizeof(errorMsg), "%s (step %d)", recipeErrorText(error), errorStep);
+                sendBLEError(errorMsg);
+                return;
+            } else if (error != RECIPE_OK && error != RECIPE_STORAGE) {
+                sendBLEError(recipeErrorText(error));
+                return;
+            }
+        }
+        // The steps may be longer than a sendBLEStatus() line
+        char reply[BLE_CMD_MAX_LEN + 16];
+        snprintf(reply, sizeof(reply), "%s:Recipe:", BLE_RESP_STATUS);
+        formatRecipe(reply + strlen(reply), sizeof(reply) - strlen(reply));
+        sendBLEString(reply);
+    }
+    // Measure each frequency several times and average (STM32 support needed)
+    else if (const char* arg = commandArg(cmdBuffer, BLE_CMD_REPEATS)) {
+        if (measurementInProgress || isMonitorActive()) {
+            sendBLEError("Measurement in progress");
+            return;
+        }
+        if (!setSweepRepeats(atoi(arg))) {
+            sendBLEError("Invalid repeat count");
             return;
-        } else if (!baselineMeasurementDone) {
+        }
+        char statusMsg[32];
+        snprintf(statusMsg, sizeof(statusMsg), "Repeats:%d", getSweepRepeats());
+        sendBLEStatus(statusMsg);
+    }
+    // Repeats per frequency from the measured noise (STM32 support needed)
+    else if (commandArg(cmdBuffer, BLE_CMD_ADAPTIVE)) {
+        if (measurementInProgress || isMonitorActive()) {
+            sendBLEError("Measurement in progress");
+            return;
+        }
+        setAdaptiveRepeats(commandSwitchOn(cmdBuffer, cmdLen));
+        sendBLEStatus(isAdaptiveRepeats() ? "Adaptive repeats on" : "Adaptive repeats off");
+    }
+    // Coarse baseline first, then only the frequencies where the spectrum bends
+    else if (commandArg(cmdBuffer, BLE_CMD_REFINE)) {
+        if (measurementInProgress || isMonitorActive()) {
+            sendBLEError("Measurement in progress");
+            return;
+        }
+        setSweepRefinement(commandSwitchOn(cmdBuffer, cmdLen));
+        sendBLEStatus(isSweepRefinement() ? "Refinement on" : "Refinement off");
+    }
+    // A short verification sweep against the lot reference instead of a full baseline
+    else if (commandArg(cmdBuffer, BLE_CMD_LOTREF)) {
+        if (measurementInProgress || isMonitorActive()) {
+            sendBLEError("Measurement in progress");
+            return;
+        }
+        setLotReferenceEnabled(commandSwitchOn(cmdBuffer, cmdLen));
+        sendBLEStatus(isLotReferenceEnabled() ? "Lot reference on" : "Lot reference off");
+    }
+    // The baseline of sample sensors as the lot reference
+    else if (const char* args = commandArg(cmdBuffer, BLE_CMD_LOTREF_SAVE)) {
+        if (measurementInProgress || isMonitorActive()) {
+            sendBLEError("Measurement in progress");
+            return;
+        }
+        if (!baselineMeasurementDone) {
             sendBLEError("Baseline measurement needs to be done first");
             return;
         }
-
-        for (int i = 0; i < MAX_DUT_COUNT; i++) {
-            frequencyCount[i] = 0;
-            for (int j = 0; j < MAX_FREQUENCIES; j++) {
-                measurementImpedanceData[i][j] = ImpedancePoint();
+        char name[LOT_REF_NAME_MAX];
+        size_t len = strcspn(args, ",");
+        if (len == 0 || len >= sizeof(name)) {
+            sendBLEError("Invalid lot name");
+            return;
+        }
+        memcpy(name, args, len);
+        name[len] = '\0';
+        float magTol = LOT_REF_MAG_TOL_PCT;
+        float phaseTol = LOT_REF_PHASE_TOL_DEG;
+        if (args[len] == ',' && sscanf(args + len + 1, "%f,%f", &magTol, &phaseTol) != 2) {
+            sendBLEError("Invalid tolerances");
+            return;
+        }
+        if (!saveLotReference(name, num_duts, magTol, phaseTol)) {
+            sendBLEError("No valid baseline point");
+            return;
+        }
+        char statusMsg[40];
+        snprintf(statusMsg, sizeof(statusMsg), "LotRef saved:%s", name);
+        sendBLEStatus(statusMsg);
+    }
+    // The stored final sweep classified again with a new band and cutoffs
+    else if (const char* args = commandArg(cmdBuffer, BLE_CMD_RECALC)) {
+        if (measurementInProgress || isMonitorActive()) {
+            sendBLEError("Measurement in progress");
+            return;
+        }
+        if (!finalMeasurementDone) {
+            sendBLEError("Final measurement needs to be done first");
+            return;
+        }
+        float startHz, endHz, low, medium, high;
+        if (sscanf(args, "%f,%f,%f,%f,%f", &startHz, &endHz, &low, &medium, &high) != 5) {
+            sendBLEError("Invalid recalc parameters");
+            return;
+        }
+        if (!(startHz > 0.0f) || endHz < startHz) {
+            sendBLEError("Invalid calculation band");
+            return;
+        }
+        if (low < 0.0f || medium < low || high < medium) {
+            sendBLEError("Invalid risk cutoffs");
+            return;
+        }
+        // Also the band and cutoffs of the next final sweep
+        calcStartFreq = startHz;
+        calcEndFreq = endHz;
+        lowRiskCutoff = low;
+        mediumRiskCutoff = medium;
+        highRiskCutoff = high;
+
+        uint32_t startUs = micros();
+        int changed = 0;
+        for (uint8_t dut = 0; dut < num_duts; dut++) {
+            if (recalculateRiskLevel(dut, (uint32_t)calcStartFreq, (uint32_t)calcEndFreq)) {
+                changed++;
+                sendBLERisk(dut);
+                showDUTResult(dut);
+            }
+        }
+        char statusMsg[40];
+        snprintf(statusMsg, sizeof(statusMsg), "Recalc:%d/%d,%luus", changed, num_duts,
+                 (unsigned long)(micros() - startUs));
+        sendBLEStatus(statusMsg);
+    }
+    // DATA payload format for this connection - JSON for legacy clients
+    else if (const char* format = commandArg(cmdBuffer, BLE_CMD_FORMAT)) {
+        if (strcmp(format, "BIN") == 0) {
+            setBLEBinaryData(true);
+        } else if (strcmp(format, "JSON") == 0) {
+            setBLEBinaryData(false);
+        } else {
+            sendBLEError("Unknown format");
+            return;
+        }
+        char statusMsg[32];
+        snprintf(statusMsg, sizeof(statusMsg), "Format:%s,%d", isBLEBinaryData() ? "BIN" : "JSON",
+                 (int)getBLEPayloadSize());
+        sendBLEStatus(statusMsg);
+    }
+    // Live points while sweeping instead of one DATA burst per DUT
+    else if (commandArg(cmdBuffer, BLE_CMD_STREAM)) {
+        setBLEStreaming(commandSwitchOn(cmdBuffer, cmdLen));
+        sendBLEStatus(isBLEStreaming() ? "Stream on" : "Stream off");
+    }
+    // Chunk headers on text for this connection - reassembly and RESEND
+    else if (commandArg(cmdBuffer, BLE_CMD_FRAMING)) {
+        setBLEFramedText(commandSwitchOn(cmdBuffer, cmdLen));
+        sendBLEStatus(isBLEFramedText() ? "Framing on" : "Framing off");
+    }
+    // Framed chunks the client missed - the chunks themselves are the reply
+    else if (const char* arg = commandArg(cmdBuffer, BLE_CMD_RESEND)) {
+        char* end;
+        unsigned long message = strtoul(arg, &end, 10);
+        if (*end != ',' || message > 0xFF) {
+            sendBLEError("Invalid resend request");
+            return;
+        }
+        unsigned long first = strtoul(end + 1, &end, 10);
+        unsigned long count = *end == ',' ? strtoul(end + 1, nullptr, 10) : 1;
+        if (first > UINT16_MAX || count == 0) {
+            sendBLEError("Invalid resend request");
+            return;
+        }
+        if (!resendBLEChunks(message, first, min(count, (unsigned long)UINT16_MAX))) {
+            sendBLEError("Chunk not retained");
+        }
+    }
+    // Screen mirror to this connection or the Wi-Fi WebSockets
+    else if (strcmp(cmdBuffer, BLE_CMD_MIRROR) == 0 || commandArg(cmdBuffer, BLE_CMD_MIRROR)) {
+        const char* arg = commandArg(cmdBuffer, BLE_CMD_MIRROR);
+        bool ok = true;
+        if (arg == nullptr) {
+            // Report only
+        } else if (strcmp(arg, "BLE") == 0) {
+            ok = setScreenMirror(MIRROR_SINK_BLE, true);
+        } else if (strcmp(arg, "WIFI") == 0) {
+            ok = setScreenMirror(MIRROR_SINK_WIFI, true);
+        } else if (strcmp(arg, "0") == 0) {
+            setScreenMirror(MIRROR_SINK_BLE | MIRROR_SINK_WIFI, false);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            sendBLEError("Mirror not available");
+            return;
+        }
+        char names[20];
+        char statusMsg[32];
+        formatMirrorSinks(names, sizeof(names));
+        snprintf(statusMsg, sizeof(statusMsg), "Mirror:%s", names);
+        sendBLEStatus(statusMsg);
+    }
+    // Token to quote after a reconnect
+    else if (strcmp(cmdBuffer, BLE_CMD_RESUME) == 0) {
+        char reply[24];
+        snprintf(reply, sizeof(reply), "%s:%08lX", BLE_RESP_RESUME, (unsigned long)getBLEResumeToken());
+        sendBLEString(reply);
+    }
+    // Carry on a transfer a dropped connection was receiving
+    else if (const char* arg = commandArg(cmdBuffer, BLE_CMD_RESUME)) {
+        char* end;
+        unsigned long token = strtoul(arg, &end, 16);
+        unsigned long message = *end == ',' ? strtoul(end + 1, &end, 10) : 0x100;
+        unsigned long chunk = *end == ',' ? strtoul(end + 1, nullptr, 10) : 0x10000;
+        if (message > 0xFF || chunk > UINT16_MAX) {
+            sendBLEError("Invalid resume request");
+            return;
+        }
+        int messages;
+        switch (resumeBLETransfer(token, message, chunk, messages)) {
+            case BLE_RESUME_OK: {
+                char status[24];
+                snprintf(status, sizeof(status), "Resumed %d", messages);
+                sendBLEStatus(status);
+                break;
             }
+            case BLE_RESUME_UNKNOWN:
+                sendBLEError("Resume token unknown");
+                break;
+            case BLE_RESUME_NOT_RETAINED:
+                sendBLEError("Chunk not retained");
+                break;
+        }
+    }
+    // Synthetic TX throughput run to the client that asked
+    else if (const char* arg = commandArg(cmdBuffer, BLE_CMD_BENCH)) {
+        handleBLEBenchCommand(arg);
+    }
+    // Wall clock for session timestamps
+    else if (const char* arg = commandArg(cmdBuffer, BLE_CMD_TIME)) {
+        setSessionClock(strtoul(arg, nullptr, 10));
+        sendBLEStatus("Time set");
+    }
+    // Past sweeps: list, or fetch one by timestamp and DUT
+    else if (strcmp(cmdBuffer, BLE_CMD_HISTORY) == 0) {
+        sendBLESessionList();
+    }
+    else if (const char* key = commandArg(cmdBuffer, BLE_CMD_HISTORY)) {
+        const char* comma = strchr(key, ',');
+        if (comma == nullptr || comma == key) {
+            sendBLEError("Invalid session key");
+            return;
+        }
+        sendBLESession(strtoul(key, nullptr, 10), atoi(comma + 1));
+    }
+    // Stored rows again, to the requester only - a late or reloaded client
+    // fetches results instead of sweeping
+    else if (strcmp(cmdBuffer, BLE_CMD_GET_DATA) == 0 || commandArg(cmdBuffer, BLE_CMD_GET_DATA)) {
+        BLEDataQuery query;
+        if (!parseBLEDataQuery(commandArg(cmdBuffer, BLE_CMD_GET_DATA), query)) {
+            sendBLEError("Invalid data query");
+            return;
         }
-        finalMeasurementDone = false;
-        // Start measurement via UART
-        if (sendStartCommand(num_duts, startIDX, endIDX)) {
-            // Send status update with DUT count
-            char statusMsg[32];
-            snprintf(statusMsg, sizeof(statusMsg), "Measuring:%d", num_duts);
+        char statusMsg[32];
+        snprintf(statusMsg, sizeof(statusMsg), "Data:%d", sendBLEDataQuery(query));
+        sendBLEStatus(statusMsg);
+    }
+    // Select the frequencies of the next baseline (and its final) sweep
+    else if (const char* selection = commandArg(cmdBuffer, BLE_CMD_SWEEP)) {
+        SweepMask mask;
+        char statusMsg[32];
+        if (strcmp(selection, "ALL") == 0) {
+            customSweepMask = 0;
+            sendBLEStatus("Sweep:all");
+        } else if (parseSweepMask(selection, mask)) {
+            customSweepMask = mask;
+            snprintf(statusMsg, sizeof(statusMsg), "Sweep:%d", __builtin_popcountll(mask));
             sendBLEStatus(statusMsg);
-            measurementInProgress = true;
-
-            // Update display GUI to show progress screen
-            setGUIState(GUI_FINAL_PROGRESS);
         } else {
-            sendBLEError("Failed to start measurement");
+            sendBLEError("Invalid sweep selection");
         }
     }
     // Parse STOP command
-    else if (cmdStr.equals(BLE_CMD_STOP)) {
-        Serial.println("[BLE] Stopping measurement...");
-        sendStopCommand();
-        sendBLEStatus("Stopped");
-        measurementInProgress = false;
-
-        // Return display GUI to home screen
-        setGUIState(GUI_HOME);
+    else if (strcmp(cmdBuffer, BLE_CMD_STOP) == 0) {
+        Console.println("[BLE] Stopping measurement...");
+        requestMeasurementStop(MEAS_SOURCE_BLE);  // Back to the home screen, "Stopped" sent
     }
     else {
-        Serial.printf("[BLE] ERROR: Unknown command '%s'\n", cmdBuffer);
+        HAL_PRINTF("[BLE] ERROR: Unknown command '%s'\n", cmdBuffer);
         sendBLEError("Unknown command");
     }
 }
 
+void processBLECommands() {
+    char cmdBuffer[BLE_CMD_MAX_LEN];
+
+    // Tell the client about commands the ring had to drop
+    static uint32_t reportedDrops = 0;
+    uint32_t drops = getBLECommandDrops();
+    if (drops != reportedDrops) {
+        char errorMsg[40];
+        snprintf(errorMsg, sizeof(errorMsg), "Commands dropped:%lu", (unsigned long)(drops - reportedDrops));
+        Console.printf("[BLE] WARNING: %s\n", errorMsg);
+        sendBLEError(errorMsg);
+        reportedDrops = drops;
+    }
+
+    // All queued commands - one wake-up may stand for several writes
+    size_t cmdLen;
+    while ((cmdLen = getBLECommand(cmdBuffer, sizeof(cmdBuffer))) > 0) {
+        handleBLECommand(cmdBuffer, cmdLen);
+    }
+}
+
 /*=========================TASK: GUI=========================*/
 // Task to handle GUI and user interaction
+// How long the GUI task may sleep: until the nearest deadline of a timed
+// module, else until something wakes it (wakeGUITask) or the task
+// watchdog wants feeding
+static TickType_t guiWaitTicks(bool splashDone) {
+    uint32_t waitMs = min(min(getMonitorWaitMs(), getPowerWaitMs()),
+                          min(getGUISettingsWaitMs(), getSweepWatchdogWaitMs()));
+    waitMs = min(waitMs, min(getRenderWaitMs(), getBackgroundJobsWaitMs()));
+    waitMs = min(waitMs, min(getDisplayPowerWaitMs(), getPerfDashboardWaitMs()));
+    waitMs = min(waitMs, min(getSleepMonitorWaitMs(), getRecipeWaitMs()));
+    if (!splashDone && getGUIState() == GUI_SPLASH) {
+        uint32_t elapsed = millis() - splashStartTime;
+        waitMs = min(waitMs, elapsed >= SPLASH_DURATION_MS ? 0 : SPLASH_DURATION_MS - elapsed);
+    }
+    // Streams refill the TX buffer as it drains, the rest retry while busy
+    if (isHistoryDownloadActive() || isBLEBenchActive() || isCalUploadInProgress() || isOTAUpdateActive() ||
+        isCalAcquireActive() || isCalibrationSetSelectionWaiting()) {
+        waitMs = min(waitMs, (uint32_t)GUI_POLL_MS);
+    }
+    // A line still buffered after the last one was handled
+    if (Serial.available()) {
+        waitMs = 0;
+    }
+    // Wakes at least once per watchdog feed period
+    return pdMS_TO_TICKS(min(waitMs, (uint32_t)TASK_WDT_FEED_MS));
+}
+
+// Whether a DUT's results go out - set by its first delivery job
+static bool deliveryReport[MAX_DUT_COUNT];
+
+// Delivery jobs carry their session's kind with the DUT - a baseline's jobs
+// may still run once the final sweep started (meas_control.h), and read the
+// rows and results of their own kind
+#define DELIVERY_FINAL      0x80
+#define DELIVERY_DUT_MASK   0x7F
+
+// Delivery job 1: the DUT's points to BLE
+static void deliverDUTData(uint8_t job) {
+    uint8_t dutIndex = job & DELIVERY_DUT_MASK;
+    bool final = (job & DELIVERY_FINAL) != 0;
+    // Monitor sweeps only report a changed risk - no per-DUT data
+    bool monitoring = isMonitorActive();
+    deliveryReport[dutIndex] = !monitoring;
+    if (!monitoring) {
+        if (isChannelOpen(dutIndex)) {
+            char statusMsg[16];
+            snprintf(statusMsg, sizeof(statusMsg), "Open:%d", dutIndex + 1);
+            sendBLEStatus(statusMsg);
+        }
+        // Send DUT start notification via BLE (streaming clients only get DUT_END -
+        // their points already went out live)
+        sendBLEDUTStart(dutIndex + 1);
+
+        // Send impedance data via BLE
+        int64_t bleStartUs = esp_timer_get_time();
+        if (sendBLEImpedanceData(dutIndex, final)) {
+            Console.printf("[BLE] Sent data for DUT %d\n", dutIndex + 1);
+        }
+        sweepStatsRecord(STAGE_BLE_DELIVERY, (uint32_t)(esp_timer_get_time() - bleStartUs));
+
+        // Send DUT end notification via BLE
+        sendBLEDUTEnd(dutIndex + 1);
+    }
+}
+
+// Delivery job 2: risk, circuit fit, KK and spectral metrics
+static void deliverDUTResults(uint8_t job) {
+    uint8_t dutIndex = job & DELIVERY_DUT_MASK;
+    bool final = (job & DELIVERY_FINAL) != 0;
+    bool report = deliveryReport[dutIndex];
+    // Risk is complete with the DUT's last point - report it before the other DUTs finish
+    if (final && dutIndex < num_duts) {
+        calculateRiskLevel(dutIndex);
+        if (isMonitorActive()) {
+            trackDUTBaseline(dutIndex);
+        }
+        report = report || monitorRiskChanged(dutIndex);
+        if (report) {
+            sendBLERisk(dutIndex);
+            if (isMonitorActive() && getTrackingHalfLife() > 0) {
+                sendBLETrackedRisk(dutIndex);
+            }
+        }
+        showDUTResult(dutIndex);
+    }
+    // Circuit parameters without the spectrum, and whether the data is
+    // KK-consistent - baseline and final
+    if (report) {
+        sendBLEFit(dutIndex, final);
+        sendBLEKKResult(dutIndex, final);
+    }
+    // Accumulated with the risk - after the fit, which the fit deltas need
+    if (final && dutIndex < num_duts) {
+        finishSpectralMetrics(dutIndex);
+        if (report) {
+            sendBLEMetrics(dutIndex);
+            // The same result for the ward's collector (THREAD_UPLINK)
+            queueThreadSummary(dutIndex);
+        }
+    }
+    deliveryReport[dutIndex] = report;
+}
+
+// Delivery job 3: keep the sweep (and its risk) for later HISTORY requests
+static void deliverDUTArchive(uint8_t job) {
+    uint8_t dutIndex = job & DELIVERY_DUT_MASK;
+    if (deliveryReport[dutIndex]) {
+        archiveSession(dutIndex, (job & DELIVERY_FINAL) != 0);
+    }
+    sweepStatsMark(MARK_DUT_DELIVERED, dutIndex + 1);
+}
+
+// A DUT's points are final: send them, report its risk and archive it - as
+// background jobs, in the frame gaps of the DUTs still being measured
+static void deliverDUT(uint8_t dutIndex) {
+    uint8_t job = dutIndex | (isFinalGeneration(getMeasurementGeneration()) ? DELIVERY_FINAL : 0);
+    queueBackgroundJob(deliverDUTData, job);
+    queueBackgroundJob(deliverDUTResults, job);
+    queueBackgroundJob(deliverDUTArchive, job);
+}
+
+// Last job of a baseline or final sweep (arg: DELIVERY_FINAL or 0), behind
+// its DUTs' deliveries: the binary export (usb_export_decode.py) and the
+// completion messages
+static void deliverSweepComplete(uint8_t job) {
+    bool final = (job & DELIVERY_FINAL) != 0;
+    Console.println("All measurements complete - sending binary export");
+    sendBinaryExport(true);
+
+    // Send completion notification via BLE
+    if (!final) {
+        Console.println("Baseline measurement complete");
+        sendBLEStatus("Baseline Complete");
+    } else {
+        sendBLEStatus("Measurement Complete");
+        Console.println("Final measurement complete");
+    }
+
+    // Serial runs and recipes start their next step from here, after the export
+    serialSweepComplete(final);
+    recipeSweepComplete(final);
+    sweepBenchSweepComplete(final);
+    calAcquireSweepComplete();
+}
+
 void taskGUI(void* parameter) {
-    Serial.println("GUI task started");
+    Console.println("GUI task started");
+
+    // Producers wake this task from here on
+    registerGUITask();
+    initSerialCommands();
 
     // Initialize button interrupts
     initButtons();
-    Serial.println("Button interrupts initialized");
+    Console.println("Button interrupts initialized");
 
     // Draw splash screen
     renderCurrentScreen();
 
     bool splashDone = false;
 
-    Serial.println("\n=== BioPal ESP32 Ready ===");
-    Serial.println("Type 'help' for available commands\n");
+    Console.println("\n=== BioPal ESP32 Ready ===");
+    Console.println("Type 'help' for available commands\n");
 
-    // Get semaphore handles
-    SemaphoreHandle_t dutCompleteSem = getDUTCompleteSemaphore();
-    SemaphoreHandle_t measurementCompleteSem = getMeasurementCompleteSemaphore();
+    // Get queue handles
+    QueueHandle_t dutCompleteQueue = getDUTCompleteQueue();
     QueueHandle_t btnEventQueue = getButtonEventQueue();
+    QueueHandle_t guiEventQueue = getGUIEventQueue();
 
     bool allMeasurementsComplete = false;
 
-    // Main GUI event loop
+    // Main GUI event loop - each pass handles everything queued since the last
     while (true) {
+        taskWatchdogFeed();
+        uint32_t wakeReasons = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &wakeReasons, guiWaitTicks(splashDone));
+        trace(TRACE_GUI_WAKE, 0, wakeReasons);
+        if (wakeReasons & (GUI_WAKE_BUTTON | GUI_WAKE_EVENT | GUI_WAKE_SERIAL | GUI_WAKE_BLE)) {
+            notePowerActivity();
+        }
+        // The panel wakes before this pass draws or handles input (not for serial
+        // polling by bench scripts)
+        if (wakeReasons & (GUI_WAKE_BUTTON | GUI_WAKE_EVENT | GUI_WAKE_DUT | GUI_WAKE_BLE)) {
+            noteDisplayActivity();
+        }
+
         // Auto-advance from splash screen after 2 seconds
         if (!splashDone && getGUIState() == GUI_SPLASH) {
-            if (millis() - splashStartTime >= 2000) {
-                setGUIState(GUI_HOME);
+            if (millis() - splashStartTime >= SPLASH_DURATION_MS) {
+                // A restored baseline goes straight to its final sweep
+                setGUIState(baselineMeasurementDone ? GUI_BASELINE_COMPLETE : GUI_HOME);
                 splashDone = true;
             }
         }
@@ -246,120 +1341,348 @@ void taskGUI(void* parameter) {
         // Process BLE commands from WebUI
         processBLECommands();
 
+        // Write received calibration image frames to flash
+        processCalUpload();
+
+        // Write firmware update frames to the update slot, confirm a new image
+        processOTAUpdate();
+
+        // Next calibration acquisition sweep, or the image write after the last
+        processCalAcquire();
+
+        // Queue the next history download blocks
+        processHistoryDownload();
+
+        // Queue the next BLE_BENCH payloads
+        processBLEBench();
+
+        // Switch calibration set once the STM32 reports its ID
+        processCalibrationSetSelection();
+
+        // Run callbacks for completed STM32 commands
+        processUARTCommandResults();
+
+        // Resume or stop a sweep the STM32 stopped answering
+        processSweepWatchdog();
+
+        // Next monitor sweep once its interval has passed
+        processMonitor();
+
+        // Report window and deep sleep between the sweeps of an armed monitor
+        processSleepMonitor();
+
+        // Recipe steps that are due - a sweep step waits for its completion
+        processRecipe();
+
+        // Settings write once the changes have settled
+        processGUISettingsSave();
+
+        // Draw the points stored since the last loop on the live plot
+        processLiveBodePlot();
+
+        // Advance the progress bar by the points stored since the last loop
+        processProgress();
+
+        // Diagnostics screen numbers, once per refresh while it is shown
+        processPerfDashboard();
+
+        // Deferred DUT deliveries that fit before the next frame
+        processBackgroundJobs();
+
         // Handle button/encoder input
-        ButtonEvent event;
-        if (xQueueReceive(btnEventQueue, &event, 0) == pdTRUE) {
-            handleGUIInput(event);
+        ButtonInput input;
+        while (xQueueReceive(btnEventQueue, &input, 0) == pdTRUE) {
+            inputLatencyReceived(input);
+            handleGUIInput(input.event);
+            inputLatencyHandled();
         }
 
-        // Wait for DUT completion event (10ms timeout for responsive UI)
-        if (xSemaphoreTake(dutCompleteSem, pdMS_TO_TICKS(10)) == pdTRUE) {
-            // DUT just completed
-            uint8_t dutIndex = getCompletedDUTIndex();
-            Serial.printf("DUT %d completed\n", dutIndex + 1);
+        // Handle events posted by the BLE callbacks
+        GUIEvent guiEvent;
+        while (guiEventQueue != nullptr && xQueueReceive(guiEventQueue, &guiEvent, 0) == pdTRUE) {
+            handleGUIEvent(guiEvent);
+        }
+
+        // DUT completion (GUI_WAKE_DUT) - every DUT_END, in order
+        DUTCompleteEvent dutEvent;
+        while (xQueueReceive(dutCompleteQueue, &dutEvent, 0) == pdTRUE) {
+            // A DUT_END of a sweep that was stopped before its event got here
+            if (dutEvent.generation != getMeasurementGeneration()) {
+                continue;
+            }
+            uint8_t dutIndex = dutEvent.dutIndex;
+            Console.printf("DUT %d completed (%u points, +%lu ms)\n", dutIndex + 1,
+                          dutEvent.points, millis() - dutEvent.timestampMs);
 
             // Update progress screen
             updateProgressScreen(dutIndex);
 
-            // Send DUT start notification via BLE
-            sendBLEDUTStart(dutIndex + 1);
-
-            // Send impedance data via BLE
-            if (sendBLEImpedanceData(dutIndex)) {
-                Serial.printf("[BLE] Sent data for DUT %d\n", dutIndex + 1);
+            // Once per session - a DUT with gaps waits for the repair sweep,
+            // a refined baseline for its second pass, a verification sweep
+            // for the lot reference check
+            if (claimDUTDelivery(dutIndex, false)) {
+                deliverDUT(dutIndex);
             }
 
-            // Send DUT end notification via BLE
-            sendBLEDUTEnd(dutIndex + 1);
-
-            // Check if all measurements are complete
-            if (xSemaphoreTake(measurementCompleteSem, 0) == pdTRUE) {
-                allMeasurementsComplete = true;
-                measurementInProgress = false;
-                if (!baselineMeasurementDone) {
-                    baselineMeasurementDone = true;
-                    Serial.println("Baseline measurement completed");
+            // Check if all measurements are complete - unless a full baseline
+            // follows an out-of-band verification sweep, a refinement
+            // follows the coarse pass, or points are missing and a repair
+            // sweep re-measures them
+            if (dutEvent.sweepDone && !requestLotVerification() && !requestSweepRefinement() &&
+                !requestSweepRepair()) {
+                // DUTs held back for a repair, or whose DUT_END wake was merged
+                for (uint8_t dut = 0; dut < num_duts; dut++) {
+                    if (claimDUTDelivery(dut, true)) {
+                        deliverDUT(dut);
+                    }
+                }
+                // The results screen of a final sweep needs every DUT delivered.
+                // A baseline's deliveries run on in the frame gaps of the final
+                // sweep, which may start at once - it stores into the other rows
+                if (isFinalGeneration(getMeasurementGeneration())) {
+                    flushBackgroundJobs();
+                }
+                bool final = completeMeasurement();
+                // Point times learned in this sweep - written while the link is idle
+                saveSweepTimeModel();
+                // Repeats the spread of this sweep asks for - kept by an adaptive preset
+                if (isAdaptiveRepeats() && learnRepeatPlan(final)) {
+                    updateSweepPresetRepeatPlan();
+                }
+                if (isMonitorActive()) {
+                    onMonitorSweepComplete();
+                } else if (!final) {
+                    allMeasurementsComplete = true;
+                    Console.println("Baseline measurement completed");
                     setGUIState(GUI_BASELINE_COMPLETE);
                 } else {
-                    finalMeasurementDone = true;
-                    Serial.println("Final measurement completed");
-                    // Calculate qualitative results
-                    for (uint8_t i = 0; i < num_duts; i++) {
-                        calculateRiskLevel(i, calcStartFreq, calcEndFreq);
-                    }
+                    allMeasurementsComplete = true;
+                    Console.println("Final measurement completed");
+                    // Qualitative results were calculated as each DUT completed -
+                    // already on the screen, only the title and button change
                     setGUIState(GUI_RESULTS);
+                    requestRender();
                 }
             }
         }
 
-        // If all measurements complete, export CSV
+        // If all measurements complete, export the rows and report it - behind
+        // the DUTs' deliveries
         if (allMeasurementsComplete) {
-            Serial.println("All measurements complete - exporting CSV data");
-            printCSVToSerial();
-
-            // Send completion notification via BLE
-            if (!finalMeasurementDone) {
-                Serial.println("Baseline measurement complete");
-                sendBLEStatus("Baseline Complete");
-            } else {
-                sendBLEStatus("Measurement Complete");
-                Serial.println("Final measurement complete");
-            }
+            queueBackgroundJob(deliverSweepComplete, finalMeasurementDone ? DELIVERY_FINAL : 0);
+            sweepStatsMark(MARK_SWEEP_COMPLETE);
+            checkTaskStacks();
+            heapStatsSample();
+            heapStatsSweepEnd();
 
             allMeasurementsComplete = false;  // Reset flag
         }
 
-        // Small delay to prevent task starvation
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // Commands written during this pass start or stop the sweep before the
+        // frame is drawn, not after it
+        processBLECommands();
+
+        // One frame for every screen change of this pass, paced to GUI_FRAME_MIN_MS
+        processRender();
+
+        // Clock / sleep locks and advertising follow this pass's sweep start or end
+        processPowerManagement();
+        processDisplayPower();
     }
 }
 
+/*=========================BOOT TASKS=========================*/
+// Calibration load and BLE bring-up run concurrently while setup() draws
+// the splash and starts the UART; setup() waits for both before the
+// worker tasks are created
+#define BOOT_CAL_DONE   ((EventBits_t)1 << 0)
+#define BOOT_BLE_DONE   ((EventBits_t)1 << 1)
+#define BOOT_TASK_STACK 8192
+
+static EventGroupHandle_t bootEvents;
+static StaticEventGroup_t bootEventsControl;
+
+// Mounts LittleFS for good (storage.h) - nothing else reads it before this signals
+void taskBootCalibration(void* parameter) {
+    uint8_t stage = bootStageBegin("LittleFS mount");
+    if (!initStorage()) {
+        Console.println("WARNING: Storage unavailable - calibration, settings and sessions are not kept");
+    }
+    bootStageEnd(stage);
+
+    stage = bootStageBegin("Calibration load");
+    Console.println("Loading calibration data...");
+    if (loadCalibrationData()) {
+        Console.println("Calibration data loaded successfully");
+    } else {
+        Console.println("WARNING: Failed to load calibration data");
+    }
+    bootStageEnd(stage);
+
+    // Lay out the measurement rows for the configured channel count
+    stage = bootStageBegin("Measurement store");
+    initMeasurementStore();
+    bootStageEnd(stage);
+
+    // A baseline from before the reboot - the final sweep can follow it
+    stage = bootStageBegin("Baseline restore");
+    restoreBaseline();
+    initLotReference();
+    bootStageEnd(stage);
+
+    stage = bootStageBegin("Sweep presets");
+    loadSweepPresets();
+    loadRecipe();
+    bootStageEnd(stage);
+
+    xEventGroupSetBits(bootEvents, BOOT_CAL_DONE);
+    vTaskDelete(nullptr);
+}
+
+void taskBootBLE(void* parameter) {
+    uint8_t stage = bootStageBegin("BLE init");
+    initBLE();
+    Console.println("BLE initialized - ready for WebUI connection");
+    bootStageEnd(stage);
+
+    xEventGroupSetBits(bootEvents, BOOT_BLE_DONE);
+    vTaskDelete(nullptr);
+}
+
+/*=========================TASK TABLE=========================*/
+// Priorities follow the sweep pipeline: bytes off the UART first so the RX
+// ring never overflows, then the ACK-driven command task, then calibration
+// and BLE TX, with the GUI last. Stacks are checked against their high-water
+// marks with the "tasks" command and after every sweep
+static constexpr TaskSpec appTasks[] = {
+    {taskUARTReader,    "UART Reader",    4096, 4},
+    {taskUARTCommand,   "UART Command",   4096, 3},
+#if STM32_SIM
+    {taskSTM32Sim,      "STM32 Sim",      4096, 3},
+#endif
+    {taskDataProcessor, "Data Processor", 8192, 2},
+    {taskBLETx,         "BLE TX",         4096, 2},
+    {taskGUI,           "GUI",            4096, 1},
+    {taskStorage,       "Storage",        4096, 1},
+    {taskConsoleTx,     "Console TX",     3072, 1},
+#if WIFI_SERVER
+    {taskWiFiTx,        "WiFi TX",        4096, 1},
+#endif
+#if FLEET_AGGREGATOR
+    {taskFleet,         "Fleet",          6144, 1},
+#endif
+#if THREAD_UPLINK
+    {taskThreadUplink,  "Thread Uplink",  3072, 1},
+#endif
+};
+#define APP_TASK_COUNT      (sizeof(appTasks) / sizeof(appTasks[0]))
+#define TASK_ARENA_BYTES    taskStackBytes(appTasks, APP_TASK_COUNT)
+
+// Every table stack; the boot tasks use its front first (task_monitor.h)
+static StackType_t taskArena[TASK_ARENA_BYTES / sizeof(StackType_t)];
+static_assert(TASK_BOOT_MAX * BOOT_TASK_STACK <= TASK_ARENA_BYTES, "Boot task stacks must fit the arena");
+
 /*=========================SETUP=========================*/
 void setup() {
-    // Initialize serial for debugging
-    vTaskDelay(500);  // Short delay to allow stable startup
+    // Boot output goes out once the USB CDC host is attached - the
+    // timeline is printed again with the "boot" command
     Serial.begin(115200);
-    vTaskDelay(500);  // Wait for serial to initialize
-    Serial.println("\n\n=== BioPal ESP32-C6 Impedance Analyzer ===");
+    Console.println("\n\n=== BioPal ESP32-C6 Impedance Analyzer ===");
+    initHeapStats();
+    initTrace();
+    // Before the calibration image and the first frames are checked
+    checkIntegrityEngines();
+
+    // A scheduled wake of the sleep monitor takes its session from RTC
+    // memory - no LittleFS, calibration files, splash or BLE (sleep_monitor.h)
+    bool sleepWake = checkSleepMonitorWake();
+
+    bootEvents = xEventGroupCreateStatic(&bootEventsControl);
+    if (!sleepWake) {
+        startBootTask(taskBootCalibration, "Boot Cal", taskArena, BOOT_TASK_STACK, 1);
+    }
 
     // Initialize sprite buffer for flicker-free rendering
+    uint8_t stage = bootStageBegin("Sprite buffer");
     if (!initSpriteBuffer()) {
-        Serial.println("WARNING: Sprite buffer failed to initialize - rendering will have flicker");
+        Console.println("WARNING: No memory for a sprite strip - frames wait until there is");
     }
+    bootStageEnd(stage);
 
-    // Initialize GUI state machine
-    initGUIState();
+    // GUI event queues, TFT and splash - BLE posts connection events
+    stage = bootStageBegin("TFT + splash");
+    initGUIState(!sleepWake);
     splashStartTime = millis();
+    bootStageEnd(stage);
 
-    // Load calibration data from filesystem
-    Serial.println("Loading calibration data...");
-    if (loadCalibrationData()) {
-        Serial.println("Calibration data loaded successfully");
+    if (sleepWake) {
+        // The BLE TX task still waits on its queue - the stack comes up only
+        // for a report window
+        initBLETx();
     } else {
-        Serial.println("WARNING: Failed to load calibration data");
+        startBootTask(taskBootBLE, "Boot BLE", taskArena + BOOT_TASK_STACK / sizeof(StackType_t), BOOT_TASK_STACK, 1);
     }
 
-    // Create FreeRTOS queue for measurement data
-    measurementQueue = xQueueCreate(20, sizeof(MeasurementPoint));
-    if (measurementQueue == nullptr) {
-        Serial.println("ERROR: Failed to create measurement queue");
-        while (1) delay(1000);
-    }
+    // Filled batches from the UART reader to the data processor
+    measurementQueue = xQueueCreateStatic(MEASUREMENT_BATCH_POOL, sizeof(MeasurementBatch*),
+                                          measurementQueueStorage, &measurementQueueControl);
 
     // Initialize UART communication
+    stage = bootStageBegin("UART init");
     initUART(measurementQueue);
+#if STM32_SIM
+    initSTM32Sim();
+#endif
+
+    // Picks the per-board calibration set (cal_set.h) when the reply arrives
+    requestSTM32DeviceId();
+    bootStageEnd(stage);
+
+    if (sleepWake) {
+        // Layout, calibration rows, baseline and monitor as before the sleep
+        stage = bootStageBegin("Sleep restore");
+        restoreSleepMonitor();
+        bootStageEnd(stage);
+    } else {
+        // Calibration rows and BLE must be up before any task uses them
+        stage = bootStageBegin("Wait for boot tasks");
+        xEventGroupWaitBits(bootEvents, BOOT_CAL_DONE | BOOT_BLE_DONE, pdFALSE, pdTRUE, portMAX_DELAY);
+        bootStageEnd(stage);
+    }
+    vEventGroupDelete(bootEvents);
 
-    // Initialize BLE communication
-    initBLE();
-    Serial.println("BLE initialized - ready for WebUI connection");
-
-    // Create FreeRTOS tasks
-    xTaskCreate(taskUARTReader, "UART Reader", 4096, nullptr, 2, nullptr);
-    xTaskCreate(taskDataProcessor, "Data Processor", 8192, nullptr, 2, nullptr);
-    xTaskCreate(taskGUI, "GUI", 4096, nullptr, 1, nullptr);
-
-    Serial.println("All tasks created successfully");
-    Serial.println("System ready!\n");
+    // The calibration task is done with LittleFS (not mounted on a sleep
+    // wake - the radios below find no configuration and stay off)
+    if (!sleepWake) {
+        loadGUISettings();
+        loadSweepTimeModel();
+    }
+#if WIFI_SERVER
+    initWiFiServer();
+#endif
+#if FLEET_AGGREGATOR
+    initFleetAggregator();
+#endif
+#if THREAD_UPLINK
+    initThreadUplink();
+#endif
+
+    // DFS / light sleep with POWER_SAVE - UART and BLE are up
+    initPowerManagement();
+
+    // Table tasks are subscribed as they are created
+    initTaskWatchdog();
+
+    // Create FreeRTOS tasks - over the boot task stacks
+    bool tasksStarted = startTasks(appTasks, APP_TASK_COUNT, taskArena, sizeof(taskArena));
+
+    // Boot self-test of a firmware update - rolls back if it failed
+    initOTAUpdate(tasksStarted);
+
+    Console.println("All tasks created successfully");
+    bootReady();
+    printBootTimes();
+    Console.println("System ready!\n");
 }
 
 /*=========================LOOP=========================*/
@@ -401,12 +1724,12 @@ void loop() {
 // class MyServerCallbacks: public BLEServerCallbacks {
 //     void onConnect(BLEServer* pServer) {
 //         deviceConnected = true;
-//         Serial.println("Client connected");
+//         Console.println("Client connected");
 //     }
 
 //     void onDisconnect(BLEServer* pServer) {
 //         deviceConnected = false;
-//         Serial.println("Client disconnected");
+//         Console.println("Client disconnected");
 //     }
 // };
 
@@ -416,25 +1739,25 @@ void loop() {
 //         String value = pCharacteristic->getValue().c_str();
 
 //         if (value.length() > 0) {
-//             Serial.print("Received command: ");
-//             Serial.println(value);
+//             Console.print("Received command: ");
+//             Console.println(value);
 
 //             // Parse and execute commands
 //             if (value == "LED_ON") {
 //                 ledState = true;
 //                 digitalWrite(LED_PIN, HIGH);
-//                 Serial.println("LED turned ON");
+//                 Console.println("LED turned ON");
 //             }
 //             else if (value == "LED_OFF") {
 //                 ledState = false;
 //                 digitalWrite(LED_PIN, LOW);
-//                 Serial.println("LED turned OFF");
+//                 Console.println("LED turned OFF");
 //             }
 //             else if (value == "LED_TOGGLE") {
 //                 ledState = !ledState;
 //                 digitalWrite(LED_PIN, ledState);
-//                 Serial.print("LED toggled to: ");
-//                 Serial.println(ledState ? "ON" : "OFF");
+//                 Console.print("LED toggled to: ");
+//                 Console.println(ledState ? "ON" : "OFF");
 //             }
 //             else if (value == "GET_STATUS") {
 //                 // Send immediate status update
@@ -443,15 +1766,15 @@ void loop() {
 //                          (unsigned long)dataCounter, ledState ? "ON" : "OFF");
 //                 pTxCharacteristic->setValue(statusBuffer);
 //                 pTxCharacteristic->notify();
-//                 Serial.print("Status sent: ");
-//                 Serial.println(statusBuffer);
+//                 Console.print("Status sent: ");
+//                 Console.println(statusBuffer);
 //             }
 //             else if (value == "RESET_COUNTER") {
 //                 dataCounter = 0;
-//                 Serial.println("Counter reset");
+//                 Console.println("Counter reset");
 //             }
 //             else {
-//                 Serial.println("Unknown command");
+//                 Console.println("Unknown command");
 //             }
 //         }
 //     }
@@ -459,7 +1782,7 @@ void loop() {
 
 // void setup() {
 //     Serial.begin(115200);
-//     Serial.println("Starting ESP32-C6 BLE Server...");
+//     Console.println("Starting ESP32-C6 BLE Server...");
 
 //     // Initialize LED
 //     pinMode(LED_PIN, OUTPUT);
@@ -500,22 +1823,22 @@ void loop() {
 //     pAdvertising->setMinPreferred(0x12);
 //     BLEDevice::startAdvertising();
 
-//     Serial.println("BLE Server started!");
-//     Serial.println("Device name: ESP32-C6-BioPal");
-//     Serial.println("Waiting for client connection...");
+//     Console.println("BLE Server started!");
+//     Console.println("Device name: ESP32-C6-BioPal");
+//     Console.println("Waiting for client connection...");
 // }
 
 // void loop() {
 //     // Handle connection state changes
 //     if (deviceConnected && !oldDeviceConnected) {
 //         oldDeviceConnected = deviceConnected;
-//         Serial.println("Device connected - ready to send/receive data");
+//         Console.println("Device connected - ready to send/receive data");
 //     }
 
 //     if (!deviceConnected && oldDeviceConnected) {
 //         delay(500); // give the bluetooth stack time to get ready
 //         pServer->startAdvertising(); // restart advertising
-//         Serial.println("Start advertising again");
+//         Console.println("Start advertising again");
 //         oldDeviceConnected = deviceConnected;
 //     }
 
@@ -536,8 +1859,8 @@ void loop() {
 //             pTxCharacteristic->setValue(dataBuffer);
 //             pTxCharacteristic->notify();
 
-//             Serial.print("Sent data: ");
-//             Serial.println(dataBuffer);
+//             Console.print("Sent data: ");
+//             Console.println(dataBuffer);
 //         }
 //     }
 
@@ -0,0 +1,538 @@
+#include "meas_control.h"
+#include "console.h"
+#include "defines.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "monitor.h"
+#include "gui_state.h"
+#include "BLE_Functions.h"
+#include "sweep_watchdog.h"
+#include "cal_acquire.h"
+#include "serial_commands.h"
+#include "ota_update.h"
+#include "bg_jobs.h"
+#include "baseline_store.h"
+#include "open_channel.h"
+#include "sweep_refine.h"
+#include "lot_reference.h"
+#include "recipe.h"
+#include "sweep_bench.h"
+#include "sweep_stats.h"
+
+// Sweep plan (main.cpp)
+extern uint8_t num_duts;
+extern uint8_t startIDX;
+extern uint8_t endIDX;
+extern SweepMask sweepMask;
+
+static const char* const requestErrorText[] = {
+    "OK",
+    "Measurement already in progress",
+    "Monitor running",
+    "Baseline measurement needs to be done first",
+    "Invalid Sensor count",
+    "Command queue full",
+    "Firmware update in progress",
+    "Calibration changed since the baseline",
+    "Recipe running"
+};
+
+// Written by the GUI task only - preemptMeasurementStop() reads the state
+static volatile MeasControlState controlState = MEAS_IDLE;
+static std::atomic<bool> stopPreempted(false);  // STOP queued ahead of the GUI task's requestMeasurementStop()
+
+// GUI task only
+static MeasSource activeSource = MEAS_SOURCE_GUI;
+static bool activeFinal = false;
+static UARTCommandCallback startCallback = nullptr;
+static void* startContext = nullptr;
+static uint8_t resyncCount = 0;
+static uint8_t repairCount = 0;
+static uint32_t deliveredDuts = 0;  // Bit per DUT whose points went out this session
+// Planned indices the session measures, 0 = all of them (sweep_refine.h)
+static SweepMask wantedPoints = 0;
+static bool refinePending = false;  // Coarse pass of a refined baseline running
+static bool lotVerifyPending = false;   // Verification sweep against the lot reference running
+
+// What the START in flight sweeps - the plan, a resume from firstDut or a repair
+static SweepPlan inflight;
+static uint8_t inflightFirstDut = 1;
+
+static void setInflight(const SweepPlan& plan, uint8_t firstDut) {
+    inflight = plan;
+    inflightFirstDut = firstDut;
+}
+
+// Sweep table indices of the plan
+static SweepMask planMask() {
+    return sweepMask != 0 ? sweepMask : getSweepRangeMask(startIDX, endIDX);
+}
+
+// Planned points of dut the session still wants
+static SweepMask wantedMissing(uint8_t dut) {
+    SweepMask missing = getMissingPoints(dut);
+    return wantedPoints != 0 ? missing & wantedPoints : missing;
+}
+
+static void armWatchdog() {
+    sweepWatchdogArm(inflight.numDuts, inflight.startIdx, inflight.endIdx, inflight.mask, inflightFirstDut);
+}
+
+/*=========================START=========================*/
+
+// START answered by the STM32 (GUI task)
+static void onStartAnswered(uint8_t cmd_type, bool success, void* context) {
+    // A STOP posted meanwhile went out behind the START - the sweep is over
+    bool started = success && controlState == MEAS_STARTING;
+    if (controlState == MEAS_STARTING) {
+        controlState = started ? MEAS_SWEEPING : MEAS_IDLE;
+    }
+
+    if (started) {
+        measurementInProgress = true;
+        armWatchdog();
+        // Entering the progress screen tells the WebUI "Measuring:<duts>"
+        if (activeSource != MEAS_SOURCE_MONITOR) {
+            setGUIState(activeFinal ? GUI_FINAL_PROGRESS : GUI_BASELINE_PROGRESS);
+        }
+    } else if (success) {
+        Console.println("[MEAS] START answered after STOP - sweep stays stopped");
+    } else if (activeSource == MEAS_SOURCE_BLE) {
+        sendBLEError("Failed to start measurement");
+    } else {
+        Console.println("[MEAS] START failed - staying on current screen");
+    }
+
+    if (startCallback != nullptr) {
+        startCallback(cmd_type, started, startContext);
+    }
+}
+
+// final: the new session's kind
+static MeasRequestError checkIdle(MeasSource source, bool final) {
+    if (source != MEAS_SOURCE_MONITOR && isMonitorActive()) {
+        return MEAS_REQUEST_MONITOR;
+    }
+    if (source != MEAS_SOURCE_RECIPE && isRecipeRunning()) {
+        return MEAS_REQUEST_RECIPE;
+    }
+    if (controlState != MEAS_IDLE || measurementInProgress || isSweepStartPending()) {
+        return MEAS_REQUEST_BUSY;
+    }
+    if (isOTAUpdateActive()) {
+        return MEAS_REQUEST_UPDATE;
+    }
+    // The new sweep overwrites the rows and results of its kind that deferred
+    // deliveries still read - a baseline also ends the final results. A final
+    // sweep after a baseline stores into the other rows: the baseline's
+    // deliveries run on in its frame gaps
+    if (!final || activeFinal) {
+        flushBackgroundJobs();
+    }
+    return MEAS_REQUEST_OK;
+}
+
+// Gain plan of a final sweep from the baseline rows: the gains each valid
+// baseline point was measured at. Returns false if no point has one
+static bool loadBaselineGainPlan() {
+    clearGainPlan();
+    bool any = false;
+    for (uint8_t dut = 0; dut < num_duts; dut++) {
+        const ImpedanceRow& row = baselineImpedanceData[dut];
+        int count = getRowPointCount(true, dut);
+        for (int i = 0; i < count; i++) {
+            uint8_t idx = storedFreqIndex(row.freqCode[i]);
+            if (idx == SWEEP_FREQ_INVALID || !isStoredPointValid(row, i)) {
+                continue;
+            }
+            setGainPlanHint(dut, idx, GAIN_HINT_VALID | (row.flags[i] & (GAIN_HINT_TIA_HIGH | GAIN_HINT_PGA_MASK)));
+            any = true;
+        }
+    }
+    return any;
+}
+
+// Queued behind a START: its empty slots firstDut..lastDut (1-based) end at
+// once instead of being swept (open_channel.h)
+static void skipOpenChannels(uint8_t firstDut, uint8_t lastDut) {
+    for (uint8_t dut = firstDut; dut <= lastDut; dut++) {
+        if (isChannelOpen(dut - 1)) {
+            sendSkipDUTCommandAsync(dut);
+        }
+    }
+}
+
+static MeasRequestError queueStart(MeasSource source, bool final, UARTCommandCallback callback, void* context) {
+    // A STOP sent early is ahead of this START in the queue - the new sweep's stop sends its own
+    stopPreempted = false;
+    activeSource = source;
+    activeFinal = final;
+    startCallback = callback;
+    startContext = context;
+    resyncCount = 0;
+    repairCount = 0;
+    deliveredDuts = 0;
+
+    // Refined: a baseline's coarse pass, or a final sweep of the baseline's
+    // points. Either way the session plans all indices, so slots pair up
+    SweepMask plan = planMask();
+    SweepMask startMask = sweepMask;
+    wantedPoints = 0;
+    refinePending = false;
+    lotVerifyPending = false;
+    SweepMask verify = !final && source != MEAS_SOURCE_CAL ? getLotVerifyMask(plan) : 0;
+    if (verify != 0) {
+        // A few indices against the lot reference first (lot_reference.h)
+        wantedPoints = verify;
+        startMask = verify;
+        lotVerifyPending = true;
+    } else if (isSweepRefinement() && source != MEAS_SOURCE_CAL) {
+        SweepMask wanted = final ? getBaselinePointMask(num_duts) & plan : getCoarseSweepMask(plan);
+        if (wanted != 0 && wanted != plan) {
+            wantedPoints = wanted;
+            startMask = wanted;
+            refinePending = !final;
+        }
+    }
+    setInflight({num_duts, startIDX, endIDX, startMask}, 1);
+
+    // The baseline's gains as starting ranges of the final sweep
+    bool gainPlan = final && isGainHints() && loadBaselineGainPlan();
+
+    // Points from here on belong to the new session
+    beginMeasurementSession(final, plan);
+    if (!sendSweepStartAsync(num_duts, startIDX, endIDX, startMask, onStartAnswered, nullptr, gainPlan)) {
+        // No sweep runs - the stored rows stay the newest
+        abortMeasurementSession();
+        return MEAS_REQUEST_QUEUE;
+    }
+    // A baseline checks every DUT again
+    if (final) {
+        skipOpenChannels(1, num_duts);
+    }
+    controlState = MEAS_STARTING;
+    return MEAS_REQUEST_OK;
+}
+
+MeasRequestError requestBaselineSweep(MeasSource source, const SweepPlan& plan,
+                                      UARTCommandCallback callback, void* context) {
+    MeasRequestError error = checkIdle(source, false);
+    if (error != MEAS_REQUEST_OK) {
+        return error;
+    }
+    if (plan.numDuts < 1 || plan.numDuts > getDUTCount()) {
+        return MEAS_REQUEST_INVALID;
+    }
+
+    // queueStart() plans from these - the old ones come back if START is not queued
+    SweepPlan previous = {num_duts, startIDX, endIDX, sweepMask};
+    num_duts = plan.numDuts;
+    startIDX = plan.startIdx;
+    endIDX = plan.endIdx;
+    sweepMask = plan.mask;
+    error = queueStart(source, false, callback, context);
+    if (error != MEAS_REQUEST_OK) {
+        num_duts = previous.numDuts;
+        startIDX = previous.startIdx;
+        endIDX = previous.endIdx;
+        sweepMask = previous.mask;
+        return error;
+    }
+    // Only a queued START replaces the stored baseline
+    baselineMeasurementDone = false;
+    finalMeasurementDone = false;
+    forgetStoredBaseline();
+    return MEAS_REQUEST_OK;
+}
+
+MeasRequestError requestFinalSweep(MeasSource source, UARTCommandCallback callback, void* context) {
+    MeasRequestError error = checkIdle(source, true);
+    if (error != MEAS_REQUEST_OK) {
+        return error;
+    }
+    if (!baselineMeasurementDone) {
+        return MEAS_REQUEST_NO_BASELINE;
+    }
+    // A restored baseline, and the STM32 ID picked another set since
+    if (!isBaselineCalibrationCurrent()) {
+        return MEAS_REQUEST_CALIBRATION;
+    }
+    // The channel count may have been lowered since the baseline
+    if (num_duts > getDUTCount()) {
+        num_duts = getDUTCount();
+    }
+
+    finalMeasurementDone = false;
+    return queueStart(source, true, callback, context);
+}
+
+/*=========================STALL RECOVERY=========================*/
+
+// The STM32 stopped sending: end the sweep as a lost link
+static void abandonSweep() {
+    Console.println("[MEAS] STM32 not responding - sweep stopped");
+    sendBLEError("STM32 not responding - sweep stopped");
+    abortCalAcquire("link_lost");
+    serialSweepAborted("link_lost");
+    abortRecipe("link_lost");
+    abortSweepBench("link_lost");
+    requestMeasurementStop(activeSource);
+}
+
+// Resuming START answered (GUI task) - the session and screen carry on
+static void onResumeAnswered(uint8_t cmd_type, bool success, void* context) {
+    if (controlState != MEAS_STARTING) {
+        return;  // Stopped meanwhile
+    }
+    if (!success) {
+        abandonSweep();
+        return;
+    }
+    controlState = MEAS_SWEEPING;
+    armWatchdog();
+}
+
+void handleSweepStall(uint8_t dut) {
+    if (controlState != MEAS_SWEEPING) {
+        return;
+    }
+    // Interleaved DUTs have no resume point, a calibration step no partial points
+    bool resumable = !isInterleavedSweep() && activeSource != MEAS_SOURCE_CAL &&
+                     resyncCount < SWEEP_WD_RESYNC_MAX;
+    const SweepPlan& plan = inflight;
+    if (!resumable || !sendLinkResetAsync() ||
+        !sendSweepResumeAsync(plan.numDuts, dut, plan.startIdx, plan.endIdx, plan.mask, onResumeAnswered)) {
+        abandonSweep();
+        return;
+    }
+    skipOpenChannels(dut, plan.numDuts);
+    resyncCount++;
+    inflightFirstDut = dut;
+    controlState = MEAS_STARTING;
+    Console.printf("[MEAS] Sweep stalled - link reset, resuming at DUT %u (%u of %u)\n",
+                  dut, resyncCount, SWEEP_WD_RESYNC_MAX);
+    Console.printf("@EVT sweep_resync %u\n", dut);
+    if (activeSource != MEAS_SOURCE_MONITOR) {
+        char status[16];
+        snprintf(status, sizeof(status), "Resync:%u", dut);
+        sendBLEStatus(status);
+    }
+}
+
+/*=========================MISSING POINTS=========================*/
+
+bool claimDUTDelivery(uint8_t dutIndex, bool sweepDone) {
+    uint32_t bit = 1UL << dutIndex;
+    if (deliveredDuts & bit) {
+        return false;
+    }
+    // Held back for the reference check or refinement, or while a repair sweep may still fill its gaps
+    if (!sweepDone && (lotVerifyPending || refinePending || (wantedMissing(dutIndex) != 0 && repairCount < SWEEP_REPAIR_MAX))) {
+        return false;
+    }
+    deliveredDuts |= bit;
+    return true;
+}
+
+bool isDUTDelivered(uint8_t dutIndex) {
+    return (deliveredDuts & (1UL << dutIndex)) != 0;
+}
+
+bool isSweepRepairAvailable() {
+    return repairCount < SWEEP_REPAIR_MAX;
+}
+
+bool requestSweepRepair() {
+    if (controlState != MEAS_SWEEPING || repairCount >= SWEEP_REPAIR_MAX) {
+        return false;
+    }
+    SweepMask missing = 0;
+    uint8_t lastDut = 0;
+    int points = 0;
+    for (uint8_t dut = 0; dut < num_duts; dut++) {
+        SweepMask gaps = wantedMissing(dut);
+        if (gaps != 0) {
+            missing |= gaps;
+            lastDut = dut + 1;
+            points += __builtin_popcountll(gaps);
+        }
+    }
+    if (missing == 0) {
+        return false;
+    }
+
+    // From DUT 1 - older firmware ignores the first-DUT field; the points
+    // that arrived already are dropped by the data processor
+    SweepPlan repair = {lastDut, startIDX, endIDX, missing};
+    repairCount++;
+    if (!sendSweepResumeAsync(repair.numDuts, 1, repair.startIdx, repair.endIdx, repair.mask, onResumeAnswered)) {
+        Console.println("[MEAS] Repair sweep not queued - keeping the gaps");
+        return false;
+    }
+    skipOpenChannels(1, repair.numDuts);
+    setInflight(repair, 1);
+    controlState = MEAS_STARTING;
+    sweepWatchdogDisarm();
+    Console.printf("[MEAS] %d point(s) missing - re-measuring %d frequencies on DUT 1-%u (%u of %u)\n",
+                  points, __builtin_popcountll(missing), lastDut, repairCount, SWEEP_REPAIR_MAX);
+    Console.printf("@EVT sweep_repair %d\n", points);
+    if (activeSource != MEAS_SOURCE_MONITOR) {
+        char status[16];
+        snprintf(status, sizeof(status), "Repair:%d", points);
+        sendBLEStatus(status);
+    }
+    return true;
+}
+
+bool requestLotVerification() {
+    if (controlState != MEAS_SWEEPING || !lotVerifyPending) {
+        return false;
+    }
+    lotVerifyPending = false;
+    SweepMask plan = planMask();
+    if (applyLotReference(num_duts, plan, wantedPoints)) {
+        wantedPoints = 0;
+        Console.println("[MEAS] All DUTs in band - lot reference used as baseline");
+        Console.println("@EVT lot_reference pass");
+        if (activeSource != MEAS_SOURCE_MONITOR) {
+            sendBLEStatus("LotRef:pass");
+        }
+        return false;
+    }
+
+    // Full baseline in the same session - its coarse pass if refined
+    SweepMask next = plan;
+    if (isSweepRefinement() && getCoarseSweepMask(plan) != plan) {
+        next = getCoarseSweepMask(plan);
+        refinePending = true;
+    }
+    SweepPlan rest = {num_duts, startIDX, endIDX, next & ~wantedPoints};
+    if (rest.mask == 0 || !sendSweepResumeAsync(rest.numDuts, 1, rest.startIdx, rest.endIdx, rest.mask,
+                                                onResumeAnswered)) {
+        Console.println("[MEAS] Full baseline not queued - keeping the verified points");
+        refinePending = false;
+        return false;
+    }
+    wantedPoints = next == plan ? 0 : wantedPoints | next;
+    skipOpenChannels(1, rest.numDuts);
+    setInflight(rest, 1);
+    controlState = MEAS_STARTING;
+    sweepWatchdogDisarm();
+    Console.println("[MEAS] Out of the lot band - sweeping a full baseline");
+    Console.println("@EVT lot_reference fail");
+    if (activeSource != MEAS_SOURCE_MONITOR) {
+        sendBLEStatus("LotRef:full");
+    }
+    return true;
+}
+
+bool requestSweepRefinement() {
+    if (controlState != MEAS_SWEEPING || !refinePending) {
+        return false;
+    }
+    refinePending = false;
+    SweepMask added = planSweepRefinement(num_duts, planMask(), wantedPoints);
+    if (added == 0) {
+        Console.println("[MEAS] Coarse sweep is smooth - nothing to refine");
+        return false;
+    }
+
+    // Like a repair: the same session, points already stored are dropped
+    SweepPlan refinement = {num_duts, startIDX, endIDX, added};
+    if (!sendSweepResumeAsync(refinement.numDuts, 1, refinement.startIdx, refinement.endIdx, refinement.mask,
+                              onResumeAnswered)) {
+        Console.println("[MEAS] Refinement sweep not queued - keeping the coarse points");
+        return false;
+    }
+    wantedPoints |= added;
+    skipOpenChannels(1, refinement.numDuts);
+    setInflight(refinement, 1);
+    controlState = MEAS_STARTING;
+    sweepWatchdogDisarm();
+    int points = __builtin_popcountll(added);
+    Console.printf("[MEAS] Refining - %d more frequencies where the spectrum bends\n", points);
+    Console.printf("@EVT sweep_refine %d\n", points);
+    if (activeSource != MEAS_SOURCE_MONITOR) {
+        char status[16];
+        snprintf(status, sizeof(status), "Refine:%d", points);
+        sendBLEStatus(status);
+    }
+    return true;
+}
+
+/*=========================STOP / COMPLETION=========================*/
+
+// The STOP of a stop request - unless preemptMeasurementStop() queued it already
+static void sendStop() {
+    if (!stopPreempted.exchange(false)) {
+        sendStopCommandAsync();
+    }
+}
+
+bool preemptMeasurementStop() {
+    if (controlState == MEAS_IDLE || stopPreempted || !sendStopCommandAsync()) {
+        return false;
+    }
+    stopPreempted = true;
+    return true;
+}
+
+void requestMeasurementStop(MeasSource source) {
+    sweepWatchdogDisarm();
+    if (source != MEAS_SOURCE_MONITOR) {
+        if (isMonitorActive()) {
+            stopMonitor();  // Stops a running monitor sweep too
+        } else {
+            sendStop();
+        }
+        abortRecipe("stopped");
+        abortSweepBench("stopped");
+        setGUIState(GUI_HOME);
+        // Acknowledged now - the STOP's ACK (up to its retries) is not waited for
+        sendBLEStatus("Stopped");
+    } else if (controlState != MEAS_IDLE) {
+        sendStop();
+    }
+    // The points still in the pipeline are dropped instead of processed, so
+    // the next START may follow at once (nested stop via the monitor: done)
+    if (controlState != MEAS_IDLE) {
+        abortMeasurementSession();
+    }
+    // The stopped sweep's START must not time the next one
+    sweepStatsMark(MARK_SWEEP_STOPPED);
+    controlState = MEAS_IDLE;
+    measurementInProgress = false;
+}
+
+bool completeMeasurement() {
+    sweepWatchdogDisarm();
+    controlState = MEAS_IDLE;
+    measurementInProgress = false;
+    if (activeFinal) {
+        finalMeasurementDone = true;
+    } else {
+        baselineMeasurementDone = true;
+        // Survives a reboot before the final sweep - not the calibration runs
+        saveBaseline(activeSource != MEAS_SOURCE_CAL);
+    }
+    return activeFinal;
+}
+
+void resetMeasurementResults() {
+    flushBackgroundJobs();
+    baselineMeasurementDone = false;
+    finalMeasurementDone = false;
+    forgetStoredBaseline();
+}
+
+MeasControlState getMeasurementState() {
+    return controlState;
+}
+
+MeasSource getMeasurementSource() {
+    return activeSource;
+}
+
+const char* measRequestErrorText(MeasRequestError error) {
+    return error <= MEAS_REQUEST_RECIPE ? requestErrorText[error] : "Unknown error";
+}
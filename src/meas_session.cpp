@@ -0,0 +1,181 @@
+#include "meas_session.h"
+#include "defines.h"
+#include <atomic>
+
+// Written by the measurement controller - the plan before the generation
+static std::atomic<uint32_t> generation{0};
+static SweepMask sessionPlan = SWEEP_MASK_ALL;
+// Newest generation set by an abort - its batches and older ones are dropped
+static std::atomic<uint32_t> closedGeneration{0};
+
+// Written by the data processor - the session being stored, and the newest
+// session of each kind, baseline [0] and final [1]
+static std::atomic<uint32_t> storedGeneration{0};
+static std::atomic<uint32_t> kindGeneration[2];
+
+// Data processor only - tag (low 24 bits of the generation that wrote it) and
+// point count of each row in one word, so one load gives a consistent pair
+static std::atomic<uint32_t> rowTag[2][MAX_DUT_COUNT];
+
+// Data processor only - the stored session's plan, and per DUT the planned
+// indices that arrived (or are no longer wanted)
+static SweepMask storedPlan = SWEEP_MASK_ALL;
+static SweepMask arrived[MAX_DUT_COUNT];
+
+#define ROW_TAG(gen, count)         (((gen) << 8) | (uint32_t)(count))
+#define ROW_TAG_COUNT(tag)          ((int)((tag) & 0xFF))
+#define ROW_TAG_MATCHES(tag, gen)   (((tag) >> 8) == ((gen) & 0xFFFFFF))
+
+// Points of a row written by the newest session of its kind, else 0
+static int rowPointCount(bool final, uint8_t dut, std::memory_order order) {
+    uint32_t tag = rowTag[final][dut].load(order);
+    return ROW_TAG_MATCHES(tag, kindGeneration[final].load(order)) ? ROW_TAG_COUNT(tag) : 0;
+}
+
+void beginMeasurementSession(bool final, SweepMask plan) {
+    sessionPlan = plan;
+    uint32_t next = ((generation.load(std::memory_order_relaxed) >> 1) + 1) << 1;
+    generation.store(next | (final ? 1 : 0), std::memory_order_release);
+}
+
+void abortMeasurementSession() {
+    uint32_t current = generation.load(std::memory_order_relaxed);
+    uint32_t closed = (((current >> 1) + 1) << 1) | (current & 1);
+    closedGeneration.store(closed, std::memory_order_relaxed);
+    generation.store(closed, std::memory_order_release);
+}
+
+uint32_t getMeasurementGeneration() {
+    return generation.load(std::memory_order_acquire);
+}
+
+SessionSync syncMeasurementSession(uint32_t batchGeneration) {
+    // Sessions only move forward - compare the numbers without the kind bit
+    uint32_t closed = closedGeneration.load(std::memory_order_acquire);
+    if (closed != 0 && (int32_t)((batchGeneration >> 1) - (closed >> 1)) <= 0) {
+        return SESSION_STALE;
+    }
+    uint32_t stored = storedGeneration.load(std::memory_order_relaxed);
+    if (batchGeneration == stored) {
+        return SESSION_CURRENT;
+    }
+    if ((int32_t)((batchGeneration >> 1) - (stored >> 1)) < 0) {
+        return SESSION_STALE;
+    }
+
+    // No row is touched: the old points of this kind now carry a stale tag,
+    // read as 0 points, and are overwritten as the new ones come in. A new
+    // baseline also retires the final rows - no final row has an even tag
+    bool final = isFinalGeneration(batchGeneration);
+    kindGeneration[final].store(batchGeneration, std::memory_order_release);
+    if (!final) {
+        kindGeneration[1].store(batchGeneration, std::memory_order_release);
+    }
+    storedGeneration.store(batchGeneration, std::memory_order_release);
+    // The plan was written before the generation this batch carries
+    storedPlan = sessionPlan;
+    memset(arrived, 0, sizeof(arrived));
+    return SESSION_NEW;
+}
+
+int claimPointSlot(uint8_t dut, uint8_t freqIdx) {
+    if (freqIdx >= SWEEP_FREQ_COUNT) {
+        return getNextPointIndex(dut);
+    }
+    SweepMask bit = (SweepMask)1 << freqIdx;
+    if (!(storedPlan & bit) || (arrived[dut] & bit)) {
+        return -1;
+    }
+    arrived[dut] |= bit;
+    return __builtin_popcountll(storedPlan & (bit - 1));
+}
+
+uint8_t getSlotFreqIndex(int slot) {
+    SweepMask plan = storedPlan;
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        if ((plan & ((SweepMask)1 << i)) && slot-- == 0) {
+            return i;
+        }
+    }
+    return SWEEP_FREQ_INVALID;
+}
+
+void publishMeasurementPoints(uint8_t dut, int end) {
+    // Single writer - no read-modify-write needed
+    uint32_t gen = storedGeneration.load(std::memory_order_relaxed);
+    rowTag[isFinalGeneration(gen)][dut].store(ROW_TAG(gen, end), std::memory_order_release);
+}
+
+void publishFilledRow(uint8_t dut, int end) {
+    // The data processor is done with the session - the GUI task writes in its place
+    arrived[dut] = storedPlan;
+    publishMeasurementPoints(dut, end);
+}
+
+void publishRecalibratedRow(bool baseline, uint8_t dut, int end) {
+    uint32_t gen = kindGeneration[!baseline].load(std::memory_order_relaxed);
+    rowTag[!baseline][dut].store(ROW_TAG(gen, end), std::memory_order_release);
+}
+
+void closeMeasurementRow(uint8_t dut) {
+    arrived[dut] = storedPlan;
+}
+
+void reopenMeasurementRow(uint8_t dut) {
+    arrived[dut] = 0;
+}
+
+SweepMask getMissingPoints(uint8_t dut) {
+    return dut < MAX_DUT_COUNT ? storedPlan & ~arrived[dut] : 0;
+}
+
+int getNextPointIndex(uint8_t dut) {
+    return rowPointCount(isFinalGeneration(storedGeneration.load(std::memory_order_relaxed)), dut,
+                         std::memory_order_relaxed);
+}
+
+int getStoredPointCount(uint8_t dut) {
+    uint32_t stored = storedGeneration.load(std::memory_order_acquire);
+    if (dut >= MAX_DUT_COUNT || stored != generation.load(std::memory_order_acquire)) {
+        return 0;
+    }
+    return rowPointCount(isFinalGeneration(stored), dut, std::memory_order_acquire);
+}
+
+int getRowPointCount(bool baseline, uint8_t dut) {
+    if (dut >= MAX_DUT_COUNT) {
+        return 0;
+    }
+    return rowPointCount(!baseline, dut, std::memory_order_acquire);
+}
+
+uint32_t getRowGeneration(bool baseline) {
+    return kindGeneration[!baseline].load(std::memory_order_acquire);
+}
+
+void restoreBaselineSession(const uint8_t* counts, SweepMask plan) {
+    // The first baseline generation, as if its batches had just been stored
+    uint32_t gen = 2;
+    sessionPlan = plan;
+    storedPlan = plan;
+    for (int i = 0; i < MAX_DUT_COUNT; i++) {
+        rowTag[0][i].store(ROW_TAG(gen, counts[i]), std::memory_order_relaxed);
+        rowTag[1][i].store(0, std::memory_order_relaxed);
+        arrived[i] = plan;
+    }
+    kindGeneration[0].store(gen, std::memory_order_release);
+    kindGeneration[1].store(gen, std::memory_order_release);
+    storedGeneration.store(gen, std::memory_order_release);
+    generation.store(gen, std::memory_order_release);
+}
+
+void resetMeasurementCounts() {
+    for (int i = 0; i < MAX_DUT_COUNT; i++) {
+        rowTag[0][i].store(0, std::memory_order_relaxed);
+        rowTag[1][i].store(0, std::memory_order_relaxed);
+    }
+    memset(arrived, 0, sizeof(arrived));
+    // No session has generation 0 - every row reads empty until the next one
+    kindGeneration[0].store(0, std::memory_order_release);
+    kindGeneration[1].store(0, std::memory_order_release);
+}
@@ -0,0 +1,199 @@
+#include "meas_store.h"
+#include "console.h"
+#include "meas_session.h"
+#include "storage.h"
+#include <LittleFS.h>
+
+// Row pointers into the arenas, nullptr past the active channel count
+ImpedanceRow baselineImpedanceData[MAX_DUT_COUNT] = {};
+ImpedanceRow measurementImpedanceData[MAX_DUT_COUNT] = {};
+
+// One arena per field - 12 bytes per point
+static float magArena[MEAS_STORE_ARENA_POINTS];
+static float phaseArena[MEAS_STORE_ARENA_POINTS];
+static uint8_t freqCodeArena[MEAS_STORE_ARENA_POINTS];
+static uint8_t flagsArena[MEAS_STORE_ARENA_POINTS];
+static uint8_t magSdArena[MEAS_STORE_ARENA_POINTS];
+static uint8_t phaseSdArena[MEAS_STORE_ARENA_POINTS];
+
+// Off-grid part of the frequency axis - only ever appended, so readers in
+// other tasks see a code only after its frequency is written
+static uint32_t offGridFreqs[MEAS_STORE_OFFGRID_MAX];
+static volatile uint8_t offGridCount = 0;
+
+static uint8_t dutCount = 0;
+static uint8_t pointsPerDut = 0;
+
+/*=========================LAYOUT=========================*/
+
+static ImpedanceRow rowAt(size_t offset) {
+    ImpedanceRow row = {&magArena[offset], &phaseArena[offset], &freqCodeArena[offset], &flagsArena[offset],
+                        &magSdArena[offset], &phaseSdArena[offset]};
+    return row;
+}
+
+bool configureMeasurementStore(uint8_t duts, uint8_t points) {
+    if (duts < 1 || duts > MAX_DUT_COUNT || points < 1 || points > MAX_FREQUENCIES) {
+        Console.printf("ERROR: Invalid store layout %d x %d (max %d x %d)\n",
+                      duts, points, MAX_DUT_COUNT, MAX_FREQUENCIES);
+        return false;
+    }
+    size_t needed = 2 * (size_t)duts * points;
+    if (needed > MEAS_STORE_ARENA_POINTS) {
+        Console.printf("ERROR: %d x %d needs %u points, arena holds %u\n",
+                      duts, points, (unsigned)needed, (unsigned)MEAS_STORE_ARENA_POINTS);
+        return false;
+    }
+
+    // Baseline rows first, final rows behind them
+    for (uint8_t i = 0; i < MAX_DUT_COUNT; i++) {
+        baselineImpedanceData[i] = i < duts ? rowAt(i * points) : ImpedanceRow();
+        measurementImpedanceData[i] = i < duts ? rowAt((duts + i) * points) : ImpedanceRow();
+    }
+    dutCount = duts;
+    pointsPerDut = points;
+
+    clearImpedanceData(true);
+    clearImpedanceData(false);
+    resetMeasurementCounts();
+    Console.printf("Measurement store: %d channel%s x %d points\n", duts, duts > 1 ? "s" : "", points);
+    return true;
+}
+
+void initMeasurementStore() {
+    int duts = MEAS_STORE_DEFAULT_DUTS;
+    int points = MAX_FREQUENCIES;
+
+    if (isStorageMounted()) {
+        File file = LittleFS.open(MEAS_STORE_CONFIG_FILE, "r");
+        if (file) {
+            String line = file.readStringUntil('\n');
+            file.close();
+            int comma = line.indexOf(',');
+            if (comma > 0) {
+                duts = line.substring(0, comma).toInt();
+                points = line.substring(comma + 1).toInt();
+            }
+        }
+    }
+
+    if (!configureMeasurementStore(duts, points)) {
+        Console.println("WARNING: Stored store layout rejected - using defaults");
+        configureMeasurementStore(MEAS_STORE_DEFAULT_DUTS, MAX_FREQUENCIES);
+    }
+}
+
+bool saveMeasurementStoreConfig() {
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted");
+        return false;
+    }
+    File file = LittleFS.open(MEAS_STORE_CONFIG_FILE, "w");
+    bool ok = file && file.printf("%d,%d\n", dutCount, pointsPerDut) > 0;
+    if (file) {
+        file.close();
+    }
+    return ok;
+}
+
+uint8_t getDUTCount() {
+    return dutCount;
+}
+
+uint8_t getPointsPerDUT() {
+    return pointsPerDut;
+}
+
+/*=========================CLEARING=========================*/
+
+void clearImpedanceData(bool baseline) {
+    ImpedanceRow* rows = baseline ? baselineImpedanceData : measurementImpedanceData;
+    for (uint8_t i = 0; i < MAX_DUT_COUNT; i++) {
+        if (rows[i].mag == nullptr) {
+            continue;
+        }
+        memset(rows[i].mag, 0, pointsPerDut * sizeof(float));
+        memset(rows[i].phase, 0, pointsPerDut * sizeof(float));
+        memset(rows[i].freqCode, MEAS_STORE_FREQ_UNKNOWN, pointsPerDut);
+        memset(rows[i].flags, 0, pointsPerDut);
+        memset(rows[i].magSd, 0, pointsPerDut);
+        memset(rows[i].phaseSd, 0, pointsPerDut);
+    }
+}
+
+/*=========================POINT ACCESS=========================*/
+
+// Axis code of a frequency, registering new off-grid frequencies
+static uint8_t frequencyCode(uint32_t freq_hz, uint8_t freqIdx) {
+    uint8_t idx = getSweepFrequencyIndex(freq_hz, freqIdx);
+    if (idx != SWEEP_FREQ_INVALID) {
+        return idx;
+    }
+
+    uint8_t count = offGridCount;
+    for (uint8_t k = 0; k < count; k++) {
+        if (offGridFreqs[k] == freq_hz) {
+            return SWEEP_FREQ_COUNT + k;
+        }
+    }
+    if (count >= MEAS_STORE_OFFGRID_MAX) {
+        return MEAS_STORE_FREQ_UNKNOWN;
+    }
+    // Only the data processor stores points - no other writer to race with
+    offGridFreqs[count] = freq_hz;
+    offGridCount = count + 1;
+    return SWEEP_FREQ_COUNT + count;
+}
+
+void storeImpedancePoint(const ImpedanceRow& row, int i, const ImpedancePoint& point,
+                         const PointNoise& noise) {
+    uint8_t code = frequencyCode(point.freq_hz, point.freq_idx);
+    uint8_t flags = point.pga_gain & IMPEDANCE_FLAG_PGA_MASK;
+    if (point.tia_gain) {
+        flags |= IMPEDANCE_FLAG_TIA_HIGH;
+    }
+    if (point.valid && code != MEAS_STORE_FREQ_UNKNOWN) {
+        flags |= IMPEDANCE_FLAG_VALID;
+    }
+
+    row.mag[i] = point.Z_magnitude;
+    row.phase[i] = point.Z_phase;
+    row.freqCode[i] = code;
+    row.flags[i] = flags;
+    row.magSd[i] = noise.magSd;
+    row.phaseSd[i] = noise.phaseSd;
+}
+
+ImpedancePoint loadImpedancePoint(const ImpedanceRow& row, int i) {
+    ImpedancePoint point;
+    uint8_t code = row.freqCode[i];
+    uint8_t flags = row.flags[i];
+    point.freq_hz = storedFrequency(code);
+    point.freq_idx = storedFreqIndex(code);
+    point.Z_magnitude = row.mag[i];
+    point.Z_phase = row.phase[i];
+    point.pga_gain = flags & IMPEDANCE_FLAG_PGA_MASK;
+    point.tia_gain = (flags & IMPEDANCE_FLAG_TIA_HIGH) != 0;
+    point.valid = (flags & IMPEDANCE_FLAG_VALID) != 0;
+    return point;
+}
+
+uint32_t storedFrequency(uint8_t freqCode) {
+    if (freqCode < SWEEP_FREQ_COUNT) {
+        return sweepFrequencies[freqCode];
+    }
+    uint8_t k = freqCode - SWEEP_FREQ_COUNT;
+    return k < offGridCount ? offGridFreqs[k] : 0;
+}
+
+void printMeasurementStore() {
+    Console.println("\n=== Measurement Store ===");
+    Console.printf("Channels:  %d (max %d)\n", dutCount, MAX_DUT_COUNT);
+    Console.printf("Points:    %d per sweep (max %d)\n", pointsPerDut, MAX_FREQUENCIES);
+    Console.printf("Arena:     %u / %u points (%u bytes)\n",
+                  (unsigned)(2 * dutCount * pointsPerDut), (unsigned)MEAS_STORE_ARENA_POINTS,
+                  (unsigned)(sizeof(magArena) + sizeof(phaseArena) + sizeof(freqCodeArena) + sizeof(flagsArena) +
+                              sizeof(magSdArena) + sizeof(phaseSdArena)));
+    Console.printf("Off-grid:  %d / %d frequencies\n", offGridCount, MEAS_STORE_OFFGRID_MAX);
+    Console.println("=========================\n");
+}
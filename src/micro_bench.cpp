@@ -0,0 +1,269 @@
+#include "micro_bench.h"
+#include "console.h"
+
+#if MICRO_BENCH
+
+#include "BLE_Functions.h"
+#include "calibration.h"
+#include "cal_apply.h"
+#include "defines.h"
+#include "fixed_cal.h"
+#include "fixed_format.h"
+#include "gui_screens.h"
+#include "impedance_calc.h"
+#include "meas_session.h"
+#include "meas_store.h"
+#include "sweep_stats.h"
+#include "sweep_table.h"
+#include "esp_cpu.h"
+
+// One timed kernel: call i of a round, returns whether it succeeded
+typedef bool (*BenchKernel)(int i);
+
+// Keeps results alive so the kernels are not optimised away
+static volatile float sink;
+
+// STM32-like inputs at every sweep frequency, with the TIA/PGA of a valid
+// LUT entry where there is one, and the same points run through calcImpedance
+static MeasurementPoint inputs[SWEEP_FREQ_COUNT];
+static ImpedancePoint rawPoints[SWEEP_FREQ_COUNT];
+
+static void buildInputs() {
+    for (int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        MeasurementPoint& m = inputs[f];
+        m.freq_hz = sweepFrequencies[f];
+        m.V_magnitude = 0.35f;
+        m.I_magnitude = 4.0e-6f * (1 + f % 4);
+        m.phase_deg = -45.0f + f;
+        m.pga_gain = 0;
+        m.tia_gain = false;
+        m.valid = true;
+        m.freq_idx = f;
+        for (int slot = 0; slot < 16; slot++) {
+            if (calibrationLUT[f][slot / 8][slot % 8].valid) {
+                m.tia_gain = slot / 8;
+                m.pga_gain = slot % 8;
+                break;
+            }
+        }
+        rawPoints[f] = calcImpedance(m);
+    }
+}
+
+/*=========================TIMING=========================*/
+static int compareCycles(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// Min and median cycles per call over MICRO_BENCH_ROUNDS rounds of calls
+static void runKernel(const char* name, BenchKernel kernel, int calls) {
+    uint32_t perCall[MICRO_BENCH_ROUNDS];
+    uint32_t ok = 0;
+    kernel(0);      // Warm the caches and any lazily built tables
+    for (int round = 0; round < MICRO_BENCH_ROUNDS; round++) {
+        uint32_t start = esp_cpu_get_cycle_count();
+        for (int i = 0; i < calls; i++) {
+            ok += kernel(i) ? 1 : 0;
+        }
+        perCall[round] = (esp_cpu_get_cycle_count() - start) / calls;
+    }
+    qsort(perCall, MICRO_BENCH_ROUNDS, sizeof(perCall[0]), compareCycles);
+
+    float mhz = getCpuFrequencyMhz();
+    uint32_t median = perCall[MICRO_BENCH_ROUNDS / 2];
+    Console.printf("%-22s %10lu %10lu %10.2f %5.0f%%\n", name, perCall[0], median,
+                  median / mhz, 100.0f * ok / (MICRO_BENCH_ROUNDS * calls));
+}
+
+static void skipKernel(const char* name, const char* reason) {
+    Console.printf("%-22s %10s (%s)\n", name, "-", reason);
+}
+
+/*=========================KERNELS=========================*/
+static bool benchCalcImpedance(int i) {
+    ImpedancePoint p = calcImpedance(inputs[i % SWEEP_FREQ_COUNT]);
+    sink = p.Z_magnitude;
+    return p.valid;
+}
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FUSED)
+static bool benchSeparateFiles(int i) {
+    ImpedancePoint p = rawPoints[i % SWEEP_FREQ_COUNT];
+    bool ok = calibrateWithSeparateFiles(p);
+    sink = p.Z_magnitude;
+    return ok;
+}
+
+static bool benchFixedKernel(int i) {
+    ImpedancePoint p;
+    bool ok = calcCalibratedImpedanceFixed(inputs[i % SWEEP_FREQ_COUNT], p);
+    sink = p.Z_magnitude;
+    return ok;
+}
+#endif
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
+static bool benchFormula(int i) {
+    ImpedancePoint p = rawPoints[i % SWEEP_FREQ_COUNT];
+    bool ok = calibrateWithFormula(p);
+    sink = p.Z_magnitude;
+    return ok;
+}
+#endif
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+static bool benchLookup(int i) {
+    ImpedancePoint p = rawPoints[i % SWEEP_FREQ_COUNT];
+    bool ok = calibrateWithLookup(p);
+    sink = p.Z_magnitude;
+    return ok;
+}
+#endif
+
+// Recomputed from the unchanged risk sums - the stored results stay the same
+static bool benchRiskLevel(int i) {
+    uint8_t dut = i % getDUTCount();
+    calculateRiskLevel(dut);
+    return riskLevels[dut] != RISK_ERROR;
+}
+
+static bool benchBLEJson(int i) {
+    static char json[BLE_DATA_JSON_BYTES];
+    BLEDataQuery all;
+    parseBLEDataQuery(nullptr, all);
+    uint8_t dut = i % getDUTCount();
+    int stored = getStoredPointCount(dut);
+    const ImpedanceRow& row = baselineMeasurementDone ? measurementImpedanceData[dut]
+                                                      : baselineImpedanceData[dut];
+    return stored > 0 && encodeBLEImpedanceJSON(dut, row, stored, json, sizeof(json), all) > 0;
+}
+
+// One CSV magnitude, fixed-decimal formatter against newlib's printf
+static bool benchFormatFixed(int i) {
+    char text[FIXED_FORMAT_BUFFER];
+    size_t n = formatFixed(text, sizeof(text), rawPoints[i % SWEEP_FREQ_COUNT].Z_magnitude, 6);
+    sink = text[0];
+    return n > 0;
+}
+
+static bool benchFormatPrintf(int i) {
+    char text[FIXED_FORMAT_BUFFER];
+    int n = snprintf(text, sizeof(text), "%.6f", rawPoints[i % SWEEP_FREQ_COUNT].Z_magnitude);
+    sink = text[0];
+    return n > 0 && n < (int)sizeof(text);
+}
+
+/*=========================SCREENS=========================*/
+struct BenchScreen {
+    const char* name;
+    void (*draw)();
+};
+
+static void drawBaselineProgress() {
+    drawProgressScreen(true);
+}
+
+static void drawFinalProgress() {
+    drawProgressScreen(false);
+}
+
+static const BenchScreen screens[] = {
+    {"home",              drawHomeScreen},
+    {"settings",          drawSettingsScreen},
+    {"freq_override",     drawFreqOverrideScreen},
+    {"progress_baseline", drawBaselineProgress},
+    {"progress_final",    drawFinalProgress},
+    {"baseline_complete", drawBaselineCompleteScreen},
+    {"results",           drawResultsScreen},
+    {"monitor",           drawMonitorScreen},
+};
+
+static const BenchScreen* benchScreen = nullptr;
+
+// Draw only: every band, nothing pushed
+static bool benchScreenDraw(int i) {
+    for (int16_t top = 0; top < SCREEN_HEIGHT; top += BAND_HEIGHT) {
+        sprite.selectBand(0, top);
+        benchScreen->draw();
+    }
+    return true;
+}
+
+// Draw and push every band, up to the last DMA transfer
+static bool benchScreenFrame(int i) {
+    renderFrame(benchScreen->draw);
+    finishFramePush();
+    return true;
+}
+
+// Decodes the logo while drawing, so it has no draw-only variant
+static bool benchSplash(int i) {
+    drawSplashScreen();
+    finishFramePush();
+    return true;
+}
+
+/*=========================RUNNER=========================*/
+void runMicroBenchmarks() {
+    buildInputs();
+
+    Console.println("\n=== Micro-benchmarks ===");
+    Console.printf("CPU %lu MHz, %d rounds, calibration mode %d\n", (unsigned long)getCpuFrequencyMhz(),
+                  MICRO_BENCH_ROUNDS, (int)getCalibrationMode());
+    Console.printf("%-22s %10s %10s %10s %6s\n", "kernel", "min cyc", "med cyc", "med us", "ok");
+
+    runKernel("calcImpedance", benchCalcImpedance, MICRO_BENCH_POINT_CALLS);
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FUSED)
+    runKernel("cal_separate_files", benchSeparateFiles, MICRO_BENCH_POINT_CALLS);
+    runKernel("cal_fixed_point", benchFixedKernel, MICRO_BENCH_POINT_CALLS);
+#endif
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
+    runKernel("cal_formula", benchFormula, MICRO_BENCH_POINT_CALLS);
+#endif
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+    runKernel("cal_lookup", benchLookup, MICRO_BENCH_POINT_CALLS);
+#endif
+
+    runKernel("format_fixed", benchFormatFixed, MICRO_BENCH_POINT_CALLS);
+    runKernel("format_printf", benchFormatPrintf, MICRO_BENCH_POINT_CALLS);
+
+    if (finalMeasurementDone) {
+        runKernel("calculateRiskLevel", benchRiskLevel, MICRO_BENCH_SWEEP_CALLS);
+    } else {
+        skipKernel("calculateRiskLevel", "no final sweep");
+    }
+    if (getStoredPointCount(0) > 0) {
+        runKernel("ble_json_encode", benchBLEJson, MICRO_BENCH_SWEEP_CALLS);
+    } else {
+        skipKernel("ble_json_encode", "no stored sweep");
+    }
+
+    if (sprite.created()) {
+        char name[32];
+        for (const BenchScreen& screen : screens) {
+            benchScreen = &screen;
+            snprintf(name, sizeof(name), "draw_%s", screen.name);
+            runKernel(name, benchScreenDraw, MICRO_BENCH_FRAME_CALLS);
+            snprintf(name, sizeof(name), "frame_%s", screen.name);
+            runKernel(name, benchScreenFrame, MICRO_BENCH_FRAME_CALLS);
+        }
+        runKernel("frame_splash", benchSplash, MICRO_BENCH_FRAME_CALLS);
+    } else {
+        skipKernel("screens", "no strip buffers");
+    }
+    Console.println("========================\n");
+
+    // The fixed-point kernel records every call as a calibrate() stage
+    sweepStatsReset();
+    renderCurrentScreen();
+}
+
+#else
+
+void runMicroBenchmarks() {
+    Console.println("Micro-benchmarks are not built in (pio run -e bench)");
+}
+
+#endif // MICRO_BENCH
@@ -0,0 +1,173 @@
+#include "monitor.h"
+#include "console.h"
+#include "defines.h"
+#include "meas_store.h"
+#include "meas_control.h"
+#include "gui_state.h"
+#include "gui_screens.h"
+#include "impedance_calc.h"
+#include "sleep_monitor.h"
+
+static bool monitorActive = false;
+static uint32_t intervalMs = 0;
+static uint32_t lastSweepMs = 0;
+static uint32_t sweepCount = 0;
+
+// Last result sent per DUT
+static RiskLevel reportedLevel[MAX_DUT_COUNT];
+static float reportedPercent[MAX_DUT_COUNT];
+static RiskLevel reportedTrackedLevel[MAX_DUT_COUNT];
+static float reportedTrackedPercent[MAX_DUT_COUNT];
+
+/*=========================CONTROL=========================*/
+
+bool startMonitor(uint32_t intervalS, uint32_t trackHalfLife) {
+    if (!baselineMeasurementDone || getMeasurementState() != MEAS_IDLE) {
+        Console.println("ERROR: Monitor needs a baseline and an idle sweep");
+        return false;
+    }
+    if (intervalS < MONITOR_MIN_INTERVAL_S) {
+        Console.printf("ERROR: Monitor interval must be at least %d s\n", MONITOR_MIN_INTERVAL_S);
+        return false;
+    }
+    if (trackHalfLife > TRACK_HALF_LIFE_MAX) {
+        Console.printf("ERROR: Tracking half-life must be at most %d sweeps\n", TRACK_HALF_LIFE_MAX);
+        return false;
+    }
+
+    // Nothing reported yet - the first sweep sends every DUT's result
+    for (int i = 0; i < MAX_DUT_COUNT; i++) {
+        reportedLevel[i] = RISK_ERROR;
+        reportedPercent[i] = NAN;
+        reportedTrackedLevel[i] = RISK_ERROR;
+        reportedTrackedPercent[i] = NAN;
+    }
+    resetTrackedBaseline(trackHalfLife);
+    intervalMs = intervalS * 1000;
+    lastSweepMs = millis() - intervalMs;
+    sweepCount = 0;
+    monitorActive = true;
+
+    if (trackHalfLife > 0) {
+        Console.printf("Monitor: every %lu s, baseline tracked (half-life %lu sweeps)\n",
+                      (unsigned long)intervalS, (unsigned long)trackHalfLife);
+    } else {
+        Console.printf("Monitor: every %lu s\n", (unsigned long)intervalS);
+    }
+    setGUIState(GUI_MONITOR);
+    return true;
+}
+
+void stopMonitor() {
+    if (!monitorActive) {
+        return;
+    }
+    monitorActive = false;
+    requestMeasurementStop(MEAS_SOURCE_MONITOR);
+    Console.printf("Monitor stopped after %lu sweeps\n", (unsigned long)sweepCount);
+}
+
+bool isMonitorActive() {
+    return monitorActive;
+}
+
+uint32_t getMonitorInterval() {
+    return intervalMs / 1000;
+}
+
+uint32_t getMonitorSweepCount() {
+    return sweepCount;
+}
+
+/*=========================SWEEPS=========================*/
+
+// START completion, after the controller's (GUI task)
+static void onMonitorStart(uint8_t cmd_type, bool success, void* context) {
+    if (!monitorActive) {
+        return;
+    }
+    if (success) {
+        sweepCount++;
+    } else {
+        Console.println("Monitor: START failed - retrying next interval");
+    }
+}
+
+void processMonitor() {
+    if (!monitorActive || getMeasurementState() != MEAS_IDLE) {
+        return;
+    }
+    uint32_t now = millis();
+    if (now - lastSweepMs < intervalMs) {
+        return;
+    }
+    lastSweepMs = now;
+
+    // Same plan as the baseline so the points pair up by sweep index
+    MeasRequestError error = requestFinalSweep(MEAS_SOURCE_MONITOR, onMonitorStart);
+    if (error != MEAS_REQUEST_OK) {
+        Console.printf("Monitor: %s - retrying next interval\n", measRequestErrorText(error));
+    }
+}
+
+uint32_t getMonitorWaitMs() {
+    if (!monitorActive || getMeasurementState() != MEAS_IDLE) {
+        return UINT32_MAX;
+    }
+    uint32_t elapsed = millis() - lastSweepMs;
+    return elapsed >= intervalMs ? 0 : intervalMs - elapsed;
+}
+
+static bool resultMoved(RiskLevel level, float percent, RiskLevel reported, float reportedPct) {
+    return level != reported || !(fabs(percent - reportedPct) < MONITOR_PCT_DEADBAND);
+}
+
+bool monitorRiskChanged(uint8_t dutIndex) {
+    RiskLevel level = riskLevels[dutIndex];
+    float percent = riskPercentages[dutIndex];
+    bool tracking = getTrackingHalfLife() > 0;
+    RiskLevel trackedLevel = getTrackedRiskLevel(dutIndex);
+    float trackedPercent = getTrackedRiskPercent(dutIndex);
+    if (!resultMoved(level, percent, reportedLevel[dutIndex], reportedPercent[dutIndex]) &&
+        !(tracking && resultMoved(trackedLevel, trackedPercent, reportedTrackedLevel[dutIndex],
+                                  reportedTrackedPercent[dutIndex]))) {
+        return false;
+    }
+    reportedLevel[dutIndex] = level;
+    reportedPercent[dutIndex] = percent;
+    reportedTrackedLevel[dutIndex] = trackedLevel;
+    reportedTrackedPercent[dutIndex] = trackedPercent;
+    return true;
+}
+
+void onMonitorSweepComplete() {
+    Console.printf("Monitor: sweep %lu complete\n", (unsigned long)sweepCount);
+    if (getGUIState() == GUI_MONITOR) {
+        requestRender();
+    }
+    // Behind the deliveries of the sweep
+    sleepMonitorSweepComplete();
+}
+
+MonitorReport getMonitorReport(uint8_t dutIndex) {
+    MonitorReport report;
+    report.level = reportedLevel[dutIndex];
+    report.percent = reportedPercent[dutIndex];
+    report.trackedLevel = reportedTrackedLevel[dutIndex];
+    report.trackedPercent = reportedTrackedPercent[dutIndex];
+    return report;
+}
+
+void resumeMonitor(uint32_t intervalS, uint32_t sweeps, const MonitorReport* reports, uint8_t count) {
+    for (int i = 0; i < MAX_DUT_COUNT; i++) {
+        reportedLevel[i] = i < count ? reports[i].level : RISK_ERROR;
+        reportedPercent[i] = i < count ? reports[i].percent : NAN;
+        reportedTrackedLevel[i] = i < count ? reports[i].trackedLevel : RISK_ERROR;
+        reportedTrackedPercent[i] = i < count ? reports[i].trackedPercent : NAN;
+    }
+    intervalMs = intervalS * 1000;
+    lastSweepMs = millis() - intervalMs;
+    sweepCount = sweeps;
+    monitorActive = true;
+    setGUIState(GUI_MONITOR);
+}
@@ -0,0 +1,56 @@
+#include "open_channel.h"
+
+static_assert(MAX_DUT_COUNT <= 32, "Open channel mask holds one bit per DUT");
+
+// Read by the GUI task for the final sweep and the results screen
+static std::atomic<uint32_t> openMask(0);
+
+// Data processor only
+static uint32_t checkedMask = 0;    // DUTs decided in this session
+static uint8_t leadingOpen[MAX_DUT_COUNT];
+
+// No signal: the front end saw no current worth measuring
+static bool isOpenPoint(const MeasurementPoint& point) {
+    return !point.valid || point.I_magnitude <= 0.0f ||
+           point.V_magnitude > point.I_magnitude * OPEN_CHANNEL_OHMS;
+}
+
+void resetOpenChannelScan(bool final) {
+    memset(leadingOpen, 0, sizeof(leadingOpen));
+    if (!final) {
+        openMask.store(0, std::memory_order_relaxed);
+    }
+    // The baseline's open DUTs are skipped, not checked again
+    checkedMask = openMask.load(std::memory_order_relaxed);
+}
+
+bool noteOpenChannelPoint(uint8_t dut, const MeasurementPoint& point) {
+    uint32_t bit = 1UL << dut;
+    if (dut >= MAX_DUT_COUNT || (checkedMask & bit)) {
+        return false;
+    }
+    if (!isOpenPoint(point)) {
+        checkedMask |= bit;
+        return false;
+    }
+    if (++leadingOpen[dut] < OPEN_CHANNEL_POINTS) {
+        return false;
+    }
+    checkedMask |= bit;
+    openMask.fetch_or(bit, std::memory_order_relaxed);
+    return true;
+}
+
+void markChannelOpen(uint8_t dut) {
+    if (dut < MAX_DUT_COUNT) {
+        openMask.fetch_or(1UL << dut, std::memory_order_relaxed);
+    }
+}
+
+bool isChannelOpen(uint8_t dut) {
+    return dut < MAX_DUT_COUNT && (openMask.load(std::memory_order_relaxed) & (1UL << dut)) != 0;
+}
+
+uint32_t getOpenChannelMask() {
+    return openMask.load(std::memory_order_relaxed);
+}
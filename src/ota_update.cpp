@@ -0,0 +1,581 @@
+#include "ota_update.h"
+#include "console.h"
+#include "cal_upload.h"
+#include "cal_acquire.h"
+#include "history_download.h"
+#include "meas_control.h"
+#include "monitor.h"
+#include "storage.h"
+#include "integrity.h"
+#include "ota_signing_key.h"
+#include "BLE_Functions.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_system.h"
+#include "defines.h"
+
+enum OTAState : uint8_t {
+    OTA_IDLE,
+    OTA_HASHING_BASE,       // Delta BEGIN received, checking the running image
+    OTA_RECEIVING,
+    OTA_REBOOTING           // END accepted, boot slot switched
+};
+
+// Single frame slot - filled by the BLE callback, drained by processOTAUpdate()
+static uint8_t frameBuffer[OTA_FRAME_MAX];
+static volatile size_t frameLength = 0;         // 0 = slot free
+static volatile bool frameDropped = false;
+
+static OTAState state = OTA_IDLE;
+static const esp_partition_t* runningSlot = nullptr;
+static const esp_partition_t* targetSlot = nullptr;
+static esp_ota_handle_t otaHandle = 0;
+static bool otaOpen = false;
+static Sha256 imageHash;
+static Sha256 baseHash;
+static_assert(OTA_SHA_SIZE == SHA256_SIZE, "BEGIN carries SHA-256 digests");
+static_assert(OTA_SIGNATURE_SIZE == P256_SIGNATURE_SIZE, "BEGIN carries a P-256 signature");
+static_assert(sizeof(otaSigningKey) == P256_PUBLIC_KEY_SIZE, "ota_signing_key.h holds an uncompressed P-256 point");
+static uint16_t nextSeq = 0;
+static unsigned long rebootStart = 0;
+static bool selfTestPending = false;
+
+// Image announced by BEGIN
+static uint8_t encoding = OTA_ENCODING_RAW;
+static uint32_t imageSize = 0;
+static uint8_t imageSha[OTA_SHA_SIZE];
+static uint32_t baseSize = 0;
+static uint8_t baseSha[OTA_SHA_SIZE];
+static uint8_t signature[OTA_SIGNATURE_SIZE];
+static uint32_t baseHashed = 0;
+
+// Output: whole blocks go to esp_ota_write() and the image hash
+static uint8_t writeBuffer[OTA_WRITE_BUFFER];
+static size_t buffered = 0;
+static uint32_t flushed = 0;            // Bytes already in the slot
+
+// DATA frame being decoded - it keeps the slot until its ops are done
+static bool dataPending = false;
+static uint16_t dataSeq = 0;
+static size_t dataCursor = 0;           // Next unread byte of frameBuffer
+static size_t dataEnd = 0;
+
+// Delta op being decoded
+static uint8_t opHeader[9];
+static uint8_t opHeaderLen = 0;
+static uint8_t opCode = OTA_OP_LITERAL;
+static uint32_t opSource = 0;           // COPY_*: next source offset
+static uint32_t opRemaining = 0;        // Output bytes the op still produces
+static uint8_t opValue = 0;
+
+// Arduino core hook: the firmware confirms an update itself (initOTAUpdate)
+extern "C" bool verifyRollbackLater() {
+    return true;
+}
+
+/*=========================BLE SIDE=========================*/
+bool otaUpdateReceive(const uint8_t* data, size_t len) {
+    if (frameLength != 0) {
+        frameDropped = true;
+        return false;
+    }
+    if (len < OTA_FRAME_OVERHEAD || len > OTA_FRAME_MAX) {
+        return false;
+    }
+
+    memcpy(frameBuffer, data, len);
+    frameLength = len;      // Publish after the copy
+    return true;
+}
+
+bool isOTAUpdateActive() {
+    return state != OTA_IDLE;
+}
+
+/*=========================REPLIES=========================*/
+static void sendAck(uint16_t seq) {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%s:%u", BLE_RESP_OTA_ACK, seq);
+    sendBLEString(buffer);
+}
+
+static void releaseUpdate() {
+    if (otaOpen) {
+        esp_ota_abort(otaHandle);
+        otaOpen = false;
+    }
+    imageHash.release();
+    baseHash.release();
+    dataPending = false;
+    state = OTA_IDLE;
+}
+
+static void fail(const char* reason) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "OTA: %s", reason);
+    Console.printf("[OTA] %s\n", buffer);
+    sendBLEError(buffer);
+    releaseUpdate();
+}
+
+/*=========================OUTPUT=========================*/
+static bool flushOutput() {
+    if (buffered == 0) {
+        return true;
+    }
+    imageHash.update(writeBuffer, buffered);
+    if (esp_ota_write(otaHandle, writeBuffer, buffered) != ESP_OK) {
+        fail("flash write failed");
+        return false;
+    }
+    flushed += buffered;
+    buffered = 0;
+    return true;
+}
+
+// Room for at least one byte in the write buffer
+static bool makeRoom() {
+    return buffered < OTA_WRITE_BUFFER || flushOutput();
+}
+
+static bool emit(const uint8_t* data, size_t len) {
+    while (len > 0) {
+        if (!makeRoom()) {
+            return false;
+        }
+        size_t n = min(len, OTA_WRITE_BUFFER - buffered);
+        memcpy(writeBuffer + buffered, data, n);
+        buffered += n;
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+/*=========================DELTA DECODER=========================*/
+static uint8_t opHeaderSize(uint8_t op) {
+    switch (op) {
+        case OTA_OP_LITERAL:    return 3;
+        case OTA_OP_COPY_BASE:
+        case OTA_OP_COPY_OUT:   return 9;
+        case OTA_OP_FILL:       return 6;
+        default:                return 0;
+    }
+}
+
+// The op header is complete - check it against the image and the sources
+static bool startOp() {
+    opCode = opHeader[0];
+    if (opCode == OTA_OP_LITERAL) {
+        uint16_t len;
+        memcpy(&len, opHeader + 1, sizeof(len));
+        opRemaining = len;
+    } else if (opCode == OTA_OP_FILL) {
+        memcpy(&opRemaining, opHeader + 1, sizeof(opRemaining));
+        opValue = opHeader[5];
+    } else {
+        memcpy(&opSource, opHeader + 1, sizeof(opSource));
+        memcpy(&opRemaining, opHeader + 5, sizeof(opRemaining));
+        // A full buffer is flushed lazily - the encoder counts it as written
+        if (opCode == OTA_OP_COPY_OUT && !makeRoom()) {
+            return false;
+        }
+        uint32_t limit = opCode == OTA_OP_COPY_BASE ? baseSize : flushed;
+        if (opSource > limit || opRemaining > limit - opSource) {
+            fail("delta copy outside its source");
+            return false;
+        }
+    }
+    if (opRemaining > imageSize - flushed - buffered) {
+        fail("image larger than announced");
+        return false;
+    }
+    return true;
+}
+
+// Run a COPY / FILL op for at most budget output bytes
+static bool stepOp(size_t& budget) {
+    while (opCode != OTA_OP_LITERAL && opRemaining > 0 && budget > 0) {
+        if (!makeRoom()) {
+            return false;
+        }
+        size_t n = min(min((size_t)opRemaining, OTA_WRITE_BUFFER - buffered), budget);
+        if (opCode == OTA_OP_FILL) {
+            memset(writeBuffer + buffered, opValue, n);
+        } else {
+            const esp_partition_t* source = opCode == OTA_OP_COPY_BASE ? runningSlot : targetSlot;
+            if (esp_partition_read(source, opSource, writeBuffer + buffered, n) != ESP_OK) {
+                fail("flash read failed");
+                return false;
+            }
+            opSource += n;
+        }
+        buffered += n;
+        opRemaining -= n;
+        budget -= n;
+    }
+    return true;
+}
+
+static bool opBusy() {
+    return opCode != OTA_OP_LITERAL && opRemaining > 0;
+}
+
+// Decode the held DATA frame for one step; false once it failed
+static bool decodeData() {
+    size_t budget = OTA_STEP_BYTES;
+    while (true) {
+        if (!stepOp(budget)) {
+            return false;
+        }
+        if (opBusy() || dataCursor == dataEnd) {
+            return true;        // Out of budget, or the frame is used up
+        }
+
+        const uint8_t* in = frameBuffer + dataCursor;
+        size_t available = dataEnd - dataCursor;
+        if (encoding == OTA_ENCODING_RAW) {
+            if (available > imageSize - flushed - buffered) {
+                fail("image larger than announced");
+                return false;
+            }
+            if (!emit(in, available)) {
+                return false;
+            }
+            dataCursor = dataEnd;
+        } else if (opRemaining > 0) {
+            // LITERAL bytes
+            size_t n = min(available, (size_t)opRemaining);
+            if (!emit(in, n)) {
+                return false;
+            }
+            dataCursor += n;
+            opRemaining -= n;
+        } else {
+            opHeader[opHeaderLen++] = *in;
+            dataCursor++;
+            uint8_t size = opHeaderSize(opHeader[0]);
+            if (size == 0) {
+                fail("bad delta op");
+                return false;
+            }
+            if (opHeaderLen == size) {
+                opHeaderLen = 0;
+                if (!startOp()) {
+                    return false;
+                }
+            }
+        }
+    }
+}
+
+/*=========================FRAME HANDLERS=========================*/
+static void handleBegin(const uint8_t* payload, size_t len) {
+    if (state != OTA_IDLE) {
+        releaseUpdate();    // A new BEGIN restarts the update
+    }
+    if (len != OTA_BEGIN_SIZE) {
+        fail("bad BEGIN");
+        return;
+    }
+    if (getMeasurementState() != MEAS_IDLE || measurementInProgress || isMonitorActive()) {
+        fail("measurement in progress");
+        return;
+    }
+    if (isCalUploadInProgress() || isCalAcquireActive()) {
+        fail("calibration transfer running");
+        return;
+    }
+    if (isHistoryDownloadActive()) {
+        fail("history download running");
+        return;
+    }
+    if (selfTestPending) {
+        fail("running firmware not confirmed yet");
+        return;
+    }
+
+    targetSlot = esp_ota_get_next_update_partition(nullptr);
+    if (targetSlot == nullptr || runningSlot == nullptr) {
+        fail("no OTA slot");
+        return;
+    }
+
+    memcpy(&imageSize, payload, sizeof(imageSize));
+    encoding = payload[4];
+    memcpy(imageSha, payload + 5, OTA_SHA_SIZE);
+    memcpy(&baseSize, payload + 5 + OTA_SHA_SIZE, sizeof(baseSize));
+    memcpy(baseSha, payload + 9 + OTA_SHA_SIZE, OTA_SHA_SIZE);
+    memcpy(signature, payload + 9 + 2 * OTA_SHA_SIZE, OTA_SIGNATURE_SIZE);
+    if (imageSize == 0 || imageSize > targetSlot->size) {
+        fail("bad image size");
+        return;
+    }
+    if (encoding > OTA_ENCODING_DELTA || (encoding == OTA_ENCODING_RAW && baseSize != 0)) {
+        fail("unknown encoding");
+        return;
+    }
+    if (baseSize > runningSlot->size) {
+        fail("bad base size");
+        return;
+    }
+    // An unsigned image never opens the slot - END checks it again over
+    // what was actually written
+    if (otaSigningKey[0] != 0x04) {
+        fail("no update key in this firmware");
+        return;
+    }
+    if (!verifyP256Signature(otaSigningKey, imageSha, signature)) {
+        fail("image not signed by the update key");
+        return;
+    }
+
+    // Sectors are erased as the writes reach them, not all at BEGIN
+    if (esp_ota_begin(targetSlot, OTA_WITH_SEQUENTIAL_WRITES, &otaHandle) != ESP_OK) {
+        fail("slot open failed");
+        return;
+    }
+    otaOpen = true;
+    imageHash.begin();
+    baseHash.begin();
+
+    buffered = 0;
+    flushed = 0;
+    baseHashed = 0;
+    nextSeq = 0;
+    opHeaderLen = 0;
+    opCode = OTA_OP_LITERAL;
+    opRemaining = 0;
+    state = baseSize > 0 ? OTA_HASHING_BASE : OTA_RECEIVING;
+    Console.printf("[OTA] Update to %s started (%lu bytes, %s)\n", targetSlot->label, imageSize,
+                  encoding == OTA_ENCODING_DELTA ? "delta" : "raw");
+    if (state == OTA_RECEIVING) {
+        sendAck(0);
+    }
+}
+
+// Hash the next OTA_STEP_BYTES of the delta base - ACK BEGIN once it matched
+static void hashBaseStep() {
+    uint32_t end = min(baseSize, baseHashed + OTA_STEP_BYTES);
+    while (baseHashed < end) {
+        size_t n = min((size_t)(end - baseHashed), sizeof(writeBuffer));
+        if (esp_partition_read(runningSlot, baseHashed, writeBuffer, n) != ESP_OK) {
+            fail("flash read failed");
+            return;
+        }
+        baseHash.update(writeBuffer, n);
+        baseHashed += n;
+    }
+    if (baseHashed < baseSize) {
+        return;
+    }
+
+    uint8_t digest[OTA_SHA_SIZE];
+    baseHash.finish(digest);
+    if (memcmp(digest, baseSha, OTA_SHA_SIZE) != 0) {
+        fail("delta made for other firmware");
+        return;
+    }
+    state = OTA_RECEIVING;
+    sendAck(0);
+}
+
+static void handleData(uint16_t seq, size_t len) {
+    if (state != OTA_RECEIVING) {
+        fail("DATA before BEGIN");
+        return;
+    }
+    if (seq + 1 == nextSeq) {
+        sendAck(seq);       // Retransmission after a lost ACK - already written
+        return;
+    }
+    if (seq != nextSeq) {
+        fail("chunk out of sequence");
+        return;
+    }
+    dataPending = true;
+    dataSeq = seq;
+    dataCursor = 3;
+    dataEnd = 3 + len;
+}
+
+// Continue the held DATA frame - ACK once all of its ops are done
+static void continueData() {
+    if (!decodeData()) {
+        return;
+    }
+    if (dataCursor < dataEnd || opBusy()) {
+        return;             // Next GUI loop pass
+    }
+    dataPending = false;
+    nextSeq++;
+    sendAck(dataSeq);
+}
+
+static void handleEnd(uint16_t seq) {
+    if (state != OTA_RECEIVING || opHeaderLen != 0 || opRemaining != 0) {
+        fail("image incomplete");
+        return;
+    }
+    if (!flushOutput()) {
+        return;
+    }
+    if (flushed != imageSize) {
+        fail("image incomplete");
+        return;
+    }
+
+    uint8_t digest[OTA_SHA_SIZE];
+    imageHash.finish(digest);
+    if (memcmp(digest, imageSha, OTA_SHA_SIZE) != 0) {
+        fail("SHA-256 mismatch");
+        return;
+    }
+    // The digest of the written slot, so a delta is checked as reconstructed
+    if (!verifyP256Signature(otaSigningKey, digest, signature)) {
+        fail("signature mismatch");
+        return;
+    }
+    // Checks the image header, segments and appended digest
+    otaOpen = false;
+    if (esp_ota_end(otaHandle) != ESP_OK) {
+        fail("image invalid");
+        return;
+    }
+    if (esp_ota_set_boot_partition(targetSlot) != ESP_OK) {
+        fail("boot slot switch failed");
+        return;
+    }
+
+    Console.printf("[OTA] Update complete (%lu bytes) - rebooting into %s\n", imageSize, targetSlot->label);
+    sendAck(seq);
+    imageHash.release();
+    baseHash.release();
+    state = OTA_REBOOTING;
+    rebootStart = millis();
+}
+
+/*=========================PROCESSING=========================*/
+void initOTAUpdate(bool tasksStarted) {
+    runningSlot = esp_ota_get_running_partition();
+    esp_ota_img_states_t imageState;
+    if (runningSlot == nullptr || esp_ota_get_state_partition(runningSlot, &imageState) != ESP_OK ||
+        imageState != ESP_OTA_IMG_PENDING_VERIFY) {
+        return;
+    }
+
+    // Boot self-test of an update: the tasks run and the filesystem mounted
+    if (!tasksStarted || !isStorageMounted()) {
+        Console.println("[OTA] New firmware failed its boot self-test - rolling back");
+        esp_ota_mark_app_invalid_rollback_and_reboot();
+        return;
+    }
+    selfTestPending = true;
+    Console.printf("[OTA] New firmware in %s - confirmed after %d s\n", runningSlot->label, OTA_SELFTEST_MS / 1000);
+}
+
+void processOTAUpdate() {
+    if (selfTestPending && millis() >= OTA_SELFTEST_MS) {
+        selfTestPending = false;
+        if (esp_ota_mark_app_valid_cancel_rollback() == ESP_OK) {
+            Console.println("[OTA] New firmware confirmed");
+        }
+    }
+
+    if (frameDropped) {
+        frameDropped = false;
+        fail("frame dropped - wait for OTA_ACK");
+    }
+
+    switch (state) {
+        case OTA_HASHING_BASE:
+            hashBaseStep();
+            break;
+        case OTA_REBOOTING:
+            if (millis() - rebootStart >= OTA_REBOOT_DELAY_MS) {
+                flushConsole();
+                esp_restart();
+            }
+            frameLength = 0;
+            return;
+        default:
+            break;
+    }
+
+    if (dataPending) {
+        continueData();
+        if (!dataPending) {
+            frameLength = 0;    // Free the slot for the next frame
+        }
+        return;
+    }
+
+    size_t len = frameLength;
+    if (len == 0) {
+        return;
+    }
+
+    uint16_t crc;
+    memcpy(&crc, frameBuffer + len - sizeof(crc), sizeof(crc));
+    if (crc != crc16_ccitt(frameBuffer, len - sizeof(crc))) {
+        fail("frame CRC mismatch");
+        frameLength = 0;
+        return;
+    }
+
+    uint8_t type = frameBuffer[0];
+    uint16_t seq;
+    memcpy(&seq, frameBuffer + 1, sizeof(seq));
+    const uint8_t* payload = frameBuffer + 3;
+    size_t payloadLen = len - OTA_FRAME_OVERHEAD;
+
+    switch (type) {
+        case OTA_UPDATE_BEGIN:
+            handleBegin(payload, payloadLen);
+            break;
+        case OTA_UPDATE_DATA:
+            handleData(seq, payloadLen);
+            if (dataPending) {
+                continueData();
+            }
+            break;
+        case OTA_UPDATE_END:
+            handleEnd(seq);
+            break;
+        case OTA_UPDATE_ABORT:
+            // The slot keeps a partial image - it is never made bootable
+            releaseUpdate();
+            Console.println("[OTA] Update aborted");
+            sendAck(seq);
+            break;
+        default:
+            fail("unknown frame type");
+            break;
+    }
+
+    if (!dataPending) {
+        frameLength = 0;        // Free the slot for the next frame
+    }
+}
+
+/*=========================REPORT=========================*/
+void printOTAStatus() {
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    const esp_partition_t* next = esp_ota_get_next_update_partition(nullptr);
+    esp_ota_img_states_t imageState;
+    const char* stateName = "valid";
+    if (running != nullptr && esp_ota_get_state_partition(running, &imageState) == ESP_OK) {
+        stateName = imageState == ESP_OTA_IMG_PENDING_VERIFY ? "pending verify"
+                  : imageState == ESP_OTA_IMG_NEW ? "new" : "valid";
+    }
+    Console.printf("Running: %s (%s)%s\n", running != nullptr ? running->label : "?", stateName,
+                  selfTestPending ? ", confirming" : "");
+    Console.printf("Update slot: %s\n", next != nullptr ? next->label : "none");
+    if (state == OTA_HASHING_BASE) {
+        Console.printf("Checking delta base: %lu/%lu bytes\n", baseHashed, baseSize);
+    } else if (state != OTA_IDLE) {
+        Console.printf("Update: %lu/%lu bytes (%s)%s\n", flushed + buffered, imageSize,
+                      encoding == OTA_ENCODING_DELTA ? "delta" : "raw",
+                      state == OTA_REBOOTING ? ", rebooting" : "");
+    }
+}
@@ -0,0 +1,92 @@
+#include "perf_dashboard.h"
+#include "UART_Functions.h"
+#include "BLE_Functions.h"
+#include "counters.h"
+#include "gui_screens.h"
+#include "heap_stats.h"
+
+// GUI task only
+static PerfSnapshot snapshot;
+static uint32_t lastSampleMs = 0;
+static uint32_t lastFrames = 0;
+static uint32_t lastBLEBytes = 0;
+
+// Registered by the modules that count them - nullptr if compiled out
+static const FieldHistogram* notifyBytes = nullptr;
+static const FieldCounter* notifyErrors = nullptr;
+static const FieldHistogram* renderUs = nullptr;
+
+static const FieldHistogram* findHistogram(const char* name) {
+    const FieldMetric* m = findFieldMetric(name);
+    return m != nullptr && m->kind == COUNTER_KIND_HISTOGRAM ? static_cast<const FieldHistogram*>(m) : nullptr;
+}
+
+static const FieldCounter* findCounter(const char* name) {
+    const FieldMetric* m = findFieldMetric(name);
+    return m != nullptr && m->kind == COUNTER_KIND_COUNTER ? static_cast<const FieldCounter*>(m) : nullptr;
+}
+
+// Per second over elapsedMs, 0 for the first sample
+static uint32_t perSecond(uint32_t delta, uint32_t elapsedMs) {
+    return elapsedMs > 0 ? (uint32_t)((uint64_t)delta * 1000 / elapsedMs) : 0;
+}
+
+static void takeSample(bool first) {
+    uint32_t now = millis();
+    uint32_t elapsedMs = first ? 0 : now - lastSampleMs;
+    lastSampleMs = now;
+
+    UARTStats uart = getUARTStats();
+    snapshot.uartFramesPerS = perSecond(uart.framesParsed - lastFrames, elapsedMs);
+    lastFrames = uart.framesParsed;
+    snapshot.uartErrors = uart.crcErrors + uart.frameErrors + uart.fifoOverflows + uart.bufferFullEvents +
+                          uart.resyncs;
+    snapshot.uartLost = uart.pointsLost + uart.pointsDropped;
+    snapshot.batchesQueued = getPendingBatchCount();
+    snapshot.commandsQueued = getPendingCommandCount();
+
+    size_t txFree = getBLETxFree();
+    snapshot.bleTxQueued = txFree < BLE_TX_BUFFER_BYTES ? BLE_TX_BUFFER_BYTES - txFree : 0;
+    uint32_t bleBytes = notifyBytes != nullptr ? notifyBytes->sum() : 0;
+    snapshot.bleBytesPerS = perSecond(bleBytes - lastBLEBytes, elapsedMs);
+    lastBLEBytes = bleBytes;
+    snapshot.bleErrors = notifyErrors != nullptr ? notifyErrors->get() : 0;
+
+    HeapSummary heap;
+    getHeapSummary(heap);
+    snapshot.heapFree = heap.freeBytes;
+    snapshot.heapMin = heap.minFreeBytes;
+    snapshot.heapLargest = heap.largestBlock;
+
+    snapshot.renderUs = renderUs != nullptr ? renderUs->last() : 0;
+    snapshot.renderMaxUs = renderUs != nullptr ? renderUs->maximum() : 0;
+    snapshot.taskCount = sampleTaskCpu(snapshot.tasks, TASK_MONITOR_MAX);
+}
+
+void resetPerfDashboard() {
+    if (renderUs == nullptr) {
+        notifyBytes = findHistogram("ble.notify_bytes");
+        notifyErrors = findCounter("ble.notify_err");
+        renderUs = findHistogram("gui.render_us");
+    }
+    takeSample(true);
+}
+
+void processPerfDashboard() {
+    if (getPerfDashboardWaitMs() == 0) {
+        takeSample(false);
+        requestRender();
+    }
+}
+
+uint32_t getPerfDashboardWaitMs() {
+    if (currentGUIState != GUI_DIAGNOSTICS) {
+        return UINT32_MAX;
+    }
+    uint32_t elapsed = millis() - lastSampleMs;
+    return elapsed >= DIAG_REFRESH_MS ? 0 : DIAG_REFRESH_MS - elapsed;
+}
+
+const PerfSnapshot& getPerfSnapshot() {
+    return snapshot;
+}
@@ -0,0 +1,175 @@
+#include "power_manager.h"
+#include "console.h"
+#include "defines.h"
+#include "UART_Functions.h"
+#include "BLE_Functions.h"
+#include "display_power.h"
+#include "esp_timer.h"
+#if POWER_SAVE
+#include "sdkconfig.h"
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#endif
+
+static const char* const stateNames[POWER_STATE_COUNT] = {
+    "Sweep", "Slow sweep", "Connected", "Adv fast", "Adv slow"
+};
+static const float stateCurrentMA[POWER_STATE_COUNT] = {
+    POWER_SWEEP_MA, POWER_SWEEP_SLOW_MA, POWER_CONNECTED_MA, POWER_ADV_FAST_MA, POWER_ADV_SLOW_MA
+};
+
+// GUI task only
+static PowerState powerState = POWER_STATE_ADV_FAST;
+static int64_t stateSinceUs = 0;
+static int64_t stateTimeUs[POWER_STATE_COUNT] = {0};
+static uint32_t lastActivityMs = 0;
+
+#if POWER_SAVE && CONFIG_PM_ENABLE
+// Held from START to the end of the sweep
+static esp_pm_lock_handle_t sweepClockLock = nullptr;
+static esp_pm_lock_handle_t sweepAwakeLock = nullptr;
+#endif
+
+/*=========================SETUP=========================*/
+void initPowerManagement() {
+    stateSinceUs = esp_timer_get_time();
+    lastActivityMs = millis();
+#if POWER_SAVE
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t config = {};
+    config.max_freq_mhz = POWER_MAX_FREQ_MHZ;
+    config.min_freq_mhz = POWER_MIN_FREQ_MHZ;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    config.light_sleep_enable = true;
+#endif
+    esp_err_t err = esp_pm_configure(&config);
+    if (err != ESP_OK) {
+        Console.printf("[PWR] esp_pm_configure failed: %s\n", esp_err_to_name(err));
+        return;
+    }
+    if (esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "sweep_clk", &sweepClockLock) != ESP_OK ||
+        esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "sweep_awake", &sweepAwakeLock) != ESP_OK) {
+        Console.println("[PWR] WARNING: Failed to create sweep PM locks");
+    }
+
+    // STM32 bytes on any link and the buttons (button_handler.cpp) end light sleep
+    for (int link = 0; link < UART_LINK_COUNT; link++) {
+        uart_set_wakeup_threshold(getUARTLinkPort(link), POWER_UART_WAKE_EDGES);
+        esp_sleep_enable_uart_wakeup(getUARTLinkPort(link));
+    }
+    esp_sleep_enable_gpio_wakeup();
+
+    Console.printf("[PWR] DFS %d-%d MHz, light sleep %s\n", POWER_MIN_FREQ_MHZ, POWER_MAX_FREQ_MHZ,
+                  config.light_sleep_enable ? "on" : "off (no tickless idle)");
+#else
+    Console.println("[PWR] POWER_SAVE needs CONFIG_PM_ENABLE - running at full clock");
+#endif
+#endif
+}
+
+/*=========================STATE TRACKING=========================*/
+static bool isSweepState(PowerState state) {
+    return state == POWER_STATE_SWEEP || state == POWER_STATE_SWEEP_SLOW;
+}
+
+static void setPowerState(PowerState next) {
+    int64_t now = esp_timer_get_time();
+    stateTimeUs[powerState] += now - stateSinceUs;
+    stateSinceUs = now;
+
+#if POWER_SAVE && CONFIG_PM_ENABLE
+    // No light sleep while the STM32 streams points, full clock unless the
+    // link is slow enough for the DFS minimum
+    if (sweepClockLock != nullptr && sweepAwakeLock != nullptr) {
+        bool wasClock = powerState == POWER_STATE_SWEEP;
+        bool isClock = next == POWER_STATE_SWEEP;
+        if (isSweepState(next) && !isSweepState(powerState)) {
+            esp_pm_lock_acquire(sweepAwakeLock);
+        }
+        if (isClock != wasClock) {
+            if (isClock) {
+                esp_pm_lock_acquire(sweepClockLock);
+            } else {
+                esp_pm_lock_release(sweepClockLock);
+            }
+        }
+        if (!isSweepState(next) && isSweepState(powerState)) {
+            esp_pm_lock_release(sweepAwakeLock);
+        }
+    }
+#endif
+    powerState = next;
+}
+
+static bool isSweepActive() {
+    return measurementInProgress || isSweepStartPending();
+}
+
+void processPowerManagement() {
+    bool sweeping = isSweepActive();
+    if (sweeping) {
+        lastActivityMs = millis();
+    }
+
+    // Discovery is fast until nothing has happened for a while
+    bool slow = millis() - lastActivityMs >= POWER_ADV_SLOW_AFTER_MS;
+    if (slow != isBLEAdvertisingSlow()) {
+        setBLEAdvertisingSlow(slow);
+    }
+
+    PowerState next;
+    if (sweeping) {
+        next = getCurrentBaudRate() <= POWER_SLOW_LINK_BAUD ? POWER_STATE_SWEEP_SLOW : POWER_STATE_SWEEP;
+    } else if (getBLEClientCount() > 0) {
+        next = POWER_STATE_CONNECTED;
+    } else {
+        next = slow ? POWER_STATE_ADV_SLOW : POWER_STATE_ADV_FAST;
+    }
+    if (next != powerState) {
+        setPowerState(next);
+    }
+}
+
+void notePowerActivity() {
+    lastActivityMs = millis();
+}
+
+uint32_t getPowerWaitMs() {
+    if (isSweepActive() || isBLEAdvertisingSlow()) {
+        return UINT32_MAX;
+    }
+    uint32_t elapsed = millis() - lastActivityMs;
+    return elapsed >= POWER_ADV_SLOW_AFTER_MS ? 0 : POWER_ADV_SLOW_AFTER_MS - elapsed;
+}
+
+PowerState getPowerState() {
+    return powerState;
+}
+
+/*=========================REPORT=========================*/
+void printPowerReport() {
+    int64_t times[POWER_STATE_COUNT];
+    int64_t total = 0;
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        times[i] = stateTimeUs[i];
+        if (i == powerState) {
+            times[i] += esp_timer_get_time() - stateSinceUs;
+        }
+        total += times[i];
+    }
+
+    Console.printf("\n=== Power (%s, %s advertising) ===\n",
+                  POWER_SAVE ? "POWER_SAVE" : "full clock", isBLEAdvertisingSlow() ? "slow" : "fast");
+    float chargeMAs = 0;
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        float seconds = times[i] / 1e6f;
+        chargeMAs += seconds * stateCurrentMA[i];
+        Console.printf("%-10s %c %9.1f s  %5.1f%%  ~%5.1f mA\n", stateNames[i], i == powerState ? '*' : ' ',
+                      seconds, total > 0 ? times[i] * 100.0f / total : 0.0f, stateCurrentMA[i]);
+    }
+    if (total > 0) {
+        Console.printf("Average    ~%.2f mA (estimated from the per-state figures)\n", chargeMAs / (total / 1e6f));
+    }
+    printDisplayPowerReport();
+    Console.println("========================\n");
+}
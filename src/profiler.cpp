@@ -0,0 +1,140 @@
+#include "profiler.h"
+#include "console.h"
+#include "driver/gptimer.h"
+#include <atomic>
+
+#if PROFILER
+
+#define PROFILER_TIMER_HZ   1000000     // 1 us alarm resolution
+
+// Allocated on the first start and kept - stopping does not wait for the ISR
+static ProfileSample* ring = nullptr;
+static gptimer_handle_t timer = nullptr;
+static bool running = false;
+static uint32_t rateHz = 0;
+
+// ISR is the only writer - samples taken since the last start (ring index = head % size)
+static std::atomic<uint32_t> head{0};
+
+static inline uint32_t interruptedPC() {
+#if defined(__riscv)
+    // Saved by the interrupt entry and restored before mret - still the
+    // interrupted PC inside this handler
+    uint32_t pc;
+    asm volatile("csrr %0, mepc" : "=r"(pc));
+    return pc;
+#else
+    return 0;
+#endif
+}
+
+static bool onSample(gptimer_handle_t, const gptimer_alarm_event_data_t*, void*) {
+    uint32_t index = head.load(std::memory_order_relaxed);
+    ProfileSample& sample = ring[index & (PROFILER_RING_SIZE - 1)];
+    sample.pc = interruptedPC();
+    sample.task = (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+    head.store(index + 1, std::memory_order_release);
+    return false;
+}
+
+static bool initTimer() {
+    gptimer_config_t config = {};
+    config.clk_src = GPTIMER_CLK_SRC_DEFAULT;
+    config.direction = GPTIMER_COUNT_UP;
+    config.resolution_hz = PROFILER_TIMER_HZ;
+    if (gptimer_new_timer(&config, &timer) != ESP_OK) {
+        timer = nullptr;
+        return false;
+    }
+    gptimer_event_callbacks_t callbacks = {};
+    callbacks.on_alarm = onSample;
+    return gptimer_register_event_callbacks(timer, &callbacks, nullptr) == ESP_OK;
+}
+
+bool startProfiler(uint32_t hz) {
+    if (hz == 0 || hz > PROFILER_MAX_HZ) {
+        return false;
+    }
+    stopProfiler();
+    if (ring == nullptr) {
+        ring = (ProfileSample*)malloc(PROFILER_RING_SIZE * sizeof(ProfileSample));
+        if (ring == nullptr) {
+            Console.println("[PROF] Out of memory");
+            return false;
+        }
+    }
+    if (timer == nullptr && !initTimer()) {
+        Console.println("[PROF] No free timer");
+        return false;
+    }
+
+    gptimer_alarm_config_t alarm = {};
+    alarm.alarm_count = PROFILER_TIMER_HZ / hz;
+    alarm.reload_count = 0;
+    alarm.flags.auto_reload_on_alarm = true;
+    head.store(0, std::memory_order_release);
+    gptimer_set_raw_count(timer, 0);
+    if (gptimer_set_alarm_action(timer, &alarm) != ESP_OK || gptimer_enable(timer) != ESP_OK) {
+        return false;
+    }
+    gptimer_start(timer);
+    running = true;
+    rateHz = hz;
+    return true;
+}
+
+void stopProfiler() {
+    if (!running) {
+        return;
+    }
+    gptimer_stop(timer);
+    gptimer_disable(timer);
+    running = false;
+}
+
+void printProfilerStatus() {
+    uint32_t taken = head.load(std::memory_order_acquire);
+    Console.printf("Profiler: %s at %lu Hz, %lu of %d samples (%lu taken)\n", running ? "running" : "stopped",
+                   rateHz, min(taken, (uint32_t)PROFILER_RING_SIZE), PROFILER_RING_SIZE, taken);
+}
+
+void dumpProfiler() {
+    // Snapshot the head - samples taken during the dump may be mixed in
+    uint32_t last = head.load(std::memory_order_acquire);
+    uint32_t count = ring != nullptr ? min(last, (uint32_t)PROFILER_RING_SIZE) : 0;
+    uint32_t first = last - count;
+
+    Console.printf("PROF_BEGIN %d %lu %d %lu\n", PROFILER_FORMAT_VER, count, (int)sizeof(ProfileSample), rateHz);
+    for (uint32_t i = 0; i < count; i++) {
+        const ProfileSample& sample = ring[(first + i) & (PROFILER_RING_SIZE - 1)];
+        consoleWriteWait((const uint8_t*)&sample, sizeof(sample));
+    }
+    Console.println();
+
+    // Task names for the handles - deleted tasks (boot tasks) stay unnamed
+    static TaskStatus_t tasks[24];
+    UBaseType_t taskCount = uxTaskGetSystemState(tasks, sizeof(tasks) / sizeof(tasks[0]), nullptr);
+    for (UBaseType_t i = 0; i < taskCount; i++) {
+        Console.printf("PROF_TASK %08lX %s\n", (unsigned long)(uintptr_t)tasks[i].xHandle, tasks[i].pcTaskName);
+    }
+    Console.println("PROF_END");
+}
+
+#else
+
+bool startProfiler(uint32_t hz) {
+    Console.println("[PROF] Not in this build (PROFILER=0)");
+    return false;
+}
+
+void stopProfiler() {}
+
+void printProfilerStatus() {
+    Console.println("Profiler: not in this build");
+}
+
+void dumpProfiler() {
+    Console.printf("PROF_BEGIN %d 0 %d 0\n\nPROF_END\n", PROFILER_FORMAT_VER, (int)sizeof(ProfileSample));
+}
+
+#endif
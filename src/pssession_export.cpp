@@ -0,0 +1,267 @@
+#include "pssession_export.h"
+#include "defines.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "session_log.h"
+#include "fixed_format.h"
+#include <math.h>
+#include <stdarg.h>
+
+// Seconds from 0001-01-01 (.NET DateTime ticks) to the Unix epoch
+#define PSSESSION_EPOCH_OFFSET_S    62135596800ULL
+#define PSSESSION_TICKS_PER_S       10000000ULL
+
+#define PS_UNIT_CURRENT "{\"type\":\"PalmSens.Units.MicroAmpere\",\"s\":\"A\",\"q\":\"Current\",\"a\":\"i\"}"
+
+// What a data array holds per point
+enum PsValue : uint8_t {
+    PS_VALUE_ZERO,          // No DC data - PalmSens needs the arrays
+    PS_VALUE_TIME,
+    PS_VALUE_FREQ,
+    PS_VALUE_ZRE,
+    PS_VALUE_ZIM,
+    PS_VALUE_Z,
+    PS_VALUE_PHASE,
+    PS_VALUE_IAC            // uA at PSSESSION_AMPLITUDE_V
+};
+
+struct PsArray {
+    const char* type;       // PalmSens.Data.<type>
+    uint8_t arrayType;
+    const char* description;
+    const char* unit;       // JSON object
+    const char* valueType;  // PalmSens.Data.DataValue.<valueType>
+    const char* extra;      // Fields after "v" in every value
+    PsValue value;
+    uint8_t decimals;
+};
+
+// In the order PSTrace writes them. Symbols are JSON escapes, so the text stays ASCII
+static const PsArray psArrays[] = {
+    {"DataArrayCurrents", 2, "Idc", PS_UNIT_CURRENT, "DataValueCurrentRange", ",\"c\":3,\"s\":0", PS_VALUE_ZERO, 1},
+    {"DataArrayPotentials", 1, "potential",
+     "{\"type\":\"PalmSens.Units.Volt\",\"s\":\"V\",\"q\":\"Potential\",\"a\":\"E\"}",
+     "DataValueGainRange", ",\"s\":0,\"r\":3", PS_VALUE_ZERO, 1},
+    {"DataArrayTime", 0, "time", "{\"type\":\"PalmSens.Units.Time\",\"s\":\"s\",\"q\":\"Time\",\"a\":\"t\"}",
+     "DataValue", "", PS_VALUE_TIME, 4},
+    {"DataArray", 5, "Frequency", "{\"type\":\"PalmSens.Units.Hertz\",\"s\":\"Hz\",\"q\":\"Frequency\",\"a\":\"f\"}",
+     "DataValue", "", PS_VALUE_FREQ, 0},
+    {"DataArray", 7, "ZRe", "{\"type\":\"PalmSens.Units.ZRe\",\"s\":\"\\u03a9\",\"q\":\"Z'\",\"a\":\"Z\"}",
+     "DataValue", "", PS_VALUE_ZRE, 6},
+    {"DataArray", 8, "ZIm", "{\"type\":\"PalmSens.Units.ZIm\",\"s\":\"\\u03a9\",\"q\":\"-Z''\",\"a\":\"Z\"}",
+     "DataValue", "", PS_VALUE_ZIM, 6},
+    {"DataArray", 10, "Z", "{\"type\":\"PalmSens.Units.Z\",\"s\":\"\\u03a9\",\"q\":\"Z\",\"a\":\"Z\"}",
+     "DataValue", "", PS_VALUE_Z, 6},
+    {"DataArray", 6, "Phase", "{\"type\":\"PalmSens.Units.Phase\",\"s\":\"\\u00b0\",\"q\":\"-Phase\",\"a\":\"Phase\"}",
+     "DataValue", "", PS_VALUE_PHASE, 2},
+    {"DataArrayCurrents", 9, "Iac", PS_UNIT_CURRENT, "DataValueCurrentRange", ",\"c\":3,\"s\":0", PS_VALUE_IAC, 6},
+};
+
+/*=========================OUTPUT BUFFER=========================*/
+// ASCII text is widened to UTF-16LE on the caller's stack and handed to the
+// sink in PSSESSION_CHUNK blocks
+struct PsWriter {
+    PsSessionSink sink;
+    void* context;
+    uint32_t generation;    // Session whose rows are read
+    bool ok;
+    size_t len;
+    uint8_t data[PSSESSION_CHUNK];
+};
+
+static void flush(PsWriter& out) {
+    if (out.ok && out.len > 0) {
+        out.ok = out.sink(out.data, out.len, out.context);
+    }
+    out.len = 0;
+}
+
+static void putUnit(PsWriter& out, uint16_t unit) {
+    if (out.len + 2 > sizeof(out.data)) {
+        flush(out);
+    }
+    out.data[out.len++] = unit & 0xFF;
+    out.data[out.len++] = unit >> 8;
+}
+
+static void put(PsWriter& out, const char* text) {
+    for (; out.ok && *text != '\0'; text++) {
+        putUnit(out, (uint8_t)*text);
+    }
+}
+
+static void putf(PsWriter& out, const char* format, ...) {
+    char text[96];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    put(out, text);
+}
+
+// Without printf's 64-bit support
+static void putTicks(PsWriter& out, uint64_t value) {
+    char text[21];
+    char* p = &text[sizeof(text) - 1];
+    *p = '\0';
+    do {
+        *--p = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    put(out, p);
+}
+
+/*=========================DOCUMENT=========================*/
+
+static const ImpedanceRow& exportRow(bool final, uint8_t dut) {
+    return final ? measurementImpedanceData[dut] : baselineImpedanceData[dut];
+}
+
+static int exportCount(bool final, uint8_t dut) {
+    return exportRow(final, dut).mag == nullptr ? 0 : min(getRowPointCount(!final, dut), (int)getPointsPerDUT());
+}
+
+static bool isExportPoint(const ImpedanceRow& row, int i) {
+    return isStoredPointValid(row, i) && storedFrequency(row.freqCode[i]) > 0;
+}
+
+static int countValidPoints(bool final, uint8_t dut) {
+    const ImpedanceRow& row = exportRow(final, dut);
+    int valid = 0;
+    for (int i = 0; i < exportCount(final, dut); i++) {
+        valid += isExportPoint(row, i) ? 1 : 0;
+    }
+    return valid;
+}
+
+static float pointValue(const PsArray& array, uint32_t freq, const ImpedancePoint& point) {
+    float rad = point.Z_phase * (float)M_PI / 180.0f;
+    switch (array.value) {
+        case PS_VALUE_TIME:  return 0.0001f;
+        case PS_VALUE_FREQ:  return (float)freq;
+        case PS_VALUE_ZRE:   return point.Z_magnitude * cosf(rad);
+        case PS_VALUE_ZIM:   return point.Z_magnitude * sinf(rad);
+        case PS_VALUE_Z:     return point.Z_magnitude;
+        case PS_VALUE_PHASE: return point.Z_phase;
+        case PS_VALUE_IAC:   return point.Z_magnitude > 0.0f ? PSSESSION_AMPLITUDE_V / point.Z_magnitude * 1e6f : 0.0f;
+        default:             return 0.0f;
+    }
+}
+
+// PSTrace method text as a JSON string - the frequency range of the exported points
+static void putMethod(PsWriter& out, bool final) {
+    uint32_t lo = UINT32_MAX;
+    uint32_t hi = 0;
+    SweepMask swept = 0;
+    int offGrid = 0;
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        const ImpedanceRow& row = exportRow(final, dut);
+        for (int i = 0; i < exportCount(final, dut); i++) {
+            if (!isExportPoint(row, i)) {
+                continue;
+            }
+            uint32_t freq = storedFrequency(row.freqCode[i]);
+            lo = min(lo, freq);
+            hi = max(hi, freq);
+            uint8_t idx = storedFreqIndex(row.freqCode[i]);
+            if (idx < SWEEP_FREQ_COUNT) {
+                swept |= (SweepMask)1 << idx;
+            } else {
+                offGrid++;
+            }
+        }
+    }
+    put(out, "\"#PSTrace, Version=" PSSESSION_CORE_VERSION "\\n#BioPal ESP32 Impedance Analyzer\\n"
+             "#METHOD_VERSION=1\\n#TECHNIQUE=14\\n#NOTES=BioPal ESP32 Measurement\\n#Frequency range\\n");
+    putf(out, "FREQ_START=%.3E\\nFREQ_END=%.3E\\nNUM_FREQS=%d\\nAMPLITUDE=%.3E\\n\"",
+         (double)lo, (double)hi, __builtin_popcountll(swept) + offGrid, (double)PSSESSION_AMPLITUDE_V);
+}
+
+static void putArray(PsWriter& out, const PsArray& array, const ImpedanceRow& row, int count) {
+    putf(out, "{\"type\":\"PalmSens.Data.%s\",\"arraytype\":%u,\"description\":\"%s\",\"unit\":",
+         array.type, array.arrayType, array.description);
+    put(out, array.unit);
+    put(out, ",\"datavalues\":[");
+    bool first = true;
+    for (int i = 0; i < count && out.ok; i++) {
+        if (!isExportPoint(row, i)) {
+            continue;
+        }
+        ImpedancePoint point = loadImpedancePoint(row, i);
+        char text[FIXED_FORMAT_BUFFER];
+        put(out, first ? "{\"v\":" : ",{\"v\":");
+        put(out, fixedText(text, pointValue(array, storedFrequency(row.freqCode[i]), point), array.decimals));
+        put(out, array.extra);
+        put(out, "}");
+        first = false;
+    }
+    putf(out, "],\"datavaluetype\":\"PalmSens.Data.DataValue.%s\"}", array.valueType);
+}
+
+static void putMeasurement(PsWriter& out, bool final, uint8_t dut, uint64_t ticks) {
+    const ImpedanceRow& row = exportRow(final, dut);
+    int count = exportCount(final, dut);
+
+    putf(out, "{\"title\":\"DUT %d %s\",\"timestamp\":", dut + 1, final ? "final" : "baseline");
+    putTicks(out, ticks);
+    put(out, ",\"utctimestamp\":");
+    putTicks(out, ticks);
+    put(out, ",\"deviceused\":0,\"deviceserial\":\"BioPal-ESP32\",\"devicefw\":\"1.0\",\"type\":\".\","
+             "\"dataset\":{\"type\":\"PalmSens.Data.DataSetEIS\",\"values\":[");
+    for (size_t a = 0; a < sizeof(psArrays) / sizeof(psArrays[0]); a++) {
+        if (a > 0) {
+            put(out, ",");
+        }
+        putArray(out, psArrays[a], row, count);
+    }
+    put(out, "]},\"method\":");
+    putMethod(out, final);
+    put(out, ",\"curves\":[],\"eisdatalist\":[]}");
+}
+
+bool hasPsSessionData(bool final) {
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        if (countValidPoints(final, dut) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool writePsSession(bool final, PsSessionSink sink, void* context) {
+    PsWriter out;
+    out.sink = sink;
+    out.context = context;
+    out.generation = getMeasurementGeneration();
+    out.ok = true;
+    out.len = 0;
+    if (!hasPsSessionData(final)) {
+        return false;
+    }
+
+    uint64_t ticks = ((uint64_t)getSessionTime() + PSSESSION_EPOCH_OFFSET_S) * PSSESSION_TICKS_PER_S;
+    putUnit(out, 0xFEFF);
+    put(out, "{\"type\":\"PalmSens.DataFiles.SessionFile\",\"coreversion\":\"" PSSESSION_CORE_VERSION "\","
+             "\"methodformeasurement\":");
+    putMethod(out, final);
+    put(out, ",\"measurements\":[");
+    bool first = true;
+    for (uint8_t dut = 0; dut < getDUTCount() && out.ok; dut++) {
+        if (countValidPoints(final, dut) == 0) {
+            continue;
+        }
+        if (!first) {
+            put(out, ",");
+        }
+        putMeasurement(out, final, dut, ticks);
+        first = false;
+        // A new session may have cleared the rows being read
+        if (getMeasurementGeneration() != out.generation) {
+            out.ok = false;
+        }
+    }
+    put(out, "]}");
+    putUnit(out, 0xFEFF);
+    flush(out);
+    return out.ok;
+}
@@ -0,0 +1,221 @@
+#include "raw_capture.h"
+#include "console.h"
+#include "crc.h"
+#include "calibration.h"
+#include "fixed_cal.h"
+#include "impedance_calc.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "repeat_filter.h"
+#include <atomic>
+
+// Allocated on the first "raw on" and kept - the data processor may still be
+// filing a batch when capture is turned off
+static RawCaptureRecord* ring = nullptr;
+static std::atomic<bool> active{false};
+
+// Data processor is the only writer - total records written since the last
+// clear (ring index = head % size)
+static std::atomic<uint32_t> head{0};
+
+// Data processor only - the newest session of each kind in the ring, baseline
+// [0] and final [1]: its generation and the head at its first record
+static uint32_t sessionGeneration[2] = {0, 0};
+static uint32_t sessionStart[2] = {0, 0};
+
+bool setRawCapture(bool on) {
+    if (on && ring == nullptr) {
+        ring = (RawCaptureRecord*)malloc(RAW_CAPTURE_RING_SIZE * sizeof(RawCaptureRecord));
+        if (ring == nullptr) {
+            Console.println("[RAW] Out of memory");
+            return false;
+        }
+    }
+    active.store(on, std::memory_order_release);
+    return true;
+}
+
+bool isRawCaptureActive() {
+    return active.load(std::memory_order_acquire);
+}
+
+void captureRawPoint(uint8_t dut, bool final, const MeasurementPoint& point) {
+    uint32_t index = head.load(std::memory_order_relaxed);
+    // The batch's session was synced before it got here (meas_session.h)
+    uint32_t generation = getRowGeneration(!final);
+    if (generation != sessionGeneration[final]) {
+        sessionGeneration[final] = generation;
+        sessionStart[final] = index;
+    }
+    RawCaptureRecord& record = ring[index & (RAW_CAPTURE_RING_SIZE - 1)];
+    record.freqHz = point.freq_hz;
+    record.vMagnitude = point.V_magnitude;
+    record.iMagnitude = point.I_magnitude;
+    record.phaseDeg = point.phase_deg;
+    record.dut = dut;
+    record.flags = (point.pga_gain & IMPEDANCE_FLAG_PGA_MASK) |
+                   (point.tia_gain ? IMPEDANCE_FLAG_TIA_HIGH : 0) |
+                   (point.valid ? IMPEDANCE_FLAG_VALID : 0);
+    record.freqIdx = point.freq_idx;
+    record.sweep = final ? 1 : 0;
+    head.store(index + 1, std::memory_order_release);
+}
+
+uint32_t getRawCaptureCount() {
+    return min(head.load(std::memory_order_acquire), (uint32_t)RAW_CAPTURE_RING_SIZE);
+}
+
+uint32_t getRawCaptureTotal() {
+    return head.load(std::memory_order_acquire);
+}
+
+void clearRawCapture() {
+    head.store(0, std::memory_order_release);
+    // No session has generation 0 - the next record starts one
+    sessionGeneration[0] = 0;
+    sessionGeneration[1] = 0;
+}
+
+void dumpRawCapture() {
+    // Snapshot the head - records written during the dump may be mixed in
+    uint32_t last = head.load(std::memory_order_acquire);
+    uint32_t count = ring != nullptr ? min(last, (uint32_t)RAW_CAPTURE_RING_SIZE) : 0;
+    uint32_t first = last - count;
+
+    Console.printf("RAW_BEGIN %d %lu %d\n", RAW_CAPTURE_FORMAT_VER, count, (int)sizeof(RawCaptureRecord));
+    uint16_t crc = CRC16_CCITT_INIT;
+    for (uint32_t i = 0; i < count; i++) {
+        const RawCaptureRecord& record = ring[(first + i) & (RAW_CAPTURE_RING_SIZE - 1)];
+        consoleWriteWait((const uint8_t*)&record, sizeof(record));
+        crc = crc16_ccitt((const uint8_t*)&record, sizeof(record), crc);
+    }
+    Console.println();
+    Console.printf("RAW_END %04X\n", crc);
+}
+
+/*=========================RECALIBRATION=========================*/
+
+// The record through the data processor's pipeline
+static bool calibrateRecord(const RawCaptureRecord& record, ImpedancePoint& impedance) {
+    MeasurementPoint point;
+    point.freq_hz = record.freqHz;
+    point.V_magnitude = record.vMagnitude;
+    point.I_magnitude = record.iMagnitude;
+    point.phase_deg = record.phaseDeg;
+    point.pga_gain = record.flags & IMPEDANCE_FLAG_PGA_MASK;
+    point.tia_gain = (record.flags & IMPEDANCE_FLAG_TIA_HIGH) != 0;
+    point.valid = (record.flags & IMPEDANCE_FLAG_VALID) != 0;
+    point.freq_idx = record.freqIdx;
+#if CAL_FIXED_POINT
+    return calcCalibratedImpedanceFixed(point, impedance);
+#else
+    impedance = calcImpedance(point);
+    bool calibrated = calibrate(impedance);
+#if IMPEDANCE_RECTANGULAR
+    impedanceToPolar(impedance);
+#endif
+    return calibrated;
+#endif
+}
+
+// Rows are laid out by the indices the session captured, in sweep order
+static void storeRecalPoint(const ImpedanceRow& row, SweepMask captured, const ImpedancePoint& point,
+                            const PointNoise& noise, RawRecalResult& result) {
+    SweepMask bit = (SweepMask)1 << point.freq_idx;
+    int slot = __builtin_popcountll(captured & (bit - 1));
+    if (slot < getPointsPerDUT()) {
+        storeImpedancePoint(row, slot, point, noise);
+        result.points++;
+    }
+}
+
+static void recalibrateSession(bool final, uint32_t freqStartHz, uint32_t freqEndHz, RawRecalResult& result) {
+    uint32_t last = head.load(std::memory_order_acquire);
+    uint32_t first = last - min(last, (uint32_t)RAW_CAPTURE_RING_SIZE);
+    if ((int32_t)(sessionStart[final] - first) < 0) {
+        result.truncated = true;
+    } else {
+        first = sessionStart[final];
+    }
+
+    // Sweep indices of each DUT in the session
+    SweepMask captured[MAX_DUT_COUNT] = {};
+    for (uint32_t i = first; i != last; i++) {
+        const RawCaptureRecord& record = ring[i & (RAW_CAPTURE_RING_SIZE - 1)];
+        uint8_t dut = record.dut - 1;
+        if (record.sweep == (final ? 1 : 0) && dut < getDUTCount() && record.freqIdx < SWEEP_FREQ_COUNT) {
+            captured[dut] |= (SweepMask)1 << record.freqIdx;
+        }
+    }
+    const ImpedanceRow* rows = final ? measurementImpedanceData : baselineImpedanceData;
+
+    resetRepeatFilter();
+    ImpedancePoint averaged;
+    PointNoise noise;
+    for (uint32_t i = first; i != last; i++) {
+        const RawCaptureRecord& record = ring[i & (RAW_CAPTURE_RING_SIZE - 1)];
+        uint8_t dut = record.dut - 1;
+        if (record.sweep != (final ? 1 : 0) || dut >= getDUTCount() || record.freqIdx >= SWEEP_FREQ_COUNT) {
+            continue;
+        }
+        ImpedancePoint impedance;
+        if (!calibrateRecord(record, impedance)) {
+            result.uncalibrated++;
+        }
+        if (addRepeatSample(dut, impedance, averaged, noise)) {
+            storeRecalPoint(rows[dut], captured[dut], averaged, noise, result);
+        }
+    }
+
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        if (captured[dut] == 0) {
+            continue;
+        }
+        if (flushRepeatSample(dut, averaged, noise)) {
+            storeRecalPoint(rows[dut], captured[dut], averaged, noise, result);
+        }
+        int end = min(__builtin_popcountll(captured[dut]), (int)getPointsPerDUT());
+        publishRecalibratedRow(!final, dut, end);
+        // What the data processor does with each stored point
+        if (final) {
+            resetRiskAccumulator(dut, freqStartHz, freqEndHz);
+        } else {
+            resetBaselineSlots(dut);
+        }
+        for (int slot = 0; slot < end; slot++) {
+            ImpedancePoint point = loadImpedancePoint(rows[dut], slot);
+            if (final) {
+                accumulateRiskPoint(dut, slot, point);
+            } else {
+                recordBaselinePoint(dut, slot, point);
+            }
+        }
+#if KK_CHECK
+        checkDUTKramersKronig(dut, final);
+#endif
+#if CIRCUIT_FIT
+        fitDUTCircuit(dut, final);
+#endif
+        if (final) {
+            result.finalDuts |= 1 << dut;
+        } else {
+            result.baselineDuts |= 1 << dut;
+        }
+    }
+}
+
+RawRecalResult recalibrateRawCapture(uint32_t freqStartHz, uint32_t freqEndHz) {
+    RawRecalResult result = {};
+    if (ring == nullptr) {
+        return result;
+    }
+    // A session whose rows a newer one took over is left alone
+    if (sessionGeneration[0] != 0 && sessionGeneration[0] == getRowGeneration(true)) {
+        recalibrateSession(false, freqStartHz, freqEndHz, result);
+    }
+    if (sessionGeneration[1] != 0 && sessionGeneration[1] == getRowGeneration(false) &&
+        isFinalGeneration(sessionGeneration[1])) {
+        recalibrateSession(true, freqStartHz, freqEndHz, result);
+    }
+    return result;
+}
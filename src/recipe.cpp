@@ -0,0 +1,360 @@
+#include "recipe.h"
+#include "console.h"
+#include "defines.h"
+#include "BLE_Functions.h"
+#include "meas_store.h"
+#include "meas_control.h"
+#include "monitor.h"
+#include "usb_export.h"
+#include "storage.h"
+#include "crc.h"
+#include <LittleFS.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+static_assert(sizeof(RecipeFile) <= STORAGE_ITEM_MAX, "RecipeFile must fit one storage operation");
+
+// Sweep selection of a B step (main.cpp)
+extern SweepMask customSweepMask;
+
+// GUI task only
+static RecipeFile store = {RECIPE_MAGIC, RECIPE_VERSION, 0, {}, 0};
+
+// Run state
+static bool running = false;
+static uint8_t pc = 0;                      // Step due next
+static bool awaitingSweep = false;          // pc's sweep started, its completion not delivered yet
+static uint32_t stepStartMs = 0;            // End of the step before - W counts from here
+static uint16_t loopLeft[RECIPE_MAX_STEPS]; // L: jumps back still to take
+static uint32_t stepsRun = 0;
+
+static uint16_t storeCrc() {
+    return crc16_ccitt((const uint8_t*)&store, offsetof(RecipeFile, crc));
+}
+
+/*=========================FILE=========================*/
+
+void loadRecipe() {
+    if (!isStorageMounted() || !LittleFS.exists(RECIPE_FILE)) {
+        return;
+    }
+    fs::File file = LittleFS.open(RECIPE_FILE, "r");
+    if (!file) {
+        return;
+    }
+    static RecipeFile loaded;           // Boot task only
+    bool ok = file.read((uint8_t*)&loaded, sizeof(loaded)) == sizeof(loaded);
+    file.close();
+    ok = ok && loaded.magic == RECIPE_MAGIC && loaded.version == RECIPE_VERSION &&
+         loaded.count <= RECIPE_MAX_STEPS &&
+         loaded.crc == crc16_ccitt((const uint8_t*)&loaded, offsetof(RecipeFile, crc));
+    if (!ok) {
+        Console.println("WARNING: Stored recipe invalid - discarded");
+        LittleFS.remove(RECIPE_FILE);
+        return;
+    }
+    store = loaded;
+    Console.printf("Recipe loaded (%d steps)\n", store.count);
+}
+
+/*=========================STEPS=========================*/
+
+// One step of the text, [text, end)
+static bool parseStep(const char* text, const char* end, uint8_t index, RecipeStep& step) {
+    memset(&step, 0, sizeof(step));
+    size_t len = end - text;
+    char* stop;
+    if (len == 0) {
+        return false;
+    }
+    switch (toupper((unsigned char)text[0])) {
+        case 'B':
+            step.op = RECIPE_OP_BASELINE;
+            if (len == 1) {
+                return true;
+            }
+            step.value = strtoul(text + 1, &stop, 10);
+            return stop == end && step.value >= 1 && step.value <= MAX_DUT_COUNT;
+        case 'P':
+            step.op = RECIPE_OP_PRESET;
+            if (len < 2 || len - 1 >= SWEEP_PRESET_NAME_MAX) {
+                return false;
+            }
+            memcpy(step.preset, text + 1, len - 1);
+            step.preset[len - 1] = '\0';
+            return true;
+        case 'M':
+            step.op = RECIPE_OP_MEASURE;
+            return len == 1;
+        case 'E':
+            step.op = RECIPE_OP_EXPORT;
+            return len == 1;
+        case 'W':
+            step.op = RECIPE_OP_WAIT;
+            step.value = strtoul(text + 1, &stop, 10);
+            return stop == end && step.value >= 1 && step.value <= RECIPE_WAIT_MAX_S;
+        case 'L': {
+            step.op = RECIPE_OP_LOOP;
+            uint32_t first = strtoul(text + 1, &stop, 10);
+            if (stop == text + 1 || (*stop != 'x' && *stop != 'X')) {
+                return false;
+            }
+            uint32_t count = strtoul(stop + 1, &stop, 10);
+            // Back to an earlier step only
+            if (stop != end || first < 1 || first > index || count < 1 || count > RECIPE_LOOP_MAX) {
+                return false;
+            }
+            step.value = first - 1;
+            step.count = count;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+RecipeError saveRecipe(const char* text, uint8_t* errorStep) {
+    if (running) {
+        return RECIPE_BUSY;
+    }
+    RecipeFile parsed = {RECIPE_MAGIC, RECIPE_VERSION, 0, {}, 0};
+    const char* p = text;
+    while (*p != '\0') {
+        const char* end = strchr(p, ',');
+        if (end == nullptr) {
+            end = p + strlen(p);
+        }
+        if (parsed.count >= RECIPE_MAX_STEPS) {
+            return RECIPE_TOO_LONG;
+        }
+        if (!parseStep(p, end, parsed.count, parsed.steps[parsed.count])) {
+            if (errorStep != nullptr) {
+                *errorStep = parsed.count + 1;
+            }
+            return RECIPE_SYNTAX;
+        }
+        parsed.count++;
+        p = *end == ',' ? end + 1 : end;
+    }
+    if (parsed.count == 0) {
+        return RECIPE_EMPTY;
+    }
+    store = parsed;
+    store.crc = storeCrc();
+    if (!isStorageMounted() || !queueStorageWrite(RECIPE_FILE, &store, sizeof(store))) {
+        return RECIPE_STORAGE;
+    }
+    return RECIPE_OK;
+}
+
+static int formatStep(char* out, size_t size, const RecipeStep& step) {
+    switch (step.op) {
+        case RECIPE_OP_BASELINE:
+            return step.value > 0 ? snprintf(out, size, "B%lu", (unsigned long)step.value) : snprintf(out, size, "B");
+        case RECIPE_OP_PRESET:  return snprintf(out, size, "P%s", step.preset);
+        case RECIPE_OP_MEASURE: return snprintf(out, size, "M");
+        case RECIPE_OP_WAIT:    return snprintf(out, size, "W%lu", (unsigned long)step.value);
+        case RECIPE_OP_LOOP:
+            return snprintf(out, size, "L%lux%u", (unsigned long)step.value + 1, step.count);
+        default:                return snprintf(out, size, "E");
+    }
+}
+
+void formatRecipe(char* out, size_t size) {
+    size_t len = 0;
+    out[0] = '\0';
+    for (uint8_t i = 0; i < store.count && len + 1 < size; i++) {
+        if (i > 0) {
+            out[len++] = ',';
+            out[len] = '\0';
+        }
+        int n = formatStep(out + len, size - len, store.steps[i]);
+        len = min(len + (n > 0 ? (size_t)n : 0), size - 1);
+    }
+}
+
+/*=========================RUN=========================*/
+
+static void endRecipe(const char* reason) {
+    if (!running) {
+        return;
+    }
+    running = false;
+    awaitingSweep = false;
+    Console.printf("@EVT recipe_end %lu %s\n", (unsigned long)stepsRun, reason);
+}
+
+// A sweep step was refused or did not start
+static void failRecipe(const char* reason, const char* text) {
+    Console.printf("Recipe: step %d - %s\n", pc + 1, text);
+    sendBLEError(text);
+    endRecipe(reason);
+}
+
+RecipeError runRecipe() {
+    if (store.count == 0) {
+        return RECIPE_EMPTY;
+    }
+    if (running || isMonitorActive() || getMeasurementState() != MEAS_IDLE) {
+        return RECIPE_BUSY;
+    }
+    for (uint8_t i = 0; i < store.count; i++) {
+        loopLeft[i] = store.steps[i].count > 0 ? store.steps[i].count - 1 : 0;
+    }
+    pc = 0;
+    stepsRun = 0;
+    awaitingSweep = false;
+    stepStartMs = millis();
+    running = true;
+    return RECIPE_OK;
+}
+
+void abortRecipe(const char* reason) {
+    endRecipe(reason);
+}
+
+bool isRecipeRunning() {
+    return running;
+}
+
+// START of a sweep step answered (GUI task)
+static void onRecipeStart(uint8_t cmd_type, bool success, void* context) {
+    if (running && awaitingSweep && !success) {
+        failRecipe("start_failed", "Recipe stopped - sweep did not start");
+    }
+}
+
+// Step done: the next one is due from now
+static void advance(uint8_t next) {
+    pc = next;
+    stepStartMs = millis();
+}
+
+// Start pc's sweep - false if it was refused (the recipe ended)
+static bool startSweepStep(const RecipeStep& step) {
+    MeasRequestError error;
+    if (step.op == RECIPE_OP_PRESET) {
+        const SweepPreset* preset = findSweepPreset(step.preset);
+        if (preset == nullptr) {
+            failRecipe("no_preset", sweepPresetErrorText(SWEEP_PRESET_NOT_FOUND));
+            return false;
+        }
+        error = startSweepPreset(MEAS_SOURCE_RECIPE, *preset, onRecipeStart);
+    } else if (step.op == RECIPE_OP_BASELINE) {
+        uint8_t duts = step.value > 0 ? step.value : getDUTCount();
+        if (duts > getDUTCount()) {
+            failRecipe("invalid", measRequestErrorText(MEAS_REQUEST_INVALID));
+            return false;
+        }
+        SweepPlan plan = {duts, 0, SWEEP_FREQ_COUNT - 1, customSweepMask};
+        error = requestBaselineSweep(MEAS_SOURCE_RECIPE, plan, onRecipeStart);
+    } else {
+        error = requestFinalSweep(MEAS_SOURCE_RECIPE, onRecipeStart);
+    }
+    if (error != MEAS_REQUEST_OK) {
+        failRecipe("refused", measRequestErrorText(error));
+        return false;
+    }
+    awaitingSweep = true;
+    return true;
+}
+
+void processRecipe() {
+    // Steps without a sweep follow at once - a loop of them is bounded by its counts
+    while (running && !awaitingSweep) {
+        if (pc >= store.count) {
+            sendBLEStatus("Recipe Complete");
+            endRecipe("done");
+            return;
+        }
+        const RecipeStep& step = store.steps[pc];
+        if (step.op == RECIPE_OP_WAIT && millis() - stepStartMs < step.value * 1000) {
+            return;
+        }
+
+        char text[24];
+        formatStep(text, sizeof(text), step);
+        Console.printf("@EVT recipe_step %d %s\n", pc + 1, text);
+        stepsRun++;
+        switch (step.op) {
+            case RECIPE_OP_BASELINE:
+            case RECIPE_OP_PRESET:
+            case RECIPE_OP_MEASURE:
+                // Advanced by recipeSweepComplete()
+                if (!startSweepStep(step)) {
+                    return;
+                }
+                break;
+            case RECIPE_OP_LOOP:
+                if (loopLeft[pc] > 0) {
+                    loopLeft[pc]--;
+                    advance(step.value);
+                } else {
+                    // Ready for an outer loop to run it again
+                    loopLeft[pc] = step.count - 1;
+                    advance(pc + 1);
+                }
+                break;
+            case RECIPE_OP_EXPORT:
+                if (!sendPsSessionExport(finalMeasurementDone)) {
+                    Console.println("Recipe: nothing to export");
+                }
+                advance(pc + 1);
+                break;
+            default:
+                advance(pc + 1);
+                break;
+        }
+    }
+}
+
+uint32_t getRecipeWaitMs() {
+    if (!running || awaitingSweep) {
+        return UINT32_MAX;
+    }
+    if (pc >= store.count || store.steps[pc].op != RECIPE_OP_WAIT) {
+        return 0;
+    }
+    uint32_t elapsed = millis() - stepStartMs;
+    uint32_t waitMs = store.steps[pc].value * 1000;
+    return elapsed >= waitMs ? 0 : waitMs - elapsed;
+}
+
+void recipeSweepComplete(bool final) {
+    if (!running || !awaitingSweep || getMeasurementSource() != MEAS_SOURCE_RECIPE) {
+        return;
+    }
+    awaitingSweep = false;
+    advance(pc + 1);
+}
+
+/*=========================STATUS=========================*/
+
+void printRecipe() {
+    if (store.count == 0) {
+        Console.println("Recipe: none stored");
+        return;
+    }
+    char text[RECIPE_MAX_STEPS * 24];
+    formatRecipe(text, sizeof(text));
+    Console.printf("Recipe (%d steps): %s\n", store.count, text);
+    if (running) {
+        Console.printf("Running: step %d of %d%s, %lu steps run\n", pc + 1, store.count,
+                       awaitingSweep ? " (sweeping)" : "", (unsigned long)stepsRun);
+    } else {
+        Console.println("Not running");
+    }
+}
+
+const char* recipeErrorText(RecipeError error) {
+    switch (error) {
+        case RECIPE_OK:        return "OK";
+        case RECIPE_SYNTAX:    return "Invalid recipe step";
+        case RECIPE_EMPTY:     return "No recipe steps";
+        case RECIPE_TOO_LONG:  return "Too many recipe steps";
+        case RECIPE_BUSY:      return "Recipe, monitor or sweep running";
+        case RECIPE_STORAGE:   return "Recipe not saved to flash";
+        default:               return "Unknown error";
+    }
+}
@@ -0,0 +1,417 @@
+// Host render benchmark and golden-image check of the GUI - [env:render]
+// only, the firmware build (ARDUINO) compiles this file to nothing
+//
+// Draws every screen of gui_screens.cpp and bode_plot.cpp through the real
+// sprite bands and frame pushes into the TFT_eSPI host panel model
+// (TFT_eSPI/Processors/TFT_eSPI_Host.h). The session is a fixed fixture: 4
+// DUTs of RC-model impedance, baseline complete, final sweep under way. For
+// each scene it prints the render time, what reached the panel (bytes,
+// memory-write windows, pixels, DMA pushes), the drawing calls made into the
+// sprite and an FNV-1a hash of the visible image
+//
+// The scenes render in order, so the progress and results updates after the
+// first frame of a screen go through the dirty rects as on the device. The
+// golden file holds "scene hash bytes" per line: a changed image or more
+// bytes on the bus for the same image both fail the check
+//
+// Usage: pio run -e render
+//        .pio/build/render/program [--golden render_golden.txt [--update]] [--out dir]
+//   --out writes each scene as dir/<scene>.ppm
+#ifndef ARDUINO
+
+#include "UART_Functions.h"
+#include "console.h"
+#include "gui_screens.h"
+#include "gui_state.h"
+#include "hal.h"
+#include "heap_stats.h"
+#include "meas_control.h"
+#include "meas_session.h"
+#include "meas_store.h"
+#include "monitor.h"
+#include "open_channel.h"
+#include "perf_dashboard.h"
+#include "screen_mirror.h"
+#include "storage.h"
+#include "sweep_eta.h"
+#include <map>
+#include <string>
+
+/*=========================FIRMWARE STUBS=========================*/
+// What the GUI modules read from the rest of the firmware - fixture values
+
+size_t ConsoleOut::write(uint8_t c) {
+    return fputc(c, stderr) == EOF ? 0 : 1;
+}
+
+size_t ConsoleOut::write(const uint8_t* data, size_t len) {
+    return fwrite(data, 1, len, stderr);
+}
+
+ConsoleOut Console;
+
+GUIState currentGUIState = GUI_SPLASH;
+GUISettings guiSettings = {false, 0, SWEEP_FREQ_LAST, 4};
+uint8_t selectedDUTCount = 4;
+uint8_t selectedStartFreq = 0;
+uint8_t selectedEndFreq = SWEEP_FREQ_LAST;
+FreqPickStage freqPickStage = FREQ_PICK_START;
+uint8_t menuSelection = 0;
+bool menuEditMode = false;
+uint8_t currentDUT = 0;
+uint8_t totalDUTs = 4;
+float progressPercent = 0.0f;
+bool dutStatus[MAX_DUT_COUNT];
+bool resultReady[MAX_DUT_COUNT];
+uint8_t overlayDUT = 0;
+
+GUIState getGUIState() {
+    return currentGUIState;
+}
+
+std::atomic<bool> baselineMeasurementDone{false};
+uint8_t startIDX = 0;
+uint8_t endIDX = SWEEP_FREQ_LAST;
+uint8_t num_duts = 4;
+
+RiskLevel riskLevels[MAX_DUT_COUNT];
+float riskPercentages[MAX_DUT_COUNT];
+
+static MeasControlState measState = MEAS_IDLE;
+static uint8_t sweepDUT = 0;        // 1-based, 0 = none
+
+MeasControlState getMeasurementState() { return measState; }
+uint8_t getCurrentDUT() { return sweepDUT; }
+uint32_t estimateSweepRemainingMs(uint8_t dutCount) { return 95000; }
+uint32_t getMonitorSweepCount() { return 12; }
+bool isChannelOpen(uint8_t dut) { return false; }
+bool isScreenMirrorActive() { return false; }
+void mirrorRows(const uint16_t* pixels, int16_t top, int16_t rows, int16_t left, int16_t right) {}
+void endMirrorFrame() {}
+uint16_t* getMirrorRowBuffer() { return nullptr; }
+void printHeapStats() {}
+bool isBLEConnected() { return true; }
+bool isStorageMounted() { return false; }
+bool isHistoryDownloadActive() { return false; }
+void wakeGUITask(uint32_t reason) {}
+
+static PerfSnapshot perfSnapshot = {
+    212, 0, 3, 1, 0, 1536, 6100, 0, 98304, 81920, 65536, 8400, 21300, 7,
+    {{"UART Reader", 9}, {"UART Command", 1}, {"Data Processor", 14}, {"BLE TX", 6},
+     {"GUI", 11}, {"Storage", 0}, {"Console TX", 1}}
+};
+
+const PerfSnapshot& getPerfSnapshot() { return perfSnapshot; }
+
+/*=========================FIXTURE=========================*/
+
+// Series R + C with a parallel tissue-like R||C: |Z| falls with frequency,
+// the phase dips in the mid band. The final sweep shifts each DUT by drift
+static ImpedancePoint modelPoint(uint8_t dut, uint8_t freqIdx, float drift) {
+    const float kPi = 3.14159265f;
+    float w = 2.0f * kPi * sweepFrequencies[freqIdx];
+    float rs = 150.0f + 40.0f * dut;
+    float rp = 2500.0f * (1.0f + drift);
+    float cp = 47e-9f;
+    float cs = 2.2e-6f * (1.0f + 0.2f * dut);
+    // Zp = rp / (1 + j w rp cp)
+    float d = 1.0f + w * w * rp * rp * cp * cp;
+    float re = rs + rp / d;
+    float im = -w * rp * rp * cp / d - 1.0f / (w * cs);
+
+    ImpedancePoint point;
+    point.freq_hz = sweepFrequencies[freqIdx];
+    point.freq_idx = freqIdx;
+    point.Z_magnitude = sqrtf(re * re + im * im);
+    point.Z_phase = atan2f(im, re) * 180.0f / kPi;
+    point.valid = true;
+    return point;
+}
+
+// A session of the whole table, the first points[dut] stored per DUT
+static void fillSession(bool final, const int* points) {
+    beginMeasurementSession(final, getSweepRangeMask(startIDX, endIDX));
+    syncMeasurementSession(getMeasurementGeneration());
+    for (uint8_t dut = 0; dut < totalDUTs; dut++) {
+        ImpedanceRow& row = final ? measurementImpedanceData[dut] : baselineImpedanceData[dut];
+        for (int k = 0; k < points[dut]; k++) {
+            uint8_t freqIdx = getSlotFreqIndex(k);
+            int slot = claimPointSlot(dut, freqIdx);
+            if (slot >= 0) {
+                storeImpedancePoint(row, slot, modelPoint(dut, freqIdx, final ? 0.08f * (dut + 1) : 0.0f));
+            }
+        }
+        publishMeasurementPoints(dut, points[dut]);
+    }
+}
+
+/*=========================SCENES=========================*/
+
+static void setProgress(uint8_t dut, float percent) {
+    currentDUT = dut;
+    progressPercent = percent;
+    for (uint8_t i = 0; i < totalDUTs; i++) {
+        dutStatus[i] = i < dut;
+    }
+}
+
+static void sceneSplash()   { currentGUIState = GUI_SPLASH; }
+static void sceneHome()     { currentGUIState = GUI_HOME; menuSelection = 1; }
+static void sceneSettings() { currentGUIState = GUI_SETTINGS; menuSelection = 0; }
+static void sceneFreq()     { currentGUIState = GUI_FREQ_OVERRIDE; menuSelection = 1; }
+
+static void sceneFreqPicker() {
+    menuEditMode = true;
+    freqPickStage = FREQ_PICK_END;
+    selectedStartFreq = 4;
+    menuSelection = 12;
+}
+
+static void sceneBaseline() {
+    menuEditMode = false;
+    measState = MEAS_SWEEPING;
+    currentGUIState = GUI_BASELINE_PROGRESS;
+    setProgress(1, 30.0f);
+}
+
+static void sceneBaselineStep()  { setProgress(1, 35.0f); }
+static void sceneBaselineNext()  { setProgress(2, 52.0f); }
+
+static void sceneBaselineDone() {
+    const int full[] = {SWEEP_FREQ_COUNT, SWEEP_FREQ_COUNT, SWEEP_FREQ_COUNT, SWEEP_FREQ_COUNT};
+    fillSession(false, full);
+    baselineMeasurementDone = true;
+    measState = MEAS_IDLE;
+    setProgress(4, 100.0f);
+    currentGUIState = GUI_BASELINE_COMPLETE;
+}
+
+static void sceneFinal() {
+    const int partial[] = {SWEEP_FREQ_COUNT, SWEEP_FREQ_COUNT / 2, 0, 0};
+    fillSession(true, partial);
+    measState = MEAS_SWEEPING;
+    sweepDUT = 2;
+    currentGUIState = GUI_FINAL_PROGRESS;
+    setProgress(1, 37.0f);
+}
+
+static void sceneLivePlot() { currentGUIState = GUI_LIVE_PLOT; }
+
+static void sceneResultsFirst() {
+    currentGUIState = GUI_RESULTS;
+    riskLevels[0] = RISK_LOW;
+    riskPercentages[0] = 8.0f;
+    resultReady[0] = true;
+}
+
+static void sceneResultsNext() {
+    riskLevels[1] = RISK_MEDIUM;
+    riskPercentages[1] = 16.0f;
+    resultReady[1] = true;
+}
+
+static void sceneResultsDone() {
+    const int full[] = {SWEEP_FREQ_COUNT, SWEEP_FREQ_COUNT, SWEEP_FREQ_COUNT, SWEEP_FREQ_COUNT};
+    fillSession(true, full);
+    riskLevels[2] = RISK_HIGH;
+    riskPercentages[2] = 24.0f;
+    riskLevels[3] = RISK_NONE;
+    riskPercentages[3] = 3.0f;
+    resultReady[2] = resultReady[3] = true;
+    measState = MEAS_IDLE;
+    sweepDUT = 0;
+}
+
+static void sceneMonitor()  { currentGUIState = GUI_MONITOR; }
+static void sceneOverlay()  { currentGUIState = GUI_OVERLAY; overlayDUT = 0; }
+static void sceneOverlay2() { overlayDUT = 2; }
+static void sceneDiagnostics() { currentGUIState = GUI_DIAGNOSTICS; }
+
+static void sceneDiagnosticsRefresh() {
+    perfSnapshot.uartFramesPerS = 208;
+    perfSnapshot.tasks[2].percent = 15;
+}
+
+struct Scene {
+    const char* name;
+    void (*setup)();
+};
+
+static const Scene scenes[] = {
+    {"splash",              sceneSplash},
+    {"home",                sceneHome},
+    {"settings",            sceneSettings},
+    {"freq_override",       sceneFreq},
+    {"freq_picker",         sceneFreqPicker},
+    {"baseline_progress",   sceneBaseline},
+    {"baseline_step",       sceneBaselineStep},
+    {"baseline_next_dut",   sceneBaselineNext},
+    {"baseline_complete",   sceneBaselineDone},
+    {"final_progress",      sceneFinal},
+    {"live_plot",           sceneLivePlot},
+    {"results_first",       sceneResultsFirst},
+    {"results_next",        sceneResultsNext},
+    {"results_complete",    sceneResultsDone},
+    {"monitor",             sceneMonitor},
+    {"overlay_dut1",        sceneOverlay},
+    {"overlay_dut3",        sceneOverlay2},
+    {"diagnostics",         sceneDiagnostics},
+    {"diagnostics_refresh", sceneDiagnosticsRefresh},
+};
+
+/*=========================PANEL IMAGE=========================*/
+
+static uint32_t hashFrame() {
+    uint32_t hash = 2166136261u;    // FNV-1a, low byte first
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        const uint16_t* row = &tftHostPanel.frame[y * TFT_HOST_SIZE];
+        for (int x = 0; x < SCREEN_WIDTH; x++) {
+            hash = (hash ^ (row[x] & 0xFF)) * 16777619u;
+            hash = (hash ^ (row[x] >> 8)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+static bool writePPM(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        uint8_t rgb[SCREEN_WIDTH * 3];
+        for (int x = 0; x < SCREEN_WIDTH; x++) {
+            uint16_t c = tftHostPanel.frame[y * TFT_HOST_SIZE + x];
+            rgb[x * 3]     = (c >> 11) * 255 / 31;
+            rgb[x * 3 + 1] = ((c >> 5) & 0x3F) * 255 / 63;
+            rgb[x * 3 + 2] = (c & 0x1F) * 255 / 31;
+        }
+        fwrite(rgb, 1, sizeof(rgb), file);
+    }
+    return fclose(file) == 0;
+}
+
+struct GoldenEntry {
+    uint32_t hash;
+    uint32_t bytes;
+};
+
+static bool readGolden(const char* path, std::map<std::string, GoldenEntry>& golden) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), file)) {
+        char name[64];
+        unsigned long hash, bytes;
+        if (line[0] != '#' && sscanf(line, "%63s %lx %lu", name, &hash, &bytes) == 3) {
+            golden[name] = {(uint32_t)hash, (uint32_t)bytes};
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+static const char* primitiveNames[TFT_PRIM_COUNT] = {
+    "pixel", "line", "hline", "vline", "rect", "rrect", "circle", "char", "string", "image"
+};
+
+int main(int argc, char** argv) {
+    const char* goldenPath = nullptr;
+    const char* outDir = nullptr;
+    bool update = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            goldenPath = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--golden file [--update]] [--out dir]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (update && goldenPath == nullptr) {
+        fprintf(stderr, "ERROR: --update needs --golden\n");
+        return 2;
+    }
+
+    std::map<std::string, GoldenEntry> golden;
+    if (goldenPath != nullptr && !update && !readGolden(goldenPath, golden)) {
+        fprintf(stderr, "ERROR: Cannot read %s\n", goldenPath);
+        return 2;
+    }
+
+    // Same bring-up as initGUIState()
+    tft.init();
+    tft.setRotation(3);
+    if (!configureMeasurementStore(4, SWEEP_FREQ_COUNT) || !initSpriteBuffer()) {
+        fprintf(stderr, "ERROR: Store or sprite setup failed\n");
+        return 2;
+    }
+
+    std::string goldenText = "# scene hash bytes - written by render_bench --update\n";
+    int failures = 0;
+    HAL_PRINTF("%-20s %8s %8s %6s %7s %4s  %-8s  %s\n",
+               "scene", "us", "bytes", "wins", "pixels", "dma", "hash", "sprite calls");
+    for (const Scene& scene : scenes) {
+        scene.setup();
+        tftHostResetStats();
+        uint64_t startUs = halMicros();
+        renderCurrentScreen();
+        finishFramePush();
+        uint32_t us = (uint32_t)(halMicros() - startUs);
+
+        const TFTHostStats& stats = tftHostPanel.stats;
+        uint32_t hash = hashFrame();
+        char calls[160] = "";
+        size_t n = 0;
+        for (int k = 0; k < TFT_PRIM_COUNT; k++) {
+            if (stats.primitives[k] != 0 && n < sizeof(calls)) {
+                n += snprintf(calls + n, sizeof(calls) - n, " %s=%lu", primitiveNames[k],
+                              (unsigned long)stats.primitives[k]);
+            }
+        }
+        HAL_PRINTF("%-20s %8lu %8lu %6lu %7lu %4lu  %08lx %s\n", scene.name, (unsigned long)us,
+                   (unsigned long)stats.bytes, (unsigned long)stats.windows, (unsigned long)stats.pixels,
+                   (unsigned long)stats.dmaPushes, (unsigned long)hash, calls);
+
+        char line[96];
+        snprintf(line, sizeof(line), "%s %08lx %lu\n", scene.name, (unsigned long)hash, (unsigned long)stats.bytes);
+        goldenText += line;
+
+        if (outDir != nullptr && !writePPM(std::string(outDir) + "/" + scene.name + ".ppm")) {
+            fprintf(stderr, "ERROR: Cannot write %s/%s.ppm\n", outDir, scene.name);
+            return 2;
+        }
+        if (goldenPath != nullptr && !update) {
+            auto it = golden.find(scene.name);
+            if (it == golden.end()) {
+                HAL_PRINTF("  MISSING from golden\n");
+                failures++;
+            } else if (it->second.hash != hash || it->second.bytes != stats.bytes) {
+                HAL_PRINTF("  MISMATCH: golden %08lx %lu bytes\n",
+                           (unsigned long)it->second.hash, (unsigned long)it->second.bytes);
+                failures++;
+            }
+        }
+    }
+
+    if (update) {
+        FILE* file = fopen(goldenPath, "w");
+        if (file == nullptr || fputs(goldenText.c_str(), file) < 0 || fclose(file) != 0) {
+            fprintf(stderr, "ERROR: Cannot write %s\n", goldenPath);
+            return 2;
+        }
+        HAL_PRINTF("Wrote %s\n", goldenPath);
+    } else if (goldenPath != nullptr) {
+        HAL_PRINTF("%d of %d scenes differ from %s\n", failures, (int)(sizeof(scenes) / sizeof(scenes[0])),
+                   goldenPath);
+    }
+    return failures ? 1 : 0;
+}
+
+#endif // ARDUINO
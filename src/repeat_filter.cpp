@@ -0,0 +1,163 @@
+#include "repeat_filter.h"
+#include "repeat_plan.h"
+#include "console.h"
+#include "log.h"
+
+// Running estimate of the point being repeated, one per DUT
+struct RepeatEstimator {
+    bool active;
+    ImpedancePoint point;   // Frequency and gains of the point; first valid repeat
+    uint8_t seen;           // Repeats received
+    uint8_t accepted;       // Repeats in the mean
+    uint8_t rejected;
+    float magMean;
+    float magM2;            // Sum of squared deviations (Welford)
+    float phaseMean;
+    float phaseM2;
+};
+
+static RepeatEstimator estimators[MAX_DUT_COUNT];
+static volatile uint8_t repeatCount = 1;
+static uint32_t rejectedTotal = 0;
+
+/*=========================CONFIGURATION=========================*/
+
+bool setSweepRepeats(uint8_t repeats) {
+    if (repeats < 1 || repeats > REPEAT_COUNT_MAX) {
+        Console.printf("ERROR: Repeat count must be 1-%d\n", REPEAT_COUNT_MAX);
+        return false;
+    }
+    repeatCount = repeats;
+    return true;
+}
+
+uint8_t getSweepRepeats() {
+    return repeatCount;
+}
+
+void resetRepeatFilter() {
+    for (int i = 0; i < MAX_DUT_COUNT; i++) {
+        estimators[i].active = false;
+    }
+    rejectedTotal = 0;
+}
+
+uint32_t getRejectedRepeatCount() {
+    return rejectedTotal;
+}
+
+/*=========================ESTIMATOR=========================*/
+
+static uint8_t saturateNoise(float value) {
+    return value >= 255.0f ? 255 : (uint8_t)(value + 0.5f);
+}
+
+static void accumulate(RepeatEstimator& est, const ImpedancePoint& sample) {
+    est.seen++;
+    if (!sample.valid) {
+        return;
+    }
+    if (est.accepted == 0) {
+        est.point = sample;  // Gains of a valid repeat, not of a failed first one
+    }
+
+    float magDelta = sample.Z_magnitude - est.magMean;
+
+    // Outlier gate against the repeats accepted so far
+    if (est.accepted >= REPEAT_REJECT_MIN_SAMPLES) {
+        float sd = sqrtf(est.magM2 / (est.accepted - 1));
+        if (sd > 0.0f && fabsf(magDelta) > REPEAT_REJECT_SIGMA * sd) {
+            est.rejected++;
+            return;
+        }
+    }
+
+    est.accepted++;
+    est.magMean += magDelta / est.accepted;
+    est.magM2 += magDelta * (sample.Z_magnitude - est.magMean);
+
+    float phaseDelta = sample.Z_phase - est.phaseMean;
+    est.phaseMean += phaseDelta / est.accepted;
+    est.phaseM2 += phaseDelta * (sample.Z_phase - est.phaseMean);
+}
+
+static void start(RepeatEstimator& est, const ImpedancePoint& sample) {
+    est.active = true;
+    est.point = sample;
+    est.seen = 0;
+    est.accepted = 0;
+    est.rejected = 0;
+    est.magMean = 0.0f;
+    est.magM2 = 0.0f;
+    est.phaseMean = 0.0f;
+    est.phaseM2 = 0.0f;
+    accumulate(est, sample);
+}
+
+static void finish(RepeatEstimator& est, ImpedancePoint& out, PointNoise& noise) {
+    est.active = false;
+    out = est.point;
+    out.valid = est.accepted > 0;
+    noise = PointNoise();
+    noise.repeats = est.accepted;
+    noise.rejected = est.rejected;
+    rejectedTotal += est.rejected;
+    if (!out.valid) {
+        return;
+    }
+
+    out.Z_magnitude = est.magMean;
+    out.Z_phase = est.phaseMean;
+    if (est.accepted > 1) {
+        float magSd = sqrtf(est.magM2 / (est.accepted - 1));
+        float phaseSd = sqrtf(est.phaseM2 / (est.accepted - 1));
+        if (est.magMean > 0.0f) {
+            noise.magSd = saturateNoise(magSd / est.magMean * 100.0f / POINT_NOISE_MAG_STEP);
+        }
+        noise.phaseSd = saturateNoise(phaseSd / POINT_NOISE_PHASE_STEP);
+    }
+    if (est.rejected > 0) {
+        LOG_D("Repeat filter: %lu Hz kept %d, rejected %d\n", out.freq_hz, est.accepted, est.rejected);
+    }
+}
+
+/*=========================SAMPLES=========================*/
+
+bool addRepeatSample(uint8_t dutIndex, const ImpedancePoint& sample, ImpedancePoint& out, PointNoise& noise) {
+    RepeatEstimator& est = estimators[dutIndex];
+    uint8_t repeats = getPointRepeats(sample.freq_idx);
+
+    // Single repeats pass straight through
+    if (repeats <= 1 && !est.active) {
+        out = sample;
+        noise = PointNoise();
+        return true;
+    }
+
+    // A new frequency ends the previous point early (missed repeats)
+    if (est.active && est.point.freq_hz != sample.freq_hz) {
+        finish(est, out, noise);
+        start(est, sample);
+        return true;
+    }
+
+    if (est.active) {
+        accumulate(est, sample);
+    } else {
+        start(est, sample);
+    }
+    if (est.seen >= repeats) {
+        finish(est, out, noise);
+        return true;
+    }
+    return false;
+}
+
+bool flushRepeatSample(uint8_t dutIndex, ImpedancePoint& out, PointNoise& noise) {
+    RepeatEstimator& est = estimators[dutIndex];
+    if (!est.active) {
+        return false;
+    }
+    finish(est, out, noise);
+    return true;
+}
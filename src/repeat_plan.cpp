@@ -0,0 +1,135 @@
+#include "repeat_plan.h"
+#include "repeat_filter.h"
+#include "meas_session.h"
+#include "meas_store.h"
+#include "open_channel.h"
+#include "sweep_eta.h"
+#include "console.h"
+#include "log.h"
+#include <math.h>
+
+static RepeatPlan uniformPlan(uint8_t repeats) {
+    RepeatPlan plan;
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        setRepeatPlanCount(plan, i, repeats);
+    }
+    return plan;
+}
+
+// Written between sweeps, read by the data processor while one runs
+static RepeatPlan plan = uniformPlan(REPEAT_PLAN_MIN);
+static bool adaptive = REPEAT_PLAN_ADAPTIVE;
+static volatile bool applied = false;       // The running sweep uses the plan
+static uint32_t plannedFrames = 0;          // Frames per DUT of that sweep
+
+/*=========================CONFIGURATION=========================*/
+
+void setAdaptiveRepeats(bool enable) {
+    adaptive = enable;
+}
+
+bool isAdaptiveRepeats() {
+    return adaptive;
+}
+
+void resetRepeatPlan() {
+    plan = uniformPlan(max(getSweepRepeats(), (uint8_t)REPEAT_PLAN_MIN));
+}
+
+const RepeatPlan& getRepeatPlan() {
+    return plan;
+}
+
+void setRepeatPlan(const RepeatPlan& newPlan) {
+    plan = newPlan;
+}
+
+void setRepeatPlanApplied(bool enable, SweepMask mask) {
+    plannedFrames = 0;
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        if (mask & ((SweepMask)1 << i)) {
+            plannedFrames += getRepeatPlanCount(plan, i);
+        }
+    }
+    applied = enable;
+}
+
+bool isRepeatPlanApplied() {
+    return applied;
+}
+
+uint32_t getRepeatPlanFrames() {
+    return plannedFrames;
+}
+
+uint8_t getPointRepeats(uint8_t freqIdx) {
+    if (applied && freqIdx < SWEEP_FREQ_COUNT) {
+        return getRepeatPlanCount(plan, freqIdx);
+    }
+    return getSweepRepeats();
+}
+
+/*=========================LEARNING=========================*/
+
+bool learnRepeatPlan(bool final) {
+    // A single repeat has no spread to learn from
+    if (!applied && getSweepRepeats() < 2) {
+        return false;
+    }
+    const ImpedanceRow* rows = final ? measurementImpedanceData : baselineImpedanceData;
+    float need[SWEEP_FREQ_COUNT] = {};
+    SweepMask seen = 0;
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        if (isChannelOpen(dut)) {
+            continue;
+        }
+        const ImpedanceRow& row = rows[dut];
+        int count = getRowPointCount(!final, dut);
+        for (int i = 0; i < count; i++) {
+            uint8_t idx = storedFreqIndex(row.freqCode[i]);
+            if (idx >= SWEEP_FREQ_COUNT || !isStoredPointValid(row, i)) {
+                continue;
+            }
+            // Standard error sd / sqrt(n) on target: n = (sd / se)^2
+            float mag = storedMagSdPercent(row, i) / REPEAT_PLAN_TARGET_MAG_SE;
+            float phase = storedPhaseSdDegrees(row, i) / REPEAT_PLAN_TARGET_PHASE_SE;
+            need[idx] = max(need[idx], max(mag * mag, phase * phase));
+            seen |= (SweepMask)1 << idx;
+        }
+    }
+
+    bool changed = false;
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        if (!(seen & ((SweepMask)1 << i))) {
+            continue;
+        }
+        int current = getRepeatPlanCount(plan, i);
+        // At most double or halve per sweep
+        int repeats = min(max((int)ceilf(need[i]), max(current / 2, REPEAT_PLAN_MIN)),
+                          min(current * 2, REPEAT_COUNT_MAX));
+        if (repeats != current) {
+            setRepeatPlanCount(plan, i, repeats);
+            changed = true;
+        }
+    }
+    if (changed) {
+        LOG_I("Repeat plan updated from the %s sweep\n", final ? "final" : "baseline");
+    }
+    return changed;
+}
+
+void printRepeatPlan() {
+    Console.printf("\n=== Repeat Plan (%s) ===\n", adaptive ? "adaptive" : "off");
+    uint64_t planUs = 0;
+    uint64_t uniformUs = 0;
+    uint8_t uniform = getSweepRepeats();
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        uint8_t repeats = getRepeatPlanCount(plan, i);
+        uint32_t us = getPointTimeUs(i);
+        planUs += (uint64_t)us * repeats;
+        uniformUs += (uint64_t)us * uniform;
+        Console.printf("%8lu Hz %3d x %8.1f ms\n", sweepFrequencies[i], repeats, us / 1000.0f);
+    }
+    Console.printf("Full sweep: %.1f s per DUT (%.1f s with %d repeat%s)\n", planUs / 1e6f, uniformUs / 1e6f,
+                   uniform, uniform == 1 ? "" : "s");
+}
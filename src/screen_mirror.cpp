@@ -0,0 +1,291 @@
+#include "screen_mirror.h"
+#include "console.h"
+#include "gui_screens.h"
+#include "BLE_Functions.h"
+#include "wifi_server.h"
+#include "usb_export.h"
+#include <esp_heap_caps.h>
+
+#define TILE_COLUMNS        (SCREEN_WIDTH / MIRROR_TILE_W)
+#define TILE_ROWS           (SCREEN_HEIGHT / MIRROR_TILE_H)
+#define PACKET_TILES_MAX    64      // Tile records a packet can hold (8 + 3 bytes at least each)
+
+static_assert(SCREEN_WIDTH % MIRROR_TILE_W == 0 && SCREEN_HEIGHT % MIRROR_TILE_H == 0,
+              "Tiles must cover the screen");
+static_assert(BAND_HEIGHT % MIRROR_TILE_H == 0 && PALETTE_SLICE_ROWS % MIRROR_TILE_H == 0,
+              "A band must hold whole tile rows");
+static_assert(MIRROR_TILE_W <= 128, "A tile row must fit one RLE count");
+static_assert(MIRROR_PACKET_MAX <= WIFI_WS_FRAME_MAX, "A packet must fit one live frame");
+
+// Worst case of one RLE row: one count byte and every pixel literal
+#define ROW_BYTES_MAX(w)    (1 + 2 * (w))
+
+// GUI task only
+static uint8_t sinks = 0;
+static int8_t bleClient = BLE_NO_CLIENT;
+static uint32_t tileHash[TILE_ROWS][TILE_COLUMNS];  // Last sent, 0 = not on the host
+static uint16_t* rowBuffer = nullptr;
+
+static uint8_t packet[MIRROR_PACKET_MAX];
+static size_t packetLen = 0;        // 0 = no packet open
+static size_t packetMax = 0;        // Packet size of this frame, 0 = no tile yet
+static uint16_t packetTiles[PACKET_TILES_MAX];     // Tile indices in the open packet
+static uint8_t frameNumber = 0;
+static uint8_t framePart = 0;
+static bool resync = false;         // A packet was refused - redraw everything
+
+static uint32_t sentPackets = 0;
+static uint32_t sentBytes = 0;
+static uint32_t sentFrames = 0;
+static uint32_t refusedPackets = 0;
+
+/*=========================SINKS=========================*/
+
+// Redraw the whole screen; tiles the host has are still skipped
+static void requestFullFrame() {
+    invalidateFrame();
+    requestRender();
+}
+
+bool setScreenMirror(uint8_t sink, bool enable) {
+    if (enable) {
+        if (sink == MIRROR_SINK_WIFI && !WIFI_SERVER) {
+            return false;
+        }
+        if (sink == MIRROR_SINK_BLE) {
+            int8_t client = getBLECommandClient();
+            if (getBLEClientPayloadSize(client) < MIRROR_BLE_MIN_PAYLOAD) {
+                return false;
+            }
+            bleClient = client;
+        }
+        if (GUI_SPRITE_4BIT && rowBuffer == nullptr) {
+            rowBuffer = (uint16_t*)heap_caps_malloc(SCREEN_WIDTH * MIRROR_TILE_H * sizeof(uint16_t),
+                                                    MALLOC_CAP_8BIT);
+            if (rowBuffer == nullptr) {
+                return false;
+            }
+        }
+        // The new host has nothing yet
+        sinks |= sink;
+        memset(tileHash, 0, sizeof(tileHash));
+        requestFullFrame();
+    } else {
+        sinks &= ~sink;
+    }
+    return true;
+}
+
+uint8_t getScreenMirrorSinks() {
+    return sinks;
+}
+
+void formatMirrorSinks(char* out, size_t size) {
+    snprintf(out, size, "%s%s%s%s", sinks == 0 ? "off" : "", (sinks & MIRROR_SINK_USB) ? "+usb" : "",
+             (sinks & MIRROR_SINK_BLE) ? "+ble" : "", (sinks & MIRROR_SINK_WIFI) ? "+wifi" : "");
+    if (out[0] == '+') {
+        memmove(out, out + 1, strlen(out));
+    }
+}
+
+bool isScreenMirrorActive() {
+    return sinks != 0;
+}
+
+uint16_t* getMirrorRowBuffer() {
+    // 8-bit strips come with the heap (RENDER_TIER_8BIT), after the mirror was enabled
+    if (rowBuffer == nullptr) {
+        rowBuffer = (uint16_t*)heap_caps_malloc(SCREEN_WIDTH * MIRROR_TILE_H * sizeof(uint16_t), MALLOC_CAP_8BIT);
+    }
+    return rowBuffer;
+}
+
+// Packet size for this frame: the smallest sink's
+static void beginPackets() {
+    packetMax = MIRROR_PACKET_MAX;
+    if (sinks & MIRROR_SINK_BLE) {
+        size_t payload = getBLEClientPayloadSize(bleClient);
+        if (payload < MIRROR_BLE_MIN_PAYLOAD) {
+            // Disconnected (or its slot taken over)
+            sinks &= ~MIRROR_SINK_BLE;
+            Console.println("[MIRROR] BLE client gone - BLE mirror off");
+        } else {
+            packetMax = min(packetMax, payload);
+        }
+    }
+}
+
+static void openPacket() {
+    ScreenMirrorHeader* header = (ScreenMirrorHeader*)packet;
+    header->magic = BLE_BIN_MAGIC;
+    header->type = BLE_BIN_TYPE_MIRROR;
+    header->frame = frameNumber;
+    header->flags = 0;
+    header->part = framePart;
+    header->tiles = 0;
+    packetLen = sizeof(ScreenMirrorHeader);
+}
+
+static void sendPacket(bool end) {
+    // Frame end without an open packet: a bare header carries the flag
+    if (packetLen == 0) {
+        openPacket();
+    }
+    ScreenMirrorHeader* header = (ScreenMirrorHeader*)packet;
+    header->flags = end ? MIRROR_FLAG_END : 0;
+
+    bool ok = true;
+    if (sinks & MIRROR_SINK_USB) {
+        sendUsbExportFrame(USB_EXPORT_MIRROR, packet, packetLen);
+    }
+    if (sinks & MIRROR_SINK_BLE) {
+        ok = queueBLEClientMessage(bleClient, packet, packetLen, packetLen, 0) && ok;
+    }
+    if (sinks & MIRROR_SINK_WIFI) {
+        ok = sendWiFiLive(packet, packetLen) && ok;
+    }
+    if (ok) {
+        sentPackets++;
+        sentBytes += packetLen;
+    } else {
+        // The host misses these tiles - send them with the next frame
+        refusedPackets++;
+        for (uint8_t i = 0; i < header->tiles; i++) {
+            tileHash[packetTiles[i] / TILE_COLUMNS][packetTiles[i] % TILE_COLUMNS] = 0;
+        }
+        resync = true;
+    }
+    framePart++;
+    packetLen = 0;
+}
+
+/*=========================TILES=========================*/
+
+static uint32_t hashTile(const uint16_t* pixels) {
+    uint32_t hash = 2166136261u;    // FNV-1a over pixel pairs
+    for (int16_t y = 0; y < MIRROR_TILE_H; y++, pixels += SCREEN_WIDTH) {
+        const uint32_t* pairs = (const uint32_t*)pixels;
+        for (int16_t x = 0; x < MIRROR_TILE_W / 2; x++) {
+            hash = (hash ^ pairs[x]) * 16777619u;
+        }
+    }
+    return hash != 0 ? hash : 1;
+}
+
+// One row of w pixels as RLE; returns the bytes written
+static size_t encodeRow(const uint16_t* pixels, int16_t w, uint8_t* out) {
+    size_t o = 0;
+    int16_t i = 0;
+    while (i < w) {
+        int16_t run = 1;
+        while (i + run < w && run < 128 && pixels[i + run] == pixels[i]) {
+            run++;
+        }
+        if (run > 1) {
+            out[o++] = 0x80 | (run - 1);
+            memcpy(&out[o], &pixels[i], 2);
+            o += 2;
+            i += run;
+            continue;
+        }
+        // Literals up to the next repeat
+        int16_t start = i;
+        while (i < w && i - start < 128 && !(i + 1 < w && pixels[i + 1] == pixels[i])) {
+            i++;
+        }
+        out[o++] = i - start - 1;
+        memcpy(&out[o], &pixels[start], (i - start) * 2);
+        o += (i - start) * 2;
+    }
+    return o;
+}
+
+// Rect x, y, w, h of tile index; origin is screen row y, column 0. A tile
+// is split across packets by rows when it does not fit the open one
+static void sendTile(uint16_t index, int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* origin) {
+    int16_t row = 0;
+    while (row < h) {
+        if (packetLen > 0 && (packetLen + sizeof(ScreenMirrorTile) + ROW_BYTES_MAX(w) > packetMax ||
+                              ((ScreenMirrorHeader*)packet)->tiles == PACKET_TILES_MAX)) {
+            sendPacket(false);
+        }
+        if (packetLen == 0) {
+            openPacket();
+        }
+        ScreenMirrorHeader* header = (ScreenMirrorHeader*)packet;
+
+        ScreenMirrorTile* tile = (ScreenMirrorTile*)&packet[packetLen];
+        packetLen += sizeof(ScreenMirrorTile);
+        size_t start = packetLen;
+        int16_t first = row;
+        while (row < h && packetLen + ROW_BYTES_MAX(w) <= packetMax) {
+            packetLen += encodeRow(origin + row * SCREEN_WIDTH + x, w, &packet[packetLen]);
+            row++;
+        }
+        tile->x = x;
+        tile->y = y + first;
+        tile->w = w;
+        tile->h = row - first;
+        tile->bytes = packetLen - start;
+        packetTiles[header->tiles++] = index;
+    }
+}
+
+void mirrorRows(const uint16_t* pixels, int16_t top, int16_t rows, int16_t left, int16_t right) {
+    if (sinks == 0 || pixels == nullptr) {
+        return;
+    }
+    if (packetMax == 0) {
+        beginPackets();
+        if (sinks == 0) {
+            return;
+        }
+    }
+    int16_t bottom = top + rows;
+    for (int16_t ty = top / MIRROR_TILE_H; ty * MIRROR_TILE_H < bottom; ty++) {
+        int16_t y0 = max(top, (int16_t)(ty * MIRROR_TILE_H));
+        int16_t y1 = min(bottom, (int16_t)((ty + 1) * MIRROR_TILE_H));
+        const uint16_t* origin = pixels + (y0 - top) * SCREEN_WIDTH;
+        for (int16_t tx = left / MIRROR_TILE_W; tx * MIRROR_TILE_W < right; tx++) {
+            int16_t x0 = max(left, (int16_t)(tx * MIRROR_TILE_W));
+            int16_t x1 = min(right, (int16_t)((tx + 1) * MIRROR_TILE_W));
+            // Only a whole tile is hashed - a part leaves the rest unknown
+            if (y1 - y0 == MIRROR_TILE_H && x1 - x0 == MIRROR_TILE_W) {
+                uint32_t hash = hashTile(origin + x0);
+                if (hash == tileHash[ty][tx]) {
+                    continue;
+                }
+                tileHash[ty][tx] = hash;
+            } else {
+                tileHash[ty][tx] = 0;
+            }
+            sendTile(ty * TILE_COLUMNS + tx, x0, y0, x1 - x0, y1 - y0, origin);
+        }
+    }
+}
+
+void endMirrorFrame() {
+    // Nothing changed (or every sink went off): no packet at all
+    if (sinks != 0 && (packetLen > 0 || framePart > 0)) {
+        sendPacket(true);
+        frameNumber++;
+        sentFrames++;
+    }
+    packetLen = 0;
+    framePart = 0;
+    packetMax = 0;
+    if (resync) {
+        resync = false;
+        requestFullFrame();
+    }
+}
+
+void printScreenMirrorStats() {
+    if (sinks == 0 && sentPackets == 0) {
+        return;
+    }
+    char names[20];
+    formatMirrorSinks(names, sizeof(names));
+    Console.printf("Screen mirror: %s, %lu frames, %lu packets / %lu bytes, %lu refused\n",
+                   names, sentFrames, sentPackets, sentBytes, refusedPackets);
+}
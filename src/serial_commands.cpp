@@ -1,75 +1,1338 @@
 #include "serial_commands.h"
+#include "console.h"
 #include "UART_Functions.h"
+#include "BLE_Functions.h"
 #include "defines.h"
+#include "trace.h"
+#include "profiler.h"
+#include "sweep_stats.h"
+#include "sweep_eta.h"
+#include "boot_timing.h"
+#include "power_manager.h"
+#include "task_monitor.h"
+#include "heap_stats.h"
+#include "fixed_cal.h"
+#include "calibration.h"
+#include "cal_upload.h"
+#include "ota_update.h"
+#include "cal_acquire.h"
+#include "raw_capture.h"
+#include "cal_set.h"
+#include "impedance_calc.h"
+#include "sweep_table.h"
+#include "meas_store.h"
+#include "repeat_filter.h"
+#include "repeat_plan.h"
+#include "sweep_refine.h"
+#include "lot_reference.h"
+#include "session_log.h"
+#include "usb_export.h"
+#include "csv_export.h"
+#include "monitor.h"
+#include "sleep_monitor.h"
+#include "meas_control.h"
+#include "gui_state.h"
+#include "gui_screens.h"
+#include "meas_session.h"
+#include "micro_bench.h"
+#include "sweep_bench.h"
+#include "stm32_sim.h"
+#include "wifi_server.h"
+#include "spectral_metrics.h"
+#include "sweep_presets.h"
+#include "recipe.h"
+#include "fleet_aggregator.h"
+#include "thread_uplink.h"
+#include "screen_mirror.h"
+#include "counters.h"
+#include "bg_jobs.h"
 #include <string.h>
+#include <stdlib.h>
 
 #define CMD_BUFFER_SIZE 64
 
-void processSerialCommands() {
-    // Check if data available on USB serial
-    if (!Serial.available()) {
-        return;
+// Sweep selection and plan (main.cpp)
+extern SweepMask customSweepMask;
+extern uint8_t num_duts;
+SweepConfig sweepConfigDefaults();
+
+// Risk calculation band (main.cpp)
+extern float calcStartFreq;
+extern float calcEndFreq;
+
+#if ARDUINO_USB_CDC_ON_BOOT && ARDUINO_USB_MODE
+// USB Serial/JTAG RX event, from the HWCDC event task
+static void onSerialRx(void* arg, esp_event_base_t base, int32_t id, void* data) {
+    wakeGUITask(GUI_WAKE_SERIAL);
+}
+#endif
+
+void initSerialCommands() {
+#if ARDUINO_USB_CDC_ON_BOOT && ARDUINO_USB_MODE
+    Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT, onSerialRx);
+#else
+    Serial.onReceive([]() { wakeGUITask(GUI_WAKE_SERIAL); });
+#endif
+}
+
+/*=========================SWEEP RUNS=========================*/
+// "run <n>": n sweeps back to back, started from the completion of the one
+// before (serialSweepComplete) - GUI task only
+static uint16_t runTotal = 0;
+static uint16_t runDone = 0;
+static uint8_t runDuts = 0;
+
+// Reason token of a refused sweep request
+static const char* const requestErrorTokens[] = {
+    "ok", "busy", "monitor", "no_baseline", "invalid", "queue", "update", "calibration", "recipe"
+};
+
+static void endRun(const char* reason) {
+    if (runTotal > 0) {
+        Console.printf("@EVT run_end %u %u %s\n", runDone, runTotal, reason);
+        runTotal = 0;
     }
+}
 
-    // Read line from serial
-    String cmdLine = Serial.readStringUntil('\n');
-    cmdLine.trim();  // Remove whitespace
+static void onRunStartAnswered(uint8_t cmd_type, bool success, void* context) {
+    if (!success) {
+        endRun("start_failed");
+    }
+}
 
-    if (cmdLine.length() == 0) {
+// Next sweep of the run: a baseline if none is stored, else a final sweep
+static MeasRequestError startRunSweep() {
+    if (!baselineMeasurementDone) {
+        SweepPlan plan = {runDuts, 0, SWEEP_FREQ_COUNT - 1, customSweepMask};
+        return requestBaselineSweep(MEAS_SOURCE_SERIAL, plan, onRunStartAnswered);
+    }
+    return requestFinalSweep(MEAS_SOURCE_SERIAL, onRunStartAnswered);
+}
+
+void serialSweepComplete(bool final) {
+    Console.printf("@EVT sweep %s %lu\n", final ? "final" : "baseline",
+                  (unsigned long)getMeasurementGeneration());
+    if (runTotal == 0 || getMeasurementSource() != MEAS_SOURCE_SERIAL) {
+        return;
+    }
+    runDone++;
+    if (runDone >= runTotal) {
+        endRun("done");
         return;
     }
+    MeasRequestError error = startRunSweep();
+    if (error != MEAS_REQUEST_OK) {
+        endRun(requestErrorTokens[error]);
+    }
+}
+
+void serialSweepAborted(const char* reason) {
+    if (getMeasurementSource() == MEAS_SOURCE_SERIAL) {
+        endRun(reason);
+    }
+}
+
+/*=========================HANDLERS=========================*/
+// args: the rest of the line after the command and a space ("" if none)
+// Return nullptr on success, else a reason token for the @ERR line
+
+static bool measurementIdle() {
+    return getMeasurementState() == MEAS_IDLE && !isMonitorActive();
+}
+
+static const char* cmdStart(const char* args) {
+    int duts = getDUTCount();  // Default: all configured channels
+    if (args[0] != '\0') {
+        duts = atoi(args);
+        if (duts < 1 || duts > getDUTCount()) {
+            Console.printf("ERROR: Invalid number of DUTs (%d). Must be 1-%d.\n", duts, getDUTCount());
+            return "invalid";
+        }
+    }
+
+    // A new baseline takes the current selection, the final sweep keeps the baseline's
+    MeasRequestError error;
+    if (!baselineMeasurementDone) {
+        Console.printf("Starting measurement with %d DUT%s...\n", duts, duts > 1 ? "s" : "");
+        SweepPlan plan = {(uint8_t)duts, 0, SWEEP_FREQ_COUNT - 1, customSweepMask};
+        error = requestBaselineSweep(MEAS_SOURCE_SERIAL, plan);
+    } else {
+        Console.println("Starting final measurement with the baseline's DUTs...");
+        error = requestFinalSweep(MEAS_SOURCE_SERIAL);
+    }
+    if (error != MEAS_REQUEST_OK) {
+        Console.printf("ERROR: %s\n", measRequestErrorText(error));
+        return requestErrorTokens[error];
+    }
+    return nullptr;
+}
+
+static const char* cmdRun(const char* args) {
+    char* rest;
+    long count = strtol(args, &rest, 10);
+    int duts = *rest == ' ' ? atoi(rest + 1) : getDUTCount();
+    if (count < 1 || count > UINT16_MAX || duts < 1 || duts > getDUTCount()) {
+        Console.printf("ERROR: Usage: run <sweeps> [1-%d DUTs]\n", getDUTCount());
+        return "invalid";
+    }
+    if (runTotal > 0) {
+        if (getMeasurementState() != MEAS_IDLE) {
+            return "busy";
+        }
+        endRun("aborted");  // Stopped from the GUI or BLE
+    }
+
+    runDuts = duts;
+    MeasRequestError error = startRunSweep();
+    if (error != MEAS_REQUEST_OK) {
+        Console.printf("ERROR: %s\n", measRequestErrorText(error));
+        return requestErrorTokens[error];
+    }
+    runTotal = count;
+    runDone = 0;
+    Console.printf("@EVT run_start %u\n", runTotal);
+    return nullptr;
+}
+
+static const char* cmdStop(const char* args) {
+    Console.println("Stopping measurement...");
+    endRun("stopped");
+    abortCalAcquire("stopped");
+    requestMeasurementStop(MEAS_SOURCE_SERIAL);
+    return nullptr;
+}
+
+static const char* cmdStatus(const char* args) {
+    static const char* const stateNames[] = {"idle", "starting", "sweeping"};
+    Console.printf("@STATUS state=%s baseline=%d final=%d monitor=%d duts=%d points=%d repeats=%d "
+                  "mask=0x%010llX gen=%lu run=%u/%u\n",
+                  stateNames[getMeasurementState()], baselineMeasurementDone ? 1 : 0,
+                  finalMeasurementDone ? 1 : 0, isMonitorActive() ? 1 : 0, num_duts, getPointsPerDUT(),
+                  getSweepRepeats(), (unsigned long long)customSweepMask,
+                  (unsigned long)getMeasurementGeneration(), runDone, runTotal);
+    return nullptr;
+}
+
+// STM32 analog settings - only between sweeps, the sweep sets its own
+static const char* queueSetting(uint8_t cmd_type, long maxValue, const char* args) {
+    char* end;
+    long value = strtol(args, &end, 10);
+    if (args[0] == '\0' || *end != '\0' || value < 0 || value > maxValue) {
+        Console.printf("ERROR: Value must be 0-%ld\n", maxValue);
+        return "invalid";
+    }
+    if (!measurementIdle()) {
+        Console.println("ERROR: Measurement in progress");
+        return "busy";
+    }
+    return queueUARTCommand(cmd_type, value, 0, 0) ? nullptr : "queue";
+}
+
+static const char* cmdPGA(const char* args) {
+    return queueSetting(CMD_SET_PGA_GAIN, 7, args);
+}
+
+static const char* cmdMux(const char* args) {
+    return queueSetting(CMD_SET_MUX_CHANNEL, MAX_DUT_COUNT - 1, args);
+}
+
+static const char* cmdTIA(const char* args) {
+    // 0 = high gain (7500 Ohm), 1 = low gain (37.5 Ohm)
+    if (strcmp(args, "high") == 0) {
+        args = "0";
+    } else if (strcmp(args, "low") == 0) {
+        args = "1";
+    }
+    return queueSetting(CMD_SET_TIA_GAIN, 1, args);
+}
+
+static const char* cmdMonitor(const char* args) {
+    if (strcmp(args, "off") == 0) {
+        if (isMonitorActive()) {
+            stopMonitor();
+            setGUIState(GUI_BASELINE_COMPLETE);
+        }
+    } else if (args[0] != '\0' && !isMonitorActive()) {
+        char* end;
+        uint32_t intervalS = strtoul(args, &end, 10);
+        if (!startMonitor(intervalS, strtoul(end, nullptr, 10))) {
+            return "invalid";
+        }
+    }
+    if (isMonitorActive()) {
+        Console.printf("Monitor: every %lu s, %lu sweeps", (unsigned long)getMonitorInterval(),
+                      (unsigned long)getMonitorSweepCount());
+        if (getTrackingHalfLife() > 0) {
+            Console.printf(", baseline tracked (half-life %d sweeps)", getTrackingHalfLife());
+        }
+        Console.println();
+    } else {
+        Console.println("Monitor: off");
+    }
+    return nullptr;
+}
+
+// recipe [<steps>|run|stop] (recipe.h)
+static const char* cmdRecipe(const char* args) {
+    if (strcmp(args, "stop") == 0) {
+        if (isRecipeRunning()) {
+            requestMeasurementStop(MEAS_SOURCE_SERIAL);
+        }
+    } else if (strcmp(args, "run") == 0) {
+        RecipeError error = runRecipe();
+        if (error != RECIPE_OK) {
+            Console.printf("ERROR: %s\n", recipeErrorText(error));
+            return error == RECIPE_BUSY ? "busy" : "invalid";
+        }
+    } else if (args[0] != '\0') {
+        uint8_t errorStep = 0;
+        RecipeError error = saveRecipe(args, &errorStep);
+        if (error == RECIPE_SYNTAX) {
+            Console.printf("ERROR: %s (step %d)\n", recipeErrorText(error), errorStep);
+            return "invalid";
+        } else if (error == RECIPE_STORAGE) {
+            Console.printf("WARNING: %s - kept until reboot\n", recipeErrorText(error));
+        } else if (error != RECIPE_OK) {
+            Console.printf("ERROR: %s\n", recipeErrorText(error));
+            return error == RECIPE_BUSY ? "busy" : "invalid";
+        }
+    }
+    printRecipe();
+    return nullptr;
+}
+
+#if SLEEP_MONITOR
+static const char* cmdSleep(const char* args) {
+    if (strcmp(args, "off") == 0) {
+        stopSleepMonitor();
+    } else if (args[0] != '\0' && !isMonitorActive()) {
+        char* end;
+        uint32_t intervalS = strtoul(args, &end, 10);
+        if (!startSleepMonitor(intervalS, strtoul(end, nullptr, 10))) {
+            return "invalid";
+        }
+    } else if (args[0] != '\0') {
+        return "busy";
+    }
+    printSleepMonitor();
+    return nullptr;
+}
+#endif
+
+static const char* cmdTraceDump(const char* args) {
+    traceDump();
+    return nullptr;
+}
+
+static const char* cmdTraceClear(const char* args) {
+    traceClear();
+    Console.println("Trace buffer cleared");
+    return nullptr;
+}
+
+static const char* cmdProfStart(const char* args) {
+    uint32_t hz = args[0] != '\0' ? strtoul(args, nullptr, 10) : PROFILER_DEFAULT_HZ;
+    if (hz == 0 || hz > PROFILER_MAX_HZ) {
+        Console.printf("ERROR: Usage: prof start [1-%d Hz]\n", PROFILER_MAX_HZ);
+        return "invalid";
+    }
+    if (!startProfiler(hz)) {
+        return "failed";
+    }
+    printProfilerStatus();
+    return nullptr;
+}
+
+static const char* cmdProfStop(const char* args) {
+    stopProfiler();
+    printProfilerStatus();
+    return nullptr;
+}
+
+static const char* cmdProfDump(const char* args) {
+    dumpProfiler();
+    return nullptr;
+}
+
+static const char* cmdProf(const char* args) {
+    printProfilerStatus();
+    return nullptr;
+}
+
+static const char* cmdRaw(const char* args) {
+    if (strcmp(args, "on") == 0 || strcmp(args, "off") == 0) {
+        if (!measurementIdle() || isCalAcquireActive()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        if (!setRawCapture(strcmp(args, "on") == 0)) {
+            return "failed";
+        }
+    } else if (args[0] != '\0') {
+        Console.println("ERROR: Usage: raw [on|off]");
+        return "invalid";
+    }
+    Console.printf("Raw capture: %s, %lu of %d records (%lu captured)\n",
+                  isRawCaptureActive() ? "on - calibration bypassed" : "off",
+                  (unsigned long)getRawCaptureCount(), RAW_CAPTURE_RING_SIZE,
+                  (unsigned long)getRawCaptureTotal());
+    return nullptr;
+}
+
+static const char* cmdRawDump(const char* args) {
+    dumpRawCapture();
+    return nullptr;
+}
+
+static const char* cmdRawClear(const char* args) {
+    clearRawCapture();
+    Console.println("Raw capture cleared");
+    return nullptr;
+}
+
+static const char* cmdRawRecal(const char* args) {
+    if (!measurementIdle() || isCalAcquireActive()) {
+        Console.println("ERROR: Measurement in progress");
+        return "busy";
+    }
+    // The data processor swaps a reloaded table in - recalibrate after it did
+    if (isCalibrationReloadPending()) {
+        Console.println("ERROR: Calibration reload not applied yet - retry");
+        return "busy";
+    }
+    if (getRawCaptureCount() == 0) {
+        Console.println("ERROR: No raw points captured");
+        return "empty";
+    }
+    // Jobs still reading the rows of the sweep
+    flushBackgroundJobs();
+    uint32_t startUs = micros();
+    RawRecalResult result = recalibrateRawCapture((uint32_t)calcStartFreq, (uint32_t)calcEndFreq);
+    if (result.baselineDuts == 0 && result.finalDuts == 0) {
+        Console.println("ERROR: The captured sessions no longer own their rows");
+        return "stale";
+    }
+    for (uint8_t dut = 0; dut < num_duts; dut++) {
+        if (!(result.finalDuts & (1 << dut))) {
+            continue;
+        }
+        calculateRiskLevel(dut);
+        finishSpectralMetrics(dut);
+        sendBLERisk(dut);
+        sendBLEMetrics(dut);
+        showDUTResult(dut);
+        Console.printf("DUT %d: risk %d, %.1f%%\n", dut + 1, (int)riskLevels[dut], riskPercentages[dut]);
+    }
+    Console.printf("Recalibrated with \"%s\": %d baseline / %d final rows, %u points (%u uncalibrated), %lu us\n",
+                   getCalibrationSetName(), __builtin_popcount(result.baselineDuts),
+                   __builtin_popcount(result.finalDuts), result.points, result.uncalibrated,
+                   (unsigned long)(micros() - startUs));
+    if (result.truncated) {
+        Console.println("WARNING: The ring had lost the first points of a session - they are left out");
+    }
+    return nullptr;
+}
 
-    Serial.printf("Received command: '%s'\n", cmdLine.c_str());
+static const char* cmdStats(const char* args) {
+    printSweepStats();
+    printSweepTimeModel();
+    printHeapReport();
+    printConsoleStats();
+    printUARTFlowStats();
+    printBLELinkStatus();
+    printScreenMirrorStats();
+    printRenderStats();
+    return nullptr;
+}
 
-    // Parse command
-    if (cmdLine.startsWith("start")) {
-        // Extract number of DUTs if provided
-        int num_duts = 4;  // Default
+static const char* cmdStatsReset(const char* args) {
+    sweepStatsReset();
+    heapStatsReset();
+    Console.println("Sweep and heap statistics cleared");
+    return nullptr;
+}
 
-        // Check if there's a number after "start"
-        int spaceIndex = cmdLine.indexOf(' ');
-        if (spaceIndex > 0) {
-            String numStr = cmdLine.substring(spaceIndex + 1);
-            num_duts = numStr.toInt();
+static const char* cmdCounters(const char* args) {
+    printFieldCounters();
+    return nullptr;
+}
+
+static const char* cmdCountersReset(const char* args) {
+    resetFieldCounters();
+    Console.println("Counters cleared");
+    return nullptr;
+}
 
-            // Validate range
-            if (num_duts < 1 || num_duts > 4) {
-                Serial.printf("ERROR: Invalid number of DUTs (%d). Must be 1-4.\n", num_duts);
-                return;
+static const char* cmdSweep(const char* args) {
+    SweepMask mask;
+    if (args[0] == '\0') {
+        // Show the current selection
+    } else if (strcmp(args, "all") == 0) {
+        customSweepMask = 0;
+    } else if (parseSweepMask(args, mask)) {
+        customSweepMask = mask;
+    } else {
+        Console.printf("ERROR: Invalid sweep selection '%s'\n", args);
+        return "invalid";
+    }
+
+    if (customSweepMask == 0) {
+        Console.println("Sweep: all frequencies");
+    } else {
+        Console.printf("Sweep: %d frequencies (mask 0x%010llX)\n",
+                      __builtin_popcountll(customSweepMask), (unsigned long long)customSweepMask);
+    }
+    return nullptr;
+}
+
+// "on" / "off" into value, anything else leaves it
+static void parseOnOff(const char* args, bool& value) {
+    if (strcmp(args, "on") == 0) {
+        value = true;
+    } else if (strcmp(args, "off") == 0) {
+        value = false;
+    }
+}
+
+static const char* cmdInterleave(const char* args) {
+    bool interleaved = isInterleavedSweep();
+    parseOnOff(args, interleaved);
+    setInterleavedSweep(interleaved);
+    Console.printf("Interleaved sweep: %s\n", isInterleavedSweep() ? "on" : "off");
+    return nullptr;
+}
+
+static const char* cmdIndexed(const char* args) {
+    bool indexed = isIndexedFrames();
+    parseOnOff(args, indexed);
+    setIndexedFrames(indexed);
+    Console.printf("Indexed frames: %s\n", isIndexedFrames() ? "on" : "off");
+    return nullptr;
+}
+
+static const char* cmdBlocks(const char* args) {
+    bool blocks = isBlockFrames();
+    parseOnOff(args, blocks);
+    setBlockFrames(blocks);
+    Console.printf("Block frames: %s\n", isBlockFrames() ? "on" : "off");
+    return nullptr;
+}
+
+static const char* cmdCompact(const char* args) {
+    bool compact = isCompactFrames();
+    parseOnOff(args, compact);
+    setCompactFrames(compact);
+    Console.printf("Compact frames: %s%s\n", isCompactFrames() ? "on" : "off",
+                   isCompactFrames() && !isBlockFrames() ? " (blocks off - not used)" : "");
+    return nullptr;
+}
+
+static const char* cmdGainHints(const char* args) {
+    bool hints = isGainHints();
+    parseOnOff(args, hints);
+    setGainHints(hints);
+    Console.printf("Gain hints: %s\n", isGainHints() ? "on" : "off");
+    return nullptr;
+}
+
+static const char* cmdGainLimits(const char* args) {
+    bool limits = isGainLimits();
+    parseOnOff(args, limits);
+    setGainLimits(limits);
+    Console.printf("Gain limits: %s\n", isGainLimits() ? "on" : "off");
+    return nullptr;
+}
+
+static const char* cmdMirror(const char* args) {
+    bool ok = true;
+    if (strcmp(args, "usb") == 0) {
+        ok = setScreenMirror(MIRROR_SINK_USB, true);
+    } else if (strcmp(args, "wifi") == 0) {
+        ok = setScreenMirror(MIRROR_SINK_WIFI, true);
+    } else if (strcmp(args, "off") == 0) {
+        setScreenMirror(MIRROR_SINK_USB | MIRROR_SINK_BLE | MIRROR_SINK_WIFI, false);
+    } else if (args[0] != '\0') {
+        Console.println("ERROR: mirror usb, wifi or off");
+        return "invalid";
+    }
+    if (!ok) {
+        Console.println("ERROR: Mirror sink not available");
+        return "unavailable";
+    }
+    char names[20];
+    formatMirrorSinks(names, sizeof(names));
+    Console.printf("Screen mirror: %s\n", names);
+    return nullptr;
+}
+
+static const char* cmdCredits(const char* args) {
+    bool credits = isFlowCredits();
+    parseOnOff(args, credits);
+    setFlowCredits(credits);
+    Console.printf("Flow credits: %s\n", isFlowCredits() ? "on" : "off");
+    return nullptr;
+}
+
+static const char* cmdLinkTune(const char* args) {
+    if (strcmp(args, "now") == 0) {
+        if (!requestLinkTuning()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        Console.println("Link tuning queued");
+        return nullptr;
+    }
+    bool tuning = isLinkTuning();
+    parseOnOff(args, tuning);
+    setLinkTuning(tuning);
+    printLinkTuning();
+    return nullptr;
+}
+
+static const char* cmdFast(const char* args) {
+    parseOnOff(args, fastScreenMode);
+    Console.printf("Fast screen: %s\n", fastScreenMode ? "on" : "off");
+    return nullptr;
+}
+
+static const char* cmdMetrics(const char* args) {
+    if (args[0] != '\0') {
+        if (measurementInProgress || isMonitorActive()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        // Same fields as the BLE command
+        char cmd[96];
+        snprintf(cmd, sizeof(cmd), "METRICS:%s", args);
+        uint8_t field;
+        if (!parseMetricsConfig(cmd, metricsConfig, field)) {
+            Console.printf("ERROR: Invalid metrics (field %d)\n", field);
+            return "invalid";
+        }
+    }
+    printSpectralMetrics();
+    return nullptr;
+}
+
+static void printSweepPreset(const SweepPreset& preset) {
+    const SweepPlan& plan = preset.plan;
+    Console.printf("  %-15s %d DUT%s, ", preset.name, plan.numDuts, plan.numDuts > 1 ? "s" : "");
+    if (plan.mask != 0) {
+        Console.printf("mask 0x%010llX", (unsigned long long)plan.mask);
+    } else {
+        Console.printf("indices %u-%u", plan.startIdx, plan.endIdx);
+    }
+    Console.printf(", band %.0f-%.0f Hz, limits %.3f/%.3f/%.3f, %d repeat%s, metrics %02x\n",
+                  preset.calcStartFreq, preset.calcEndFreq, preset.lowCutoff, preset.mediumCutoff,
+                  preset.highCutoff, preset.repeats, preset.repeats > 1 ? "s" : "", preset.metrics.mask);
+}
+
+// preset <name> starts a baseline, preset alone lists them
+static const char* cmdPreset(const char* args) {
+    if (args[0] == '\0') {
+        Console.printf("Sweep presets (%d of %d):\n", getSweepPresetCount(), SWEEP_PRESET_MAX);
+        for (uint8_t i = 0; i < getSweepPresetCount(); i++) {
+            printSweepPreset(getSweepPreset(i));
+        }
+        return nullptr;
+    }
+    const SweepPreset* preset = findSweepPreset(args);
+    if (preset == nullptr) {
+        Console.printf("ERROR: %s\n", sweepPresetErrorText(SWEEP_PRESET_NOT_FOUND));
+        return "invalid";
+    }
+    Console.printf("Starting baseline from preset %s...\n", preset->name);
+    MeasRequestError error = startSweepPreset(MEAS_SOURCE_SERIAL, *preset);
+    if (error != MEAS_REQUEST_OK) {
+        Console.printf("ERROR: %s\n", measRequestErrorText(error));
+        return requestErrorTokens[error];
+    }
+    return nullptr;
+}
+
+// preset save <name> [n,SS,EE,...] - the BASELINE_START fields
+static const char* cmdPresetSave(const char* args) {
+    if (!measurementIdle()) {
+        Console.println("ERROR: Measurement in progress");
+        return "busy";
+    }
+    char name[SWEEP_PRESET_NAME_MAX];
+    const char* space = strchr(args, ' ');
+    size_t len = space != nullptr ? space - args : strlen(args);
+    if (len == 0 || len >= sizeof(name)) {
+        Console.printf("ERROR: %s\n", sweepPresetErrorText(SWEEP_PRESET_NAME));
+        return "invalid";
+    }
+    memcpy(name, args, len);
+    name[len] = '\0';
+
+    char cmd[CMD_BUFFER_SIZE + 16];
+    snprintf(cmd, sizeof(cmd), "BASELINE_START%s%s", space != nullptr ? ":" : "", space != nullptr ? space + 1 : "");
+    SweepConfig config = parseSweepConfigText(cmd, sweepConfigDefaults());
+    if (config.error != SWEEP_CONFIG_OK) {
+        Console.printf("ERROR: %s (field %d)\n", sweepConfigErrorText(config.error), config.errorField);
+        return "invalid";
+    }
+    SweepPresetError error = saveSweepPreset(name, config, customSweepMask);
+    if (error != SWEEP_PRESET_OK) {
+        Console.printf("ERROR: %s\n", sweepPresetErrorText(error));
+        return error == SWEEP_PRESET_STORAGE ? "storage" : "invalid";
+    }
+    printSweepPreset(*findSweepPreset(name));
+    return nullptr;
+}
+
+static const char* cmdPresetDel(const char* args) {
+    SweepPresetError error = deleteSweepPreset(args);
+    if (error != SWEEP_PRESET_OK) {
+        Console.printf("ERROR: %s\n", sweepPresetErrorText(error));
+        return error == SWEEP_PRESET_STORAGE ? "storage" : "invalid";
+    }
+    Console.printf("Preset %s deleted\n", args);
+    return nullptr;
+}
+
+static const char* cmdRepeats(const char* args) {
+    if (args[0] != '\0') {
+        if (measurementInProgress || isMonitorActive()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        if (!setSweepRepeats(atoi(args))) {
+            return "invalid";
+        }
+    }
+    Console.printf("Repeats: %d per frequency (%lu rejected in the last sweep)\n",
+                  getSweepRepeats(), (unsigned long)getRejectedRepeatCount());
+    return nullptr;
+}
+
+static const char* cmdAdaptive(const char* args) {
+    if (args[0] != '\0') {
+        if (measurementInProgress || isMonitorActive()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        if (strcmp(args, "reset") == 0) {
+            resetRepeatPlan();
+        } else {
+            bool adaptive = isAdaptiveRepeats();
+            parseOnOff(args, adaptive);
+            setAdaptiveRepeats(adaptive);
+        }
+    }
+    printRepeatPlan();
+    return nullptr;
+}
+
+static const char* cmdRefine(const char* args) {
+    if (args[0] != '\0') {
+        if (measurementInProgress || isMonitorActive()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        bool refine = isSweepRefinement();
+        parseOnOff(args, refine);
+        setSweepRefinement(refine);
+    }
+    printSweepRefinement();
+    return nullptr;
+}
+
+// lotref [on|off|clear|save <name> [|Z| %] [phase deg]]
+static const char* cmdLotRef(const char* args) {
+    if (args[0] != '\0') {
+        if (measurementInProgress || isMonitorActive()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        if (strncmp(args, "save ", 5) == 0) {
+            char name[LOT_REF_NAME_MAX];
+            float magTol = LOT_REF_MAG_TOL_PCT;
+            float phaseTol = LOT_REF_PHASE_TOL_DEG;
+            if (sscanf(args + 5, "%15s %f %f", name, &magTol, &phaseTol) < 1) {
+                return "invalid";
+            }
+            if (!baselineMeasurementDone) {
+                Console.println("ERROR: Baseline measurement needs to be done first");
+                return "no_baseline";
+            }
+            if (!saveLotReference(name, num_duts, magTol, phaseTol)) {
+                return "empty";
             }
+        } else if (strcmp(args, "clear") == 0) {
+            clearLotReference();
+        } else {
+            bool enable = isLotReferenceEnabled();
+            parseOnOff(args, enable);
+            setLotReferenceEnabled(enable);
         }
+    }
+    printLotReference();
+    return nullptr;
+}
 
-        Serial.printf("Starting measurement with %d DUT%s...\n", num_duts, num_duts > 1 ? "s" : "");
+static const char* cmdRecalc(const char* args) {
+    if (measurementInProgress || isMonitorActive()) {
+        Console.println("ERROR: Measurement in progress");
+        return "busy";
+    }
+    if (!finalMeasurementDone) {
+        Console.println("ERROR: Final measurement needs to be done first");
+        return "no_final";
+    }
+    float startHz, endHz, low, medium, high;
+    if (sscanf(args, "%f %f %f %f %f", &startHz, &endHz, &low, &medium, &high) != 5 || !(startHz > 0.0f) ||
+        endHz < startHz || low < 0.0f || medium < low || high < medium) {
+        return "invalid";
+    }
+    calcStartFreq = startHz;
+    calcEndFreq = endHz;
+    lowRiskCutoff = low;
+    mediumRiskCutoff = medium;
+    highRiskCutoff = high;
 
-        // Clear previous measurement data
-        Serial.println("Clearing measurement buffers...");
-        for (int i = 0; i < MAX_DUT_COUNT; i++) {
-            frequencyCount[i] = 0;
-            // Optionally clear impedance data array
-            for (int j = 0; j < MAX_FREQUENCIES; j++) {
-                if (baselineMeasurementDone) {
-                    measurementImpedanceData[i][j] = ImpedancePoint();
-                } else {
-                    baselineImpedanceData[i][j] = ImpedancePoint();
-                }
+    uint32_t startUs = micros();
+    int changed = 0;
+    for (uint8_t dut = 0; dut < num_duts; dut++) {
+        if (recalculateRiskLevel(dut, (uint32_t)calcStartFreq, (uint32_t)calcEndFreq)) {
+            changed++;
+            sendBLERisk(dut);
+            showDUTResult(dut);
+            Console.printf("DUT %d: risk %d, %.1f%%\n", dut + 1, (int)riskLevels[dut], riskPercentages[dut]);
+        }
+    }
+    Console.printf("Recalculated %.0f-%.0f Hz, L=%.3f M=%.3f H=%.3f: %d of %u DUTs changed (%lu us)\n",
+                   calcStartFreq, calcEndFreq, lowRiskCutoff, mediumRiskCutoff, highRiskCutoff, changed, num_duts,
+                   (unsigned long)(micros() - startUs));
+    return nullptr;
+}
+
+static const char* cmdChannels(const char* args) {
+    if (args[0] != '\0') {
+        char* rest;
+        int duts = strtol(args, &rest, 10);
+        int points = *rest == ' ' ? atoi(rest + 1) : getPointsPerDUT();
+
+        if (measurementInProgress || isMonitorActive()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        if (!configureMeasurementStore(duts, points)) {
+            return "invalid";
+        }
+        // The old rows are gone - a new baseline is needed
+        resetMeasurementResults();
+        if (selectedDUTCount > duts) {
+            selectedDUTCount = duts;
+        }
+        if (!saveMeasurementStoreConfig()) {
+            Console.println("WARNING: Failed to store channel configuration");
+        }
+    }
+    printMeasurementStore();
+    return nullptr;
+}
+
+static const char* cmdHistory(const char* args) {
+    printSessions();
+    return nullptr;
+}
+
+static const char* cmdHistoryFlush(const char* args) {
+    if (!flushSessions()) {
+        return "failed";
+    }
+    Console.println("Sessions written to " SESSION_LOG_FILE);
+    return nullptr;
+}
+
+static const char* cmdCalReload(const char* args) {
+    if (isCalUploadInProgress()) {
+        Console.println("ERROR: Calibration upload in progress");
+        return "busy";
+    }
+    reloadCalibration();
+    return nullptr;
+}
+
+static const char* cmdCalSets(const char* args) {
+    printCalibrationSets();
+    return nullptr;
+}
+
+// The current selection's indices that lack a calibrated gain combination
+static const char* cmdCalCoverage(const char* args) {
+    SweepMask plan = customSweepMask != 0 ? customSweepMask : getSweepRangeMask(0, SWEEP_FREQ_COUNT - 1);
+    Console.printf("Calibration coverage (gain limits %s):\n", isGainLimits() ? "on" : "off");
+    printCalibrationCoverage(plan);
+    return nullptr;
+}
+
+static const char* cmdCalSet(const char* args) {
+    const char* name = strcmp(args, "default") == 0 ? "" : args;
+    if (isCalUploadInProgress()) {
+        Console.println("ERROR: Calibration upload in progress");
+        return "busy";
+    }
+    if (!storeCalibrationSet(name)) {
+        Console.printf("ERROR: Invalid calibration set '%s'\n", name);
+        return "invalid";
+    }
+    reloadCalibration();
+    return nullptr;
+}
+
+static const char* cmdCalAcquire(const char* args) {
+    float ohms = args[0] != '\0' ? atof(args) : CAL_ACQUIRE_REF_OHMS;
+    if (!(ohms > 0.0f)) {
+        Console.println("ERROR: Usage: cal acquire [reference ohms]");
+        return "invalid";
+    }
+    return startCalAcquire(ohms) ? nullptr : "busy";
+}
+
+static const char* cmdCalSelfTest(const char* args) {
+    runFixedCalibrationSelfTest();
+    return nullptr;
+}
+
+static const char* cmdBench(const char* args) {
+    // Calibration tables and rows are only stable with no sweep or upload
+    if (!measurementIdle() || isCalUploadInProgress()) {
+        Console.println("ERROR: Measurement in progress");
+        return "busy";
+    }
+    runMicroBenchmarks();
+    return nullptr;
+}
+
+#if SWEEP_BENCH
+// bench sweep [n] - the throughput workloads, or the last results while one runs
+static const char* cmdBenchSweep(const char* args) {
+    if (args[0] == '\0' && isSweepBenchRunning()) {
+        printSweepBench();
+        return nullptr;
+    }
+    if (!measurementIdle() || runTotal > 0 || isRecipeRunning()) {
+        Console.println("ERROR: Measurement in progress");
+        return "busy";
+    }
+    long sweeps = args[0] != '\0' ? strtol(args, nullptr, 10) : SWEEP_BENCH_SWEEPS;
+    return startSweepBench(sweeps > 0 && sweeps <= UINT16_MAX ? sweeps : 0) ? nullptr : "invalid";
+}
+#endif
+
+#if WIFI_SERVER
+// wifi on / wifi off / wifi <ssid>[,<passphrase>] - same as the BLE WIFI command
+static const char* cmdWiFi(const char* args) {
+    bool ok = true;
+    if (strcmp(args, "on") == 0 || strcmp(args, "off") == 0) {
+        ok = setWiFiEnabled(args[1] == 'n');
+    } else if (args[0] != '\0') {
+        char network[WIFI_SSID_MAX + 1];
+        const char* comma = strchr(args, ',');
+        size_t len = comma != nullptr ? comma - args : strlen(args);
+        ok = len <= WIFI_SSID_MAX;
+        if (ok) {
+            memcpy(network, args, len);
+            network[len] = '\0';
+            ok = setWiFiNetwork(network, comma != nullptr ? comma + 1 : "");
+        }
+    }
+    char status[40];
+    getWiFiStatus(status, sizeof(status));
+    Console.printf("Wi-Fi: %s, %d live client(s), %lu live frame(s) dropped\n", status,
+                  getWiFiLiveClients(), (unsigned long)getWiFiLiveDrops());
+    return ok ? nullptr : "invalid";
+}
+#endif
+
+#if FLEET_AGGREGATOR
+static const char* cmdFleet(const char* args) {
+    bool ok = true;
+    if (args[0] != '\0') {
+        bool enable = isFleetEnabled();
+        parseOnOff(args, enable);
+        ok = setFleetEnabled(enable);
+    }
+    printFleetStatus();
+    return ok ? nullptr : "invalid";
+}
+#endif
+
+#if THREAD_UPLINK
+// thread on / thread off / thread <channel>,<PAN ID>,<ext PAN ID>,<key> /
+// thread dest <IPv6>[,<port>] - same as the BLE THREAD and THREAD_DEST commands
+static const char* cmdThread(const char* args) {
+    bool ok = true;
+    if (strcmp(args, "on") == 0 || strcmp(args, "off") == 0) {
+        ok = setThreadEnabled(args[1] == 'n');
+    } else if (strncmp(args, "dest ", 5) == 0) {
+        char address[THREAD_ADDR_MAX];
+        const char* comma = strchr(args + 5, ',');
+        size_t len = comma != nullptr ? comma - (args + 5) : strlen(args + 5);
+        unsigned long port = comma != nullptr ? strtoul(comma + 1, nullptr, 10) : THREAD_DEFAULT_PORT;
+        ok = len < sizeof(address) && port <= 65535;
+        if (ok) {
+            memcpy(address, args + 5, len);
+            address[len] = '\0';
+            ok = setThreadDestination(address, port);
+        }
+    } else if (args[0] != '\0') {
+        ok = setThreadNetwork(args);
+    }
+    printThreadStatus();
+    return ok ? nullptr : "invalid";
+}
+#endif
+
+#if STM32_SIM
+static const char* cmdSim(const char* args) {
+    if (args[0] != '\0') {
+        STM32SimMode mode;
+        if (strcmp(args, "off") == 0) {
+            mode = SIM_OFF;
+        } else if (strcmp(args, "loop") == 0) {
+            mode = SIM_LOOPBACK;
+        } else if (strcmp(args, "tx") == 0) {
+            mode = SIM_TX;
+        } else {
+            Console.println("ERROR: Use sim off, sim loop or sim tx");
+            return "invalid";
+        }
+        if (!measurementIdle()) {
+            Console.println("ERROR: Measurement in progress");
+            return "busy";
+        }
+        setSTM32SimMode(mode);
+    }
+    printSTM32SimStatus();
+    return nullptr;
+}
+
+static const char* cmdSimSet(const char* args) {
+    char* rest;
+    long pointMs = strtol(args, &rest, 10);
+    float noise = *rest == ' ' ? strtof(rest + 1, &rest) : 0.0f;
+    long duts = *rest == ' ' ? strtol(rest + 1, &rest, 10) : 0;
+    if (rest == args || *rest != '\0' || pointMs < 0 || noise < 0.0f || duts < 0 || duts > MAX_DUT_COUNT) {
+        Console.println("ERROR: sim set <ms per point> [noise %] [duts]");
+        return "invalid";
+    }
+    setSTM32SimParams(pointMs, noise, duts);
+    printSTM32SimStatus();
+    return nullptr;
+}
+
+static const char* cmdSimHang(const char* args) {
+    char* rest;
+    long points = strtol(args, &rest, 10);
+    if (rest == args || *rest != '\0' || points < 0) {
+        Console.println("ERROR: sim hang <points> (0 = off)");
+        return "invalid";
+    }
+    setSTM32SimHang(points);
+    printSTM32SimStatus();
+    return nullptr;
+}
+
+static const char* cmdSimDrop(const char* args) {
+    char* rest;
+    long every = strtol(args, &rest, 10);
+    if (rest == args || *rest != '\0' || every < 0) {
+        Console.println("ERROR: sim drop <n> (0 = off)");
+        return "invalid";
+    }
+    setSTM32SimDrop(every);
+    printSTM32SimStatus();
+    return nullptr;
+}
+
+static const char* cmdSimEmpty(const char* args) {
+    char* rest;
+    unsigned long mask = strtoul(args, &rest, 0);
+    if (rest == args || *rest != '\0') {
+        Console.println("ERROR: sim empty <mask> (bit 0 = DUT 1, 0 = none)");
+        return "invalid";
+    }
+    setSTM32SimEmpty(mask);
+    printSTM32SimStatus();
+    return nullptr;
+}
+#endif
+
+static const char* cmdExport(const char* args) {
+    return sendBinaryExport() ? nullptr : "empty";
+}
+
+static const char* cmdExportCsv(const char* args) {
+    uint16_t columns = args[0] != '\0' ? parseCSVColumns(args) : CSV_COLS_DEFAULT;
+    if (columns == 0) {
+        Console.println("ERROR: Columns are freq,mag,phase,gain,sweep,valid,spread,risk or all");
+        return "invalid";
+    }
+    printCSVToSerial(columns);
+    return nullptr;
+}
+
+// Final rows once measured, else the baseline
+static const char* cmdExportPsSession(const char* args) {
+    bool final = finalMeasurementDone;
+    if (strcmp(args, "baseline") == 0) {
+        final = false;
+    } else if (strcmp(args, "final") == 0) {
+        final = true;
+    } else if (args[0] != '\0') {
+        return "invalid";
+    }
+    return sendPsSessionExport(final) ? nullptr : "empty";
+}
+
+// Same fields as BLE GET_DATA, any case - JSON lines only (binary: "export")
+static const char* cmdData(const char* args) {
+    char fields[48];
+    size_t len = strlen(args);
+    if (len >= sizeof(fields)) {
+        return "invalid";
+    }
+    for (size_t i = 0; i <= len; i++) {
+        fields[i] = toupper((unsigned char)args[i]);
+    }
+    BLEDataQuery query;
+    if (!parseBLEDataQuery(len > 0 ? fields : nullptr, query) || query.format == 1) {
+        Console.println("ERROR: data [<dut hex mask>,<cur|base|final>,<min Hz>-<max Hz>]");
+        return "invalid";
+    }
+    int sent = printDataQuery(query);
+    Console.printf("%d DUT%s\n", sent, sent == 1 ? "" : "s");
+    return nullptr;
+}
+
+static const char* cmdBoot(const char* args) {
+    printBootTimes();
+    return nullptr;
+}
+
+static const char* cmdOTA(const char* args) {
+    printOTAStatus();
+    return nullptr;
+}
+
+static const char* cmdPower(const char* args) {
+    printPowerReport();
+    return nullptr;
+}
+
+static const char* cmdTasks(const char* args) {
+    printTaskStats();
+    return nullptr;
+}
+
+static const char* cmdHelp(const char* args);
+
+/*=========================COMMAND TABLE=========================*/
+// A line matches an entry when it equals name, or - for entries that take
+// arguments - starts with name and a space. help prints the table in order
+struct SerialCommand {
+    const char* name;
+    bool takesArgs;
+    const char* (*handler)(const char* args);
+    const char* usage;
+    const char* help;
+};
+
+static const SerialCommand commands[] = {
+    {"start",         true,  cmdStart,        "start [num_duts]",   "Start measurement (default all channels, or specify 1-n)"},
+    {"stop",          false, cmdStop,         "stop",               "Stop measurement (and a run)"},
+    {"run",           true,  cmdRun,          "run <n> [duts]",     "n sweeps back to back: a baseline if none is stored, then final sweeps"},
+    {"status",        false, cmdStatus,       "status",             "One @STATUS line: sweep state, results, plan, run progress"},
+    {"pga",           true,  cmdPGA,          "pga <0-7>",          "Set the STM32 PGA gain index (between sweeps)"},
+    {"tia",           true,  cmdTIA,          "tia <high|low>",     "Set the STM32 TIA gain (between sweeps)"},
+    {"mux",           true,  cmdMux,          "mux <channel>",      "Set the STM32 MUX channel, 0-based (between sweeps)"},
+    {"trace dump",    false, cmdTraceDump,    "trace dump",         "Dump binary trace ring (decode with trace_decode.py)"},
+    {"trace clear",   false, cmdTraceClear,   "trace clear",        "Clear trace ring"},
+    {"prof start",    true,  cmdProfStart,    "prof start [hz]",    "Sample PC and task at hz (default 997) into a ring"},
+    {"prof stop",     false, cmdProfStop,     "prof stop",          "Stop sampling"},
+    {"prof dump",     false, cmdProfDump,     "prof dump",          "Dump the samples (report with profile_report.py)"},
+    {"prof",          false, cmdProf,         "prof",               "Profiler state and sample count"},
+    {"raw dump",      false, cmdRawDump,      "raw dump",           "Dump captured raw points (decode with raw_capture_decode.py)"},
+    {"raw recal",     false, cmdRawRecal,     "raw recal",          "Calibrate the captured sweeps again with the active calibration, into their rows"},
+    {"raw clear",     false, cmdRawClear,     "raw clear",          "Clear captured raw points"},
+    {"raw",           true,  cmdRaw,          "raw [on|off]",       "Keep STM32 points uncalibrated in a ring instead of storing sweeps"},
+    {"stats",         false, cmdStats,        "stats",              "Show sweep latency and heap statistics"},
+    {"stats reset",   false, cmdStatsReset,   "stats reset",        "Clear sweep latency and heap statistics"},
+    {"counters",      false, cmdCounters,     "counters",           "Show the field counters and histograms"},
+    {"counters reset", false, cmdCountersReset, "counters reset",   "Clear the field counters"},
+    {"sweep",         true,  cmdSweep,        "sweep [sel|all]",    "Sweep only indices <sel> (0x mask or list, e.g. 0,3,6)"},
+    {"interleave",    true,  cmdInterleave,   "interleave [on|off]", "Sweep all DUTs per frequency (needs STM32 support)"},
+    {"indexed",       true,  cmdIndexed,      "indexed [on|off]", "Frames carry sweep index and sequence (needs STM32 support)"},
+    {"blocks",        true,  cmdBlocks,       "blocks [on|off]",    "Several points per frame, DUT-by-DUT sweeps (needs STM32 support)"},
+    {"compact",       true,  cmdCompact,      "compact [on|off]",   "Quantized block points, half the bytes (needs STM32 support)"},
+    {"gainhints",     true,  cmdGainHints,    "gainhints [on|off]", "Start final sweeps at the baseline's gains (needs STM32 support)"},
+    {"gainlimits",    true,  cmdGainLimits,   "gainlimits [on|off]", "Autorange only over calibrated gains (needs STM32 support)"},
+    {"credits",       true,  cmdCredits,      "credits [on|off]",   "STM32 holds frames the ESP32 has no room for (needs STM32 support)"},
+    {"linktune",      true,  cmdLinkTune,     "linktune [on|off|now]", "Pick the fastest rate the cable passes a link test at (needs STM32 support)"},
+    {"fast",          true,  cmdFast,         "fast [on|off]",      "End final DUT sweeps once the risk is certain"},
+    {"metrics",       true,  cmdMetrics,      "metrics [fields]",   "Show results / set mask,marker,split lo,split hi,thresholds"},
+    {"preset save",   true,  cmdPresetSave,   "preset save <n> [f]", "Store the BASELINE_START fields f, repeats and metrics as preset n"},
+    {"preset del",    true,  cmdPresetDel,    "preset del <name>",  "Remove a stored sweep preset"},
+    {"preset",        true,  cmdPreset,       "preset [name]",      "List sweep presets / start a baseline from one"},
+    {"repeats",       true,  cmdRepeats,      "repeats [n]",        "Measure each frequency n times and average (needs STM32 support)"},
+    {"adaptive",      true,  cmdAdaptive,     "adaptive [on|off|reset]", "Repeats per frequency learned from the noise (needs STM32 support)"},
+    {"refine",        true,  cmdRefine,       "refine [on|off]",    "Coarse baseline, then only where the spectrum bends"},
+    {"lotref",        true,  cmdLotRef,       "lotref [on|off|clear|save <name> [%] [deg]]",
+     "Baseline from the lot reference if a short sweep is in band / save it from the baseline"},
+    {"recalc",        true,  cmdRecalc,       "recalc <start> <end> <l> <m> <h>",
+     "Risk of the stored final sweep with a new band (Hz) and cutoffs (fractions)"},
+    {"channels",      true,  cmdChannels,     "channels [n [pts]]", "Show / set channel count and points per sweep (stored)"},
+    {"monitor",       true,  cmdMonitor,      "monitor [s [h]|off]", "Repeat the final sweep every s seconds, report changes only; h: track the baseline (half-life h sweeps)"},
+#if SLEEP_MONITOR
+    {"sleep",         true,  cmdSleep,        "sleep [s [h]|off]",  "Monitor every s seconds in deep sleep between sweeps (SLEEP_MONITOR)"},
+#endif
+    {"recipe",        true,  cmdRecipe,       "recipe [steps|run|stop]",
+     "Show / store a sweep recipe (e.g. B,W300,M,L2x6,E) / run / stop it"},
+    {"history",       false, cmdHistory,      "history",            "List archived sweeps (newest first)"},
+    {"history flush", false, cmdHistoryFlush, "history flush",      "Retry sessions not yet in flash"},
+    {"cal reload",    false, cmdCalReload,    "cal reload",         "Reload calibration from flash without reboot"},
+    {"cal sets",      false, cmdCalSets,      "cal sets",           "List calibration sets and the STM32 ID"},
+    {"cal coverage",  false, cmdCalCoverage,  "cal coverage",       "Indices of the selection with uncalibrated gain combinations"},
+    {"cal set",       true,  cmdCalSet,       "cal set [name]",     "Use set <name> (no name or 'default' = STM32 ID)"},
+    {"cal acquire",   true,  cmdCalAcquire,   "cal acquire [ohms]", "Calibrate against a reference resistor on channel 1, write the image"},
+    {"cal selftest",  false, cmdCalSelfTest,  "cal selftest",       "Compare fixed-point and float calibration"},
+#if STM32_SIM
+    {"sim drop",      true,  cmdSimDrop,      "sim drop <n>",       "Virtual STM32: next sweep loses every n-th point (0 = off)"},
+    {"sim empty",     true,  cmdSimEmpty,     "sim empty <mask>",   "Virtual STM32: DUTs of mask read as empty slots (0 = none)"},
+    {"sim hang",      true,  cmdSimHang,      "sim hang <n>",       "Virtual STM32: next sweep goes silent after n points (0 = off)"},
+    {"sim set",       true,  cmdSimSet,       "sim set <ms> [n d]", "Virtual STM32: ms per point, noise n % of |Z|, d DUTs (0 = as started)"},
+    {"sim",           true,  cmdSim,          "sim [off|loop|tx]",  "Virtual STM32 in loopback / as another board's STM32 (STM32_SIM)"},
+#endif
+#if WIFI_SERVER
+    {"wifi",          true,  cmdWiFi,         "wifi [on|off|ssid,pass]", "Wi-Fi history / live server: switch, provision, show the address"},
+#endif
+#if FLEET_AGGREGATOR
+    {"fleet",         true,  cmdFleet,        "fleet [on|off]",     "Relay the results of nearby BioPals to this board's clients (FLEET_AGGREGATOR)"},
+#endif
+#if THREAD_UPLINK
+    {"thread",        true,  cmdThread,       "thread [on|off|net|dest a,p]", "Thread telemetry uplink: switch, network ch,pan,xpan,key, collector"},
+#endif
+    {"mirror",        true,  cmdMirror,       "mirror [usb|wifi|off]", "Mirror the screen as changed tiles (screen_mirror_view.py)"},
+    {"export",        false, cmdExport,       "export",             "Send the stored rows as binary frames (usb_export_decode.py)"},
+    {"data",          true,  cmdData,         "data [d,r,lo-hi]",   "Stored rows as DATA JSON: DUT hex mask, cur|base|final, Hz range"},
+    {"export csv",    true,  cmdExportCsv,    "export csv [cols]",  "Baseline and final rows as CSV (cols e.g. freq,mag,risk or all)"},
+    {"export pssession", true, cmdExportPsSession, "export pssession [baseline|final]",
+     "PalmSens .pssession of the final (or baseline) rows as binary frames"},
+    {"boot",          false, cmdBoot,         "boot",               "Show the boot stage timeline"},
+    {"ota",           false, cmdOTA,          "ota",                "Running firmware slot, its state and an update in progress"},
+    {"power",         false, cmdPower,        "power",              "Time per power / display state, estimated current"},
+    {"tasks",         false, cmdTasks,        "tasks",              "Task priorities, free stack and CPU time"},
+#if SWEEP_BENCH
+    {"bench sweep",   true,  cmdBenchSweep,   "bench sweep [n]",    "Sweeps/hour, latency, heap and CPU of 1/4/16-DUT sweeps on the virtual STM32 (pio run -e bench_sweep)"},
+#endif
+    {"bench",         false, cmdBench,        "bench",              "Time the calibration, risk, BLE and screen kernels (pio run -e bench)"},
+    {"help",          false, cmdHelp,         "help",               "Show this help message"},
+};
+
+static const char* cmdHelp(const char* args) {
+    Console.println("\n=== Available Commands ===");
+    for (const SerialCommand& command : commands) {
+        Console.printf("%-19s - %s\n", command.usage, command.help);
+    }
+    Console.println("#<tag> <command>    - Same, answered @OK <tag> / @ERR <tag> <reason> when done");
+    Console.println("========================\n");
+    return nullptr;
+}
+
+// Table entry for a line, with args set to its arguments
+static const SerialCommand* findCommand(const char* line, const char*& args) {
+    for (const SerialCommand& command : commands) {
+        size_t len = strlen(command.name);
+        if (strncmp(line, command.name, len) != 0) {
+            continue;
+        }
+        if (line[len] == '\0') {
+            args = "";
+            return &command;
+        }
+        if (line[len] == ' ' && command.takesArgs) {
+            args = line + len;
+            while (*args == ' ') {
+                args++;
             }
+            return &command;
         }
-        Serial.println("Buffers cleared - ready for new measurement");
+    }
+    return nullptr;
+}
 
-        sendStartCommand(num_duts);
+// "[#<tag> ]<command>" - a tagged line is answered with one @OK/@ERR line
+// after all of its output, so a test script can run commands back to back
+static void dispatchCommand(char* line) {
+    const char* tag = nullptr;
+    if (line[0] == '#') {
+        tag = line + 1;
+        line = strchr(line, ' ');
+        if (line == nullptr) {
+            Console.printf("@ERR %s no_command\n", tag);
+            return;
+        }
+        *line++ = '\0';
+    } else {
+        Console.printf("Received command: '%s'\n", line);
+    }
+
+    const char* args;
+    const SerialCommand* command = findCommand(line, args);
+    const char* error = command != nullptr ? command->handler(args) : "unknown";
+    if (command == nullptr) {
+        Console.printf("ERROR: Unknown command '%s'. Type 'help' for available commands.\n", line);
+    }
+    if (tag != nullptr) {
+        if (error == nullptr) {
+            Console.printf("@OK %s\n", tag);
+        } else {
+            Console.printf("@ERR %s %s\n", tag, error);
+        }
     }
-    else if (cmdLine.equals("stop")) {
-        Serial.println("Stopping measurement...");
-        sendStopCommand();
+}
+
+/*=========================LINE READER=========================*/
+// Bytes are collected as they arrive - a partial line never blocks the GUI
+// task, it is finished by a later RX event
+static char line[CMD_BUFFER_SIZE];
+static size_t lineLength = 0;
+static bool lineOverflow = false;   // Drop the rest of a too long line
+
+static void finishLine() {
+    // Trim trailing whitespace (leading whitespace is never stored)
+    while (lineLength > 0 && line[lineLength - 1] == ' ') {
+        lineLength--;
     }
-    else if (cmdLine.equals("help")) {
-        Serial.println("\n=== Available Commands ===");
-        Serial.println("start [num_duts]  - Start measurement (default 4 DUTs, or specify 1-4)");
-        Serial.println("stop              - Stop measurement");
-        Serial.println("help              - Show this help message");
-        Serial.println("========================\n");
+    line[lineLength] = '\0';
+    if (lineOverflow) {
+        Console.printf("ERROR: Command longer than %d characters ignored\n", CMD_BUFFER_SIZE - 1);
+    } else if (lineLength > 0) {
+        dispatchCommand(line);
     }
-    else {
-        Serial.printf("ERROR: Unknown command '%s'. Type 'help' for available commands.\n", cmdLine.c_str());
+    lineLength = 0;
+    lineOverflow = false;
+}
+
+void processSerialCommands() {
+    int available = Serial.available();
+    while (available-- > 0) {
+        int c = Serial.read();
+        if (c < 0) {
+            break;
+        }
+        if (c == '\n' || c == '\r') {
+            finishLine();
+        } else if ((c == ' ' || c == '\t') && lineLength == 0) {
+            // Leading whitespace
+        } else if (lineLength < CMD_BUFFER_SIZE - 1) {
+            line[lineLength++] = c == '\t' ? ' ' : (char)c;
+        } else {
+            lineOverflow = true;
+        }
     }
 }
@@ -0,0 +1,162 @@
+#include "session_codec.h"
+#include "crc.h"
+
+/*=========================POINT CODING=========================*/
+
+static int32_t magCode(float mag) {
+    if (!isfinite(mag) || mag < SESSION_MAG_MIN) {
+        mag = SESSION_MAG_MIN;
+    }
+    return lroundf(logf(mag) * SESSION_MAG_STEPS_PER_LN);
+}
+
+static float magValue(int32_t code) {
+    return expf(code / (float)SESSION_MAG_STEPS_PER_LN);
+}
+
+static int32_t phaseCode(float phase) {
+    return isfinite(phase) ? lroundf(phase / SESSION_PHASE_STEP_DEG) : 0;
+}
+
+static float phaseValue(int32_t code) {
+    return code * SESSION_PHASE_STEP_DEG;
+}
+
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static size_t putVarint(uint8_t* out, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (v & 0x7F) | 0x80;
+        v >>= 7;
+    }
+    out[n++] = v;
+    return n;
+}
+
+struct CodeReader {
+    const uint8_t* data;
+    size_t len;
+    size_t pos;
+    bool ok;
+};
+
+static uint32_t getVarint(CodeReader& r) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (r.pos >= r.len) {
+            r.ok = false;
+            return 0;
+        }
+        uint8_t byte = r.data[r.pos++];
+        v |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return v;
+        }
+    }
+    r.ok = false;
+    return 0;
+}
+
+void quantizeSessionPoints(Session& session) {
+    for (int i = 0; i < session.header.count; i++) {
+        session.points[i].mag = magValue(magCode(session.points[i].mag));
+        session.points[i].phase = phaseValue(phaseCode(session.points[i].phase));
+    }
+}
+
+bool sessionMatchesReference(const Session& session, const Session& ref) {
+    if (session.header.count != ref.header.count) {
+        return false;
+    }
+    for (int i = 0; i < session.header.count; i++) {
+        if (session.points[i].freq_hz != ref.points[i].freq_hz) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t encodeSessionPoints(const Session& session, const Session* ref, uint8_t* out) {
+    size_t n = 0;
+    int32_t prevFreq = 0, prevMag = 0, prevPhase = 0;
+    for (int i = 0; i < session.header.count; i++) {
+        const SessionPoint& point = session.points[i];
+        int32_t mag = magCode(point.mag);
+        int32_t phase = phaseCode(point.phase);
+        if (ref != nullptr) {
+            mag -= magCode(ref->points[i].mag);
+            phase -= phaseCode(ref->points[i].phase);
+        } else {
+            n += putVarint(out + n, zigzag((int32_t)point.freq_hz - prevFreq));
+            prevFreq = point.freq_hz;
+        }
+        n += putVarint(out + n, zigzag(mag - prevMag));
+        n += putVarint(out + n, zigzag(phase - prevPhase));
+        prevMag = mag;
+        prevPhase = phase;
+    }
+
+    // Flags against the reference's, or the point before
+    uint8_t changes = 0;
+    for (int i = 0; i < session.header.count; i++) {
+        uint8_t base = ref != nullptr ? ref->points[i].flags : i > 0 ? session.points[i - 1].flags : 0;
+        changes += session.points[i].flags != base ? 1 : 0;
+    }
+    n += putVarint(out + n, changes);
+    for (int i = 0; i < session.header.count; i++) {
+        uint8_t base = ref != nullptr ? ref->points[i].flags : i > 0 ? session.points[i - 1].flags : 0;
+        if (session.points[i].flags != base) {
+            n += putVarint(out + n, i);
+            n += putVarint(out + n, session.points[i].flags ^ base);
+        }
+    }
+    return n;
+}
+
+bool decodeSessionPoints(const SessionHeader& header, const uint8_t* data, const Session* ref, Session& out) {
+    memset(&out, 0, sizeof(out));
+    out.header = header;
+    CodeReader r = {data, header.bytes, 0, true};
+    int32_t freq = 0, mag = 0, phase = 0;
+    for (int i = 0; i < header.count; i++) {
+        if (ref == nullptr) {
+            freq += unzigzag(getVarint(r));
+        }
+        mag += unzigzag(getVarint(r));
+        phase += unzigzag(getVarint(r));
+        SessionPoint& point = out.points[i];
+        point.freq_hz = ref != nullptr ? ref->points[i].freq_hz : (uint32_t)freq;
+        point.mag = magValue(ref != nullptr ? mag + magCode(ref->points[i].mag) : mag);
+        point.phase = phaseValue(ref != nullptr ? phase + phaseCode(ref->points[i].phase) : phase);
+    }
+    // Self-contained flags follow the point before - apply the changes in order
+    uint32_t changes = getVarint(r);
+    uint8_t xorMask[MAX_FREQUENCIES] = {};
+    for (uint32_t k = 0; k < changes && r.ok; k++) {
+        uint32_t i = getVarint(r);
+        uint32_t mask = getVarint(r);
+        if (i >= header.count) {
+            return false;
+        }
+        xorMask[i] = mask;
+    }
+    for (int i = 0; i < header.count; i++) {
+        uint8_t base = ref != nullptr ? ref->points[i].flags : i > 0 ? out.points[i - 1].flags : 0;
+        out.points[i].flags = base ^ xorMask[i];
+    }
+    return r.ok && r.pos == r.len;
+}
+
+uint16_t sessionRecordCrc(const SessionHeader& header, const uint8_t* data) {
+    SessionHeader copy = header;
+    copy.crc = 0;
+    uint16_t crc = crc16_ccitt((const uint8_t*)&copy, sizeof(copy));
+    return crc16_ccitt(data, header.bytes, crc);
+}
@@ -0,0 +1,447 @@
+#include "session_log.h"
+#include "console.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "storage.h"
+#include <LittleFS.h>
+
+#define RECORD_BYTES_MAX    (sizeof(SessionHeader) + SESSION_DATA_MAX)
+
+static_assert(RECORD_BYTES_MAX <= STORAGE_ITEM_MAX, "A record must fit one storage append");
+static_assert(SESSION_DATA_MAX <= 0xFFFF, "SessionHeader.bytes");
+
+static Session ring[SESSION_RAM_DEPTH];
+static bool ringPending[SESSION_RAM_DEPTH];    // Flash append still to do
+static uint8_t ringHead = 0;        // Next slot to write
+static uint8_t ringCount = 0;
+
+// Records and bytes of the segments, read from the files on the first mount
+static bool segmentsLoaded = false;
+static int logRecords = 0;
+static int oldRecords = 0;
+static uint32_t logBytes = 0;
+static uint32_t oldBytes = 0;
+
+// Per DUT: offset of the newest self-contained record in SESSION_LOG_FILE
+static uint32_t referenceOffset[MAX_DUT_COUNT];
+
+static uint32_t clockOffset = 0;    // Unix seconds at boot, 0 = clock not set
+
+/*=========================CLOCK=========================*/
+
+void setSessionClock(uint32_t unixSeconds) {
+    clockOffset = unixSeconds - millis() / 1000;
+    Console.printf("Session clock set to %lu\n", (unsigned long)unixSeconds);
+}
+
+uint32_t getSessionTime() {
+    return clockOffset + millis() / 1000;
+}
+
+/*=========================SEGMENTS=========================*/
+// Files of the two segments, each a log and its index
+
+static size_t fileSize(const char* path) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return 0;
+    }
+    size_t size = file.size();
+    file.close();
+    return size;
+}
+
+static void removeFile(const char* path) {
+    if (LittleFS.exists(path)) {
+        LittleFS.remove(path);
+    }
+}
+
+static bool readAt(const char* path, size_t offset, void* dest, size_t len) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+    bool ok = file.seek(offset) && file.read((uint8_t*)dest, len) == len;
+    file.close();
+    return ok;
+}
+
+// Header of the record at offset, if it is one
+static bool readHeaderAt(const char* logPath, uint32_t offset, SessionHeader& header) {
+    return readAt(logPath, offset, &header, sizeof(header)) && isSessionHeader(header, offset);
+}
+
+// The record at offset of a log, decoded; false if it or its reference is damaged
+static bool readSession(const char* logPath, uint32_t offset, Session& out, bool asReference = false) {
+    static uint8_t data[SESSION_DATA_MAX];
+    static Session ref;
+    SessionHeader header;
+    if (!readHeaderAt(logPath, offset, header)) {
+        return false;
+    }
+    // References are self-contained - read before data, which the call reuses
+    bool coded = header.reference != SESSION_NO_REFERENCE;
+    if (coded && (asReference || header.reference >= offset || !readSession(logPath, header.reference, ref, true))) {
+        return false;
+    }
+    if (!readAt(logPath, offset + sizeof(header), data, header.bytes) || sessionRecordCrc(header, data) != header.crc) {
+        return false;
+    }
+    return decodeSessionPoints(header, data, coded ? &ref : nullptr, out);
+}
+
+// Write the index of a log again by walking its records; after a damaged
+// record the walk resyncs on the next header that names its own offset.
+// Returns the records
+static int rebuildIndex(const char* logPath, const char* indexPath, uint32_t size) {
+    Console.printf("Session index %s out of step - rebuilding\n", indexPath);
+    removeFile(indexPath);
+    File index = LittleFS.open(indexPath, "w");
+    if (!index) {
+        return 0;
+    }
+    int records = 0;
+    SessionHeader header;
+    for (uint32_t offset = 0; offset + sizeof(header) <= size;) {
+        if (readHeaderAt(logPath, offset, header) && offset + sizeof(header) + header.bytes <= size) {
+            index.write((const uint8_t*)&header, sizeof(header));
+            records++;
+            offset += sizeof(header) + header.bytes;
+        } else {
+            offset++;
+        }
+    }
+    index.close();
+    return records;
+}
+
+// Records of one segment; the record and its index entry are separate
+// appends, so a reset between them leaves the index one entry short
+static int loadSegment(const char* logPath, const char* indexPath, uint32_t& bytes) {
+    bytes = fileSize(logPath);
+    int records = fileSize(indexPath) / sizeof(SessionHeader);
+    if (bytes > 0) {
+        SessionHeader first;
+        if (!readAt(logPath, 0, &first, sizeof(first)) || first.magic != SESSION_MAGIC) {
+            // Log of an older firmware (fixed-size records)
+            Console.printf("Dropping %s - unknown record format\n", logPath);
+            removeFile(logPath);
+            removeFile(indexPath);
+            bytes = 0;
+            return 0;
+        }
+    }
+    // In step: the last entry ends where the log does
+    SessionHeader last;
+    bool inStep = records == 0 ? bytes == 0
+                : readAt(indexPath, (records - 1) * sizeof(SessionHeader), &last, sizeof(last)) &&
+                  last.magic == SESSION_MAGIC && last.offset + sizeof(last) + last.bytes == bytes;
+    if (!inStep) {
+        return rebuildIndex(logPath, indexPath, bytes);
+    }
+    return records;
+}
+
+static bool noteReference(const SessionHeader& header, int record, void* context);
+
+// Visit the index entries of one segment newest first, SESSION_LIST_MAX per
+// read; the visitor returns false to stop. Returns false if stopped
+typedef bool (*IndexVisitor)(const SessionHeader& header, int record, void* context);
+
+static bool visitIndex(const char* indexPath, int records, IndexVisitor visitor, void* context) {
+    static SessionHeader entries[SESSION_LIST_MAX];
+    for (int end = records; end > 0;) {
+        int first = max(0, end - SESSION_LIST_MAX);
+        if (!readAt(indexPath, first * sizeof(SessionHeader), entries, (end - first) * sizeof(SessionHeader))) {
+            return true;
+        }
+        for (int i = end - first - 1; i >= 0; i--) {
+            if (entries[i].magic == SESSION_MAGIC && !visitor(entries[i], first + i, context)) {
+                return false;
+            }
+        }
+        end = first;
+    }
+    return true;
+}
+
+// Also after a failed queued write, whose counts may be off
+static void loadSegments() {
+    static uint32_t loadedErrors = 0;
+    if (!segmentsLoaded || loadedErrors != getStorageErrors()) {
+        waitStorageIdle();
+        loadedErrors = getStorageErrors();
+        memset(referenceOffset, 0xFF, sizeof(referenceOffset));
+        logRecords = loadSegment(SESSION_LOG_FILE, SESSION_INDEX_FILE, logBytes);
+        oldRecords = loadSegment(SESSION_LOG_OLD_FILE, SESSION_INDEX_OLD_FILE, oldBytes);
+        // Newest self-contained record per DUT in the current log
+        visitIndex(SESSION_INDEX_FILE, logRecords, noteReference, nullptr);
+        segmentsLoaded = true;
+    }
+}
+
+static bool noteReference(const SessionHeader& header, int record, void* context) {
+    if (header.reference == SESSION_NO_REFERENCE && header.dut >= 1 && header.dut <= MAX_DUT_COUNT &&
+        referenceOffset[header.dut - 1] == SESSION_NO_REFERENCE) {
+        referenceOffset[header.dut - 1] = header.offset;
+    }
+    return true;
+}
+
+// Close a full segment - renames only, the oldest segment is dropped whole
+static bool rotateSegments() {
+    bool ok = queueStorageRemove(SESSION_LOG_OLD_FILE) && queueStorageRemove(SESSION_INDEX_OLD_FILE) &&
+              queueStorageRename(SESSION_LOG_FILE, SESSION_LOG_OLD_FILE) &&
+              queueStorageRename(SESSION_INDEX_FILE, SESSION_INDEX_OLD_FILE);
+    if (!ok) {
+        // Part of the rotation may be queued - count the files again
+        segmentsLoaded = false;
+        return false;
+    }
+    oldRecords = logRecords;
+    oldBytes = logBytes;
+    logRecords = 0;
+    logBytes = 0;
+    // References never cross into the old log - the next record of each DUT is self-contained
+    memset(referenceOffset, 0xFF, sizeof(referenceOffset));
+    return true;
+}
+
+// The DUT's reference session, from the RAM ring or the log; nullptr if there
+// is none or it is unreadable
+static const Session* findReference(uint8_t dut) {
+    static Session ref;
+    uint32_t offset = dut >= 1 && dut <= MAX_DUT_COUNT ? referenceOffset[dut - 1] : SESSION_NO_REFERENCE;
+    if (offset == SESSION_NO_REFERENCE) {
+        return nullptr;
+    }
+    for (int i = 0; i < SESSION_RAM_DEPTH; i++) {
+        if (!ringPending[i] && ring[i].header.magic == SESSION_MAGIC && ring[i].header.dut == dut &&
+            ring[i].header.offset == offset) {
+            return &ring[i];
+        }
+    }
+    // Out of the ring for a while, so long written
+    return readSession(SESSION_LOG_FILE, offset, ref) ? &ref : nullptr;
+}
+
+// One record and its index entry - the only flash writes per session,
+// queued for the storage task (storage.h). Sets the header's offset,
+// reference, bytes and crc
+static bool appendRecord(Session& session) {
+    static uint8_t record[RECORD_BYTES_MAX];
+    loadSegments();
+    if (logBytes + RECORD_BYTES_MAX > SESSION_SEGMENT_BYTES && !rotateSegments()) {
+        return false;
+    }
+
+    SessionHeader& header = session.header;
+    const Session* ref = header.kind == SESSION_FINAL ? findReference(header.dut) : nullptr;
+    if (ref != nullptr && !sessionMatchesReference(session, *ref)) {
+        ref = nullptr;
+    }
+    uint8_t* data = record + sizeof(SessionHeader);
+    header.offset = logBytes;
+    header.reference = ref != nullptr ? ref->header.offset : SESSION_NO_REFERENCE;
+    header.bytes = encodeSessionPoints(session, ref, data);
+    header.crc = sessionRecordCrc(header, data);
+    memcpy(record, &header, sizeof(header));
+
+    size_t size = sizeof(header) + header.bytes;
+    if (!queueStorageAppend(SESSION_LOG_FILE, record, size)) {
+        return false;
+    }
+    logRecords++;
+    logBytes += size;
+    if (ref == nullptr && header.dut >= 1 && header.dut <= MAX_DUT_COUNT) {
+        referenceOffset[header.dut - 1] = header.offset;
+    }
+    if (!queueStorageAppend(SESSION_INDEX_FILE, &header, sizeof(SessionHeader))) {
+        // The record is queued; the index is rebuilt on the next load
+        segmentsLoaded = false;
+    }
+    return true;
+}
+
+/*=========================RAM RING=========================*/
+
+void archiveSession(uint8_t dutIndex, bool final) {
+    if (dutIndex >= getDUTCount()) {
+        return;
+    }
+    const ImpedanceRow& row = final ? measurementImpedanceData[dutIndex] : baselineImpedanceData[dutIndex];
+    int count = min(getRowPointCount(!final, dutIndex), (int)MAX_FREQUENCIES);
+
+    Session& slot = ring[ringHead];
+    if (ringCount == SESSION_RAM_DEPTH && ringPending[ringHead]) {
+        Console.println("WARNING: Oldest session lost - it never reached flash");
+    }
+    ringCount = min(ringCount + 1, SESSION_RAM_DEPTH);
+
+    memset(&slot, 0, sizeof(slot));
+    SessionHeader& header = slot.header;
+    header.magic = SESSION_MAGIC;
+    header.timestamp = getSessionTime();
+    header.dut = dutIndex + 1;
+    header.kind = final ? SESSION_FINAL : SESSION_BASELINE;
+    header.count = count;
+    header.risk = final ? riskLevels[dutIndex] : RISK_NONE;
+    header.riskPercent = final ? riskPercentages[dutIndex] : 0.0f;
+    header.offset = SESSION_NO_REFERENCE;
+    header.reference = SESSION_NO_REFERENCE;
+    for (int i = 0; i < count; i++) {
+        slot.points[i].freq_hz = storedFrequency(row.freqCode[i]);
+        slot.points[i].mag = row.mag[i];
+        slot.points[i].phase = row.phase[i];
+        slot.points[i].flags = row.flags[i];
+    }
+    quantizeSessionPoints(slot);
+
+    ringPending[ringHead] = true;
+    if (isStorageMounted()) {
+        ringPending[ringHead] = !appendRecord(slot);
+    }
+    if (ringPending[ringHead]) {
+        Console.println("WARNING: Session kept in RAM only - log append not queued");
+    }
+    ringHead = (ringHead + 1) % SESSION_RAM_DEPTH;
+}
+
+// Ring slot of the i-th newest session (0 = newest)
+static int ringSlot(int i) {
+    return (ringHead + SESSION_RAM_DEPTH - 1 - i) % SESSION_RAM_DEPTH;
+}
+
+struct SessionQuery {
+    uint32_t timestamp;
+    uint8_t dut;
+    uint32_t offset;        // Match in the segment, SESSION_NO_REFERENCE = none
+};
+
+static bool matchEntry(const SessionHeader& header, int record, void* context) {
+    SessionQuery* query = (SessionQuery*)context;
+    if (header.timestamp == query->timestamp && header.dut == query->dut) {
+        query->offset = header.offset;
+        return false;
+    }
+    return true;
+}
+
+bool findSession(uint32_t timestamp, uint8_t dut, Session& out) {
+    for (int i = 0; i < ringCount; i++) {
+        const Session& session = ring[ringSlot(i)];
+        if (session.header.timestamp == timestamp && session.header.dut == dut) {
+            memcpy(&out, &session, sizeof(Session));
+            return true;
+        }
+    }
+
+    if (!isStorageMounted()) {
+        return false;
+    }
+    // Queued appends must land before the index is read
+    loadSegments();
+    waitStorageIdle();
+    // Newest match first - boot-relative timestamps repeat after a reboot
+    SessionQuery query = {timestamp, dut, SESSION_NO_REFERENCE};
+    const char* logPath = SESSION_LOG_FILE;
+    if (visitIndex(SESSION_INDEX_FILE, logRecords, matchEntry, &query)) {
+        logPath = SESSION_LOG_OLD_FILE;
+        visitIndex(SESSION_INDEX_OLD_FILE, oldRecords, matchEntry, &query);
+    }
+    return query.offset != SESSION_NO_REFERENCE && readSession(logPath, query.offset, out);
+}
+
+/*=========================LISTING=========================*/
+
+struct SessionListing {
+    SessionVisitor visitor;
+    void* context;
+    int remaining;
+};
+
+static bool listEntry(const SessionHeader& header, int record, void* context) {
+    SessionListing* listing = (SessionListing*)context;
+    listing->visitor(header, listing->context);
+    return --listing->remaining > 0;
+}
+
+int listSessions(int maxCount, SessionVisitor visitor, void* context) {
+    maxCount = min(maxCount, SESSION_LIST_MAX);
+    SessionListing listing = {visitor, context, maxCount};
+
+    // Sessions that only live in RAM are the newest ones
+    for (int i = 0; i < ringCount && listing.remaining > 0; i++) {
+        if (ringPending[ringSlot(i)]) {
+            visitor(ring[ringSlot(i)].header, context);
+            listing.remaining--;
+        }
+    }
+
+    if (listing.remaining > 0 && isStorageMounted()) {
+        loadSegments();
+        waitStorageIdle();
+        if (visitIndex(SESSION_INDEX_FILE, logRecords, listEntry, &listing)) {
+            visitIndex(SESSION_INDEX_OLD_FILE, oldRecords, listEntry, &listing);
+        }
+    }
+    return maxCount - listing.remaining;
+}
+
+static int pendingCount() {
+    int pending = 0;
+    for (int i = 0; i < ringCount; i++) {
+        pending += ringPending[ringSlot(i)] ? 1 : 0;
+    }
+    return pending;
+}
+
+// Also waits for the queued writes, so the sessions are in flash on return
+bool flushSessions() {
+    if (pendingCount() == 0) {
+        return waitStorageIdle();
+    }
+    if (!isStorageMounted()) {
+        Console.println("LittleFS not mounted");
+        return false;
+    }
+    // Oldest first so the log stays in time order
+    bool ok = true;
+    for (int i = ringCount - 1; i >= 0; i--) {
+        int slot = ringSlot(i);
+        if (ringPending[slot]) {
+            ringPending[slot] = !appendRecord(ring[slot]);
+            ok = ok && !ringPending[slot];
+        }
+    }
+    return waitStorageIdle() && ok;
+}
+
+static void printSessionHeader(const SessionHeader& header, void* context) {
+    Console.printf("  %10lu  DUT %2d  %-8s  %2d points", (unsigned long)header.timestamp, header.dut,
+                  header.kind == SESSION_FINAL ? "final" : "baseline", header.count);
+    if (header.kind == SESSION_FINAL) {
+        Console.printf("  risk %d (%.1f%%)", header.risk, header.riskPercent);
+    }
+    if (header.offset != SESSION_NO_REFERENCE) {
+        Console.printf("  %3d B%s", (int)(sizeof(header) + header.bytes),
+                      header.reference != SESSION_NO_REFERENCE ? " delta" : "");
+    }
+    Console.println();
+}
+
+void printSessions() {
+    Console.println("\n=== Sessions (newest first) ===");
+    int count = listSessions(SESSION_LIST_MAX, printSessionHeader, nullptr);
+    Console.printf("%d session%s (%d not yet in flash)\n", count, count == 1 ? "" : "s", pendingCount());
+    if (segmentsLoaded && logRecords + oldRecords > 0) {
+        // Against the fixed 512-byte records of the uncoded log
+        uint32_t bytes = logBytes + oldBytes;
+        int records = logRecords + oldRecords;
+        Console.printf("Log: %d records, %lu bytes (%lu per record, %.1fx smaller than uncoded)\n", records,
+                      (unsigned long)bytes, (unsigned long)(bytes / records),
+                      bytes > 0 ? (float)records * 512 / bytes : 0.0f);
+    }
+    Console.println("===============================\n");
+}
@@ -0,0 +1,339 @@
+#include "sleep_monitor.h"
+#include "console.h"
+
+#if SLEEP_MONITOR
+
+#include "defines.h"
+#include "monitor.h"
+#include "meas_store.h"
+#include "meas_control.h"
+#include "baseline_store.h"
+#include "calibration.h"
+#include "cal_set.h"
+#include "impedance_calc.h"
+#include "repeat_filter.h"
+#include "BLE_Functions.h"
+#include "display_power.h"
+#include "storage.h"
+#include "bg_jobs.h"
+#include "crc.h"
+#include "esp_sleep.h"
+#include "esp_system.h"
+
+// Sweep plan and calculation band (main.cpp)
+extern uint8_t num_duts;
+extern uint8_t startIDX;
+extern uint8_t endIDX;
+extern SweepMask sweepMask;
+extern float calcStartFreq;
+extern float calcEndFreq;
+
+#define SLEEP_MONITOR_RTC_BYTES     8192    // Of the C6's 16 kB LP SRAM
+
+/*=========================KEPT STATE=========================*/
+// Written by the GUI task before every sleep, read by setup() on the wake
+struct SleepMonitorState {
+    uint32_t magic;         // SLEEP_MONITOR_MAGIC, 0 = disarmed
+    uint16_t version;       // SLEEP_MONITOR_VERSION
+    uint8_t halfLife;       // getTrackingHalfLife()
+    uint8_t repeats;        // getSweepRepeats()
+    uint32_t intervalS;
+    uint32_t sweeps;        // getMonitorSweepCount()
+    uint32_t wakes;         // Scheduled wakes since arming
+    uint16_t lastMoved;     // DUTs of the last sweep whose result moved
+    uint32_t lastAwakeMs;   // Boot to the last summary
+    float calcStart;
+    float calcEnd;
+    float lowCutoff;
+    float mediumCutoff;
+    float highCutoff;
+    SweepMask calMask;      // Indices of cal, in order
+    CalLUTRow cal[SLEEP_MONITOR_MAX_POINTS];
+    BaselineHeader header;  // calSet names the set of cal
+    BaselineDutRecord baseline[SLEEP_MONITOR_MAX_DUTS];
+    MonitorReport reports[SLEEP_MONITOR_MAX_DUTS];
+    float trackedLogMag[SLEEP_MONITOR_MAX_DUTS][MAX_FREQUENCIES];
+    uint64_t trackedSeeded[SLEEP_MONITOR_MAX_DUTS];
+    uint16_t crc;           // CRC-16/CCITT (crc.h) of everything before it
+};
+
+static_assert(sizeof(SleepMonitorState) <= SLEEP_MONITOR_RTC_BYTES, "SleepMonitorState must fit RTC memory");
+static_assert(SLEEP_MONITOR_MAX_DUTS <= 16, "lastMoved holds one bit per DUT");
+
+// Zeroed by a power-on or reset, kept over deep sleep
+RTC_DATA_ATTR static SleepMonitorState state;
+
+enum SleepPhase : uint8_t {
+    SLEEP_PHASE_MONITOR,    // Sweep running or waiting for its deliveries
+    SLEEP_PHASE_REPORT,     // BLE up, waiting for a client
+    SLEEP_PHASE_DRAIN       // BLE TX and storage emptying, then sleep
+};
+
+// GUI task only (setup() before it runs)
+static bool armed = false;
+static bool wakeBoot = false;
+static SleepPhase phase = SLEEP_PHASE_MONITOR;
+static uint32_t phaseStartMs = 0;
+
+static uint16_t stateCrc() {
+    return crc16_ccitt((const uint8_t*)&state, offsetof(SleepMonitorState, crc));
+}
+
+static SweepMask planMask() {
+    return sweepMask != 0 ? sweepMask : getSweepRangeMask(startIDX, endIDX);
+}
+
+static uint8_t keptDuts() {
+    return min(num_duts, getDUTCount());
+}
+
+static void setPhase(SleepPhase next) {
+    phase = next;
+    phaseStartMs = millis();
+}
+
+// GUI task, the monitor idle: everything the next wake needs
+static void packState() {
+    state.version = SLEEP_MONITOR_VERSION;
+    state.halfLife = getTrackingHalfLife();
+    state.repeats = getSweepRepeats();
+    state.intervalS = getMonitorInterval();
+    state.sweeps = getMonitorSweepCount();
+    state.calcStart = calcStartFreq;
+    state.calcEnd = calcEndFreq;
+    state.lowCutoff = lowRiskCutoff;
+    state.mediumCutoff = mediumRiskCutoff;
+    state.highCutoff = highRiskCutoff;
+
+    state.calMask = planMask();
+    int n = 0;
+    for (uint8_t idx = 0; idx < SWEEP_FREQ_COUNT; idx++) {
+        if (state.calMask & ((SweepMask)1 << idx)) {
+            memcpy(state.cal[n++], calibrationLUT[idx], sizeof(CalLUTRow));
+        }
+    }
+
+    packBaselineHeader(state.header);
+    for (uint8_t dut = 0; dut < state.header.numDuts; dut++) {
+        packBaselineRecord(dut, state.baseline[dut]);
+        state.reports[dut] = getMonitorReport(dut);
+        state.trackedSeeded[dut] = getTrackedBaseline(dut, state.trackedLogMag[dut]);
+    }
+    state.magic = SLEEP_MONITOR_MAGIC;
+    state.crc = stateCrc();
+}
+
+/*=========================ARMING=========================*/
+
+bool startSleepMonitor(uint32_t intervalS, uint32_t trackHalfLife) {
+    if (intervalS < SLEEP_MONITOR_MIN_INTERVAL_S) {
+        Console.printf("ERROR: Sleep monitor interval must be at least %d s\n", SLEEP_MONITOR_MIN_INTERVAL_S);
+        return false;
+    }
+    if (getCalibrationMode() != CALIBRATION_MODE_SEPARATE_FILES) {
+        Console.println("ERROR: Sleep monitor needs separate-files calibration");
+        return false;
+    }
+    if (keptDuts() > SLEEP_MONITOR_MAX_DUTS || __builtin_popcountll(planMask()) > SLEEP_MONITOR_MAX_POINTS) {
+        Console.printf("ERROR: Sleep monitor keeps at most %d DUTs and %d sweep points\n", SLEEP_MONITOR_MAX_DUTS,
+                       SLEEP_MONITOR_MAX_POINTS);
+        return false;
+    }
+    if (!startMonitor(intervalS, trackHalfLife)) {
+        return false;
+    }
+    state.magic = 0;
+    state.wakes = 0;
+    armed = true;
+    wakeBoot = false;
+    setPhase(SLEEP_PHASE_MONITOR);
+    Console.println("Sleep monitor: armed - deep sleep after each sweep");
+    return true;
+}
+
+void stopSleepMonitor() {
+    if (!armed) {
+        return;
+    }
+    armed = false;
+    state.magic = 0;
+    Console.printf("Sleep monitor: disarmed after %lu wakes\n", (unsigned long)state.wakes);
+    if (wakeBoot) {
+        // No LittleFS, BLE or splash on this boot - start over
+        Console.println("Sleep monitor: restarting");
+        flushConsole();
+        esp_restart();
+    }
+}
+
+bool isSleepMonitorArmed() {
+    return armed;
+}
+
+/*=========================WAKE=========================*/
+
+bool checkSleepMonitorWake() {
+    bool valid = state.magic == SLEEP_MONITOR_MAGIC && state.version == SLEEP_MONITOR_VERSION &&
+                 state.crc == stateCrc();
+    wakeBoot = valid && esp_reset_reason() == ESP_RST_DEEPSLEEP &&
+               esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
+    if (!wakeBoot) {
+        state.magic = 0;
+    }
+    return wakeBoot;
+}
+
+void restoreSleepMonitor() {
+    holdDisplayOff();
+    bool ok = configureMeasurementStore(state.header.storeDuts, state.header.storePoints);
+    restoreCalibrationSetName(state.header.calSet);
+    ok = ok && installCalibrationRows(state.cal, state.calMask);
+    ok = ok && restoreBaselineRecords(state.header, state.baseline);
+    ok = ok && setSweepRepeats(state.repeats);
+    if (!ok) {
+        // A kept session this build cannot take (store arena, heap)
+        Console.println("WARNING: Sleep monitor session does not fit - disarmed, restarting");
+        state.magic = 0;
+        esp_restart();
+        return;
+    }
+    calcStartFreq = state.calcStart;
+    calcEndFreq = state.calcEnd;
+    lowRiskCutoff = state.lowCutoff;
+    mediumRiskCutoff = state.mediumCutoff;
+    highRiskCutoff = state.highCutoff;
+
+    resetTrackedBaseline(state.halfLife);
+    for (uint8_t dut = 0; dut < state.header.numDuts; dut++) {
+        setTrackedBaseline(dut, state.trackedLogMag[dut], state.trackedSeeded[dut]);
+    }
+    resumeMonitor(state.intervalS, state.sweeps, state.reports, state.header.numDuts);
+    state.wakes++;
+    armed = true;
+    setPhase(SLEEP_PHASE_MONITOR);
+    Console.printf("Sleep monitor: wake %lu, sweep %lu\n", (unsigned long)state.wakes,
+                   (unsigned long)state.sweeps + 1);
+}
+
+/*=========================SWEEP END=========================*/
+
+static bool sameReport(const MonitorReport& a, const MonitorReport& b) {
+    // Bitwise - the NaN of a DUT never reported equals itself
+    return a.level == b.level && a.trackedLevel == b.trackedLevel &&
+           memcmp(&a.percent, &b.percent, sizeof(a.percent)) == 0 &&
+           memcmp(&a.trackedPercent, &b.trackedPercent, sizeof(a.trackedPercent)) == 0;
+}
+
+// Background job behind the sweep's deliveries - risk and reports are final
+static void onSweepDelivered(uint8_t arg) {
+    if (!armed || !isMonitorActive()) {
+        return;
+    }
+    // The arming boot reported live over BLE; a wake compares with the kept reports
+    uint16_t moved = 0;
+    for (uint8_t dut = 0; wakeBoot && dut < state.header.numDuts; dut++) {
+        if (!sameReport(getMonitorReport(dut), state.reports[dut])) {
+            moved |= 1 << dut;
+        }
+    }
+    state.lastMoved = moved;
+    state.lastAwakeMs = millis();
+    packState();
+    Console.printf("@EVT sleep_summary %lu %d/%u %lu\n", (unsigned long)state.sweeps, __builtin_popcount(moved),
+                   state.header.numDuts, (unsigned long)state.lastAwakeMs);
+
+    if (moved != 0) {
+        Console.println("Sleep monitor: result moved - BLE up for a client");
+        initBLE();
+        setPhase(SLEEP_PHASE_REPORT);
+    } else {
+        setPhase(SLEEP_PHASE_DRAIN);
+    }
+}
+
+void sleepMonitorSweepComplete() {
+    if (armed) {
+        queueBackgroundJob(onSweepDelivered, 0);
+    }
+}
+
+// A client subscribed: the moved results, as the sweep would have sent them
+static void sendMovedReports() {
+    for (uint8_t dut = 0; dut < state.header.numDuts; dut++) {
+        if (state.lastMoved & (1 << dut)) {
+            sendBLERisk(dut);
+            if (state.halfLife > 0) {
+                sendBLETrackedRisk(dut);
+            }
+        }
+    }
+    char statusMsg[32];
+    snprintf(statusMsg, sizeof(statusMsg), "Sleep:%lu,%lu", (unsigned long)state.intervalS,
+             (unsigned long)state.sweeps);
+    sendBLEStatus(statusMsg);
+}
+
+static void enterDeepSleep() {
+    uint32_t sleepMs = max(getMonitorWaitMs(), (uint32_t)SLEEP_MONITOR_MIN_SLEEP_MS);
+    waitStorageIdle();
+    Console.printf("Sleep monitor: deep sleep for %lu ms\n", (unsigned long)sleepMs);
+    flushConsole();
+    holdDisplayOff();
+    esp_sleep_enable_timer_wakeup((uint64_t)sleepMs * 1000);
+    esp_deep_sleep_start();
+}
+
+void processSleepMonitor() {
+    if (!armed) {
+        return;
+    }
+    // Button, STOP or MONITOR:0
+    if (!isMonitorActive()) {
+        stopSleepMonitor();
+        return;
+    }
+    // The next sweep came due during the report window - its end takes over
+    if (phase != SLEEP_PHASE_MONITOR && getMeasurementState() != MEAS_IDLE) {
+        setPhase(SLEEP_PHASE_MONITOR);
+        return;
+    }
+    uint32_t elapsed = millis() - phaseStartMs;
+    if (phase == SLEEP_PHASE_REPORT) {
+        if (getBLEDataPayloadSize() > 0) {
+            sendMovedReports();
+            setPhase(SLEEP_PHASE_DRAIN);
+        } else if (elapsed >= SLEEP_REPORT_WINDOW_MS) {
+            Console.println("Sleep monitor: no client - results kept for the next change");
+            setPhase(SLEEP_PHASE_DRAIN);
+        }
+    } else if (phase == SLEEP_PHASE_DRAIN) {
+        if (getBLETxFree() >= BLE_TX_BUFFER_BYTES || elapsed >= SLEEP_DRAIN_MS) {
+            enterDeepSleep();
+        }
+    }
+}
+
+uint32_t getSleepMonitorWaitMs() {
+    if (!armed || phase == SLEEP_PHASE_MONITOR) {
+        return UINT32_MAX;
+    }
+    return SLEEP_POLL_MS;
+}
+
+void printSleepMonitor() {
+    if (!armed) {
+        Console.println("Sleep monitor: off");
+        return;
+    }
+    Console.printf("Sleep monitor: armed, every %lu s, %lu wakes%s\n", (unsigned long)getMonitorInterval(),
+                   (unsigned long)state.wakes, wakeBoot ? " (this boot is one)" : "");
+    if (state.magic == SLEEP_MONITOR_MAGIC) {
+        Console.printf("Last sleep: sweep %lu, %d of %u DUTs moved, awake %lu ms\n", (unsigned long)state.sweeps,
+                       __builtin_popcount(state.lastMoved), state.header.numDuts,
+                       (unsigned long)state.lastAwakeMs);
+    }
+    Console.printf("Kept in RTC memory: %u of %d bytes\n", (unsigned)sizeof(SleepMonitorState),
+                   SLEEP_MONITOR_RTC_BYTES);
+}
+
+#endif
@@ -0,0 +1,305 @@
+#include "spectral_metrics.h"
+#include "console.h"
+#include "sweep_table.h"
+#include "impedance_calc.h"
+#include "meas_store.h"
+#include "log.h"
+#include <math.h>
+#include <stdlib.h>
+
+MetricsConfig metricsConfig = {
+    METRICS_MASK_ALL,
+    1000.0f,                    // Marker
+    100.0f, 10000.0f,           // Bands: < 100 Hz, 100 Hz - 10 kHz, > 10 kHz
+    0.15f,                      // Band |Z| reduction (the default medium cutoff)
+    5.0f,                       // Phase shift
+    0.1f,                       // Area
+    0.15f                       // Fit parameters
+};
+
+/*=========================METRIC TABLE=========================*/
+// Per-DUT accumulator - each metric uses the fields it needs
+struct MetricAccum {
+    float sum;
+    float weight;               // Points (or 0 before the first)
+    float best;                 // Phase: distance of the nearest point to the marker
+    float value;
+};
+
+struct MetricPoint {
+    uint32_t freqHz;
+    uint8_t freqIdx;
+    float baselineMag;
+    float baselinePhase;
+    float finalMag;
+    float finalPhase;
+};
+
+struct MetricOps {
+    const char* name;
+    void (*add)(MetricAccum& accum, const MetricPoint& point);      // nullptr: no per-point state
+    bool (*finish)(const MetricAccum& accum, uint8_t dutIdx, float& value);
+    const float* threshold;
+};
+
+// ln of the marker, taken when the accumulators are reset
+static float markerLn = 0.0f;
+
+// Half the log10 distance to the neighbouring sweep frequencies
+static float decadeWidth(uint8_t idx) {
+    float above = getSweepFreqInfo(idx > 0 ? idx - 1 : idx).log10Hz;
+    float below = getSweepFreqInfo(idx < SWEEP_FREQ_LAST ? idx + 1 : idx).log10Hz;
+    return 0.5f * (above - below);
+}
+
+static void addBand(MetricAccum& accum, const MetricPoint& point, SpectralMetric band) {
+    SpectralMetric pointBand = point.freqHz < metricsConfig.splitLowHz ? METRIC_BAND_LOW
+                             : point.freqHz > metricsConfig.splitHighHz ? METRIC_BAND_HIGH
+                             : METRIC_BAND_MID;
+    if (pointBand == band) {
+        accum.sum += 1.0f - point.finalMag / point.baselineMag;
+        accum.weight += 1.0f;
+    }
+}
+
+static void addBandLow(MetricAccum& accum, const MetricPoint& point) { addBand(accum, point, METRIC_BAND_LOW); }
+static void addBandMid(MetricAccum& accum, const MetricPoint& point) { addBand(accum, point, METRIC_BAND_MID); }
+static void addBandHigh(MetricAccum& accum, const MetricPoint& point) { addBand(accum, point, METRIC_BAND_HIGH); }
+
+static bool finishMean(const MetricAccum& accum, uint8_t dutIdx, float& value) {
+    if (accum.weight <= 0.0f) {
+        return false;
+    }
+    value = accum.sum / accum.weight;
+    return true;
+}
+
+static void addPhase(MetricAccum& accum, const MetricPoint& point) {
+    float lnHz = point.freqIdx < SWEEP_FREQ_COUNT ? getSweepFreqInfo(point.freqIdx).lnHz : logf(point.freqHz);
+    float distance = fabsf(lnHz - markerLn);
+    if (accum.weight > 0.0f && distance >= accum.best) {
+        return;
+    }
+    float shift = point.finalPhase - point.baselinePhase;
+    if (shift > 180.0f) shift -= 360.0f;
+    if (shift < -180.0f) shift += 360.0f;
+    accum.best = distance;
+    accum.value = shift;
+    accum.weight = 1.0f;
+}
+
+static bool finishValue(const MetricAccum& accum, uint8_t dutIdx, float& value) {
+    if (accum.weight <= 0.0f) {
+        return false;
+    }
+    value = accum.value;
+    return true;
+}
+
+// Midpoint rule on the sweep table axis, so the order points arrive in
+// (repairs, interleaving) does not matter. Off-grid points are left out
+static void addArea(MetricAccum& accum, const MetricPoint& point) {
+    if (point.freqIdx >= SWEEP_FREQ_COUNT) {
+        return;
+    }
+    accum.sum += decadeWidth(point.freqIdx) * log10f(point.baselineMag / point.finalMag);
+    accum.weight += 1.0f;
+}
+
+static bool finishArea(const MetricAccum& accum, uint8_t dutIdx, float& value) {
+    if (accum.weight <= 0.0f) {
+        return false;
+    }
+    value = accum.sum;
+    return true;
+}
+
+// Fit deltas need both circuit fits of the DUT
+static bool bothFits(uint8_t dutIdx, const CircuitFit*& baseline, const CircuitFit*& final) {
+    baseline = &getDUTCircuitFit(dutIdx, false);
+    final = &getDUTCircuitFit(dutIdx, true);
+    return baseline->valid && final->valid;
+}
+
+static bool finishRs(const MetricAccum& accum, uint8_t dutIdx, float& value) {
+    const CircuitFit* baseline;
+    const CircuitFit* final;
+    if (!bothFits(dutIdx, baseline, final) || baseline->params.rs <= 0.0f) {
+        return false;
+    }
+    value = 1.0f - final->params.rs / baseline->params.rs;
+    return true;
+}
+
+static bool finishRct(const MetricAccum& accum, uint8_t dutIdx, float& value) {
+    const CircuitFit* baseline;
+    const CircuitFit* final;
+    if (!bothFits(dutIdx, baseline, final)) {
+        return false;
+    }
+    value = getCircuitRctChange(dutIdx);
+    return true;
+}
+
+static bool finishN(const MetricAccum& accum, uint8_t dutIdx, float& value) {
+    const CircuitFit* baseline;
+    const CircuitFit* final;
+    if (!bothFits(dutIdx, baseline, final)) {
+        return false;
+    }
+    value = final->params.n - baseline->params.n;
+    return true;
+}
+
+static const MetricOps metricOps[METRIC_COUNT] = {
+    {"band_lo",  addBandLow,  finishMean,  &metricsConfig.bandThreshold},
+    {"band_mid", addBandMid,  finishMean,  &metricsConfig.bandThreshold},
+    {"band_hi",  addBandHigh, finishMean,  &metricsConfig.bandThreshold},
+    {"phase",    addPhase,    finishValue, &metricsConfig.phaseThreshold},
+    {"area",     addArea,     finishArea,  &metricsConfig.areaThreshold},
+    {"rs",       nullptr,     finishRs,    &metricsConfig.fitThreshold},
+    {"rct",      nullptr,     finishRct,   &metricsConfig.fitThreshold},
+    {"n",        nullptr,     finishN,     &metricsConfig.fitThreshold},
+};
+
+/*=========================ACCUMULATION=========================*/
+// Written by the data processor, read by finishSpectralMetrics() after the
+// DUT's completion event
+static MetricAccum accums[MAX_DUT_COUNT][METRIC_COUNT];
+static MetricsResult results[MAX_DUT_COUNT];
+
+void resetSpectralMetrics(uint8_t dutIdx) {
+    if (dutIdx >= MAX_DUT_COUNT) {
+        return;
+    }
+    markerLn = logf(metricsConfig.markerHz);
+    memset(accums[dutIdx], 0, sizeof(accums[dutIdx]));
+}
+
+void addSpectralMetricsPoint(uint8_t dutIdx, uint32_t freqHz, uint8_t freqIdx,
+                             float baselineMag, float baselinePhase, float finalMag, float finalPhase) {
+    if (dutIdx >= MAX_DUT_COUNT || !(finalMag > 0.0f) || !(baselineMag > 0.0f)) {
+        return;
+    }
+    MetricPoint point = {freqHz, freqIdx, baselineMag, baselinePhase, finalMag, finalPhase};
+    uint16_t mask = metricsConfig.mask;
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if ((mask & (1u << i)) && metricOps[i].add != nullptr) {
+            metricOps[i].add(accums[dutIdx][i], point);
+        }
+    }
+}
+
+void finishSpectralMetrics(uint8_t dutIdx) {
+    if (dutIdx >= MAX_DUT_COUNT) {
+        return;
+    }
+    MetricsResult& result = results[dutIdx];
+    result.mask = 0;
+    result.alarms = 0;
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        result.value[i] = 0.0f;
+        if (!(metricsConfig.mask & (1u << i)) ||
+            !metricOps[i].finish(accums[dutIdx][i], dutIdx, result.value[i])) {
+            continue;
+        }
+        result.mask |= 1u << i;
+        if (fabsf(result.value[i]) >= *metricOps[i].threshold) {
+            result.alarms |= 1u << i;
+        }
+    }
+    LOG_I("DUT %d metrics: mask 0x%02x, alarms 0x%02x\n", dutIdx + 1, result.mask, result.alarms);
+}
+
+const MetricsResult& getSpectralMetrics(uint8_t dutIdx) {
+    return results[dutIdx < MAX_DUT_COUNT ? dutIdx : 0];
+}
+
+const char* getSpectralMetricName(SpectralMetric metric) {
+    return metric < METRIC_COUNT ? metricOps[metric].name : "unknown";
+}
+
+/*=========================CONFIGURATION=========================*/
+#define METRICS_TEXT_PREFIX "METRICS"
+
+bool parseMetricsConfig(const char* cmd, MetricsConfig& config, uint8_t& errorField) {
+    MetricsConfig parsed = config;
+    errorField = 0;
+    size_t prefixLen = strlen(METRICS_TEXT_PREFIX);
+    if (strncmp(cmd, METRICS_TEXT_PREFIX, prefixLen) != 0) {
+        return false;
+    }
+    const char* cursor = cmd + prefixLen;
+    if (*cursor == ':') {
+        cursor++;
+    } else if (*cursor != '\0') {
+        return false;
+    }
+
+    // Fields in order - a command may stop after any of them
+    float* const floats[] = {&parsed.markerHz, &parsed.splitLowHz, &parsed.splitHighHz, &parsed.bandThreshold,
+                             &parsed.phaseThreshold, &parsed.areaThreshold, &parsed.fitThreshold};
+    for (uint8_t field = 1; *cursor != '\0'; field++) {
+        char* end;
+        if (field > METRICS_TEXT_FIELDS) {
+            errorField = field;
+            return false;
+        }
+        if (field == 1) {
+            unsigned long mask = strtoul(cursor, &end, 16);
+            if (mask > METRICS_MASK_ALL) {
+                errorField = field;
+                return false;
+            }
+            parsed.mask = mask;
+        } else {
+            *floats[field - 2] = strtof(cursor, &end);
+        }
+        if (end == cursor || (*end != ',' && *end != '\0')) {
+            errorField = field;
+            return false;
+        }
+        cursor = *end == ',' ? end + 1 : end;
+    }
+
+    // Bands ascending and thresholds not negative
+    if (!(parsed.markerHz > 0.0f)) {
+        errorField = 2;
+        return false;
+    }
+    if (!(parsed.splitLowHz > 0.0f) || parsed.splitHighHz < parsed.splitLowHz) {
+        errorField = 3;
+        return false;
+    }
+    for (int i = 3; i < 7; i++) {
+        if (!(*floats[i] >= 0.0f)) {
+            errorField = i + 2;
+            return false;
+        }
+    }
+    config = parsed;
+    return true;
+}
+
+/*=========================REPORT=========================*/
+void printSpectralMetrics() {
+    const MetricsConfig& c = metricsConfig;
+    Console.printf("Metrics 0x%02x: marker %.0f Hz, bands %.0f / %.0f Hz\n",
+                  c.mask, c.markerHz, c.splitLowHz, c.splitHighHz);
+    Console.printf("Thresholds: band %.3f, phase %.1f deg, area %.3f, fit %.3f\n",
+                  c.bandThreshold, c.phaseThreshold, c.areaThreshold, c.fitThreshold);
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        const MetricsResult& result = results[dut];
+        if (result.mask == 0) {
+            continue;
+        }
+        Console.printf("DUT %d:", dut + 1);
+        for (int i = 0; i < METRIC_COUNT; i++) {
+            if (result.mask & (1u << i)) {
+                Console.printf(" %s=%.4f%s", metricOps[i].name, result.value[i],
+                              (result.alarms & (1u << i)) ? "!" : "");
+            }
+        }
+        Console.println();
+    }
+}
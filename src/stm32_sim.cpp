@@ -0,0 +1,661 @@
+#include "stm32_sim.h"
+#include "console.h"
+
+#if STM32_SIM
+
+#include "UART_Functions.h"
+#include "log.h"
+#include "sweep_table.h"
+#include "freertos/queue.h"
+#include <math.h>
+
+// A command for the simulator task - cmd 0 drops the running sweep
+struct SimCommand {
+    uint8_t cmd;
+    uint8_t seq;
+    bool v2;
+    uint32_t data1, data2, data3;
+};
+
+#define SIM_CMD_RESET   0
+
+// Sweep in progress - simulator task only
+struct SimSweep {
+    bool active;
+    bool interleaved;
+    bool indexed;           // FREQUENCY_IDX frames
+    bool blocks;            // FREQUENCY_BLOCK frames (v2, sequential sweeps)
+    bool compact;           // ... sent as COMPACT_BLOCK
+    bool blockLost;         // A point of the pending block is dropped - the whole frame is
+    bool gainPlan;          // Points report their CMD_SET_GAIN_PLAN gains
+    bool repeatPlan;        // Indices repeat their CMD_SET_REPEAT_PLAN count
+    bool gainLimits;        // Points settle only on their CMD_SET_GAIN_LIMITS gains
+    bool dutStarted;        // DUT_START of dut sent (sequential sweeps)
+    uint8_t duts;
+    uint8_t dut;            // 1-based
+    uint8_t repeats;        // Frames per frequency
+    uint8_t repeat;
+    int freq;               // Sweep table index of the next point, -1 = past the end
+    SweepMask mask;
+    uint32_t ended;         // DUTs whose DUT_END was sent
+    uint32_t hangIn;        // Points left before the link goes silent, 0 = no hang
+    bool hung;              // Silent - commands are still answered
+    uint32_t dropEvery;     // Every n-th point is not sent, 0 = all are
+    uint32_t points;        // Points of this sweep so far, dropped ones included
+    bool credits;           // START_FLAG_CREDITS: points only up to creditLimit
+    bool held;              // At the limit, waiting for a grant
+    uint32_t creditLimit;
+    uint16_t seq[MAX_DUT_COUNT];    // Next FREQUENCY_IDX sequence number per DUT
+    uint8_t block[UART_V2_MAX_PAYLOAD];     // Pending FREQUENCY_BLOCK: header + points
+    uint32_t nextPointAt;   // millis() of the next point
+};
+
+static QueueHandle_t commandQueue = nullptr;
+static uint8_t commandQueueStorage[STM32_SIM_QUEUE_DEPTH * sizeof(SimCommand)];
+static StaticQueue_t commandQueueControl;
+static volatile STM32SimMode mode = SIM_OFF;
+
+// Parameters - written by the GUI task, read by the simulator task per point
+static volatile uint32_t pointMs = STM32_SIM_POINT_MS;
+static volatile float noisePct = 0.0f;
+static volatile uint8_t dutLimit = 0;
+static volatile uint32_t hangAfter = 0;     // Points of the next sweep before the hang, 0 = none
+static volatile uint32_t dropEvery = 0;     // Next sweep loses every n-th point, 0 = none
+static volatile uint32_t emptyMask = 0;     // DUTs without a sensor (bit 0 = DUT 1)
+
+// Simulator task only
+static SimSweep sweep = {};
+static bool peerV2 = STM32_SIM_V2;  // Send v2 frames
+static uint8_t pgaGain = 0;
+static uint8_t tiaGain = 1;         // Frame encoding: 1 = high
+static uint8_t gainPlan[MAX_DUT_COUNT][SWEEP_FREQ_COUNT];  // GAIN_HINT_* per point, 0 = none
+static uint8_t repeatPlan[SWEEP_FREQ_COUNT];                // Repeats per index, 0 = the START count
+static uint16_t gainLimits[SWEEP_FREQ_COUNT];               // GAIN_LIMIT_BIT mask per index, 0 = not limited
+static uint32_t baudSwitchAt = 0;   // SIM_TX: pending switch awaiting its verify
+static uint32_t noiseState = 0x12345678;
+
+// Counts for the status print
+static volatile uint32_t framesSent = 0;
+static volatile uint32_t sweepsDone = 0;
+static volatile uint32_t commandsSeen = 0;
+static volatile uint32_t creditHolds = 0;
+
+// SIM_TX receiver - UART reader task only
+static uint8_t rxData[UART_V2_HEADER_SIZE + sizeof(UARTCommandPayload) + UART_V2_CRC_SIZE];
+static size_t rxLen = 0;
+
+/*=========================FRAMES=========================*/
+static void sendFrame(const uint8_t* frame, size_t size) {
+    if (size == 0) {
+        LOG_W("[SIM] Frame outside the schema not sent\n");
+        return;
+    }
+    uart_write_bytes(UART_PORT_NUM, frame, size);
+    framesSent++;
+}
+
+static void writeFrame(uint8_t type, const void* payload, size_t len) {
+    uint8_t frame[UART_V2_MAX_FRAME_SIZE];
+    sendFrame(frame, encodeUARTFrame(frame, type, payload, len, peerV2));
+}
+
+static void writeAck(const SimCommand& command) {
+    uint8_t frame[UART_V2_HEADER_SIZE + sizeof(UARTAckSeqPayload) + UART_V2_CRC_SIZE];
+    sendFrame(frame, encodeUARTAck(frame, command.cmd, command.seq, command.v2));
+}
+
+static void writeDutEnd(uint8_t dut) {
+    UARTDutEndPayload end = {dut};
+    writeFrame(UART_DATA_DUT_END, &end, sizeof(end));
+    sweep.ended |= 1UL << (dut - 1);
+}
+
+// Uniform in [-1, 1) - xorshift32, the same stream after every boot
+static float noiseSample() {
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    return (int32_t)noiseState / 2147483648.0f;
+}
+
+// DUT n is R = n * 10 kOhm parallel to 10 nF, driven with 0.35 V
+// Autoranging that may only settle on allowed combinations: the nearest
+// allowed PGA at the same TIA, else at the other one
+static void limitGains(uint16_t allowed, UARTFrequencyPayload& point) {
+    for (int pass = 0; pass < 2; pass++) {
+        uint8_t tia = pass == 0 ? point.tia_gain : !point.tia_gain;
+        for (int d = 0; d < 8; d++) {
+            int candidates[2] = {point.pga_gain - d, point.pga_gain + d};
+            for (int pga : candidates) {
+                if (pga >= 0 && pga < 8 && (allowed & GAIN_LIMIT_BIT(tia, pga))) {
+                    point.tia_gain = tia;
+                    point.pga_gain = pga;
+                    return;
+                }
+            }
+        }
+    }
+}
+
+static UARTFrequencyPayload makePoint(uint8_t dut, int freq) {
+    UARTFrequencyPayload point;
+    float f = sweepFrequencies[freq];
+    float r = dut * 10000.0f;
+    float wrc = 2.0f * (float)M_PI * f * r * 10e-9f;
+    float mag = r / sqrtf(1.0f + wrc * wrc) * (1.0f + noiseSample() * noisePct / 100.0f);
+    float phase = -atanf(wrc) * (float)(180.0 / M_PI) + noiseSample() * noisePct / 10.0f;
+
+    point.freq_hz = sweepFrequencies[freq];
+    point.V_magnitude = 0.35f;
+    point.V_phase = 0.0f;
+    point.I_magnitude = 0.35f / mag;
+    point.I_phase = -phase;
+    point.pga_gain = pgaGain;
+    point.tia_gain = tiaGain;
+    // A hinted point settles at the planned range at once
+    uint8_t hint = sweep.gainPlan ? gainPlan[dut - 1][freq] : 0;
+    if (hint & GAIN_HINT_VALID) {
+        point.pga_gain = hint & GAIN_HINT_PGA_MASK;
+        point.tia_gain = (hint & GAIN_HINT_TIA_HIGH) ? 1 : 0;
+    }
+    if (sweep.gainLimits && gainLimits[freq] != 0) {
+        limitGains(gainLimits[freq], point);
+    }
+    point.valid = 1;
+    if (emptyMask & (1UL << (dut - 1))) {
+        point.I_magnitude = 0.0f;
+        point.valid = 0;
+    }
+    return point;
+}
+
+/*=========================SWEEP=========================*/
+static int nextFrequency(int from) {
+    for (int i = max(from, 0); i < SWEEP_FREQ_COUNT; i++) {
+        if (sweep.mask & ((SweepMask)1 << i)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void startSweep(uint32_t flags, SweepMask mask) {
+    uint8_t duts = min((int)(flags & 0xFF), MAX_DUT_COUNT);
+    uint8_t limit = dutLimit;
+    if (limit > 0) {
+        duts = min(duts, limit);
+    }
+    sweep = {};
+    sweep.active = duts > 0 && mask != 0;
+    sweep.interleaved = (flags & START_FLAG_INTERLEAVED) != 0;
+    sweep.indexed = (flags & START_FLAG_INDEXED) != 0;
+    sweep.gainPlan = (flags & START_FLAG_GAIN_PLAN) != 0;
+    sweep.credits = (flags & START_FLAG_CREDITS) != 0;
+    sweep.blocks = (flags & START_FLAG_BLOCKS) != 0 && !sweep.interleaved && peerV2;
+    sweep.compact = sweep.blocks && (flags & START_FLAG_COMPACT) != 0;
+    sweep.repeatPlan = (flags & START_FLAG_REPEAT_PLAN) != 0;
+    sweep.gainLimits = (flags & START_FLAG_GAIN_LIMITS) != 0;
+    if (!sweep.gainLimits) {
+        memset(gainLimits, 0, sizeof(gainLimits));
+    }
+    if (!sweep.gainPlan) {
+        memset(gainPlan, 0, sizeof(gainPlan));
+    }
+    if (!sweep.repeatPlan) {
+        memset(repeatPlan, 0, sizeof(repeatPlan));
+    }
+    sweep.duts = duts;
+    // A resumed sweep leaves out the DUTs before its first one
+    uint8_t first = max((int)((flags >> START_FIRST_DUT_SHIFT) & 0xFF), 1);
+    sweep.dut = first;
+    for (uint8_t dut = 1; dut < first && dut <= duts; dut++) {
+        sweep.ended |= 1UL << (dut - 1);
+    }
+    // The fault is armed once - the resumed sweep must get through
+    sweep.hangIn = hangAfter;
+    hangAfter = 0;
+    sweep.dropEvery = dropEvery;
+    dropEvery = 0;
+    sweep.repeats = max((int)((flags >> START_REPEATS_SHIFT) & 0xFF), 1);
+    sweep.mask = mask;
+    sweep.freq = nextFrequency(0);
+    sweep.nextPointAt = millis();
+    LOG_I("[SIM] Sweep: %d DUT%s from %d, %d frequencies%s%s%s%s\n", duts, duts == 1 ? "" : "s", first,
+          __builtin_popcountll(mask), sweep.interleaved ? ", interleaved" : "",
+          sweep.indexed ? ", indexed" : "", sweep.compact ? ", compact blocks" : sweep.blocks ? ", blocks" : "",
+          sweep.credits ? ", credits" : "");
+}
+
+// Frames per point at sweep index freq
+static uint8_t pointRepeats(int freq) {
+    if (sweep.repeatPlan && freq >= 0 && freq < SWEEP_FREQ_COUNT && repeatPlan[freq] > 0) {
+        return repeatPlan[freq];
+    }
+    return sweep.repeats;
+}
+
+static void finishSweep() {
+    sweep.active = false;
+    sweepsDone++;
+}
+
+static UARTFrequencyBlockHeader& blockHeader() {
+    return *reinterpret_cast<UARTFrequencyBlockHeader*>(sweep.block);
+}
+
+// Send the pending block - points made before a hold or a hang go out first
+static void flushBlock() {
+    UARTFrequencyBlockHeader& header = blockHeader();
+    if (header.count == 0) {
+        return;
+    }
+    if (!sweep.blockLost) {
+        size_t pointSize = sweep.compact ? sizeof(UARTCompactPoint) : sizeof(UARTBlockPoint);
+        writeFrame(sweep.compact ? UART_DATA_COMPACT_BLOCK : UART_DATA_FREQUENCY_BLOCK, sweep.block,
+                   sizeof(header) + header.count * pointSize);
+    }
+    header.count = 0;
+    sweep.blockLost = false;
+}
+
+static void addBlockPoint(const UARTFrequencyIdxPayload& frame, bool dropped) {
+    UARTFrequencyBlockHeader& header = blockHeader();
+    if (header.count == 0) {
+        header.dut = frame.dut;
+        header.firstIdx = frame.freqIdx;
+        header.step = 1;
+        header.firstRepeat = sweep.repeat;
+        header.repeats = pointRepeats(sweep.freq);
+        header.seq = frame.seq;
+    }
+    uint8_t gains = (frame.point.valid ? BLOCK_POINT_VALID : 0) | (frame.point.tia_gain ? BLOCK_POINT_TIA_HIGH : 0) |
+                    (frame.point.pga_gain & BLOCK_POINT_PGA_MASK);
+    float phase = frame.point.V_phase - frame.point.I_phase;
+    if (sweep.compact) {
+        UARTCompactPoint& point = reinterpret_cast<UARTCompactPoint*>(sweep.block + sizeof(header))[header.count++];
+        point.V_code = uartCompactMagCode(frame.point.V_magnitude);
+        point.I_code = uartCompactMagCode(frame.point.I_magnitude);
+        // Centidegrees of [-180, 180] fit an int16
+        phase = remainderf(phase, 360.0f);
+        point.phase_cdeg = (int16_t)lroundf(phase * 100.0f);
+        point.gains = gains;
+    } else {
+        UARTBlockPoint& point = reinterpret_cast<UARTBlockPoint*>(sweep.block + sizeof(header))[header.count++];
+        point.V_magnitude = frame.point.V_magnitude;
+        point.I_magnitude = frame.point.I_magnitude;
+        point.phase_deg = phase;
+        point.gains = gains;
+    }
+    sweep.blockLost = sweep.blockLost || dropped;
+}
+
+// One point of the current (frequency, DUT), repeated as START asked
+// Returns true once it was sent the last time
+static bool writePoint(uint8_t dut) {
+    UARTFrequencyIdxPayload frame;
+    frame.dut = dut;
+    frame.freqIdx = sweep.freq;
+    frame.seq = sweep.seq[dut - 1]++;
+    frame.point = makePoint(dut, sweep.freq);
+    // A frame lost on the line - the board's repair sweep asks for it again
+    sweep.points++;
+    bool dropped = sweep.dropEvery > 0 && sweep.points % sweep.dropEvery == 0;
+    if (sweep.blocks) {
+        addBlockPoint(frame, dropped);
+    } else if (dropped) {
+        LOG_D("[SIM] DUT %u index %d dropped\n", dut, sweep.freq);
+    } else if (sweep.indexed) {
+        writeFrame(UART_DATA_FREQUENCY_IDX, &frame, sizeof(frame));
+    } else if (sweep.interleaved) {
+        UARTFrequencyDutPayload tagged = {dut, frame.point};
+        writeFrame(UART_DATA_FREQUENCY_DUT, &tagged, sizeof(tagged));
+    } else {
+        writeFrame(UART_DATA_FREQUENCY, &frame.point, sizeof(frame.point));
+    }
+    sweep.nextPointAt = millis() + pointMs;
+    bool full = blockHeader().count == UART_BLOCK_MAX_POINTS;
+    if (sweep.hangIn > 0 && --sweep.hangIn == 0) {
+        LOG_I("[SIM] Hanging - no frames until the next START or STOP\n");
+        flushBlock();
+        sweep.hung = true;
+    }
+    if (++sweep.repeat < pointRepeats(sweep.freq)) {
+        if (full) {
+            flushBlock();
+        }
+        return false;
+    }
+    sweep.repeat = 0;
+    // A block covers consecutive indices of one repeat count only - a mask
+    // gap, a plan step or the DUT's end closes it
+    int next = nextFrequency(sweep.freq + 1);
+    if (full || next != sweep.freq + 1 || pointRepeats(next) != pointRepeats(sweep.freq)) {
+        flushBlock();
+    }
+    return true;
+}
+
+// No credit left for the next point - the board has no room for it
+static bool creditHeld() {
+    bool held = sweep.credits && sweep.points >= sweep.creditLimit;
+    if (held && !sweep.held) {
+        LOG_D("[SIM] Holding at %lu points\n", (unsigned long)sweep.points);
+        creditHolds++;
+        // The board grants more once it has the points
+        flushBlock();
+    }
+    sweep.held = held;
+    return held;
+}
+
+static void stepSequential() {
+    uint8_t dut = sweep.dut;
+    if (dut > sweep.duts) {
+        finishSweep();
+        return;
+    }
+    if (sweep.ended & (1UL << (dut - 1))) {
+        // Skipped before it began
+        sweep.dut++;
+        sweep.freq = nextFrequency(0);
+        return;
+    }
+    if (!sweep.dutStarted) {
+        UARTDutStartPayload start = {dut, (uint8_t)__builtin_popcountll(sweep.mask), {0, 0}};
+        writeFrame(UART_DATA_DUT_START, &start, sizeof(start));
+        sweep.dutStarted = true;
+        return;
+    }
+    if (sweep.freq >= 0) {
+        if (creditHeld()) {
+            return;
+        }
+        if (writePoint(dut)) {
+            sweep.freq = nextFrequency(sweep.freq + 1);
+        }
+        return;
+    }
+    writeDutEnd(dut);
+    sweep.dutStarted = false;
+    sweep.dut++;
+    sweep.freq = nextFrequency(0);
+}
+
+static void stepInterleaved() {
+    if (sweep.freq < 0) {
+        for (uint8_t dut = 1; dut <= sweep.duts; dut++) {
+            if (!(sweep.ended & (1UL << (dut - 1)))) {
+                writeDutEnd(dut);
+            }
+        }
+        finishSweep();
+        return;
+    }
+    uint8_t dut = sweep.dut;
+    if (!(sweep.ended & (1UL << (dut - 1)))) {
+        if (creditHeld() || !writePoint(dut)) {
+            return;
+        }
+    }
+    if (++sweep.dut > sweep.duts) {
+        sweep.dut = 1;
+        sweep.freq = nextFrequency(sweep.freq + 1);
+    }
+}
+
+/*=========================COMMANDS=========================*/
+static void handleCommand(const SimCommand& command) {
+    if (command.cmd == SIM_CMD_RESET) {
+        sweep.active = false;
+        peerV2 = STM32_SIM_V2;
+        baudSwitchAt = 0;
+        return;
+    }
+    commandsSeen++;
+    peerV2 = peerV2 || command.v2;
+
+    switch (command.cmd) {
+        case CMD_START_MEASUREMENT: {
+            int first = min((int)command.data2, SWEEP_FREQ_COUNT - 1);
+            int last = min((int)command.data3, SWEEP_FREQ_COUNT - 1);
+            SweepMask mask = 0;
+            for (int i = first; i <= last; i++) {
+                mask |= (SweepMask)1 << i;
+            }
+            writeAck(command);
+            startSweep(command.data1, mask);
+            break;
+        }
+        case CMD_START_MASKED:
+            writeAck(command);
+            startSweep(command.data1, ((SweepMask)command.data3 << 32) | command.data2);
+            break;
+        case CMD_END_MEASUREMENT:
+            writeAck(command);
+            if (!sweep.active) {
+                break;
+            }
+            if (command.data1 == STOP_SCOPE_ALL || sweep.hung) {
+                sweep.active = false;
+            } else if (command.data1 <= sweep.duts && !(sweep.ended & (1UL << (command.data1 - 1)))) {
+                // Fast screen skip: end the DUT now, carry on with the others
+                writeDutEnd(command.data1);
+                if (!sweep.interleaved && command.data1 == sweep.dut && sweep.dutStarted) {
+                    sweep.dutStarted = false;
+                    sweep.dut++;
+                    sweep.freq = nextFrequency(0);
+                }
+            }
+            break;
+        case CMD_SET_PGA_GAIN:
+            pgaGain = command.data1 & 0x07;
+            writeAck(command);
+            break;
+        case CMD_SET_TIA_GAIN:
+            tiaGain = command.data1 ? 0 : 1;    // Command: 1 = low, frames: 1 = high
+            writeAck(command);
+            break;
+        case CMD_SET_GAIN_PLAN: {
+            uint8_t dut = command.data1 & 0xFF;
+            int first = (command.data1 >> GAIN_PLAN_FIRST_SHIFT) & 0xFF;
+            int count = min((int)((command.data1 >> GAIN_PLAN_COUNT_SHIFT) & 0xFF), GAIN_PLAN_CHUNK);
+            uint32_t words[2] = {command.data2, command.data3};
+            for (int k = 0; k < count && dut >= 1 && dut <= MAX_DUT_COUNT && first + k < SWEEP_FREQ_COUNT; k++) {
+                gainPlan[dut - 1][first + k] = words[k / 4] >> (8 * (k % 4));
+            }
+            writeAck(command);
+            break;
+        }
+        case CMD_SET_REPEAT_PLAN: {
+            int first = command.data1 & 0xFF;
+            int count = min((int)((command.data1 >> REPEAT_PLAN_COUNT_SHIFT) & 0xFF), REPEAT_PLAN_CHUNK);
+            uint32_t words[2] = {command.data2, command.data3};
+            for (int k = 0; k < count && first + k < SWEEP_FREQ_COUNT; k++) {
+                repeatPlan[first + k] = words[k / 4] >> (8 * (k % 4));
+            }
+            writeAck(command);
+            break;
+        }
+        case CMD_SET_GAIN_LIMITS: {
+            int first = command.data1 & 0xFF;
+            int count = min((int)((command.data1 >> GAIN_LIMIT_COUNT_SHIFT) & 0xFF), GAIN_LIMIT_CHUNK);
+            uint32_t words[2] = {command.data2, command.data3};
+            for (int k = 0; k < count && first + k < SWEEP_FREQ_COUNT; k++) {
+                gainLimits[first + k] = words[k / 2] >> (16 * (k % 2));
+            }
+            writeAck(command);
+            break;
+        }
+        case CMD_SET_BAUD_RATE:
+            writeAck(command);
+            // In loopback the board switches the shared UART itself
+            if (mode == SIM_TX && command.data2 == BAUD_PHASE_SWITCH) {
+                uart_wait_tx_done(UART_PORT_NUM, pdMS_TO_TICKS(100));
+                uart_set_baudrate(UART_PORT_NUM, command.data1);
+                baudSwitchAt = millis() | 1;
+            } else if (command.data2 == BAUD_PHASE_VERIFY) {
+                baudSwitchAt = 0;
+            }
+            break;
+        case CMD_FLOW_CREDIT:
+            // Not ACKed - a grant only ever raises the limit
+            if (command.data1 > sweep.creditLimit) {
+                sweep.creditLimit = command.data1;
+                sweep.held = false;
+            }
+            break;
+        case CMD_GET_DEVICE_ID: {
+            UARTDeviceIdPayload id = {{0x314D4953, 0, 0}};     // "SIM1"
+            writeFrame(UART_DATA_DEVICE_ID, &id, sizeof(id));
+            break;
+        }
+        case CMD_LINK_TEST: {
+            writeAck(command);
+            UARTLinkTestPayload test;
+            for (uint32_t n = 0; n < min(command.data1, (uint32_t)LINK_TEST_MAX_FRAMES); n++) {
+                test.seq = n;
+                fillUARTLinkTestPattern(test.pattern, command.data2, n);
+                writeFrame(UART_DATA_LINK_TEST, &test, sizeof(test));
+            }
+            break;
+        }
+        default:
+            writeAck(command);
+            break;
+    }
+}
+
+/*=========================INTERFACE=========================*/
+static void postCommand(const SimCommand& command) {
+    if (commandQueue == nullptr || xQueueSend(commandQueue, &command, pdMS_TO_TICKS(100)) != pdTRUE) {
+        LOG_E("[SIM] Command queue full - 0x%02X dropped\n", command.cmd);
+    }
+}
+
+void initSTM32Sim() {
+    commandQueue = xQueueCreateStatic(STM32_SIM_QUEUE_DEPTH, sizeof(SimCommand), commandQueueStorage, &commandQueueControl);
+    if (STM32_SIM_BOOT_MODE != SIM_OFF) {
+        setSTM32SimMode((STM32SimMode)STM32_SIM_BOOT_MODE);
+    }
+}
+
+void setSTM32SimMode(STM32SimMode newMode) {
+    if (newMode == mode) {
+        return;
+    }
+    SimCommand reset = {SIM_CMD_RESET, 0, false, 0, 0, 0};
+    postCommand(reset);
+    mode = newMode;
+    uart_set_loop_back(UART_PORT_NUM, newMode == SIM_LOOPBACK);
+    // New peer: back to the boot rate, v2 is detected again
+    resetBaudRate();
+    Console.printf("[SIM] Virtual STM32 %s\n",
+                  newMode == SIM_LOOPBACK ? "on (loopback)" : newMode == SIM_TX ? "on (UART TX)" : "off");
+}
+
+STM32SimMode getSTM32SimMode() {
+    return mode;
+}
+
+void setSTM32SimParams(uint32_t newPointMs, float newNoisePct, uint8_t duts) {
+    pointMs = newPointMs;
+    noisePct = newNoisePct;
+    dutLimit = duts;
+}
+
+void setSTM32SimHang(uint32_t points) {
+    hangAfter = points;
+}
+
+void setSTM32SimDrop(uint32_t every) {
+    dropEvery = every;
+}
+
+void setSTM32SimEmpty(uint32_t mask) {
+    emptyMask = mask;
+}
+
+void printSTM32SimStatus() {
+    static const char* const modeNames[] = {"off", "loop", "tx"};
+    char duts[16] = "as requested";
+    if (dutLimit > 0) {
+        snprintf(duts, sizeof(duts), "%u", dutLimit);
+    }
+    Console.printf("Virtual STM32: %s, %lu ms/point, noise %.1f%%, DUTs %s\n",
+                  modeNames[mode], (unsigned long)pointMs, noisePct, duts);
+    Console.printf("  %lu commands, %lu frames, %lu sweeps, %lu credit holds\n",
+                  (unsigned long)commandsSeen, (unsigned long)framesSent, (unsigned long)sweepsDone,
+                  (unsigned long)creditHolds);
+    if (hangAfter > 0) {
+        Console.printf("  Next sweep hangs after %lu points\n", (unsigned long)hangAfter);
+    }
+    if (dropEvery > 0) {
+        Console.printf("  Next sweep drops every %lu. point\n", (unsigned long)dropEvery);
+    }
+    if (emptyMask != 0) {
+        Console.printf("  Empty slots: 0x%lX\n", (unsigned long)emptyMask);
+    }
+}
+
+void stm32SimCommand(uint8_t cmd, uint8_t seq, bool v2, uint32_t data1, uint32_t data2, uint32_t data3) {
+    SimCommand command = {cmd, seq, v2, data1, data2, data3};
+    postCommand(command);
+}
+
+// Command at the start of rxData: bytes consumed, 0 = need more
+static size_t parseCommand() {
+    UARTCommand command;
+    bool v2;
+    size_t size;
+    switch (decodeUARTCommand(rxData, rxLen, command, v2, size)) {
+        case FRAME_OK:
+            stm32SimCommand(command.type, command.seq, v2, command.data1, command.data2, command.data3);
+            return size;
+        case FRAME_INCOMPLETE:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+void stm32SimReceive(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        rxData[rxLen++] = data[i];
+        size_t used;
+        while (rxLen > 0 && (used = parseCommand()) > 0) {
+            memmove(rxData, rxData + used, rxLen - used);
+            rxLen -= used;
+        }
+    }
+}
+
+void processSTM32Sim(TickType_t timeout) {
+    TickType_t wait = timeout;
+    // Held for credit: only a grant (a command) moves the sweep on
+    if (sweep.active && !sweep.held) {
+        int32_t due = (int32_t)(sweep.nextPointAt - millis());
+        wait = due > 0 ? pdMS_TO_TICKS(due) : 0;
+    }
+
+    SimCommand command;
+    if (xQueueReceive(commandQueue, &command, wait) == pdTRUE) {
+        handleCommand(command);
+        return;
+    }
+
+    // The board never confirmed the new rate - fall back like the STM32
+    if (baudSwitchAt != 0 && millis() - baudSwitchAt > UART_BAUD_REVERT_MS) {
+        uart_set_baudrate(UART_PORT_NUM, UART_BAUD_RATE);
+        baudSwitchAt = 0;
+    }
+    if (!sweep.active || sweep.hung || mode == SIM_OFF) {
+        return;
+    }
+    if (sweep.interleaved) {
+        stepInterleaved();
+    } else {
+        stepSequential();
+    }
+}
+
+#endif // STM32_SIM
@@ -0,0 +1,154 @@
+#include "storage.h"
+#include "console.h"
+#include <LittleFS.h>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/message_buffer.h"
+#include "freertos/semphr.h"
+#include "heap_stats.h"
+#include "task_monitor.h"
+#include "sweep_eta.h"
+
+// Header of a queued operation - followed by its data
+struct StorageItemHeader {
+    uint8_t op;             // StorageOp
+    char path[STORAGE_PATH_MAX];
+};
+
+static bool mounted = false;
+static MessageBufferHandle_t queue = nullptr;
+static SemaphoreHandle_t queueMutex = nullptr;     // One writer at a time - the buffer allows one
+static uint8_t queueStorage[STORAGE_QUEUE_BYTES + 1];
+static StaticMessageBuffer_t queueControl;
+static StaticSemaphore_t queueMutexControl;
+static std::atomic<int> pending{0};                 // Queued, not yet run
+static std::atomic<uint32_t> errors{0};
+
+bool initStorage() {
+    mounted = LittleFS.begin(true);
+    if (!mounted) {
+        Console.println("ERROR: Failed to mount LittleFS");
+    }
+    if (queue == nullptr) {
+        queue = xMessageBufferCreateStatic(STORAGE_QUEUE_BYTES, queueStorage, &queueControl);
+        queueMutex = xSemaphoreCreateMutexStatic(&queueMutexControl);
+    }
+    return mounted;
+}
+
+bool isStorageMounted() {
+    return mounted;
+}
+
+/*=========================QUEUE=========================*/
+
+static bool queueOp(StorageOp op, const char* path, const void* data, size_t len) {
+    if (!mounted || queue == nullptr || strlen(path) >= STORAGE_PATH_MAX || len > STORAGE_ITEM_MAX) {
+        Console.printf("ERROR: Storage %d of %s rejected\n", op, path);
+        return false;
+    }
+    static uint8_t item[sizeof(StorageItemHeader) + STORAGE_ITEM_MAX];
+    StorageItemHeader* header = (StorageItemHeader*)item;
+
+    xSemaphoreTake(queueMutex, portMAX_DELAY);
+    header->op = op;
+    strncpy(header->path, path, STORAGE_PATH_MAX);
+    if (len > 0) {
+        memcpy(item + sizeof(StorageItemHeader), data, len);
+    }
+    // Counted before the send so waitStorageIdle() cannot miss it
+    pending++;
+    bool ok = xMessageBufferSend(queue, item, sizeof(StorageItemHeader) + len,
+                                 pdMS_TO_TICKS(STORAGE_QUEUE_WAIT_MS)) > 0;
+    if (!ok) {
+        pending--;
+    }
+    xSemaphoreGive(queueMutex);
+
+    if (!ok) {
+        Console.printf("ERROR: Storage queue full - %s not written\n", path);
+    }
+    return ok;
+}
+
+bool queueStorageWrite(const char* path, const void* data, size_t len) {
+    return queueOp(STORAGE_OP_WRITE, path, data, len);
+}
+
+bool queueStorageAppend(const char* path, const void* data, size_t len) {
+    return queueOp(STORAGE_OP_APPEND, path, data, len);
+}
+
+bool queueStorageRemove(const char* path) {
+    return queueOp(STORAGE_OP_REMOVE, path, nullptr, 0);
+}
+
+bool queueStorageRename(const char* path, const char* newPath) {
+    return queueOp(STORAGE_OP_RENAME, path, newPath, strlen(newPath) + 1);
+}
+
+bool waitStorageIdle(uint32_t timeoutMs) {
+    uint32_t start = millis();
+    while (pending.load() > 0) {
+        if (millis() - start >= timeoutMs) {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+uint32_t getStorageErrors() {
+    return errors.load();
+}
+
+/*=========================TASK=========================*/
+
+static bool runFileOp(const StorageItemHeader& header, const uint8_t* data, size_t len) {
+    switch (header.op) {
+        case STORAGE_OP_WRITE:
+        case STORAGE_OP_APPEND: {
+            File file = LittleFS.open(header.path, header.op == STORAGE_OP_WRITE ? "w" : "a");
+            if (!file) {
+                return false;
+            }
+            bool ok = file.write(data, len) == len;
+            file.close();
+            return ok;
+        }
+        case STORAGE_OP_REMOVE:
+            return !LittleFS.exists(header.path) || LittleFS.remove(header.path);
+        case STORAGE_OP_RENAME:
+            // data holds the new path with its terminator; nothing to rename is no error
+            return len > 0 && data[len - 1] == '\0' &&
+                   (!LittleFS.exists(header.path) || LittleFS.rename(header.path, (const char*)data));
+        default:
+            return false;
+    }
+}
+
+// LittleFS allocates its file handles and caches - not counted as the app's
+static bool runOp(const StorageItemHeader& header, const uint8_t* data, size_t len) {
+    heapStatsEnterFramework();
+    bool ok = runFileOp(header, data, len);
+    heapStatsExitFramework();
+    return ok;
+}
+
+void taskStorage(void* parameter) {
+    static uint8_t item[sizeof(StorageItemHeader) + STORAGE_ITEM_MAX];
+    while (1) {
+        taskWatchdogFeed();
+        size_t size = xMessageBufferReceive(queue, item, sizeof(item), pdMS_TO_TICKS(TASK_WDT_FEED_MS));
+        if (size < sizeof(StorageItemHeader)) {
+            continue;
+        }
+        const StorageItemHeader* header = (const StorageItemHeader*)item;
+        waitForSweepGap(STORAGE_SWEEP_GAP_MS, STORAGE_GAP_WAIT_MS);
+        if (!runOp(*header, item + sizeof(StorageItemHeader), size - sizeof(StorageItemHeader))) {
+            errors++;
+            Console.printf("ERROR: Storage %d of %s failed\n", header->op, header->path);
+        }
+        pending--;
+    }
+}
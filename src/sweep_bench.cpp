@@ -0,0 +1,263 @@
+#include "sweep_bench.h"
+#include "console.h"
+
+#if SWEEP_BENCH
+
+#include "defines.h"
+#include "BLE_Functions.h"
+#include "meas_control.h"
+#include "meas_store.h"
+#include "repeat_filter.h"
+#include "stm32_sim.h"
+#include "sweep_table.h"
+#include "task_monitor.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+static const uint8_t workloadDuts[] = {1, 4, 16};
+#define SWEEP_BENCH_WORKLOADS   (sizeof(workloadDuts) / sizeof(workloadDuts[0]))
+
+static_assert(SWEEP_BENCH_SAMPLES >= MAX_DUT_COUNT, "SWEEP_BENCH_SAMPLES must hold a sweep of every DUT");
+
+struct BenchResult {
+    uint8_t duts;
+    bool ble;                   // A client streamed live points
+    uint16_t sweeps;
+    float sweepsPerHour;
+    uint32_t p50Us;
+    uint32_t p95Us;
+    uint32_t p99Us;
+    uint32_t heapMin;           // Bytes
+    float cpuPercent;           // < 0: no run-time stats
+};
+
+// GUI task only
+static BenchResult results[SWEEP_BENCH_WORKLOADS];
+static uint8_t resultCount = 0;
+static uint16_t resultSweeps = 0;
+
+// Run state
+static bool running = false;
+static uint8_t workload = 0;
+static uint16_t sweepsPerWorkload = SWEEP_BENCH_SWEEPS;
+static uint16_t sweepsDone = 0;         // Final sweeps of the workload complete
+static bool awaitingSweep = false;      // A bench sweep was requested, its completion not delivered yet
+static bool measuring = false;          // Past the warm-up baseline
+static uint8_t savedRepeats = 1;
+
+// Over the measured sweeps
+static int64_t measureStartUs = 0;
+static uint32_t idleAtStart = 0;
+static uint32_t clockAtStart = 0;
+static bool streamingAtStart = false;
+
+// DUT latencies - written inside the sweep statistics' critical section
+static uint32_t samples[SWEEP_BENCH_SAMPLES];
+static volatile uint16_t sampleCount = 0;
+static volatile bool sampling = false;
+
+void sweepBenchLatency(uint32_t us) {
+    if (sampling && sampleCount < SWEEP_BENCH_SAMPLES) {
+        samples[sampleCount] = us;
+        sampleCount = sampleCount + 1;
+    }
+}
+
+/*=========================RESULTS=========================*/
+
+// Nearest rank of sorted[0..count)
+static uint32_t percentile(const uint32_t* sorted, uint16_t count, uint8_t pct) {
+    if (count == 0) {
+        return 0;
+    }
+    uint16_t rank = ((uint32_t)pct * count + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void stopMeasuring() {
+    if (measuring) {
+        sampling = false;
+        measuring = false;
+        heap_caps_monitor_local_minimum_free_size_stop();
+    }
+}
+
+static void finishWorkload() {
+    int64_t elapsedUs = esp_timer_get_time() - measureStartUs;
+    sampling = false;
+    BenchResult& r = results[resultCount++];
+    r.duts = workloadDuts[workload];
+    r.ble = streamingAtStart;
+    r.sweeps = sweepsDone;
+    r.sweepsPerHour = elapsedUs > 0 ? sweepsDone * 3600.0e6f / elapsedUs : 0.0f;
+
+    // Sampling has stopped - the sort may work in place
+    uint16_t count = sampleCount;
+    for (uint16_t i = 1; i < count; i++) {
+        uint32_t v = samples[i];
+        uint16_t j = i;
+        for (; j > 0 && samples[j - 1] > v; j--) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = v;
+    }
+    r.p50Us = percentile(samples, count, 50);
+    r.p95Us = percentile(samples, count, 95);
+    r.p99Us = percentile(samples, count, 99);
+
+    // Lowest free heap since the monitor started - read before it stops
+    r.heapMin = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    stopMeasuring();
+
+    uint32_t idle;
+    uint32_t clock;
+    r.cpuPercent = -1.0f;
+    if (getIdleRunTime(idle, clock) && clock != clockAtStart) {
+        r.cpuPercent = 100.0f - (idle - idleAtStart) * 100.0f / (clock - clockAtStart);
+    }
+
+    Console.printf("@EVT bench_result %u %d %u %.1f %lu %lu %lu %lu %.1f\n", r.duts, r.ble ? 1 : 0, r.sweeps,
+                   r.sweepsPerHour, (unsigned long)r.p50Us, (unsigned long)r.p95Us, (unsigned long)r.p99Us,
+                   (unsigned long)r.heapMin, r.cpuPercent);
+}
+
+/*=========================RUN=========================*/
+
+static void endBench(const char* reason) {
+    if (!running) {
+        return;
+    }
+    running = false;
+    awaitingSweep = false;
+    stopMeasuring();
+    setSweepRepeats(savedRepeats);
+    Console.printf("@EVT bench_end %u %s\n", resultCount, reason);
+    printSweepBench();
+}
+
+void abortSweepBench(const char* reason) {
+    endBench(reason);
+}
+
+bool isSweepBenchRunning() {
+    return running;
+}
+
+// START of a bench sweep answered (GUI task)
+static void onBenchStart(uint8_t cmd_type, bool success, void* context) {
+    if (running && awaitingSweep && !success) {
+        Console.println("Sweep bench: sweep did not start");
+        endBench("start_failed");
+    }
+}
+
+// The warm-up baseline of the workload, or its next final sweep
+static void startBenchSweep() {
+    MeasRequestError error;
+    if (!measuring) {
+        SweepPlan plan = {workloadDuts[workload], 0, SWEEP_FREQ_COUNT - 1, 0};
+        error = requestBaselineSweep(MEAS_SOURCE_SERIAL, plan, onBenchStart);
+    } else {
+        error = requestFinalSweep(MEAS_SOURCE_SERIAL, onBenchStart);
+    }
+    if (error != MEAS_REQUEST_OK) {
+        Console.printf("Sweep bench: %s\n", measRequestErrorText(error));
+        endBench("refused");
+        return;
+    }
+    awaitingSweep = true;
+}
+
+bool startSweepBench(uint16_t sweeps) {
+    if (running) {
+        Console.println("ERROR: Sweep bench already running");
+        return false;
+    }
+    if (getSTM32SimMode() != SIM_LOOPBACK) {
+        Console.println("ERROR: Sweep bench needs the virtual STM32 in loopback (sim loop)");
+        return false;
+    }
+    if (sweeps < 1 || sweeps > SWEEP_BENCH_MAX_SWEEPS) {
+        Console.printf("ERROR: Sweeps must be 1-%d\n", SWEEP_BENCH_MAX_SWEEPS);
+        return false;
+    }
+    // Every workload in one layout - its rows replace the session
+    uint8_t maxDuts = workloadDuts[SWEEP_BENCH_WORKLOADS - 1];
+    if (getDUTCount() < maxDuts || getPointsPerDUT() < SWEEP_FREQ_COUNT) {
+        if (!configureMeasurementStore(maxDuts, SWEEP_FREQ_COUNT)) {
+            return false;
+        }
+        resetMeasurementResults();
+    }
+
+    savedRepeats = getSweepRepeats();
+    setSweepRepeats(SWEEP_BENCH_REPEATS);
+    setSTM32SimParams(STM32_SIM_POINT_MS, SWEEP_BENCH_NOISE_PCT, 0);
+    sweepsPerWorkload = sweeps;
+    resultSweeps = sweeps;
+    resultCount = 0;
+    workload = 0;
+    sweepsDone = 0;
+    measuring = false;
+    running = true;
+    Console.printf("@EVT bench_start %u %u\n", (unsigned)SWEEP_BENCH_WORKLOADS, sweeps);
+    startBenchSweep();
+    return running;
+}
+
+void sweepBenchSweepComplete(bool final) {
+    if (!running || !awaitingSweep || getMeasurementSource() != MEAS_SOURCE_SERIAL) {
+        return;
+    }
+    awaitingSweep = false;
+    if (!measuring) {
+        // Warm-up done: measure from the first final START on
+        measuring = true;
+        sampleCount = 0;
+        sampling = true;
+        streamingAtStart = anyBLEClientStreaming();
+        heap_caps_monitor_local_minimum_free_size_start();
+        getIdleRunTime(idleAtStart, clockAtStart);
+        measureStartUs = esp_timer_get_time();
+    } else if (++sweepsDone >= sweepsPerWorkload) {
+        finishWorkload();
+        if (++workload >= SWEEP_BENCH_WORKLOADS) {
+            endBench("done");
+            return;
+        }
+        sweepsDone = 0;
+    }
+    startBenchSweep();
+}
+
+/*=========================STATUS=========================*/
+
+void printSweepBench() {
+    if (running) {
+        Console.printf("Sweep bench: workload %u of %u (%u DUTs), %s, %u of %u sweeps\n", workload + 1,
+                       (unsigned)SWEEP_BENCH_WORKLOADS, workloadDuts[workload],
+                       measuring ? "measuring" : "warm-up baseline", sweepsDone, sweepsPerWorkload);
+        return;
+    }
+    if (resultCount == 0) {
+        Console.println("Sweep bench: no results - \"bench sweep [sweeps]\" runs it");
+        return;
+    }
+    Console.printf("\n=== Sweep Bench (%u final sweeps, %d frequencies, %d repeat) ===\n", resultSweeps,
+                   SWEEP_FREQ_COUNT, SWEEP_BENCH_REPEATS);
+    Console.printf("%4s %3s %10s %9s %9s %9s %9s %6s\n", "DUTs", "BLE", "sweeps/h", "p50 ms", "p95 ms", "p99 ms",
+                   "heap min", "CPU %");
+    for (uint8_t i = 0; i < resultCount; i++) {
+        const BenchResult& r = results[i];
+        Console.printf("%4u %3s %10.1f %9.2f %9.2f %9.2f %9lu ", r.duts, r.ble ? "on" : "off", r.sweepsPerHour,
+                       r.p50Us / 1000.0f, r.p95Us / 1000.0f, r.p99Us / 1000.0f, (unsigned long)r.heapMin);
+        if (r.cpuPercent >= 0.0f) {
+            Console.printf("%6.1f\n", r.cpuPercent);
+        } else {
+            Console.printf("%6s\n", "-");
+        }
+    }
+    Console.println("========================\n");
+}
+
+#endif // SWEEP_BENCH
@@ -0,0 +1,190 @@
+#include "sweep_config.h"
+#include "meas_store.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#define SWEEP_CONFIG_TEXT_PREFIX    "BASELINE_START"
+#define SWEEP_CONFIG_TEXT_FIELDS    9
+
+/*=========================VALIDATION=========================*/
+
+static SweepConfig fail(SweepConfig config, SweepConfigError error, uint8_t field) {
+    config.error = error;
+    config.errorField = field;
+    return config;
+}
+
+static SweepConfig validate(SweepConfig config) {
+    if (config.numDuts < 1 || config.numDuts > getDUTCount()) {
+        return fail(config, SWEEP_CONFIG_DUTS, 1);
+    }
+    if (config.startIdx > config.endIdx || config.endIdx >= SWEEP_FREQ_COUNT) {
+        return fail(config, SWEEP_CONFIG_RANGE, 2);
+    }
+    if (!(config.calcStartFreq > 0.0f) || config.calcEndFreq < config.calcStartFreq) {
+        return fail(config, SWEEP_CONFIG_BAND, 4);
+    }
+    if (config.lowCutoff < 0.0f || config.mediumCutoff < config.lowCutoff ||
+        config.highCutoff < config.mediumCutoff) {
+        return fail(config, SWEEP_CONFIG_CUTOFFS, 6);
+    }
+    config.error = SWEEP_CONFIG_OK;
+    config.errorField = 0;
+    return config;
+}
+
+/*=========================TEXT=========================*/
+
+// Parse one field at cursor - it must end at a comma or the end of the command
+// On success the cursor is past the comma
+static bool fieldEnd(const char*& cursor, const char* end) {
+    if (end == cursor) {
+        return false;
+    }
+    while (*end == ' ' || *end == '\r' || *end == '\n') {
+        end++;
+    }
+    if (*end == ',') {
+        cursor = end + 1;
+        return true;
+    }
+    if (*end == '\0') {
+        cursor = end;
+        return true;
+    }
+    return false;
+}
+
+static bool parseUnsigned(const char*& cursor, int base, uint64_t max, uint64_t& out) {
+    char* end;
+    unsigned long long value = strtoull(cursor, &end, base);
+    if (*cursor == '-' || value > max || !fieldEnd(cursor, end)) {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+static bool parseFloat(const char*& cursor, float& out) {
+    char* end;
+    float value = strtof(cursor, &end);
+    if (!fieldEnd(cursor, end)) {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+SweepConfig parseSweepConfigText(const char* cmd, const SweepConfig& defaults) {
+    SweepConfig config = defaults;
+    config.sweepMask = 0;
+
+    size_t prefixLen = strlen(SWEEP_CONFIG_TEXT_PREFIX);
+    if (strncmp(cmd, SWEEP_CONFIG_TEXT_PREFIX, prefixLen) != 0) {
+        return fail(config, SWEEP_CONFIG_SYNTAX, 0);
+    }
+    const char* cursor = cmd + prefixLen;
+    if (*cursor == ':' || *cursor == ',') {
+        cursor++;
+    } else if (*cursor != '\0') {
+        return fail(config, SWEEP_CONFIG_SYNTAX, 0);
+    }
+
+    // Fields in order - a command may stop after any of them
+    uint64_t value;
+    for (uint8_t field = 1; field <= SWEEP_CONFIG_TEXT_FIELDS && *cursor != '\0'; field++) {
+        bool ok;
+        switch (field) {
+            case 1:
+                ok = parseUnsigned(cursor, 10, UINT8_MAX, value);
+                config.numDuts = ok ? value : config.numDuts;
+                break;
+            case 2:
+                ok = parseUnsigned(cursor, 10, UINT8_MAX, value);
+                config.startIdx = ok ? value : config.startIdx;
+                break;
+            case 3:
+                ok = parseUnsigned(cursor, 10, UINT8_MAX, value);
+                config.endIdx = ok ? value : config.endIdx;
+                break;
+            case 4: ok = parseFloat(cursor, config.calcStartFreq); break;
+            case 5: ok = parseFloat(cursor, config.calcEndFreq); break;
+            case 6: ok = parseFloat(cursor, config.lowCutoff); break;
+            case 7: ok = parseFloat(cursor, config.mediumCutoff); break;
+            case 8: ok = parseFloat(cursor, config.highCutoff); break;
+            default:
+                // Pinned frequencies (hex mask) turn on sweep planning
+                ok = parseUnsigned(cursor, 16, SWEEP_MASK_ALL, value);
+                if (ok) {
+                    config = validate(config);
+                    if (config.error != SWEEP_CONFIG_OK) {
+                        return config;
+                    }
+                    config.sweepMask = planSweepMask((uint32_t)config.calcStartFreq,
+                                                     (uint32_t)config.calcEndFreq, value);
+                    if (config.sweepMask == 0) {
+                        return fail(config, SWEEP_CONFIG_PLAN, field);
+                    }
+                }
+                break;
+        }
+        if (!ok) {
+            return fail(config, SWEEP_CONFIG_SYNTAX, field);
+        }
+    }
+    if (*cursor != '\0') {
+        return fail(config, SWEEP_CONFIG_SYNTAX, SWEEP_CONFIG_TEXT_FIELDS + 1);
+    }
+    return validate(config);
+}
+
+/*=========================BINARY=========================*/
+
+SweepConfig parseSweepConfigBinary(const uint8_t* data, size_t len, const SweepConfig& defaults) {
+    SweepConfig config = defaults;
+    config.sweepMask = 0;
+
+    // Magic and type were checked by the dispatcher
+    SweepConfigPacket packet;
+    if (len != sizeof(packet)) {
+        return fail(config, SWEEP_CONFIG_VERSION, 0);
+    }
+    memcpy(&packet, data, sizeof(packet));
+    if (packet.version != SWEEP_CONFIG_PACKET_VERSION) {
+        return fail(config, SWEEP_CONFIG_VERSION, offsetof(SweepConfigPacket, version));
+    }
+
+    config.numDuts = packet.numDuts;
+    config.startIdx = packet.startIdx;
+    config.endIdx = packet.endIdx;
+    config.calcStartFreq = packet.calcStartFreq;
+    config.calcEndFreq = packet.calcEndFreq;
+    config.lowCutoff = packet.lowCutoff;
+    config.mediumCutoff = packet.mediumCutoff;
+    config.highCutoff = packet.highCutoff;
+    config = validate(config);
+    if (config.error != SWEEP_CONFIG_OK || !(packet.flags & SWEEP_CONFIG_FLAG_PLAN)) {
+        return config;
+    }
+
+    config.sweepMask = planSweepMask(packet.calcStartFreq, packet.calcEndFreq, packet.pinnedMask & SWEEP_MASK_ALL);
+    if (config.sweepMask == 0) {
+        return fail(config, SWEEP_CONFIG_PLAN, offsetof(SweepConfigPacket, pinnedMask));
+    }
+    return config;
+}
+
+const char* sweepConfigErrorText(SweepConfigError error) {
+    switch (error) {
+        case SWEEP_CONFIG_OK:       return "OK";
+        case SWEEP_CONFIG_SYNTAX:   return "Invalid start parameters";
+        case SWEEP_CONFIG_VERSION:  return "Unsupported start packet";
+        case SWEEP_CONFIG_DUTS:     return "Invalid Sensor count";
+        case SWEEP_CONFIG_RANGE:    return "Invalid frequency range";
+        case SWEEP_CONFIG_BAND:     return "Invalid calculation band";
+        case SWEEP_CONFIG_CUTOFFS:  return "Invalid risk cutoffs";
+        case SWEEP_CONFIG_PLAN:     return "Sweep plan is empty";
+    }
+    return "Invalid start parameters";
+}
@@ -0,0 +1,171 @@
+#include "sweep_eta.h"
+#include "console.h"
+#include "meas_control.h"
+#include "meas_session.h"
+#include "meas_store.h"
+#include "repeat_plan.h"
+#include "storage.h"
+#include "crc.h"
+#include "log.h"
+#include <LittleFS.h>
+#include "esp_timer.h"
+
+// Written by the reader task, read by the others
+static volatile uint32_t pointUs[SWEEP_FREQ_COUNT];
+static volatile uint32_t lastFrameMs = 0;
+static volatile uint8_t lastIdx = SWEEP_FREQ_INVALID;   // SWEEP_FREQ_INVALID between DUTs
+
+// Reader task only
+static int64_t lastFrameUs = 0;     // 0 = no interval open
+
+// GUI task only - what the file holds
+static uint32_t savedUs[SWEEP_FREQ_COUNT];
+
+/*=========================PERSISTENCE=========================*/
+
+void loadSweepTimeModel() {
+    if (!isStorageMounted() || !LittleFS.exists(SWEEP_ETA_FILE)) {
+        return;
+    }
+    fs::File file = LittleFS.open(SWEEP_ETA_FILE, "r");
+    if (!file) {
+        return;
+    }
+    SweepTimeRecord record;
+    bool ok = file.read((uint8_t*)&record, sizeof(record)) == sizeof(record);
+    file.close();
+    if (!ok || record.magic != SWEEP_ETA_MAGIC || record.version != SWEEP_ETA_VERSION ||
+        record.count != SWEEP_FREQ_COUNT ||
+        record.crc != crc16_ccitt((const uint8_t*)&record, offsetof(SweepTimeRecord, crc))) {
+        // A new sweep table or a torn write - learned again from scratch
+        Console.println("[ETA] Sweep time model invalid, using the prior");
+        return;
+    }
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        pointUs[i] = record.pointUs[i];
+        savedUs[i] = record.pointUs[i];
+    }
+    Console.println("[ETA] Sweep time model loaded");
+}
+
+void saveSweepTimeModel() {
+    SweepTimeRecord record;
+    bool changed = false;
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        uint32_t now = pointUs[i];
+        uint32_t saved = savedUs[i];
+        uint32_t delta = now > saved ? now - saved : saved - now;
+        changed |= (uint64_t)delta * 100 > (uint64_t)saved * SWEEP_ETA_SAVE_DELTA;
+        record.pointUs[i] = now;
+    }
+    if (!changed) {
+        return;
+    }
+    record.magic = SWEEP_ETA_MAGIC;
+    record.version = SWEEP_ETA_VERSION;
+    record.count = SWEEP_FREQ_COUNT;
+    record.crc = crc16_ccitt((const uint8_t*)&record, offsetof(SweepTimeRecord, crc));
+    if (!queueStorageWrite(SWEEP_ETA_FILE, &record, sizeof(record))) {
+        Console.println("[ETA] Failed to queue sweep time model save");
+        return;
+    }
+    memcpy(savedUs, record.pointUs, sizeof(savedUs));
+}
+
+/*=========================LEARNING=========================*/
+
+void sweepTimeDutStart(uint8_t dut) {
+    lastFrameUs = esp_timer_get_time();
+    lastFrameMs = millis();
+    lastIdx = SWEEP_FREQ_INVALID;
+}
+
+void sweepTimePoint(uint8_t dut, uint8_t freqIdx) {
+    int64_t now = esp_timer_get_time();
+    int64_t interval = lastFrameUs != 0 ? now - lastFrameUs : 0;
+    lastFrameUs = now;
+    lastFrameMs = millis();
+    lastIdx = freqIdx;
+    if (freqIdx >= SWEEP_FREQ_COUNT || interval <= 0 || interval > SWEEP_ETA_SAMPLE_MAX_MS * 1000LL) {
+        return;
+    }
+    // Exponential average - the first interval seeds it
+    int32_t old = pointUs[freqIdx];
+    int32_t sample = (int32_t)interval;
+    pointUs[freqIdx] = old == 0 ? sample : old + (sample - old) / (1 << SWEEP_ETA_WEIGHT_SHIFT);
+}
+
+void sweepTimeDutEnd(uint8_t dut) {
+    // DUT_END to the next DUT_START is not a point
+    lastFrameUs = 0;
+    lastIdx = SWEEP_FREQ_INVALID;
+}
+
+/*=========================ESTIMATES=========================*/
+
+uint32_t getPointTimeUs(uint8_t freqIdx) {
+    if (freqIdx >= SWEEP_FREQ_COUNT) {
+        return SWEEP_ETA_PRIOR_MS * 1000UL;
+    }
+    uint32_t learned = pointUs[freqIdx];
+    if (learned != 0) {
+        return learned;
+    }
+    return SWEEP_ETA_PRIOR_MS * 1000UL + SWEEP_ETA_PRIOR_PERIODS * 1000000UL / sweepFrequencies[freqIdx];
+}
+
+uint32_t estimateSweepRemainingMs(uint8_t dutCount) {
+    if (getMeasurementState() == MEAS_IDLE) {
+        return 0;
+    }
+    int perDUT = getPointsPerDUT();
+    uint64_t us = 0;
+    for (uint8_t dut = 0; dut < dutCount && dut < MAX_DUT_COUNT; dut++) {
+        for (int slot = min(getStoredPointCount(dut), perDUT); slot < perDUT; slot++) {
+            uint8_t idx = getSlotFreqIndex(slot);
+            us += (uint64_t)getPointTimeUs(idx) * getPointRepeats(idx);
+        }
+    }
+    return (uint32_t)min(us / 1000, (uint64_t)UINT32_MAX);
+}
+
+uint32_t getSweepGapMs() {
+    if (getMeasurementState() == MEAS_IDLE) {
+        return UINT32_MAX;
+    }
+    uint8_t idx = lastIdx;
+    if (idx >= SWEEP_FREQ_COUNT) {
+        return 0;
+    }
+    // The next frame is a repeat or the next frequency - take the shorter
+    uint32_t expected = getPointTimeUs(idx);
+    if (idx + 1 < SWEEP_FREQ_COUNT) {
+        expected = min(expected, getPointTimeUs(idx + 1));
+    }
+    uint32_t elapsed = millis() - lastFrameMs;
+    expected /= 1000;
+    return elapsed >= expected ? 0 : expected - elapsed;
+}
+
+bool waitForSweepGap(uint32_t needMs, uint32_t maxWaitMs) {
+    uint32_t start = millis();
+    while (getSweepGapMs() < needMs) {
+        uint32_t waited = millis() - start;
+        if (waited >= maxWaitMs) {
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(min((uint32_t)SWEEP_GAP_POLL_MS, maxWaitMs - waited)));
+    }
+    return true;
+}
+
+void printSweepTimeModel() {
+    Console.println("\n=== Sweep Time Model (ms per point) ===");
+    uint64_t total = 0;
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        uint32_t us = getPointTimeUs(i);
+        total += us;
+        Console.printf("%8lu Hz %8.1f%s\n", sweepFrequencies[i], us / 1000.0f, pointUs[i] == 0 ? " (prior)" : "");
+    }
+    Console.printf("Full sweep: %.1f s per DUT and repeat\n", total / 1e6f);
+}
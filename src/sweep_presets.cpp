@@ -0,0 +1,210 @@
+#include "sweep_presets.h"
+#include "console.h"
+#include "defines.h"
+#include "repeat_filter.h"
+#include "meas_session.h"
+#include "storage.h"
+#include "crc.h"
+#include <LittleFS.h>
+#include <string.h>
+#include <stddef.h>
+
+static_assert(sizeof(SweepPresetFile) <= STORAGE_ITEM_MAX, "SweepPresetFile must fit one storage operation");
+
+// Risk band (main.cpp)
+extern float calcStartFreq;
+extern float calcEndFreq;
+
+// GUI task only
+static SweepPresetFile store = {SWEEP_PRESET_MAGIC, SWEEP_PRESET_VERSION, 0, {}, 0};
+
+// Adaptive preset whose baseline is the current baseline session, -1 = none
+static int learningPreset = -1;
+static uint32_t learningGeneration = 0;
+
+/*=========================FILE=========================*/
+
+static uint16_t storeCrc() {
+    return crc16_ccitt((const uint8_t*)&store, offsetof(SweepPresetFile, crc));
+}
+
+void loadSweepPresets() {
+    if (!isStorageMounted() || !LittleFS.exists(SWEEP_PRESET_FILE)) {
+        return;
+    }
+    fs::File file = LittleFS.open(SWEEP_PRESET_FILE, "r");
+    if (!file) {
+        return;
+    }
+    static SweepPresetFile loaded;      // Boot task only
+    bool ok = file.read((uint8_t*)&loaded, sizeof(loaded)) == sizeof(loaded);
+    file.close();
+    ok = ok && loaded.magic == SWEEP_PRESET_MAGIC && loaded.version == SWEEP_PRESET_VERSION &&
+         loaded.count <= SWEEP_PRESET_MAX &&
+         loaded.crc == crc16_ccitt((const uint8_t*)&loaded, offsetof(SweepPresetFile, crc));
+    if (!ok) {
+        Console.println("WARNING: Stored sweep presets invalid - discarded");
+        LittleFS.remove(SWEEP_PRESET_FILE);
+        return;
+    }
+    store = loaded;
+    Console.printf("%d sweep preset%s loaded\n", store.count, store.count == 1 ? "" : "s");
+}
+
+static SweepPresetError persist() {
+    store.crc = storeCrc();
+    if (!isStorageMounted() || !queueStorageWrite(SWEEP_PRESET_FILE, &store, sizeof(store))) {
+        return SWEEP_PRESET_STORAGE;
+    }
+    return SWEEP_PRESET_OK;
+}
+
+/*=========================PRESETS=========================*/
+
+static bool validName(const char* name) {
+    size_t len = strlen(name);
+    if (len == 0 || len >= SWEEP_PRESET_NAME_MAX) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        char c = name[i];
+        if (!isalnum((unsigned char)c) && c != '_' && c != '-') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int findIndex(const char* name) {
+    for (uint8_t i = 0; i < store.count; i++) {
+        if (strcmp(store.presets[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+SweepPresetError saveSweepPreset(const char* name, const SweepConfig& config, SweepMask customMask) {
+    if (!validName(name)) {
+        return SWEEP_PRESET_NAME;
+    }
+    if (config.error != SWEEP_CONFIG_OK) {
+        return SWEEP_PRESET_CONFIG;
+    }
+    int index = findIndex(name);
+    if (index < 0) {
+        if (store.count == SWEEP_PRESET_MAX) {
+            return SWEEP_PRESET_FULL;
+        }
+        index = store.count++;
+    }
+
+    // The plan BASELINE_START would build from the same fields
+    SweepPreset& preset = store.presets[index];
+    memset(&preset, 0, sizeof(preset));
+    memcpy(preset.name, name, strlen(name) + 1);
+    preset.plan = {config.numDuts, config.startIdx, config.endIdx,
+                   config.sweepMask != 0 ? config.sweepMask : customMask};
+    preset.calcStartFreq = config.calcStartFreq;
+    preset.calcEndFreq = config.calcEndFreq;
+    preset.lowCutoff = config.lowCutoff;
+    preset.mediumCutoff = config.mediumCutoff;
+    preset.highCutoff = config.highCutoff;
+    preset.repeats = getSweepRepeats();
+    preset.adaptive = isAdaptiveRepeats();
+    preset.repeatPlan = getRepeatPlan();
+    preset.metrics = metricsConfig;
+    return persist();
+}
+
+SweepPresetError deleteSweepPreset(const char* name) {
+    int index = findIndex(name);
+    if (index < 0) {
+        return SWEEP_PRESET_NOT_FOUND;
+    }
+    memmove(&store.presets[index], &store.presets[index + 1],
+            (store.count - index - 1) * sizeof(SweepPreset));
+    store.count--;
+    memset(&store.presets[store.count], 0, sizeof(SweepPreset));
+    if (learningPreset == index) {
+        learningPreset = -1;
+    } else if (learningPreset > index) {
+        learningPreset--;
+    }
+    return persist();
+}
+
+const SweepPreset* findSweepPreset(const char* name) {
+    int index = findIndex(name);
+    return index >= 0 ? &store.presets[index] : nullptr;
+}
+
+uint8_t getSweepPresetCount() {
+    return store.count;
+}
+
+const SweepPreset& getSweepPreset(uint8_t index) {
+    return store.presets[index];
+}
+
+/*=========================START=========================*/
+
+MeasRequestError startSweepPreset(MeasSource source, const SweepPreset& preset, UARTCommandCallback callback) {
+    // The data processor reads both while a sweep runs
+    if (measurementInProgress) {
+        return MEAS_REQUEST_BUSY;
+    }
+    // Repeats and metrics must be in place before START goes out - put back
+    // if the sweep does not start
+    uint8_t repeats = getSweepRepeats();
+    bool adaptive = isAdaptiveRepeats();
+    RepeatPlan repeatPlan = getRepeatPlan();
+    MetricsConfig metrics = metricsConfig;
+    setSweepRepeats(preset.repeats);
+    setAdaptiveRepeats(preset.adaptive);
+    if (preset.adaptive) {
+        setRepeatPlan(preset.repeatPlan);
+    }
+    metricsConfig = preset.metrics;
+    // The caller's preset may be a copy
+    int index = findIndex(preset.name);
+
+    MeasRequestError error = requestBaselineSweep(source, preset.plan, callback);
+    if (error != MEAS_REQUEST_OK) {
+        setSweepRepeats(repeats);
+        setAdaptiveRepeats(adaptive);
+        setRepeatPlan(repeatPlan);
+        metricsConfig = metrics;
+        return error;
+    }
+    learningPreset = preset.adaptive ? index : -1;
+    learningGeneration = getMeasurementGeneration();
+    calcStartFreq = preset.calcStartFreq;
+    calcEndFreq = preset.calcEndFreq;
+    lowRiskCutoff = preset.lowCutoff;
+    mediumRiskCutoff = preset.mediumCutoff;
+    highRiskCutoff = preset.highCutoff;
+    return MEAS_REQUEST_OK;
+}
+
+bool updateSweepPresetRepeatPlan() {
+    // Only while the preset's baseline is still the one in the rows
+    if (learningPreset < 0 || getRowGeneration(true) != learningGeneration) {
+        learningPreset = -1;
+        return false;
+    }
+    store.presets[learningPreset].repeatPlan = getRepeatPlan();
+    return persist() == SWEEP_PRESET_OK;
+}
+
+const char* sweepPresetErrorText(SweepPresetError error) {
+    switch (error) {
+        case SWEEP_PRESET_OK:        return "OK";
+        case SWEEP_PRESET_NAME:      return "Invalid preset name";
+        case SWEEP_PRESET_CONFIG:    return "Invalid preset fields";
+        case SWEEP_PRESET_FULL:      return "Preset store full";
+        case SWEEP_PRESET_NOT_FOUND: return "Unknown preset";
+        case SWEEP_PRESET_STORAGE:   return "Preset not stored";
+    }
+    return "Unknown error";
+}
@@ -0,0 +1,169 @@
+#include "sweep_refine.h"
+#include "meas_session.h"
+#include "meas_store.h"
+#include "open_channel.h"
+#include "repeat_plan.h"
+#include "sweep_eta.h"
+#include "console.h"
+#include "log.h"
+#include <math.h>
+
+// Written between sweeps (GUI task)
+static bool refine = SWEEP_REFINE_DEFAULT;
+
+// Last refinement, for printSweepRefinement()
+static uint8_t lastPlanned = 0;
+static uint8_t lastCoarse = 0;
+static uint8_t lastAdded = 0;
+static uint8_t lastTimePercent = 0;
+
+// Sweep time of the indices of mask
+static uint64_t sweepTimeUs(SweepMask mask) {
+    uint64_t us = 0;
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        if (mask & ((SweepMask)1 << i)) {
+            us += (uint64_t)getPointTimeUs(i) * getPointRepeats(i);
+        }
+    }
+    return us;
+}
+
+/*=========================CONFIGURATION=========================*/
+
+void setSweepRefinement(bool enable) {
+    refine = enable;
+}
+
+bool isSweepRefinement() {
+    return refine;
+}
+
+SweepMask getCoarseSweepMask(SweepMask plan) {
+    if (__builtin_popcountll(plan) < SWEEP_REFINE_MIN_POINTS) {
+        return plan;
+    }
+    SweepMask coarse = 0;
+    int n = 0;
+    uint8_t last = 0;
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        if (!(plan & ((SweepMask)1 << i))) {
+            continue;
+        }
+        if (n++ % SWEEP_REFINE_STRIDE == 0) {
+            coarse |= (SweepMask)1 << i;
+        }
+        last = i;
+    }
+    // Both ends, so every planned index lies between two coarse points
+    return coarse | (SweepMask)1 << last;
+}
+
+/*=========================REFINEMENT=========================*/
+
+// Raise the score of the planned, not yet swept indices between a and b
+static void scoreBetween(float* score, SweepMask candidates, uint8_t a, uint8_t b, float error) {
+    for (uint8_t i = min(a, b) + 1; i < max(a, b); i++) {
+        if ((candidates & ((SweepMask)1 << i)) && error > score[i]) {
+            score[i] = error;
+        }
+    }
+}
+
+SweepMask planSweepRefinement(uint8_t numDuts, SweepMask plan, SweepMask coarse) {
+    SweepMask candidates = plan & ~coarse;
+    float score[SWEEP_FREQ_COUNT] = {};
+    for (uint8_t dut = 0; dut < numDuts; dut++) {
+        if (isChannelOpen(dut)) {
+            continue;
+        }
+        // The valid coarse points in sweep order
+        const ImpedanceRow& row = baselineImpedanceData[dut];
+        int count = getStoredPointCount(dut);
+        uint8_t index[SWEEP_FREQ_COUNT];
+        float logF[SWEEP_FREQ_COUNT];
+        float logZ[SWEEP_FREQ_COUNT];
+        float phase[SWEEP_FREQ_COUNT];
+        int n = 0;
+        for (int i = 0; i < count && n < SWEEP_FREQ_COUNT; i++) {
+            uint8_t idx = storedFreqIndex(row.freqCode[i]);
+            if (idx >= SWEEP_FREQ_COUNT || !isStoredPointValid(row, i)) {
+                continue;
+            }
+            ImpedancePoint point = loadImpedancePoint(row, i);
+            if (point.Z_magnitude <= 0.0f) {
+                continue;
+            }
+            index[n] = idx;
+            logF[n] = log10f((float)sweepFrequencies[idx]);
+            logZ[n] = log10f(point.Z_magnitude);
+            phase[n] = point.Z_phase;
+            n++;
+        }
+        // Each interior point against the line through its neighbours
+        for (int j = 1; j + 1 < n; j++) {
+            float t = (logF[j] - logF[j - 1]) / (logF[j + 1] - logF[j - 1]);
+            float magError = fabsf(logZ[j] - (logZ[j - 1] + t * (logZ[j + 1] - logZ[j - 1])));
+            float phaseError = fabsf(phase[j] - (phase[j - 1] + t * (phase[j + 1] - phase[j - 1])));
+            float error = max(magError / SWEEP_REFINE_MAG_TOL, phaseError / SWEEP_REFINE_PHASE_TOL);
+            scoreBetween(score, candidates, index[j - 1], index[j + 1], error);
+        }
+    }
+
+    // Best first, while the budget lasts
+    uint64_t fullUs = sweepTimeUs(plan);
+    uint64_t budgetUs = fullUs * SWEEP_REFINE_BUDGET_PCT / 100;
+    uint64_t usedUs = sweepTimeUs(coarse);
+    SweepMask added = 0;
+    while (true) {
+        int best = -1;
+        for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+            if (score[i] >= 1.0f && (best < 0 || score[i] > score[best])) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        score[best] = 0.0f;
+        uint64_t us = (uint64_t)getPointTimeUs(best) * getPointRepeats(best);
+        if (usedUs + us > budgetUs) {
+            continue;  // A slow low frequency may not fit where a faster one does
+        }
+        usedUs += us;
+        added |= (SweepMask)1 << best;
+    }
+
+    lastPlanned = __builtin_popcountll(plan);
+    lastCoarse = __builtin_popcountll(coarse);
+    lastAdded = __builtin_popcountll(added);
+    lastTimePercent = fullUs > 0 ? (uint8_t)(usedUs * 100 / fullUs) : 0;
+    LOG_I("Refinement: %u coarse + %u of %u planned points, %u%% of the full sweep time\n",
+          lastCoarse, lastAdded, lastPlanned, lastTimePercent);
+    return added;
+}
+
+SweepMask getBaselinePointMask(uint8_t numDuts) {
+    SweepMask mask = 0;
+    for (uint8_t dut = 0; dut < numDuts; dut++) {
+        const ImpedanceRow& row = baselineImpedanceData[dut];
+        int count = getRowPointCount(true, dut);
+        for (int i = 0; i < count; i++) {
+            uint8_t idx = storedFreqIndex(row.freqCode[i]);
+            if (idx < SWEEP_FREQ_COUNT && isStoredPointValid(row, i)) {
+                mask |= (SweepMask)1 << idx;
+            }
+        }
+    }
+    return mask;
+}
+
+void printSweepRefinement() {
+    Console.printf("Sweep refinement: %s (1 in %d planned points, then where |Z| bends %.1f%% or phase %.1f deg,"
+                   " up to %d%% of the sweep time)\n",
+                   refine ? "on" : "off", SWEEP_REFINE_STRIDE, (powf(10.0f, SWEEP_REFINE_MAG_TOL) - 1.0f) * 100.0f,
+                   SWEEP_REFINE_PHASE_TOL, SWEEP_REFINE_BUDGET_PCT);
+    if (lastPlanned > 0) {
+        Console.printf("Last baseline: %u coarse + %u refined of %u planned points, %u%% of the full sweep time\n",
+                       lastCoarse, lastAdded, lastPlanned, lastTimePercent);
+    }
+}
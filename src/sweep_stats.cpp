@@ -0,0 +1,160 @@
+#include "sweep_stats.h"
+#include "console.h"
+#include "defines.h"
+#include "sweep_bench.h"
+
+/*=========================STATE=========================*/
+static StageStats stageStats[STAGE_COUNT];
+static portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Timeline timestamps (0 = not seen in this sweep)
+static int64_t startSentUs = 0;
+static int64_t lastFrameUs = 0;
+static int64_t dutEndUs[MAX_DUT_COUNT];
+static bool firstDutSeen = false;
+
+static const char* const stageNames[STAGE_COUNT] = {
+    "start_ack",
+    "start_to_first_dut",
+    "freq_interval",
+    "calibrate",
+    "dut_end_to_ble",
+    "ble_delivery",
+    "sweep_total",
+    "circuit_fit",
+};
+
+/*=========================RECORDING=========================*/
+
+// Caller holds statsMux
+static void recordLocked(SweepStage stage, uint32_t duration_us) {
+    StageStats& s = stageStats[stage];
+
+    if (s.count == 0 || duration_us < s.min_us) s.min_us = duration_us;
+    if (duration_us > s.max_us) s.max_us = duration_us;
+    s.sum_us += duration_us;
+    s.count++;
+
+    int bin = duration_us ? 31 - __builtin_clz(duration_us) : 0;
+    if (bin >= SWEEP_STATS_HIST_BINS) bin = SWEEP_STATS_HIST_BINS - 1;
+    if (s.hist[bin] < UINT16_MAX) s.hist[bin]++;
+}
+
+static void recordSince(SweepStage stage, int64_t since, int64_t now) {
+    if (since != 0 && now >= since) {
+        recordLocked(stage, (uint32_t)min(now - since, (int64_t)UINT32_MAX));
+    }
+}
+
+void sweepStatsRecord(SweepStage stage, uint32_t duration_us) {
+    if (stage >= STAGE_COUNT) return;
+    portENTER_CRITICAL(&statsMux);
+    recordLocked(stage, duration_us);
+    portEXIT_CRITICAL(&statsMux);
+}
+
+void sweepStatsMark(SweepMark mark, uint8_t dutNum) {
+    int64_t now = esp_timer_get_time();
+    int dutIdx = (dutNum >= 1 && dutNum <= MAX_DUT_COUNT) ? dutNum - 1 : -1;
+
+    portENTER_CRITICAL(&statsMux);
+    switch (mark) {
+        case MARK_START_SENT:
+            // Only the first attempt counts - retries are part of the ACK latency
+            if (startSentUs == 0) {
+                startSentUs = now;
+                lastFrameUs = 0;
+                firstDutSeen = false;
+                memset(dutEndUs, 0, sizeof(dutEndUs));
+            }
+            break;
+        case MARK_START_ACKED:
+            recordSince(STAGE_START_ACK, startSentUs, now);
+            break;
+        case MARK_START_FAILED:
+            startSentUs = 0;
+            break;
+        case MARK_SWEEP_STOPPED:
+            startSentUs = 0;
+            lastFrameUs = 0;
+            memset(dutEndUs, 0, sizeof(dutEndUs));
+            break;
+        case MARK_DUT_START:
+            if (!firstDutSeen) {
+                recordSince(STAGE_START_TO_FIRST_DUT, startSentUs, now);
+                firstDutSeen = true;
+            }
+            lastFrameUs = now;
+            break;
+        case MARK_FREQUENCY:
+            recordSince(STAGE_FREQ_INTERVAL, lastFrameUs, now);
+            lastFrameUs = now;
+            break;
+        case MARK_DUT_END:
+            lastFrameUs = 0;
+            if (dutIdx >= 0) dutEndUs[dutIdx] = now;
+            break;
+        case MARK_DUT_DELIVERED:
+            if (dutIdx >= 0) {
+                recordSince(STAGE_DUT_END_TO_BLE, dutEndUs[dutIdx], now);
+                if (dutEndUs[dutIdx] != 0 && now >= dutEndUs[dutIdx]) {
+                    sweepBenchLatency((uint32_t)min(now - dutEndUs[dutIdx], (int64_t)UINT32_MAX));
+                }
+                dutEndUs[dutIdx] = 0;
+            }
+            break;
+        case MARK_SWEEP_COMPLETE:
+            recordSince(STAGE_SWEEP_TOTAL, startSentUs, now);
+            startSentUs = 0;
+            break;
+    }
+    portEXIT_CRITICAL(&statsMux);
+}
+
+void sweepStatsReset() {
+    portENTER_CRITICAL(&statsMux);
+    memset(stageStats, 0, sizeof(stageStats));
+    portEXIT_CRITICAL(&statsMux);
+}
+
+/*=========================REPORTING=========================*/
+
+void getSweepStageStats(SweepStage stage, StageStats& out) {
+    if (stage >= STAGE_COUNT) {
+        memset(&out, 0, sizeof(out));
+        return;
+    }
+    portENTER_CRITICAL(&statsMux);
+    out = stageStats[stage];
+    portEXIT_CRITICAL(&statsMux);
+}
+
+const char* getSweepStageName(SweepStage stage) {
+    return stage < STAGE_COUNT ? stageNames[stage] : "unknown";
+}
+
+void printSweepStats() {
+    Console.println("\n=== Sweep Latency (us) ===");
+    Console.printf("%-20s %6s %10s %10s %10s\n", "stage", "count", "min", "avg", "max");
+
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        StageStats s;
+        getSweepStageStats((SweepStage)i, s);
+        if (s.count == 0) {
+            Console.printf("%-20s %6d %10s %10s %10s\n", stageNames[i], 0, "-", "-", "-");
+            continue;
+        }
+        Console.printf("%-20s %6lu %10lu %10lu %10lu\n", stageNames[i], s.count,
+                      s.min_us, (uint32_t)(s.sum_us / s.count), s.max_us);
+
+        // Histogram: only the populated bins, as "<lower bound>us:count"
+        Console.print("  hist");
+        for (int b = 0; b < SWEEP_STATS_HIST_BINS; b++) {
+            if (s.hist[b]) {
+                Console.printf(" %lu%s:%u", 1UL << b,
+                              b == SWEEP_STATS_HIST_BINS - 1 ? "+" : "", s.hist[b]);
+            }
+        }
+        Console.println();
+    }
+}
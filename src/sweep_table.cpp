@@ -0,0 +1,107 @@
+#include "sweep_table.h"
+
+uint8_t getSweepFrequencyIndex(uint32_t freq_hz, uint8_t hint) {
+    if (hint < SWEEP_FREQ_COUNT && sweepFrequencies[hint] == freq_hz) {
+        return hint;
+    }
+
+    // Table is sorted in descending order
+    int lo = 0;
+    int hi = SWEEP_FREQ_COUNT - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (sweepFrequencies[mid] == freq_hz) {
+            return mid;
+        }
+        if (sweepFrequencies[mid] > freq_hz) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return SWEEP_FREQ_INVALID;
+}
+
+uint8_t getSweepSegment(uint32_t freq_hz) {
+    if (freq_hz >= sweepFrequencies[0] || freq_hz <= sweepFrequencies[SWEEP_FREQ_COUNT - 1]) {
+        return SWEEP_FREQ_INVALID;
+    }
+
+    // First entry below freq_hz - the segment starts one before it
+    int lo = 1;
+    int hi = SWEEP_FREQ_COUNT - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (sweepFrequencies[mid] < freq_hz) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return sweepFrequencies[lo - 1] == freq_hz ? SWEEP_FREQ_INVALID : lo - 1;
+}
+
+SweepMask planSweepMask(uint32_t calcStartHz, uint32_t calcEndHz, SweepMask pinned) {
+    uint32_t lowHz = min(calcStartHz, calcEndHz);
+    uint32_t highHz = max(calcStartHz, calcEndHz);
+
+    SweepMask mask = pinned & SWEEP_MASK_ALL;
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        if (sweepFrequencies[i] >= lowHz && sweepFrequencies[i] <= highHz) {
+            mask |= 1ULL << i;
+        }
+    }
+    return mask;
+}
+
+bool getSweepMaskRange(SweepMask mask, uint8_t& firstIdx, uint8_t& lastIdx) {
+    mask &= SWEEP_MASK_ALL;
+    if (mask == 0) {
+        return false;
+    }
+    firstIdx = __builtin_ctzll(mask);
+    lastIdx = 63 - __builtin_clzll(mask);
+    return true;
+}
+
+SweepMask getSweepRangeMask(uint8_t firstIdx, uint8_t lastIdx) {
+    uint8_t lo = min(min(firstIdx, lastIdx), (uint8_t)(SWEEP_FREQ_COUNT - 1));
+    uint8_t hi = min(max(firstIdx, lastIdx), (uint8_t)(SWEEP_FREQ_COUNT - 1));
+    return (SWEEP_MASK_ALL >> (SWEEP_FREQ_COUNT - 1 - hi)) & ~(((SweepMask)1 << lo) - 1);
+}
+
+bool isSweepMaskContiguous(SweepMask mask) {
+    mask &= SWEEP_MASK_ALL;
+    if (mask == 0) {
+        return false;
+    }
+    // Shift the run down to bit 0 - a single run is then 0b0..01..1
+    mask >>= __builtin_ctzll(mask);
+    return (mask & (mask + 1)) == 0;
+}
+
+bool parseSweepMask(const char* text, SweepMask& mask) {
+    char* end;
+    if (text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        mask = strtoull(text + 2, &end, 16);
+        return *end == '\0' && mask != 0 && (mask & ~SWEEP_MASK_ALL) == 0;
+    }
+
+    mask = 0;
+    const char* p = text;
+    while (*p != '\0') {
+        long idx = strtol(p, &end, 10);
+        if (end == p || idx < 0 || idx >= SWEEP_FREQ_COUNT) {
+            return false;
+        }
+        mask |= 1ULL << idx;
+
+        p = end;
+        if (*p == ',') {
+            p++;
+        } else if (*p != '\0') {
+            return false;
+        }
+    }
+    return mask != 0;
+}
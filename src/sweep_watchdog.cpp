@@ -0,0 +1,103 @@
+#include "sweep_watchdog.h"
+#include "meas_control.h"
+#include "repeat_plan.h"
+#include "defines.h"
+#include "log.h"
+
+// GUI task only
+static bool armed = false;
+static uint8_t planDuts = 0;
+static uint32_t dutBudgetMs = 0;
+static uint32_t stallMs = 0;
+
+// Written by the reader task, read by the GUI task
+static volatile uint32_t lastFrameMs = 0;
+static volatile uint32_t dutStartMs = 0;
+static volatile uint32_t endedMask = 0;
+
+// Worst-case time of one point at freqHz
+static uint32_t pointBudgetMs(uint32_t freqHz) {
+    return SWEEP_WD_POINT_MS + (freqHz > 0 ? SWEEP_WD_PERIODS * 1000UL / freqHz : 0);
+}
+
+void sweepWatchdogArm(uint8_t numDuts, uint8_t startIdx, uint8_t endIdx, SweepMask mask, uint8_t firstDut) {
+    uint32_t budget = 0;
+    uint32_t slowest = 0;
+    SweepMask planned = mask != 0 ? mask : getSweepRangeMask(startIdx, endIdx);
+    for (uint8_t i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        if (planned & ((SweepMask)1 << i)) {
+            uint32_t point = pointBudgetMs(sweepFrequencies[i]) * getPointRepeats(i);
+            budget += point;
+            slowest = max(slowest, point);
+        }
+    }
+    planDuts = numDuts;
+    dutBudgetMs = budget;
+    stallMs = SWEEP_WD_STALL_MS + slowest;
+    if (firstDut <= 1) {
+        endedMask = 0;
+    }
+    // The first DUT_START must come within one DUT budget
+    uint32_t now = millis();
+    lastFrameMs = now;
+    dutStartMs = now;
+    armed = true;
+    LOG_D("[WD] Armed: %u DUT(s) from %u, %lu ms per DUT, stall after %lu ms\n",
+          numDuts, max(firstDut, (uint8_t)1), dutBudgetMs, stallMs);
+}
+
+void sweepWatchdogDisarm() {
+    armed = false;
+}
+
+void sweepWatchdogDutStart(uint8_t dut) {
+    uint32_t now = millis();
+    dutStartMs = now;
+    lastFrameMs = now;
+}
+
+void sweepWatchdogPoint() {
+    lastFrameMs = millis();
+}
+
+void sweepWatchdogDutEnd(uint8_t dut) {
+    if (dut >= 1 && dut <= MAX_DUT_COUNT) {
+        endedMask = endedMask | (1UL << (dut - 1));
+    }
+    lastFrameMs = millis();
+}
+
+// First DUT of the plan without DUT_END (1-based)
+static uint8_t firstIncompleteDut() {
+    uint32_t ended = endedMask;
+    uint8_t dut = 1;
+    while (dut < planDuts && (ended & (1UL << (dut - 1)))) {
+        dut++;
+    }
+    return dut;
+}
+
+// Remaining time of the stricter of the two limits, 0 once expired
+static uint32_t remainingMs() {
+    uint32_t now = millis();
+    uint32_t sinceFrame = now - lastFrameMs;
+    uint32_t sinceDut = now - dutStartMs;
+    uint32_t frameLeft = sinceFrame >= stallMs ? 0 : stallMs - sinceFrame;
+    uint32_t dutLeft = sinceDut >= dutBudgetMs + stallMs ? 0 : dutBudgetMs + stallMs - sinceDut;
+    return min(frameLeft, dutLeft);
+}
+
+void processSweepWatchdog() {
+    if (!armed || remainingMs() > 0) {
+        return;
+    }
+    armed = false;
+    bool noFrames = millis() - lastFrameMs >= stallMs;
+    uint8_t dut = firstIncompleteDut();
+    LOG_W("[WD] Sweep stalled at DUT %u (%s)\n", dut, noFrames ? "no frames" : "DUT over budget");
+    handleSweepStall(dut);
+}
+
+uint32_t getSweepWatchdogWaitMs() {
+    return armed ? remainingMs() : UINT32_MAX;
+}
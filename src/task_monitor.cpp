@@ -0,0 +1,189 @@
+#include "task_monitor.h"
+#include "console.h"
+#include <esp_system.h>
+#if TASK_WATCHDOG
+#include <esp_task_wdt.h>
+#endif
+
+static const TaskSpec* taskSpecs[TASK_MONITOR_MAX];
+static TaskHandle_t taskHandles[TASK_MONITOR_MAX];
+static bool stackReported[TASK_MONITOR_MAX];
+static size_t taskCount = 0;
+static size_t arenaSize = 0;
+
+static StaticTask_t taskControls[TASK_MONITOR_MAX];
+static StaticTask_t bootControls[TASK_BOOT_MAX];
+static TaskHandle_t bootHandles[TASK_BOOT_MAX];
+static size_t bootCount = 0;
+
+/*=========================TASK WATCHDOG=========================*/
+void initTaskWatchdog() {
+    if (esp_reset_reason() == ESP_RST_TASK_WDT) {
+        Console.println("WARNING: Last reset was the task watchdog - a task hung");
+    }
+#if TASK_WATCHDOG
+    // The idle task keeps watching the scheduler; a stuck table task panics
+    esp_task_wdt_config_t config = {
+        .timeout_ms = TASK_WDT_TIMEOUT_MS,
+        .idle_core_mask = 1,
+        .trigger_panic = true,
+    };
+    // The Arduino core may have started it already (CONFIG_ESP_TASK_WDT_INIT)
+    esp_err_t err = esp_task_wdt_reconfigure(&config);
+    if (err == ESP_ERR_INVALID_STATE) {
+        err = esp_task_wdt_init(&config);
+    }
+    if (err != ESP_OK) {
+        Console.printf("WARNING: Task watchdog not configured (%d)\n", err);
+    }
+#endif
+}
+
+#if TASK_WATCHDOG
+void taskWatchdogFeed() {
+    esp_task_wdt_reset();
+}
+#endif
+
+/*=========================TASK TABLE=========================*/
+void startBootTask(TaskFunction_t function, const char* name, StackType_t* stack, uint32_t stackBytes,
+                   UBaseType_t priority) {
+    if (bootCount < TASK_BOOT_MAX) {
+        bootHandles[bootCount] = xTaskCreateStatic(function, name, stackBytes, nullptr, priority, stack,
+                                                   &bootControls[bootCount]);
+        bootCount++;
+    }
+}
+
+bool startTasks(const TaskSpec* specs, size_t count, StackType_t* arena, size_t arenaBytes) {
+    // A boot task still runs on its stack between its last signal and its
+    // vTaskDelete() - the table takes that memory only once it is gone
+    for (size_t i = 0; i < bootCount; i++) {
+        while (eTaskGetState(bootHandles[i]) != eDeleted) {
+            vTaskDelay(1);
+        }
+    }
+    bootCount = 0;
+
+    bool ok = true;
+    size_t offset = 0;
+    for (size_t i = 0; i < count && taskCount < TASK_MONITOR_MAX; i++) {
+        if (offset + specs[i].stackBytes > arenaBytes) {
+            Console.printf("ERROR: No stack for task %s\n", specs[i].name);
+            ok = false;
+            continue;
+        }
+        TaskHandle_t handle = xTaskCreateStatic(specs[i].function, specs[i].name, specs[i].stackBytes, nullptr,
+                                                specs[i].priority, arena + offset / sizeof(StackType_t),
+                                                &taskControls[taskCount]);
+        offset += specs[i].stackBytes;
+#if TASK_WATCHDOG
+        if (esp_task_wdt_add(handle) != ESP_OK) {
+            Console.printf("WARNING: Task %s not watched\n", specs[i].name);
+        }
+#endif
+        taskSpecs[taskCount] = &specs[i];
+        taskHandles[taskCount] = handle;
+        taskCount++;
+    }
+    arenaSize = arenaBytes;
+    return ok && taskCount == count;
+}
+
+bool isTableTask(TaskHandle_t task) {
+    for (size_t i = 0; i < taskCount; i++) {
+        if (taskHandles[i] == task) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void printTaskStats() {
+    // ESP-IDF stacks are counted in bytes
+    Console.println("\n=== Tasks ===");
+    Console.println("Task            Prio  Stack  Free (min)");
+    for (size_t i = 0; i < taskCount; i++) {
+        UBaseType_t freeBytes = uxTaskGetStackHighWaterMark(taskHandles[i]);
+        Console.printf("%-15s %4u  %5u  %5u%s\n", taskSpecs[i]->name, (unsigned)taskSpecs[i]->priority,
+                      (unsigned)taskSpecs[i]->stackBytes, (unsigned)freeBytes,
+                      freeBytes < TASK_STACK_MIN_FREE ? "  LOW" : "");
+    }
+    Console.printf("Stacks: %u bytes, static arena\n", (unsigned)arenaSize);
+
+#if configGENERATE_RUN_TIME_STATS && configUSE_STATS_FORMATTING_FUNCTIONS
+    // About 40 characters per task
+    size_t size = uxTaskGetNumberOfTasks() * 48 + 64;
+    char* buffer = (char*)malloc(size);
+    if (buffer != nullptr) {
+        vTaskGetRunTimeStats(buffer);
+        Console.println("\nTask            Run time        CPU");
+        Console.print(buffer);
+        free(buffer);
+    }
+#else
+    Console.println("(CPU time per task needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)");
+#endif
+    Console.println("========================\n");
+}
+
+#if configGENERATE_RUN_TIME_STATS
+// Kernels before FreeRTOS 10.5 count run time in 32 bits only
+#ifndef configRUN_TIME_COUNTER_TYPE
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
+size_t sampleTaskCpu(TaskCpuLoad* out, size_t max) {
+    static TaskStatus_t tasks[24];
+    static uint32_t lastRun[TASK_MONITOR_MAX];
+    static uint32_t lastTotal = 0;
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t listed = uxTaskGetSystemState(tasks, sizeof(tasks) / sizeof(tasks[0]), &total);
+    uint32_t elapsed = (uint32_t)total - lastTotal;
+    lastTotal = (uint32_t)total;
+
+    size_t count = 0;
+    for (size_t i = 0; i < taskCount && count < max; i++) {
+        for (UBaseType_t j = 0; j < listed; j++) {
+            if (tasks[j].xHandle != taskHandles[i]) {
+                continue;
+            }
+            // The counters wrap - the differences stay right
+            uint32_t run = (uint32_t)tasks[j].ulRunTimeCounter - lastRun[i];
+            lastRun[i] = (uint32_t)tasks[j].ulRunTimeCounter;
+            out[count].name = taskSpecs[i]->name;
+            out[count].percent = elapsed > 0 ? (uint8_t)min((uint64_t)run * 100 / elapsed, (uint64_t)100) : 0;
+            count++;
+            break;
+        }
+    }
+    return count;
+}
+
+bool getIdleRunTime(uint32_t& idle, uint32_t& total) {
+    idle = (uint32_t)ulTaskGetIdleRunTimeCounter();
+    total = (uint32_t)portGET_RUN_TIME_COUNTER_VALUE();
+    return true;
+}
+#else
+size_t sampleTaskCpu(TaskCpuLoad* out, size_t max) {
+    return 0;
+}
+
+bool getIdleRunTime(uint32_t& idle, uint32_t& total) {
+    idle = 0;
+    total = 0;
+    return false;
+}
+#endif
+
+void checkTaskStacks() {
+    for (size_t i = 0; i < taskCount; i++) {
+        UBaseType_t freeBytes = uxTaskGetStackHighWaterMark(taskHandles[i]);
+        if (freeBytes < TASK_STACK_MIN_FREE && !stackReported[i]) {
+            stackReported[i] = true;
+            Console.printf("WARNING: Task %s has %u of %u stack bytes left\n", taskSpecs[i]->name,
+                          (unsigned)freeBytes, (unsigned)taskSpecs[i]->stackBytes);
+        }
+    }
+}
@@ -0,0 +1,347 @@
+#include "thread_uplink.h"
+#include "console.h"
+
+#if THREAD_UPLINK
+
+#include "BLE_Functions.h"
+#include "defines.h"
+#include "monitor.h"
+#include "spectral_metrics.h"
+#include "storage.h"
+#include "task_monitor.h"
+#include "log.h"
+#include <LittleFS.h>
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_vfs_eventfd.h"
+#include "openthread/dataset.h"
+#include "openthread/ip6.h"
+#include "openthread/link.h"
+#include "openthread/thread.h"
+#include "openthread/udp.h"
+#include "freertos/queue.h"
+
+/*=========================STATE=========================*/
+// Settings - written by the GUI / serial commands
+static bool enabled = false;
+static char destAddress[THREAD_ADDR_MAX] = THREAD_DEFAULT_DEST;
+static uint16_t destPort = THREAD_DEFAULT_PORT;
+
+// OpenThread - started once, on the first enable
+static otInstance* instance = nullptr;
+static otUdpSocket summarySocket;
+static StackType_t mainStack[THREAD_MAIN_STACK / sizeof(StackType_t)];
+static StaticTask_t mainTaskControl;
+
+// Summaries from the GUI task to the uplink task
+struct SummaryFrame {
+    uint8_t len;
+    uint8_t data[sizeof(ThreadSummaryHeader) + METRIC_COUNT * sizeof(float)];
+};
+static QueueHandle_t summaryQueue = nullptr;
+static uint8_t summaryQueueStorage[THREAD_SUMMARY_QUEUE_DEPTH * sizeof(SummaryFrame)];
+static StaticQueue_t summaryQueueControl;
+static uint16_t summarySequence = 0;
+static volatile uint32_t summariesSent = 0;
+static volatile uint32_t summariesDropped = 0;     // Queue full while detached
+static volatile uint32_t summariesFailed = 0;      // Refused by the stack
+
+/*=========================SETTINGS=========================*/
+static void loadConfig() {
+    if (!isStorageMounted()) {
+        return;
+    }
+    File file = LittleFS.open(THREAD_CONFIG_FILE, "r");
+    if (!file) {
+        return;
+    }
+    String on = file.readStringUntil('\n');
+    String address = file.readStringUntil('\n');
+    String port = file.readStringUntil('\n');
+    file.close();
+    enabled = on.toInt() == 1;
+    if (address.length() > 0 && address.length() < sizeof(destAddress)) {
+        strcpy(destAddress, address.c_str());
+    }
+    if (port.toInt() > 0 && port.toInt() <= 65535) {
+        destPort = port.toInt();
+    }
+}
+
+static bool saveConfig() {
+    char text[16 + THREAD_ADDR_MAX];
+    int len = snprintf(text, sizeof(text), "%d\n%s\n%u\n", enabled ? 1 : 0, destAddress, destPort);
+    return queueStorageWrite(THREAD_CONFIG_FILE, text, len);
+}
+
+/*=========================OPENTHREAD=========================*/
+// Framework task: the OpenThread tasklets and radio events - never returns
+// while the stack runs, so it is not in the task table or the watchdog
+static void threadMainLoop(void* parameter) {
+    esp_err_t err = esp_openthread_launch_mainloop();
+    Console.printf("[THREAD] Main loop ended (%s)\n", esp_err_to_name(err));
+    vTaskDelete(nullptr);
+}
+
+// Sleepy end device: the receiver is off between the parent polls and the
+// summaries it sends
+static void applyLinkMode() {
+    otLinkModeConfig mode = {};
+    mode.mRxOnWhenIdle = false;
+    mode.mDeviceType = false;
+    mode.mNetworkData = false;
+    otThreadSetLinkMode(instance, mode);
+    otLinkSetPollPeriod(instance, THREAD_POLL_PERIOD_MS);
+}
+
+static bool startOpenThread() {
+    if (instance != nullptr) {
+        return true;
+    }
+    esp_vfs_eventfd_config_t eventfd = {};
+    eventfd.max_fds = 3;
+    esp_openthread_platform_config_t config = {};
+    config.radio_config.radio_mode = RADIO_MODE_NATIVE;
+    config.host_config.host_connection_mode = HOST_CONNECTION_MODE_NONE;
+    config.port_config.storage_partition_name = "nvs";
+    config.port_config.netif_queue_size = 10;
+    config.port_config.task_queue_size = 10;
+    if (esp_vfs_eventfd_register(&eventfd) != ESP_OK || esp_openthread_init(&config) != ESP_OK) {
+        Console.println("[THREAD] ERROR: OpenThread init failed");
+        return false;
+    }
+    instance = esp_openthread_get_instance();
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    memset(&summarySocket, 0, sizeof(summarySocket));
+    otUdpOpen(instance, &summarySocket, nullptr, nullptr);
+    applyLinkMode();
+    esp_openthread_lock_release();
+
+    xTaskCreateStatic(threadMainLoop, "OpenThread", THREAD_MAIN_STACK / sizeof(StackType_t), nullptr,
+                      THREAD_MAIN_PRIORITY, mainStack, &mainTaskControl);
+    return true;
+}
+
+// Join with the stored dataset, or leave (OpenThread lock held)
+static void applyEnabled() {
+    if (enabled && !otDatasetIsCommissioned(instance)) {
+        Console.println("[THREAD] No network stored - THREAD:<channel>,<PAN ID>,<ext PAN ID>,<key>");
+        return;
+    }
+    otIp6SetEnabled(instance, enabled);
+    otThreadSetEnabled(instance, enabled);
+}
+
+static bool isAttached() {
+    if (instance == nullptr || !esp_openthread_lock_acquire(pdMS_TO_TICKS(THREAD_LOCK_WAIT_MS))) {
+        return false;
+    }
+    otDeviceRole role = otThreadGetDeviceRole(instance);
+    esp_openthread_lock_release();
+    return role >= OT_DEVICE_ROLE_CHILD;
+}
+
+void initThreadUplink() {
+    summaryQueue = xQueueCreateStatic(THREAD_SUMMARY_QUEUE_DEPTH, sizeof(SummaryFrame), summaryQueueStorage,
+                                      &summaryQueueControl);
+    loadConfig();
+    if (enabled && startOpenThread()) {
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        applyEnabled();
+        esp_openthread_lock_release();
+    }
+}
+
+bool setThreadEnabled(bool enable) {
+    if (enable && !startOpenThread()) {
+        return false;
+    }
+    enabled = enable;
+    if (instance != nullptr) {
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        applyEnabled();
+        esp_openthread_lock_release();
+    }
+    return saveConfig();
+}
+
+bool isThreadEnabled() {
+    return enabled;
+}
+
+// count bytes as 2 * count hex digits - the whole field
+static bool parseHexField(const char* text, size_t len, uint8_t* out, size_t count) {
+    if (len != count * 2) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        char digits[3] = {text[2 * i], text[2 * i + 1], '\0'};
+        if (!isxdigit((unsigned char)digits[0]) || !isxdigit((unsigned char)digits[1])) {
+            return false;
+        }
+        out[i] = strtoul(digits, nullptr, 16);
+    }
+    return true;
+}
+
+bool setThreadNetwork(const char* args) {
+    const char* field[4];
+    size_t len[4];
+    for (int i = 0; i < 4; i++) {
+        const char* comma = strchr(args, ',');
+        field[i] = args;
+        len[i] = comma != nullptr ? comma - args : strlen(args);
+        if ((comma == nullptr) != (i == 3)) {
+            return false;
+        }
+        if (comma != nullptr) {
+            args = comma + 1;
+        }
+    }
+
+    otOperationalDataset dataset = {};
+    char* end;
+    unsigned long channel = strtoul(field[0], &end, 10);
+    uint8_t pan[2];
+    if (end != field[0] + len[0] || channel < 11 || channel > 26 || !parseHexField(field[1], len[1], pan, 2) ||
+        !parseHexField(field[2], len[2], dataset.mExtendedPanId.m8, OT_EXT_PAN_ID_SIZE) ||
+        !parseHexField(field[3], len[3], dataset.mNetworkKey.m8, OT_NETWORK_KEY_SIZE)) {
+        return false;
+    }
+    dataset.mChannel = channel;
+    dataset.mPanId = pan[0] << 8 | pan[1];
+    dataset.mComponents.mIsChannelPresent = true;
+    dataset.mComponents.mIsPanIdPresent = true;
+    dataset.mComponents.mIsExtendedPanIdPresent = true;
+    dataset.mComponents.mIsNetworkKeyPresent = true;
+
+    if (!startOpenThread()) {
+        return false;
+    }
+    // The leader hands over the rest of the dataset once attached
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    otThreadSetEnabled(instance, false);
+    bool ok = otDatasetSetActive(instance, &dataset) == OT_ERROR_NONE;
+    enabled = ok;
+    applyEnabled();
+    esp_openthread_lock_release();
+    return ok && saveConfig();
+}
+
+bool setThreadDestination(const char* address, uint16_t port) {
+    otIp6Address parsed;
+    if (strlen(address) >= sizeof(destAddress) || otIp6AddressFromString(address, &parsed) != OT_ERROR_NONE ||
+        port == 0) {
+        return false;
+    }
+    strcpy(destAddress, address);
+    destPort = port;
+    return saveConfig();
+}
+
+void getThreadStatus(char* out, size_t size) {
+    if (!enabled || instance == nullptr) {
+        snprintf(out, size, "off");
+        return;
+    }
+    if (!esp_openthread_lock_acquire(pdMS_TO_TICKS(THREAD_LOCK_WAIT_MS))) {
+        snprintf(out, size, "busy");
+        return;
+    }
+    otDeviceRole role = otThreadGetDeviceRole(instance);
+    if (role >= OT_DEVICE_ROLE_CHILD) {
+        snprintf(out, size, "%s %04x", otThreadDeviceRoleToString(role), otThreadGetRloc16(instance));
+    } else {
+        snprintf(out, size, "%s", otThreadDeviceRoleToString(role));
+    }
+    esp_openthread_lock_release();
+}
+
+/*=========================SUMMARIES=========================*/
+void queueThreadSummary(uint8_t dutIndex) {
+    if (!enabled || summaryQueue == nullptr || dutIndex >= MAX_DUT_COUNT) {
+        return;
+    }
+    SummaryFrame frame;
+    ThreadSummaryHeader* header = (ThreadSummaryHeader*)frame.data;
+    const MetricsResult& metrics = getSpectralMetrics(dutIndex);
+    header->magic = BLE_BIN_MAGIC;
+    header->type = BLE_BIN_TYPE_SUMMARY;
+    header->version = THREAD_SUMMARY_VERSION;
+    header->dut = dutIndex + 1;
+    header->sequence = summarySequence++;
+    header->risk = riskLevels[dutIndex];
+    header->flags = isMonitorActive() ? THREAD_SUMMARY_MONITOR : 0;
+    header->percent = (int16_t)lroundf(riskPercentages[dutIndex] * 10.0f);
+    header->metricMask = metrics.mask;
+    header->alarms = metrics.alarms;
+    uint8_t* out = frame.data + sizeof(ThreadSummaryHeader);
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if (metrics.mask & (1u << i)) {
+            memcpy(out, &metrics.value[i], sizeof(float));
+            out += sizeof(float);
+        }
+    }
+    frame.len = out - frame.data;
+
+    // Detached for long: the newest results are the ones worth sending
+    if (xQueueSend(summaryQueue, &frame, 0) != pdTRUE) {
+        SummaryFrame oldest;
+        xQueueReceive(summaryQueue, &oldest, 0);
+        xQueueSend(summaryQueue, &frame, 0);
+        summariesDropped++;
+    }
+}
+
+static bool sendSummary(const SummaryFrame& frame) {
+    if (!esp_openthread_lock_acquire(pdMS_TO_TICKS(THREAD_LOCK_WAIT_MS))) {
+        return false;
+    }
+    otMessageInfo info = {};
+    bool ok = otIp6AddressFromString(destAddress, &info.mPeerAddr) == OT_ERROR_NONE;
+    info.mPeerPort = destPort;
+    otMessage* message = ok ? otUdpNewMessage(instance, nullptr) : nullptr;
+    ok = message != nullptr && otMessageAppend(message, frame.data, frame.len) == OT_ERROR_NONE;
+    if (ok) {
+        ok = otUdpSend(instance, &summarySocket, message, &info) == OT_ERROR_NONE;
+    } else if (message != nullptr) {
+        otMessageFree(message);
+    }
+    esp_openthread_lock_release();
+    return ok;
+}
+
+void taskThreadUplink(void* parameter) {
+    SummaryFrame frame;
+    Console.println("Thread uplink task started");
+
+    while (true) {
+        taskWatchdogFeed();
+        // Summaries wait in the queue until the device is attached
+        if (!enabled || !isAttached()) {
+            vTaskDelay(pdMS_TO_TICKS(THREAD_RETRY_MS));
+            continue;
+        }
+        if (xQueueReceive(summaryQueue, &frame, pdMS_TO_TICKS(TASK_WDT_FEED_MS)) != pdTRUE) {
+            continue;
+        }
+        if (sendSummary(frame)) {
+            summariesSent++;
+        } else {
+            summariesFailed++;
+            LOG_W("[THREAD] Summary of DUT %d not sent\n", frame.data[3]);
+        }
+    }
+}
+
+void printThreadStatus() {
+    char status[32];
+    getThreadStatus(status, sizeof(status));
+    Console.printf("Thread: %s, collector [%s]:%u\n", status, destAddress, destPort);
+    Console.printf("Summaries: %lu sent, %lu dropped, %lu failed, %u queued\n", (unsigned long)summariesSent,
+                  (unsigned long)summariesDropped, (unsigned long)summariesFailed,
+                  summaryQueue != nullptr ? (unsigned)uxQueueMessagesWaiting(summaryQueue) : 0);
+}
+
+#endif // THREAD_UPLINK
@@ -0,0 +1,81 @@
+#include "trace.h"
+#include "console.h"
+#if TRACE_SYSVIEW
+#include "SEGGER_SYSVIEW.h"
+#endif
+
+TraceRecord traceRing[TRACE_RING_SIZE];
+uint32_t traceHead = 0;
+
+#if TRACE_SYSVIEW
+// Names for the SystemView event list - as EVENT_NAMES in trace_decode.py
+static const struct {
+    uint16_t event;
+    const char* name;
+} sysViewNames[] = {
+    {TRACE_UART_BLOCK, "UART_BLOCK"}, {TRACE_UART_FRAME, "UART_FRAME"}, {TRACE_UART_ACK, "UART_ACK"},
+    {TRACE_UART_CMD_TX, "UART_CMD_TX"}, {TRACE_UART_OVERFLOW, "UART_OVERFLOW"},
+    {TRACE_BATCH_FLUSH, "BATCH_FLUSH"}, {TRACE_CAL_BEGIN, "CAL_BEGIN"}, {TRACE_CAL_END, "CAL_END"},
+    {TRACE_BATCH_PROCESSED, "BATCH_PROCESSED"}, {TRACE_BLE_TX_BEGIN, "BLE_TX_BEGIN"},
+    {TRACE_BLE_TX_END, "BLE_TX_END"}, {TRACE_GUI_RENDER_BEGIN, "GUI_RENDER_BEGIN"},
+    {TRACE_GUI_RENDER_END, "GUI_RENDER_END"}, {TRACE_GUI_STATE, "GUI_STATE"}, {TRACE_GUI_WAKE, "GUI_WAKE"},
+};
+
+static void sendSysViewDescription();
+
+static SEGGER_SYSVIEW_MODULE sysViewModule = {
+    "M=BioPal", TRACE_SV_EVENTS, 0, sendSysViewDescription, nullptr,
+};
+
+// 0x0100..0x040F -> 0..63, -1 outside
+static int sysViewIndex(uint16_t event) {
+    uint16_t group = event >> 8;
+    uint16_t index = event & 0xFF;
+    if (group < 1 || group > 4 || index >= TRACE_SV_GROUP_EVENTS) {
+        return -1;
+    }
+    return (group - 1) * TRACE_SV_GROUP_EVENTS + index;
+}
+
+// Sent by SystemView when a recording starts
+static void sendSysViewDescription() {
+    char text[48];
+    for (const auto& entry : sysViewNames) {
+        snprintf(text, sizeof(text), "%d %s a0=%%u a1=%%u a2=%%u", sysViewIndex(entry.event), entry.name);
+        SEGGER_SYSVIEW_RecordModuleDescription(&sysViewModule, text);
+    }
+}
+
+void traceSysView(uint16_t event, uint16_t arg0, uint32_t arg1, uint32_t arg2) {
+    int index = sysViewIndex(event);
+    if (index >= 0) {
+        SEGGER_SYSVIEW_RecordU32x3(sysViewModule.EventOffset + index, arg0, arg1, arg2);
+    }
+}
+#endif
+
+void initTrace() {
+#if TRACE_SYSVIEW
+    SEGGER_SYSVIEW_RegisterModule(&sysViewModule);
+    Console.println("[TRACE] SystemView events over JTAG apptrace");
+#endif
+}
+
+void traceClear() {
+    __atomic_store_n(&traceHead, 0, __ATOMIC_RELAXED);
+}
+
+void traceDump() {
+    // Snapshot the head - records written during the dump may be mixed in
+    uint32_t head = __atomic_load_n(&traceHead, __ATOMIC_RELAXED);
+    uint32_t count = min(head, (uint32_t)TRACE_RING_SIZE);
+    uint32_t first = head - count;
+
+    Console.printf("TRACE_BEGIN %d %lu %d\n", TRACE_FORMAT_VER, count, (int)sizeof(TraceRecord));
+    for (uint32_t i = 0; i < count; i++) {
+        const TraceRecord& rec = traceRing[(first + i) & (TRACE_RING_SIZE - 1)];
+        consoleWriteWait((const uint8_t*)&rec, sizeof(rec));
+    }
+    Console.println();
+    Console.println("TRACE_END");
+}
@@ -0,0 +1,288 @@
+#include "uart_frame.h"
+#include "crc.h"
+#include "log.h"
+#include <math.h>
+
+uint16_t uartCompactMagCode(float magnitude) {
+    if (!(magnitude > 0.0f)) {
+        return 0;
+    }
+    long code = lroundf(logf(magnitude) * UART_COMPACT_MAG_STEPS_PER_LN) + UART_COMPACT_MAG_ZERO;
+    return (uint16_t)(code < 1 ? 1 : code > 0xFFFF ? 0xFFFF : code);
+}
+
+float uartCompactMagnitude(uint16_t code) {
+    if (code == 0) {
+        return 0.0f;
+    }
+    return expf((float)((int32_t)code - UART_COMPACT_MAG_ZERO) / UART_COMPACT_MAG_STEPS_PER_LN);
+}
+
+// Legacy frame: AA type payload 55
+static FrameCheck checkLegacyFrame(const uint8_t* data, size_t avail, size_t* size) {
+    if (avail < 2) {
+        return FRAME_INCOMPLETE;
+    }
+
+    // Variable-size frames need the v2 length byte
+    uint8_t type = data[1];
+    bool legacy = type < UART_FRAME_TYPE_LIMIT && (uartFrameSchema.spec[type].flags & UART_FRAME_LEGACY);
+    size_t payloadSize = legacy ? uartPayloadSize(type) : 0;
+    if (payloadSize == 0) {
+        return FRAME_INVALID;  // e.g. 0xAA inside a payload
+    }
+
+    size_t frameSize = payloadSize + UART_LEGACY_OVERHEAD;
+    if (avail < frameSize) {
+        return FRAME_INCOMPLETE;
+    }
+    if (data[frameSize - 1] != UART_DATA_END_BYTE) {
+        LOG_D("Invalid end byte: 0x%02X\n", data[frameSize - 1]);
+        return FRAME_INVALID;
+    }
+
+    *size = frameSize;
+    return FRAME_OK;
+}
+
+// v2 frame: A5 5A ver type len payload crc16
+static FrameCheck checkV2Frame(const uint8_t* data, size_t avail, size_t* size, UARTFrameCounters& counters) {
+    if (avail < UART_V2_HEADER_SIZE) {
+        // Reject early on what we can already see
+        if (avail >= 2 && data[1] != UART_V2_SYNC1) return FRAME_INVALID;
+        if (avail >= 3 && data[2] != UART_V2_VERSION) return FRAME_INVALID;
+        return FRAME_INCOMPLETE;
+    }
+    if (data[1] != UART_V2_SYNC1 || data[2] != UART_V2_VERSION) {
+        return FRAME_INVALID;
+    }
+
+    uint8_t type = data[3];
+    uint8_t len = data[4];
+    size_t expected = uartPayloadSize(type);
+    if (expected == 0 || len < expected || len > UART_V2_MAX_PAYLOAD) {
+        return FRAME_INVALID;
+    }
+
+    size_t frameSize = UART_V2_HEADER_SIZE + len + UART_V2_CRC_SIZE;
+    if (avail < frameSize) {
+        return FRAME_INCOMPLETE;
+    }
+
+    // CRC covers ver, type, len and payload
+    uint16_t crc = crc16_ccitt(&data[2], UART_V2_HEADER_SIZE - 2 + len);
+    uint16_t rxCrc = (uint16_t)data[frameSize - 2] | ((uint16_t)data[frameSize - 1] << 8);
+    if (crc != rxCrc) {
+        counters.crcErrors++;
+        return FRAME_INVALID;
+    }
+
+    *size = frameSize;
+    return FRAME_OK;
+}
+
+// Find the next byte that may start a legacy or v2 frame
+static size_t findFrameStart(const uint8_t* data, size_t pos, size_t len) {
+    while (pos < len && data[pos] != UART_DATA_START_BYTE && data[pos] != UART_V2_SYNC0) {
+        pos++;
+    }
+    return pos;
+}
+
+// outOfSync carries the resync state across calls on a stage
+static size_t scanFrames(const uint8_t* data, size_t len, size_t* consumed, UARTFrameHandler handler,
+                         void* context, UARTFrameCounters& counters, bool& outOfSync) {
+    size_t pos = 0;
+    size_t frames = 0;
+
+    while (pos < len) {
+        // Resync: jump to the next start byte
+        size_t start = findFrameStart(data, pos, len);
+        if (start > pos && !outOfSync) {
+            counters.resyncs++;
+            outOfSync = true;
+        }
+        counters.bytesSkipped += start - pos;
+        pos = start;
+        if (pos >= len) {
+            break;
+        }
+
+        const uint8_t* frame = data + pos;
+        size_t avail = len - pos;
+        size_t frameSize = 0;
+        bool isV2 = (frame[0] == UART_V2_SYNC0);
+
+        FrameCheck check = isV2 ? checkV2Frame(frame, avail, &frameSize, counters)
+                                : checkLegacyFrame(frame, avail, &frameSize);
+
+        if (check == FRAME_INCOMPLETE) {
+            break;  // Leave it for the next block
+        }
+        if (check == FRAME_INVALID) {
+            if (!outOfSync) {
+                counters.resyncs++;
+                outOfSync = true;
+            }
+            counters.bytesSkipped++;
+            pos++;
+            continue;
+        }
+
+        if (isV2) {
+            handler(frame[3], &frame[UART_V2_HEADER_SIZE], frame[4], true, context);
+            counters.v2Frames++;
+        } else {
+            handler(frame[1], &frame[2], frameSize - UART_LEGACY_OVERHEAD, false, context);
+        }
+        counters.framesParsed++;
+        frames++;
+        pos += frameSize;
+        outOfSync = false;
+    }
+
+    *consumed = pos;
+    return frames;
+}
+
+size_t scanUARTFrames(const uint8_t* data, size_t len, size_t* consumed,
+                      UARTFrameHandler handler, void* context, UARTFrameCounters& counters) {
+    bool outOfSync = false;
+    return scanFrames(data, len, consumed, handler, context, counters, outOfSync);
+}
+
+size_t parseUARTStage(UARTFrameStage& stage, UARTFrameHandler handler, void* context,
+                      UARTFrameCounters& counters) {
+    size_t consumed = 0;
+    size_t frames = scanFrames(stage.data, stage.len, &consumed, handler, context, counters, stage.outOfSync);
+
+    size_t remaining = stage.len - consumed;
+    if (remaining > 0 && consumed > 0) {
+        memmove(stage.data, stage.data + consumed, remaining);
+    }
+    stage.len = remaining;
+    return frames;
+}
+
+size_t feedUARTFrames(UARTFrameStage& stage, const uint8_t* data, size_t len,
+                      UARTFrameHandler handler, void* context, UARTFrameCounters& counters) {
+    size_t frames = 0;
+
+    // Fast path: nothing pending, parse the caller's buffer directly
+    if (stage.len == 0) {
+        size_t consumed = 0;
+        frames = scanFrames(data, len, &consumed, handler, context, counters, stage.outOfSync);
+        data += consumed;
+        len -= consumed;
+    }
+
+    // Append the rest after the pending tail and parse in place
+    while (len > 0) {
+        size_t toCopy = min(len, UART_RX_STAGE_SIZE - stage.len);
+        memcpy(stage.data + stage.len, data, toCopy);
+        stage.len += toCopy;
+        data += toCopy;
+        len -= toCopy;
+        frames += parseUARTStage(stage, handler, context, counters);
+    }
+    return frames;
+}
+
+/*=========================FRAME CODEC=========================*/
+
+static size_t wrapFrame(uint8_t* out, uint8_t start, uint8_t type, const void* payload, size_t len, bool v2) {
+    if (v2) {
+        out[0] = UART_V2_SYNC0;
+        out[1] = UART_V2_SYNC1;
+        out[2] = UART_V2_VERSION;
+        out[3] = type;
+        out[4] = len;
+        memcpy(&out[UART_V2_HEADER_SIZE], payload, len);
+        uint16_t crc = crc16_ccitt(&out[2], UART_V2_HEADER_SIZE - 2 + len);
+        out[UART_V2_HEADER_SIZE + len] = crc & 0xFF;
+        out[UART_V2_HEADER_SIZE + len + 1] = crc >> 8;
+        return UART_V2_HEADER_SIZE + len + UART_V2_CRC_SIZE;
+    }
+    out[0] = start;
+    out[1] = type;
+    memcpy(&out[2], payload, len);
+    out[2 + len] = UART_DATA_END_BYTE;
+    return len + UART_LEGACY_OVERHEAD;
+}
+
+size_t encodeUARTFrame(uint8_t* out, uint8_t type, const void* payload, size_t len, bool v2) {
+    if (type >= UART_FRAME_TYPE_LIMIT || uartFrameSchema.spec[type].payloadSize == 0) {
+        return 0;
+    }
+    const UARTFrameSpec& spec = uartFrameSchema.spec[type];
+    if (len < spec.payloadSize || len > UART_V2_MAX_PAYLOAD || (!v2 && !(spec.flags & UART_FRAME_LEGACY))) {
+        return 0;
+    }
+    // Legacy frames have no length byte - exactly the schema size
+    if (!v2) {
+        len = spec.payloadSize;
+    }
+    if (spec.flags & UART_FRAME_BLOCK) {
+        uint8_t count = static_cast<const UARTFrequencyBlockHeader*>(payload)->count;
+        if (count == 0 || count > UART_BLOCK_MAX_POINTS || len != spec.payloadSize + (size_t)count * spec.pointSize) {
+            return 0;
+        }
+    }
+    return wrapFrame(out, UART_DATA_START_BYTE, type, payload, len, v2);
+}
+
+size_t encodeUARTAck(uint8_t* out, uint8_t cmd, uint8_t seq, bool v2) {
+    UARTAckSeqPayload ack = {0x01, seq};
+    if (cmd >= UART_FRAME_TYPE_LIMIT || !(uartFrameSchema.spec[cmd].flags & UART_FRAME_ACK)) {
+        return 0;
+    }
+    return wrapFrame(out, UART_DATA_START_BYTE, cmd, &ack, v2 ? sizeof(UARTAckSeqPayload) : sizeof(UARTAckPayload), v2);
+}
+
+size_t encodeUARTCommand(uint8_t* out, const UARTCommand& command, bool v2) {
+    if (v2) {
+        UARTCommandPayload payload = {command.seq, command.data1, command.data2, command.data3};
+        return wrapFrame(out, UART_CMD_START_BYTE, command.type, &payload, sizeof(payload), true);
+    }
+    UARTLegacyCommandPayload payload = {command.data1, command.data2, command.data3};
+    return wrapFrame(out, UART_CMD_START_BYTE, command.type, &payload, sizeof(payload), false);
+}
+
+FrameCheck decodeUARTCommand(const uint8_t* data, size_t len, UARTCommand& command, bool& v2, size_t& size) {
+    if (len == 0) {
+        return FRAME_INCOMPLETE;
+    }
+    if (data[0] == UART_CMD_START_BYTE) {
+        if (len < UART_CMD_PACKET_SIZE) {
+            return FRAME_INCOMPLETE;
+        }
+        if (data[UART_CMD_PACKET_SIZE - 1] != UART_CMD_END_BYTE) {
+            return FRAME_INVALID;
+        }
+        UARTLegacyCommandPayload payload;
+        memcpy(&payload, &data[2], sizeof(payload));
+        command = {data[1], 0, payload.data1, payload.data2, payload.data3};
+        v2 = false;
+        size = UART_CMD_PACKET_SIZE;
+        return FRAME_OK;
+    }
+    if (data[0] != UART_V2_SYNC0) {
+        return FRAME_INVALID;
+    }
+    const size_t frameSize = UART_V2_HEADER_SIZE + sizeof(UARTCommandPayload) + UART_V2_CRC_SIZE;
+    if (len < frameSize) {
+        return FRAME_INCOMPLETE;
+    }
+    size_t crcAt = UART_V2_HEADER_SIZE + sizeof(UARTCommandPayload);
+    uint16_t crc = crc16_ccitt(&data[2], crcAt - 2);
+    if (data[1] != UART_V2_SYNC1 || data[2] != UART_V2_VERSION || data[4] != sizeof(UARTCommandPayload) ||
+        crc != ((uint16_t)data[crcAt] | (uint16_t)data[crcAt + 1] << 8)) {
+        return FRAME_INVALID;
+    }
+    UARTCommandPayload payload;
+    memcpy(&payload, &data[UART_V2_HEADER_SIZE], sizeof(payload));
+    command = {data[3], payload.seq, payload.data1, payload.data2, payload.data3};
+    v2 = true;
+    size = frameSize;
+    return FRAME_OK;
+}
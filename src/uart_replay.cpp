@@ -0,0 +1,139 @@
+// Host replay harness for the UART frame parser - [env:replay] only, the
+// firmware build (ARDUINO) compiles this file to nothing
+//
+// Feeds a recorded STM32 byte stream (logic analyser / USB-UART dump, or one
+// made by uart_replay_gen.py from STM_output.csv or a raw capture) through
+// feedUARTFrames() in receive-sized blocks, the same path processIncomingBytes()
+// takes on the device, and reports frames/s, resyncs and per-frame latency
+//
+// Usage: pio run -e replay
+//        .pio/build/replay/program stream.bin [--block N] [--passes N] [--expect FRAMES]
+#ifndef ARDUINO
+
+#include "uart_frame.h"
+#include <chrono>
+#include <vector>
+
+struct ReplayStats {
+    uint32_t byType[256];
+    std::vector<uint32_t> latencyNs;    // Block handed over -> frame dispatched
+    std::chrono::steady_clock::time_point blockStart;
+};
+
+static void onFrame(uint8_t type, const uint8_t* payload, size_t len, bool v2, void* context) {
+    ReplayStats& stats = *static_cast<ReplayStats*>(context);
+    stats.byType[type]++;
+    auto now = std::chrono::steady_clock::now();
+    stats.latencyNs.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now - stats.blockStart).count());
+}
+
+static const char* typeName(int type) {
+    switch (type) {
+        case UART_DATA_DUT_START:     return "DUT_START";
+        case UART_DATA_FREQUENCY:     return "FREQUENCY";
+        case UART_DATA_DUT_END:       return "DUT_END";
+        case UART_DATA_DEVICE_ID:     return "DEVICE_ID";
+        case UART_DATA_FREQUENCY_DUT: return "FREQUENCY_DUT";
+        case UART_DATA_FREQUENCY_IDX: return "FREQUENCY_IDX";
+        case UART_DATA_FREQUENCY_BLOCK: return "FREQUENCY_BLOCK";
+        case UART_DATA_COMPACT_BLOCK: return "COMPACT_BLOCK";
+        case UART_DATA_LINK_TEST:     return "LINK_TEST";
+        default:                      return "ACK";
+    }
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    fclose(file);
+    return true;
+}
+
+static uint32_t percentile(const std::vector<uint32_t>& sorted, int pct) {
+    return sorted.empty() ? 0 : sorted[(sorted.size() - 1) * pct / 100];
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    size_t block = UART_RX_BLOCK_SIZE;
+    int passes = 1;
+    long expect = -1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            block = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--passes") == 0 && i + 1 < argc) {
+            passes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--expect") == 0 && i + 1 < argc) {
+            expect = strtol(argv[++i], nullptr, 10);
+        } else if (path == nullptr && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if (path == nullptr || block == 0 || passes < 1) {
+        fprintf(stderr, "Usage: %s stream.bin [--block N] [--passes N] [--expect FRAMES]\n", argv[0]);
+        fprintf(stderr, "  --block 1 replays byte by byte (processIncomingByte)\n");
+        return 2;
+    }
+
+    std::vector<uint8_t> stream;
+    if (!readFile(path, stream) || stream.empty()) {
+        fprintf(stderr, "ERROR: Cannot read %s\n", path);
+        return 2;
+    }
+
+    static ReplayStats stats = {};
+    stats.latencyNs.reserve(stream.size() / sizeof(UARTDutEndPayload) + 1);
+    UARTFrameCounters counters = {};
+    size_t frames = 0;
+
+    // Each pass starts with an empty stage, as after a link reset
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        UARTFrameStage stage = {};
+        for (size_t pos = 0; pos < stream.size(); pos += block) {
+            size_t len = min(block, stream.size() - pos);
+            stats.blockStart = std::chrono::steady_clock::now();
+            frames += feedUARTFrames(stage, &stream[pos], len, onFrame, &stats, counters);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double bytes = (double)stream.size() * passes;
+    HAL_PRINTF("Stream:     %s (%zu bytes), block %zu, %d pass%s\n",
+               path, stream.size(), block, passes, passes > 1 ? "es" : "");
+    HAL_PRINTF("Frames:     %zu per pass", frames / passes);
+    for (int type = 0; type < 256; type++) {
+        if (stats.byType[type] > 0) {
+            HAL_PRINTF(", %s 0x%02X %u", typeName(type), type, stats.byType[type] / passes);
+        }
+    }
+    HAL_PRINTF("\n");
+    HAL_PRINTF("v2 frames:  %u\n", counters.v2Frames / passes);
+    HAL_PRINTF("Resyncs:    %u (%u bytes skipped, %u CRC errors)\n",
+               counters.resyncs / passes, counters.bytesSkipped / passes, counters.crcErrors / passes);
+    HAL_PRINTF("Throughput: %.0f frames/s, %.2f MB/s\n", frames / seconds, bytes / seconds / 1e6);
+
+    std::vector<uint32_t>& latency = stats.latencyNs;
+    std::sort(latency.begin(), latency.end());
+    HAL_PRINTF("Latency:    min %u ns, p50 %u ns, p99 %u ns, max %u ns\n",
+               percentile(latency, 0), percentile(latency, 50), percentile(latency, 99), percentile(latency, 100));
+
+    if (expect >= 0 && (long)(frames / passes) != expect) {
+        fprintf(stderr, "FAIL: expected %ld frames per pass, got %zu\n", expect, frames / passes);
+        return 1;
+    }
+    return 0;
+}
+
+#endif // ARDUINO
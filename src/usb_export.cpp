@@ -0,0 +1,163 @@
+#include "usb_export.h"
+#include "console.h"
+#include "defines.h"
+#include "crc.h"
+#include "meas_store.h"
+#include "meas_session.h"
+#include "meas_control.h"
+#include "pssession_export.h"
+
+// Largest decoded frame: a ROW of MAX_FREQUENCIES points plus type and CRC
+#define USB_EXPORT_FRAME_MAX    (1 + 3 + MAX_FREQUENCIES * sizeof(UsbExportPoint) + 2)
+// COBS adds one byte per 254, plus the two delimiters
+#define USB_EXPORT_WIRE_MAX     (USB_EXPORT_FRAME_MAX + USB_EXPORT_FRAME_MAX / 254 + 3)
+static_assert(USB_EXPORT_WIRE_MAX <= CONSOLE_RECORD_MAX, "A frame must go out as one console record");
+static_assert(1 + 4 + PSSESSION_CHUNK + 2 <= USB_EXPORT_FRAME_MAX, "A document chunk must fit one frame");
+
+// GUI task only
+static uint8_t frame[USB_EXPORT_FRAME_MAX];
+static uint8_t wire[USB_EXPORT_WIRE_MAX];
+
+/*=========================FRAMING=========================*/
+
+// COBS-encode len bytes of in to out, between two 0x00 delimiters
+static size_t encodeFrame(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t o = 0;
+    out[o++] = 0x00;
+    size_t codeAt = o++;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] != 0x00) {
+            out[o++] = in[i];
+            code++;
+        }
+        if (in[i] == 0x00 || code == 0xFF) {
+            out[codeAt] = code;
+            codeAt = o++;
+            code = 1;
+        }
+    }
+    out[codeAt] = code;
+    out[o++] = 0x00;
+    return o;
+}
+
+// Append the CRC to the len bytes in frame and write them as one frame
+static void sendFrame(size_t len) {
+    uint16_t crc = crc16_ccitt(frame, len);
+    frame[len++] = crc & 0xFF;
+    frame[len++] = crc >> 8;
+    consoleWriteWait(wire, encodeFrame(frame, len, wire));
+}
+
+void sendUsbExportFrame(uint8_t type, const uint8_t* body, size_t len) {
+    if (1 + len + 2 > USB_EXPORT_FRAME_MAX) {
+        return;
+    }
+    frame[0] = type;
+    memcpy(&frame[1], body, len);
+    sendFrame(1 + len);
+}
+
+/*=========================EXPORT=========================*/
+
+// ROW frame of one stored row; returns its points
+static int sendRow(uint8_t dut, bool final) {
+    const ImpedanceRow& row = final ? measurementImpedanceData[dut] : baselineImpedanceData[dut];
+    int count = min(getRowPointCount(!final, dut), (int)getPointsPerDUT());
+    if (row.mag == nullptr || count == 0) {
+        return 0;
+    }
+
+    frame[0] = USB_EXPORT_ROW;
+    frame[1] = dut;
+    frame[2] = final ? 1 : 0;
+    frame[3] = count;
+    UsbExportPoint* points = (UsbExportPoint*)&frame[4];
+    for (int i = 0; i < count; i++) {
+        points[i].freqHz = storedFrequency(row.freqCode[i]);
+        points[i].magnitude = row.mag[i];
+        points[i].phase = row.phase[i];
+        points[i].flags = row.flags[i];
+        points[i].magSd = row.magSd[i];
+        points[i].phaseSd = row.phaseSd[i];
+    }
+    sendFrame(4 + count * sizeof(UsbExportPoint));
+    return count;
+}
+
+bool sendBinaryExport(bool finishedOnly) {
+    // Kind of the rows being swept, if left out: 0 baseline, 1 final, -1 none
+    int running = -1;
+    if (finishedOnly && getMeasurementState() != MEAS_IDLE) {
+        running = isFinalGeneration(getMeasurementGeneration()) ? 1 : 0;
+    }
+
+    int total = 0;
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        total += (running == 0 ? 0 : getRowPointCount(true, dut)) + (running == 1 ? 0 : getRowPointCount(false, dut));
+    }
+    if (total == 0) {
+        Console.println("Export: no stored points");
+        return false;
+    }
+
+    uint32_t generation = getMeasurementGeneration();
+    frame[0] = USB_EXPORT_BEGIN;
+    frame[1] = USB_EXPORT_VERSION;
+    frame[2] = getDUTCount();
+    frame[3] = getPointsPerDUT();
+    frame[4] = (baselineMeasurementDone ? USB_EXPORT_STATE_BASELINE : 0) |
+               (finalMeasurementDone ? USB_EXPORT_STATE_FINAL : 0);
+    memcpy(&frame[5], &generation, sizeof(generation));
+    sendFrame(9);
+
+    uint8_t rows = 0;
+    uint16_t points = 0;
+    for (uint8_t dut = 0; dut < getDUTCount(); dut++) {
+        for (int final = 0; final < 2; final++) {
+            int count = final == running ? 0 : sendRow(dut, final);
+            if (count > 0) {
+                rows++;
+                points += count;
+            }
+        }
+    }
+
+    frame[0] = USB_EXPORT_END;
+    frame[1] = rows;
+    memcpy(&frame[2], &points, sizeof(points));
+    sendFrame(4);
+    return true;
+}
+
+/*=========================PSSESSION EXPORT=========================*/
+
+// GUI task only - bytes of the document sent so far
+static uint32_t fileOffset = 0;
+
+static bool sendFileChunk(const uint8_t* data, size_t len, void* context) {
+    uint8_t body[4 + PSSESSION_CHUNK];
+    memcpy(body, &fileOffset, sizeof(fileOffset));
+    memcpy(&body[4], data, len);
+    sendUsbExportFrame(USB_EXPORT_FILE, body, 4 + len);
+    fileOffset += len;
+    return true;
+}
+
+bool sendPsSessionExport(bool final) {
+    if (!hasPsSessionData(final)) {
+        Console.println("Export: no valid points");
+        return false;
+    }
+    fileOffset = 0;
+    uint8_t complete = writePsSession(final, sendFileChunk, nullptr) ? 1 : 0;
+    uint8_t body[5];
+    memcpy(body, &fileOffset, sizeof(fileOffset));
+    body[4] = complete;
+    sendUsbExportFrame(USB_EXPORT_FILE_END, body, sizeof(body));
+    if (!complete) {
+        Console.println("Export: a new sweep started - document cut short");
+    }
+    return true;
+}
@@ -0,0 +1,492 @@
+#include "wifi_server.h"
+#include "console.h"
+
+#if WIFI_SERVER
+
+#include "BLE_Functions.h"
+#include "UART_Functions.h"
+#include "history_download.h"
+#include "pssession_export.h"
+#include "defines.h"
+#include "storage.h"
+#include "task_monitor.h"
+#include "heap_stats.h"
+#include "gui_screens.h"
+#include "log.h"
+#include <WiFi.h>
+#include <ESPmDNS.h>
+#include <LittleFS.h>
+#include <esp_http_server.h>
+#include <unistd.h>
+#include "freertos/message_buffer.h"
+#include "freertos/semphr.h"
+
+/*=========================STATE=========================*/
+// Network - written by the GUI / serial commands, read by the event handler
+static char ssid[WIFI_SSID_MAX + 1] = "";
+static char pass[WIFI_PASS_MAX + 1] = "";
+static bool enabled = false;
+static volatile bool connected = false;
+static volatile uint32_t ipAddress = 0;
+
+static httpd_handle_t server = nullptr;
+
+// Live WebSocket sockets - added / removed by the server task, read by the TX task
+static int liveSockets[WIFI_WS_CLIENTS];
+static uint8_t liveCount = 0;
+static portMUX_TYPE liveMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Live frames for the TX task - any task writes, under liveMutex
+static MessageBufferHandle_t liveBuffer = nullptr;
+static SemaphoreHandle_t liveMutex = nullptr;
+static uint8_t liveBufferStorage[WIFI_WS_BUFFER_BYTES + 1];
+static StaticMessageBuffer_t liveBufferControl;
+static StaticSemaphore_t liveMutexControl;
+static volatile uint32_t liveDrops = 0;
+
+/*=========================SETTINGS=========================*/
+static void copyText(char* dest, const char* src, size_t size) {
+    strncpy(dest, src, size - 1);
+    dest[size - 1] = '\0';
+}
+
+static void loadConfig() {
+    if (!isStorageMounted()) {
+        return;
+    }
+    File file = LittleFS.open(WIFI_CONFIG_FILE, "r");
+    if (!file) {
+        return;
+    }
+    String on = file.readStringUntil('\n');
+    String name = file.readStringUntil('\n');
+    String key = file.readStringUntil('\n');
+    file.close();
+    enabled = on.toInt() == 1;
+    copyText(ssid, name.c_str(), sizeof(ssid));
+    copyText(pass, key.c_str(), sizeof(pass));
+}
+
+static bool saveConfig() {
+    char text[8 + WIFI_SSID_MAX + WIFI_PASS_MAX];
+    int len = snprintf(text, sizeof(text), "%d\n%s\n%s\n", enabled ? 1 : 0, ssid, pass);
+    return queueStorageWrite(WIFI_CONFIG_FILE, text, len);
+}
+
+/*=========================LIVE SOCKETS=========================*/
+static void updateLiveHandover() {
+    setLiveBatchHandover(anyBLEClientStreaming() || liveCount > 0);
+}
+
+static bool addLiveSocket(int fd) {
+    bool added = false;
+    portENTER_CRITICAL(&liveMux);
+    if (liveCount < WIFI_WS_CLIENTS) {
+        liveSockets[liveCount++] = fd;
+        added = true;
+    }
+    portEXIT_CRITICAL(&liveMux);
+    updateLiveHandover();
+    return added;
+}
+
+static void removeLiveSocket(int fd) {
+    portENTER_CRITICAL(&liveMux);
+    for (uint8_t i = 0; i < liveCount; i++) {
+        if (liveSockets[i] == fd) {
+            liveSockets[i] = liveSockets[--liveCount];
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&liveMux);
+    updateLiveHandover();
+}
+
+// Server close_fn - every closed socket, live or not
+static void onSocketClose(httpd_handle_t handle, int fd) {
+    removeLiveSocket(fd);
+    close(fd);
+}
+
+uint8_t getWiFiLiveClients() {
+    return liveCount;
+}
+
+uint32_t getWiFiLiveDrops() {
+    return liveDrops;
+}
+
+bool sendWiFiLive(const uint8_t* data, size_t len) {
+    if (liveCount == 0 || liveBuffer == nullptr || len == 0) {
+        return false;
+    }
+    bool ok = false;
+    if (len <= WIFI_WS_FRAME_MAX) {
+        xSemaphoreTake(liveMutex, portMAX_DELAY);
+        ok = xMessageBufferSend(liveBuffer, data, len, 0) > 0;
+        xSemaphoreGive(liveMutex);
+    }
+    if (!ok) {
+        liveDrops++;
+    }
+    return ok;
+}
+
+/*=========================TX TASK=========================*/
+void taskWiFiTx(void* parameter) {
+    static uint8_t frame[WIFI_WS_FRAME_MAX];
+    int sockets[WIFI_WS_CLIENTS];
+    Console.println("Wi-Fi TX task started");
+
+    while (true) {
+        taskWatchdogFeed();
+        size_t len = xMessageBufferReceive(liveBuffer, frame, sizeof(frame), pdMS_TO_TICKS(TASK_WDT_FEED_MS));
+        if (len == 0 || server == nullptr) {
+            continue;
+        }
+        portENTER_CRITICAL(&liveMux);
+        uint8_t count = liveCount;
+        memcpy(sockets, liveSockets, sizeof(sockets));
+        portEXIT_CRITICAL(&liveMux);
+
+        httpd_ws_frame_t ws = {};
+        ws.final = true;
+        ws.type = frame[0] == BLE_BIN_MAGIC ? HTTPD_WS_TYPE_BINARY : HTTPD_WS_TYPE_TEXT;
+        ws.payload = frame;
+        ws.len = len;
+        for (uint8_t i = 0; i < count; i++) {
+            // lwIP buffers are the framework's, as in the BT stack
+            heapStatsEnterFramework();
+            esp_err_t err = httpd_ws_send_frame_async(server, sockets[i], &ws);
+            heapStatsExitFramework();
+            if (err != ESP_OK) {
+                LOG_W("[WIFI] Live socket %d failed - closing\n", sockets[i]);
+                httpd_sess_trigger_close(server, sockets[i]);
+            }
+            // A send may take up to WIFI_SEND_TIMEOUT_S per socket
+            taskWatchdogFeed();
+        }
+    }
+}
+
+/*=========================HTTP HANDLERS=========================*/
+// The WebUI is served from elsewhere - let it read the replies and headers
+static void setCorsHeaders(httpd_req_t* req) {
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(req, "Access-Control-Expose-Headers",
+                       "X-History-Id, X-History-Size, X-History-Start, X-History-Match");
+}
+
+static esp_err_t sendStatus(httpd_req_t* req, const char* status, const char* message) {
+    httpd_resp_set_status(req, status);
+    httpd_resp_set_type(req, "text/plain");
+    return httpd_resp_sendstr(req, message);
+}
+
+static esp_err_t handleHistoryInfo(httpd_req_t* req) {
+    setCorsHeaders(req);
+    uint32_t id, size;
+    if (!getHistoryImageInfo(id, size)) {
+        return sendStatus(req, "503 Service Unavailable", "Storage unavailable");
+    }
+    char json[96];
+    snprintf(json, sizeof(json), "{\"version\":%d,\"id\":%lu,\"size\":%lu}",
+             HISTORY_VERSION, (unsigned long)id, (unsigned long)size);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, json);
+}
+
+// Unsigned query parameter, or fallback if it is not given
+static uint32_t queryValue(const char* query, const char* key, uint32_t fallback) {
+    char value[16];
+    if (query[0] == '\0' || httpd_query_key_value(query, key, value, sizeof(value)) != ESP_OK) {
+        return fallback;
+    }
+    return strtoul(value, nullptr, 10);
+}
+
+// after=<timestamp>.<dut>.<kind>.<crc>[,...] into the refs of sync - false
+// if the list does not parse
+static bool parseSyncRefs(const char* text, HistorySyncRequest& sync) {
+    sync.count = 0;
+    while (*text != '\0') {
+        if (sync.count >= HISTORY_SYNC_REFS) {
+            return false;
+        }
+        unsigned long timestamp, dut, kind, crc;
+        int used = 0;
+        if (sscanf(text, "%lu.%lu.%lu.%lu%n", &timestamp, &dut, &kind, &crc, &used) != 4 ||
+            (text[used] != ',' && text[used] != '\0')) {
+            return false;
+        }
+        sync.refs[sync.count++] = {(uint32_t)timestamp, (uint8_t)dut, (uint8_t)kind, (uint16_t)crc};
+        text += text[used] == ',' ? used + 1 : used;
+    }
+    return true;
+}
+
+static esp_err_t handleHistory(httpd_req_t* req) {
+    // Handlers run one at a time in the server task
+    static uint8_t chunk[WIFI_HTTP_CHUNK_BYTES];
+    setCorsHeaders(req);
+
+    char query[192] = "";
+    char after[160] = "";
+    if (httpd_req_get_url_query_len(req) + 1 <= sizeof(query)) {
+        httpd_req_get_url_query_str(req, query, sizeof(query));
+    }
+    uint32_t id, size, offset;
+    uint8_t match = HISTORY_SYNC_GENERATION;
+    if (query[0] != '\0' && httpd_query_key_value(query, "after", after, sizeof(after)) == ESP_OK) {
+        // Sync: id and offset are what the client holds, the sessions its newest
+        HistorySyncRequest sync = {HISTORY_REQ_SYNC, 0, {}, queryValue(query, "id", 0),
+                                   queryValue(query, "offset", 0), {}};
+        if (!parseSyncRefs(after, sync)) {
+            return sendStatus(req, "400 Bad Request", "after: up to 4 of <timestamp>.<dut>.<kind>.<crc>");
+        }
+        if (!syncHistoryImage(sync, id, size, offset, match)) {
+            return sendStatus(req, "503 Service Unavailable", "Storage unavailable");
+        }
+    } else {
+        if (!getHistoryImageInfo(id, size)) {
+            return sendStatus(req, "503 Service Unavailable", "Storage unavailable");
+        }
+        if (queryValue(query, "id", id) != id) {
+            return sendStatus(req, "409 Conflict", "Session log rotated - read /history/info again");
+        }
+        offset = queryValue(query, "offset", 0);
+        if (offset > size) {
+            return sendStatus(req, "416 Range Not Satisfiable", "Offset past the end of the image");
+        }
+    }
+
+    char idText[12], sizeText[12], startText[12], matchText[4];
+    snprintf(idText, sizeof(idText), "%lu", (unsigned long)id);
+    snprintf(sizeText, sizeof(sizeText), "%lu", (unsigned long)size);
+    snprintf(startText, sizeof(startText), "%lu", (unsigned long)offset);
+    snprintf(matchText, sizeof(matchText), "%u", match);
+    httpd_resp_set_hdr(req, "X-History-Id", idText);
+    httpd_resp_set_hdr(req, "X-History-Size", sizeText);
+    httpd_resp_set_hdr(req, "X-History-Start", startText);
+    httpd_resp_set_hdr(req, "X-History-Match", matchText);
+    httpd_resp_set_type(req, "application/octet-stream");
+
+    // The socket buffers get the render's larger strips while the body goes out
+    holdRenderMemory();
+    uint32_t start = offset;
+    while (offset < size) {
+        size_t copied;
+        HistoryError error;
+        if (!readHistoryImage(id, offset, chunk, min((uint32_t)sizeof(chunk), size - offset), copied, error) ||
+            copied == 0) {
+            // The body ends short - the client resumes from what it got
+            LOG_W("[WIFI] History read stopped at offset %lu\n", (unsigned long)offset);
+            releaseRenderMemory();
+            return ESP_FAIL;
+        }
+        if (httpd_resp_send_chunk(req, (const char*)chunk, copied) != ESP_OK) {
+            releaseRenderMemory();
+            return ESP_FAIL;
+        }
+        offset += copied;
+    }
+    releaseRenderMemory();
+    Console.printf("[WIFI] History sent: %lu bytes from %lu\n", (unsigned long)(offset - start), (unsigned long)start);
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+static bool sendSessionChunk(const uint8_t* data, size_t len, void* context) {
+    return httpd_resp_send_chunk((httpd_req_t*)context, (const char*)data, len) == ESP_OK;
+}
+
+static esp_err_t handleSession(httpd_req_t* req) {
+    setCorsHeaders(req);
+    char query[32] = "";
+    char sweep[12] = "";
+    if (httpd_req_get_url_query_len(req) + 1 <= sizeof(query)) {
+        httpd_req_get_url_query_str(req, query, sizeof(query));
+    }
+    bool final = finalMeasurementDone;
+    if (query[0] != '\0' && httpd_query_key_value(query, "sweep", sweep, sizeof(sweep)) == ESP_OK) {
+        final = strcmp(sweep, "final") == 0;
+    }
+    if (!hasPsSessionData(final)) {
+        return sendStatus(req, "404 Not Found", "No valid points stored");
+    }
+
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Content-Disposition", final ? "attachment; filename=\"biopal_final.pssession\""
+                                                         : "attachment; filename=\"biopal_baseline.pssession\"");
+    holdRenderMemory();
+    bool written = writePsSession(final, sendSessionChunk, req);
+    releaseRenderMemory();
+    if (!written) {
+        // Socket gone, or a new sweep cleared the rows - the body ends short
+        LOG_W("[WIFI] Session document cut short\n");
+        return ESP_FAIL;
+    }
+    Console.printf("[WIFI] Session document sent (%s)\n", final ? "final" : "baseline");
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+static esp_err_t handleLive(httpd_req_t* req) {
+    if (req->method == HTTP_GET) {
+        // Handshake done - the socket is a live client from now on
+        int fd = httpd_req_to_sockfd(req);
+        if (!addLiveSocket(fd)) {
+            LOG_W("[WIFI] All %d live slots taken\n", WIFI_WS_CLIENTS);
+            return ESP_FAIL;
+        }
+        Console.printf("[WIFI] Live client connected (%d)\n", getWiFiLiveClients());
+        return ESP_OK;
+    }
+    // Control stays on BLE - client frames are read and dropped
+    static uint8_t ignored[128];
+    httpd_ws_frame_t ws = {};
+    if (httpd_ws_recv_frame(req, &ws, 0) != ESP_OK || ws.len > sizeof(ignored)) {
+        return ESP_FAIL;
+    }
+    ws.payload = ignored;
+    return ws.len > 0 ? httpd_ws_recv_frame(req, &ws, ws.len) : ESP_OK;
+}
+
+/*=========================SERVER=========================*/
+static void startServer() {
+    if (server != nullptr) {
+        return;
+    }
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.send_wait_timeout = WIFI_SEND_TIMEOUT_S;
+    config.close_fn = onSocketClose;
+    config.lru_purge_enable = true;
+    if (httpd_start(&server, &config) != ESP_OK) {
+        Console.println("[WIFI] ERROR: HTTP server did not start");
+        server = nullptr;
+        return;
+    }
+
+    static const httpd_uri_t uris[] = {
+        {.uri = "/history/info", .method = HTTP_GET, .handler = handleHistoryInfo, .user_ctx = nullptr},
+        {.uri = "/history", .method = HTTP_GET, .handler = handleHistory, .user_ctx = nullptr},
+        {.uri = "/session.pssession", .method = HTTP_GET, .handler = handleSession, .user_ctx = nullptr},
+        {.uri = "/live", .method = HTTP_GET, .handler = handleLive, .user_ctx = nullptr, .is_websocket = true},
+    };
+    for (const httpd_uri_t& uri : uris) {
+        httpd_register_uri_handler(server, &uri);
+    }
+    if (MDNS.begin(WIFI_HOSTNAME)) {
+        MDNS.addService("http", "tcp", 80);
+    }
+}
+
+static void stopServer() {
+    if (server == nullptr) {
+        return;
+    }
+    MDNS.end();
+    httpd_stop(server);
+    server = nullptr;
+    portENTER_CRITICAL(&liveMux);
+    liveCount = 0;
+    portEXIT_CRITICAL(&liveMux);
+    updateLiveHandover();
+}
+
+/*=========================NETWORK=========================*/
+// Arduino event task
+static void onWiFiEvent(arduino_event_id_t event) {
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        connected = true;
+        ipAddress = (uint32_t)WiFi.localIP();
+        startServer();
+        char status[40];
+        getWiFiStatus(status, sizeof(status));
+        Console.printf("[WIFI] Connected to %s: http://%s/ (%s.local)\n", ssid, status, WIFI_HOSTNAME);
+        char message[48];
+        snprintf(message, sizeof(message), "WiFi:%s", status);
+        sendBLEStatus(message);
+    } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED && connected) {
+        // The server stays up - the station reconnects on its own
+        connected = false;
+        Console.println("[WIFI] Disconnected - reconnecting");
+    }
+}
+
+static void connectWiFi() {
+    Console.printf("[WIFI] Connecting to %s\n", ssid);
+    WiFi.setHostname(WIFI_HOSTNAME);
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(true);
+    WiFi.begin(ssid, pass[0] != '\0' ? pass : nullptr);
+}
+
+static void disconnectWiFi() {
+    stopServer();
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+    connected = false;
+}
+
+/*=========================CONTROL=========================*/
+void initWiFiServer() {
+    liveBuffer = xMessageBufferCreateStatic(WIFI_WS_BUFFER_BYTES, liveBufferStorage, &liveBufferControl);
+    liveMutex = xSemaphoreCreateMutexStatic(&liveMutexControl);
+    WiFi.onEvent(onWiFiEvent);
+    loadConfig();
+    if (enabled && ssid[0] != '\0') {
+        connectWiFi();
+    } else {
+        WiFi.mode(WIFI_OFF);
+    }
+}
+
+bool setWiFiNetwork(const char* newSsid, const char* newPass) {
+    size_t ssidLen = strlen(newSsid);
+    if (ssidLen == 0 || ssidLen > WIFI_SSID_MAX || strlen(newPass) > WIFI_PASS_MAX ||
+        strchr(newSsid, '\n') != nullptr || strchr(newPass, '\n') != nullptr) {
+        Console.printf("ERROR: SSID must be 1-%d characters, passphrase at most %d\n", WIFI_SSID_MAX, WIFI_PASS_MAX);
+        return false;
+    }
+    if (enabled) {
+        disconnectWiFi();
+    }
+    copyText(ssid, newSsid, sizeof(ssid));
+    copyText(pass, newPass, sizeof(pass));
+    enabled = true;
+    connectWiFi();
+    return saveConfig();
+}
+
+bool setWiFiEnabled(bool enable) {
+    if (enable && ssid[0] == '\0') {
+        Console.println("ERROR: No Wi-Fi network stored");
+        return false;
+    }
+    if (enable != enabled) {
+        enabled = enable;
+        if (enable) {
+            connectWiFi();
+        } else {
+            disconnectWiFi();
+        }
+    }
+    return saveConfig();
+}
+
+bool isWiFiEnabled() {
+    return enabled;
+}
+
+void getWiFiStatus(char* out, size_t size) {
+    if (!enabled) {
+        snprintf(out, size, "off");
+    } else if (!connected) {
+        snprintf(out, size, "connecting %s", ssid);
+    } else {
+        uint32_t ip = ipAddress;
+        snprintf(out, size, "%lu.%lu.%lu.%lu", (unsigned long)(ip & 0xFF), (unsigned long)((ip >> 8) & 0xFF),
+                 (unsigned long)((ip >> 16) & 0xFF), (unsigned long)(ip >> 24));
+    }
+}
+
+#endif // WIFI_SERVER
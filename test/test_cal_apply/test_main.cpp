@@ -0,0 +1,198 @@
+#include <unity.h>
+#include "cal_apply.h"
+#include "cal_model.h"
+#include "impedance_math.h"
+#include "sweep_table.h"
+
+// Fused table: every (TIA, PGA) entry valid, gain and phase rising with the index
+static CalLUTRow table[SWEEP_FREQ_COUNT];
+
+static float entryGain(int idx, int pga) {
+    return 1.0f + 0.05f * idx + 0.1f * pga;
+}
+
+static float entryPhase(int idx, int tia) {
+    return tia ? -2.0f - 0.25f * idx : 3.0f + 0.5f * idx;
+}
+
+static ImpedancePoint point(uint32_t freq, uint8_t freqIdx, bool tia, uint8_t pga, float mag, float phase) {
+    MeasurementPoint m = {};
+    m.freq_hz = freq;
+    m.V_magnitude = mag * 1.0e-3f;
+    m.I_magnitude = 1.0e-3f;
+    m.phase_deg = phase;
+    m.pga_gain = pga;
+    m.tia_gain = tia;
+    m.valid = true;
+    m.freq_idx = freqIdx;
+    return calcImpedance(m);
+}
+
+static void toPolar(ImpedancePoint& z) {
+#if IMPEDANCE_RECTANGULAR
+    impedanceToPolar(z);
+#endif
+}
+
+void setUp(void) {
+    for (int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        for (int tia = 0; tia < 2; tia++) {
+            for (int pga = 0; pga < 8; pga++) {
+                table[f][tia][pga] = {entryGain(f, pga), entryPhase(f, tia), true, {0, 0, 0}};
+            }
+        }
+    }
+    setCalibrationApplyTable(table);
+}
+
+void tearDown(void) {
+    setCalibrationApplyTable(emptyCalibrationLUT);
+}
+
+/*=========================SEPARATE FILES (FUSED LUT)=========================*/
+
+void test_sweep_frequency_takes_its_entry(void) {
+    int idx = 15;
+    ImpedancePoint z = point(sweepFrequencies[idx], idx, true, 3, 1000.0f, -20.0f);
+    TEST_ASSERT_TRUE(calibrateWithSeparateFiles(z));
+    toPolar(z);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1000.0f * entryGain(idx, 3), z.Z_magnitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -20.0f + entryPhase(idx, 1), z.Z_phase);
+}
+
+void test_unknown_index_is_looked_up_by_frequency(void) {
+    int idx = 20;
+    ImpedancePoint z = point(sweepFrequencies[idx], SWEEP_FREQ_INVALID, false, 0, 500.0f, 0.0f);
+    TEST_ASSERT_TRUE(calibrateWithSeparateFiles(z));
+    toPolar(z);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 500.0f * entryGain(idx, 0), z.Z_magnitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, entryPhase(idx, 0), z.Z_phase);
+}
+
+void test_off_grid_interpolates_in_log_frequency(void) {
+    // Between 1250 Hz (index 14) and 1000 Hz (index 15)
+    int s = 14;
+    uint32_t freq = 1100;
+    ImpedancePoint z = point(freq, SWEEP_FREQ_INVALID, false, 2, 100.0f, 0.0f);
+    TEST_ASSERT_TRUE(calibrateWithSeparateFiles(z));
+    toPolar(z);
+
+    float t = (logf((float)freq) - getSweepFreqInfo(s).lnHz) /
+              (getSweepFreqInfo(s + 1).lnHz - getSweepFreqInfo(s).lnHz);
+    float gain = entryGain(s, 2) + t * (entryGain(s + 1, 2) - entryGain(s, 2));
+    float phase = entryPhase(s, 0) + t * (entryPhase(s + 1, 0) - entryPhase(s, 0));
+#if CAL_MODEL_PRIOR
+    float w = 4.0f * t * (1.0f - t);
+    gain *= 1.0f + w * calModel.bow[s][0][2].gain;
+    phase += w * calModel.bow[s][0][2].phase;
+#endif
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f * gain, z.Z_magnitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, phase, z.Z_phase);
+}
+
+void test_no_extrapolation_outside_the_table(void) {
+    ImpedancePoint z = point(200000, SWEEP_FREQ_INVALID, false, 0, 100.0f, 0.0f);
+    TEST_ASSERT_FALSE(calibrateWithSeparateFiles(z));
+}
+
+void test_invalid_entry_leaves_the_point(void) {
+    int idx = 7;
+    table[idx][1][4].valid = false;
+    setCalibrationApplyTable(table);
+    ImpedancePoint z = point(sweepFrequencies[idx], idx, true, 4, 250.0f, 12.0f);
+    TEST_ASSERT_FALSE(calibrateWithSeparateFiles(z));
+    toPolar(z);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 250.0f, z.Z_magnitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.0f, z.Z_phase);
+}
+
+void test_bad_pga_is_rejected(void) {
+    ImpedancePoint z = point(sweepFrequencies[3], 3, false, 8, 100.0f, 0.0f);
+    TEST_ASSERT_FALSE(calibrateWithSeparateFiles(z));
+}
+
+void test_phase_wraps_to_half_circle(void) {
+    int idx = 10;
+    table[idx][0][1].phase_offset = 20.0f;
+    setCalibrationApplyTable(table);
+    ImpedancePoint z = point(sweepFrequencies[idx], idx, false, 1, 100.0f, 170.0f);
+    TEST_ASSERT_TRUE(calibrateWithSeparateFiles(z));
+    toPolar(z);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -170.0f, z.Z_phase);
+}
+
+void test_empty_table_calibrates_nothing(void) {
+    setCalibrationApplyTable(emptyCalibrationLUT);
+    ImpedancePoint z = point(sweepFrequencies[0], 0, false, 0, 100.0f, 0.0f);
+    TEST_ASSERT_FALSE(calibrateWithSeparateFiles(z));
+}
+
+/*=========================FACTOR AND OTHER MODES=========================*/
+
+void test_calibration_factor(void) {
+    ImpedancePoint z = point(1000, 15, false, 0, 200.0f, -45.0f);
+    applyCalibrationFactor(z, 0.5f, 15.0f);
+    toPolar(z);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 100.0f, z.Z_magnitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -30.0f, z.Z_phase);
+}
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
+void test_formula_mode(void) {
+    CalibrationCoefficients& c = calibrationCoefficients[0][2];
+    c.m0 = 2.0f;
+    c.m1 = 1.0e-3f;
+    c.m2 = 0.0f;
+    c.a1 = 1.0e-2f;
+    c.a2 = 0.0f;
+    c.valid = true;
+    ImpedancePoint z = point(1000, 15, false, 2, 300.0f, 0.0f);
+    TEST_ASSERT_TRUE(calibrateWithFormula(z));
+    toPolar(z);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, z.Z_magnitude);     // 300 / (2 + 1)
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -10.0f, z.Z_phase);
+
+    c.valid = false;
+    TEST_ASSERT_FALSE(calibrateWithFormula(z));
+}
+#endif
+
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+void test_lookup_mode(void) {
+    numCalibrationFreqs = 1;
+    calibrationData[0].frequency_hz = 1000;
+    for (int pga = 0; pga < 8; pga++) {
+        calibrationData[0].low_TIA_gains[pga].setCalibrationPoint(4.0f, 30.0f);
+        calibrationData[0].high_TIA_gains[pga].setCalibrationPoint(4.0f, 30.0f);
+    }
+    ImpedancePoint z = point(1000, 15, false, 6, 25.0f, 0.0f);
+    TEST_ASSERT_TRUE(calibrateWithLookup(z));
+    toPolar(z);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 100.0f, z.Z_magnitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -30.0f, z.Z_phase);
+
+    ImpedancePoint other = point(2000, 13, false, 6, 25.0f, 0.0f);
+    TEST_ASSERT_FALSE(calibrateWithLookup(other));
+    numCalibrationFreqs = 0;
+}
+#endif
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_sweep_frequency_takes_its_entry);
+    RUN_TEST(test_unknown_index_is_looked_up_by_frequency);
+    RUN_TEST(test_off_grid_interpolates_in_log_frequency);
+    RUN_TEST(test_no_extrapolation_outside_the_table);
+    RUN_TEST(test_invalid_entry_leaves_the_point);
+    RUN_TEST(test_bad_pga_is_rejected);
+    RUN_TEST(test_phase_wraps_to_half_circle);
+    RUN_TEST(test_empty_table_calibrates_nothing);
+    RUN_TEST(test_calibration_factor);
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_FORMULA)
+    RUN_TEST(test_formula_mode);
+#endif
+#if CAL_PIPELINE_HAS(CAL_PIPELINE_LOOKUP)
+    RUN_TEST(test_lookup_mode);
+#endif
+    return UNITY_END();
+}
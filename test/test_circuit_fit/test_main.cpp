@@ -0,0 +1,111 @@
+#include <unity.h>
+#include "circuit_fit.h"
+#include "sweep_table.h"
+
+// Synthetic spectrum of a Randles cell over the sweep table
+static uint32_t freqHz[SWEEP_FREQ_COUNT];
+static float mag[SWEEP_FREQ_COUNT];
+static float phaseDeg[SWEEP_FREQ_COUNT];
+
+static const CircuitParams cell = {150.0f, 12000.0f, 2.0e-6f, 0.85f};
+
+static void makeSpectrum(const CircuitParams& params) {
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        float re;
+        float im;
+        freqHz[i] = sweepFrequencies[i];
+        circuitImpedance(params, freqHz[i], re, im);
+        mag[i] = sqrtf(re * re + im * im);
+        phaseDeg[i] = atan2f(im, re) * (float)(180.0 / M_PI);
+    }
+}
+
+void setUp(void) {
+    makeSpectrum(cell);
+}
+
+void tearDown(void) {}
+
+/*=========================MODEL=========================*/
+
+void test_model_limits(void) {
+    float re;
+    float im;
+    // Highest frequency: towards Rs; lowest: towards Rs + Rct
+    circuitImpedance(cell, 1000000, re, im);
+    TEST_ASSERT_FLOAT_WITHIN(cell.rs * 0.2f, cell.rs, re);
+    circuitImpedance({cell.rs, cell.rct, cell.q, 1.0f}, 0, re, im);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, cell.rs + cell.rct, re);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, im);
+}
+
+/*=========================FIT=========================*/
+
+void test_recovers_randles_cell(void) {
+    CircuitFit out;
+    TEST_ASSERT_TRUE(fitCircuit(freqHz, mag, phaseDeg, SWEEP_FREQ_COUNT, nullptr, out));
+    TEST_ASSERT_TRUE(out.valid);
+    TEST_ASSERT_TRUE(out.converged);
+    TEST_ASSERT_EQUAL(SWEEP_FREQ_COUNT, out.points);
+    TEST_ASSERT_TRUE(out.iterations <= CIRCUIT_FIT_MAX_ITER);
+    TEST_ASSERT_LESS_THAN_FLOAT(1e-4f, out.rmsError);
+    TEST_ASSERT_FLOAT_WITHIN(cell.rs * 0.01f, cell.rs, out.params.rs);
+    TEST_ASSERT_FLOAT_WITHIN(cell.rct * 0.01f, cell.rct, out.params.rct);
+    TEST_ASSERT_FLOAT_WITHIN(cell.q * 0.02f, cell.q, out.params.q);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, cell.n, out.params.n);
+}
+
+void test_start_from_previous_fit(void) {
+    CircuitFit baseline;
+    TEST_ASSERT_TRUE(fitCircuit(freqHz, mag, phaseDeg, SWEEP_FREQ_COUNT, nullptr, baseline));
+
+    // The final sweep: Rct dropped by 20 %
+    CircuitParams changed = cell;
+    changed.rct *= 0.8f;
+    makeSpectrum(changed);
+    CircuitFit out;
+    TEST_ASSERT_TRUE(fitCircuit(freqHz, mag, phaseDeg, SWEEP_FREQ_COUNT, &baseline, out));
+    TEST_ASSERT_TRUE(out.converged);
+    TEST_ASSERT_FLOAT_WITHIN(changed.rct * 0.01f, changed.rct, out.params.rct);
+}
+
+void test_skips_invalid_points(void) {
+    freqHz[3] = 0;
+    mag[10] = 0.0f;
+    mag[11] = -5.0f;
+    CircuitFit out;
+    TEST_ASSERT_TRUE(fitCircuit(freqHz, mag, phaseDeg, SWEEP_FREQ_COUNT, nullptr, out));
+    TEST_ASSERT_EQUAL(SWEEP_FREQ_COUNT - 3, out.points);
+    TEST_ASSERT_FLOAT_WITHIN(cell.rct * 0.01f, cell.rct, out.params.rct);
+}
+
+void test_too_few_points(void) {
+    CircuitFit out;
+    TEST_ASSERT_FALSE(fitCircuit(freqHz, mag, phaseDeg, CIRCUIT_FIT_MIN_POINTS - 1, nullptr, out));
+    TEST_ASSERT_FALSE(out.valid);
+}
+
+void test_cpe_exponent_stays_in_range(void) {
+    // A pure resistor has no CPE to find
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        mag[i] = 1000.0f;
+        phaseDeg[i] = 0.0f;
+    }
+    CircuitFit out;
+    fitCircuit(freqHz, mag, phaseDeg, SWEEP_FREQ_COUNT, nullptr, out);
+    TEST_ASSERT_TRUE(out.iterations <= CIRCUIT_FIT_MAX_ITER);
+    if (out.valid) {
+        TEST_ASSERT_TRUE(out.params.n >= CIRCUIT_FIT_N_MIN && out.params.n <= CIRCUIT_FIT_N_MAX);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_model_limits);
+    RUN_TEST(test_recovers_randles_cell);
+    RUN_TEST(test_start_from_previous_fit);
+    RUN_TEST(test_skips_invalid_points);
+    RUN_TEST(test_too_few_points);
+    RUN_TEST(test_cpe_exponent_stays_in_range);
+    return UNITY_END();
+}
@@ -0,0 +1,147 @@
+#include <unity.h>
+#include "fixed_cal.h"
+#include "cal_apply.h"
+#include "cal_model.h"
+#include "impedance_math.h"
+#include "sweep_table.h"
+
+// Fixed kernel against the float path over the sweep table (the firmware's
+// "cal selftest" grid): worst relative |Z| error and phase error
+#define FIXED_MAX_MAG_ERROR     50e-6f      // 50 ppm
+#define FIXED_MAX_PHASE_ERROR   1e-4f       // Degrees
+
+static float phaseError(float d) {
+    while (d > 180.0f) d -= 360.0f;
+    while (d < -180.0f) d += 360.0f;
+    return fabsf(d);
+}
+
+static MeasurementPoint measurement(int idx, bool tia, uint8_t pga, float v, float i, float phase) {
+    MeasurementPoint m = {};
+    m.freq_hz = sweepFrequencies[idx];
+    m.V_magnitude = v;
+    m.I_magnitude = i;
+    m.phase_deg = phase;
+    m.pga_gain = pga;
+    m.tia_gain = tia;
+    m.valid = true;
+    m.freq_idx = idx;
+    return m;
+}
+
+// The data processor's float path for m
+static bool floatPath(const MeasurementPoint& m, ImpedancePoint& out) {
+    out = calcImpedance(m);
+    bool success = out.valid && calibrateWithSeparateFiles(out);
+#if IMPEDANCE_RECTANGULAR
+    impedanceToPolar(out);
+#endif
+    return success;
+}
+
+void setUp(void) {
+    // The model table is a realistic spread of gains and phase offsets
+    setCalibrationApplyTable(getCalModelLUT());
+    buildFixedCalibrationLUT(getCalModelLUT());
+}
+
+void tearDown(void) {}
+
+/*=========================CONVERSIONS=========================*/
+
+void test_log2_and_exp2(void) {
+    const float values[] = {1.0e-9f, 3.0e-4f, 0.5f, 1.0f, 2.0f, 7.77f, 1.0e6f};
+    for (float x : values) {
+        TEST_ASSERT_FLOAT_WITHIN(2.0f / FX_LOG2_ONE, log2f(x), (float)fxLog2(x) / FX_LOG2_ONE);
+        TEST_ASSERT_FLOAT_WITHIN(x * 50e-6f, x, fxExp2(fxLog2(x)));
+    }
+    TEST_ASSERT_EQUAL(FX_LOG2_ONE, fxLog2(2.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, fxExp2(0));
+}
+
+void test_log2_rejects_non_positive(void) {
+    TEST_ASSERT_EQUAL(INT32_MIN, fxLog2(0.0f));
+    TEST_ASSERT_EQUAL(INT32_MIN, fxLog2(-1.0f));
+    TEST_ASSERT_EQUAL(INT32_MIN, fxLog2(INFINITY));
+}
+
+void test_angles_wrap(void) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 90.0f, fxAngleToDeg(fxDegToAngle(90.0f)));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -90.0f, fxAngleToDeg(fxDegToAngle(270.0f)));
+    // 170 + 20 wraps by overflow
+    fx_angle_t sum = (fx_angle_t)((uint32_t)fxDegToAngle(170.0f) + (uint32_t)fxDegToAngle(20.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -170.0f, fxAngleToDeg(sum));
+}
+
+/*=========================KERNEL=========================*/
+
+void test_fixed_matches_float_path(void) {
+    static const float testV[] = {0.005f, 0.35f, 2.9f};
+    static const float testI[] = {2.0e-9f, 4.0e-6f, 1.5e-3f};
+    static const float testPhase[] = {-179.5f, -45.0f, 0.0f, 89.9f};
+
+    int points = 0;
+    float maxMagErr = 0.0f;
+    float maxPhaseErr = 0.0f;
+    for (int f = 0; f < SWEEP_FREQ_COUNT; f++) {
+        for (int tia = 0; tia < 2; tia++) {
+            for (int pga = 0; pga < 8; pga++) {
+                for (float v : testV) {
+                    for (float i : testI) {
+                        for (float ph : testPhase) {
+                            MeasurementPoint m = measurement(f, tia, pga, v, i, ph);
+                            ImpedancePoint ref;
+                            ImpedancePoint fx;
+                            bool refOk = floatPath(m, ref);
+                            TEST_ASSERT_EQUAL(refOk, calcFixedCalibratedPoint(m, fx));
+                            if (!refOk) {
+                                continue;
+                            }
+                            maxMagErr = max(maxMagErr, fabsf(fx.Z_magnitude - ref.Z_magnitude) / ref.Z_magnitude);
+                            maxPhaseErr = max(maxPhaseErr, phaseError(fx.Z_phase - ref.Z_phase));
+                            points++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(points > 0);
+    TEST_ASSERT_LESS_THAN_FLOAT(FIXED_MAX_MAG_ERROR, maxMagErr);
+    TEST_ASSERT_LESS_THAN_FLOAT(FIXED_MAX_PHASE_ERROR, maxPhaseErr);
+}
+
+void test_missing_entry_keeps_uncalibrated_value(void) {
+    static CalLUTRow table[SWEEP_FREQ_COUNT];
+    memcpy(table, getCalModelLUT(), sizeof(table));
+    table[4][0][2].valid = false;
+    buildFixedCalibrationLUT(table);
+
+    ImpedancePoint fx;
+    TEST_ASSERT_FALSE(calcFixedCalibratedPoint(measurement(4, false, 2, 1.0f, 1.0e-3f, 30.0f), fx));
+    TEST_ASSERT_TRUE(fx.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 1000.0f, fx.Z_magnitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 30.0f, fx.Z_phase);
+}
+
+void test_invalid_measurement_is_rejected(void) {
+    ImpedancePoint fx;
+    TEST_ASSERT_FALSE(calcFixedCalibratedPoint(measurement(0, false, 0, 1.0f, 0.0f, 0.0f), fx));
+    TEST_ASSERT_FALSE(fx.valid);
+
+    MeasurementPoint m = measurement(0, false, 0, 1.0f, 1.0e-3f, 0.0f);
+    m.valid = false;
+    TEST_ASSERT_FALSE(calcFixedCalibratedPoint(m, fx));
+    TEST_ASSERT_FALSE(fx.valid);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_log2_and_exp2);
+    RUN_TEST(test_log2_rejects_non_positive);
+    RUN_TEST(test_angles_wrap);
+    RUN_TEST(test_fixed_matches_float_path);
+    RUN_TEST(test_missing_entry_keeps_uncalibrated_value);
+    RUN_TEST(test_invalid_measurement_is_rejected);
+    return UNITY_END();
+}
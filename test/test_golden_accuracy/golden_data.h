@@ -0,0 +1,222 @@
+// Golden-accuracy fixture - generated by golden_accuracy.py, do not edit
+// Calibration: data/ (cal_compile.py)
+// Case: STM_output.csv vs PBS 1x DUT 1_2.pssession
+#ifndef GOLDEN_DATA_H
+#define GOLDEN_DATA_H
+
+#include "cal_apply.h"
+
+// A recorded point as the UART handler decodes it, and the PalmSens |Z| and phase
+struct GoldenPoint {
+    const char* reference;
+    uint8_t dut;
+    uint32_t freq_hz;
+    float v_mag;
+    float phase_deg;        // V - I
+    float i_mag;
+    uint8_t pga;
+    bool tia;               // High TIA
+    bool valid;
+    float ref_z;
+    float ref_phase;
+};
+
+static const CalLUTRow goldenCalibration[SWEEP_FREQ_COUNT] = {
+    {   // 100000 Hz
+        {{486.524384f, -358.144318f, true, {0, 0, 0}}, {972.545532f, -358.611755f, true, {0, 0, 0}}, {2420.63599f, -359.225098f, true, {0, 0, 0}}, {4847.03076f, -359.716858f, true, {0, 0, 0}}, {11380.9824f, -362.474823f, true, {0, 0, 0}}, {28168.4492f, -364.379791f, true, {0, 0, 0}}, {49100.1562f, -371.424469f, true, {0, 0, 0}}, {92474.2891f, -381.468903f, true, {0, 0, 0}}},
+        {{2.47174883f, -357.899963f, true, {0, 0, 0}}, {4.94094086f, -358.367401f, true, {0, 0, 0}}, {12.2978506f, -358.980713f, true, {0, 0, 0}}, {24.624958f, -359.472473f, true, {0, 0, 0}}, {57.8201866f, -362.230469f, true, {0, 0, 0}}, {143.10759f, -364.135406f, true, {0, 0, 0}}, {249.449478f, -371.180115f, true, {0, 0, 0}}, {469.80835f, -381.224548f, true, {0, 0, 0}}},
+    },
+    {   // 80000 Hz
+        {{436.353821f, -359.807404f, true, {0, 0, 0}}, {871.180115f, -360.041382f, true, {0, 0, 0}}, {2170.99756f, -360.74292f, true, {0, 0, 0}}, {4345.95947f, -361.151978f, true, {0, 0, 0}}, {10220.0703f, -363.454987f, true, {0, 0, 0}}, {25348.709f, -365.083527f, true, {0, 0, 0}}, {44325.9805f, -371.391571f, true, {0, 0, 0}}, {84795.3672f, -380.155151f, true, {0, 0, 0}}},
+        {{2.21579838f, -359.54715f, true, {0, 0, 0}}, {4.42384005f, -359.781128f, true, {0, 0, 0}}, {11.0242939f, -360.482635f, true, {0, 0, 0}}, {22.068718f, -360.891724f, true, {0, 0, 0}}, {51.8973694f, -363.194733f, true, {0, 0, 0}}, {128.720367f, -364.823242f, true, {0, 0, 0}}, {225.086685f, -371.131317f, true, {0, 0, 0}}, {430.589661f, -379.894897f, true, {0, 0, 0}}},
+    },
+    {   // 62500 Hz
+        {{446.419922f, -361.590851f, true, {0, 0, 0}}, {890.326233f, -361.619049f, true, {0, 0, 0}}, {2220.91724f, -362.386597f, true, {0, 0, 0}}, {4444.28711f, -362.72171f, true, {0, 0, 0}}, {10463.5527f, -364.522583f, true, {0, 0, 0}}, {26005.9492f, -365.864563f, true, {0, 0, 0}}, {45638.8828f, -371.441467f, true, {0, 0, 0}}, {88555.4062f, -378.907166f, true, {0, 0, 0}}},
+        {{2.26611161f, -361.318817f, true, {0, 0, 0}}, {4.51946354f, -361.347015f, true, {0, 0, 0}}, {11.2737942f, -362.114563f, true, {0, 0, 0}}, {22.5600376f, -362.449677f, true, {0, 0, 0}}, {53.1149597f, -364.250549f, true, {0, 0, 0}}, {132.011093f, -365.592529f, true, {0, 0, 0}}, {231.67157f, -371.169434f, true, {0, 0, 0}}, {449.523926f, -378.635132f, true, {0, 0, 0}}},
+    },
+    {   // 50000 Hz
+        {{456.417175f, -362.847778f, true, {0, 0, 0}}, {909.607422f, -362.734406f, true, {0, 0, 0}}, {2270.38306f, -363.535583f, true, {0, 0, 0}}, {4541.69873f, -363.817963f, true, {0, 0, 0}}, {10699.1543f, -365.165405f, true, {0, 0, 0}}, {26632.6426f, -366.266144f, true, {0, 0, 0}}, {46900.2305f, -371.256226f, true, {0, 0, 0}}, {91946.125f, -377.652161f, true, {0, 0, 0}}},
+        {{2.31642485f, -362.569794f, true, {0, 0, 0}}, {4.61647224f, -362.456451f, true, {0, 0, 0}}, {11.5227299f, -363.257599f, true, {0, 0, 0}}, {23.0501919f, -363.539978f, true, {0, 0, 0}}, {54.3007317f, -364.887421f, true, {0, 0, 0}}, {135.166946f, -365.98819f, true, {0, 0, 0}}, {238.029739f, -370.978241f, true, {0, 0, 0}}, {466.648285f, -377.374176f, true, {0, 0, 0}}},
+    },
+    {   // 25000 Hz
+        {{472.436768f, -363.394562f, true, {0, 0, 0}}, {940.885742f, -363.099182f, true, {0, 0, 0}}, {2348.49658f, -363.852875f, true, {0, 0, 0}}, {4693.39355f, -364.040741f, true, {0, 0, 0}}, {11044.1377f, -363.985779f, true, {0, 0, 0}}, {27577.7969f, -364.464355f, true, {0, 0, 0}}, {49159.8203f, -368.059753f, true, {0, 0, 0}}, {98124.5156f, -371.723572f, true, {0, 0, 0}}},
+        {{2.39819717f, -363.122009f, true, {0, 0, 0}}, {4.77615118f, -362.82663f, true, {0, 0, 0}}, {11.9215059f, -363.580322f, true, {0, 0, 0}}, {23.8247395f, -363.768188f, true, {0, 0, 0}}, {56.0625725f, -363.713226f, true, {0, 0, 0}}, {139.991211f, -364.191803f, true, {0, 0, 0}}, {249.546494f, -367.787201f, true, {0, 0, 0}}, {498.102478f, -371.450989f, true, {0, 0, 0}}},
+    },
+    {   // 15625 Hz
+        {{478.640259f, -362.593536f, true, {0, 0, 0}}, {954.529663f, -362.410309f, true, {0, 0, 0}}, {2378.90161f, -362.995453f, true, {0, 0, 0}}, {4754.15576f, -363.166931f, true, {0, 0, 0}}, {11151.0186f, -362.175049f, true, {0, 0, 0}}, {27854.3613f, -362.367004f, true, {0, 0, 0}}, {50214.5742f, -365.368652f, true, {0, 0, 0}}, {100253.727f, -367.691406f, true, {0, 0, 0}}},
+        {{2.43104219f, -362.342194f, true, {0, 0, 0}}, {4.84811258f, -362.158936f, true, {0, 0, 0}}, {12.0825815f, -362.74408f, true, {0, 0, 0}}, {24.1466389f, -362.915558f, true, {0, 0, 0}}, {56.6366844f, -361.923706f, true, {0, 0, 0}}, {141.473953f, -362.115631f, true, {0, 0, 0}}, {255.042786f, -365.11731f, true, {0, 0, 0}}, {509.19458f, -367.440063f, true, {0, 0, 0}}},
+    },
+    {   // 12500 Hz
+        {{486.688477f, -362.604889f, true, {0, 0, 0}}, {971.591064f, -362.552612f, true, {0, 0, 0}}, {2419.30884f, -363.016815f, true, {0, 0, 0}}, {4836.92627f, -363.197052f, true, {0, 0, 0}}, {11321.125f, -361.76532f, true, {0, 0, 0}}, {28240.6211f, -361.851562f, true, {0, 0, 0}}, {51301.4766f, -364.682617f, true, {0, 0, 0}}, {102243.773f, -366.531433f, true, {0, 0, 0}}},
+        {{2.47203445f, -362.368286f, true, {0, 0, 0}}, {4.93499804f, -362.315979f, true, {0, 0, 0}}, {12.2883835f, -362.780182f, true, {0, 0, 0}}, {24.5681782f, -362.960449f, true, {0, 0, 0}}, {57.5033379f, -361.528717f, true, {0, 0, 0}}, {143.442459f, -361.61496f, true, {0, 0, 0}}, {260.575348f, -364.445984f, true, {0, 0, 0}}, {519.326294f, -366.2948f, true, {0, 0, 0}}},
+    },
+    {   // 10000 Hz
+        {{491.402069f, -362.563385f, true, {0, 0, 0}}, {982.442932f, -362.667938f, true, {0, 0, 0}}, {2443.93311f, -363.014191f, true, {0, 0, 0}}, {4888.44482f, -363.22052f, true, {0, 0, 0}}, {11406.9385f, -361.332947f, true, {0, 0, 0}}, {28403.0586f, -361.295807f, true, {0, 0, 0}}, {52087.543f, -364.051331f, true, {0, 0, 0}}, {103481.891f, -365.529175f, true, {0, 0, 0}}},
+        {{2.49599075f, -362.344788f, true, {0, 0, 0}}, {4.99014664f, -362.449371f, true, {0, 0, 0}}, {12.4135294f, -362.795593f, true, {0, 0, 0}}, {24.8299999f, -363.001953f, true, {0, 0, 0}}, {57.9395485f, -361.11438f, true, {0, 0, 0}}, {144.268356f, -361.07724f, true, {0, 0, 0}}, {264.56955f, -363.832764f, true, {0, 0, 0}}, {525.618164f, -365.310577f, true, {0, 0, 0}}},
+    },
+    {   // 6250 Hz
+        {{503.112732f, -362.756409f, true, {0, 0, 0}}, {1008.44525f, -363.267639f, true, {0, 0, 0}}, {2502.42627f, -363.382538f, true, {0, 0, 0}}, {5012.10596f, -363.582062f, true, {0, 0, 0}}, {11519.8398f, -360.486603f, true, {0, 0, 0}}, {28623.373f, -360.380371f, true, {0, 0, 0}}, {53714.5156f, -363.112f, true, {0, 0, 0}}, {105792.156f, -363.831238f, true, {0, 0, 0}}},
+        {{2.55588293f, -362.588989f, true, {0, 0, 0}}, {5.12304306f, -363.10022f, true, {0, 0, 0}}, {12.712676f, -363.215118f, true, {0, 0, 0}}, {25.4621983f, -363.414642f, true, {0, 0, 0}}, {58.5223999f, -360.319183f, true, {0, 0, 0}}, {145.410736f, -360.212952f, true, {0, 0, 0}}, {272.877258f, -362.94458f, true, {0, 0, 0}}, {537.438904f, -363.663818f, true, {0, 0, 0}}},
+    },
+    {   // 5000 Hz
+        {{504.445557f, -362.35437f, true, {0, 0, 0}}, {1012.26141f, -362.991547f, true, {0, 0, 0}}, {2508.24243f, -363.062714f, true, {0, 0, 0}}, {5027.41553f, -363.134247f, true, {0, 0, 0}}, {11438.1182f, -359.543945f, true, {0, 0, 0}}, {28405.8828f, -359.530487f, true, {0, 0, 0}}, {53879.3125f, -362.243195f, true, {0, 0, 0}}, {105608.656f, -362.672272f, true, {0, 0, 0}}},
+        {{2.56285405f, -362.218872f, true, {0, 0, 0}}, {5.14283085f, -362.856049f, true, {0, 0, 0}}, {12.7432165f, -362.927216f, true, {0, 0, 0}}, {25.5419674f, -362.998749f, true, {0, 0, 0}}, {58.1117744f, -359.408447f, true, {0, 0, 0}}, {144.317123f, -359.394989f, true, {0, 0, 0}}, {273.735809f, -362.107697f, true, {0, 0, 0}}, {536.548645f, -362.536743f, true, {0, 0, 0}}},
+    },
+    {   // 4000 Hz
+        {{501.029175f, -362.685303f, true, {0, 0, 0}}, {1003.35431f, -363.390778f, true, {0, 0, 0}}, {2484.69531f, -363.459778f, true, {0, 0, 0}}, {4978.64648f, -363.35498f, true, {0, 0, 0}}, {11185.5f, -359.387177f, true, {0, 0, 0}}, {27739.1992f, -359.481567f, true, {0, 0, 0}}, {53112.8125f, -362.18103f, true, {0, 0, 0}}, {103848.344f, -362.417572f, true, {0, 0, 0}}},
+        {{2.54503822f, -362.587708f, true, {0, 0, 0}}, {5.09665966f, -363.293182f, true, {0, 0, 0}}, {12.6213112f, -363.362183f, true, {0, 0, 0}}, {25.2896385f, -363.257385f, true, {0, 0, 0}}, {56.8181038f, -359.289581f, true, {0, 0, 0}}, {140.904617f, -359.383972f, true, {0, 0, 0}}, {269.792969f, -362.083435f, true, {0, 0, 0}}, {527.510193f, -362.319977f, true, {0, 0, 0}}},
+    },
+    {   // 3125 Hz
+        {{493.426178f, -363.177032f, true, {0, 0, 0}}, {985.959106f, -363.982941f, true, {0, 0, 0}}, {2439.16675f, -364.022217f, true, {0, 0, 0}}, {4885.35791f, -363.728455f, true, {0, 0, 0}}, {10806.3926f, -359.465576f, true, {0, 0, 0}}, {26745.7871f, -359.681335f, true, {0, 0, 0}}, {51754.582f, -362.361908f, true, {0, 0, 0}}, {101034.125f, -362.417389f, true, {0, 0, 0}}},
+        {{2.50614309f, -363.129395f, true, {0, 0, 0}}, {5.00774908f, -363.935333f, true, {0, 0, 0}}, {12.3886833f, -363.974579f, true, {0, 0, 0}}, {24.8130455f, -363.680817f, true, {0, 0, 0}}, {54.8863564f, -359.417938f, true, {0, 0, 0}}, {135.843552f, -359.633698f, true, {0, 0, 0}}, {262.864838f, -362.31427f, true, {0, 0, 0}}, {513.158752f, -362.369751f, true, {0, 0, 0}}},
+    },
+    {   // 2500 Hz
+        {{487.605804f, -363.113892f, true, {0, 0, 0}}, {972.983032f, -363.937439f, true, {0, 0, 0}}, {2404.62573f, -363.946533f, true, {0, 0, 0}}, {4816.01904f, -363.521362f, true, {0, 0, 0}}, {10485.8018f, -359.147797f, true, {0, 0, 0}}, {25903.7852f, -359.398346f, true, {0, 0, 0}}, {50635.875f, -362.08316f, true, {0, 0, 0}}, {98708.5156f, -362.141235f, true, {0, 0, 0}}},
+        {{2.47662878f, -363.120117f, true, {0, 0, 0}}, {4.9419384f, -363.943665f, true, {0, 0, 0}}, {12.2134838f, -363.952759f, true, {0, 0, 0}}, {24.4613419f, -363.527618f, true, {0, 0, 0}}, {53.2590828f, -359.154022f, true, {0, 0, 0}}, {131.569519f, -359.404572f, true, {0, 0, 0}}, {257.187805f, -362.089386f, true, {0, 0, 0}}, {501.356537f, -362.147461f, true, {0, 0, 0}}},
+    },
+    {   // 2000 Hz
+        {{445.532288f, -367.836639f, true, {0, 0, 0}}, {889.788696f, -368.714539f, true, {0, 0, 0}}, {2197.66162f, -368.706329f, true, {0, 0, 0}}, {4402.42725f, -368.113861f, true, {0, 0, 0}}, {9435.50391f, -363.632935f, true, {0, 0, 0}}, {23263.1875f, -363.967804f, true, {0, 0, 0}}, {45888.8789f, -366.650543f, true, {0, 0, 0}}, {89376.3828f, -366.779572f, true, {0, 0, 0}}},
+        {{2.26318502f, -367.905853f, true, {0, 0, 0}}, {4.51988888f, -368.783752f, true, {0, 0, 0}}, {11.1635332f, -368.775543f, true, {0, 0, 0}}, {22.3631554f, -368.183075f, true, {0, 0, 0}}, {47.9298401f, -363.702148f, true, {0, 0, 0}}, {118.170776f, -364.037018f, true, {0, 0, 0}}, {233.103241f, -366.719727f, true, {0, 0, 0}}, {454.008118f, -366.848785f, true, {0, 0, 0}}},
+    },
+    {   // 1250 Hz
+        {{436.08606f, -368.168976f, true, {0, 0, 0}}, {873.157227f, -368.882324f, true, {0, 0, 0}}, {2159.58691f, -368.899506f, true, {0, 0, 0}}, {4317.61426f, -368.350128f, true, {0, 0, 0}}, {8998.65527f, -364.3237f, true, {0, 0, 0}}, {22085.2793f, -364.585419f, true, {0, 0, 0}}, {44167.0859f, -367.093018f, true, {0, 0, 0}}, {86371.0938f, -367.097565f, true, {0, 0, 0}}},
+        {{2.21563625f, -368.337738f, true, {0, 0, 0}}, {4.43627739f, -369.051086f, true, {0, 0, 0}}, {10.9722815f, -369.068268f, true, {0, 0, 0}}, {21.9366379f, -368.51889f, true, {0, 0, 0}}, {45.7197495f, -364.492462f, true, {0, 0, 0}}, {112.209373f, -364.754181f, true, {0, 0, 0}}, {224.401093f, -367.26178f, true, {0, 0, 0}}, {438.828339f, -367.266327f, true, {0, 0, 0}}},
+    },
+    {   // 1000 Hz
+        {{427.882904f, -367.98941f, true, {0, 0, 0}}, {856.708008f, -368.539673f, true, {0, 0, 0}}, {2120.72729f, -368.609436f, true, {0, 0, 0}}, {4233.85938f, -368.158447f, true, {0, 0, 0}}, {8724.71289f, -364.591827f, true, {0, 0, 0}}, {21414.5723f, -364.766937f, true, {0, 0, 0}}, {43033.3711f, -367.107483f, true, {0, 0, 0}}, {84530.0469f, -366.975037f, true, {0, 0, 0}}},
+        {{2.17372179f, -368.180084f, true, {0, 0, 0}}, {4.35223007f, -368.730347f, true, {0, 0, 0}}, {10.773675f, -368.80011f, true, {0, 0, 0}}, {21.5087643f, -368.349121f, true, {0, 0, 0}}, {44.3231049f, -364.782501f, true, {0, 0, 0}}, {108.789856f, -364.957611f, true, {0, 0, 0}}, {218.617249f, -367.298187f, true, {0, 0, 0}}, {429.427795f, -367.16571f, true, {0, 0, 0}}},
+    },
+    {   // 800 Hz
+        {{426.856934f, -368.192627f, true, {0, 0, 0}}, {853.681763f, -368.55127f, true, {0, 0, 0}}, {2113.38354f, -368.646912f, true, {0, 0, 0}}, {4215.35938f, -368.314514f, true, {0, 0, 0}}, {8602.35449f, -365.237793f, true, {0, 0, 0}}, {21160.3281f, -365.388245f, true, {0, 0, 0}}, {42666.5898f, -367.439362f, true, {0, 0, 0}}, {84246.9922f, -367.247314f, true, {0, 0, 0}}},
+        {{2.16777205f, -368.400787f, true, {0, 0, 0}}, {4.33538151f, -368.75943f, true, {0, 0, 0}}, {10.7327147f, -368.855072f, true, {0, 0, 0}}, {21.4074974f, -368.522675f, true, {0, 0, 0}}, {43.6866379f, -365.445923f, true, {0, 0, 0}}, {107.461693f, -365.596405f, true, {0, 0, 0}}, {216.680206f, -367.647522f, true, {0, 0, 0}}, {427.844238f, -367.455475f, true, {0, 0, 0}}},
+    },
+    {   // 625 Hz
+        {{412.151337f, -368.757111f, true, {0, 0, 0}}, {822.611084f, -368.946289f, true, {0, 0, 0}}, {2035.62427f, -369.01123f, true, {0, 0, 0}}, {4057.68628f, -368.835876f, true, {0, 0, 0}}, {8219.11328f, -366.289093f, true, {0, 0, 0}}, {20264.0215f, -366.519226f, true, {0, 0, 0}}, {40934.3281f, -368.049713f, true, {0, 0, 0}}, {81279.8438f, -367.908997f, true, {0, 0, 0}}},
+        {{2.09210634f, -368.983673f, true, {0, 0, 0}}, {4.17562628f, -369.172882f, true, {0, 0, 0}}, {10.3329582f, -369.237793f, true, {0, 0, 0}}, {20.5970745f, -369.062469f, true, {0, 0, 0}}, {41.7207451f, -366.515686f, true, {0, 0, 0}}, {102.861458f, -366.745789f, true, {0, 0, 0}}, {207.785263f, -368.276306f, true, {0, 0, 0}}, {412.581635f, -368.135559f, true, {0, 0, 0}}},
+    },
+    {   // 500 Hz
+        {{401.155945f, -368.681335f, true, {0, 0, 0}}, {798.61731f, -368.780975f, true, {0, 0, 0}}, {1974.48608f, -368.766174f, true, {0, 0, 0}}, {3933.23315f, -368.752625f, true, {0, 0, 0}}, {7939.08252f, -366.642731f, true, {0, 0, 0}}, {19620.3047f, -366.983398f, true, {0, 0, 0}}, {39610.3398f, -367.896759f, true, {0, 0, 0}}, {79006.0234f, -367.946808f, true, {0, 0, 0}}},
+        {{2.03520775f, -368.93222f, true, {0, 0, 0}}, {4.0516715f, -369.03186f, true, {0, 0, 0}}, {10.0172749f, -369.01709f, true, {0, 0, 0}}, {19.9547005f, -369.00354f, true, {0, 0, 0}}, {40.2778053f, -366.893646f, true, {0, 0, 0}}, {99.5408325f, -367.234314f, true, {0, 0, 0}}, {200.957428f, -368.147675f, true, {0, 0, 0}}, {400.825836f, -368.197723f, true, {0, 0, 0}}},
+    },
+    {   // 400 Hz
+        {{387.458801f, -368.31604f, true, {0, 0, 0}}, {770.312988f, -368.343628f, true, {0, 0, 0}}, {1901.73706f, -368.261749f, true, {0, 0, 0}}, {3786.81006f, -368.422913f, true, {0, 0, 0}}, {7629.93311f, -366.663818f, true, {0, 0, 0}}, {18883.8926f, -367.117065f, true, {0, 0, 0}}, {38111.168f, -367.399261f, true, {0, 0, 0}}, {76225.1172f, -367.696472f, true, {0, 0, 0}}},
+        {{1.96444476f, -368.573547f, true, {0, 0, 0}}, {3.9055438f, -368.601166f, true, {0, 0, 0}}, {9.64194679f, -368.519287f, true, {0, 0, 0}}, {19.1994057f, -368.68042f, true, {0, 0, 0}}, {38.6843224f, -366.921356f, true, {0, 0, 0}}, {95.7427368f, -367.374573f, true, {0, 0, 0}}, {193.226425f, -367.656769f, true, {0, 0, 0}}, {386.46698f, -367.953979f, true, {0, 0, 0}}},
+    },
+    {   // 250 Hz
+        {{356.665894f, -370.074554f, true, {0, 0, 0}}, {709.694458f, -370.006744f, true, {0, 0, 0}}, {1747.39246f, -369.857208f, true, {0, 0, 0}}, {3487.07031f, -370.12439f, true, {0, 0, 0}}, {7012.25293f, -368.955566f, true, {0, 0, 0}}, {17355.4219f, -369.253174f, true, {0, 0, 0}}, {35040.6562f, -368.768372f, true, {0, 0, 0}}, {70140.9766f, -369.715179f, true, {0, 0, 0}}},
+        {{1.80677819f, -370.38913f, true, {0, 0, 0}}, {3.59513068f, -370.321289f, true, {0, 0, 0}}, {8.85184383f, -370.171783f, true, {0, 0, 0}}, {17.6646061f, -370.438934f, true, {0, 0, 0}}, {35.5222816f, -369.270142f, true, {0, 0, 0}}, {87.918129f, -369.567719f, true, {0, 0, 0}}, {177.507019f, -369.082916f, true, {0, 0, 0}}, {355.316254f, -370.029724f, true, {0, 0, 0}}},
+    },
+    {   // 200 Hz
+        {{348.942657f, -370.400574f, true, {0, 0, 0}}, {694.736572f, -370.373138f, true, {0, 0, 0}}, {1712.7074f, -370.164337f, true, {0, 0, 0}}, {3422.55737f, -370.382721f, true, {0, 0, 0}}, {6871.5166f, -369.524689f, true, {0, 0, 0}}, {16993.2188f, -369.62558f, true, {0, 0, 0}}, {34310.5703f, -369.117249f, true, {0, 0, 0}}, {68646.7031f, -370.184204f, true, {0, 0, 0}}},
+        {{1.76762629f, -370.715759f, true, {0, 0, 0}}, {3.51930189f, -370.688324f, true, {0, 0, 0}}, {8.67599964f, -370.479523f, true, {0, 0, 0}}, {17.3375244f, -370.697906f, true, {0, 0, 0}}, {34.8087921f, -369.839874f, true, {0, 0, 0}}, {86.0819397f, -369.940765f, true, {0, 0, 0}}, {173.805817f, -369.432404f, true, {0, 0, 0}}, {347.74115f, -370.49939f, true, {0, 0, 0}}},
+    },
+    {   // 160 Hz
+        {{323.295807f, -370.55603f, true, {0, 0, 0}}, {643.437561f, -370.581085f, true, {0, 0, 0}}, {1590.9104f, -370.306671f, true, {0, 0, 0}}, {3182.35229f, -370.479248f, true, {0, 0, 0}}, {6367.42139f, -369.891235f, true, {0, 0, 0}}, {15743.7109f, -369.889435f, true, {0, 0, 0}}, {31800.1699f, -369.388855f, true, {0, 0, 0}}, {63584.043f, -370.425018f, true, {0, 0, 0}}},
+        {{1.63793194f, -370.879791f, true, {0, 0, 0}}, {3.2598846f, -370.904846f, true, {0, 0, 0}}, {8.06012058f, -370.630432f, true, {0, 0, 0}}, {16.1229343f, -370.803009f, true, {0, 0, 0}}, {32.2596321f, -370.214996f, true, {0, 0, 0}}, {79.7632599f, -370.213196f, true, {0, 0, 0}}, {161.111023f, -369.712616f, true, {0, 0, 0}}, {322.139465f, -370.748779f, true, {0, 0, 0}}},
+    },
+    {   // 125 Hz
+        {{310.860413f, -369.97345f, true, {0, 0, 0}}, {618.390381f, -370.061249f, true, {0, 0, 0}}, {1534.22046f, -369.730652f, true, {0, 0, 0}}, {3070.6499f, -369.824219f, true, {0, 0, 0}}, {6110.76562f, -369.495422f, true, {0, 0, 0}}, {15117.6309f, -369.458832f, true, {0, 0, 0}}, {30588.1367f, -368.999847f, true, {0, 0, 0}}, {61136.75f, -369.840179f, true, {0, 0, 0}}},
+        {{1.57536674f, -370.289093f, true, {0, 0, 0}}, {3.13385582f, -370.376892f, true, {0, 0, 0}}, {7.77506542f, -370.046295f, true, {0, 0, 0}}, {15.5613251f, -370.139862f, true, {0, 0, 0}}, {30.9679089f, -369.811066f, true, {0, 0, 0}}, {76.6125641f, -369.774475f, true, {0, 0, 0}}, {155.013428f, -369.315491f, true, {0, 0, 0}}, {309.826538f, -370.155823f, true, {0, 0, 0}}},
+    },
+    {   // 100 Hz
+        {{305.648621f, -369.641052f, true, {0, 0, 0}}, {608.265137f, -369.770172f, true, {0, 0, 0}}, {1512.99463f, -369.410065f, true, {0, 0, 0}}, {3029.56323f, -369.374695f, true, {0, 0, 0}}, {5994.33496f, -369.26767f, true, {0, 0, 0}}, {14835.8271f, -369.303406f, true, {0, 0, 0}}, {30103.7676f, -368.891113f, true, {0, 0, 0}}, {60166.0156f, -369.43512f, true, {0, 0, 0}}},
+        {{1.54964471f, -369.962158f, true, {0, 0, 0}}, {3.08391666f, -370.091248f, true, {0, 0, 0}}, {7.6709137f, -369.73114f, true, {0, 0, 0}}, {15.3599482f, -369.695801f, true, {0, 0, 0}}, {30.3914013f, -369.588745f, true, {0, 0, 0}}, {75.2179489f, -369.624512f, true, {0, 0, 0}}, {152.626724f, -369.212219f, true, {0, 0, 0}}, {305.042938f, -369.756195f, true, {0, 0, 0}}},
+    },
+    {   // 80 Hz
+        {{300.373627f, -370.965668f, true, {0, 0, 0}}, {598.37915f, -371.093842f, true, {0, 0, 0}}, {1491.21716f, -370.757843f, true, {0, 0, 0}}, {2985.15356f, -370.550507f, true, {0, 0, 0}}, {5879.14062f, -370.654785f, true, {0, 0, 0}}, {14551.9775f, -370.825073f, true, {0, 0, 0}}, {29620.3516f, -370.468536f, true, {0, 0, 0}}, {59232.9688f, -370.69046f, true, {0, 0, 0}}},
+        {{1.52348769f, -371.288635f, true, {0, 0, 0}}, {3.03496456f, -371.416809f, true, {0, 0, 0}}, {7.56341696f, -371.080811f, true, {0, 0, 0}}, {15.140626f, -370.873474f, true, {0, 0, 0}}, {29.8188572f, -370.977753f, true, {0, 0, 0}}, {73.8072739f, -371.148041f, true, {0, 0, 0}}, {150.233704f, -370.791504f, true, {0, 0, 0}}, {300.428162f, -371.013428f, true, {0, 0, 0}}},
+    },
+    {   // 50 Hz
+        {{278.191193f, -372.342712f, true, {0, 0, 0}}, {555.072205f, -372.397583f, true, {0, 0, 0}}, {1386.50842f, -372.201477f, true, {0, 0, 0}}, {2769.72974f, -371.814148f, true, {0, 0, 0}}, {5433.83984f, -371.959717f, true, {0, 0, 0}}, {13483.8096f, -372.653107f, true, {0, 0, 0}}, {27478.0391f, -371.876587f, true, {0, 0, 0}}, {55042.4961f, -372.122192f, true, {0, 0, 0}}},
+        {{1.41120994f, -372.714355f, true, {0, 0, 0}}, {2.81577349f, -372.769226f, true, {0, 0, 0}}, {7.0334878f, -372.57312f, true, {0, 0, 0}}, {14.0503016f, -372.185791f, true, {0, 0, 0}}, {27.5648155f, -372.33136f, true, {0, 0, 0}}, {68.4007492f, -373.02475f, true, {0, 0, 0}}, {139.390762f, -372.24823f, true, {0, 0, 0}}, {279.21991f, -372.493835f, true, {0, 0, 0}}},
+    },
+    {   // 40 Hz
+        {{266.461792f, -372.764954f, true, {0, 0, 0}}, {531.649109f, -372.780426f, true, {0, 0, 0}}, {1328.41589f, -372.672455f, true, {0, 0, 0}}, {2651.83813f, -372.258118f, true, {0, 0, 0}}, {5202.68604f, -372.351257f, true, {0, 0, 0}}, {12944.1191f, -373.221863f, true, {0, 0, 0}}, {26317.6934f, -372.213135f, true, {0, 0, 0}}, {52749.832f, -372.531219f, true, {0, 0, 0}}},
+        {{1.35127711f, -373.186249f, true, {0, 0, 0}}, {2.69609118f, -373.201721f, true, {0, 0, 0}}, {6.73664284f, -373.09375f, true, {0, 0, 0}}, {13.4479628f, -372.679413f, true, {0, 0, 0}}, {26.3837872f, -372.772552f, true, {0, 0, 0}}, {65.6420288f, -373.643158f, true, {0, 0, 0}}, {133.461899f, -372.63443f, true, {0, 0, 0}}, {267.504181f, -372.952515f, true, {0, 0, 0}}},
+    },
+    {   // 32 Hz
+        {{253.107559f, -372.119904f, true, {0, 0, 0}}, {504.73056f, -372.096069f, true, {0, 0, 0}}, {1261.15637f, -372.033844f, true, {0, 0, 0}}, {2518.20776f, -371.600677f, true, {0, 0, 0}}, {4942.93945f, -371.629486f, true, {0, 0, 0}}, {12340.166f, -372.768585f, true, {0, 0, 0}}, {24982.7012f, -371.382019f, true, {0, 0, 0}}, {50090.1211f, -371.863586f, true, {0, 0, 0}}},
+        {{1.28293884f, -372.605286f, true, {0, 0, 0}}, {2.55835295f, -372.581482f, true, {0, 0, 0}}, {6.3924861f, -372.519226f, true, {0, 0, 0}}, {12.7641659f, -372.08609f, true, {0, 0, 0}}, {25.0545254f, -372.114899f, true, {0, 0, 0}}, {62.5492134f, -373.253998f, true, {0, 0, 0}}, {126.631065f, -371.867432f, true, {0, 0, 0}}, {253.894287f, -372.348969f, true, {0, 0, 0}}},
+    },
+    {   // 25 Hz
+        {{248.909592f, -374.029999f, true, {0, 0, 0}}, {496.112946f, -374.009033f, true, {0, 0, 0}}, {1239.27271f, -374.121124f, true, {0, 0, 0}}, {2476.38721f, -373.638794f, true, {0, 0, 0}}, {4866.97998f, -373.630127f, true, {0, 0, 0}}, {12188.582f, -374.658325f, true, {0, 0, 0}}, {24548.9355f, -373.004608f, true, {0, 0, 0}}, {49224.2461f, -373.688782f, true, {0, 0, 0}}},
+        {{1.26091063f, -374.601013f, true, {0, 0, 0}}, {2.51317787f, -374.580048f, true, {0, 0, 0}}, {6.27782965f, -374.692139f, true, {0, 0, 0}}, {12.5447273f, -374.209808f, true, {0, 0, 0}}, {24.6548424f, -374.201141f, true, {0, 0, 0}}, {61.7441521f, -375.22937f, true, {0, 0, 0}}, {124.358452f, -373.575623f, true, {0, 0, 0}}, {249.357086f, -374.259796f, true, {0, 0, 0}}},
+    },
+    {   // 20 Hz
+        {{244.52742f, -371.098846f, true, {0, 0, 0}}, {487.030731f, -371.126831f, true, {0, 0, 0}}, {1216.3606f, -371.315979f, true, {0, 0, 0}}, {2432.271f, -370.838501f, true, {0, 0, 0}}, {4789.30127f, -370.776459f, true, {0, 0, 0}}, {12020.5889f, -371.711121f, true, {0, 0, 0}}, {24094.8008f, -369.852875f, true, {0, 0, 0}}, {48296.1602f, -370.754944f, true, {0, 0, 0}}},
+        {{1.23939455f, -371.759491f, true, {0, 0, 0}}, {2.46852994f, -371.787476f, true, {0, 0, 0}}, {6.16516018f, -371.976624f, true, {0, 0, 0}}, {12.3280392f, -371.499176f, true, {0, 0, 0}}, {24.2747173f, -371.437103f, true, {0, 0, 0}}, {60.9267197f, -372.371765f, true, {0, 0, 0}}, {122.125229f, -370.513519f, true, {0, 0, 0}}, {244.790543f, -371.415619f, true, {0, 0, 0}}},
+    },
+    {   // 16 Hz
+        {{230.484955f, -369.044769f, true, {0, 0, 0}}, {459.118958f, -369.202118f, true, {0, 0, 0}}, {1145.81226f, -369.381256f, true, {0, 0, 0}}, {2292.8667f, -368.965546f, true, {0, 0, 0}}, {4524.99023f, -368.906311f, true, {0, 0, 0}}, {11351.3135f, -369.628876f, true, {0, 0, 0}}, {22709.8535f, -367.786987f, true, {0, 0, 0}}, {45492.332f, -368.771545f, true, {0, 0, 0}}},
+        {{1.17009187f, -369.806122f, true, {0, 0, 0}}, {2.33078694f, -369.963501f, true, {0, 0, 0}}, {5.81688929f, -370.142639f, true, {0, 0, 0}}, {11.6400852f, -369.726898f, true, {0, 0, 0}}, {22.9717999f, -369.667664f, true, {0, 0, 0}}, {57.6266632f, -370.390259f, true, {0, 0, 0}}, {115.290016f, -368.54834f, true, {0, 0, 0}}, {230.948715f, -369.532898f, true, {0, 0, 0}}},
+    },
+    {   // 10 Hz
+        {{241.045853f, -384.044312f, true, {0, 0, 0}}, {480.324432f, -384.559723f, true, {0, 0, 0}}, {1197.22192f, -384.537323f, true, {0, 0, 0}}, {2397.35327f, -384.407532f, true, {0, 0, 0}}, {4752.66602f, -384.273865f, true, {0, 0, 0}}, {11879.7256f, -384.386963f, true, {0, 0, 0}}, {23736.0801f, -383.078156f, true, {0, 0, 0}}, {47566.0078f, -384.001526f, true, {0, 0, 0}}},
+        {{1.2049582f, -385.053711f, true, {0, 0, 0}}, {2.40108204f, -385.569122f, true, {0, 0, 0}}, {5.98476315f, -385.546753f, true, {0, 0, 0}}, {11.9840698f, -385.416931f, true, {0, 0, 0}}, {23.7579861f, -385.283295f, true, {0, 0, 0}}, {59.3852692f, -385.396393f, true, {0, 0, 0}}, {118.653709f, -384.087555f, true, {0, 0, 0}}, {237.77655f, -385.010956f, true, {0, 0, 0}}},
+    },
+    {   // 8 Hz
+        {{204.146545f, -377.721252f, true, {0, 0, 0}}, {406.95993f, -378.357635f, true, {0, 0, 0}}, {1013.76752f, -378.157776f, true, {0, 0, 0}}, {2030.31616f, -378.182037f, true, {0, 0, 0}}, {4032.37988f, -378.030701f, true, {0, 0, 0}}, {10053.415f, -377.89801f, true, {0, 0, 0}}, {20099.3066f, -376.988586f, true, {0, 0, 0}}, {40300.8711f, -377.737061f, true, {0, 0, 0}}},
+        {{1.00993395f, -378.865662f, true, {0, 0, 0}}, {2.01327276f, -379.502045f, true, {0, 0, 0}}, {5.01521206f, -379.302185f, true, {0, 0, 0}}, {10.0441828f, -379.326447f, true, {0, 0, 0}}, {19.948597f, -379.17511f, true, {0, 0, 0}}, {49.7352791f, -379.042419f, true, {0, 0, 0}}, {99.4333344f, -378.132996f, true, {0, 0, 0}}, {199.372543f, -378.8815f, true, {0, 0, 0}}},
+    },
+    {   // 5 Hz
+        {{129.83873f, -389.575592f, true, {0, 0, 0}}, {259.076233f, -390.362274f, true, {0, 0, 0}}, {644.754761f, -389.86203f, true, {0, 0, 0}}, {1291.81421f, -390.161346f, true, {0, 0, 0}}, {2571.23926f, -390.034912f, true, {0, 0, 0}}, {6382.57422f, -389.507172f, true, {0, 0, 0}}, {12777.1094f, -389.317169f, true, {0, 0, 0}}, {25664.9082f, -389.643402f, true, {0, 0, 0}}},
+        {{0.627815366f, -391.041687f, true, {0, 0, 0}}, {1.25272369f, -391.828369f, true, {0, 0, 0}}, {3.11761332f, -391.328125f, true, {0, 0, 0}}, {6.24637032f, -391.627441f, true, {0, 0, 0}}, {12.4328356f, -391.501007f, true, {0, 0, 0}}, {30.8619652f, -390.973267f, true, {0, 0, 0}}, {61.781765f, -390.783264f, true, {0, 0, 0}}, {124.098755f, -391.109497f, true, {0, 0, 0}}},
+    },
+    {   // 4 Hz
+        {{212.148819f, -367.806f, true, {0, 0, 0}}, {423.459961f, -368.638306f, true, {0, 0, 0}}, {1053.42798f, -367.99765f, true, {0, 0, 0}}, {2111.00928f, -368.425354f, true, {0, 0, 0}}, {4202.91992f, -368.332367f, true, {0, 0, 0}}, {10425.8057f, -367.651886f, true, {0, 0, 0}}, {20873.7969f, -367.807037f, true, {0, 0, 0}}, {41947.7266f, -367.886383f, true, {0, 0, 0}}},
+        {{1.01763213f, -369.443115f, true, {0, 0, 0}}, {2.03124595f, -370.275421f, true, {0, 0, 0}}, {5.05306673f, -369.634766f, true, {0, 0, 0}}, {10.1260557f, -370.062469f, true, {0, 0, 0}}, {20.1605015f, -369.969482f, true, {0, 0, 0}}, {50.0103416f, -369.289001f, true, {0, 0, 0}}, {100.127098f, -369.444153f, true, {0, 0, 0}}, {201.214203f, -369.523499f, true, {0, 0, 0}}},
+    },
+    {   // 2 Hz
+        {{186.578537f, -492.976898f, true, {0, 0, 0}}, {372.800415f, -493.847076f, true, {0, 0, 0}}, {926.224915f, -492.744568f, true, {0, 0, 0}}, {1856.98694f, -493.587158f, true, {0, 0, 0}}, {3693.43042f, -493.659637f, true, {0, 0, 0}}, {9170.30078f, -492.625549f, true, {0, 0, 0}}, {18358.9961f, -493.957642f, true, {0, 0, 0}}, {36905.8711f, -493.045959f, true, {0, 0, 0}}},
+        {{0.878829241f, -495.22403f, true, {0, 0, 0}}, {1.75597847f, -496.094208f, true, {0, 0, 0}}, {4.36273909f, -494.991699f, true, {0, 0, 0}}, {8.74684906f, -495.83429f, true, {0, 0, 0}}, {17.3969345f, -495.906799f, true, {0, 0, 0}}, {43.194294f, -494.872711f, true, {0, 0, 0}}, {86.475235f, -496.204773f, true, {0, 0, 0}}, {173.835403f, -495.293091f, true, {0, 0, 0}}},
+    },
+    {   // 1 Hz
+        {{277.818237f, -371.976532f, true, {0, 0, 0}}, {555.742493f, -372.686279f, true, {0, 0, 0}}, {1378.77258f, -371.125519f, true, {0, 0, 0}}, {2765.76343f, -372.384796f, true, {0, 0, 0}}, {5478.46094f, -372.713959f, true, {0, 0, 0}}, {13677.0635f, -371.522919f, true, {0, 0, 0}}, {27363.6289f, -374.131104f, true, {0, 0, 0}}, {54930.5898f, -371.914703f, true, {0, 0, 0}}},
+        {{1.30159748f, -374.958344f, true, {0, 0, 0}}, {2.60369158f, -375.66806f, true, {0, 0, 0}}, {6.45964384f, -374.1073f, true, {0, 0, 0}}, {12.9577913f, -375.366577f, true, {0, 0, 0}}, {25.6669636f, -375.69574f, true, {0, 0, 0}}, {64.07798f, -374.5047f, true, {0, 0, 0}}, {128.20047f, -377.112915f, true, {0, 0, 0}}, {257.353577f, -374.896515f, true, {0, 0, 0}}},
+    },
+};
+
+static const GoldenPoint goldenPoints[] = {
+    {"PBS 1x DUT 1_2.pssession", 1, 1, 3.084f, -41.3600f, 0.514f, 3, false, true, 14342.3f, -52.5951f},
+    {"PBS 1x DUT 1_2.pssession", 1, 2, 3.086f, -41.0100f, 0.737f, 3, false, true, 9812.82f, -48.5114f},
+    {"PBS 1x DUT 1_2.pssession", 1, 4, 3.08f, -41.4500f, 1.083f, 3, false, true, 7025.49f, -45.2019f},
+    {"PBS 1x DUT 1_2.pssession", 1, 5, 3.085f, -40.1100f, 1.224f, 3, false, true, 6381.41f, -44.6957f},
+    {"PBS 1x DUT 1_2.pssession", 1, 8, 3.087f, -40.2600f, 1.603f, 3, false, true, 5197.18f, -44.3296f},
+    {"PBS 1x DUT 1_2.pssession", 1, 10, 3.084f, -40.3800f, 1.796f, 3, false, true, 4716.15f, -45.0412f},
+    {"PBS 1x DUT 1_2.pssession", 1, 16, 3.085f, -40.1200f, 1.132f, 2, false, true, 3807.61f, -47.0401f},
+    {"PBS 1x DUT 1_2.pssession", 1, 20, 3.08f, -40.8300f, 1.259f, 2, false, true, 3422.25f, -48.4038f},
+    {"PBS 1x DUT 1_2.pssession", 1, 25, 3.084f, -40.5700f, 1.433f, 2, false, true, 3057.15f, -50.0796f},
+    {"PBS 1x DUT 1_2.pssession", 1, 32, 3.088f, -40.9200f, 1.634f, 2, false, true, 2677.41f, -52.2483f},
+    {"PBS 1x DUT 1_2.pssession", 1, 40, 3.087f, -42.3500f, 1.874f, 2, false, true, 2356.97f, -54.2682f},
+    {"PBS 1x DUT 1_2.pssession", 1, 50, 3.087f, -42.7500f, 2.136f, 2, false, true, 2046.63f, -56.4128f},
+    {"PBS 1x DUT 1_2.pssession", 1, 80, 3.082f, -44.7000f, 1.148f, 1, false, true, 1510.03f, -60.5973f},
+    {"PBS 1x DUT 1_2.pssession", 1, 100, 3.083f, -45.9800f, 1.336f, 1, false, true, 1291.36f, -62.5302f},
+    {"PBS 1x DUT 1_2.pssession", 1, 125, 3.084f, -47.7100f, 1.575f, 1, false, true, 1099.88f, -64.2649f},
+    {"PBS 1x DUT 1_2.pssession", 1, 160, 3.081f, -50.5800f, 1.929f, 1, false, true, 913.686f, -65.9555f},
+    {"PBS 1x DUT 1_2.pssession", 1, 200, 3.08f, -54.4000f, 2.418f, 1, false, true, 770.234f, -67.3445f},
+    {"PBS 1x DUT 1_2.pssession", 1, 250, 3.082f, -58.9200f, 1.589f, 0, false, true, 646.316f, -68.5060f},
+    {"PBS 1x DUT 1_2.pssession", 1, 400, 3.082f, -67.0400f, 2.932f, 0, false, true, 442.383f, -70.4149f},
+    {"PBS 1x DUT 1_2.pssession", 1, 500, 3.084f, -63.2400f, 1.454f, 6, true, true, 368.147f, -71.1449f},
+    {"PBS 1x DUT 1_2.pssession", 1, 625, 3.082f, -65.5100f, 1.893f, 6, true, true, 305.796f, -71.7769f},
+    {"PBS 1x DUT 1_2.pssession", 1, 800, 3.083f, -67.7100f, 2.488f, 6, true, true, 250.792f, -72.3498f},
+    {"PBS 1x DUT 1_2.pssession", 1, 1000, 3.089f, -68.3800f, 1.582f, 5, true, true, 208.411f, -72.7469f},
+    {"PBS 1x DUT 1_2.pssession", 1, 1250, 3.081f, -69.4700f, 1.996f, 5, true, true, 172.727f, -72.9164f},
+    {"PBS 1x DUT 1_2.pssession", 1, 2000, 3.083f, -69.2000f, 1.313f, 4, true, true, 115.451f, -72.6920f},
+    {"PBS 1x DUT 1_2.pssession", 1, 2500, 3.081f, -68.4300f, 1.633f, 4, true, true, 95.2134f, -72.3201f},
+    {"PBS 1x DUT 1_2.pssession", 1, 3125, 3.096f, -66.5300f, 2.055f, 4, true, true, 78.2414f, -71.9175f},
+    {"PBS 1x DUT 1_2.pssession", 1, 4000, 3.081f, -65.7900f, 2.56f, 4, true, true, 62.7996f, -71.2240f},
+    {"PBS 1x DUT 1_2.pssession", 1, 5000, 3.089f, -63.1000f, 1.541f, 3, true, true, 51.2119f, -70.3772f},
+    {"PBS 1x DUT 1_2.pssession", 1, 6250, 3.082f, -60.6900f, 1.858f, 3, true, true, 41.483f, -69.3867f},
+    {"PBS 1x DUT 1_2.pssession", 1, 10000, 3.088f, -53.2300f, 2.532f, 3, true, true, 25.5292f, -66.2988f},
+    {"PBS 1x DUT 1_2.pssession", 1, 12500, 3.092f, -49.2100f, 2.915f, 3, true, true, 25.2707f, -58.7098f},
+    {"PBS 1x DUT 1_2.pssession", 1, 15625, 3.096f, -45.8700f, 1.629f, 2, true, true, 21.3625f, -55.0777f},
+    {"PBS 1x DUT 1_2.pssession", 1, 25000, 3.106f, -36.5200f, 2.056f, 2, true, true, 15.6129f, -46.0610f},
+    {"PBS 1x DUT 1_2.pssession", 1, 50000, 3.118f, -25.2000f, 2.552f, 2, true, true, 11.1664f, -31.2730f},
+    {"PBS 1x DUT 1_2.pssession", 1, 62500, 3.118f, -22.2400f, 2.648f, 2, true, true, 10.3251f, -26.4064f},
+    {"PBS 1x DUT 1_2.pssession", 1, 80000, 3.113f, -19.1700f, 2.77f, 2, true, true, 9.62795f, -20.8698f},
+    {"PBS 1x DUT 1_2.pssession", 1, 100000, 3.095f, -16.2500f, 2.832f, 2, true, true, 9.20591f, -15.5150f},
+};
+
+#define GOLDEN_POINT_COUNT  (sizeof(goldenPoints) / sizeof(goldenPoints[0]))
+
+#endif // GOLDEN_DATA_H
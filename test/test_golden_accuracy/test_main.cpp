@@ -0,0 +1,217 @@
+#include <unity.h>
+#include "fixed_cal.h"
+#include "impedance_math.h"
+#include "sweep_table.h"
+#include "golden_data.h"       // python golden_accuracy.py
+
+// Specified accuracy of the front end against the PalmSens reference, by band.
+// Frequencies outside every band are not specified and not checked
+struct AccuracyBand {
+    uint32_t minHz;
+    uint32_t maxHz;
+    float magTol;       // |Z| error, percent
+    float phaseTol;     // Degrees
+};
+
+static const AccuracyBand bands[] = {
+    {10,    80,     5.0f, 3.0f},    // Electrode polarisation, few periods per integration
+    {100,   10000,  2.0f, 2.0f},    // Core band
+    {12500, 100000, 5.0f, 3.0f},    // TIA bandwidth and lead capacitance
+};
+
+// Fixed kernel against the float path on the same points
+#define FIXED_MAX_MAG_ERROR     100e-6f     // 100 ppm
+#define FIXED_MAX_PHASE_ERROR   0.01f       // Degrees
+
+// Points outside their band's tolerance with today's calibration (data/),
+// by metric - today's float-path error in the comment. A listed metric that
+// comes back within tolerance fails the suite as well, so the entry goes with
+// the change that fixed it. Do not add entries to let a change through
+#define KNOWN_MAG       0x01
+#define KNOWN_PHASE     0x02
+
+struct KnownFailure {
+    uint8_t dut;
+    uint32_t freq_hz;
+    uint8_t metrics;
+};
+
+static const KnownFailure knownFailures[] = {
+    {1, 10,     KNOWN_MAG | KNOWN_PHASE},   // 12.7 %, 19.7 deg
+    {1, 16,     KNOWN_MAG},                 // 18.0 %
+    {1, 20,     KNOWN_MAG | KNOWN_PHASE},   // 13.0 %, 3.7 deg
+    {1, 25,     KNOWN_MAG | KNOWN_PHASE},   // 12.8 %, 4.6 deg
+    {1, 32,     KNOWN_MAG},                 // 11.0 %
+    {1, 40,     KNOWN_MAG},                 // 7.2 %
+    {1, 80,     KNOWN_MAG | KNOWN_PHASE},   // 6.4 %, 4.8 deg
+    {1, 100,    KNOWN_MAG | KNOWN_PHASE},   // 8.7 %, 6.8 deg
+    {1, 125,    KNOWN_MAG | KNOWN_PHASE},   // 10.1 %, 6.5 deg
+    {1, 160,    KNOWN_MAG | KNOWN_PHASE},   // 12.5 %, 4.8 deg
+    {1, 200,    KNOWN_MAG | KNOWN_PHASE},   // 14.9 %, 2.6 deg
+    {1, 250,    KNOWN_MAG},                 // 7.0 %
+    {1, 400,    KNOWN_MAG | KNOWN_PHASE},   // 7.9 %, 4.9 deg
+    {1, 500,    KNOWN_MAG},                 // 15.8 %
+    {1, 625,    KNOWN_MAG | KNOWN_PHASE},   // 10.6 %, 2.01 deg
+    {1, 800,    KNOWN_MAG | KNOWN_PHASE},   // 7.1 %, 3.0 deg
+    {1, 2000,   KNOWN_MAG},                 // 2.5 %
+    {1, 2500,   KNOWN_MAG | KNOWN_PHASE},   // 5.5 %, 4.7 deg
+    {1, 3125,   KNOWN_MAG | KNOWN_PHASE},   // 5.7 %, 6.0 deg
+    {1, 4000,   KNOWN_MAG | KNOWN_PHASE},   // 8.9 %, 6.1 deg
+    {1, 5000,   KNOWN_PHASE},               // 4.3 deg
+    {1, 6250,   KNOWN_PHASE},               // 5.3 deg
+    {1, 10000,  KNOWN_MAG | KNOWN_PHASE},   // 18.6 %, 10.1 deg
+    {1, 12500,  KNOWN_PHASE},               // 6.5 deg
+    {1, 15625,  KNOWN_MAG | KNOWN_PHASE},   // 7.5 %, 6.5 deg
+    {1, 25000,  KNOWN_MAG | KNOWN_PHASE},   // 15.4 %, 6.0 deg
+    {1, 50000,  KNOWN_MAG},                 // 26.1 %
+    {1, 62500,  KNOWN_MAG},                 // 28.6 %
+    {1, 80000,  KNOWN_MAG},                 // 28.7 %
+    {1, 100000, KNOWN_MAG},                 // 46.0 %
+};
+
+static float phaseError(float d) {
+    while (d > 180.0f) d -= 360.0f;
+    while (d < -180.0f) d += 360.0f;
+    return fabsf(d);
+}
+
+static const AccuracyBand* bandOf(uint32_t freq) {
+    for (const AccuracyBand& band : bands) {
+        if (freq >= band.minHz && freq <= band.maxHz) {
+            return &band;
+        }
+    }
+    return nullptr;
+}
+
+static uint8_t knownMetrics(const GoldenPoint& p) {
+    for (const KnownFailure& k : knownFailures) {
+        if (k.dut == p.dut && k.freq_hz == p.freq_hz) {
+            return k.metrics;
+        }
+    }
+    return 0;
+}
+
+static MeasurementPoint measurement(const GoldenPoint& p) {
+    MeasurementPoint m = {};
+    m.freq_hz = p.freq_hz;
+    m.V_magnitude = p.v_mag;
+    m.I_magnitude = p.i_mag;
+    m.phase_deg = p.phase_deg;
+    m.pga_gain = p.pga;
+    m.tia_gain = p.tia;
+    m.valid = p.valid;
+    m.freq_idx = getSweepFrequencyIndex(p.freq_hz);
+    return m;
+}
+
+// The data processor's float path for m
+static bool floatPath(const MeasurementPoint& m, ImpedancePoint& out) {
+    out = calcImpedance(m);
+    bool success = out.valid && calibrateWithSeparateFiles(out);
+#if IMPEDANCE_RECTANGULAR
+    impedanceToPolar(out);
+#endif
+    return success;
+}
+
+// Every in-band point against its band and the known failures - reports each
+// mismatch, then fails once with the count
+static void checkAgainstReference(bool fixed) {
+    int checked = 0;
+    int mismatches = 0;
+    char msg[160];
+    for (const GoldenPoint& p : goldenPoints) {
+        const AccuracyBand* band = bandOf(p.freq_hz);
+        if (band == nullptr) {
+            continue;
+        }
+        MeasurementPoint m = measurement(p);
+        ImpedancePoint z;
+        bool ok = fixed ? calcFixedCalibratedPoint(m, z) : floatPath(m, z);
+        TEST_ASSERT_TRUE(ok);
+
+        float magErr = fabsf(z.Z_magnitude - p.ref_z) / p.ref_z * 100.0f;
+        float phaseErr = phaseError(z.Z_phase - p.ref_phase);
+        uint8_t failed = (magErr > band->magTol ? KNOWN_MAG : 0) |
+                         (phaseErr > band->phaseTol ? KNOWN_PHASE : 0);
+        uint8_t known = knownMetrics(p);
+        if (failed != known) {
+            snprintf(msg, sizeof(msg), "DUT %u %lu Hz: |Z| %.2f %% (tol %.1f), phase %.2f deg (tol %.1f) - %s",
+                     p.dut, (unsigned long)p.freq_hz, magErr, band->magTol, phaseErr, band->phaseTol,
+                     (failed & ~known) ? "new failure" : "now passes, remove it from knownFailures");
+            TEST_MESSAGE(msg);
+            mismatches++;
+        }
+        checked++;
+    }
+    TEST_ASSERT_TRUE(checked > 0);
+    if (mismatches > 0) {
+        snprintf(msg, sizeof(msg), "%d of %d points differ from the bands and knownFailures", mismatches, checked);
+        TEST_FAIL_MESSAGE(msg);
+    }
+}
+
+void setUp(void) {
+    setCalibrationApplyTable(goldenCalibration);
+    buildFixedCalibrationLUT(goldenCalibration);
+}
+
+void tearDown(void) {
+    setCalibrationApplyTable(emptyCalibrationLUT);
+}
+
+/*=========================FIXTURE=========================*/
+
+void test_known_failures_are_in_band_points(void) {
+    // A stale entry (point dropped from the fixture or out of every band) would
+    // otherwise excuse nothing and hide that the list needs an update
+    for (const KnownFailure& k : knownFailures) {
+        bool found = false;
+        for (const GoldenPoint& p : goldenPoints) {
+            found |= (p.dut == k.dut && p.freq_hz == k.freq_hz);
+        }
+        TEST_ASSERT_TRUE(found);
+        TEST_ASSERT_NOT_NULL(bandOf(k.freq_hz));
+        TEST_ASSERT_TRUE(k.metrics != 0);
+    }
+}
+
+/*=========================REFERENCE=========================*/
+
+void test_float_path_against_reference(void) {
+    checkAgainstReference(false);
+}
+
+void test_fixed_kernel_against_reference(void) {
+    checkAgainstReference(true);
+}
+
+void test_fixed_kernel_matches_float_path(void) {
+    float maxMagErr = 0.0f;
+    float maxPhaseErr = 0.0f;
+    for (const GoldenPoint& p : goldenPoints) {
+        MeasurementPoint m = measurement(p);
+        ImpedancePoint ref;
+        ImpedancePoint fx;
+        bool refOk = floatPath(m, ref);
+        TEST_ASSERT_EQUAL(refOk, calcFixedCalibratedPoint(m, fx));
+        if (!refOk) {
+            continue;
+        }
+        maxMagErr = max(maxMagErr, fabsf(fx.Z_magnitude - ref.Z_magnitude) / ref.Z_magnitude);
+        maxPhaseErr = max(maxPhaseErr, phaseError(fx.Z_phase - ref.Z_phase));
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(FIXED_MAX_MAG_ERROR, maxMagErr);
+    TEST_ASSERT_LESS_THAN_FLOAT(FIXED_MAX_PHASE_ERROR, maxPhaseErr);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_known_failures_are_in_band_points);
+    RUN_TEST(test_float_path_against_reference);
+    RUN_TEST(test_fixed_kernel_against_reference);
+    RUN_TEST(test_fixed_kernel_matches_float_path);
+    return UNITY_END();
+}
@@ -0,0 +1,90 @@
+#include <unity.h>
+#include "impedance_math.h"
+
+static MeasurementPoint measurement(float v, float i, float phase) {
+    MeasurementPoint m = {};
+    m.freq_hz = 1000;
+    m.V_magnitude = v;
+    m.I_magnitude = i;
+    m.phase_deg = phase;
+    m.pga_gain = 5;
+    m.tia_gain = true;
+    m.valid = true;
+    m.freq_idx = 12;
+    return m;
+}
+
+// Polar fields as the data processor stores them
+static ImpedancePoint polar(const MeasurementPoint& m) {
+    ImpedancePoint z = calcImpedance(m);
+#if IMPEDANCE_RECTANGULAR
+    impedanceToPolar(z);
+#endif
+    return z;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/*=========================IMPEDANCE=========================*/
+
+void test_magnitude_is_v_over_i(void) {
+    ImpedancePoint z = polar(measurement(0.5f, 2.0e-4f, -35.0f));
+    TEST_ASSERT_TRUE(z.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 2500.0f, z.Z_magnitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -35.0f, z.Z_phase);
+}
+
+void test_point_fields_are_carried(void) {
+    ImpedancePoint z = calcImpedance(measurement(0.5f, 2.0e-4f, 10.0f));
+    TEST_ASSERT_EQUAL_UINT32(1000, z.freq_hz);
+    TEST_ASSERT_EQUAL_UINT8(5, z.pga_gain);
+    TEST_ASSERT_TRUE(z.tia_gain);
+    TEST_ASSERT_EQUAL_UINT8(12, z.freq_idx);
+}
+
+void test_invalid_or_zero_current_is_rejected(void) {
+    TEST_ASSERT_FALSE(calcImpedance(measurement(0.5f, 0.0f, 0.0f)).valid);
+    TEST_ASSERT_FALSE(calcImpedance(measurement(0.5f, -1.0e-6f, 0.0f)).valid);
+
+    MeasurementPoint m = measurement(0.5f, 1.0e-6f, 0.0f);
+    m.valid = false;
+    TEST_ASSERT_FALSE(calcImpedance(m).valid);
+}
+
+#if IMPEDANCE_RECTANGULAR
+void test_rectangular_parts_match_polar(void) {
+    ImpedancePoint z = calcImpedance(measurement(1.0f, 1.0e-3f, -60.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 500.0f, z.Z_re);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -866.025f, z.Z_im);
+}
+#endif
+
+/*=========================RISK=========================*/
+
+void test_risk_bands(void) {
+    TEST_ASSERT_EQUAL(RISK_NONE, classifyRiskChange(0.0f));
+    TEST_ASSERT_EQUAL(RISK_NONE, classifyRiskChange(-0.2f));
+    TEST_ASSERT_EQUAL(RISK_LOW, classifyRiskChange(lowRiskCutoff));
+    TEST_ASSERT_EQUAL(RISK_MEDIUM, classifyRiskChange(mediumRiskCutoff));
+    TEST_ASSERT_EQUAL(RISK_HIGH, classifyRiskChange(highRiskCutoff));
+    TEST_ASSERT_EQUAL(RISK_HIGH, classifyRiskChange(0.9f));
+}
+
+void test_risk_of_nan_is_an_error(void) {
+    TEST_ASSERT_EQUAL(RISK_ERROR, classifyRiskChange(NAN));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_magnitude_is_v_over_i);
+    RUN_TEST(test_point_fields_are_carried);
+    RUN_TEST(test_invalid_or_zero_current_is_rejected);
+#if IMPEDANCE_RECTANGULAR
+    RUN_TEST(test_rectangular_parts_match_polar);
+#endif
+    RUN_TEST(test_risk_bands);
+    RUN_TEST(test_risk_of_nan_is_an_error);
+    return UNITY_END();
+}
@@ -0,0 +1,90 @@
+#include <unity.h>
+#include "kk_check.h"
+#include <complex>
+
+// Spectrum over the sweep table, by sweep index
+static uint8_t freqIdx[SWEEP_FREQ_COUNT];
+static float mag[SWEEP_FREQ_COUNT];
+static float phaseDeg[SWEEP_FREQ_COUNT];
+
+static void setPoint(int i, std::complex<double> z) {
+    freqIdx[i] = i;
+    mag[i] = (float)std::abs(z);
+    phaseDeg[i] = (float)(std::arg(z) * 180.0 / M_PI);
+}
+
+// Randles cell with a CPE - causal, so Lin-KK describes it
+static void makeRandles() {
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        double w = 2.0 * M_PI * sweepFrequencies[i];
+        std::complex<double> cpe = std::pow(std::complex<double>(0.0, w), 0.85);
+        setPoint(i, 150.0 + 12000.0 / (1.0 + 12000.0 * 2.0e-6 * cpe));
+    }
+}
+
+void setUp(void) {
+    makeRandles();
+}
+
+void tearDown(void) {}
+
+void test_causal_spectrum_passes(void) {
+    KKResult out;
+    TEST_ASSERT_TRUE(checkKramersKronig(freqIdx, mag, phaseDeg, SWEEP_FREQ_COUNT, out));
+    TEST_ASSERT_TRUE(out.checked);
+    TEST_ASSERT_EQUAL(SWEEP_FREQ_COUNT, out.points);
+    TEST_ASSERT_LESS_THAN_FLOAT(KK_MAX_RMS, out.rmsResidual);
+    TEST_ASSERT_LESS_THAN_FLOAT(KK_MAX_RESIDUAL, out.maxResidual);
+}
+
+void test_series_capacitor_passes(void) {
+    // Blocking electrode: R + C, the 1/(j*w*C) column carries it
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        double w = 2.0 * M_PI * sweepFrequencies[i];
+        setPoint(i, 500.0 + 1.0 / std::complex<double>(0.0, w * 1.0e-5));
+    }
+    KKResult out;
+    TEST_ASSERT_TRUE(checkKramersKronig(freqIdx, mag, phaseDeg, SWEEP_FREQ_COUNT, out));
+}
+
+void test_disturbed_point_fails(void) {
+    // A bubble over one point in the middle of the sweep
+    int bad = SWEEP_FREQ_COUNT / 2;
+    mag[bad] *= 1.3f;
+    phaseDeg[bad] += 8.0f;
+    KKResult out;
+    TEST_ASSERT_FALSE(checkKramersKronig(freqIdx, mag, phaseDeg, SWEEP_FREQ_COUNT, out));
+    TEST_ASSERT_TRUE(out.checked);
+    TEST_ASSERT_EQUAL_UINT8(bad, out.worstIdx);
+}
+
+void test_drift_during_sweep_fails(void) {
+    // |Z| falling 1 % per point as the sweep goes on, the phase unchanged
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        mag[i] *= 1.0f - 0.01f * i;
+    }
+    KKResult out;
+    TEST_ASSERT_FALSE(checkKramersKronig(freqIdx, mag, phaseDeg, SWEEP_FREQ_COUNT, out));
+    TEST_ASSERT_TRUE(out.checked);
+}
+
+void test_skipped_points_and_no_verdict(void) {
+    freqIdx[2] = SWEEP_FREQ_INVALID;
+    mag[5] = 0.0f;
+    KKResult out;
+    checkKramersKronig(freqIdx, mag, phaseDeg, SWEEP_FREQ_COUNT, out);
+    TEST_ASSERT_EQUAL(SWEEP_FREQ_COUNT - 2, out.points);
+
+    TEST_ASSERT_FALSE(checkKramersKronig(freqIdx + 6, mag + 6, phaseDeg + 6, KK_MIN_POINTS - 1, out));
+    TEST_ASSERT_FALSE(out.checked);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_causal_spectrum_passes);
+    RUN_TEST(test_series_capacitor_passes);
+    RUN_TEST(test_disturbed_point_fails);
+    RUN_TEST(test_drift_during_sweep_fails);
+    RUN_TEST(test_skipped_points_and_no_verdict);
+    return UNITY_END();
+}
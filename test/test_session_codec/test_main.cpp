@@ -0,0 +1,144 @@
+#include <unity.h>
+#include "session_codec.h"
+#include "sweep_table.h"
+
+// A full sweep of a slowly falling spectrum; scale moves |Z| and phase
+static Session session(bool final, float scale) {
+    Session s = {};
+    s.header.magic = SESSION_MAGIC;
+    s.header.timestamp = 1791990042;
+    s.header.dut = 2;
+    s.header.kind = final ? SESSION_FINAL : SESSION_BASELINE;
+    s.header.count = SWEEP_FREQ_COUNT;
+    s.header.offset = 0;
+    s.header.reference = SESSION_NO_REFERENCE;
+    for (int i = 0; i < SWEEP_FREQ_COUNT; i++) {
+        s.points[i].freq_hz = sweepFrequencies[i];
+        s.points[i].mag = 40.0f * scale * (1.0f + i * i);
+        s.points[i].phase = -15.0f - 1.5f * i * scale;
+        s.points[i].flags = i < 10 ? 3 : 5;
+    }
+    quantizeSessionPoints(s);
+    return s;
+}
+
+static void assertSamePoints(const Session& expected, const Session& actual) {
+    TEST_ASSERT_EQUAL(expected.header.count, actual.header.count);
+    for (int i = 0; i < expected.header.count; i++) {
+        TEST_ASSERT_EQUAL_UINT32(expected.points[i].freq_hz, actual.points[i].freq_hz);
+        TEST_ASSERT_EQUAL_FLOAT(expected.points[i].mag, actual.points[i].mag);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected.points[i].phase, actual.points[i].phase);
+        TEST_ASSERT_EQUAL_UINT8(expected.points[i].flags, actual.points[i].flags);
+    }
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/*=========================CODING=========================*/
+
+void test_self_contained_round_trip(void) {
+    Session s = session(false, 1.0f);
+    uint8_t data[SESSION_DATA_MAX];
+    s.header.bytes = encodeSessionPoints(s, nullptr, data);
+    TEST_ASSERT_TRUE(s.header.bytes > 0 && s.header.bytes <= SESSION_DATA_MAX);
+
+    Session out;
+    TEST_ASSERT_TRUE(decodeSessionPoints(s.header, data, nullptr, out));
+    assertSamePoints(s, out);
+}
+
+void test_delta_against_reference(void) {
+    Session ref = session(false, 1.0f);
+    Session s = session(true, 1.05f);
+    TEST_ASSERT_TRUE(sessionMatchesReference(s, ref));
+    s.points[20].flags = 7;
+
+    uint8_t self[SESSION_DATA_MAX];
+    uint8_t delta[SESSION_DATA_MAX];
+    size_t selfBytes = encodeSessionPoints(s, nullptr, self);
+    s.header.bytes = encodeSessionPoints(s, &ref, delta);
+    // Following the reference costs fewer bytes than coding the points again
+    TEST_ASSERT_LESS_THAN(selfBytes, s.header.bytes);
+
+    Session out;
+    TEST_ASSERT_TRUE(decodeSessionPoints(s.header, delta, &ref, out));
+    assertSamePoints(s, out);
+}
+
+void test_quantized_points_are_stable(void) {
+    Session s = session(false, 1.0f);
+    Session again = s;
+    quantizeSessionPoints(again);
+    assertSamePoints(s, again);
+}
+
+void test_other_frequencies_do_not_match(void) {
+    Session ref = session(false, 1.0f);
+    Session s = session(true, 1.0f);
+    s.points[5].freq_hz += 10;
+    TEST_ASSERT_FALSE(sessionMatchesReference(s, ref));
+    s = session(true, 1.0f);
+    s.header.count--;
+    TEST_ASSERT_FALSE(sessionMatchesReference(s, ref));
+}
+
+/*=========================DAMAGE=========================*/
+
+void test_cut_or_extra_data_is_rejected(void) {
+    Session s = session(false, 1.0f);
+    uint8_t data[SESSION_DATA_MAX + 1];
+    s.header.bytes = encodeSessionPoints(s, nullptr, data);
+    Session out;
+
+    SessionHeader header = s.header;
+    header.bytes--;
+    TEST_ASSERT_FALSE(decodeSessionPoints(header, data, nullptr, out));
+    header.bytes += 2;
+    data[s.header.bytes] = 0;
+    TEST_ASSERT_FALSE(decodeSessionPoints(header, data, nullptr, out));
+}
+
+void test_crc_covers_header_and_points(void) {
+    Session s = session(false, 1.0f);
+    uint8_t data[SESSION_DATA_MAX];
+    s.header.bytes = encodeSessionPoints(s, nullptr, data);
+    s.header.crc = sessionRecordCrc(s.header, data);
+    // Stored with the CRC in place - it is computed with crc 0
+    TEST_ASSERT_EQUAL_UINT16(s.header.crc, sessionRecordCrc(s.header, data));
+
+    SessionHeader header = s.header;
+    header.riskPercent = 1.0f;
+    TEST_ASSERT_TRUE(sessionRecordCrc(header, data) != s.header.crc);
+    data[3] ^= 0x01;
+    TEST_ASSERT_TRUE(sessionRecordCrc(s.header, data) != s.header.crc);
+}
+
+void test_header_checks(void) {
+    Session s = session(false, 1.0f);
+    s.header.offset = 512;
+    TEST_ASSERT_TRUE(isSessionHeader(s.header, 512));
+    TEST_ASSERT_FALSE(isSessionHeader(s.header, 511));
+    SessionHeader header = s.header;
+    header.magic ^= 1;
+    TEST_ASSERT_FALSE(isSessionHeader(header, 512));
+    header = s.header;
+    header.count = MAX_FREQUENCIES + 1;
+    TEST_ASSERT_FALSE(isSessionHeader(header, 512));
+    header = s.header;
+    header.bytes = SESSION_DATA_MAX + 1;
+    TEST_ASSERT_FALSE(isSessionHeader(header, 512));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_self_contained_round_trip);
+    RUN_TEST(test_delta_against_reference);
+    RUN_TEST(test_quantized_points_are_stable);
+    RUN_TEST(test_other_frequencies_do_not_match);
+    RUN_TEST(test_cut_or_extra_data_is_rejected);
+    RUN_TEST(test_crc_covers_header_and_points);
+    RUN_TEST(test_header_checks);
+    return UNITY_END();
+}
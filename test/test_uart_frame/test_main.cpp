@@ -0,0 +1,201 @@
+#include <unity.h>
+#include "uart_frame.h"
+
+// Frames the handler saw in the last scan
+struct Received {
+    int frames;
+    uint8_t type;
+    bool v2;
+    size_t len;
+    uint8_t payload[UART_V2_MAX_PAYLOAD];
+};
+
+static Received received;
+static UARTFrameCounters counters;
+
+static void onFrame(uint8_t type, const uint8_t* payload, size_t len, bool v2, void* context) {
+    Received* r = static_cast<Received*>(context);
+    r->frames++;
+    r->type = type;
+    r->v2 = v2;
+    r->len = len;
+    memcpy(r->payload, payload, len);
+}
+
+static UARTFrequencyPayload samplePoint() {
+    UARTFrequencyPayload point = {};
+    point.freq_hz = 1000;
+    point.V_magnitude = 0.25f;
+    point.V_phase = -12.5f;
+    point.I_magnitude = 3.0e-6f;
+    point.I_phase = 4.0f;
+    point.pga_gain = 3;
+    point.tia_gain = 1;
+    point.valid = 1;
+    return point;
+}
+
+void setUp(void) {
+    memset(&received, 0, sizeof(received));
+    memset(&counters, 0, sizeof(counters));
+}
+
+void tearDown(void) {}
+
+/*=========================PARSER=========================*/
+
+void test_v2_frame_round_trip(void) {
+    UARTFrequencyPayload point = samplePoint();
+    uint8_t frame[UART_MAX_FRAME_SIZE];
+    size_t size = encodeUARTFrame<UART_DATA_FREQUENCY>(frame, point, true);
+    TEST_ASSERT_EQUAL(UART_V2_HEADER_SIZE + sizeof(point) + UART_V2_CRC_SIZE, size);
+
+    size_t consumed = 0;
+    TEST_ASSERT_EQUAL(1, scanUARTFrames(frame, size, &consumed, onFrame, &received, counters));
+    TEST_ASSERT_EQUAL(size, consumed);
+    TEST_ASSERT_EQUAL_UINT8(UART_DATA_FREQUENCY, received.type);
+    TEST_ASSERT_TRUE(received.v2);
+    TEST_ASSERT_EQUAL(sizeof(point), received.len);
+    TEST_ASSERT_EQUAL_MEMORY(&point, received.payload, sizeof(point));
+    TEST_ASSERT_EQUAL_UINT32(1, counters.v2Frames);
+    TEST_ASSERT_EQUAL_UINT32(0, counters.bytesSkipped);
+}
+
+void test_legacy_frame_round_trip(void) {
+    UARTDutStartPayload start = {2, 38, {0, 0}};
+    uint8_t frame[UART_MAX_FRAME_SIZE];
+    size_t size = encodeUARTFrame<UART_DATA_DUT_START>(frame, start, false);
+    TEST_ASSERT_EQUAL(UART_DATA_DUT_START_SIZE, size);
+    TEST_ASSERT_EQUAL_HEX8(UART_DATA_START_BYTE, frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(UART_DATA_END_BYTE, frame[size - 1]);
+
+    size_t consumed = 0;
+    TEST_ASSERT_EQUAL(1, scanUARTFrames(frame, size, &consumed, onFrame, &received, counters));
+    TEST_ASSERT_FALSE(received.v2);
+    TEST_ASSERT_EQUAL_UINT8(UART_DATA_DUT_START, received.type);
+    TEST_ASSERT_EQUAL_MEMORY(&start, received.payload, sizeof(start));
+    TEST_ASSERT_EQUAL_UINT32(0, counters.v2Frames);
+}
+
+void test_garbage_before_frame_is_skipped(void) {
+    UARTDutEndPayload end = {5};
+    uint8_t data[3 + UART_MAX_FRAME_SIZE] = {0x00, 0x13, 0x37};
+    size_t size = 3 + encodeUARTFrame<UART_DATA_DUT_END>(data + 3, end, true);
+
+    size_t consumed = 0;
+    TEST_ASSERT_EQUAL(1, scanUARTFrames(data, size, &consumed, onFrame, &received, counters));
+    TEST_ASSERT_EQUAL_UINT8(5, received.payload[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, counters.bytesSkipped);
+    TEST_ASSERT_EQUAL_UINT32(1, counters.resyncs);
+}
+
+void test_crc_error_rejects_frame(void) {
+    UARTDutEndPayload end = {7};
+    uint8_t frame[UART_MAX_FRAME_SIZE];
+    size_t size = encodeUARTFrame<UART_DATA_DUT_END>(frame, end, true);
+    frame[UART_V2_HEADER_SIZE] ^= 0x01;
+
+    size_t consumed = 0;
+    TEST_ASSERT_EQUAL(0, scanUARTFrames(frame, size, &consumed, onFrame, &received, counters));
+    TEST_ASSERT_EQUAL(0, received.frames);
+    TEST_ASSERT_EQUAL_UINT32(1, counters.crcErrors);
+    TEST_ASSERT_EQUAL(size, consumed);
+}
+
+void test_partial_frame_waits_for_the_rest(void) {
+    UARTFrequencyPayload point = samplePoint();
+    uint8_t frame[UART_MAX_FRAME_SIZE];
+    size_t size = encodeUARTFrame<UART_DATA_FREQUENCY>(frame, point, true);
+
+    UARTFrameStage stage = {};
+    size_t split = size / 2;
+    TEST_ASSERT_EQUAL(0, feedUARTFrames(stage, frame, split, onFrame, &received, counters));
+    TEST_ASSERT_EQUAL(split, stage.len);
+    TEST_ASSERT_EQUAL(1, feedUARTFrames(stage, frame + split, size - split, onFrame, &received, counters));
+    TEST_ASSERT_EQUAL(0, stage.len);
+    TEST_ASSERT_EQUAL_MEMORY(&point, received.payload, sizeof(point));
+    TEST_ASSERT_EQUAL_UINT32(0, counters.bytesSkipped);
+}
+
+void test_block_frame_decodes_its_points(void) {
+    uint8_t payload[sizeof(UARTFrequencyBlockHeader) + 3 * sizeof(UARTBlockPoint)];
+    UARTFrequencyBlockHeader header = {1, 10, 1, 0, 1, 3, 40};
+    memcpy(payload, &header, sizeof(header));
+    UARTBlockPoint* points = reinterpret_cast<UARTBlockPoint*>(payload + sizeof(header));
+    for (int i = 0; i < 3; i++) {
+        points[i] = {0.1f * (i + 1), 1.0e-6f, -30.0f, BLOCK_POINT_VALID | 2};
+    }
+
+    // Blocks are v2 only
+    uint8_t frame[UART_MAX_FRAME_SIZE];
+    TEST_ASSERT_EQUAL(0, encodeUARTFrame(frame, UART_DATA_FREQUENCY_BLOCK, payload, sizeof(payload), false));
+    size_t size = encodeUARTFrame(frame, UART_DATA_FREQUENCY_BLOCK, payload, sizeof(payload), true);
+    TEST_ASSERT_EQUAL(UART_V2_HEADER_SIZE + sizeof(payload) + UART_V2_CRC_SIZE, size);
+
+    size_t consumed = 0;
+    TEST_ASSERT_EQUAL(1, scanUARTFrames(frame, size, &consumed, onFrame, &received, counters));
+    const UARTBlockPoint* decoded = nullptr;
+    const UARTFrequencyBlockHeader* h = decodeUARTBlock<UART_DATA_FREQUENCY_BLOCK>(received.payload, received.len,
+                                                                                   decoded);
+    TEST_ASSERT_NOT_NULL(h);
+    TEST_ASSERT_EQUAL_UINT8(3, h->count);
+    TEST_ASSERT_EQUAL_UINT16(40, h->seq);
+    TEST_ASSERT_EQUAL_FLOAT(0.3f, decoded[2].V_magnitude);
+
+    // A count the payload does not hold
+    TEST_ASSERT_NULL(decodeUARTBlock<UART_DATA_FREQUENCY_BLOCK>(received.payload, received.len - 1, decoded));
+}
+
+/*=========================CODEC=========================*/
+
+void test_command_round_trip(void) {
+    UARTCommand command = {CMD_START_MEASUREMENT, 9, 4 | START_FLAG_INDEXED, 0, 37};
+    for (int v2 = 0; v2 < 2; v2++) {
+        uint8_t packet[UART_MAX_FRAME_SIZE];
+        size_t size = encodeUARTCommand(packet, command, v2);
+        TEST_ASSERT_TRUE(size > 0);
+
+        UARTCommand decoded;
+        bool decodedV2 = !v2;
+        size_t used = 0;
+        TEST_ASSERT_EQUAL(FRAME_OK, decodeUARTCommand(packet, size, decoded, decodedV2, used));
+        TEST_ASSERT_EQUAL(size, used);
+        TEST_ASSERT_EQUAL(v2, decodedV2);
+        TEST_ASSERT_EQUAL_UINT8(command.type, decoded.type);
+        TEST_ASSERT_EQUAL_UINT8(v2 ? command.seq : 0, decoded.seq);
+        TEST_ASSERT_EQUAL_UINT32(command.data1, decoded.data1);
+        TEST_ASSERT_EQUAL_UINT32(command.data3, decoded.data3);
+        TEST_ASSERT_EQUAL(FRAME_INCOMPLETE, decodeUARTCommand(packet, size - 1, decoded, decodedV2, used));
+    }
+}
+
+void test_ack_only_for_acked_commands(void) {
+    uint8_t frame[UART_MAX_FRAME_SIZE];
+    TEST_ASSERT_EQUAL(UART_ACK_PACKET_SIZE, encodeUARTAck(frame, CMD_START_MEASUREMENT, 0, false));
+    TEST_ASSERT_EQUAL(0, encodeUARTAck(frame, CMD_FLOW_CREDIT, 0, true));
+}
+
+void test_compact_magnitude_code(void) {
+    const float magnitudes[] = {1.0e-6f, 3.3e-3f, 1.0f, 47.0f, 2.0e5f};
+    for (float m : magnitudes) {
+        float decoded = uartCompactMagnitude(uartCompactMagCode(m));
+        TEST_ASSERT_FLOAT_WITHIN(m * 0.0005f, m, decoded);
+    }
+    TEST_ASSERT_EQUAL_UINT16(UART_COMPACT_MAG_ZERO, uartCompactMagCode(1.0f));
+    TEST_ASSERT_EQUAL_UINT16(0, uartCompactMagCode(0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, uartCompactMagnitude(0));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_v2_frame_round_trip);
+    RUN_TEST(test_legacy_frame_round_trip);
+    RUN_TEST(test_garbage_before_frame_is_skipped);
+    RUN_TEST(test_crc_error_rejects_frame);
+    RUN_TEST(test_partial_frame_waits_for_the_rest);
+    RUN_TEST(test_block_frame_decodes_its_points);
+    RUN_TEST(test_command_round_trip);
+    RUN_TEST(test_ack_only_for_acked_commands);
+    RUN_TEST(test_compact_magnitude_code);
+    return UNITY_END();
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+BioPal Thread Telemetry Collector
+Receives the risk / metric summaries of THREAD_UPLINK builds
+(include/thread_uplink.h) on a host beyond the Thread border router, one
+UDP datagram per DUT result, and prints one line each - optionally appended
+to a CSV file. Every unit is told apart by its Thread source address; gaps
+in its sequence numbers are reported as lost summaries.
+
+Usage (point the units at this host first: THREAD_DEST:<host IPv6>,61631):
+  python thread_collector.py                        # listen on [::]:61631
+  python thread_collector.py --port 61631 --csv ward.csv
+"""
+
+import argparse
+import csv
+import socket
+import struct
+import sys
+import time
+
+# Must match include/thread_uplink.h, include/BLE_Functions.h and include/spectral_metrics.h
+BIN_MAGIC = 0xB1
+BIN_TYPE_SUMMARY = 0x06
+SUMMARY_VERSION = 1
+SUMMARY_MONITOR = 0x01
+HEADER_FORMAT = "<BBBBHBBhHH"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+DEFAULT_PORT = 61631
+RISK_NAMES = {0: "none", 1: "low", 2: "medium", 3: "high", 4: "error"}
+METRIC_NAMES = ["band_low", "band_mid", "band_high", "phase_shift", "area", "rs_change", "rct_change", "n_change"]
+
+
+def decode_summary(data):
+    """The summary of one datagram as a dict, None if it is not one"""
+    if len(data) < HEADER_SIZE:
+        return None
+    (magic, ptype, version, dut, sequence, risk, flags,
+     percent, mask, alarms) = struct.unpack_from(HEADER_FORMAT, data)
+    if magic != BIN_MAGIC or ptype != BIN_TYPE_SUMMARY or version != SUMMARY_VERSION:
+        return None
+    names = [name for i, name in enumerate(METRIC_NAMES) if mask & (1 << i)]
+    if len(data) < HEADER_SIZE + 4 * len(names):
+        return None
+    values = struct.unpack_from(f"<{len(names)}f", data, HEADER_SIZE)
+    return {
+        "dut": dut,
+        "sequence": sequence,
+        "risk": RISK_NAMES.get(risk, str(risk)),
+        "percent": percent / 10.0,
+        "monitor": bool(flags & SUMMARY_MONITOR),
+        "metrics": dict(zip(names, values)),
+        "alarms": [name for i, name in enumerate(METRIC_NAMES) if alarms & (1 << i)],
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Collect BioPal Thread telemetry summaries")
+    parser.add_argument("--port", type=int, default=DEFAULT_PORT, help="UDP port (THREAD_DEST)")
+    parser.add_argument("--csv", help="Append every summary to this CSV file")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    sock.bind(("::", args.port))
+    print(f"Listening on [::]:{args.port}", file=sys.stderr)
+
+    writer = None
+    if args.csv:
+        out = open(args.csv, "a", newline="")
+        writer = csv.writer(out)
+        if out.tell() == 0:
+            writer.writerow(["time", "unit", "dut", "sequence", "risk", "percent", "monitor", "alarms"] + METRIC_NAMES)
+
+    last_sequence = {}
+    try:
+        while True:
+            data, sender = sock.recvfrom(256)
+            summary = decode_summary(data)
+            if summary is None:
+                continue
+            unit = sender[0]
+            expected = last_sequence.get(unit)
+            if expected is not None and summary["sequence"] != (expected + 1) & 0xFFFF:
+                lost = (summary["sequence"] - expected - 1) & 0xFFFF
+                print(f"{unit}: {lost} summaries lost (or the unit rebooted)", file=sys.stderr)
+            last_sequence[unit] = summary["sequence"]
+
+            metrics = " ".join(f"{k}={v:.4g}" for k, v in summary["metrics"].items())
+            alarms = f"  ALARM {','.join(summary['alarms'])}" if summary["alarms"] else ""
+            print(f"{time.strftime('%H:%M:%S')}  {unit}  DUT {summary['dut']:2}  {summary['risk']:<6} "
+                  f"{summary['percent']:6.1f}%{' monitor' if summary['monitor'] else ''}  {metrics}{alarms}")
+            if writer:
+                writer.writerow([int(time.time()), unit, summary["dut"], summary["sequence"], summary["risk"],
+                                 f"{summary['percent']:.1f}", int(summary["monitor"]), ",".join(summary["alarms"])] +
+                                [f"{summary['metrics'][name]:.6g}" if name in summary["metrics"] else ""
+                                 for name in METRIC_NAMES])
+                out.flush()
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""
+BioPal Trace Decoder
+Fetches the ESP32 binary trace ring ("trace dump" serial command) and prints
+it as a timeline with per-record deltas. Can also decode a saved raw dump.
+
+Usage:
+  python trace_decode.py --port /dev/ttyACM0          # request dump from device
+  python trace_decode.py --port COM5 --save dump.bin  # also keep the raw dump
+  python trace_decode.py --file dump.bin              # decode saved dump
+"""
+
+import argparse
+import struct
+import sys
+
+# Must match TraceRecord in include/trace.h
+RECORD_FORMAT = "<IHHII"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+# Must match TraceEvent in include/trace.h
+EVENT_NAMES = {
+    0x0100: "UART_BLOCK",
+    0x0101: "UART_FRAME",
+    0x0102: "UART_ACK",
+    0x0103: "UART_CMD_TX",
+    0x0104: "UART_OVERFLOW",
+    0x0105: "BATCH_FLUSH",
+    0x0200: "CAL_BEGIN",
+    0x0201: "CAL_END",
+    0x0202: "BATCH_PROCESSED",
+    0x0300: "BLE_TX_BEGIN",
+    0x0301: "BLE_TX_END",
+    0x0400: "GUI_RENDER_BEGIN",
+    0x0401: "GUI_RENDER_END",
+    0x0402: "GUI_STATE",
+    0x0403: "GUI_WAKE",
+}
+
+# Paired events reported as durations (begin -> end)
+SPANS = {
+    0x0200: 0x0201,  # CAL
+    0x0300: 0x0301,  # BLE_TX
+    0x0400: 0x0401,  # GUI_RENDER
+}
+
+
+def extract_dump(data):
+    """Find the TRACE_BEGIN header in a byte stream and return (records bytes, count)"""
+    start = data.find(b"TRACE_BEGIN ")
+    if start < 0:
+        raise ValueError("No TRACE_BEGIN marker found")
+
+    header_end = data.index(b"\n", start)
+    fields = data[start:header_end].split()
+    version, count, record_size = int(fields[1]), int(fields[2]), int(fields[3])
+    if version != 1 or record_size != RECORD_SIZE:
+        raise ValueError(f"Unsupported trace format (version {version}, record size {record_size})")
+
+    payload = data[header_end + 1:header_end + 1 + count * RECORD_SIZE]
+    if len(payload) < count * RECORD_SIZE:
+        raise ValueError(f"Truncated dump: expected {count} records")
+    return payload, count
+
+
+def read_from_device(port, baud_rate=115200, timeout=5.0):
+    """Send 'trace dump' and capture everything up to TRACE_END"""
+    import serial
+
+    with serial.Serial(port, baud_rate, timeout=timeout) as ser:
+        ser.reset_input_buffer()
+        ser.write(b"trace dump\n")
+
+        data = b""
+        while b"TRACE_END" not in data:
+            chunk = ser.read(4096)
+            if not chunk:
+                raise TimeoutError("Timed out waiting for TRACE_END")
+            data += chunk
+    return data
+
+
+def decode(payload, count):
+    """Yield (timestamp_us, event, arg0, arg1, arg2) tuples in order"""
+    for i in range(count):
+        yield struct.unpack_from(RECORD_FORMAT, payload, i * RECORD_SIZE)
+
+
+def print_timeline(records):
+    """Print records with time since first record and since previous record"""
+    if not records:
+        print("Trace is empty")
+        return
+
+    t0 = records[0][0]
+    prev = t0
+    print(f"{'t (ms)':>10} {'dt (us)':>9}  {'event':<18} args")
+    for ts, event, arg0, arg1, arg2 in records:
+        name = EVENT_NAMES.get(event, f"0x{event:04X}")
+        rel = ((ts - t0) & 0xFFFFFFFF) / 1000.0
+        delta = (ts - prev) & 0xFFFFFFFF
+        print(f"{rel:10.3f} {delta:9d}  {name:<18} {arg0} {arg1} {arg2}")
+        prev = ts
+
+
+def print_span_summary(records):
+    """Summarize begin/end pairs as min/avg/max durations"""
+    open_spans = {}
+    durations = {}
+    for ts, event, *_ in records:
+        if event in SPANS:
+            open_spans[event] = ts
+        else:
+            for begin, end in SPANS.items():
+                if event == end and begin in open_spans:
+                    durations.setdefault(begin, []).append((ts - open_spans.pop(begin)) & 0xFFFFFFFF)
+
+    if not durations:
+        return
+
+    print("\n=== Span durations (us) ===")
+    print(f"{'span':<18} {'count':>6} {'min':>8} {'avg':>8} {'max':>8}")
+    for begin, values in durations.items():
+        name = EVENT_NAMES[begin].replace("_BEGIN", "")
+        avg = sum(values) / len(values)
+        print(f"{name:<18} {len(values):6d} {min(values):8d} {avg:8.0f} {max(values):8d}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the BioPal ESP32 trace ring")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="Serial port of the ESP32")
+    source.add_argument("--file", help="Saved raw dump (output of --save)")
+    parser.add_argument("--baud", type=int, default=115200, help="Serial baud rate")
+    parser.add_argument("--save", help="Write the raw dump to this file")
+    args = parser.parse_args()
+
+    try:
+        if args.port:
+            data = read_from_device(args.port, args.baud)
+        else:
+            with open(args.file, "rb") as f:
+                data = f.read()
+
+        if args.save:
+            with open(args.save, "wb") as f:
+                f.write(data)
+
+        payload, count = extract_dump(data)
+    except (ValueError, TimeoutError, OSError) as e:
+        print(f"ERROR: {e}")
+        sys.exit(1)
+
+    records = list(decode(payload, count))
+    print_timeline(records)
+    print_span_summary(records)
+
+
+if __name__ == "__main__":
+    main()
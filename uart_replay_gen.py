@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""
+BioPal UART Replay Stream Generator
+Builds the raw STM32 -> ESP32 byte stream of a recorded sweep, optionally
+corrupted, for the host replay harness (src/uart_replay.cpp, [env:replay]).
+
+Sources:
+  --stm STM_output.csv      STM32 voltage/current listing (as stm_to_impedance.py reads)
+  --raw dump.bin            Raw capture dump from the device ("raw dump", raw_capture_decode.py)
+
+Usage:
+  python uart_replay_gen.py --stm STM_output.csv --out clean.bin
+  python uart_replay_gen.py --stm STM_output.csv --v2 --flip 0.001 --seed 1 --out noisy.bin
+  python uart_replay_gen.py --stm STM_output.csv --v2 --indexed --out indexed.bin
+  python uart_replay_gen.py --stm STM_output.csv --v2 --blocks --out blocks.bin
+  python uart_replay_gen.py --stm STM_output.csv --v2 --blocks --compact --out compact.bin
+  pio run -e replay && .pio/build/replay/program noisy.bin --passes 100
+"""
+
+import argparse
+import math
+import random
+import struct
+import sys
+
+from usb_export_decode import crc16_ccitt
+
+# Must match include/uart_protocol.h
+DATA_START = 0xAA
+DATA_END = 0x55
+V2_SYNC = b"\xA5\x5A"
+V2_VERSION = 0x01
+TYPE_DUT_START = 0x10
+TYPE_FREQUENCY = 0x11
+TYPE_DUT_END = 0x12
+TYPE_FREQUENCY_DUT = 0x14
+TYPE_FREQUENCY_IDX = 0x15
+TYPE_FREQUENCY_BLOCK = 0x16
+TYPE_COMPACT_BLOCK = 0x17
+FREQ_INVALID = 0xFF                 # SWEEP_FREQ_INVALID
+BLOCK_MAX_POINTS = 16               # UART_BLOCK_MAX_POINTS
+
+FREQUENCY_FORMAT = "<IffffBBB"      # UARTFrequencyPayload
+BLOCK_HEADER_FORMAT = "<BBbBBBH"     # UARTFrequencyBlockHeader
+BLOCK_POINT_FORMAT = "<fffB"        # UARTBlockPoint
+COMPACT_POINT_FORMAT = "<HHhB"      # UARTCompactPoint
+COMPACT_MAG_STEPS_PER_LN = 2048
+COMPACT_MAG_ZERO = 32768
+
+
+def frame(ftype, payload, v2):
+    """One legacy (AA type payload 55) or v2 (A5 5A ver type len payload crc16) frame"""
+    if not v2:
+        return bytes([DATA_START, ftype]) + payload + bytes([DATA_END])
+    body = bytes([V2_VERSION, ftype, len(payload)]) + payload
+    return V2_SYNC + body + struct.pack("<H", crc16_ccitt(body))
+
+
+def points_from_stm(path):
+    """(dut, freq, v_mag, v_phase, i_mag, i_phase, pga, tia, valid) rows in STM32 units"""
+    from stm_to_impedance import parse_stm_csv
+    for dut, freq, v_mag, v_phase, i_mag, i_phase, pga, tia, valid in parse_stm_csv(path):
+        # Same scaling as stm_to_impedance.py: mV and centidegrees
+        yield dut, freq, v_mag / 1000.0, v_phase / 100.0, i_mag / 1000.0, i_phase / 100.0, pga, tia, valid
+
+
+def points_from_raw(path):
+    """Rows from a raw capture dump - the phase is the V-I difference, I phase 0"""
+    from raw_capture_decode import extract_dump, decode
+    with open(path, "rb") as f:
+        payload, count = extract_dump(f.read())
+    for p in decode(payload, count):
+        yield (p["dut"], p["frequency"], p["v_mag"], p["phase"], p["i_mag"], 0.0,
+               p["pga_gain"], p["tia_gain"], int(p["valid"]))
+
+
+def compact_mag_code(mag):
+    """uartCompactMagCode(): log-coded magnitude, 0 for 0"""
+    if mag <= 0:
+        return 0
+    return min(max(round(math.log(mag) * COMPACT_MAG_STEPS_PER_LN) + COMPACT_MAG_ZERO, 1), 0xFFFF)
+
+
+def block_frames(dut, rows, index_of, compact=False):
+    """FREQUENCY_BLOCK frames of one DUT: runs of consecutive sweep indices"""
+    frames = []
+    run = []
+    for seq, row in enumerate(rows):
+        idx = index_of.get(row[1], FREQ_INVALID)
+        step = run[1][1] - run[0][1] if len(run) > 1 else idx - run[0][1] if run else 0
+        if run and (len(run) == BLOCK_MAX_POINTS or step not in (1, -1) or idx != run[-1][1] + step):
+            frames.append(block_frame(dut, run, compact))
+            run = []
+        if idx == FREQ_INVALID:
+            raise ValueError(f"{row[1]} Hz is not in the sweep table - blocks need indices")
+        run.append((seq, idx, row))
+    if run:
+        frames.append(block_frame(dut, run, compact))
+    return frames
+
+
+def block_frame(dut, run, compact):
+    seq, first_idx, _ = run[0]
+    step = run[1][1] - first_idx if len(run) > 1 else 1
+    body = struct.pack(BLOCK_HEADER_FORMAT, dut, first_idx, step, 0, 1, len(run), seq & 0xFFFF)
+    for _, _, (_, _, v_mag, v_phase, i_mag, i_phase, pga, tia, valid) in run:
+        gains = (0x80 if valid else 0) | (0x08 if tia == 1 else 0) | (pga & 0x07)
+        phase = v_phase - i_phase
+        if compact:
+            phase = math.remainder(phase, 360.0)
+            body += struct.pack(COMPACT_POINT_FORMAT, compact_mag_code(v_mag), compact_mag_code(i_mag),
+                                round(phase * 100), gains)
+        else:
+            body += struct.pack(BLOCK_POINT_FORMAT, v_mag, i_mag, phase, gains)
+    return frame(TYPE_COMPACT_BLOCK if compact else TYPE_FREQUENCY_BLOCK, body, True)
+
+
+def build_stream(points, v2, interleaved, indexed, blocks=False, compact=False):
+    """Frames of the sweep in STM32 order, and the number of frames"""
+    from cal_compile import SWEEP_FREQUENCIES
+    index_of = {freq: i for i, freq in enumerate(SWEEP_FREQUENCIES)}
+    by_dut = {}
+    for row in points:
+        by_dut.setdefault(row[0], []).append(row)
+
+    frames = []
+    for dut in sorted(by_dut):
+        rows = by_dut[dut]
+        if not interleaved:
+            frames.append(frame(TYPE_DUT_START, bytes([dut, len(rows), 0, 0]), v2))
+        if blocks:
+            frames.extend(block_frames(dut, rows, index_of, compact))
+            frames.append(frame(TYPE_DUT_END, bytes([dut]), v2))
+            continue
+        for seq, (_, freq, v_mag, v_phase, i_mag, i_phase, pga, tia, valid) in enumerate(rows):
+            point = struct.pack(FREQUENCY_FORMAT, freq, v_mag, v_phase, i_mag, i_phase, pga, tia, valid)
+            if indexed:
+                tag = bytes([dut, index_of.get(freq, FREQ_INVALID)]) + struct.pack("<H", seq & 0xFFFF)
+                frames.append(frame(TYPE_FREQUENCY_IDX, tag + point, v2))
+            elif interleaved:
+                frames.append(frame(TYPE_FREQUENCY_DUT, bytes([dut]) + point, v2))
+            else:
+                frames.append(frame(TYPE_FREQUENCY, point, v2))
+        frames.append(frame(TYPE_DUT_END, bytes([dut]), v2))
+    return b"".join(frames), len(frames)
+
+
+def corrupt(data, flip, drop, noise, rng):
+    """Flip a random bit, drop the byte or insert a random byte, each at its per-byte rate"""
+    out = bytearray()
+    for byte in data:
+        r = rng.random()
+        if r < drop:
+            continue
+        if r < drop + noise:
+            out.append(rng.randrange(256))
+        if rng.random() < flip:
+            byte ^= 1 << rng.randrange(8)
+        out.append(byte)
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build a UART replay stream for the host parser harness")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--stm", help="STM32 listing (STM_output.csv format)")
+    source.add_argument("--raw", help="Raw capture dump (raw dump output)")
+    parser.add_argument("--out", required=True, help="Stream file to write")
+    parser.add_argument("--v2", action="store_true", help="CRC-protected v2 frames instead of legacy")
+    parser.add_argument("--interleaved", action="store_true", help="FREQUENCY_DUT frames, no DUT_START")
+    parser.add_argument("--indexed", action="store_true", help="FREQUENCY_IDX frames (sweep index + sequence)")
+    parser.add_argument("--blocks", action="store_true", help="FREQUENCY_BLOCK frames (needs --v2, not --interleaved)")
+    parser.add_argument("--compact", action="store_true", help="Quantized COMPACT_BLOCK frames (with --blocks)")
+    parser.add_argument("--repeat", type=int, default=1, help="Repeat the sweep N times")
+    parser.add_argument("--flip", type=float, default=0.0, help="Per-byte bit flip rate")
+    parser.add_argument("--drop", type=float, default=0.0, help="Per-byte drop rate")
+    parser.add_argument("--noise", type=float, default=0.0, help="Per-byte random insertion rate")
+    parser.add_argument("--seed", type=int, default=0, help="Corruption RNG seed (reproducible streams)")
+    args = parser.parse_args()
+
+    try:
+        points = list(points_from_stm(args.stm) if args.stm else points_from_raw(args.raw))
+    except (ValueError, OSError) as e:
+        print(f"ERROR: {e}")
+        sys.exit(1)
+    if not points:
+        print("ERROR: No points in the source")
+        sys.exit(1)
+
+    if args.blocks and (not args.v2 or args.interleaved):
+        print("ERROR: --blocks needs --v2 and DUT-by-DUT order")
+        sys.exit(1)
+    if args.compact and not args.blocks:
+        print("ERROR: --compact needs --blocks")
+        sys.exit(1)
+    try:
+        sweep, frame_count = build_stream(points, args.v2, args.interleaved, args.indexed, args.blocks, args.compact)
+    except ValueError as e:
+        print(f"ERROR: {e}")
+        sys.exit(1)
+    stream = sweep * max(args.repeat, 1)
+    if args.flip or args.drop or args.noise:
+        stream = corrupt(stream, args.flip, args.drop, args.noise, random.Random(args.seed))
+
+    with open(args.out, "wb") as f:
+        f.write(stream)
+
+    total = frame_count * max(args.repeat, 1)
+    clean = not (args.flip or args.drop or args.noise)
+    print(f"Wrote {len(stream)} bytes, {total} frames ({len(points)} points) to {args.out}", file=sys.stderr)
+    if clean:
+        print(f"Check with: --expect {total}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+"""
+BioPal Binary Export Decoder
+Reads the ESP32's framed binary export ("export" serial command, and sent
+automatically after each sweep) and writes the rows as CSV. Log text between
+frames is passed through, so the stream needs no banner scraping. With
+--pssession it requests the PalmSens document the firmware generates
+("export pssession") and saves it as sent - no host conversion.
+
+Usage:
+  python usb_export_decode.py --port /dev/ttyACM0 --csv out.csv   # request export from device
+  python usb_export_decode.py --port COM5 --save raw.bin          # also keep the raw stream
+  python usb_export_decode.py --file raw.bin --csv out.csv        # decode saved stream
+  python usb_export_decode.py --port COM5 --pssession run.pssession --sweep final
+"""
+
+import argparse
+import struct
+import sys
+
+# Must match include/usb_export.h
+EXPORT_VERSION = 1
+FRAME_BEGIN = 0x01
+FRAME_ROW = 0x02
+FRAME_END = 0x03
+FRAME_MIRROR = 0x04     # Screen mirror packet (screen_mirror_view.py) - skipped here
+FRAME_FILE = 0x05       # offset (u32), bytes of a .pssession document
+FRAME_FILE_END = 0x06   # bytes (u32), complete (u8)
+STATE_BASELINE = 0x01
+STATE_FINAL = 0x02
+
+BEGIN_FORMAT = "<BBBBI"
+ROW_HEADER_FORMAT = "<BBB"
+POINT_FORMAT = "<IffBBB"
+POINT_SIZE = struct.calcsize(POINT_FORMAT)
+END_FORMAT = "<BH"
+FILE_END_FORMAT = "<IB"
+
+# Must match include/defines.h and include/repeat_filter.h
+FLAG_VALID = 0x80
+FLAG_TIA_HIGH = 0x08
+FLAG_PGA_MASK = 0x07
+NOISE_MAG_STEP = 0.1
+NOISE_PHASE_STEP = 0.1
+
+SWEEP_NAMES = ("baseline", "final")
+CSV_HEADER = "DUT,Frequency_Hz,Magnitude_Ohms,Phase_Deg,PGA Gain, TIA Gain,Sweep,Valid,Mag_SD_Pct,Phase_SD_Deg"
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as crc16_ccitt() in src/crc.cpp"""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Decode one COBS block (without delimiters); None if it is malformed"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(block):
+    """(type, body) of a COBS block, or None if it is not a valid frame"""
+    frame = cobs_decode(block)
+    if frame is None or len(frame) < 3:
+        return None
+    body, crc = frame[:-2], struct.unpack("<H", frame[-2:])[0]
+    if crc16_ccitt(body) != crc or body[0] not in (FRAME_BEGIN, FRAME_ROW, FRAME_END, FRAME_MIRROR,
+                                                             FRAME_FILE, FRAME_FILE_END):
+        return None
+    return body[0], body[1:]
+
+
+class ExportDecoder:
+    """Splits a serial byte stream into export frames and log text"""
+
+    def __init__(self, on_text=None):
+        self.on_text = on_text or (lambda text: sys.stdout.write(text))
+        self.pending = bytearray()
+        self.in_frame = False     # Last 0x00 opened a frame
+        self.export = None        # Export being received
+        self.done = []            # Completed exports
+        self.document = None      # .pssession document being received
+        self.documents = []       # Completed documents (bytes)
+
+    def feed(self, data):
+        """Process received bytes; returns the exports completed by them"""
+        self.pending += data
+        completed = len(self.done)
+        while True:
+            i = self.pending.find(0)
+            if i < 0:
+                break
+            block = bytes(self.pending[:i])
+            del self.pending[:i + 1]
+            frame = parse_frame(block) if block else None
+            if frame is not None:
+                self.handle_frame(*frame)
+            else:
+                # Text up to an opening delimiter (or a damaged frame)
+                self.emit_text(block)
+            self.in_frame = frame is None
+        # Pass complete lines through unless a frame is still arriving
+        if not self.in_frame:
+            end = self.pending.rfind(b"\n")
+            if end >= 0:
+                self.emit_text(bytes(self.pending[:end + 1]))
+                del self.pending[:end + 1]
+        return self.done[completed:]
+
+    def emit_text(self, block):
+        if block:
+            self.on_text(block.decode("utf-8", errors="replace"))
+
+    def handle_frame(self, frame_type, body):
+        if frame_type == FRAME_BEGIN and len(body) == struct.calcsize(BEGIN_FORMAT):
+            version, duts, points, state, generation = struct.unpack(BEGIN_FORMAT, body)
+            if version != EXPORT_VERSION:
+                raise ValueError(f"Unsupported export version {version}")
+            self.export = {"duts": duts, "points_per_dut": points, "generation": generation,
+                           "baseline_done": bool(state & STATE_BASELINE),
+                           "final_done": bool(state & STATE_FINAL), "rows": []}
+        elif frame_type == FRAME_ROW and self.export is not None:
+            dut, sweep, count = struct.unpack_from(ROW_HEADER_FORMAT, body)
+            rows = []
+            for k in range(count):
+                freq, mag, phase, flags, mag_sd, phase_sd = struct.unpack_from(
+                    POINT_FORMAT, body, struct.calcsize(ROW_HEADER_FORMAT) + k * POINT_SIZE)
+                rows.append({"frequency": freq, "magnitude": mag, "phase": phase,
+                             "pga_gain": flags & FLAG_PGA_MASK, "tia_gain": int(bool(flags & FLAG_TIA_HIGH)),
+                             "valid": bool(flags & FLAG_VALID),
+                             "mag_sd_pct": mag_sd * NOISE_MAG_STEP, "phase_sd_deg": phase_sd * NOISE_PHASE_STEP})
+            self.export["rows"].append({"dut": dut + 1, "sweep": SWEEP_NAMES[sweep & 1], "points": rows})
+        elif frame_type == FRAME_END and self.export is not None:
+            rows, points = struct.unpack(END_FORMAT, body)
+            received = sum(len(row["points"]) for row in self.export["rows"])
+            if rows != len(self.export["rows"]) or points != received:
+                print(f"WARNING: Export incomplete ({len(self.export['rows'])}/{rows} rows, "
+                      f"{received}/{points} points)", file=sys.stderr)
+            self.done.append(self.export)
+            self.export = None
+        elif frame_type == FRAME_FILE and len(body) >= 4:
+            offset = struct.unpack_from("<I", body)[0]
+            if offset == 0:
+                self.document = bytearray()
+            if self.document is not None and offset == len(self.document):
+                self.document += body[4:]
+            else:
+                self.document = None  # A frame was lost - wait for the next document
+        elif frame_type == FRAME_FILE_END and len(body) == struct.calcsize(FILE_END_FORMAT):
+            size, complete = struct.unpack(FILE_END_FORMAT, body)
+            if self.document is None or size != len(self.document) or not complete:
+                print("WARNING: Document incomplete (frame lost or a new sweep started)", file=sys.stderr)
+            else:
+                self.documents.append(bytes(self.document))
+            self.document = None
+
+
+def export_to_csv_lines(export, sweeps=SWEEP_NAMES, valid_only=False):
+    """CSV lines (header first) of the rows of the given sweeps"""
+    lines = [CSV_HEADER]
+    for row in export["rows"]:
+        if row["sweep"] not in sweeps:
+            continue
+        for p in row["points"]:
+            if valid_only and not p["valid"]:
+                continue
+            lines.append(f"{row['dut']},{p['frequency']},{p['magnitude']:.6f},{p['phase']:.2f},"
+                         f"{p['pga_gain']},{p['tia_gain']},{row['sweep']},{int(p['valid'])},"
+                         f"{p['mag_sd_pct']:.1f},{p['phase_sd_deg']:.1f}")
+    return lines
+
+
+def read_from_port(port, baud, save_path, timeout_s, command=b"export\n", done=lambda d: d.done):
+    """Send command and return the decoder once done(decoder) lists a result"""
+    import time
+    import serial
+
+    decoder = ExportDecoder()
+    raw = bytearray()
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        ser.reset_input_buffer()
+        ser.write(command)
+        deadline = time.time() + timeout_s
+        while time.time() < deadline:
+            data = ser.read(4096)
+            raw += data
+            decoder.feed(data)
+            if done(decoder):
+                break
+    if save_path:
+        with open(save_path, "wb") as f:
+            f.write(raw)
+    return decoder
+
+
+def save_pssession(args):
+    """Request (or find in the saved stream) a .pssession document and write it"""
+    if args.port:
+        command = b"export pssession\n" if args.sweep == "all" else f"export pssession {args.sweep}\n".encode()
+        decoder = read_from_port(args.port, args.baud, args.save, args.timeout, command, lambda d: d.documents)
+    else:
+        decoder = ExportDecoder(on_text=lambda text: None)
+        with open(args.file, "rb") as f:
+            decoder.feed(f.read())
+    if not decoder.documents:
+        print("ERROR: No complete .pssession document received", file=sys.stderr)
+        return 1
+    with open(args.pssession, "wb") as f:
+        f.write(decoder.documents[-1])
+    print(f"Wrote {len(decoder.documents[-1])} bytes to {args.pssession}", file=sys.stderr)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the BioPal binary export")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="Serial port to request the export from")
+    source.add_argument("--file", help="Saved raw serial stream")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=10.0, help="Seconds to wait for the export")
+    parser.add_argument("--save", help="Keep the raw stream (with --port)")
+    parser.add_argument("--csv", help="Write the rows to this CSV file (default: stdout)")
+    parser.add_argument("--sweep", choices=["baseline", "final", "all"], default="all",
+                        help="Rows to convert; with --pssession the document's sweep (all: final if measured)")
+    parser.add_argument("--pssession", help="Save the firmware's .pssession document here instead of CSV")
+    parser.add_argument("--valid-only", action="store_true", help="Leave out invalid points")
+    args = parser.parse_args()
+
+    if args.pssession:
+        return save_pssession(args)
+
+    if args.port:
+        decoder = read_from_port(args.port, args.baud, args.save, args.timeout)
+        export = decoder.done[0] if decoder.done else None
+    else:
+        decoder = ExportDecoder(on_text=lambda text: None)
+        with open(args.file, "rb") as f:
+            decoder.feed(f.read())
+        export = decoder.done[-1] if decoder.done else None
+
+    if export is None:
+        print("ERROR: No complete export received", file=sys.stderr)
+        return 1
+
+    sweeps = SWEEP_NAMES if args.sweep == "all" else (args.sweep,)
+    lines = export_to_csv_lines(export, sweeps, args.valid_only)
+    if args.csv:
+        with open(args.csv, "w") as f:
+            f.write("\n".join(lines) + "\n")
+        print(f"Wrote {len(lines) - 1} points of {len(export['rows'])} rows to {args.csv}", file=sys.stderr)
+    else:
+        print("\n".join(lines))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())